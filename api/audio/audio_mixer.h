@@ -13,6 +13,7 @@
 
 #include <memory>
 
+#include "absl/types/optional.h"
 #include "api/audio/audio_frame.h"
 #include "rtc_base/ref_count.h"
 
@@ -48,6 +49,23 @@ class AudioMixer : public rtc::RefCountInterface {
     // with this sample rate or higher will not cause quality loss.
     virtual int PreferredSampleRate() const = 0;
 
+    // Returns the level of the most recently received audio, in -dBov as
+    // carried by the RTP audio level header extension (0 is the loudest and
+    // 127 silence), or nullopt if unknown. Lets a mixer select the sources to
+    // mix before getting audio from any of them.
+    virtual absl::optional<int> ReceivedAudioLevel() const {
+      return absl::nullopt;
+    }
+
+    // Called instead of GetAudioFrameWithInfo when a mixer does not mix the
+    // next 10 ms of audio of this source. Sources for which producing audio
+    // is expensive, e.g. because it must be decoded, should discard it
+    // without producing it.
+    virtual void SkipAudioFrame(int sample_rate_hz) {
+      AudioFrame audio_frame;
+      GetAudioFrameWithInfo(sample_rate_hz, &audio_frame);
+    }
+
     virtual ~Source() {}
   };
 
@@ -17,6 +17,7 @@
 #include "api/array_view.h"
 #include "api/ref_counted_base.h"
 #include "api/scoped_refptr.h"
+#include "rtc_base/copy_on_write_buffer.h"
 
 namespace webrtc {
 
@@ -45,8 +46,33 @@ struct PacketOptions {
 
 class Transport {
  public:
+  // An RTP packet handed to SendRtpBatch(). `sent` is filled in by the
+  // transport.
+  struct BatchedRtpPacket {
+    rtc::CopyOnWriteBuffer packet;
+    PacketOptions options;
+    bool sent = false;
+  };
+
   virtual bool SendRtp(rtc::ArrayView<const uint8_t> packet,
                        const PacketOptions& options) = 0;
+  // Same as SendRtp, but hands over a reference to the packet's own buffer so
+  // that a transport which needs to keep or modify the packet can share it
+  // instead of copying it. The buffer may still be referenced by the sender
+  // (e.g. for retransmissions), so it must only be written to through the
+  // copy-on-write interface.
+  virtual bool SendRtpBuffer(rtc::CopyOnWriteBuffer packet,
+                             const PacketOptions& options) {
+    return SendRtp(packet, options);
+  }
+  // Sends a burst of packets, in order, with a single call, so that the
+  // transport can hand them over to the network layer together. The default
+  // implementation sends them one by one.
+  virtual void SendRtpBatch(rtc::ArrayView<BatchedRtpPacket> packets) {
+    for (BatchedRtpPacket& packet : packets) {
+      packet.sent = SendRtpBuffer(packet.packet, packet.options);
+    }
+  }
   virtual bool SendRtcp(rtc::ArrayView<const uint8_t> packet) = 0;
 
  protected:
@@ -33,6 +33,13 @@ class TransformableFrameInterface {
   // Copies `data` into the owned frame payload data.
   virtual void SetData(rtc::ArrayView<const uint8_t> data) = 0;
 
+  // Returns a writable view of the frame payload data, for transforms that
+  // don't change the payload size to modify it in place instead of copying
+  // their output with SetData(). The view is valid until the next non-const
+  // method call. Returns an empty view if the frame doesn't support in-place
+  // modification.
+  virtual rtc::ArrayView<uint8_t> GetMutableData() { return {}; }
+
   virtual uint8_t GetPayloadType() const = 0;
   virtual uint32_t GetSsrc() const = 0;
   virtual uint32_t GetTimestamp() const = 0;
@@ -116,6 +123,12 @@ class FrameTransformerInterface : public rtc::RefCountInterface {
   virtual void UnregisterTransformedFrameCallback() {}
   virtual void UnregisterTransformedFrameSinkCallback(uint32_t ssrc) {}
 
+  // Returns true if the transformer always hands each frame back through
+  // OnTransformedFrame() before Transform() returns, on the same sequence.
+  // Transformed frames are then sent or received directly on that sequence
+  // instead of being posted to another task queue.
+  virtual bool TransformsSynchronously() const { return false; }
+
  protected:
   ~FrameTransformerInterface() override = default;
 };
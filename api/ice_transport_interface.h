@@ -24,6 +24,7 @@ class IceTransportInternal;
 class PortAllocator;
 class IceControllerFactoryInterface;
 class ActiveIceControllerFactoryInterface;
+class IcePingScheduler;
 }  // namespace cricket
 
 namespace webrtc {
@@ -95,6 +96,14 @@ struct IceTransportInit final {
     return active_ice_controller_factory_;
   }
 
+  // If set, the default active ICE controller schedules its connectivity checks
+  // with this scheduler, which may be shared by many transports, to coalesce
+  // their wake ups. It must outlive the transport.
+  void set_ping_scheduler(cricket::IcePingScheduler* ping_scheduler) {
+    ping_scheduler_ = ping_scheduler;
+  }
+  cricket::IcePingScheduler* ping_scheduler() { return ping_scheduler_; }
+
   const FieldTrialsView* field_trials() { return field_trials_; }
   void set_field_trials(const FieldTrialsView* field_trials) {
     field_trials_ = field_trials;
@@ -107,6 +116,7 @@ struct IceTransportInit final {
   cricket::IceControllerFactoryInterface* ice_controller_factory_ = nullptr;
   cricket::ActiveIceControllerFactoryInterface* active_ice_controller_factory_ =
       nullptr;
+  cricket::IcePingScheduler* ping_scheduler_ = nullptr;
   const FieldTrialsView* field_trials_ = nullptr;
   // TODO(https://crbug.com/webrtc/12657): Redesign to have const members.
 };
@@ -23,7 +23,22 @@ namespace webrtc {
 // The declaration is overriden inside the Chromium build.
 class RTC_EXPORT Location {
  public:
-  static Location Current() { return Location(); }
+  // Captures the file and line of the caller. When used as a default
+  // argument, that is the caller of the function taking the Location.
+  static Location Current(const char* file_name = __builtin_FILE(),
+                          int line_number = __builtin_LINE()) {
+    return Location(file_name, line_number);
+  }
+
+  const char* file_name() const { return file_name_; }
+  int line_number() const { return line_number_; }
+
+ private:
+  Location(const char* file_name, int line_number)
+      : file_name_(file_name), line_number_(line_number) {}
+
+  const char* file_name_;
+  int line_number_;
 };
 
 }  // namespace webrtc
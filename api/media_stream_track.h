@@ -11,6 +11,7 @@
 #ifndef API_MEDIA_STREAM_TRACK_H_
 #define API_MEDIA_STREAM_TRACK_H_
 
+#include <atomic>
 #include <string>
 
 #include "absl/strings/string_view.h"
@@ -27,13 +28,17 @@ class MediaStreamTrack : public Notifier<T> {
   typedef typename T::TrackState TypedTrackState;
 
   std::string id() const override { return id_; }
+  // May be called on any thread.
   MediaStreamTrackInterface::TrackState state() const override {
-    return state_;
+    return state_.load(std::memory_order_relaxed);
+  }
+  // May be called on any thread.
+  bool enabled() const override {
+    return enabled_.load(std::memory_order_relaxed);
   }
-  bool enabled() const override { return enabled_; }
   bool set_enabled(bool enable) override {
-    bool fire_on_change = (enable != enabled_);
-    enabled_ = enable;
+    bool fire_on_change =
+        (enable != enabled_.exchange(enable, std::memory_order_relaxed));
     if (fire_on_change) {
       Notifier<T>::FireOnChanged();
     }
@@ -46,17 +51,18 @@ class MediaStreamTrack : public Notifier<T> {
       : enabled_(true), id_(id), state_(MediaStreamTrackInterface::kLive) {}
 
   bool set_state(MediaStreamTrackInterface::TrackState new_state) {
-    bool fire_on_change = (state_ != new_state);
-    state_ = new_state;
+    bool fire_on_change =
+        (new_state != state_.exchange(new_state, std::memory_order_relaxed));
     if (fire_on_change)
       Notifier<T>::FireOnChanged();
     return true;
   }
 
  private:
-  bool enabled_;
+  // Atomic so that the proxies can read them without a thread hop.
+  std::atomic<bool> enabled_;
   const std::string id_;
-  MediaStreamTrackInterface::TrackState state_;
+  std::atomic<MediaStreamTrackInterface::TrackState> state_;
 };
 
 }  // namespace webrtc
@@ -308,6 +308,10 @@ class NetEq {
   // Returns the length of the audio yet to play in the sync buffer.
   // Mainly intended for testing.
   virtual int SyncBufferSizeMs() const = 0;
+
+  // Returns the number of bytes held by the packet buffer and the audio
+  // buffers.
+  virtual size_t GetMemoryUsageBytes() const { return 0; }
 };
 
 }  // namespace webrtc
@@ -72,6 +72,7 @@
 
 #include <functional>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -112,12 +113,14 @@
 #include "api/set_remote_description_observer_interface.h"
 #include "api/stats/rtc_stats_collector_callback.h"
 #include "api/task_queue/task_queue_factory.h"
+#include "api/thread_policy.h"
 #include "api/transport/bandwidth_estimation_settings.h"
 #include "api/transport/bitrate_settings.h"
 #include "api/transport/enums.h"
 #include "api/transport/network_control.h"
 #include "api/transport/sctp_transport_factory_interface.h"
 #include "api/turn_customizer.h"
+#include "api/units/time_delta.h"
 #include "api/video/video_bitrate_allocator_factory.h"
 #include "api/video_codecs/video_decoder_factory.h"
 #include "api/video_codecs/video_encoder_factory.h"
@@ -680,6 +683,14 @@ class RTC_EXPORT PeerConnectionInterface : public webrtc::RefCountInterface {
     // The burst interval of the pacer, see TaskQueuePacedSender constructor.
     absl::optional<TimeDelta> pacer_burst_interval;
 
+    // If set, local candidates gathered within this window after the first
+    // one are delivered together through
+    // PeerConnectionObserver::OnIceCandidatesBatch(), instead of one
+    // OnIceCandidate() per candidate. Pending candidates are delivered before
+    // a change of the ICE gathering state. Can't be changed by
+    // SetConfiguration().
+    absl::optional<TimeDelta> ice_candidate_batch_window;
+
     //
     // Don't forget to update operator== if adding something.
     //
@@ -946,6 +957,23 @@ class RTC_EXPORT PeerConnectionInterface : public webrtc::RefCountInterface {
   virtual void GetStats(
       rtc::scoped_refptr<RtpReceiverInterface> selector,
       rtc::scoped_refptr<RTCStatsCollectorCallback> callback) = 0;
+  struct StatsRequest {
+    // The types of the stats objects to deliver, as returned by
+    // RTCStats::type(), e.g. "outbound-rtp". All types if empty.
+    std::set<std::string> types;
+    // If set, the stats objects that are in this report with the same values
+    // are left out, e.g. to only get what changed since the previous report.
+    rtc::scoped_refptr<const RTCStatsReport> unchanged_since;
+  };
+  // Spec-compliant getStats() that only delivers the requested stats. The
+  // stats of the media channels, which are gathered on the worker thread, are
+  // skipped unless RTP stream, codec or media source stats are requested.
+  // The default implementation ignores `request` and delivers all stats.
+  virtual void GetStats(
+      const StatsRequest& request,
+      rtc::scoped_refptr<RTCStatsCollectorCallback> callback) {
+    GetStats(callback.get());
+  }
   // Clear cached stats in the RTCStatsCollector.
   virtual void ClearStatsCache() {}
 
@@ -1295,6 +1323,17 @@ class PeerConnectionObserver {
   // A new ICE candidate has been gathered.
   virtual void OnIceCandidate(const IceCandidateInterface* candidate) = 0;
 
+  // Called instead of OnIceCandidate() when
+  // RTCConfiguration::ice_candidate_batch_window is set, with the candidates
+  // gathered within one window in the order they were gathered. The default
+  // implementation calls OnIceCandidate() for each of them.
+  virtual void OnIceCandidatesBatch(
+      const std::vector<const IceCandidateInterface*>& candidates) {
+    for (const IceCandidateInterface* candidate : candidates) {
+      OnIceCandidate(candidate);
+    }
+  }
+
   // Gathering of an ICE candidate failed.
   // See https://w3c.github.io/webrtc-pc/#event-icecandidateerror
   virtual void OnIceCandidateError(const std::string& address,
@@ -1417,6 +1456,25 @@ struct RTC_EXPORT PeerConnectionFactoryDependencies final {
   rtc::Thread* network_thread = nullptr;
   rtc::Thread* worker_thread = nullptr;
   rtc::Thread* signaling_thread = nullptr;
+  // Number of network threads to spread PeerConnections over. When larger
+  // than one, the factory starts `num_network_threads - 1` additional network
+  // threads, each with its own socket server, and assigns every new
+  // PeerConnection to the one with the fewest PeerConnections. A PeerConnection
+  // stays on its network thread for its whole lifetime. The injected
+  // `network_thread`, `socket_factory`, `packet_socket_factory`,
+  // `network_manager` and `sctp_factory` only apply to the first network
+  // thread; the additional ones use default implementations.
+  int num_network_threads = 1;
+  // If positive, and no `task_queue_factory` is injected, the task queues of
+  // the internal modules of all PeerConnections, e.g. the encoder, pacer and
+  // RTC event log queues, share a pool of this many threads instead of getting
+  // a thread each.
+  int num_task_queue_threads = 0;
+  // Priority, scheduling policy and CPU affinity of the network and worker
+  // threads the factory starts, and of the encoder, decoder and audio task
+  // queues. Task queue attributes are not applied to a pool of
+  // `num_task_queue_threads`, as its threads are shared by all queues.
+  ThreadPolicy thread_policy;
   rtc::SocketFactory* socket_factory = nullptr;
   // The `packet_socket_factory` will only be used if CreatePeerConnection is
   // called without a `port_allocator`.
@@ -1445,6 +1503,11 @@ struct RTC_EXPORT PeerConnectionFactoryDependencies final {
   // TODO(b/304158952): Consider merging into a single metronome for all codec
   // usage.
   std::unique_ptr<Metronome> encode_metronome;
+  // Metronome the pacers of all calls created by the factory align their
+  // wakeups to, must be called on the worker thread. Lets a server with many
+  // peer connections send media in shared bursts rather than one timer per
+  // connection.
+  std::unique_ptr<Metronome> pacer_metronome;
 
   // Media specific dependencies. Unused when `media_factory == nullptr`.
   rtc::scoped_refptr<AudioDeviceModule> adm;
@@ -1504,10 +1567,20 @@ class RTC_EXPORT PeerConnectionFactoryInterface
     // Sets the maximum supported protocol version. The highest version
     // supported by both ends will be used for the connection, i.e. if one
     // party supports DTLS 1.0 and the other DTLS 1.2, DTLS 1.0 will be used.
+    // SSL_PROTOCOL_DTLS_13 offers DTLS 1.3, which saves a round trip in the
+    // handshake, when the SSL library supports it.
     rtc::SSLProtocolVersion ssl_max_version = rtc::SSL_PROTOCOL_DTLS_12;
 
     // Sets crypto related options, e.g. enabled cipher suites.
     CryptoOptions crypto_options = {};
+
+    // If positive, this many DTLS certificates are generated ahead of time on
+    // a background thread, and PeerConnections created with the default
+    // certificate generator take one instead of generating a key. Only
+    // certificates with the default key parameters and expiration are pooled.
+    int certificate_pool_size = 0;
+    // Pooled certificates older than this are replaced by new ones.
+    TimeDelta certificate_pool_max_age = TimeDelta::Seconds(24 * 60 * 60);
   };
 
   // Set the options to be used for subsequently created PeerConnections.
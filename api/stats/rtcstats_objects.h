@@ -171,6 +171,16 @@ class RTC_EXPORT RTCPeerConnectionStats final : public RTCStats {
 
   absl::optional<uint32_t> data_channels_opened;
   absl::optional<uint32_t> data_channels_closed;
+  // Non-standard. The time in seconds from the creation of the peer connection
+  // until each of the setup phases that have been reached, keyed by phase
+  // name, e.g. "localDescriptionSet" or "connected".
+  absl::optional<std::map<std::string, double>> setup_timeline;
+  // Non-standard. Bytes held by the packet histories, jitter buffers and data
+  // channel send queues of the peer connection, in total and keyed by
+  // component name.
+  absl::optional<uint64_t> memory_usage_bytes;
+  absl::optional<std::map<std::string, uint64_t>>
+      memory_usage_bytes_by_component;
 };
 
 // https://w3c.github.io/webrtc-stats/#streamstats-dict*
@@ -315,6 +325,10 @@ class RTC_EXPORT RTCInboundRtpStreamStats final
   absl::optional<uint32_t> interruption_count;
   absl::optional<double> total_interruption_duration;
   absl::optional<double> min_playout_delay;
+  // Thread CPU time in seconds spent decoding, by the video decoder or by
+  // NetEq for audio. Only defined when the "WebRTC-PerStreamCpuTime" field
+  // trial is enabled.
+  absl::optional<double> total_decode_cpu_time;
 };
 
 // https://w3c.github.io/webrtc-stats/#outboundrtpstats-dict*
@@ -365,6 +379,12 @@ class RTC_EXPORT RTCOutboundRtpStreamStats final
 
   // RTX ssrc. Only present if RTX is negotiated.
   absl::optional<uint32_t> rtx_ssrc;
+
+  // The following metrics are NOT exposed to JavaScript.
+  // Thread CPU time in seconds spent encoding the frames of all layers of the
+  // send stream. Only defined for video when the "WebRTC-PerStreamCpuTime"
+  // field trial is enabled.
+  absl::optional<double> total_encode_cpu_time;
 };
 
 // https://w3c.github.io/webrtc-stats/#remoteinboundrtpstats-dict*
@@ -38,6 +38,7 @@ class MockFrameTransformer : public FrameTransformerInterface {
               UnregisterTransformedFrameSinkCallback,
               (uint32_t),
               (override));
+  MOCK_METHOD(bool, TransformsSynchronously, (), (const, override));
 };
 
 }  // namespace webrtc
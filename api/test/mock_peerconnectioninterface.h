@@ -105,6 +105,11 @@ class MockPeerConnectionInterface : public webrtc::PeerConnectionInterface {
               (rtc::scoped_refptr<RtpReceiverInterface>,
                rtc::scoped_refptr<RTCStatsCollectorCallback>),
               (override));
+  MOCK_METHOD(void,
+              GetStats,
+              (const StatsRequest&,
+               rtc::scoped_refptr<RTCStatsCollectorCallback>),
+              (override));
   MOCK_METHOD(void, ClearStatsCache, (), (override));
   MOCK_METHOD(rtc::scoped_refptr<SctpTransportInterface>,
               GetSctpTransport,
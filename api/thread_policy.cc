@@ -0,0 +1,103 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "api/thread_policy.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+namespace {
+
+class ThreadPolicyTaskQueueFactory : public TaskQueueFactory {
+ public:
+  ThreadPolicyTaskQueueFactory(std::unique_ptr<TaskQueueFactory> factory,
+                               const ThreadPolicy& policy)
+      : factory_(std::move(factory)), policy_(policy) {}
+
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> CreateTaskQueue(
+      absl::string_view name,
+      Priority priority) const override {
+    std::unique_ptr<TaskQueueBase, TaskQueueDeleter> task_queue =
+        factory_->CreateTaskQueue(name, priority);
+    absl::optional<ThreadRole> role = ThreadRoleForTaskQueue(name);
+    if (role && policy_.ForRole(*role)) {
+      // The first task runs on the thread of the new task queue.
+      task_queue->PostTask([attributes = *policy_.ForRole(*role),
+                            name = std::string(name)] {
+        ApplyThreadAttributes(attributes, name);
+      });
+    }
+    return task_queue;
+  }
+
+ private:
+  const std::unique_ptr<TaskQueueFactory> factory_;
+  const ThreadPolicy policy_;
+};
+
+}  // namespace
+
+const absl::optional<rtc::ThreadAttributes>& ThreadPolicy::ForRole(
+    ThreadRole role) const {
+  switch (role) {
+    case ThreadRole::kNetwork:
+      return network;
+    case ThreadRole::kWorker:
+      return worker;
+    case ThreadRole::kVideoEncoder:
+      return video_encoder;
+    case ThreadRole::kVideoDecoder:
+      return video_decoder;
+    case ThreadRole::kAudio:
+      return audio;
+  }
+  RTC_CHECK_NOTREACHED();
+}
+
+bool ThreadPolicy::IsEmpty() const {
+  return !network && !worker && !video_encoder && !video_decoder && !audio;
+}
+
+absl::optional<ThreadRole> ThreadRoleForTaskQueue(
+    absl::string_view task_queue_name) {
+  if (task_queue_name == "EncoderQueue") {
+    return ThreadRole::kVideoEncoder;
+  }
+  if (task_queue_name == "DecodingQueue") {
+    return ThreadRole::kVideoDecoder;
+  }
+  if (task_queue_name == "AudioEncoder" ||
+      task_queue_name == "AsyncAudioProcessing") {
+    return ThreadRole::kAudio;
+  }
+  return absl::nullopt;
+}
+
+void ApplyThreadAttributes(const rtc::ThreadAttributes& attributes,
+                           absl::string_view thread_name) {
+  if (!rtc::SetCurrentThreadAttributes(attributes)) {
+    RTC_LOG(LS_WARNING) << "Failed to apply the thread policy to "
+                        << thread_name;
+  }
+}
+
+std::unique_ptr<TaskQueueFactory> CreateThreadPolicyTaskQueueFactory(
+    std::unique_ptr<TaskQueueFactory> factory,
+    const ThreadPolicy& policy) {
+  return std::make_unique<ThreadPolicyTaskQueueFactory>(std::move(factory),
+                                                        policy);
+}
+
+}  // namespace webrtc
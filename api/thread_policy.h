@@ -0,0 +1,73 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef API_THREAD_POLICY_H_
+#define API_THREAD_POLICY_H_
+
+#include <memory>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "api/task_queue/task_queue_factory.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/system/rtc_export.h"
+
+namespace webrtc {
+
+// Roles of the threads WebRTC starts, see ThreadPolicy.
+enum class ThreadRole {
+  // The network threads started by the PeerConnectionFactory.
+  kNetwork,
+  // The worker thread started by the PeerConnectionFactory, which also runs
+  // the pacers.
+  kWorker,
+  // Video encoder task queues.
+  kVideoEncoder,
+  // Video decoder task queues.
+  kVideoDecoder,
+  // Audio encoder and audio processing task queues. The capture and playout
+  // threads of audio device modules are set up by the modules themselves.
+  kAudio,
+};
+
+// Priority, scheduling policy and CPU affinity of the threads WebRTC starts,
+// by role. Roles without attributes keep the defaults. Threads injected by the
+// application are left alone. Real-time scheduling usually requires a
+// privilege; attributes that cannot be applied are logged and ignored.
+struct RTC_EXPORT ThreadPolicy {
+  absl::optional<rtc::ThreadAttributes> network;
+  absl::optional<rtc::ThreadAttributes> worker;
+  absl::optional<rtc::ThreadAttributes> video_encoder;
+  absl::optional<rtc::ThreadAttributes> video_decoder;
+  absl::optional<rtc::ThreadAttributes> audio;
+
+  const absl::optional<rtc::ThreadAttributes>& ForRole(ThreadRole role) const;
+  bool IsEmpty() const;
+};
+
+// Returns the role of the task queues WebRTC creates with the name
+// `task_queue_name`, if they have one.
+RTC_EXPORT absl::optional<ThreadRole> ThreadRoleForTaskQueue(
+    absl::string_view task_queue_name);
+
+// Applies `attributes` to the calling thread, logging a failure as a warning.
+RTC_EXPORT void ApplyThreadAttributes(const rtc::ThreadAttributes& attributes,
+                                      absl::string_view thread_name);
+
+// Returns a factory creating the task queues of `factory`, on whose threads it
+// applies the attributes `policy` has for their role. Needs a factory that
+// runs each task queue on a thread of its own.
+RTC_EXPORT std::unique_ptr<TaskQueueFactory>
+CreateThreadPolicyTaskQueueFactory(std::unique_ptr<TaskQueueFactory> factory,
+                                   const ThreadPolicy& policy);
+
+}  // namespace webrtc
+
+#endif  // API_THREAD_POLICY_H_
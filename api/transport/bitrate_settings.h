@@ -31,6 +31,14 @@ struct RTC_EXPORT BitrateSettings {
   absl::optional<int> min_bitrate_bps;
   absl::optional<int> start_bitrate_bps;
   absl::optional<int> max_bitrate_bps;
+  // Capacity of the path to the remote peer that is already known to the
+  // application, e.g. from a previous session or from a server side
+  // measurement. When set, bandwidth estimation starts at
+  // `capacity_hint_confidence` times the hint and verifies it with a single
+  // probe instead of the initial exponential probing.
+  absl::optional<int> capacity_hint_bps;
+  // How much `capacity_hint_bps` can be trusted, in the range (0, 1].
+  double capacity_hint_confidence = 1.0;
 };
 
 // TODO(srte): BitrateConstraints and BitrateSettings should be merged.
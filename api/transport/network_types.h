@@ -64,6 +64,9 @@ struct TargetRateConstraints {
   // The initial bandwidth estimate to base target rate on. This should be used
   // as the basis for initial OnTargetTransferRate and OnPacerConfig callbacks.
   absl::optional<DataRate> starting_rate;
+  // Capacity of the path reported by the application. If set, the initial
+  // exponential probing is replaced by a single probe at this rate.
+  absl::optional<DataRate> capacity_hint;
 };
 
 // Send side information
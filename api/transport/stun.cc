@@ -24,6 +24,7 @@
 #include "rtc_base/helpers.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/message_digest.h"
+#include "rtc_base/openssl_digest.h"
 #include "system_wrappers/include/metrics.h"
 
 using rtc::ByteBufferReader;
@@ -85,6 +86,33 @@ bool LengthValid(int type, int length) {
   return true;
 }
 
+// Computes the HMAC of the MESSAGE-INTEGRITY attribute at offset `mi_pos` of
+// the STUN message `data`, with a value of `mi_attr_size` bytes. As outlined in
+// RFC 5389, section 15.4, the HMAC covers the message up to the attribute, with
+// the length in the header adjusted to end with the attribute. Only the header
+// is copied to adjust it.
+bool ComputeMessageIntegrity(const uint8_t* data,
+                             size_t mi_pos,
+                             size_t mi_attr_size,
+                             absl::string_view password,
+                             uint8_t hmac[kStunMessageIntegritySize]) {
+  RTC_DCHECK_GE(mi_pos, kStunHeaderSize);
+  uint8_t header[kStunHeaderSize];
+  memcpy(header, data, kStunHeaderSize);
+  rtc::SetBE16(header + 2,
+               static_cast<uint16_t>(mi_pos - kStunHeaderSize +
+                                     kStunAttributeHeaderSize + mi_attr_size));
+  const rtc::ArrayView<const uint8_t> input_segments[] = {
+      header, rtc::MakeArrayView(data + kStunHeaderSize,
+                                 mi_pos - kStunHeaderSize)};
+  rtc::OpenSSLDigest digest(rtc::DIGEST_SHA_1);
+  size_t ret =
+      rtc::ComputeHmac(&digest, password.data(), password.size(),
+                       input_segments, hmac, kStunMessageIntegritySize);
+  RTC_DCHECK(ret == kStunMessageIntegritySize);
+  return ret == kStunMessageIntegritySize;
+}
+
 }  // namespace
 
 const char STUN_ERROR_REASON_TRY_ALTERNATE_SERVER[] = "Try Alternate Server";
@@ -381,7 +409,7 @@ bool StunMessage::ValidateMessageIntegrityOfType(int mi_attr_type,
                                                  size_t mi_attr_size,
                                                  const char* data,
                                                  size_t size,
-                                                 const std::string& password) {
+                                                 absl::string_view password) {
   RTC_DCHECK(mi_attr_size <= kStunMessageIntegritySize);
 
   // Verifying the size of the message.
@@ -426,32 +454,9 @@ bool StunMessage::ValidateMessageIntegrityOfType(int mi_attr_type,
     return false;
   }
 
-  // Getting length of the message to calculate Message Integrity.
-  size_t mi_pos = current_pos;
-  std::unique_ptr<char[]> temp_data(new char[current_pos]);
-  memcpy(temp_data.get(), data, current_pos);
-  if (size > mi_pos + kStunAttributeHeaderSize + mi_attr_size) {
-    // Stun message has other attributes after message integrity.
-    // Adjust the length parameter in stun message to calculate HMAC.
-    size_t extra_offset =
-        size - (mi_pos + kStunAttributeHeaderSize + mi_attr_size);
-    size_t new_adjusted_len = size - extra_offset - kStunHeaderSize;
-
-    // Writing new length of the STUN message @ Message Length in temp buffer.
-    //      0                   1                   2                   3
-    //      0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
-    //     +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-    //     |0 0|     STUN Message Type     |         Message Length        |
-    //     +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-    rtc::SetBE16(temp_data.get() + 2, static_cast<uint16_t>(new_adjusted_len));
-  }
-
-  char hmac[kStunMessageIntegritySize];
-  size_t ret =
-      rtc::ComputeHmac(rtc::DIGEST_SHA_1, password.c_str(), password.size(),
-                       temp_data.get(), mi_pos, hmac, sizeof(hmac));
-  RTC_DCHECK(ret == sizeof(hmac));
-  if (ret != sizeof(hmac)) {
+  uint8_t hmac[kStunMessageIntegritySize];
+  if (!ComputeMessageIntegrity(reinterpret_cast<const uint8_t*>(data),
+                               current_pos, mi_attr_size, password, hmac)) {
     return false;
   }
 
@@ -1431,6 +1436,353 @@ std::unique_ptr<StunAttribute> CopyStunAttribute(
   return copy;
 }
 
+namespace {
+
+// Returns the address of an address attribute value, with its port and IP
+// XORed with `xor_key` when it isn't null. The key is the magic cookie followed
+// by the 12 byte transaction ID, as outlined in RFC 5389, section 15.2.
+absl::optional<rtc::SocketAddress> ReadAddress(
+    rtc::ArrayView<const uint8_t> value,
+    const uint8_t* xor_key) {
+  if (value.size() < StunAddressAttribute::SIZE_IP4) {
+    return absl::nullopt;
+  }
+  uint8_t address[StunAddressAttribute::SIZE_IP6 - 4];
+  const size_t address_size = value.size() - 4;
+  if (!(value[1] == STUN_ADDRESS_IPV4 && address_size == sizeof(in_addr)) &&
+      !(value[1] == STUN_ADDRESS_IPV6 && address_size == sizeof(in6_addr))) {
+    return absl::nullopt;
+  }
+  uint16_t port = rtc::GetBE16(&value[2]);
+  memcpy(address, &value[4], address_size);
+  if (xor_key) {
+    port ^= rtc::GetBE16(xor_key);
+    for (size_t i = 0; i < address_size; ++i) {
+      address[i] ^= xor_key[i];
+    }
+  }
+  if (address_size == sizeof(in_addr)) {
+    in_addr v4addr;
+    memcpy(&v4addr, address, sizeof(v4addr));
+    return rtc::SocketAddress(rtc::IPAddress(v4addr), port);
+  }
+  in6_addr v6addr;
+  memcpy(&v6addr, address, sizeof(v6addr));
+  return rtc::SocketAddress(rtc::IPAddress(v6addr), port);
+}
+
+}  // namespace
+
+// StunMessageView
+
+absl::optional<StunMessageView> StunMessageView::Create(
+    rtc::ArrayView<const uint8_t> data) {
+  // RTP and RTCP set the MSB of the first byte, which is never set in STUN.
+  if (data.size() < kStunHeaderSize || (data[0] & 0x80) != 0 ||
+      rtc::GetBE16(&data[2]) != data.size() - kStunHeaderSize) {
+    return absl::nullopt;
+  }
+  // The attributes, with their padding, must fill the message exactly.
+  size_t pos = kStunHeaderSize;
+  while (pos < data.size()) {
+    if (data.size() - pos < kStunAttributeHeaderSize) {
+      return absl::nullopt;
+    }
+    const size_t padded_length = (rtc::GetBE16(&data[pos + 2]) + 3) & ~3;
+    pos += kStunAttributeHeaderSize;
+    if (data.size() - pos < padded_length) {
+      return absl::nullopt;
+    }
+    pos += padded_length;
+  }
+  return StunMessageView(data);
+}
+
+bool StunMessageView::IsLegacy() const {
+  return rtc::GetBE32(&data_[kStunTransactionIdOffset -
+                             kStunMagicCookieLength]) != kStunMagicCookie;
+}
+
+absl::string_view StunMessageView::transaction_id() const {
+  const size_t offset = IsLegacy()
+                            ? kStunHeaderSize - kStunLegacyTransactionIdLength
+                            : kStunTransactionIdOffset;
+  return absl::string_view(reinterpret_cast<const char*>(&data_[offset]),
+                           kStunHeaderSize - offset);
+}
+
+size_t StunMessageView::FindAttribute(uint16_t type) const {
+  // The framing was checked by Create().
+  size_t pos = kStunHeaderSize;
+  while (pos < data_.size()) {
+    if (rtc::GetBE16(&data_[pos]) == type) {
+      return pos;
+    }
+    const size_t padded_length = (rtc::GetBE16(&data_[pos + 2]) + 3) & ~3;
+    pos += kStunAttributeHeaderSize + padded_length;
+  }
+  return 0;
+}
+
+absl::optional<rtc::ArrayView<const uint8_t>> StunMessageView::GetAttribute(
+    uint16_t type) const {
+  const size_t pos = FindAttribute(type);
+  if (pos == 0) {
+    return absl::nullopt;
+  }
+  return data_.subview(pos + kStunAttributeHeaderSize,
+                       rtc::GetBE16(&data_[pos + 2]));
+}
+
+absl::optional<uint32_t> StunMessageView::GetUInt32(uint16_t type) const {
+  const auto value = GetAttribute(type);
+  if (!value || value->size() != StunUInt32Attribute::SIZE) {
+    return absl::nullopt;
+  }
+  return rtc::GetBE32(value->data());
+}
+
+absl::optional<uint64_t> StunMessageView::GetUInt64(uint16_t type) const {
+  const auto value = GetAttribute(type);
+  if (!value || value->size() != StunUInt64Attribute::SIZE) {
+    return absl::nullopt;
+  }
+  return rtc::GetBE64(value->data());
+}
+
+absl::optional<absl::string_view> StunMessageView::GetByteString(
+    uint16_t type) const {
+  const auto value = GetAttribute(type);
+  if (!value) {
+    return absl::nullopt;
+  }
+  return absl::string_view(reinterpret_cast<const char*>(value->data()),
+                           value->size());
+}
+
+absl::optional<rtc::SocketAddress> StunMessageView::GetAddress(
+    uint16_t type) const {
+  const auto value = GetAttribute(type);
+  if (!value) {
+    return absl::nullopt;
+  }
+  return ReadAddress(*value, /*xor_key=*/nullptr);
+}
+
+absl::optional<rtc::SocketAddress> StunMessageView::GetXorAddress(
+    uint16_t type) const {
+  const auto value = GetAttribute(type);
+  if (!value) {
+    return absl::nullopt;
+  }
+  uint8_t xor_key[kStunMagicCookieLength + kStunTransactionIdLength];
+  rtc::SetBE32(xor_key, kStunMagicCookie);
+  if (IsLegacy()) {
+    // Like StunXorAddressAttribute, only IPv4 addresses can be XORed without
+    // a 12 byte transaction ID.
+    if (value->size() != StunAddressAttribute::SIZE_IP4) {
+      return absl::nullopt;
+    }
+  } else {
+    memcpy(&xor_key[kStunMagicCookieLength], &data_[kStunTransactionIdOffset],
+           kStunTransactionIdLength);
+  }
+  return ReadAddress(*value, xor_key);
+}
+
+int StunMessageView::GetErrorCodeValue() const {
+  const auto value = GetAttribute(STUN_ATTR_ERROR_CODE);
+  if (!value || value->size() < StunErrorCodeAttribute::MIN_SIZE) {
+    return STUN_ERROR_GLOBAL_FAILURE;
+  }
+  return ((*value)[2] & 0x7) * 100 + (*value)[3];
+}
+
+StunMessage::IntegrityStatus StunMessageView::ValidateMessageIntegrity(
+    absl::string_view password) const {
+  uint16_t mi_attr_type = STUN_ATTR_MESSAGE_INTEGRITY;
+  size_t mi_attr_size = kStunMessageIntegritySize;
+  size_t mi_pos = FindAttribute(mi_attr_type);
+  if (mi_pos == 0) {
+    mi_attr_type = STUN_ATTR_GOOG_MESSAGE_INTEGRITY_32;
+    mi_attr_size = kStunMessageIntegrity32Size;
+    mi_pos = FindAttribute(mi_attr_type);
+  }
+  if (mi_pos == 0) {
+    return StunMessage::IntegrityStatus::kNoIntegrity;
+  }
+  uint8_t hmac[kStunMessageIntegritySize];
+  if (rtc::GetBE16(&data_[mi_pos + 2]) != mi_attr_size ||
+      !ComputeMessageIntegrity(data_.data(), mi_pos, mi_attr_size, password,
+                               hmac) ||
+      memcmp(&data_[mi_pos + kStunAttributeHeaderSize], hmac, mi_attr_size) !=
+          0) {
+    return StunMessage::IntegrityStatus::kIntegrityBad;
+  }
+  return StunMessage::IntegrityStatus::kIntegrityOk;
+}
+
+bool StunMessageView::ValidateFingerprint() const {
+  return StunMessage::ValidateFingerprint(
+      reinterpret_cast<const char*>(data_.data()), data_.size());
+}
+
+// StunMessageBuilder
+
+StunMessageBuilder::StunMessageBuilder(rtc::ArrayView<uint8_t> buffer,
+                                       uint16_t type,
+                                       absl::string_view transaction_id)
+    : buffer_(buffer), size_(kStunHeaderSize) {
+  RTC_DCHECK_GE(buffer.size(), kStunHeaderSize);
+  RTC_DCHECK_EQ(transaction_id.size(), kStunTransactionIdLength);
+  rtc::SetBE16(&buffer_[0], type);
+  rtc::SetBE16(&buffer_[2], 0);
+  rtc::SetBE32(&buffer_[4], kStunMagicCookie);
+  memcpy(&buffer_[kStunTransactionIdOffset], transaction_id.data(),
+         kStunTransactionIdLength);
+}
+
+uint8_t* StunMessageBuilder::AddAttribute(uint16_t type, size_t length) {
+  const size_t padded_length = (length + 3) & ~3;
+  if (length > 0xFFFF ||
+      buffer_.size() - size_ < kStunAttributeHeaderSize + padded_length ||
+      size_ + kStunAttributeHeaderSize + padded_length - kStunHeaderSize >
+          0xFFFF) {
+    return nullptr;
+  }
+  uint8_t* attribute = &buffer_[size_];
+  rtc::SetBE16(attribute, type);
+  rtc::SetBE16(attribute + 2, static_cast<uint16_t>(length));
+  memset(attribute + kStunAttributeHeaderSize + length, 0,
+         padded_length - length);
+  size_ += kStunAttributeHeaderSize + padded_length;
+  rtc::SetBE16(&buffer_[2], static_cast<uint16_t>(size_ - kStunHeaderSize));
+  return attribute + kStunAttributeHeaderSize;
+}
+
+bool StunMessageBuilder::AddUInt32(uint16_t type, uint32_t value) {
+  uint8_t* attribute = AddAttribute(type, StunUInt32Attribute::SIZE);
+  if (!attribute) {
+    return false;
+  }
+  rtc::SetBE32(attribute, value);
+  return true;
+}
+
+bool StunMessageBuilder::AddUInt64(uint16_t type, uint64_t value) {
+  uint8_t* attribute = AddAttribute(type, StunUInt64Attribute::SIZE);
+  if (!attribute) {
+    return false;
+  }
+  rtc::SetBE64(attribute, value);
+  return true;
+}
+
+bool StunMessageBuilder::AddByteString(uint16_t type,
+                                       absl::string_view value) {
+  uint8_t* attribute = AddAttribute(type, value.size());
+  if (!attribute) {
+    return false;
+  }
+  memcpy(attribute, value.data(), value.size());
+  return true;
+}
+
+bool StunMessageBuilder::AddAddress(uint16_t type,
+                                    const rtc::SocketAddress& address) {
+  return AddAddressOfType(type, address, /*xor_address=*/false);
+}
+
+bool StunMessageBuilder::AddXorAddress(uint16_t type,
+                                       const rtc::SocketAddress& address) {
+  return AddAddressOfType(type, address, /*xor_address=*/true);
+}
+
+bool StunMessageBuilder::AddAddressOfType(uint16_t type,
+                                          const rtc::SocketAddress& address,
+                                          bool xor_address) {
+  uint8_t family;
+  uint8_t ip[sizeof(in6_addr)];
+  size_t ip_size;
+  switch (address.family()) {
+    case AF_INET: {
+      const in_addr v4addr = address.ipaddr().ipv4_address();
+      family = STUN_ADDRESS_IPV4;
+      ip_size = sizeof(v4addr);
+      memcpy(ip, &v4addr, ip_size);
+      break;
+    }
+    case AF_INET6: {
+      const in6_addr v6addr = address.ipaddr().ipv6_address();
+      family = STUN_ADDRESS_IPV6;
+      ip_size = sizeof(v6addr);
+      memcpy(ip, &v6addr, ip_size);
+      break;
+    }
+    default:
+      RTC_LOG(LS_ERROR) << "Error writing address attribute: unknown family.";
+      return false;
+  }
+  uint8_t* attribute = AddAttribute(type, 4 + ip_size);
+  if (!attribute) {
+    return false;
+  }
+  // The magic cookie and the transaction ID follow each other in the header.
+  const uint8_t* xor_key = &buffer_[kStunTransactionIdOffset -
+                                    kStunMagicCookieLength];
+  attribute[0] = 0;
+  attribute[1] = family;
+  rtc::SetBE16(&attribute[2],
+               xor_address ? address.port() ^ rtc::GetBE16(xor_key)
+                           : address.port());
+  for (size_t i = 0; i < ip_size; ++i) {
+    attribute[4 + i] = xor_address ? ip[i] ^ xor_key[i] : ip[i];
+  }
+  return true;
+}
+
+bool StunMessageBuilder::AddMessageIntegrity(absl::string_view password) {
+  return AddMessageIntegrityOfType(STUN_ATTR_MESSAGE_INTEGRITY,
+                                   kStunMessageIntegritySize, password);
+}
+
+bool StunMessageBuilder::AddMessageIntegrity32(absl::string_view password) {
+  return AddMessageIntegrityOfType(STUN_ATTR_GOOG_MESSAGE_INTEGRITY_32,
+                                   kStunMessageIntegrity32Size, password);
+}
+
+bool StunMessageBuilder::AddMessageIntegrityOfType(uint16_t type,
+                                                   size_t size,
+                                                   absl::string_view password) {
+  const size_t mi_pos = size_;
+  uint8_t* attribute = AddAttribute(type, size);
+  uint8_t hmac[kStunMessageIntegritySize];
+  if (!attribute) {
+    return false;
+  }
+  if (!ComputeMessageIntegrity(buffer_.data(), mi_pos, size, password, hmac)) {
+    // Leave the message unchanged.
+    size_ = mi_pos;
+    rtc::SetBE16(&buffer_[2], static_cast<uint16_t>(size_ - kStunHeaderSize));
+    return false;
+  }
+  memcpy(attribute, hmac, size);
+  return true;
+}
+
+bool StunMessageBuilder::AddFingerprint() {
+  const size_t fingerprint_pos = size_;
+  uint8_t* attribute =
+      AddAttribute(STUN_ATTR_FINGERPRINT, StunUInt32Attribute::SIZE);
+  if (!attribute) {
+    return false;
+  }
+  rtc::SetBE32(attribute,
+               rtc::ComputeCrc32(buffer_.data(), fingerprint_pos) ^
+                   STUN_FINGERPRINT_XOR_VALUE);
+  return true;
+}
+
 StunAttributeValueType RelayMessage::GetAttributeValueType(int type) const {
   switch (type) {
     case STUN_ATTR_LIFETIME:
@@ -23,8 +23,10 @@
 #include <vector>
 
 #include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
 #include "api/array_view.h"
 #include "rtc_base/byte_buffer.h"
+#include "rtc_base/byte_order.h"
 #include "rtc_base/ip_address.h"
 #include "rtc_base/socket_address.h"
 
@@ -327,7 +329,7 @@ class StunMessage {
                                              size_t mi_attr_size,
                                              const char* data,
                                              size_t size,
-                                             const std::string& password);
+                                             absl::string_view password);
 
   uint16_t type_ = STUN_INVALID_MESSAGE_TYPE;
   uint16_t length_ = 0;
@@ -645,6 +647,106 @@ std::unique_ptr<StunAttribute> CopyStunAttribute(
     const StunAttribute& attribute,
     rtc::ByteBufferWriter* tmp_buffer_ptr = 0);
 
+// A read-only view of a serialized STUN message, which parses the message in
+// place. Creating the view only checks the framing of the header and of the
+// attributes; attributes are then looked up and decoded on demand, without
+// allocating. This is meant for the hot receive paths, where StunMessage would
+// allocate every attribute. `data` must outlive the view.
+class StunMessageView {
+ public:
+  // Returns a view of `data` if it holds one complete STUN message, and
+  // nullopt otherwise.
+  static absl::optional<StunMessageView> Create(
+      rtc::ArrayView<const uint8_t> data);
+
+  uint16_t type() const { return rtc::GetBE16(data_.data()); }
+  size_t length() const { return data_.size() - kStunHeaderSize; }
+  rtc::ArrayView<const uint8_t> data() const { return data_; }
+
+  // Returns true if the message has no magic cookie (RFC 3489), in which case
+  // the transaction ID is 16 bytes long.
+  bool IsLegacy() const;
+  absl::string_view transaction_id() const;
+
+  // Returns the value of the first attribute of type `type`, without padding,
+  // or nullopt if there is none.
+  absl::optional<rtc::ArrayView<const uint8_t>> GetAttribute(
+      uint16_t type) const;
+
+  // Decode the value of the first attribute of type `type`. Return nullopt if
+  // there is none or if it is malformed.
+  absl::optional<uint32_t> GetUInt32(uint16_t type) const;
+  absl::optional<uint64_t> GetUInt64(uint16_t type) const;
+  absl::optional<absl::string_view> GetByteString(uint16_t type) const;
+  absl::optional<rtc::SocketAddress> GetAddress(uint16_t type) const;
+  absl::optional<rtc::SocketAddress> GetXorAddress(uint16_t type) const;
+
+  // Returns the code inside the error code attribute, if present, and
+  // STUN_ERROR_GLOBAL_FAILURE otherwise.
+  int GetErrorCodeValue() const;
+
+  // Same as StunMessage::ValidateMessageIntegrity(), without the histograms.
+  // Never returns kNotSet.
+  StunMessage::IntegrityStatus ValidateMessageIntegrity(
+      absl::string_view password) const;
+
+  // Same as StunMessage::ValidateFingerprint() on the message.
+  bool ValidateFingerprint() const;
+
+ private:
+  explicit StunMessageView(rtc::ArrayView<const uint8_t> data) : data_(data) {}
+
+  // Returns the offset of the header of the first attribute of type `type`, or
+  // 0 if there is none.
+  size_t FindAttribute(uint16_t type) const;
+
+  rtc::ArrayView<const uint8_t> data_;
+};
+
+// Writes a STUN message into a buffer provided by the caller, so that no
+// allocation is needed to send one. Attributes are written in the order in
+// which they are added, and MESSAGE-INTEGRITY and FINGERPRINT must be added
+// last, like with StunMessage. The Add methods return false, and leave the
+// message unchanged, if the attribute doesn't fit in the buffer.
+class StunMessageBuilder {
+ public:
+  // Starts a message of type `type` with the 12 byte transaction ID
+  // `transaction_id` in `buffer`, which must hold at least kStunHeaderSize
+  // bytes and outlive the builder.
+  StunMessageBuilder(rtc::ArrayView<uint8_t> buffer,
+                     uint16_t type,
+                     absl::string_view transaction_id);
+
+  bool AddUInt32(uint16_t type, uint32_t value);
+  bool AddUInt64(uint16_t type, uint64_t value);
+  bool AddByteString(uint16_t type, absl::string_view value);
+  bool AddAddress(uint16_t type, const rtc::SocketAddress& address);
+  bool AddXorAddress(uint16_t type, const rtc::SocketAddress& address);
+  bool AddMessageIntegrity(absl::string_view password);
+  bool AddMessageIntegrity32(absl::string_view password);
+  bool AddFingerprint();
+
+  // Returns the message written so far.
+  rtc::ArrayView<const uint8_t> message() const {
+    return buffer_.subview(0, size_);
+  }
+
+ private:
+  // Writes the header of an attribute with a value of `length` bytes, and
+  // updates the message length. Returns a pointer to the value, which is
+  // followed by zeroed padding, or nullptr if the attribute doesn't fit.
+  uint8_t* AddAttribute(uint16_t type, size_t length);
+  bool AddAddressOfType(uint16_t type,
+                        const rtc::SocketAddress& address,
+                        bool xor_address);
+  bool AddMessageIntegrityOfType(uint16_t type,
+                                 size_t size,
+                                 absl::string_view password);
+
+  const rtc::ArrayView<uint8_t> buffer_;
+  size_t size_ = 0;
+};
+
 // TODO(?): Move the TURN/ICE stuff below out to separate files.
 extern const char TURN_MAGIC_COOKIE_VALUE[4];
 
@@ -1867,4 +1867,165 @@ TEST_F(StunTest, ValidateMessageIntegrityWithParser) {
   EXPECT_EQ(webrtc::metrics::NumSamples("WebRTC.Stun.Integrity.Request"), 2);
 }
 
+TEST_F(StunTest, ViewOfRfc5769Request) {
+  absl::optional<StunMessageView> view =
+      StunMessageView::Create(kRfc5769SampleRequest);
+  ASSERT_TRUE(view);
+  EXPECT_EQ(view->type(), STUN_BINDING_REQUEST);
+  EXPECT_EQ(view->length(), sizeof(kRfc5769SampleRequest) - kStunHeaderSize);
+  EXPECT_FALSE(view->IsLegacy());
+  EXPECT_EQ(view->transaction_id(),
+            absl::string_view(
+                reinterpret_cast<const char*>(kRfc5769SampleMsgTransactionId),
+                kStunTransactionIdLength));
+  EXPECT_EQ(view->GetByteString(STUN_ATTR_SOFTWARE),
+            kRfc5769SampleMsgClientSoftware);
+  EXPECT_EQ(view->GetByteString(STUN_ATTR_USERNAME), kRfc5769SampleMsgUsername);
+  EXPECT_EQ(view->GetUInt32(STUN_ATTR_PRIORITY), 0x6e0001ffu);
+  EXPECT_EQ(view->GetUInt64(STUN_ATTR_ICE_CONTROLLED), 0x932ff9b151263b36u);
+  EXPECT_FALSE(view->GetByteString(STUN_ATTR_NONCE));
+  EXPECT_TRUE(view->ValidateFingerprint());
+  EXPECT_EQ(view->ValidateMessageIntegrity(kRfc5769SampleMsgPassword),
+            StunMessage::IntegrityStatus::kIntegrityOk);
+  EXPECT_EQ(view->ValidateMessageIntegrity("InvalidPassword"),
+            StunMessage::IntegrityStatus::kIntegrityBad);
+}
+
+TEST_F(StunTest, ViewValidatesMessageIntegrity32) {
+  absl::optional<StunMessageView> view =
+      StunMessageView::Create(kSampleRequestMI32);
+  ASSERT_TRUE(view);
+  EXPECT_EQ(view->ValidateMessageIntegrity(kRfc5769SampleMsgPassword),
+            StunMessage::IntegrityStatus::kIntegrityOk);
+  EXPECT_EQ(view->ValidateMessageIntegrity("InvalidPassword"),
+            StunMessage::IntegrityStatus::kIntegrityBad);
+
+  view = StunMessageView::Create(kRfc5769SampleRequestWithoutMI);
+  ASSERT_TRUE(view);
+  EXPECT_EQ(view->ValidateMessageIntegrity(kRfc5769SampleMsgPassword),
+            StunMessage::IntegrityStatus::kNoIntegrity);
+}
+
+TEST_F(StunTest, ViewOfRfc5769Responses) {
+  absl::optional<StunMessageView> view =
+      StunMessageView::Create(kRfc5769SampleResponse);
+  ASSERT_TRUE(view);
+  EXPECT_EQ(view->type(), STUN_BINDING_RESPONSE);
+  EXPECT_EQ(view->GetXorAddress(STUN_ATTR_XOR_MAPPED_ADDRESS),
+            kRfc5769SampleMsgMappedAddress);
+  EXPECT_EQ(view->ValidateMessageIntegrity(kRfc5769SampleMsgPassword),
+            StunMessage::IntegrityStatus::kIntegrityOk);
+
+  view = StunMessageView::Create(kRfc5769SampleResponseIPv6);
+  ASSERT_TRUE(view);
+  EXPECT_EQ(view->GetXorAddress(STUN_ATTR_XOR_MAPPED_ADDRESS),
+            kRfc5769SampleMsgIPv6MappedAddress);
+}
+
+TEST_F(StunTest, ViewOfAddressAndErrorAttributes) {
+  absl::optional<StunMessageView> view =
+      StunMessageView::Create(kStunMessageWithIPv4MappedAddress);
+  ASSERT_TRUE(view);
+  rtc::IPAddress test_ip(kIPv4TestAddress1);
+  EXPECT_EQ(view->GetAddress(STUN_ATTR_MAPPED_ADDRESS),
+            rtc::SocketAddress(test_ip, kTestMessagePort4));
+
+  view = StunMessageView::Create(kStunMessageWithIPv6XorMappedAddress);
+  ASSERT_TRUE(view);
+  test_ip = rtc::IPAddress(kIPv6TestAddress1);
+  EXPECT_EQ(view->GetXorAddress(STUN_ATTR_XOR_MAPPED_ADDRESS),
+            rtc::SocketAddress(test_ip, kTestMessagePort1));
+
+  view = StunMessageView::Create(kStunMessageWithErrorAttribute);
+  ASSERT_TRUE(view);
+  EXPECT_EQ(view->GetErrorCodeValue(), kTestErrorCode);
+}
+
+TEST_F(StunTest, ViewRejectsMalformedMessages) {
+  EXPECT_FALSE(StunMessageView::Create(kStunMessageWithExcessLength));
+  EXPECT_FALSE(StunMessageView::Create(kStunMessageWithSmallLength));
+  EXPECT_FALSE(StunMessageView::Create(kRtcpPacket));
+  EXPECT_FALSE(StunMessageView::Create(
+      rtc::MakeArrayView(kRfc5769SampleRequest, kStunHeaderSize - 1)));
+  // The last attribute is truncated.
+  uint8_t truncated[sizeof(kRfc5769SampleRequest)];
+  memcpy(truncated, kRfc5769SampleRequest, sizeof(truncated));
+  rtc::SetBE16(&truncated[2], sizeof(truncated) - kStunHeaderSize - 4);
+  EXPECT_FALSE(StunMessageView::Create(
+      rtc::MakeArrayView(truncated, sizeof(truncated) - 4)));
+}
+
+// Validate that the builder writes the same message as IceMessage.
+TEST_F(StunTest, BuilderMatchesStunMessage) {
+  const std::string transaction_id(
+      reinterpret_cast<const char*>(kRfc5769SampleMsgTransactionId),
+      kStunTransactionIdLength);
+  const rtc::SocketAddress address(rtc::IPAddress(kIPv6TestAddress1),
+                                   kTestMessagePort2);
+  for (bool message_integrity_32 : {false, true}) {
+    SCOPED_TRACE(message_integrity_32);
+    IceMessage msg(STUN_BINDING_RESPONSE, transaction_id);
+    msg.AddAttribute(std::make_unique<StunByteStringAttribute>(
+        STUN_ATTR_USERNAME, kTestUserName2));
+    msg.AddAttribute(
+        std::make_unique<StunUInt32Attribute>(STUN_ATTR_PRIORITY, 12345));
+    msg.AddAttribute(std::make_unique<StunUInt64Attribute>(
+        STUN_ATTR_ICE_CONTROLLING, 0x0123456789abcdefu));
+    msg.AddAttribute(std::make_unique<StunXorAddressAttribute>(
+        STUN_ATTR_XOR_MAPPED_ADDRESS, address));
+    msg.AddAttribute(std::make_unique<StunAddressAttribute>(
+        STUN_ATTR_MAPPED_ADDRESS, kRfc5769SampleMsgMappedAddress));
+    if (message_integrity_32) {
+      ASSERT_TRUE(msg.AddMessageIntegrity32(kRfc5769SampleMsgPassword));
+    } else {
+      ASSERT_TRUE(msg.AddMessageIntegrity(kRfc5769SampleMsgPassword));
+    }
+    ASSERT_TRUE(msg.AddFingerprint());
+    rtc::ByteBufferWriter expected;
+    ASSERT_TRUE(msg.Write(&expected));
+
+    uint8_t buffer[256];
+    StunMessageBuilder builder(buffer, STUN_BINDING_RESPONSE, transaction_id);
+    EXPECT_TRUE(builder.AddByteString(STUN_ATTR_USERNAME, kTestUserName2));
+    EXPECT_TRUE(builder.AddUInt32(STUN_ATTR_PRIORITY, 12345));
+    EXPECT_TRUE(
+        builder.AddUInt64(STUN_ATTR_ICE_CONTROLLING, 0x0123456789abcdefu));
+    EXPECT_TRUE(builder.AddXorAddress(STUN_ATTR_XOR_MAPPED_ADDRESS, address));
+    EXPECT_TRUE(builder.AddAddress(STUN_ATTR_MAPPED_ADDRESS,
+                                   kRfc5769SampleMsgMappedAddress));
+    if (message_integrity_32) {
+      EXPECT_TRUE(builder.AddMessageIntegrity32(kRfc5769SampleMsgPassword));
+    } else {
+      EXPECT_TRUE(builder.AddMessageIntegrity(kRfc5769SampleMsgPassword));
+    }
+    EXPECT_TRUE(builder.AddFingerprint());
+    ASSERT_EQ(builder.message().size(), expected.Length());
+    EXPECT_EQ(memcmp(builder.message().data(), expected.Data(),
+                     expected.Length()),
+              0);
+
+    absl::optional<StunMessageView> view =
+        StunMessageView::Create(builder.message());
+    ASSERT_TRUE(view);
+    EXPECT_EQ(view->GetXorAddress(STUN_ATTR_XOR_MAPPED_ADDRESS), address);
+    EXPECT_EQ(view->ValidateMessageIntegrity(kRfc5769SampleMsgPassword),
+              StunMessage::IntegrityStatus::kIntegrityOk);
+    EXPECT_TRUE(view->ValidateFingerprint());
+  }
+}
+
+TEST_F(StunTest, BuilderLeavesMessageUnchangedWhenFull) {
+  uint8_t buffer[kStunHeaderSize + 8];
+  StunMessageBuilder builder(buffer, STUN_BINDING_REQUEST,
+                             StunMessage::GenerateTransactionId());
+  EXPECT_TRUE(builder.AddUInt32(STUN_ATTR_PRIORITY, 1));
+  EXPECT_FALSE(builder.AddUInt32(STUN_ATTR_PRIORITY, 2));
+  EXPECT_FALSE(builder.AddMessageIntegrity(kRfc5769SampleMsgPassword));
+  EXPECT_EQ(builder.message().size(), sizeof(buffer));
+  absl::optional<StunMessageView> view =
+      StunMessageView::Create(builder.message());
+  ASSERT_TRUE(view);
+  EXPECT_EQ(view->GetUInt32(STUN_ATTR_PRIORITY), 1u);
+}
+
 }  // namespace cricket
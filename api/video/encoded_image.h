@@ -17,6 +17,8 @@
 #include <utility>
 
 #include "absl/types/optional.h"
+#include "api/array_view.h"
+#include "api/function_view.h"
 #include "api/rtp_packet_infos.h"
 #include "api/scoped_refptr.h"
 #include "api/units/timestamp.h"
@@ -42,6 +44,15 @@ class EncodedImageBufferInterface : public rtc::RefCountInterface {
   // this non-const data method.
   virtual uint8_t* data() = 0;
   virtual size_t size() const = 0;
+
+  // Calls `callback` with consecutive chunks that together hold the same bytes
+  // as `data()`. Buffers that don't store their bytes contiguously implement
+  // this without copying, which `data()` can't. By default the whole buffer is
+  // passed as a single chunk.
+  virtual void ForEachChunk(
+      rtc::FunctionView<void(rtc::ArrayView<const uint8_t>)> callback) const {
+    callback(rtc::ArrayView<const uint8_t>(data(), size()));
+  }
 };
 
 // Basic implementation of EncodedImageBufferInterface.
@@ -136,6 +136,19 @@ rtc::scoped_refptr<I420BufferInterface> I010Buffer::ToI420() {
   return i420_buffer;
 }
 
+rtc::scoped_refptr<VideoFrameBuffer> I010Buffer::CropAndScale(
+    int offset_x,
+    int offset_y,
+    int crop_width,
+    int crop_height,
+    int scaled_width,
+    int scaled_height) {
+  rtc::scoped_refptr<I010Buffer> result =
+      I010Buffer::Create(scaled_width, scaled_height);
+  result->CropAndScaleFrom(*this, offset_x, offset_y, crop_width, crop_height);
+  return result;
+}
+
 int I010Buffer::width() const {
   return width_;
 }
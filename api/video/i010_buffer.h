@@ -40,6 +40,12 @@ class I010Buffer : public I010BufferInterface {
 
   // VideoFrameBuffer implementation.
   rtc::scoped_refptr<I420BufferInterface> ToI420() override;
+  rtc::scoped_refptr<VideoFrameBuffer> CropAndScale(int offset_x,
+                                                    int offset_y,
+                                                    int crop_width,
+                                                    int crop_height,
+                                                    int scaled_width,
+                                                    int scaled_height) override;
 
   // PlanarYuv16BBuffer implementation.
   int width() const override;
@@ -147,6 +147,19 @@ rtc::scoped_refptr<I420BufferInterface> I410Buffer::ToI420() {
   return i420_buffer;
 }
 
+rtc::scoped_refptr<VideoFrameBuffer> I410Buffer::CropAndScale(
+    int offset_x,
+    int offset_y,
+    int crop_width,
+    int crop_height,
+    int scaled_width,
+    int scaled_height) {
+  rtc::scoped_refptr<I410Buffer> result =
+      I410Buffer::Create(scaled_width, scaled_height);
+  result->CropAndScaleFrom(*this, offset_x, offset_y, crop_width, crop_height);
+  return result;
+}
+
 void I410Buffer::InitializeData() {
   memset(data_.get(), 0,
          I410DataSize(height_, stride_y_, stride_u_, stride_v_));
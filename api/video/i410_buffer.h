@@ -49,6 +49,12 @@ class RTC_EXPORT I410Buffer : public I410BufferInterface {
                                                VideoRotation rotation);
 
   rtc::scoped_refptr<I420BufferInterface> ToI420() final;
+  rtc::scoped_refptr<VideoFrameBuffer> CropAndScale(int offset_x,
+                                                    int offset_y,
+                                                    int crop_width,
+                                                    int crop_height,
+                                                    int scaled_width,
+                                                    int scaled_height) final;
   const I420BufferInterface* GetI420() const final { return nullptr; }
 
   // Sets all three planes to all zeros. Used to work around for
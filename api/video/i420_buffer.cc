@@ -18,6 +18,7 @@
 #include "rtc_base/checks.h"
 #include "third_party/libyuv/include/libyuv/convert.h"
 #include "third_party/libyuv/include/libyuv/planar_functions.h"
+#include "third_party/libyuv/include/libyuv/rotate.h"
 #include "third_party/libyuv/include/libyuv/scale.h"
 
 // Aligning pointer to 64 bytes for improved performance, e.g. use SIMD.
@@ -129,6 +130,34 @@ rtc::scoped_refptr<I420Buffer> I420Buffer::Rotate(
   return buffer;
 }
 
+// static
+rtc::scoped_refptr<I420Buffer> I420Buffer::Rotate(
+    const NV12BufferInterface& src,
+    VideoRotation rotation) {
+  RTC_CHECK(src.DataY());
+  RTC_CHECK(src.DataUV());
+
+  int rotated_width = src.width();
+  int rotated_height = src.height();
+  if (rotation == webrtc::kVideoRotation_90 ||
+      rotation == webrtc::kVideoRotation_270) {
+    std::swap(rotated_width, rotated_height);
+  }
+
+  rtc::scoped_refptr<webrtc::I420Buffer> buffer =
+      I420Buffer::Create(rotated_width, rotated_height);
+
+  RTC_CHECK_EQ(0, libyuv::NV12ToI420Rotate(
+                      src.DataY(), src.StrideY(), src.DataUV(),
+                      src.StrideUV(), buffer->MutableDataY(),
+                      buffer->StrideY(), buffer->MutableDataU(),
+                      buffer->StrideU(), buffer->MutableDataV(),
+                      buffer->StrideV(), src.width(), src.height(),
+                      static_cast<libyuv::RotationMode>(rotation)));
+
+  return buffer;
+}
+
 void I420Buffer::InitializeData() {
   memset(data_.get(), 0,
          I420DataSize(height_, stride_y_, stride_u_, stride_v_));
@@ -52,6 +52,9 @@ class RTC_EXPORT I420Buffer : public I420BufferInterface {
   // Returns a rotated copy of `src`.
   static rtc::scoped_refptr<I420Buffer> Rotate(const I420BufferInterface& src,
                                                VideoRotation rotation);
+  // Returns a rotated I420 copy of `src`, converted and rotated in one pass.
+  static rtc::scoped_refptr<I420Buffer> Rotate(const NV12BufferInterface& src,
+                                               VideoRotation rotation);
   // Deprecated.
   static rtc::scoped_refptr<I420Buffer> Rotate(const VideoFrameBuffer& src,
                                                VideoRotation rotation) {
@@ -31,6 +31,7 @@
 #include "modules/rtp_rtcp/source/video_rtp_depacketizer_vp9.h"
 #include "modules/video_coding/packet_buffer.h"
 #include "modules/video_coding/rtp_frame_reference_finder.h"
+#include "rtc_base/copy_on_write_buffer.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/numerics/sequence_number_unwrapper.h"
 
@@ -143,7 +144,7 @@ RtpVideoFrameAssembler::Impl::RtpFrameVector
 RtpVideoFrameAssembler::Impl::AssembleFrames(
     video_coding::PacketBuffer::InsertResult insert_result) {
   video_coding::PacketBuffer::Packet* first_packet = nullptr;
-  std::vector<rtc::ArrayView<const uint8_t>> payloads;
+  std::vector<rtc::CopyOnWriteBuffer> payloads;
   RtpFrameVector result;
 
   for (auto& packet : insert_result.packets) {
@@ -154,8 +155,8 @@ RtpVideoFrameAssembler::Impl::AssembleFrames(
     payloads.emplace_back(packet->video_payload);
 
     if (packet->is_last_packet_in_frame()) {
-      rtc::scoped_refptr<EncodedImageBuffer> bitstream =
-          depacketizer_->AssembleFrame(payloads);
+      rtc::scoped_refptr<EncodedImageBufferInterface> bitstream =
+          depacketizer_->AssembleFrameFromPayloads(payloads);
 
       if (!bitstream) {
         continue;
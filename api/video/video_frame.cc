@@ -300,6 +300,19 @@ VideoFrame::VideoFrame(uint16_t id,
 
 VideoFrame::~VideoFrame() = default;
 
+void VideoFrame::set_update_region(std::vector<UpdateRect> update_region) {
+  UpdateRect bounding_rect;
+  for (const UpdateRect& rect : update_region) {
+    RTC_DCHECK_GE(rect.offset_x, 0);
+    RTC_DCHECK_GE(rect.offset_y, 0);
+    RTC_DCHECK_LE(rect.offset_x + rect.width, width());
+    RTC_DCHECK_LE(rect.offset_y + rect.height, height());
+    bounding_rect.Union(rect);
+  }
+  update_rect_ = bounding_rect;
+  update_region_ = std::move(update_region);
+}
+
 VideoFrame::VideoFrame(const VideoFrame&) = default;
 VideoFrame::VideoFrame(VideoFrame&&) = default;
 VideoFrame& VideoFrame::operator=(const VideoFrame&) = default;
@@ -14,6 +14,7 @@
 #include <stdint.h>
 
 #include <utility>
+#include <vector>
 
 #include "absl/types/optional.h"
 #include "api/rtp_packet_infos.h"
@@ -261,9 +262,25 @@ class RTC_EXPORT VideoFrame {
     RTC_DCHECK_LE(update_rect.offset_x + update_rect.width, width());
     RTC_DCHECK_LE(update_rect.offset_y + update_rect.height, height());
     update_rect_ = update_rect;
+    update_region_.clear();
   }
 
-  void clear_update_rect() { update_rect_ = absl::nullopt; }
+  void clear_update_rect() {
+    update_rect_ = absl::nullopt;
+    update_region_.clear();
+  }
+
+  // Returns the rectangles whose union is the area updated since the last
+  // frame, e.g. the dirty region reported by a screen capturer. This is a more
+  // precise version of update_rect(). Empty if only update_rect() is known.
+  const std::vector<UpdateRect>& update_region() const {
+    return update_region_;
+  }
+
+  // Sets the updated area to the union of `update_region`, and update_rect()
+  // to its bounding box. Rectangles must be within the frame dimensions.
+  // Setting, or clearing, the update rect afterwards clears the region.
+  void set_update_region(std::vector<UpdateRect> update_region);
 
   // Get information about packets used to assemble this video frame. Might be
   // empty if the information isn't available.
@@ -314,6 +331,8 @@ class RTC_EXPORT VideoFrame {
   // If absent, it means that there's no information about the change at all and
   // update_rect() will return a rectangle corresponding to the entire frame.
   absl::optional<UpdateRect> update_rect_;
+  // Optional precise version of `update_rect_`, which is its bounding box.
+  std::vector<UpdateRect> update_region_;
   // Information about packets used to assemble this video frame. This is needed
   // by `SourceTracker` when the frame is delivered to the RTCRtpReceiver's
   // MediaStreamTrack, in order to implement getContributingSources(). See:
@@ -28,6 +28,13 @@ class VideoSinkInterface {
   // limiting.
   virtual void OnDiscardedFrame() {}
 
+  // May be called by the source, on the thread it delivers frames on, before
+  // it converts or scales a frame captured at `timestamp_us` (in the
+  // rtc::TimeMicros() time base) for this sink. Returns false if the sink will
+  // drop the frame anyway, in which case the source may skip producing it
+  // and call OnDiscardedFrame() instead of OnFrame().
+  virtual bool WantsFrame(int64_t timestamp_us) { return true; }
+
   // Called on the network thread when video constraints change.
   // TODO(crbug/1255737): make pure virtual once downstream project adapts.
   virtual void OnConstraintsChanged(
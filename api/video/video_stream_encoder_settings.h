@@ -44,6 +44,11 @@ struct VideoStreamEncoderSettings {
   // Ownership stays with WebrtcVideoEngine (delegated from PeerConnection).
   VideoEncoderFactory* encoder_factory = nullptr;
 
+  // Lets the encoder be shared with the send streams of other calls that
+  // encode the same source with identical settings, so that frames are encoded
+  // once for all of them.
+  bool share_encoder = false;
+
   // Requests the WebRtcVideoChannel to perform a codec switch.
   EncoderSwitchRequestCallback* encoder_switch_request_callback = nullptr;
 
@@ -101,7 +101,8 @@ VideoEncoder::EncoderInfo::EncoderInfo()
           1,
           kMaxFramerateFraction)},
       supports_simulcast(false),
-      preferred_pixel_formats{VideoFrameBuffer::Type::kI420} {}
+      preferred_pixel_formats{VideoFrameBuffer::Type::kI420},
+      num_threads(1) {}
 
 VideoEncoder::EncoderInfo::EncoderInfo(const EncoderInfo&) = default;
 
@@ -186,6 +187,7 @@ std::string VideoEncoder::EncoderInfo::ToString() const {
   if (is_qp_trusted.has_value()) {
     oss << ", is_qp_trusted = " << is_qp_trusted.value();
   }
+  oss << ", num_threads = " << num_threads;
   oss << "}";
   return oss.str();
 }
@@ -210,7 +212,8 @@ bool VideoEncoder::EncoderInfo::operator==(const EncoderInfo& rhs) const {
   if (supports_native_handle != rhs.supports_native_handle ||
       implementation_name != rhs.implementation_name ||
       has_trusted_rate_controller != rhs.has_trusted_rate_controller ||
-      is_hardware_accelerated != rhs.is_hardware_accelerated) {
+      is_hardware_accelerated != rhs.is_hardware_accelerated ||
+      num_threads != rhs.num_threads) {
     return false;
   }
 
@@ -325,8 +328,40 @@ int VideoEncoder::InitEncode(const VideoCodec* codec_settings,
 
 void VideoEncoder::OnPacketLossRateUpdate(float packet_loss_rate) {}
 
+bool VideoEncoder::UpdateActiveStreams(const VideoCodec& codec_settings) {
+  return false;
+}
+
 void VideoEncoder::OnRttUpdate(int64_t rtt_ms) {}
 
+VideoEncoder::Settings::ThreadingPolicy::ThreadingPolicy() = default;
+
+VideoEncoder::Settings::ThreadingPolicy::ThreadingPolicy(
+    const ThreadingPolicy&) = default;
+
+VideoEncoder::Settings::ThreadingPolicy::~ThreadingPolicy() = default;
+
+bool VideoEncoder::Settings::ThreadingPolicy::operator==(
+    const ThreadingPolicy& rhs) const {
+  return num_threads == rhs.num_threads &&
+         log2_tile_columns == rhs.log2_tile_columns && row_mt == rhs.row_mt &&
+         speed_by_resolution == rhs.speed_by_resolution;
+}
+
+absl::optional<int> VideoEncoder::Settings::ThreadingPolicy::GetSpeed(
+    int pixel_count) const {
+  absl::optional<int> speed;
+  int best_min_pixel_count = 0;
+  for (const SpeedSetting& setting : speed_by_resolution) {
+    if (setting.min_pixel_count <= pixel_count &&
+        (!speed || setting.min_pixel_count >= best_min_pixel_count)) {
+      speed = setting.speed;
+      best_min_pixel_count = setting.min_pixel_count;
+    }
+  }
+  return speed;
+}
+
 void VideoEncoder::OnLossNotification(
     const LossNotification& loss_notification) {}
 
@@ -20,6 +20,7 @@
 #include "absl/types/optional.h"
 #include "api/fec_controller_override.h"
 #include "api/units/data_rate.h"
+#include "api/units/time_delta.h"
 #include "api/video/encoded_image.h"
 #include "api/video/video_bitrate_allocation.h"
 #include "api/video/video_codec_constants.h"
@@ -259,6 +260,18 @@ class RTC_EXPORT VideoEncoder {
     // Indicates whether or not QP value encoder writes into frame/slice/tile
     // header can be interpreted as average frame/slice/tile QP.
     absl::optional<bool> is_qp_trusted;
+
+    // Number of threads a software encoder encodes with. Used to tell CPU
+    // time spent encoding from wall-clock encode time in CPU adaptation.
+    int num_threads;
+
+    // Total thread CPU time the encoder has spent on threads of its own, i.e.
+    // not on the thread calling Encode(), since it was created. Lets CPU
+    // adaptation that measures thread CPU time account for work the encoder
+    // hands off to other threads. Unset if the encoder has no such threads or
+    // can't measure them. Not compared by operator==, as it grows with every
+    // frame.
+    absl::optional<TimeDelta> worker_thread_cpu_time;
   };
 
   struct RTC_EXPORT RateControlParameters {
@@ -333,6 +346,44 @@ class RTC_EXPORT VideoEncoder {
     // Experimental API - currently only supported by LibvpxVp8Encoder and
     // the OpenH264 encoder. If set, limits the number of encoder threads.
     absl::optional<int> encoder_thread_limit;
+
+    // Experimental API - currently supported by the libaom AV1, libvpx VP9 and
+    // OpenH264 encoders. Overrides the encoder's own choice of threading and
+    // speed; fields left unset keep the encoder's defaults.
+    struct RTC_EXPORT ThreadingPolicy {
+      struct SpeedSetting {
+        bool operator==(const SpeedSetting& rhs) const {
+          return min_pixel_count == rhs.min_pixel_count && speed == rhs.speed;
+        }
+        int min_pixel_count;
+        int speed;
+      };
+
+      ThreadingPolicy();
+      ThreadingPolicy(const ThreadingPolicy&);
+      ~ThreadingPolicy();
+
+      bool operator==(const ThreadingPolicy& rhs) const;
+      bool operator!=(const ThreadingPolicy& rhs) const {
+        return !(*this == rhs);
+      }
+
+      // Returns the speed of the entry with the largest `min_pixel_count` not
+      // exceeding `pixel_count`, if any.
+      absl::optional<int> GetSpeed(int pixel_count) const;
+
+      // Number of encoder threads, capped by `number_of_cores`.
+      absl::optional<int> num_threads;
+      // Log2 of the number of tile columns (AV1, VP9).
+      absl::optional<int> log2_tile_columns;
+      // Row based multithreading (AV1, VP9).
+      absl::optional<bool> row_mt;
+      // Encoder speed (cpu-used) by resolution. As CPU adaptation lowers the
+      // resolution when the encoder overuses the CPU, this lets the speed
+      // follow the CPU load.
+      std::vector<SpeedSetting> speed_by_resolution;
+    };
+    ThreadingPolicy threading_policy;
   };
 
   static VideoCodecVP8 GetDefaultVp8Settings();
@@ -373,6 +424,17 @@ class RTC_EXPORT VideoEncoder {
   virtual int InitEncode(const VideoCodec* codec_settings,
                          const VideoEncoder::Settings& settings);
 
+  // Applies `codec_settings` to an initialized encoder without reinitializing
+  // it, when they differ from the settings of the last InitEncode() or
+  // UpdateActiveStreams() call only in which simulcast streams are active.
+  // Streams that stay active continue without a key frame, newly activated
+  // streams start with one.
+  //
+  // Return value                : true if the settings were applied, false if
+  //                               the encoder has to be reinitialized with
+  //                               InitEncode() instead.
+  virtual bool UpdateActiveStreams(const VideoCodec& codec_settings);
+
   // Register an encode complete callback object.
   //
   // Input:
@@ -151,6 +151,8 @@ class VideoEncoderSoftwareFallbackWrapper final : public VideoEncoder {
   int32_t InitEncode(const VideoCodec* codec_settings,
                      const VideoEncoder::Settings& settings) override;
 
+  bool UpdateActiveStreams(const VideoCodec& codec_settings) override;
+
   int32_t RegisterEncodeCompleteCallback(
       EncodedImageCallback* callback) override;
 
@@ -339,6 +341,17 @@ int32_t VideoEncoderSoftwareFallbackWrapper::InitEncode(
   return ret;
 }
 
+bool VideoEncoderSoftwareFallbackWrapper::UpdateActiveStreams(
+    const VideoCodec& codec_settings) {
+  if (encoder_state_ == EncoderState::kUninitialized ||
+      !current_encoder()->UpdateActiveStreams(codec_settings)) {
+    return false;
+  }
+  // Keep the settings a later fallback is initialized with up to date.
+  codec_settings_ = codec_settings;
+  return true;
+}
+
 int32_t VideoEncoderSoftwareFallbackWrapper::RegisterEncodeCompleteCallback(
     EncodedImageCallback* callback) {
   callback_ = callback;
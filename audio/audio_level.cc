@@ -11,7 +11,7 @@
 #include "audio/audio_level.h"
 
 #include "api/audio/audio_frame.h"
-#include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "common_audio/signal_level.h"
 
 namespace webrtc {
 namespace voe {
@@ -57,7 +57,7 @@ void AudioLevel::ComputeLevel(const AudioFrame& audioFrame, double duration) {
   int16_t abs_value =
       audioFrame.muted()
           ? 0
-          : WebRtcSpl_MaxAbsValueW16(
+          : MaxAbsValueS16(
                 audioFrame.data(),
                 audioFrame.samples_per_channel_ * audioFrame.num_channels_);
 
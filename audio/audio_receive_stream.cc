@@ -27,6 +27,8 @@
 #include "call/rtp_stream_receiver_controller_interface.h"
 #include "modules/rtp_rtcp/source/rtp_packet_received.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/experiments/field_trial_parser.h"
+#include "rtc_base/experiments/field_trial_units.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/strings/string_builder.h"
 #include "rtc_base/time_utils.h"
@@ -57,12 +59,30 @@ std::string AudioReceiveStreamInterface::Config::ToString() const {
 }
 
 namespace {
+// "WebRTC-Audio-LazyNetEq/Enabled,idle_release_time:30s/" makes receive
+// streams create NetEq on their first audio packet, and release it after
+// `idle_release_time` without audio packets. The release time defaults to
+// infinity, which keeps NetEq once created.
+absl::optional<TimeDelta> LazyNetEqIdleReleaseTime(
+    const FieldTrialsView& field_trials) {
+  FieldTrialFlag enabled("Enabled");
+  FieldTrialParameter<TimeDelta> idle_release_time("idle_release_time",
+                                                   TimeDelta::PlusInfinity());
+  ParseFieldTrial({&enabled, &idle_release_time},
+                  field_trials.Lookup("WebRTC-Audio-LazyNetEq"));
+  if (!enabled || idle_release_time.Get() <= TimeDelta::Zero()) {
+    return absl::nullopt;
+  }
+  return idle_release_time.Get();
+}
+
 std::unique_ptr<voe::ChannelReceiveInterface> CreateChannelReceive(
     Clock* clock,
     webrtc::AudioState* audio_state,
     NetEqFactory* neteq_factory,
     const webrtc::AudioReceiveStreamInterface::Config& config,
-    RtcEventLog* event_log) {
+    RtcEventLog* event_log,
+    const FieldTrialsView& field_trials) {
   RTC_DCHECK(audio_state);
   internal::AudioState* internal_audio_state =
       static_cast<internal::AudioState*>(audio_state);
@@ -71,7 +91,9 @@ std::unique_ptr<voe::ChannelReceiveInterface> CreateChannelReceive(
       config.rtcp_send_transport, event_log, config.rtp.local_ssrc,
       config.rtp.remote_ssrc, config.jitter_buffer_max_packets,
       config.jitter_buffer_fast_accelerate, config.jitter_buffer_min_delay_ms,
-      config.enable_non_sender_rtt, config.decoder_factory,
+      config.enable_non_sender_rtt,
+      field_trials.IsEnabled("WebRTC-PerStreamCpuTime"),
+      LazyNetEqIdleReleaseTime(field_trials), config.decoder_factory,
       config.codec_pair_id, std::move(config.frame_decryptor),
       config.crypto_options, std::move(config.frame_transformer));
 }
@@ -83,7 +105,8 @@ AudioReceiveStreamImpl::AudioReceiveStreamImpl(
     NetEqFactory* neteq_factory,
     const webrtc::AudioReceiveStreamInterface::Config& config,
     const rtc::scoped_refptr<webrtc::AudioState>& audio_state,
-    webrtc::RtcEventLog* event_log)
+    webrtc::RtcEventLog* event_log,
+    const FieldTrialsView& field_trials)
     : AudioReceiveStreamImpl(clock,
                              packet_router,
                              config,
@@ -93,7 +116,8 @@ AudioReceiveStreamImpl::AudioReceiveStreamImpl(
                                                   audio_state.get(),
                                                   neteq_factory,
                                                   config,
-                                                  event_log)) {}
+                                                  event_log,
+                                                  field_trials)) {}
 
 AudioReceiveStreamImpl::AudioReceiveStreamImpl(
     Clock* clock,
@@ -319,6 +343,7 @@ webrtc::AudioReceiveStreamInterface::Stats AudioReceiveStreamImpl::GetStats(
       static_cast<double>(rtc::kNumMillisecsPerSec);
   stats.interruption_count = ns.interruptionCount;
   stats.total_interruption_duration_ms = ns.totalInterruptionDurationMs;
+  stats.total_decode_cpu_time = channel_receive_->GetTotalDecodeCpuTime();
 
   auto ds = channel_receive_->GetDecodingCallStatistics();
   stats.decoding_calls_to_silence_generator = ds.calls_to_silence_generator;
@@ -344,6 +369,12 @@ webrtc::AudioReceiveStreamInterface::Stats AudioReceiveStreamImpl::GetStats(
   return stats;
 }
 
+void AudioReceiveStreamImpl::VisitMemoryUsage(
+    rtc::MemoryUsageVisitor& visitor) const {
+  RTC_DCHECK_RUN_ON(&worker_thread_checker_);
+  visitor.Add("netEqBuffer", channel_receive_->GetNetEqMemoryUsageBytes());
+}
+
 void AudioReceiveStreamImpl::SetSink(AudioSinkInterface* sink) {
   RTC_DCHECK_RUN_ON(&worker_thread_checker_);
   channel_receive_->SetSink(sink);
@@ -389,6 +420,14 @@ int AudioReceiveStreamImpl::PreferredSampleRate() const {
   return channel_receive_->PreferredSampleRate();
 }
 
+absl::optional<int> AudioReceiveStreamImpl::ReceivedAudioLevel() const {
+  return channel_receive_->ReceivedAudioLevel();
+}
+
+void AudioReceiveStreamImpl::SkipAudioFrame(int sample_rate_hz) {
+  channel_receive_->SkipAudioFrame();
+}
+
 uint32_t AudioReceiveStreamImpl::id() const {
   RTC_DCHECK_RUN_ON(&worker_thread_checker_);
   return remote_ssrc();
@@ -18,6 +18,7 @@
 
 #include "absl/strings/string_view.h"
 #include "api/audio/audio_mixer.h"
+#include "api/field_trials_view.h"
 #include "api/neteq/neteq_factory.h"
 #include "api/rtp_headers.h"
 #include "api/sequence_checker.h"
@@ -25,6 +26,7 @@
 #include "call/audio_receive_stream.h"
 #include "call/syncable.h"
 #include "modules/rtp_rtcp/source/source_tracker.h"
+#include "rtc_base/memory_usage.h"
 #include "rtc_base/system/no_unique_address.h"
 #include "system_wrappers/include/clock.h"
 
@@ -52,7 +54,8 @@ class AudioReceiveStreamImpl final : public webrtc::AudioReceiveStreamInterface,
       NetEqFactory* neteq_factory,
       const webrtc::AudioReceiveStreamInterface::Config& config,
       const rtc::scoped_refptr<webrtc::AudioState>& audio_state,
-      webrtc::RtcEventLog* event_log);
+      webrtc::RtcEventLog* event_log,
+      const FieldTrialsView& field_trials);
   // For unit tests, which need to supply a mock channel receive.
   AudioReceiveStreamImpl(
       Clock* clock,
@@ -97,6 +100,8 @@ class AudioReceiveStreamImpl final : public webrtc::AudioReceiveStreamInterface,
 
   webrtc::AudioReceiveStreamInterface::Stats GetStats(
       bool get_and_clear_legacy_stats) const override;
+  // Reports the memory held by the NetEq buffers of the stream.
+  void VisitMemoryUsage(rtc::MemoryUsageVisitor& visitor) const;
   void SetSink(AudioSinkInterface* sink) override;
   void SetGain(float gain) override;
   bool SetBaseMinimumPlayoutDelayMs(int delay_ms) override;
@@ -108,6 +113,8 @@ class AudioReceiveStreamImpl final : public webrtc::AudioReceiveStreamInterface,
                                        AudioFrame* audio_frame) override;
   int Ssrc() const override;
   int PreferredSampleRate() const override;
+  absl::optional<int> ReceivedAudioLevel() const override;
+  void SkipAudioFrame(int sample_rate_hz) override;
 
   // Syncable
   uint32_t id() const override;
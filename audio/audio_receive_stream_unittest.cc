@@ -17,6 +17,7 @@
 
 #include "api/test/mock_audio_mixer.h"
 #include "api/test/mock_frame_decryptor.h"
+#include "api/units/time_delta.h"
 #include "audio/conversion.h"
 #include "audio/mock_voe_channel_proxy.h"
 #include "call/rtp_stream_receiver_controller.h"
@@ -61,6 +62,7 @@ const unsigned int kSpeechOutputLevel = 99;
 const double kTotalOutputEnergy = 0.25;
 const double kTotalOutputDuration = 0.5;
 const int64_t kPlayoutNtpTimestampMs = 5678;
+const TimeDelta kTotalDecodeCpuTime = TimeDelta::Micros(4321);
 
 const CallReceiveStatistics kCallStats = {678, 234, -12, 567, 78, 890, 123};
 const std::pair<int, SdpAudioFormat> kReceiveCodec = {
@@ -170,6 +172,8 @@ struct ConfigHelper {
         .WillOnce(Return(kTotalOutputEnergy));
     EXPECT_CALL(*channel_receive_, GetTotalOutputDuration())
         .WillOnce(Return(kTotalOutputDuration));
+    EXPECT_CALL(*channel_receive_, GetTotalDecodeCpuTime())
+        .WillOnce(Return(kTotalDecodeCpuTime));
     EXPECT_CALL(*channel_receive_, GetNetworkStatistics(_))
         .WillOnce(Return(kNetworkStats));
     EXPECT_CALL(*channel_receive_, GetDecodingCallStatistics())
@@ -306,6 +310,7 @@ TEST(AudioReceiveStreamTest, GetStats) {
     EXPECT_EQ(kNetworkStats.interruptionCount, stats.interruption_count);
     EXPECT_EQ(kNetworkStats.totalInterruptionDurationMs,
               stats.total_interruption_duration_ms);
+    EXPECT_EQ(kTotalDecodeCpuTime, stats.total_decode_cpu_time);
 
     EXPECT_EQ(kAudioDecodeStats.calls_to_silence_generator,
               stats.decoding_calls_to_silence_generator);
@@ -324,6 +329,19 @@ TEST(AudioReceiveStreamTest, GetStats) {
   }
 }
 
+TEST(AudioReceiveStreamTest, VisitMemoryUsage) {
+  test::RunLoop loop;
+  ConfigHelper helper(/*use_null_audio_processing=*/false);
+  auto recv_stream = helper.CreateAudioReceiveStream();
+  EXPECT_CALL(*helper.channel_receive(), GetNetEqMemoryUsageBytes())
+      .WillOnce(Return(12345u));
+  rtc::MemoryUsageVisitor visitor;
+  recv_stream->VisitMemoryUsage(visitor);
+  EXPECT_EQ(visitor.total_bytes(), 12345);
+  EXPECT_EQ(visitor.bytes_by_component().at("netEqBuffer"), 12345);
+  recv_stream->UnregisterFromTransport();
+}
+
 TEST(AudioReceiveStreamTest, SetGain) {
   test::RunLoop loop;
   for (bool use_null_audio_processing : {false, true}) {
@@ -26,6 +26,7 @@
 #include "audio/audio_state.h"
 #include "audio/channel_send.h"
 #include "audio/conversion.h"
+#include "audio/shared_audio_encoder_pool.h"
 #include "call/rtp_config.h"
 #include "call/rtp_transport_controller_send_interface.h"
 #include "common_audio/vad/include/vad.h"
@@ -381,25 +382,35 @@ void AudioSendStream::Stop() {
 
 void AudioSendStream::SendAudioData(std::unique_ptr<AudioFrame> audio_frame) {
   RTC_CHECK_RUNS_SERIALIZED(&audio_capture_race_checker_);
-  RTC_DCHECK_GT(audio_frame->sample_rate_hz_, 0);
   TRACE_EVENT0("webrtc", "AudioSendStream::SendAudioData");
-  double duration = static_cast<double>(audio_frame->samples_per_channel_) /
-                    audio_frame->sample_rate_hz_;
-  {
-    // Note: SendAudioData() passes the frame further down the pipeline and it
-    // may eventually get sent. But this method is invoked even if we are not
-    // connected, as long as we have an AudioSendStream (created as a result of
-    // an O/A exchange). This means that we are calculating audio levels whether
-    // or not we are sending samples.
-    // TODO(https://crbug.com/webrtc/10771): All "media-source" related stats
-    // should move from send-streams to the local audio sources or tracks; a
-    // send-stream should not be required to read the microphone audio levels.
-    MutexLock lock(&audio_level_lock_);
-    audio_level_.ComputeLevel(*audio_frame, duration);
-  }
+  UpdateAudioLevel(*audio_frame);
   channel_send_->ProcessAndEncodeAudio(std::move(audio_frame));
 }
 
+void AudioSendStream::SendSharedAudioData(
+    rtc::scoped_refptr<const SharedAudioFrame> audio_frame) {
+  RTC_CHECK_RUNS_SERIALIZED(&audio_capture_race_checker_);
+  TRACE_EVENT0("webrtc", "AudioSendStream::SendSharedAudioData");
+  UpdateAudioLevel(*audio_frame);
+  channel_send_->ProcessAndEncodeSharedAudio(std::move(audio_frame));
+}
+
+void AudioSendStream::UpdateAudioLevel(const AudioFrame& audio_frame) {
+  RTC_DCHECK_GT(audio_frame.sample_rate_hz_, 0);
+  double duration = static_cast<double>(audio_frame.samples_per_channel_) /
+                    audio_frame.sample_rate_hz_;
+  // Note: SendAudioData() passes the frame further down the pipeline and it
+  // may eventually get sent. But this method is invoked even if we are not
+  // connected, as long as we have an AudioSendStream (created as a result of
+  // an O/A exchange). This means that we are calculating audio levels whether
+  // or not we are sending samples.
+  // TODO(https://crbug.com/webrtc/10771): All "media-source" related stats
+  // should move from send-streams to the local audio sources or tracks; a
+  // send-stream should not be required to read the microphone audio levels.
+  MutexLock lock(&audio_level_lock_);
+  audio_level_.ComputeLevel(audio_frame, duration);
+}
+
 bool AudioSendStream::SendTelephoneEvent(int payload_type,
                                          int payload_frequency,
                                          int event,
@@ -573,8 +584,9 @@ bool AudioSendStream::SetupSendCodec(const Config& new_config) {
 
   RTC_DCHECK(new_config.encoder_factory);
   std::unique_ptr<AudioEncoder> encoder =
-      new_config.encoder_factory->MakeAudioEncoder(
-          spec.payload_type, spec.format, new_config.codec_pair_id);
+      SharedAudioEncoderPool::Default().CreateEncoder(
+          new_config.encoder_factory, spec.payload_type, spec.format,
+          new_config.codec_pair_id, new_config.shared_encoder_source);
 
   if (!encoder) {
     RTC_DLOG(LS_ERROR) << "Unable to create encoder for "
@@ -649,13 +661,15 @@ bool AudioSendStream::ReconfigureSendCodec(const Config& new_config) {
 
   if (new_config.send_codec_spec == old_config.send_codec_spec &&
       new_config.audio_network_adaptor_config ==
-          old_config.audio_network_adaptor_config) {
+          old_config.audio_network_adaptor_config &&
+      new_config.shared_encoder_source == old_config.shared_encoder_source) {
     return true;
   }
 
-  // If we have no encoder, or the format or payload type's changed, create a
-  // new encoder.
+  // If we have no encoder, or the format, payload type or shared encoder's
+  // changed, create a new encoder.
   if (!old_config.send_codec_spec ||
+      new_config.shared_encoder_source != old_config.shared_encoder_source ||
       new_config.send_codec_spec->format !=
           old_config.send_codec_spec->format ||
       new_config.send_codec_spec->payload_type !=
@@ -22,6 +22,7 @@
 #include "audio/audio_level.h"
 #include "audio/channel_send.h"
 #include "call/audio_send_stream.h"
+#include "call/audio_sender.h"
 #include "call/audio_state.h"
 #include "call/bitrate_allocator.h"
 #include "modules/rtp_rtcp/source/rtp_rtcp_interface.h"
@@ -90,6 +91,8 @@ class AudioSendStream final : public webrtc::AudioSendStream,
   void Start() override;
   void Stop() override;
   void SendAudioData(std::unique_ptr<AudioFrame> audio_frame) override;
+  void SendSharedAudioData(
+      rtc::scoped_refptr<const SharedAudioFrame> audio_frame) override;
   bool SendTelephoneEvent(int payload_type,
                           int payload_frequency,
                           int event,
@@ -126,6 +129,9 @@ class AudioSendStream final : public webrtc::AudioSendStream,
   void StoreEncoderProperties(int sample_rate_hz, size_t num_channels)
       RTC_RUN_ON(worker_thread_checker_);
 
+  // Updates the audio level stats with a captured frame.
+  void UpdateAudioLevel(const AudioFrame& audio_frame);
+
   void ConfigureStream(const Config& new_config,
                        bool first_time,
                        SetParametersCallback callback)
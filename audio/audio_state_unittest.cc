@@ -10,6 +10,7 @@
 
 #include "audio/audio_state.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -232,6 +233,60 @@ TEST_P(AudioStateTest, RecordedAudioArrivesAtSingleStream) {
   audio_state->RemoveSendingStream(&stream);
 }
 
+TEST_P(AudioStateTest, RecordedFloatAudioArrivesAtSingleStream) {
+  ConfigHelper helper(GetParam());
+
+  if (GetParam().use_async_audio_processing) {
+    EXPECT_CALL(helper.mock_audio_frame_processor(), SinkSet);
+    EXPECT_CALL(helper.mock_audio_frame_processor(), ProcessCalled);
+    EXPECT_CALL(helper.mock_audio_frame_processor(), SinkCleared);
+  }
+
+  rtc::scoped_refptr<internal::AudioState> audio_state(
+      rtc::make_ref_counted<internal::AudioState>(helper.config()));
+
+  MockAudioSendStream stream;
+  audio_state->AddSendingStream(&stream, kSampleRate, 1);
+
+  EXPECT_CALL(
+      stream,
+      SendAudioDataForMock(::testing::AllOf(
+          ::testing::Field(&AudioFrame::sample_rate_hz_,
+                           ::testing::Eq(kSampleRate)),
+          ::testing::Field(&AudioFrame::num_channels_, ::testing::Eq(1u)))))
+      .WillOnce(::testing::Invoke([](AudioFrame* audio_frame) {
+        EXPECT_EQ(audio_frame->samples_per_channel_,
+                  static_cast<size_t>(kSampleRate / 100));
+        EXPECT_LT(0u, ComputeChannelLevels(audio_frame)[0]);
+      }));
+  MockAudioProcessing* ap =
+      GetParam().use_null_audio_processing
+          ? nullptr
+          : static_cast<MockAudioProcessing*>(audio_state->audio_processing());
+  if (ap) {
+    // The float audio is processed without an int16 round trip.
+    EXPECT_CALL(*ap, set_stream_delay_ms(0));
+    EXPECT_CALL(*ap, set_stream_key_pressed(false));
+    EXPECT_CALL(*ap, ProcessStream(_, _, _, Matcher<int16_t*>(_))).Times(0);
+    EXPECT_CALL(*ap, ProcessStream(_, _, _, Matcher<float* const*>(_)))
+        .WillOnce(::testing::Invoke(
+            [](const float* const* src, const StreamConfig& input_config,
+               const StreamConfig& output_config, float* const* dest) {
+              std::copy(src[0], src[0] + output_config.num_frames(), dest[0]);
+              return 0;
+            }));
+  }
+
+  std::vector<float> audio_data(kSampleRate / 100);
+  const auto int16_data = Create10msTestData(kSampleRate, 1);
+  std::transform(int16_data.begin(), int16_data.end(), audio_data.begin(),
+                 [](int16_t x) { return x / 32768.f; });
+  audio_state->audio_transport()->RecordedFloatDataIsAvailable(
+      audio_data, 1, kSampleRate, 0, false, absl::nullopt);
+
+  audio_state->RemoveSendingStream(&stream);
+}
+
 TEST_P(AudioStateTest, RecordedAudioArrivesAtMultipleStreams) {
   ConfigHelper helper(GetParam());
 
@@ -292,6 +347,49 @@ TEST_P(AudioStateTest, RecordedAudioArrivesAtMultipleStreams) {
   audio_state->RemoveSendingStream(&stream_2);
 }
 
+TEST_P(AudioStateTest, RecordedAudioIsSharedBetweenStreams) {
+  class SharedFrameRecorder : public MockAudioSendStream {
+   public:
+    void SendSharedAudioData(
+        rtc::scoped_refptr<const SharedAudioFrame> audio_frame) override {
+      frames.push_back(std::move(audio_frame));
+    }
+    std::vector<rtc::scoped_refptr<const SharedAudioFrame>> frames;
+  };
+
+  ConfigHelper helper(GetParam());
+
+  if (GetParam().use_async_audio_processing) {
+    EXPECT_CALL(helper.mock_audio_frame_processor(), SinkSet);
+    EXPECT_CALL(helper.mock_audio_frame_processor(), ProcessCalled);
+    EXPECT_CALL(helper.mock_audio_frame_processor(), SinkCleared);
+  }
+
+  rtc::scoped_refptr<internal::AudioState> audio_state(
+      rtc::make_ref_counted<internal::AudioState>(helper.config()));
+
+  SharedFrameRecorder stream_1;
+  SharedFrameRecorder stream_2;
+  audio_state->AddSendingStream(&stream_1, 8001, 2);
+  audio_state->AddSendingStream(&stream_2, 32000, 1);
+
+  constexpr int kSampleRate = 16000;
+  constexpr size_t kNumChannels = 1;
+  auto audio_data = Create10msTestData(kSampleRate, kNumChannels);
+  uint32_t new_mic_level = 667;
+  audio_state->audio_transport()->RecordedDataIsAvailable(
+      &audio_data[0], kSampleRate / 100, kNumChannels * 2, kNumChannels,
+      kSampleRate, 0, 0, 0, false, new_mic_level);
+
+  ASSERT_EQ(stream_1.frames.size(), 1u);
+  ASSERT_EQ(stream_2.frames.size(), 1u);
+  EXPECT_EQ(stream_1.frames[0], stream_2.frames[0]);
+  EXPECT_EQ(stream_1.frames[0]->sample_rate_hz_, kSampleRate);
+
+  audio_state->RemoveSendingStream(&stream_1);
+  audio_state->RemoveSendingStream(&stream_2);
+}
+
 TEST_P(AudioStateTest, EnableChannelSwap) {
   constexpr int kSampleRate = 16000;
   constexpr size_t kNumChannels = 2;
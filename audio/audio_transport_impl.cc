@@ -14,7 +14,9 @@
 #include <memory>
 #include <utility>
 
+#include "api/make_ref_counted.h"
 #include "audio/remix_resample.h"
+#include "common_audio/include/audio_util.h"
 #include "audio/utility/audio_frame_operations.h"
 #include "call/audio_sender.h"
 #include "modules/async_audio_processing/async_audio_processing.h"
@@ -166,7 +168,90 @@ int32_t AudioTransportImpl::RecordedDataIsAvailable(
   ProcessCaptureFrame(audio_delay_milliseconds, key_pressed,
                       swap_stereo_channels, audio_processing_,
                       audio_frame.get());
+  DeliverCaptureFrame(std::move(audio_frame), estimated_capture_time_ns);
+  return 0;
+}
+
+int32_t AudioTransportImpl::RecordedFloatDataIsAvailable(
+    rtc::ArrayView<const float> audio_samples,
+    size_t number_of_channels,
+    uint32_t sample_rate,
+    uint32_t total_delay_ms,
+    bool key_pressed,
+    absl::optional<int64_t> estimated_capture_time_ns) {
+  RTC_DCHECK_GE(number_of_channels, 1);
+  RTC_DCHECK_GE(sample_rate, AudioProcessing::NativeRate::kSampleRate8kHz);
+  const size_t number_of_frames = sample_rate / 100;
+  RTC_DCHECK_EQ(number_of_frames * number_of_channels, audio_samples.size());
+
+  int send_sample_rate_hz = 0;
+  size_t send_num_channels = 0;
+  bool swap_stereo_channels = false;
+  {
+    MutexLock lock(&capture_lock_);
+    send_sample_rate_hz = send_sample_rate_hz_;
+    send_num_channels = send_num_channels_;
+    swap_stereo_channels = swap_stereo_channels_;
+  }
 
+  std::unique_ptr<AudioFrame> audio_frame(new AudioFrame());
+  InitializeCaptureFrame(sample_rate, send_sample_rate_hz, number_of_channels,
+                         send_num_channels, audio_frame.get());
+  const size_t num_output_channels = audio_frame->num_channels_;
+  const size_t num_output_frames = audio_frame->sample_rate_hz_ / 100;
+  // APM can only output one channel or as many channels as its input.
+  if (!audio_processing_ ||
+      (num_output_channels != 1 && num_output_channels != number_of_channels)) {
+    return AudioTransport::RecordedFloatDataIsAvailable(
+        audio_samples, number_of_channels, sample_rate, total_delay_ms,
+        key_pressed, estimated_capture_time_ns);
+  }
+  RTC_DCHECK_LE(num_output_frames * num_output_channels,
+                AudioFrame::kMaxDataSizeSamples);
+
+  if (!capture_float_input_ ||
+      capture_float_input_->num_frames() != number_of_frames ||
+      capture_float_input_->num_channels() != number_of_channels) {
+    capture_float_input_ = std::make_unique<ChannelBuffer<float>>(
+        number_of_frames, number_of_channels);
+  }
+  if (!capture_float_output_ ||
+      capture_float_output_->num_frames() != num_output_frames ||
+      capture_float_output_->num_channels() != num_output_channels) {
+    capture_float_output_ = std::make_unique<ChannelBuffer<float>>(
+        num_output_frames, num_output_channels);
+  }
+  Deinterleave(audio_samples.data(), number_of_frames, number_of_channels,
+               capture_float_input_->channels());
+
+  // APM resamples and downmixes the float audio itself.
+  audio_processing_->set_stream_delay_ms(total_delay_ms);
+  audio_processing_->set_stream_key_pressed(key_pressed);
+  int error = audio_processing_->ProcessStream(
+      capture_float_input_->channels(),
+      StreamConfig(sample_rate, number_of_channels),
+      StreamConfig(audio_frame->sample_rate_hz_, num_output_channels),
+      capture_float_output_->channels());
+  RTC_DCHECK_EQ(0, error) << "ProcessStream() error: " << error;
+
+  // The only conversion to 16 bit.
+  audio_frame->samples_per_channel_ = num_output_frames;
+  int16_t* data = audio_frame->mutable_data();
+  const float* const* output = capture_float_output_->channels();
+  for (size_t i = 0; i < num_output_frames; ++i) {
+    for (size_t ch = 0; ch < num_output_channels; ++ch) {
+      data[i * num_output_channels + ch] = FloatToS16(output[ch][i]);
+    }
+  }
+  ProcessCaptureFrame(total_delay_ms, key_pressed, swap_stereo_channels,
+                      /*audio_processing=*/nullptr, audio_frame.get());
+  DeliverCaptureFrame(std::move(audio_frame), estimated_capture_time_ns);
+  return 0;
+}
+
+void AudioTransportImpl::DeliverCaptureFrame(
+    std::unique_ptr<AudioFrame> audio_frame,
+    absl::optional<int64_t> estimated_capture_time_ns) {
   if (estimated_capture_time_ns) {
     audio_frame->set_absolute_capture_timestamp_ms(*estimated_capture_time_ns /
                                                    1000000);
@@ -177,8 +262,6 @@ int32_t AudioTransportImpl::RecordedDataIsAvailable(
     async_audio_processing_->Process(std::move(audio_frame));
   else
     SendProcessedData(std::move(audio_frame));
-
-  return 0;
 }
 
 void AudioTransportImpl::SendProcessedData(
@@ -189,14 +272,20 @@ void AudioTransportImpl::SendProcessedData(
   if (audio_senders_.empty())
     return;
 
-  auto it = audio_senders_.begin();
-  while (++it != audio_senders_.end()) {
-    auto audio_frame_copy = std::make_unique<AudioFrame>();
-    audio_frame_copy->CopyFrom(*audio_frame);
-    (*it)->SendAudioData(std::move(audio_frame_copy));
+  if (audio_senders_.size() == 1) {
+    // Send the original frame to the only stream w/o copying.
+    audio_senders_.front()->SendAudioData(std::move(audio_frame));
+    return;
+  }
+
+  // Copy the frame once into a refcounted frame that all the streams share,
+  // rather than once per stream.
+  rtc::scoped_refptr<SharedAudioFrame> shared_frame =
+      rtc::make_ref_counted<AudioFrame>();
+  shared_frame->CopyFrom(*audio_frame);
+  for (AudioSender* sender : audio_senders_) {
+    sender->SendSharedAudioData(shared_frame);
   }
-  // Send the original frame to the first stream w/o copying.
-  (*audio_senders_.begin())->SendAudioData(std::move(audio_frame));
 }
 
 // Mix all received streams, feed the result to the AudioProcessing module, then
@@ -14,8 +14,11 @@
 #include <memory>
 #include <vector>
 
+#include "absl/types/optional.h"
+#include "api/array_view.h"
 #include "api/audio/audio_mixer.h"
 #include "api/scoped_refptr.h"
+#include "common_audio/channel_buffer.h"
 #include "common_audio/resampler/include/push_resampler.h"
 #include "modules/async_audio_processing/async_audio_processing.h"
 #include "modules/audio_device/include/audio_device.h"
@@ -65,6 +68,18 @@ class AudioTransportImpl : public AudioTransport {
       uint32_t& newMicLevel,
       absl::optional<int64_t> estimated_capture_time_ns) override;
 
+  // Runs the audio processing module on the float samples directly, such that
+  // they are only converted to 16 bit once, after processing. Falls back to
+  // the 16 bit path if there is no audio processing module, or if the send
+  // streams need a remix it does not support.
+  int32_t RecordedFloatDataIsAvailable(
+      rtc::ArrayView<const float> audio_samples,
+      size_t number_of_channels,
+      uint32_t sample_rate,
+      uint32_t total_delay_ms,
+      bool key_pressed,
+      absl::optional<int64_t> estimated_capture_time_ns) override;
+
   int32_t NeedMorePlayData(size_t nSamples,
                            size_t nBytesPerSample,
                            size_t nChannels,
@@ -88,6 +103,9 @@ class AudioTransportImpl : public AudioTransport {
   void SetStereoChannelSwapping(bool enable);
 
  private:
+  // Sends a processed capture frame, through async audio processing if any.
+  void DeliverCaptureFrame(std::unique_ptr<AudioFrame> audio_frame,
+                           absl::optional<int64_t> estimated_capture_time_ns);
   void SendProcessedData(std::unique_ptr<AudioFrame> audio_frame);
 
   // Shared.
@@ -104,6 +122,9 @@ class AudioTransportImpl : public AudioTransport {
   size_t send_num_channels_ RTC_GUARDED_BY(capture_lock_) = 1;
   bool swap_stereo_channels_ RTC_GUARDED_BY(capture_lock_) = false;
   PushResampler<int16_t> capture_resampler_;
+  // Deinterleaved input and output of the float capture path.
+  std::unique_ptr<ChannelBuffer<float>> capture_float_input_;
+  std::unique_ptr<ChannelBuffer<float>> capture_float_output_;
 
   // Render side.
 
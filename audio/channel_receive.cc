@@ -43,6 +43,7 @@
 #include "modules/rtp_rtcp/source/rtp_rtcp_config.h"
 #include "modules/rtp_rtcp/source/rtp_rtcp_impl2.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/cpu_time.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/numerics/safe_minmax.h"
 #include "rtc_base/numerics/sequence_number_unwrapper.h"
@@ -72,7 +73,8 @@ acm2::AcmReceiver::Config AcmConfig(
     absl::optional<AudioCodecPairId> codec_pair_id,
     size_t jitter_buffer_max_packets,
     bool jitter_buffer_fast_playout,
-    int jitter_buffer_min_delay_ms) {
+    int jitter_buffer_min_delay_ms,
+    absl::optional<TimeDelta> lazy_neteq_idle_release_time) {
   acm2::AcmReceiver::Config acm_config;
   acm_config.neteq_factory = neteq_factory;
   acm_config.decoder_factory = decoder_factory;
@@ -81,6 +83,12 @@ acm2::AcmReceiver::Config AcmConfig(
   acm_config.neteq_config.enable_fast_accelerate = jitter_buffer_fast_playout;
   acm_config.neteq_config.enable_muted_state = true;
   acm_config.neteq_config.min_delay_ms = jitter_buffer_min_delay_ms;
+  if (lazy_neteq_idle_release_time) {
+    acm_config.create_neteq_on_first_packet = true;
+    if (lazy_neteq_idle_release_time->IsFinite()) {
+      acm_config.neteq_idle_release_time = lazy_neteq_idle_release_time;
+    }
+  }
 
   return acm_config;
 }
@@ -101,6 +109,8 @@ class ChannelReceive : public ChannelReceiveInterface,
       bool jitter_buffer_fast_playout,
       int jitter_buffer_min_delay_ms,
       bool enable_non_sender_rtt,
+      bool enable_cpu_time_accounting,
+      absl::optional<TimeDelta> lazy_neteq_idle_release_time,
       rtc::scoped_refptr<AudioDecoderFactory> decoder_factory,
       absl::optional<AudioCodecPairId> codec_pair_id,
       rtc::scoped_refptr<FrameDecryptorInterface> frame_decryptor,
@@ -133,6 +143,8 @@ class ChannelReceive : public ChannelReceiveInterface,
   // https://w3c.github.io/webrtc-stats/#dom-rtcmediastreamtrackstats-totalaudioenergy
   double GetTotalOutputEnergy() const override;
   double GetTotalOutputDuration() const override;
+  absl::optional<TimeDelta> GetTotalDecodeCpuTime() const override;
+  size_t GetNetEqMemoryUsageBytes() const override;
 
   // Stats.
   NetworkStatistics GetNetworkStatistics(
@@ -170,6 +182,9 @@ class ChannelReceive : public ChannelReceiveInterface,
 
   int PreferredSampleRate() const override;
 
+  absl::optional<int> ReceivedAudioLevel() const override;
+  void SkipAudioFrame() override;
+
   void SetSourceTracker(SourceTracker* source_tracker) override;
 
   // Associate to a send channel.
@@ -231,6 +246,16 @@ class ChannelReceive : public ChannelReceiveInterface,
 
   bool playing_ RTC_GUARDED_BY(worker_thread_checker_) = false;
 
+  // Level of the most recently received packet carrying one, written when
+  // packets are received and read by the audio mixer.
+  mutable Mutex received_audio_level_mutex_;
+  absl::optional<int> received_audio_level_
+      RTC_GUARDED_BY(received_audio_level_mutex_);
+  Timestamp received_audio_level_time_
+      RTC_GUARDED_BY(received_audio_level_mutex_) = Timestamp::MinusInfinity();
+  // True from SkipAudioFrame() until the next GetAudioFrameWithInfo().
+  bool skipping_playout_ RTC_GUARDED_BY(received_audio_level_mutex_) = false;
+
   RtcEventLog* const event_log_;
 
   // Indexed by payload type.
@@ -280,6 +305,11 @@ class ChannelReceive : public ChannelReceiveInterface,
   AudioDeviceModule* _audioDeviceModulePtr;
   float _outputGain RTC_GUARDED_BY(volume_settings_mutex_);
 
+  const bool cpu_time_accounting_enabled_;
+  mutable Mutex decode_cpu_time_mutex_;
+  TimeDelta total_decode_cpu_time_ RTC_GUARDED_BY(decode_cpu_time_mutex_) =
+      TimeDelta::Zero();
+
   const ChannelSendInterface* associated_send_channel_
       RTC_GUARDED_BY(network_thread_checker_);
 
@@ -320,14 +350,22 @@ class ChannelReceive : public ChannelReceiveInterface,
 void ChannelReceive::OnReceivedPayloadData(
     rtc::ArrayView<const uint8_t> payload,
     const RTPHeader& rtpHeader) {
-  if (!playing_) {
-    // Avoid inserting into NetEQ when we are not playing. Count the
-    // packet as discarded.
+  bool skipping_playout;
+  {
+    MutexLock lock(&received_audio_level_mutex_);
+    if (rtpHeader.extension.hasAudioLevel) {
+      received_audio_level_ = rtpHeader.extension.audioLevel;
+      received_audio_level_time_ = clock_->CurrentTime();
+    }
+    skipping_playout = skipping_playout_;
+  }
 
+  if (!playing_ || skipping_playout) {
     // If we have a source_tracker_, tell it that the frame has been
     // "delivered". Normally, this happens in AudioReceiveStreamInterface when
     // audio frames are pulled out, but when playout is muted, nothing is
-    // pulling frames. The downside of this approach is that frames delivered
+    // pulling frames, and while the mixer skips this channel the frames are
+    // discarded. The downside of this approach is that frames delivered
     // this way won't be delayed for playout, and therefore will be
     // unsynchronized with (a) audio delay when playing and (b) any audio/video
     // synchronization. But the alternative is that muting playout also stops
@@ -337,7 +375,11 @@ void ChannelReceive::OnReceivedPayloadData(
           RtpPacketInfo(rtpHeader, clock_->CurrentTime())};
       source_tracker_->OnFrameDelivered(RtpPacketInfos(packet_vector));
     }
+  }
 
+  if (!playing_) {
+    // Avoid inserting into NetEQ when we are not playing. Count the
+    // packet as discarded.
     return;
   }
 
@@ -387,13 +429,26 @@ AudioMixer::Source::AudioFrameInfo ChannelReceive::GetAudioFrameWithInfo(
                      "sample_rate_hz", sample_rate_hz);
   RTC_DCHECK_RUNS_SERIALIZED(&audio_thread_race_checker_);
   audio_frame->sample_rate_hz_ = sample_rate_hz;
+  {
+    MutexLock lock(&received_audio_level_mutex_);
+    skipping_playout_ = false;
+  }
 
   event_log_->Log(std::make_unique<RtcEventAudioPlayout>(remote_ssrc_));
 
   // Get 10ms raw PCM data from the ACM (mixer limits output frequency)
   bool muted;
-  if (acm_receiver_.GetAudio(audio_frame->sample_rate_hz_, audio_frame,
-                             &muted) == -1) {
+  const int64_t get_audio_start_cpu_time_ns =
+      cpu_time_accounting_enabled_ ? rtc::GetThreadCpuTimeNanos() : 0;
+  const int get_audio_result = acm_receiver_.GetAudio(
+      audio_frame->sample_rate_hz_, audio_frame, &muted);
+  if (cpu_time_accounting_enabled_) {
+    MutexLock lock(&decode_cpu_time_mutex_);
+    total_decode_cpu_time_ += TimeDelta::Micros(
+        (rtc::GetThreadCpuTimeNanos() - get_audio_start_cpu_time_ns) /
+        rtc::kNumNanosecsPerMicrosec);
+  }
+  if (get_audio_result == -1) {
     RTC_DLOG(LS_ERROR)
         << "ChannelReceive::GetAudioFrame() PlayoutData10Ms() failed!";
     // In all likelihood, the audio in this frame is garbage. We return an
@@ -521,6 +576,30 @@ int ChannelReceive::PreferredSampleRate() const {
                   acm_receiver_.last_output_sample_rate_hz());
 }
 
+absl::optional<int> ChannelReceive::ReceivedAudioLevel() const {
+  // Senders using DTX stop sending packets during silence.
+  constexpr TimeDelta kSilenceTimeout = TimeDelta::Millis(500);
+  constexpr int kSilentAudioLevel = 127;
+  MutexLock lock(&received_audio_level_mutex_);
+  if (received_audio_level_ &&
+      clock_->CurrentTime() - received_audio_level_time_ > kSilenceTimeout) {
+    return kSilentAudioLevel;
+  }
+  return received_audio_level_;
+}
+
+void ChannelReceive::SkipAudioFrame() {
+  RTC_DCHECK_RUNS_SERIALIZED(&audio_thread_race_checker_);
+  {
+    MutexLock lock(&received_audio_level_mutex_);
+    skipping_playout_ = true;
+  }
+  // Drop the buffered packets rather than decoding them. When the channel is
+  // mixed again, playout starts from the packets received since the last
+  // skipped frame.
+  acm_receiver_.FlushBuffers();
+}
+
 void ChannelReceive::SetSourceTracker(SourceTracker* source_tracker) {
   source_tracker_ = source_tracker;
 }
@@ -537,6 +616,8 @@ ChannelReceive::ChannelReceive(
     bool jitter_buffer_fast_playout,
     int jitter_buffer_min_delay_ms,
     bool enable_non_sender_rtt,
+    bool enable_cpu_time_accounting,
+    absl::optional<TimeDelta> lazy_neteq_idle_release_time,
     rtc::scoped_refptr<AudioDecoderFactory> decoder_factory,
     absl::optional<AudioCodecPairId> codec_pair_id,
     rtc::scoped_refptr<FrameDecryptorInterface> frame_decryptor,
@@ -551,7 +632,8 @@ ChannelReceive::ChannelReceive(
                               codec_pair_id,
                               jitter_buffer_max_packets,
                               jitter_buffer_fast_playout,
-                              jitter_buffer_min_delay_ms)),
+                              jitter_buffer_min_delay_ms,
+                              lazy_neteq_idle_release_time)),
       _outputAudioLevel(),
       clock_(clock),
       ntp_estimator_(clock),
@@ -561,6 +643,7 @@ ChannelReceive::ChannelReceive(
       capture_start_ntp_time_ms_(-1),
       _audioDeviceModulePtr(audio_device_module),
       _outputGain(1.0f),
+      cpu_time_accounting_enabled_(enable_cpu_time_accounting),
       associated_send_channel_(nullptr),
       frame_decryptor_(frame_decryptor),
       crypto_options_(crypto_options),
@@ -784,6 +867,20 @@ double ChannelReceive::GetTotalOutputDuration() const {
   return _outputAudioLevel.TotalDuration();
 }
 
+absl::optional<TimeDelta> ChannelReceive::GetTotalDecodeCpuTime() const {
+  RTC_DCHECK_RUN_ON(&worker_thread_checker_);
+  if (!cpu_time_accounting_enabled_) {
+    return absl::nullopt;
+  }
+  MutexLock lock(&decode_cpu_time_mutex_);
+  return total_decode_cpu_time_;
+}
+
+size_t ChannelReceive::GetNetEqMemoryUsageBytes() const {
+  RTC_DCHECK_RUN_ON(&worker_thread_checker_);
+  return acm_receiver_.GetMemoryUsageBytes();
+}
+
 void ChannelReceive::SetChannelOutputVolumeScaling(float scaling) {
   RTC_DCHECK_RUN_ON(&worker_thread_checker_);
   MutexLock lock(&volume_settings_mutex_);
@@ -1118,6 +1215,8 @@ std::unique_ptr<ChannelReceiveInterface> CreateChannelReceive(
     bool jitter_buffer_fast_playout,
     int jitter_buffer_min_delay_ms,
     bool enable_non_sender_rtt,
+    bool enable_cpu_time_accounting,
+    absl::optional<TimeDelta> lazy_neteq_idle_release_time,
     rtc::scoped_refptr<AudioDecoderFactory> decoder_factory,
     absl::optional<AudioCodecPairId> codec_pair_id,
     rtc::scoped_refptr<FrameDecryptorInterface> frame_decryptor,
@@ -1127,7 +1226,8 @@ std::unique_ptr<ChannelReceiveInterface> CreateChannelReceive(
       clock, neteq_factory, audio_device_module, rtcp_send_transport,
       rtc_event_log, local_ssrc, remote_ssrc, jitter_buffer_max_packets,
       jitter_buffer_fast_playout, jitter_buffer_min_delay_ms,
-      enable_non_sender_rtt, decoder_factory, codec_pair_id,
+      enable_non_sender_rtt, enable_cpu_time_accounting,
+      lazy_neteq_idle_release_time, decoder_factory, codec_pair_id,
       std::move(frame_decryptor), crypto_options, std::move(frame_transformer));
 }
 
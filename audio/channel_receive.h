@@ -25,6 +25,7 @@
 #include "api/frame_transformer_interface.h"
 #include "api/neteq/neteq_factory.h"
 #include "api/transport/rtp/rtp_source.h"
+#include "api/units/time_delta.h"
 #include "call/rtp_packet_sink_interface.h"
 #include "call/syncable.h"
 #include "modules/audio_coding/include/audio_coding_module_typedefs.h"
@@ -109,6 +110,11 @@ class ChannelReceiveInterface : public RtpPacketSinkInterface {
   // https://w3c.github.io/webrtc-stats/#dom-rtcmediastreamtrackstats-totalaudioenergy
   virtual double GetTotalOutputEnergy() const = 0;
   virtual double GetTotalOutputDuration() const = 0;
+  // Thread CPU time spent in NetEq producing audio for playout. Only set when
+  // CPU time accounting is enabled.
+  virtual absl::optional<TimeDelta> GetTotalDecodeCpuTime() const = 0;
+  // Bytes held by the NetEq packet buffer and audio buffers.
+  virtual size_t GetNetEqMemoryUsageBytes() const = 0;
 
   // Stats.
   virtual NetworkStatistics GetNetworkStatistics(
@@ -148,6 +154,14 @@ class ChannelReceiveInterface : public RtpPacketSinkInterface {
 
   virtual int PreferredSampleRate() const = 0;
 
+  // See AudioMixer::Source::ReceivedAudioLevel().
+  virtual absl::optional<int> ReceivedAudioLevel() const = 0;
+
+  // Discards the audio buffered for playout instead of decoding it, for when
+  // it is not mixed. Packets keep being reported to the source tracker until
+  // the next call to GetAudioFrameWithInfo().
+  virtual void SkipAudioFrame() = 0;
+
   // Sets the source tracker to notify about "delivered" packets when output is
   // muted.
   virtual void SetSourceTracker(SourceTracker* source_tracker) = 0;
@@ -170,6 +184,9 @@ class ChannelReceiveInterface : public RtpPacketSinkInterface {
   virtual uint32_t GetLocalSsrc() const = 0;
 };
 
+// If `lazy_neteq_idle_release_time` is set, the channel creates NetEq on the
+// first audio packet rather than up front, and releases it again after that
+// long without audio packets, unless it is infinite.
 std::unique_ptr<ChannelReceiveInterface> CreateChannelReceive(
     Clock* clock,
     NetEqFactory* neteq_factory,
@@ -182,6 +199,8 @@ std::unique_ptr<ChannelReceiveInterface> CreateChannelReceive(
     bool jitter_buffer_fast_playout,
     int jitter_buffer_min_delay_ms,
     bool enable_non_sender_rtt,
+    bool enable_cpu_time_accounting,
+    absl::optional<TimeDelta> lazy_neteq_idle_release_time,
     rtc::scoped_refptr<AudioDecoderFactory> decoder_factory,
     absl::optional<AudioCodecPairId> codec_pair_id,
     rtc::scoped_refptr<FrameDecryptorInterface> frame_decryptor,
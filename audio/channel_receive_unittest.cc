@@ -67,7 +67,10 @@ class ChannelReceiveTest : public Test {
         /* jitter_buffer_max_packets= */ 0,
         /* jitter_buffer_fast_playout= */ false,
         /* jitter_buffer_min_delay_ms= */ 0,
-        /* enable_non_sender_rtt= */ false, audio_decoder_factory_,
+        /* enable_non_sender_rtt= */ false,
+        /* enable_cpu_time_accounting= */ false,
+        /* lazy_neteq_idle_release_time= */ absl::nullopt,
+        audio_decoder_factory_,
         /* codec_pair_id= */ absl::nullopt,
         /* frame_decryptor_interface= */ nullptr, crypto_options,
         /* frame_transformer= */ nullptr);
@@ -133,6 +133,8 @@ class ChannelSend : public ChannelSendInterface,
   // can go back to sleep and be prepared to deliver an new captured audio
   // packet.
   void ProcessAndEncodeAudio(std::unique_ptr<AudioFrame> audio_frame) override;
+  void ProcessAndEncodeSharedAudio(
+      rtc::scoped_refptr<const SharedAudioFrame> audio_frame) override;
 
   int64_t GetRTT() const override;
 
@@ -165,6 +167,17 @@ class ChannelSend : public ChannelSendInterface,
 
   bool InputMute() const;
 
+  // Returns the RTP timestamp offset of the next captured `audio_frame`.
+  uint32_t NextFrameTimestamp(const AudioFrame& audio_frame);
+
+  // Mutes if needed, measures the level of, and encodes `audio_frame` as if
+  // its `timestamp_` was `timestamp`. Muting is done in place when
+  // `writable_frame` points to `audio_frame`, and on a copy when it is null.
+  void EncodeOnTaskQueue(const AudioFrame& audio_frame,
+                         uint32_t timestamp,
+                         AudioFrame* writable_frame)
+      RTC_RUN_ON(encoder_queue_checker_);
+
   int32_t SendRtpAudio(AudioFrameType frameType,
                        uint8_t payloadType,
                        uint32_t rtp_timestamp_without_offset,
@@ -209,6 +222,8 @@ class ChannelSend : public ChannelSendInterface,
   RmsLevel rms_level_ RTC_GUARDED_BY(encoder_queue_checker_);
   bool input_mute_ RTC_GUARDED_BY(volume_settings_mutex_) = false;
   bool previous_frame_muted_ RTC_GUARDED_BY(encoder_queue_checker_) = false;
+  // Muted copy of a frame shared with other channels.
+  AudioFrame mute_frame_ RTC_GUARDED_BY(encoder_queue_checker_);
 
   PacketRouter* packet_router_ RTC_GUARDED_BY(&worker_thread_checker_) =
       nullptr;
@@ -740,27 +755,7 @@ void ChannelSend::ProcessAndEncodeAudio(
     return;
   }
 
-  // Update `timestamp_` based on the capture timestamp for the first frame
-  // after sending is resumed.
-  if (first_frame_.load()) {
-    first_frame_.store(false);
-    if (last_capture_timestamp_ms_ &&
-        audio_frame->absolute_capture_timestamp_ms()) {
-      int64_t diff_ms = *audio_frame->absolute_capture_timestamp_ms() -
-                        *last_capture_timestamp_ms_;
-      // Truncate to whole frames and subtract one since `timestamp_` was
-      // incremented after the last frame.
-      int64_t diff_frames = diff_ms * audio_frame->sample_rate_hz() / 1000 /
-                                audio_frame->samples_per_channel() -
-                            1;
-      timestamp_ += std::max<int64_t>(
-          diff_frames * audio_frame->samples_per_channel(), 0);
-    }
-  }
-
-  audio_frame->timestamp_ = timestamp_;
-  timestamp_ += audio_frame->samples_per_channel_;
-  last_capture_timestamp_ms_ = audio_frame->absolute_capture_timestamp_ms();
+  audio_frame->timestamp_ = NextFrameTimestamp(*audio_frame);
 
   // Profile time between when the audio frame is added to the task queue and
   // when the task is actually executed.
@@ -776,35 +771,101 @@ void ChannelSend::ProcessAndEncodeAudio(
         // unwanted extra latency added by the task queue.
         RTC_HISTOGRAM_COUNTS_10000("WebRTC.Audio.EncodingTaskQueueLatencyMs",
                                    audio_frame->ElapsedProfileTimeMs());
-
-        bool is_muted = InputMute();
-        AudioFrameOperations::Mute(audio_frame.get(), previous_frame_muted_,
-                                   is_muted);
-
-        if (include_audio_level_indication_.load()) {
-          size_t length =
-              audio_frame->samples_per_channel_ * audio_frame->num_channels_;
-          RTC_CHECK_LE(length, AudioFrame::kMaxDataSizeBytes);
-          if (is_muted && previous_frame_muted_) {
-            rms_level_.AnalyzeMuted(length);
-          } else {
-            rms_level_.Analyze(
-                rtc::ArrayView<const int16_t>(audio_frame->data(), length));
-          }
-        }
-        previous_frame_muted_ = is_muted;
-
-        // This call will trigger AudioPacketizationCallback::SendData if
-        // encoding is done and payload is ready for packetization and
-        // transmission. Otherwise, it will return without invoking the
-        // callback.
-        if (audio_coding_->Add10MsData(*audio_frame) < 0) {
-          RTC_DLOG(LS_ERROR) << "ACM::Add10MsData() failed.";
-          return;
-        }
+        EncodeOnTaskQueue(*audio_frame, audio_frame->timestamp_,
+                          audio_frame.get());
       });
 }
 
+void ChannelSend::ProcessAndEncodeSharedAudio(
+    rtc::scoped_refptr<const SharedAudioFrame> audio_frame) {
+  TRACE_EVENT0("webrtc", "ChannelSend::ProcessAndEncodeSharedAudio");
+
+  RTC_DCHECK_RUNS_SERIALIZED(&audio_thread_race_checker_);
+  RTC_DCHECK_GT(audio_frame->samples_per_channel_, 0);
+  RTC_DCHECK_LE(audio_frame->num_channels_, 8);
+
+  if (!encoder_queue_is_active_.load()) {
+    return;
+  }
+
+  // The frame is shared with other channels, so its timestamp and profile
+  // timestamp are kept here instead of in the frame.
+  const uint32_t timestamp = NextFrameTimestamp(*audio_frame);
+  const int64_t enqueue_time_ms = rtc::TimeMillis();
+  encoder_queue_->PostTask([this, audio_frame = std::move(audio_frame),
+                            timestamp, enqueue_time_ms] {
+    RTC_DCHECK_RUN_ON(&encoder_queue_checker_);
+    if (!encoder_queue_is_active_.load()) {
+      return;
+    }
+    RTC_HISTOGRAM_COUNTS_10000("WebRTC.Audio.EncodingTaskQueueLatencyMs",
+                               rtc::TimeSince(enqueue_time_ms));
+    EncodeOnTaskQueue(*audio_frame, timestamp, /*writable_frame=*/nullptr);
+  });
+}
+
+uint32_t ChannelSend::NextFrameTimestamp(const AudioFrame& audio_frame) {
+  RTC_DCHECK_RUNS_SERIALIZED(&audio_thread_race_checker_);
+  // Update `timestamp_` based on the capture timestamp for the first frame
+  // after sending is resumed.
+  if (first_frame_.load()) {
+    first_frame_.store(false);
+    if (last_capture_timestamp_ms_ &&
+        audio_frame.absolute_capture_timestamp_ms()) {
+      int64_t diff_ms = *audio_frame.absolute_capture_timestamp_ms() -
+                        *last_capture_timestamp_ms_;
+      // Truncate to whole frames and subtract one since `timestamp_` was
+      // incremented after the last frame.
+      int64_t diff_frames = diff_ms * audio_frame.sample_rate_hz() / 1000 /
+                                audio_frame.samples_per_channel() -
+                            1;
+      timestamp_ += std::max<int64_t>(
+          diff_frames * audio_frame.samples_per_channel(), 0);
+    }
+  }
+
+  const uint32_t timestamp = timestamp_;
+  timestamp_ += audio_frame.samples_per_channel_;
+  last_capture_timestamp_ms_ = audio_frame.absolute_capture_timestamp_ms();
+  return timestamp;
+}
+
+void ChannelSend::EncodeOnTaskQueue(const AudioFrame& audio_frame,
+                                    uint32_t timestamp,
+                                    AudioFrame* writable_frame) {
+  bool is_muted = InputMute();
+  const AudioFrame* frame = &audio_frame;
+  if (is_muted || previous_frame_muted_) {
+    // Copy on write if the frame is shared with other channels.
+    if (!writable_frame) {
+      mute_frame_.CopyFrom(audio_frame);
+      writable_frame = &mute_frame_;
+    }
+    AudioFrameOperations::Mute(writable_frame, previous_frame_muted_,
+                               is_muted);
+    frame = writable_frame;
+  }
+
+  if (include_audio_level_indication_.load()) {
+    size_t length = frame->samples_per_channel_ * frame->num_channels_;
+    RTC_CHECK_LE(length, AudioFrame::kMaxDataSizeBytes);
+    if (is_muted && previous_frame_muted_) {
+      rms_level_.AnalyzeMuted(length);
+    } else {
+      rms_level_.Analyze(rtc::ArrayView<const int16_t>(frame->data(), length));
+    }
+  }
+  previous_frame_muted_ = is_muted;
+
+  // This call will trigger AudioPacketizationCallback::SendData if
+  // encoding is done and payload is ready for packetization and
+  // transmission. Otherwise, it will return without invoking the
+  // callback.
+  if (audio_coding_->Add10MsData(*frame, timestamp) < 0) {
+    RTC_DLOG(LS_ERROR) << "ACM::Add10MsData() failed.";
+  }
+}
+
 ANAStats ChannelSend::GetANAStatistics() const {
   RTC_DCHECK_RUN_ON(&worker_thread_checker_);
   return audio_coding_->GetANAStats();
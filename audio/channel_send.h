@@ -21,7 +21,9 @@
 #include "api/field_trials_view.h"
 #include "api/frame_transformer_interface.h"
 #include "api/function_view.h"
+#include "api/scoped_refptr.h"
 #include "api/task_queue/task_queue_factory.h"
+#include "call/audio_sender.h"
 #include "modules/rtp_rtcp/include/report_block_data.h"
 #include "modules/rtp_rtcp/source/rtp_rtcp_interface.h"
 #include "modules/rtp_rtcp/source/rtp_sender_audio.h"
@@ -87,6 +89,10 @@ class ChannelSendInterface {
 
   virtual void ProcessAndEncodeAudio(
       std::unique_ptr<AudioFrame> audio_frame) = 0;
+  // Same as ProcessAndEncodeAudio() for a frame shared with other channels,
+  // which is not modified.
+  virtual void ProcessAndEncodeSharedAudio(
+      rtc::scoped_refptr<const SharedAudioFrame> audio_frame) = 0;
   virtual RtpRtcpInterface* GetRtpRtcp() const = 0;
 
   // In RTP we currently rely on RTCP packets (`ReceivedRTCPPacket`) to inform
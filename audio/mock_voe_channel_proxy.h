@@ -48,6 +48,11 @@ class MockChannelReceive : public voe::ChannelReceiveInterface {
   MOCK_METHOD(int, GetSpeechOutputLevelFullRange, (), (const, override));
   MOCK_METHOD(double, GetTotalOutputEnergy, (), (const, override));
   MOCK_METHOD(double, GetTotalOutputDuration, (), (const, override));
+  MOCK_METHOD(absl::optional<TimeDelta>,
+              GetTotalDecodeCpuTime,
+              (),
+              (const, override));
+  MOCK_METHOD(size_t, GetNetEqMemoryUsageBytes, (), (const, override));
   MOCK_METHOD(uint32_t, GetDelayEstimate, (), (const, override));
   MOCK_METHOD(void, SetSink, (AudioSinkInterface*), (override));
   MOCK_METHOD(void, OnRtpPacket, (const RtpPacketReceived& packet), (override));
@@ -61,6 +66,8 @@ class MockChannelReceive : public voe::ChannelReceiveInterface {
               (int sample_rate_hz, AudioFrame*),
               (override));
   MOCK_METHOD(int, PreferredSampleRate, (), (const, override));
+  MOCK_METHOD(absl::optional<int>, ReceivedAudioLevel, (), (const, override));
+  MOCK_METHOD(void, SkipAudioFrame, (), (override));
   MOCK_METHOD(void, SetSourceTracker, (SourceTracker*), (override));
   MOCK_METHOD(void,
               SetAssociatedSendChannel,
@@ -167,6 +174,10 @@ class MockChannelSend : public voe::ChannelSendInterface {
               ProcessAndEncodeAudio,
               (std::unique_ptr<AudioFrame>),
               (override));
+  MOCK_METHOD(void,
+              ProcessAndEncodeSharedAudio,
+              (rtc::scoped_refptr<const SharedAudioFrame>),
+              (override));
   MOCK_METHOD(RtpRtcpInterface*, GetRtpRtcp, (), (const, override));
   MOCK_METHOD(int, GetTargetBitrate, (), (const, override));
   MOCK_METHOD(int64_t, GetRTT, (), (const, override));
@@ -0,0 +1,553 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "audio/shared_audio_encoder_pool.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <deque>
+#include <utility>
+
+#include "absl/algorithm/container.h"
+#include "api/array_view.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+namespace {
+
+// Number of encoded 10 ms blocks kept for members that are behind. Streams of
+// the same source are fed by the same audio callback, so they are never far
+// apart.
+constexpr size_t kMaxBlocks = 50;
+
+bool IsSilent(rtc::ArrayView<const int16_t> audio) {
+  return absl::c_all_of(audio, [](int16_t sample) { return sample == 0; });
+}
+
+}  // namespace
+
+// A shared encoder and the encoders of the pool using it.
+// The encoder runs on a timeline of its own. A member is in step when its
+// last block was found in, or added to, the encoded blocks, and `offset`
+// maps its RTP timestamps to the group's timeline.
+class SharedAudioEncoderPool::Group {
+ public:
+  Group(AudioEncoderFactory* factory,
+        int payload_type,
+        const SdpAudioFormat& format,
+        absl::optional<AudioCodecPairId> codec_pair_id,
+        const void* source,
+        std::unique_ptr<AudioEncoder> encoder)
+      : factory_(factory),
+        payload_type_(payload_type),
+        format_(format),
+        codec_pair_id_(codec_pair_id),
+        source_(source),
+        encoder_(std::move(encoder)),
+        timestamps_per_block_(encoder_->RtpTimestampRateHz() / 100) {}
+
+  bool Matches(AudioEncoderFactory* factory,
+               int payload_type,
+               const SdpAudioFormat& format,
+               absl::optional<AudioCodecPairId> codec_pair_id,
+               const void* source) const {
+    return factory == factory_ && payload_type == payload_type_ &&
+           format == format_ && codec_pair_id == codec_pair_id_ &&
+           source == source_;
+  }
+
+  void AddMember(SharedEncoder* member) {
+    MutexLock lock(&mutex_);
+    members_.push_back(Member{member});
+  }
+
+  // Returns true if no members remain.
+  bool RemoveMember(SharedEncoder* member) {
+    MutexLock lock(&mutex_);
+    auto it = absl::c_find_if(
+        members_, [&](const Member& m) { return m.encoder == member; });
+    RTC_DCHECK(it != members_.end());
+    members_.erase(it);
+    if (members_.empty()) {
+      return true;
+    }
+    ApplyRates();
+    return false;
+  }
+
+  // Writes the encoding of `audio` for `member` to `encoded` and `info`.
+  // Returns false if `member` is out of step and has to encode `audio`
+  // itself.
+  bool Encode(SharedEncoder* member,
+              uint32_t rtp_timestamp,
+              rtc::ArrayView<const int16_t> audio,
+              rtc::Buffer* encoded,
+              AudioEncoder::EncodedInfo* info) {
+    MutexLock lock(&mutex_);
+    Member& m = FindMember(member);
+    if (m.offset) {
+      const uint32_t timestamp = rtp_timestamp - *m.offset;
+      if (const Block* block = FindBlock(timestamp)) {
+        if (absl::c_equal(block->audio, audio)) {
+          m.in_step = true;
+          Deliver(*block, *m.offset, encoded, info);
+          return true;
+        }
+      } else if (timestamp == next_timestamp_ &&
+                 (m.in_step || !AnyMemberInStep())) {
+        m.in_step = true;
+        Deliver(EncodeBlock(audio), *m.offset, encoded, info);
+        return true;
+      }
+      m.in_step = false;
+    }
+
+    // Look for the audio among the encoded blocks. Silence would match
+    // anywhere, so the member waits for audio to get back in step.
+    if (!IsSilent(audio)) {
+      for (auto it = blocks_.rbegin(); it != blocks_.rend(); ++it) {
+        if (absl::c_equal(it->audio, audio)) {
+          m.offset = rtp_timestamp - it->timestamp;
+          m.in_step = true;
+          Deliver(*it, *m.offset, encoded, info);
+          return true;
+        }
+      }
+    }
+    if (AnyMemberInStep()) {
+      return false;
+    }
+    // No member is in step, so this one continues the group's timeline.
+    m.offset = rtp_timestamp - next_timestamp_;
+    m.in_step = true;
+    Deliver(EncodeBlock(audio), *m.offset, encoded, info);
+    return true;
+  }
+
+  void SetTargetBitrate(SharedEncoder* member, int target_bps) {
+    MutexLock lock(&mutex_);
+    FindMember(member).target_bitrate_bps = target_bps;
+    ApplyRates();
+  }
+
+  void SetPacketLossFraction(SharedEncoder* member, float fraction) {
+    MutexLock lock(&mutex_);
+    FindMember(member).packet_loss_fraction = fraction;
+    ApplyRates();
+  }
+
+  // Runs `function` on the encoder.
+  template <typename Function>
+  auto Call(Function function) const {
+    MutexLock lock(&mutex_);
+    return function(encoder_.get());
+  }
+
+ private:
+  struct Member {
+    SharedEncoder* encoder;
+    absl::optional<uint32_t> offset;
+    bool in_step = false;
+    int target_bitrate_bps = 0;
+    float packet_loss_fraction = 0.0f;
+  };
+
+  struct Block {
+    uint32_t timestamp;
+    std::vector<int16_t> audio;
+    AudioEncoder::EncodedInfo info;
+    rtc::Buffer payload;
+  };
+
+  Member& FindMember(SharedEncoder* member)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    auto it = absl::c_find_if(
+        members_, [&](const Member& m) { return m.encoder == member; });
+    RTC_DCHECK(it != members_.end());
+    return *it;
+  }
+
+  bool AnyMemberInStep() const RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return absl::c_any_of(members_, [](const Member& m) { return m.in_step; });
+  }
+
+  const Block* FindBlock(uint32_t timestamp) const
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    if (blocks_.empty()) {
+      return nullptr;
+    }
+    const uint32_t blocks_ago = (next_timestamp_ - timestamp - 1) /
+                                static_cast<uint32_t>(timestamps_per_block_);
+    if (blocks_ago >= blocks_.size()) {
+      return nullptr;
+    }
+    const Block& block = blocks_[blocks_.size() - 1 - blocks_ago];
+    return block.timestamp == timestamp ? &block : nullptr;
+  }
+
+  const Block& EncodeBlock(rtc::ArrayView<const int16_t> audio)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    if (blocks_.size() == kMaxBlocks) {
+      blocks_.pop_front();
+    }
+    blocks_.emplace_back();
+    Block& block = blocks_.back();
+    block.timestamp = next_timestamp_;
+    block.audio.assign(audio.begin(), audio.end());
+    block.info = encoder_->Encode(next_timestamp_, audio, &block.payload);
+    next_timestamp_ += timestamps_per_block_;
+    return block;
+  }
+
+  static void Deliver(const Block& block,
+                      uint32_t offset,
+                      rtc::Buffer* encoded,
+                      AudioEncoder::EncodedInfo* info) {
+    encoded->AppendData(block.payload);
+    *info = block.info;
+    info->encoded_timestamp += offset;
+    for (AudioEncoder::EncodedInfoLeaf& redundant : info->redundant) {
+      redundant.encoded_timestamp += offset;
+    }
+  }
+
+  // Runs the encoder at the lowest target bitrate and the highest packet loss
+  // of the members, so that the stream fits every member's link.
+  void ApplyRates() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    int target_bitrate_bps = 0;
+    float packet_loss_fraction = 0.0f;
+    for (const Member& member : members_) {
+      if (member.target_bitrate_bps > 0 &&
+          (target_bitrate_bps == 0 ||
+           member.target_bitrate_bps < target_bitrate_bps)) {
+        target_bitrate_bps = member.target_bitrate_bps;
+      }
+      packet_loss_fraction =
+          std::max(packet_loss_fraction, member.packet_loss_fraction);
+    }
+    if (target_bitrate_bps > 0 && target_bitrate_bps != applied_bitrate_bps_) {
+      encoder_->OnReceivedUplinkBandwidth(target_bitrate_bps, absl::nullopt);
+      applied_bitrate_bps_ = target_bitrate_bps;
+    }
+    if (packet_loss_fraction != applied_packet_loss_fraction_) {
+      encoder_->OnReceivedUplinkPacketLossFraction(packet_loss_fraction);
+      applied_packet_loss_fraction_ = packet_loss_fraction;
+    }
+  }
+
+  AudioEncoderFactory* const factory_;
+  const int payload_type_;
+  const SdpAudioFormat format_;
+  const absl::optional<AudioCodecPairId> codec_pair_id_;
+  const void* const source_;
+
+  mutable Mutex mutex_;
+  const std::unique_ptr<AudioEncoder> encoder_ RTC_PT_GUARDED_BY(mutex_);
+  const int timestamps_per_block_;
+  uint32_t next_timestamp_ RTC_GUARDED_BY(mutex_) = 0;
+  std::deque<Block> blocks_ RTC_GUARDED_BY(mutex_);
+  std::vector<Member> members_ RTC_GUARDED_BY(mutex_);
+  int applied_bitrate_bps_ RTC_GUARDED_BY(mutex_) = 0;
+  float applied_packet_loss_fraction_ RTC_GUARDED_BY(mutex_) = 0.0f;
+};
+
+// Encoder handed out by the pool. Forwards to its group, and encodes the
+// blocks the group can't provide with an encoder of its own, which is created
+// the first time it is needed.
+class SharedAudioEncoderPool::SharedEncoder : public AudioEncoder {
+ public:
+  SharedEncoder(SharedAudioEncoderPool* pool,
+                Group* group,
+                rtc::scoped_refptr<AudioEncoderFactory> factory,
+                int payload_type,
+                const SdpAudioFormat& format,
+                absl::optional<AudioCodecPairId> codec_pair_id)
+      : pool_(pool),
+        group_(group),
+        factory_(std::move(factory)),
+        payload_type_(payload_type),
+        format_(format),
+        codec_pair_id_(codec_pair_id) {}
+
+  ~SharedEncoder() override { pool_->Leave(this, group_); }
+
+  // AudioEncoder implementation.
+  int SampleRateHz() const override {
+    return group_->Call([](AudioEncoder* e) { return e->SampleRateHz(); });
+  }
+
+  size_t NumChannels() const override {
+    return group_->Call([](AudioEncoder* e) { return e->NumChannels(); });
+  }
+
+  int RtpTimestampRateHz() const override {
+    return group_->Call(
+        [](AudioEncoder* e) { return e->RtpTimestampRateHz(); });
+  }
+
+  size_t Num10MsFramesInNextPacket() const override {
+    return group_->Call(
+        [](AudioEncoder* e) { return e->Num10MsFramesInNextPacket(); });
+  }
+
+  size_t Max10MsFramesInAPacket() const override {
+    return group_->Call(
+        [](AudioEncoder* e) { return e->Max10MsFramesInAPacket(); });
+  }
+
+  int GetTargetBitrate() const override {
+    return group_->Call([](AudioEncoder* e) { return e->GetTargetBitrate(); });
+  }
+
+  void Reset() override {
+    if (own_encoder_) {
+      own_encoder_->Reset();
+    }
+  }
+
+  bool SetFec(bool enable) override {
+    fec_enabled_ = enable;
+    if (own_encoder_) {
+      own_encoder_->SetFec(enable);
+    }
+    return group_->Call([&](AudioEncoder* e) { return e->SetFec(enable); });
+  }
+
+  bool SetDtx(bool enable) override {
+    dtx_enabled_ = enable;
+    if (own_encoder_) {
+      own_encoder_->SetDtx(enable);
+    }
+    return group_->Call([&](AudioEncoder* e) { return e->SetDtx(enable); });
+  }
+
+  bool GetDtx() const override {
+    return group_->Call([](AudioEncoder* e) { return e->GetDtx(); });
+  }
+
+  bool SetApplication(Application application) override {
+    if (own_encoder_) {
+      own_encoder_->SetApplication(application);
+    }
+    return group_->Call(
+        [&](AudioEncoder* e) { return e->SetApplication(application); });
+  }
+
+  void SetMaxPlaybackRate(int frequency_hz) override {
+    if (own_encoder_) {
+      own_encoder_->SetMaxPlaybackRate(frequency_hz);
+    }
+    group_->Call(
+        [&](AudioEncoder* e) { e->SetMaxPlaybackRate(frequency_hz); });
+  }
+
+  void OnReceivedUplinkPacketLossFraction(
+      float uplink_packet_loss_fraction) override {
+    packet_loss_fraction_ = uplink_packet_loss_fraction;
+    if (own_encoder_) {
+      own_encoder_->OnReceivedUplinkPacketLossFraction(
+          uplink_packet_loss_fraction);
+    }
+    group_->SetPacketLossFraction(this, uplink_packet_loss_fraction);
+  }
+
+  void OnReceivedTargetAudioBitrate(int target_bps) override {
+    OnReceivedUplinkBandwidth(target_bps, absl::nullopt);
+  }
+
+  void OnReceivedUplinkBandwidth(
+      int target_audio_bitrate_bps,
+      absl::optional<int64_t> bwe_period_ms) override {
+    target_bitrate_bps_ = target_audio_bitrate_bps;
+    if (own_encoder_) {
+      own_encoder_->OnReceivedUplinkBandwidth(target_audio_bitrate_bps,
+                                              bwe_period_ms);
+    }
+    group_->SetTargetBitrate(this, target_audio_bitrate_bps);
+  }
+
+  void OnReceivedUplinkAllocation(BitrateAllocationUpdate update) override {
+    OnReceivedUplinkBandwidth(update.target_bitrate.bps(),
+                              update.bwe_period.ms());
+  }
+
+  void OnReceivedRtt(int rtt_ms) override {
+    if (own_encoder_) {
+      own_encoder_->OnReceivedRtt(rtt_ms);
+    }
+    group_->Call([&](AudioEncoder* e) { e->OnReceivedRtt(rtt_ms); });
+  }
+
+  void OnReceivedOverhead(size_t overhead_bytes_per_packet) override {
+    overhead_bytes_per_packet_ = overhead_bytes_per_packet;
+    if (own_encoder_) {
+      own_encoder_->OnReceivedOverhead(overhead_bytes_per_packet);
+    }
+    group_->Call([&](AudioEncoder* e) {
+      e->OnReceivedOverhead(overhead_bytes_per_packet);
+    });
+  }
+
+  void SetReceiverFrameLengthRange(int min_frame_length_ms,
+                                   int max_frame_length_ms) override {
+    if (own_encoder_) {
+      own_encoder_->SetReceiverFrameLengthRange(min_frame_length_ms,
+                                                max_frame_length_ms);
+    }
+    group_->Call([&](AudioEncoder* e) {
+      e->SetReceiverFrameLengthRange(min_frame_length_ms, max_frame_length_ms);
+    });
+  }
+
+  absl::optional<std::pair<TimeDelta, TimeDelta>> GetFrameLengthRange()
+      const override {
+    return group_->Call(
+        [](AudioEncoder* e) { return e->GetFrameLengthRange(); });
+  }
+
+  absl::optional<std::pair<DataRate, DataRate>> GetBitrateRange()
+      const override {
+    return group_->Call([](AudioEncoder* e) { return e->GetBitrateRange(); });
+  }
+
+ protected:
+  EncodedInfo EncodeImpl(uint32_t rtp_timestamp,
+                         rtc::ArrayView<const int16_t> audio,
+                         rtc::Buffer* encoded) override {
+    EncodedInfo info;
+    if (group_->Encode(this, rtp_timestamp, audio, encoded, &info)) {
+      if (own_encoder_used_) {
+        // Drop the audio buffered for a packet that won't be completed.
+        own_encoder_->Reset();
+        own_encoder_used_ = false;
+      }
+      return info;
+    }
+    if (!own_encoder_ && !CreateOwnEncoder()) {
+      return EncodedInfo();
+    }
+    own_encoder_used_ = true;
+    return own_encoder_->Encode(rtp_timestamp, audio, encoded);
+  }
+
+ private:
+  bool CreateOwnEncoder() {
+    own_encoder_ =
+        factory_->MakeAudioEncoder(payload_type_, format_, codec_pair_id_);
+    if (!own_encoder_) {
+      return false;
+    }
+    if (fec_enabled_) {
+      own_encoder_->SetFec(*fec_enabled_);
+    }
+    if (dtx_enabled_) {
+      own_encoder_->SetDtx(*dtx_enabled_);
+    }
+    if (target_bitrate_bps_ > 0) {
+      own_encoder_->OnReceivedUplinkBandwidth(target_bitrate_bps_,
+                                              absl::nullopt);
+    }
+    own_encoder_->OnReceivedUplinkPacketLossFraction(packet_loss_fraction_);
+    if (overhead_bytes_per_packet_ > 0) {
+      own_encoder_->OnReceivedOverhead(overhead_bytes_per_packet_);
+    }
+    return true;
+  }
+
+  SharedAudioEncoderPool* const pool_;
+  Group* const group_;
+  const rtc::scoped_refptr<AudioEncoderFactory> factory_;
+  const int payload_type_;
+  const SdpAudioFormat format_;
+  const absl::optional<AudioCodecPairId> codec_pair_id_;
+
+  // Settings applied to `own_encoder_` when it is created.
+  absl::optional<bool> fec_enabled_;
+  absl::optional<bool> dtx_enabled_;
+  int target_bitrate_bps_ = 0;
+  float packet_loss_fraction_ = 0.0f;
+  size_t overhead_bytes_per_packet_ = 0;
+
+  std::unique_ptr<AudioEncoder> own_encoder_;
+  bool own_encoder_used_ = false;
+};
+
+SharedAudioEncoderPool& SharedAudioEncoderPool::Default() {
+  static SharedAudioEncoderPool* const pool = new SharedAudioEncoderPool();
+  return *pool;
+}
+
+SharedAudioEncoderPool::SharedAudioEncoderPool() = default;
+
+SharedAudioEncoderPool::~SharedAudioEncoderPool() {
+  RTC_DCHECK(groups_.empty());
+}
+
+std::unique_ptr<AudioEncoder> SharedAudioEncoderPool::CreateEncoder(
+    rtc::scoped_refptr<AudioEncoderFactory> factory,
+    int payload_type,
+    const SdpAudioFormat& format,
+    absl::optional<AudioCodecPairId> codec_pair_id,
+    const void* source) {
+  if (source == nullptr) {
+    return factory->MakeAudioEncoder(payload_type, format, codec_pair_id);
+  }
+  MutexLock lock(&mutex_);
+  Group* group = nullptr;
+  for (const std::unique_ptr<Group>& g : groups_) {
+    if (g->Matches(factory.get(), payload_type, format, codec_pair_id,
+                   source)) {
+      group = g.get();
+      break;
+    }
+  }
+  if (!group) {
+    std::unique_ptr<AudioEncoder> encoder =
+        factory->MakeAudioEncoder(payload_type, format, codec_pair_id);
+    if (!encoder) {
+      return nullptr;
+    }
+    groups_.push_back(std::make_unique<Group>(factory.get(), payload_type,
+                                              format, codec_pair_id, source,
+                                              std::move(encoder)));
+    group = groups_.back().get();
+    RTC_LOG(LS_INFO) << "Created shared audio encoder for " << format.name
+                     << ", " << groups_.size() << " in use.";
+  }
+  auto member = std::make_unique<SharedEncoder>(
+      this, group, std::move(factory), payload_type, format, codec_pair_id);
+  group->AddMember(member.get());
+  return member;
+}
+
+size_t SharedAudioEncoderPool::NumGroups() const {
+  MutexLock lock(&mutex_);
+  return groups_.size();
+}
+
+void SharedAudioEncoderPool::Leave(SharedEncoder* member, Group* group) {
+  // Released after unlocking.
+  std::unique_ptr<Group> released;
+  MutexLock lock(&mutex_);
+  if (!group->RemoveMember(member)) {
+    return;
+  }
+  auto it = absl::c_find_if(groups_, [&](const std::unique_ptr<Group>& g) {
+    return g.get() == group;
+  });
+  RTC_DCHECK(it != groups_.end());
+  released = std::move(*it);
+  groups_.erase(it);
+}
+
+}  // namespace webrtc
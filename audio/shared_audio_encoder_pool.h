@@ -0,0 +1,80 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef AUDIO_SHARED_AUDIO_ENCODER_POOL_H_
+#define AUDIO_SHARED_AUDIO_ENCODER_POOL_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/audio_codecs/audio_codec_pair_id.h"
+#include "api/audio_codecs/audio_encoder.h"
+#include "api/audio_codecs/audio_encoder_factory.h"
+#include "api/audio_codecs/audio_format.h"
+#include "api/scoped_refptr.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Lets the send streams of several calls that send the same audio source with
+// the same codec share a single encoder, e.g. when one mix is sent to many
+// PeerConnections. Encoders created by the pool for the same source, factory,
+// payload type and format form a group with one encoder. Each 10 ms block of
+// audio is encoded once, by the first member to pass it in, and the other
+// members get a copy of the output with the timestamps moved to their own
+// RTP timeline. Members find the block they are at by comparing the audio,
+// so a member whose audio differs, e.g. because it is muted, encodes that
+// audio with an encoder of its own until it is back in step.
+// The encoder runs at the lowest target bitrate and highest packet loss of
+// the members. The audio network adaptor is not supported on shared encoders.
+// This class is thread safe.
+class SharedAudioEncoderPool {
+ public:
+  // Returns the process-wide pool.
+  static SharedAudioEncoderPool& Default();
+
+  SharedAudioEncoderPool();
+  ~SharedAudioEncoderPool();
+
+  SharedAudioEncoderPool(const SharedAudioEncoderPool&) = delete;
+  SharedAudioEncoderPool& operator=(const SharedAudioEncoderPool&) = delete;
+
+  // Returns an encoder for `format` that shares its encoder with the other
+  // encoders of this pool created for the same `source`, which only serves as
+  // a key. Returns null if `factory` fails to create an encoder.
+  std::unique_ptr<AudioEncoder> CreateEncoder(
+      rtc::scoped_refptr<AudioEncoderFactory> factory,
+      int payload_type,
+      const SdpAudioFormat& format,
+      absl::optional<AudioCodecPairId> codec_pair_id,
+      const void* source);
+
+  // Number of shared encoders in use.
+  size_t NumGroups() const;
+
+ private:
+  class Group;
+  class SharedEncoder;
+
+  // Removes `member` from `group`, destroying the group if it was the last
+  // member.
+  void Leave(SharedEncoder* member, Group* group);
+
+  mutable Mutex mutex_;
+  std::vector<std::unique_ptr<Group>> groups_ RTC_GUARDED_BY(mutex_);
+};
+
+}  // namespace webrtc
+
+#endif  // AUDIO_SHARED_AUDIO_ENCODER_POOL_H_
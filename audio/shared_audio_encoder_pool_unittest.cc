@@ -0,0 +1,213 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "audio/shared_audio_encoder_pool.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "api/make_ref_counted.h"
+#include "rtc_base/buffer.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+
+constexpr int kSampleRateHz = 48000;
+constexpr size_t kSamplesPer10Ms = kSampleRateHz / 100;
+constexpr int kPayloadType = 111;
+
+// Mono encoder putting one 10 ms block in each packet, whose payload is the
+// block's first sample.
+class FakeEncoder : public AudioEncoder {
+ public:
+  explicit FakeEncoder(std::vector<int>* encoded_samples,
+                       std::vector<int>* target_bitrates)
+      : encoded_samples_(encoded_samples), target_bitrates_(target_bitrates) {}
+
+  int SampleRateHz() const override { return kSampleRateHz; }
+  size_t NumChannels() const override { return 1; }
+  size_t Num10MsFramesInNextPacket() const override { return 1; }
+  size_t Max10MsFramesInAPacket() const override { return 1; }
+  int GetTargetBitrate() const override { return 32000; }
+  void Reset() override {}
+  absl::optional<std::pair<TimeDelta, TimeDelta>> GetFrameLengthRange()
+      const override {
+    return absl::nullopt;
+  }
+  void OnReceivedUplinkBandwidth(
+      int target_audio_bitrate_bps,
+      absl::optional<int64_t> bwe_period_ms) override {
+    target_bitrates_->push_back(target_audio_bitrate_bps);
+  }
+
+ protected:
+  EncodedInfo EncodeImpl(uint32_t rtp_timestamp,
+                         rtc::ArrayView<const int16_t> audio,
+                         rtc::Buffer* encoded) override {
+    encoded_samples_->push_back(audio[0]);
+    encoded->AppendData(static_cast<uint8_t>(audio[0]));
+    EncodedInfo info;
+    info.encoded_bytes = 1;
+    info.encoded_timestamp = rtp_timestamp;
+    info.payload_type = kPayloadType;
+    return info;
+  }
+
+ private:
+  std::vector<int>* const encoded_samples_;
+  std::vector<int>* const target_bitrates_;
+};
+
+class FakeEncoderFactory : public AudioEncoderFactory {
+ public:
+  std::vector<AudioCodecSpec> GetSupportedEncoders() override { return {}; }
+  absl::optional<AudioCodecInfo> QueryAudioEncoder(
+      const SdpAudioFormat& format) override {
+    return absl::nullopt;
+  }
+  std::unique_ptr<AudioEncoder> MakeAudioEncoder(
+      int payload_type,
+      const SdpAudioFormat& format,
+      absl::optional<AudioCodecPairId> codec_pair_id) override {
+    ++num_created;
+    return std::make_unique<FakeEncoder>(&encoded_samples, &target_bitrates);
+  }
+
+  int num_created = 0;
+  // First sample of every block encoded by the encoders of this factory.
+  std::vector<int> encoded_samples;
+  std::vector<int> target_bitrates;
+};
+
+std::vector<int16_t> Block(int16_t value) {
+  return std::vector<int16_t>(kSamplesPer10Ms, value);
+}
+
+struct Output {
+  uint32_t timestamp;
+  uint8_t payload;
+};
+
+Output Encode(AudioEncoder& encoder,
+              uint32_t rtp_timestamp,
+              const std::vector<int16_t>& audio) {
+  rtc::Buffer encoded;
+  AudioEncoder::EncodedInfo info =
+      encoder.Encode(rtp_timestamp, audio, &encoded);
+  EXPECT_EQ(info.encoded_bytes, 1u);
+  return {info.encoded_timestamp, encoded.empty() ? uint8_t{0} : encoded[0]};
+}
+
+class SharedAudioEncoderPoolTest : public ::testing::Test {
+ protected:
+  std::unique_ptr<AudioEncoder> CreateEncoder(const void* source) {
+    return pool_.CreateEncoder(factory_, kPayloadType,
+                               SdpAudioFormat("opus", kSampleRateHz, 2),
+                               absl::nullopt, source);
+  }
+
+  const rtc::scoped_refptr<FakeEncoderFactory> factory_ =
+      rtc::make_ref_counted<FakeEncoderFactory>();
+  SharedAudioEncoderPool pool_;
+  const int source_ = 0;
+  const int other_source_ = 0;
+};
+
+TEST_F(SharedAudioEncoderPoolTest, EncodesEachBlockOnce) {
+  std::unique_ptr<AudioEncoder> a = CreateEncoder(&source_);
+  std::unique_ptr<AudioEncoder> b = CreateEncoder(&source_);
+  EXPECT_EQ(pool_.NumGroups(), 1u);
+  EXPECT_EQ(factory_->num_created, 1);
+
+  for (int i = 1; i <= 3; ++i) {
+    const uint32_t offset = (i - 1) * kSamplesPer10Ms;
+    Output output_a = Encode(*a, 1000 + offset, Block(i));
+    Output output_b = Encode(*b, 5000 + offset, Block(i));
+    EXPECT_EQ(output_a.timestamp, 1000 + offset);
+    EXPECT_EQ(output_b.timestamp, 5000 + offset);
+    EXPECT_EQ(output_a.payload, i);
+    EXPECT_EQ(output_b.payload, i);
+  }
+  EXPECT_THAT(factory_->encoded_samples, ElementsAre(1, 2, 3));
+}
+
+TEST_F(SharedAudioEncoderPoolTest, MemberBehindGetsEarlierBlocks) {
+  std::unique_ptr<AudioEncoder> a = CreateEncoder(&source_);
+  std::unique_ptr<AudioEncoder> b = CreateEncoder(&source_);
+
+  for (int i = 1; i <= 3; ++i) {
+    Encode(*a, (i - 1) * kSamplesPer10Ms, Block(i));
+  }
+  for (int i = 1; i <= 3; ++i) {
+    EXPECT_EQ(Encode(*b, 7 + (i - 1) * kSamplesPer10Ms, Block(i)).payload, i);
+  }
+  EXPECT_THAT(factory_->encoded_samples, ElementsAre(1, 2, 3));
+}
+
+TEST_F(SharedAudioEncoderPoolTest, DoesNotShareBetweenSources) {
+  std::unique_ptr<AudioEncoder> a = CreateEncoder(&source_);
+  std::unique_ptr<AudioEncoder> b = CreateEncoder(&other_source_);
+  EXPECT_EQ(pool_.NumGroups(), 2u);
+
+  Encode(*a, 0, Block(1));
+  Encode(*b, 0, Block(1));
+  EXPECT_THAT(factory_->encoded_samples, ElementsAre(1, 1));
+}
+
+TEST_F(SharedAudioEncoderPoolTest, MemberWithOtherAudioUsesOwnEncoder) {
+  std::unique_ptr<AudioEncoder> a = CreateEncoder(&source_);
+  std::unique_ptr<AudioEncoder> b = CreateEncoder(&source_);
+
+  Encode(*a, 0, Block(1));
+  Encode(*b, 0, Block(1));
+  // `b` is muted.
+  Encode(*a, kSamplesPer10Ms, Block(2));
+  EXPECT_EQ(Encode(*b, kSamplesPer10Ms, Block(0)).payload, 0);
+  EXPECT_EQ(factory_->num_created, 2);
+  // And back in step.
+  Encode(*a, 2 * kSamplesPer10Ms, Block(3));
+  EXPECT_EQ(Encode(*b, 2 * kSamplesPer10Ms, Block(3)).payload, 3);
+
+  EXPECT_THAT(factory_->encoded_samples, ElementsAre(1, 2, 0, 3));
+}
+
+TEST_F(SharedAudioEncoderPoolTest, RunsAtLowestTargetBitrate) {
+  std::unique_ptr<AudioEncoder> a = CreateEncoder(&source_);
+  std::unique_ptr<AudioEncoder> b = CreateEncoder(&source_);
+
+  a->OnReceivedUplinkBandwidth(40000, absl::nullopt);
+  b->OnReceivedUplinkBandwidth(24000, absl::nullopt);
+  a->OnReceivedUplinkBandwidth(20000, absl::nullopt);
+  b.reset();
+  EXPECT_THAT(factory_->target_bitrates, ElementsAre(40000, 24000, 20000));
+}
+
+TEST_F(SharedAudioEncoderPoolTest, ReleasesGroupWithLastMember) {
+  std::unique_ptr<AudioEncoder> a = CreateEncoder(&source_);
+  std::unique_ptr<AudioEncoder> b = CreateEncoder(&source_);
+  a.reset();
+  EXPECT_EQ(pool_.NumGroups(), 1u);
+  b.reset();
+  EXPECT_EQ(pool_.NumGroups(), 0u);
+}
+
+TEST_F(SharedAudioEncoderPoolTest, DoesNotShareWithoutSource) {
+  std::unique_ptr<AudioEncoder> a = CreateEncoder(nullptr);
+  EXPECT_NE(a, nullptr);
+  EXPECT_EQ(pool_.NumGroups(), 0u);
+}
+
+}  // namespace
+}  // namespace webrtc
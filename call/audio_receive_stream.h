@@ -88,6 +88,10 @@ class AudioReceiveStreamInterface : public MediaReceiveStreamInterface {
     double relative_packet_arrival_delay_seconds = 0.0;
     int32_t interruption_count = 0;
     int32_t total_interruption_duration_ms = 0;
+    // Non-standard. Thread CPU time spent in NetEq producing audio for
+    // playout. Only set when the "WebRTC-PerStreamCpuTime" field trial is
+    // enabled.
+    absl::optional<TimeDelta> total_decode_cpu_time;
     // https://w3c.github.io/webrtc-stats/#dom-rtcinboundrtpstreamstats-estimatedplayouttimestamp
     absl::optional<int64_t> estimated_playout_ntp_timestamp_ms;
     // Remote outbound stats derived by the received RTCP sender reports.
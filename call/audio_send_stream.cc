@@ -37,6 +37,7 @@ std::string AudioSendStream::Config::ToString() const {
   ss << ", has_dscp: " << (has_dscp ? "true" : "false");
   ss << ", send_codec_spec: "
      << (send_codec_spec ? send_codec_spec->ToString() : "<unset>");
+  ss << ", share_encoder: " << (shared_encoder_source ? "true" : "false");
   ss << "}";
   return ss.Release();
 }
@@ -153,6 +153,11 @@ class AudioSendStream : public AudioSender {
     rtc::scoped_refptr<AudioEncoderFactory> encoder_factory;
     absl::optional<AudioCodecPairId> codec_pair_id;
 
+    // If set, the encoder is shared with the send streams, also those of other
+    // calls, that have the same source and send codec, so that the audio is
+    // encoded once for all of them. Only serves as a key.
+    const void* shared_encoder_source = nullptr;
+
     // Track ID as specified during track creation.
     std::string track_id;
 
@@ -12,16 +12,32 @@
 #define CALL_AUDIO_SENDER_H_
 
 #include <memory>
+#include <utility>
 
 #include "api/audio/audio_frame.h"
+#include "api/scoped_refptr.h"
+#include "rtc_base/ref_counted_object.h"
 
 namespace webrtc {
 
+// Captured audio handed to several senders at once. It must not be modified;
+// a sender that needs to change the audio works on a copy of its own.
+using SharedAudioFrame = rtc::FinalRefCountedObject<AudioFrame>;
+
 class AudioSender {
  public:
   // Encode and send audio.
   virtual void SendAudioData(std::unique_ptr<AudioFrame> audio_frame) = 0;
 
+  // Encode and send audio that is shared with other senders. The default
+  // implementation sends a copy.
+  virtual void SendSharedAudioData(
+      rtc::scoped_refptr<const SharedAudioFrame> audio_frame) {
+    auto audio_frame_copy = std::make_unique<AudioFrame>();
+    audio_frame_copy->CopyFrom(*audio_frame);
+    SendAudioData(std::move(audio_frame_copy));
+  }
+
   virtual ~AudioSender() = default;
 };
 
@@ -20,6 +20,7 @@
 #include "api/units/data_rate.h"
 #include "api/units/time_delta.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/numerics/safe_minmax.h"
 #include "system_wrappers/include/clock.h"
@@ -41,6 +42,22 @@ const uint32_t kMinToggleBitrateBps = 20000;
 
 const int64_t kBweLogIntervalMs = 5000;
 
+absl::optional<double> ParseUpdateHysteresis(
+    const FieldTrialsView& field_trials) {
+  FieldTrialOptional<double> hysteresis("hysteresis");
+  ParseFieldTrial({&hysteresis}, field_trials.Lookup(
+                                     "WebRTC-BitrateAllocator-SkipUnchanged"));
+  return hysteresis.GetOptional();
+}
+
+bool WithinHysteresis(DataRate last, DataRate current, double hysteresis) {
+  // Changes to or from zero pause or resume the observer and must always be
+  // delivered.
+  if (last.IsZero() || current.IsZero())
+    return last == current;
+  return std::abs(current.bps() - last.bps()) <= hysteresis * last.bps();
+}
+
 double MediaRatio(uint32_t allocated_bitrate, uint32_t protection_bitrate) {
   RTC_DCHECK_GT(allocated_bitrate, 0);
   if (protection_bitrate == 0)
@@ -78,34 +95,37 @@ void DistributeBitrateEvenly(
     uint32_t bitrate,
     bool include_zero_allocations,
     int max_multiplier,
-    std::map<BitrateAllocatorObserver*, int>* allocation) {
+    std::vector<int>* allocation) {
   RTC_DCHECK_EQ(allocation->size(), allocatable_tracks.size());
 
-  std::multimap<uint32_t, const AllocatableTrack*> list_max_bitrates;
-  for (const auto& observer_config : allocatable_tracks) {
-    if (include_zero_allocations ||
-        allocation->at(observer_config.observer) != 0) {
-      list_max_bitrates.insert(
-          {observer_config.config.max_bitrate_bps, &observer_config});
-    }
+  // Indices of the observers to distribute to, in order of increasing max
+  // bitrate.
+  std::vector<size_t> by_max_bitrate;
+  by_max_bitrate.reserve(allocatable_tracks.size());
+  for (size_t i = 0; i < allocatable_tracks.size(); ++i) {
+    if (include_zero_allocations || (*allocation)[i] != 0)
+      by_max_bitrate.push_back(i);
   }
-  auto it = list_max_bitrates.begin();
-  while (it != list_max_bitrates.end()) {
+  absl::c_stable_sort(by_max_bitrate, [&](size_t a, size_t b) {
+    return allocatable_tracks[a].config.max_bitrate_bps <
+           allocatable_tracks[b].config.max_bitrate_bps;
+  });
+  for (size_t n = 0; n < by_max_bitrate.size(); ++n) {
     RTC_DCHECK_GT(bitrate, 0);
+    size_t i = by_max_bitrate[n];
+    uint32_t max_bitrate = allocatable_tracks[i].config.max_bitrate_bps;
     uint32_t extra_allocation =
-        bitrate / static_cast<uint32_t>(list_max_bitrates.size());
-    uint32_t total_allocation =
-        extra_allocation + allocation->at(it->second->observer);
+        bitrate / static_cast<uint32_t>(by_max_bitrate.size() - n);
+    uint32_t total_allocation = extra_allocation + (*allocation)[i];
     bitrate -= extra_allocation;
-    if (total_allocation > max_multiplier * it->first) {
+    if (total_allocation > max_multiplier * max_bitrate) {
       // There is more than we can fit for this observer, carry over to the
       // remaining observers.
-      bitrate += total_allocation - max_multiplier * it->first;
-      total_allocation = max_multiplier * it->first;
+      bitrate += total_allocation - max_multiplier * max_bitrate;
+      total_allocation = max_multiplier * max_bitrate;
     }
     // Finally, update the allocation for this observer.
-    allocation->at(it->second->observer) = total_allocation;
-    it = list_max_bitrates.erase(it);
+    (*allocation)[i] = total_allocation;
   }
 }
 
@@ -118,13 +138,13 @@ void DistributeBitrateEvenly(
 void DistributeBitrateRelatively(
     const std::vector<AllocatableTrack>& allocatable_tracks,
     uint32_t remaining_bitrate,
-    const std::map<BitrateAllocatorObserver*, int>& observers_capacities,
-    std::map<BitrateAllocatorObserver*, int>* allocation) {
+    const std::vector<int>& observers_capacities,
+    std::vector<int>* allocation) {
   RTC_DCHECK_EQ(allocation->size(), allocatable_tracks.size());
   RTC_DCHECK_EQ(observers_capacities.size(), allocatable_tracks.size());
 
   struct PriorityRateObserverConfig {
-    BitrateAllocatorObserver* allocation_key;
+    size_t allocation_key;
     // The amount of bitrate bps that can be allocated to this observer.
     int capacity_bps;
     double bitrate_priority;
@@ -132,12 +152,12 @@ void DistributeBitrateRelatively(
 
   double bitrate_priority_sum = 0;
   std::vector<PriorityRateObserverConfig> priority_rate_observers;
-  for (const auto& observer_config : allocatable_tracks) {
+  priority_rate_observers.reserve(allocatable_tracks.size());
+  for (size_t i = 0; i < allocatable_tracks.size(); ++i) {
     priority_rate_observers.push_back(PriorityRateObserverConfig{
-        observer_config.observer,
-        observers_capacities.at(observer_config.observer),
-        observer_config.config.bitrate_priority});
-    bitrate_priority_sum += observer_config.config.bitrate_priority;
+        i, observers_capacities[i],
+        allocatable_tracks[i].config.bitrate_priority});
+    bitrate_priority_sum += allocatable_tracks[i].config.bitrate_priority;
   }
 
   // Iterate in the order observers can be allocated their full capacity.
@@ -166,7 +186,7 @@ void DistributeBitrateRelatively(
     bool enough_bitrate = allocation_bps >= priority_rate_observer.capacity_bps;
     if (!enough_bitrate)
       break;
-    allocation->at(priority_rate_observer.allocation_key) +=
+    (*allocation)[priority_rate_observer.allocation_key] +=
         priority_rate_observer.capacity_bps;
     remaining_bitrate -= priority_rate_observer.capacity_bps;
     bitrate_priority_sum -= priority_rate_observer.bitrate_priority;
@@ -178,39 +198,41 @@ void DistributeBitrateRelatively(
     const auto& priority_rate_observer = priority_rate_observers[i];
     double fraction_allocated =
         priority_rate_observer.bitrate_priority / bitrate_priority_sum;
-    allocation->at(priority_rate_observer.allocation_key) +=
+    (*allocation)[priority_rate_observer.allocation_key] +=
         fraction_allocated * remaining_bitrate;
   }
 }
 
 // Allocates bitrate to observers when there isn't enough to allocate the
 // minimum to all observers.
-std::map<BitrateAllocatorObserver*, int> LowRateAllocation(
+std::vector<int> LowRateAllocation(
     const std::vector<AllocatableTrack>& allocatable_tracks,
     uint32_t bitrate) {
-  std::map<BitrateAllocatorObserver*, int> allocation;
+  std::vector<int> allocation(allocatable_tracks.size(), 0);
   // Start by allocating bitrate to observers enforcing a min bitrate, hence
   // remaining_bitrate might turn negative.
   int64_t remaining_bitrate = bitrate;
-  for (const auto& observer_config : allocatable_tracks) {
+  for (size_t i = 0; i < allocatable_tracks.size(); ++i) {
+    const auto& observer_config = allocatable_tracks[i];
     int32_t allocated_bitrate = 0;
     if (observer_config.config.enforce_min_bitrate)
       allocated_bitrate = observer_config.config.min_bitrate_bps;
 
-    allocation[observer_config.observer] = allocated_bitrate;
+    allocation[i] = allocated_bitrate;
     remaining_bitrate -= allocated_bitrate;
   }
 
   // Allocate bitrate to all previously active streams.
   if (remaining_bitrate > 0) {
-    for (const auto& observer_config : allocatable_tracks) {
+    for (size_t i = 0; i < allocatable_tracks.size(); ++i) {
+      const auto& observer_config = allocatable_tracks[i];
       if (observer_config.config.enforce_min_bitrate ||
           observer_config.LastAllocatedBitrate() == 0)
         continue;
 
       uint32_t required_bitrate = observer_config.MinBitrateWithHysteresis();
       if (remaining_bitrate >= required_bitrate) {
-        allocation[observer_config.observer] = required_bitrate;
+        allocation[i] = required_bitrate;
         remaining_bitrate -= required_bitrate;
       }
     }
@@ -218,14 +240,15 @@ std::map<BitrateAllocatorObserver*, int> LowRateAllocation(
 
   // Allocate bitrate to previously paused streams.
   if (remaining_bitrate > 0) {
-    for (const auto& observer_config : allocatable_tracks) {
+    for (size_t i = 0; i < allocatable_tracks.size(); ++i) {
+      const auto& observer_config = allocatable_tracks[i];
       if (observer_config.LastAllocatedBitrate() != 0)
         continue;
 
       // Add a hysteresis to avoid toggling.
       uint32_t required_bitrate = observer_config.MinBitrateWithHysteresis();
       if (remaining_bitrate >= required_bitrate) {
-        allocation[observer_config.observer] = required_bitrate;
+        allocation[i] = required_bitrate;
         remaining_bitrate -= required_bitrate;
       }
     }
@@ -251,32 +274,30 @@ std::map<BitrateAllocatorObserver*, int> LowRateAllocation(
 // bitrate_priority = 2.0, the expected behavior is that observer 2 will be
 // allocated twice the bitrate as observer 1 above the each observer's
 // min_bitrate_bps values, until one of the observers hits its max_bitrate_bps.
-std::map<BitrateAllocatorObserver*, int> NormalRateAllocation(
+std::vector<int> NormalRateAllocation(
     const std::vector<AllocatableTrack>& allocatable_tracks,
     uint32_t bitrate,
     uint32_t sum_min_bitrates) {
-  std::map<BitrateAllocatorObserver*, int> allocation;
-  std::map<BitrateAllocatorObserver*, int> observers_capacities;
-  for (const auto& observer_config : allocatable_tracks) {
-    allocation[observer_config.observer] =
-        observer_config.config.min_bitrate_bps;
-    observers_capacities[observer_config.observer] =
-        observer_config.config.max_bitrate_bps -
-        observer_config.config.min_bitrate_bps;
+  std::vector<int> allocation(allocatable_tracks.size());
+  std::vector<int> observers_capacities(allocatable_tracks.size());
+  for (size_t i = 0; i < allocatable_tracks.size(); ++i) {
+    const auto& observer_config = allocatable_tracks[i];
+    allocation[i] = observer_config.config.min_bitrate_bps;
+    observers_capacities[i] = observer_config.config.max_bitrate_bps -
+                              observer_config.config.min_bitrate_bps;
   }
 
   bitrate -= sum_min_bitrates;
 
   // TODO(srte): Implement fair sharing between prioritized streams, currently
   // they are treated on a first come first serve basis.
-  for (const auto& observer_config : allocatable_tracks) {
-    int64_t priority_margin = observer_config.config.priority_bitrate_bps -
-                              allocation[observer_config.observer];
+  for (size_t i = 0; i < allocatable_tracks.size(); ++i) {
+    int64_t priority_margin =
+        allocatable_tracks[i].config.priority_bitrate_bps - allocation[i];
     if (priority_margin > 0 && bitrate > 0) {
       int64_t extra_bitrate = std::min<int64_t>(priority_margin, bitrate);
-      allocation[observer_config.observer] +=
-          rtc::dchecked_cast<int>(extra_bitrate);
-      observers_capacities[observer_config.observer] -= extra_bitrate;
+      allocation[i] += rtc::dchecked_cast<int>(extra_bitrate);
+      observers_capacities[i] -= extra_bitrate;
       bitrate -= extra_bitrate;
     }
   }
@@ -292,16 +313,15 @@ std::map<BitrateAllocatorObserver*, int> NormalRateAllocation(
 
 // Allocates bitrate to observers when there is enough available bandwidth
 // for all observers to be allocated their max bitrate.
-std::map<BitrateAllocatorObserver*, int> MaxRateAllocation(
+std::vector<int> MaxRateAllocation(
     const std::vector<AllocatableTrack>& allocatable_tracks,
     uint32_t bitrate,
     uint32_t sum_max_bitrates) {
-  std::map<BitrateAllocatorObserver*, int> allocation;
+  std::vector<int> allocation(allocatable_tracks.size());
 
-  for (const auto& observer_config : allocatable_tracks) {
-    allocation[observer_config.observer] =
-        observer_config.config.max_bitrate_bps;
-    bitrate -= observer_config.config.max_bitrate_bps;
+  for (size_t i = 0; i < allocatable_tracks.size(); ++i) {
+    allocation[i] = allocatable_tracks[i].config.max_bitrate_bps;
+    bitrate -= allocatable_tracks[i].config.max_bitrate_bps;
   }
   DistributeBitrateEvenly(allocatable_tracks, bitrate, true,
                           kTransmissionMaxBitrateMultiplier, &allocation);
@@ -309,19 +329,18 @@ std::map<BitrateAllocatorObserver*, int> MaxRateAllocation(
 }
 
 // Allocates zero bitrate to all observers.
-std::map<BitrateAllocatorObserver*, int> ZeroRateAllocation(
+std::vector<int> ZeroRateAllocation(
     const std::vector<AllocatableTrack>& allocatable_tracks) {
-  std::map<BitrateAllocatorObserver*, int> allocation;
-  for (const auto& observer_config : allocatable_tracks)
-    allocation[observer_config.observer] = 0;
-  return allocation;
+  return std::vector<int>(allocatable_tracks.size(), 0);
 }
 
-std::map<BitrateAllocatorObserver*, int> AllocateBitrates(
+// Returns the allocation of each track in `allocatable_tracks`, in the same
+// order.
+std::vector<int> AllocateBitrates(
     const std::vector<AllocatableTrack>& allocatable_tracks,
     uint32_t bitrate) {
   if (allocatable_tracks.empty())
-    return std::map<BitrateAllocatorObserver*, int>();
+    return std::vector<int>();
 
   if (bitrate == 0)
     return ZeroRateAllocation(allocatable_tracks);
@@ -351,8 +370,10 @@ std::map<BitrateAllocatorObserver*, int> AllocateBitrates(
 
 }  // namespace
 
-BitrateAllocator::BitrateAllocator(LimitObserver* limit_observer)
+BitrateAllocator::BitrateAllocator(LimitObserver* limit_observer,
+                                   const FieldTrialsView& field_trials)
     : limit_observer_(limit_observer),
+      update_hysteresis_(ParseUpdateHysteresis(field_trials)),
       last_target_bps_(0),
       last_stable_target_bps_(0),
       last_non_zero_bitrate_bps_(kDefaultBitrateBps),
@@ -394,14 +415,15 @@ void BitrateAllocator::OnNetworkEstimateChanged(TargetTransferRate msg) {
     last_bwe_log_time_ = now;
   }
 
-  auto allocation = AllocateBitrates(allocatable_tracks_, last_target_bps_);
-  auto stable_bitrate_allocation =
+  std::vector<int> allocation =
+      AllocateBitrates(allocatable_tracks_, last_target_bps_);
+  std::vector<int> stable_bitrate_allocation =
       AllocateBitrates(allocatable_tracks_, last_stable_target_bps_);
 
-  for (auto& config : allocatable_tracks_) {
-    uint32_t allocated_bitrate = allocation[config.observer];
-    uint32_t allocated_stable_target_rate =
-        stable_bitrate_allocation[config.observer];
+  for (size_t i = 0; i < allocatable_tracks_.size(); ++i) {
+    AllocatableTrack& config = allocatable_tracks_[i];
+    uint32_t allocated_bitrate = allocation[i];
+    uint32_t allocated_stable_target_rate = stable_bitrate_allocation[i];
     BitrateAllocationUpdate update;
     update.target_bitrate = DataRate::BitsPerSec(allocated_bitrate);
     update.stable_target_bitrate =
@@ -410,7 +432,10 @@ void BitrateAllocator::OnNetworkEstimateChanged(TargetTransferRate msg) {
     update.round_trip_time = TimeDelta::Millis(last_rtt_);
     update.bwe_period = TimeDelta::Millis(last_bwe_period_ms_);
     update.cwnd_reduce_ratio = msg.cwnd_reduce_ratio;
+    if (CanSkipUpdate(config, update))
+      continue;
     uint32_t protection_bitrate = config.observer->OnBitrateUpdated(update);
+    config.last_update = update;
 
     if (allocated_bitrate == 0 && config.allocated_bitrate_bps > 0) {
       if (last_target_bps_ > 0)
@@ -461,13 +486,14 @@ void BitrateAllocator::AddObserver(BitrateAllocatorObserver* observer,
   if (last_target_bps_ > 0) {
     // Calculate a new allocation and update all observers.
 
-    auto allocation = AllocateBitrates(allocatable_tracks_, last_target_bps_);
-    auto stable_bitrate_allocation =
+    std::vector<int> allocation =
+        AllocateBitrates(allocatable_tracks_, last_target_bps_);
+    std::vector<int> stable_bitrate_allocation =
         AllocateBitrates(allocatable_tracks_, last_stable_target_bps_);
-    for (auto& config : allocatable_tracks_) {
-      uint32_t allocated_bitrate = allocation[config.observer];
-      uint32_t allocated_stable_bitrate =
-          stable_bitrate_allocation[config.observer];
+    for (size_t i = 0; i < allocatable_tracks_.size(); ++i) {
+      AllocatableTrack& config = allocatable_tracks_[i];
+      uint32_t allocated_bitrate = allocation[i];
+      uint32_t allocated_stable_bitrate = stable_bitrate_allocation[i];
       BitrateAllocationUpdate update;
       update.target_bitrate = DataRate::BitsPerSec(allocated_bitrate);
       update.stable_target_bitrate =
@@ -475,7 +501,10 @@ void BitrateAllocator::AddObserver(BitrateAllocatorObserver* observer,
       update.packet_loss_ratio = last_fraction_loss_ / 256.0;
       update.round_trip_time = TimeDelta::Millis(last_rtt_);
       update.bwe_period = TimeDelta::Millis(last_bwe_period_ms_);
+      if (CanSkipUpdate(config, update))
+        continue;
       uint32_t protection_bitrate = config.observer->OnBitrateUpdated(update);
+      config.last_update = update;
       config.allocated_bitrate_bps = allocated_bitrate;
       if (allocated_bitrate > 0)
         config.media_ratio = MediaRatio(allocated_bitrate, protection_bitrate);
@@ -496,6 +525,22 @@ void BitrateAllocator::AddObserver(BitrateAllocatorObserver* observer,
   UpdateAllocationLimits();
 }
 
+bool BitrateAllocator::CanSkipUpdate(
+    const AllocatableTrack& track,
+    const BitrateAllocationUpdate& update) const {
+  if (!update_hysteresis_ || !track.last_update)
+    return false;
+  const BitrateAllocationUpdate& last = *track.last_update;
+  return WithinHysteresis(last.target_bitrate, update.target_bitrate,
+                          *update_hysteresis_) &&
+         WithinHysteresis(last.stable_target_bitrate,
+                          update.stable_target_bitrate, *update_hysteresis_) &&
+         last.packet_loss_ratio == update.packet_loss_ratio &&
+         last.round_trip_time == update.round_trip_time &&
+         last.bwe_period == update.bwe_period &&
+         last.cwnd_reduce_ratio == update.cwnd_reduce_ratio;
+}
+
 void BitrateAllocator::UpdateAllocationLimits() {
   BitrateAllocationLimits limits;
   for (const auto& config : allocatable_tracks_) {
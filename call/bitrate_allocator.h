@@ -19,7 +19,9 @@
 #include <utility>
 #include <vector>
 
+#include "absl/types/optional.h"
 #include "api/call/bitrate_allocation.h"
+#include "api/field_trials_view.h"
 #include "api/sequence_checker.h"
 #include "api/transport/network_types.h"
 #include "rtc_base/system/no_unique_address.h"
@@ -87,6 +89,8 @@ struct AllocatableTrack {
   MediaStreamAllocationConfig config;
   int64_t allocated_bitrate_bps;
   double media_ratio;  // Part of the total bitrate used for media [0.0, 1.0].
+  // The update most recently delivered to `observer`.
+  absl::optional<BitrateAllocationUpdate> last_update;
 
   uint32_t LastAllocatedBitrate() const;
   // The minimum bitrate required by this observer, including
@@ -110,7 +114,12 @@ class BitrateAllocator : public BitrateAllocatorInterface {
     virtual ~LimitObserver() = default;
   };
 
-  explicit BitrateAllocator(LimitObserver* limit_observer);
+  // If the "WebRTC-BitrateAllocator-SkipUnchanged" field trial sets a
+  // `hysteresis`, observers are not notified of updates where their target
+  // and stable target rates changed by at most that fraction and the network
+  // parameters are unchanged.
+  BitrateAllocator(LimitObserver* limit_observer,
+                   const FieldTrialsView& field_trials);
   ~BitrateAllocator() override;
 
   void UpdateStartRate(uint32_t start_rate_bps);
@@ -143,6 +152,11 @@ class BitrateAllocator : public BitrateAllocatorInterface {
   // calls LimitObserver::OnAllocationLimitsChanged.
   void UpdateAllocationLimits() RTC_RUN_ON(&sequenced_checker_);
 
+  // Returns true if `update` is close enough to the last update delivered to
+  // `track` that it does not need to be delivered.
+  bool CanSkipUpdate(const AllocatableTrack& track,
+                     const BitrateAllocationUpdate& update) const;
+
   // Allow packets to be transmitted in up to 2 times max video bitrate if the
   // bandwidth estimate allows it.
   // TODO(bugs.webrtc.org/8541): May be worth to refactor to keep this logic in
@@ -151,6 +165,7 @@ class BitrateAllocator : public BitrateAllocatorInterface {
 
   RTC_NO_UNIQUE_ADDRESS SequenceChecker sequenced_checker_;
   LimitObserver* const limit_observer_ RTC_GUARDED_BY(&sequenced_checker_);
+  const absl::optional<double> update_hysteresis_;
   // Stored in a list to keep track of the insertion order.
   std::vector<AllocatableTrack> allocatable_tracks_
       RTC_GUARDED_BY(&sequenced_checker_);
@@ -16,6 +16,7 @@
 
 #include "absl/strings/string_view.h"
 #include "system_wrappers/include/clock.h"
+#include "test/explicit_key_value_config.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 
@@ -68,6 +69,7 @@ class TestBitrateObserver : public BitrateAllocatorObserver {
   }
 
   uint32_t OnBitrateUpdated(BitrateAllocationUpdate update) override {
+    ++num_updates_;
     last_bitrate_bps_ = update.target_bitrate.bps();
     last_fraction_loss_ =
         rtc::dchecked_cast<uint8_t>(update.packet_loss_ratio * 256);
@@ -80,6 +82,7 @@ class TestBitrateObserver : public BitrateAllocatorObserver {
   int64_t last_rtt_ms_;
   int last_probing_interval_ms_;
   double protection_ratio_;
+  int num_updates_ = 0;
 };
 
 constexpr int64_t kDefaultProbingIntervalMs = 3000;
@@ -105,7 +108,8 @@ TargetTransferRate CreateTargetRateMessage(uint32_t target_bitrate_bps,
 
 class BitrateAllocatorTest : public ::testing::Test {
  protected:
-  BitrateAllocatorTest() : allocator_(new BitrateAllocator(&limit_observer_)) {
+  BitrateAllocatorTest()
+      : allocator_(new BitrateAllocator(&limit_observer_, field_trials_)) {
     allocator_->OnNetworkEstimateChanged(
         CreateTargetRateMessage(300000u, 0, 0, kDefaultProbingIntervalMs));
   }
@@ -132,6 +136,7 @@ class BitrateAllocatorTest : public ::testing::Test {
     return default_config;
   }
 
+  test::ExplicitKeyValueConfig field_trials_{""};
   NiceMock<MockLimitObserver> limit_observer_;
   std::unique_ptr<BitrateAllocator> allocator_;
 };
@@ -297,7 +302,7 @@ TEST_F(BitrateAllocatorTest, RemoveObserverTriggersLimitObserver) {
 class BitrateAllocatorTestNoEnforceMin : public ::testing::Test {
  protected:
   BitrateAllocatorTestNoEnforceMin()
-      : allocator_(new BitrateAllocator(&limit_observer_)) {
+      : allocator_(new BitrateAllocator(&limit_observer_, field_trials_)) {
     allocator_->OnNetworkEstimateChanged(
         CreateTargetRateMessage(300000u, 0, 0, kDefaultProbingIntervalMs));
   }
@@ -313,6 +318,7 @@ class BitrateAllocatorTestNoEnforceMin : public ::testing::Test {
         observer, {min_bitrate_bps, max_bitrate_bps, pad_up_bitrate_bps, 0,
                    enforce_min_bitrate, bitrate_priority});
   }
+  test::ExplicitKeyValueConfig field_trials_{""};
   NiceMock<MockLimitObserver> limit_observer_;
   std::unique_ptr<BitrateAllocator> allocator_;
 };
@@ -1034,4 +1040,63 @@ TEST_F(BitrateAllocatorTest, PriorityRateThreeObserversTwoAllocatedToMax) {
   allocator_->RemoveObserver(&observer_high);
 }
 
+TEST_F(BitrateAllocatorTest, DeliversUnchangedUpdatesByDefault) {
+  TestBitrateObserver observer;
+  AddObserver(&observer, 100000, 1500000, 0, true, kDefaultBitratePriority);
+  int num_updates = observer.num_updates_;
+  allocator_->OnNetworkEstimateChanged(
+      CreateTargetRateMessage(300000, 0, 50, kDefaultProbingIntervalMs));
+  allocator_->OnNetworkEstimateChanged(
+      CreateTargetRateMessage(300000, 0, 50, kDefaultProbingIntervalMs));
+  EXPECT_EQ(observer.num_updates_, num_updates + 2);
+  allocator_->RemoveObserver(&observer);
+}
+
+TEST(BitrateAllocatorSkipUnchangedTest, SkipsUpdatesWithinHysteresis) {
+  test::ExplicitKeyValueConfig field_trials(
+      "WebRTC-BitrateAllocator-SkipUnchanged/hysteresis:0.05/");
+  NiceMock<MockLimitObserver> limit_observer;
+  BitrateAllocator allocator(&limit_observer, field_trials);
+  TestBitrateObserver observer;
+  allocator.AddObserver(&observer, {/*min_bitrate_bps=*/30000,
+                                    /*max_bitrate_bps=*/1500000,
+                                    /*pad_up_bitrate_bps=*/0,
+                                    /*priority_bitrate_bps=*/0,
+                                    /*enforce_min_bitrate=*/false,
+                                    kDefaultBitratePriority});
+
+  allocator.OnNetworkEstimateChanged(
+      CreateTargetRateMessage(300000, 0, 50, kDefaultProbingIntervalMs));
+  EXPECT_EQ(observer.last_bitrate_bps_, 300000u);
+  int num_updates = observer.num_updates_;
+
+  // Identical update and small change are skipped.
+  allocator.OnNetworkEstimateChanged(
+      CreateTargetRateMessage(300000, 0, 50, kDefaultProbingIntervalMs));
+  allocator.OnNetworkEstimateChanged(
+      CreateTargetRateMessage(310000, 0, 50, kDefaultProbingIntervalMs));
+  EXPECT_EQ(observer.num_updates_, num_updates);
+  EXPECT_EQ(observer.last_bitrate_bps_, 300000u);
+
+  // Change beyond the hysteresis is delivered.
+  allocator.OnNetworkEstimateChanged(
+      CreateTargetRateMessage(330000, 0, 50, kDefaultProbingIntervalMs));
+  EXPECT_EQ(observer.num_updates_, num_updates + 1);
+  EXPECT_EQ(observer.last_bitrate_bps_, 330000u);
+
+  // Changed network parameters are always delivered.
+  allocator.OnNetworkEstimateChanged(
+      CreateTargetRateMessage(330000, 0, 80, kDefaultProbingIntervalMs));
+  EXPECT_EQ(observer.num_updates_, num_updates + 2);
+  EXPECT_EQ(observer.last_rtt_ms_, 80);
+
+  // As is pausing the observer.
+  allocator.OnNetworkEstimateChanged(
+      CreateTargetRateMessage(0, 0, 80, kDefaultProbingIntervalMs));
+  EXPECT_EQ(observer.num_updates_, num_updates + 3);
+  EXPECT_EQ(observer.last_bitrate_bps_, 0u);
+
+  allocator.RemoveObserver(&observer);
+}
+
 }  // namespace webrtc
@@ -57,6 +57,7 @@
 #include "modules/video_coding/fec_controller_default.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/memory_usage.h"
 #include "rtc_base/strings/string_builder.h"
 #include "rtc_base/system/no_unique_address.h"
 #include "rtc_base/task_utils/repeating_task.h"
@@ -67,8 +68,10 @@
 #include "system_wrappers/include/cpu_info.h"
 #include "system_wrappers/include/metrics.h"
 #include "video/call_stats2.h"
+#include "video/decode_thread_pool.h"
 #include "video/send_delay_stats.h"
 #include "video/stats_counter.h"
+#include "video/video_decoder_pool.h"
 #include "video/video_receive_stream2.h"
 #include "video/video_send_stream_impl.h"
 
@@ -350,6 +353,11 @@ class Call final : public webrtc::Call,
   RTC_NO_UNIQUE_ADDRESS SequenceChecker send_transport_sequence_checker_;
 
   const int num_cpu_cores_;
+  // Shared by the decode queues of all video receive streams when enabled by
+  // field trial.
+  const std::unique_ptr<DecodeThreadPool> decode_thread_pool_;
+  // Decoders released by the video receive streams, for reuse by the others.
+  const std::unique_ptr<VideoDecoderPool> decoder_pool_;
   const std::unique_ptr<CallStats> call_stats_;
   const std::unique_ptr<BitrateAllocator> bitrate_allocator_;
   const CallConfig config_ RTC_GUARDED_BY(worker_thread_);
@@ -658,8 +666,14 @@ Call::Call(const CallConfig& config,
                                                      worker_thread_)
               : nullptr),
       num_cpu_cores_(CpuInfo::DetectNumberOfCores()),
+      decode_thread_pool_(
+          DecodeThreadPool::CreateFromFieldTrials(env_.field_trials(),
+                                                  env_.task_queue_factory(),
+                                                  num_cpu_cores_)),
+      decoder_pool_(VideoDecoderPool::CreateFromFieldTrials(env_.field_trials(),
+                                                            env_.clock())),
       call_stats_(new CallStats(&env_.clock(), worker_thread_)),
-      bitrate_allocator_(new BitrateAllocator(this)),
+      bitrate_allocator_(new BitrateAllocator(this, env_.field_trials())),
       config_(config),
       audio_network_state_(kNetworkDown),
       video_network_state_(kNetworkDown),
@@ -816,7 +830,7 @@ webrtc::AudioReceiveStreamInterface* Call::CreateAudioReceiveStream(
 
   AudioReceiveStreamImpl* receive_stream = new AudioReceiveStreamImpl(
       &env_.clock(), transport_send_->packet_router(), config_.neteq_factory,
-      config, config_.audio_state, &env_.event_log());
+      config, config_.audio_state, &env_.event_log(), env_.field_trials());
   audio_receive_streams_.insert(receive_stream);
 
   // TODO(bugs.webrtc.org/11993): Make the registration on the network thread
@@ -991,7 +1005,8 @@ webrtc::VideoReceiveStreamInterface* Call::CreateVideoReceiveStream(
       env_, this, num_cpu_cores_, transport_send_->packet_router(),
       std::move(configuration), call_stats_.get(),
       std::make_unique<VCMTiming>(&env_.clock(), trials()),
-      &nack_periodic_processor_, decode_sync_.get());
+      &nack_periodic_processor_, decode_sync_.get(),
+      decode_thread_pool_.get(), decoder_pool_.get());
   // TODO(bugs.webrtc.org/11993): Set this up asynchronously on the network
   // thread.
   receive_stream->RegisterWithTransport(&video_receiver_controller_);
@@ -1094,6 +1109,17 @@ Call::Stats Call::GetStats() const {
   stats.max_padding_bitrate_bps =
       configured_max_padding_bitrate_bps_.load(std::memory_order_relaxed);
 
+  rtc::MemoryUsageVisitor memory_usage;
+  for (const VideoSendStreamImpl* stream : video_send_streams_)
+    stream->VisitMemoryUsage(memory_usage);
+  for (const VideoReceiveStream2* stream : video_receive_streams_)
+    stream->VisitMemoryUsage(memory_usage);
+  for (const AudioReceiveStreamImpl* stream : audio_receive_streams_)
+    stream->VisitMemoryUsage(memory_usage);
+  stats.memory_usage_bytes_by_component.insert(
+      memory_usage.bytes_by_component().begin(),
+      memory_usage.bytes_by_component().end());
+
   return stats;
 }
 
@@ -1346,7 +1372,8 @@ void Call::DeliverRtcpPacket(rtc::CopyOnWriteBuffer packet) {
   }
 
   if (rtcp_delivered) {
-    env_.event_log().Log(std::make_unique<RtcEventRtcpPacketIncoming>(packet));
+    env_.event_log().Log(
+        std::make_unique<RtcEventRtcpPacketIncoming>(std::move(packet)));
   }
 }
 
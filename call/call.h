@@ -11,6 +11,7 @@
 #define CALL_CALL_H_
 
 #include <algorithm>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -53,6 +54,9 @@ class Call {
     int recv_bandwidth_bps = 0;       // Estimated available receive bandwidth.
     int64_t pacer_delay_ms = 0;
     int64_t rtt_ms = -1;
+    // Bytes held by the packet histories and receive buffers of the streams,
+    // keyed by component name.
+    std::map<std::string, int64_t> memory_usage_bytes_by_component;
   };
 
   static std::unique_ptr<Call> Create(const CallConfig& config);
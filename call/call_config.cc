@@ -29,6 +29,8 @@ RtpTransportConfig CallConfig::ExtractTransportConfig() const {
   transport_config.network_state_predictor_factory =
       network_state_predictor_factory;
   transport_config.pacer_burst_interval = pacer_burst_interval;
+  transport_config.pacer_metronome = pacer_metronome;
+  transport_config.route_estimate_cache = route_estimate_cache;
 
   return transport_config;
 }
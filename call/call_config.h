@@ -18,6 +18,7 @@
 #include "api/transport/bitrate_settings.h"
 #include "api/transport/network_control.h"
 #include "call/audio_state.h"
+#include "call/network_route_estimate_cache.h"
 #include "call/rtp_transport_config.h"
 #include "call/rtp_transport_controller_send_factory_interface.h"
 
@@ -70,6 +71,12 @@ struct CallConfig {
 
   Metronome* decode_metronome = nullptr;
   Metronome* encode_metronome = nullptr;
+  // If set, the pacer aligns its wakeups to this metronome, see
+  // TaskQueuePacedSender constructor.
+  Metronome* pacer_metronome = nullptr;
+  // If set, shared between calls to seed the start rate on known network
+  // routes, see RtpTransportConfig.
+  NetworkRouteEstimateCache* route_estimate_cache = nullptr;
 
   // The burst interval of the pacer, see TaskQueuePacedSender constructor.
   absl::optional<TimeDelta> pacer_burst_interval;
@@ -0,0 +1,91 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "call/network_route_estimate_cache.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+constexpr char NetworkRouteEstimateCache::Config::kKey[];
+
+std::unique_ptr<StructParametersParser>
+NetworkRouteEstimateCache::Config::Parser() {
+  return StructParametersParser::Create(
+      "enabled", &enabled,                        //
+      "half_life", &half_life,                    //
+      "max_age", &max_age,                        //
+      "min_route_duration", &min_route_duration,  //
+      "backoff_factor", &backoff_factor,          //
+      "max_entries", &max_entries);
+}
+
+std::unique_ptr<NetworkRouteEstimateCache>
+NetworkRouteEstimateCache::CreateFromFieldTrials(
+    const FieldTrialsView& field_trials) {
+  Config config;
+  config.Parser()->Parse(field_trials.Lookup(Config::kKey));
+  if (!config.enabled)
+    return nullptr;
+  return std::make_unique<NetworkRouteEstimateCache>(config);
+}
+
+NetworkRouteEstimateCache::RouteKey::RouteKey(const rtc::NetworkRoute& route)
+    : local_network_id(route.local.network_id()),
+      local_adapter_type(route.local.adapter_type()),
+      local_uses_turn(route.local.uses_turn()),
+      remote_adapter_type(route.remote.adapter_type()),
+      remote_uses_turn(route.remote.uses_turn()) {}
+
+NetworkRouteEstimateCache::NetworkRouteEstimateCache(const Config& config)
+    : config_(config) {
+  RTC_DCHECK_GT(config_.half_life, TimeDelta::Zero());
+  RTC_DCHECK_GT(config_.max_entries, 0);
+}
+
+NetworkRouteEstimateCache::~NetworkRouteEstimateCache() = default;
+
+void NetworkRouteEstimateCache::Store(const rtc::NetworkRoute& route,
+                                      DataRate estimate,
+                                      Timestamp now) {
+  if (!estimate.IsFinite() || estimate <= DataRate::Zero())
+    return;
+  MutexLock lock(&mutex_);
+  entries_.insert_or_assign(RouteKey(route), Entry{estimate, now});
+  if (entries_.size() > static_cast<size_t>(config_.max_entries)) {
+    auto oldest = entries_.begin();
+    for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+      if (it->second.update_time < oldest->second.update_time)
+        oldest = it;
+    }
+    entries_.erase(oldest);
+  }
+}
+
+absl::optional<DataRate> NetworkRouteEstimateCache::Lookup(
+    const rtc::NetworkRoute& route,
+    Timestamp now) {
+  MutexLock lock(&mutex_);
+  auto it = entries_.find(RouteKey(route));
+  if (it == entries_.end())
+    return absl::nullopt;
+  TimeDelta age = std::max(now - it->second.update_time, TimeDelta::Zero());
+  if (age > config_.max_age) {
+    entries_.erase(it);
+    return absl::nullopt;
+  }
+  double decay = std::exp2(-(age / config_.half_life));
+  return it->second.estimate * (config_.backoff_factor * decay);
+}
+
+}  // namespace webrtc
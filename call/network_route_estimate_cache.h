@@ -0,0 +1,107 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef CALL_NETWORK_ROUTE_ESTIMATE_CACHE_H_
+#define CALL_NETWORK_ROUTE_ESTIMATE_CACHE_H_
+
+#include <map>
+#include <memory>
+#include <tuple>
+
+#include "absl/types/optional.h"
+#include "api/field_trials_view.h"
+#include "api/units/data_rate.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "rtc_base/experiments/struct_parameters_parser.h"
+#include "rtc_base/network_constants.h"
+#include "rtc_base/network_route.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Remembers the bandwidth estimate last reached on a network route, so that a
+// later call on the same route, or a call moving back to it, can start from
+// that estimate rather than from the configured start bitrate. The cache is
+// shared between calls and is therefore thread safe.
+class NetworkRouteEstimateCache {
+ public:
+  struct Config {
+    static constexpr char kKey[] = "WebRTC-Bwe-NetworkRouteEstimateCache";
+    std::unique_ptr<StructParametersParser> Parser();
+
+    bool enabled = false;
+    // Cached estimates are halved every `half_life`...
+    TimeDelta half_life = TimeDelta::Minutes(10);
+    // ...and forgotten completely after `max_age`.
+    TimeDelta max_age = TimeDelta::Minutes(60);
+    // Estimates are not stored until a route has been in use for this long,
+    // so that a route still in its initial ramp-up does not overwrite a
+    // better estimate.
+    TimeDelta min_route_duration = TimeDelta::Seconds(5);
+    // Fraction of the decayed estimate returned by Lookup.
+    double backoff_factor = 0.85;
+    int max_entries = 32;
+  };
+
+  // Returns a cache configured from `field_trials`, or nullptr if the cache is
+  // not enabled.
+  static std::unique_ptr<NetworkRouteEstimateCache> CreateFromFieldTrials(
+      const FieldTrialsView& field_trials);
+
+  explicit NetworkRouteEstimateCache(const Config& config);
+  ~NetworkRouteEstimateCache();
+
+  NetworkRouteEstimateCache(const NetworkRouteEstimateCache&) = delete;
+  NetworkRouteEstimateCache& operator=(const NetworkRouteEstimateCache&) =
+      delete;
+
+  const Config& config() const { return config_; }
+
+  void Store(const rtc::NetworkRoute& route, DataRate estimate, Timestamp now);
+  // Returns the estimate stored for `route`, decayed according to its age, or
+  // nullopt if there is none.
+  absl::optional<DataRate> Lookup(const rtc::NetworkRoute& route,
+                                  Timestamp now);
+
+ private:
+  // Routes are identified by the local network and the kind of the remote
+  // endpoint. Adapter ids are left out since they are not stable across ICE
+  // restarts.
+  struct RouteKey {
+    explicit RouteKey(const rtc::NetworkRoute& route);
+    bool operator<(const RouteKey& other) const {
+      return std::tie(local_network_id, local_adapter_type, local_uses_turn,
+                      remote_adapter_type, remote_uses_turn) <
+             std::tie(other.local_network_id, other.local_adapter_type,
+                      other.local_uses_turn, other.remote_adapter_type,
+                      other.remote_uses_turn);
+    }
+
+    uint16_t local_network_id;
+    rtc::AdapterType local_adapter_type;
+    bool local_uses_turn;
+    rtc::AdapterType remote_adapter_type;
+    bool remote_uses_turn;
+  };
+  struct Entry {
+    DataRate estimate;
+    Timestamp update_time;
+  };
+
+  const Config config_;
+  Mutex mutex_;
+  std::map<RouteKey, Entry> entries_ RTC_GUARDED_BY(mutex_);
+};
+
+}  // namespace webrtc
+
+#endif  // CALL_NETWORK_ROUTE_ESTIMATE_CACHE_H_
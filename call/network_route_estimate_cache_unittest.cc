@@ -0,0 +1,122 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "call/network_route_estimate_cache.h"
+
+#include "test/explicit_key_value_config.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using test::ExplicitKeyValueConfig;
+
+rtc::NetworkRoute CreateRoute(uint16_t local_network_id,
+                              rtc::AdapterType local_adapter_type) {
+  rtc::NetworkRoute route;
+  route.connected = true;
+  route.local = rtc::RouteEndpoint(local_adapter_type, /*adapter_id=*/0,
+                                   local_network_id, /*uses_turn=*/false);
+  route.remote = rtc::RouteEndpoint::CreateWithNetworkId(7);
+  return route;
+}
+
+NetworkRouteEstimateCache::Config CreateConfig() {
+  NetworkRouteEstimateCache::Config config;
+  config.enabled = true;
+  config.half_life = TimeDelta::Minutes(10);
+  config.max_age = TimeDelta::Minutes(60);
+  config.backoff_factor = 1.0;
+  config.max_entries = 2;
+  return config;
+}
+
+TEST(NetworkRouteEstimateCacheTest, DisabledByDefault) {
+  ExplicitKeyValueConfig field_trials("");
+  EXPECT_EQ(NetworkRouteEstimateCache::CreateFromFieldTrials(field_trials),
+            nullptr);
+}
+
+TEST(NetworkRouteEstimateCacheTest, CreatedFromFieldTrial) {
+  ExplicitKeyValueConfig field_trials(
+      "WebRTC-Bwe-NetworkRouteEstimateCache/enabled:true,half_life:5s/");
+  auto cache = NetworkRouteEstimateCache::CreateFromFieldTrials(field_trials);
+  ASSERT_NE(cache, nullptr);
+  EXPECT_EQ(cache->config().half_life, TimeDelta::Seconds(5));
+}
+
+TEST(NetworkRouteEstimateCacheTest, ReturnsStoredEstimateForSameRoute) {
+  NetworkRouteEstimateCache cache(CreateConfig());
+  Timestamp now = Timestamp::Seconds(1000);
+  rtc::NetworkRoute wifi = CreateRoute(1, rtc::ADAPTER_TYPE_WIFI);
+  rtc::NetworkRoute cellular = CreateRoute(2, rtc::ADAPTER_TYPE_CELLULAR);
+
+  cache.Store(wifi, DataRate::KilobitsPerSec(2500), now);
+  EXPECT_EQ(cache.Lookup(wifi, now), DataRate::KilobitsPerSec(2500));
+  EXPECT_EQ(cache.Lookup(cellular, now), absl::nullopt);
+
+  // Routes differing only in adapter id are considered the same.
+  rtc::NetworkRoute wifi_other_adapter = wifi;
+  wifi_other_adapter.local =
+      rtc::RouteEndpoint(rtc::ADAPTER_TYPE_WIFI, /*adapter_id=*/3,
+                         /*network_id=*/1, /*uses_turn=*/false);
+  EXPECT_EQ(cache.Lookup(wifi_other_adapter, now),
+            DataRate::KilobitsPerSec(2500));
+}
+
+TEST(NetworkRouteEstimateCacheTest, TurnRouteIsSeparateEntry) {
+  NetworkRouteEstimateCache cache(CreateConfig());
+  Timestamp now = Timestamp::Seconds(1000);
+  rtc::NetworkRoute direct = CreateRoute(1, rtc::ADAPTER_TYPE_WIFI);
+  rtc::NetworkRoute relayed = direct;
+  relayed.local = direct.local.CreateWithTurn(true);
+
+  cache.Store(direct, DataRate::KilobitsPerSec(2500), now);
+  EXPECT_EQ(cache.Lookup(relayed, now), absl::nullopt);
+}
+
+TEST(NetworkRouteEstimateCacheTest, DecaysWithAgeAndExpires) {
+  NetworkRouteEstimateCache::Config config = CreateConfig();
+  config.backoff_factor = 0.8;
+  NetworkRouteEstimateCache cache(config);
+  Timestamp now = Timestamp::Seconds(1000);
+  rtc::NetworkRoute wifi = CreateRoute(1, rtc::ADAPTER_TYPE_WIFI);
+
+  cache.Store(wifi, DataRate::KilobitsPerSec(2000), now);
+  EXPECT_EQ(cache.Lookup(wifi, now), DataRate::KilobitsPerSec(1600));
+  EXPECT_EQ(cache.Lookup(wifi, now + TimeDelta::Minutes(10)),
+            DataRate::KilobitsPerSec(800));
+  EXPECT_EQ(cache.Lookup(wifi, now + TimeDelta::Minutes(20)),
+            DataRate::KilobitsPerSec(400));
+  EXPECT_EQ(cache.Lookup(wifi, now + TimeDelta::Minutes(61)), absl::nullopt);
+  // Expired entries are removed.
+  EXPECT_EQ(cache.Lookup(wifi, now), absl::nullopt);
+}
+
+TEST(NetworkRouteEstimateCacheTest, EvictsOldestEntry) {
+  NetworkRouteEstimateCache cache(CreateConfig());
+  Timestamp now = Timestamp::Seconds(1000);
+  rtc::NetworkRoute first = CreateRoute(1, rtc::ADAPTER_TYPE_WIFI);
+  rtc::NetworkRoute second = CreateRoute(2, rtc::ADAPTER_TYPE_WIFI);
+  rtc::NetworkRoute third = CreateRoute(3, rtc::ADAPTER_TYPE_WIFI);
+
+  cache.Store(second, DataRate::KilobitsPerSec(1000), now);
+  cache.Store(first, DataRate::KilobitsPerSec(1000),
+              now + TimeDelta::Seconds(1));
+  cache.Store(third, DataRate::KilobitsPerSec(1000),
+              now + TimeDelta::Seconds(2));
+
+  now += TimeDelta::Seconds(2);
+  EXPECT_TRUE(cache.Lookup(first, now));
+  EXPECT_FALSE(cache.Lookup(second, now));
+  EXPECT_TRUE(cache.Lookup(third, now));
+}
+
+}  // namespace
+}  // namespace webrtc
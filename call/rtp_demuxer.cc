@@ -10,6 +10,9 @@
 
 #include "call/rtp_demuxer.h"
 
+#include <algorithm>
+#include <utility>
+
 #include "absl/strings/string_view.h"
 #include "call/rtp_packet_sink_interface.h"
 #include "modules/rtp_rtcp/source/rtp_header_extensions.h"
@@ -110,6 +113,74 @@ std::string RtpDemuxer::DescribePacket(const RtpPacketReceived& packet) {
   return sb.Release();
 }
 
+RtpDemuxer::SsrcSinkCache::SsrcSinkCache() = default;
+RtpDemuxer::SsrcSinkCache::~SsrcSinkCache() = default;
+
+RtpPacketSinkInterface* RtpDemuxer::SsrcSinkCache::Find(uint32_t ssrc) const {
+  if (size_ == 0) {
+    return nullptr;
+  }
+  const size_t mask = slots_.size() - 1;
+  for (size_t i = SlotIndex(ssrc);; i = (i + 1) & mask) {
+    const Entry& entry = slots_[i];
+    if (entry.sink == nullptr || entry.ssrc == ssrc) {
+      return entry.sink;
+    }
+  }
+}
+
+void RtpDemuxer::SsrcSinkCache::Insert(uint32_t ssrc,
+                                       RtpPacketSinkInterface* sink) {
+  RTC_DCHECK(sink);
+  if (2 * (size_ + 1) > slots_.size()) {
+    if (size_ >= kMaxSsrcBindings) {
+      return;
+    }
+    Grow();
+  }
+  const size_t mask = slots_.size() - 1;
+  for (size_t i = SlotIndex(ssrc);; i = (i + 1) & mask) {
+    Entry& entry = slots_[i];
+    if (entry.sink == nullptr) {
+      entry = {.ssrc = ssrc, .sink = sink};
+      ++size_;
+      return;
+    }
+    if (entry.ssrc == ssrc) {
+      entry.sink = sink;
+      return;
+    }
+  }
+}
+
+void RtpDemuxer::SsrcSinkCache::Clear() {
+  if (size_ > 0) {
+    std::fill(slots_.begin(), slots_.end(), Entry());
+    size_ = 0;
+  }
+}
+
+size_t RtpDemuxer::SsrcSinkCache::SlotIndex(uint32_t ssrc) const {
+  // Fibonacci hashing, SSRCs are random but may be chosen by the remote.
+  return (ssrc * uint32_t{0x9E3779B1}) >> hash_shift_;
+}
+
+void RtpDemuxer::SsrcSinkCache::Grow() {
+  std::vector<Entry> old_slots =
+      std::exchange(slots_, std::vector<Entry>(std::max<size_t>(
+                                16, 2 * slots_.size())));
+  hash_shift_ = 32;
+  for (size_t num_slots = slots_.size(); num_slots > 1; num_slots /= 2) {
+    --hash_shift_;
+  }
+  size_ = 0;
+  for (const Entry& entry : old_slots) {
+    if (entry.sink != nullptr) {
+      Insert(entry.ssrc, entry.sink);
+    }
+  }
+}
+
 RtpDemuxer::RtpDemuxer(bool use_mid /* = true*/) : use_mid_(use_mid) {}
 
 RtpDemuxer::~RtpDemuxer() {
@@ -159,6 +230,8 @@ bool RtpDemuxer::AddSink(const RtpDemuxerCriteria& criteria,
   }
 
   RefreshKnownMids();
+  // The new criteria may take over SSRCs resolved to other sinks so far.
+  sink_cache_.Clear();
 
   RTC_DLOG(LS_INFO) << "Added sink = " << sink << " for criteria "
                     << criteria.ToString();
@@ -252,6 +325,7 @@ bool RtpDemuxer::RemoveSink(const RtpPacketSinkInterface* sink) {
                        RemoveFromMapByValue(&sink_by_mid_and_rsid_, sink) +
                        RemoveFromMapByValue(&sink_by_rsid_, sink);
   RefreshKnownMids();
+  sink_cache_.Clear();
   return num_removed > 0;
 }
 
@@ -279,6 +353,36 @@ bool RtpDemuxer::OnRtpPacket(const RtpPacketReceived& packet) {
 
 RtpPacketSinkInterface* RtpDemuxer::ResolveSink(
     const RtpPacketReceived& packet) {
+  const uint32_t ssrc = packet.Ssrc();
+  // Without MID or RSID to learn from, the demux algorithm only depends on the
+  // SSRC, and on the payload type for SSRCs that failed to bind.
+  const bool has_ids = (use_mid_ && packet.HasExtension<RtpMid>()) ||
+                       packet.HasExtension<RtpStreamId>() ||
+                       packet.HasExtension<RepairedRtpStreamId>();
+  if (!has_ids) {
+    RtpPacketSinkInterface* sink = sink_cache_.Find(ssrc);
+    if (sink != nullptr) {
+      return sink;
+    }
+  }
+
+  bool by_payload_type = false;
+  RtpPacketSinkInterface* sink = ResolveSinkUncached(packet, by_payload_type);
+  if (sink != nullptr && !by_payload_type) {
+    // Packets with IDs update the learned IDs for the SSRC, which later packets
+    // without IDs resolve the same way.
+    sink_cache_.Insert(ssrc, sink);
+  } else if (sink_cache_.Find(ssrc) != nullptr) {
+    // The packet's IDs changed how the SSRC is demuxed. Rare enough to not
+    // bother with removing a single entry.
+    sink_cache_.Clear();
+  }
+  return sink;
+}
+
+RtpPacketSinkInterface* RtpDemuxer::ResolveSinkUncached(
+    const RtpPacketReceived& packet,
+    bool& by_payload_type) {
   // See the BUNDLE spec for high level reference to this algorithm:
   // https://tools.ietf.org/html/draft-ietf-mmusic-sdp-bundle-negotiation-38#section-10.2
 
@@ -373,7 +477,11 @@ RtpPacketSinkInterface* RtpDemuxer::ResolveSink(
   }
 
   // Legacy senders will only signal payload type, support that as last resort.
-  return ResolveSinkByPayloadType(packet.PayloadType(), ssrc);
+  bool bound = false;
+  RtpPacketSinkInterface* sink =
+      ResolveSinkByPayloadType(packet.PayloadType(), ssrc, bound);
+  by_payload_type = !bound;
+  return sink;
 }
 
 RtpPacketSinkInterface* RtpDemuxer::ResolveSinkByMid(absl::string_view mid,
@@ -413,27 +521,28 @@ RtpPacketSinkInterface* RtpDemuxer::ResolveSinkByRsid(absl::string_view rsid,
 
 RtpPacketSinkInterface* RtpDemuxer::ResolveSinkByPayloadType(
     uint8_t payload_type,
-    uint32_t ssrc) {
+    uint32_t ssrc,
+    bool& bound) {
   const auto range = sinks_by_pt_.equal_range(payload_type);
   if (range.first != range.second) {
     auto it = range.first;
     const auto end = range.second;
     if (std::next(it) == end) {
       RtpPacketSinkInterface* sink = it->second;
-      AddSsrcSinkBinding(ssrc, sink);
+      bound = AddSsrcSinkBinding(ssrc, sink);
       return sink;
     }
   }
   return nullptr;
 }
 
-void RtpDemuxer::AddSsrcSinkBinding(uint32_t ssrc,
+bool RtpDemuxer::AddSsrcSinkBinding(uint32_t ssrc,
                                     RtpPacketSinkInterface* sink) {
   if (sink_by_ssrc_.size() >= kMaxSsrcBindings) {
     RTC_LOG(LS_WARNING) << "New SSRC=" << ssrc
                         << " sink binding ignored; limit of" << kMaxSsrcBindings
                         << " bindings has been reached.";
-    return;
+    return false;
   }
 
   auto result = sink_by_ssrc_.emplace(ssrc, sink);
@@ -447,6 +556,7 @@ void RtpDemuxer::AddSsrcSinkBinding(uint32_t ssrc,
                       << " binding with SSRC=" << ssrc;
     it->second = sink;
   }
+  return true;
 }
 
 }  // namespace webrtc
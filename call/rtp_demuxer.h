@@ -163,11 +163,51 @@ class RtpDemuxer {
   // with the existing criteria and should be rejected.
   bool CriteriaWouldConflict(const RtpDemuxerCriteria& criteria) const;
 
+  // Caches the sink resolved for SSRCs in an open addressing hash table, so
+  // that packets of known streams cost a single probe. Only valid as long as
+  // the sinks and SSRC bindings the cached sinks were resolved from don't
+  // change.
+  class SsrcSinkCache {
+   public:
+    SsrcSinkCache();
+    ~SsrcSinkCache();
+
+    // Returns null if `ssrc` isn't cached.
+    RtpPacketSinkInterface* Find(uint32_t ssrc) const;
+    // Adds or updates the sink for `ssrc`. Ignored when the cache holds
+    // `kMaxSsrcBindings` SSRCs already.
+    void Insert(uint32_t ssrc, RtpPacketSinkInterface* sink);
+    void Clear();
+
+   private:
+    struct Entry {
+      uint32_t ssrc = 0;
+      // Null for empty slots.
+      RtpPacketSinkInterface* sink = nullptr;
+    };
+
+    size_t SlotIndex(uint32_t ssrc) const;
+    void Grow();
+
+    // Size is a power of two, kept at least twice the number of entries.
+    std::vector<Entry> slots_;
+    int hash_shift_ = 32;
+    size_t size_ = 0;
+  };
+
+  // Returns the sink that should receive the packet, from the cache when the
+  // packet has no MID or RSID to learn from, otherwise by running the demux
+  // algorithm. If the packet should be dropped, this method returns null.
+  RtpPacketSinkInterface* ResolveSink(const RtpPacketReceived& packet);
+
   // Runs the demux algorithm on the given packet and returns the sink that
   // should receive the packet.
   // Will record any SSRC<->ID associations along the way.
+  // Sets `by_payload_type` if the sink may depend on the packet's payload type
+  // and not just its SSRC and header extensions.
   // If the packet should be dropped, this method returns null.
-  RtpPacketSinkInterface* ResolveSink(const RtpPacketReceived& packet);
+  RtpPacketSinkInterface* ResolveSinkUncached(const RtpPacketReceived& packet,
+                                              bool& by_payload_type);
 
   // Used by the ResolveSink algorithm.
   RtpPacketSinkInterface* ResolveSinkByMid(absl::string_view mid,
@@ -177,8 +217,10 @@ class RtpDemuxer {
                                                uint32_t ssrc);
   RtpPacketSinkInterface* ResolveSinkByRsid(absl::string_view rsid,
                                             uint32_t ssrc);
+  // Sets `bound` if the SSRC is bound to the returned sink.
   RtpPacketSinkInterface* ResolveSinkByPayloadType(uint8_t payload_type,
-                                                   uint32_t ssrc);
+                                                   uint32_t ssrc,
+                                                   bool& bound);
 
   // Regenerate the known_mids_ set from information in the sink_by_mid_ and
   // sink_by_mid_and_rsid_ maps.
@@ -210,8 +252,13 @@ class RtpDemuxer {
   flat_map<uint32_t, std::string> mid_by_ssrc_;
   flat_map<uint32_t, std::string> rsid_by_ssrc_;
 
-  // Adds a binding from the SSRC to the given sink.
-  void AddSsrcSinkBinding(uint32_t ssrc, RtpPacketSinkInterface* sink);
+  // Sinks resolved for packets without MID and RSID, cleared whenever sinks
+  // are added or removed.
+  SsrcSinkCache sink_cache_;
+
+  // Adds a binding from the SSRC to the given sink. Returns false if the
+  // binding was ignored because of `kMaxSsrcBindings`.
+  bool AddSsrcSinkBinding(uint32_t ssrc, RtpPacketSinkInterface* sink);
 
   const bool use_mid_;
 };
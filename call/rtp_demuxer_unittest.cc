@@ -1023,6 +1023,29 @@ TEST_F(RtpDemuxerTest, RoutedByPayloadTypeLatchesSsrc) {
   EXPECT_TRUE(demuxer_.OnRtpPacket(*packet_with_ssrc));
 }
 
+TEST_F(RtpDemuxerTest, SsrcRoutedToNewSinkAfterLearnedSinkRemoved) {
+  constexpr uint32_t ssrc = 10;
+  const std::string rsid = "a";
+
+  NiceMock<MockRtpPacketSink> rsid_sink;
+  AddSinkOnlyRsid(rsid, &rsid_sink);
+
+  auto packet_with_rsid = CreatePacketWithSsrcRsid(ssrc, rsid);
+  ASSERT_TRUE(demuxer_.OnRtpPacket(*packet_with_rsid));
+  auto packet_with_ssrc = CreatePacketWithSsrc(ssrc);
+  ASSERT_TRUE(demuxer_.OnRtpPacket(*packet_with_ssrc));
+
+  RemoveSink(&rsid_sink);
+  MockRtpPacketSink ssrc_sink;
+  AddSinkOnlySsrc(ssrc, &ssrc_sink);
+
+  packet_with_ssrc = CreatePacketWithSsrc(ssrc);
+  EXPECT_CALL(rsid_sink, OnRtpPacket(_)).Times(0);
+  EXPECT_CALL(ssrc_sink, OnRtpPacket(SamePacketAs(*packet_with_ssrc)))
+      .Times(1);
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*packet_with_ssrc));
+}
+
 // RSIDs are scoped within MID, so if two sinks are registered with the same
 // RSIDs but different MIDs, then packets containing both extensions should be
 // routed to the correct one.
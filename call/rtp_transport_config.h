@@ -15,10 +15,12 @@
 
 #include "absl/types/optional.h"
 #include "api/environment/environment.h"
+#include "api/metronome/metronome.h"
 #include "api/network_state_predictor.h"
 #include "api/transport/bitrate_settings.h"
 #include "api/transport/network_control.h"
 #include "api/units/time_delta.h"
+#include "call/network_route_estimate_cache.h"
 
 namespace webrtc {
 
@@ -38,6 +40,14 @@ struct RtpTransportConfig {
 
   // The burst interval of the pacer, see TaskQueuePacedSender constructor.
   absl::optional<TimeDelta> pacer_burst_interval;
+
+  // Metronome the pacer aligns its wakeups to, see TaskQueuePacedSender
+  // constructor. Must outlive the transport.
+  Metronome* pacer_metronome = nullptr;
+
+  // If set, the start rate on a network route is seeded from the estimate
+  // previously reached on it. Must outlive the transport.
+  NetworkRouteEstimateCache* route_estimate_cache = nullptr;
 };
 }  // namespace webrtc
 
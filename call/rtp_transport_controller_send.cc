@@ -9,6 +9,7 @@
  */
 #include "call/rtp_transport_controller_send.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -77,7 +78,8 @@ RtpTransportControllerSend::RtpTransportControllerSend(
              &packet_router_,
              env_.field_trials(),
              TimeDelta::Millis(5),
-             3),
+             3,
+             config.pacer_metronome),
       observer_(nullptr),
       controller_factory_override_(config.network_controller_factory),
       controller_factory_fallback_(
@@ -95,7 +97,8 @@ RtpTransportControllerSend::RtpTransportControllerSend(
       network_available_(false),
       congestion_window_size_(DataSize::PlusInfinity()),
       is_congested_(false),
-      retransmission_rate_limiter_(&env_.clock(), kRetransmitWindowSizeMs) {
+      retransmission_rate_limiter_(&env_.clock(), kRetransmitWindowSizeMs),
+      route_estimate_cache_(config.route_estimate_cache) {
   ParseFieldTrial(
       {&relay_bandwidth_cap_},
       env_.field_trials().Lookup("WebRTC-Bwe-NetworkRouteConstraints"));
@@ -335,7 +338,22 @@ void RtpTransportControllerSend::OnNetworkRouteChanged(
   }
 
   if (inserted) {
-    if (relay_constraint_update.has_value()) {
+    OnEstimateCacheRouteChanged(network_route);
+    absl::optional<DataRate> cached_start_rate =
+        GetCachedStartRate(network_route);
+    if (cached_start_rate) {
+      TargetRateConstraints msg = ConvertConstraints(
+          relay_constraint_update.value_or(bitrate_configurator_.GetConfig()),
+          &env_.clock());
+      msg.starting_rate = cached_start_rate;
+      if (controller_) {
+        PostUpdates(controller_->OnTargetRateConstraints(msg));
+      } else {
+        UpdateInitialConstraints(msg);
+        if (observer_)
+          observer_->OnStartRateUpdate(*cached_start_rate);
+      }
+    } else if (relay_constraint_update.has_value()) {
       UpdateBitrateConstraints(*relay_constraint_update);
     }
     transport_overhead_bytes_per_packet_ = network_route.packet_overhead;
@@ -362,6 +380,13 @@ void RtpTransportControllerSend::OnNetworkRouteChanged(
     NetworkRouteChange msg;
     msg.at_time = Timestamp::Millis(env_.clock().TimeInMilliseconds());
     msg.constraints = ConvertConstraints(bitrate_config, &env_.clock());
+    OnEstimateCacheRouteChanged(network_route);
+    if (absl::optional<DataRate> cached_start_rate =
+            GetCachedStartRate(network_route)) {
+      RTC_LOG(LS_INFO) << "Starting from cached estimate "
+                       << ToString(*cached_start_rate) << " on new route.";
+      msg.constraints.starting_rate = cached_start_rate;
+    }
     transport_overhead_bytes_per_packet_ = network_route.packet_overhead;
     if (reset_feedback_on_route_change_) {
       transport_feedback_adapter_.SetNetworkRoute(network_route);
@@ -498,7 +523,12 @@ void RtpTransportControllerSend::SetClientBitratePreferences(
   RTC_DCHECK_RUN_ON(&sequence_checker_);
   absl::optional<BitrateConstraints> updated =
       bitrate_configurator_.UpdateWithClientPreferences(preferences);
-  if (updated.has_value()) {
+  if (preferences.capacity_hint_bps.has_value()) {
+    // A capacity hint is forwarded even if the constraints are unchanged.
+    ApplyCapacityHint(updated.value_or(bitrate_configurator_.GetConfig()),
+                      DataRate::BitsPerSec(*preferences.capacity_hint_bps),
+                      preferences.capacity_hint_confidence);
+  } else if (updated.has_value()) {
     UpdateBitrateConstraints(*updated);
   } else {
     RTC_LOG(LS_VERBOSE)
@@ -507,6 +537,34 @@ void RtpTransportControllerSend::SetClientBitratePreferences(
   }
 }
 
+void RtpTransportControllerSend::ApplyCapacityHint(
+    const BitrateConstraints& constraints,
+    DataRate capacity_hint,
+    double confidence) {
+  if (capacity_hint <= DataRate::Zero() || confidence <= 0) {
+    UpdateBitrateConstraints(constraints);
+    return;
+  }
+  TargetRateConstraints msg = ConvertConstraints(constraints, &env_.clock());
+  capacity_hint = std::min(capacity_hint, *msg.max_data_rate);
+  // Start at the part of the hint that is trusted, but never below the
+  // configured start rate.
+  DataRate start_rate = std::max(capacity_hint * std::min(confidence, 1.0),
+                                 msg.starting_rate.value_or(DataRate::Zero()));
+  msg.starting_rate =
+      std::min(std::max(start_rate, *msg.min_data_rate), capacity_hint);
+  msg.capacity_hint = capacity_hint;
+  RTC_LOG(LS_INFO) << "Capacity hint " << ToString(capacity_hint)
+                   << ", starting at " << ToString(*msg.starting_rate);
+  if (controller_) {
+    PostUpdates(controller_->OnTargetRateConstraints(msg));
+  } else {
+    UpdateInitialConstraints(msg);
+    if (observer_)
+      observer_->OnStartRateUpdate(*msg.starting_rate);
+  }
+}
+
 absl::optional<BitrateConstraints>
 RtpTransportControllerSend::ApplyOrLiftRelayCap(bool is_relayed) {
   DataRate cap = is_relayed ? relay_bandwidth_cap_ : DataRate::PlusInfinity();
@@ -650,6 +708,8 @@ void RtpTransportControllerSend::UpdateInitialConstraints(
     TargetRateConstraints new_contraints) {
   if (!new_contraints.starting_rate)
     new_contraints.starting_rate = initial_config_.constraints.starting_rate;
+  if (!new_contraints.capacity_hint)
+    new_contraints.capacity_hint = initial_config_.constraints.capacity_hint;
   RTC_DCHECK(new_contraints.starting_rate);
   initial_config_.constraints = new_contraints;
 }
@@ -708,7 +768,50 @@ void RtpTransportControllerSend::PostUpdates(NetworkControlUpdate update) {
   if (update.target_rate) {
     control_handler_->SetTargetRate(*update.target_rate);
     UpdateControlState();
+    MaybeStoreEstimateInCache(*update.target_rate);
+  }
+}
+
+void RtpTransportControllerSend::OnEstimateCacheRouteChanged(
+    const rtc::NetworkRoute& route) {
+  if (!route_estimate_cache_)
+    return;
+  estimate_cache_route_ = route;
+  estimate_cache_route_start_ =
+      Timestamp::Millis(env_.clock().TimeInMilliseconds());
+}
+
+absl::optional<DataRate> RtpTransportControllerSend::GetCachedStartRate(
+    const rtc::NetworkRoute& route) {
+  if (!route_estimate_cache_)
+    return absl::nullopt;
+  absl::optional<DataRate> cached = route_estimate_cache_->Lookup(
+      route, Timestamp::Millis(env_.clock().TimeInMilliseconds()));
+  if (!cached)
+    return absl::nullopt;
+  // The cache is only used to start higher than configured, a low cached
+  // estimate is better rediscovered than trusted.
+  BitrateConstraints config = bitrate_configurator_.GetConfig();
+  if (cached->bps() <= config.start_bitrate_bps)
+    return absl::nullopt;
+  if (config.max_bitrate_bps > 0)
+    cached = std::min(*cached, DataRate::BitsPerSec(config.max_bitrate_bps));
+  return cached;
+}
+
+void RtpTransportControllerSend::MaybeStoreEstimateInCache(
+    const TargetTransferRate& target_rate) {
+  if (!route_estimate_cache_ || !estimate_cache_route_)
+    return;
+  if (target_rate.at_time - estimate_cache_route_start_ <
+      route_estimate_cache_->config().min_route_duration) {
+    return;
   }
+  // The stable target rate is used since the target rate itself may be
+  // inflated by an ongoing probe or overshoot.
+  route_estimate_cache_->Store(*estimate_cache_route_,
+                               target_rate.stable_target_rate,
+                               target_rate.at_time);
 }
 
 void RtpTransportControllerSend::OnReport(
@@ -18,6 +18,7 @@
 #include <vector>
 
 #include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
 #include "api/environment/environment.h"
 #include "api/network_state_predictor.h"
 #include "api/sequence_checker.h"
@@ -25,6 +26,8 @@
 #include "api/task_queue/task_queue_factory.h"
 #include "api/transport/network_control.h"
 #include "api/units/data_rate.h"
+#include "api/units/timestamp.h"
+#include "call/network_route_estimate_cache.h"
 #include "call/rtp_bitrate_configurator.h"
 #include "call/rtp_transport_config.h"
 #include "call/rtp_transport_controller_send_interface.h"
@@ -140,8 +143,21 @@ class RtpTransportControllerSend final
   bool IsRelevantRouteChange(const rtc::NetworkRoute& old_route,
                              const rtc::NetworkRoute& new_route) const;
   void UpdateBitrateConstraints(const BitrateConstraints& updated);
+  // Updates the constraints and lets the controller start at `confidence`
+  // times `capacity_hint`, verifying the hint with a probe.
+  void ApplyCapacityHint(const BitrateConstraints& constraints,
+                         DataRate capacity_hint,
+                         double confidence) RTC_RUN_ON(sequence_checker_);
   void UpdateStreamsConfig() RTC_RUN_ON(sequence_checker_);
   void PostUpdates(NetworkControlUpdate update) RTC_RUN_ON(sequence_checker_);
+  void OnEstimateCacheRouteChanged(const rtc::NetworkRoute& route)
+      RTC_RUN_ON(sequence_checker_);
+  // Returns the start rate to use on `route` if the route estimate cache holds
+  // an estimate above the configured start rate.
+  absl::optional<DataRate> GetCachedStartRate(const rtc::NetworkRoute& route)
+      RTC_RUN_ON(sequence_checker_);
+  void MaybeStoreEstimateInCache(const TargetTransferRate& target_rate)
+      RTC_RUN_ON(sequence_checker_);
   void UpdateControlState() RTC_RUN_ON(sequence_checker_);
   void UpdateCongestedState() RTC_RUN_ON(sequence_checker_);
   absl::optional<bool> GetCongestedStateUpdate() const
@@ -210,6 +226,14 @@ class RtpTransportControllerSend final
   // Protected by internal locks.
   RateLimiter retransmission_rate_limiter_;
 
+  NetworkRouteEstimateCache* const route_estimate_cache_;
+  // Route the current estimate is stored for in `route_estimate_cache_`, and
+  // when it was taken into use.
+  absl::optional<rtc::NetworkRoute> estimate_cache_route_
+      RTC_GUARDED_BY(sequence_checker_);
+  Timestamp estimate_cache_route_start_ RTC_GUARDED_BY(sequence_checker_) =
+      Timestamp::MinusInfinity();
+
   ScopedTaskSafety safety_;
 };
 
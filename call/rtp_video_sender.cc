@@ -860,6 +860,14 @@ uint32_t RtpVideoSender::GetProtectionBitrateBps() const {
   return protection_bitrate_bps_;
 }
 
+size_t RtpVideoSender::GetPacketHistoryMemoryUsageBytes() const {
+  size_t bytes = 0;
+  for (const auto& rtp_stream : rtp_streams_) {
+    bytes += rtp_stream.rtp_rtcp->GetPacketHistoryMemoryUsageBytes();
+  }
+  return bytes;
+}
+
 std::vector<RtpSequenceNumberMap::Info> RtpVideoSender::GetSentRtpPacketInfos(
     uint32_t ssrc,
     rtc::ArrayView<const uint16_t> sequence_numbers) const {
@@ -149,6 +149,8 @@ class RtpVideoSender : public RtpVideoSenderInterface,
       rtc::ArrayView<const uint16_t> sequence_numbers) const
       RTC_LOCKS_EXCLUDED(mutex_) override;
 
+  size_t GetPacketHistoryMemoryUsageBytes() const override;
+
   // From StreamFeedbackObserver.
   void OnPacketFeedbackVector(
       std::vector<StreamPacketInfo> packet_feedback_vector)
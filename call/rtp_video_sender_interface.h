@@ -57,6 +57,8 @@ class RtpVideoSenderInterface : public EncodedImageCallback,
   virtual std::vector<RtpSequenceNumberMap::Info> GetSentRtpPacketInfos(
       uint32_t ssrc,
       rtc::ArrayView<const uint16_t> sequence_numbers) const = 0;
+  // Returns the number of bytes held by the packet histories of all streams.
+  virtual size_t GetPacketHistoryMemoryUsageBytes() const = 0;
 
   // Implements FecControllerOverride.
   void SetFecAllowed(bool fec_allowed) override = 0;
@@ -10,8 +10,6 @@
 
 #include "call/rtx_receive_stream.h"
 
-#include <string.h>
-
 #include <utility>
 
 #include "api/array_view.h"
@@ -65,22 +63,15 @@ void RtxReceiveStream::OnRtpPacket(const RtpPacketReceived& rtx_packet) {
                          << " on rtx ssrc " << rtx_packet.Ssrc();
     return;
   }
-  RtpPacketReceived media_packet;
-  media_packet.CopyHeaderFrom(rtx_packet);
+  // Shares the buffer of `rtx_packet`, which is copied once, when the RTX
+  // header is removed.
+  RtpPacketReceived media_packet = rtx_packet;
+  media_packet.RemovePayloadPrefix(kRtxHeaderSize);
 
   media_packet.SetSsrc(media_ssrc_);
   media_packet.SetSequenceNumber((payload[0] << 8) + payload[1]);
   media_packet.SetPayloadType(it->second);
   media_packet.set_recovered(true);
-  media_packet.set_arrival_time(rtx_packet.arrival_time());
-
-  // Skip the RTX header.
-  rtc::ArrayView<const uint8_t> rtx_payload = payload.subview(kRtxHeaderSize);
-
-  uint8_t* media_payload = media_packet.AllocatePayload(rtx_payload.size());
-  RTC_DCHECK(media_payload != nullptr);
-
-  memcpy(media_payload, rtx_payload.data(), rtx_payload.size());
 
   media_sink_->OnRtpPacket(media_packet);
 }
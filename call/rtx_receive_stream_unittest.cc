@@ -263,6 +263,8 @@ TEST(RtxReceiveStreamTest, SupportsLargePacketWithPadding) {
         EXPECT_EQ(packet.Ssrc(), kMediaSSRC);
         EXPECT_EQ(packet.PayloadType(), kMediaPayloadType);
         EXPECT_THAT(packet.payload(), ::testing::ElementsAreArray(payload));
+        EXPECT_FALSE(packet.has_padding());
+        EXPECT_EQ(packet.size(), packet.headers_size() + payload.size());
       });
 
   rtx_sink.OnRtpPacket(rtx_packet);
@@ -115,6 +115,9 @@ class VideoReceiveStreamInterface : public MediaReceiveStreamInterface {
     TimeDelta total_decode_time = TimeDelta::Zero();
     // https://w3c.github.io/webrtc-stats/#dom-rtcinboundrtpstreamstats-totalprocessingdelay
     TimeDelta total_processing_delay = TimeDelta::Zero();
+    // Non-standard. Thread CPU time spent in the decoder. Only set when the
+    // "WebRTC-PerStreamCpuTime" field trial is enabled.
+    absl::optional<TimeDelta> total_decode_cpu_time;
     // TODO(bugs.webrtc.org/13986): standardize
     TimeDelta total_assembly_time = TimeDelta::Zero();
     uint32_t frames_assembled_from_multiple_packets = 0;
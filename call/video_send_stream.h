@@ -25,6 +25,7 @@
 #include "api/rtp_parameters.h"
 #include "api/rtp_sender_interface.h"
 #include "api/scoped_refptr.h"
+#include "api/units/time_delta.h"
 #include "api/video/video_content_type.h"
 #include "api/video/video_frame.h"
 #include "api/video/video_sink_interface.h"
@@ -111,6 +112,10 @@ class VideoSendStream {
     uint64_t total_encode_time_ms = 0;
     // https://w3c.github.io/webrtc-stats/#dom-rtcoutboundrtpstreamstats-totalencodedbytestarget
     uint64_t total_encoded_bytes_target = 0;
+    // Non-standard. Thread CPU time spent encoding frames of all layers,
+    // including work done synchronously in the encoder callbacks. Only set
+    // when the "WebRTC-PerStreamCpuTime" field trial is enabled.
+    absl::optional<TimeDelta> total_encode_cpu_time;
     uint32_t frames = 0;
     uint32_t frames_dropped_by_capturer = 0;
     uint32_t frames_dropped_by_bad_timestamp = 0;
@@ -0,0 +1,260 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_audio/signal_level.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "system_wrappers/include/cpu_features_wrapper.h"
+
+// This needs to be after rtc_base/system/arch.h which defines
+// architecture macros.
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#endif
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace webrtc {
+namespace signal_level_internal {
+namespace {
+
+using SumOfSquaresS16Function = uint64_t (*)(const int16_t*, size_t);
+using SumOfSquaresFloatS16Function = uint64_t (*)(const float*, size_t);
+using MaxAbsValueS16Function = int16_t (*)(const int16_t*, size_t);
+
+SumOfSquaresS16Function SelectSumOfSquaresS16Function() {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (GetCPUInfo(kAVX2) != 0) {
+    return &SumOfSquaresS16_AVX2;
+  }
+  if (GetCPUInfo(kSSE2) != 0) {
+    return &SumOfSquaresS16_SSE2;
+  }
+#endif
+#if defined(WEBRTC_HAS_NEON)
+  return &SumOfSquaresS16_NEON;
+#else
+  return &SumOfSquaresS16_C;
+#endif
+}
+
+SumOfSquaresFloatS16Function SelectSumOfSquaresFloatS16Function() {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (GetCPUInfo(kAVX2) != 0) {
+    return &SumOfSquaresFloatS16_AVX2;
+  }
+  if (GetCPUInfo(kSSE2) != 0) {
+    return &SumOfSquaresFloatS16_SSE2;
+  }
+#endif
+#if defined(WEBRTC_HAS_NEON)
+  return &SumOfSquaresFloatS16_NEON;
+#else
+  return &SumOfSquaresFloatS16_C;
+#endif
+}
+
+MaxAbsValueS16Function SelectMaxAbsValueS16Function() {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (GetCPUInfo(kAVX2) != 0) {
+    return &MaxAbsValueS16_AVX2;
+  }
+  if (GetCPUInfo(kSSE2) != 0) {
+    return &MaxAbsValueS16_SSE2;
+  }
+#endif
+#if defined(WEBRTC_HAS_NEON)
+  return &MaxAbsValueS16_NEON;
+#else
+  return &MaxAbsValueS16_C;
+#endif
+}
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// Adds the 4 32 bit values of `x`, zero extended to 64 bits, to `sum`.
+__m128i AddWidened(__m128i sum, __m128i x) {
+  const __m128i zero = _mm_setzero_si128();
+  sum = _mm_add_epi64(sum, _mm_unpacklo_epi32(x, zero));
+  return _mm_add_epi64(sum, _mm_unpackhi_epi32(x, zero));
+}
+
+// Adds the squares of the 8 samples of `x` to `sum`. A pair of squares is at
+// most 2^31, so the 32 bit sums are read as unsigned.
+__m128i AddSquares(__m128i sum, __m128i x) {
+  return AddWidened(sum, _mm_madd_epi16(x, x));
+}
+
+// Returns the 8 samples of `x` limited to the int16_t range and truncated.
+__m128i TruncateToS16(__m128 x_low, __m128 x_high) {
+  const __m128 min = _mm_set1_ps(-32768.f);
+  const __m128 max = _mm_set1_ps(32767.f);
+  x_low = _mm_min_ps(_mm_max_ps(x_low, min), max);
+  x_high = _mm_min_ps(_mm_max_ps(x_high, min), max);
+  return _mm_packs_epi32(_mm_cvttps_epi32(x_low), _mm_cvttps_epi32(x_high));
+}
+
+uint64_t HorizontalSum(__m128i sum) {
+  alignas(16) uint64_t sums[2];
+  _mm_store_si128(reinterpret_cast<__m128i*>(sums), sum);
+  return sums[0] + sums[1];
+}
+#endif
+
+#if defined(WEBRTC_HAS_NEON)
+// Adds the squares of the 8 samples of `x` to `sum`. The squares are at most
+// 2^30, so they are read as unsigned.
+uint64x2_t AddSquares(uint64x2_t sum, int16x8_t x) {
+  const int16x4_t x_low = vget_low_s16(x);
+  const int16x4_t x_high = vget_high_s16(x);
+  sum = vpadalq_u32(sum, vreinterpretq_u32_s32(vmull_s16(x_low, x_low)));
+  return vpadalq_u32(sum, vreinterpretq_u32_s32(vmull_s16(x_high, x_high)));
+}
+
+// Returns the 4 samples of `x` limited to the int16_t range and truncated.
+int16x4_t TruncateToS16(float32x4_t x) {
+  x = vminq_f32(vmaxq_f32(x, vdupq_n_f32(-32768.f)), vdupq_n_f32(32767.f));
+  return vmovn_s32(vcvtq_s32_f32(x));
+}
+#endif
+
+}  // namespace
+}  // namespace signal_level_internal
+
+uint64_t SumOfSquaresS16(const int16_t* x, size_t length) {
+  static const signal_level_internal::SumOfSquaresS16Function
+      sum_of_squares_function =
+          signal_level_internal::SelectSumOfSquaresS16Function();
+  return sum_of_squares_function(x, length);
+}
+
+uint64_t SumOfSquaresFloatS16(const float* x, size_t length) {
+  static const signal_level_internal::SumOfSquaresFloatS16Function
+      sum_of_squares_function =
+          signal_level_internal::SelectSumOfSquaresFloatS16Function();
+  return sum_of_squares_function(x, length);
+}
+
+int16_t MaxAbsValueS16(const int16_t* x, size_t length) {
+  static const signal_level_internal::MaxAbsValueS16Function
+      max_abs_value_function =
+          signal_level_internal::SelectMaxAbsValueS16Function();
+  return max_abs_value_function(x, length);
+}
+
+namespace signal_level_internal {
+
+uint64_t SumOfSquaresS16_C(const int16_t* x, size_t length) {
+  uint64_t sum = 0;
+  for (size_t i = 0; i < length; ++i) {
+    sum += static_cast<uint32_t>(x[i] * x[i]);
+  }
+  return sum;
+}
+
+uint64_t SumOfSquaresFloatS16_C(const float* x, size_t length) {
+  uint64_t sum = 0;
+  for (size_t i = 0; i < length; ++i) {
+    const int16_t sample =
+        static_cast<int16_t>(std::min(std::max(x[i], -32768.f), 32767.f));
+    sum += static_cast<uint32_t>(sample * sample);
+  }
+  return sum;
+}
+
+int16_t MaxAbsValueS16_C(const int16_t* x, size_t length) {
+  int max_abs = 0;
+  for (size_t i = 0; i < length; ++i) {
+    max_abs = std::max(max_abs, std::abs(static_cast<int>(x[i])));
+  }
+  return static_cast<int16_t>(std::min(max_abs, 32767));
+}
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+uint64_t SumOfSquaresS16_SSE2(const int16_t* x, size_t length) {
+  __m128i sum = _mm_setzero_si128();
+  size_t i = 0;
+  for (; i + 8 <= length; i += 8) {
+    sum = AddSquares(
+        sum, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&x[i])));
+  }
+  return HorizontalSum(sum) + SumOfSquaresS16_C(&x[i], length - i);
+}
+
+uint64_t SumOfSquaresFloatS16_SSE2(const float* x, size_t length) {
+  __m128i sum = _mm_setzero_si128();
+  size_t i = 0;
+  for (; i + 8 <= length; i += 8) {
+    sum = AddSquares(
+        sum, TruncateToS16(_mm_loadu_ps(&x[i]), _mm_loadu_ps(&x[i + 4])));
+  }
+  return HorizontalSum(sum) + SumOfSquaresFloatS16_C(&x[i], length - i);
+}
+
+int16_t MaxAbsValueS16_SSE2(const int16_t* x, size_t length) {
+  // The saturating negation maps -32768 to 32767, which is the limit anyway.
+  const __m128i zero = _mm_setzero_si128();
+  __m128i max_abs = zero;
+  size_t i = 0;
+  for (; i + 8 <= length; i += 8) {
+    const __m128i samples =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&x[i]));
+    max_abs = _mm_max_epi16(
+        max_abs, _mm_max_epi16(samples, _mm_subs_epi16(zero, samples)));
+  }
+  max_abs = _mm_max_epi16(max_abs, _mm_unpackhi_epi64(max_abs, max_abs));
+  max_abs = _mm_max_epi16(max_abs, _mm_srli_epi64(max_abs, 32));
+  max_abs = _mm_max_epi16(max_abs, _mm_srli_epi32(max_abs, 16));
+  return std::max(static_cast<int16_t>(_mm_cvtsi128_si32(max_abs)),
+                  MaxAbsValueS16_C(&x[i], length - i));
+}
+#endif
+
+#if defined(WEBRTC_HAS_NEON)
+uint64_t SumOfSquaresS16_NEON(const int16_t* x, size_t length) {
+  uint64x2_t sum = vdupq_n_u64(0);
+  size_t i = 0;
+  for (; i + 8 <= length; i += 8) {
+    sum = AddSquares(sum, vld1q_s16(&x[i]));
+  }
+  return vgetq_lane_u64(sum, 0) + vgetq_lane_u64(sum, 1) +
+         SumOfSquaresS16_C(&x[i], length - i);
+}
+
+uint64_t SumOfSquaresFloatS16_NEON(const float* x, size_t length) {
+  uint64x2_t sum = vdupq_n_u64(0);
+  size_t i = 0;
+  for (; i + 8 <= length; i += 8) {
+    sum = AddSquares(sum, vcombine_s16(TruncateToS16(vld1q_f32(&x[i])),
+                                       TruncateToS16(vld1q_f32(&x[i + 4]))));
+  }
+  return vgetq_lane_u64(sum, 0) + vgetq_lane_u64(sum, 1) +
+         SumOfSquaresFloatS16_C(&x[i], length - i);
+}
+
+int16_t MaxAbsValueS16_NEON(const int16_t* x, size_t length) {
+  // The saturating absolute value maps -32768 to 32767.
+  int16x8_t max_abs = vdupq_n_s16(0);
+  size_t i = 0;
+  for (; i + 8 <= length; i += 8) {
+    max_abs = vmaxq_s16(max_abs, vqabsq_s16(vld1q_s16(&x[i])));
+  }
+  int16x4_t max_abs_4 = vmax_s16(vget_low_s16(max_abs), vget_high_s16(max_abs));
+  max_abs_4 = vpmax_s16(max_abs_4, max_abs_4);
+  max_abs_4 = vpmax_s16(max_abs_4, max_abs_4);
+  return std::max(vget_lane_s16(max_abs_4, 0),
+                  MaxAbsValueS16_C(&x[i], length - i));
+}
+#endif
+
+}  // namespace signal_level_internal
+}  // namespace webrtc
@@ -0,0 +1,62 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef COMMON_AUDIO_SIGNAL_LEVEL_H_
+#define COMMON_AUDIO_SIGNAL_LEVEL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rtc_base/system/arch.h"
+
+namespace webrtc {
+
+// Level measurements shared by the RMS and peak level meters of the audio
+// pipeline. Each function uses the widest vector instructions the CPU supports
+// and gives the same result as its _C variant.
+
+// Returns the exact sum of the squares of the `length` samples of `x`.
+uint64_t SumOfSquaresS16(const int16_t* x, size_t length);
+
+// Same as SumOfSquaresS16(), for FloatS16 samples that are limited to the
+// int16_t range and truncated towards zero before being squared.
+uint64_t SumOfSquaresFloatS16(const float* x, size_t length);
+
+// Returns the largest absolute value of the `length` samples of `x`, limited
+// to 32767. Same as WebRtcSpl_MaxAbsValueW16(), but returns 0 when `length` is
+// 0.
+int16_t MaxAbsValueS16(const int16_t* x, size_t length);
+
+namespace signal_level_internal {
+
+// Variants of the functions above for a given instruction set, exposed for
+// testing.
+uint64_t SumOfSquaresS16_C(const int16_t* x, size_t length);
+uint64_t SumOfSquaresFloatS16_C(const float* x, size_t length);
+int16_t MaxAbsValueS16_C(const int16_t* x, size_t length);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+uint64_t SumOfSquaresS16_SSE2(const int16_t* x, size_t length);
+uint64_t SumOfSquaresFloatS16_SSE2(const float* x, size_t length);
+int16_t MaxAbsValueS16_SSE2(const int16_t* x, size_t length);
+// Must only be called when GetCPUInfo(kAVX2) is set.
+uint64_t SumOfSquaresS16_AVX2(const int16_t* x, size_t length);
+uint64_t SumOfSquaresFloatS16_AVX2(const float* x, size_t length);
+int16_t MaxAbsValueS16_AVX2(const int16_t* x, size_t length);
+#endif
+#if defined(WEBRTC_HAS_NEON)
+uint64_t SumOfSquaresS16_NEON(const int16_t* x, size_t length);
+uint64_t SumOfSquaresFloatS16_NEON(const float* x, size_t length);
+int16_t MaxAbsValueS16_NEON(const int16_t* x, size_t length);
+#endif
+
+}  // namespace signal_level_internal
+}  // namespace webrtc
+
+#endif  // COMMON_AUDIO_SIGNAL_LEVEL_H_
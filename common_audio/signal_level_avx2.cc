@@ -0,0 +1,92 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include <algorithm>
+
+#include "common_audio/signal_level.h"
+
+namespace webrtc {
+namespace signal_level_internal {
+namespace {
+
+// Adds the squares of the 16 samples of `x` to `sum`. A pair of squares is at
+// most 2^31, so the 32 bit sums are zero extended.
+__m256i AddSquares(__m256i sum, __m256i x) {
+  const __m256i squares = _mm256_madd_epi16(x, x);
+  sum = _mm256_add_epi64(
+      sum, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(squares)));
+  return _mm256_add_epi64(
+      sum, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(squares, 1)));
+}
+
+// Returns the 16 samples of `x` limited to the int16_t range and truncated.
+// The samples are not in the order of `x`.
+__m256i TruncateToS16(__m256 x_low, __m256 x_high) {
+  const __m256 min = _mm256_set1_ps(-32768.f);
+  const __m256 max = _mm256_set1_ps(32767.f);
+  x_low = _mm256_min_ps(_mm256_max_ps(x_low, min), max);
+  x_high = _mm256_min_ps(_mm256_max_ps(x_high, min), max);
+  return _mm256_packs_epi32(_mm256_cvttps_epi32(x_low),
+                            _mm256_cvttps_epi32(x_high));
+}
+
+uint64_t HorizontalSum(__m256i sum) {
+  alignas(32) uint64_t sums[4];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(sums), sum);
+  return sums[0] + sums[1] + sums[2] + sums[3];
+}
+
+}  // namespace
+
+uint64_t SumOfSquaresS16_AVX2(const int16_t* x, size_t length) {
+  __m256i sum = _mm256_setzero_si256();
+  size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    sum = AddSquares(
+        sum, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&x[i])));
+  }
+  return HorizontalSum(sum) + SumOfSquaresS16_SSE2(&x[i], length - i);
+}
+
+uint64_t SumOfSquaresFloatS16_AVX2(const float* x, size_t length) {
+  __m256i sum = _mm256_setzero_si256();
+  size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    sum = AddSquares(sum, TruncateToS16(_mm256_loadu_ps(&x[i]),
+                                        _mm256_loadu_ps(&x[i + 8])));
+  }
+  return HorizontalSum(sum) + SumOfSquaresFloatS16_SSE2(&x[i], length - i);
+}
+
+int16_t MaxAbsValueS16_AVX2(const int16_t* x, size_t length) {
+  // The saturating negation maps -32768 to 32767, which is the limit anyway.
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i max_abs = zero;
+  size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    const __m256i samples =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&x[i]));
+    max_abs = _mm256_max_epi16(
+        max_abs, _mm256_max_epi16(samples, _mm256_subs_epi16(zero, samples)));
+  }
+  __m128i max_abs_128 = _mm_max_epi16(_mm256_castsi256_si128(max_abs),
+                                      _mm256_extracti128_si256(max_abs, 1));
+  max_abs_128 = _mm_max_epi16(max_abs_128,
+                              _mm_unpackhi_epi64(max_abs_128, max_abs_128));
+  max_abs_128 = _mm_max_epi16(max_abs_128, _mm_srli_epi64(max_abs_128, 32));
+  max_abs_128 = _mm_max_epi16(max_abs_128, _mm_srli_epi32(max_abs_128, 16));
+  return std::max(static_cast<int16_t>(_mm_cvtsi128_si32(max_abs_128)),
+                  MaxAbsValueS16_SSE2(&x[i], length - i));
+}
+
+}  // namespace signal_level_internal
+}  // namespace webrtc
@@ -0,0 +1,133 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_audio/signal_level.h"
+
+#include <vector>
+
+#include "rtc_base/random.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace signal_level_internal {
+namespace {
+
+using SumOfSquaresS16Function = uint64_t (*)(const int16_t*, size_t);
+using SumOfSquaresFloatS16Function = uint64_t (*)(const float*, size_t);
+using MaxAbsValueS16Function = int16_t (*)(const int16_t*, size_t);
+
+constexpr size_t kMaxLength = 100;
+
+std::vector<int16_t> RandomSamples(Random& random, size_t length) {
+  std::vector<int16_t> samples(length);
+  for (int16_t& sample : samples) {
+    sample = static_cast<int16_t>(random.Rand(-32768, 32767));
+  }
+  return samples;
+}
+
+void VerifySumOfSquaresS16(SumOfSquaresS16Function sum_of_squares) {
+  Random random(/*seed=*/1234);
+  for (size_t length = 0; length <= kMaxLength; ++length) {
+    SCOPED_TRACE(length);
+    const std::vector<int16_t> samples = RandomSamples(random, length);
+    EXPECT_EQ(sum_of_squares(samples.data(), length),
+              SumOfSquaresS16_C(samples.data(), length));
+  }
+  // The largest squares don't overflow.
+  const std::vector<int16_t> loud(kMaxLength, -32768);
+  EXPECT_EQ(sum_of_squares(loud.data(), kMaxLength),
+            uint64_t{kMaxLength} * 32768 * 32768);
+}
+
+void VerifySumOfSquaresFloatS16(SumOfSquaresFloatS16Function sum_of_squares) {
+  Random random(/*seed=*/1234);
+  for (size_t length = 0; length <= kMaxLength; ++length) {
+    SCOPED_TRACE(length);
+    // Includes samples out of the int16_t range.
+    std::vector<float> samples(length);
+    for (float& sample : samples) {
+      sample = 40000.f * (2.f * random.Rand<float>() - 1.f);
+    }
+    EXPECT_EQ(sum_of_squares(samples.data(), length),
+              SumOfSquaresFloatS16_C(samples.data(), length));
+  }
+  const std::vector<float> samples = {-40000.f, -32768.f, -1.9f, -0.5f,
+                                      0.5f,     1.9f,     32767.9f, 40000.f};
+  EXPECT_EQ(sum_of_squares(samples.data(), samples.size()),
+            uint64_t{2} * 32768 * 32768 + 2 * 32767 * 32767 + 2);
+}
+
+void VerifyMaxAbsValueS16(MaxAbsValueS16Function max_abs_value) {
+  Random random(/*seed=*/1234);
+  for (size_t length = 0; length <= kMaxLength; ++length) {
+    SCOPED_TRACE(length);
+    std::vector<int16_t> samples(length);
+    for (int16_t& sample : samples) {
+      sample = static_cast<int16_t>(random.Rand(-1000, 1000));
+    }
+    EXPECT_EQ(max_abs_value(samples.data(), length),
+              MaxAbsValueS16_C(samples.data(), length));
+    // A single negative peak, at each position.
+    for (size_t i = 0; i < length; ++i) {
+      std::vector<int16_t> peak = samples;
+      peak[i] = -5000;
+      EXPECT_EQ(max_abs_value(peak.data(), length), 5000);
+    }
+  }
+  // -32768 is limited to 32767.
+  const std::vector<int16_t> loud(kMaxLength, -32768);
+  EXPECT_EQ(max_abs_value(loud.data(), kMaxLength), 32767);
+}
+
+TEST(SignalLevelTest, C) {
+  VerifySumOfSquaresS16(&SumOfSquaresS16_C);
+  VerifySumOfSquaresFloatS16(&SumOfSquaresFloatS16_C);
+  VerifyMaxAbsValueS16(&MaxAbsValueS16_C);
+}
+
+TEST(SignalLevelTest, Dispatched) {
+  VerifySumOfSquaresS16(&SumOfSquaresS16);
+  VerifySumOfSquaresFloatS16(&SumOfSquaresFloatS16);
+  VerifyMaxAbsValueS16(&MaxAbsValueS16);
+}
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+TEST(SignalLevelTest, Sse2) {
+  if (GetCPUInfo(kSSE2) == 0) {
+    GTEST_SKIP() << "SSE2 is not supported.";
+  }
+  VerifySumOfSquaresS16(&SumOfSquaresS16_SSE2);
+  VerifySumOfSquaresFloatS16(&SumOfSquaresFloatS16_SSE2);
+  VerifyMaxAbsValueS16(&MaxAbsValueS16_SSE2);
+}
+
+TEST(SignalLevelTest, Avx2) {
+  if (GetCPUInfo(kAVX2) == 0) {
+    GTEST_SKIP() << "AVX2 is not supported.";
+  }
+  VerifySumOfSquaresS16(&SumOfSquaresS16_AVX2);
+  VerifySumOfSquaresFloatS16(&SumOfSquaresFloatS16_AVX2);
+  VerifyMaxAbsValueS16(&MaxAbsValueS16_AVX2);
+}
+#endif
+
+#if defined(WEBRTC_HAS_NEON)
+TEST(SignalLevelTest, Neon) {
+  VerifySumOfSquaresS16(&SumOfSquaresS16_NEON);
+  VerifySumOfSquaresFloatS16(&SumOfSquaresFloatS16_NEON);
+  VerifyMaxAbsValueS16(&MaxAbsValueS16_NEON);
+}
+#endif
+
+}  // namespace
+}  // namespace signal_level_internal
+}  // namespace webrtc
@@ -10,8 +10,11 @@
 
 #include "common_video/h264/h264_common.h"
 
+#include <algorithm>
 #include <cstdint>
 
+#include "common_video/h264/start_sequence_scan.h"
+
 namespace webrtc {
 namespace H264 {
 
@@ -19,39 +22,29 @@ const uint8_t kNaluTypeMask = 0x1F;
 
 std::vector<NaluIndex> FindNaluIndices(const uint8_t* buffer,
                                        size_t buffer_size) {
-  // This is sorta like Boyer-Moore, but with only the first optimization step:
-  // given a 3-byte sequence we're looking at, if the 3rd byte isn't 1 or 0,
-  // skip ahead to the next 3-byte sequence. 0s and 1s are relatively rare, so
-  // this will skip the majority of reads/checks.
   std::vector<NaluIndex> sequences;
   if (buffer_size < kNaluShortStartSequenceSize)
     return sequences;
 
-  static_assert(kNaluShortStartSequenceSize >= 2,
-                "kNaluShortStartSequenceSize must be larger or equals to 2");
-  const size_t end = buffer_size - kNaluShortStartSequenceSize;
-  for (size_t i = 0; i < end;) {
-    if (buffer[i + 2] > 1) {
-      i += 3;
-    } else if (buffer[i + 2] == 1) {
-      if (buffer[i + 1] == 0 && buffer[i] == 0) {
-        // We found a start sequence, now check if it was a 3 of 4 byte one.
-        NaluIndex index = {i, i + 3, 0};
-        if (index.start_offset > 0 && buffer[index.start_offset - 1] == 0)
-          --index.start_offset;
-
-        // Update length of previous entry.
-        auto it = sequences.rbegin();
-        if (it != sequences.rend())
-          it->payload_size = index.start_offset - it->payload_start_offset;
-
-        sequences.push_back(index);
-      }
-
-      i += 3;
-    } else {
-      ++i;
-    }
+  // A start sequence must be followed by at least one byte.
+  const size_t end = buffer_size - 1;
+  for (size_t i = 0;;) {
+    size_t start = i + internal::FindZerosFollowedBy(buffer + i, end - i, 1);
+    if (start == end)
+      break;
+
+    // We found a start sequence, now check if it was a 3 of 4 byte one.
+    NaluIndex index = {start, start + 3, 0};
+    if (index.start_offset > 0 && buffer[index.start_offset - 1] == 0)
+      --index.start_offset;
+
+    // Update length of previous entry.
+    auto it = sequences.rbegin();
+    if (it != sequences.rend())
+      it->payload_size = index.start_offset - it->payload_start_offset;
+
+    sequences.push_back(index);
+    i = index.payload_start_offset;
   }
 
   // Update length of last entry, if any.
@@ -71,20 +64,12 @@ std::vector<uint8_t> ParseRbsp(const uint8_t* data, size_t length) {
   out.reserve(length);
 
   for (size_t i = 0; i < length;) {
-    // Be careful about over/underflow here. byte_length_ - 3 can underflow, and
-    // i + 3 can overflow, but byte_length_ - i can't, because i < byte_length_
-    // above, and that expression will produce the number of bytes left in
-    // the stream including the byte at i.
-    if (length - i >= 3 && !data[i] && !data[i + 1] && data[i + 2] == 3) {
-      // Two rbsp bytes.
-      out.push_back(data[i++]);
-      out.push_back(data[i++]);
-      // Skip the emulation byte.
-      i++;
-    } else {
-      // Single rbsp byte.
-      out.push_back(data[i++]);
-    }
+    size_t emulation =
+        i + internal::FindZerosFollowedBy(data + i, length - i, 3);
+    // Copy the rbsp bytes up to and including the two zeros, and skip the
+    // emulation byte.
+    out.insert(out.end(), data + i, data + std::min(emulation + 2, length));
+    i = emulation + 3;
   }
   return out;
 }
@@ -0,0 +1,123 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_video/h264/start_sequence_scan.h"
+
+#include "absl/numeric/bits.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+
+// This needs to be after rtc_base/system/arch.h which defines
+// architecture macros.
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#endif
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace webrtc {
+namespace H264 {
+namespace internal {
+namespace {
+
+using FindFunction = size_t (*)(const uint8_t*, size_t, uint8_t);
+
+FindFunction SelectFindFunction() {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (GetCPUInfo(kAVX2) != 0) {
+    return &FindZerosFollowedBy_AVX2;
+  }
+  if (GetCPUInfo(kSSE2) != 0) {
+    return &FindZerosFollowedBy_SSE2;
+  }
+#endif
+#if defined(WEBRTC_HAS_NEON)
+  return &FindZerosFollowedBy_NEON;
+#else
+  return &FindZerosFollowedBy_C;
+#endif
+}
+
+}  // namespace
+
+size_t FindZerosFollowedBy(const uint8_t* data, size_t size, uint8_t byte) {
+  static const FindFunction find_function = SelectFindFunction();
+  return find_function(data, size, byte);
+}
+
+size_t FindZerosFollowedBy_C(const uint8_t* data, size_t size, uint8_t byte) {
+  // This is sorta like Boyer-Moore, but with only the first optimization step:
+  // given a 3-byte sequence we're looking at, if the 3rd byte isn't 0, no
+  // sequence starts at the next two bytes either, so skip ahead to the next
+  // 3-byte sequence. 0s are relatively rare, so this will skip the majority of
+  // reads/checks.
+  for (size_t i = 0; i + 3 <= size;) {
+    if (data[i + 2] == byte && data[i + 1] == 0 && data[i] == 0) {
+      return i;
+    }
+    i += data[i + 2] == 0 ? 1 : 3;
+  }
+  return size;
+}
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+size_t FindZerosFollowedBy_SSE2(const uint8_t* data,
+                                size_t size,
+                                uint8_t byte) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i last = _mm_set1_epi8(static_cast<char>(byte));
+  size_t i = 0;
+  // Compares the 16 sequences starting at `i` at once.
+  for (; i + 18 <= size; i += 16) {
+    const __m128i b0 =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    const __m128i b1 =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 1));
+    const __m128i b2 =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 2));
+    const __m128i match =
+        _mm_and_si128(_mm_and_si128(_mm_cmpeq_epi8(b0, zero),
+                                    _mm_cmpeq_epi8(b1, zero)),
+                      _mm_cmpeq_epi8(b2, last));
+    const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(match));
+    if (mask != 0) {
+      return i + absl::countr_zero(mask);
+    }
+  }
+  return i + FindZerosFollowedBy_C(data + i, size - i, byte);
+}
+#endif
+
+#if defined(WEBRTC_HAS_NEON)
+size_t FindZerosFollowedBy_NEON(const uint8_t* data,
+                                size_t size,
+                                uint8_t byte) {
+  const uint8x16_t zero = vdupq_n_u8(0);
+  const uint8x16_t last = vdupq_n_u8(byte);
+  size_t i = 0;
+  for (; i + 18 <= size; i += 16) {
+    const uint8x16_t match =
+        vandq_u8(vandq_u8(vceqq_u8(vld1q_u8(data + i), zero),
+                          vceqq_u8(vld1q_u8(data + i + 1), zero)),
+                 vceqq_u8(vld1q_u8(data + i + 2), last));
+    // Narrow each byte of the comparison to 4 bits of a 64 bit mask.
+    const uint64_t mask = vget_lane_u64(
+        vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(match), 4)), 0);
+    if (mask != 0) {
+      return i + absl::countr_zero(mask) / 4;
+    }
+  }
+  return i + FindZerosFollowedBy_C(data + i, size - i, byte);
+}
+#endif
+
+}  // namespace internal
+}  // namespace H264
+}  // namespace webrtc
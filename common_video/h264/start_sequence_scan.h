@@ -0,0 +1,51 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef COMMON_VIDEO_H264_START_SEQUENCE_SCAN_H_
+#define COMMON_VIDEO_H264_START_SEQUENCE_SCAN_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rtc_base/system/arch.h"
+
+namespace webrtc {
+namespace H264 {
+namespace internal {
+
+// Returns the offset of the first 00 00 `byte` sequence that lies entirely
+// within the `size` bytes of `data`, or `size` if there is none. Used with
+// `byte` 01 to find start sequences and with 03 to find emulation prevention
+// bytes. Uses the widest vector instructions the CPU supports.
+size_t FindZerosFollowedBy(const uint8_t* data, size_t size, uint8_t byte);
+
+// Variants of FindZerosFollowedBy() for a given instruction set, exposed for
+// testing.
+size_t FindZerosFollowedBy_C(const uint8_t* data, size_t size, uint8_t byte);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+size_t FindZerosFollowedBy_SSE2(const uint8_t* data,
+                                size_t size,
+                                uint8_t byte);
+// Must only be called when GetCPUInfo(kAVX2) is set.
+size_t FindZerosFollowedBy_AVX2(const uint8_t* data,
+                                size_t size,
+                                uint8_t byte);
+#endif
+#if defined(WEBRTC_HAS_NEON)
+size_t FindZerosFollowedBy_NEON(const uint8_t* data,
+                                size_t size,
+                                uint8_t byte);
+#endif
+
+}  // namespace internal
+}  // namespace H264
+}  // namespace webrtc
+
+#endif  // COMMON_VIDEO_H264_START_SEQUENCE_SCAN_H_
@@ -0,0 +1,48 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include "absl/numeric/bits.h"
+#include "common_video/h264/start_sequence_scan.h"
+
+namespace webrtc {
+namespace H264 {
+namespace internal {
+
+size_t FindZerosFollowedBy_AVX2(const uint8_t* data,
+                                size_t size,
+                                uint8_t byte) {
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i last = _mm256_set1_epi8(static_cast<char>(byte));
+  size_t i = 0;
+  // Compares the 32 sequences starting at `i` at once.
+  for (; i + 34 <= size; i += 32) {
+    const __m256i b0 =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+    const __m256i b1 =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 1));
+    const __m256i b2 =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 2));
+    const __m256i match =
+        _mm256_and_si256(_mm256_and_si256(_mm256_cmpeq_epi8(b0, zero),
+                                          _mm256_cmpeq_epi8(b1, zero)),
+                         _mm256_cmpeq_epi8(b2, last));
+    const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(match));
+    if (mask != 0) {
+      return i + absl::countr_zero(mask);
+    }
+  }
+  return i + FindZerosFollowedBy_C(data + i, size - i, byte);
+}
+
+}  // namespace internal
+}  // namespace H264
+}  // namespace webrtc
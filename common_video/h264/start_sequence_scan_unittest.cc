@@ -0,0 +1,130 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_video/h264/start_sequence_scan.h"
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+#include "common_video/h264/h264_common.h"
+#include "rtc_base/random.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace H264 {
+namespace internal {
+namespace {
+
+using ::testing::ElementsAre;
+
+using FindFunction = size_t (*)(const uint8_t*, size_t, uint8_t);
+
+size_t FindReference(const uint8_t* data, size_t size, uint8_t byte) {
+  for (size_t i = 0; i + 3 <= size; ++i) {
+    if (data[i] == 0 && data[i + 1] == 0 && data[i + 2] == byte)
+      return i;
+  }
+  return size;
+}
+
+// Checks `find_function` against a plain loop for all sizes up to a few vector
+// registers, for unaligned buffers, and for sequences straddling the vector
+// boundaries. Random bytes are mostly 0, 1 and 3 so that sequences are common.
+void VerifyFind(FindFunction find_function) {
+  Random random(/*seed=*/1234);
+  for (size_t offset = 0; offset < 4; ++offset) {
+    for (size_t size = 0; size <= 100; ++size) {
+      SCOPED_TRACE(size);
+      for (int trial = 0; trial < 20; ++trial) {
+        std::vector<uint8_t> buffer(offset + size + 2);
+        for (uint8_t& byte : buffer) {
+          byte = random.Rand(3) == 0 ? random.Rand<uint8_t>()
+                                     : random.Rand(1) * random.Rand(1, 3);
+        }
+        // Any sequence in the bytes past the end must not be found.
+        buffer[offset + size] = 0;
+        buffer[offset + size + 1] = 0;
+
+        for (uint8_t byte : {1, 3}) {
+          const uint8_t* data = buffer.data() + offset;
+          EXPECT_EQ(find_function(data, size, byte),
+                    FindReference(data, size, byte));
+        }
+      }
+    }
+  }
+}
+
+TEST(H264StartSequenceScanTest, FindZerosFollowedBy) {
+  VerifyFind(&FindZerosFollowedBy);
+}
+
+TEST(H264StartSequenceScanTest, FindZerosFollowedByC) {
+  VerifyFind(&FindZerosFollowedBy_C);
+}
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+TEST(H264StartSequenceScanTest, FindZerosFollowedBySse2) {
+  if (GetCPUInfo(kSSE2) == 0) {
+    GTEST_SKIP() << "SSE2 is not supported.";
+  }
+  VerifyFind(&FindZerosFollowedBy_SSE2);
+}
+
+TEST(H264StartSequenceScanTest, FindZerosFollowedByAvx2) {
+  if (GetCPUInfo(kAVX2) == 0) {
+    GTEST_SKIP() << "AVX2 is not supported.";
+  }
+  VerifyFind(&FindZerosFollowedBy_AVX2);
+}
+#endif
+
+#if defined(WEBRTC_HAS_NEON)
+TEST(H264StartSequenceScanTest, FindZerosFollowedByNeon) {
+  VerifyFind(&FindZerosFollowedBy_NEON);
+}
+#endif
+
+TEST(H264StartSequenceScanTest, FindsNaluIndices) {
+  std::vector<uint8_t> buffer(100, 0xff);
+  // A 4 byte start sequence at the beginning, and a 3 byte one at an offset
+  // that spans two vector registers.
+  const uint8_t kLongStart[] = {0, 0, 0, 1};
+  const uint8_t kShortStart[] = {0, 0, 1};
+  std::copy(std::begin(kLongStart), std::end(kLongStart), buffer.begin());
+  std::copy(std::begin(kShortStart), std::end(kShortStart),
+            buffer.begin() + 31);
+  // A start sequence that ends the buffer has no payload and is ignored.
+  std::copy(std::begin(kShortStart), std::end(kShortStart), buffer.end() - 3);
+
+  std::vector<NaluIndex> indices =
+      FindNaluIndices(buffer.data(), buffer.size());
+  ASSERT_EQ(indices.size(), 2u);
+  EXPECT_EQ(indices[0].start_offset, 0u);
+  EXPECT_EQ(indices[0].payload_start_offset, 4u);
+  EXPECT_EQ(indices[0].payload_size, 27u);
+  EXPECT_EQ(indices[1].start_offset, 31u);
+  EXPECT_EQ(indices[1].payload_start_offset, 34u);
+  EXPECT_EQ(indices[1].payload_size, 66u);
+}
+
+TEST(H264StartSequenceScanTest, ParseRbspRemovesEmulationBytes) {
+  const uint8_t kRbsp[] = {0, 0, 3, 0, 5, 0, 0, 3, 3, 0, 0, 3};
+  EXPECT_THAT(ParseRbsp(kRbsp, sizeof(kRbsp)),
+              ElementsAre(0, 0, 0, 5, 0, 0, 3, 0, 0));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace H264
+}  // namespace webrtc
@@ -0,0 +1,101 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef COMMON_VIDEO_INCLUDE_SHARED_VIDEO_FRAME_BUFFER_POOL_H_
+#define COMMON_VIDEO_INCLUDE_SHARED_VIDEO_FRAME_BUFFER_POOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <list>
+
+#include "api/scoped_refptr.h"
+#include "api/video/video_frame_buffer.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/system/rtc_export.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+class VideoFrameBufferPool;
+
+// Pool of idle video frame buffers shared by the VideoFrameBufferPools of many
+// decoders and scalers, possibly of different PeerConnections. A
+// VideoFrameBufferPool attached to a shared pool hands its idle buffers over
+// to the shared pool instead of keeping them, and takes buffers of matching
+// type and resolution from it before allocating new ones. The idle buffers are
+// kept up to a byte budget, beyond which the least recently returned ones are
+// freed.
+// This class is thread safe.
+class RTC_EXPORT SharedVideoFrameBufferPool {
+ public:
+  static constexpr size_t kDefaultMaxIdleBytes = 256 * 1024 * 1024;
+
+  struct Stats {
+    // Buffers requested from the pool that were, or were not, available.
+    int64_t hits = 0;
+    int64_t misses = 0;
+    // Idle buffers freed to stay within the byte budget.
+    int64_t evictions = 0;
+    size_t idle_buffers = 0;
+    size_t idle_bytes = 0;
+  };
+
+  // Returns the process-wide pool, with a budget of `kDefaultMaxIdleBytes`.
+  static SharedVideoFrameBufferPool& Default();
+
+  explicit SharedVideoFrameBufferPool(size_t max_idle_bytes);
+  ~SharedVideoFrameBufferPool();
+
+  SharedVideoFrameBufferPool(const SharedVideoFrameBufferPool&) = delete;
+  SharedVideoFrameBufferPool& operator=(const SharedVideoFrameBufferPool&) =
+      delete;
+
+  // Changes the byte budget, freeing idle buffers beyond it.
+  void SetMaxIdleBytes(size_t max_idle_bytes);
+  // Frees all idle buffers.
+  void Clear();
+  Stats GetStats() const;
+
+ private:
+  friend class VideoFrameBufferPool;
+
+  struct IdleBuffer {
+    rtc::scoped_refptr<VideoFrameBuffer> buffer;
+    bool zero_initialized;
+    size_t size_bytes;
+  };
+
+  // Returns an idle buffer of the given type and resolution, or null. Buffers
+  // allocated zero initialized are only handed out to pools that zero
+  // initialize their buffers, and vice versa.
+  rtc::scoped_refptr<VideoFrameBuffer> Take(VideoFrameBuffer::Type type,
+                                            int width,
+                                            int height,
+                                            bool zero_initialized);
+  // Adds an idle buffer created by a VideoFrameBufferPool. `buffer` must be
+  // the only reference to it.
+  void Give(rtc::scoped_refptr<VideoFrameBuffer> buffer, bool zero_initialized);
+
+  // Moves the least recently given buffers beyond the byte budget to
+  // `evicted`, to be freed after releasing the lock.
+  void TrimLocked(std::list<IdleBuffer>& evicted)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  mutable Mutex mutex_;
+  size_t max_idle_bytes_ RTC_GUARDED_BY(mutex_);
+  // Idle buffers, least recently given first.
+  std::list<IdleBuffer> idle_buffers_ RTC_GUARDED_BY(mutex_);
+  Stats stats_ RTC_GUARDED_BY(mutex_);
+};
+
+}  // namespace webrtc
+
+#endif  // COMMON_VIDEO_INCLUDE_SHARED_VIDEO_FRAME_BUFFER_POOL_H_
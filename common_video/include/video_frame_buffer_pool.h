@@ -23,6 +23,7 @@
 #include "api/video/i422_buffer.h"
 #include "api/video/i444_buffer.h"
 #include "api/video/nv12_buffer.h"
+#include "common_video/include/shared_video_frame_buffer_pool.h"
 #include "rtc_base/race_checker.h"
 
 namespace webrtc {
@@ -36,11 +37,17 @@ namespace webrtc {
 // Note that Create(I420|NV12)Buffer will crash if more than
 // kMaxNumberOfFramesBeforeCrash are created. This is to prevent memory leaks
 // where frames are not returned.
+// With a `shared_pool`, idle buffers are handed over to it instead of being
+// kept, and buffers are taken from it before new ones are allocated, so that
+// pools of many streams share their idle buffers.
 class VideoFrameBufferPool {
  public:
   VideoFrameBufferPool();
   explicit VideoFrameBufferPool(bool zero_initialize);
   VideoFrameBufferPool(bool zero_initialize, size_t max_number_of_buffers);
+  VideoFrameBufferPool(bool zero_initialize,
+                       size_t max_number_of_buffers,
+                       SharedVideoFrameBufferPool* shared_pool);
   ~VideoFrameBufferPool();
 
   // Returns a buffer from the pool. If no suitable buffer exist in the pool
@@ -60,7 +67,8 @@ class VideoFrameBufferPool {
   bool Resize(size_t max_number_of_buffers);
 
   // Clears buffers_ and detaches the thread checker so that it can be reused
-  // later from another thread.
+  // later from another thread. Idle buffers are handed to the shared pool, if
+  // any.
   void Release();
 
  private:
@@ -77,6 +85,7 @@ class VideoFrameBufferPool {
   const bool zero_initialize_;
   // Max number of buffers this pool can have pending.
   size_t max_number_of_buffers_;
+  SharedVideoFrameBufferPool* const shared_pool_;
 };
 
 }  // namespace webrtc
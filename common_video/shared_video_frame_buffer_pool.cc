@@ -0,0 +1,127 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_video/include/shared_video_frame_buffer_pool.h"
+
+#include <utility>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+namespace {
+
+// Approximate size of the pixel data, ignoring stride alignment.
+size_t BufferSizeBytes(const VideoFrameBuffer& buffer) {
+  size_t pixels = static_cast<size_t>(buffer.width()) * buffer.height();
+  switch (buffer.type()) {
+    case VideoFrameBuffer::Type::kI420:
+    case VideoFrameBuffer::Type::kNV12:
+      return pixels * 3 / 2;
+    case VideoFrameBuffer::Type::kI422:
+      return pixels * 2;
+    case VideoFrameBuffer::Type::kI444:
+    case VideoFrameBuffer::Type::kI010:
+      return pixels * 3;
+    case VideoFrameBuffer::Type::kI210:
+      return pixels * 4;
+    case VideoFrameBuffer::Type::kI410:
+      return pixels * 6;
+    default:
+      RTC_DCHECK_NOTREACHED();
+  }
+  return pixels;
+}
+
+}  // namespace
+
+SharedVideoFrameBufferPool& SharedVideoFrameBufferPool::Default() {
+  static SharedVideoFrameBufferPool* const pool =
+      new SharedVideoFrameBufferPool(kDefaultMaxIdleBytes);
+  return *pool;
+}
+
+SharedVideoFrameBufferPool::SharedVideoFrameBufferPool(size_t max_idle_bytes)
+    : max_idle_bytes_(max_idle_bytes) {}
+
+SharedVideoFrameBufferPool::~SharedVideoFrameBufferPool() = default;
+
+void SharedVideoFrameBufferPool::SetMaxIdleBytes(size_t max_idle_bytes) {
+  std::list<IdleBuffer> evicted;
+  MutexLock lock(&mutex_);
+  max_idle_bytes_ = max_idle_bytes;
+  TrimLocked(evicted);
+}
+
+void SharedVideoFrameBufferPool::Clear() {
+  std::list<IdleBuffer> idle_buffers;
+  {
+    MutexLock lock(&mutex_);
+    idle_buffers.swap(idle_buffers_);
+    stats_.idle_buffers = 0;
+    stats_.idle_bytes = 0;
+  }
+}
+
+SharedVideoFrameBufferPool::Stats SharedVideoFrameBufferPool::GetStats()
+    const {
+  MutexLock lock(&mutex_);
+  return stats_;
+}
+
+rtc::scoped_refptr<VideoFrameBuffer> SharedVideoFrameBufferPool::Take(
+    VideoFrameBuffer::Type type,
+    int width,
+    int height,
+    bool zero_initialized) {
+  MutexLock lock(&mutex_);
+  // Prefer the most recently given buffer, which is most likely still cached.
+  for (auto it = idle_buffers_.rbegin(); it != idle_buffers_.rend(); ++it) {
+    const VideoFrameBuffer& buffer = *it->buffer;
+    if (buffer.type() == type && buffer.width() == width &&
+        buffer.height() == height &&
+        it->zero_initialized == zero_initialized) {
+      rtc::scoped_refptr<VideoFrameBuffer> taken = std::move(it->buffer);
+      --stats_.idle_buffers;
+      stats_.idle_bytes -= it->size_bytes;
+      ++stats_.hits;
+      idle_buffers_.erase(std::next(it).base());
+      return taken;
+    }
+  }
+  ++stats_.misses;
+  return nullptr;
+}
+
+void SharedVideoFrameBufferPool::Give(
+    rtc::scoped_refptr<VideoFrameBuffer> buffer,
+    bool zero_initialized) {
+  RTC_DCHECK(buffer);
+  size_t size_bytes = BufferSizeBytes(*buffer);
+  std::list<IdleBuffer> evicted;
+  {
+    MutexLock lock(&mutex_);
+    idle_buffers_.push_back({std::move(buffer), zero_initialized, size_bytes});
+    ++stats_.idle_buffers;
+    stats_.idle_bytes += size_bytes;
+    TrimLocked(evicted);
+  }
+}
+
+void SharedVideoFrameBufferPool::TrimLocked(std::list<IdleBuffer>& evicted) {
+  while (stats_.idle_bytes > max_idle_bytes_) {
+    --stats_.idle_buffers;
+    stats_.idle_bytes -= idle_buffers_.front().size_bytes;
+    ++stats_.evictions;
+    evicted.splice(evicted.end(), idle_buffers_, idle_buffers_.begin());
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,117 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_video/include/shared_video_frame_buffer_pool.h"
+
+#include <stdint.h>
+
+#include <limits>
+
+#include "api/scoped_refptr.h"
+#include "api/video/i420_buffer.h"
+#include "common_video/include/video_frame_buffer_pool.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kMaxBuffers = std::numeric_limits<size_t>::max();
+// Size of a 16x16 I420 buffer as accounted by the shared pool.
+constexpr size_t kBufferBytes = 16 * 16 * 3 / 2;
+
+TEST(SharedVideoFrameBufferPoolTest, SharesIdleBuffersBetweenPools) {
+  SharedVideoFrameBufferPool shared_pool(/*max_idle_bytes=*/1024 * 1024);
+  VideoFrameBufferPool pool1(/*zero_initialize=*/false, kMaxBuffers,
+                             &shared_pool);
+  VideoFrameBufferPool pool2(/*zero_initialize=*/false, kMaxBuffers,
+                             &shared_pool);
+
+  rtc::scoped_refptr<I420Buffer> buffer = pool1.CreateI420Buffer(16, 16);
+  const uint8_t* y_ptr = buffer->DataY();
+  buffer = nullptr;
+  pool1.Release();
+  EXPECT_EQ(shared_pool.GetStats().idle_buffers, 1u);
+  EXPECT_EQ(shared_pool.GetStats().idle_bytes, kBufferBytes);
+
+  buffer = pool2.CreateI420Buffer(16, 16);
+  EXPECT_EQ(buffer->DataY(), y_ptr);
+  SharedVideoFrameBufferPool::Stats stats = shared_pool.GetStats();
+  EXPECT_EQ(stats.hits, 1);
+  EXPECT_EQ(stats.misses, 1);
+  EXPECT_EQ(stats.idle_buffers, 0u);
+  EXPECT_EQ(stats.idle_bytes, 0u);
+}
+
+TEST(SharedVideoFrameBufferPoolTest, PoolHandsOtherIdleBuffersToSharedPool) {
+  SharedVideoFrameBufferPool shared_pool(/*max_idle_bytes=*/1024 * 1024);
+  VideoFrameBufferPool pool(/*zero_initialize=*/false, kMaxBuffers,
+                            &shared_pool);
+  rtc::scoped_refptr<I420Buffer> buffer1 = pool.CreateI420Buffer(16, 16);
+  rtc::scoped_refptr<I420Buffer> buffer2 = pool.CreateI420Buffer(16, 16);
+  buffer1 = nullptr;
+  buffer2 = nullptr;
+
+  // One idle buffer is reused, the other is handed to the shared pool.
+  buffer1 = pool.CreateI420Buffer(16, 16);
+  EXPECT_EQ(shared_pool.GetStats().idle_buffers, 1u);
+}
+
+TEST(SharedVideoFrameBufferPoolTest, FreesLeastRecentlyGivenBuffers) {
+  SharedVideoFrameBufferPool shared_pool(/*max_idle_bytes=*/2 * kBufferBytes);
+  VideoFrameBufferPool pool1(/*zero_initialize=*/false, kMaxBuffers,
+                             &shared_pool);
+  VideoFrameBufferPool pool2(/*zero_initialize=*/false, kMaxBuffers,
+                             &shared_pool);
+  rtc::scoped_refptr<I420Buffer> buffer1 = pool1.CreateI420Buffer(16, 16);
+  rtc::scoped_refptr<I420Buffer> buffer2 = pool1.CreateI420Buffer(16, 16);
+  rtc::scoped_refptr<I420Buffer> buffer3 = pool1.CreateI420Buffer(16, 16);
+  const uint8_t* y_ptr3 = buffer3->DataY();
+  buffer1 = nullptr;
+  buffer2 = nullptr;
+  buffer3 = nullptr;
+  pool1.Release();
+
+  SharedVideoFrameBufferPool::Stats stats = shared_pool.GetStats();
+  EXPECT_EQ(stats.evictions, 1);
+  EXPECT_EQ(stats.idle_buffers, 2u);
+  EXPECT_EQ(stats.idle_bytes, 2 * kBufferBytes);
+
+  // The most recently given buffer is handed out first.
+  EXPECT_EQ(pool2.CreateI420Buffer(16, 16)->DataY(), y_ptr3);
+
+  shared_pool.SetMaxIdleBytes(0);
+  stats = shared_pool.GetStats();
+  EXPECT_EQ(stats.evictions, 2);
+  EXPECT_EQ(stats.idle_buffers, 0u);
+}
+
+TEST(SharedVideoFrameBufferPoolTest, MatchesTypeResolutionAndInitialization) {
+  SharedVideoFrameBufferPool shared_pool(/*max_idle_bytes=*/1024 * 1024);
+  VideoFrameBufferPool pool(/*zero_initialize=*/true, kMaxBuffers,
+                            &shared_pool);
+  VideoFrameBufferPool other_pool(/*zero_initialize=*/false, kMaxBuffers,
+                                  &shared_pool);
+  pool.CreateI420Buffer(16, 16);
+  pool.Release();
+
+  // Buffers still in use are not handed to the shared pool.
+  rtc::scoped_refptr<I420Buffer> buffer1 = other_pool.CreateI420Buffer(16, 16);
+  rtc::scoped_refptr<I420Buffer> buffer2 = other_pool.CreateI420Buffer(32, 16);
+  rtc::scoped_refptr<NV12Buffer> buffer3 = other_pool.CreateNV12Buffer(16, 16);
+  SharedVideoFrameBufferPool::Stats stats = shared_pool.GetStats();
+  EXPECT_EQ(stats.hits, 0);
+  EXPECT_EQ(stats.idle_buffers, 1u);
+
+  shared_pool.Clear();
+  EXPECT_EQ(shared_pool.GetStats().idle_buffers, 0u);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -10,6 +10,9 @@
 #include "common_video/include/video_frame_buffer.h"
 
 #include "api/make_ref_counted.h"
+#include "api/video/i010_buffer.h"
+#include "api/video/i210_buffer.h"
+#include "api/video/i410_buffer.h"
 #include "api/video/i420_buffer.h"
 #include "rtc_base/checks.h"
 #include "third_party/libyuv/include/libyuv/convert.h"
@@ -198,6 +201,12 @@ class WrappedYuv16BBuffer : public Base {
 class I010BufferBase : public I010BufferInterface {
  public:
   rtc::scoped_refptr<I420BufferInterface> ToI420() final;
+  rtc::scoped_refptr<VideoFrameBuffer> CropAndScale(int offset_x,
+                                                    int offset_y,
+                                                    int crop_width,
+                                                    int crop_height,
+                                                    int scaled_width,
+                                                    int scaled_height) final;
 };
 
 rtc::scoped_refptr<I420BufferInterface> I010BufferBase::ToI420() {
@@ -211,9 +220,30 @@ rtc::scoped_refptr<I420BufferInterface> I010BufferBase::ToI420() {
   return i420_buffer;
 }
 
+// Scales in the buffer's own format rather than through I420, which would
+// lose the bit depth.
+rtc::scoped_refptr<VideoFrameBuffer> I010BufferBase::CropAndScale(
+    int offset_x,
+    int offset_y,
+    int crop_width,
+    int crop_height,
+    int scaled_width,
+    int scaled_height) {
+  rtc::scoped_refptr<I010Buffer> result =
+      I010Buffer::Create(scaled_width, scaled_height);
+  result->CropAndScaleFrom(*this, offset_x, offset_y, crop_width, crop_height);
+  return result;
+}
+
 class I210BufferBase : public I210BufferInterface {
  public:
   rtc::scoped_refptr<I420BufferInterface> ToI420() final;
+  rtc::scoped_refptr<VideoFrameBuffer> CropAndScale(int offset_x,
+                                                    int offset_y,
+                                                    int crop_width,
+                                                    int crop_height,
+                                                    int scaled_width,
+                                                    int scaled_height) final;
 };
 
 rtc::scoped_refptr<I420BufferInterface> I210BufferBase::ToI420() {
@@ -227,9 +257,28 @@ rtc::scoped_refptr<I420BufferInterface> I210BufferBase::ToI420() {
   return i420_buffer;
 }
 
+rtc::scoped_refptr<VideoFrameBuffer> I210BufferBase::CropAndScale(
+    int offset_x,
+    int offset_y,
+    int crop_width,
+    int crop_height,
+    int scaled_width,
+    int scaled_height) {
+  rtc::scoped_refptr<I210Buffer> result =
+      I210Buffer::Create(scaled_width, scaled_height);
+  result->CropAndScaleFrom(*this, offset_x, offset_y, crop_width, crop_height);
+  return result;
+}
+
 class I410BufferBase : public I410BufferInterface {
  public:
   rtc::scoped_refptr<I420BufferInterface> ToI420() final;
+  rtc::scoped_refptr<VideoFrameBuffer> CropAndScale(int offset_x,
+                                                    int offset_y,
+                                                    int crop_width,
+                                                    int crop_height,
+                                                    int scaled_width,
+                                                    int scaled_height) final;
 };
 
 rtc::scoped_refptr<I420BufferInterface> I410BufferBase::ToI420() {
@@ -243,6 +292,19 @@ rtc::scoped_refptr<I420BufferInterface> I410BufferBase::ToI420() {
   return i420_buffer;
 }
 
+rtc::scoped_refptr<VideoFrameBuffer> I410BufferBase::CropAndScale(
+    int offset_x,
+    int offset_y,
+    int crop_width,
+    int crop_height,
+    int scaled_width,
+    int scaled_height) {
+  rtc::scoped_refptr<I410Buffer> result =
+      I410Buffer::Create(scaled_width, scaled_height);
+  result->CropAndScaleFrom(*this, offset_x, offset_y, crop_width, crop_height);
+  return result;
+}
+
 }  // namespace
 
 rtc::scoped_refptr<I420BufferInterface> WrapI420Buffer(
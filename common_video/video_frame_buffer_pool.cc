@@ -11,6 +11,7 @@
 #include "common_video/include/video_frame_buffer_pool.h"
 
 #include <limits>
+#include <utility>
 
 #include "api/make_ref_counted.h"
 #include "rtc_base/checks.h"
@@ -68,12 +69,29 @@ VideoFrameBufferPool::VideoFrameBufferPool(bool zero_initialize)
 
 VideoFrameBufferPool::VideoFrameBufferPool(bool zero_initialize,
                                            size_t max_number_of_buffers)
+    : VideoFrameBufferPool(zero_initialize,
+                           max_number_of_buffers,
+                           /*shared_pool=*/nullptr) {}
+
+VideoFrameBufferPool::VideoFrameBufferPool(
+    bool zero_initialize,
+    size_t max_number_of_buffers,
+    SharedVideoFrameBufferPool* shared_pool)
     : zero_initialize_(zero_initialize),
-      max_number_of_buffers_(max_number_of_buffers) {}
+      max_number_of_buffers_(max_number_of_buffers),
+      shared_pool_(shared_pool) {}
 
-VideoFrameBufferPool::~VideoFrameBufferPool() = default;
+VideoFrameBufferPool::~VideoFrameBufferPool() {
+  Release();
+}
 
 void VideoFrameBufferPool::Release() {
+  if (shared_pool_) {
+    for (rtc::scoped_refptr<VideoFrameBuffer>& buffer : buffers_) {
+      if (HasOneRef(buffer))
+        shared_pool_->Give(std::move(buffer), zero_initialize_);
+    }
+  }
   buffers_.clear();
 }
 
@@ -98,6 +116,8 @@ bool VideoFrameBufferPool::Resize(size_t max_number_of_buffers) {
   auto iter = buffers_.begin();
   while (iter != buffers_.end() && buffers_to_purge > 0) {
     if (HasOneRef(*iter)) {
+      if (shared_pool_)
+        shared_pool_->Give(std::move(*iter), zero_initialize_);
       iter = buffers_.erase(iter);
       buffers_to_purge--;
     } else {
@@ -318,26 +338,44 @@ rtc::scoped_refptr<VideoFrameBuffer> VideoFrameBufferPool::GetExistingBuffer(
     VideoFrameBuffer::Type type) {
   // Release buffers with wrong resolution or different type.
   for (auto it = buffers_.begin(); it != buffers_.end();) {
-    const auto& buffer = *it;
+    auto& buffer = *it;
     if (buffer->width() != width || buffer->height() != height ||
         buffer->type() != type) {
+      if (shared_pool_ && HasOneRef(buffer))
+        shared_pool_->Give(std::move(buffer), zero_initialize_);
       it = buffers_.erase(it);
     } else {
       ++it;
     }
   }
-  // Look for a free buffer.
-  for (const rtc::scoped_refptr<VideoFrameBuffer>& buffer : buffers_) {
+  // Look for a free buffer. With a shared pool, the other free buffers are
+  // handed to it rather than kept idle here.
+  rtc::scoped_refptr<VideoFrameBuffer> free_buffer;
+  for (auto it = buffers_.begin(); it != buffers_.end();) {
     // If the buffer is in use, the ref count will be >= 2, one from the list we
     // are looping over and one from the application. If the ref count is 1,
     // then the list we are looping over holds the only reference and it's safe
     // to reuse.
-    if (HasOneRef(buffer)) {
-      RTC_CHECK(buffer->type() == type);
-      return buffer;
+    if (!HasOneRef(*it)) {
+      ++it;
+    } else if (!free_buffer) {
+      RTC_CHECK((*it)->type() == type);
+      free_buffer = *it;
+      ++it;
+    } else if (shared_pool_) {
+      shared_pool_->Give(std::move(*it), zero_initialize_);
+      it = buffers_.erase(it);
+    } else {
+      break;
     }
   }
-  return nullptr;
+  if (!free_buffer && shared_pool_ &&
+      buffers_.size() < max_number_of_buffers_) {
+    free_buffer = shared_pool_->Take(type, width, height, zero_initialize_);
+    if (free_buffer)
+      buffers_.push_back(free_buffer);
+  }
+  return free_buffer;
 }
 
 }  // namespace webrtc
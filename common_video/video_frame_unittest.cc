@@ -218,6 +218,19 @@ TEST(TestVideoFrame, WidthHeightValues) {
   EXPECT_EQ(789, frame.render_time_ms());
 }
 
+TEST(TestVideoFrame, UpdateRegionSetsBoundingUpdateRect) {
+  VideoFrame frame = VideoFrame::Builder()
+                         .set_video_frame_buffer(I420Buffer::Create(100, 100))
+                         .build();
+  frame.set_update_region({{0, 0, 10, 10}, {50, 60, 20, 10}});
+  EXPECT_EQ(frame.update_region().size(), 2u);
+  EXPECT_EQ(frame.update_rect(), VideoFrame::UpdateRect({0, 0, 70, 70}));
+
+  // The region is no longer known once only a bounding rect is set.
+  frame.set_update_rect({0, 0, 100, 100});
+  EXPECT_TRUE(frame.update_region().empty());
+}
+
 TEST(TestVideoFrame, ShallowCopy) {
   uint32_t timestamp = 1;
   int64_t ntp_time_ms = 2;
@@ -409,7 +422,19 @@ TYPED_TEST_P(TestPlanarYuvBufferScale, Scale) {
   CheckCrop<TypeParam>(*scaled_buffer, 0.0, 0.0, 1.0, 1.0);
 }
 
-REGISTER_TYPED_TEST_SUITE_P(TestPlanarYuvBufferScale, Scale);
+TYPED_TEST_P(TestPlanarYuvBufferScale, CropAndScaleKeepsFormat) {
+  rtc::scoped_refptr<TypeParam> buf = CreateGradient<TypeParam>(200, 100);
+
+  rtc::scoped_refptr<VideoFrameBuffer> scaled_buffer =
+      buf->CropAndScale(50, 0, 100, 100, 50, 50);
+  EXPECT_EQ(scaled_buffer->type(), buf->type());
+  EXPECT_EQ(scaled_buffer->width(), 50);
+  EXPECT_EQ(scaled_buffer->height(), 50);
+}
+
+REGISTER_TYPED_TEST_SUITE_P(TestPlanarYuvBufferScale,
+                            Scale,
+                            CropAndScaleKeepsFormat);
 
 using TestTypesScale =
     ::testing::Types<I420Buffer, I010Buffer, I210Buffer, I410Buffer>;
@@ -442,6 +467,18 @@ INSTANTIATE_TYPED_TEST_SUITE_P(Rotate,
                                TestPlanarYuvBufferRotate,
                                TestTypesRotate);
 
+TEST(TestNV12Buffer, RotatesToI420) {
+  for (webrtc::VideoRotation rotation :
+       {kVideoRotation_0, kVideoRotation_90, kVideoRotation_180,
+        kVideoRotation_270}) {
+    rtc::scoped_refptr<NV12Buffer> buffer =
+        NV12Buffer::Copy(*CreateGradient<I420Buffer>(640, 480));
+    rtc::scoped_refptr<I420Buffer> rotated_buffer =
+        I420Buffer::Rotate(*buffer, rotation);
+    CheckRotate(640, 480, rotation, *rotated_buffer);
+  }
+}
+
 TEST(TestNV12Buffer, CropAndScale) {
   const int kSourceWidth = 640;
   const int kSourceHeight = 480;
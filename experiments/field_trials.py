@@ -41,15 +41,24 @@ ACTIVE_FIELD_TRIALS: FrozenSet[FieldTrial] = frozenset([
     FieldTrial('WebRTC-Aec3PenalyzeHighDelaysInitialPhase',
                'webrtc:14919',
                date(2024, 4, 1)),
+    FieldTrial('WebRTC-Aec3PffftFft',
+               'webrtc:15368',
+               date(2025, 1, 1)),
     FieldTrial('WebRTC-Aec3PreEchoConfiguration',
                'webrtc:14205',
                date(2024, 4, 1)),
     FieldTrial('WebRTC-Audio-GainController2',
                'webrtc:7494',
                date(2024, 4, 1)),
+    FieldTrial('WebRTC-Audio-LazyNetEq',
+               'webrtc:15368',
+               date(2025, 1, 1)),
     FieldTrial('WebRTC-Audio-NetEqFecDelayAdaptation',
                'webrtc:13322',
                date(2024, 4, 1)),
+    FieldTrial('WebRTC-Audio-OpusCpuAdaptation',
+               'webrtc:15368',
+               date(2025, 1, 1)),
     FieldTrial('WebRTC-Audio-OpusSetSignalVoiceWithDtx',
                'webrtc:4559',
                date(2024, 4, 1)),
@@ -65,15 +74,33 @@ ACTIVE_FIELD_TRIALS: FrozenSet[FieldTrial] = frozenset([
     FieldTrial('WebRTC-Av1-GetEncoderInfoOverride',
                'webrtc:14931',
                date(2024, 4, 1)),
+    FieldTrial('WebRTC-BitrateAllocator-SkipUnchanged',
+               'webrtc:15368',
+               date(2025, 1, 1)),
     FieldTrial('WebRTC-BurstyPacer',
                'chromium:1354491',
                date(2024, 4, 1)),
+    FieldTrial('WebRTC-Bwe-NetworkRouteEstimateCache',
+               'webrtc:15368',
+               date(2025, 1, 1)),
     FieldTrial('WebRTC-Bwe-SubtractAdditionalBackoffTerm',
                'webrtc:13402',
                date(2024, 4, 1)),
+    FieldTrial('WebRTC-DataChannelBulkTransfer',
+               'webrtc:15368',
+               date(2025, 1, 1)),
+    FieldTrial('WebRTC-DataChannelZeroChecksum',
+               'webrtc:15368',
+               date(2025, 1, 1)),
+    FieldTrial('WebRTC-Dav1dDecoder-Threading',
+               'webrtc:15368',
+               date(2025, 1, 1)),
     FieldTrial('WebRTC-DisableRtxRateLimiter',
                'webrtc:15184',
                date(2024, 4, 1)),
+    FieldTrial('WebRTC-DnsCache',
+               'webrtc:15368',
+               date(2025, 1, 1)),
     FieldTrial('WebRTC-EncoderDataDumpDirectory',
                'b/296242528',
                date(2024, 4, 1)),
@@ -89,12 +116,18 @@ ACTIVE_FIELD_TRIALS: FrozenSet[FieldTrial] = frozenset([
     FieldTrial('WebRTC-JitterEstimatorConfig',
                'webrtc:14151',
                date(2024, 4, 1)),
+    FieldTrial('WebRTC-KernelTlsOffload',
+               'webrtc:15368',
+               date(2025, 1, 1)),
     FieldTrial('WebRTC-LibaomAv1Encoder-DisableFrameDropping',
                'webrtc:15225',
                date(2024, 4, 1)),
     FieldTrial('WebRTC-LibaomAv1Encoder-MaxConsecFrameDrop',
                'webrtc:15821',
                date(2024, 4, 1)),
+    FieldTrial('WebRTC-NsPffftFft',
+               'webrtc:15368',
+               date(2025, 1, 1)),
     FieldTrial('WebRTC-Pacer-FastRetransmissions',
                'chromium:1354491',
                date(2024, 4, 1)),
@@ -104,6 +137,9 @@ ACTIVE_FIELD_TRIALS: FrozenSet[FieldTrial] = frozenset([
     FieldTrial('WebRTC-PaddingMode-RecentLargePacket',
                'webrtc:15201',
                date(2024, 4, 1)),
+    FieldTrial('WebRTC-PerStreamCpuTime',
+               'webrtc:15368',
+               date(2025, 1, 1)),
     FieldTrial('WebRTC-PermuteTlsClientHello',
                'webrtc:15467',
                date(2024, 7, 1)),
@@ -116,6 +152,9 @@ ACTIVE_FIELD_TRIALS: FrozenSet[FieldTrial] = frozenset([
     FieldTrial('WebRTC-RtcEventLogEncodeNetEqSetMinimumDelayKillSwitch',
                'webrtc:14763',
                date(2024, 4, 1)),
+    FieldTrial('WebRTC-RtcEventLogLimits',
+               'webrtc:15368',
+               date(2025, 1, 1)),
     FieldTrial('WebRTC-SCM-Timestamp',
                'webrtc:5773',
                date(2024, 4, 1)),
@@ -128,15 +167,42 @@ ACTIVE_FIELD_TRIALS: FrozenSet[FieldTrial] = frozenset([
     FieldTrial('WebRTC-TaskQueue-ReplaceLibeventWithStdlib',
                'webrtc:14389',
                date(2024, 4, 1)),
+    FieldTrial('WebRTC-UdpBatchedReceive',
+               'webrtc:15368',
+               date(2025, 1, 1)),
+    FieldTrial('WebRTC-Video-CaptureNV12',
+               'webrtc:15368',
+               date(2025, 1, 1)),
+    FieldTrial('WebRTC-Video-DecoderPool',
+               'webrtc:15368',
+               date(2025, 1, 1)),
+    FieldTrial('WebRTC-Video-DecodeThreadPool',
+               'webrtc:15368',
+               date(2025, 1, 1)),
     FieldTrial('WebRTC-Video-EnableRetransmitAllLayers',
                'webrtc:14959',
                date(2024, 4, 1)),
     FieldTrial('WebRTC-Video-EncoderFallbackSettings',
                'webrtc:6634',
                date(2024, 4, 1)),
+    FieldTrial('WebRTC-Video-KeyframeCache',
+               'webrtc:15368',
+               date(2025, 1, 1)),
     FieldTrial('WebRTC-Video-RequestedResolutionOverrideOutputFormatRequest',
                'webrtc:14451',
                date(2024, 4, 1)),
+    FieldTrial('WebRTC-Video-SharedFrameBufferPool',
+               'webrtc:15368',
+               date(2025, 1, 1)),
+    FieldTrial('WebRTC-Video-SimulcastParallelEncode',
+               'webrtc:15368',
+               date(2025, 1, 1)),
+    FieldTrial('WebRTC-Video-UltraLowLatencyPlayout',
+               'webrtc:15368',
+               date(2025, 1, 1)),
+    FieldTrial('WebRTC-Video-VaapiDecoder',
+               'webrtc:15368',
+               date(2025, 1, 1)),
     FieldTrial('WebRTC-VideoEncoderSettings',
                'chromium:1406331',
                date(2024, 4, 1)),
@@ -388,6 +454,9 @@ POLICY_EXEMPT_FIELD_TRIALS: FrozenSet[FieldTrial] = frozenset([
     FieldTrial('WebRTC-Agc2SimdAvx2KillSwitch',
                'webrtc:7494',
                date(2024, 4, 1)),
+    FieldTrial('WebRTC-Agc2SimdAvx512KillSwitch',
+               'webrtc:7494',
+               date(2024, 4, 1)),
     FieldTrial('WebRTC-Agc2SimdNeonKillSwitch',
                'webrtc:7494',
                date(2024, 4, 1)),
@@ -571,6 +640,9 @@ POLICY_EXEMPT_FIELD_TRIALS: FrozenSet[FieldTrial] = frozenset([
     FieldTrial('WebRTC-CpuLoadEstimator',
                'webrtc:8504',
                date(2024, 4, 1)),
+    FieldTrial('WebRTC-CpuOveruse-ThreadCpuTime',
+               'webrtc:15368',
+               date(2025, 1, 1)),
     FieldTrial('WebRTC-Debugging-RtpDump',
                'webrtc:10675',
                INDEFINITE),
@@ -711,7 +711,7 @@ std::string RtcEventLogEncoderLegacy::EncodeVideoSendStreamConfig(
 
 std::string RtcEventLogEncoderLegacy::EncodeRtcpPacket(
     int64_t timestamp_us,
-    const rtc::Buffer& packet,
+    rtc::ArrayView<const uint8_t> packet,
     bool is_incoming) {
   rtclog::Event rtclog_event;
   rtclog_event.set_timestamp_us(timestamp_us);
@@ -291,7 +291,7 @@ rtclog2::IceCandidatePairEvent::IceCandidatePairEventType ConvertToProtoFormat(
 
 // Copies all RTCP blocks except APP, SDES and unknown from `packet` to
 // `buffer`. `buffer` must have space for at least `packet.size()` bytes.
-size_t RemoveNonAllowlistedRtcpBlocks(const rtc::Buffer& packet,
+size_t RemoveNonAllowlistedRtcpBlocks(rtc::ArrayView<const uint8_t> packet,
                                       uint8_t* buffer) {
   RTC_DCHECK(buffer != nullptr);
   rtcp::CommonHeader header;
@@ -10,6 +10,8 @@
 
 #include "logging/rtc_event_log/events/rtc_event_rtcp_packet_incoming.h"
 
+#include <utility>
+
 #include "absl/memory/memory.h"
 
 namespace webrtc {
@@ -18,10 +20,13 @@ RtcEventRtcpPacketIncoming::RtcEventRtcpPacketIncoming(
     rtc::ArrayView<const uint8_t> packet)
     : packet_(packet.data(), packet.size()) {}
 
+RtcEventRtcpPacketIncoming::RtcEventRtcpPacketIncoming(
+    rtc::CopyOnWriteBuffer packet)
+    : packet_(std::move(packet)) {}
+
 RtcEventRtcpPacketIncoming::RtcEventRtcpPacketIncoming(
     const RtcEventRtcpPacketIncoming& other)
-    : RtcEvent(other.timestamp_us_),
-      packet_(other.packet_.data(), other.packet_.size()) {}
+    : RtcEvent(other.timestamp_us_), packet_(other.packet_) {}
 
 RtcEventRtcpPacketIncoming::~RtcEventRtcpPacketIncoming() = default;
 
@@ -10,6 +10,8 @@
 
 #include "logging/rtc_event_log/events/rtc_event_rtcp_packet_outgoing.h"
 
+#include <utility>
+
 #include "absl/memory/memory.h"
 
 namespace webrtc {
@@ -18,10 +20,13 @@ RtcEventRtcpPacketOutgoing::RtcEventRtcpPacketOutgoing(
     rtc::ArrayView<const uint8_t> packet)
     : packet_(packet.data(), packet.size()) {}
 
+RtcEventRtcpPacketOutgoing::RtcEventRtcpPacketOutgoing(
+    rtc::CopyOnWriteBuffer packet)
+    : packet_(std::move(packet)) {}
+
 RtcEventRtcpPacketOutgoing::RtcEventRtcpPacketOutgoing(
     const RtcEventRtcpPacketOutgoing& other)
-    : RtcEvent(other.timestamp_us_),
-      packet_(other.packet_.data(), other.packet_.size()) {}
+    : RtcEvent(other.timestamp_us_), packet_(other.packet_) {}
 
 RtcEventRtcpPacketOutgoing::~RtcEventRtcpPacketOutgoing() = default;
 
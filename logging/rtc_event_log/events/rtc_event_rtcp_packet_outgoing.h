@@ -22,7 +22,7 @@
 #include "api/rtc_event_log/rtc_event.h"
 #include "logging/rtc_event_log/events/logged_rtp_rtcp.h"
 #include "logging/rtc_event_log/events/rtc_event_field_encoding_parser.h"
-#include "rtc_base/buffer.h"
+#include "rtc_base/copy_on_write_buffer.h"
 
 namespace webrtc {
 
@@ -31,6 +31,8 @@ class RtcEventRtcpPacketOutgoing final : public RtcEvent {
   static constexpr Type kType = Type::RtcpPacketOutgoing;
 
   explicit RtcEventRtcpPacketOutgoing(rtc::ArrayView<const uint8_t> packet);
+  // Shares the buffer with `packet`, rather than copying it.
+  explicit RtcEventRtcpPacketOutgoing(rtc::CopyOnWriteBuffer packet);
   ~RtcEventRtcpPacketOutgoing() override;
 
   Type GetType() const override { return kType; }
@@ -38,7 +40,7 @@ class RtcEventRtcpPacketOutgoing final : public RtcEvent {
 
   std::unique_ptr<RtcEventRtcpPacketOutgoing> Copy() const;
 
-  const rtc::Buffer& packet() const { return packet_; }
+  const rtc::CopyOnWriteBuffer& packet() const { return packet_; }
 
   static std::string Encode(rtc::ArrayView<const RtcEvent*> batch) {
     // TODO(terelius): Implement
@@ -56,7 +58,7 @@ class RtcEventRtcpPacketOutgoing final : public RtcEvent {
  private:
   RtcEventRtcpPacketOutgoing(const RtcEventRtcpPacketOutgoing& other);
 
-  rtc::Buffer packet_;
+  const rtc::CopyOnWriteBuffer packet_;
 };
 
 }  // namespace webrtc
@@ -65,6 +65,11 @@ ABSL_FLAG(std::string,
           "",
           "Store only packets with this SSRC (decimal or hex, the latter "
           "starting with 0x).");
+ABSL_FLAG(bool,
+          indexed,
+          false,
+          "Write the indexed rtpdump format, which can be filtered by SSRC "
+          "and seeked in without reading the whole file.");
 
 namespace {
 
@@ -196,7 +201,10 @@ int main(int argc, char* argv[]) {
 
   std::unique_ptr<webrtc::test::RtpFileWriter> rtp_writer(
       webrtc::test::RtpFileWriter::Create(
-          webrtc::test::RtpFileWriter::FileFormat::kRtpDump, output_file));
+          absl::GetFlag(FLAGS_indexed)
+              ? webrtc::test::RtpFileWriter::FileFormat::kIndexedRtpDump
+              : webrtc::test::RtpFileWriter::FileFormat::kRtpDump,
+          output_file));
 
   if (!rtp_writer) {
     std::cerr << "Error while opening output file: " << output_file
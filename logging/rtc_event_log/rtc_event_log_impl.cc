@@ -10,6 +10,7 @@
 
 #include "logging/rtc_event_log/rtc_event_log_impl.h"
 
+#include <algorithm>
 #include <functional>
 #include <limits>
 #include <memory>
@@ -25,6 +26,7 @@
 #include "logging/rtc_event_log/encoder/rtc_event_log_encoder_new_format.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/event.h"
+#include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/numerics/safe_conversions.h"
 #include "rtc_base/numerics/safe_minmax.h"
@@ -43,17 +45,37 @@ std::unique_ptr<RtcEventLogEncoder> CreateEncoder(const Environment& env) {
   }
 }
 
+RtcEventLogLimits ParseLimits(const FieldTrialsView& field_trials) {
+  FieldTrialParameter<int> max_pending_events("max_pending_events", 0);
+  FieldTrialParameter<int> max_events_per_type_per_second(
+      "max_events_per_type_per_second", 0);
+  ParseFieldTrial({&max_pending_events, &max_events_per_type_per_second},
+                  field_trials.Lookup("WebRTC-RtcEventLogLimits"));
+  RtcEventLogLimits limits;
+  limits.max_pending_events =
+      static_cast<size_t>(std::max(0, max_pending_events.Get()));
+  limits.max_events_per_type_per_second =
+      std::max(0, max_events_per_type_per_second.Get());
+  return limits;
+}
+
 }  // namespace
 
 RtcEventLogImpl::RtcEventLogImpl(const Environment& env)
-    : RtcEventLogImpl(CreateEncoder(env), &env.task_queue_factory()) {}
+    : RtcEventLogImpl(CreateEncoder(env),
+                      &env.task_queue_factory(),
+                      kMaxEventsInHistory,
+                      kMaxEventsInConfigHistory,
+                      ParseLimits(env.field_trials())) {}
 
 RtcEventLogImpl::RtcEventLogImpl(std::unique_ptr<RtcEventLogEncoder> encoder,
                                  TaskQueueFactory* task_queue_factory,
                                  size_t max_events_in_history,
-                                 size_t max_config_events_in_history)
+                                 size_t max_config_events_in_history,
+                                 RtcEventLogLimits limits)
     : max_events_in_history_(max_events_in_history),
       max_config_events_in_history_(max_config_events_in_history),
+      limits_(limits),
       event_encoder_(std::move(encoder)),
       last_output_ms_(rtc::TimeMillis()),
       task_queue_(task_queue_factory->CreateTaskQueue(
@@ -157,6 +179,8 @@ void RtcEventLogImpl::StopLogging(std::function<void()> callback) {
         if (event_output_) {
           RTC_DCHECK(event_output_->IsActive());
           LogEventsToOutput(std::move(histories));
+        } else {
+          OnHistoriesProcessed(histories);
         }
         StopLoggingInternal();
         callback();
@@ -166,13 +190,65 @@ void RtcEventLogImpl::StopLogging(std::function<void()> callback) {
 RtcEventLogImpl::EventHistories RtcEventLogImpl::ExtractRecentHistories() {
   EventHistories histories;
   std::swap(histories, recent_);
+  pending_events_ += histories.history.size();
   return histories;
 }
 
+void RtcEventLogImpl::OnHistoriesProcessed(const EventHistories& histories) {
+  MutexLock lock(&mutex_);
+  RTC_DCHECK_GE(pending_events_, histories.history.size());
+  pending_events_ -= histories.history.size();
+  if (sampled_events_ > 0 || dropped_events_ > 0) {
+    RTC_LOG(LS_WARNING) << "Event log limits exceeded, sampled away "
+                        << sampled_events_ << " and dropped "
+                        << dropped_events_ << " events.";
+    sampled_events_ = 0;
+    dropped_events_ = 0;
+  }
+}
+
+bool RtcEventLogImpl::ExceedsLimits(const RtcEvent& event) {
+  if (event.IsConfigEvent()) {
+    return false;
+  }
+
+  if (limits_.max_pending_events > 0 && logging_state_started_) {
+    size_t pending_events = pending_events_ + recent_.history.size();
+    if (pending_events >= 2 * limits_.max_pending_events) {
+      ++dropped_events_;
+      return true;
+    }
+    // Sampling keeps some events of all kinds, while the encoder catches up.
+    if (pending_events >= limits_.max_pending_events &&
+        ++sampling_counter_ % kOverBudgetSamplingInterval != 0) {
+      ++sampled_events_;
+      return true;
+    }
+  }
+
+  if (limits_.max_events_per_type_per_second > 0) {
+    RateWindow& window = rate_windows_[event.GetType()];
+    const int64_t now_ms = event.timestamp_ms();
+    if (window.count == 0 || now_ms - window.start_ms >= 1000) {
+      window.start_ms = now_ms;
+      window.count = 0;
+    }
+    if (window.count >= limits_.max_events_per_type_per_second) {
+      ++dropped_events_;
+      return true;
+    }
+    ++window.count;
+  }
+  return false;
+}
+
 void RtcEventLogImpl::Log(std::unique_ptr<RtcEvent> event) {
   RTC_CHECK(event);
   MutexLock lock(&mutex_);
 
+  if (ExceedsLimits(*event)) {
+    return;
+  }
   LogToMemory(std::move(event));
   if (logging_state_started_) {
     if (ShouldOutputImmediately()) {
@@ -183,6 +259,8 @@ void RtcEventLogImpl::Log(std::unique_ptr<RtcEvent> event) {
             if (event_output_) {
               RTC_DCHECK(event_output_->IsActive());
               LogEventsToOutput(std::move(histories));
+            } else {
+              OnHistoriesProcessed(histories);
             }
           });
     } else if (need_schedule_output_) {
@@ -264,6 +342,7 @@ void RtcEventLogImpl::LogEventsToOutput(EventHistories histories) {
   // log; one batch of events might be missing.
   std::string encoded_history = event_encoder_->EncodeBatch(
       histories.history.begin(), histories.history.end());
+  OnHistoriesProcessed(histories);
 
   WriteConfigsAndHistoryToOutput(encoded_configs, encoded_history);
 
@@ -26,11 +26,23 @@
 #include "api/task_queue/task_queue_base.h"
 #include "api/task_queue/task_queue_factory.h"
 #include "logging/rtc_event_log/encoder/rtc_event_log_encoder.h"
+#include "rtc_base/containers/flat_map.h"
 #include "rtc_base/system/no_unique_address.h"
 #include "rtc_base/thread_annotations.h"
 
 namespace webrtc {
 
+// Bounds the cost of logging long calls with all events enabled. Config
+// events are never dropped, as they are needed to interpret other events.
+// Zero means no limit.
+struct RtcEventLogLimits {
+  // The max number of events that are waiting to be encoded and written.
+  // Over it, events are sampled, and over twice that, they are dropped.
+  size_t max_pending_events = 0;
+  // The max number of events of each type that are logged per second.
+  int max_events_per_type_per_second = 0;
+};
+
 class RtcEventLogImpl final : public RtcEventLog {
  public:
   // The max number of events that the history can store.
@@ -39,13 +51,16 @@ class RtcEventLogImpl final : public RtcEventLog {
   // The config-history is supposed to be unbounded, but needs to have some
   // bound to prevent an attack via unreasonable memory use.
   static constexpr size_t kMaxEventsInConfigHistory = 1000;
+  // When over the pending events budget, one in this many events is kept.
+  static constexpr size_t kOverBudgetSamplingInterval = 10;
 
   explicit RtcEventLogImpl(const Environment& env);
   RtcEventLogImpl(
       std::unique_ptr<RtcEventLogEncoder> encoder,
       TaskQueueFactory* task_queue_factory,
       size_t max_events_in_history = kMaxEventsInHistory,
-      size_t max_config_events_in_history = kMaxEventsInConfigHistory);
+      size_t max_config_events_in_history = kMaxEventsInConfigHistory,
+      RtcEventLogLimits limits = RtcEventLogLimits());
   RtcEventLogImpl(const RtcEventLogImpl&) = delete;
   RtcEventLogImpl& operator=(const RtcEventLogImpl&) = delete;
 
@@ -70,8 +85,20 @@ class RtcEventLogImpl final : public RtcEventLog {
     EventDeque history;
   };
 
-  // Helper to extract and clear `recent_`.
+  // Events of one type logged during the current one second window.
+  struct RateWindow {
+    int64_t start_ms = 0;
+    int count = 0;
+  };
+
+  // Helper to extract and clear `recent_`. The extracted events are counted
+  // as pending until `OnHistoriesProcessed` is called.
   EventHistories ExtractRecentHistories() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  void OnHistoriesProcessed(const EventHistories& histories)
+      RTC_LOCKS_EXCLUDED(mutex_);
+  // Returns true if `event` should be dropped to respect `limits_`.
+  bool ExceedsLimits(const RtcEvent& event)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
   void LogToMemory(std::unique_ptr<RtcEvent> event)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
   void LogEventsToOutput(EventHistories histories) RTC_RUN_ON(task_queue_);
@@ -94,6 +121,8 @@ class RtcEventLogImpl final : public RtcEventLog {
   // Max size of config event history.
   const size_t max_config_events_in_history_;
 
+  const RtcEventLogLimits limits_;
+
   // History containing all past configuration events.
   EventDeque all_config_history_ RTC_GUARDED_BY(task_queue_);
 
@@ -113,6 +142,14 @@ class RtcEventLogImpl final : public RtcEventLog {
   bool immediately_output_mode_ RTC_GUARDED_BY(mutex_) = false;
   bool need_schedule_output_ RTC_GUARDED_BY(mutex_) = false;
 
+  // Events that have been extracted from `recent_`, but not yet processed on
+  // the `task_queue_`.
+  size_t pending_events_ RTC_GUARDED_BY(mutex_) = 0;
+  size_t sampling_counter_ RTC_GUARDED_BY(mutex_) = 0;
+  size_t sampled_events_ RTC_GUARDED_BY(mutex_) = 0;
+  size_t dropped_events_ RTC_GUARDED_BY(mutex_) = 0;
+  flat_map<RtcEvent::Type, RateWindow> rate_windows_ RTC_GUARDED_BY(mutex_);
+
   std::unique_ptr<TaskQueueBase, TaskQueueDeleter> task_queue_;
 
   Mutex mutex_;
@@ -293,5 +293,86 @@ TEST_F(RtcEventLogImplTest, StopOutputOnWriteFailure) {
   Mock::VerifyAndClearExpectations(encoder_ptr_);
 }
 
+class RtcEventLogImplLimitsTest : public ::testing::Test {
+ public:
+  static constexpr size_t kMaxEventsInHistory = 1000;
+  static constexpr TimeDelta kOutputPeriod = TimeDelta::Seconds(2);
+
+  std::unique_ptr<RtcEventLogImpl> CreateEventLog(
+      RtcEventLogLimits limits) {
+    auto encoder = std::make_unique<MockEventEncoder>();
+    encoder_ptr_ = encoder.get();
+    return std::make_unique<RtcEventLogImpl>(
+        std::move(encoder), time_controller_.GetTaskQueueFactory(),
+        kMaxEventsInHistory, RtcEventLogImpl::kMaxEventsInConfigHistory,
+        limits);
+  }
+
+  GlobalSimulatedTimeController time_controller_{Timestamp::Seconds(1)};
+  std::string written_data_;  // This must be destroyed after the event log.
+  MockEventEncoder* encoder_ptr_ = nullptr;
+};
+
+TEST_F(RtcEventLogImplLimitsTest, SamplesAndDropsEventsOverPendingBudget) {
+  constexpr size_t kMaxPendingEvents = 10;
+  std::unique_ptr<RtcEventLogImpl> event_log =
+      CreateEventLog({.max_pending_events = kMaxPendingEvents});
+  event_log->StartLogging(std::make_unique<FakeOutput>(written_data_),
+                          kOutputPeriod.ms());
+
+  event_log->Log(std::make_unique<FakeConfigEvent>());
+  // All events are kept until the budget is reached, then one in
+  // `kOverBudgetSamplingInterval`, and none at twice the budget.
+  constexpr size_t kSampledEvents =
+      kMaxPendingEvents * RtcEventLogImpl::kOverBudgetSamplingInterval;
+  for (size_t i = 0; i < kMaxPendingEvents + kSampledEvents + 10; ++i) {
+    event_log->Log(std::make_unique<FakeEvent>());
+  }
+  EXPECT_CALL(*encoder_ptr_,
+              OnEncode(Property(&RtcEvent::IsConfigEvent, true)));
+  EXPECT_CALL(*encoder_ptr_,
+              OnEncode(Property(&RtcEvent::IsConfigEvent, false)))
+      .Times(2 * kMaxPendingEvents);
+  time_controller_.AdvanceTime(kOutputPeriod);
+  Mock::VerifyAndClearExpectations(encoder_ptr_);
+
+  // Once written, the events no longer count against the budget.
+  for (size_t i = 0; i < kMaxPendingEvents; ++i) {
+    event_log->Log(std::make_unique<FakeEvent>());
+  }
+  EXPECT_CALL(*encoder_ptr_,
+              OnEncode(Property(&RtcEvent::IsConfigEvent, false)))
+      .Times(kMaxPendingEvents);
+  time_controller_.AdvanceTime(kOutputPeriod);
+  Mock::VerifyAndClearExpectations(encoder_ptr_);
+  event_log->StopLogging();
+}
+
+TEST_F(RtcEventLogImplLimitsTest, LimitsEventsPerTypePerSecond) {
+  std::unique_ptr<RtcEventLogImpl> event_log =
+      CreateEventLog({.max_events_per_type_per_second = 2});
+  event_log->StartLogging(std::make_unique<FakeOutput>(written_data_),
+                          kOutputPeriod.ms());
+
+  for (int i = 0; i < 5; ++i) {
+    event_log->Log(std::make_unique<FakeEvent>());
+    // Config events are never dropped.
+    event_log->Log(std::make_unique<FakeConfigEvent>());
+  }
+  time_controller_.AdvanceTime(TimeDelta::Seconds(1));
+  for (int i = 0; i < 5; ++i) {
+    event_log->Log(std::make_unique<FakeEvent>());
+  }
+  EXPECT_CALL(*encoder_ptr_,
+              OnEncode(Property(&RtcEvent::IsConfigEvent, true)))
+      .Times(5);
+  EXPECT_CALL(*encoder_ptr_,
+              OnEncode(Property(&RtcEvent::IsConfigEvent, false)))
+      .Times(4);
+  time_controller_.AdvanceTime(kOutputPeriod);
+  Mock::VerifyAndClearExpectations(encoder_ptr_);
+  event_log->StopLogging();
+}
+
 }  // namespace
 }  // namespace webrtc
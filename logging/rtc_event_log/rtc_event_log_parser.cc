@@ -13,6 +13,13 @@
 #include <stdint.h>
 #include <string.h>
 
+#if defined(WEBRTC_POSIX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #include <algorithm>
 #include <limits>
 #include <map>
@@ -1125,6 +1132,44 @@ void ParsedRtcEventLog::Clear() {
 
 ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::ParseFile(
     absl::string_view filename) {
+#if defined(WEBRTC_POSIX)
+  // Map the file rather than copying it, so that the pages of a large log can
+  // be dropped by the kernel once they have been parsed.
+  const std::string filename_str(filename);
+  int fd = open(filename_str.c_str(), O_RDONLY);
+  if (fd < 0) {
+    RTC_LOG(LS_WARNING) << "Could not open file " << filename
+                        << " for reading.";
+    RTC_PARSE_CHECK_OR_RETURN_GE(fd, 0);
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0) {
+    close(fd);
+    return ParseStatus::Error("Failed to get file size", __FILE__, __LINE__);
+  }
+  if (file_stat.st_size < 0 || file_stat.st_size > kMaxLogSize) {
+    close(fd);
+    RTC_PARSE_CHECK_OR_RETURN_GE(file_stat.st_size, 0);
+    RTC_PARSE_CHECK_OR_RETURN_LE(file_stat.st_size, kMaxLogSize);
+  }
+  size_t filesize = rtc::checked_cast<size_t>(file_stat.st_size);
+  if (filesize == 0) {
+    close(fd);
+    return ParseStream(absl::string_view());
+  }
+
+  void* data = mmap(nullptr, filesize, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    RTC_LOG(LS_WARNING) << "Failed to map file " << filename;
+    return ParseStatus::Error("Failed to map file", __FILE__, __LINE__);
+  }
+  madvise(data, filesize, MADV_SEQUENTIAL);
+  ParseStatus status =
+      ParseStream(absl::string_view(static_cast<const char*>(data), filesize));
+  munmap(data, filesize);
+  return status;
+#else
   FileWrapper file = FileWrapper::OpenReadOnly(filename);
   if (!file.is_open()) {
     RTC_LOG(LS_WARNING) << "Could not open file " << filename
@@ -1147,6 +1192,7 @@ ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::ParseFile(
   }
 
   return ParseStream(buffer);
+#endif
 }
 
 ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::ParseString(
@@ -1389,6 +1435,10 @@ ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::ParseStreamInternal(
     size_t total_event_size = event_start.size() - s.size();
     RTC_CHECK_LE(total_event_size, event_start.size());
 
+    if (SkipNewFormatEvent(tag)) {
+      continue;
+    }
+
     if (tag == kExpectedV1Tag) {
       // Parse the protobuf event from the buffer.
       rtclog::EventStream event_stream;
@@ -1419,6 +1469,37 @@ ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::ParseStreamInternal(
   return ParseStatus::Success();
 }
 
+bool ParsedRtcEventLog::SkipNewFormatEvent(uint64_t tag) const {
+  // Field numbers of the packet events in rtclog2::EventStream.
+  constexpr uint64_t kIncomingRtpPackets = 2;
+  constexpr uint64_t kOutgoingRtpPackets = 3;
+  constexpr uint64_t kIncomingRtcpPackets = 4;
+  constexpr uint64_t kOutgoingRtcpPackets = 5;
+  const uint64_t field_number = tag >> 3;
+  if (field_number == kIncomingRtpPackets ||
+      field_number == kOutgoingRtpPackets) {
+    return !parse_rtp_packets_;
+  }
+  if (field_number == kIncomingRtcpPackets ||
+      field_number == kOutgoingRtcpPackets) {
+    return !parse_rtcp_packets_;
+  }
+  return false;
+}
+
+bool ParsedRtcEventLog::SkipV3Event(uint64_t event_type) const {
+  switch (event_type) {
+    case static_cast<uint32_t>(RtcEvent::Type::RtpPacketIncoming):
+    case static_cast<uint32_t>(RtcEvent::Type::RtpPacketOutgoing):
+      return !parse_rtp_packets_;
+    case static_cast<uint32_t>(RtcEvent::Type::RtcpPacketIncoming):
+    case static_cast<uint32_t>(RtcEvent::Type::RtcpPacketOutgoing):
+      return !parse_rtcp_packets_;
+    default:
+      return false;
+  }
+}
+
 ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::ParseStreamInternalV3(
     absl::string_view s) {
   constexpr uint64_t kMaxEventSize = 10000000;  // Sanity check.
@@ -1453,6 +1534,10 @@ ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::ParseStreamInternalV3(
       expect_begin_log_event = false;
     }
 
+    if (SkipV3Event(event_type)) {
+      continue;
+    }
+
     switch (event_type) {
       case static_cast<uint32_t>(RtcEvent::Type::BeginV3Log):
         RtcEventBeginLog::Parse(event_fields, batched, start_log_events_);
@@ -1636,6 +1721,9 @@ ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::StoreParsedLegacyEvent(
       break;
     }
     case rtclog::Event::RTP_EVENT: {
+      if (!parse_rtp_packets_) {
+        break;
+      }
       RTC_PARSE_CHECK_OR_RETURN(event.has_rtp_packet());
       const rtclog::RtpPacket& rtp_packet = event.rtp_packet();
       RTC_PARSE_CHECK_OR_RETURN(rtp_packet.has_header());
@@ -1681,6 +1769,9 @@ ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::StoreParsedLegacyEvent(
       break;
     }
     case rtclog::Event::RTCP_EVENT: {
+      if (!parse_rtcp_packets_) {
+        break;
+      }
       PacketDirection direction;
       std::vector<uint8_t> packet;
       auto status = GetRtcpPacket(event, &direction, &packet);
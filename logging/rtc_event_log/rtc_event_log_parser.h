@@ -386,7 +386,16 @@ class ParsedRtcEventLog {
   // empty state.
   void Clear();
 
+  // Selects whether RTP and RTCP packet events are parsed. These make up most
+  // of a typical log, so skipping them saves both time and memory when only
+  // e.g. bandwidth estimation or audio events are needed. For all but the
+  // legacy format, skipped events are not decoded at all. Takes effect on the
+  // next call to one of the Parse functions.
+  void set_parse_rtp_packets(bool parse) { parse_rtp_packets_ = parse; }
+  void set_parse_rtcp_packets(bool parse) { parse_rtcp_packets_ = parse; }
+
   // Reads an RtcEventLog file and returns success if parsing was successful.
+  // Where supported, the file is memory mapped rather than read into memory.
   ParseStatus ParseFile(absl::string_view file_name);
 
   // Reads an RtcEventLog from a string and returns success if successful.
@@ -677,6 +686,11 @@ class ParsedRtcEventLog {
   ABSL_MUST_USE_RESULT ParseStatus ParseStreamInternal(absl::string_view s);
   ABSL_MUST_USE_RESULT ParseStatus ParseStreamInternalV3(absl::string_view s);
 
+  // Return true if the event with the given protobuf field `tag`, or the given
+  // V3 `event_type`, has been filtered out and should not be decoded.
+  bool SkipNewFormatEvent(uint64_t tag) const;
+  bool SkipV3Event(uint64_t event_type) const;
+
   ABSL_MUST_USE_RESULT ParseStatus
   StoreParsedLegacyEvent(const rtclog::Event& event);
 
@@ -806,6 +820,8 @@ class ParsedRtcEventLog {
 
   const UnconfiguredHeaderExtensions parse_unconfigured_header_extensions_;
   const bool allow_incomplete_logs_;
+  bool parse_rtp_packets_ = true;
+  bool parse_rtcp_packets_ = true;
 
   // Make a default extension map for streams without configuration information.
   // TODO(ivoc): Once configuration of audio streams is stored in the event log,
@@ -905,6 +905,35 @@ TEST_P(RtcEventLogSession, StartLoggingInTheMiddle) {
   ReadAndVerifyLog();
 }
 
+TEST_P(RtcEventLogSession, SkipsFilteredPacketEvents) {
+  EventCounts count;
+  count.audio_send_streams = 1;
+  count.video_recv_streams = 1;
+  count.bwe_loss_events = 20;
+  count.bwe_delay_events = 20;
+  count.incoming_rtp_packets = 100;
+  count.outgoing_rtp_packets = 100;
+  count.incoming_rtcp_packets = 20;
+  count.outgoing_rtcp_packets = 20;
+  WriteLog(count, 0);
+
+  auto it = log_storage_.logs().find(temp_filename_);
+  ASSERT_TRUE(it != log_storage_.logs().end());
+  ParsedRtcEventLog parsed_log;
+  parsed_log.set_parse_rtp_packets(false);
+  parsed_log.set_parse_rtcp_packets(false);
+  ASSERT_TRUE(parsed_log.ParseString(it->second).ok());
+
+  EXPECT_TRUE(parsed_log.incoming_rtp_packets_by_ssrc().empty());
+  EXPECT_TRUE(parsed_log.outgoing_rtp_packets_by_ssrc().empty());
+  EXPECT_TRUE(parsed_log.incoming_rtcp_packets().empty());
+  EXPECT_TRUE(parsed_log.outgoing_rtcp_packets().empty());
+  EXPECT_EQ(parsed_log.bwe_loss_updates().size(), bwe_loss_list_.size());
+  EXPECT_EQ(parsed_log.bwe_delay_updates().size(), bwe_delay_list_.size());
+  EXPECT_EQ(parsed_log.audio_send_configs().size(), 1u);
+  EXPECT_EQ(parsed_log.video_recv_configs().size(), 1u);
+}
+
 INSTANTIATE_TEST_SUITE_P(
     RtcEventLogTest,
     RtcEventLogSession,
@@ -10,11 +10,6 @@
 
 #include "media/base/adapted_video_track_source.h"
 
-#include "api/scoped_refptr.h"
-#include "api/video/i420_buffer.h"
-#include "api/video/video_frame_buffer.h"
-#include "api/video/video_rotation.h"
-#include "rtc_base/checks.h"
 #include "rtc_base/time_utils.h"
 
 namespace rtc {
@@ -38,27 +33,9 @@ bool AdaptedVideoTrackSource::GetStats(Stats* stats) {
 }
 
 void AdaptedVideoTrackSource::OnFrame(const webrtc::VideoFrame& frame) {
-  rtc::scoped_refptr<webrtc::VideoFrameBuffer> buffer(
-      frame.video_frame_buffer());
-  /* Note that this is a "best effort" approach to
-     wants.rotation_applied; apply_rotation_ can change from false to
-     true between the check of apply_rotation() and the call to
-     broadcaster_.OnFrame(), in which case we generate a frame with
-     pending rotation despite some sink with wants.rotation_applied ==
-     true was just added. The VideoBroadcaster enforces
-     synchronization for us in this case, by not passing the frame on
-     to sinks which don't want it. */
-  if (apply_rotation() && frame.rotation() != webrtc::kVideoRotation_0 &&
-      buffer->type() == webrtc::VideoFrameBuffer::Type::kI420) {
-    /* Apply pending rotation. */
-    webrtc::VideoFrame rotated_frame(frame);
-    rotated_frame.set_video_frame_buffer(
-        webrtc::I420Buffer::Rotate(*buffer->GetI420(), frame.rotation()));
-    rotated_frame.set_rotation(webrtc::kVideoRotation_0);
-    broadcaster_.OnFrame(rotated_frame);
-  } else {
-    broadcaster_.OnFrame(frame);
-  }
+  // The VideoBroadcaster applies pending rotation for the sinks that want
+  // rotation_applied.
+  broadcaster_.OnFrame(frame);
 }
 
 void AdaptedVideoTrackSource::OnFrameDropped() {
@@ -113,6 +90,12 @@ bool AdaptedVideoTrackSource::AdaptFrame(int width,
     return false;
   }
 
+  if (!broadcaster_.WantsFrame(time_us)) {
+    // All sinks would drop the frame, skip cropping and scaling it.
+    broadcaster_.OnDiscardedFrame();
+    return false;
+  }
+
   *crop_x = (width - *crop_width) / 2;
   *crop_y = (height - *crop_height) / 2;
   return true;
@@ -41,8 +41,9 @@ class RTC_EXPORT AdaptedVideoTrackSource
   // Allows derived classes to initialize `video_adapter_` with a custom
   // alignment.
   explicit AdaptedVideoTrackSource(int required_alignment);
-  // Checks the apply_rotation() flag. If the frame needs rotation, and it is a
-  // plain memory frame, it is rotated. Subclasses producing native frames must
+  // Delivers the frame to the sinks. Pending rotation is applied for the sinks
+  // with wants.rotation_applied, which requires that the buffer can be
+  // converted to I420. Subclasses producing native frames that can't must
   // handle apply_rotation() themselves.
   void OnFrame(const webrtc::VideoFrame& frame);
   // Indication from source that a frame was dropped.
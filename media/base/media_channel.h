@@ -551,6 +551,8 @@ struct VoiceReceiverInfo : public MediaReceiverInfo {
   // longer than 150 ms).
   int32_t interruption_count = 0;
   int32_t total_interruption_duration_ms = 0;
+  // Thread CPU time spent in NetEq producing audio for playout.
+  absl::optional<webrtc::TimeDelta> total_decode_cpu_time;
   // Remote outbound stats derived by the received RTCP sender reports.
   // https://w3c.github.io/webrtc-stats/#remoteoutboundrtpstats-dict*
   absl::optional<int64_t> last_sender_report_timestamp_ms;
@@ -595,6 +597,8 @@ struct VideoSenderInfo : public MediaSenderInfo {
   uint64_t total_encode_time_ms = 0;
   // https://w3c.github.io/webrtc-stats/#dom-rtcoutboundrtpstreamstats-totalencodedbytestarget
   uint64_t total_encoded_bytes_target = 0;
+  // Non-standard, covers all layers of the send stream.
+  absl::optional<webrtc::TimeDelta> total_encode_cpu_time;
   bool has_entered_low_resolution = false;
   absl::optional<uint64_t> qp_sum;
   webrtc::VideoContentType content_type = webrtc::VideoContentType::UNSPECIFIED;
@@ -635,6 +639,8 @@ struct VideoReceiverInfo : public MediaReceiverInfo {
   webrtc::TimeDelta total_decode_time = webrtc::TimeDelta::Zero();
   // https://w3c.github.io/webrtc-stats/#dom-rtcinboundrtpstreamstats-totalprocessingdelay
   webrtc::TimeDelta total_processing_delay = webrtc::TimeDelta::Zero();
+  // Non-standard.
+  absl::optional<webrtc::TimeDelta> total_decode_cpu_time;
   webrtc::TimeDelta total_assembly_time = webrtc::TimeDelta::Zero();
   uint32_t frames_assembled_from_multiple_packets = 0;
   double total_inter_frame_delay = 0;
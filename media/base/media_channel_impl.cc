@@ -14,6 +14,7 @@
 #include <string>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "absl/functional/any_invocable.h"
 #include "api/audio_options.h"
@@ -167,6 +168,37 @@ std::map<std::string, std::string> VideoSenderParameters::ToStringMap() const {
 
 // --------------------- MediaChannelUtil::TransportForMediaChannels -----
 
+namespace {
+// Largest SRTP authentication tag used by any supported crypto suite
+// (AEAD_AES_256_GCM). WebRTC never adds an MKI.
+constexpr size_t kSrtpMaxTrailerLen = 16;
+// SRTCP also appends the E flag and SRTCP index.
+constexpr size_t kSrtcpMaxTrailerLen = kSrtpMaxTrailerLen + 4;
+
+// SRTP protects the packet in place and appends the authentication tag, so
+// make sure there is room for it. Otherwise the sender's buffer is shared, and
+// only copied if it is still referenced when it gets protected.
+void ReserveSrtpTrailer(rtc::CopyOnWriteBuffer& packet) {
+  if (packet.capacity() < packet.size() + kSrtpMaxTrailerLen) {
+    packet.EnsureCapacity(kMaxRtpPacketLen);
+  }
+}
+
+// Converts everything but the DSCP value, which is only known on the network
+// thread.
+rtc::PacketOptions ToRtcPacketOptions(const webrtc::PacketOptions& options) {
+  rtc::PacketOptions rtc_options;
+  rtc_options.packet_id = options.packet_id;
+  rtc_options.info_signaled_after_sent.included_in_feedback =
+      options.included_in_feedback;
+  rtc_options.info_signaled_after_sent.included_in_allocation =
+      options.included_in_allocation;
+  rtc_options.batchable = options.batchable;
+  rtc_options.last_packet_in_batch = options.last_packet_in_batch;
+  return rtc_options;
+}
+}  // namespace
+
 MediaChannelUtil::TransportForMediaChannels::TransportForMediaChannels(
     webrtc::TaskQueueBase* network_thread,
     bool enable_dscp)
@@ -181,8 +213,8 @@ MediaChannelUtil::TransportForMediaChannels::~TransportForMediaChannels() {
 
 bool MediaChannelUtil::TransportForMediaChannels::SendRtcp(
     rtc::ArrayView<const uint8_t> packet) {
-  auto send = [this, packet = rtc::CopyOnWriteBuffer(
-                         packet, kMaxRtpPacketLen)]() mutable {
+  auto send = [this, packet = CopyToSendBuffer(
+                         packet, kSrtcpMaxTrailerLen)]() mutable {
     rtc::PacketOptions rtc_options;
     if (DscpEnabled()) {
       rtc_options.dscp = PreferredDscp();
@@ -201,37 +233,65 @@ bool MediaChannelUtil::TransportForMediaChannels::SendRtcp(
 bool MediaChannelUtil::TransportForMediaChannels::SendRtp(
     rtc::ArrayView<const uint8_t> packet,
     const webrtc::PacketOptions& options) {
-  auto send =
-      [this, packet_id = options.packet_id,
-       included_in_feedback = options.included_in_feedback,
-       included_in_allocation = options.included_in_allocation,
-       batchable = options.batchable,
-       last_packet_in_batch = options.last_packet_in_batch,
-       packet = rtc::CopyOnWriteBuffer(packet, kMaxRtpPacketLen)]() mutable {
-        rtc::PacketOptions rtc_options;
-        rtc_options.packet_id = packet_id;
-        if (DscpEnabled()) {
-          rtc_options.dscp = PreferredDscp();
-        }
-        rtc_options.info_signaled_after_sent.included_in_feedback =
-            included_in_feedback;
-        rtc_options.info_signaled_after_sent.included_in_allocation =
-            included_in_allocation;
-        rtc_options.batchable = batchable;
-        rtc_options.last_packet_in_batch = last_packet_in_batch;
-        DoSendPacket(&packet, false, rtc_options);
-      };
+  return SendRtpBuffer(CopyToSendBuffer(packet, kSrtpMaxTrailerLen), options);
+}
+
+bool MediaChannelUtil::TransportForMediaChannels::SendRtpBuffer(
+    rtc::CopyOnWriteBuffer packet,
+    const webrtc::PacketOptions& options) {
+  ReserveSrtpTrailer(packet);
+  SendOnNetworkThread([this, packet = std::move(packet),
+                       rtc_options = ToRtcPacketOptions(options)]() mutable {
+    if (DscpEnabled()) {
+      rtc_options.dscp = PreferredDscp();
+    }
+    DoSendPacket(&packet, false, rtc_options);
+  });
+  return true;
+}
+
+void MediaChannelUtil::TransportForMediaChannels::SendRtpBatch(
+    rtc::ArrayView<BatchedRtpPacket> packets) {
+  std::vector<std::pair<rtc::CopyOnWriteBuffer, rtc::PacketOptions>> batch;
+  batch.reserve(packets.size());
+  for (BatchedRtpPacket& packet : packets) {
+    ReserveSrtpTrailer(packet.packet);
+    batch.emplace_back(std::move(packet.packet),
+                       ToRtcPacketOptions(packet.options));
+    packet.sent = true;
+  }
+  // A single task for the whole batch, rather than one thread hop per packet.
+  SendOnNetworkThread([this, batch = std::move(batch)]() mutable {
+    for (auto& [packet, rtc_options] : batch) {
+      if (DscpEnabled()) {
+        rtc_options.dscp = PreferredDscp();
+      }
+      DoSendPacket(&packet, false, rtc_options);
+    }
+  });
+}
 
+rtc::CopyOnWriteBuffer
+MediaChannelUtil::TransportForMediaChannels::CopyToSendBuffer(
+    rtc::ArrayView<const uint8_t> packet,
+    size_t trailer_size) {
+  rtc::CopyOnWriteBuffer buffer =
+      send_buffer_pool_->Create(packet.size() + trailer_size);
+  buffer.AppendData(packet);
+  return buffer;
+}
+
+void MediaChannelUtil::TransportForMediaChannels::SendOnNetworkThread(
+    absl::AnyInvocable<void() &&> send) {
   // TODO(bugs.webrtc.org/11993): ModuleRtpRtcpImpl2 and related classes (e.g.
   // RTCPSender) aren't aware of the network thread and may trigger calls to
   // this function from different threads. Update those classes to keep
   // network traffic on the network thread.
   if (network_thread_->IsCurrent()) {
-    send();
+    std::move(send)();
   } else {
     network_thread_->PostTask(SafeTask(network_safety_, std::move(send)));
   }
-  return true;
 }
 
 void MediaChannelUtil::TransportForMediaChannels::SetInterface(
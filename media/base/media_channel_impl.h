@@ -30,6 +30,7 @@
 #include "api/crypto/frame_decryptor_interface.h"
 #include "api/crypto/frame_encryptor_interface.h"
 #include "api/frame_transformer_interface.h"
+#include "api/make_ref_counted.h"
 #include "api/media_types.h"
 #include "api/rtc_error.h"
 #include "api/rtp_headers.h"
@@ -124,6 +125,9 @@ class MediaChannelUtil {
     // Implementation of webrtc::Transport
     bool SendRtp(rtc::ArrayView<const uint8_t> packet,
                  const webrtc::PacketOptions& options) override;
+    bool SendRtpBuffer(rtc::CopyOnWriteBuffer packet,
+                       const webrtc::PacketOptions& options) override;
+    void SendRtpBatch(rtc::ArrayView<BatchedRtpPacket> packets) override;
     bool SendRtcp(rtc::ArrayView<const uint8_t> packet) override;
 
     // Not implementation of webrtc::Transport
@@ -146,6 +150,16 @@ class MediaChannelUtil {
     void SetPreferredDscp(rtc::DiffServCodePoint new_dscp);
 
    private:
+    // Copies `packet` to storage from `send_buffer_pool_`, with room for
+    // `trailer_size` more bytes, so that SRTP can protect it in place.
+    rtc::CopyOnWriteBuffer CopyToSendBuffer(
+        rtc::ArrayView<const uint8_t> packet,
+        size_t trailer_size);
+
+    // Runs `send` right away when called on the network thread, otherwise
+    // posts it there.
+    void SendOnNetworkThread(absl::AnyInvocable<void() &&> send);
+
     // This is the DSCP value used for both RTP and RTCP channels if DSCP is
     // enabled. It can be changed at any time via `SetPreferredDscp`.
     rtc::DiffServCodePoint PreferredDscp() const {
@@ -170,6 +184,10 @@ class MediaChannelUtil {
         RTC_GUARDED_BY(network_thread_) = nullptr;
     rtc::DiffServCodePoint preferred_dscp_ RTC_GUARDED_BY(network_thread_) =
         rtc::DSCP_DEFAULT;
+    // Storage of packets copied for sending, which is given back when the
+    // network thread is done with them.
+    const rtc::scoped_refptr<rtc::CopyOnWriteBufferPool> send_buffer_pool_ =
+        rtc::make_ref_counted<rtc::CopyOnWriteBufferPool>();
   };
 
   bool extmap_allow_mixed_ = false;
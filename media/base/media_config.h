@@ -65,12 +65,22 @@ struct MediaConfig {
 
     // Enables send packet batching from the egress RTP sender.
     bool enable_send_packet_batching = false;
+
+    // Shares the encoder of send streams with the send streams of other
+    // PeerConnections that have this flag set and send the same track with
+    // identical codec settings. Software encoders only.
+    bool enable_shared_encoder = false;
   } video;
 
   // Audio-specific config.
   struct Audio {
     // Time interval between RTCP report for audio
     int rtcp_report_interval_ms = 5000;
+
+    // Shares the encoder of send streams with the send streams of other
+    // PeerConnections that have this flag set and send the same track with
+    // the same codec, so that the track is encoded once.
+    bool enable_shared_encoder = false;
   } audio;
 
   bool operator==(const MediaConfig& o) const {
@@ -87,7 +97,9 @@ struct MediaConfig {
            video.rtcp_report_interval_ms == o.video.rtcp_report_interval_ms &&
            video.enable_send_packet_batching ==
                o.video.enable_send_packet_batching &&
-           audio.rtcp_report_interval_ms == o.audio.rtcp_report_interval_ms;
+           video.enable_shared_encoder == o.video.enable_shared_encoder &&
+           audio.rtcp_report_interval_ms == o.audio.rtcp_report_interval_ms &&
+           audio.enable_shared_encoder == o.audio.enable_shared_encoder;
   }
 
   bool operator!=(const MediaConfig& o) const { return !(*this == o); }
@@ -123,6 +123,9 @@ const char kH265FmtpProfileCompatibilityIndicator[] =
     "profile-compatibility-indicator";
 const char kH265FmtpInteropConstraints[] = "interop-constraints";
 const char kH265FmtpTxMode[] = "tx-mode";
+const char kH265FmtpSpropVps[] = "sprop-vps";
+const char kH265FmtpSpropSps[] = "sprop-sps";
+const char kH265FmtpSpropPps[] = "sprop-pps";
 
 // draft-ietf-payload-vp9
 const char kVP9ProfileId[] = "profile-id";
@@ -146,6 +146,9 @@ RTC_EXPORT extern const char kH265FmtpLevelId[];
 RTC_EXPORT extern const char kH265FmtpProfileCompatibilityIndicator[];
 RTC_EXPORT extern const char kH265FmtpInteropConstraints[];
 RTC_EXPORT extern const char kH265FmtpTxMode[];
+extern const char kH265FmtpSpropVps[];
+extern const char kH265FmtpSpropSps[];
+extern const char kH265FmtpSpropPps[];
 
 // draft-ietf-payload-vp9
 extern const char kVP9ProfileId[];
@@ -11,6 +11,7 @@
 #include "media/base/video_broadcaster.h"
 
 #include <algorithm>
+#include <limits>
 #include <vector>
 
 #include "absl/types/optional.h"
@@ -19,8 +20,39 @@
 #include "media/base/video_common.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/time_utils.h"
 
 namespace rtc {
+namespace {
+
+// Returns `frame` with its rotation applied to the buffer, or nullopt if the
+// buffer can't be converted to I420.
+absl::optional<webrtc::VideoFrame> ApplyRotation(
+    const webrtc::VideoFrame& frame) {
+  const rtc::scoped_refptr<webrtc::VideoFrameBuffer>& buffer =
+      frame.video_frame_buffer();
+  rtc::scoped_refptr<webrtc::I420Buffer> rotated_buffer;
+  if (buffer->type() == webrtc::VideoFrameBuffer::Type::kNV12) {
+    rotated_buffer =
+        webrtc::I420Buffer::Rotate(*buffer->GetNV12(), frame.rotation());
+  } else {
+    rtc::scoped_refptr<webrtc::I420BufferInterface> i420_buffer =
+        buffer->ToI420();
+    if (!i420_buffer) {
+      return absl::nullopt;
+    }
+    rotated_buffer =
+        webrtc::I420Buffer::Rotate(*i420_buffer, frame.rotation());
+  }
+  webrtc::VideoFrame rotated_frame(frame);
+  rotated_frame.set_video_frame_buffer(rotated_buffer);
+  rotated_frame.set_rotation(webrtc::kVideoRotation_0);
+  // The update rect and region are relative to the unrotated frame.
+  rotated_frame.clear_update_rect();
+  return rotated_frame;
+}
+
+}  // namespace
 
 VideoBroadcaster::VideoBroadcaster() = default;
 VideoBroadcaster::~VideoBroadcaster() = default;
@@ -32,7 +64,7 @@ void VideoBroadcaster::AddOrUpdateSink(
   webrtc::MutexLock lock(&sinks_and_wants_lock_);
   if (!FindSinkPair(sink)) {
     // `Sink` is a new sink, which didn't receive previous frame.
-    previous_frame_sent_to_all_sinks_ = false;
+    sink_states_[sink].missed_previous_frame = true;
 
     if (last_constraints_.has_value()) {
       RTC_LOG(LS_INFO) << __func__ << " forwarding stored constraints min_fps "
@@ -42,6 +74,10 @@ void VideoBroadcaster::AddOrUpdateSink(
     }
   }
   VideoSourceBase::AddOrUpdateSink(sink, wants);
+  sink_states_[sink].framerate_controller.SetMaxFramerate(
+      wants.max_framerate_fps < std::numeric_limits<int>::max()
+          ? wants.max_framerate_fps
+          : std::numeric_limits<double>::max());
   UpdateWants();
 }
 
@@ -50,6 +86,7 @@ void VideoBroadcaster::RemoveSink(
   RTC_DCHECK(sink != nullptr);
   webrtc::MutexLock lock(&sinks_and_wants_lock_);
   VideoSourceBase::RemoveSink(sink);
+  sink_states_.erase(sink);
   UpdateWants();
 }
 
@@ -65,40 +102,70 @@ VideoSinkWants VideoBroadcaster::wants() const {
 
 void VideoBroadcaster::OnFrame(const webrtc::VideoFrame& frame) {
   webrtc::MutexLock lock(&sinks_and_wants_lock_);
-  bool current_frame_was_discarded = false;
+  // Variants of `frame` are built at most once and shared by all sinks that
+  // need them. Index 1 holds the variants with the rotation applied.
+  absl::optional<webrtc::VideoFrame> black_frames[2];
+  absl::optional<webrtc::VideoFrame> frame_without_update_rect;
+  absl::optional<webrtc::VideoFrame> rotated_frame;
+  bool rotation_failed = false;
   for (auto& sink_pair : sink_pairs()) {
-    if (sink_pair.wants.rotation_applied &&
-        frame.rotation() != webrtc::kVideoRotation_0) {
-      // Calls to OnFrame are not synchronized with changes to the sink wants.
-      // When rotation_applied is set to true, one or a few frames may get here
-      // with rotation still pending. Protect sinks that don't expect any
-      // pending rotation.
-      RTC_LOG(LS_VERBOSE) << "Discarding frame with unexpected rotation.";
+    SinkState& sink_state = sink_states_[sink_pair.sink];
+    if (sink_state.framerate_controller.ShouldDropFrame(
+            frame.timestamp_us() * rtc::kNumNanosecsPerMicrosec)) {
+      // The sink asked for a lower framerate than the source delivers, drop
+      // the frame here rather than downstream of the sink.
       sink_pair.sink->OnDiscardedFrame();
-      current_frame_was_discarded = true;
+      sink_state.missed_previous_frame = true;
       continue;
     }
+    const bool apply_rotation = sink_pair.wants.rotation_applied &&
+                                frame.rotation() != webrtc::kVideoRotation_0;
     if (sink_pair.wants.black_frames) {
-      webrtc::VideoFrame black_frame =
-          webrtc::VideoFrame::Builder()
-              .set_video_frame_buffer(
-                  GetBlackFrameBuffer(frame.width(), frame.height()))
-              .set_rotation(frame.rotation())
-              .set_timestamp_us(frame.timestamp_us())
-              .set_id(frame.id())
-              .build();
-      sink_pair.sink->OnFrame(black_frame);
-    } else if (!previous_frame_sent_to_all_sinks_ && frame.has_update_rect()) {
-      // Since last frame was not sent to some sinks, no reliable update
+      absl::optional<webrtc::VideoFrame>& black_frame =
+          black_frames[apply_rotation];
+      if (!black_frame) {
+        const bool transpose = apply_rotation &&
+                               (frame.rotation() == webrtc::kVideoRotation_90 ||
+                                frame.rotation() == webrtc::kVideoRotation_270);
+        black_frame =
+            webrtc::VideoFrame::Builder()
+                .set_video_frame_buffer(GetBlackFrameBuffer(
+                    transpose ? frame.height() : frame.width(),
+                    transpose ? frame.width() : frame.height()))
+                .set_rotation(apply_rotation ? webrtc::kVideoRotation_0
+                                             : frame.rotation())
+                .set_timestamp_us(frame.timestamp_us())
+                .set_id(frame.id())
+                .build();
+      }
+      sink_pair.sink->OnFrame(*black_frame);
+    } else if (apply_rotation) {
+      // Rotation is carried as metadata up to here, and only applied once
+      // for the sinks that can't handle it.
+      if (!rotated_frame && !rotation_failed) {
+        rotated_frame = ApplyRotation(frame);
+        rotation_failed = !rotated_frame;
+      }
+      if (rotation_failed) {
+        RTC_LOG(LS_VERBOSE) << "Discarding frame that can't be rotated.";
+        sink_pair.sink->OnDiscardedFrame();
+        sink_state.missed_previous_frame = true;
+        continue;
+      }
+      sink_pair.sink->OnFrame(*rotated_frame);
+    } else if (sink_state.missed_previous_frame && frame.has_update_rect()) {
+      // Since the sink didn't get the last frame, no reliable update
       // information is available, so we need to clear the update rect.
-      webrtc::VideoFrame copy = frame;
-      copy.clear_update_rect();
-      sink_pair.sink->OnFrame(copy);
+      if (!frame_without_update_rect) {
+        frame_without_update_rect = frame;
+        frame_without_update_rect->clear_update_rect();
+      }
+      sink_pair.sink->OnFrame(*frame_without_update_rect);
     } else {
       sink_pair.sink->OnFrame(frame);
     }
+    sink_state.missed_previous_frame = false;
   }
-  previous_frame_sent_to_all_sinks_ = !current_frame_was_discarded;
 }
 
 void VideoBroadcaster::OnDiscardedFrame() {
@@ -108,6 +175,23 @@ void VideoBroadcaster::OnDiscardedFrame() {
   }
 }
 
+bool VideoBroadcaster::WantsFrame(int64_t timestamp_us) {
+  webrtc::MutexLock lock(&sinks_and_wants_lock_);
+  bool wanted = false;
+  // Every sink is asked, as sinks may count on being asked for each frame.
+  for (auto& sink_pair : sink_pairs()) {
+    wanted |= sink_pair.sink->WantsFrame(timestamp_us);
+  }
+  if (!wanted) {
+    // The frame will not reach the sinks, so the update rect of the next one
+    // is not reliable.
+    for (auto& [sink, sink_state] : sink_states_) {
+      sink_state.missed_previous_frame = true;
+    }
+  }
+  return wanted;
+}
+
 void VideoBroadcaster::ProcessConstraints(
     const webrtc::VideoTrackSourceConstraints& constraints) {
   webrtc::MutexLock lock(&sinks_and_wants_lock_);
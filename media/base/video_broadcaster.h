@@ -11,11 +11,14 @@
 #ifndef MEDIA_BASE_VIDEO_BROADCASTER_H_
 #define MEDIA_BASE_VIDEO_BROADCASTER_H_
 
+#include <map>
+
 #include "api/media_stream_interface.h"
 #include "api/scoped_refptr.h"
 #include "api/sequence_checker.h"
 #include "api/video/video_frame_buffer.h"
 #include "api/video/video_source_interface.h"
+#include "common_video/framerate_controller.h"
 #include "media/base/video_source_base.h"
 #include "rtc_base/synchronization/mutex.h"
 #include "rtc_base/thread_annotations.h"
@@ -49,13 +52,20 @@ class VideoBroadcaster : public VideoSourceBase,
   VideoSinkWants wants() const;
 
   // This method ensures that if a sink sets rotation_applied == true,
-  // it will never receive a frame with pending rotation. Our caller
-  // may pass in frames without precise synchronization with changes
-  // to the VideoSinkWants.
+  // it will never receive a frame with pending rotation. The rotation is
+  // applied once per frame, for those sinks only, and other sinks get the
+  // frame with the rotation as metadata. Frames with a buffer that can't be
+  // converted to I420 are discarded for sinks that want rotation applied.
+  // Frames exceeding the max_framerate_fps of a sink are dropped for that
+  // sink.
   void OnFrame(const webrtc::VideoFrame& frame) override;
 
   void OnDiscardedFrame() override;
 
+  // Returns true if at least one sink wants a frame captured at
+  // `timestamp_us`, see VideoSinkInterface::WantsFrame.
+  bool WantsFrame(int64_t timestamp_us) override;
+
   // Called on the network thread when constraints change. Forwards the
   // constraints to sinks added with AddOrUpdateSink via OnConstraintsChanged.
   void ProcessConstraints(
@@ -71,8 +81,14 @@ class VideoBroadcaster : public VideoSourceBase,
 
   VideoSinkWants current_wants_ RTC_GUARDED_BY(sinks_and_wants_lock_);
   rtc::scoped_refptr<webrtc::VideoFrameBuffer> black_frame_buffer_;
-  bool previous_frame_sent_to_all_sinks_ RTC_GUARDED_BY(sinks_and_wants_lock_) =
-      true;
+  struct SinkState {
+    // Drops frames above the max framerate the sink asked for.
+    webrtc::FramerateController framerate_controller;
+    // The update rect of the next frame is not reliable for the sink.
+    bool missed_previous_frame = false;
+  };
+  std::map<VideoSinkInterface<webrtc::VideoFrame>*, SinkState> sink_states_
+      RTC_GUARDED_BY(sinks_and_wants_lock_);
   absl::optional<webrtc::VideoTrackSourceConstraints> last_constraints_
       RTC_GUARDED_BY(sinks_and_wants_lock_);
 };
@@ -54,6 +54,36 @@ TEST(VideoBroadcasterTest, frame_wanted) {
   EXPECT_FALSE(broadcaster.frame_wanted());
 }
 
+class FrameSkippingSink : public rtc::VideoSinkInterface<webrtc::VideoFrame> {
+ public:
+  void OnFrame(const webrtc::VideoFrame&) override {}
+  bool WantsFrame(int64_t timestamp_us) override {
+    ++num_asked;
+    return wants_frames;
+  }
+
+  bool wants_frames = true;
+  int num_asked = 0;
+};
+
+TEST(VideoBroadcasterTest, WantsFrameIfAnySinkWantsIt) {
+  VideoBroadcaster broadcaster;
+  FrameSkippingSink sink1;
+  FrameSkippingSink sink2;
+  broadcaster.AddOrUpdateSink(&sink1, rtc::VideoSinkWants());
+  broadcaster.AddOrUpdateSink(&sink2, rtc::VideoSinkWants());
+
+  EXPECT_TRUE(broadcaster.WantsFrame(/*timestamp_us=*/1000));
+  sink1.wants_frames = false;
+  EXPECT_TRUE(broadcaster.WantsFrame(/*timestamp_us=*/2000));
+  sink2.wants_frames = false;
+  EXPECT_FALSE(broadcaster.WantsFrame(/*timestamp_us=*/3000));
+
+  // Each sink is asked about each frame.
+  EXPECT_EQ(sink1.num_asked, 3);
+  EXPECT_EQ(sink2.num_asked, 3);
+}
+
 TEST(VideoBroadcasterTest, OnFrame) {
   VideoBroadcaster broadcaster;
 
@@ -436,3 +466,101 @@ TEST(VideoBroadcasterTest, IgnoreInactiveSinkIfNewApiUsed) {
   broadcaster.RemoveSink(&sink2);
   EXPECT_EQ(broadcaster.wants().resolution_alignment, 1);
 }
+
+class RecordingSink : public rtc::VideoSinkInterface<webrtc::VideoFrame> {
+ public:
+  void OnFrame(const webrtc::VideoFrame& frame) override {
+    ++num_frames;
+    last_frame_had_update_rect = frame.has_update_rect();
+  }
+  void OnDiscardedFrame() override { ++num_discarded; }
+
+  int num_frames = 0;
+  int num_discarded = 0;
+  bool last_frame_had_update_rect = false;
+};
+
+webrtc::VideoFrame FrameWithUpdateRect(int64_t timestamp_us) {
+  rtc::scoped_refptr<webrtc::I420Buffer> buffer(
+      webrtc::I420Buffer::Create(100, 50));
+  webrtc::I420Buffer::SetBlack(buffer.get());
+  return webrtc::VideoFrame::Builder()
+      .set_video_frame_buffer(buffer)
+      .set_timestamp_us(timestamp_us)
+      .set_update_rect(webrtc::VideoFrame::UpdateRect{0, 0, 10, 10})
+      .build();
+}
+
+TEST(VideoBroadcasterTest, DropsFramesAboveSinkMaxFramerate) {
+  VideoBroadcaster broadcaster;
+  RecordingSink limited_sink;
+  VideoSinkWants wants;
+  wants.max_framerate_fps = 25;
+  broadcaster.AddOrUpdateSink(&limited_sink, wants);
+  RecordingSink sink;
+  broadcaster.AddOrUpdateSink(&sink, VideoSinkWants());
+
+  // 50 fps.
+  for (int i = 0; i < 10; ++i) {
+    broadcaster.OnFrame(FrameWithUpdateRect(i * 20000));
+  }
+  EXPECT_EQ(limited_sink.num_frames, 6);
+  EXPECT_EQ(limited_sink.num_discarded, 4);
+  EXPECT_EQ(sink.num_frames, 10);
+  EXPECT_EQ(sink.num_discarded, 0);
+}
+
+TEST(VideoBroadcasterTest, ClearsUpdateRectOnlyForSinksThatMissedFrame) {
+  VideoBroadcaster broadcaster;
+  RecordingSink limited_sink;
+  VideoSinkWants wants;
+  wants.max_framerate_fps = 25;
+  broadcaster.AddOrUpdateSink(&limited_sink, wants);
+  RecordingSink sink;
+  broadcaster.AddOrUpdateSink(&sink, VideoSinkWants());
+
+  // New sinks didn't get the previous frame.
+  broadcaster.OnFrame(FrameWithUpdateRect(0));
+  EXPECT_FALSE(limited_sink.last_frame_had_update_rect);
+  EXPECT_FALSE(sink.last_frame_had_update_rect);
+
+  broadcaster.OnFrame(FrameWithUpdateRect(20000));
+  EXPECT_TRUE(limited_sink.last_frame_had_update_rect);
+  EXPECT_TRUE(sink.last_frame_had_update_rect);
+
+  // Dropped for `limited_sink`.
+  broadcaster.OnFrame(FrameWithUpdateRect(40000));
+  EXPECT_EQ(limited_sink.num_discarded, 1);
+
+  broadcaster.OnFrame(FrameWithUpdateRect(60000));
+  EXPECT_FALSE(limited_sink.last_frame_had_update_rect);
+  EXPECT_TRUE(sink.last_frame_had_update_rect);
+}
+
+TEST(VideoBroadcasterTest, AppliesRotationOnlyForSinksThatWantIt) {
+  VideoBroadcaster broadcaster;
+  FakeVideoRenderer rotating_sink;
+  VideoSinkWants wants;
+  wants.rotation_applied = true;
+  broadcaster.AddOrUpdateSink(&rotating_sink, wants);
+  FakeVideoRenderer sink;
+  broadcaster.AddOrUpdateSink(&sink, VideoSinkWants());
+
+  rtc::scoped_refptr<webrtc::I420Buffer> buffer(
+      webrtc::I420Buffer::Create(100, 50));
+  webrtc::I420Buffer::SetBlack(buffer.get());
+  broadcaster.OnFrame(webrtc::VideoFrame::Builder()
+                          .set_video_frame_buffer(buffer)
+                          .set_rotation(webrtc::kVideoRotation_90)
+                          .set_timestamp_us(0)
+                          .build());
+
+  EXPECT_EQ(rotating_sink.num_rendered_frames(), 1);
+  EXPECT_EQ(rotating_sink.rotation(), webrtc::kVideoRotation_0);
+  EXPECT_EQ(rotating_sink.width(), 50);
+  EXPECT_EQ(rotating_sink.height(), 100);
+  EXPECT_EQ(sink.num_rendered_frames(), 1);
+  EXPECT_EQ(sink.rotation(), webrtc::kVideoRotation_90);
+  EXPECT_EQ(sink.width(), 100);
+  EXPECT_EQ(sink.height(), 50);
+}
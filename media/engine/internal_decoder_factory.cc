@@ -10,10 +10,13 @@
 
 #include "media/engine/internal_decoder_factory.h"
 
+#include <utility>
+
 #include "absl/strings/match.h"
 #include "api/video_codecs/av1_profile.h"
 #include "api/video_codecs/sdp_video_format.h"
 #include "api/video_codecs/video_codec.h"
+#include "api/video_codecs/video_decoder_software_fallback_wrapper.h"
 #include "media/base/codec.h"
 #include "media/base/media_constants.h"
 #include "modules/video_coding/codecs/h264/include/h264.h"
@@ -27,6 +30,10 @@
 #include "modules/video_coding/codecs/av1/dav1d_decoder.h"  // nogncheck
 #endif
 
+#if defined(RTC_USE_VAAPI_DECODER)
+#include "modules/video_coding/codecs/vaapi/vaapi_video_decoder.h"  // nogncheck
+#endif
+
 namespace webrtc {
 namespace {
 #if defined(RTC_DAV1D_IN_INTERNAL_DECODER_FACTORY)
@@ -38,6 +45,30 @@ std::unique_ptr<VideoDecoder> CreateDav1dDecoder() {
 }
 #endif
 
+#if !defined(RTC_USE_VAAPI_DECODER)
+bool IsVaapiDecoderSupported(VideoCodecType codec_type) {
+  return false;
+}
+std::unique_ptr<VideoDecoder> CreateVaapiDecoder(VideoCodecType codec_type) {
+  return nullptr;
+}
+#endif
+
+// Puts a VA-API decoder in front of `software_decoder` when the hardware
+// supports `codec_type`. Streams the hardware rejects fall back to
+// `software_decoder`.
+std::unique_ptr<VideoDecoder> MaybeCreateHardwareDecoder(
+    VideoCodecType codec_type,
+    std::unique_ptr<VideoDecoder> software_decoder) {
+  if (!software_decoder ||
+      field_trial::IsDisabled("WebRTC-Video-VaapiDecoder") ||
+      !IsVaapiDecoderSupported(codec_type)) {
+    return software_decoder;
+  }
+  return CreateVideoDecoderSoftwareFallbackWrapper(
+      std::move(software_decoder), CreateVaapiDecoder(codec_type));
+}
+
 }  // namespace
 
 std::vector<SdpVideoFormat> InternalDecoderFactory::GetSupportedFormats()
@@ -91,11 +122,11 @@ std::unique_ptr<VideoDecoder> InternalDecoderFactory::CreateVideoDecoder(
   if (absl::EqualsIgnoreCase(format.name, cricket::kVp9CodecName))
     return VP9Decoder::Create();
   if (absl::EqualsIgnoreCase(format.name, cricket::kH264CodecName))
-    return H264Decoder::Create();
+    return MaybeCreateHardwareDecoder(kVideoCodecH264, H264Decoder::Create());
 
   if (absl::EqualsIgnoreCase(format.name, cricket::kAv1CodecName) &&
       kDav1dIsIncluded) {
-    return CreateDav1dDecoder();
+    return MaybeCreateHardwareDecoder(kVideoCodecAV1, CreateDav1dDecoder());
   }
 
   RTC_DCHECK_NOTREACHED();
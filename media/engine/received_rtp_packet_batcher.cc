@@ -0,0 +1,59 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "media/engine/received_rtp_packet_batcher.h"
+
+#include <utility>
+
+#include "rtc_base/checks.h"
+
+namespace cricket {
+
+ReceivedRtpPacketBatcher::ReceivedRtpPacketBatcher(
+    webrtc::TaskQueueBase* worker_thread,
+    rtc::scoped_refptr<webrtc::PendingTaskSafetyFlag> safety,
+    absl::AnyInvocable<void(webrtc::RtpPacketReceived)> handler)
+    : worker_thread_(worker_thread),
+      safety_(std::move(safety)),
+      handler_(std::move(handler)) {
+  RTC_DCHECK(worker_thread_);
+  RTC_DCHECK(safety_);
+}
+
+ReceivedRtpPacketBatcher::~ReceivedRtpPacketBatcher() = default;
+
+void ReceivedRtpPacketBatcher::OnPacketReceived(
+    const webrtc::RtpPacketReceived& packet) {
+  bool post_task;
+  {
+    webrtc::MutexLock lock(&mutex_);
+    post_task = pending_packets_.empty();
+    pending_packets_.push_back(packet);
+  }
+  if (post_task) {
+    worker_thread_->PostTask(webrtc::SafeTask(
+        safety_, [this]() { DeliverPendingPackets(); }));
+  }
+}
+
+void ReceivedRtpPacketBatcher::DeliverPendingPackets() {
+  RTC_DCHECK_RUN_ON(worker_thread_);
+  RTC_DCHECK(delivered_packets_.empty());
+  {
+    webrtc::MutexLock lock(&mutex_);
+    std::swap(pending_packets_, delivered_packets_);
+  }
+  for (webrtc::RtpPacketReceived& packet : delivered_packets_) {
+    handler_(std::move(packet));
+  }
+  delivered_packets_.clear();
+}
+
+}  // namespace cricket
@@ -0,0 +1,66 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MEDIA_ENGINE_RECEIVED_RTP_PACKET_BATCHER_H_
+#define MEDIA_ENGINE_RECEIVED_RTP_PACKET_BATCHER_H_
+
+#include <vector>
+
+#include "absl/functional/any_invocable.h"
+#include "api/scoped_refptr.h"
+#include "api/sequence_checker.h"
+#include "api/task_queue/pending_task_safety_flag.h"
+#include "api/task_queue/task_queue_base.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace cricket {
+
+// Hands RTP packets received on the network thread over to the worker thread.
+// Instead of posting a task per packet, packets that arrive while a delivery
+// task is pending are added to it, so that a burst of packets costs a single
+// task and worker thread wakeup.
+class ReceivedRtpPacketBatcher {
+ public:
+  // `handler` is called on `worker_thread` for each packet, in the order the
+  // packets were received. Delivery stops when `safety` is no longer alive.
+  ReceivedRtpPacketBatcher(
+      webrtc::TaskQueueBase* worker_thread,
+      rtc::scoped_refptr<webrtc::PendingTaskSafetyFlag> safety,
+      absl::AnyInvocable<void(webrtc::RtpPacketReceived)> handler);
+  ~ReceivedRtpPacketBatcher();
+
+  ReceivedRtpPacketBatcher(const ReceivedRtpPacketBatcher&) = delete;
+  ReceivedRtpPacketBatcher& operator=(const ReceivedRtpPacketBatcher&) =
+      delete;
+
+  // Called on the network thread.
+  void OnPacketReceived(const webrtc::RtpPacketReceived& packet);
+
+ private:
+  void DeliverPendingPackets();
+
+  webrtc::TaskQueueBase* const worker_thread_;
+  const rtc::scoped_refptr<webrtc::PendingTaskSafetyFlag> safety_;
+  absl::AnyInvocable<void(webrtc::RtpPacketReceived)> handler_;
+
+  webrtc::Mutex mutex_;
+  // Non-empty exactly when a delivery task is pending.
+  std::vector<webrtc::RtpPacketReceived> pending_packets_
+      RTC_GUARDED_BY(mutex_);
+  // The batch being delivered, kept to reuse its capacity.
+  std::vector<webrtc::RtpPacketReceived> delivered_packets_
+      RTC_GUARDED_BY(worker_thread_);
+};
+
+}  // namespace cricket
+
+#endif  // MEDIA_ENGINE_RECEIVED_RTP_PACKET_BATCHER_H_
@@ -0,0 +1,103 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "media/engine/received_rtp_packet_batcher.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "api/task_queue/task_queue_base.h"
+#include "api/task_queue/task_queue_factory.h"
+#include "api/units/timestamp.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+#include "test/time_controller/simulated_time_controller.h"
+
+namespace cricket {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+webrtc::RtpPacketReceived CreatePacket(uint16_t sequence_number) {
+  webrtc::RtpPacketReceived packet;
+  packet.SetSequenceNumber(sequence_number);
+  return packet;
+}
+
+class ReceivedRtpPacketBatcherTest : public ::testing::Test {
+ protected:
+  ReceivedRtpPacketBatcherTest()
+      : time_controller_(webrtc::Timestamp::Millis(4711)),
+        worker_(time_controller_.GetTaskQueueFactory()->CreateTaskQueue(
+            "worker",
+            webrtc::TaskQueueFactory::Priority::NORMAL)),
+        safety_(webrtc::PendingTaskSafetyFlag::CreateDetached()),
+        batcher_(worker_.get(),
+                 safety_,
+                 [this](webrtc::RtpPacketReceived packet) {
+                   ++handled_in_task_[tasks_run_];
+                   sequence_numbers_.push_back(packet.SequenceNumber());
+                 }) {}
+
+  // Posts a marker task that starts a new entry in `handled_in_task_`, so
+  // packets handled by tasks posted before and after it are counted apart.
+  void MarkTaskBoundary() {
+    worker_->PostTask([this] {
+      ++tasks_run_;
+      handled_in_task_.push_back(0);
+    });
+  }
+
+  webrtc::GlobalSimulatedTimeController time_controller_;
+  std::unique_ptr<webrtc::TaskQueueBase, webrtc::TaskQueueDeleter> worker_;
+  rtc::scoped_refptr<webrtc::PendingTaskSafetyFlag> safety_;
+  size_t tasks_run_ = 0;
+  std::vector<int> handled_in_task_ = {0};
+  std::vector<uint16_t> sequence_numbers_;
+  ReceivedRtpPacketBatcher batcher_;
+};
+
+TEST_F(ReceivedRtpPacketBatcherTest, DeliversBurstInOneTask) {
+  batcher_.OnPacketReceived(CreatePacket(1));
+  batcher_.OnPacketReceived(CreatePacket(2));
+  batcher_.OnPacketReceived(CreatePacket(3));
+  MarkTaskBoundary();
+  time_controller_.AdvanceTime(webrtc::TimeDelta::Zero());
+
+  EXPECT_THAT(sequence_numbers_, ElementsAre(1, 2, 3));
+  EXPECT_THAT(handled_in_task_, ElementsAre(3, 0));
+}
+
+TEST_F(ReceivedRtpPacketBatcherTest, PostsNewTaskAfterBatchIsDelivered) {
+  batcher_.OnPacketReceived(CreatePacket(1));
+  MarkTaskBoundary();
+  time_controller_.AdvanceTime(webrtc::TimeDelta::Zero());
+  batcher_.OnPacketReceived(CreatePacket(2));
+  batcher_.OnPacketReceived(CreatePacket(3));
+  MarkTaskBoundary();
+  time_controller_.AdvanceTime(webrtc::TimeDelta::Zero());
+
+  EXPECT_THAT(sequence_numbers_, ElementsAre(1, 2, 3));
+  EXPECT_THAT(handled_in_task_, ElementsAre(1, 2, 0));
+}
+
+TEST_F(ReceivedRtpPacketBatcherTest, DropsPacketsWhenSafetyFlagIsNotAlive) {
+  worker_->PostTask([this] { safety_->SetNotAlive(); });
+  batcher_.OnPacketReceived(CreatePacket(1));
+  time_controller_.AdvanceTime(webrtc::TimeDelta::Zero());
+
+  EXPECT_THAT(sequence_numbers_, IsEmpty());
+}
+
+}  // namespace
+}  // namespace cricket
@@ -14,14 +14,17 @@
 #include <string.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <string>
 #include <utility>
 
 #include "absl/algorithm/container.h"
 #include "api/field_trials_view.h"
+#include "api/function_view.h"
 #include "api/scoped_refptr.h"
 #include "api/transport/field_trial_based_config.h"
+#include "api/units/time_delta.h"
 #include "api/video/i420_buffer.h"
 #include "api/video/video_codec_constants.h"
 #include "api/video/video_frame_buffer.h"
@@ -34,8 +37,12 @@
 #include "modules/video_coding/include/video_error_codes.h"
 #include "modules/video_coding/utility/simulcast_rate_allocator.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/cpu_time.h"
+#include "rtc_base/event.h"
 #include "rtc_base/experiments/rate_control_settings.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/time_utils.h"
 
 namespace {
 
@@ -117,7 +124,7 @@ bool StreamQualityCompare(const webrtc::SimulcastStream& a,
 }
 
 void GetLowestAndHighestQualityStreamIndixes(
-    rtc::ArrayView<webrtc::SimulcastStream> streams,
+    rtc::ArrayView<const webrtc::SimulcastStream> streams,
     int* lowest_quality_stream_idx,
     int* highest_quality_stream_idx) {
   const auto lowest_highest_quality_streams =
@@ -148,6 +155,106 @@ std::vector<uint32_t> GetStreamStartBitratesKbps(
 }  // namespace
 
 namespace webrtc {
+namespace {
+
+SimulcastEncoderAdapter::ParallelEncodeConfig ParseParallelEncodeConfig(
+    const FieldTrialsView& field_trials) {
+  SimulcastEncoderAdapter::ParallelEncodeConfig config;
+  config.Parser()->Parse(field_trials.Lookup(
+      SimulcastEncoderAdapter::ParallelEncodeConfig::kKey));
+  return config;
+}
+
+}  // namespace
+
+constexpr char SimulcastEncoderAdapter::ParallelEncodeConfig::kKey[];
+
+std::unique_ptr<StructParametersParser>
+SimulcastEncoderAdapter::ParallelEncodeConfig::Parser() {
+  return StructParametersParser::Create("enabled", &enabled,  //
+                                        "max_threads", &max_threads);
+}
+
+// Threads that encode the layers of a frame together with the encoder task
+// queue. Each worker thread waits for its start event, runs its share of the
+// jobs and signals its done event.
+class SimulcastEncoderAdapter::EncodeWorkers {
+ public:
+  explicit EncodeWorkers(int num_threads) {
+    RTC_DCHECK_GT(num_threads, 1);
+    for (int i = 1; i < num_threads; ++i) {
+      workers_.push_back(std::make_unique<Worker>());
+      workers_.back()->thread = rtc::PlatformThread::SpawnJoinable(
+          [this, i] { WorkerLoop(i); }, "SimulcastEncodeWorker",
+          rtc::ThreadAttributes().SetPriority(rtc::ThreadPriority::kHigh));
+    }
+  }
+
+  ~EncodeWorkers() {
+    stop_ = true;
+    for (auto& worker : workers_) {
+      worker->start.Set();
+      worker->thread.Finalize();
+    }
+  }
+
+  int num_threads() const { return static_cast<int>(workers_.size()) + 1; }
+
+  // Thread CPU time spent running jobs on the worker threads, i.e. not
+  // counting the caller.
+  TimeDelta worker_cpu_time() const {
+    return TimeDelta::Micros(
+        worker_cpu_time_ns_.load(std::memory_order_relaxed) /
+        rtc::kNumNanosecsPerMicrosec);
+  }
+
+  // Runs `job(i)` for all i in [0, `num_jobs`) and returns when all are done.
+  // Job i runs on thread i % num_threads(), where thread 0 is the caller.
+  void Run(int num_jobs, rtc::FunctionView<void(int)> job) {
+    num_jobs_ = num_jobs;
+    job_ = job;
+    int num_workers = std::min(num_jobs, num_threads()) - 1;
+    for (int i = 0; i < num_workers; ++i)
+      workers_[i]->start.Set();
+    RunJobs(/*thread_index=*/0);
+    for (int i = 0; i < num_workers; ++i)
+      workers_[i]->done.Wait(rtc::Event::kForever);
+  }
+
+ private:
+  struct Worker {
+    rtc::Event start;
+    rtc::Event done;
+    rtc::PlatformThread thread;
+  };
+
+  void RunJobs(int thread_index) {
+    for (int i = thread_index; i < num_jobs_; i += num_threads())
+      job_(i);
+  }
+
+  void WorkerLoop(int thread_index) {
+    Worker& worker = *workers_[thread_index - 1];
+    while (true) {
+      worker.start.Wait(rtc::Event::kForever);
+      if (stop_)
+        return;
+      const int64_t start_cpu_time_ns = rtc::GetThreadCpuTimeNanos();
+      RunJobs(thread_index);
+      worker_cpu_time_ns_.fetch_add(
+          rtc::GetThreadCpuTimeNanos() - start_cpu_time_ns,
+          std::memory_order_relaxed);
+      worker.done.Set();
+    }
+  }
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  // Written before the start events are set, read by the worker threads.
+  int num_jobs_ = 0;
+  rtc::FunctionView<void(int)> job_;
+  bool stop_ = false;
+  std::atomic<int64_t> worker_cpu_time_ns_{0};
+};
 
 SimulcastEncoderAdapter::EncoderContext::EncoderContext(
     std::unique_ptr<VideoEncoder> encoder,
@@ -195,7 +302,9 @@ SimulcastEncoderAdapter::StreamContext::StreamContext(StreamContext&& rhs)
       width_(rhs.width_),
       height_(rhs.height_),
       is_keyframe_needed_(rhs.is_keyframe_needed_),
-      is_paused_(rhs.is_paused_) {
+      is_paused_(rhs.is_paused_),
+      collect_encoded_images_(rhs.collect_encoded_images_),
+      collected_images_(std::move(rhs.collected_images_)) {
   if (parent_) {
     encoder_context_->encoder().RegisterEncodeCompleteCallback(this);
   }
@@ -233,10 +342,22 @@ SimulcastEncoderAdapter::StreamContext::OnEncodedImage(
     const EncodedImage& encoded_image,
     const CodecSpecificInfo* codec_specific_info) {
   RTC_CHECK(parent_);  // If null, this method should never be called.
+  if (collect_encoded_images_) {
+    collected_images_.push_back({encoded_image, *codec_specific_info});
+    return Result(Result::OK);
+  }
   return parent_->OnEncodedImage(stream_idx_, encoded_image,
                                  codec_specific_info);
 }
 
+void SimulcastEncoderAdapter::StreamContext::DeliverCollectedImages() {
+  for (const CollectedImage& image : collected_images_) {
+    parent_->OnEncodedImage(stream_idx_, image.encoded_image,
+                            &image.codec_specific_info);
+  }
+  collected_images_.clear();
+}
+
 void SimulcastEncoderAdapter::StreamContext::OnDroppedFrame(
     DropReason /*reason*/) {
   RTC_CHECK(parent_);  // If null, this method should never be called.
@@ -268,7 +389,8 @@ SimulcastEncoderAdapter::SimulcastEncoderAdapter(
           RateControlSettings::ParseFromKeyValueConfig(&field_trials)
               .Vp8BoostBaseLayerQuality()),
       prefer_temporal_support_on_base_layer_(field_trials.IsEnabled(
-          "WebRTC-Video-PreferTemporalSupportOnBaseLayer")) {
+          "WebRTC-Video-PreferTemporalSupportOnBaseLayer")),
+      parallel_encode_config_(ParseParallelEncodeConfig(field_trials)) {
   RTC_DCHECK(primary_factory);
 
   // The adapter is typically created on the worker thread, but operated on
@@ -298,6 +420,7 @@ int SimulcastEncoderAdapter::Release() {
   }
 
   bypass_mode_ = false;
+  parallel_encode_ = false;
 
   // It's legal to move the encoder to another queue now.
   encoder_queue_.Detach();
@@ -324,6 +447,7 @@ int SimulcastEncoderAdapter::InitEncode(
   Release();
 
   codec_ = *codec_settings;
+  settings_ = settings;
   total_streams_count_ = CountAllStreams(*codec_settings);
 
   bool is_legacy_singlecast = codec_.numberOfSimulcastStreams == 0;
@@ -386,6 +510,16 @@ int SimulcastEncoderAdapter::InitEncode(
   std::vector<uint32_t> stream_start_bitrate_kbps =
       GetStreamStartBitratesKbps(codec_);
 
+  VideoEncoder::Settings stream_settings =
+      MakeStreamSettings(settings, active_streams_count,
+                         encoder_context->encoder(), &parallel_encode_);
+  if (parallel_encode_) {
+    int num_encode_threads = std::min(parallel_encode_config_.max_threads,
+                                      settings.number_of_cores);
+    if (!encode_workers_ || encode_workers_->num_threads() != num_encode_threads)
+      encode_workers_ = std::make_unique<EncodeWorkers>(num_encode_threads);
+  }
+
   for (int stream_idx = 0; stream_idx < total_streams_count_; ++stream_idx) {
     if (!is_legacy_singlecast && !codec_.simulcastStream[stream_idx].active) {
       continue;
@@ -405,7 +539,8 @@ int SimulcastEncoderAdapter::InitEncode(
         /*is_lowest_quality_stream=*/stream_idx == lowest_quality_stream_idx,
         /*is_highest_quality_stream=*/stream_idx == highest_quality_stream_idx);
 
-    int ret = encoder_context->encoder().InitEncode(&stream_codec, settings);
+    int ret =
+        encoder_context->encoder().InitEncode(&stream_codec, stream_settings);
     if (ret < 0) {
       encoder_context.reset();
       Release();
@@ -414,8 +549,10 @@ int SimulcastEncoderAdapter::InitEncode(
 
     // Intercept frame encode complete callback only for upper streams, where
     // we need to set a correct stream index. Set `parent` to nullptr for the
-    // lowest stream to bypass the callback.
-    SimulcastEncoderAdapter* parent = stream_idx > 0 ? this : nullptr;
+    // lowest stream to bypass the callback, unless the encoded images of all
+    // streams are collected for parallel encoding.
+    SimulcastEncoderAdapter* parent =
+        stream_idx > 0 || parallel_encode_ ? this : nullptr;
 
     bool is_paused = stream_start_bitrate_kbps[stream_idx] == 0;
     stream_contexts_.emplace_back(
@@ -431,6 +568,128 @@ int SimulcastEncoderAdapter::InitEncode(
   return WEBRTC_VIDEO_CODEC_OK;
 }
 
+bool SimulcastEncoderAdapter::UpdateActiveStreams(
+    const VideoCodec& codec_settings) {
+  RTC_DCHECK_RUN_ON(&encoder_queue_);
+
+  // Streams can only be started and stopped on their own if each has an
+  // encoder of its own.
+  if (!Initialized() || bypass_mode_ || stream_contexts_.empty() ||
+      total_streams_count_ < 2 ||
+      codec_settings.codecType != codec_.codecType ||
+      codec_settings.numberOfSimulcastStreams !=
+          codec_.numberOfSimulcastStreams ||
+      CountAllStreams(codec_settings) != total_streams_count_) {
+    return false;
+  }
+  int active_streams_count = CountActiveStreams(codec_settings);
+  if (active_streams_count == 0) {
+    return false;
+  }
+
+  // InitEncode() would encode all streams with one simulcast-capable encoder,
+  // or give the encoders a different number of cores.
+  const VideoEncoder& encoder = stream_contexts_.front().encoder();
+  if (active_streams_count > 1 && encoder.GetEncoderInfo().supports_simulcast) {
+    return false;
+  }
+  bool parallel_encode = false;
+  VideoEncoder::Settings stream_settings = MakeStreamSettings(
+      *settings_, active_streams_count, encoder, &parallel_encode);
+  bool current_parallel_encode = false;
+  VideoEncoder::Settings current_stream_settings =
+      MakeStreamSettings(*settings_, static_cast<int>(stream_contexts_.size()),
+                         encoder, &current_parallel_encode);
+  if (parallel_encode != parallel_encode_ ||
+      stream_settings.number_of_cores !=
+          current_stream_settings.number_of_cores) {
+    return false;
+  }
+
+  int lowest_quality_stream_idx = 0;
+  int highest_quality_stream_idx = 0;
+  GetLowestAndHighestQualityStreamIndixes(
+      rtc::ArrayView<const SimulcastStream>(codec_settings.simulcastStream,
+                                            total_streams_count_),
+      &lowest_quality_stream_idx, &highest_quality_stream_idx);
+  std::vector<uint32_t> stream_start_bitrate_kbps =
+      GetStreamStartBitratesKbps(codec_settings);
+
+  // Initialize the encoders of the activated streams first, so that a failure
+  // leaves the current streams untouched.
+  std::vector<StreamContext> activated_streams;
+  auto current_stream = stream_contexts_.begin();
+  for (int stream_idx = 0; stream_idx < total_streams_count_; ++stream_idx) {
+    if (current_stream != stream_contexts_.end() &&
+        current_stream->stream_idx() == stream_idx) {
+      ++current_stream;
+      continue;
+    }
+    if (!codec_settings.simulcastStream[stream_idx].active) {
+      continue;
+    }
+
+    std::unique_ptr<EncoderContext> encoder_context =
+        FetchOrCreateEncoderContext(
+            /*is_lowest_quality_stream=*/stream_idx ==
+            lowest_quality_stream_idx);
+    VideoCodec stream_codec = MakeStreamCodec(
+        codec_settings, stream_idx, stream_start_bitrate_kbps[stream_idx],
+        /*is_lowest_quality_stream=*/stream_idx == lowest_quality_stream_idx,
+        /*is_highest_quality_stream=*/stream_idx == highest_quality_stream_idx);
+    if (encoder_context == nullptr ||
+        encoder_context->encoder().InitEncode(&stream_codec,
+                                              stream_settings) < 0) {
+      if (encoder_context) {
+        encoder_context->Release();
+        cached_encoder_contexts_.push_front(std::move(encoder_context));
+      }
+      for (StreamContext& stream : activated_streams) {
+        cached_encoder_contexts_.push_front(
+            std::move(stream).ReleaseEncoderContext());
+      }
+      return false;
+    }
+
+    SimulcastEncoderAdapter* parent =
+        stream_idx > 0 || parallel_encode_ ? this : nullptr;
+    // The stream isn't paused until SetRates() says so, as unpausing a stream
+    // makes all streams send key frames. Its encoder starts with a key frame
+    // anyway.
+    activated_streams.emplace_back(
+        parent, std::move(encoder_context),
+        std::make_unique<FramerateController>(stream_codec.maxFramerate),
+        stream_idx, stream_codec.width, stream_codec.height,
+        /*is_paused=*/false);
+  }
+
+  // Merge the streams in stream index order, releasing the encoders of the
+  // deactivated streams to the cache.
+  std::vector<StreamContext> stream_contexts;
+  stream_contexts.reserve(active_streams_count);
+  current_stream = stream_contexts_.begin();
+  auto activated_stream = activated_streams.begin();
+  for (int stream_idx = 0; stream_idx < total_streams_count_; ++stream_idx) {
+    if (current_stream != stream_contexts_.end() &&
+        current_stream->stream_idx() == stream_idx) {
+      if (codec_settings.simulcastStream[stream_idx].active) {
+        stream_contexts.push_back(std::move(*current_stream));
+      } else {
+        cached_encoder_contexts_.push_front(
+            std::move(*current_stream).ReleaseEncoderContext());
+      }
+      ++current_stream;
+    } else if (activated_stream != activated_streams.end() &&
+               activated_stream->stream_idx() == stream_idx) {
+      stream_contexts.push_back(std::move(*activated_stream));
+      ++activated_stream;
+    }
+  }
+  stream_contexts_ = std::move(stream_contexts);
+  codec_ = codec_settings;
+  return true;
+}
+
 int SimulcastEncoderAdapter::Encode(
     const VideoFrame& input_image,
     const std::vector<VideoFrameType>* frame_types) {
@@ -476,11 +735,12 @@ int SimulcastEncoderAdapter::Encode(
     }
   }
 
-  // Temporary thay may hold the result of texture to i420 buffer conversion.
-  rtc::scoped_refptr<VideoFrameBuffer> src_buffer;
   int src_width = input_image.width();
   int src_height = input_image.height();
 
+  // The frames of all layers are selected and scaled before any is encoded.
+  std::vector<LayerFrame> layer_frames;
+
   for (auto& layer : stream_contexts_) {
     // Don't encode frames in resolutions that we don't intend to send.
     if (layer.is_paused()) {
@@ -539,39 +799,105 @@ int SimulcastEncoderAdapter::Encode(
     // correctly sample/scale the source texture.
     // TODO(perkj): ensure that works going forward, and figure out how this
     // affects webrtc:5683.
-    if ((layer.width() == src_width && layer.height() == src_height) ||
-        (input_image.video_frame_buffer()->type() ==
-             VideoFrameBuffer::Type::kNative &&
-         layer.encoder().GetEncoderInfo().supports_native_handle)) {
-      int ret = layer.encoder().Encode(input_image, &stream_frame_types);
-      if (ret != WEBRTC_VIDEO_CODEC_OK) {
-        return ret;
-      }
-    } else {
-      if (src_buffer == nullptr) {
-        src_buffer = input_image.video_frame_buffer();
-      }
-      rtc::scoped_refptr<VideoFrameBuffer> dst_buffer =
-          src_buffer->Scale(layer.width(), layer.height());
-      if (!dst_buffer) {
-        RTC_LOG(LS_ERROR) << "Failed to scale video frame";
-        return WEBRTC_VIDEO_CODEC_ENCODER_FAILURE;
-      }
+    bool needs_scaling =
+        !(layer.width() == src_width && layer.height() == src_height) &&
+        !(input_image.video_frame_buffer()->type() ==
+              VideoFrameBuffer::Type::kNative &&
+          layer.encoder().GetEncoderInfo().supports_native_handle);
+    layer_frames.push_back(
+        {&layer, std::move(stream_frame_types), needs_scaling});
+  }
 
-      // UpdateRect is not propagated to lower simulcast layers currently.
-      // TODO(ilnik): Consider scaling UpdateRect together with the buffer.
-      VideoFrame frame(input_image);
-      frame.set_video_frame_buffer(dst_buffer);
-      frame.set_rotation(webrtc::kVideoRotation_0);
-      frame.set_update_rect(
-          VideoFrame::UpdateRect{0, 0, frame.width(), frame.height()});
-      int ret = layer.encoder().Encode(frame, &stream_frame_types);
-      if (ret != WEBRTC_VIDEO_CODEC_OK) {
-        return ret;
-      }
+  if (!ScaleLayerFrames(input_image, layer_frames)) {
+    RTC_LOG(LS_ERROR) << "Failed to scale video frame";
+    return WEBRTC_VIDEO_CODEC_ENCODER_FAILURE;
+  }
+
+  if (parallel_encode_ && !layer_frames.empty()) {
+    return EncodeInParallel(input_image, layer_frames);
+  }
+  for (LayerFrame& layer_frame : layer_frames) {
+    int ret = layer_frame.layer->encoder().Encode(
+        layer_frame.frame(input_image), &layer_frame.frame_types);
+    if (ret != WEBRTC_VIDEO_CODEC_OK) {
+      return ret;
     }
   }
+  return WEBRTC_VIDEO_CODEC_OK;
+}
 
+bool SimulcastEncoderAdapter::ScaleLayerFrames(
+    const VideoFrame& input_image,
+    std::vector<LayerFrame>& layer_frames) {
+  // Scale the largest layer first, and every other layer from the smallest
+  // already scaled buffer that is at least as large, instead of from the input
+  // frame. This builds a pyramid where each level reads less memory than the
+  // full resolution frame.
+  std::vector<LayerFrame*> scaled_layer_frames;
+  for (LayerFrame& layer_frame : layer_frames) {
+    if (layer_frame.needs_scaling)
+      scaled_layer_frames.push_back(&layer_frame);
+  }
+  absl::c_stable_sort(scaled_layer_frames,
+                      [](const LayerFrame* a, const LayerFrame* b) {
+                        return a->layer->width() * a->layer->height() >
+                               b->layer->width() * b->layer->height();
+                      });
+
+  std::vector<rtc::scoped_refptr<VideoFrameBuffer>> levels;
+  for (LayerFrame* layer_frame : scaled_layer_frames) {
+    const int width = layer_frame->layer->width();
+    const int height = layer_frame->layer->height();
+    rtc::scoped_refptr<VideoFrameBuffer> src_buffer =
+        input_image.video_frame_buffer();
+    for (const auto& level : levels) {
+      if (level->width() >= width && level->height() >= height)
+        src_buffer = level;
+    }
+    rtc::scoped_refptr<VideoFrameBuffer> dst_buffer =
+        src_buffer->width() == width && src_buffer->height() == height
+            ? src_buffer
+            : src_buffer->Scale(width, height);
+    if (!dst_buffer) {
+      return false;
+    }
+    levels.push_back(dst_buffer);
+
+    // UpdateRect is not propagated to lower simulcast layers currently.
+    // TODO(ilnik): Consider scaling UpdateRect together with the buffer.
+    VideoFrame& frame = layer_frame->scaled_frame.emplace(input_image);
+    frame.set_video_frame_buffer(dst_buffer);
+    frame.set_rotation(webrtc::kVideoRotation_0);
+    frame.set_update_rect(
+        VideoFrame::UpdateRect{0, 0, frame.width(), frame.height()});
+  }
+  return true;
+}
+
+int SimulcastEncoderAdapter::EncodeInParallel(
+    const VideoFrame& input_image,
+    std::vector<LayerFrame>& layer_frames) {
+  RTC_DCHECK(parallel_encode_);
+  std::vector<int> results(layer_frames.size(), WEBRTC_VIDEO_CODEC_OK);
+  for (LayerFrame& layer_frame : layer_frames)
+    layer_frame.layer->set_collect_encoded_images(true);
+  encode_workers_->Run(static_cast<int>(layer_frames.size()), [&](int i) {
+    LayerFrame& layer_frame = layer_frames[i];
+    results[i] = layer_frame.layer->encoder().Encode(
+        layer_frame.frame(input_image), &layer_frame.frame_types);
+  });
+
+  // Forward the encoded images in the order of sequential encoding. Unlike
+  // sequential encoding, layers after a failing one have been encoded too, and
+  // their images are forwarded as well.
+  for (LayerFrame& layer_frame : layer_frames) {
+    layer_frame.layer->set_collect_encoded_images(false);
+    layer_frame.layer->DeliverCollectedImages();
+  }
+  for (int result : results) {
+    if (result != WEBRTC_VIDEO_CODEC_OK)
+      return result;
+  }
   return WEBRTC_VIDEO_CODEC_OK;
 }
 
@@ -579,7 +905,8 @@ int SimulcastEncoderAdapter::RegisterEncodeCompleteCallback(
     EncodedImageCallback* callback) {
   RTC_DCHECK_RUN_ON(&encoder_queue_);
   encoded_complete_callback_ = callback;
-  if (!stream_contexts_.empty() && stream_contexts_.front().stream_idx() == 0) {
+  if (!stream_contexts_.empty() && stream_contexts_.front().stream_idx() == 0 &&
+      !parallel_encode_) {
     // Bypass frame encode complete callback for the lowest layer since there is
     // no need to override frame's spatial index.
     stream_contexts_.front().encoder().RegisterEncodeCompleteCallback(callback);
@@ -695,6 +1022,27 @@ bool SimulcastEncoderAdapter::Initialized() const {
   return inited_.load() == 1;
 }
 
+VideoEncoder::Settings SimulcastEncoderAdapter::MakeStreamSettings(
+    const VideoEncoder::Settings& settings,
+    int active_streams_count,
+    const VideoEncoder& encoder,
+    bool* parallel_encode) const {
+  // Software encoders of several layers may encode in parallel. The cores are
+  // then split between the layers encoding at the same time.
+  VideoEncoder::Settings stream_settings = settings;
+  int num_encode_threads = std::min(parallel_encode_config_.max_threads,
+                                    settings.number_of_cores);
+  *parallel_encode = parallel_encode_config_.enabled &&
+                     active_streams_count > 1 && num_encode_threads > 1 &&
+                     !encoder.GetEncoderInfo().is_hardware_accelerated;
+  if (*parallel_encode) {
+    stream_settings.number_of_cores = std::max(
+        1, settings.number_of_cores /
+               std::min(active_streams_count, num_encode_threads));
+  }
+  return stream_settings;
+}
+
 void SimulcastEncoderAdapter::DestroyStoredEncoders() {
   while (!cached_encoder_contexts_.empty()) {
     cached_encoder_contexts_.pop_back();
@@ -973,6 +1321,13 @@ VideoEncoder::EncoderInfo SimulcastEncoderAdapter::GetEncoderInfo() const {
   }
   encoder_info.implementation_name += ")";
 
+  if (parallel_encode_) {
+    encoder_info.num_threads = encode_workers_->num_threads();
+  }
+  if (encode_workers_) {
+    encoder_info.worker_thread_cpu_time = encode_workers_->worker_cpu_time();
+  }
+
   OverrideFromFieldTrial(&encoder_info);
 
   return encoder_info;
@@ -30,6 +30,7 @@
 #include "common_video/framerate_controller.h"
 #include "modules/video_coding/include/video_codec_interface.h"
 #include "rtc_base/experiments/encoder_info_settings.h"
+#include "rtc_base/experiments/struct_parameters_parser.h"
 #include "rtc_base/system/no_unique_address.h"
 #include "rtc_base/system/rtc_export.h"
 
@@ -39,8 +40,24 @@ namespace webrtc {
 // webrtc::VideoEncoder instances with the given VideoEncoderFactory.
 // The object is created and destroyed on the worker thread, but all public
 // interfaces should be called from the encoder task queue.
+//
+// With the field trial of ParallelEncodeConfig enabled, the layers of a frame
+// are encoded in parallel on a few threads owned by the adapter, one of which
+// is the encoder task queue. The encoded images are collected and forwarded
+// in layer order once all layers are encoded, so the callback sees the same
+// sequence as with sequential encoding. This requires software encoders that
+// deliver their encoded images from within Encode().
 class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
  public:
+  struct ParallelEncodeConfig {
+    static constexpr char kKey[] = "WebRTC-Video-SimulcastParallelEncode";
+    std::unique_ptr<StructParametersParser> Parser();
+
+    bool enabled = false;
+    // Number of threads encoding layers, including the encoder task queue.
+    int max_threads = 3;
+  };
+
   // TODO(bugs.webrtc.org/11000): Remove when downstream usage is gone.
   SimulcastEncoderAdapter(VideoEncoderFactory* primarty_factory,
                           const SdpVideoFormat& format);
@@ -59,6 +76,10 @@ class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
   int Release() override;
   int InitEncode(const VideoCodec* codec_settings,
                  const VideoEncoder::Settings& settings) override;
+  // Starts and stops the encoders of the streams that are activated and
+  // deactivated, if the streams are encoded by separate encoders. Encoders of
+  // deactivated streams are kept for when the streams are activated again.
+  bool UpdateActiveStreams(const VideoCodec& codec_settings) override;
   int Encode(const VideoFrame& input_image,
              const std::vector<VideoFrameType>* frame_types) override;
   int RegisterEncodeCompleteCallback(EncodedImageCallback* callback) override;
@@ -133,7 +154,19 @@ class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
     void OnKeyframe(Timestamp timestamp);
     bool ShouldDropFrame(Timestamp timestamp);
 
+    // While collecting, encoded images are kept instead of being forwarded to
+    // the parent, until DeliverCollectedImages() is called.
+    void set_collect_encoded_images(bool collect) {
+      collect_encoded_images_ = collect;
+    }
+    void DeliverCollectedImages();
+
    private:
+    struct CollectedImage {
+      EncodedImage encoded_image;
+      CodecSpecificInfo codec_specific_info;
+    };
+
     SimulcastEncoderAdapter* const parent_;
     std::unique_ptr<EncoderContext> encoder_context_;
     std::unique_ptr<FramerateController> framerate_controller_;
@@ -142,10 +175,43 @@ class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
     const uint16_t height_;
     bool is_keyframe_needed_;
     bool is_paused_;
+    bool collect_encoded_images_ = false;
+    std::vector<CollectedImage> collected_images_;
+  };
+
+  // Frame to encode on a layer. The input frame is encoded unless the layer
+  // needs a scaled frame.
+  struct LayerFrame {
+    StreamContext* layer;
+    std::vector<VideoFrameType> frame_types;
+    bool needs_scaling;
+    absl::optional<VideoFrame> scaled_frame;
+
+    const VideoFrame& frame(const VideoFrame& input_image) const {
+      return scaled_frame ? *scaled_frame : input_image;
+    }
   };
 
+  class EncodeWorkers;
+
   bool Initialized() const;
 
+  // Scales the frames of the layers that need it, each from the smallest
+  // already scaled frame at least as large. Returns false if scaling fails.
+  static bool ScaleLayerFrames(const VideoFrame& input_image,
+                               std::vector<LayerFrame>& layer_frames);
+  int EncodeInParallel(const VideoFrame& input_image,
+                       std::vector<LayerFrame>& layer_frames);
+
+  // Returns the settings to initialize the encoders of `active_streams_count`
+  // streams with, when they are encoded by separate encoders like `encoder`.
+  // Sets `parallel_encode` to whether the streams are encoded in parallel.
+  VideoEncoder::Settings MakeStreamSettings(
+      const VideoEncoder::Settings& settings,
+      int active_streams_count,
+      const VideoEncoder& encoder,
+      bool* parallel_encode) const;
+
   void DestroyStoredEncoders();
 
   // This method creates encoder. May reuse previously created encoders from
@@ -175,6 +241,8 @@ class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
   const SdpVideoFormat video_format_;
   VideoCodec codec_;
   int total_streams_count_;
+  // Settings of the last InitEncode() call.
+  absl::optional<VideoEncoder::Settings> settings_;
   bool bypass_mode_;
   std::vector<StreamContext> stream_contexts_;
   EncodedImageCallback* encoded_complete_callback_;
@@ -183,7 +251,8 @@ class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
   RTC_NO_UNIQUE_ADDRESS SequenceChecker encoder_queue_;
 
   // Store previously created and released encoders , so they don't have to be
-  // recreated. Remaining encoders are destroyed by the destructor.
+  // recreated, e.g. when a stream is activated again. Encoders not reused by
+  // InitEncode() are destroyed by it, remaining ones by the destructor.
   // Marked as `mutable` becuase we may need to temporarily create encoder in
   // GetEncoderInfo(), which is const.
   mutable std::list<std::unique_ptr<EncoderContext>> cached_encoder_contexts_;
@@ -193,6 +262,12 @@ class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
   const bool prefer_temporal_support_on_base_layer_;
 
   const SimulcastEncoderAdapterEncoderInfoSettings encoder_info_override_;
+
+  const ParallelEncodeConfig parallel_encode_config_;
+  // Created by the first InitEncode() that encodes layers in parallel.
+  std::unique_ptr<EncodeWorkers> encode_workers_;
+  // True if the current layers are encoded in parallel.
+  bool parallel_encode_ = false;
 };
 
 }  // namespace webrtc
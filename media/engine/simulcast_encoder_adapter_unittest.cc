@@ -30,6 +30,7 @@
 #include "modules/video_coding/include/video_codec_interface.h"
 #include "modules/video_coding/utility/simulcast_test_fixture_impl.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/event.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 #include "test/scoped_key_value_config.h"
@@ -217,6 +218,7 @@ class MockVideoEncoder : public VideoEncoder {
   int32_t InitEncode(const VideoCodec* codecSettings,
                      const VideoEncoder::Settings& settings) override {
     codec_ = *codecSettings;
+    number_of_cores_ = settings.number_of_cores;
     return init_encode_return_value_;
   }
 
@@ -258,6 +260,7 @@ class MockVideoEncoder : public VideoEncoder {
   virtual ~MockVideoEncoder() { factory_->DestroyVideoEncoder(this); }
 
   const VideoCodec& codec() const { return codec_; }
+  int number_of_cores() const { return number_of_cores_; }
 
   void SendEncodedImage(int width, int height) {
     // Sends a fake image of the given width/height.
@@ -347,6 +350,7 @@ class MockVideoEncoder : public VideoEncoder {
   std::vector<VideoEncoder::ResolutionBitrateLimits> resolution_bitrate_limits;
 
   VideoCodec codec_;
+  int number_of_cores_ = 0;
   EncodedImageCallback* callback_;
 };
 
@@ -796,6 +800,63 @@ TEST_F(TestSimulcastEncoderAdapterFake, DoesNotLeakEncoders) {
 
 // This test verifies that an adapter reinit with the same codec settings as
 // before does not change the underlying encoder codec settings.
+TEST_F(TestSimulcastEncoderAdapterFake,
+       UpdatesActiveStreamsWithoutReinitializingOtherStreams) {
+  SetupCodec();
+  std::vector<MockVideoEncoder*> encoders = helper_->factory()->encoders();
+  ASSERT_EQ(3u, encoders.size());
+
+  // Deactivating a stream only releases its encoder, which is kept.
+  EXPECT_CALL(*encoders[0], Release()).Times(0);
+  EXPECT_CALL(*encoders[1], Release()).Times(0);
+  EXPECT_CALL(*encoders[2], Release()).WillOnce(Return(WEBRTC_VIDEO_CODEC_OK));
+  codec_.simulcastStream[2].active = false;
+  EXPECT_TRUE(adapter_->UpdateActiveStreams(codec_));
+  EXPECT_EQ(encoders, helper_->factory()->encoders());
+  ::testing::Mock::VerifyAndClearExpectations(encoders[2]);
+
+  const uint32_t target_bitrate =
+      1000 * (codec_.simulcastStream[0].targetBitrate +
+              codec_.simulcastStream[1].targetBitrate +
+              codec_.simulcastStream[2].minBitrate);
+  rtc::scoped_refptr<VideoFrameBuffer> buffer(I420Buffer::Create(1280, 720));
+  VideoFrame input_frame = VideoFrame::Builder()
+                               .set_video_frame_buffer(buffer)
+                               .set_timestamp_rtp(100)
+                               .set_timestamp_ms(1000)
+                               .build();
+  std::vector<VideoFrameType> frame_types(3, VideoFrameType::kVideoFrameDelta);
+  adapter_->SetRates(VideoEncoder::RateControlParameters(
+      rate_allocator_->Allocate(
+          VideoBitrateAllocationParameters(target_bitrate, 30)),
+      30.0));
+  EXPECT_CALL(*encoders[0], Encode(_, _))
+      .WillOnce(Return(WEBRTC_VIDEO_CODEC_OK));
+  EXPECT_CALL(*encoders[1], Encode(_, _))
+      .WillOnce(Return(WEBRTC_VIDEO_CODEC_OK));
+  EXPECT_CALL(*encoders[2], Encode(_, _)).Times(0);
+  EXPECT_EQ(0, adapter_->Encode(input_frame, &frame_types));
+
+  // Activating it again reuses its encoder.
+  codec_.simulcastStream[2].active = true;
+  EXPECT_TRUE(adapter_->UpdateActiveStreams(codec_));
+  EXPECT_EQ(encoders, helper_->factory()->encoders());
+  EXPECT_EQ(encoders[2]->codec().width, codec_.simulcastStream[2].width);
+  EXPECT_EQ(encoders[2]->codec().height, codec_.simulcastStream[2].height);
+  ::testing::Mock::VerifyAndClearExpectations(encoders[0]);
+  ::testing::Mock::VerifyAndClearExpectations(encoders[1]);
+}
+
+TEST_F(TestSimulcastEncoderAdapterFake,
+       DoesNotUpdateActiveStreamsOfSimulcastCapableEncoder) {
+  helper_->factory()->set_supports_simulcast(true);
+  SetupCodec();
+  ASSERT_EQ(1u, helper_->factory()->encoders().size());
+
+  codec_.simulcastStream[2].active = false;
+  EXPECT_FALSE(adapter_->UpdateActiveStreams(codec_));
+}
+
 TEST_F(TestSimulcastEncoderAdapterFake, ReinitDoesNotReorderEncoderSettings) {
   SetupCodec();
   VerifyCodecSettings();
@@ -1104,6 +1165,74 @@ TEST_F(TestSimulcastEncoderAdapterFake, NativeHandleForwardingOnlyIfSupported) {
   EXPECT_EQ(0, adapter_->Encode(input_frame, &frame_types));
 }
 
+// Buffer recording the width of the buffers scaled from.
+class ScaleRecordingBuffer : public VideoFrameBuffer {
+ public:
+  ScaleRecordingBuffer(int width, int height, std::vector<int>* scaled_from)
+      : width_(width), height_(height), scaled_from_(scaled_from) {}
+
+  Type type() const override { return Type::kNative; }
+  int width() const override { return width_; }
+  int height() const override { return height_; }
+  rtc::scoped_refptr<I420BufferInterface> ToI420() override { return nullptr; }
+
+  rtc::scoped_refptr<VideoFrameBuffer> CropAndScale(int offset_x,
+                                                    int offset_y,
+                                                    int crop_width,
+                                                    int crop_height,
+                                                    int scaled_width,
+                                                    int scaled_height) override {
+    scaled_from_->push_back(width_);
+    return rtc::make_ref_counted<ScaleRecordingBuffer>(
+        scaled_width, scaled_height, scaled_from_);
+  }
+
+ private:
+  const int width_;
+  const int height_;
+  std::vector<int>* const scaled_from_;
+};
+
+TEST_F(TestSimulcastEncoderAdapterFake, ScalesEachLayerFromNextLargerLayer) {
+  SimulcastTestFixtureImpl::DefaultSettings(
+      &codec_, static_cast<const int*>(kTestTemporalLayerProfile),
+      kVideoCodecVP8);
+  // High start bitrate, so all streams are enabled.
+  codec_.startBitrate = 3000;
+  EXPECT_EQ(0, adapter_->InitEncode(&codec_, kSettings));
+  adapter_->RegisterEncodeCompleteCallback(this);
+  ASSERT_EQ(3u, helper_->factory()->encoders().size());
+
+  std::vector<int> scaled_from;
+  rtc::scoped_refptr<VideoFrameBuffer> buffer(
+      rtc::make_ref_counted<ScaleRecordingBuffer>(kDefaultWidth, kDefaultHeight,
+                                                  &scaled_from));
+  VideoFrame input_frame = VideoFrame::Builder()
+                               .set_video_frame_buffer(buffer)
+                               .set_timestamp_rtp(100)
+                               .set_timestamp_ms(1000)
+                               .build();
+  std::vector<int> encoded_widths;
+  for (MockVideoEncoder* encoder : helper_->factory()->encoders()) {
+    EXPECT_CALL(*encoder, Encode)
+        .WillOnce([&](const VideoFrame& frame,
+                      const std::vector<VideoFrameType>* frame_types) {
+          encoded_widths.push_back(frame.width());
+          return 0;
+        });
+  }
+  std::vector<VideoFrameType> frame_types(3, VideoFrameType::kVideoFrameKey);
+  EXPECT_EQ(0, adapter_->Encode(input_frame, &frame_types));
+
+  // The layers are still encoded lowest first, but the middle layer is scaled
+  // from the input frame and the lowest layer from the middle layer.
+  EXPECT_THAT(encoded_widths, ::testing::ElementsAre(kDefaultWidth / 4,
+                                                     kDefaultWidth / 2,
+                                                     kDefaultWidth));
+  EXPECT_THAT(scaled_from,
+              ::testing::ElementsAre(kDefaultWidth, kDefaultWidth / 2));
+}
+
 TEST_F(TestSimulcastEncoderAdapterFake, GeneratesKeyFramesOnRequestedLayers) {
   // Set up common settings for three streams.
   SimulcastTestFixtureImpl::DefaultSettings(
@@ -1214,6 +1343,107 @@ TEST_F(TestSimulcastEncoderAdapterFake, TestFailureReturnCodesFromEncodeCalls) {
             adapter_->Encode(input_frame, &frame_types));
 }
 
+TEST_F(TestSimulcastEncoderAdapterFake,
+       EncodesLayersInParallelAndDeliversThemInOrder) {
+  test::ScopedKeyValueConfig field_trials(
+      field_trials_,
+      "WebRTC-Video-SimulcastParallelEncode/enabled:true,max_threads:3/");
+  SetUp();
+  SimulcastTestFixtureImpl::DefaultSettings(
+      &codec_, static_cast<const int*>(kTestTemporalLayerProfile),
+      kVideoCodecVP8);
+  codec_.startBitrate = 3000;
+  adapter_->RegisterEncodeCompleteCallback(this);
+  EXPECT_EQ(0, adapter_->InitEncode(
+                   &codec_, VideoEncoder::Settings(kCapabilities,
+                                                   /*number_of_cores=*/6,
+                                                   /*max_payload_size=*/1200)));
+  std::vector<MockVideoEncoder*> encoders = helper_->factory()->encoders();
+  ASSERT_EQ(3u, encoders.size());
+  for (MockVideoEncoder* encoder : encoders) {
+    EXPECT_EQ(encoder->number_of_cores(), 2);
+  }
+
+  // The lowest layer completes only after the highest one, which can only
+  // happen if they are encoded at the same time.
+  rtc::Event highest_layer_encoded;
+  std::vector<int> simulcast_indices;
+  class Callback : public EncodedImageCallback {
+   public:
+    explicit Callback(std::vector<int>* simulcast_indices)
+        : simulcast_indices_(simulcast_indices) {}
+    Result OnEncodedImage(
+        const EncodedImage& encoded_image,
+        const CodecSpecificInfo* codec_specific_info) override {
+      simulcast_indices_->push_back(encoded_image.SimulcastIndex().value_or(-1));
+      return Result(Result::OK);
+    }
+
+   private:
+    std::vector<int>* const simulcast_indices_;
+  } callback(&simulcast_indices);
+  adapter_->RegisterEncodeCompleteCallback(&callback);
+
+  EXPECT_CALL(*encoders[0], Encode)
+      .WillOnce([&](const VideoFrame& frame,
+                    const std::vector<VideoFrameType>* frame_types) {
+        EXPECT_TRUE(highest_layer_encoded.Wait(TimeDelta::Seconds(5)));
+        encoders[0]->SendEncodedImage(frame.width(), frame.height());
+        return WEBRTC_VIDEO_CODEC_OK;
+      });
+  EXPECT_CALL(*encoders[1], Encode)
+      .WillOnce([&](const VideoFrame& frame,
+                    const std::vector<VideoFrameType>* frame_types) {
+        encoders[1]->SendEncodedImage(frame.width(), frame.height());
+        return WEBRTC_VIDEO_CODEC_OK;
+      });
+  EXPECT_CALL(*encoders[2], Encode)
+      .WillOnce([&](const VideoFrame& frame,
+                    const std::vector<VideoFrameType>* frame_types) {
+        encoders[2]->SendEncodedImage(frame.width(), frame.height());
+        highest_layer_encoded.Set();
+        return WEBRTC_VIDEO_CODEC_OK;
+      });
+
+  rtc::scoped_refptr<I420Buffer> input_buffer =
+      I420Buffer::Create(kDefaultWidth, kDefaultHeight);
+  input_buffer->InitializeData();
+  VideoFrame input_frame = VideoFrame::Builder()
+                               .set_video_frame_buffer(input_buffer)
+                               .set_timestamp_rtp(0)
+                               .set_timestamp_us(0)
+                               .set_rotation(kVideoRotation_0)
+                               .build();
+  std::vector<VideoFrameType> frame_types(3, VideoFrameType::kVideoFrameKey);
+  EXPECT_EQ(0, adapter_->Encode(input_frame, &frame_types));
+  EXPECT_THAT(simulcast_indices, ::testing::ElementsAre(0, 1, 2));
+}
+
+TEST_F(TestSimulcastEncoderAdapterFake,
+       DoesNotEncodeHardwareLayersInParallel) {
+  test::ScopedKeyValueConfig field_trials(
+      field_trials_, "WebRTC-Video-SimulcastParallelEncode/enabled:true/");
+  SetUp();
+  SimulcastTestFixtureImpl::DefaultSettings(
+      &codec_, static_cast<const int*>(kTestTemporalLayerProfile),
+      kVideoCodecVP8);
+  const VideoEncoder::Settings settings(kCapabilities, /*number_of_cores=*/6,
+                                        /*max_payload_size=*/1200);
+  EXPECT_EQ(0, adapter_->InitEncode(&codec_, settings));
+  ASSERT_EQ(3u, helper_->factory()->encoders().size());
+  for (MockVideoEncoder* encoder : helper_->factory()->encoders()) {
+    EXPECT_EQ(encoder->number_of_cores(), 2);
+    encoder->set_is_hardware_accelerated(true);
+  }
+
+  // Encoders are reused by the next InitEncode().
+  EXPECT_EQ(0, adapter_->InitEncode(&codec_, settings));
+  ASSERT_EQ(3u, helper_->factory()->encoders().size());
+  for (MockVideoEncoder* encoder : helper_->factory()->encoders()) {
+    EXPECT_EQ(encoder->number_of_cores(), 6);
+  }
+}
+
 TEST_F(TestSimulcastEncoderAdapterFake, TestInitFailureCleansUpEncoders) {
   SimulcastTestFixtureImpl::DefaultSettings(
       &codec_, static_cast<const int*>(kTestTemporalLayerProfile),
@@ -1469,6 +1469,7 @@ bool WebRtcVideoSendChannel::AddSendStream(const StreamParams& sp) {
   config.encoder_settings.experiment_cpu_load_estimator =
       video_config_.experiment_cpu_load_estimator;
   config.encoder_settings.encoder_factory = encoder_factory_;
+  config.encoder_settings.share_encoder = video_config_.enable_shared_encoder;
   config.encoder_settings.bitrate_allocator_factory =
       bitrate_allocator_factory_;
   config.encoder_settings.encoder_switch_request_callback = this;
@@ -2339,6 +2340,7 @@ WebRtcVideoSendChannel::WebRtcVideoSendStream::GetPerLayerVideoSenderInfos(
     common_info.aggregated_framerate_sent = stats.encode_frame_rate;
     common_info.aggregated_huge_frames_sent = stats.huge_frames_sent;
     common_info.power_efficient_encoder = stats.power_efficient_encoder;
+    common_info.total_encode_cpu_time = stats.total_encode_cpu_time;
 
     // The normal case is that substreams are present, handled below. But if
     // substreams are missing (can happen before negotiated/connected where we
@@ -2580,6 +2582,12 @@ WebRtcVideoReceiveChannel::WebRtcVideoReceiveChannel(
     webrtc::VideoDecoderFactory* decoder_factory)
     : MediaChannelUtil(call->network_thread(), config.enable_dscp),
       worker_thread_(call->worker_thread()),
+      received_packets_(worker_thread_,
+                        task_safety_.flag(),
+                        [this](webrtc::RtpPacketReceived packet) {
+                          RTC_DCHECK_RUN_ON(&thread_checker_);
+                          ProcessReceivedPacket(std::move(packet));
+                        }),
       receiving_(false),
       call_(call),
       default_sink_(nullptr),
@@ -3064,11 +3072,7 @@ void WebRtcVideoReceiveChannel::OnPacketReceived(
   // TODO(crbug.com/1373439): Stop posting to the worker thread when the
   // combined network/worker project launches.
   if (webrtc::TaskQueueBase::Current() != worker_thread_) {
-    worker_thread_->PostTask(
-        SafeTask(task_safety_.flag(), [this, packet = packet]() mutable {
-          RTC_DCHECK_RUN_ON(&thread_checker_);
-          ProcessReceivedPacket(std::move(packet));
-        }));
+    received_packets_.OnPacketReceived(packet);
   } else {
     RTC_DCHECK_RUN_ON(&thread_checker_);
     ProcessReceivedPacket(packet);
@@ -3680,6 +3684,7 @@ WebRtcVideoReceiveChannel::WebRtcVideoReceiveStream::GetVideoReceiverInfo(
   info.qp_sum = stats.qp_sum;
   info.total_decode_time = stats.total_decode_time;
   info.total_processing_delay = stats.total_processing_delay;
+  info.total_decode_cpu_time = stats.total_decode_cpu_time;
   info.total_assembly_time = stats.total_assembly_time;
   info.frames_assembled_from_multiple_packets =
       stats.frames_assembled_from_multiple_packets;
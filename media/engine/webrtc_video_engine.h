@@ -62,6 +62,7 @@
 #include "media/base/media_config.h"
 #include "media/base/media_engine.h"
 #include "media/base/stream_params.h"
+#include "media/engine/received_rtp_packet_batcher.h"
 #include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
 #include "modules/rtp_rtcp/source/rtp_packet_received.h"
 #include "rtc_base/network/sent_packet.h"
@@ -794,6 +795,8 @@ class WebRtcVideoReceiveChannel : public MediaChannelUtil,
   // Variables.
   webrtc::TaskQueueBase* const worker_thread_;
   webrtc::ScopedTaskSafety task_safety_;
+  // Batches packets posted from the network thread to the worker thread.
+  ReceivedRtpPacketBatcher received_packets_;
   RTC_NO_UNIQUE_ADDRESS webrtc::SequenceChecker network_thread_checker_{
       webrtc::SequenceChecker::kDetached};
   RTC_NO_UNIQUE_ADDRESS webrtc::SequenceChecker thread_checker_;
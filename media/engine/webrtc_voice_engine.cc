@@ -801,6 +801,7 @@ class WebRtcVoiceSendChannel::WebRtcAudioSendStream : public AudioSource::Sink {
       const std::vector<webrtc::RtpExtension>& extensions,
       int max_send_bitrate_bps,
       int rtcp_report_interval_ms,
+      bool share_encoder,
       const absl::optional<std::string>& audio_network_adaptor_config,
       webrtc::Call* call,
       webrtc::Transport* send_transport,
@@ -811,6 +812,7 @@ class WebRtcVoiceSendChannel::WebRtcAudioSendStream : public AudioSource::Sink {
       : adaptive_ptime_config_(call->trials()),
         call_(call),
         config_(send_transport),
+        share_encoder_(share_encoder),
         max_send_bitrate_bps_(max_send_bitrate_bps),
         rtp_parameters_(CreateRtpParametersWithOneEncoding()) {
     RTC_DCHECK(call);
@@ -966,6 +968,11 @@ class WebRtcVoiceSendChannel::WebRtcAudioSendStream : public AudioSource::Sink {
     }
     source->SetSink(this);
     source_ = source;
+    if (share_encoder_) {
+      // Streams sending the same source can share their encoder.
+      config_.shared_encoder_source = source;
+      ReconfigureAudioSendStream(nullptr);
+    }
     UpdateSendState();
   }
 
@@ -1190,6 +1197,7 @@ class WebRtcVoiceSendChannel::WebRtcAudioSendStream : public AudioSource::Sink {
   // PeerConnection will make sure invalidating the pointer before the object
   // goes away.
   AudioSource* source_ = nullptr;
+  const bool share_encoder_;
   bool send_ = false;
   bool muted_ = false;
   int max_send_bitrate_bps_;
@@ -1541,7 +1549,8 @@ bool WebRtcVoiceSendChannel::AddSendStream(const StreamParams& sp) {
   WebRtcAudioSendStream* stream = new WebRtcAudioSendStream(
       ssrc, mid_, sp.cname, sp.id, send_codec_spec_, ExtmapAllowMixed(),
       send_rtp_extensions_, max_send_bitrate_bps_,
-      audio_config_.rtcp_report_interval_ms, audio_network_adaptor_config,
+      audio_config_.rtcp_report_interval_ms,
+      audio_config_.enable_shared_encoder, audio_network_adaptor_config,
       call_, transport(), engine()->encoder_factory_, codec_pair_id_, nullptr,
       crypto_options_);
   send_streams_.insert(std::make_pair(ssrc, stream));
@@ -2019,6 +2028,11 @@ WebRtcVoiceReceiveChannel::WebRtcVoiceReceiveChannel(
     webrtc::AudioCodecPairId codec_pair_id)
     : MediaChannelUtil(call->network_thread(), config.enable_dscp),
       worker_thread_(call->worker_thread()),
+      received_packets_(worker_thread_,
+                        task_safety_.flag(),
+                        [this](webrtc::RtpPacketReceived packet) {
+                          ProcessReceivedPacket(std::move(packet));
+                        }),
       engine_(engine),
       call_(call),
       audio_config_(config.audio),
@@ -2447,27 +2461,28 @@ void WebRtcVoiceReceiveChannel::OnPacketReceived(
   // call_->Receiver() to a common implementation and provide a callback on
   // the worker thread for the exception case (DELIVERY_UNKNOWN_SSRC) and
   // how retry is attempted.
-  worker_thread_->PostTask(
-      SafeTask(task_safety_.flag(), [this, packet = packet]() mutable {
-        RTC_DCHECK_RUN_ON(worker_thread_);
+  received_packets_.OnPacketReceived(packet);
+}
 
-        // TODO(bugs.webrtc.org/7135): extensions in `packet` is currently set
-        // in RtpTransport and does not neccessarily include extensions specific
-        // to this channel/MID. Also see comment in
-        // BaseChannel::MaybeUpdateDemuxerAndRtpExtensions_w.
-        // It would likely be good if extensions where merged per BUNDLE and
-        // applied directly in RtpTransport::DemuxPacket;
-        packet.IdentifyExtensions(recv_rtp_extension_map_);
-        if (!packet.arrival_time().IsFinite()) {
-          packet.set_arrival_time(webrtc::Timestamp::Micros(rtc::TimeMicros()));
-        }
+void WebRtcVoiceReceiveChannel::ProcessReceivedPacket(
+    webrtc::RtpPacketReceived packet) {
+  RTC_DCHECK_RUN_ON(worker_thread_);
 
-        call_->Receiver()->DeliverRtpPacket(
-            webrtc::MediaType::AUDIO, std::move(packet),
-            absl::bind_front(
-                &WebRtcVoiceReceiveChannel::MaybeCreateDefaultReceiveStream,
-                this));
-      }));
+  // TODO(bugs.webrtc.org/7135): extensions in `packet` is currently set
+  // in RtpTransport and does not neccessarily include extensions specific
+  // to this channel/MID. Also see comment in
+  // BaseChannel::MaybeUpdateDemuxerAndRtpExtensions_w.
+  // It would likely be good if extensions where merged per BUNDLE and
+  // applied directly in RtpTransport::DemuxPacket;
+  packet.IdentifyExtensions(recv_rtp_extension_map_);
+  if (!packet.arrival_time().IsFinite()) {
+    packet.set_arrival_time(webrtc::Timestamp::Micros(rtc::TimeMicros()));
+  }
+
+  call_->Receiver()->DeliverRtpPacket(
+      webrtc::MediaType::AUDIO, std::move(packet),
+      absl::bind_front(
+          &WebRtcVoiceReceiveChannel::MaybeCreateDefaultReceiveStream, this));
 }
 
 bool WebRtcVoiceReceiveChannel::MaybeCreateDefaultReceiveStream(
@@ -2603,6 +2618,7 @@ bool WebRtcVoiceReceiveChannel::GetStats(VoiceMediaReceiveInfo* info,
         stats.relative_packet_arrival_delay_seconds;
     rinfo.interruption_count = stats.interruption_count;
     rinfo.total_interruption_duration_ms = stats.total_interruption_duration_ms;
+    rinfo.total_decode_cpu_time = stats.total_decode_cpu_time;
     rinfo.last_sender_report_timestamp_ms =
         stats.last_sender_report_timestamp_ms;
     rinfo.last_sender_report_remote_timestamp_ms =
@@ -57,6 +57,7 @@
 #include "media/base/media_engine.h"
 #include "media/base/rtp_utils.h"
 #include "media/base/stream_params.h"
+#include "media/engine/received_rtp_packet_batcher.h"
 #include "modules/async_audio_processing/async_audio_processing.h"
 #include "modules/audio_device/include/audio_device.h"
 #include "modules/audio_processing/include/audio_processing.h"
@@ -439,12 +440,15 @@ class WebRtcVoiceReceiveChannel final
   // can not be demuxed. Returns true if a default receive stream has been
   // created.
   bool MaybeCreateDefaultReceiveStream(const webrtc::RtpPacketReceived& packet);
+  void ProcessReceivedPacket(webrtc::RtpPacketReceived packet);
   // Check if 'ssrc' is an unsignaled stream, and if so mark it as not being
   // unsignaled anymore (i.e. it is now removed, or signaled), and return true.
   bool MaybeDeregisterUnsignaledRecvStream(uint32_t ssrc);
 
   webrtc::TaskQueueBase* const worker_thread_;
   webrtc::ScopedTaskSafety task_safety_;
+  // Batches packets posted from the network thread to the worker thread.
+  ReceivedRtpPacketBatcher received_packets_;
   webrtc::SequenceChecker network_thread_checker_{
       webrtc::SequenceChecker::kDetached};
 
@@ -32,6 +32,7 @@
 #include "rtc_base/thread.h"
 #include "rtc_base/trace_event.h"
 #include "system_wrappers/include/clock.h"
+#include "system_wrappers/include/field_trial.h"
 
 namespace webrtc {
 
@@ -45,6 +46,32 @@ using ::dcsctp::SendPacketStatus;
 constexpr dcsctp::DurationMs kMaxTimerBackoffDuration =
     dcsctp::DurationMs(3000);
 
+// When enabled, the SCTP association is tuned for bulk transfers (e.g. file
+// transfers) over paths with a large bandwidth-delay product, where the
+// default buffer sizes and the conservative congestion window growth limit the
+// throughput of a single reliable data channel.
+constexpr char kBulkTransferFieldTrial[] = "WebRTC-DataChannelBulkTransfer";
+
+void ApplyBulkTransferProfile(dcsctp::DcSctpOptions& options) {
+  // Allows for ~1 Gbps at 100 ms RTT. The advertised receiver window shrinks
+  // as the reassembly queue fills up, so a slow reader still throttles the
+  // sender.
+  options.max_receiver_window_buffer_size = 16 * 1024 * 1024;
+  options.max_send_buffer_size = 16 * 1024 * 1024;
+  // Compensates for delayed acknowledgements in slow start, and recovers
+  // faster after packet loss. Bursts are still limited by `max_burst`.
+  options.slow_start_cwnd_increase_mtus = 2;
+  options.congestion_avoidance_cwnd_increase_mtus = 4;
+  // A SACK is sent for every second packet anyway; this only affects the last
+  // packet of a flight, which would otherwise stall the sender for long.
+  options.delayed_ack_max_timeout = dcsctp::DurationMs(50);
+}
+
+// When enabled, the SCTP association offers the zero checksum extension, and
+// packets are sent without a CRC32c checksum if the peer accepts it. Integrity
+// is already provided by DTLS (RFC 8261), so the checksum is pure overhead.
+constexpr char kZeroChecksumFieldTrial[] = "WebRTC-DataChannelZeroChecksum";
+
 enum class WebrtcPPID : dcsctp::PPID::UnderlyingType {
   // https://www.rfc-editor.org/rfc/rfc8832.html#section-8.1
   kDCEP = 50,
@@ -191,6 +218,11 @@ bool DcSctpTransport::Start(int local_sctp_port,
     // Don't close the connection automatically on too many retransmissions.
     options.max_retransmissions = absl::nullopt;
     options.max_init_retransmits = absl::nullopt;
+    if (field_trial::IsEnabled(kBulkTransferFieldTrial)) {
+      ApplyBulkTransferProfile(options);
+    }
+    options.enable_zero_checksum =
+        field_trial::IsEnabled(kZeroChecksumFieldTrial);
 
     std::unique_ptr<dcsctp::PacketObserver> packet_observer;
     if (RTC_LOG_CHECK_LEVEL(LS_VERBOSE)) {
@@ -381,6 +413,32 @@ void DcSctpTransport::set_debug_name_for_testing(const char* debug_name) {
 SendPacketStatus DcSctpTransport::SendPacketWithStatus(
     rtc::ArrayView<const uint8_t> data) {
   RTC_DCHECK_RUN_ON(network_thread_);
+  return SendPacketWithOptions(data, rtc::PacketOptions());
+}
+
+std::vector<SendPacketStatus> DcSctpTransport::SendPacketsWithStatus(
+    rtc::ArrayView<const rtc::ArrayView<const uint8_t>> packets) {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  std::vector<SendPacketStatus> statuses;
+  statuses.reserve(packets.size());
+  // Lets the UDP socket collect the (encrypted) packets and send them with a
+  // single system call when the last one arrives.
+  rtc::PacketOptions options;
+  options.batchable = true;
+  for (size_t i = 0; i < packets.size(); ++i) {
+    options.last_packet_in_batch = i == packets.size() - 1;
+    statuses.push_back(SendPacketWithOptions(packets[i], options));
+    if (statuses.back() != SendPacketStatus::kSuccess) {
+      break;
+    }
+  }
+  return statuses;
+}
+
+SendPacketStatus DcSctpTransport::SendPacketWithOptions(
+    rtc::ArrayView<const uint8_t> data,
+    const rtc::PacketOptions& options) {
+  RTC_DCHECK_RUN_ON(network_thread_);
   RTC_DCHECK(socket_);
 
   if (data.size() > (socket_->options().mtu)) {
@@ -401,7 +459,7 @@ SendPacketStatus DcSctpTransport::SendPacketWithStatus(
 
   auto result =
       transport_->SendPacket(reinterpret_cast<const char*>(data.data()),
-                             data.size(), rtc::PacketOptions(), 0);
+                             data.size(), options, 0);
 
   if (result < 0) {
     RTC_LOG(LS_WARNING) << debug_name_ << "->SendPacket(length=" << data.size()
@@ -13,6 +13,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
@@ -25,6 +26,7 @@
 #include "net/dcsctp/public/types.h"
 #include "net/dcsctp/timer/task_queue_timeout.h"
 #include "p2p/base/packet_transport_internal.h"
+#include "rtc_base/async_packet_socket.h"
 #include "rtc_base/containers/flat_map.h"
 #include "rtc_base/copy_on_write_buffer.h"
 #include "rtc_base/random.h"
@@ -70,6 +72,8 @@ class DcSctpTransport : public cricket::SctpTransportInternal,
   // dcsctp::DcSctpSocketCallbacks
   dcsctp::SendPacketStatus SendPacketWithStatus(
       rtc::ArrayView<const uint8_t> data) override;
+  std::vector<dcsctp::SendPacketStatus> SendPacketsWithStatus(
+      rtc::ArrayView<const rtc::ArrayView<const uint8_t>> packets) override;
   std::unique_ptr<dcsctp::Timeout> CreateTimeout(
       TaskQueueBase::DelayPrecision precision) override;
   dcsctp::TimeMs TimeMillis() override;
@@ -101,6 +105,9 @@ class DcSctpTransport : public cricket::SctpTransportInternal,
   void OnTransportClosed(rtc::PacketTransportInternal* transport);
 
   void MaybeConnectSocket();
+  dcsctp::SendPacketStatus SendPacketWithOptions(
+      rtc::ArrayView<const uint8_t> data,
+      const rtc::PacketOptions& options);
 
   rtc::Thread* network_thread_;
   rtc::PacketTransportInternal* transport_;
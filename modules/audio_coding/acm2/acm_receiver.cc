@@ -46,6 +46,33 @@ std::unique_ptr<NetEq> CreateNetEq(
   return DefaultNetEqFactory().CreateNetEq(config, decoder_factory, clock);
 }
 
+void AddLifetimeStatistics(const NetEqLifetimeStatistics& stats,
+                           NetEqLifetimeStatistics& sum) {
+  sum.total_samples_received += stats.total_samples_received;
+  sum.concealed_samples += stats.concealed_samples;
+  sum.concealment_events += stats.concealment_events;
+  sum.jitter_buffer_delay_ms += stats.jitter_buffer_delay_ms;
+  sum.jitter_buffer_emitted_count += stats.jitter_buffer_emitted_count;
+  sum.jitter_buffer_target_delay_ms += stats.jitter_buffer_target_delay_ms;
+  sum.jitter_buffer_minimum_delay_ms += stats.jitter_buffer_minimum_delay_ms;
+  sum.inserted_samples_for_deceleration +=
+      stats.inserted_samples_for_deceleration;
+  sum.removed_samples_for_acceleration +=
+      stats.removed_samples_for_acceleration;
+  sum.silent_concealed_samples += stats.silent_concealed_samples;
+  sum.fec_packets_received += stats.fec_packets_received;
+  sum.fec_packets_discarded += stats.fec_packets_discarded;
+  sum.packets_discarded += stats.packets_discarded;
+  sum.delayed_packet_outage_samples += stats.delayed_packet_outage_samples;
+  sum.delayed_packet_outage_events += stats.delayed_packet_outage_events;
+  sum.relative_packet_arrival_delay_ms +=
+      stats.relative_packet_arrival_delay_ms;
+  sum.jitter_buffer_packets_received += stats.jitter_buffer_packets_received;
+  sum.interruption_count += stats.interruption_count;
+  sum.total_interruption_duration_ms += stats.total_interruption_duration_ms;
+  sum.generated_noise_samples += stats.generated_noise_samples;
+}
+
 }  // namespace
 
 AcmReceiver::Config::Config(
@@ -56,38 +83,57 @@ AcmReceiver::Config::Config(const Config&) = default;
 AcmReceiver::Config::~Config() = default;
 
 AcmReceiver::AcmReceiver(const Config& config)
-    : last_audio_buffer_(new int16_t[AudioFrame::kMaxDataSizeSamples]),
-      neteq_(CreateNetEq(config.neteq_factory,
-                         config.neteq_config,
-                         &config.clock,
-                         config.decoder_factory)),
+    : neteq_config_(config.neteq_config),
+      neteq_factory_(config.neteq_factory),
+      decoder_factory_(config.decoder_factory),
+      neteq_idle_release_time_(config.neteq_idle_release_time),
+      last_audio_buffer_(new int16_t[AudioFrame::kMaxDataSizeSamples]),
       clock_(config.clock),
       resampled_last_output_frame_(true) {
   memset(last_audio_buffer_.get(), 0,
          sizeof(int16_t) * AudioFrame::kMaxDataSizeSamples);
+  if (!config.create_neteq_on_first_packet) {
+    MutexLock lock(&neteq_mutex_);
+    InstantiateNetEq();
+  }
 }
 
 AcmReceiver::~AcmReceiver() = default;
 
 int AcmReceiver::SetMinimumDelay(int delay_ms) {
-  if (neteq_->SetMinimumDelay(delay_ms))
+  MutexLock lock(&neteq_mutex_);
+  if (!neteq_ || neteq_->SetMinimumDelay(delay_ms)) {
+    minimum_delay_ms_ = delay_ms;
     return 0;
+  }
   RTC_LOG(LS_ERROR) << "AcmReceiver::SetExtraDelay " << delay_ms;
   return -1;
 }
 
 int AcmReceiver::SetMaximumDelay(int delay_ms) {
-  if (neteq_->SetMaximumDelay(delay_ms))
+  MutexLock lock(&neteq_mutex_);
+  if (!neteq_ || neteq_->SetMaximumDelay(delay_ms)) {
+    maximum_delay_ms_ = delay_ms;
     return 0;
+  }
   RTC_LOG(LS_ERROR) << "AcmReceiver::SetExtraDelay " << delay_ms;
   return -1;
 }
 
 bool AcmReceiver::SetBaseMinimumDelayMs(int delay_ms) {
-  return neteq_->SetBaseMinimumDelayMs(delay_ms);
+  MutexLock lock(&neteq_mutex_);
+  if (neteq_ && !neteq_->SetBaseMinimumDelayMs(delay_ms)) {
+    return false;
+  }
+  base_minimum_delay_ms_ = delay_ms;
+  return true;
 }
 
 int AcmReceiver::GetBaseMinimumDelayMs() const {
+  MutexLock lock(&neteq_mutex_);
+  if (!neteq_) {
+    return base_minimum_delay_ms_.value_or(neteq_config_.min_delay_ms);
+  }
   return neteq_->GetBaseMinimumDelayMs();
 }
 
@@ -100,16 +146,38 @@ absl::optional<int> AcmReceiver::last_packet_sample_rate_hz() const {
 }
 
 int AcmReceiver::last_output_sample_rate_hz() const {
+  MutexLock lock(&neteq_mutex_);
+  if (!neteq_) {
+    return neteq_config_.sample_rate_hz;
+  }
   return neteq_->last_output_sample_rate_hz();
 }
 
 int AcmReceiver::InsertPacket(const RTPHeader& rtp_header,
                               rtc::ArrayView<const uint8_t> incoming_payload) {
+  MutexLock neteq_lock(&neteq_mutex_);
   if (incoming_payload.empty()) {
-    neteq_->InsertEmptyPacket(rtp_header);
+    if (neteq_) {
+      neteq_->InsertEmptyPacket(rtp_header);
+    }
     return 0;
   }
 
+  if (!neteq_) {
+    auto it = codecs_.find(rtp_header.payloadType);
+    if (it == codecs_.end()) {
+      RTC_LOG_F(LS_ERROR) << "Payload-type "
+                          << static_cast<int>(rtp_header.payloadType)
+                          << " is not registered.";
+      return -1;
+    }
+    if (absl::EqualsIgnoreCase(it->second.name, "cn")) {
+      // Comfort noise alone doesn't start playout.
+      return 0;
+    }
+    InstantiateNetEq();
+  }
+
   int payload_type = rtp_header.payloadType;
   auto format = neteq_->GetDecoderFormat(payload_type);
   if (format && absl::EqualsIgnoreCase(format->sdp_format.name, "red")) {
@@ -132,6 +200,7 @@ int AcmReceiver::InsertPacket(const RTPHeader& rtp_header,
         return 0;
       }
     } else {
+      last_audio_packet_time_ = clock_.CurrentTime();
       last_decoder_ = DecoderInfo{/*payload_type=*/payload_type,
                                   /*sample_rate_hz=*/format->sample_rate_hz,
                                   /*num_channels=*/format->num_channels,
@@ -154,10 +223,18 @@ int AcmReceiver::GetAudio(int desired_freq_hz,
   RTC_DCHECK(muted);
 
   int current_sample_rate_hz = 0;
-  if (neteq_->GetAudio(audio_frame, muted, &current_sample_rate_hz) !=
-      NetEq::kOK) {
-    RTC_LOG(LS_ERROR) << "AcmReceiver::GetAudio - NetEq Failed.";
-    return -1;
+  {
+    MutexLock neteq_lock(&neteq_mutex_);
+    MaybeReleaseNetEq();
+    if (!neteq_) {
+      GetSilence(desired_freq_hz, audio_frame, muted);
+      return 0;
+    }
+    if (neteq_->GetAudio(audio_frame, muted, &current_sample_rate_hz) !=
+        NetEq::kOK) {
+      RTC_LOG(LS_ERROR) << "AcmReceiver::GetAudio - NetEq Failed.";
+      return -1;
+    }
   }
 
   RTC_DCHECK_NE(current_sample_rate_hz, 0);
@@ -217,29 +294,51 @@ int AcmReceiver::GetAudio(int desired_freq_hz,
 }
 
 void AcmReceiver::SetCodecs(const std::map<int, SdpAudioFormat>& codecs) {
-  neteq_->SetCodecs(codecs);
+  MutexLock lock(&neteq_mutex_);
+  codecs_ = codecs;
+  if (neteq_) {
+    neteq_->SetCodecs(codecs);
+  }
 }
 
 void AcmReceiver::FlushBuffers() {
-  neteq_->FlushBuffers();
+  MutexLock lock(&neteq_mutex_);
+  if (neteq_) {
+    neteq_->FlushBuffers();
+  }
 }
 
 void AcmReceiver::RemoveAllCodecs() {
+  MutexLock neteq_lock(&neteq_mutex_);
   MutexLock lock(&mutex_);
-  neteq_->RemoveAllPayloadTypes();
+  codecs_.clear();
+  if (neteq_) {
+    neteq_->RemoveAllPayloadTypes();
+  }
   last_decoder_ = absl::nullopt;
 }
 
 absl::optional<uint32_t> AcmReceiver::GetPlayoutTimestamp() {
+  MutexLock lock(&neteq_mutex_);
+  if (!neteq_) {
+    return absl::nullopt;
+  }
   return neteq_->GetPlayoutTimestamp();
 }
 
 int AcmReceiver::FilteredCurrentDelayMs() const {
-  return neteq_->FilteredCurrentDelayMs();
+  MutexLock lock(&neteq_mutex_);
+  return neteq_ ? neteq_->FilteredCurrentDelayMs() : 0;
 }
 
 int AcmReceiver::TargetDelayMs() const {
-  return neteq_->TargetDelayMs();
+  MutexLock lock(&neteq_mutex_);
+  return neteq_ ? neteq_->TargetDelayMs() : 0;
+}
+
+size_t AcmReceiver::GetMemoryUsageBytes() const {
+  MutexLock lock(&neteq_mutex_);
+  return neteq_ ? neteq_->GetMemoryUsageBytes() : 0;
 }
 
 absl::optional<std::pair<int, SdpAudioFormat>> AcmReceiver::LastDecoder()
@@ -255,8 +354,19 @@ absl::optional<std::pair<int, SdpAudioFormat>> AcmReceiver::LastDecoder()
 void AcmReceiver::GetNetworkStatistics(
     NetworkStatistics* acm_stat,
     bool get_and_clear_legacy_stats /* = true */) const {
-  NetEqNetworkStatistics neteq_stat;
-  if (get_and_clear_legacy_stats) {
+  MutexLock lock(&neteq_mutex_);
+  NetEqNetworkStatistics neteq_stat = {};
+  if (!neteq_) {
+    // Same as for a NetEq that hasn't received any packets.
+    acm_stat->currentExpandRate = 0;
+    acm_stat->currentSpeechExpandRate = 0;
+    acm_stat->currentPreemptiveRate = 0;
+    acm_stat->currentAccelerateRate = 0;
+    acm_stat->currentSecondaryDecodedRate = 0;
+    acm_stat->currentSecondaryDiscardedRate = 0;
+    acm_stat->meanWaitingTimeMs = -1;
+    acm_stat->maxWaitingTimeMs = -1;
+  } else if (get_and_clear_legacy_stats) {
     // NetEq function always returns zero, so we don't check the return value.
     neteq_->NetworkStatistics(&neteq_stat);
 
@@ -284,7 +394,14 @@ void AcmReceiver::GetNetworkStatistics(
   acm_stat->preferredBufferSize = neteq_stat.preferred_buffer_size_ms;
   acm_stat->jitterPeaksFound = neteq_stat.jitter_peaks_found ? true : false;
 
-  NetEqLifetimeStatistics neteq_lifetime_stat = neteq_->GetLifetimeStatistics();
+  NetEqLifetimeStatistics neteq_lifetime_stat = released_lifetime_stats_;
+  uint64_t packet_buffer_flushes = released_packet_buffer_flushes_;
+  if (neteq_) {
+    AddLifetimeStatistics(neteq_->GetLifetimeStatistics(),
+                          neteq_lifetime_stat);
+    packet_buffer_flushes +=
+        neteq_->GetOperationsAndState().packet_buffer_flushes;
+  }
   acm_stat->totalSamplesReceived = neteq_lifetime_stat.total_samples_received;
   acm_stat->concealedSamples = neteq_lifetime_stat.concealed_samples;
   acm_stat->silentConcealedSamples =
@@ -311,32 +428,101 @@ void AcmReceiver::GetNetworkStatistics(
   acm_stat->fecPacketsReceived = neteq_lifetime_stat.fec_packets_received;
   acm_stat->fecPacketsDiscarded = neteq_lifetime_stat.fec_packets_discarded;
   acm_stat->packetsDiscarded = neteq_lifetime_stat.packets_discarded;
-
-  NetEqOperationsAndState neteq_operations_and_state =
-      neteq_->GetOperationsAndState();
-  acm_stat->packetBufferFlushes =
-      neteq_operations_and_state.packet_buffer_flushes;
+  acm_stat->packetBufferFlushes = packet_buffer_flushes;
 }
 
 int AcmReceiver::EnableNack(size_t max_nack_list_size) {
-  neteq_->EnableNack(max_nack_list_size);
+  MutexLock lock(&neteq_mutex_);
+  if (neteq_) {
+    neteq_->EnableNack(max_nack_list_size);
+  }
+  max_nack_list_size_ = max_nack_list_size;
   return 0;
 }
 
 void AcmReceiver::DisableNack() {
-  neteq_->DisableNack();
+  MutexLock lock(&neteq_mutex_);
+  if (neteq_) {
+    neteq_->DisableNack();
+  }
+  max_nack_list_size_ = absl::nullopt;
 }
 
 std::vector<uint16_t> AcmReceiver::GetNackList(
     int64_t round_trip_time_ms) const {
+  MutexLock lock(&neteq_mutex_);
+  if (!neteq_) {
+    return {};
+  }
   return neteq_->GetNackList(round_trip_time_ms);
 }
 
 void AcmReceiver::ResetInitialDelay() {
-  neteq_->SetMinimumDelay(0);
+  MutexLock lock(&neteq_mutex_);
+  if (neteq_) {
+    neteq_->SetMinimumDelay(0);
+  }
+  minimum_delay_ms_ = 0;
   // TODO(turajs): Should NetEq Buffer be flushed?
 }
 
+void AcmReceiver::InstantiateNetEq() {
+  RTC_DCHECK(!neteq_);
+  neteq_ =
+      CreateNetEq(neteq_factory_, neteq_config_, &clock_, decoder_factory_);
+  neteq_->SetCodecs(codecs_);
+  if (base_minimum_delay_ms_) {
+    neteq_->SetBaseMinimumDelayMs(*base_minimum_delay_ms_);
+  }
+  if (maximum_delay_ms_) {
+    neteq_->SetMaximumDelay(*maximum_delay_ms_);
+  }
+  if (minimum_delay_ms_) {
+    neteq_->SetMinimumDelay(*minimum_delay_ms_);
+  }
+  if (max_nack_list_size_) {
+    neteq_->EnableNack(*max_nack_list_size_);
+  }
+  last_audio_packet_time_ = clock_.CurrentTime();
+}
+
+void AcmReceiver::MaybeReleaseNetEq() {
+  if (!neteq_ || !neteq_idle_release_time_ ||
+      clock_.CurrentTime() - last_audio_packet_time_ <
+          *neteq_idle_release_time_) {
+    return;
+  }
+  AddLifetimeStatistics(neteq_->GetLifetimeStatistics(),
+                        released_lifetime_stats_);
+  released_packet_buffer_flushes_ +=
+      neteq_->GetOperationsAndState().packet_buffer_flushes;
+  neteq_ = nullptr;
+  RTC_LOG(LS_INFO) << "Released NetEq after "
+                   << ToString(*neteq_idle_release_time_)
+                   << " without audio packets.";
+}
+
+void AcmReceiver::GetSilence(int desired_freq_hz,
+                             AudioFrame* audio_frame,
+                             bool* muted) {
+  const int sample_rate_hz =
+      desired_freq_hz != -1 ? desired_freq_hz : neteq_config_.sample_rate_hz;
+  audio_frame->Reset();
+  RTC_DCHECK(audio_frame->muted());
+  audio_frame->sample_rate_hz_ = sample_rate_hz;
+  audio_frame->samples_per_channel_ =
+      rtc::CheckedDivExact(sample_rate_hz, 100);
+  audio_frame->num_channels_ = 1;
+  *muted = true;
+
+  MutexLock lock(&mutex_);
+  // Primes the resampler with silence once there is a NetEq again.
+  memset(last_audio_buffer_.get(), 0,
+         sizeof(int16_t) * AudioFrame::kMaxDataSizeSamples);
+  resampled_last_output_frame_ = false;
+  call_stats_.DecodedBySilenceGenerator();
+}
+
 uint32_t AcmReceiver::NowInTimestamp(int decoder_sampling_rate) const {
   // Down-cast the time to (32-6)-bit since we only care about
   // the least significant bits. (32-6) bits cover 2^(32-6) = 67108864 ms.
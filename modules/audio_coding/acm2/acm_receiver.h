@@ -26,6 +26,8 @@
 #include "api/audio_codecs/audio_format.h"
 #include "api/neteq/neteq.h"
 #include "api/neteq/neteq_factory.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
 #include "modules/audio_coding/acm2/acm_resampler.h"
 #include "modules/audio_coding/acm2/call_statistics.h"
 #include "modules/audio_coding/include/audio_coding_module_typedefs.h"
@@ -52,6 +54,15 @@ class AcmReceiver {
     Clock& clock;
     rtc::scoped_refptr<AudioDecoderFactory> decoder_factory;
     NetEqFactory* neteq_factory = nullptr;
+    // If true, NetEq and its decoders are not created until the first packet
+    // that carries audio other than comfort noise is inserted. Until then,
+    // GetAudio() outputs muted frames.
+    bool create_neteq_on_first_packet = false;
+    // If set, NetEq and its decoders are released when no packet carrying
+    // audio other than comfort noise has been inserted for this long, and are
+    // created again by the next one. Lifetime statistics and the settings
+    // made through this class carry over to the new NetEq.
+    absl::optional<TimeDelta> neteq_idle_release_time;
   };
 
   // Constructor of the class
@@ -144,7 +155,8 @@ class AcmReceiver {
   // packet was inserted, the return value is empty.
   absl::optional<int> last_packet_sample_rate_hz() const;
 
-  // Returns last_output_sample_rate_hz from the NetEq instance.
+  // Returns last_output_sample_rate_hz from the NetEq instance, or the initial
+  // sample rate from its config while there is none.
   int last_output_sample_rate_hz() const;
 
   //
@@ -181,6 +193,10 @@ class AcmReceiver {
   //
   int TargetDelayMs() const;
 
+  // Returns the bytes held by the NetEq packet buffer and audio buffers.
+  //
+  size_t GetMemoryUsageBytes() const;
+
   //
   // Get payload type and format of the last non-CNG/non-DTMF received payload.
   // If no non-CNG/non-DTMF packet is received absl::nullopt is returned.
@@ -228,12 +244,40 @@ class AcmReceiver {
 
   uint32_t NowInTimestamp(int decoder_sampling_rate) const;
 
+  // Creates `neteq_` and applies the settings made so far to it.
+  void InstantiateNetEq() RTC_EXCLUSIVE_LOCKS_REQUIRED(neteq_mutex_);
+  // Releases `neteq_` if it has been idle for `neteq_idle_release_time_`.
+  void MaybeReleaseNetEq() RTC_EXCLUSIVE_LOCKS_REQUIRED(neteq_mutex_);
+  // Outputs 10 ms of silence while there is no NetEq.
+  void GetSilence(int desired_freq_hz, AudioFrame* audio_frame, bool* muted)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(neteq_mutex_);
+
+  const NetEq::Config neteq_config_;
+  NetEqFactory* const neteq_factory_;
+  const rtc::scoped_refptr<AudioDecoderFactory> decoder_factory_;
+  const absl::optional<TimeDelta> neteq_idle_release_time_;
+
+  // Only guards the `neteq_` pointer, which is replaced when NetEq is created
+  // lazily or released, and the settings to apply to a new NetEq. NetEq itself
+  // is thread-safe.
+  mutable Mutex neteq_mutex_ RTC_ACQUIRED_BEFORE(mutex_);
+  std::unique_ptr<NetEq> neteq_ RTC_GUARDED_BY(neteq_mutex_);
+  std::map<int, SdpAudioFormat> codecs_ RTC_GUARDED_BY(neteq_mutex_);
+  absl::optional<int> minimum_delay_ms_ RTC_GUARDED_BY(neteq_mutex_);
+  absl::optional<int> maximum_delay_ms_ RTC_GUARDED_BY(neteq_mutex_);
+  absl::optional<int> base_minimum_delay_ms_ RTC_GUARDED_BY(neteq_mutex_);
+  absl::optional<size_t> max_nack_list_size_ RTC_GUARDED_BY(neteq_mutex_);
+  Timestamp last_audio_packet_time_ RTC_GUARDED_BY(neteq_mutex_) =
+      Timestamp::MinusInfinity();
+  // Counters of the NetEq instances released so far.
+  NetEqLifetimeStatistics released_lifetime_stats_ RTC_GUARDED_BY(neteq_mutex_);
+  uint64_t released_packet_buffer_flushes_ RTC_GUARDED_BY(neteq_mutex_) = 0;
+
   mutable Mutex mutex_;
   absl::optional<DecoderInfo> last_decoder_ RTC_GUARDED_BY(mutex_);
   ACMResampler resampler_ RTC_GUARDED_BY(mutex_);
   std::unique_ptr<int16_t[]> last_audio_buffer_ RTC_GUARDED_BY(mutex_);
   CallStatistics call_stats_ RTC_GUARDED_BY(mutex_);
-  const std::unique_ptr<NetEq> neteq_;  // NetEq is thread-safe; no lock needed.
   Clock& clock_;
   bool resampled_last_output_frame_ RTC_GUARDED_BY(mutex_);
 };
@@ -16,6 +16,7 @@
 #include "absl/types/optional.h"
 #include "api/audio_codecs/builtin_audio_decoder_factory.h"
 #include "api/audio_codecs/builtin_audio_encoder_factory.h"
+#include "api/units/time_delta.h"
 #include "modules/audio_coding/codecs/cng/audio_encoder_cng.h"
 #include "modules/audio_coding/include/audio_coding_module.h"
 #include "modules/audio_coding/neteq/tools/rtp_generator.h"
@@ -407,6 +408,54 @@ TEST_F(AcmReceiverTestOldApi, MAYBE_NetEqCalls) {
   // TODO(henrik.lundin) Add a test with muted state enabled.
 }
 
+TEST_F(AcmReceiverTestOldApi, CreatesNetEqOnFirstAudioPacket) {
+  config_.create_neteq_on_first_packet = true;
+  receiver_ = std::make_unique<AcmReceiver>(config_);
+  const SdpAudioFormat codec("PCMU", 8000, 1);
+  receiver_->SetCodecs({{0, codec}});
+  EXPECT_TRUE(receiver_->SetBaseMinimumDelayMs(100));
+  EXPECT_EQ(0u, receiver_->GetMemoryUsageBytes());
+
+  AudioFrame frame;
+  bool muted = false;
+  EXPECT_EQ(0, receiver_->GetAudio(16000, &frame, &muted));
+  EXPECT_TRUE(muted);
+  EXPECT_EQ(16000, frame.sample_rate_hz_);
+  EXPECT_EQ(160u, frame.samples_per_channel_);
+  EXPECT_EQ(0u, receiver_->GetMemoryUsageBytes());
+
+  InsertOnePacketOfSilence(SetEncoder(0, codec));
+  EXPECT_GT(receiver_->GetMemoryUsageBytes(), 0u);
+  EXPECT_EQ(0, receiver_->GetAudio(16000, &frame, &muted));
+  EXPECT_EQ(100, receiver_->GetBaseMinimumDelayMs());
+
+  AudioDecodingCallStats stats;
+  receiver_->GetDecodingCallStatistics(&stats);
+  EXPECT_EQ(1, stats.calls_to_silence_generator);
+  EXPECT_EQ(1, stats.calls_to_neteq);
+}
+
+TEST_F(AcmReceiverTestOldApi, ReleasesIdleNetEq) {
+  config_.create_neteq_on_first_packet = true;
+  config_.neteq_idle_release_time = TimeDelta::Zero();
+  receiver_ = std::make_unique<AcmReceiver>(config_);
+  const SdpAudioFormat codec("PCMU", 8000, 1);
+  receiver_->SetCodecs({{0, codec}});
+  const AudioCodecInfo info = SetEncoder(0, codec);
+
+  InsertOnePacketOfSilence(info);
+  EXPECT_GT(receiver_->GetMemoryUsageBytes(), 0u);
+  AudioFrame frame;
+  bool muted = false;
+  EXPECT_EQ(0, receiver_->GetAudio(16000, &frame, &muted));
+  EXPECT_TRUE(muted);
+  EXPECT_EQ(0u, receiver_->GetMemoryUsageBytes());
+
+  // The next audio packet brings NetEq back, with the codecs set before.
+  InsertOnePacketOfSilence(info);
+  EXPECT_GT(receiver_->GetMemoryUsageBytes(), 0u);
+}
+
 }  // namespace acm2
 
 }  // namespace webrtc
@@ -56,6 +56,7 @@ class AudioCodingModuleImpl final : public AudioCodingModule {
 
   // Add 10 ms of raw (PCM) audio data to the encoder.
   int Add10MsData(const AudioFrame& audio_frame) override;
+  int Add10MsData(const AudioFrame& audio_frame, uint32_t timestamp) override;
 
   /////////////////////////////////////////
   // (FEC) Forward Error Correction (codec internal)
@@ -102,7 +103,9 @@ class AudioCodingModuleImpl final : public AudioCodingModule {
     const std::string histogram_name_;
   };
 
-  int Add10MsDataInternal(const AudioFrame& audio_frame, InputData* input_data)
+  int Add10MsDataInternal(const AudioFrame& audio_frame,
+                          uint32_t timestamp,
+                          InputData* input_data)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(acm_mutex_);
 
   // TODO(bugs.webrtc.org/10739): change `absolute_capture_timestamp_ms` to
@@ -118,6 +121,7 @@ class AudioCodingModuleImpl final : public AudioCodingModule {
   // required, before pushing audio into encoder's buffer.
   //
   // in_frame: input audio-frame
+  // timestamp: timestamp of `in_frame`, used instead of `in_frame.timestamp_`
   // ptr_out: pointer to output audio_frame. If no preprocessing is required
   //          `ptr_out` will be pointing to `in_frame`, otherwise pointing to
   //          `preprocess_frame_`.
@@ -126,6 +130,7 @@ class AudioCodingModuleImpl final : public AudioCodingModule {
   //   -1: if encountering an error.
   //    0: otherwise.
   int PreprocessToAddData(const AudioFrame& in_frame,
+                          uint32_t timestamp,
                           const AudioFrame** ptr_out)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(acm_mutex_);
 
@@ -299,8 +304,13 @@ int AudioCodingModuleImpl::RegisterTransportCallback(
 
 // Add 10MS of raw (PCM) audio data to the encoder.
 int AudioCodingModuleImpl::Add10MsData(const AudioFrame& audio_frame) {
+  return Add10MsData(audio_frame, audio_frame.timestamp_);
+}
+
+int AudioCodingModuleImpl::Add10MsData(const AudioFrame& audio_frame,
+                                       uint32_t timestamp) {
   MutexLock lock(&acm_mutex_);
-  int r = Add10MsDataInternal(audio_frame, &input_data_);
+  int r = Add10MsDataInternal(audio_frame, timestamp, &input_data_);
   // TODO(bugs.webrtc.org/10739): add dcheck that
   // `audio_frame.absolute_capture_timestamp_ms()` always has a value.
   return r < 0
@@ -309,6 +319,7 @@ int AudioCodingModuleImpl::Add10MsData(const AudioFrame& audio_frame) {
 }
 
 int AudioCodingModuleImpl::Add10MsDataInternal(const AudioFrame& audio_frame,
+                                               uint32_t timestamp,
                                                InputData* input_data) {
   if (audio_frame.samples_per_channel_ == 0) {
     RTC_DCHECK_NOTREACHED();
@@ -347,7 +358,7 @@ int AudioCodingModuleImpl::Add10MsDataInternal(const AudioFrame& audio_frame,
   // performed before resampling (a down mix prior to resampling will take
   // place if both primary and secondary encoders are mono and input is in
   // stereo).
-  if (PreprocessToAddData(audio_frame, &ptr_frame) < 0) {
+  if (PreprocessToAddData(audio_frame, timestamp, &ptr_frame) < 0) {
     return -1;
   }
 
@@ -357,7 +368,8 @@ int AudioCodingModuleImpl::Add10MsDataInternal(const AudioFrame& audio_frame,
       ptr_frame->num_channels_ == current_num_channels;
 
   // TODO(yujo): Skip encode of muted frames.
-  input_data->input_timestamp = ptr_frame->timestamp_;
+  input_data->input_timestamp =
+      ptr_frame == &audio_frame ? timestamp : ptr_frame->timestamp_;
   input_data->length_per_channel = ptr_frame->samples_per_channel_;
   input_data->audio_channel = current_num_channels;
 
@@ -386,6 +398,7 @@ int AudioCodingModuleImpl::Add10MsDataInternal(const AudioFrame& audio_frame,
 // is required, |*ptr_out| points to `in_frame`.
 // TODO(yujo): Make this more efficient for muted frames.
 int AudioCodingModuleImpl::PreprocessToAddData(const AudioFrame& in_frame,
+                                               uint32_t timestamp,
                                                const AudioFrame** ptr_out) {
   const bool resample =
       in_frame.sample_rate_hz_ != encoder_stack_->SampleRateHz();
@@ -398,18 +411,18 @@ int AudioCodingModuleImpl::PreprocessToAddData(const AudioFrame& in_frame,
       in_frame.num_channels_ == 2 && encoder_stack_->NumChannels() == 1;
 
   if (!first_10ms_data_) {
-    expected_in_ts_ = in_frame.timestamp_;
-    expected_codec_ts_ = in_frame.timestamp_;
+    expected_in_ts_ = timestamp;
+    expected_codec_ts_ = timestamp;
     first_10ms_data_ = true;
-  } else if (in_frame.timestamp_ != expected_in_ts_) {
-    RTC_LOG(LS_WARNING) << "Unexpected input timestamp: " << in_frame.timestamp_
+  } else if (timestamp != expected_in_ts_) {
+    RTC_LOG(LS_WARNING) << "Unexpected input timestamp: " << timestamp
                         << ", expected: " << expected_in_ts_;
     expected_codec_ts_ +=
-        (in_frame.timestamp_ - expected_in_ts_) *
+        (timestamp - expected_in_ts_) *
         static_cast<uint32_t>(
             static_cast<double>(encoder_stack_->SampleRateHz()) /
             static_cast<double>(in_frame.sample_rate_hz_));
-    expected_in_ts_ = in_frame.timestamp_;
+    expected_in_ts_ = timestamp;
   }
 
   if (!down_mix && !resample) {
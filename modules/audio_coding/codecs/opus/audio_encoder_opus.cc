@@ -370,6 +370,7 @@ AudioEncoderOpusImpl::AudioEncoderOpusImpl(
       bitrate_multipliers_(GetBitrateMultipliers()),
       packet_loss_rate_(0.0),
       inst_(nullptr),
+      load_monitor_(OpusEncoderLoadMonitor::GetIfEnabled()),
       packet_loss_fraction_smoother_(new PacketLossFractionSmoother()),
       audio_network_adaptor_creator_(audio_network_adaptor_creator),
       bitrate_smoother_(std::move(bitrate_smoother)),
@@ -592,6 +593,11 @@ AudioEncoder::EncodedInfo AudioEncoderOpusImpl::EncodeImpl(
   RTC_CHECK_EQ(input_buffer_.size(),
                Num10msFramesPerPacket() * SamplesPer10msFrame());
 
+  if (load_monitor_) {
+    ApplyComplexity();
+  }
+  const int64_t encode_start_us = load_monitor_ ? rtc::TimeMicros() : 0;
+
   const size_t max_encoded_bytes = SufficientOutputBufferSize();
   EncodedInfo info;
   info.encoded_bytes = encoded->AppendData(
@@ -607,6 +613,11 @@ AudioEncoder::EncodedInfo AudioEncoderOpusImpl::EncodeImpl(
       });
   input_buffer_.clear();
 
+  if (load_monitor_) {
+    const int64_t now_us = rtc::TimeMicros();
+    load_monitor_->OnEncoded(now_us, now_us - encode_start_us);
+  }
+
   bool dtx_frame = (info.encoded_bytes <= 2);
 
   // Will use new packet size for next encoding.
@@ -686,7 +697,8 @@ bool AudioEncoderOpusImpl::RecreateEncoderInstance(
   // Use the default complexity if the start bitrate is within the hysteresis
   // window.
   complexity_ = GetNewComplexity(config).value_or(config.complexity);
-  RTC_CHECK_EQ(0, WebRtcOpus_SetComplexity(inst_, complexity_));
+  applied_complexity_ = -1;
+  ApplyComplexity();
   bitrate_changed_ = true;
   if (config.dtx_enabled) {
     RTC_CHECK_EQ(0, WebRtcOpus_EnableDtx(inst_));
@@ -755,7 +767,18 @@ void AudioEncoderOpusImpl::SetTargetBitrate(int bits_per_second) {
   const auto new_complexity = GetNewComplexity(config_);
   if (new_complexity && complexity_ != *new_complexity) {
     complexity_ = *new_complexity;
-    RTC_CHECK_EQ(0, WebRtcOpus_SetComplexity(inst_, complexity_));
+    ApplyComplexity();
+  }
+}
+
+void AudioEncoderOpusImpl::ApplyComplexity() {
+  int complexity = complexity_;
+  if (load_monitor_) {
+    complexity = std::min(complexity, load_monitor_->ComplexityCap());
+  }
+  if (complexity != applied_complexity_) {
+    applied_complexity_ = complexity;
+    RTC_CHECK_EQ(0, WebRtcOpus_SetComplexity(inst_, applied_complexity_));
   }
 }
 
@@ -23,6 +23,7 @@
 #include "api/audio_codecs/opus/audio_encoder_opus_config.h"
 #include "common_audio/smoothing_filter.h"
 #include "modules/audio_coding/audio_network_adaptor/include/audio_network_adaptor.h"
+#include "modules/audio_coding/codecs/opus/opus_encoder_load_monitor.h"
 #include "modules/audio_coding/codecs/opus/opus_interface.h"
 
 namespace webrtc {
@@ -152,6 +153,10 @@ class AudioEncoderOpusImpl final : public AudioEncoder {
 
   void MaybeUpdateUplinkBandwidth();
 
+  // Sets `complexity_`, capped by the load monitor, on the encoder instance
+  // unless it is already in use.
+  void ApplyComplexity();
+
   AudioEncoderOpusConfig config_;
   const int payload_type_;
   const bool use_stable_target_for_adaptation_;
@@ -168,6 +173,10 @@ class AudioEncoderOpusImpl final : public AudioEncoder {
   size_t num_channels_to_encode_;
   int next_frame_length_ms_;
   int complexity_;
+  // Complexity set on `inst_`, which is lower than `complexity_` while the
+  // load monitor caps it.
+  int applied_complexity_;
+  OpusEncoderLoadMonitor* const load_monitor_;
   std::unique_ptr<PacketLossFractionSmoother> packet_loss_fraction_smoother_;
   const AudioNetworkAdaptorCreator audio_network_adaptor_creator_;
   std::unique_ptr<AudioNetworkAdaptor> audio_network_adaptor_;
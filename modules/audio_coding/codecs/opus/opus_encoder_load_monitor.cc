@@ -0,0 +1,96 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/codecs/opus/opus_encoder_load_monitor.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "rtc_base/experiments/field_trial_parser.h"
+#include "rtc_base/logging.h"
+#include "system_wrappers/include/cpu_info.h"
+#include "system_wrappers/include/field_trial.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr char kFieldTrialName[] = "WebRTC-Audio-OpusCpuAdaptation";
+constexpr int64_t kWindowUs = 1000000;
+// Underusing windows required before the cap is raised, so that a short lull
+// doesn't undo the adaptation.
+constexpr int kUnderusingWindowsBeforeRampUp = 5;
+constexpr int kMaxLevel =
+    static_cast<int>(std::size(OpusEncoderLoadMonitor::kComplexityCaps)) - 1;
+
+}  // namespace
+
+OpusEncoderLoadMonitor::OpusEncoderLoadMonitor(const Config& config)
+    : config_(config), complexity_cap_(kComplexityCaps[0]) {}
+
+// static
+OpusEncoderLoadMonitor* OpusEncoderLoadMonitor::GetIfEnabled() {
+  static OpusEncoderLoadMonitor* const monitor =
+      []() -> OpusEncoderLoadMonitor* {
+    if (!field_trial::IsEnabled(kFieldTrialName)) {
+      return nullptr;
+    }
+    Config config;
+    FieldTrialParameter<double> high_usage("high_usage", config.high_usage);
+    FieldTrialParameter<double> low_usage("low_usage", config.low_usage);
+    ParseFieldTrial({&high_usage, &low_usage},
+                    field_trial::FindFullName(kFieldTrialName));
+    config.high_usage = high_usage.Get();
+    config.low_usage = std::min(low_usage.Get(), config.high_usage);
+    config.num_cores =
+        std::max(1, static_cast<int>(CpuInfo::DetectNumberOfCores()));
+    return new OpusEncoderLoadMonitor(config);
+  }();
+  return monitor;
+}
+
+void OpusEncoderLoadMonitor::OnEncoded(int64_t now_us,
+                                       int64_t encode_time_us) {
+  MutexLock lock(&mutex_);
+  if (window_start_us_ < 0) {
+    window_start_us_ = now_us;
+  }
+  window_encode_time_us_ += encode_time_us;
+  const int64_t elapsed_us = now_us - window_start_us_;
+  if (elapsed_us < kWindowUs) {
+    return;
+  }
+
+  const double usage = static_cast<double>(window_encode_time_us_) /
+                       (elapsed_us * config_.num_cores);
+  window_start_us_ = now_us;
+  window_encode_time_us_ = 0;
+
+  const int previous_level = level_;
+  if (usage > config_.high_usage) {
+    num_underusing_windows_ = 0;
+    level_ = std::min(level_ + 1, kMaxLevel);
+  } else if (usage < config_.low_usage) {
+    if (++num_underusing_windows_ >= kUnderusingWindowsBeforeRampUp) {
+      num_underusing_windows_ = 0;
+      level_ = std::max(level_ - 1, 0);
+    }
+  } else {
+    num_underusing_windows_ = 0;
+  }
+  if (level_ != previous_level) {
+    RTC_LOG(LS_INFO) << "Opus encode usage " << usage
+                     << ", capping complexity at "
+                     << kComplexityCaps[level_];
+    complexity_cap_.store(kComplexityCaps[level_]);
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,73 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_CODING_CODECS_OPUS_OPUS_ENCODER_LOAD_MONITOR_H_
+#define MODULES_AUDIO_CODING_CODECS_OPUS_OPUS_ENCODER_LOAD_MONITOR_H_
+
+#include <stdint.h>
+
+#include <atomic>
+
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Tracks how much of the machine's CPU all Opus encoders of the process spend
+// encoding, and lowers the maximum encoder complexity while that share is too
+// high, the audio counterpart of OveruseFrameDetector. Encoders report the
+// wall clock time of every encode call, which is summed up over one second
+// windows. Each overusing window lowers the complexity cap by one step, and
+// the cap is raised again one step at a time after a few underusing windows.
+//
+// Thread safe, encoders report from their own encoder threads.
+class OpusEncoderLoadMonitor {
+ public:
+  struct Config {
+    // Share of the total CPU capacity, i.e. of all cores, spent encoding above
+    // which the complexity cap is lowered.
+    double high_usage = 0.25;
+    // Share below which the complexity cap is raised again.
+    double low_usage = 0.1;
+    // Number of cores the usage is relative to.
+    int num_cores = 1;
+  };
+
+  // Complexity caps, from no adaptation to the most aggressive step.
+  static constexpr int kComplexityCaps[] = {10, 8, 6, 4, 2};
+
+  explicit OpusEncoderLoadMonitor(const Config& config);
+  OpusEncoderLoadMonitor(const OpusEncoderLoadMonitor&) = delete;
+  OpusEncoderLoadMonitor& operator=(const OpusEncoderLoadMonitor&) = delete;
+
+  // Returns the monitor shared by all encoders of the process, or null unless
+  // the "WebRTC-Audio-OpusCpuAdaptation" field trial is enabled.
+  static OpusEncoderLoadMonitor* GetIfEnabled();
+
+  // Reports that an encoder spent `encode_time_us` in an encode call which
+  // finished at `now_us`.
+  void OnEncoded(int64_t now_us, int64_t encode_time_us);
+
+  // Highest complexity encoders should currently use.
+  int ComplexityCap() const { return complexity_cap_.load(); }
+
+ private:
+  const Config config_;
+  Mutex mutex_;
+  int64_t window_start_us_ RTC_GUARDED_BY(mutex_) = -1;
+  int64_t window_encode_time_us_ RTC_GUARDED_BY(mutex_) = 0;
+  int num_underusing_windows_ RTC_GUARDED_BY(mutex_) = 0;
+  int level_ RTC_GUARDED_BY(mutex_) = 0;
+  std::atomic<int> complexity_cap_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_CODING_CODECS_OPUS_OPUS_ENCODER_LOAD_MONITOR_H_
@@ -0,0 +1,72 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/codecs/opus/opus_encoder_load_monitor.h"
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int64_t kFrameIntervalUs = 20000;
+
+// Runs `num_windows` one second windows of 20 ms frames, each taking
+// `encode_time_us` to encode, and returns the time after them. The first
+// window must have been started at `start_us`.
+int64_t RunWindows(OpusEncoderLoadMonitor& monitor,
+                   int64_t start_us,
+                   int num_windows,
+                   int64_t encode_time_us) {
+  int64_t now_us = start_us;
+  for (int i = 0; i < num_windows * 50; ++i) {
+    now_us += kFrameIntervalUs;
+    monitor.OnEncoded(now_us, encode_time_us);
+  }
+  return now_us;
+}
+
+TEST(OpusEncoderLoadMonitorTest, KeepsFullComplexityWhenNotOverusing) {
+  OpusEncoderLoadMonitor monitor({.high_usage = 0.25, .low_usage = 0.1});
+  monitor.OnEncoded(0, 0);
+  RunWindows(monitor, 0, 10, kFrameIntervalUs / 10);
+  EXPECT_EQ(monitor.ComplexityCap(), 10);
+}
+
+TEST(OpusEncoderLoadMonitorTest, LowersCapOneStepPerOverusingWindow) {
+  OpusEncoderLoadMonitor monitor({.high_usage = 0.25, .low_usage = 0.1});
+  monitor.OnEncoded(0, 0);
+  int64_t now_us = RunWindows(monitor, 0, 2, kFrameIntervalUs / 2);
+  EXPECT_EQ(monitor.ComplexityCap(), 6);
+  RunWindows(monitor, now_us, 10, kFrameIntervalUs / 2);
+  EXPECT_EQ(monitor.ComplexityCap(), 2);
+}
+
+TEST(OpusEncoderLoadMonitorTest, UsageIsRelativeToAllCores) {
+  OpusEncoderLoadMonitor monitor(
+      {.high_usage = 0.25, .low_usage = 0.1, .num_cores = 4});
+  monitor.OnEncoded(0, 0);
+  RunWindows(monitor, 0, 5, kFrameIntervalUs / 2);
+  EXPECT_EQ(monitor.ComplexityCap(), 10);
+}
+
+TEST(OpusEncoderLoadMonitorTest, RaisesCapAfterSustainedUnderuse) {
+  OpusEncoderLoadMonitor monitor({.high_usage = 0.25, .low_usage = 0.1});
+  monitor.OnEncoded(0, 0);
+  int64_t now_us = RunWindows(monitor, 0, 1, kFrameIntervalUs / 2);
+  ASSERT_EQ(monitor.ComplexityCap(), 8);
+
+  now_us = RunWindows(monitor, now_us, 4, kFrameIntervalUs / 20);
+  EXPECT_EQ(monitor.ComplexityCap(), 8);
+  RunWindows(monitor, now_us, 1, kFrameIntervalUs / 20);
+  EXPECT_EQ(monitor.ComplexityCap(), 10);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -115,6 +115,12 @@ class AudioCodingModule {
   //
   virtual int32_t Add10MsData(const AudioFrame& audio_frame) = 0;
 
+  // Same as above, but encodes `audio_frame` as if its `timestamp_` was
+  // `timestamp`. Lets callers encode a frame they must not modify, e.g. one
+  // shared with other senders, without copying it.
+  virtual int32_t Add10MsData(const AudioFrame& audio_frame,
+                              uint32_t timestamp) = 0;
+
   ///////////////////////////////////////////////////////////////////////////
   // int SetPacketLossRate()
   // Sets expected packet loss rate for encoding. Some encoders provide packet
@@ -49,7 +49,7 @@ Accelerate::ReturnCodes Accelerate::CheckCriteriaAndStretch(
     int16_t best_correlation,
     bool active_speech,
     bool fast_mode,
-    AudioMultiVector* output) const {
+    AudioMultiVector* output) {
   // Check for strong correlation or passive speech.
   // Use 8192 (0.5 in Q14) in fast mode.
   const int correlation_threshold = fast_mode ? 8192 : kCorrelationThreshold;
@@ -71,12 +71,12 @@ Accelerate::ReturnCodes Accelerate::CheckCriteriaAndStretch(
     // Copy first part; 0 to 15 ms.
     output->PushBackInterleaved(
         rtc::ArrayView<const int16_t>(input, fs_mult_120 * num_channels_));
-    // Copy the `peak_index` starting at 15 ms to `temp_vector`.
-    AudioMultiVector temp_vector(num_channels_);
-    temp_vector.PushBackInterleaved(rtc::ArrayView<const int16_t>(
+    // Copy the `peak_index` starting at 15 ms to `cross_fade_vector_`.
+    cross_fade_vector_.Clear();
+    cross_fade_vector_.PushBackInterleaved(rtc::ArrayView<const int16_t>(
         &input[fs_mult_120 * num_channels_], peak_index * num_channels_));
-    // Cross-fade `temp_vector` onto the end of `output`.
-    output->CrossFade(temp_vector, peak_index);
+    // Cross-fade `cross_fade_vector_` onto the end of `output`.
+    output->CrossFade(cross_fade_vector_, peak_index);
     // Copy the last unmodified part, 15 ms + pitch period until the end.
     output->PushBackInterleaved(rtc::ArrayView<const int16_t>(
         &input[(fs_mult_120 + peak_index) * num_channels_],
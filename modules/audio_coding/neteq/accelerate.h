@@ -63,7 +63,7 @@ class Accelerate : public TimeStretch {
                                       int16_t best_correlation,
                                       bool active_speech,
                                       bool fast_mode,
-                                      AudioMultiVector* output) const override;
+                                      AudioMultiVector* output) override;
 };
 
 struct AccelerateFactory {
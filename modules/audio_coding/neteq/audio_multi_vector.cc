@@ -50,6 +50,12 @@ void AudioMultiVector::Clear() {
   }
 }
 
+void AudioMultiVector::Reserve(size_t length) {
+  for (AudioVector* channel : channels_) {
+    channel->Reserve(length);
+  }
+}
+
 void AudioMultiVector::Zeros(size_t length) {
   for (size_t i = 0; i < num_channels_; ++i) {
     channels_[i]->Clear();
@@ -76,16 +82,20 @@ void AudioMultiVector::PushBackInterleaved(
     channels_[0]->PushBack(append_this.data(), append_this.size());
     return;
   }
-  size_t length_per_channel = append_this.size() / num_channels_;
-  int16_t* temp_array = new int16_t[length_per_channel];  // Temporary storage.
-  for (size_t channel = 0; channel < num_channels_; ++channel) {
-    // Copy elements to `temp_array`.
-    for (size_t i = 0; i < length_per_channel; ++i) {
-      temp_array[i] = append_this[channel + i * num_channels_];
+  const size_t length_per_channel = append_this.size() / num_channels_;
+  Reserve(Size() + length_per_channel);
+  // De-interleave in chunks through stack memory to not allocate.
+  constexpr size_t kChunkLength = 480;
+  int16_t chunk[kChunkLength];
+  for (size_t start = 0; start < length_per_channel; start += kChunkLength) {
+    const size_t length = std::min(kChunkLength, length_per_channel - start);
+    for (size_t channel = 0; channel < num_channels_; ++channel) {
+      for (size_t i = 0; i < length; ++i) {
+        chunk[i] = append_this[channel + (start + i) * num_channels_];
+      }
+      channels_[channel]->PushBack(chunk, length);
     }
-    channels_[channel]->PushBack(temp_array, length_per_channel);
   }
-  delete[] temp_array;
 }
 
 void AudioMultiVector::PushBack(const AudioMultiVector& append_this) {
@@ -42,6 +42,10 @@ class AudioMultiVector {
   // Clears the vector and inserts `length` zeros into each channel.
   virtual void Zeros(size_t length);
 
+  // Makes room for `length` elements per channel, so that the vector can grow
+  // to that size without reallocating.
+  void Reserve(size_t length);
+
   // Copies all values from this vector to `copy_to`. Any contents in `copy_to`
   // are deleted. After the operation is done, `copy_to` will be an exact
   // replica of this object. The source and the destination must have the same
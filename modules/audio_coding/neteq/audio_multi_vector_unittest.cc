@@ -124,6 +124,28 @@ TEST_P(AudioMultiVectorTest, CopyToNull) {
 }
 
 // Test the PushBack method with another AudioMultiVector as input argument.
+// Test PushBackInterleaved with more samples per channel than are
+// de-interleaved at a time.
+TEST_P(AudioMultiVectorTest, PushBackLongInterleaved) {
+  constexpr size_t kLength = 1234;
+  std::vector<int16_t> interleaved(num_channels_ * kLength);
+  for (size_t i = 0; i < kLength; ++i) {
+    for (size_t j = 0; j < num_channels_; ++j) {
+      interleaved[i * num_channels_ + j] =
+          rtc::checked_cast<int16_t>(j * kLength + i);
+    }
+  }
+  AudioMultiVector vec(num_channels_);
+  vec.Reserve(kLength);
+  vec.PushBackInterleaved(interleaved);
+  ASSERT_EQ(kLength, vec.Size());
+  for (size_t channel = 0; channel < num_channels_; ++channel) {
+    for (size_t i = 0; i < kLength; ++i) {
+      EXPECT_EQ(static_cast<int16_t>(channel * kLength + i), vec[channel][i]);
+    }
+  }
+}
+
 TEST_P(AudioMultiVectorTest, PushBackVector) {
   AudioMultiVector vec1(num_channels_, array_length());
   AudioMultiVector vec2(num_channels_, array_length());
@@ -13,6 +13,7 @@
 #include <algorithm>
 #include <memory>
 
+#include "modules/audio_coding/neteq/dsp_kernels.h"
 #include "rtc_base/checks.h"
 
 namespace webrtc {
@@ -255,15 +256,21 @@ void AudioVector::CrossFade(const AudioVector& append_this,
   // TODO(hlundin): Consider skipping +1 in the denominator to produce a
   // smoother cross-fade, in particular at the end of the fade.
   int alpha_step = 16384 / (static_cast<int>(fade_length) + 1);
-  int alpha = 16384;
-  for (size_t i = 0; i < fade_length; ++i) {
-    alpha -= alpha_step;
-    array_[(position + i) % capacity_] =
-        (alpha * array_[(position + i) % capacity_] +
-         (16384 - alpha) * append_this[i] + 8192) >>
-        14;
+  int alpha = 16384 - alpha_step;
+  // Both vectors may wrap around; fade each contiguous stretch at a time.
+  for (size_t i = 0; i < fade_length;) {
+    const size_t index = (position + i) % capacity_;
+    const size_t append_index =
+        (append_this.begin_index_ + i) % append_this.capacity_;
+    const size_t chunk_length =
+        std::min({fade_length - i, capacity_ - index,
+                  append_this.capacity_ - append_index});
+    internal::CrossFade(&array_[index], &append_this.array_[append_index],
+                        chunk_length, alpha, alpha_step, &array_[index]);
+    alpha -= static_cast<int>(chunk_length) * alpha_step;
+    i += chunk_length;
   }
-  RTC_DCHECK_GE(alpha, 0);  // Verify that the slope was correct.
+  RTC_DCHECK_GE(alpha + alpha_step, 0);  // Verify that the slope was correct.
   // Append what is left of `append_this`.
   size_t samples_to_push_back = append_this.Size() - fade_length;
   if (samples_to_push_back > 0)
@@ -299,82 +306,50 @@ void AudioVector::Reserve(size_t n) {
 void AudioVector::InsertByPushBack(const int16_t* insert_this,
                                    size_t length,
                                    size_t position) {
-  const size_t move_chunk_length = Size() - position;
-  std::unique_ptr<int16_t[]> temp_array(nullptr);
-  if (move_chunk_length > 0) {
-    // TODO(minyue): see if it is possible to avoid copying to a buffer.
-    temp_array.reset(new int16_t[move_chunk_length]);
-    CopyTo(move_chunk_length, position, temp_array.get());
-    PopBack(move_chunk_length);
-  }
-
-  Reserve(Size() + length + move_chunk_length);
-  PushBack(insert_this, length);
-  if (move_chunk_length > 0)
-    PushBack(temp_array.get(), move_chunk_length);
+  InsertZerosByPushBack(length, position);
+  OverwriteAt(insert_this, length, position);
 }
 
 void AudioVector::InsertByPushFront(const int16_t* insert_this,
                                     size_t length,
                                     size_t position) {
-  std::unique_ptr<int16_t[]> temp_array(nullptr);
-  if (position > 0) {
-    // TODO(minyue): see if it is possible to avoid copying to a buffer.
-    temp_array.reset(new int16_t[position]);
-    CopyTo(position, 0, temp_array.get());
-    PopFront(position);
-  }
-
-  Reserve(Size() + length + position);
-  PushFront(insert_this, length);
-  if (position > 0)
-    PushFront(temp_array.get(), position);
+  InsertZerosByPushFront(length, position);
+  OverwriteAt(insert_this, length, position);
 }
 
 void AudioVector::InsertZerosByPushBack(size_t length, size_t position) {
   const size_t move_chunk_length = Size() - position;
-  std::unique_ptr<int16_t[]> temp_array(nullptr);
-  if (move_chunk_length > 0) {
-    temp_array.reset(new int16_t[move_chunk_length]);
-    CopyTo(move_chunk_length, position, temp_array.get());
-    PopBack(move_chunk_length);
-  }
-
-  Reserve(Size() + length + move_chunk_length);
-
-  const size_t first_zero_chunk_length =
-      std::min(length, capacity_ - end_index_);
-  memset(&array_[end_index_], 0, first_zero_chunk_length * sizeof(int16_t));
-  const size_t remaining_zero_length = length - first_zero_chunk_length;
-  if (remaining_zero_length > 0)
-    memset(array_.get(), 0, remaining_zero_length * sizeof(int16_t));
+  Reserve(Size() + length);
   end_index_ = (end_index_ + length) % capacity_;
 
-  if (move_chunk_length > 0)
-    PushBack(temp_array.get(), move_chunk_length);
+  // Move the samples after `position` towards the end, in place, starting with
+  // the last one.
+  for (size_t i = move_chunk_length; i > 0; --i) {
+    (*this)[position + length + i - 1] = (*this)[position + i - 1];
+  }
+  SetZeros(length, position);
 }
 
 void AudioVector::InsertZerosByPushFront(size_t length, size_t position) {
-  std::unique_ptr<int16_t[]> temp_array(nullptr);
-  if (position > 0) {
-    temp_array.reset(new int16_t[position]);
-    CopyTo(position, 0, temp_array.get());
-    PopFront(position);
-  }
+  Reserve(Size() + length);
+  begin_index_ = (begin_index_ + capacity_ - length) % capacity_;
 
-  Reserve(Size() + length + position);
+  // Move the samples before `position` towards the beginning, in place,
+  // starting with the first one.
+  for (size_t i = 0; i < position; ++i) {
+    (*this)[i] = (*this)[i + length];
+  }
+  SetZeros(length, position);
+}
 
-  const size_t first_zero_chunk_length = std::min(length, begin_index_);
-  memset(&array_[begin_index_ - first_zero_chunk_length], 0,
-         first_zero_chunk_length * sizeof(int16_t));
+void AudioVector::SetZeros(size_t length, size_t position) {
+  const size_t zero_index = (begin_index_ + position) % capacity_;
+  const size_t first_zero_chunk_length =
+      std::min(length, capacity_ - zero_index);
+  memset(&array_[zero_index], 0, first_zero_chunk_length * sizeof(int16_t));
   const size_t remaining_zero_length = length - first_zero_chunk_length;
   if (remaining_zero_length > 0)
-    memset(&array_[capacity_ - remaining_zero_length], 0,
-           remaining_zero_length * sizeof(int16_t));
-  begin_index_ = (begin_index_ + capacity_ - length) % capacity_;
-
-  if (position > 0)
-    PushFront(temp_array.get(), position);
+    memset(array_.get(), 0, remaining_zero_length * sizeof(int16_t));
 }
 
 }  // namespace webrtc
@@ -36,6 +36,10 @@ class AudioVector {
   // Deletes all values and make the vector empty.
   virtual void Clear();
 
+  // Makes room for `n` elements, so that the vector can grow to that size
+  // without reallocating.
+  void Reserve(size_t n);
+
   // Copies all values from this vector to `copy_to`. Any contents in `copy_to`
   // are deleted before the copy operation. After the operation is done,
   // `copy_to` will be an exact replica of this object.
@@ -142,8 +146,6 @@ class AudioVector {
     return ix;
   }
 
-  void Reserve(size_t n);
-
   void InsertByPushBack(const int16_t* insert_this,
                         size_t length,
                         size_t position);
@@ -156,6 +158,9 @@ class AudioVector {
 
   void InsertZerosByPushFront(size_t length, size_t position);
 
+  // Sets `length` elements starting from `position` to zero.
+  void SetZeros(size_t length, size_t position);
+
   std::unique_ptr<int16_t[]> array_;
 
   size_t capacity_;  // Allocated number of samples in the array.
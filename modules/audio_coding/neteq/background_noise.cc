@@ -17,6 +17,7 @@
 #include "common_audio/signal_processing/include/signal_processing_library.h"
 #include "modules/audio_coding/neteq/audio_multi_vector.h"
 #include "modules/audio_coding/neteq/cross_correlation.h"
+#include "modules/audio_coding/neteq/dsp_kernels.h"
 
 namespace webrtc {
 namespace {
@@ -89,7 +90,7 @@ bool BackgroundNoise::Update(const AudioMultiVector& sync_buffer) {
       WebRtcSpl_FilterMAFastQ12(temp_signal + kVecLen - kResidualLength,
                                 filter_output, lpc_coefficients,
                                 kMaxLpcOrder + 1, kResidualLength);
-      int32_t residual_energy = WebRtcSpl_DotProductWithScale(
+      int32_t residual_energy = internal::DotProductWithScale(
           filter_output, filter_output, kResidualLength, 0);
 
       // Check spectral flatness.
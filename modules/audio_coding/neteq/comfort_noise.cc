@@ -11,7 +11,6 @@
 #include "modules/audio_coding/neteq/comfort_noise.h"
 
 #include <cstdint>
-#include <memory>
 
 #include "api/array_view.h"
 #include "modules/audio_coding/codecs/cng/webrtc_cng.h"
@@ -66,16 +65,15 @@ int ComfortNoise::Generate(size_t requested_length, AudioMultiVector* output) {
     return kUnknownPayloadType;
   }
 
-  std::unique_ptr<int16_t[]> temp(new int16_t[number_of_samples]);
-  if (!cng_decoder->Generate(
-          rtc::ArrayView<int16_t>(temp.get(), number_of_samples), new_period)) {
+  noise_.resize(number_of_samples);
+  if (!cng_decoder->Generate(noise_, new_period)) {
     // Error returned.
     output->Zeros(requested_length);
     RTC_LOG(LS_ERROR)
         << "ComfortNoiseDecoder::Genererate failed to generate comfort noise";
     return kInternalError;
   }
-  (*output)[0].OverwriteAt(temp.get(), number_of_samples, 0);
+  (*output)[0].OverwriteAt(noise_.data(), number_of_samples, 0);
 
   if (first_call_) {
     // Set tapering window parameters. Values are in Q15.
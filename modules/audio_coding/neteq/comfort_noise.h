@@ -12,6 +12,9 @@
 #define MODULES_AUDIO_CODING_NETEQ_COMFORT_NOISE_H_
 
 #include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
 
 namespace webrtc {
 
@@ -66,6 +69,8 @@ class ComfortNoise {
   DecoderDatabase* decoder_database_;
   SyncBuffer* sync_buffer_;
   int internal_error_code_;
+  // Kept between calls to not allocate while generating noise.
+  std::vector<int16_t> noise_;
 };
 
 }  // namespace webrtc
@@ -104,8 +104,8 @@ DecisionLogic::DecisionLogic(
                                         config_.packet_history_size_ms)),
       tick_timer_(config.tick_timer),
       disallow_time_stretching_(!config.allow_time_stretching),
-      timescale_countdown_(
-          tick_timer_->GetNewCountdown(kMinTimescaleInterval + 1)) {}
+      timescale_allowed_tick_(tick_timer_->ticks() + kMinTimescaleInterval +
+                              1) {}
 
 DecisionLogic::~DecisionLogic() = default;
 
@@ -113,8 +113,7 @@ void DecisionLogic::SoftReset() {
   packet_length_samples_ = 0;
   sample_memory_ = 0;
   prev_time_scale_ = false;
-  timescale_countdown_ =
-      tick_timer_->GetNewCountdown(kMinTimescaleInterval + 1);
+  timescale_allowed_tick_ = tick_timer_->ticks() + kMinTimescaleInterval + 1;
   time_stretched_cn_samples_ = 0;
   delay_manager_->Reset();
   buffer_level_filter_->Reset();
@@ -134,7 +133,7 @@ NetEq::Operation DecisionLogic::GetDecision(const NetEqStatus& status,
                                             bool* reset_decoder) {
   prev_time_scale_ = prev_time_scale_ && IsTimestretch(status.last_mode);
   if (prev_time_scale_) {
-    timescale_countdown_ = tick_timer_->GetNewCountdown(kMinTimescaleInterval);
+    timescale_allowed_tick_ = tick_timer_->ticks() + kMinTimescaleInterval;
   }
   if (!IsCng(status.last_mode) &&
       !(config_.combine_concealment_decision && IsExpand(status.last_mode))) {
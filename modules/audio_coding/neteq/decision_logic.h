@@ -130,7 +130,7 @@ class DecisionLogic : public NetEqController {
   // Checks if enough time has elapsed since the last successful timescale
   // operation was done (i.e., accelerate or preemptive expand).
   bool TimescaleAllowed() const {
-    return !timescale_countdown_ || timescale_countdown_->Finished();
+    return tick_timer_->ticks() >= timescale_allowed_tick_;
   }
 
   // Checks if the current (filtered) buffer level is under the target level.
@@ -174,7 +174,9 @@ class DecisionLogic : public NetEqController {
   int sample_memory_ = 0;
   bool prev_time_scale_ = false;
   bool disallow_time_stretching_;
-  std::unique_ptr<TickTimer::Countdown> timescale_countdown_;
+  // Tick from which timescale operations are allowed again. Kept as a tick
+  // count rather than a TickTimer::Countdown to not allocate per decision.
+  uint64_t timescale_allowed_tick_;
   int time_stretched_cn_samples_ = 0;
   bool buffer_flush_ = false;
 };
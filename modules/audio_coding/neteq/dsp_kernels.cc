@@ -0,0 +1,349 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/neteq/dsp_kernels.h"
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "rtc_base/numerics/safe_conversions.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+
+// This needs to be after rtc_base/system/arch.h which defines
+// architecture macros.
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#endif
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace webrtc {
+namespace internal {
+namespace {
+
+using CrossCorrelationFunction =
+    void (*)(const int16_t*, const int16_t*, size_t, size_t, int, int,
+             int32_t*);
+using DotProductWithScaleFunction = int32_t (*)(const int16_t*,
+                                                const int16_t*,
+                                                size_t,
+                                                int);
+using CrossFadeFunction = void (*)(const int16_t*,
+                                   const int16_t*,
+                                   size_t,
+                                   int16_t,
+                                   int16_t,
+                                   int16_t*);
+
+// The signal processing library selects its own versions for ARM and MIPS.
+void CrossCorrelationSpl(const int16_t* sequence_1,
+                         const int16_t* sequence_2,
+                         size_t length,
+                         size_t num_lags,
+                         int right_shifts,
+                         int step,
+                         int32_t* cross_correlation) {
+  WebRtcSpl_CrossCorrelation(cross_correlation, sequence_1, sequence_2, length,
+                             num_lags, right_shifts, step);
+}
+
+CrossCorrelationFunction SelectCrossCorrelationFunction() {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (GetCPUInfo(kAVX2) != 0) {
+    return &CrossCorrelation_AVX2;
+  }
+  if (GetCPUInfo(kSSE2) != 0) {
+    return &CrossCorrelation_SSE2;
+  }
+#endif
+  return &CrossCorrelationSpl;
+}
+
+DotProductWithScaleFunction SelectDotProductWithScaleFunction() {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (GetCPUInfo(kAVX2) != 0) {
+    return &DotProductWithScale_AVX2;
+  }
+  if (GetCPUInfo(kSSE2) != 0) {
+    return &DotProductWithScale_SSE2;
+  }
+#endif
+#if defined(WEBRTC_HAS_NEON)
+  return &DotProductWithScale_NEON;
+#else
+  return &DotProductWithScale_C;
+#endif
+}
+
+CrossFadeFunction SelectCrossFadeFunction() {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (GetCPUInfo(kAVX2) != 0) {
+    return &CrossFade_AVX2;
+  }
+  if (GetCPUInfo(kSSE2) != 0) {
+    return &CrossFade_SSE2;
+  }
+#endif
+#if defined(WEBRTC_HAS_NEON)
+  return &CrossFade_NEON;
+#else
+  return &CrossFade_C;
+#endif
+}
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// Returns the 32 bit products of the 8 samples of `a` and `b`, as two vectors
+// of 4 products each.
+void MultiplyS16(__m128i a, __m128i b, __m128i& low, __m128i& high) {
+  const __m128i product_low = _mm_mullo_epi16(a, b);
+  const __m128i product_high = _mm_mulhi_epi16(a, b);
+  low = _mm_unpacklo_epi16(product_low, product_high);
+  high = _mm_unpackhi_epi16(product_low, product_high);
+}
+
+// Adds the 4 32 bit values of `x`, sign extended to 64 bits, to `sum`.
+__m128i AddWidened(__m128i sum, __m128i x) {
+  const __m128i sign = _mm_srai_epi32(x, 31);
+  sum = _mm_add_epi64(sum, _mm_unpacklo_epi32(x, sign));
+  return _mm_add_epi64(sum, _mm_unpackhi_epi32(x, sign));
+}
+#endif
+
+}  // namespace
+
+void CrossCorrelation(const int16_t* sequence_1,
+                      const int16_t* sequence_2,
+                      size_t length,
+                      size_t num_lags,
+                      int right_shifts,
+                      int step,
+                      int32_t* cross_correlation) {
+  static const CrossCorrelationFunction cross_correlation_function =
+      SelectCrossCorrelationFunction();
+  cross_correlation_function(sequence_1, sequence_2, length, num_lags,
+                             right_shifts, step, cross_correlation);
+}
+
+int32_t DotProductWithScale(const int16_t* vector_1,
+                            const int16_t* vector_2,
+                            size_t length,
+                            int scaling) {
+  static const DotProductWithScaleFunction dot_product_function =
+      SelectDotProductWithScaleFunction();
+  return dot_product_function(vector_1, vector_2, length, scaling);
+}
+
+void CrossFade(const int16_t* input_1,
+               const int16_t* input_2,
+               size_t length,
+               int16_t factor,
+               int16_t factor_decrement,
+               int16_t* output) {
+  static const CrossFadeFunction cross_fade_function =
+      SelectCrossFadeFunction();
+  cross_fade_function(input_1, input_2, length, factor, factor_decrement,
+                      output);
+}
+
+void CrossCorrelation_C(const int16_t* sequence_1,
+                        const int16_t* sequence_2,
+                        size_t length,
+                        size_t num_lags,
+                        int right_shifts,
+                        int step,
+                        int32_t* cross_correlation) {
+  WebRtcSpl_CrossCorrelationC(cross_correlation, sequence_1, sequence_2,
+                              length, num_lags, right_shifts, step);
+}
+
+int32_t DotProductWithScale_C(const int16_t* vector_1,
+                              const int16_t* vector_2,
+                              size_t length,
+                              int scaling) {
+  return WebRtcSpl_DotProductWithScale(vector_1, vector_2, length, scaling);
+}
+
+void CrossFade_C(const int16_t* input_1,
+                 const int16_t* input_2,
+                 size_t length,
+                 int16_t factor,
+                 int16_t factor_decrement,
+                 int16_t* output) {
+  int16_t complement_factor = 16384 - factor;
+  for (size_t i = 0; i < length; ++i) {
+    output[i] =
+        (factor * input_1[i] + complement_factor * input_2[i] + 8192) >> 14;
+    factor -= factor_decrement;
+    complement_factor += factor_decrement;
+  }
+}
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void CrossCorrelation_SSE2(const int16_t* sequence_1,
+                           const int16_t* sequence_2,
+                           size_t length,
+                           size_t num_lags,
+                           int right_shifts,
+                           int step,
+                           int32_t* cross_correlation) {
+  const __m128i shift = _mm_cvtsi32_si128(right_shifts);
+  for (size_t lag = 0; lag < num_lags; ++lag) {
+    // The products are summed in 32 bits, wrapping as in the C version.
+    __m128i sum = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+      __m128i low;
+      __m128i high;
+      MultiplyS16(
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(&sequence_1[i])),
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(&sequence_2[i])),
+          low, high);
+      sum = _mm_add_epi32(sum, _mm_sra_epi32(low, shift));
+      sum = _mm_add_epi32(sum, _mm_sra_epi32(high, shift));
+    }
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+    uint32_t correlation = static_cast<uint32_t>(_mm_cvtsi128_si32(sum));
+    for (; i < length; ++i) {
+      correlation += static_cast<uint32_t>(
+          (sequence_1[i] * sequence_2[i]) >> right_shifts);
+    }
+    cross_correlation[lag] = static_cast<int32_t>(correlation);
+    sequence_2 += step;
+  }
+}
+
+int32_t DotProductWithScale_SSE2(const int16_t* vector_1,
+                                 const int16_t* vector_2,
+                                 size_t length,
+                                 int scaling) {
+  const __m128i shift = _mm_cvtsi32_si128(scaling);
+  __m128i sum = _mm_setzero_si128();
+  size_t i = 0;
+  for (; i + 8 <= length; i += 8) {
+    __m128i low;
+    __m128i high;
+    MultiplyS16(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&vector_1[i])),
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&vector_2[i])), low,
+        high);
+    sum = AddWidened(sum, _mm_sra_epi32(low, shift));
+    sum = AddWidened(sum, _mm_sra_epi32(high, shift));
+  }
+  int64_t sums[2];
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(sums), sum);
+  int64_t dot_product = sums[0] + sums[1];
+  for (; i < length; ++i) {
+    dot_product += (vector_1[i] * vector_2[i]) >> scaling;
+  }
+  return rtc::saturated_cast<int32_t>(dot_product);
+}
+
+void CrossFade_SSE2(const int16_t* input_1,
+                    const int16_t* input_2,
+                    size_t length,
+                    int16_t factor,
+                    int16_t factor_decrement,
+                    int16_t* output) {
+  // The factors wrap in 16 bits, as in the C version.
+  const __m128i decrement = _mm_set1_epi16(factor_decrement);
+  const __m128i block_decrement =
+      _mm_slli_epi16(decrement, 3);  // 8 samples per block.
+  __m128i factors = _mm_sub_epi16(
+      _mm_set1_epi16(factor),
+      _mm_mullo_epi16(decrement, _mm_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7)));
+  const __m128i one_q14 = _mm_set1_epi16(16384);
+  const __m128i rounding = _mm_set1_epi32(8192);
+  size_t i = 0;
+  for (; i + 8 <= length; i += 8) {
+    const __m128i x_1 =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&input_1[i]));
+    const __m128i x_2 =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&input_2[i]));
+    const __m128i complement_factors = _mm_sub_epi16(one_q14, factors);
+    // factor * x_1 + complement_factor * x_2, for each sample.
+    __m128i low = _mm_madd_epi16(_mm_unpacklo_epi16(x_1, x_2),
+                                 _mm_unpacklo_epi16(factors, complement_factors));
+    __m128i high =
+        _mm_madd_epi16(_mm_unpackhi_epi16(x_1, x_2),
+                       _mm_unpackhi_epi16(factors, complement_factors));
+    low = _mm_srai_epi32(_mm_add_epi32(low, rounding), 14);
+    high = _mm_srai_epi32(_mm_add_epi32(high, rounding), 14);
+    // Truncate to 16 bits without saturation, as the conversion in C.
+    low = _mm_srai_epi32(_mm_slli_epi32(low, 16), 16);
+    high = _mm_srai_epi32(_mm_slli_epi32(high, 16), 16);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&output[i]),
+                     _mm_packs_epi32(low, high));
+    factors = _mm_sub_epi16(factors, block_decrement);
+  }
+  CrossFade_C(&input_1[i], &input_2[i], length - i,
+              static_cast<int16_t>(_mm_extract_epi16(factors, 0)),
+              factor_decrement, &output[i]);
+}
+#endif
+
+#if defined(WEBRTC_HAS_NEON)
+int32_t DotProductWithScale_NEON(const int16_t* vector_1,
+                                 const int16_t* vector_2,
+                                 size_t length,
+                                 int scaling) {
+  const int32x4_t shift = vdupq_n_s32(-scaling);
+  int64x2_t sum = vdupq_n_s64(0);
+  size_t i = 0;
+  for (; i + 8 <= length; i += 8) {
+    const int16x8_t x_1 = vld1q_s16(&vector_1[i]);
+    const int16x8_t x_2 = vld1q_s16(&vector_2[i]);
+    const int32x4_t low = vmull_s16(vget_low_s16(x_1), vget_low_s16(x_2));
+    const int32x4_t high = vmull_s16(vget_high_s16(x_1), vget_high_s16(x_2));
+    sum = vpadalq_s32(sum, vshlq_s32(low, shift));
+    sum = vpadalq_s32(sum, vshlq_s32(high, shift));
+  }
+  int64_t dot_product = vgetq_lane_s64(sum, 0) + vgetq_lane_s64(sum, 1);
+  for (; i < length; ++i) {
+    dot_product += (vector_1[i] * vector_2[i]) >> scaling;
+  }
+  return rtc::saturated_cast<int32_t>(dot_product);
+}
+
+void CrossFade_NEON(const int16_t* input_1,
+                    const int16_t* input_2,
+                    size_t length,
+                    int16_t factor,
+                    int16_t factor_decrement,
+                    int16_t* output) {
+  // The factors wrap in 16 bits, as in the C version.
+  static const int16_t kIndices[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+  const int16x8_t block_decrement =
+      vdupq_n_s16(static_cast<int16_t>(factor_decrement * 8));
+  int16x8_t factors = vmlsq_n_s16(vdupq_n_s16(factor), vld1q_s16(kIndices),
+                                  factor_decrement);
+  const int16x8_t one_q14 = vdupq_n_s16(16384);
+  size_t i = 0;
+  for (; i + 8 <= length; i += 8) {
+    const int16x8_t x_1 = vld1q_s16(&input_1[i]);
+    const int16x8_t x_2 = vld1q_s16(&input_2[i]);
+    const int16x8_t complement_factors = vsubq_s16(one_q14, factors);
+    int32x4_t low = vmull_s16(vget_low_s16(factors), vget_low_s16(x_1));
+    low = vmlal_s16(low, vget_low_s16(complement_factors), vget_low_s16(x_2));
+    int32x4_t high = vmull_s16(vget_high_s16(factors), vget_high_s16(x_1));
+    high =
+        vmlal_s16(high, vget_high_s16(complement_factors), vget_high_s16(x_2));
+    low = vshrq_n_s32(vaddq_s32(low, vdupq_n_s32(8192)), 14);
+    high = vshrq_n_s32(vaddq_s32(high, vdupq_n_s32(8192)), 14);
+    // vmovn truncates to 16 bits without saturation, as the conversion in C.
+    vst1q_s16(&output[i], vcombine_s16(vmovn_s32(low), vmovn_s32(high)));
+    factors = vsubq_s16(factors, block_decrement);
+  }
+  CrossFade_C(&input_1[i], &input_2[i], length - i,
+              vgetq_lane_s16(factors, 0), factor_decrement, &output[i]);
+}
+#endif
+
+}  // namespace internal
+}  // namespace webrtc
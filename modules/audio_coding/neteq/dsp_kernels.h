@@ -0,0 +1,130 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_CODING_NETEQ_DSP_KERNELS_H_
+#define MODULES_AUDIO_CODING_NETEQ_DSP_KERNELS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rtc_base/system/arch.h"
+
+namespace webrtc {
+namespace internal {
+
+// Sample loops of the NetEq time-stretching, merging and expansion code. Each
+// function uses the widest vector instructions the CPU supports and gives the
+// same result as its _C variant.
+
+// Calculates `num_lags` cross-correlations between `sequence_1` and
+// `sequence_2`, each over `length` samples. `sequence_2` is moved `step`
+// samples between two lags. Each product is shifted `right_shifts` bits to the
+// right before being summed, as in WebRtcSpl_CrossCorrelation(). On ARM and
+// MIPS this is WebRtcSpl_CrossCorrelation(), which has its own optimized
+// versions.
+void CrossCorrelation(const int16_t* sequence_1,
+                      const int16_t* sequence_2,
+                      size_t length,
+                      size_t num_lags,
+                      int right_shifts,
+                      int step,
+                      int32_t* cross_correlation);
+
+// Returns the dot product of `vector_1` and `vector_2`, with each product
+// shifted `scaling` bits to the right, saturated to 32 bits. Same as
+// WebRtcSpl_DotProductWithScale().
+int32_t DotProductWithScale(const int16_t* vector_1,
+                            const int16_t* vector_2,
+                            size_t length,
+                            int scaling);
+
+// Mixes `input_1` and `input_2` into `output`, with the Q14 weight of
+// `input_1` starting at `factor` and decreasing by `factor_decrement` for each
+// sample. `output` may be the same as `input_1`.
+void CrossFade(const int16_t* input_1,
+               const int16_t* input_2,
+               size_t length,
+               int16_t factor,
+               int16_t factor_decrement,
+               int16_t* output);
+
+// Variants of the functions above for a given instruction set, exposed for
+// testing.
+void CrossCorrelation_C(const int16_t* sequence_1,
+                        const int16_t* sequence_2,
+                        size_t length,
+                        size_t num_lags,
+                        int right_shifts,
+                        int step,
+                        int32_t* cross_correlation);
+int32_t DotProductWithScale_C(const int16_t* vector_1,
+                              const int16_t* vector_2,
+                              size_t length,
+                              int scaling);
+void CrossFade_C(const int16_t* input_1,
+                 const int16_t* input_2,
+                 size_t length,
+                 int16_t factor,
+                 int16_t factor_decrement,
+                 int16_t* output);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void CrossCorrelation_SSE2(const int16_t* sequence_1,
+                           const int16_t* sequence_2,
+                           size_t length,
+                           size_t num_lags,
+                           int right_shifts,
+                           int step,
+                           int32_t* cross_correlation);
+int32_t DotProductWithScale_SSE2(const int16_t* vector_1,
+                                 const int16_t* vector_2,
+                                 size_t length,
+                                 int scaling);
+void CrossFade_SSE2(const int16_t* input_1,
+                    const int16_t* input_2,
+                    size_t length,
+                    int16_t factor,
+                    int16_t factor_decrement,
+                    int16_t* output);
+// Must only be called when GetCPUInfo(kAVX2) is set.
+void CrossCorrelation_AVX2(const int16_t* sequence_1,
+                           const int16_t* sequence_2,
+                           size_t length,
+                           size_t num_lags,
+                           int right_shifts,
+                           int step,
+                           int32_t* cross_correlation);
+int32_t DotProductWithScale_AVX2(const int16_t* vector_1,
+                                 const int16_t* vector_2,
+                                 size_t length,
+                                 int scaling);
+void CrossFade_AVX2(const int16_t* input_1,
+                    const int16_t* input_2,
+                    size_t length,
+                    int16_t factor,
+                    int16_t factor_decrement,
+                    int16_t* output);
+#endif
+#if defined(WEBRTC_HAS_NEON)
+int32_t DotProductWithScale_NEON(const int16_t* vector_1,
+                                 const int16_t* vector_2,
+                                 size_t length,
+                                 int scaling);
+void CrossFade_NEON(const int16_t* input_1,
+                    const int16_t* input_2,
+                    size_t length,
+                    int16_t factor,
+                    int16_t factor_decrement,
+                    int16_t* output);
+#endif
+
+}  // namespace internal
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_CODING_NETEQ_DSP_KERNELS_H_
@@ -0,0 +1,152 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include "modules/audio_coding/neteq/dsp_kernels.h"
+#include "rtc_base/numerics/safe_conversions.h"
+
+namespace webrtc {
+namespace internal {
+namespace {
+
+// Returns the 32 bit products of the 16 samples of `a` and `b`, as two vectors
+// of 8 products each. The products are not in the order of the samples.
+void MultiplyS16(__m256i a, __m256i b, __m256i& low, __m256i& high) {
+  const __m256i product_low = _mm256_mullo_epi16(a, b);
+  const __m256i product_high = _mm256_mulhi_epi16(a, b);
+  low = _mm256_unpacklo_epi16(product_low, product_high);
+  high = _mm256_unpackhi_epi16(product_low, product_high);
+}
+
+// Adds the 8 32 bit values of `x`, sign extended to 64 bits, to `sum`.
+__m256i AddWidened(__m256i sum, __m256i x) {
+  sum = _mm256_add_epi64(sum,
+                         _mm256_cvtepi32_epi64(_mm256_castsi256_si128(x)));
+  return _mm256_add_epi64(
+      sum, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(x, 1)));
+}
+
+}  // namespace
+
+void CrossCorrelation_AVX2(const int16_t* sequence_1,
+                           const int16_t* sequence_2,
+                           size_t length,
+                           size_t num_lags,
+                           int right_shifts,
+                           int step,
+                           int32_t* cross_correlation) {
+  const __m128i shift = _mm_cvtsi32_si128(right_shifts);
+  for (size_t lag = 0; lag < num_lags; ++lag) {
+    // The products are summed in 32 bits, wrapping as in the C version.
+    __m256i sum = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+      __m256i low;
+      __m256i high;
+      MultiplyS16(_mm256_loadu_si256(
+                      reinterpret_cast<const __m256i*>(&sequence_1[i])),
+                  _mm256_loadu_si256(
+                      reinterpret_cast<const __m256i*>(&sequence_2[i])),
+                  low, high);
+      sum = _mm256_add_epi32(sum, _mm256_sra_epi32(low, shift));
+      sum = _mm256_add_epi32(sum, _mm256_sra_epi32(high, shift));
+    }
+    __m128i sum_128 = _mm_add_epi32(_mm256_castsi256_si128(sum),
+                                    _mm256_extracti128_si256(sum, 1));
+    sum_128 = _mm_add_epi32(
+        sum_128, _mm_shuffle_epi32(sum_128, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum_128 = _mm_add_epi32(
+        sum_128, _mm_shuffle_epi32(sum_128, _MM_SHUFFLE(2, 3, 0, 1)));
+    uint32_t correlation = static_cast<uint32_t>(_mm_cvtsi128_si32(sum_128));
+    for (; i < length; ++i) {
+      correlation += static_cast<uint32_t>(
+          (sequence_1[i] * sequence_2[i]) >> right_shifts);
+    }
+    cross_correlation[lag] = static_cast<int32_t>(correlation);
+    sequence_2 += step;
+  }
+}
+
+int32_t DotProductWithScale_AVX2(const int16_t* vector_1,
+                                 const int16_t* vector_2,
+                                 size_t length,
+                                 int scaling) {
+  const __m128i shift = _mm_cvtsi32_si128(scaling);
+  __m256i sum = _mm256_setzero_si256();
+  size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    __m256i low;
+    __m256i high;
+    MultiplyS16(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&vector_1[i])),
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&vector_2[i])),
+        low, high);
+    sum = AddWidened(sum, _mm256_sra_epi32(low, shift));
+    sum = AddWidened(sum, _mm256_sra_epi32(high, shift));
+  }
+  int64_t sums[4];
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(sums), sum);
+  int64_t dot_product = sums[0] + sums[1] + sums[2] + sums[3];
+  for (; i < length; ++i) {
+    dot_product += (vector_1[i] * vector_2[i]) >> scaling;
+  }
+  return rtc::saturated_cast<int32_t>(dot_product);
+}
+
+void CrossFade_AVX2(const int16_t* input_1,
+                    const int16_t* input_2,
+                    size_t length,
+                    int16_t factor,
+                    int16_t factor_decrement,
+                    int16_t* output) {
+  // The factors wrap in 16 bits, as in the C version.
+  const __m256i decrement = _mm256_set1_epi16(factor_decrement);
+  const __m256i block_decrement =
+      _mm256_slli_epi16(decrement, 4);  // 16 samples per block.
+  __m256i factors = _mm256_sub_epi16(
+      _mm256_set1_epi16(factor),
+      _mm256_mullo_epi16(decrement,
+                         _mm256_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10,
+                                           11, 12, 13, 14, 15)));
+  const __m256i one_q14 = _mm256_set1_epi16(16384);
+  const __m256i rounding = _mm256_set1_epi32(8192);
+  size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    const __m256i x_1 =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&input_1[i]));
+    const __m256i x_2 =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&input_2[i]));
+    const __m256i complement_factors = _mm256_sub_epi16(one_q14, factors);
+    // factor * x_1 + complement_factor * x_2, for each sample. The unpacking
+    // and the packing below both work within 128 bit lanes, so the samples
+    // end up in order.
+    __m256i low =
+        _mm256_madd_epi16(_mm256_unpacklo_epi16(x_1, x_2),
+                          _mm256_unpacklo_epi16(factors, complement_factors));
+    __m256i high =
+        _mm256_madd_epi16(_mm256_unpackhi_epi16(x_1, x_2),
+                          _mm256_unpackhi_epi16(factors, complement_factors));
+    low = _mm256_srai_epi32(_mm256_add_epi32(low, rounding), 14);
+    high = _mm256_srai_epi32(_mm256_add_epi32(high, rounding), 14);
+    // Truncate to 16 bits without saturation, as the conversion in C.
+    low = _mm256_srai_epi32(_mm256_slli_epi32(low, 16), 16);
+    high = _mm256_srai_epi32(_mm256_slli_epi32(high, 16), 16);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&output[i]),
+                        _mm256_packs_epi32(low, high));
+    factors = _mm256_sub_epi16(factors, block_decrement);
+  }
+  CrossFade_C(&input_1[i], &input_2[i], length - i,
+              static_cast<int16_t>(_mm256_extract_epi16(factors, 0)),
+              factor_decrement, &output[i]);
+}
+
+}  // namespace internal
+}  // namespace webrtc
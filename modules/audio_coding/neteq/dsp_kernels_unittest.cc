@@ -0,0 +1,177 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/neteq/dsp_kernels.h"
+
+#include <limits>
+#include <vector>
+
+#include "rtc_base/random.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace internal {
+namespace {
+
+using ::testing::ElementsAreArray;
+
+using CrossCorrelationFunction =
+    void (*)(const int16_t*, const int16_t*, size_t, size_t, int, int,
+             int32_t*);
+using DotProductWithScaleFunction = int32_t (*)(const int16_t*,
+                                                const int16_t*,
+                                                size_t,
+                                                int);
+using CrossFadeFunction = void (*)(const int16_t*,
+                                   const int16_t*,
+                                   size_t,
+                                   int16_t,
+                                   int16_t,
+                                   int16_t*);
+
+constexpr size_t kMaxLength = 100;
+constexpr size_t kNumLags = 10;
+
+// Returns `length` random samples, limited to +/- `max_abs`.
+std::vector<int16_t> RandomSamples(Random& random,
+                                   size_t length,
+                                   int max_abs) {
+  std::vector<int16_t> samples(length);
+  for (int16_t& sample : samples) {
+    sample = static_cast<int16_t>(random.Rand(-max_abs, max_abs));
+  }
+  return samples;
+}
+
+// The shifts keep the sums of `kMaxLength` products from overflowing, since
+// the C version doesn't handle that.
+struct Scaling {
+  int max_abs;
+  int shift;
+};
+constexpr Scaling kScalings[] = {{1000, 0}, {32767, 7}, {32767, 10}};
+
+void VerifyCrossCorrelation(CrossCorrelationFunction cross_correlation) {
+  Random random(/*seed=*/1234);
+  for (const Scaling& scaling : kScalings) {
+    for (int step : {1, -1}) {
+      for (size_t length = 0; length <= kMaxLength; ++length) {
+        SCOPED_TRACE(length);
+        const std::vector<int16_t> sequence_1 =
+            RandomSamples(random, length, scaling.max_abs);
+        const std::vector<int16_t> sequence_2 =
+            RandomSamples(random, length + kNumLags, scaling.max_abs);
+        // Start at the end for negative steps.
+        const int16_t* sequence_2_start =
+            step > 0 ? sequence_2.data() : sequence_2.data() + kNumLags;
+        std::vector<int32_t> expected(kNumLags);
+        std::vector<int32_t> result(kNumLags);
+        CrossCorrelation_C(sequence_1.data(), sequence_2_start, length,
+                           kNumLags, scaling.shift, step, expected.data());
+        cross_correlation(sequence_1.data(), sequence_2_start, length,
+                          kNumLags, scaling.shift, step, result.data());
+        EXPECT_THAT(result, ElementsAreArray(expected));
+      }
+    }
+  }
+}
+
+void VerifyDotProductWithScale(DotProductWithScaleFunction dot_product) {
+  Random random(/*seed=*/1234);
+  for (const Scaling& scaling : kScalings) {
+    for (size_t length = 0; length <= kMaxLength; ++length) {
+      SCOPED_TRACE(length);
+      const std::vector<int16_t> vector_1 =
+          RandomSamples(random, length, scaling.max_abs);
+      const std::vector<int16_t> vector_2 =
+          RandomSamples(random, length, scaling.max_abs);
+      EXPECT_EQ(
+          dot_product(vector_1.data(), vector_2.data(), length, scaling.shift),
+          DotProductWithScale_C(vector_1.data(), vector_2.data(), length,
+                                scaling.shift));
+    }
+  }
+  // Saturates rather than wraps.
+  const std::vector<int16_t> loud(kMaxLength, -32768);
+  EXPECT_EQ(dot_product(loud.data(), loud.data(), kMaxLength, 0),
+            std::numeric_limits<int32_t>::max());
+}
+
+void VerifyCrossFade(CrossFadeFunction cross_fade) {
+  Random random(/*seed=*/1234);
+  for (size_t length = 0; length <= kMaxLength; ++length) {
+    SCOPED_TRACE(length);
+    const std::vector<int16_t> input_1 = RandomSamples(random, length, 32767);
+    const std::vector<int16_t> input_2 = RandomSamples(random, length, 32767);
+    // As used by NetEq: fading out `input_1` over the whole length.
+    const int16_t factor_decrement = 16384 / (length + 1);
+    const int16_t factor = 16384 - factor_decrement;
+    std::vector<int16_t> expected(length);
+    std::vector<int16_t> result(length);
+    CrossFade_C(input_1.data(), input_2.data(), length, factor,
+                factor_decrement, expected.data());
+    cross_fade(input_1.data(), input_2.data(), length, factor,
+               factor_decrement, result.data());
+    EXPECT_THAT(result, ElementsAreArray(expected));
+
+    // In place, and with factors going out of range.
+    std::vector<int16_t> in_place = input_1;
+    CrossFade_C(input_1.data(), input_2.data(), length, 16384, 500,
+                expected.data());
+    cross_fade(in_place.data(), input_2.data(), length, 16384, 500,
+               in_place.data());
+    EXPECT_THAT(in_place, ElementsAreArray(expected));
+  }
+}
+
+TEST(NetEqDspKernelsTest, DotProductWithScale) {
+  VerifyDotProductWithScale(&DotProductWithScale);
+}
+
+TEST(NetEqDspKernelsTest, CrossFade) {
+  VerifyCrossFade(&CrossFade);
+}
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+TEST(NetEqDspKernelsTest, CrossCorrelation) {
+  VerifyCrossCorrelation(&CrossCorrelation);
+}
+
+TEST(NetEqDspKernelsTest, Sse2) {
+  if (GetCPUInfo(kSSE2) == 0) {
+    GTEST_SKIP() << "SSE2 is not supported.";
+  }
+  VerifyCrossCorrelation(&CrossCorrelation_SSE2);
+  VerifyDotProductWithScale(&DotProductWithScale_SSE2);
+  VerifyCrossFade(&CrossFade_SSE2);
+}
+
+TEST(NetEqDspKernelsTest, Avx2) {
+  if (GetCPUInfo(kAVX2) == 0) {
+    GTEST_SKIP() << "AVX2 is not supported.";
+  }
+  VerifyCrossCorrelation(&CrossCorrelation_AVX2);
+  VerifyDotProductWithScale(&DotProductWithScale_AVX2);
+  VerifyCrossFade(&CrossFade_AVX2);
+}
+#endif
+
+#if defined(WEBRTC_HAS_NEON)
+TEST(NetEqDspKernelsTest, Neon) {
+  VerifyDotProductWithScale(&DotProductWithScale_NEON);
+  VerifyCrossFade(&CrossFade_NEON);
+}
+#endif
+
+}  // namespace
+}  // namespace internal
+}  // namespace webrtc
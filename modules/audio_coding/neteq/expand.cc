@@ -20,6 +20,7 @@
 #include "modules/audio_coding/neteq/background_noise.h"
 #include "modules/audio_coding/neteq/cross_correlation.h"
 #include "modules/audio_coding/neteq/dsp_helper.h"
+#include "modules/audio_coding/neteq/dsp_kernels.h"
 #include "modules/audio_coding/neteq/random_vector.h"
 #include "modules/audio_coding/neteq/statistics_calculator.h"
 #include "modules/audio_coding/neteq/sync_buffer.h"
@@ -106,6 +107,7 @@ int Expand::Process(AudioMultiVector* output) {
   size_t expansion_vector_position =
       expansion_vector_length - current_lag - overlap_length_;
   size_t temp_length = current_lag + overlap_length_;
+  RTC_DCHECK_LE(temp_length, kMaxExpansionLength);
   for (size_t channel_ix = 0; channel_ix < num_channels_; ++channel_ix) {
     ChannelParameters& parameters = channel_parameters_[channel_ix];
     if (current_lag_index_ == 0) {
@@ -115,14 +117,14 @@ int Expand::Process(AudioMultiVector* output) {
       parameters.expand_vector0.CopyTo(temp_length, expansion_vector_position,
                                        voiced_vector_storage);
     } else if (current_lag_index_ == 1) {
-      std::unique_ptr<int16_t[]> temp_0(new int16_t[temp_length]);
+      int16_t temp_0[kMaxExpansionLength];
       parameters.expand_vector0.CopyTo(temp_length, expansion_vector_position,
-                                       temp_0.get());
-      std::unique_ptr<int16_t[]> temp_1(new int16_t[temp_length]);
+                                       temp_0);
+      int16_t temp_1[kMaxExpansionLength];
       parameters.expand_vector1.CopyTo(temp_length, expansion_vector_position,
-                                       temp_1.get());
+                                       temp_1);
       // Mix 3/4 of expand_vector0 with 1/4 of expand_vector1.
-      WebRtcSpl_ScaleAndAddVectorsWithRound(temp_0.get(), 3, temp_1.get(), 1, 2,
+      WebRtcSpl_ScaleAndAddVectorsWithRound(temp_0, 3, temp_1, 1, 2,
                                             voiced_vector_storage, temp_length);
     } else if (current_lag_index_ == 2) {
       // Mix 1/2 of expand_vector0 with 1/2 of expand_vector1.
@@ -131,13 +133,13 @@ int Expand::Process(AudioMultiVector* output) {
       RTC_DCHECK_LE(expansion_vector_position + temp_length,
                     parameters.expand_vector1.Size());
 
-      std::unique_ptr<int16_t[]> temp_0(new int16_t[temp_length]);
+      int16_t temp_0[kMaxExpansionLength];
       parameters.expand_vector0.CopyTo(temp_length, expansion_vector_position,
-                                       temp_0.get());
-      std::unique_ptr<int16_t[]> temp_1(new int16_t[temp_length]);
+                                       temp_0);
+      int16_t temp_1[kMaxExpansionLength];
       parameters.expand_vector1.CopyTo(temp_length, expansion_vector_position,
-                                       temp_1.get());
-      WebRtcSpl_ScaleAndAddVectorsWithRound(temp_0.get(), 1, temp_1.get(), 1, 1,
+                                       temp_1);
+      WebRtcSpl_ScaleAndAddVectorsWithRound(temp_0, 1, temp_1, 1, 1,
                                             voiced_vector_storage, temp_length);
     }
 
@@ -393,9 +395,9 @@ void Expand::AnalyzeSignal(int16_t* random_vector) {
   const size_t signal_length = static_cast<size_t>(256 * fs_mult);
 
   const size_t audio_history_position = sync_buffer_->Size() - signal_length;
-  std::unique_ptr<int16_t[]> audio_history(new int16_t[signal_length]);
+  int16_t audio_history[256 * kMaxSampleRate / 8000];
   (*sync_buffer_)[0].CopyTo(signal_length, audio_history_position,
-                            audio_history.get());
+                            audio_history);
 
   // Initialize.
   InitializeForAnExpandPeriod();
@@ -404,7 +406,7 @@ void Expand::AnalyzeSignal(int16_t* random_vector) {
   size_t correlation_length = 51;  // TODO(hlundin): Legacy bit-exactness.
   // If it is decided to break bit-exactness `correlation_length` should be
   // initialized to the return value of Correlation().
-  Correlation(audio_history.get(), signal_length, correlation_vector);
+  Correlation(audio_history, signal_length, correlation_vector);
 
   // Find peaks in correlation vector.
   DspHelper::PeakDetection(correlation_vector, correlation_length,
@@ -474,7 +476,7 @@ void Expand::AnalyzeSignal(int16_t* random_vector) {
       // other cases, we will have to copy the correct channel into
       // audio_history.
       (*sync_buffer_)[channel_ix].CopyTo(signal_length, audio_history_position,
-                                         audio_history.get());
+                                         audio_history);
     }
 
     // Calculate suitable scaling.
@@ -488,11 +490,11 @@ void Expand::AnalyzeSignal(int16_t* random_vector) {
     correlation_scale = std::max(0, correlation_scale);
 
     // Calculate the correlation, store in `correlation_vector2`.
-    WebRtcSpl_CrossCorrelation(
-        correlation_vector2,
+    internal::CrossCorrelation(
         &(audio_history[signal_length - correlation_length]),
         &(audio_history[signal_length - correlation_length - start_index]),
-        correlation_length, correlation_lags, correlation_scale, -1);
+        correlation_length, correlation_lags, correlation_scale, -1,
+        correlation_vector2);
 
     // Find maximizing index.
     best_index = WebRtcSpl_MaxIndexW32(correlation_vector2, correlation_lags);
@@ -501,11 +503,11 @@ void Expand::AnalyzeSignal(int16_t* random_vector) {
     best_index = best_index + start_index;
 
     // Calculate energies.
-    int32_t energy1 = WebRtcSpl_DotProductWithScale(
+    int32_t energy1 = internal::DotProductWithScale(
         &(audio_history[signal_length - correlation_length]),
         &(audio_history[signal_length - correlation_length]),
         correlation_length, correlation_scale);
-    int32_t energy2 = WebRtcSpl_DotProductWithScale(
+    int32_t energy2 = internal::DotProductWithScale(
         &(audio_history[signal_length - correlation_length - best_index]),
         &(audio_history[signal_length - correlation_length - best_index]),
         correlation_length, correlation_scale);
@@ -542,10 +544,10 @@ void Expand::AnalyzeSignal(int16_t* random_vector) {
     const int16_t* vector1 = &(audio_history[signal_length - expansion_length]);
     const int16_t* vector2 = vector1 - distortion_lag;
     // Normalize the second vector to the same energy as the first.
-    energy1 = WebRtcSpl_DotProductWithScale(vector1, vector1, expansion_length,
-                                            correlation_scale);
-    energy2 = WebRtcSpl_DotProductWithScale(vector2, vector2, expansion_length,
-                                            correlation_scale);
+    energy1 = internal::DotProductWithScale(vector1, vector1,
+                                            expansion_length, correlation_scale);
+    energy2 = internal::DotProductWithScale(vector2, vector2,
+                                            expansion_length, correlation_scale);
     // Confirm that amplitude ratio sqrt(energy1 / energy2) is within 0.5 - 2.0,
     // i.e., energy1 / energy2 is within 0.25 - 4.
     int16_t amplitude_ratio;
@@ -569,11 +571,12 @@ void Expand::AnalyzeSignal(int16_t* random_vector) {
         parameters.expand_vector1.Extend(expansion_length -
                                          parameters.expand_vector1.Size());
       }
-      std::unique_ptr<int16_t[]> temp_1(new int16_t[expansion_length]);
-      WebRtcSpl_AffineTransformVector(
-          temp_1.get(), const_cast<int16_t*>(vector2), amplitude_ratio, 4096,
-          13, expansion_length);
-      parameters.expand_vector1.OverwriteAt(temp_1.get(), expansion_length, 0);
+      RTC_DCHECK_LE(expansion_length, kMaxExpansionLength);
+      int16_t temp_1[kMaxExpansionLength];
+      WebRtcSpl_AffineTransformVector(temp_1, const_cast<int16_t*>(vector2),
+                                      amplitude_ratio, 4096, 13,
+                                      expansion_length);
+      parameters.expand_vector1.OverwriteAt(temp_1, expansion_length, 0);
     } else {
       // Energy change constraint not fulfilled. Only use last vector.
       parameters.expand_vector0.Clear();
@@ -614,8 +617,8 @@ void Expand::AnalyzeSignal(int16_t* random_vector) {
     size_t temp_index =
         signal_length - fs_mult_lpc_analysis_len - kUnvoicedLpcOrder;
     // Copy signal to temporary vector to be able to pad with leading zeros.
-    int16_t* temp_signal =
-        new int16_t[fs_mult_lpc_analysis_len + kUnvoicedLpcOrder];
+    int16_t temp_signal[kMaxSampleRate / 8000 * kLpcAnalysisLength +
+                        kUnvoicedLpcOrder];
     memset(temp_signal, 0,
            sizeof(int16_t) * (fs_mult_lpc_analysis_len + kUnvoicedLpcOrder));
     memcpy(&temp_signal[kUnvoicedLpcOrder],
@@ -624,7 +627,6 @@ void Expand::AnalyzeSignal(int16_t* random_vector) {
     CrossCorrelationWithAutoShift(
         &temp_signal[kUnvoicedLpcOrder], &temp_signal[kUnvoicedLpcOrder],
         fs_mult_lpc_analysis_len, kUnvoicedLpcOrder + 1, -1, auto_correlation);
-    delete[] temp_signal;
 
     // Verify that variance is positive.
     if (auto_correlation[0] > 0) {
@@ -691,7 +693,7 @@ void Expand::AnalyzeSignal(int16_t* random_vector) {
     int unvoiced_prescale =
         std::max(0, 2 * WebRtcSpl_GetSizeInBits(unvoiced_max_abs) - 24);
 
-    int32_t unvoiced_energy = WebRtcSpl_DotProductWithScale(
+    int32_t unvoiced_energy = internal::DotProductWithScale(
         unvoiced_vector, unvoiced_vector, 128, unvoiced_prescale);
 
     // Normalize `unvoiced_energy` to 28 or 29 bits to preserve sqrt() accuracy.
@@ -99,6 +99,8 @@ class Expand {
   static const size_t kDistortionLength = 20;
   static const size_t kLpcAnalysisLength = 160;
   static const size_t kMaxSampleRate = 48000;
+  // Upper bound of `max_lag_` + `overlap_length_`.
+  static const size_t kMaxExpansionLength = kMaxSampleRate / 8000 * 125;
   static const int kNumLags = 3;
 
   struct ChannelParameters {
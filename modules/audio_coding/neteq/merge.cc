@@ -13,12 +13,12 @@
 #include <string.h>  // memmove, memcpy, memset, size_t
 
 #include <algorithm>  // min, max
-#include <memory>
 
 #include "common_audio/signal_processing/include/signal_processing_library.h"
 #include "modules/audio_coding/neteq/audio_multi_vector.h"
 #include "modules/audio_coding/neteq/cross_correlation.h"
 #include "modules/audio_coding/neteq/dsp_helper.h"
+#include "modules/audio_coding/neteq/dsp_kernels.h"
 #include "modules/audio_coding/neteq/expand.h"
 #include "modules/audio_coding/neteq/sync_buffer.h"
 #include "rtc_base/numerics/safe_conversions.h"
@@ -36,7 +36,9 @@ Merge::Merge(int fs_hz,
       timestamps_per_call_(static_cast<size_t>(fs_hz_ / 100)),
       expand_(expand),
       sync_buffer_(sync_buffer),
-      expanded_(num_channels_) {
+      expanded_(num_channels_),
+      expanded_temp_(num_channels_),
+      input_vector_(num_channels_) {
   RTC_DCHECK_GT(num_channels_, 0);
 }
 
@@ -59,33 +61,33 @@ size_t Merge::Process(int16_t* input,
   size_t expanded_length = GetExpandedSignal(&old_length, &expand_period);
 
   // Transfer input signal to an AudioMultiVector.
-  AudioMultiVector input_vector(num_channels_);
-  input_vector.PushBackInterleaved(
+  input_vector_.Clear();
+  input_vector_.PushBackInterleaved(
       rtc::ArrayView<const int16_t>(input, input_length));
-  size_t input_length_per_channel = input_vector.Size();
+  size_t input_length_per_channel = input_vector_.Size();
   RTC_DCHECK_EQ(input_length_per_channel, input_length / num_channels_);
 
   size_t best_correlation_index = 0;
   size_t output_length = 0;
 
-  std::unique_ptr<int16_t[]> input_channel(
-      new int16_t[input_length_per_channel]);
-  std::unique_ptr<int16_t[]> expanded_channel(new int16_t[expanded_length]);
+  input_channel_.resize(input_length_per_channel);
+  expanded_channel_.resize(expanded_length);
+  int16_t* const input_channel = input_channel_.data();
+  int16_t* const expanded_channel = expanded_channel_.data();
   for (size_t channel = 0; channel < num_channels_; ++channel) {
-    input_vector[channel].CopyTo(input_length_per_channel, 0,
-                                 input_channel.get());
-    expanded_[channel].CopyTo(expanded_length, 0, expanded_channel.get());
+    input_vector_[channel].CopyTo(input_length_per_channel, 0, input_channel);
+    expanded_[channel].CopyTo(expanded_length, 0, expanded_channel);
 
     const int16_t new_mute_factor = std::min<int16_t>(
-        16384, SignalScaling(input_channel.get(), input_length_per_channel,
-                             expanded_channel.get()));
+        16384,
+        SignalScaling(input_channel, input_length_per_channel, expanded_channel));
 
     if (channel == 0) {
       // Downsample, correlate, and find strongest correlation period for the
       // reference (i.e., first) channel only.
       // Downsample to 4kHz sample rate.
-      Downsample(input_channel.get(), input_length_per_channel,
-                 expanded_channel.get(), expanded_length);
+      Downsample(input_channel, input_length_per_channel, expanded_channel,
+                 expanded_length);
 
       // Calculate the lag of the strongest correlation period.
       best_correlation_index = CorrelateAndPeakSearch(
@@ -116,7 +118,7 @@ size_t Merge::Process(int16_t* input,
           ((16384 - mute_factor) << 6) / input_length_per_channel);
       const int increment = std::max(4194 / fs_mult_, back_to_fullscale_inc);
       mute_factor = static_cast<int16_t>(DspHelper::RampSignal(
-          input_channel.get(), interpolation_length, mute_factor, increment));
+          input_channel, interpolation_length, mute_factor, increment));
       DspHelper::UnmuteSignal(&input_channel[interpolation_length],
                               input_length_per_channel - interpolation_length,
                               &mute_factor, increment,
@@ -133,11 +135,11 @@ size_t Merge::Process(int16_t* input,
     int16_t increment =
         static_cast<int16_t>(16384 / (interpolation_length + 1));  // In Q14.
     int16_t local_mute_factor = 16384 - increment;
-    memmove(temp_data_.data(), expanded_channel.get(),
+    memmove(temp_data_.data(), expanded_channel,
             sizeof(int16_t) * best_correlation_index);
     DspHelper::CrossFade(&expanded_channel[best_correlation_index],
-                         input_channel.get(), interpolation_length,
-                         &local_mute_factor, increment, decoded_output);
+                         input_channel, interpolation_length, &local_mute_factor,
+                         increment, decoded_output);
 
     output_length = best_correlation_index + input_length_per_channel;
     if (channel == 0) {
@@ -183,22 +185,22 @@ size_t Merge::GetExpandedSignal(size_t* old_length, size_t* expand_period) {
   // This assert should always be true thanks to the if statement above.
   RTC_DCHECK_GE(210 * kMaxSampleRate / 8000, *old_length);
 
-  AudioMultiVector expanded_temp(num_channels_);
-  expand_->Process(&expanded_temp);
-  *expand_period = expanded_temp.Size();  // Samples per channel.
+  expanded_temp_.Clear();
+  expand_->Process(&expanded_temp_);
+  *expand_period = expanded_temp_.Size();  // Samples per channel.
 
   expanded_.Clear();
   // Copy what is left since earlier into the expanded vector.
   expanded_.PushBackFromIndex(*sync_buffer_, sync_buffer_->next_index());
   RTC_DCHECK_EQ(expanded_.Size(), *old_length);
-  RTC_DCHECK_GT(expanded_temp.Size(), 0);
+  RTC_DCHECK_GT(expanded_temp_.Size(), 0);
   // Do "ugly" copy and paste from the expanded in order to generate more data
   // to correlate (but not interpolate) with.
   const size_t required_length = static_cast<size_t>((120 + 80 + 2) * fs_mult_);
   if (expanded_.Size() < required_length) {
     while (expanded_.Size() < required_length) {
       // Append one more pitch period each time.
-      expanded_.PushBack(expanded_temp);
+      expanded_.PushBack(expanded_temp_);
     }
     // Trim the length to exactly `required_length`.
     expanded_.PopBack(expanded_.Size() - required_length);
@@ -219,7 +221,7 @@ int16_t Merge::SignalScaling(const int16_t* input,
       (expanded_max * expanded_max) / (std::numeric_limits<int32_t>::max() /
                                        static_cast<int32_t>(mod_input_length));
   const int expanded_shift = factor == 0 ? 0 : 31 - WebRtcSpl_NormW32(factor);
-  int32_t energy_expanded = WebRtcSpl_DotProductWithScale(
+  int32_t energy_expanded = internal::DotProductWithScale(
       expanded_signal, expanded_signal, mod_input_length, expanded_shift);
 
   // Calculate energy of input signal.
@@ -227,7 +229,7 @@ int16_t Merge::SignalScaling(const int16_t* input,
   factor = (input_max * input_max) / (std::numeric_limits<int32_t>::max() /
                                       static_cast<int32_t>(mod_input_length));
   const int input_shift = factor == 0 ? 0 : 31 - WebRtcSpl_NormW32(factor);
-  int32_t energy_input = WebRtcSpl_DotProductWithScale(
+  int32_t energy_input = internal::DotProductWithScale(
       input, input, mod_input_length, input_shift);
 
   // Align to the same Q-domain.
@@ -330,9 +332,10 @@ size_t Merge::CorrelateAndPeakSearch(size_t start_position,
   // Normalize correlation to 14 bits and copy to a 16-bit array.
   const size_t pad_length = expand_->overlap_length() - 1;
   const size_t correlation_buffer_size = 2 * pad_length + kMaxCorrelationLength;
-  std::unique_ptr<int16_t[]> correlation16(
-      new int16_t[correlation_buffer_size]);
-  memset(correlation16.get(), 0, correlation_buffer_size * sizeof(int16_t));
+  constexpr size_t kMaxPadLength = 5 * kMaxSampleRate / 8000 - 1;
+  RTC_DCHECK_LE(pad_length, kMaxPadLength);
+  int16_t correlation16[2 * kMaxPadLength + kMaxCorrelationLength];
+  memset(correlation16, 0, correlation_buffer_size * sizeof(int16_t));
   int16_t* correlation_ptr = &correlation16[pad_length];
   int32_t max_correlation =
       WebRtcSpl_MaxAbsValueW32(correlation, stop_position_downsamp);
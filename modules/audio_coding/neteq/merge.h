@@ -94,6 +94,11 @@ class Merge {
   int16_t expanded_downsampled_[kExpandDownsampLength];
   int16_t input_downsampled_[kInputDownsampLength];
   AudioMultiVector expanded_;
+  // Scratch memory kept between calls, to not allocate while merging.
+  AudioMultiVector expanded_temp_;
+  AudioMultiVector input_vector_;
+  std::vector<int16_t> input_channel_;
+  std::vector<int16_t> expanded_channel_;
   std::vector<int16_t> temp_data_;
 };
 
@@ -0,0 +1,88 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "modules/audio_coding/neteq/dsp_kernels.h"
+#include "modules/audio_coding/neteq/tools/neteq_performance_test.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/system/unused.h"
+
+namespace webrtc {
+namespace {
+
+// Sizes used by TimeStretch at 48 kHz: 50 correlation lags over 50 samples of
+// the signal downsampled to 4 kHz, and a cross-fade of up to 15 ms.
+constexpr size_t kCorrelationLength = 50;
+constexpr size_t kNumLags = 50;
+constexpr size_t kCrossFadeLength = 720;
+
+std::vector<int16_t> Signal(size_t length) {
+  std::vector<int16_t> signal(length);
+  for (size_t i = 0; i < length; ++i) {
+    signal[i] =
+        static_cast<int16_t>(static_cast<int>((i * 7919) % 20000) - 10000);
+  }
+  return signal;
+}
+
+// `state.range(0)` selects the plain C version (0) or the fastest available
+// one (1).
+void BM_CrossCorrelation(benchmark::State& state) {
+  const std::vector<int16_t> signal = Signal(kCorrelationLength + kNumLags);
+  std::vector<int32_t> correlation(kNumLags);
+  const auto cross_correlation = state.range(0) == 0
+                                     ? &internal::CrossCorrelation_C
+                                     : &internal::CrossCorrelation;
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    cross_correlation(signal.data(), signal.data() + kNumLags,
+                      kCorrelationLength, kNumLags, /*right_shifts=*/5,
+                      /*step=*/-1, correlation.data());
+    benchmark::DoNotOptimize(correlation.data());
+  }
+}
+
+void BM_CrossFade(benchmark::State& state) {
+  const std::vector<int16_t> input_1 = Signal(kCrossFadeLength);
+  const std::vector<int16_t> input_2 = Signal(kCrossFadeLength + 1);
+  std::vector<int16_t> output(kCrossFadeLength);
+  const auto cross_fade =
+      state.range(0) == 0 ? &internal::CrossFade_C : &internal::CrossFade;
+  const int16_t factor_decrement = 16384 / (kCrossFadeLength + 1);
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    cross_fade(input_1.data(), input_2.data() + 1, kCrossFadeLength,
+               16384 - factor_decrement, factor_decrement, output.data());
+    benchmark::DoNotOptimize(output.data());
+  }
+}
+
+// Runs one second of NetEq with packet loss (one out of `state.range(0)`
+// packets) and clock drift, so that all of Expand, Merge, Accelerate and
+// PreemptiveExpand are exercised.
+void BM_NetEqWithLossAndDrift(benchmark::State& state) {
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    RTC_CHECK_GE(test::NetEqPerformanceTest::Run(
+                     /*runtime_ms=*/1000, /*lossrate=*/state.range(0),
+                     /*drift_factor=*/0.1),
+                 0);
+  }
+}
+
+}  // namespace
+
+BENCHMARK(BM_CrossCorrelation)->Arg(0)->Arg(1);
+BENCHMARK(BM_CrossFade)->Arg(0)->Arg(1);
+BENCHMARK(BM_NetEqWithLossAndDrift)->Arg(10)->Arg(3);
+
+}  // namespace webrtc
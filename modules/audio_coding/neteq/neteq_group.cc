@@ -0,0 +1,40 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/neteq/neteq_group.h"
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+NetEqGroup::NetEqGroup(int num_threads)
+    : processor_(num_threads, "neteq_group_worker") {}
+
+NetEqGroup::~NetEqGroup() = default;
+
+int NetEqGroup::GetAudio(rtc::ArrayView<NetEq* const> neteqs,
+                         rtc::ArrayView<AudioFrame> audio_frames,
+                         rtc::ArrayView<int> results) {
+  RTC_DCHECK_EQ(neteqs.size(), audio_frames.size());
+  RTC_DCHECK_EQ(neteqs.size(), results.size());
+  processor_.Run(neteqs.size(), [&](size_t i) {
+    bool muted = false;
+    results[i] = neteqs[i]->GetAudio(&audio_frames[i], &muted);
+  });
+  int num_errors = 0;
+  for (int result : results) {
+    if (result != NetEq::kOK) {
+      ++num_errors;
+    }
+  }
+  return num_errors;
+}
+
+}  // namespace webrtc
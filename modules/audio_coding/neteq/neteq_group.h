@@ -0,0 +1,53 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_CODING_NETEQ_NETEQ_GROUP_H_
+#define MODULES_AUDIO_CODING_NETEQ_NETEQ_GROUP_H_
+
+#include "api/array_view.h"
+#include "api/audio/audio_frame.h"
+#include "api/neteq/neteq.h"
+#include "modules/audio_processing/utility/parallel_channel_processor.h"
+
+namespace webrtc {
+
+// Advances a group of NetEq instances by one 10 ms frame in a single call,
+// spreading the instances over a pool of worker threads. Meant for servers
+// that receive many streams in one process, where pulling each stream in turn
+// does not scale beyond one core.
+//
+// GetAudio() may be called from one thread at a time. The instances may be
+// used from other threads in between, as NetEq is thread-safe.
+class NetEqGroup {
+ public:
+  // Uses `num_threads` threads, including the one calling GetAudio().
+  explicit NetEqGroup(int num_threads);
+  ~NetEqGroup();
+
+  NetEqGroup(const NetEqGroup&) = delete;
+  NetEqGroup& operator=(const NetEqGroup&) = delete;
+
+  int num_threads() const { return processor_.num_threads(); }
+
+  // Calls GetAudio() on each of `neteqs`, writing the audio of `neteqs[i]` to
+  // `audio_frames[i]` and its return value to `results[i]`. A muted frame is
+  // marked as such in `audio_frames[i]`. Each instance must only be in
+  // `neteqs` once. Returns the number of instances that returned an error.
+  int GetAudio(rtc::ArrayView<NetEq* const> neteqs,
+               rtc::ArrayView<AudioFrame> audio_frames,
+               rtc::ArrayView<int> results);
+
+ private:
+  ParallelChannelProcessor processor_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_CODING_NETEQ_NETEQ_GROUP_H_
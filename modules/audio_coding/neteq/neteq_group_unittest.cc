@@ -0,0 +1,115 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/neteq/neteq_group.h"
+
+#include <memory>
+#include <vector>
+
+#include "api/audio_codecs/L16/audio_decoder_L16.h"
+#include "api/audio_codecs/audio_decoder_factory_template.h"
+#include "modules/audio_coding/codecs/pcm16b/pcm16b.h"
+#include "modules/audio_coding/neteq/default_neteq_factory.h"
+#include "system_wrappers/include/clock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kSampleRateHz = 16000;
+constexpr size_t kFrameSamples = kSampleRateHz / 100;
+constexpr int kPayloadType = 95;
+constexpr size_t kNumStreams = 8;
+
+// Two sets of identical NetEq instances, fed with the same packets.
+class NetEqGroupTest : public ::testing::Test {
+ protected:
+  NetEqGroupTest() : clock_(0) {
+    NetEq::Config config;
+    config.sample_rate_hz = kSampleRateHz;
+    DefaultNetEqFactory neteq_factory;
+    auto decoder_factory = CreateAudioDecoderFactory<AudioDecoderL16>();
+    for (size_t i = 0; i < kNumStreams; ++i) {
+      for (auto* neteqs : {&grouped_, &serial_}) {
+        neteqs->push_back(
+            neteq_factory.CreateNetEq(config, decoder_factory, &clock_));
+        EXPECT_TRUE(neteqs->back()->RegisterPayloadType(
+            kPayloadType, SdpAudioFormat("l16", kSampleRateHz, 1)));
+      }
+    }
+  }
+
+  // Inserts the packet with sequence number `sequence_number` into the
+  // instances of stream `stream`, unless it is lost. Each stream has its own
+  // signal and loss pattern.
+  void InsertPacket(size_t stream, uint16_t sequence_number) {
+    if (sequence_number % (stream + 3) == 0) {
+      return;
+    }
+    int16_t samples[kFrameSamples];
+    for (size_t i = 0; i < kFrameSamples; ++i) {
+      samples[i] = static_cast<int16_t>(
+          ((sequence_number * kFrameSamples + i) * (stream + 1) * 37) % 8000);
+    }
+    uint8_t payload[kFrameSamples * 2];
+    WebRtcPcm16b_Encode(samples, kFrameSamples, payload);
+    RTPHeader header;
+    header.payloadType = kPayloadType;
+    header.sequenceNumber = sequence_number;
+    header.timestamp = sequence_number * kFrameSamples;
+    header.ssrc = static_cast<uint32_t>(stream);
+    EXPECT_EQ(grouped_[stream]->InsertPacket(header, payload), NetEq::kOK);
+    EXPECT_EQ(serial_[stream]->InsertPacket(header, payload), NetEq::kOK);
+  }
+
+  SimulatedClock clock_;
+  std::vector<std::unique_ptr<NetEq>> grouped_;
+  std::vector<std::unique_ptr<NetEq>> serial_;
+};
+
+TEST_F(NetEqGroupTest, ProducesSameAudioAsSerialPulls) {
+  NetEqGroup group(/*num_threads=*/4);
+  std::vector<NetEq*> neteqs;
+  for (const auto& neteq : grouped_) {
+    neteqs.push_back(neteq.get());
+  }
+  std::vector<AudioFrame> frames(kNumStreams);
+  std::vector<int> results(kNumStreams);
+  AudioFrame expected;
+
+  for (uint16_t sequence_number = 0; sequence_number < 200;
+       ++sequence_number) {
+    for (size_t stream = 0; stream < kNumStreams; ++stream) {
+      InsertPacket(stream, sequence_number);
+    }
+    EXPECT_EQ(group.GetAudio(neteqs, frames, results), 0);
+    for (size_t stream = 0; stream < kNumStreams; ++stream) {
+      bool muted;
+      ASSERT_EQ(serial_[stream]->GetAudio(&expected, &muted), NetEq::kOK);
+      EXPECT_EQ(results[stream], NetEq::kOK);
+      ASSERT_EQ(frames[stream].samples_per_channel_,
+                expected.samples_per_channel_);
+      EXPECT_EQ(frames[stream].timestamp_, expected.timestamp_);
+      EXPECT_EQ(frames[stream].speech_type_, expected.speech_type_);
+      for (size_t i = 0; i < expected.samples_per_channel_; ++i) {
+        ASSERT_EQ(frames[stream].data()[i], expected.data()[i]);
+      }
+    }
+    clock_.AdvanceTimeMilliseconds(10);
+  }
+}
+
+TEST_F(NetEqGroupTest, HandlesEmptyGroup) {
+  NetEqGroup group(/*num_threads=*/2);
+  EXPECT_EQ(group.GetAudio({}, {}, {}), 0);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -451,6 +451,16 @@ int NetEqImpl::SyncBufferSizeMs() const {
                                  rtc::CheckedDivExact(fs_hz_, 1000));
 }
 
+size_t NetEqImpl::GetMemoryUsageBytes() const {
+  MutexLock lock(&mutex_);
+  const size_t audio_samples =
+      sync_buffer_->Channels() * sync_buffer_->Size() +
+      algorithm_buffer_->Channels() * algorithm_buffer_->Size() +
+      decoded_buffer_length_;
+  return packet_buffer_->GetMemoryUsageBytes() +
+         audio_samples * sizeof(int16_t);
+}
+
 const SyncBuffer* NetEqImpl::sync_buffer_for_test() const {
   MutexLock lock(&mutex_);
   return sync_buffer_.get();
@@ -1923,7 +1933,8 @@ int NetEqImpl::DtmfOverdub(const DtmfEvent& dtmf_event,
     overdub_length = output_size_samples_ - out_index;
   }
 
-  AudioMultiVector dtmf_output(num_channels);
+  RTC_DCHECK_EQ(dtmf_output_->Channels(), num_channels);
+  dtmf_output_->Clear();
   int dtmf_return_value = 0;
   if (!dtmf_tone_generator_->initialized()) {
     dtmf_return_value = dtmf_tone_generator_->Init(fs_hz_, dtmf_event.event_no,
@@ -1931,10 +1942,10 @@ int NetEqImpl::DtmfOverdub(const DtmfEvent& dtmf_event,
   }
   if (dtmf_return_value == 0) {
     dtmf_return_value =
-        dtmf_tone_generator_->Generate(overdub_length, &dtmf_output);
-    RTC_DCHECK_EQ(overdub_length, dtmf_output.Size());
+        dtmf_tone_generator_->Generate(overdub_length, dtmf_output_.get());
+    RTC_DCHECK_EQ(overdub_length, dtmf_output_->Size());
   }
-  dtmf_output.ReadInterleaved(overdub_length, &output[out_index]);
+  dtmf_output_->ReadInterleaved(overdub_length, &output[out_index]);
   return dtmf_return_value < 0 ? dtmf_return_value : 0;
 }
 
@@ -2058,8 +2069,11 @@ void NetEqImpl::SetSampleRateAndChannels(int fs_hz, size_t channels) {
   if (cng_decoder)
     cng_decoder->Reset();
 
-  // Delete algorithm buffer and create a new one.
+  // Delete algorithm buffer and create a new one, with room for the longest
+  // decoded frame so that it does not grow while producing audio.
   algorithm_buffer_.reset(new AudioMultiVector(channels));
+  algorithm_buffer_->Reserve(kMaxFrameSize);
+  dtmf_output_.reset(new AudioMultiVector(channels));
 
   // Delete sync buffer and create a new one.
   sync_buffer_.reset(new SyncBuffer(channels, kSyncBufferSize * fs_mult_));
@@ -188,6 +188,8 @@ class NetEqImpl : public webrtc::NetEq {
 
   int SyncBufferSizeMs() const override;
 
+  size_t GetMemoryUsageBytes() const override;
+
   // This accessor method is only intended for testing purposes.
   const SyncBuffer* sync_buffer_for_test() const;
   Operation last_operation_for_test() const;
@@ -362,6 +364,7 @@ class NetEqImpl : public webrtc::NetEq {
   std::unique_ptr<BackgroundNoise> background_noise_ RTC_GUARDED_BY(mutex_);
   std::unique_ptr<NetEqController> controller_ RTC_GUARDED_BY(mutex_);
   std::unique_ptr<AudioMultiVector> algorithm_buffer_ RTC_GUARDED_BY(mutex_);
+  std::unique_ptr<AudioMultiVector> dtmf_output_ RTC_GUARDED_BY(mutex_);
   std::unique_ptr<SyncBuffer> sync_buffer_ RTC_GUARDED_BY(mutex_);
   std::unique_ptr<Expand> expand_ RTC_GUARDED_BY(mutex_);
   std::unique_ptr<Normal> normal_ RTC_GUARDED_BY(mutex_);
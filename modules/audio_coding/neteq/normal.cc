@@ -18,6 +18,7 @@
 #include "modules/audio_coding/neteq/audio_multi_vector.h"
 #include "modules/audio_coding/neteq/background_noise.h"
 #include "modules/audio_coding/neteq/decoder_database.h"
+#include "modules/audio_coding/neteq/dsp_kernels.h"
 #include "modules/audio_coding/neteq/expand.h"
 #include "rtc_base/checks.h"
 
@@ -64,28 +65,33 @@ int Normal::Process(const int16_t* input,
     expand_->SetParametersForNormalAfterExpand();
 
     // Call Expand.
-    AudioMultiVector expanded(output->Channels());
+    if (!expanded_ || expanded_->Channels() != output->Channels()) {
+      expanded_ = std::make_unique<AudioMultiVector>(output->Channels());
+    }
+    AudioMultiVector& expanded = *expanded_;
+    expanded.Clear();
     expand_->Process(&expanded);
     expand_->Reset();
 
     size_t length_per_channel = length / output->Channels();
-    std::unique_ptr<int16_t[]> signal(new int16_t[length_per_channel]);
+    signal_.resize(length_per_channel);
+    int16_t* const signal = signal_.data();
     for (size_t channel_ix = 0; channel_ix < output->Channels(); ++channel_ix) {
       // Set muting factor to the same as expand muting factor.
       int16_t mute_factor = expand_->MuteFactor(channel_ix);
 
-      (*output)[channel_ix].CopyTo(length_per_channel, 0, signal.get());
+      (*output)[channel_ix].CopyTo(length_per_channel, 0, signal);
 
       // Find largest absolute value in new data.
       int16_t decoded_max =
-          WebRtcSpl_MaxAbsValueW16(signal.get(), length_per_channel);
+          WebRtcSpl_MaxAbsValueW16(signal, length_per_channel);
       // Adjust muting factor if needed (to BGN level).
       size_t energy_length =
           std::min(static_cast<size_t>(fs_mult * 64), length_per_channel);
       int scaling = 6 + fs_shift - WebRtcSpl_NormW32(decoded_max * decoded_max);
       scaling = std::max(scaling, 0);  // `scaling` should always be >= 0.
-      int32_t energy = WebRtcSpl_DotProductWithScale(signal.get(), signal.get(),
-                                                     energy_length, scaling);
+      int32_t energy = internal::DotProductWithScale(signal, signal,
+                                                      energy_length, scaling);
       int32_t scaled_energy_length =
           static_cast<int32_t>(energy_length >> scaling);
       if (scaled_energy_length > 0) {
@@ -14,7 +14,11 @@
 #include <stdint.h>
 #include <string.h>  // Access to size_t.
 
+#include <memory>
+#include <vector>
+
 #include "api/neteq/neteq.h"
+#include "modules/audio_coding/neteq/audio_multi_vector.h"
 #include "modules/audio_coding/neteq/statistics_calculator.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/numerics/safe_conversions.h"
@@ -22,7 +26,6 @@
 namespace webrtc {
 
 // Forward declarations.
-class AudioMultiVector;
 class BackgroundNoise;
 class DecoderDatabase;
 class Expand;
@@ -70,6 +73,9 @@ class Normal {
   const size_t samples_per_ms_;
   const int16_t default_win_slope_Q14_;
   StatisticsCalculator* const statistics_;
+  // Kept between calls to not allocate while processing.
+  std::unique_ptr<AudioMultiVector> expanded_;
+  std::vector<int16_t> signal_;
 };
 
 }  // namespace webrtc
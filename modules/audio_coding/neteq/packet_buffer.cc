@@ -9,13 +9,13 @@
  */
 
 // This is the implementation of the PacketBuffer class. It is mostly based on
-// an STL list. The list is kept sorted at all times so that the next packet to
-// decode is at the beginning of the list.
+// an STL deque. The deque is kept sorted at all times so that the next packet
+// to decode is at the front.
 
 #include "modules/audio_coding/neteq/packet_buffer.h"
 
 #include <algorithm>
-#include <list>
+#include <deque>
 #include <memory>
 #include <type_traits>
 #include <utility>
@@ -32,7 +32,7 @@
 
 namespace webrtc {
 namespace {
-// Predicate used when inserting packets in the buffer list.
+// Predicate used when inserting packets in the buffer.
 // Operator() returns true when `packet` goes before `new_packet`.
 class NewTimestampIsLarger {
  public:
@@ -92,14 +92,15 @@ int PacketBuffer::InsertPacket(Packet&& packet) {
   }
 
   // Get an iterator pointing to the place in the buffer where the new packet
-  // should be inserted. The list is searched from the back, since the most
-  // likely case is that the new packet should be near the end of the list.
-  PacketList::reverse_iterator rit = std::find_if(
-      buffer_.rbegin(), buffer_.rend(), NewTimestampIsLarger(packet));
+  // should be inserted. The buffer is searched from the back, since the most
+  // likely case is that the new packet should be appended, which is done in
+  // constant time.
+  auto rit = std::find_if(buffer_.rbegin(), buffer_.rend(),
+                          NewTimestampIsLarger(packet));
 
   // The new packet is to be inserted to the right of `rit`. If it has the same
   // timestamp as `rit`, which has a higher priority, do not insert the new
-  // packet to list.
+  // packet to the buffer.
   if (rit != buffer_.rend() && packet.timestamp == rit->timestamp) {
     LogPacketDiscarded(packet.priority.codec_level);
     return return_val;
@@ -108,7 +109,7 @@ int PacketBuffer::InsertPacket(Packet&& packet) {
   // The new packet is to be inserted to the left of `it`. If it has the same
   // timestamp as `it`, which has a lower priority, replace `it` with the new
   // packet.
-  PacketList::iterator it = rit.base();
+  auto it = rit.base();
   if (it != buffer_.end() && packet.timestamp == it->timestamp) {
     LogPacketDiscarded(it->priority.codec_level);
     it = buffer_.erase(it);
@@ -137,11 +138,10 @@ int PacketBuffer::NextHigherTimestamp(uint32_t timestamp,
   if (!next_timestamp) {
     return kInvalidPointer;
   }
-  PacketList::const_iterator it;
-  for (it = buffer_.begin(); it != buffer_.end(); ++it) {
-    if (it->timestamp >= timestamp) {
+  for (const Packet& packet : buffer_) {
+    if (packet.timestamp >= timestamp) {
       // Found a packet matching the search.
-      *next_timestamp = it->timestamp;
+      *next_timestamp = packet.timestamp;
       return kOK;
     }
   }
@@ -180,13 +180,17 @@ int PacketBuffer::DiscardNextPacket() {
 
 void PacketBuffer::DiscardOldPackets(uint32_t timestamp_limit,
                                      uint32_t horizon_samples) {
-  buffer_.remove_if([this, timestamp_limit, horizon_samples](const Packet& p) {
-    if (timestamp_limit == p.timestamp ||
-        !IsObsoleteTimestamp(p.timestamp, timestamp_limit, horizon_samples)) {
-      return false;
-    }
-    LogPacketDiscarded(p.priority.codec_level);
-    return true;
+  // Obsolete packets normally sit at the front; pop those without moving the
+  // rest of the buffer.
+  while (!buffer_.empty() && buffer_.front().timestamp != timestamp_limit &&
+         IsObsoleteTimestamp(buffer_.front().timestamp, timestamp_limit,
+                             horizon_samples)) {
+    LogPacketDiscarded(buffer_.front().priority.codec_level);
+    buffer_.pop_front();
+  }
+  RemovePacketsIf([timestamp_limit, horizon_samples](const Packet& p) {
+    return timestamp_limit != p.timestamp &&
+           IsObsoleteTimestamp(p.timestamp, timestamp_limit, horizon_samples);
   });
 }
 
@@ -195,12 +199,8 @@ void PacketBuffer::DiscardAllOldPackets(uint32_t timestamp_limit) {
 }
 
 void PacketBuffer::DiscardPacketsWithPayloadType(uint8_t payload_type) {
-  buffer_.remove_if([this, payload_type](const Packet& p) {
-    if (p.payload_type != payload_type) {
-      return false;
-    }
-    LogPacketDiscarded(p.priority.codec_level);
-    return true;
+  RemovePacketsIf([payload_type](const Packet& p) {
+    return p.payload_type == payload_type;
   });
 }
 
@@ -208,6 +208,14 @@ size_t PacketBuffer::NumPacketsInBuffer() const {
   return buffer_.size();
 }
 
+size_t PacketBuffer::GetMemoryUsageBytes() const {
+  size_t bytes = 0;
+  for (const Packet& packet : buffer_) {
+    bytes += sizeof(Packet) + packet.payload.capacity();
+  }
+  return bytes;
+}
+
 size_t PacketBuffer::NumSamplesInBuffer(size_t last_decoded_length) const {
   size_t num_samples = 0;
   size_t last_duration = last_decoded_length;
@@ -264,6 +272,20 @@ bool PacketBuffer::ContainsDtxOrCngPacket(
   return false;
 }
 
+template <typename Predicate>
+void PacketBuffer::RemovePacketsIf(Predicate predicate) {
+  // Compacts the buffer in a single pass.
+  auto end = std::remove_if(buffer_.begin(), buffer_.end(),
+                            [this, &predicate](const Packet& p) {
+                              if (!predicate(p)) {
+                                return false;
+                              }
+                              LogPacketDiscarded(p.priority.codec_level);
+                              return true;
+                            });
+  buffer_.erase(end, buffer_.end());
+}
+
 void PacketBuffer::LogPacketDiscarded(int codec_level) {
   if (codec_level > 0) {
     stats_->SecondaryPacketsDiscarded(1);
@@ -11,6 +11,8 @@
 #ifndef MODULES_AUDIO_CODING_NETEQ_PACKET_BUFFER_H_
 #define MODULES_AUDIO_CODING_NETEQ_PACKET_BUFFER_H_
 
+#include <deque>
+
 #include "absl/types/optional.h"
 #include "modules/audio_coding/neteq/decoder_database.h"
 #include "modules/audio_coding/neteq/packet.h"
@@ -22,7 +24,9 @@ class DecoderDatabase;
 class StatisticsCalculator;
 class TickTimer;
 
-// This is the actual buffer holding the packets before decoding.
+// This is the actual buffer holding the packets before decoding. The packets
+// are kept sorted in a ring of contiguous blocks, so that packets arriving in
+// order are appended in constant time without allocating a node per packet.
 class PacketBuffer {
  public:
   enum BufferReturnCodes {
@@ -107,6 +111,10 @@ class PacketBuffer {
   // duplicate and redundant packets.
   virtual size_t NumSamplesInBuffer(size_t last_decoded_length) const;
 
+  // Returns the bytes held by the buffered packets. Payloads that have already
+  // been parsed into frames by the decoder are not included.
+  size_t GetMemoryUsageBytes() const;
+
   // Returns the total duration in samples that the packets in the buffer spans
   // across.
   virtual size_t GetSpanSamples(size_t last_decoded_length,
@@ -132,10 +140,15 @@ class PacketBuffer {
   }
 
  private:
+  // Removes the packets for which `predicate` returns true, keeping the order
+  // of the others.
+  template <typename Predicate>
+  void RemovePacketsIf(Predicate predicate);
+
   void LogPacketDiscarded(int codec_level);
 
   size_t max_number_of_packets_;
-  PacketList buffer_;
+  std::deque<Packet> buffer_;
   const TickTimer* tick_timer_;
   StatisticsCalculator* stats_;
 };
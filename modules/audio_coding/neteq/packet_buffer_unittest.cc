@@ -163,6 +163,25 @@ TEST(PacketBuffer, FlushBuffer) {
   EXPECT_CALL(decoder_database, Die());  // Called when object is deleted.
 }
 
+TEST(PacketBuffer, MemoryUsageFollowsBufferedPayloads) {
+  TickTimer tick_timer;
+  StrictMock<MockStatisticsCalculator> mock_stats;
+  PacketBuffer buffer(10, &tick_timer, &mock_stats);  // 10 packets.
+  PacketGenerator gen(0, 0, 0, 10);
+  const int payload_len = 100;
+  EXPECT_EQ(0u, buffer.GetMemoryUsageBytes());
+
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(PacketBuffer::kOK, buffer.InsertPacket(/*packet=*/gen.NextPacket(
+                                     payload_len, nullptr)));
+  }
+  EXPECT_GE(buffer.GetMemoryUsageBytes(), 10u * payload_len);
+
+  EXPECT_CALL(mock_stats, PacketsDiscarded(1)).Times(10);
+  buffer.Flush();
+  EXPECT_EQ(0u, buffer.GetMemoryUsageBytes());
+}
+
 // Test to fill the buffer over the limits, and verify that it flushes.
 TEST(PacketBuffer, OverfillBuffer) {
   TickTimer tick_timer;
@@ -63,7 +63,7 @@ PreemptiveExpand::ReturnCodes PreemptiveExpand::CheckCriteriaAndStretch(
     int16_t best_correlation,
     bool active_speech,
     bool /*fast_mode*/,
-    AudioMultiVector* output) const {
+    AudioMultiVector* output) {
   // Pre-calculate common multiplication with `fs_mult_`.
   // 120 corresponds to 15 ms.
   size_t fs_mult_120 = static_cast<size_t>(fs_mult_ * 120);
@@ -80,13 +80,14 @@ PreemptiveExpand::ReturnCodes PreemptiveExpand::CheckCriteriaAndStretch(
     // Copy first part, including cross-fade region.
     output->PushBackInterleaved(rtc::ArrayView<const int16_t>(
         input, (unmodified_length + peak_index) * num_channels_));
-    // Copy the last `peak_index` samples up to 15 ms to `temp_vector`.
-    AudioMultiVector temp_vector(num_channels_);
-    temp_vector.PushBackInterleaved(rtc::ArrayView<const int16_t>(
+    // Copy the last `peak_index` samples up to 15 ms to
+    // `cross_fade_vector_`.
+    cross_fade_vector_.Clear();
+    cross_fade_vector_.PushBackInterleaved(rtc::ArrayView<const int16_t>(
         &input[(unmodified_length - peak_index) * num_channels_],
         peak_index * num_channels_));
-    // Cross-fade `temp_vector` onto the end of `output`.
-    output->CrossFade(temp_vector, peak_index);
+    // Cross-fade `cross_fade_vector_` onto the end of `output`.
+    output->CrossFade(cross_fade_vector_, peak_index);
     // Copy the last unmodified part, 15 ms + pitch period until the end.
     output->PushBackInterleaved(rtc::ArrayView<const int16_t>(
         &input[unmodified_length * num_channels_],
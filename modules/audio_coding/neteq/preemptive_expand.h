@@ -64,7 +64,7 @@ class PreemptiveExpand : public TimeStretch {
                                       int16_t best_correlation,
                                       bool active_speech,
                                       bool /*fast_mode*/,
-                                      AudioMultiVector* output) const override;
+                                      AudioMultiVector* output) override;
 
  private:
   size_t old_data_length_per_channel_;
@@ -197,6 +197,19 @@ TEST(RedPayloadSplitter, OnePacketTwoPayloads) {
 
 // Packets A and B are not split at all. Only the RED header in each packet is
 // removed.
+TEST(RedPayloadSplitter, PrimaryPayloadReusesRedBuffer) {
+  uint8_t payload_types[] = {0, 0};
+  PacketList packet_list;
+  packet_list.push_back(CreateRedPayload(2, payload_types, 160));
+  const uint8_t* red_buffer = packet_list.front().payload.data();
+  RedPayloadSplitter splitter;
+  EXPECT_TRUE(splitter.SplitRed(&packet_list));
+  ASSERT_EQ(2u, packet_list.size());
+  EXPECT_EQ(packet_list.front().payload.data(), red_buffer);
+  VerifyPacket(packet_list.front(), kPayloadLength, payload_types[1],
+               kSequenceNumber, kBaseTimestamp, 1, true);
+}
+
 TEST(RedPayloadSplitter, TwoPacketsOnePayload) {
   uint8_t payload_types[] = {0};
   const int kTimestampOffset = 160;
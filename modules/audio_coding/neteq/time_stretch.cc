@@ -11,12 +11,12 @@
 #include "modules/audio_coding/neteq/time_stretch.h"
 
 #include <algorithm>  // min, max
-#include <memory>
 
 #include "common_audio/signal_processing/include/signal_processing_library.h"
 #include "modules/audio_coding/neteq/background_noise.h"
 #include "modules/audio_coding/neteq/cross_correlation.h"
 #include "modules/audio_coding/neteq/dsp_helper.h"
+#include "modules/audio_coding/neteq/dsp_kernels.h"
 #include "rtc_base/numerics/safe_conversions.h"
 
 namespace webrtc {
@@ -31,7 +31,6 @@ TimeStretch::ReturnCodes TimeStretch::Process(const int16_t* input,
       static_cast<size_t>(fs_mult_ * 120);  // Corresponds to 15 ms.
 
   const int16_t* signal;
-  std::unique_ptr<int16_t[]> signal_array;
   size_t signal_len;
   if (num_channels_ == 1) {
     signal = input;
@@ -41,11 +40,11 @@ TimeStretch::ReturnCodes TimeStretch::Process(const int16_t* input,
     // interleaved. Thus, we take the first sample, skip forward `num_channels`
     // samples, and continue like that.
     signal_len = input_len / num_channels_;
-    signal_array.reset(new int16_t[signal_len]);
-    signal = signal_array.get();
+    reference_channel_.resize(signal_len);
+    signal = reference_channel_.data();
     size_t j = kRefChannel;
     for (size_t i = 0; i < signal_len; ++i) {
-      signal_array[i] = input[j];
+      reference_channel_[i] = input[j];
       j += num_channels_;
     }
   }
@@ -91,13 +90,13 @@ TimeStretch::ReturnCodes TimeStretch::Process(const int16_t* input,
   // Calculate energies for `vec1` and `vec2`, assuming they both contain
   // `peak_index` samples.
   int32_t vec1_energy =
-      WebRtcSpl_DotProductWithScale(vec1, vec1, peak_index, scaling);
+      internal::DotProductWithScale(vec1, vec1, peak_index, scaling);
   int32_t vec2_energy =
-      WebRtcSpl_DotProductWithScale(vec2, vec2, peak_index, scaling);
+      internal::DotProductWithScale(vec2, vec2, peak_index, scaling);
 
   // Calculate cross-correlation between `vec1` and `vec2`.
   int32_t cross_corr =
-      WebRtcSpl_DotProductWithScale(vec1, vec2, peak_index, scaling);
+      internal::DotProductWithScale(vec1, vec2, peak_index, scaling);
 
   // Check if the signal seems to be active speech or not (simple VAD).
   bool active_speech =
@@ -13,6 +13,8 @@
 
 #include <string.h>  // memset, size_t
 
+#include <vector>
+
 #include "modules/audio_coding/neteq/audio_multi_vector.h"
 
 namespace webrtc {
@@ -39,7 +41,8 @@ class TimeStretch {
         fs_mult_(sample_rate_hz / 8000),
         num_channels_(num_channels),
         background_noise_(background_noise),
-        max_input_value_(0) {
+        max_input_value_(0),
+        cross_fade_vector_(num_channels) {
     RTC_DCHECK(sample_rate_hz_ == 8000 || sample_rate_hz_ == 16000 ||
                sample_rate_hz_ == 32000 || sample_rate_hz_ == 48000);
     RTC_DCHECK_GT(num_channels_, 0);
@@ -77,7 +80,7 @@ class TimeStretch {
       int16_t best_correlation,
       bool active_speech,
       bool fast_mode,
-      AudioMultiVector* output) const = 0;
+      AudioMultiVector* output) = 0;
 
   static const size_t kCorrelationLen = 50;
   static const size_t kLogCorrelationLen = 6;  // >= log2(kCorrelationLen).
@@ -96,6 +99,9 @@ class TimeStretch {
   // Adding 1 to the size of `auto_correlation_` because of how it is used
   // by the peak-detection algorithm.
   int16_t auto_correlation_[kCorrelationLen + 1];
+  // Holds the segment cross-faded onto the output. Kept between calls to not
+  // allocate while stretching.
+  AudioMultiVector cross_fade_vector_;
 
  private:
   // Calculates the auto-correlation of `downsampled_input_` and writes the
@@ -107,6 +113,8 @@ class TimeStretch {
                        int32_t vec2_energy,
                        size_t peak_index,
                        int scaling) const;
+
+  std::vector<int16_t> reference_channel_;
 };
 
 }  // namespace webrtc
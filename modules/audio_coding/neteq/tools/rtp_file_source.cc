@@ -18,6 +18,7 @@
 #endif
 
 #include <memory>
+#include <set>
 
 #include "modules/audio_coding/neteq/tools/packet.h"
 #include "rtc_base/checks.h"
@@ -36,6 +37,10 @@ RtpFileSource* RtpFileSource::Create(absl::string_view file_name,
 bool RtpFileSource::ValidRtpDump(absl::string_view file_name) {
   std::unique_ptr<RtpFileReader> temp_file(
       RtpFileReader::Create(RtpFileReader::kRtpDump, file_name));
+  if (!temp_file) {
+    temp_file.reset(
+        RtpFileReader::Create(RtpFileReader::kIndexedRtpDump, file_name));
+  }
   return !!temp_file;
 }
 
@@ -83,6 +88,15 @@ RtpFileSource::RtpFileSource(absl::optional<uint32_t> ssrc_filter)
     : PacketSource(), ssrc_filter_(ssrc_filter) {}
 
 bool RtpFileSource::OpenFile(absl::string_view file_name) {
+  // The indexed format lets the reader skip packets of other SSRCs without
+  // reading them.
+  std::set<uint32_t> ssrcs;
+  if (ssrc_filter_)
+    ssrcs.insert(*ssrc_filter_);
+  rtp_reader_.reset(
+      RtpFileReader::Create(RtpFileReader::kIndexedRtpDump, file_name, ssrcs));
+  if (rtp_reader_)
+    return true;
   rtp_reader_.reset(RtpFileReader::Create(RtpFileReader::kRtpDump, file_name));
   if (rtp_reader_)
     return true;
@@ -0,0 +1,79 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_device/adaptive_device_latency.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+AdaptiveDeviceLatency::AdaptiveDeviceLatency(const Config& config)
+    : config_(config), target_(config.min_latency) {
+  RTC_DCHECK_GT(config_.step, TimeDelta::Zero());
+  RTC_DCHECK_LE(config_.min_latency, config_.max_latency);
+}
+
+absl::optional<TimeDelta> AdaptiveDeviceLatency::OnCallback(
+    Timestamp now,
+    TimeDelta period) {
+  if (interval_start_.IsInfinite()) {
+    StartInterval(now);
+  }
+  if (last_callback_) {
+    max_jitter_ = std::max(max_jitter_, now - *last_callback_ - last_period_);
+  }
+  last_callback_ = now;
+  last_period_ = period;
+
+  // The buffer has to hold one period plus whatever the callbacks may be late.
+  const TimeDelta required =
+      RoundUpToStep(period + max_jitter_ * config_.jitter_headroom);
+  const TimeDelta previous_target = target_;
+  if (required > target_) {
+    target_ = required;
+  } else if (now - interval_start_ >= config_.decrease_interval) {
+    if (target_ - config_.step >= required) {
+      target_ = std::max(target_ - config_.step, config_.min_latency);
+    }
+    StartInterval(now);
+  }
+  if (target_ == previous_target) {
+    return absl::nullopt;
+  }
+  return target_;
+}
+
+absl::optional<TimeDelta> AdaptiveDeviceLatency::OnUnderflow(Timestamp now) {
+  const TimeDelta previous_target = target_;
+  target_ = std::min(target_ + 2 * config_.step, config_.max_latency);
+  // Don't go back down until the device has been stable for a full interval.
+  StartInterval(now);
+  if (target_ == previous_target) {
+    return absl::nullopt;
+  }
+  return target_;
+}
+
+TimeDelta AdaptiveDeviceLatency::RoundUpToStep(TimeDelta latency) const {
+  const int64_t steps =
+      (latency.us() + config_.step.us() - 1) / config_.step.us();
+  return std::clamp(steps * config_.step, config_.min_latency,
+                    config_.max_latency);
+}
+
+void AdaptiveDeviceLatency::StartInterval(Timestamp now) {
+  interval_start_ = now;
+  max_jitter_ = TimeDelta::Zero();
+}
+
+}  // namespace webrtc
@@ -0,0 +1,68 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_DEVICE_ADAPTIVE_DEVICE_LATENCY_H_
+#define MODULES_AUDIO_DEVICE_ADAPTIVE_DEVICE_LATENCY_H_
+
+#include "absl/types/optional.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+
+namespace webrtc {
+
+// Picks the size of a device playout buffer for backends running in
+// low-latency mode. The buffer starts out at `min_latency` and is adapted to
+// the device: the jitter of the callbacks, i.e. how much later than one period
+// after the previous one they arrive, is measured online and the target is
+// raised to cover it, and raised further on every underflow. After
+// `decrease_interval` without underflows, in which the measured jitter would
+// have fit a smaller buffer, the target is lowered again by one `step`.
+//
+// Not thread safe; feed it from the thread that runs the device callbacks.
+class AdaptiveDeviceLatency {
+ public:
+  struct Config {
+    TimeDelta min_latency = TimeDelta::Millis(10);
+    TimeDelta max_latency = TimeDelta::Millis(200);
+    // Granularity of the target; it's raised by twice this on underflow.
+    TimeDelta step = TimeDelta::Millis(5);
+    TimeDelta decrease_interval = TimeDelta::Seconds(10);
+    // Headroom kept on top of the worst jitter seen in the current interval.
+    double jitter_headroom = 1.5;
+  };
+
+  explicit AdaptiveDeviceLatency(const Config& config);
+
+  // Called every time the device asks for `period` of audio. Returns the new
+  // target latency if it changed.
+  absl::optional<TimeDelta> OnCallback(Timestamp now, TimeDelta period);
+  // Called when the device ran out of audio. Returns the new target latency
+  // if it changed.
+  absl::optional<TimeDelta> OnUnderflow(Timestamp now);
+
+  TimeDelta target_latency() const { return target_; }
+  // Worst callback jitter seen in the current interval.
+  TimeDelta max_jitter() const { return max_jitter_; }
+
+ private:
+  TimeDelta RoundUpToStep(TimeDelta latency) const;
+  void StartInterval(Timestamp now);
+
+  const Config config_;
+  TimeDelta target_;
+  Timestamp interval_start_ = Timestamp::MinusInfinity();
+  TimeDelta max_jitter_ = TimeDelta::Zero();
+  absl::optional<Timestamp> last_callback_;
+  TimeDelta last_period_ = TimeDelta::Zero();
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_DEVICE_ADAPTIVE_DEVICE_LATENCY_H_
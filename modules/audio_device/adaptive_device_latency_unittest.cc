@@ -0,0 +1,98 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_device/adaptive_device_latency.h"
+
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr TimeDelta kPeriod = TimeDelta::Millis(10);
+
+AdaptiveDeviceLatency::Config TestConfig() {
+  AdaptiveDeviceLatency::Config config;
+  config.min_latency = TimeDelta::Millis(10);
+  config.max_latency = TimeDelta::Millis(50);
+  config.step = TimeDelta::Millis(5);
+  config.decrease_interval = TimeDelta::Seconds(1);
+  config.jitter_headroom = 1.0;
+  return config;
+}
+
+TEST(AdaptiveDeviceLatencyTest, StaysAtMinimumWithoutJitter) {
+  AdaptiveDeviceLatency latency(TestConfig());
+  Timestamp now = Timestamp::Seconds(1);
+  for (int i = 0; i < 500; ++i) {
+    EXPECT_FALSE(latency.OnCallback(now, kPeriod));
+    now += kPeriod;
+  }
+  EXPECT_EQ(latency.target_latency(), TimeDelta::Millis(10));
+}
+
+TEST(AdaptiveDeviceLatencyTest, CoversCallbackJitter) {
+  AdaptiveDeviceLatency latency(TestConfig());
+  Timestamp now = Timestamp::Seconds(1);
+  latency.OnCallback(now, kPeriod);
+  now += kPeriod + TimeDelta::Millis(7);
+  EXPECT_EQ(latency.OnCallback(now, kPeriod), TimeDelta::Millis(20));
+  EXPECT_EQ(latency.max_jitter(), TimeDelta::Millis(7));
+}
+
+TEST(AdaptiveDeviceLatencyTest, RaisesOnUnderflowUpToMaximum) {
+  AdaptiveDeviceLatency latency(TestConfig());
+  const Timestamp now = Timestamp::Seconds(1);
+  EXPECT_EQ(latency.OnUnderflow(now), TimeDelta::Millis(20));
+  EXPECT_EQ(latency.OnUnderflow(now), TimeDelta::Millis(30));
+  EXPECT_EQ(latency.OnUnderflow(now), TimeDelta::Millis(40));
+  EXPECT_EQ(latency.OnUnderflow(now), TimeDelta::Millis(50));
+  EXPECT_FALSE(latency.OnUnderflow(now));
+}
+
+TEST(AdaptiveDeviceLatencyTest, LowersAfterStableInterval) {
+  AdaptiveDeviceLatency latency(TestConfig());
+  Timestamp now = Timestamp::Seconds(1);
+  latency.OnUnderflow(now);
+  ASSERT_EQ(latency.target_latency(), TimeDelta::Millis(20));
+
+  // Nothing changes before a full interval without underflow has passed.
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_FALSE(latency.OnCallback(now, kPeriod));
+    now += kPeriod;
+  }
+  EXPECT_EQ(latency.OnCallback(now, kPeriod), TimeDelta::Millis(15));
+  now += kPeriod;
+  for (int i = 0; i < 100; ++i) {
+    latency.OnCallback(now, kPeriod);
+    now += kPeriod;
+  }
+  EXPECT_EQ(latency.target_latency(), TimeDelta::Millis(10));
+}
+
+TEST(AdaptiveDeviceLatencyTest, DoesNotLowerBelowObservedJitter) {
+  AdaptiveDeviceLatency latency(TestConfig());
+  Timestamp now = Timestamp::Seconds(1);
+  latency.OnUnderflow(now);
+  ASSERT_EQ(latency.target_latency(), TimeDelta::Millis(20));
+
+  // Callbacks arriving 8 ms late every now and then need 18 ms of buffer, so
+  // the target stays at 20 ms.
+  for (int i = 0; i < 300; ++i) {
+    const bool late = i % 50 == 25;
+    now += late ? kPeriod + TimeDelta::Millis(8) : kPeriod;
+    latency.OnCallback(now, kPeriod);
+  }
+  EXPECT_EQ(latency.target_latency(), TimeDelta::Millis(20));
+}
+
+}  // namespace
+}  // namespace webrtc
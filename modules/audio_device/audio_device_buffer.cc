@@ -12,11 +12,12 @@
 
 #include <string.h>
 
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
 
-#include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "common_audio/signal_level.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/time_utils.h"
@@ -41,6 +42,16 @@ static const size_t kMinValidCallTimeTimeInMilliseconds =
 static const double k2Pi = 6.28318530717959;
 #endif
 
+// Returns the largest absolute value of the float samples in `x`, which are
+// in the range [-1, 1], scaled to and limited by the int16_t range.
+static int16_t MaxAbsValueFloatAsS16(rtc::ArrayView<const float> x) {
+  float max_abs = 0.f;
+  for (float sample : x) {
+    max_abs = std::max(max_abs, std::fabs(sample));
+  }
+  return static_cast<int16_t>(std::min(max_abs * 32768.f, 32767.f));
+}
+
 AudioDeviceBuffer::AudioDeviceBuffer(TaskQueueFactory* task_queue_factory,
                                      bool create_detached)
     : task_queue_(task_queue_factory->CreateTaskQueue(
@@ -245,12 +256,34 @@ int32_t AudioDeviceBuffer::SetRecordedBuffer(
   const size_t old_size = rec_buffer_.size();
   rec_buffer_.SetData(static_cast<const int16_t*>(audio_buffer),
                       rec_channels_ * samples_per_channel);
+  rec_buffer_is_float_ = false;
   // Keep track of the size of the recording buffer. Only updated when the
   // size changes, which is a rare event.
   if (old_size != rec_buffer_.size()) {
     RTC_LOG(LS_INFO) << "Size of recording buffer: " << rec_buffer_.size();
   }
+  OnRecordedBufferSet(samples_per_channel, capture_timestamp_ns);
+  return 0;
+}
 
+int32_t AudioDeviceBuffer::SetRecordedFloatBuffer(
+    const float* audio_buffer,
+    size_t samples_per_channel,
+    absl::optional<int64_t> capture_timestamp_ns) {
+  const size_t old_size = rec_float_buffer_.size();
+  rec_float_buffer_.SetData(audio_buffer, rec_channels_ * samples_per_channel);
+  rec_buffer_is_float_ = true;
+  if (old_size != rec_float_buffer_.size()) {
+    RTC_LOG(LS_INFO) << "Size of float recording buffer: "
+                     << rec_float_buffer_.size();
+  }
+  OnRecordedBufferSet(samples_per_channel, capture_timestamp_ns);
+  return 0;
+}
+
+void AudioDeviceBuffer::OnRecordedBufferSet(
+    size_t samples_per_channel,
+    absl::optional<int64_t> capture_timestamp_ns) {
   if (capture_timestamp_ns) {
     int64_t align_offsync_estimation_time = rtc::TimeMicros();
     if (align_offsync_estimation_time -
@@ -280,7 +313,9 @@ int32_t AudioDeviceBuffer::SetRecordedBuffer(
   RTC_DCHECK_LT(rec_stat_count_, 50);
   if (++rec_stat_count_ >= 50) {
     // Returns the largest absolute value in a signed 16-bit vector.
-    max_abs = WebRtcSpl_MaxAbsValueW16(rec_buffer_.data(), rec_buffer_.size());
+    max_abs = rec_buffer_is_float_
+                  ? MaxAbsValueFloatAsS16(rec_float_buffer_)
+                  : MaxAbsValueS16(rec_buffer_.data(), rec_buffer_.size());
     rec_stat_count_ = 0;
     // Set `only_silence_recorded_` to false as soon as at least one detection
     // of a non-zero audio packet is found. It can only be restored to true
@@ -292,7 +327,6 @@ int32_t AudioDeviceBuffer::SetRecordedBuffer(
   // Update recording stats which is used as base for periodic logging of the
   // audio input state.
   UpdateRecStats(max_abs, samples_per_channel);
-  return 0;
 }
 
 int32_t AudioDeviceBuffer::DeliverRecordedData() {
@@ -300,10 +334,19 @@ int32_t AudioDeviceBuffer::DeliverRecordedData() {
     RTC_LOG(LS_WARNING) << "Invalid audio transport";
     return 0;
   }
+  uint32_t total_delay_ms = play_delay_ms_ + rec_delay_ms_;
+  if (rec_buffer_is_float_) {
+    int32_t res = audio_transport_cb_->RecordedFloatDataIsAvailable(
+        rec_float_buffer_, rec_channels_, rec_sample_rate_, total_delay_ms,
+        typing_status_, capture_timestamp_ns_);
+    if (res == -1) {
+      RTC_LOG(LS_ERROR) << "RecordedFloatDataIsAvailable() failed";
+    }
+    return 0;
+  }
   const size_t frames = rec_buffer_.size() / rec_channels_;
   const size_t bytes_per_frame = rec_channels_ * sizeof(int16_t);
   uint32_t new_mic_level_dummy = 0;
-  uint32_t total_delay_ms = play_delay_ms_ + rec_delay_ms_;
   int32_t res = audio_transport_cb_->RecordedDataIsAvailable(
       rec_buffer_.data(), frames, bytes_per_frame, rec_channels_,
       rec_sample_rate_, total_delay_ms, 0, 0, typing_status_,
@@ -351,8 +394,7 @@ int32_t AudioDeviceBuffer::RequestPlayoutData(size_t samples_per_channel) {
   RTC_DCHECK_LT(play_stat_count_, 50);
   if (++play_stat_count_ >= 50) {
     // Returns the largest absolute value in a signed 16-bit vector.
-    max_abs =
-        WebRtcSpl_MaxAbsValueW16(play_buffer_.data(), play_buffer_.size());
+    max_abs = MaxAbsValueS16(play_buffer_.data(), play_buffer_.size());
     play_stat_count_ = 0;
   }
   // Update playout stats which is used as base for periodic logging of the
@@ -110,6 +110,13 @@ class AudioDeviceBuffer {
       const void* audio_buffer,
       size_t samples_per_channel,
       absl::optional<int64_t> capture_timestamp_ns);
+  // Same as SetRecordedBuffer() for interleaved float samples in the range
+  // [-1, 1]. DeliverRecordedData() then passes them on as float, to avoid
+  // converting them to 16 bit and back.
+  virtual int32_t SetRecordedFloatBuffer(
+      const float* audio_buffer,
+      size_t samples_per_channel,
+      absl::optional<int64_t> capture_timestamp_ns);
   virtual void SetVQEData(int play_delay_ms, int rec_delay_ms);
   virtual int32_t DeliverRecordedData();
   uint32_t NewMicLevel() const;
@@ -132,6 +139,11 @@ class AudioDeviceBuffer {
   // state = LOG_ACTIVE => logs are printed and the timer is kept alive.
   void LogStats(LogState state);
 
+  // Updates the capture timestamp and the recording stats after a new
+  // recorded buffer has been set.
+  void OnRecordedBufferSet(size_t samples_per_channel,
+                           absl::optional<int64_t> capture_timestamp_ns);
+
   // Updates counters in each play/record callback. These counters are later
   // (periodically) read by LogStats() using a lock.
   void UpdateRecStats(int16_t max_abs, size_t samples_per_channel);
@@ -190,6 +202,10 @@ class AudioDeviceBuffer {
   // Byte buffer used for recorded audio samples. Size can be changed
   // dynamically.
   rtc::BufferT<int16_t> rec_buffer_;
+  // Float buffer used instead of `rec_buffer_` for recorded audio samples set
+  // with SetRecordedFloatBuffer(), as indicated by `rec_buffer_is_float_`.
+  rtc::BufferT<float> rec_float_buffer_;
+  bool rec_buffer_is_float_ = false;
 
   // Contains true of a key-press has been detected.
   bool typing_status_;
@@ -13,8 +13,12 @@
 
 #include <stddef.h>
 
+#include <algorithm>
 #include <string>
+#include <vector>
 
+#include "absl/types/optional.h"
+#include "api/array_view.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/strings/string_builder.h"
 
@@ -65,6 +69,32 @@ class AudioTransport {
         totalDelayMS, clockDrift, currentMicLevel, keyPressed, newMicLevel);
   }
 
+  // Same as RecordedDataIsAvailable() for 10 ms of interleaved float samples
+  // in the range [-1, 1]. Lets the implementation process the audio without
+  // first quantizing it to 16 bit. The default implementation converts the
+  // samples to 16 bit and calls RecordedDataIsAvailable().
+  virtual int32_t RecordedFloatDataIsAvailable(
+      rtc::ArrayView<const float> audio_samples,
+      size_t number_of_channels,
+      uint32_t sample_rate,
+      uint32_t total_delay_ms,
+      bool key_pressed,
+      absl::optional<int64_t> estimated_capture_time_ns) {
+    RTC_DCHECK_GT(number_of_channels, 0);
+    std::vector<int16_t> samples(audio_samples.size());
+    for (size_t i = 0; i < samples.size(); ++i) {
+      const float sample =
+          std::clamp(audio_samples[i] * 32768.f, -32768.f, 32767.f);
+      samples[i] = static_cast<int16_t>(sample + (sample < 0 ? -0.5f : 0.5f));
+    }
+    uint32_t new_mic_level = 0;
+    return RecordedDataIsAvailable(
+        samples.data(), samples.size() / number_of_channels,
+        number_of_channels * sizeof(int16_t), number_of_channels, sample_rate,
+        total_delay_ms, /*clockDrift=*/0, /*currentMicLevel=*/0, key_pressed,
+        new_mic_level, estimated_capture_time_ns);
+  }
+
   // Implementation has to setup safe values for all specified out parameters.
   virtual int32_t NeedMorePlayData(size_t nSamples,
                                    size_t nBytesPerSample,
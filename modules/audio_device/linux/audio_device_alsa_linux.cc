@@ -13,6 +13,7 @@
 #include "modules/audio_device/audio_device_config.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/system/arch.h"
+#include "system_wrappers/include/field_trial.h"
 #include "system_wrappers/include/sleep.h"
 
 WebRTCAlsaSymbolTable* GetAlsaSymbolTable() {
@@ -59,6 +60,10 @@ static const unsigned int ALSA_CAPTURE_FREQ = 48000;
 static const unsigned int ALSA_CAPTURE_CH = 2;
 static const unsigned int ALSA_CAPTURE_LATENCY = 40 * 1000;  // in us
 static const unsigned int ALSA_CAPTURE_WAIT_TIMEOUT = 5;     // in ms
+// Used instead of the latencies above in low-latency mode. Two 10 ms chunks
+// is the least the play and record threads can work with.
+static const unsigned int ALSA_LOW_LATENCY_PLAYOUT_LATENCY = 20 * 1000;  // us
+static const unsigned int ALSA_LOW_LATENCY_CAPTURE_LATENCY = 20 * 1000;  // us
 
 #define FUNC_GET_NUM_OF_DEVICE 0
 #define FUNC_GET_DEVICE_NAME 1
@@ -94,7 +99,8 @@ AudioDeviceLinuxALSA::AudioDeviceLinuxALSA()
       _recIsInitialized(false),
       _playIsInitialized(false),
       _recordingDelay(0),
-      _playoutDelay(0) {
+      _playoutDelay(0),
+      low_latency_(field_trial::IsEnabled("WebRTC-Audio-LinuxLowLatency")) {
   memset(_oldKeyState, 0, sizeof(_oldKeyState));
   RTC_DLOG(LS_INFO) << __FUNCTION__ << " created";
 }
@@ -798,6 +804,8 @@ int32_t AudioDeviceLinuxALSA::InitPlayoutLocked() {
   }
 
   _playoutFramesIn10MS = _playoutFreq / 100;
+  const unsigned int latency =
+      low_latency_ ? ALSA_LOW_LATENCY_PLAYOUT_LATENCY : ALSA_PLAYOUT_LATENCY;
   if ((errVal = LATE(snd_pcm_set_params)(
            _handlePlayout,
 #if defined(WEBRTC_ARCH_BIG_ENDIAN)
@@ -809,9 +817,8 @@ int32_t AudioDeviceLinuxALSA::InitPlayoutLocked() {
            _playChannels,                  // channels
            _playoutFreq,                   // rate
            1,                              // soft_resample
-           ALSA_PLAYOUT_LATENCY  // 40*1000 //latency required overall latency
-                                 // in us
-           )) < 0) {             /* 0.5sec */
+           latency                         // overall latency in us
+           )) < 0) {
     _playoutFramesIn10MS = 0;
     RTC_LOG(LS_ERROR) << "unable to set playback device: "
                       << LATE(snd_strerror)(errVal) << " (" << errVal << ")";
@@ -922,6 +929,8 @@ int32_t AudioDeviceLinuxALSA::InitRecordingLocked() {
   }
 
   _recordingFramesIn10MS = _recordingFreq / 100;
+  const unsigned int latency =
+      low_latency_ ? ALSA_LOW_LATENCY_CAPTURE_LATENCY : ALSA_CAPTURE_LATENCY;
   if ((errVal =
            LATE(snd_pcm_set_params)(_handleRecord,
 #if defined(WEBRTC_ARCH_BIG_ENDIAN)
@@ -933,7 +942,7 @@ int32_t AudioDeviceLinuxALSA::InitRecordingLocked() {
                                     _recChannels,                   // channels
                                     _recordingFreq,                 // rate
                                     1,                    // soft_resample
-                                    ALSA_CAPTURE_LATENCY  // latency in us
+                                    latency               // latency in us
                                     )) < 0) {
     // Fall back to another mode then.
     if (_recChannels == 1)
@@ -952,7 +961,7 @@ int32_t AudioDeviceLinuxALSA::InitRecordingLocked() {
                                       _recChannels,         // channels
                                       _recordingFreq,       // rate
                                       1,                    // soft_resample
-                                      ALSA_CAPTURE_LATENCY  // latency in us
+                                      latency               // latency in us
                                       )) < 0) {
       _recordingFramesIn10MS = 0;
       RTC_LOG(LS_ERROR) << "unable to set record settings: "
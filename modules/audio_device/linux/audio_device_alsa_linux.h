@@ -197,6 +197,9 @@ class AudioDeviceLinuxALSA : public AudioDeviceGeneric {
   snd_pcm_sframes_t _recordingDelay;
   snd_pcm_sframes_t _playoutDelay;
 
+  // Set by the "WebRTC-Audio-LinuxLowLatency" field trial.
+  const bool low_latency_;
+
   char _oldKeyState[32];
 #if defined(WEBRTC_USE_X11)
   Display* _XDisplay;
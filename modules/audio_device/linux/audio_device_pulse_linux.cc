@@ -12,10 +12,14 @@
 
 #include <string.h>
 
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
 #include "modules/audio_device/linux/latebindingsymboltable_linux.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/platform_thread.h"
+#include "rtc_base/time_utils.h"
+#include "system_wrappers/include/field_trial.h"
 
 WebRTCPulseSymbolTable* GetPulseSymbolTable() {
   static WebRTCPulseSymbolTable* pulse_symbol_table =
@@ -32,6 +36,13 @@ WebRTCPulseSymbolTable* GetPulseSymbolTable() {
 
 namespace webrtc {
 
+namespace {
+
+// The play thread always writes 10 ms chunks.
+constexpr TimeDelta kPlayoutPeriod = TimeDelta::Millis(10);
+
+}  // namespace
+
 AudioDeviceLinuxPulse::AudioDeviceLinuxPulse()
     : _ptrAudioBuffer(NULL),
       _inputDeviceIndex(0),
@@ -70,6 +81,8 @@ AudioDeviceLinuxPulse::AudioDeviceLinuxPulse()
       _tempSampleDataSize(0),
       _configuredLatencyPlay(0),
       _configuredLatencyRec(0),
+      low_latency_(field_trial::IsEnabled("WebRTC-Audio-LinuxLowLatency")),
+      playout_underflows_(0),
       _paDeviceIndex(-1),
       _paStateChanged(false),
       _paMainloop(NULL),
@@ -912,8 +925,10 @@ int32_t AudioDeviceLinuxPulse::InitPlayout() {
     }
 
     size_t bytesPerSec = LATE(pa_bytes_per_second)(spec);
-    uint32_t latency = bytesPerSec * WEBRTC_PA_PLAYBACK_LATENCY_MINIMUM_MSECS /
-                       WEBRTC_PA_MSECS_PER_SEC;
+    const uint32_t minimumMsecs =
+        low_latency_ ? WEBRTC_PA_LOW_LATENCY_PLAYBACK_MINIMUM_MSECS
+                     : WEBRTC_PA_PLAYBACK_LATENCY_MINIMUM_MSECS;
+    uint32_t latency = bytesPerSec * minimumMsecs / WEBRTC_PA_MSECS_PER_SEC;
 
     // Set the play buffer attributes
     _playBufferAttr.maxlength = latency;  // num bytes stored in the buffer
@@ -924,6 +939,15 @@ int32_t AudioDeviceLinuxPulse::InitPlayout() {
     _playBufferAttr.prebuf = _playBufferAttr.tlength - _playBufferAttr.minreq;
 
     _configuredLatencyPlay = latency;
+
+    if (low_latency_) {
+      AdaptiveDeviceLatency::Config config;
+      config.min_latency = TimeDelta::Millis(minimumMsecs);
+      MutexLock lock(&mutex_);
+      adaptive_playout_latency_ =
+          std::make_unique<AdaptiveDeviceLatency>(config);
+      playout_underflows_ = 0;
+    }
   }
 
   // num samples in bytes * num channels
@@ -1013,8 +1037,10 @@ int32_t AudioDeviceLinuxPulse::InitRecording() {
     }
 
     size_t bytesPerSec = LATE(pa_bytes_per_second)(spec);
-    uint32_t latency = bytesPerSec * WEBRTC_PA_LOW_CAPTURE_LATENCY_MSECS /
-                       WEBRTC_PA_MSECS_PER_SEC;
+    const uint32_t latencyMsecs = low_latency_
+                                      ? WEBRTC_PA_LOW_LATENCY_CAPTURE_MSECS
+                                      : WEBRTC_PA_LOW_CAPTURE_LATENCY_MSECS;
+    uint32_t latency = bytesPerSec * latencyMsecs / WEBRTC_PA_MSECS_PER_SEC;
 
     // Set the rec buffer attributes
     // Note: fragsize specifies a maximum transfer size, not a minimum, so
@@ -1768,6 +1794,12 @@ void AudioDeviceLinuxPulse::PaStreamUnderflowCallbackHandler() {
     return;
   }
 
+  if (low_latency_) {
+    // The play thread adapts the latency the next time it's woken up.
+    ++playout_underflows_;
+    return;
+  }
+
   // Otherwise reconfigure the stream with a higher target latency.
 
   const pa_sample_spec* spec = LATE(pa_stream_get_sample_spec)(_playStream);
@@ -1777,15 +1809,16 @@ void AudioDeviceLinuxPulse::PaStreamUnderflowCallbackHandler() {
   }
 
   size_t bytesPerSec = LATE(pa_bytes_per_second)(spec);
-  uint32_t newLatency =
-      _configuredLatencyPlay + bytesPerSec *
-                                   WEBRTC_PA_PLAYBACK_LATENCY_INCREMENT_MSECS /
-                                   WEBRTC_PA_MSECS_PER_SEC;
+  SetPlayoutLatency(_configuredLatencyPlay +
+                    bytesPerSec * WEBRTC_PA_PLAYBACK_LATENCY_INCREMENT_MSECS /
+                        WEBRTC_PA_MSECS_PER_SEC);
+}
 
+void AudioDeviceLinuxPulse::SetPlayoutLatency(uint32_t latency) {
   // Set the play buffer attributes
-  _playBufferAttr.maxlength = newLatency;
-  _playBufferAttr.tlength = newLatency;
-  _playBufferAttr.minreq = newLatency / WEBRTC_PA_PLAYBACK_REQUEST_FACTOR;
+  _playBufferAttr.maxlength = latency;
+  _playBufferAttr.tlength = latency;
+  _playBufferAttr.minreq = latency / WEBRTC_PA_PLAYBACK_REQUEST_FACTOR;
   _playBufferAttr.prebuf = _playBufferAttr.tlength - _playBufferAttr.minreq;
 
   pa_operation* op = LATE(pa_stream_set_buffer_attr)(
@@ -1799,7 +1832,37 @@ void AudioDeviceLinuxPulse::PaStreamUnderflowCallbackHandler() {
   LATE(pa_operation_unref)(op);
 
   // Save the new latency in case we underflow again.
-  _configuredLatencyPlay = newLatency;
+  _configuredLatencyPlay = latency;
+}
+
+void AudioDeviceLinuxPulse::UpdateAdaptivePlayoutLatency() {
+  if (!adaptive_playout_latency_) {
+    return;
+  }
+
+  const Timestamp now = Timestamp::Micros(rtc::TimeMicros());
+  const TimeDelta previousLatency = adaptive_playout_latency_->target_latency();
+  if (playout_underflows_.exchange(0) > 0) {
+    adaptive_playout_latency_->OnUnderflow(now);
+  }
+  adaptive_playout_latency_->OnCallback(now, kPlayoutPeriod);
+  const TimeDelta latency = adaptive_playout_latency_->target_latency();
+  if (latency == previousLatency) {
+    return;
+  }
+
+  RTC_LOG(LS_INFO) << "Adapting playout latency to " << latency.ms()
+                   << " ms, callback jitter "
+                   << adaptive_playout_latency_->max_jitter().ms() << " ms";
+  PaLock();
+  const pa_sample_spec* spec = LATE(pa_stream_get_sample_spec)(_playStream);
+  if (spec) {
+    SetPlayoutLatency(LATE(pa_bytes_per_second)(spec) * latency.ms() /
+                      WEBRTC_PA_MSECS_PER_SEC);
+  } else {
+    RTC_LOG(LS_ERROR) << "pa_stream_get_sample_spec()";
+  }
+  PaUnLock();
 }
 
 void AudioDeviceLinuxPulse::EnableReadCallback() {
@@ -2098,6 +2161,8 @@ bool AudioDeviceLinuxPulse::PlayThreadProcess() {
     uint32_t numPlaySamples = _playbackBufferSize / (2 * _playChannels);
     // Might have been reduced to zero by the above.
     if (_tempBufferSpace > 0) {
+      UpdateAdaptivePlayoutLatency();
+
       // Ask for new PCM data to be played out using the
       // AudioDeviceBuffer ensure that this callback is executed
       // without taking the audio-thread lock.
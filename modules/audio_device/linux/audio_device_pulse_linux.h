@@ -11,9 +11,11 @@
 #ifndef AUDIO_DEVICE_AUDIO_DEVICE_PULSE_LINUX_H_
 #define AUDIO_DEVICE_AUDIO_DEVICE_PULSE_LINUX_H_
 
+#include <atomic>
 #include <memory>
 
 #include "api/sequence_checker.h"
+#include "modules/audio_device/adaptive_device_latency.h"
 #include "modules/audio_device/audio_device_buffer.h"
 #include "modules/audio_device/audio_device_generic.h"
 #include "modules/audio_device/include/audio_device.h"
@@ -75,6 +77,13 @@ const uint32_t WEBRTC_PA_PLAYBACK_LATENCY_INCREMENT_MSECS = 20;
 // would be a buffer underflow risk. We set it to half of the buffer size.
 const uint32_t WEBRTC_PA_PLAYBACK_REQUEST_FACTOR = 2;
 
+// In low-latency mode (the "WebRTC-Audio-LinuxLowLatency" field trial) we
+// start out at a single 10 ms chunk instead, and let AdaptiveDeviceLatency
+// grow the buffer to what the device turns out to need. On PipeWire, which
+// follows the tlength and minreq hints of its PulseAudio server, this is
+// usually enough.
+const uint32_t WEBRTC_PA_LOW_LATENCY_PLAYBACK_MINIMUM_MSECS = 10;
+
 // Capture.
 
 // For capture, low latency is not a buffer overflow risk, but it makes us burn
@@ -83,6 +92,8 @@ const uint32_t WEBRTC_PA_PLAYBACK_REQUEST_FACTOR = 2;
 // explicitly requests something lower then we will honour it).
 // 1ms takes about 6-7% CPU. 5ms takes about 5%. 10ms takes about 4.x%.
 const uint32_t WEBRTC_PA_LOW_CAPTURE_LATENCY_MSECS = 10;
+// Used in low-latency mode, trading some CPU for up to 5 ms less delay.
+const uint32_t WEBRTC_PA_LOW_LATENCY_CAPTURE_MSECS = 5;
 
 // There is a round-trip delay to ack the data to the server, so the
 // server-side buffer needs extra space to prevent buffer overflow. 20ms is
@@ -241,6 +252,12 @@ class AudioDeviceLinuxPulse : public AudioDeviceGeneric {
   static void PaStreamOverflowCallback(pa_stream* unused, void* pThis);
   void PaStreamOverflowCallbackHandler();
   int32_t LatencyUsecs(pa_stream* stream);
+  // Reconfigures the play stream with a target latency of `latency` bytes.
+  // Must be called with the PA lock held.
+  void SetPlayoutLatency(uint32_t latency);
+  // Feeds the adaptive latency controller in low-latency mode, and applies
+  // its new target if it has one.
+  void UpdateAdaptivePlayoutLatency() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
   int32_t ReadRecordedData(const void* bufferData, size_t bufferSize);
   int32_t ProcessRecordedData(int8_t* bufferData,
                               uint32_t bufferSizeInSamples,
@@ -323,6 +340,12 @@ class AudioDeviceLinuxPulse : public AudioDeviceGeneric {
   int32_t _configuredLatencyPlay;
   int32_t _configuredLatencyRec;
 
+  const bool low_latency_;
+  std::unique_ptr<AdaptiveDeviceLatency> adaptive_playout_latency_
+      RTC_GUARDED_BY(&mutex_);
+  // Underflows reported by PulseAudio and not yet handled by the play thread.
+  std::atomic<int> playout_underflows_;
+
   // PulseAudio
   uint16_t _paDeviceIndex;
   bool _paStateChanged;
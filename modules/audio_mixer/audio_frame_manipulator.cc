@@ -10,11 +10,23 @@
 
 #include "modules/audio_mixer/audio_frame_manipulator.h"
 
+#include <algorithm>
+#include <array>
+
+#include "api/array_view.h"
 #include "audio/utility/audio_frame_operations.h"
 #include "audio/utility/channel_mixer.h"
+#include "modules/audio_mixer/mixing_math.h"
+#include "modules/audio_processing/agc2/cpu_features.h"
 #include "rtc_base/checks.h"
 
 namespace webrtc {
+namespace {
+
+// Number of gains applied to the frame at a time by Ramp().
+constexpr size_t kRampChunkSize = 256;
+
+}  // namespace
 
 uint32_t AudioMixerCalculateEnergy(const AudioFrame& audio_frame) {
   if (audio_frame.muted()) {
@@ -40,18 +52,29 @@ void Ramp(float start_gain, float target_gain, AudioFrame* audio_frame) {
     return;
   }
 
+  static const MixingMath mixing_math(GetAvailableCpuFeatures());
   size_t samples = audio_frame->samples_per_channel_;
   RTC_DCHECK_LT(0, samples);
+  const size_t num_channels = audio_frame->num_channels_;
   float increment = (target_gain - start_gain) / samples;
   float gain = start_gain;
   int16_t* frame_data = audio_frame->mutable_data();
-  for (size_t i = 0; i < samples; ++i) {
-    // If the audio is interleaved of several channels, we want to
-    // apply the same gain change to the ith sample of every channel.
-    for (size_t ch = 0; ch < audio_frame->num_channels_; ++ch) {
-      frame_data[audio_frame->num_channels_ * i + ch] *= gain;
+  // If the audio is interleaved of several channels, we want to apply the same
+  // gain change to the ith sample of every channel. The gains are expanded
+  // per sample and applied in chunks.
+  std::array<float, kRampChunkSize> gains;
+  const size_t samples_per_chunk = gains.size() / num_channels;
+  RTC_DCHECK_LT(0, samples_per_chunk);
+  for (size_t i = 0; i < samples; i += samples_per_chunk) {
+    const size_t chunk_samples = std::min(samples_per_chunk, samples - i);
+    for (size_t j = 0; j < chunk_samples; ++j) {
+      std::fill_n(&gains[j * num_channels], num_channels, gain);
+      gain += increment;
     }
-    gain += increment;
+    const size_t chunk_size = chunk_samples * num_channels;
+    mixing_math.ApplyGains(
+        rtc::ArrayView<const float>(gains.data(), chunk_size),
+        rtc::ArrayView<int16_t>(&frame_data[i * num_channels], chunk_size));
   }
 }
 
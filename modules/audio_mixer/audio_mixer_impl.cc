@@ -17,6 +17,7 @@
 #include <type_traits>
 #include <utility>
 
+#include "absl/types/optional.h"
 #include "modules/audio_mixer/audio_frame_manipulator.h"
 #include "modules/audio_mixer/default_output_rate_calculator.h"
 #include "rtc_base/checks.h"
@@ -25,6 +26,14 @@
 #include "system_wrappers/include/metrics.h"
 
 namespace webrtc {
+namespace {
+
+// A source stays selected for 500 ms after it was last among the loudest,
+// covering the audio received while it was loud that is still buffered for
+// playout, and keeping sources from toggling between words.
+constexpr int kSelectionHangoverMixes = 50;
+
+}  // namespace
 
 struct AudioMixerImpl::SourceStatus {
   explicit SourceStatus(Source* audio_source) : audio_source(audio_source) {}
@@ -32,6 +41,12 @@ struct AudioMixerImpl::SourceStatus {
 
   // A frame that will be passed to audio_source->GetAudioFrameWithInfo.
   AudioFrame audio_frame;
+
+  // Level reported by audio_source->ReceivedAudioLevel() for this mix.
+  absl::optional<int> received_audio_level;
+  // Number of mixes since the source was last among the loudest.
+  int mixes_since_loudest = kSelectionHangoverMixes;
+  bool selected = true;
 };
 
 namespace {
@@ -53,16 +68,27 @@ struct AudioMixerImpl::HelperContainers {
   void resize(size_t size) {
     audio_to_mix.resize(size);
     preferred_rates.resize(size);
+    ranked_sources.reserve(size);
   }
 
   std::vector<AudioFrame*> audio_to_mix;
   std::vector<int> preferred_rates;
+  std::vector<SourceStatus*> ranked_sources;
 };
 
 AudioMixerImpl::AudioMixerImpl(
     std::unique_ptr<OutputRateCalculator> output_rate_calculator,
     bool use_limiter)
+    : AudioMixerImpl(std::move(output_rate_calculator),
+                     use_limiter,
+                     /*max_sources_to_mix=*/0) {}
+
+AudioMixerImpl::AudioMixerImpl(
+    std::unique_ptr<OutputRateCalculator> output_rate_calculator,
+    bool use_limiter,
+    size_t max_sources_to_mix)
     : output_rate_calculator_(std::move(output_rate_calculator)),
+      max_sources_to_mix_(max_sources_to_mix),
       audio_source_list_(),
       helper_containers_(std::make_unique<HelperContainers>()),
       frame_combiner_(use_limiter) {}
@@ -82,6 +108,14 @@ rtc::scoped_refptr<AudioMixerImpl> AudioMixerImpl::Create(
       std::move(output_rate_calculator), use_limiter);
 }
 
+rtc::scoped_refptr<AudioMixerImpl> AudioMixerImpl::Create(
+    std::unique_ptr<OutputRateCalculator> output_rate_calculator,
+    bool use_limiter,
+    size_t max_sources_to_mix) {
+  return rtc::make_ref_counted<AudioMixerImpl>(
+      std::move(output_rate_calculator), use_limiter, max_sources_to_mix);
+}
+
 void AudioMixerImpl::Mix(size_t number_of_channels,
                          AudioFrame* audio_frame_for_mixing) {
   TRACE_EVENT0("webrtc", "AudioMixerImpl::Mix");
@@ -127,8 +161,13 @@ void AudioMixerImpl::RemoveSource(Source* audio_source) {
 
 rtc::ArrayView<AudioFrame* const> AudioMixerImpl::GetAudioFromSources(
     int output_frequency) {
+  SelectSourcesToMix();
   int audio_to_mix_count = 0;
   for (auto& source_and_status : audio_source_list_) {
+    if (!source_and_status->selected) {
+      source_and_status->audio_source->SkipAudioFrame(output_frequency);
+      continue;
+    }
     const auto audio_frame_info =
         source_and_status->audio_source->GetAudioFrameWithInfo(
             output_frequency, &source_and_status->audio_frame);
@@ -148,6 +187,45 @@ rtc::ArrayView<AudioFrame* const> AudioMixerImpl::GetAudioFromSources(
       helper_containers_->audio_to_mix.data(), audio_to_mix_count);
 }
 
+void AudioMixerImpl::SelectSourcesToMix() {
+  if (max_sources_to_mix_ == 0 ||
+      audio_source_list_.size() <= max_sources_to_mix_) {
+    for (auto& source_and_status : audio_source_list_) {
+      source_and_status->selected = true;
+    }
+    return;
+  }
+
+  std::vector<SourceStatus*>& ranked_sources =
+      helper_containers_->ranked_sources;
+  ranked_sources.clear();
+  for (auto& source_and_status : audio_source_list_) {
+    source_and_status->received_audio_level =
+        source_and_status->audio_source->ReceivedAudioLevel();
+    if (source_and_status->received_audio_level) {
+      ranked_sources.push_back(source_and_status.get());
+    } else {
+      source_and_status->selected = true;
+    }
+  }
+
+  // Lower levels are louder.
+  std::stable_sort(ranked_sources.begin(), ranked_sources.end(),
+                   [](const SourceStatus* a, const SourceStatus* b) {
+                     return *a->received_audio_level <
+                            *b->received_audio_level;
+                   });
+  for (size_t i = 0; i < ranked_sources.size(); ++i) {
+    SourceStatus& status = *ranked_sources[i];
+    if (i < max_sources_to_mix_) {
+      status.mixes_since_loudest = 0;
+    } else if (status.mixes_since_loudest < kSelectionHangoverMixes) {
+      ++status.mixes_since_loudest;
+    }
+    status.selected = status.mixes_since_loudest < kSelectionHangoverMixes;
+  }
+}
+
 void AudioMixerImpl::UpdateSourceCountStats() {
   size_t current_source_count = audio_source_list_.size();
   // Log to the histogram whenever the maximum number of sources increases.
@@ -41,6 +41,16 @@ class AudioMixerImpl : public AudioMixer {
       std::unique_ptr<OutputRateCalculator> output_rate_calculator,
       bool use_limiter);
 
+  // Creates a mixer that, when it has more than `max_sources_to_mix` sources,
+  // only gets audio from the loudest `max_sources_to_mix` of the sources
+  // reporting a ReceivedAudioLevel(), plus those that were among them
+  // recently. The others are asked to skip their audio. Sources not reporting
+  // a level are always mixed. Zero means no limit.
+  static rtc::scoped_refptr<AudioMixerImpl> Create(
+      std::unique_ptr<OutputRateCalculator> output_rate_calculator,
+      bool use_limiter,
+      size_t max_sources_to_mix);
+
   ~AudioMixerImpl() override;
 
   AudioMixerImpl(const AudioMixerImpl&) = delete;
@@ -57,6 +67,9 @@ class AudioMixerImpl : public AudioMixer {
  protected:
   AudioMixerImpl(std::unique_ptr<OutputRateCalculator> output_rate_calculator,
                  bool use_limiter);
+  AudioMixerImpl(std::unique_ptr<OutputRateCalculator> output_rate_calculator,
+                 bool use_limiter,
+                 size_t max_sources_to_mix);
 
  private:
   struct HelperContainers;
@@ -67,6 +80,9 @@ class AudioMixerImpl : public AudioMixer {
   rtc::ArrayView<AudioFrame* const> GetAudioFromSources(int output_frequency)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
+  // Decides, by received audio level, which sources to get audio from.
+  void SelectSourcesToMix() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
   // The critical section lock guards audio source insertion and
   // removal, which can be done from any thread. The race checker
   // checks that mixing is done sequentially.
@@ -74,6 +90,9 @@ class AudioMixerImpl : public AudioMixer {
 
   std::unique_ptr<OutputRateCalculator> output_rate_calculator_;
 
+  // Maximum number of sources to get audio from, or zero for no limit.
+  const size_t max_sources_to_mix_;
+
   // List of all audio sources.
   std::vector<std::unique_ptr<SourceStatus>> audio_source_list_
       RTC_GUARDED_BY(mutex_);
@@ -90,6 +90,8 @@ class MockMixerAudioSource : public ::testing::NiceMock<AudioMixer::Source> {
 
   MOCK_METHOD(int, PreferredSampleRate, (), (const, override));
   MOCK_METHOD(int, Ssrc, (), (const, override));
+  MOCK_METHOD(absl::optional<int>, ReceivedAudioLevel, (), (const, override));
+  MOCK_METHOD(void, SkipAudioFrame, (int sample_rate_hz), (override));
 
   AudioFrame* fake_frame() { return &fake_frame_; }
   AudioFrameInfo fake_info() { return fake_audio_frame_info_; }
@@ -479,6 +481,85 @@ TEST(AudioMixer, ShouldIncludeRtpPacketInfoFromAllMixedSources) {
   EXPECT_THAT(frame_for_mixing.packet_infos_, UnorderedElementsAre(p0, p1, p2));
 }
 
+TEST(AudioMixer, OnlyGetsAudioFromLoudestSourcesByReceivedLevel) {
+  const auto mixer = AudioMixerImpl::Create(
+      std::make_unique<DefaultOutputRateCalculator>(), /*use_limiter=*/true,
+      /*max_sources_to_mix=*/2);
+
+  // Lower levels are louder.
+  MockMixerAudioSource sources[4];
+  const int kLevels[] = {30, 10, 127, 20};
+  for (int i = 0; i < 4; ++i) {
+    ON_CALL(sources[i], ReceivedAudioLevel()).WillByDefault(Return(kLevels[i]));
+    ResetFrame(sources[i].fake_frame());
+    mixer->AddSource(&sources[i]);
+  }
+
+  EXPECT_CALL(sources[1], GetAudioFrameWithInfo).Times(Exactly(1));
+  EXPECT_CALL(sources[3], GetAudioFrameWithInfo).Times(Exactly(1));
+  EXPECT_CALL(sources[0], GetAudioFrameWithInfo).Times(0);
+  EXPECT_CALL(sources[2], GetAudioFrameWithInfo).Times(0);
+  EXPECT_CALL(sources[0], SkipAudioFrame).Times(Exactly(1));
+  EXPECT_CALL(sources[2], SkipAudioFrame).Times(Exactly(1));
+  mixer->Mix(/*number_of_channels=*/1, &frame_for_mixing);
+}
+
+TEST(AudioMixer, AlwaysGetsAudioFromSourcesWithoutReceivedLevel) {
+  const auto mixer = AudioMixerImpl::Create(
+      std::make_unique<DefaultOutputRateCalculator>(), /*use_limiter=*/true,
+      /*max_sources_to_mix=*/1);
+
+  MockMixerAudioSource loud_source;
+  MockMixerAudioSource quiet_source;
+  MockMixerAudioSource source_without_level;
+  ON_CALL(loud_source, ReceivedAudioLevel()).WillByDefault(Return(10));
+  ON_CALL(quiet_source, ReceivedAudioLevel()).WillByDefault(Return(90));
+  for (MockMixerAudioSource* source :
+       {&loud_source, &quiet_source, &source_without_level}) {
+    ResetFrame(source->fake_frame());
+    mixer->AddSource(source);
+  }
+
+  EXPECT_CALL(loud_source, GetAudioFrameWithInfo).Times(Exactly(1));
+  EXPECT_CALL(source_without_level, GetAudioFrameWithInfo).Times(Exactly(1));
+  EXPECT_CALL(quiet_source, GetAudioFrameWithInfo).Times(0);
+  EXPECT_CALL(quiet_source, SkipAudioFrame).Times(Exactly(1));
+  mixer->Mix(/*number_of_channels=*/1, &frame_for_mixing);
+}
+
+TEST(AudioMixer, KeepsGettingAudioFromSourceThatWasRecentlyLoudest) {
+  // Matches the hangover of the mixer.
+  constexpr int kHangoverMixes = 50;
+  const auto mixer = AudioMixerImpl::Create(
+      std::make_unique<DefaultOutputRateCalculator>(), /*use_limiter=*/true,
+      /*max_sources_to_mix=*/1);
+
+  MockMixerAudioSource first_speaker;
+  MockMixerAudioSource second_speaker;
+  int first_speaker_level = 10;
+  int second_speaker_level = 90;
+  ON_CALL(first_speaker, ReceivedAudioLevel())
+      .WillByDefault(Invoke([&] { return first_speaker_level; }));
+  ON_CALL(second_speaker, ReceivedAudioLevel())
+      .WillByDefault(Invoke([&] { return second_speaker_level; }));
+  ResetFrame(first_speaker.fake_frame());
+  ResetFrame(second_speaker.fake_frame());
+  mixer->AddSource(&first_speaker);
+  mixer->AddSource(&second_speaker);
+  mixer->Mix(/*number_of_channels=*/1, &frame_for_mixing);
+
+  // The speakers swap. The first is mixed until its hangover expires.
+  std::swap(first_speaker_level, second_speaker_level);
+  EXPECT_CALL(second_speaker, GetAudioFrameWithInfo)
+      .Times(Exactly(kHangoverMixes));
+  EXPECT_CALL(first_speaker, GetAudioFrameWithInfo)
+      .Times(Exactly(kHangoverMixes - 1));
+  EXPECT_CALL(first_speaker, SkipAudioFrame).Times(Exactly(1));
+  for (int i = 0; i < kHangoverMixes; ++i) {
+    mixer->Mix(/*number_of_channels=*/1, &frame_for_mixing);
+  }
+}
+
 class HighOutputRateCalculator : public OutputRateCalculator {
  public:
   static const int kDefaultFrequency = 76000;
@@ -39,6 +39,7 @@ namespace {
 using MixingBuffer =
     std::array<std::array<float, FrameCombiner::kMaximumChannelSize>,
                FrameCombiner::kMaximumNumberOfChannels>;
+using InterleavedBuffer = FrameCombiner::InterleavedBuffer;
 
 void SetAudioFrameFields(rtc::ArrayView<const AudioFrame* const> mix_list,
                          size_t number_of_channels,
@@ -94,24 +95,41 @@ void MixFewFramesWithNoLimiter(rtc::ArrayView<const AudioFrame* const> mix_list,
 void MixToFloatFrame(rtc::ArrayView<const AudioFrame* const> mix_list,
                      size_t samples_per_channel,
                      size_t number_of_channels,
-                     MixingBuffer* mixing_buffer) {
+                     const MixingMath& mixing_math,
+                     MixingBuffer* mixing_buffer,
+                     InterleavedBuffer* interleaved_buffer) {
   RTC_DCHECK_LE(samples_per_channel, FrameCombiner::kMaximumChannelSize);
   RTC_DCHECK_LE(number_of_channels, FrameCombiner::kMaximumNumberOfChannels);
+  const size_t output_number_of_channels =
+      std::min(number_of_channels, FrameCombiner::kMaximumNumberOfChannels);
+  const size_t output_samples_per_channel =
+      std::min(samples_per_channel, FrameCombiner::kMaximumChannelSize);
   // Clear the mixing buffer.
   *mixing_buffer = {};
 
-  // Convert to FloatS16 and mix.
-  for (size_t i = 0; i < mix_list.size(); ++i) {
-    const AudioFrame* const frame = mix_list[i];
-    const int16_t* const frame_data = frame->data();
-    for (size_t j = 0; j < std::min(number_of_channels,
-                                    FrameCombiner::kMaximumNumberOfChannels);
-         ++j) {
-      for (size_t k = 0; k < std::min(samples_per_channel,
-                                      FrameCombiner::kMaximumChannelSize);
-           ++k) {
-        (*mixing_buffer)[j][k] += frame_data[number_of_channels * k + j];
-      }
+  // Convert to FloatS16 and mix. Mono frames are mixed into the mixing buffer
+  // directly; others are mixed interleaved and deinterleaved once.
+  if (number_of_channels == 1) {
+    rtc::ArrayView<float> mix((*mixing_buffer)[0].data(),
+                              output_samples_per_channel);
+    for (const AudioFrame* frame : mix_list) {
+      mixing_math.Accumulate(
+          rtc::ArrayView<const int16_t>(frame->data(), mix.size()), mix);
+    }
+    return;
+  }
+
+  const size_t number_of_samples = samples_per_channel * number_of_channels;
+  RTC_DCHECK_LE(number_of_samples, interleaved_buffer->size());
+  rtc::ArrayView<float> mix(interleaved_buffer->data(), number_of_samples);
+  std::fill(mix.begin(), mix.end(), 0.f);
+  for (const AudioFrame* frame : mix_list) {
+    mixing_math.Accumulate(
+        rtc::ArrayView<const int16_t>(frame->data(), number_of_samples), mix);
+  }
+  for (size_t j = 0; j < output_number_of_channels; ++j) {
+    for (size_t k = 0; k < output_samples_per_channel; ++k) {
+      (*mixing_buffer)[j][k] = mix[number_of_channels * k + j];
     }
   }
 }
@@ -126,17 +144,30 @@ void RunLimiter(AudioFrameView<float> mixing_buffer_view, Limiter* limiter) {
 
 // Both interleaves and rounds.
 void InterleaveToAudioFrame(AudioFrameView<const float> mixing_buffer_view,
+                            const MixingMath& mixing_math,
+                            InterleavedBuffer* interleaved_buffer,
                             AudioFrame* audio_frame_for_mixing) {
   const size_t number_of_channels = mixing_buffer_view.num_channels();
   const size_t samples_per_channel = mixing_buffer_view.samples_per_channel();
-  int16_t* const mixing_data = audio_frame_for_mixing->mutable_data();
+  const size_t number_of_samples = number_of_channels * samples_per_channel;
+  rtc::ArrayView<int16_t> mixing_data(audio_frame_for_mixing->mutable_data(),
+                                      number_of_samples);
   // Put data in the result frame.
+  if (number_of_channels == 1) {
+    mixing_math.ConvertToS16(mixing_buffer_view.channel(0), mixing_data);
+    return;
+  }
+  RTC_DCHECK_LE(number_of_samples, interleaved_buffer->size());
   for (size_t i = 0; i < number_of_channels; ++i) {
     for (size_t j = 0; j < samples_per_channel; ++j) {
-      mixing_data[number_of_channels * j + i] =
-          FloatS16ToS16(mixing_buffer_view.channel(i)[j]);
+      (*interleaved_buffer)[number_of_channels * j + i] =
+          mixing_buffer_view.channel(i)[j];
     }
   }
+  mixing_math.ConvertToS16(
+      rtc::ArrayView<const float>(interleaved_buffer->data(),
+                                  number_of_samples),
+      mixing_data);
 }
 }  // namespace
 
@@ -144,10 +175,12 @@ constexpr size_t FrameCombiner::kMaximumNumberOfChannels;
 constexpr size_t FrameCombiner::kMaximumChannelSize;
 
 FrameCombiner::FrameCombiner(bool use_limiter)
-    : data_dumper_(new ApmDataDumper(0)),
+    : mixing_math_(GetAvailableCpuFeatures()),
+      data_dumper_(new ApmDataDumper(0)),
       mixing_buffer_(
           std::make_unique<std::array<std::array<float, kMaximumChannelSize>,
                                       kMaximumNumberOfChannels>>()),
+      interleaved_buffer_(std::make_unique<InterleavedBuffer>()),
       limiter_(static_cast<size_t>(48000), data_dumper_.get(), "AudioMixer"),
       use_limiter_(use_limiter) {
   static_assert(kMaximumChannelSize * kMaximumNumberOfChannels <=
@@ -187,7 +220,8 @@ void FrameCombiner::Combine(rtc::ArrayView<AudioFrame* const> mix_list,
   }
 
   MixToFloatFrame(mix_list, samples_per_channel, number_of_channels,
-                  mixing_buffer_.get());
+                  mixing_math_, mixing_buffer_.get(),
+                  interleaved_buffer_.get());
 
   const size_t output_number_of_channels =
       std::min(number_of_channels, kMaximumNumberOfChannels);
@@ -207,7 +241,8 @@ void FrameCombiner::Combine(rtc::ArrayView<AudioFrame* const> mix_list,
     RunLimiter(mixing_buffer_view, &limiter_);
   }
 
-  InterleaveToAudioFrame(mixing_buffer_view, audio_frame_for_mixing);
+  InterleaveToAudioFrame(mixing_buffer_view, mixing_math_,
+                         interleaved_buffer_.get(), audio_frame_for_mixing);
 }
 
 }  // namespace webrtc
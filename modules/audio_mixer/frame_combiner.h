@@ -16,6 +16,7 @@
 
 #include "api/array_view.h"
 #include "api/audio/audio_frame.h"
+#include "modules/audio_mixer/mixing_math.h"
 #include "modules/audio_processing/agc2/limiter.h"
 
 namespace webrtc {
@@ -44,10 +45,14 @@ class FrameCombiner {
 
   using MixingBuffer = std::array<std::array<float, kMaximumChannelSize>,
                                   kMaximumNumberOfChannels>;
+  using InterleavedBuffer = std::array<float, AudioFrame::kMaxDataSizeSamples>;
 
  private:
+  const MixingMath mixing_math_;
   std::unique_ptr<ApmDataDumper> data_dumper_;
   std::unique_ptr<MixingBuffer> mixing_buffer_;
+  // Interleaved samples of multichannel frames being mixed.
+  std::unique_ptr<InterleavedBuffer> interleaved_buffer_;
   Limiter limiter_;
   const bool use_limiter_;
 };
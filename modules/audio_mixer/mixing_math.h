@@ -0,0 +1,193 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_MIXER_MIXING_MATH_H_
+#define MODULES_AUDIO_MIXER_MIXING_MATH_H_
+
+// Defines WEBRTC_ARCH_X86_FAMILY, used below.
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "api/array_view.h"
+#include "common_audio/include/audio_util.h"
+#include "modules/audio_processing/agc2/cpu_features.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+// Provides optimizations for the sample operations of audio mixing. All of
+// them give the same results as their scalar versions.
+class MixingMath {
+ public:
+  explicit MixingMath(AvailableCpuFeatures cpu_features)
+      : cpu_features_(cpu_features) {}
+
+  // Adds the samples of `x` to the FloatS16 samples of `accumulator`.
+  void Accumulate(rtc::ArrayView<const int16_t> x,
+                  rtc::ArrayView<float> accumulator) const {
+    RTC_DCHECK_EQ(x.size(), accumulator.size());
+    size_t i = 0;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    if (cpu_features_.avx2) {
+      AccumulateAvx2(x, accumulator);
+      return;
+    } else if (cpu_features_.sse2) {
+      for (; i + 8 <= x.size(); i += 8) {
+        const __m128i x_i =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(&x[i]));
+        // Sign extend to 32 bits by shifting the samples to the upper half.
+        const __m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(x_i, x_i), 16);
+        const __m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(x_i, x_i), 16);
+        _mm_storeu_ps(&accumulator[i],
+                      _mm_add_ps(_mm_loadu_ps(&accumulator[i]),
+                                 _mm_cvtepi32_ps(low)));
+        _mm_storeu_ps(&accumulator[i + 4],
+                      _mm_add_ps(_mm_loadu_ps(&accumulator[i + 4]),
+                                 _mm_cvtepi32_ps(high)));
+      }
+    }
+#elif defined(WEBRTC_HAS_NEON) && defined(WEBRTC_ARCH_ARM64)
+    if (cpu_features_.neon) {
+      for (; i + 8 <= x.size(); i += 8) {
+        const int16x8_t x_i = vld1q_s16(&x[i]);
+        const float32x4_t low = vcvtq_f32_s32(vmovl_s16(vget_low_s16(x_i)));
+        const float32x4_t high = vcvtq_f32_s32(vmovl_s16(vget_high_s16(x_i)));
+        vst1q_f32(&accumulator[i], vaddq_f32(vld1q_f32(&accumulator[i]), low));
+        vst1q_f32(&accumulator[i + 4],
+                  vaddq_f32(vld1q_f32(&accumulator[i + 4]), high));
+      }
+    }
+#endif
+    for (; i < x.size(); ++i) {
+      accumulator[i] += x[i];
+    }
+  }
+
+  // Rounds and saturates the FloatS16 samples of `x` into `y`, as
+  // FloatS16ToS16().
+  void ConvertToS16(rtc::ArrayView<const float> x,
+                    rtc::ArrayView<int16_t> y) const {
+    RTC_DCHECK_EQ(x.size(), y.size());
+    size_t i = 0;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    if (cpu_features_.avx2) {
+      ConvertToS16Avx2(x, y);
+      return;
+    } else if (cpu_features_.sse2) {
+      const __m128 max = _mm_set1_ps(32767.f);
+      const __m128 min = _mm_set1_ps(-32768.f);
+      const __m128 half = _mm_set1_ps(0.5f);
+      const __m128 sign_mask = _mm_set1_ps(-0.f);
+      const auto round = [&](__m128 v) {
+        v = _mm_max_ps(_mm_min_ps(v, max), min);
+        // Round half away from zero: add 0.5 with the sign of `v`, truncate.
+        const __m128 signed_half = _mm_or_ps(_mm_and_ps(v, sign_mask), half);
+        return _mm_cvttps_epi32(_mm_add_ps(v, signed_half));
+      };
+      for (; i + 8 <= x.size(); i += 8) {
+        const __m128i low = round(_mm_loadu_ps(&x[i]));
+        const __m128i high = round(_mm_loadu_ps(&x[i + 4]));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&y[i]),
+                         _mm_packs_epi32(low, high));
+      }
+    }
+#elif defined(WEBRTC_HAS_NEON) && defined(WEBRTC_ARCH_ARM64)
+    if (cpu_features_.neon) {
+      const float32x4_t max = vdupq_n_f32(32767.f);
+      const float32x4_t min = vdupq_n_f32(-32768.f);
+      const uint32x4_t half = vreinterpretq_u32_f32(vdupq_n_f32(0.5f));
+      const uint32x4_t sign_mask = vdupq_n_u32(0x80000000);
+      const auto round = [&](float32x4_t v) {
+        v = vmaxq_f32(vminq_f32(v, max), min);
+        // Round half away from zero: add 0.5 with the sign of `v`, truncate.
+        const float32x4_t signed_half = vreinterpretq_f32_u32(
+            vorrq_u32(vandq_u32(vreinterpretq_u32_f32(v), sign_mask), half));
+        return vqmovn_s32(vcvtq_s32_f32(vaddq_f32(v, signed_half)));
+      };
+      for (; i + 8 <= x.size(); i += 8) {
+        vst1q_s16(&y[i], vcombine_s16(round(vld1q_f32(&x[i])),
+                                      round(vld1q_f32(&x[i + 4]))));
+      }
+    }
+#endif
+    for (; i < x.size(); ++i) {
+      y[i] = FloatS16ToS16(x[i]);
+    }
+  }
+
+  // Multiplies each sample of `x` by the gain at the same index of `gains`,
+  // truncating the products towards zero.
+  void ApplyGains(rtc::ArrayView<const float> gains,
+                  rtc::ArrayView<int16_t> x) const {
+    RTC_DCHECK_EQ(gains.size(), x.size());
+    size_t i = 0;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    if (cpu_features_.avx2) {
+      ApplyGainsAvx2(gains, x);
+      return;
+    } else if (cpu_features_.sse2) {
+      for (; i + 8 <= x.size(); i += 8) {
+        const __m128i x_i =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(&x[i]));
+        const __m128 low = _mm_cvtepi32_ps(
+            _mm_srai_epi32(_mm_unpacklo_epi16(x_i, x_i), 16));
+        const __m128 high = _mm_cvtepi32_ps(
+            _mm_srai_epi32(_mm_unpackhi_epi16(x_i, x_i), 16));
+        const __m128i low_product =
+            _mm_cvttps_epi32(_mm_mul_ps(low, _mm_loadu_ps(&gains[i])));
+        const __m128i high_product =
+            _mm_cvttps_epi32(_mm_mul_ps(high, _mm_loadu_ps(&gains[i + 4])));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&x[i]),
+                         _mm_packs_epi32(low_product, high_product));
+      }
+    }
+#elif defined(WEBRTC_HAS_NEON) && defined(WEBRTC_ARCH_ARM64)
+    if (cpu_features_.neon) {
+      for (; i + 8 <= x.size(); i += 8) {
+        const int16x8_t x_i = vld1q_s16(&x[i]);
+        const float32x4_t low = vcvtq_f32_s32(vmovl_s16(vget_low_s16(x_i)));
+        const float32x4_t high = vcvtq_f32_s32(vmovl_s16(vget_high_s16(x_i)));
+        const int32x4_t low_product =
+            vcvtq_s32_f32(vmulq_f32(low, vld1q_f32(&gains[i])));
+        const int32x4_t high_product =
+            vcvtq_s32_f32(vmulq_f32(high, vld1q_f32(&gains[i + 4])));
+        vst1q_s16(&x[i], vcombine_s16(vqmovn_s32(low_product),
+                                      vqmovn_s32(high_product)));
+      }
+    }
+#endif
+    for (; i < x.size(); ++i) {
+      x[i] *= gains[i];
+    }
+  }
+
+ private:
+  void AccumulateAvx2(rtc::ArrayView<const int16_t> x,
+                      rtc::ArrayView<float> accumulator) const;
+  void ConvertToS16Avx2(rtc::ArrayView<const float> x,
+                        rtc::ArrayView<int16_t> y) const;
+  void ApplyGainsAvx2(rtc::ArrayView<const float> gains,
+                      rtc::ArrayView<int16_t> x) const;
+
+  const AvailableCpuFeatures cpu_features_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_MIXER_MIXING_MATH_H_
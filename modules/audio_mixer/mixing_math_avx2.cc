@@ -0,0 +1,104 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include "api/array_view.h"
+#include "common_audio/include/audio_util.h"
+#include "modules/audio_mixer/mixing_math.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+
+// Converts 16 samples to two vectors of 8 FloatS16 samples.
+void LoadS16(const int16_t* x, __m256& low, __m256& high) {
+  const __m256i x_i = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x));
+  low = _mm256_cvtepi32_ps(
+      _mm256_cvtepi16_epi32(_mm256_extracti128_si256(x_i, 0)));
+  high = _mm256_cvtepi32_ps(
+      _mm256_cvtepi16_epi32(_mm256_extracti128_si256(x_i, 1)));
+}
+
+// Saturates two vectors of 8 samples to 16 bits and stores them in order.
+void StoreS16(__m256i low, __m256i high, int16_t* y) {
+  // The packing interleaves the 128 bit lanes of `low` and `high`.
+  const __m256i packed = _mm256_permute4x64_epi64(
+      _mm256_packs_epi32(low, high), _MM_SHUFFLE(3, 1, 2, 0));
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(y), packed);
+}
+
+}  // namespace
+
+void MixingMath::AccumulateAvx2(rtc::ArrayView<const int16_t> x,
+                                rtc::ArrayView<float> accumulator) const {
+  RTC_DCHECK(cpu_features_.avx2);
+  RTC_DCHECK_EQ(x.size(), accumulator.size());
+  size_t i = 0;
+  for (; i + 16 <= x.size(); i += 16) {
+    __m256 low;
+    __m256 high;
+    LoadS16(&x[i], low, high);
+    _mm256_storeu_ps(&accumulator[i],
+                     _mm256_add_ps(_mm256_loadu_ps(&accumulator[i]), low));
+    _mm256_storeu_ps(&accumulator[i + 8],
+                     _mm256_add_ps(_mm256_loadu_ps(&accumulator[i + 8]), high));
+  }
+  for (; i < x.size(); ++i) {
+    accumulator[i] += x[i];
+  }
+}
+
+void MixingMath::ConvertToS16Avx2(rtc::ArrayView<const float> x,
+                                  rtc::ArrayView<int16_t> y) const {
+  RTC_DCHECK(cpu_features_.avx2);
+  RTC_DCHECK_EQ(x.size(), y.size());
+  const __m256 max = _mm256_set1_ps(32767.f);
+  const __m256 min = _mm256_set1_ps(-32768.f);
+  const __m256 half = _mm256_set1_ps(0.5f);
+  const __m256 sign_mask = _mm256_set1_ps(-0.f);
+  const auto round = [&](__m256 v) {
+    v = _mm256_max_ps(_mm256_min_ps(v, max), min);
+    // Round half away from zero: add 0.5 with the sign of `v`, truncate.
+    const __m256 signed_half =
+        _mm256_or_ps(_mm256_and_ps(v, sign_mask), half);
+    return _mm256_cvttps_epi32(_mm256_add_ps(v, signed_half));
+  };
+  size_t i = 0;
+  for (; i + 16 <= x.size(); i += 16) {
+    StoreS16(round(_mm256_loadu_ps(&x[i])), round(_mm256_loadu_ps(&x[i + 8])),
+             &y[i]);
+  }
+  for (; i < x.size(); ++i) {
+    y[i] = FloatS16ToS16(x[i]);
+  }
+}
+
+void MixingMath::ApplyGainsAvx2(rtc::ArrayView<const float> gains,
+                                rtc::ArrayView<int16_t> x) const {
+  RTC_DCHECK(cpu_features_.avx2);
+  RTC_DCHECK_EQ(gains.size(), x.size());
+  size_t i = 0;
+  for (; i + 16 <= x.size(); i += 16) {
+    __m256 low;
+    __m256 high;
+    LoadS16(&x[i], low, high);
+    StoreS16(
+        _mm256_cvttps_epi32(_mm256_mul_ps(low, _mm256_loadu_ps(&gains[i]))),
+        _mm256_cvttps_epi32(
+            _mm256_mul_ps(high, _mm256_loadu_ps(&gains[i + 8]))),
+        &x[i]);
+  }
+  for (; i < x.size(); ++i) {
+    x[i] *= gains[i];
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,88 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <array>
+#include <vector>
+
+#include "api/array_view.h"
+#include "api/audio/audio_frame.h"
+#include "benchmark/benchmark.h"
+#include "modules/audio_mixer/frame_combiner.h"
+#include "modules/audio_mixer/mixing_math.h"
+#include "modules/audio_processing/agc2/cpu_features.h"
+#include "rtc_base/system/unused.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kSampleRateHz = 48000;
+constexpr size_t kSamplesPerChannel = kSampleRateHz / 100;
+
+// Returns the CPU features to benchmark with, from the `index` argument of the
+// benchmark: 0 means none, 1 the available ones.
+AvailableCpuFeatures CpuFeatures(int64_t index) {
+  return index == 0 ? AvailableCpuFeatures(/*sse2=*/false, /*avx2=*/false,
+                                           /*neon=*/false)
+                    : GetAvailableCpuFeatures();
+}
+
+void BM_Accumulate(benchmark::State& state) {
+  const MixingMath mixing_math(CpuFeatures(state.range(0)));
+  std::vector<int16_t> x(kSamplesPerChannel * 2, 1000);
+  std::vector<float> accumulator(x.size());
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    mixing_math.Accumulate(x, accumulator);
+    benchmark::DoNotOptimize(accumulator.data());
+  }
+}
+
+void BM_ConvertToS16(benchmark::State& state) {
+  const MixingMath mixing_math(CpuFeatures(state.range(0)));
+  std::vector<float> x(kSamplesPerChannel * 2, 1000.5f);
+  std::vector<int16_t> y(x.size());
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    mixing_math.ConvertToS16(x, y);
+    benchmark::DoNotOptimize(y.data());
+  }
+}
+
+// Mixes `state.range(0)` stereo frames.
+void BM_FrameCombinerCombine(benchmark::State& state) {
+  FrameCombiner combiner(/*use_limiter=*/true);
+  std::vector<AudioFrame> frames(state.range(0));
+  std::vector<AudioFrame*> mix_list;
+  for (AudioFrame& frame : frames) {
+    frame.UpdateFrame(0, nullptr, kSamplesPerChannel, kSampleRateHz,
+                      AudioFrame::kNormalSpeech, AudioFrame::kVadActive,
+                      /*num_channels=*/2);
+    int16_t* data = frame.mutable_data();
+    for (size_t i = 0; i < kSamplesPerChannel * 2; ++i) {
+      data[i] = static_cast<int16_t>(i * 31);
+    }
+    mix_list.push_back(&frame);
+  }
+  AudioFrame output;
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    combiner.Combine(mix_list, /*number_of_channels=*/2, kSampleRateHz,
+                     mix_list.size(), &output);
+    benchmark::DoNotOptimize(output.data());
+  }
+}
+
+}  // namespace
+
+BENCHMARK(BM_Accumulate)->Arg(0)->Arg(1);
+BENCHMARK(BM_ConvertToS16)->Arg(0)->Arg(1);
+BENCHMARK(BM_FrameCombinerCombine)->Arg(1)->Arg(3);
+
+}  // namespace webrtc
@@ -0,0 +1,112 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_mixer/mixing_math.h"
+
+#include <limits>
+#include <vector>
+
+#include "common_audio/include/audio_util.h"
+#include "modules/audio_processing/agc2/cpu_features.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+// Not a multiple of any vector size, so that the scalar tails are tested.
+constexpr int kSize = 67;
+
+std::vector<int16_t> TestSamples() {
+  std::vector<int16_t> x(kSize);
+  for (int i = 0; i < kSize; ++i) {
+    x[i] = static_cast<int16_t>((i * 7919) % 65536 - 32768);
+  }
+  x[0] = std::numeric_limits<int16_t>::min();
+  x[1] = std::numeric_limits<int16_t>::max();
+  x[2] = 0;
+  return x;
+}
+
+class MixingMathParametrization
+    : public ::testing::TestWithParam<AvailableCpuFeatures> {};
+
+TEST_P(MixingMathParametrization, AccumulateAddsSamples) {
+  const MixingMath mixing_math(/*cpu_features=*/GetParam());
+  const std::vector<int16_t> x = TestSamples();
+  std::vector<float> accumulator(kSize, 0.5f);
+  mixing_math.Accumulate(x, accumulator);
+  mixing_math.Accumulate(x, accumulator);
+  for (int i = 0; i < kSize; ++i) {
+    EXPECT_EQ(accumulator[i], 0.5f + 2.f * x[i]) << i;
+  }
+}
+
+TEST_P(MixingMathParametrization, ConvertToS16MatchesFloatS16ToS16) {
+  const MixingMath mixing_math(/*cpu_features=*/GetParam());
+  std::vector<float> x(kSize);
+  for (int i = 0; i < kSize; ++i) {
+    // Covers saturation and rounding of halves in both directions.
+    x[i] = (i - kSize / 2) * 1234.5f;
+  }
+  x[0] = -0.5f;
+  x[1] = 0.5f;
+  x[2] = -1.5f;
+  x[3] = 32767.5f;
+  x[4] = -32768.5f;
+  std::vector<int16_t> y(kSize);
+  mixing_math.ConvertToS16(x, y);
+  for (int i = 0; i < kSize; ++i) {
+    EXPECT_EQ(y[i], FloatS16ToS16(x[i])) << x[i];
+  }
+}
+
+TEST_P(MixingMathParametrization, ApplyGainsTruncatesProducts) {
+  const MixingMath mixing_math(/*cpu_features=*/GetParam());
+  const std::vector<int16_t> x = TestSamples();
+  std::vector<float> gains(kSize);
+  for (int i = 0; i < kSize; ++i) {
+    gains[i] = static_cast<float>(i) / kSize;
+  }
+  std::vector<int16_t> y = x;
+  mixing_math.ApplyGains(gains, y);
+  for (int i = 0; i < kSize; ++i) {
+    int16_t expected = x[i];
+    expected *= gains[i];
+    EXPECT_EQ(y[i], expected) << i;
+  }
+}
+
+// Finds the relevant CPU features combinations to test.
+std::vector<AvailableCpuFeatures> GetCpuFeaturesToTest() {
+  std::vector<AvailableCpuFeatures> v;
+  v.push_back({/*sse2=*/false, /*avx2=*/false, /*neon=*/false});
+  AvailableCpuFeatures available = GetAvailableCpuFeatures();
+  if (available.avx2) {
+    v.push_back({/*sse2=*/false, /*avx2=*/true, /*neon=*/false});
+  }
+  if (available.sse2) {
+    v.push_back({/*sse2=*/true, /*avx2=*/false, /*neon=*/false});
+  }
+  if (available.neon) {
+    v.push_back({/*sse2=*/false, /*avx2=*/false, /*neon=*/true});
+  }
+  return v;
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    AudioMixer,
+    MixingMathParametrization,
+    ::testing::ValuesIn(GetCpuFeaturesToTest()),
+    [](const ::testing::TestParamInfo<AvailableCpuFeatures>& info) {
+      return info.param.ToString();
+    });
+
+}  // namespace
+}  // namespace webrtc
@@ -16,6 +16,7 @@
 
 #include "rtc_base/checks.h"
 #include "system_wrappers/include/cpu_features_wrapper.h"
+#include "system_wrappers/include/field_trial.h"
 
 namespace webrtc {
 
@@ -79,9 +80,56 @@ bool IsSse2Available() {
 #endif
 }
 
+Aec3Fft::Backend DefaultBackend() {
+  if (!field_trial::IsEnabled("WebRTC-Aec3PffftFft") ||
+      !Pffft::IsSimdEnabled()) {
+    return Aec3Fft::Backend::kOoura;
+  }
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  // PFFFT is built with SSE, which the Ooura FFT only uses if SSE2 is there.
+  if (!IsSse2Available()) {
+    return Aec3Fft::Backend::kOoura;
+  }
+#endif
+  return Aec3Fft::Backend::kPffft;
+}
+
 }  // namespace
 
-Aec3Fft::Aec3Fft() : ooura_fft_(IsSse2Available()) {}
+Aec3Fft::Aec3Fft() : Aec3Fft(DefaultBackend()) {}
+
+Aec3Fft::Aec3Fft(Backend backend)
+    : ooura_fft_(IsSse2Available()),
+      pffft_(backend == Backend::kPffft
+                 ? std::make_unique<Pffft>(kFftLength, Pffft::FftType::kReal)
+                 : nullptr),
+      pffft_buffer_(pffft_ ? pffft_->CreateBuffer() : nullptr) {}
+
+void Aec3Fft::PffftTransform(bool forward,
+                             std::array<float, kFftLength>* x) const {
+  // Both FFTs pack the real parts of the DC and Nyquist bins first, followed
+  // by interleaved real and imaginary parts, but the imaginary parts of the
+  // Ooura FFT have the opposite sign. The Ooura inverse FFT is scaled by
+  // kFftLengthBy2 and the PFFFT one by kFftLength.
+  rtc::ArrayView<float> buffer = pffft_buffer_->GetView();
+  std::copy(x->begin(), x->end(), buffer.begin());
+  if (forward) {
+    pffft_->ForwardTransform(*pffft_buffer_, pffft_buffer_.get(),
+                             /*ordered=*/true);
+    for (size_t k = 3; k < kFftLength; k += 2) {
+      buffer[k] = -buffer[k];
+    }
+    std::copy(buffer.begin(), buffer.end(), x->begin());
+  } else {
+    for (size_t k = 3; k < kFftLength; k += 2) {
+      buffer[k] = -buffer[k];
+    }
+    pffft_->BackwardTransform(*pffft_buffer_, pffft_buffer_.get(),
+                              /*ordered=*/true);
+    std::transform(buffer.begin(), buffer.end(), x->begin(),
+                   [](float a) { return 0.5f * a; });
+  }
+}
 
 // TODO(peah): Change x to be std::array once the rest of the code allows this.
 void Aec3Fft::ZeroPaddedFft(rtc::ArrayView<const float> x,
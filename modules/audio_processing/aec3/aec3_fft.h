@@ -12,11 +12,13 @@
 #define MODULES_AUDIO_PROCESSING_AEC3_AEC3_FFT_H_
 
 #include <array>
+#include <memory>
 
 #include "api/array_view.h"
 #include "common_audio/third_party/ooura/fft_size_128/ooura_fft.h"
 #include "modules/audio_processing/aec3/aec3_common.h"
 #include "modules/audio_processing/aec3/fft_data.h"
+#include "modules/audio_processing/utility/pffft_wrapper.h"
 #include "rtc_base/checks.h"
 
 namespace webrtc {
@@ -26,8 +28,13 @@ namespace webrtc {
 class Aec3Fft {
  public:
   enum class Window { kRectangular, kHanning, kSqrtHanning };
+  // FFT implementation. Both give the same output up to rounding errors.
+  enum class Backend { kOoura, kPffft };
 
+  // Uses the PFFFT backend if the "WebRTC-Aec3PffftFft" field trial is enabled
+  // and PFFFT can use SIMD instructions on this CPU, and Ooura otherwise.
   Aec3Fft();
+  explicit Aec3Fft(Backend backend);
 
   Aec3Fft(const Aec3Fft&) = delete;
   Aec3Fft& operator=(const Aec3Fft&) = delete;
@@ -36,14 +43,22 @@ class Aec3Fft {
   void Fft(std::array<float, kFftLength>* x, FftData* X) const {
     RTC_DCHECK(x);
     RTC_DCHECK(X);
-    ooura_fft_.Fft(x->data());
+    if (pffft_) {
+      PffftTransform(/*forward=*/true, x);
+    } else {
+      ooura_fft_.Fft(x->data());
+    }
     X->CopyFromPackedArray(*x);
   }
   // Computes the inverse Fft.
   void Ifft(const FftData& X, std::array<float, kFftLength>* x) const {
     RTC_DCHECK(x);
     X.CopyToPackedArray(x);
-    ooura_fft_.InverseFft(x->data());
+    if (pffft_) {
+      PffftTransform(/*forward=*/false, x);
+    } else {
+      ooura_fft_.InverseFft(x->data());
+    }
   }
 
   // Windows the input using a Hanning window, and then adds padding of
@@ -67,7 +82,14 @@ class Aec3Fft {
                  FftData* X) const;
 
  private:
+  // Computes the FFT of `x` in place with PFFFT, using the packing, sign
+  // convention and scaling of the Ooura FFT.
+  void PffftTransform(bool forward, std::array<float, kFftLength>* x) const;
+
   const OouraFft ooura_fft_;
+  // Null unless the PFFFT backend is used.
+  const std::unique_ptr<Pffft> pffft_;
+  const std::unique_ptr<Pffft::FloatBuffer> pffft_buffer_;
 };
 
 }  // namespace webrtc
@@ -153,6 +153,35 @@ TEST(Aec3Fft, FftAndIfft) {
   }
 }
 
+// Verifies that the PFFFT backend gives the same output as the Ooura one.
+TEST(Aec3Fft, PffftMatchesOoura) {
+  Aec3Fft ooura_fft(Aec3Fft::Backend::kOoura);
+  Aec3Fft pffft_fft(Aec3Fft::Backend::kPffft);
+  FftData X_ooura;
+  FftData X_pffft;
+  std::array<float, kFftLength> x_ooura;
+  std::array<float, kFftLength> x_pffft;
+
+  for (int k = 0; k < 20; ++k) {
+    for (size_t j = 0; j < x_ooura.size(); ++j) {
+      x_ooura[j] = ((k + 1) * j * 37) % 201 - 100.f;
+    }
+    x_pffft = x_ooura;
+    ooura_fft.Fft(&x_ooura, &X_ooura);
+    pffft_fft.Fft(&x_pffft, &X_pffft);
+    for (size_t j = 0; j < kFftLengthBy2Plus1; ++j) {
+      EXPECT_NEAR(X_ooura.re[j], X_pffft.re[j], 0.01f);
+      EXPECT_NEAR(X_ooura.im[j], X_pffft.im[j], 0.01f);
+    }
+
+    ooura_fft.Ifft(X_ooura, &x_ooura);
+    pffft_fft.Ifft(X_ooura, &x_pffft);
+    for (size_t j = 0; j < kFftLength; ++j) {
+      EXPECT_NEAR(x_ooura[j], x_pffft[j], 0.1f);
+    }
+  }
+}
+
 // Verifies that ZeroPaddedFft work as intended.
 TEST(Aec3Fft, ZeroPaddedFft) {
   Aec3Fft fft;
@@ -75,6 +75,8 @@ void GenerateComfortNoise(Aec3Optimization optimization,
   // (strong correlation).
   N_low->re[0] = N_low->re[kFftLengthBy2] = N_high->re[0] =
       N_high->re[kFftLengthBy2] = 0.f;
+  std::array<float, kFftLengthBy2 - 1> x;
+  std::array<float, kFftLengthBy2 - 1> y;
   for (size_t k = 1; k < kFftLengthBy2; k++) {
     constexpr int kIndexMask = 32 - 1;
     // Generate a random 31-bit integer.
@@ -83,18 +85,22 @@ void GenerateComfortNoise(Aec3Optimization optimization,
     int i = seed[0] >> 26;
 
     // y = sqrt(2) * sin(a)
-    const float x = kSqrt2Sin[i];
+    x[k - 1] = kSqrt2Sin[i];
     // x = sqrt(2) * cos(a) = sqrt(2) * sin(a + pi/2)
-    const float y = kSqrt2Sin[(i + 8) & kIndexMask];
-
-    // Form low-frequency noise via spectral shaping.
-    N_low->re[k] = N[k] * x;
-    N_low->im[k] = N[k] * y;
+    y[k - 1] = kSqrt2Sin[(i + 8) & kIndexMask];
 
     // Form the high-frequency noise via simple levelling.
-    N_high->re[k] = high_band_noise_level * x;
-    N_high->im[k] = high_band_noise_level * y;
+    N_high->re[k] = high_band_noise_level * x[k - 1];
+    N_high->im[k] = high_band_noise_level * y[k - 1];
   }
+
+  // Form low-frequency noise via spectral shaping.
+  rtc::ArrayView<const float> N_bins(&N[1], x.size());
+  aec3::VectorMath vector_math(optimization);
+  vector_math.Multiply(N_bins, x,
+                       rtc::ArrayView<float>(&N_low->re[1], x.size()));
+  vector_math.Multiply(N_bins, y,
+                       rtc::ArrayView<float>(&N_low->im[1], y.size()));
 }
 
 }  // namespace
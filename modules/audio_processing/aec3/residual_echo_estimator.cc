@@ -17,6 +17,7 @@
 
 #include "api/array_view.h"
 #include "modules/audio_processing/aec3/reverb_model.h"
+#include "modules/audio_processing/aec3/vector_math.h"
 #include "rtc_base/checks.h"
 #include "system_wrappers/include/field_trial.h"
 
@@ -118,7 +119,8 @@ void ApplyNoiseGate(const EchoCanceller3Config::EchoModel& config,
 
 // Estimates the echo generating signal power as gated maximal power over a
 // time window.
-void EchoGeneratingPower(size_t num_render_channels,
+void EchoGeneratingPower(Aec3Optimization optimization,
+                         size_t num_render_channels,
                          const SpectrumBuffer& spectrum_buffer,
                          const EchoCanceller3Config::EchoModel& echo_model,
                          int filter_delay_blocks,
@@ -128,26 +130,20 @@ void EchoGeneratingPower(size_t num_render_channels,
   GetRenderIndexesToAnalyze(spectrum_buffer, echo_model, filter_delay_blocks,
                             &idx_start, &idx_stop);
 
+  aec3::VectorMath vector_math(optimization);
   std::fill(X2.begin(), X2.end(), 0.f);
   if (num_render_channels == 1) {
     for (int k = idx_start; k != idx_stop; k = spectrum_buffer.IncIndex(k)) {
-      for (size_t j = 0; j < kFftLengthBy2Plus1; ++j) {
-        X2[j] = std::max(X2[j], spectrum_buffer.buffer[k][/*channel=*/0][j]);
-      }
+      vector_math.Maximum(spectrum_buffer.buffer[k][/*channel=*/0], X2);
     }
   } else {
     for (int k = idx_start; k != idx_stop; k = spectrum_buffer.IncIndex(k)) {
       std::array<float, kFftLengthBy2Plus1> render_power;
       render_power.fill(0.f);
       for (size_t ch = 0; ch < num_render_channels; ++ch) {
-        const auto& channel_power = spectrum_buffer.buffer[k][ch];
-        for (size_t j = 0; j < kFftLengthBy2Plus1; ++j) {
-          render_power[j] += channel_power[j];
-        }
-      }
-      for (size_t j = 0; j < kFftLengthBy2Plus1; ++j) {
-        X2[j] = std::max(X2[j], render_power[j]);
+        vector_math.Accumulate(spectrum_buffer.buffer[k][ch], render_power);
       }
+      vector_math.Maximum(render_power, X2);
     }
   }
 }
@@ -157,6 +153,7 @@ void EchoGeneratingPower(size_t num_render_channels,
 ResidualEchoEstimator::ResidualEchoEstimator(const EchoCanceller3Config& config,
                                              size_t num_render_channels)
     : config_(config),
+      optimization_(DetectOptimization()),
       num_render_channels_(num_render_channels),
       early_reflections_transparent_mode_gain_(GetTransparentModeGain()),
       late_reflections_transparent_mode_gain_(GetTransparentModeGain()),
@@ -221,7 +218,7 @@ void ResidualEchoEstimator::Estimate(
     } else {
       // Estimate the echo generating signal power.
       std::array<float, kFftLengthBy2Plus1> X2;
-      EchoGeneratingPower(num_render_channels_,
+      EchoGeneratingPower(optimization_, num_render_channels_,
                           render_buffer.GetSpectrumBuffer(), config_.echo_model,
                           aec_state.MinDirectPathFilterDelay(), X2);
       if (!aec_state.UseStationarityProperties()) {
@@ -252,11 +249,11 @@ void ResidualEchoEstimator::Estimate(
     // Scale the echo according to echo audibility.
     std::array<float, kFftLengthBy2Plus1> residual_scaling;
     aec_state.GetResidualEchoScaling(residual_scaling);
+    aec3::VectorMath vector_math(optimization_);
     for (size_t ch = 0; ch < num_capture_channels; ++ch) {
-      for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
-        R2[ch][k] *= residual_scaling[k];
-        R2_unbounded[ch][k] *= residual_scaling[k];
-      }
+      vector_math.Multiply(R2[ch], residual_scaling, R2[ch]);
+      vector_math.Multiply(R2_unbounded[ch], residual_scaling,
+                           R2_unbounded[ch]);
     }
   }
 }
@@ -277,10 +274,7 @@ void ResidualEchoEstimator::UpdateRenderNoisePower(
   if (num_render_channels_ > 1) {
     render_power_data.fill(0.f);
     for (size_t ch = 0; ch < num_render_channels_; ++ch) {
-      const auto& channel_power = X2[ch];
-      for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
-        render_power_data[k] += channel_power[k];
-      }
+      aec3::VectorMath(optimization_).Accumulate(X2[ch], render_power_data);
     }
     render_power = render_power_data;
   }
@@ -324,10 +318,7 @@ void ResidualEchoEstimator::UpdateReverb(ReverbType reverb_type,
   if (num_render_channels_ > 1) {
     render_power_data.fill(0.f);
     for (size_t ch = 0; ch < num_render_channels_; ++ch) {
-      const auto& channel_power = X2[ch];
-      for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
-        render_power_data[k] += channel_power[k];
-      }
+      aec3::VectorMath(optimization_).Accumulate(X2[ch], render_power_data);
     }
     render_power = render_power_data;
   }
@@ -353,9 +344,7 @@ void ResidualEchoEstimator::AddReverb(
   rtc::ArrayView<const float, kFftLengthBy2Plus1> reverb_power =
       echo_reverb_.reverb();
   for (size_t ch = 0; ch < num_capture_channels; ++ch) {
-    for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
-      R2[ch][k] += reverb_power[k];
-    }
+    aec3::VectorMath(optimization_).Accumulate(reverb_power, R2[ch]);
   }
 }
 
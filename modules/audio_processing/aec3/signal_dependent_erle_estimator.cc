@@ -11,10 +11,10 @@
 #include "modules/audio_processing/aec3/signal_dependent_erle_estimator.h"
 
 #include <algorithm>
-#include <functional>
 #include <numeric>
 
 #include "modules/audio_processing/aec3/spectrum_buffer.h"
+#include "modules/audio_processing/aec3/vector_math.h"
 #include "rtc_base/numerics/safe_minmax.h"
 
 namespace webrtc {
@@ -120,7 +120,8 @@ SetMaxErleSubbands(float max_erle_l, float max_erle_h, size_t limit_subband_l) {
 SignalDependentErleEstimator::SignalDependentErleEstimator(
     const EchoCanceller3Config& config,
     size_t num_capture_channels)
-    : min_erle_(config.erle.min),
+    : optimization_(DetectOptimization()),
+      min_erle_(config.erle.min),
       num_sections_(config.erle.num_sections),
       num_blocks_(config.filter.refined.length_blocks),
       delay_headroom_blocks_(config.delay.delay_headroom_samples / kBlockSize),
@@ -353,6 +354,7 @@ void SignalDependentErleEstimator::ComputeEchoEstimatePerFilterSection(
   const float one_by_num_render_channels = 1.f / num_render_channels;
 
   RTC_DCHECK_EQ(S2_section_accum_.size(), filter_frequency_responses.size());
+  aec3::VectorMath vector_math(optimization_);
 
   for (size_t capture_ch = 0; capture_ch < num_capture_channels; ++capture_ch) {
     RTC_DCHECK_EQ(S2_section_accum_[capture_ch].size() + 1,
@@ -380,23 +382,18 @@ void SignalDependentErleEstimator::ComputeEchoEstimatePerFilterSection(
                 one_by_num_render_channels;
           }
         }
-        std::transform(H2_section.begin(), H2_section.end(),
-                       filter_frequency_responses[capture_ch][block].begin(),
-                       H2_section.begin(), std::plus<float>());
+        vector_math.Accumulate(filter_frequency_responses[capture_ch][block],
+                               H2_section);
         idx_render = spectrum_render_buffer.IncIndex(idx_render);
       }
 
-      std::transform(X2_section.begin(), X2_section.end(), H2_section.begin(),
-                     S2_section_accum_[capture_ch][section].begin(),
-                     std::multiplies<float>());
+      vector_math.Multiply(X2_section, H2_section,
+                           S2_section_accum_[capture_ch][section]);
     }
 
     for (size_t section = 1; section < num_sections_; ++section) {
-      std::transform(S2_section_accum_[capture_ch][section - 1].begin(),
-                     S2_section_accum_[capture_ch][section - 1].end(),
-                     S2_section_accum_[capture_ch][section].begin(),
-                     S2_section_accum_[capture_ch][section].begin(),
-                     std::plus<float>());
+      vector_math.Accumulate(S2_section_accum_[capture_ch][section - 1],
+                             S2_section_accum_[capture_ch][section]);
     }
   }
 }
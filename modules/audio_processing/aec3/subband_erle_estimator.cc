@@ -11,8 +11,8 @@
 #include "modules/audio_processing/aec3/subband_erle_estimator.h"
 
 #include <algorithm>
-#include <functional>
 
+#include "modules/audio_processing/aec3/vector_math.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/numerics/safe_minmax.h"
 #include "system_wrappers/include/field_trial.h"
@@ -42,7 +42,8 @@ bool EnableMinErleDuringOnsets() {
 
 SubbandErleEstimator::SubbandErleEstimator(const EchoCanceller3Config& config,
                                            size_t num_capture_channels)
-    : use_onset_detection_(config.erle.onset_detection),
+    : optimization_(DetectOptimization()),
+      use_onset_detection_(config.erle.onset_detection),
       min_erle_(config.erle.min),
       max_erle_(SetMaxErleBands(config.erle.max_l, config.erle.max_h)),
       use_min_erle_during_onsets_(EnableMinErleDuringOnsets()),
@@ -234,10 +235,9 @@ void SubbandErleEstimator::UpdateAccumulatedSpectra(
       st.low_render_energy[ch].fill(false);
     }
 
-    std::transform(Y2[ch].begin(), Y2[ch].end(), st.Y2[ch].begin(),
-                   st.Y2[ch].begin(), std::plus<float>());
-    std::transform(E2[ch].begin(), E2[ch].end(), st.E2[ch].begin(),
-                   st.E2[ch].begin(), std::plus<float>());
+    aec3::VectorMath vector_math(optimization_);
+    vector_math.Accumulate(Y2[ch], st.Y2[ch]);
+    vector_math.Accumulate(E2[ch], st.E2[ch]);
 
     for (size_t k = 0; k < X2.size(); ++k) {
       st.low_render_energy[ch][k] =
@@ -85,6 +85,7 @@ class SubbandErleEstimator {
   void UpdateBands(const std::vector<bool>& converged_filters);
   void DecreaseErlePerBandForLowRenderSignals();
 
+  const Aec3Optimization optimization_;
   const bool use_onset_detection_;
   const float min_erle_;
   const std::array<float, kFftLengthBy2Plus1> max_erle_;
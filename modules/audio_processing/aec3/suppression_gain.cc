@@ -294,10 +294,10 @@ void SuppressionGain::LowerBandGain(
     GainToNoAudibleEcho(nearend, weighted_residual_echo, comfort_noise[0], &G);
 
     // Clamp gains.
-    for (size_t k = 0; k < gain->size(); ++k) {
-      G[k] = std::max(std::min(G[k], max_gain[k]), min_gain[k]);
-      (*gain)[k] = std::min((*gain)[k], G[k]);
-    }
+    aec3::VectorMath vector_math(optimization_);
+    vector_math.Minimum(max_gain, G);
+    vector_math.Maximum(min_gain, G);
+    vector_math.Minimum(G, *gain);
 
     // Store data required for the gain computation of the next block.
     std::copy(nearend.begin(), nearend.end(), last_nearend_[ch].begin());
@@ -218,6 +218,110 @@ class VectorMath {
     }
   }
 
+  // Elementwise maximum z = max(z, x), with the same results as std::max.
+  void MaximumAVX2(rtc::ArrayView<const float> x, rtc::ArrayView<float> z);
+  void Maximum(rtc::ArrayView<const float> x, rtc::ArrayView<float> z) {
+    RTC_DCHECK_EQ(z.size(), x.size());
+    switch (optimization_) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+      case Aec3Optimization::kSse2: {
+        const int x_size = static_cast<int>(x.size());
+        const int vector_limit = x_size >> 2;
+
+        int j = 0;
+        for (; j < vector_limit * 4; j += 4) {
+          const __m128 x_j = _mm_loadu_ps(&x[j]);
+          __m128 z_j = _mm_loadu_ps(&z[j]);
+          // Returns `z_j` unless `x_j` is larger, as std::max.
+          z_j = _mm_max_ps(x_j, z_j);
+          _mm_storeu_ps(&z[j], z_j);
+        }
+
+        for (; j < x_size; ++j) {
+          z[j] = std::max(z[j], x[j]);
+        }
+      } break;
+      case Aec3Optimization::kAvx2:
+        MaximumAVX2(x, z);
+        break;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+      case Aec3Optimization::kNeon: {
+        const int x_size = static_cast<int>(x.size());
+        const int vector_limit = x_size >> 2;
+
+        int j = 0;
+        for (; j < vector_limit * 4; j += 4) {
+          const float32x4_t x_j = vld1q_f32(&x[j]);
+          float32x4_t z_j = vld1q_f32(&z[j]);
+          // A select rather than vmaxq_f32, which orders -0 and +0
+          // differently from std::max.
+          z_j = vbslq_f32(vcgtq_f32(x_j, z_j), x_j, z_j);
+          vst1q_f32(&z[j], z_j);
+        }
+
+        for (; j < x_size; ++j) {
+          z[j] = std::max(z[j], x[j]);
+        }
+      } break;
+#endif
+      default:
+        std::transform(z.begin(), z.end(), x.begin(), z.begin(),
+                       [](float a, float b) { return std::max(a, b); });
+    }
+  }
+
+  // Elementwise minimum z = min(z, x), with the same results as std::min.
+  void MinimumAVX2(rtc::ArrayView<const float> x, rtc::ArrayView<float> z);
+  void Minimum(rtc::ArrayView<const float> x, rtc::ArrayView<float> z) {
+    RTC_DCHECK_EQ(z.size(), x.size());
+    switch (optimization_) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+      case Aec3Optimization::kSse2: {
+        const int x_size = static_cast<int>(x.size());
+        const int vector_limit = x_size >> 2;
+
+        int j = 0;
+        for (; j < vector_limit * 4; j += 4) {
+          const __m128 x_j = _mm_loadu_ps(&x[j]);
+          __m128 z_j = _mm_loadu_ps(&z[j]);
+          // Returns `z_j` unless `x_j` is smaller, as std::min.
+          z_j = _mm_min_ps(x_j, z_j);
+          _mm_storeu_ps(&z[j], z_j);
+        }
+
+        for (; j < x_size; ++j) {
+          z[j] = std::min(z[j], x[j]);
+        }
+      } break;
+      case Aec3Optimization::kAvx2:
+        MinimumAVX2(x, z);
+        break;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+      case Aec3Optimization::kNeon: {
+        const int x_size = static_cast<int>(x.size());
+        const int vector_limit = x_size >> 2;
+
+        int j = 0;
+        for (; j < vector_limit * 4; j += 4) {
+          const float32x4_t x_j = vld1q_f32(&x[j]);
+          float32x4_t z_j = vld1q_f32(&z[j]);
+          z_j = vbslq_f32(vcltq_f32(x_j, z_j), x_j, z_j);
+          vst1q_f32(&z[j], z_j);
+        }
+
+        for (; j < x_size; ++j) {
+          z[j] = std::min(z[j], x[j]);
+        }
+      } break;
+#endif
+      default:
+        std::transform(z.begin(), z.end(), x.begin(), z.begin(),
+                       [](float a, float b) { return std::min(a, b); });
+    }
+  }
+
  private:
   Aec3Optimization optimization_;
 };
@@ -11,6 +11,8 @@
 #include <immintrin.h>
 #include <math.h>
 
+#include <algorithm>
+
 #include "api/array_view.h"
 #include "modules/audio_processing/aec3/vector_math.h"
 #include "rtc_base/checks.h"
@@ -77,5 +79,45 @@ void VectorMath::AccumulateAVX2(rtc::ArrayView<const float> x,
   }
 }
 
+// Elementwise maximum z = max(z, x).
+void VectorMath::MaximumAVX2(rtc::ArrayView<const float> x,
+                             rtc::ArrayView<float> z) {
+  RTC_DCHECK_EQ(z.size(), x.size());
+  const int x_size = static_cast<int>(x.size());
+  const int vector_limit = x_size >> 3;
+
+  int j = 0;
+  for (; j < vector_limit * 8; j += 8) {
+    const __m256 x_j = _mm256_loadu_ps(&x[j]);
+    __m256 z_j = _mm256_loadu_ps(&z[j]);
+    z_j = _mm256_max_ps(x_j, z_j);
+    _mm256_storeu_ps(&z[j], z_j);
+  }
+
+  for (; j < x_size; ++j) {
+    z[j] = std::max(z[j], x[j]);
+  }
+}
+
+// Elementwise minimum z = min(z, x).
+void VectorMath::MinimumAVX2(rtc::ArrayView<const float> x,
+                             rtc::ArrayView<float> z) {
+  RTC_DCHECK_EQ(z.size(), x.size());
+  const int x_size = static_cast<int>(x.size());
+  const int vector_limit = x_size >> 3;
+
+  int j = 0;
+  for (; j < vector_limit * 8; j += 8) {
+    const __m256 x_j = _mm256_loadu_ps(&x[j]);
+    __m256 z_j = _mm256_loadu_ps(&z[j]);
+    z_j = _mm256_min_ps(x_j, z_j);
+    _mm256_storeu_ps(&z[j], z_j);
+  }
+
+  for (; j < x_size; ++j) {
+    z[j] = std::min(z[j], x[j]);
+  }
+}
+
 }  // namespace aec3
 }  // namespace webrtc
@@ -12,6 +12,8 @@
 
 #include <math.h>
 
+#include <cmath>
+
 #include "rtc_base/system/arch.h"
 #include "system_wrappers/include/cpu_features_wrapper.h"
 #include "test/gtest.h"
@@ -75,6 +77,60 @@ TEST(VectorMath, Accumulate) {
     EXPECT_FLOAT_EQ(x[k] + 2.f * x[k], z_neon[k]);
   }
 }
+
+TEST(VectorMath, Maximum) {
+  std::array<float, kFftLengthBy2Plus1> x;
+  std::array<float, kFftLengthBy2Plus1> z;
+  std::array<float, kFftLengthBy2Plus1> z_neon;
+
+  for (size_t k = 0; k < x.size(); ++k) {
+    x[k] = (k % 3) * 1.5f;
+    z[k] = z_neon[k] = (k % 5) * 0.9f;
+  }
+  // Zeros of different signs must be ordered as by std::max.
+  x[0] = -0.f;
+  x[1] = 0.f;
+  z[1] = z_neon[1] = -0.f;
+
+  std::array<float, kFftLengthBy2Plus1> expected;
+  for (size_t k = 0; k < x.size(); ++k) {
+    expected[k] = std::max(z[k], x[k]);
+  }
+  aec3::VectorMath(Aec3Optimization::kNone).Maximum(x, z);
+  aec3::VectorMath(Aec3Optimization::kNeon).Maximum(x, z_neon);
+  for (size_t k = 0; k < z.size(); ++k) {
+    EXPECT_EQ(std::signbit(expected[k]), std::signbit(z_neon[k]));
+    EXPECT_EQ(z[k], z_neon[k]);
+    EXPECT_EQ(expected[k], z_neon[k]);
+  }
+}
+
+TEST(VectorMath, Minimum) {
+  std::array<float, kFftLengthBy2Plus1> x;
+  std::array<float, kFftLengthBy2Plus1> z;
+  std::array<float, kFftLengthBy2Plus1> z_neon;
+
+  for (size_t k = 0; k < x.size(); ++k) {
+    x[k] = (k % 3) * 1.5f;
+    z[k] = z_neon[k] = (k % 5) * 0.9f;
+  }
+  // Zeros of different signs must be ordered as by std::min.
+  x[0] = -0.f;
+  x[1] = 0.f;
+  z[1] = z_neon[1] = -0.f;
+
+  std::array<float, kFftLengthBy2Plus1> expected;
+  for (size_t k = 0; k < x.size(); ++k) {
+    expected[k] = std::min(z[k], x[k]);
+  }
+  aec3::VectorMath(Aec3Optimization::kNone).Minimum(x, z);
+  aec3::VectorMath(Aec3Optimization::kNeon).Minimum(x, z_neon);
+  for (size_t k = 0; k < z.size(); ++k) {
+    EXPECT_EQ(std::signbit(expected[k]), std::signbit(z_neon[k]));
+    EXPECT_EQ(z[k], z_neon[k]);
+    EXPECT_EQ(expected[k], z_neon[k]);
+  }
+}
 #endif
 
 #if defined(WEBRTC_ARCH_X86_FAMILY)
@@ -204,6 +260,122 @@ TEST(VectorMath, Avx2Accumulate) {
     }
   }
 }
+
+TEST(VectorMath, Sse2Maximum) {
+  if (GetCPUInfo(kSSE2) != 0) {
+    std::array<float, kFftLengthBy2Plus1> x;
+    std::array<float, kFftLengthBy2Plus1> z;
+    std::array<float, kFftLengthBy2Plus1> z_sse2;
+
+    for (size_t k = 0; k < x.size(); ++k) {
+      x[k] = (k % 3) * 1.5f;
+      z[k] = z_sse2[k] = (k % 5) * 0.9f;
+    }
+    // Zeros of different signs must be ordered as by std::max.
+    x[0] = -0.f;
+    x[1] = 0.f;
+    z[1] = z_sse2[1] = -0.f;
+
+    std::array<float, kFftLengthBy2Plus1> expected;
+    for (size_t k = 0; k < x.size(); ++k) {
+      expected[k] = std::max(z[k], x[k]);
+    }
+    aec3::VectorMath(Aec3Optimization::kNone).Maximum(x, z);
+    aec3::VectorMath(Aec3Optimization::kSse2).Maximum(x, z_sse2);
+    for (size_t k = 0; k < z.size(); ++k) {
+      EXPECT_EQ(std::signbit(expected[k]), std::signbit(z_sse2[k]));
+      EXPECT_EQ(z[k], z_sse2[k]);
+      EXPECT_EQ(expected[k], z_sse2[k]);
+    }
+  }
+}
+
+TEST(VectorMath, Avx2Maximum) {
+  if (GetCPUInfo(kAVX2) != 0) {
+    std::array<float, kFftLengthBy2Plus1> x;
+    std::array<float, kFftLengthBy2Plus1> z;
+    std::array<float, kFftLengthBy2Plus1> z_avx2;
+
+    for (size_t k = 0; k < x.size(); ++k) {
+      x[k] = (k % 3) * 1.5f;
+      z[k] = z_avx2[k] = (k % 5) * 0.9f;
+    }
+    // Zeros of different signs must be ordered as by std::max.
+    x[0] = -0.f;
+    x[1] = 0.f;
+    z[1] = z_avx2[1] = -0.f;
+
+    std::array<float, kFftLengthBy2Plus1> expected;
+    for (size_t k = 0; k < x.size(); ++k) {
+      expected[k] = std::max(z[k], x[k]);
+    }
+    aec3::VectorMath(Aec3Optimization::kNone).Maximum(x, z);
+    aec3::VectorMath(Aec3Optimization::kAvx2).Maximum(x, z_avx2);
+    for (size_t k = 0; k < z.size(); ++k) {
+      EXPECT_EQ(std::signbit(expected[k]), std::signbit(z_avx2[k]));
+      EXPECT_EQ(z[k], z_avx2[k]);
+      EXPECT_EQ(expected[k], z_avx2[k]);
+    }
+  }
+}
+
+TEST(VectorMath, Sse2Minimum) {
+  if (GetCPUInfo(kSSE2) != 0) {
+    std::array<float, kFftLengthBy2Plus1> x;
+    std::array<float, kFftLengthBy2Plus1> z;
+    std::array<float, kFftLengthBy2Plus1> z_sse2;
+
+    for (size_t k = 0; k < x.size(); ++k) {
+      x[k] = (k % 3) * 1.5f;
+      z[k] = z_sse2[k] = (k % 5) * 0.9f;
+    }
+    // Zeros of different signs must be ordered as by std::min.
+    x[0] = -0.f;
+    x[1] = 0.f;
+    z[1] = z_sse2[1] = -0.f;
+
+    std::array<float, kFftLengthBy2Plus1> expected;
+    for (size_t k = 0; k < x.size(); ++k) {
+      expected[k] = std::min(z[k], x[k]);
+    }
+    aec3::VectorMath(Aec3Optimization::kNone).Minimum(x, z);
+    aec3::VectorMath(Aec3Optimization::kSse2).Minimum(x, z_sse2);
+    for (size_t k = 0; k < z.size(); ++k) {
+      EXPECT_EQ(std::signbit(expected[k]), std::signbit(z_sse2[k]));
+      EXPECT_EQ(z[k], z_sse2[k]);
+      EXPECT_EQ(expected[k], z_sse2[k]);
+    }
+  }
+}
+
+TEST(VectorMath, Avx2Minimum) {
+  if (GetCPUInfo(kAVX2) != 0) {
+    std::array<float, kFftLengthBy2Plus1> x;
+    std::array<float, kFftLengthBy2Plus1> z;
+    std::array<float, kFftLengthBy2Plus1> z_avx2;
+
+    for (size_t k = 0; k < x.size(); ++k) {
+      x[k] = (k % 3) * 1.5f;
+      z[k] = z_avx2[k] = (k % 5) * 0.9f;
+    }
+    // Zeros of different signs must be ordered as by std::min.
+    x[0] = -0.f;
+    x[1] = 0.f;
+    z[1] = z_avx2[1] = -0.f;
+
+    std::array<float, kFftLengthBy2Plus1> expected;
+    for (size_t k = 0; k < x.size(); ++k) {
+      expected[k] = std::min(z[k], x[k]);
+    }
+    aec3::VectorMath(Aec3Optimization::kNone).Minimum(x, z);
+    aec3::VectorMath(Aec3Optimization::kAvx2).Minimum(x, z_avx2);
+    for (size_t k = 0; k < z.size(); ++k) {
+      EXPECT_EQ(std::signbit(expected[k]), std::signbit(z_avx2[k]));
+      EXPECT_EQ(z[k], z_avx2[k]);
+      EXPECT_EQ(expected[k], z_avx2[k]);
+    }
+  }
+}
 #endif
 
 }  // namespace webrtc
@@ -28,6 +28,10 @@ std::string AvailableCpuFeatures::ToString() const {
     builder << (first ? "AVX2" : "_AVX2");
     first = false;
   }
+  if (avx512) {
+    builder << (first ? "AVX512" : "_AVX512");
+    first = false;
+  }
   if (neon) {
     builder << (first ? "NEON" : "_NEON");
     first = false;
@@ -43,7 +47,8 @@ AvailableCpuFeatures GetAvailableCpuFeatures() {
 #if defined(WEBRTC_ARCH_X86_FAMILY)
   return {/*sse2=*/GetCPUInfo(kSSE2) != 0,
           /*avx2=*/GetCPUInfo(kAVX2) != 0,
-          /*neon=*/false};
+          /*neon=*/false,
+          /*avx512=*/GetCPUInfo(kAVX512F) != 0};
 #elif defined(WEBRTC_HAS_NEON)
   return {/*sse2=*/false,
           /*avx2=*/false,
@@ -86,6 +86,10 @@ std::vector<AvailableCpuFeatures> GetCpuFeaturesToTest() {
   std::vector<AvailableCpuFeatures> v;
   v.push_back(NoAvailableCpuFeatures());
   AvailableCpuFeatures available = GetAvailableCpuFeatures();
+  if (available.avx512) {
+    v.push_back({/*sse2=*/false, /*avx2=*/false, /*neon=*/false,
+                 /*avx512=*/true});
+  }
   if (available.sse2) {
     v.push_back({/*sse2=*/true, /*avx2=*/false, /*neon=*/false});
   }
@@ -44,7 +44,9 @@ class VectorMath {
                    rtc::ArrayView<const float> y) const {
     RTC_DCHECK_EQ(x.size(), y.size());
 #if defined(WEBRTC_ARCH_X86_FAMILY)
-    if (cpu_features_.avx2) {
+    if (cpu_features_.avx512) {
+      return DotProductAvx512(x, y);
+    } else if (cpu_features_.avx2) {
       return DotProductAvx2(x, y);
     } else if (cpu_features_.sse2) {
       __m128 accumulator = _mm_setzero_ps();
@@ -73,7 +75,7 @@ class VectorMath {
       }
       return dot_product;
     }
-#elif defined(WEBRTC_HAS_NEON) && defined(WEBRTC_ARCH_ARM64)
+#elif defined(WEBRTC_HAS_NEON)
     if (cpu_features_.neon) {
       float32x4_t accumulator = vdupq_n_f32(0.f);
       constexpr int kBlockSizeLog2 = 2;
@@ -84,7 +86,12 @@ class VectorMath {
         RTC_DCHECK_LE(i + kBlockSize, x.size());
         const float32x4_t x_i = vld1q_f32(&x[i]);
         const float32x4_t y_i = vld1q_f32(&y[i]);
+#if defined(WEBRTC_ARCH_ARM64)
         accumulator = vfmaq_f32(accumulator, x_i, y_i);
+#else
+        // ARMv7 NEON has no fused multiply-add.
+        accumulator = vmlaq_f32(accumulator, x_i, y_i);
+#endif
       }
       // Reduce `accumulator` by addition.
       const float32x2_t tmp =
@@ -104,6 +111,8 @@ class VectorMath {
  private:
   float DotProductAvx2(rtc::ArrayView<const float> x,
                        rtc::ArrayView<const float> y) const;
+  float DotProductAvx512(rtc::ArrayView<const float> x,
+                         rtc::ArrayView<const float> y) const;
 
   const AvailableCpuFeatures cpu_features_;
 };
@@ -46,6 +46,10 @@ std::vector<AvailableCpuFeatures> GetCpuFeaturesToTest() {
   std::vector<AvailableCpuFeatures> v;
   v.push_back({/*sse2=*/false, /*avx2=*/false, /*neon=*/false});
   AvailableCpuFeatures available = GetAvailableCpuFeatures();
+  if (available.avx512) {
+    v.push_back({/*sse2=*/false, /*avx2=*/false, /*neon=*/false,
+                 /*avx512=*/true});
+  }
   if (available.avx2) {
     v.push_back({/*sse2=*/false, /*avx2=*/true, /*neon=*/false});
   }
@@ -366,6 +366,12 @@ void AudioBuffer::MergeFrequencyBands() {
   splitting_filter_->Synthesis(split_data_.get(), data_.get());
 }
 
+void AudioBuffer::SetParallelProcessor(ParallelChannelProcessor* processor) {
+  if (splitting_filter_) {
+    splitting_filter_->SetParallelProcessor(processor);
+  }
+}
+
 void AudioBuffer::ExportSplitChannelData(
     size_t channel,
     int16_t* const* split_band_data) const {
@@ -22,6 +22,7 @@
 
 namespace webrtc {
 
+class ParallelChannelProcessor;
 class PushSincResampler;
 class SplittingFilter;
 
@@ -119,6 +120,10 @@ class AudioBuffer {
   // Recombines the frequency bands into a full-band signal.
   void MergeFrequencyBands();
 
+  // Splits and merges the channels in parallel on `processor`, if not null.
+  // It must outlive the buffer.
+  void SetParallelProcessor(ParallelChannelProcessor* processor);
+
   // Copies the split bands data into the integer two-dimensional array.
   void ExportSplitChannelData(size_t channel,
                               int16_t* const* split_band_data) const;
@@ -319,6 +319,21 @@ void SetDownmixMethod(AudioBuffer& buffer, DownmixMethod method) {
 
 constexpr int kUnspecifiedDataDumpInputVolume = -100;
 
+// Number of consecutive frames of digital silence after which the capture
+// processing is bypassed, which lets the filter states and gains settle first.
+constexpr int kNumDigitalSilenceFramesBeforeBypass = 50;
+
+bool IsDigitalSilence(const AudioBuffer& audio) {
+  for (size_t ch = 0; ch < audio.num_channels(); ++ch) {
+    const float* channel = audio.channels_const()[ch];
+    if (std::any_of(channel, channel + audio.num_frames(),
+                    [](float sample) { return sample != 0.f; })) {
+      return false;
+    }
+  }
+  return true;
+}
+
 }  // namespace
 
 // Throughout webrtc, it's assumed that success is represented by zero.
@@ -752,6 +767,17 @@ void AudioProcessingImpl::MaybeInitializeRender(
 void AudioProcessingImpl::InitializeLocked() {
   UpdateActiveSubmoduleStates();
 
+  const int num_processing_threads =
+      std::max(config_.pipeline.num_processing_threads, 1);
+  if (num_processing_threads == 1) {
+    parallel_channel_processor_.reset();
+  } else if (!parallel_channel_processor_ ||
+             parallel_channel_processor_->num_threads() !=
+                 num_processing_threads) {
+    parallel_channel_processor_ =
+        std::make_unique<ParallelChannelProcessor>(num_processing_threads);
+  }
+
   const int render_audiobuffer_sample_rate_hz =
       formats_.api_format.reverse_output_stream().num_frames() == 0
           ? formats_.render_processing_format.sample_rate_hz()
@@ -764,6 +790,8 @@ void AudioProcessingImpl::InitializeLocked() {
         formats_.render_processing_format.num_channels(),
         render_audiobuffer_sample_rate_hz,
         formats_.render_processing_format.num_channels()));
+    render_.render_audio->SetParallelProcessor(
+        parallel_channel_processor_.get());
     if (formats_.api_format.reverse_input_stream() !=
         formats_.api_format.reverse_output_stream()) {
       render_.render_converter = AudioConverter::Create(
@@ -788,6 +816,8 @@ void AudioProcessingImpl::InitializeLocked() {
       formats_.api_format.output_stream().num_channels()));
   SetDownmixMethod(*capture_.capture_audio,
                    config_.pipeline.capture_downmix_method);
+  capture_.capture_audio->SetParallelProcessor(
+      parallel_channel_processor_.get());
 
   if (capture_nonlocked_.capture_processing_format.sample_rate_hz() <
           formats_.api_format.output_stream().sample_rate_hz() &&
@@ -921,7 +951,9 @@ void AudioProcessingImpl::ApplyConfig(const AudioProcessing::Config& config) {
       config_.pipeline.maximum_internal_processing_rate !=
           adjusted_config.pipeline.maximum_internal_processing_rate ||
       config_.pipeline.capture_downmix_method !=
-          adjusted_config.pipeline.capture_downmix_method;
+          adjusted_config.pipeline.capture_downmix_method ||
+      config_.pipeline.num_processing_threads !=
+          adjusted_config.pipeline.num_processing_threads;
 
   const bool aec_config_changed =
       config_.echo_canceller.enabled !=
@@ -1052,8 +1084,11 @@ void AudioProcessingImpl::set_output_will_be_muted(bool muted) {
 
 void AudioProcessingImpl::HandleCaptureOutputUsedSetting(
     bool capture_output_used) {
+  capture_.capture_output_used_setting = capture_output_used;
   capture_.capture_output_used =
-      capture_output_used || !constants_.minimize_processing_for_unused_output;
+      (capture_output_used ||
+       !constants_.minimize_processing_for_unused_output) &&
+      !capture_.digital_silence_bypass;
 
   if (submodules_.agc_manager.get()) {
     submodules_.agc_manager->HandleCaptureOutputUsedChange(
@@ -1073,6 +1108,24 @@ void AudioProcessingImpl::HandleCaptureOutputUsedSetting(
   }
 }
 
+void AudioProcessingImpl::UpdateDigitalSilenceBypassLocked() {
+  if (!config_.pipeline.bypass_processing_on_digital_silence) {
+    capture_.num_digital_silence_frames = 0;
+  } else if (IsDigitalSilence(*capture_.capture_audio)) {
+    capture_.num_digital_silence_frames =
+        std::min(capture_.num_digital_silence_frames + 1,
+                 kNumDigitalSilenceFramesBeforeBypass);
+  } else {
+    capture_.num_digital_silence_frames = 0;
+  }
+  const bool bypass = capture_.num_digital_silence_frames ==
+                      kNumDigitalSilenceFramesBeforeBypass;
+  if (bypass != capture_.digital_silence_bypass) {
+    capture_.digital_silence_bypass = bypass;
+    HandleCaptureOutputUsedSetting(capture_.capture_output_used_setting);
+  }
+}
+
 void AudioProcessingImpl::SetRuntimeSetting(RuntimeSetting setting) {
   PostRuntimeSetting(setting);
 }
@@ -1498,6 +1551,7 @@ int AudioProcessingImpl::ProcessStream(const int16_t* const src,
 int AudioProcessingImpl::ProcessCaptureStreamLocked() {
   EmptyQueuedRenderAudioLocked();
   HandleCaptureRuntimeSettings();
+  UpdateDigitalSilenceBypassLocked();
   DenormalDisabler denormal_disabler;
 
   // Ensure that not both the AEC and AECM are active at the same time.
@@ -1807,6 +1861,16 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
     }
   }
 
+  // The input is silent while bypassing, but the echo canceller output is
+  // not.
+  if (capture_.digital_silence_bypass) {
+    for (size_t ch = 0; ch < capture_buffer->num_channels(); ++ch) {
+      rtc::ArrayView<float> channel_view(capture_buffer->channels()[ch],
+                                         capture_buffer->num_frames());
+      std::fill(channel_view.begin(), channel_view.end(), 0.f);
+    }
+  }
+
   // Temporarily set the output to zero after the stream has been unmuted
   // (capture output is again used). The purpose of this is to avoid clicks and
   // artefacts in the audio that results when the processing again is
@@ -2430,6 +2494,8 @@ void AudioProcessingImpl::InitializeNoiseSuppressor() {
     cfg.target_level = map_level(config_.noise_suppression.level);
     submodules_.noise_suppressor = std::make_unique<NoiseSuppressor>(
         cfg, proc_sample_rate_hz(), num_proc_channels());
+    submodules_.noise_suppressor->SetParallelProcessor(
+        parallel_channel_processor_.get());
   }
 }
 
@@ -2612,6 +2678,9 @@ AudioProcessingImpl::ApmCaptureState::ApmCaptureState()
     : was_stream_delay_set(false),
       capture_output_used(true),
       capture_output_used_last_frame(true),
+      capture_output_used_setting(true),
+      num_digital_silence_frames(0),
+      digital_silence_bypass(false),
       key_pressed(false),
       capture_processing_format(kSampleRate16kHz),
       split_rate(kSampleRate16kHz),
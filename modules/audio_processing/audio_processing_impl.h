@@ -44,6 +44,7 @@
 #include "modules/audio_processing/render_queue_item_verifier.h"
 #include "modules/audio_processing/rms_level.h"
 #include "modules/audio_processing/transient/transient_suppressor.h"
+#include "modules/audio_processing/utility/parallel_channel_processor.h"
 #include "rtc_base/gtest_prod_util.h"
 #include "rtc_base/swap_queue.h"
 #include "rtc_base/synchronization/mutex.h"
@@ -102,6 +103,10 @@ class AudioProcessingImpl : public AudioProcessing {
   void set_output_will_be_muted(bool muted) override;
   void HandleCaptureOutputUsedSetting(bool capture_output_used)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_capture_);
+  // Counts the frames of digital silence in the capture input and starts or
+  // stops bypassing the capture processing accordingly.
+  void UpdateDigitalSilenceBypassLocked()
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_capture_);
   int set_stream_delay_ms(int delay) override;
   void set_stream_key_pressed(bool key_pressed) override;
   void set_stream_analog_level(int level) override;
@@ -433,6 +438,10 @@ class AudioProcessingImpl : public AudioProcessing {
   // Class containing information about what submodules are active.
   SubmoduleStates submodule_states_;
 
+  // Threads on which the channels are processed in parallel, if more than one
+  // is configured. Shared by the render and the capture side.
+  std::unique_ptr<ParallelChannelProcessor> parallel_channel_processor_;
+
   // Struct containing the pointers to the submodules.
   struct Submodules {
     Submodules(std::unique_ptr<CustomProcessing> capture_post_processor,
@@ -503,6 +512,12 @@ class AudioProcessingImpl : public AudioProcessing {
     bool was_stream_delay_set;
     bool capture_output_used;
     bool capture_output_used_last_frame;
+    // Last capture output usage set through the API.
+    bool capture_output_used_setting;
+    // Number of consecutive frames of digital silence, up to the number
+    // needed to bypass the processing.
+    int num_digital_silence_frames;
+    bool digital_silence_bypass;
     bool key_pressed;
     std::unique_ptr<AudioBuffer> capture_audio;
     std::unique_ptr<AudioBuffer> capture_fullband_audio;
@@ -378,6 +378,56 @@ TEST(AudioProcessingImplTest, EchoControllerObservesSetCaptureUsageChange) {
   apm->ProcessStream(frame.data(), config, config, frame.data());
 }
 
+TEST(AudioProcessingImplTest, BypassesProcessingOnDigitalSilence) {
+  // Tests that the capture output is treated as unused after enough frames of
+  // digital silence, and as used again on the first frame that is not silent.
+  auto echo_control_factory = std::make_unique<MockEchoControlFactory>();
+  const MockEchoControlFactory* echo_control_factory_ptr =
+      echo_control_factory.get();
+
+  AudioProcessing::Config apm_config;
+  apm_config.pipeline.bypass_processing_on_digital_silence = true;
+  rtc::scoped_refptr<AudioProcessing> apm =
+      AudioProcessingBuilderForTesting()
+          .SetConfig(apm_config)
+          .SetEchoControlFactory(std::move(echo_control_factory))
+          .Create();
+
+  constexpr int kSampleRateHz = 48000;
+  constexpr int kNumChannels = 2;
+  constexpr int kNumFramesBeforeBypass = 50;
+  std::array<int16_t, kNumChannels * kSampleRateHz / 100> frame;
+  StreamConfig config(kSampleRateHz, kNumChannels);
+
+  MockEchoControl* echo_control_mock = echo_control_factory_ptr->GetNext();
+
+  frame.fill(0);
+  EXPECT_CALL(*echo_control_mock, SetCaptureOutputUsage(testing::_)).Times(0);
+  for (int i = 0; i < kNumFramesBeforeBypass - 1; ++i) {
+    apm->ProcessStream(frame.data(), config, config, frame.data());
+  }
+  testing::Mock::VerifyAndClearExpectations(echo_control_mock);
+
+  // The echo controller keeps being fed while bypassing.
+  EXPECT_CALL(*echo_control_mock,
+              SetCaptureOutputUsage(/*capture_output_used=*/false))
+      .Times(1);
+  EXPECT_CALL(*echo_control_mock, ProcessCapture(testing::_, testing::_,
+                                                 testing::_))
+      .Times(10);
+  for (int i = 0; i < 10; ++i) {
+    apm->ProcessStream(frame.data(), config, config, frame.data());
+    EXPECT_EQ(frame[100], 0);
+  }
+  testing::Mock::VerifyAndClearExpectations(echo_control_mock);
+
+  EXPECT_CALL(*echo_control_mock,
+              SetCaptureOutputUsage(/*capture_output_used=*/true))
+      .Times(1);
+  frame.fill(1000);
+  apm->ProcessStream(frame.data(), config, config, frame.data());
+}
+
 TEST(AudioProcessingImplTest,
      EchoControllerObservesPreAmplifierEchoPathGainChange) {
   // Tests that the echo controller observes an echo path gain change when the
@@ -691,6 +741,65 @@ TEST(AudioProcessingImplTest, RenderPreProcessorBeforeEchoDetector) {
             test_echo_detector->last_render_audio_first_sample());
 }
 
+// Processing the channels on multiple threads should be bit-exact with
+// processing them on the calling thread.
+TEST(AudioProcessingImplTest, BitexactWithMultipleProcessingThreads) {
+  AudioProcessing::Config apm_config;
+  apm_config.pipeline.multi_channel_render = true;
+  apm_config.pipeline.multi_channel_capture = true;
+  apm_config.high_pass_filter.enabled = true;
+  apm_config.noise_suppression.enabled = true;
+  rtc::scoped_refptr<AudioProcessing> apm_reference =
+      AudioProcessingBuilderForTesting().Create();
+  apm_reference->ApplyConfig(apm_config);
+  apm_config.pipeline.num_processing_threads = 4;
+  rtc::scoped_refptr<AudioProcessing> apm =
+      AudioProcessingBuilderForTesting().Create();
+  apm->ApplyConfig(apm_config);
+
+  constexpr int kSampleRateHz = 48000;
+  constexpr int kNumChannels = 4;
+  constexpr int kNumFrames = kSampleRateHz / 100;
+  std::array<std::array<float, kNumFrames>, kNumChannels> buffer;
+  std::array<std::array<float, kNumFrames>, kNumChannels> buffer_reference;
+  std::array<float*, kNumChannels> channel_pointers;
+  std::array<float*, kNumChannels> channel_pointers_reference;
+  for (int ch = 0; ch < kNumChannels; ++ch) {
+    channel_pointers[ch] = buffer[ch].data();
+    channel_pointers_reference[ch] = buffer_reference[ch].data();
+  }
+  StreamConfig stream_config(kSampleRateHz, kNumChannels);
+  Random random_generator(2341U);
+
+  for (int i = 0; i < 100; ++i) {
+    for (int ch = 0; ch < kNumChannels; ++ch) {
+      RandomizeSampleVector(&random_generator, buffer[ch]);
+      buffer_reference[ch] = buffer[ch];
+    }
+    ASSERT_EQ(apm->ProcessReverseStream(channel_pointers.data(), stream_config,
+                                        stream_config, channel_pointers.data()),
+              kNoErr);
+    ASSERT_EQ(apm_reference->ProcessReverseStream(
+                  channel_pointers_reference.data(), stream_config,
+                  stream_config, channel_pointers_reference.data()),
+              kNoErr);
+    EXPECT_EQ(buffer, buffer_reference);
+
+    for (int ch = 0; ch < kNumChannels; ++ch) {
+      RandomizeSampleVector(&random_generator, buffer[ch]);
+      buffer_reference[ch] = buffer[ch];
+    }
+    ASSERT_EQ(apm->ProcessStream(channel_pointers.data(), stream_config,
+                                 stream_config, channel_pointers.data()),
+              kNoErr);
+    ASSERT_EQ(apm_reference->ProcessStream(channel_pointers_reference.data(),
+                                           stream_config, stream_config,
+                                           channel_pointers_reference.data()),
+              kNoErr);
+    EXPECT_EQ(buffer, buffer_reference);
+  }
+}
+
 // Disabling build-optional submodules and trying to enable them via the APM
 // config should be bit-exact with running APM with said submodules disabled.
 // This mainly tests that SetCreateOptionalSubmodulesForTesting has an effect.
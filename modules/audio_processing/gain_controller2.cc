@@ -44,6 +44,9 @@ AvailableCpuFeatures GetAllowedCpuFeatures() {
   if (field_trial::IsEnabled("WebRTC-Agc2SimdAvx2KillSwitch")) {
     features.avx2 = false;
   }
+  if (field_trial::IsEnabled("WebRTC-Agc2SimdAvx512KillSwitch")) {
+    features.avx512 = false;
+  }
   if (field_trial::IsEnabled("WebRTC-Agc2SimdNeonKillSwitch")) {
     features.neon = false;
   }
@@ -161,6 +161,17 @@ class RTC_EXPORT AudioProcessing : public RefCountInterface {
       // Indicates how to downmix multi-channel capture audio to mono (when
       // needed).
       DownmixMethod capture_downmix_method = DownmixMethod::kAverageChannels;
+      // Number of threads used for the processing stages that handle the
+      // channels independently (band splitting and noise suppression). Only
+      // has an effect on multi-channel audio, and the output does not depend
+      // on it.
+      int num_processing_threads = 1;
+      // Skips the processing that only affects the capture output while the
+      // capture signal has been digital silence for a while, e.g. from a
+      // hardware-muted microphone, as if the output were unused. The output
+      // is kept silent, and the echo canceller keeps following the render
+      // signal so that it stays converged.
+      bool bypass_processing_on_digital_silence = false;
     } pipeline;
 
     // Enabled the pre-amplifier. It amplifies the capture signal
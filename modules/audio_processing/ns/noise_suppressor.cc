@@ -323,7 +323,7 @@ void NoiseSuppressor::Analyze(const AudioBuffer& audio) {
   }
 
   // Analyze all channels.
-  for (size_t ch = 0; ch < num_channels_; ++ch) {
+  ForEachChannel(parallel_processor_, num_channels_, [&](size_t ch) {
     std::unique_ptr<ChannelState>& ch_p = channels_[ch];
     rtc::ArrayView<const float, kNsFrameSize> y_band0(
         &audio.split_bands_const(ch)[0][0], kNsFrameSize);
@@ -336,7 +336,7 @@ void NoiseSuppressor::Analyze(const AudioBuffer& audio) {
     // Compute the magnitude spectrum.
     std::array<float, kFftSize> real;
     std::array<float, kFftSize> imag;
-    fft_.Fft(extended_frame, real, imag);
+    ch_p->fft.Fft(extended_frame, real, imag);
 
     std::array<float, kFftSizeBy2Plus1> signal_spectrum;
     ComputeMagnitudeSpectrum(real, imag, signal_spectrum);
@@ -377,7 +377,7 @@ void NoiseSuppressor::Analyze(const AudioBuffer& audio) {
     // method.
     std::copy(signal_spectrum.begin(), signal_spectrum.end(),
               ch_p->prev_analysis_signal_spectrum.begin());
-  }
+  });
 }
 
 void NoiseSuppressor::Process(AudioBuffer* audio) {
@@ -408,7 +408,7 @@ void NoiseSuppressor::Process(AudioBuffer* audio) {
   }
 
   // Compute the suppression filters for all channels.
-  for (size_t ch = 0; ch < num_channels_; ++ch) {
+  ForEachChannel(parallel_processor_, num_channels_, [&](size_t ch) {
     // Form an extended frame and apply analysis filter bank windowing.
     rtc::ArrayView<float, kNsFrameSize> y_band0(&audio->split_bands(ch)[0][0],
                                                 kNsFrameSize);
@@ -422,8 +422,9 @@ void NoiseSuppressor::Process(AudioBuffer* audio) {
         ComputeEnergyOfExtendedFrame(filter_bank_states[ch].extended_frame);
 
     // Perform filter bank analysis and compute the magnitude spectrum.
-    fft_.Fft(filter_bank_states[ch].extended_frame, filter_bank_states[ch].real,
-             filter_bank_states[ch].imag);
+    channels_[ch]->fft.Fft(filter_bank_states[ch].extended_frame,
+                           filter_bank_states[ch].real,
+                           filter_bank_states[ch].imag);
 
     std::array<float, kFftSizeBy2Plus1> signal_spectrum;
     ComputeMagnitudeSpectrum(filter_bank_states[ch].real,
@@ -447,7 +448,7 @@ void NoiseSuppressor::Process(AudioBuffer* audio) {
           channels_[ch]->speech_probability_estimator.get_probability(),
           channels_[ch]->prev_analysis_signal_spectrum, signal_spectrum);
     }
-  }
+  });
 
   // Only do the below processing if the output of the audio processing module
   // is used.
@@ -464,21 +465,18 @@ void NoiseSuppressor::Process(AudioBuffer* audio) {
     AggregateWienerFilters(filter_data);
   }
 
-  for (size_t ch = 0; ch < num_channels_; ++ch) {
+  ForEachChannel(parallel_processor_, num_channels_, [&](size_t ch) {
     // Apply the filter to the lower band.
     for (size_t i = 0; i < kFftSizeBy2Plus1; ++i) {
       filter_bank_states[ch].real[i] *= filter[i];
       filter_bank_states[ch].imag[i] *= filter[i];
     }
-  }
 
-  // Perform filter bank synthesis
-  for (size_t ch = 0; ch < num_channels_; ++ch) {
-    fft_.Ifft(filter_bank_states[ch].real, filter_bank_states[ch].imag,
-              filter_bank_states[ch].extended_frame);
-  }
+    // Perform filter bank synthesis
+    channels_[ch]->fft.Ifft(filter_bank_states[ch].real,
+                            filter_bank_states[ch].imag,
+                            filter_bank_states[ch].extended_frame);
 
-  for (size_t ch = 0; ch < num_channels_; ++ch) {
     const float energy_after_filtering =
         ComputeEnergyOfExtendedFrame(filter_bank_states[ch].extended_frame);
 
@@ -492,7 +490,7 @@ void NoiseSuppressor::Process(AudioBuffer* audio) {
             num_analyzed_frames_,
             channels_[ch]->speech_probability_estimator.get_prior_probability(),
             energies_before_filtering[ch], energy_after_filtering);
-  }
+  });
 
   // Select and apply adjustment of the noise attenuation filter based on the
   // effect of the attenuation.
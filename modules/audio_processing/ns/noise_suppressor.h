@@ -22,6 +22,7 @@
 #include "modules/audio_processing/ns/ns_fft.h"
 #include "modules/audio_processing/ns/speech_probability_estimator.h"
 #include "modules/audio_processing/ns/wiener_filter.h"
+#include "modules/audio_processing/utility/parallel_channel_processor.h"
 
 namespace webrtc {
 
@@ -49,13 +50,19 @@ class NoiseSuppressor {
     capture_output_used_ = capture_output_used;
   }
 
+  // Analyzes and filters the channels in parallel on `processor`, if not null.
+  // It must outlive the noise suppressor.
+  void SetParallelProcessor(ParallelChannelProcessor* processor) {
+    parallel_processor_ = processor;
+  }
+
  private:
   const size_t num_bands_;
   const size_t num_channels_;
   const SuppressionParams suppression_params_;
   int32_t num_analyzed_frames_ = -1;
-  NrFft fft_;
   bool capture_output_used_ = true;
+  ParallelChannelProcessor* parallel_processor_ = nullptr;
 
   struct ChannelState {
     ChannelState(const SuppressionParams& suppression_params, size_t num_bands);
@@ -63,6 +70,8 @@ class NoiseSuppressor {
     SpeechProbabilityEstimator speech_probability_estimator;
     WienerFilter wiener_filter;
     NoiseEstimator noise_estimator;
+    // Per channel, as the transform uses its tables as scratch memory.
+    NrFft fft;
     std::array<float, kFftSizeBy2Plus1> prev_analysis_signal_spectrum;
     std::array<float, kFftSize - kNsFrameSize> analyze_analysis_memory;
     std::array<float, kOverlapSize> process_analysis_memory;
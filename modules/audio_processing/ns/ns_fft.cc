@@ -10,11 +10,31 @@
 
 #include "modules/audio_processing/ns/ns_fft.h"
 
+#include <algorithm>
+
 #include "common_audio/third_party/ooura/fft_size_256/fft4g.h"
+#include "system_wrappers/include/field_trial.h"
 
 namespace webrtc {
+namespace {
+
+NrFft::Backend DefaultBackend() {
+  return field_trial::IsEnabled("WebRTC-NsPffftFft") && Pffft::IsSimdEnabled()
+             ? NrFft::Backend::kPffft
+             : NrFft::Backend::kOoura;
+}
+
+}  // namespace
+
+NrFft::NrFft() : NrFft(DefaultBackend()) {}
 
-NrFft::NrFft() : bit_reversal_state_(kFftSize / 2), tables_(kFftSize / 2) {
+NrFft::NrFft(Backend backend)
+    : bit_reversal_state_(kFftSize / 2),
+      tables_(kFftSize / 2),
+      pffft_(backend == Backend::kPffft
+                 ? std::make_unique<Pffft>(kFftSize, Pffft::FftType::kReal)
+                 : nullptr),
+      pffft_buffer_(pffft_ ? pffft_->CreateBuffer() : nullptr) {
   // Initialize WebRtc_rdt (setting (bit_reversal_state_[0] to 0 triggers
   // initialization)
   bit_reversal_state_[0] = 0.f;
@@ -27,8 +47,21 @@ NrFft::NrFft() : bit_reversal_state_(kFftSize / 2), tables_(kFftSize / 2) {
 void NrFft::Fft(rtc::ArrayView<float, kFftSize> time_data,
                 rtc::ArrayView<float, kFftSize> real,
                 rtc::ArrayView<float, kFftSize> imag) {
-  WebRtc_rdft(kFftSize, 1, time_data.data(), bit_reversal_state_.data(),
-              tables_.data());
+  if (pffft_) {
+    // PFFFT uses the same packing as Ooura, but the opposite sign for the
+    // imaginary parts.
+    rtc::ArrayView<float> buffer = pffft_buffer_->GetView();
+    std::copy(time_data.begin(), time_data.end(), buffer.begin());
+    pffft_->ForwardTransform(*pffft_buffer_, pffft_buffer_.get(),
+                             /*ordered=*/true);
+    std::copy(buffer.begin(), buffer.end(), time_data.begin());
+    for (size_t i = 3; i < kFftSize; i += 2) {
+      time_data[i] = -time_data[i];
+    }
+  } else {
+    WebRtc_rdft(kFftSize, 1, time_data.data(), bit_reversal_state_.data(),
+                tables_.data());
+  }
 
   imag[0] = 0;
   real[0] = time_data[0];
@@ -51,6 +84,22 @@ void NrFft::Ifft(rtc::ArrayView<const float> real,
     time_data[2 * i] = real[i];
     time_data[2 * i + 1] = imag[i];
   }
+
+  if (pffft_) {
+    rtc::ArrayView<float> buffer = pffft_buffer_->GetView();
+    std::copy(time_data.begin(), time_data.end(), buffer.begin());
+    for (size_t i = 3; i < kFftSize; i += 2) {
+      buffer[i] = -buffer[i];
+    }
+    pffft_->BackwardTransform(*pffft_buffer_, pffft_buffer_.get(),
+                              /*ordered=*/true);
+    // Unlike Ooura, PFFFT scales the output by kFftSize.
+    constexpr float kScaling = 1.f / kFftSize;
+    std::transform(buffer.begin(), buffer.end(), time_data.begin(),
+                   [](float d) { return d * kScaling; });
+    return;
+  }
+
   WebRtc_rdft(kFftSize, -1, time_data.data(), bit_reversal_state_.data(),
               tables_.data());
 
@@ -11,17 +11,25 @@
 #ifndef MODULES_AUDIO_PROCESSING_NS_NS_FFT_H_
 #define MODULES_AUDIO_PROCESSING_NS_NS_FFT_H_
 
+#include <memory>
 #include <vector>
 
 #include "api/array_view.h"
 #include "modules/audio_processing/ns/ns_common.h"
+#include "modules/audio_processing/utility/pffft_wrapper.h"
 
 namespace webrtc {
 
 // Wrapper class providing 256 point FFT functionality.
 class NrFft {
  public:
+  // FFT implementation. Both give the same output up to rounding errors.
+  enum class Backend { kOoura, kPffft };
+
+  // Uses the PFFFT backend if the "WebRTC-NsPffftFft" field trial is enabled
+  // and PFFFT can use SIMD instructions, and Ooura otherwise.
   NrFft();
+  explicit NrFft(Backend backend);
   NrFft(const NrFft&) = delete;
   NrFft& operator=(const NrFft&) = delete;
 
@@ -38,6 +46,9 @@ class NrFft {
  private:
   std::vector<size_t> bit_reversal_state_;
   std::vector<float> tables_;
+  // Null unless the PFFFT backend is used.
+  const std::unique_ptr<Pffft> pffft_;
+  const std::unique_ptr<Pffft::FloatBuffer> pffft_buffer_;
 };
 
 }  // namespace webrtc
@@ -12,8 +12,8 @@
 
 #include <algorithm>
 #include <cmath>
-#include <numeric>
 
+#include "common_audio/signal_level.h"
 #include "rtc_base/checks.h"
 
 namespace webrtc {
@@ -65,9 +65,7 @@ void RmsLevel::Analyze(rtc::ArrayView<const int16_t> data) {
   CheckBlockSize(data.size());
 
   const float sum_square =
-      std::accumulate(data.begin(), data.end(), 0.f,
-                      [](float a, int16_t b) { return a + b * b; });
-  RTC_DCHECK_GE(sum_square, 0.f);
+      static_cast<float>(SumOfSquaresS16(data.data(), data.size()));
   sum_square_ += sum_square;
   sample_count_ += data.size();
 
@@ -81,14 +79,8 @@ void RmsLevel::Analyze(rtc::ArrayView<const float> data) {
 
   CheckBlockSize(data.size());
 
-  float sum_square = 0.f;
-
-  for (float data_k : data) {
-    int16_t tmp =
-        static_cast<int16_t>(std::min(std::max(data_k, -32768.f), 32767.f));
-    sum_square += tmp * tmp;
-  }
-  RTC_DCHECK_GE(sum_square, 0.f);
+  const float sum_square =
+      static_cast<float>(SumOfSquaresFloatS16(data.data(), data.size()));
   sum_square_ += sum_square;
   sample_count_ += data.size();
 
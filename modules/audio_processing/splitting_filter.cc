@@ -67,7 +67,7 @@ void SplittingFilter::TwoBandsAnalysis(const ChannelBuffer<float>* data,
   RTC_DCHECK_EQ(two_bands_states_.size(), data->num_channels());
   RTC_DCHECK_EQ(data->num_frames(), kTwoBandFilterSamplesPerFrame);
 
-  for (size_t i = 0; i < two_bands_states_.size(); ++i) {
+  ForEachChannel(parallel_processor_, two_bands_states_.size(), [&](size_t i) {
     std::array<std::array<int16_t, kSamplesPerBand>, 2> bands16;
     std::array<int16_t, kTwoBandFilterSamplesPerFrame> full_band16;
     FloatS16ToS16(data->channels(0)[i], full_band16.size(), full_band16.data());
@@ -77,14 +77,14 @@ void SplittingFilter::TwoBandsAnalysis(const ChannelBuffer<float>* data,
                           two_bands_states_[i].analysis_state2);
     S16ToFloatS16(bands16[0].data(), bands16[0].size(), bands->channels(0)[i]);
     S16ToFloatS16(bands16[1].data(), bands16[1].size(), bands->channels(1)[i]);
-  }
+  });
 }
 
 void SplittingFilter::TwoBandsSynthesis(const ChannelBuffer<float>* bands,
                                         ChannelBuffer<float>* data) {
   RTC_DCHECK_LE(data->num_channels(), two_bands_states_.size());
   RTC_DCHECK_EQ(data->num_frames(), kTwoBandFilterSamplesPerFrame);
-  for (size_t i = 0; i < data->num_channels(); ++i) {
+  ForEachChannel(parallel_processor_, data->num_channels(), [&](size_t i) {
     std::array<std::array<int16_t, kSamplesPerBand>, 2> bands16;
     std::array<int16_t, kTwoBandFilterSamplesPerFrame> full_band16;
     FloatS16ToS16(bands->channels(0)[i], bands16[0].size(), bands16[0].data());
@@ -94,7 +94,7 @@ void SplittingFilter::TwoBandsSynthesis(const ChannelBuffer<float>* bands,
                            two_bands_states_[i].synthesis_state1,
                            two_bands_states_[i].synthesis_state2);
     S16ToFloatS16(full_band16.data(), full_band16.size(), data->channels(0)[i]);
-  }
+  });
 }
 
 void SplittingFilter::ThreeBandsAnalysis(const ChannelBuffer<float>* data,
@@ -108,15 +108,16 @@ void SplittingFilter::ThreeBandsAnalysis(const ChannelBuffer<float>* data,
   RTC_DCHECK_EQ(bands->num_frames_per_band(),
                 ThreeBandFilterBank::kSplitBandSize);
 
-  for (size_t i = 0; i < three_band_filter_banks_.size(); ++i) {
-    three_band_filter_banks_[i].Analysis(
-        rtc::ArrayView<const float, ThreeBandFilterBank::kFullBandSize>(
-            data->channels_view()[i].data(),
-            ThreeBandFilterBank::kFullBandSize),
-        rtc::ArrayView<const rtc::ArrayView<float>,
-                       ThreeBandFilterBank::kNumBands>(
-            bands->bands_view(i).data(), ThreeBandFilterBank::kNumBands));
-  }
+  ForEachChannel(
+      parallel_processor_, three_band_filter_banks_.size(), [&](size_t i) {
+        three_band_filter_banks_[i].Analysis(
+            rtc::ArrayView<const float, ThreeBandFilterBank::kFullBandSize>(
+                data->channels_view()[i].data(),
+                ThreeBandFilterBank::kFullBandSize),
+            rtc::ArrayView<const rtc::ArrayView<float>,
+                           ThreeBandFilterBank::kNumBands>(
+                bands->bands_view(i).data(), ThreeBandFilterBank::kNumBands));
+      });
 }
 
 void SplittingFilter::ThreeBandsSynthesis(const ChannelBuffer<float>* bands,
@@ -130,7 +131,7 @@ void SplittingFilter::ThreeBandsSynthesis(const ChannelBuffer<float>* bands,
   RTC_DCHECK_EQ(bands->num_frames_per_band(),
                 ThreeBandFilterBank::kSplitBandSize);
 
-  for (size_t i = 0; i < data->num_channels(); ++i) {
+  ForEachChannel(parallel_processor_, data->num_channels(), [&](size_t i) {
     three_band_filter_banks_[i].Synthesis(
         rtc::ArrayView<const rtc::ArrayView<float>,
                        ThreeBandFilterBank::kNumBands>(
@@ -138,7 +139,7 @@ void SplittingFilter::ThreeBandsSynthesis(const ChannelBuffer<float>* bands,
         rtc::ArrayView<float, ThreeBandFilterBank::kFullBandSize>(
             data->channels_view()[i].data(),
             ThreeBandFilterBank::kFullBandSize));
-  }
+  });
 }
 
 }  // namespace webrtc
@@ -17,6 +17,7 @@
 
 #include "common_audio/channel_buffer.h"
 #include "modules/audio_processing/three_band_filter_bank.h"
+#include "modules/audio_processing/utility/parallel_channel_processor.h"
 
 namespace webrtc {
 
@@ -50,6 +51,12 @@ class SplittingFilter {
   void Analysis(const ChannelBuffer<float>* data, ChannelBuffer<float>* bands);
   void Synthesis(const ChannelBuffer<float>* bands, ChannelBuffer<float>* data);
 
+  // Filters the channels in parallel on `processor`, if not null. It must
+  // outlive the filter.
+  void SetParallelProcessor(ParallelChannelProcessor* processor) {
+    parallel_processor_ = processor;
+  }
+
  private:
   // Two-band analysis and synthesis work for 640 samples or less.
   void TwoBandsAnalysis(const ChannelBuffer<float>* data,
@@ -63,6 +70,7 @@ class SplittingFilter {
   void InitBuffers();
 
   const size_t num_bands_;
+  ParallelChannelProcessor* parallel_processor_ = nullptr;
   std::vector<TwoBandsStates> two_bands_states_;
   std::vector<ThreeBandFilterBank> three_band_filter_banks_;
 };
@@ -0,0 +1,345 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Benchmarks of AudioProcessing and of the submodules it runs on the capture
+// path. Every iteration processes one 10 ms frame, so the reported times are
+// per 10 ms frame. The submodules are driven the way AudioProcessingImpl
+// drives them, on seeded noise whose echo is mixed into the capture signal.
+//
+// The arguments of every benchmark are the sample rate and the number of
+// channels.
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/array_view.h"
+#include "api/audio/echo_canceller3_config.h"
+#include "api/scoped_refptr.h"
+#include "benchmark/benchmark.h"
+#include "modules/audio_processing/aec3/echo_canceller3.h"
+#include "modules/audio_processing/agc2/input_volume_controller.h"
+#include "modules/audio_processing/audio_buffer.h"
+#include "modules/audio_processing/gain_controller2.h"
+#include "modules/audio_processing/high_pass_filter.h"
+#include "modules/audio_processing/include/audio_processing.h"
+#include "modules/audio_processing/ns/noise_suppressor.h"
+#include "modules/audio_processing/test/audio_processing_builder_for_testing.h"
+#include "modules/audio_processing/three_band_filter_bank.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/random.h"
+#include "rtc_base/system/unused.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kNumSignalFrames = 100;
+constexpr float kEchoGain = 0.3f;
+constexpr float kNearEndGain = 0.05f;
+
+// One second of render and capture signal, repeated as needed.
+class TestSignal {
+ public:
+  TestSignal(int sample_rate_hz, int num_channels)
+      : stream_config_(sample_rate_hz, num_channels),
+        render_(num_channels),
+        capture_(num_channels) {
+    // Fixed seed, so that every run benchmarks the same signal.
+    Random random(0x5eed);
+    const size_t num_samples = kNumSignalFrames * stream_config_.num_frames();
+    for (int ch = 0; ch < num_channels; ++ch) {
+      render_[ch].resize(num_samples);
+      capture_[ch].resize(num_samples);
+      for (size_t i = 0; i < num_samples; ++i) {
+        render_[ch][i] = random.Rand<float>() - 0.5f;
+        capture_[ch][i] = kEchoGain * render_[ch][i] +
+                          kNearEndGain * (random.Rand<float>() - 0.5f);
+      }
+    }
+  }
+
+  const StreamConfig& stream_config() const { return stream_config_; }
+
+  // Return the channel pointers of the next 10 ms of the signals. The render
+  // frame has to be taken before the capture frame of the same 10 ms.
+  std::vector<const float*> NextRender() { return Frame(render_); }
+  std::vector<const float*> NextCapture() {
+    std::vector<const float*> channels = Frame(capture_);
+    frame_index_ = (frame_index_ + 1) % kNumSignalFrames;
+    return channels;
+  }
+
+ private:
+  std::vector<const float*> Frame(
+      const std::vector<std::vector<float>>& data) const {
+    std::vector<const float*> channels;
+    for (const std::vector<float>& channel : data) {
+      channels.push_back(channel.data() +
+                         frame_index_ * stream_config_.num_frames());
+    }
+    return channels;
+  }
+
+  const StreamConfig stream_config_;
+  std::vector<std::vector<float>> render_;
+  std::vector<std::vector<float>> capture_;
+  int frame_index_ = 0;
+};
+
+std::unique_ptr<AudioBuffer> CreateAudioBuffer(const StreamConfig& config) {
+  return std::make_unique<AudioBuffer>(
+      config.sample_rate_hz(), config.num_channels(), config.sample_rate_hz(),
+      config.num_channels(), config.sample_rate_hz(), config.num_channels());
+}
+
+// Measures the time spent in the code between Start() and Stop(), such that
+// the benchmarks can exclude the preparation of their input.
+class ManualTimer {
+ public:
+  void Start() { start_ = std::chrono::steady_clock::now(); }
+  void Stop() { elapsed_ += std::chrono::steady_clock::now() - start_; }
+
+  // Reports the time measured in this iteration and resets the timer.
+  void SetIterationTime(benchmark::State& state) {
+    state.SetIterationTime(std::chrono::duration<double>(elapsed_).count());
+    elapsed_ = std::chrono::steady_clock::duration::zero();
+  }
+
+ private:
+  std::chrono::steady_clock::time_point start_;
+  std::chrono::steady_clock::duration elapsed_ =
+      std::chrono::steady_clock::duration::zero();
+};
+
+void BM_AudioProcessing(benchmark::State& state) {
+  TestSignal signal(state.range(0), state.range(1));
+  const StreamConfig& config = signal.stream_config();
+  AudioProcessing::Config apm_config;
+  apm_config.pipeline.multi_channel_render = true;
+  apm_config.pipeline.multi_channel_capture = true;
+  apm_config.high_pass_filter.enabled = true;
+  apm_config.echo_canceller.enabled = true;
+  apm_config.noise_suppression.enabled = true;
+  apm_config.gain_controller2.enabled = true;
+  apm_config.gain_controller2.adaptive_digital.enabled = true;
+  rtc::scoped_refptr<AudioProcessing> apm =
+      AudioProcessingBuilderForTesting().SetConfig(apm_config).Create();
+
+  std::vector<std::vector<float>> output(
+      config.num_channels(), std::vector<float>(config.num_frames()));
+  std::vector<float*> output_channels;
+  for (std::vector<float>& channel : output) {
+    output_channels.push_back(channel.data());
+  }
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    apm->ProcessReverseStream(signal.NextRender().data(), config, config,
+                              output_channels.data());
+    apm->set_stream_delay_ms(0);
+    apm->ProcessStream(signal.NextCapture().data(), config, config,
+                       output_channels.data());
+  }
+}
+
+void BM_HighPassFilter(benchmark::State& state) {
+  TestSignal signal(state.range(0), state.range(1));
+  const StreamConfig& config = signal.stream_config();
+  std::unique_ptr<AudioBuffer> audio = CreateAudioBuffer(config);
+  HighPassFilter high_pass_filter(config.sample_rate_hz(),
+                                  config.num_channels());
+  ManualTimer timer;
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    audio->CopyFrom(signal.NextCapture().data(), config);
+    timer.Start();
+    high_pass_filter.Process(audio.get(), /*use_split_band_data=*/false);
+    timer.Stop();
+    timer.SetIterationTime(state);
+  }
+}
+
+// Splits the capture signal into frequency bands and merges them again.
+void BM_SplittingFilter(benchmark::State& state) {
+  TestSignal signal(state.range(0), state.range(1));
+  const StreamConfig& config = signal.stream_config();
+  std::unique_ptr<AudioBuffer> audio = CreateAudioBuffer(config);
+  ManualTimer timer;
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    audio->CopyFrom(signal.NextCapture().data(), config);
+    timer.Start();
+    audio->SplitIntoFrequencyBands();
+    audio->MergeFrequencyBands();
+    timer.Stop();
+    timer.SetIterationTime(state);
+  }
+}
+
+// Splits one 48 kHz channel into three bands and merges them again. The
+// argument selects whether SIMD instructions may be used.
+void BM_ThreeBandFilterBank(benchmark::State& state) {
+  TestSignal signal(48000, 1);
+  ThreeBandFilterBank filter_bank(/*allow_simd=*/state.range(0) != 0);
+  std::array<std::array<float, ThreeBandFilterBank::kSplitBandSize>,
+             ThreeBandFilterBank::kNumBands>
+      bands;
+  std::array<rtc::ArrayView<float>, ThreeBandFilterBank::kNumBands>
+      band_views;
+  for (int band = 0; band < ThreeBandFilterBank::kNumBands; ++band) {
+    band_views[band] = bands[band];
+  }
+  std::array<float, ThreeBandFilterBank::kFullBandSize> output;
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    filter_bank.Analysis(
+        rtc::ArrayView<const float, ThreeBandFilterBank::kFullBandSize>(
+            signal.NextCapture()[0], ThreeBandFilterBank::kFullBandSize),
+        band_views);
+    filter_bank.Synthesis(band_views, output);
+  }
+}
+
+enum class Aec3Stage { kRenderAnalysis, kCaptureProcessing };
+
+// Runs AEC3 on both streams and measures one of its stages.
+void RunEchoCanceller3(benchmark::State& state, Aec3Stage stage) {
+  TestSignal signal(state.range(0), state.range(1));
+  const StreamConfig& config = signal.stream_config();
+  std::unique_ptr<AudioBuffer> render = CreateAudioBuffer(config);
+  std::unique_ptr<AudioBuffer> capture = CreateAudioBuffer(config);
+  EchoCanceller3 echo_canceller(EchoCanceller3Config(),
+                                /*multichannel_config=*/absl::nullopt,
+                                config.sample_rate_hz(), config.num_channels(),
+                                config.num_channels());
+  const bool split = config.sample_rate_hz() > 16000;
+  ManualTimer timer;
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    render->CopyFrom(signal.NextRender().data(), config);
+    if (split) {
+      render->SplitIntoFrequencyBands();
+    }
+    if (stage == Aec3Stage::kRenderAnalysis) {
+      timer.Start();
+    }
+    echo_canceller.AnalyzeRender(render.get());
+    if (stage == Aec3Stage::kRenderAnalysis) {
+      timer.Stop();
+    }
+
+    capture->CopyFrom(signal.NextCapture().data(), config);
+    if (stage == Aec3Stage::kCaptureProcessing) {
+      timer.Start();
+    }
+    echo_canceller.AnalyzeCapture(capture.get());
+    if (stage == Aec3Stage::kCaptureProcessing) {
+      timer.Stop();
+    }
+    if (split) {
+      capture->SplitIntoFrequencyBands();
+    }
+    if (stage == Aec3Stage::kCaptureProcessing) {
+      timer.Start();
+    }
+    echo_canceller.ProcessCapture(capture.get(), /*level_change=*/false);
+    if (stage == Aec3Stage::kCaptureProcessing) {
+      timer.Stop();
+    }
+    timer.SetIterationTime(state);
+  }
+}
+
+void BM_EchoCanceller3RenderAnalysis(benchmark::State& state) {
+  RunEchoCanceller3(state, Aec3Stage::kRenderAnalysis);
+}
+
+void BM_EchoCanceller3CaptureProcessing(benchmark::State& state) {
+  RunEchoCanceller3(state, Aec3Stage::kCaptureProcessing);
+}
+
+void BM_NoiseSuppressor(benchmark::State& state) {
+  TestSignal signal(state.range(0), state.range(1));
+  const StreamConfig& config = signal.stream_config();
+  std::unique_ptr<AudioBuffer> audio = CreateAudioBuffer(config);
+  NoiseSuppressor noise_suppressor(NsConfig(), config.sample_rate_hz(),
+                                   config.num_channels());
+  const bool split = config.sample_rate_hz() > 16000;
+  ManualTimer timer;
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    audio->CopyFrom(signal.NextCapture().data(), config);
+    if (split) {
+      audio->SplitIntoFrequencyBands();
+    }
+    timer.Start();
+    noise_suppressor.Analyze(*audio);
+    noise_suppressor.Process(audio.get());
+    timer.Stop();
+    timer.SetIterationTime(state);
+  }
+}
+
+void BM_GainController2(benchmark::State& state) {
+  TestSignal signal(state.range(0), state.range(1));
+  const StreamConfig& config = signal.stream_config();
+  std::unique_ptr<AudioBuffer> audio = CreateAudioBuffer(config);
+  AudioProcessing::Config::GainController2 agc2_config;
+  agc2_config.adaptive_digital.enabled = true;
+  GainController2 gain_controller(
+      agc2_config, InputVolumeController::Config(), config.sample_rate_hz(),
+      config.num_channels(), /*use_internal_vad=*/true);
+  ManualTimer timer;
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    audio->CopyFrom(signal.NextCapture().data(), config);
+    timer.Start();
+    gain_controller.Analyze(/*applied_input_volume=*/255, *audio);
+    gain_controller.Process(/*speech_probability=*/absl::nullopt,
+                            /*input_volume_changed=*/false, audio.get());
+    timer.Stop();
+    timer.SetIterationTime(state);
+  }
+}
+
+// Mono, stereo and multichannel at 48 kHz, and mono at the rates without
+// band splitting and with two bands.
+void SampleRatesAndChannels(benchmark::internal::Benchmark* benchmark) {
+  benchmark->ArgNames({"rate", "channels"})
+      ->Args({16000, 1})
+      ->Args({32000, 1})
+      ->Args({48000, 1})
+      ->Args({48000, 2})
+      ->Args({48000, 4});
+}
+
+BENCHMARK(BM_AudioProcessing)->Apply(SampleRatesAndChannels);
+BENCHMARK(BM_HighPassFilter)->Apply(SampleRatesAndChannels)->UseManualTime();
+BENCHMARK(BM_SplittingFilter)
+    ->ArgNames({"rate", "channels"})
+    ->Args({32000, 1})
+    ->Args({48000, 1})
+    ->Args({48000, 2})
+    ->Args({48000, 4})
+    ->UseManualTime();
+BENCHMARK(BM_ThreeBandFilterBank)->ArgName("simd")->Arg(0)->Arg(1);
+BENCHMARK(BM_EchoCanceller3RenderAnalysis)
+    ->Apply(SampleRatesAndChannels)
+    ->UseManualTime();
+BENCHMARK(BM_EchoCanceller3CaptureProcessing)
+    ->Apply(SampleRatesAndChannels)
+    ->UseManualTime();
+BENCHMARK(BM_NoiseSuppressor)->Apply(SampleRatesAndChannels)->UseManualTime();
+BENCHMARK(BM_GainController2)->Apply(SampleRatesAndChannels)->UseManualTime();
+
+}  // namespace
+}  // namespace webrtc
@@ -35,6 +35,15 @@
 #include <array>
 
 #include "rtc_base/checks.h"
+#include "rtc_base/system/arch.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#endif
 
 namespace webrtc {
 namespace {
@@ -100,9 +109,122 @@ const float kDctModulation[ThreeBandFilterBank::kNumNonZeroFilters][kDctSize] =
      {1.f, -2.f, 1.f},
      {1.73205077f, 0.f, -1.73205077f}};
 
+// The outputs of FilterCore() from this index on only depend on the current
+// input, and are computed in blocks of four.
+constexpr int kFilterTailStart = kFilterSize * kStride;
+static_assert((ThreeBandFilterBank::kSplitBandSize - kFilterTailStart) % 4 ==
+                  0,
+              "The filter tail must consist of whole blocks of four samples");
+static_assert(ThreeBandFilterBank::kSplitBandSize % 4 == 0,
+              "The subbands must consist of whole blocks of four samples");
+
+// Returns true if `FilterTailSimd()` and `MultiplyAccumulateSimd()` can be
+// used.
+bool SimdAvailable() {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  return GetCPUInfo(kSSE2) != 0;
+#elif defined(WEBRTC_HAS_NEON)
+  return true;
+#else
+  return false;
+#endif
+}
+
+// Computes the outputs of FilterCore() from `kFilterTailStart` on.
+void FilterTail(
+    rtc::ArrayView<const float, kFilterSize> filter,
+    rtc::ArrayView<const float, ThreeBandFilterBank::kSplitBandSize> in,
+    const int in_shift,
+    rtc::ArrayView<float, ThreeBandFilterBank::kSplitBandSize> out) {
+  for (int k = kFilterTailStart, shift = kFilterTailStart - in_shift;
+       k < ThreeBandFilterBank::kSplitBandSize; ++k, ++shift) {
+    for (int i = 0, j = shift; i < kFilterSize; ++i, j -= kStride) {
+      out[k] += in[j] * filter[i];
+    }
+  }
+}
+
+#if defined(WEBRTC_ARCH_X86_FAMILY) || defined(WEBRTC_HAS_NEON)
+// Same as FilterTail(), four outputs at a time. Each output is accumulated in
+// the same order.
+void FilterTailSimd(
+    rtc::ArrayView<const float, kFilterSize> filter,
+    rtc::ArrayView<const float, ThreeBandFilterBank::kSplitBandSize> in,
+    const int in_shift,
+    rtc::ArrayView<float, ThreeBandFilterBank::kSplitBandSize> out) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  const __m128 f0 = _mm_set1_ps(filter[0]);
+  const __m128 f1 = _mm_set1_ps(filter[1]);
+  const __m128 f2 = _mm_set1_ps(filter[2]);
+  const __m128 f3 = _mm_set1_ps(filter[3]);
+  for (int k = kFilterTailStart; k < ThreeBandFilterBank::kSplitBandSize;
+       k += 4) {
+    const float* x = &in[k - in_shift];
+    __m128 y = _mm_mul_ps(_mm_loadu_ps(x), f0);
+    y = _mm_add_ps(y, _mm_mul_ps(_mm_loadu_ps(x - kStride), f1));
+    y = _mm_add_ps(y, _mm_mul_ps(_mm_loadu_ps(x - 2 * kStride), f2));
+    y = _mm_add_ps(y, _mm_mul_ps(_mm_loadu_ps(x - 3 * kStride), f3));
+    _mm_storeu_ps(&out[k], y);
+  }
+#else
+  const float32x4_t f0 = vdupq_n_f32(filter[0]);
+  const float32x4_t f1 = vdupq_n_f32(filter[1]);
+  const float32x4_t f2 = vdupq_n_f32(filter[2]);
+  const float32x4_t f3 = vdupq_n_f32(filter[3]);
+  for (int k = kFilterTailStart; k < ThreeBandFilterBank::kSplitBandSize;
+       k += 4) {
+    const float* x = &in[k - in_shift];
+    float32x4_t y = vmulq_f32(vld1q_f32(x), f0);
+    y = vaddq_f32(y, vmulq_f32(vld1q_f32(x - kStride), f1));
+    y = vaddq_f32(y, vmulq_f32(vld1q_f32(x - 2 * kStride), f2));
+    y = vaddq_f32(y, vmulq_f32(vld1q_f32(x - 3 * kStride), f3));
+    vst1q_f32(&out[k], y);
+  }
+#endif
+}
+
+// Adds `gain` times `x` to `y`, four samples at a time.
+void MultiplyAccumulateSimd(
+    float gain,
+    rtc::ArrayView<const float, ThreeBandFilterBank::kSplitBandSize> x,
+    float* y) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  const __m128 g = _mm_set1_ps(gain);
+  for (int n = 0; n < ThreeBandFilterBank::kSplitBandSize; n += 4) {
+    _mm_storeu_ps(&y[n], _mm_add_ps(_mm_loadu_ps(&y[n]),
+                                    _mm_mul_ps(g, _mm_loadu_ps(&x[n]))));
+  }
+#else
+  const float32x4_t g = vdupq_n_f32(gain);
+  for (int n = 0; n < ThreeBandFilterBank::kSplitBandSize; n += 4) {
+    vst1q_f32(&y[n],
+              vaddq_f32(vld1q_f32(&y[n]), vmulq_f32(g, vld1q_f32(&x[n]))));
+  }
+#endif
+}
+#endif
+
+// Adds `gain` times `x` to `y`.
+void MultiplyAccumulate(
+    bool use_simd,
+    float gain,
+    rtc::ArrayView<const float, ThreeBandFilterBank::kSplitBandSize> x,
+    float* y) {
+#if defined(WEBRTC_ARCH_X86_FAMILY) || defined(WEBRTC_HAS_NEON)
+  if (use_simd) {
+    MultiplyAccumulateSimd(gain, x, y);
+    return;
+  }
+#endif
+  for (int n = 0; n < ThreeBandFilterBank::kSplitBandSize; ++n) {
+    y[n] += gain * x[n];
+  }
+}
+
 // Filters the input signal `in` with the filter `filter` using a shift by
 // `in_shift`, taking into account the previous state.
 void FilterCore(
+    bool use_simd,
     rtc::ArrayView<const float, kFilterSize> filter,
     rtc::ArrayView<const float, ThreeBandFilterBank::kSplitBandSize> in,
     const int in_shift,
@@ -132,12 +254,15 @@ void FilterCore(
     }
   }
 
-  for (int k = kFilterSize * kStride, shift = kFilterSize * kStride - in_shift;
-       k < ThreeBandFilterBank::kSplitBandSize; ++k, ++shift) {
-    for (int i = 0, j = shift; i < kFilterSize; ++i, j -= kStride) {
-      out[k] += in[j] * filter[i];
-    }
+#if defined(WEBRTC_ARCH_X86_FAMILY) || defined(WEBRTC_HAS_NEON)
+  if (use_simd) {
+    FilterTailSimd(filter, in, in_shift, out);
+  } else {
+    FilterTail(filter, in, in_shift, out);
   }
+#else
+  FilterTail(filter, in, in_shift, out);
+#endif
 
   // Update current state.
   std::copy(in.begin() + ThreeBandFilterBank::kSplitBandSize - kMemorySize,
@@ -149,7 +274,11 @@ void FilterCore(
 // Because the low-pass filter prototype has half bandwidth it is possible to
 // use a DCT to shift it in both directions at the same time, to the center
 // frequencies [1 / 12, 3 / 12, 5 / 12].
-ThreeBandFilterBank::ThreeBandFilterBank() {
+ThreeBandFilterBank::ThreeBandFilterBank()
+    : ThreeBandFilterBank(/*allow_simd=*/true) {}
+
+ThreeBandFilterBank::ThreeBandFilterBank(bool allow_simd)
+    : use_simd_(allow_simd && SimdAvailable()) {
   RTC_DCHECK_EQ(state_analysis_.size(), kNumNonZeroFilters);
   RTC_DCHECK_EQ(state_synthesis_.size(), kNumNonZeroFilters);
   for (int k = 0; k < kNumNonZeroFilters; ++k) {
@@ -207,14 +336,13 @@ void ThreeBandFilterBank::Analysis(
 
       // Filter.
       std::array<float, kSplitBandSize> out_subsampled;
-      FilterCore(filter, in_subsampled, in_shift, out_subsampled, state);
+      FilterCore(use_simd_, filter, in_subsampled, in_shift, out_subsampled,
+                 state);
 
       // Band and modulate the output.
       for (int band = 0; band < ThreeBandFilterBank::kNumBands; ++band) {
-        float* out_band = out[band].data();
-        for (int n = 0; n < kSplitBandSize; ++n) {
-          out_band[n] += dct_modulation[band] * out_subsampled[n];
-        }
+        MultiplyAccumulate(use_simd_, dct_modulation[band], out_subsampled,
+                           out[band].data());
       }
     }
   }
@@ -255,15 +383,17 @@ void ThreeBandFilterBank::Synthesis(
       std::fill(in_subsampled.begin(), in_subsampled.end(), 0.f);
       for (int band = 0; band < ThreeBandFilterBank::kNumBands; ++band) {
         RTC_DCHECK_EQ(in[band].size(), kSplitBandSize);
-        const float* in_band = in[band].data();
-        for (int n = 0; n < kSplitBandSize; ++n) {
-          in_subsampled[n] += dct_modulation[band] * in_band[n];
-        }
+        MultiplyAccumulate(
+            use_simd_, dct_modulation[band],
+            rtc::ArrayView<const float, kSplitBandSize>(in[band].data(),
+                                                        kSplitBandSize),
+            in_subsampled.data());
       }
 
       // Filter.
       std::array<float, kSplitBandSize> out_subsampled;
-      FilterCore(filter, in_subsampled, in_shift, out_subsampled, state);
+      FilterCore(use_simd_, filter, in_subsampled, in_shift, out_subsampled,
+                 state);
 
       // Upsample.
       constexpr float kUpsamplingScaling = kSubSampling;
@@ -52,7 +52,10 @@ class ThreeBandFilterBank final {
   static const int kNumNonZeroFilters =
       kSparsity * ThreeBandFilterBank::kNumBands - kNumZeroFilters;
 
+  // Uses SSE2 or NEON instructions when the CPU supports them.
   ThreeBandFilterBank();
+  // Uses plain C++ if `allow_simd` is false.
+  explicit ThreeBandFilterBank(bool allow_simd);
   ~ThreeBandFilterBank();
 
   // Splits `in` of size kFullBandSize into 3 downsampled frequency bands in
@@ -66,6 +69,7 @@ class ThreeBandFilterBank final {
                  rtc::ArrayView<float, kFullBandSize> out);
 
  private:
+  const bool use_simd_;
   std::array<std::array<float, kMemorySize>, kNumNonZeroFilters>
       state_analysis_;
   std::array<std::array<float, kMemorySize>, kNumNonZeroFilters>
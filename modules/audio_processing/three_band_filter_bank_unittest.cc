@@ -0,0 +1,67 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/three_band_filter_bank.h"
+
+#include <array>
+
+#include "api/array_view.h"
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using Band = std::array<float, ThreeBandFilterBank::kSplitBandSize>;
+using FullBand = std::array<float, ThreeBandFilterBank::kFullBandSize>;
+
+// Verifies that the SIMD implementation, when there is one, gives the same
+// output as the plain C++ one.
+TEST(ThreeBandFilterBankTest, SimdMatchesPlainImplementation) {
+  ThreeBandFilterBank simd_filter_bank;
+  ThreeBandFilterBank plain_filter_bank(/*allow_simd=*/false);
+  Random random(42);
+
+  for (int frame = 0; frame < 20; ++frame) {
+    FullBand in;
+    for (float& sample : in) {
+      sample = 32767.f * (2.f * random.Rand<float>() - 1.f);
+    }
+
+    std::array<Band, ThreeBandFilterBank::kNumBands> simd_bands;
+    std::array<Band, ThreeBandFilterBank::kNumBands> plain_bands;
+    std::array<rtc::ArrayView<float>, ThreeBandFilterBank::kNumBands>
+        simd_views;
+    std::array<rtc::ArrayView<float>, ThreeBandFilterBank::kNumBands>
+        plain_views;
+    for (int band = 0; band < ThreeBandFilterBank::kNumBands; ++band) {
+      simd_views[band] = simd_bands[band];
+      plain_views[band] = plain_bands[band];
+    }
+    simd_filter_bank.Analysis(in, simd_views);
+    plain_filter_bank.Analysis(in, plain_views);
+    for (int band = 0; band < ThreeBandFilterBank::kNumBands; ++band) {
+      for (int k = 0; k < ThreeBandFilterBank::kSplitBandSize; ++k) {
+        EXPECT_NEAR(simd_bands[band][k], plain_bands[band][k], 0.01f);
+      }
+    }
+
+    FullBand simd_out;
+    FullBand plain_out;
+    simd_filter_bank.Synthesis(plain_views, simd_out);
+    plain_filter_bank.Synthesis(plain_views, plain_out);
+    for (int k = 0; k < ThreeBandFilterBank::kFullBandSize; ++k) {
+      EXPECT_NEAR(simd_out[k], plain_out[k], 0.01f);
+    }
+  }
+}
+
+}  // namespace
+}  // namespace webrtc
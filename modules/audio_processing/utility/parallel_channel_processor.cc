@@ -0,0 +1,105 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/utility/parallel_channel_processor.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+ParallelChannelProcessor::ParallelChannelProcessor(
+    int num_threads,
+    absl::string_view thread_name) {
+  RTC_DCHECK_GE(num_threads, 1);
+  for (int i = 1; i < num_threads; ++i) {
+    workers_.push_back(std::make_unique<Worker>());
+    Worker* worker = workers_.back().get();
+    // The workers do the work of the audio thread, so they run at its
+    // priority.
+    worker->thread = rtc::PlatformThread::SpawnJoinable(
+        [this, worker] { RunWorker(worker); }, thread_name,
+        rtc::ThreadAttributes().SetPriority(rtc::ThreadPriority::kRealtime));
+  }
+}
+
+ParallelChannelProcessor::~ParallelChannelProcessor() {
+  quit_ = true;
+  for (auto& worker : workers_) {
+    worker->wake_up.Set();
+  }
+  for (auto& worker : workers_) {
+    worker->thread.Finalize();
+  }
+}
+
+void ParallelChannelProcessor::Run(
+    size_t num_channels,
+    rtc::FunctionView<void(size_t)> process_channel) {
+  if (workers_.empty() || num_channels <= 1 || !run_mutex_.TryLock()) {
+    for (size_t ch = 0; ch < num_channels; ++ch) {
+      process_channel(ch);
+    }
+    return;
+  }
+
+  process_channel_ = process_channel;
+  num_channels_ = num_channels;
+  next_channel_.store(0);
+  // The calling thread processes channels too, so fewer workers than channels
+  // are needed.
+  const size_t num_workers = std::min(workers_.size(), num_channels - 1);
+  num_busy_workers_.store(static_cast<int>(num_workers));
+  for (size_t i = 0; i < num_workers; ++i) {
+    workers_[i]->wake_up.Set();
+  }
+  ProcessChannels();
+  {
+    rtc::ScopedAllowBaseSyncPrimitives allow_wait;
+    workers_done_.Wait(rtc::Event::kForever);
+  }
+  process_channel_ = nullptr;
+  run_mutex_.Unlock();
+}
+
+void ParallelChannelProcessor::RunWorker(Worker* worker) {
+  while (true) {
+    worker->wake_up.Wait(rtc::Event::kForever);
+    if (quit_) {
+      return;
+    }
+    ProcessChannels();
+    if (num_busy_workers_.fetch_sub(1) == 1) {
+      workers_done_.Set();
+    }
+  }
+}
+
+void ParallelChannelProcessor::ProcessChannels() {
+  for (size_t ch = next_channel_.fetch_add(1); ch < num_channels_;
+       ch = next_channel_.fetch_add(1)) {
+    process_channel_(ch);
+  }
+}
+
+void ForEachChannel(ParallelChannelProcessor* processor,
+                    size_t num_channels,
+                    rtc::FunctionView<void(size_t)> process_channel) {
+  if (processor) {
+    processor->Run(num_channels, process_channel);
+    return;
+  }
+  for (size_t ch = 0; ch < num_channels; ++ch) {
+    process_channel(ch);
+  }
+}
+
+}  // namespace webrtc
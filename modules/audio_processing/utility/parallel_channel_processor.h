@@ -0,0 +1,87 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_UTILITY_PARALLEL_CHANNEL_PROCESSOR_H_
+#define MODULES_AUDIO_PROCESSING_UTILITY_PARALLEL_CHANNEL_PROCESSOR_H_
+
+#include <stddef.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "api/function_view.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/synchronization/mutex.h"
+
+namespace webrtc {
+
+// Runs the independent per-channel work of a processing stage on a small set
+// of worker threads, and returns when all of it is done. As every channel is
+// processed exactly as it would be serially, the output does not depend on the
+// number of threads.
+//
+// The render and capture sides of the audio processing can share a
+// processor: when the workers are busy with the work of another thread, the
+// work runs on the calling thread instead of waiting for them.
+class ParallelChannelProcessor {
+ public:
+  // Processes with `num_threads` threads, including the calling one. The
+  // worker threads are named `thread_name`.
+  explicit ParallelChannelProcessor(
+      int num_threads,
+      absl::string_view thread_name = "apm_channel_worker");
+  ~ParallelChannelProcessor();
+
+  ParallelChannelProcessor(const ParallelChannelProcessor&) = delete;
+  ParallelChannelProcessor& operator=(const ParallelChannelProcessor&) =
+      delete;
+
+  int num_threads() const { return static_cast<int>(workers_.size()) + 1; }
+
+  // Calls `process_channel(ch)` for every channel `ch` in
+  // [0, `num_channels`). The calls for different channels may run
+  // concurrently and in any order, so they must not modify shared state.
+  void Run(size_t num_channels,
+           rtc::FunctionView<void(size_t)> process_channel);
+
+ private:
+  struct Worker {
+    rtc::Event wake_up;
+    rtc::PlatformThread thread;
+  };
+
+  void RunWorker(Worker* worker);
+  // Processes channels until all have been taken.
+  void ProcessChannels();
+
+  // Held while the workers are in use by a call to Run().
+  Mutex run_mutex_;
+  std::vector<std::unique_ptr<Worker>> workers_;
+  bool quit_ = false;
+  // The work of the current call to Run().
+  rtc::FunctionView<void(size_t)> process_channel_;
+  size_t num_channels_ = 0;
+  std::atomic<size_t> next_channel_{0};
+  std::atomic<int> num_busy_workers_{0};
+  rtc::Event workers_done_;
+};
+
+// Runs `process_channel` for all channels on `processor`, or serially when
+// `processor` is null.
+void ForEachChannel(ParallelChannelProcessor* processor,
+                    size_t num_channels,
+                    rtc::FunctionView<void(size_t)> process_channel);
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_UTILITY_PARALLEL_CHANNEL_PROCESSOR_H_
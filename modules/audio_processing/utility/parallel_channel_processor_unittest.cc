@@ -0,0 +1,83 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/utility/parallel_channel_processor.h"
+
+#include <atomic>
+#include <vector>
+
+#include "rtc_base/platform_thread.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::Each;
+
+TEST(ParallelChannelProcessorTest, ProcessesEveryChannelOnce) {
+  for (int num_threads : {1, 2, 4}) {
+    ParallelChannelProcessor processor(num_threads);
+    EXPECT_EQ(processor.num_threads(), num_threads);
+    for (size_t num_channels : {0, 1, 3, 8}) {
+      // Several runs, to reuse the workers.
+      for (int run = 0; run < 10; ++run) {
+        std::vector<std::atomic<int>> calls(num_channels);
+        processor.Run(num_channels, [&](size_t ch) { ++calls[ch]; });
+        for (size_t ch = 0; ch < num_channels; ++ch) {
+          EXPECT_EQ(calls[ch].load(), 1) << ch;
+        }
+      }
+    }
+  }
+}
+
+TEST(ParallelChannelProcessorTest, ProcessesChannelsConcurrently) {
+  ParallelChannelProcessor processor(/*num_threads=*/2);
+  // Each of the two channels waits for the other one to start, which only
+  // completes if they run on different threads.
+  std::atomic<int> num_started{0};
+  processor.Run(2, [&](size_t ch) {
+    ++num_started;
+    while (num_started.load() < 2) {
+    }
+  });
+  EXPECT_EQ(num_started.load(), 2);
+}
+
+TEST(ParallelChannelProcessorTest, RunsOnCallingThreadWhenBusy) {
+  ParallelChannelProcessor processor(/*num_threads=*/2);
+  std::vector<int> other_calls(4, 0);
+  std::atomic<bool> other_done{false};
+  processor.Run(2, [&](size_t ch) {
+    if (ch != 0) {
+      return;
+    }
+    // Run from another thread while the workers are in use.
+    rtc::PlatformThread::SpawnJoinable(
+        [&] {
+          processor.Run(other_calls.size(),
+                        [&](size_t other_ch) { ++other_calls[other_ch]; });
+          other_done = true;
+        },
+        "other");
+  });
+  EXPECT_TRUE(other_done);
+  EXPECT_THAT(other_calls, Each(1));
+}
+
+TEST(ParallelChannelProcessorTest, ForEachChannelWithoutProcessor) {
+  std::vector<int> calls(3, 0);
+  ForEachChannel(nullptr, calls.size(), [&](size_t ch) { ++calls[ch]; });
+  EXPECT_THAT(calls, Each(1));
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -390,6 +390,8 @@ std::vector<ProbeClusterConfig> GoogCcNetworkController::ResetConstraints(
     delay_based_bwe_->SetStartBitrate(*starting_rate_);
   delay_based_bwe_->SetMinBitrate(min_data_rate_);
 
+  if (new_constraints.capacity_hint)
+    probe_controller_->SetCapacityHint(*new_constraints.capacity_hint);
   return probe_controller_->SetBitrates(
       min_data_rate_, starting_rate_.value_or(DataRate::Zero()), max_data_rate_,
       new_constraints.at_time);
@@ -83,32 +83,40 @@ PacketResultsSummary GetPacketResultsSummary(
   return packet_results_summary;
 }
 
-double GetLossProbability(double inherent_loss,
-                          DataRate loss_limited_bandwidth,
-                          DataRate sending_rate) {
+double ClampInherentLoss(double inherent_loss) {
   if (inherent_loss < 0.0 || inherent_loss > 1.0) {
     RTC_LOG(LS_WARNING) << "The inherent loss must be in [0,1]: "
                         << inherent_loss;
     inherent_loss = std::min(std::max(inherent_loss, 0.0), 1.0);
   }
-  if (!sending_rate.IsFinite()) {
-    RTC_LOG(LS_WARNING) << "The sending rate must be finite: "
-                        << ToString(sending_rate);
-  }
-  if (!loss_limited_bandwidth.IsFinite()) {
-    RTC_LOG(LS_WARNING) << "The loss limited bandwidth must be finite: "
-                        << ToString(loss_limited_bandwidth);
-  }
+  return inherent_loss;
+}
 
+// `inherent_loss` must be in [0,1]. A sending rate of minus infinity, or a
+// loss limited bandwidth of plus infinity, leaves the inherent loss as is.
+double GetLossProbability(double inherent_loss,
+                          double loss_limited_bandwidth_bps,
+                          double sending_rate_bps) {
   double loss_probability = inherent_loss;
-  if (IsValid(sending_rate) && IsValid(loss_limited_bandwidth) &&
-      (sending_rate > loss_limited_bandwidth)) {
+  if (sending_rate_bps > loss_limited_bandwidth_bps) {
     loss_probability += (1 - inherent_loss) *
-                        (sending_rate - loss_limited_bandwidth) / sending_rate;
+                        (sending_rate_bps - loss_limited_bandwidth_bps) /
+                        sending_rate_bps;
   }
   return std::min(std::max(loss_probability, 1.0e-6), 1.0 - 1.0e-6);
 }
 
+// Bandwidth in the unit GetLossProbability() expects, plus infinity if the
+// bandwidth is not known.
+double GetLossLimitedBandwidthBps(DataRate loss_limited_bandwidth) {
+  if (!IsValid(loss_limited_bandwidth)) {
+    RTC_LOG(LS_WARNING) << "The loss limited bandwidth must be finite: "
+                        << ToString(loss_limited_bandwidth);
+    return std::numeric_limits<double>::infinity();
+  }
+  return loss_limited_bandwidth.bps<double>();
+}
+
 }  // namespace
 
 LossBasedBweV2::LossBasedBweV2(const FieldTrialsView* key_value_config)
@@ -932,40 +940,22 @@ LossBasedBweV2::Derivatives LossBasedBweV2::GetDerivatives(
     const ChannelParameters& channel_parameters) const {
   Derivatives derivatives;
 
-  for (const Observation& observation : observations_) {
-    if (!observation.IsInitialized()) {
-      continue;
-    }
-
-    double loss_probability = GetLossProbability(
-        channel_parameters.inherent_loss,
-        channel_parameters.loss_limited_bandwidth, observation.sending_rate);
-
-    double temporal_weight =
-        temporal_weights_[(num_observations_ - 1) - observation.id];
-    if (config_->use_byte_loss_rate) {
-      derivatives.first +=
-          temporal_weight *
-          ((ToKiloBytes(observation.lost_size) / loss_probability) -
-           (ToKiloBytes(observation.size - observation.lost_size) /
-            (1.0 - loss_probability)));
-      derivatives.second -=
-          temporal_weight *
-          ((ToKiloBytes(observation.lost_size) /
-            std::pow(loss_probability, 2)) +
-           (ToKiloBytes(observation.size - observation.lost_size) /
-            std::pow(1.0 - loss_probability, 2)));
-    } else {
-      derivatives.first +=
-          temporal_weight *
-          ((observation.num_lost_packets / loss_probability) -
-           (observation.num_received_packets / (1.0 - loss_probability)));
-      derivatives.second -=
-          temporal_weight *
-          ((observation.num_lost_packets / std::pow(loss_probability, 2)) +
-           (observation.num_received_packets /
-            std::pow(1.0 - loss_probability, 2)));
-    }
+  const ObservationTerms& terms = observation_terms_;
+  const double inherent_loss =
+      ClampInherentLoss(channel_parameters.inherent_loss);
+  const double loss_limited_bandwidth_bps =
+      GetLossLimitedBandwidthBps(channel_parameters.loss_limited_bandwidth);
+  for (size_t i = 0; i < terms.size(); ++i) {
+    const double loss_probability = GetLossProbability(
+        inherent_loss, loss_limited_bandwidth_bps, terms.sending_rate_bps[i]);
+    const double no_loss_probability = 1.0 - loss_probability;
+    derivatives.first +=
+        terms.temporal_weight[i] * ((terms.lost[i] / loss_probability) -
+                                    (terms.received[i] / no_loss_probability));
+    derivatives.second -=
+        terms.temporal_weight[i] *
+        ((terms.lost[i] / (loss_probability * loss_probability)) +
+         (terms.received[i] / (no_loss_probability * no_loss_probability)));
   }
 
   if (derivatives.second >= 0.0) {
@@ -1026,34 +1016,19 @@ double LossBasedBweV2::GetObjective(
   const double high_bandwidth_bias =
       GetHighBandwidthBias(channel_parameters.loss_limited_bandwidth);
 
-  for (const Observation& observation : observations_) {
-    if (!observation.IsInitialized()) {
-      continue;
-    }
-
-    double loss_probability = GetLossProbability(
-        channel_parameters.inherent_loss,
-        channel_parameters.loss_limited_bandwidth, observation.sending_rate);
-
-    double temporal_weight =
-        temporal_weights_[(num_observations_ - 1) - observation.id];
-    if (config_->use_byte_loss_rate) {
-      objective +=
-          temporal_weight *
-          ((ToKiloBytes(observation.lost_size) * std::log(loss_probability)) +
-           (ToKiloBytes(observation.size - observation.lost_size) *
-            std::log(1.0 - loss_probability)));
-      objective +=
-          temporal_weight * high_bandwidth_bias * ToKiloBytes(observation.size);
-    } else {
-      objective +=
-          temporal_weight *
-          ((observation.num_lost_packets * std::log(loss_probability)) +
-           (observation.num_received_packets *
-            std::log(1.0 - loss_probability)));
-      objective +=
-          temporal_weight * high_bandwidth_bias * observation.num_packets;
-    }
+  const ObservationTerms& terms = observation_terms_;
+  const double inherent_loss =
+      ClampInherentLoss(channel_parameters.inherent_loss);
+  const double loss_limited_bandwidth_bps =
+      GetLossLimitedBandwidthBps(channel_parameters.loss_limited_bandwidth);
+  for (size_t i = 0; i < terms.size(); ++i) {
+    const double loss_probability = GetLossProbability(
+        inherent_loss, loss_limited_bandwidth_bps, terms.sending_rate_bps[i]);
+    objective += terms.temporal_weight[i] *
+                 ((terms.lost[i] * std::log(loss_probability)) +
+                  (terms.received[i] * std::log(1.0 - loss_probability)));
+    objective +=
+        terms.temporal_weight[i] * high_bandwidth_bias * terms.total[i];
   }
 
   return objective;
@@ -1120,6 +1095,44 @@ void LossBasedBweV2::CalculateTemporalWeights() {
   }
 }
 
+void LossBasedBweV2::ObservationTerms::Clear() {
+  temporal_weight.clear();
+  sending_rate_bps.clear();
+  lost.clear();
+  received.clear();
+  total.clear();
+}
+
+void LossBasedBweV2::UpdateObservationTerms() {
+  observation_terms_.Clear();
+  for (const Observation& observation : observations_) {
+    if (!observation.IsInitialized()) {
+      continue;
+    }
+    observation_terms_.temporal_weight.push_back(
+        temporal_weights_[(num_observations_ - 1) - observation.id]);
+    if (IsValid(observation.sending_rate)) {
+      observation_terms_.sending_rate_bps.push_back(
+          observation.sending_rate.bps<double>());
+    } else {
+      RTC_LOG(LS_WARNING) << "The sending rate must be finite: "
+                          << ToString(observation.sending_rate);
+      observation_terms_.sending_rate_bps.push_back(
+          -std::numeric_limits<double>::infinity());
+    }
+    if (config_->use_byte_loss_rate) {
+      observation_terms_.lost.push_back(ToKiloBytes(observation.lost_size));
+      observation_terms_.received.push_back(
+          ToKiloBytes(observation.size - observation.lost_size));
+      observation_terms_.total.push_back(ToKiloBytes(observation.size));
+    } else {
+      observation_terms_.lost.push_back(observation.num_lost_packets);
+      observation_terms_.received.push_back(observation.num_received_packets);
+      observation_terms_.total.push_back(observation.num_packets);
+    }
+  }
+}
+
 void LossBasedBweV2::NewtonsMethodUpdate(
     ChannelParameters& channel_parameters) const {
   if (num_observations_ <= 0) {
@@ -1182,6 +1195,7 @@ bool LossBasedBweV2::PushBackObservation(
 
   partial_observation_ = PartialObservation();
 
+  UpdateObservationTerms();
   CalculateInstantUpperBound();
   return true;
 }
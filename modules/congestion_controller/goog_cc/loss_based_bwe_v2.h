@@ -145,6 +145,22 @@ class LossBasedBweV2 {
     int id = -1;
   };
 
+  // The initialized observations in `observations_`, laid out as parallel
+  // arrays so that the objective and its derivatives can be evaluated for
+  // every candidate in tight loops. `lost`, `received` and `total` count
+  // kilobytes or packets depending on `Config::use_byte_loss_rate`.
+  struct ObservationTerms {
+    void Clear();
+    size_t size() const { return temporal_weight.size(); }
+
+    std::vector<double> temporal_weight;
+    // Minus infinity if the sending rate of the observation is unknown.
+    std::vector<double> sending_rate_bps;
+    std::vector<double> lost;
+    std::vector<double> received;
+    std::vector<double> total;
+  };
+
   struct PartialObservation {
     int num_packets = 0;
     int num_lost_packets = 0;
@@ -187,6 +203,7 @@ class LossBasedBweV2 {
   void CalculateInstantLowerBound();
 
   void CalculateTemporalWeights();
+  void UpdateObservationTerms();
   void NewtonsMethodUpdate(ChannelParameters& channel_parameters) const;
 
   // Returns false if no observation was created.
@@ -201,6 +218,7 @@ class LossBasedBweV2 {
   ChannelParameters current_best_estimate_;
   int num_observations_ = 0;
   std::vector<Observation> observations_;
+  ObservationTerms observation_terms_;
   PartialObservation partial_observation_;
   Timestamp last_send_time_most_recent_observation_ = Timestamp::PlusInfinity();
   Timestamp last_time_estimate_reduced_ = Timestamp::MinusInfinity();
@@ -190,6 +190,11 @@ std::vector<ProbeClusterConfig> ProbeController::SetBitrates(
       break;
 
     case State::kProbingComplete:
+      if (capacity_hint_) {
+        std::vector<DataRate> probes = {std::min(*capacity_hint_, max_bitrate_)};
+        capacity_hint_ = absl::nullopt;
+        return InitiateProbing(at_time, probes, false);
+      }
       // If the new max bitrate is higher than both the old max bitrate and the
       // estimate then initiate probing.
       if (!estimated_bitrate_.IsZero() && old_max_bitrate < max_bitrate_ &&
@@ -201,6 +206,11 @@ std::vector<ProbeClusterConfig> ProbeController::SetBitrates(
   return std::vector<ProbeClusterConfig>();
 }
 
+void ProbeController::SetCapacityHint(DataRate capacity_hint) {
+  if (capacity_hint > DataRate::Zero() && capacity_hint.IsFinite())
+    capacity_hint_ = capacity_hint;
+}
+
 std::vector<ProbeClusterConfig> ProbeController::OnMaxTotalAllocatedBitrate(
     DataRate max_total_allocated_bitrate,
     Timestamp at_time) {
@@ -258,6 +268,14 @@ std::vector<ProbeClusterConfig> ProbeController::InitiateExponentialProbing(
   RTC_DCHECK(state_ == State::kInit);
   RTC_DCHECK_GT(start_bitrate_, DataRate::Zero());
 
+  if (capacity_hint_) {
+    // The capacity is already known, so only verify it instead of searching
+    // for it.
+    std::vector<DataRate> probes = {std::min(*capacity_hint_, max_bitrate_)};
+    capacity_hint_ = absl::nullopt;
+    return InitiateProbing(at_time, probes, false);
+  }
+
   // When probing at 1.8 Mbps ( 6x 300), this represents a threshold of
   // 1.2 Mbps to continue probing.
   std::vector<DataRate> probes = {config_.first_exponential_probe_scale *
@@ -369,6 +387,7 @@ void ProbeController::Reset(Timestamp at_time) {
   estimated_bitrate_ = DataRate::Zero();
   network_estimate_ = absl::nullopt;
   start_bitrate_ = DataRate::Zero();
+  capacity_hint_ = absl::nullopt;
   max_bitrate_ = kDefaultMaxProbingBitrate;
   Timestamp now = at_time;
   last_bwe_drop_probing_time_ = now;
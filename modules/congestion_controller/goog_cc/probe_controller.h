@@ -106,6 +106,11 @@ class ProbeController {
       DataRate max_bitrate,
       Timestamp at_time);
 
+  // Sets a capacity reported by the application. It is verified with a single
+  // probe, replacing the initial exponential probing if that has not started
+  // yet. Must be called before SetBitrates to take effect at startup.
+  void SetCapacityHint(DataRate capacity_hint);
+
   // The total bitrate, as opposed to the max bitrate, is the sum of the
   // configured bitrates for all active streams.
   ABSL_MUST_USE_RESULT std::vector<ProbeClusterConfig>
@@ -166,6 +171,8 @@ class ProbeController {
   DataRate estimated_bitrate_ = DataRate::Zero();
   absl::optional<webrtc::NetworkStateEstimate> network_estimate_;
   DataRate start_bitrate_ = DataRate::Zero();
+  // Capacity hint waiting to be verified with a probe.
+  absl::optional<DataRate> capacity_hint_;
   DataRate max_bitrate_ = DataRate::PlusInfinity();
   Timestamp last_bwe_drop_probing_time_ = Timestamp::Zero();
   absl::optional<Timestamp> alr_start_time_;
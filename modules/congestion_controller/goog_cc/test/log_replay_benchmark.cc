@@ -0,0 +1,216 @@
+/*
+ *  Copyright 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "modules/congestion_controller/goog_cc/test/log_replay_benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "api/transport/network_control.h"
+#include "api/transport/network_types.h"
+#include "api/units/data_rate.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "logging/rtc_event_log/rtc_event_log_parser.h"
+#include "rtc_base/cpu_time.h"
+#include "rtc_tools/rtc_event_log_visualizer/log_simulation.h"
+
+namespace webrtc {
+namespace {
+
+struct RateSample {
+  Timestamp at_time;
+  DataRate rate;
+};
+
+// Forwards all calls to the wrapped controller, measuring the feedback path.
+class MeasuringNetworkController : public NetworkControllerInterface {
+ public:
+  MeasuringNetworkController(
+      std::unique_ptr<NetworkControllerInterface> controller,
+      LogReplayBenchmarkResult* result)
+      : controller_(std::move(controller)), result_(result) {}
+
+  NetworkControlUpdate OnNetworkAvailability(NetworkAvailability msg) override {
+    return controller_->OnNetworkAvailability(msg);
+  }
+  NetworkControlUpdate OnNetworkRouteChange(NetworkRouteChange msg) override {
+    return controller_->OnNetworkRouteChange(msg);
+  }
+  NetworkControlUpdate OnProcessInterval(ProcessInterval msg) override {
+    return controller_->OnProcessInterval(msg);
+  }
+  NetworkControlUpdate OnRemoteBitrateReport(
+      RemoteBitrateReport msg) override {
+    return controller_->OnRemoteBitrateReport(msg);
+  }
+  NetworkControlUpdate OnRoundTripTimeUpdate(
+      RoundTripTimeUpdate msg) override {
+    return controller_->OnRoundTripTimeUpdate(msg);
+  }
+  NetworkControlUpdate OnSentPacket(SentPacket msg) override {
+    return controller_->OnSentPacket(msg);
+  }
+  NetworkControlUpdate OnReceivedPacket(ReceivedPacket msg) override {
+    return controller_->OnReceivedPacket(msg);
+  }
+  NetworkControlUpdate OnStreamsConfig(StreamsConfig msg) override {
+    return controller_->OnStreamsConfig(msg);
+  }
+  NetworkControlUpdate OnTargetRateConstraints(
+      TargetRateConstraints msg) override {
+    return controller_->OnTargetRateConstraints(msg);
+  }
+  NetworkControlUpdate OnTransportLossReport(
+      TransportLossReport msg) override {
+    return controller_->OnTransportLossReport(msg);
+  }
+  NetworkControlUpdate OnTransportPacketsFeedback(
+      TransportPacketsFeedback msg) override {
+    for (const PacketResult& packet : msg.packet_feedbacks) {
+      if (!packet.IsReceived())
+        continue;
+      TimeDelta delay = msg.feedback_time - packet.sent_packet.send_time;
+      ++result_->acked_packets;
+      feedback_delay_sum_ += delay;
+      result_->mean_feedback_delay =
+          feedback_delay_sum_ / result_->acked_packets;
+      result_->max_feedback_delay =
+          std::max(result_->max_feedback_delay, delay);
+    }
+
+    int64_t start_ns = rtc::GetThreadCpuTimeNanos();
+    NetworkControlUpdate update =
+        controller_->OnTransportPacketsFeedback(std::move(msg));
+    TimeDelta cpu_time =
+        TimeDelta::Micros((rtc::GetThreadCpuTimeNanos() - start_ns) / 1000);
+    ++result_->feedback_calls;
+    result_->feedback_cpu_time += cpu_time;
+    result_->max_feedback_cpu_time =
+        std::max(result_->max_feedback_cpu_time, cpu_time);
+    return update;
+  }
+  NetworkControlUpdate OnNetworkStateEstimate(
+      NetworkStateEstimate msg) override {
+    return controller_->OnNetworkStateEstimate(msg);
+  }
+
+ private:
+  const std::unique_ptr<NetworkControllerInterface> controller_;
+  LogReplayBenchmarkResult* const result_;
+  TimeDelta feedback_delay_sum_ = TimeDelta::Zero();
+};
+
+class MeasuringNetworkControllerFactory
+    : public NetworkControllerFactoryInterface {
+ public:
+  MeasuringNetworkControllerFactory(
+      std::unique_ptr<NetworkControllerFactoryInterface> factory,
+      LogReplayBenchmarkResult* result)
+      : factory_(std::move(factory)), result_(result) {}
+
+  std::unique_ptr<NetworkControllerInterface> Create(
+      NetworkControllerConfig config) override {
+    return std::make_unique<MeasuringNetworkController>(
+        factory_->Create(config), result_);
+  }
+  TimeDelta GetProcessInterval() const override {
+    return factory_->GetProcessInterval();
+  }
+
+ private:
+  const std::unique_ptr<NetworkControllerFactoryInterface> factory_;
+  LogReplayBenchmarkResult* const result_;
+};
+
+// Compares two step functions, each given as samples sorted by time, over
+// the time both are defined.
+void CompareRates(const std::vector<RateSample>& simulated,
+                  const std::vector<RateSample>& logged,
+                  Timestamp end_time,
+                  LogReplayBenchmarkResult& result) {
+  if (simulated.empty() || logged.empty())
+    return;
+  Timestamp time = std::max(simulated.front().at_time, logged.front().at_time);
+  size_t sim_index = 0;
+  size_t log_index = 0;
+  TimeDelta total_time = TimeDelta::Zero();
+  double simulated_bits = 0;
+  double logged_bits = 0;
+  double weighted_error = 0;
+  while (time < end_time) {
+    while (sim_index + 1 < simulated.size() &&
+           simulated[sim_index + 1].at_time <= time) {
+      ++sim_index;
+    }
+    while (log_index + 1 < logged.size() &&
+           logged[log_index + 1].at_time <= time) {
+      ++log_index;
+    }
+    Timestamp next_time = end_time;
+    if (sim_index + 1 < simulated.size())
+      next_time = std::min(next_time, simulated[sim_index + 1].at_time);
+    if (log_index + 1 < logged.size())
+      next_time = std::min(next_time, logged[log_index + 1].at_time);
+
+    const TimeDelta duration = next_time - time;
+    const DataRate sim_rate = simulated[sim_index].rate;
+    const DataRate log_rate = logged[log_index].rate;
+    total_time += duration;
+    simulated_bits += sim_rate.bps<double>() * duration.seconds<double>();
+    logged_bits += log_rate.bps<double>() * duration.seconds<double>();
+    if (!log_rate.IsZero()) {
+      weighted_error += std::abs(sim_rate.bps<double>() - log_rate.bps()) /
+                        log_rate.bps() * duration.seconds<double>();
+    }
+    time = next_time;
+  }
+  if (total_time <= TimeDelta::Zero())
+    return;
+  result.mean_target_rate =
+      DataRate::BitsPerSec(simulated_bits / total_time.seconds<double>());
+  result.mean_logged_rate =
+      DataRate::BitsPerSec(logged_bits / total_time.seconds<double>());
+  result.mean_relative_rate_error =
+      weighted_error / total_time.seconds<double>();
+}
+
+}  // namespace
+
+LogReplayBenchmarkResult RunLogReplayBenchmark(
+    const ParsedRtcEventLog& parsed_log,
+    std::unique_ptr<NetworkControllerFactoryInterface> factory) {
+  LogReplayBenchmarkResult result;
+  std::vector<RateSample> simulated_rates;
+  LogBasedNetworkControllerSimulation simulation(
+      std::make_unique<MeasuringNetworkControllerFactory>(std::move(factory),
+                                                          &result),
+      [&](const NetworkControlUpdate& update, Timestamp at_time) {
+        if (update.target_rate) {
+          simulated_rates.push_back(
+              {at_time, update.target_rate->target_rate});
+        }
+      });
+  simulation.ProcessEventsInLog(parsed_log);
+
+  std::vector<RateSample> logged_rates;
+  for (const LoggedBweLossBasedUpdate& logged : parsed_log.bwe_loss_updates()) {
+    logged_rates.push_back(
+        {logged.log_time(), DataRate::BitsPerSec(logged.bitrate_bps)});
+  }
+  CompareRates(simulated_rates, logged_rates, parsed_log.last_timestamp(),
+               result);
+  return result;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,59 @@
+/*
+ *  Copyright 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#ifndef MODULES_CONGESTION_CONTROLLER_GOOG_CC_TEST_LOG_REPLAY_BENCHMARK_H_
+#define MODULES_CONGESTION_CONTROLLER_GOOG_CC_TEST_LOG_REPLAY_BENCHMARK_H_
+
+#include <cstdint>
+#include <memory>
+
+#include "api/transport/network_control.h"
+#include "api/units/data_rate.h"
+#include "api/units/time_delta.h"
+#include "logging/rtc_event_log/rtc_event_log_parser.h"
+
+namespace webrtc {
+
+struct LogReplayBenchmarkResult {
+  // Number of OnTransportPacketsFeedback() calls and the thread CPU time
+  // spent inside them.
+  int64_t feedback_calls = 0;
+  TimeDelta feedback_cpu_time = TimeDelta::Zero();
+  TimeDelta max_feedback_cpu_time = TimeDelta::Zero();
+
+  // Time from sending a packet until feedback about it reached the
+  // controller, over all packets reported as received.
+  int64_t acked_packets = 0;
+  TimeDelta mean_feedback_delay = TimeDelta::Zero();
+  TimeDelta max_feedback_delay = TimeDelta::Zero();
+
+  // Time weighted mean of the simulated target rate and of the loss based
+  // estimate recorded in the log, over the time both are known.
+  DataRate mean_target_rate = DataRate::Zero();
+  DataRate mean_logged_rate = DataRate::Zero();
+  // Time weighted mean of |simulated - logged| / logged.
+  double mean_relative_rate_error = 0.0;
+
+  TimeDelta MeanFeedbackCpuTime() const {
+    return feedback_calls > 0 ? feedback_cpu_time / feedback_calls
+                              : TimeDelta::Zero();
+  }
+};
+
+// Replays the packets, feedback and reports of `parsed_log` through a
+// network controller created by `factory`, and measures how closely the
+// controller tracks the target rate the sender had at the time as well as
+// the CPU cost of processing transport feedback.
+LogReplayBenchmarkResult RunLogReplayBenchmark(
+    const ParsedRtcEventLog& parsed_log,
+    std::unique_ptr<NetworkControllerFactoryInterface> factory);
+
+}  // namespace webrtc
+
+#endif  // MODULES_CONGESTION_CONTROLLER_GOOG_CC_TEST_LOG_REPLAY_BENCHMARK_H_
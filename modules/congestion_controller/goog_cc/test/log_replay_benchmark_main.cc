@@ -0,0 +1,76 @@
+/*
+ *  Copyright 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Replays the send side of RTC event logs through GoogCC and prints how well
+// the simulated target rate matches the logged one, together with the CPU
+// time spent on transport feedback. Usage:
+//   goog_cc_log_replay_benchmark [--force_fieldtrials=...] log1 [log2 ...]
+
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "api/transport/goog_cc_factory.h"
+#include "logging/rtc_event_log/rtc_event_log_parser.h"
+#include "modules/congestion_controller/goog_cc/test/log_replay_benchmark.h"
+#include "system_wrappers/include/field_trial.h"
+
+ABSL_FLAG(std::string,
+          force_fieldtrials,
+          "",
+          "Field trials to run GoogCC with, e.g. "
+          "--force_fieldtrials=WebRTC-Bwe-LossBasedBweV2/Enabled:true/");
+
+int main(int argc, char* argv[]) {
+  std::vector<char*> args = absl::ParseCommandLine(argc, argv);
+  if (args.size() < 2) {
+    std::cerr << "Usage: " << args[0] << " [flags] event_log [event_log ...]"
+              << std::endl;
+    return 1;
+  }
+
+  // InitFieldTrialsFromString stores the char*, so the string must outlive
+  // the application.
+  const std::string field_trials = absl::GetFlag(FLAGS_force_fieldtrials);
+  webrtc::field_trial::InitFieldTrialsFromString(field_trials.c_str());
+
+  printf("%-40s %10s %10s %8s %8s %10s %10s %10s\n", "log", "sim_kbps",
+         "log_kbps", "rel_err", "fb_calls", "cpu_us/fb", "max_cpu_us",
+         "fb_dly_ms");
+  int failed = 0;
+  for (size_t i = 1; i < args.size(); ++i) {
+    const std::string filename = args[i];
+    webrtc::ParsedRtcEventLog parsed_log(
+        webrtc::ParsedRtcEventLog::UnconfiguredHeaderExtensions::kDontParse,
+        /*allow_incomplete_logs=*/true);
+    auto status = parsed_log.ParseFile(filename);
+    if (!status.ok()) {
+      std::cerr << "Failed to parse " << filename << ": " << status.message()
+                << std::endl;
+      ++failed;
+      continue;
+    }
+    webrtc::LogReplayBenchmarkResult result = webrtc::RunLogReplayBenchmark(
+        parsed_log, std::make_unique<webrtc::GoogCcNetworkControllerFactory>());
+    printf("%-40s %10.1f %10.1f %8.3f %8lld %10.2f %10lld %10.1f\n",
+           filename.c_str(), result.mean_target_rate.kbps<double>(),
+           result.mean_logged_rate.kbps<double>(),
+           result.mean_relative_rate_error,
+           static_cast<long long>(result.feedback_calls),
+           result.MeanFeedbackCpuTime().us<double>(),
+           static_cast<long long>(result.max_feedback_cpu_time.us()),
+           result.mean_feedback_delay.ms<double>());
+  }
+  return failed == 0 ? 0 : 1;
+}
@@ -14,6 +14,7 @@
 #include <memory>
 #include <vector>
 
+#include "api/array_view.h"
 #include "api/transport/network_control.h"
 #include "api/units/data_rate.h"
 #include "api/units/time_delta.h"
@@ -43,6 +44,11 @@ class ReceiveSideCongestionController : public CallStatsObserver {
   ~ReceiveSideCongestionController() override {}
 
   void OnReceivedPacket(const RtpPacketReceived& packet, MediaType media_type);
+  // Same as calling OnReceivedPacket for each of `packets`, but takes each
+  // estimator lock only once for the whole burst. Intended for servers that
+  // read packets from the network in batches.
+  void OnReceivedPackets(rtc::ArrayView<const RtpPacketReceived* const> packets,
+                         MediaType media_type);
 
   // Implements CallStatsObserver.
   void OnRttUpdate(int64_t avg_rtt_ms, int64_t max_rtt_ms) override;
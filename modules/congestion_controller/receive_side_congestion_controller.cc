@@ -10,6 +10,7 @@
 
 #include "modules/congestion_controller/include/receive_side_congestion_controller.h"
 
+#include "absl/container/inlined_vector.h"
 #include "api/media_types.h"
 #include "api/units/data_rate.h"
 #include "modules/pacing/packet_router.h"
@@ -22,6 +23,11 @@ namespace webrtc {
 
 namespace {
 static const uint32_t kTimeOffsetSwitchThreshold = 30;
+
+bool HasTransportSequenceNumber(const RtpPacketReceived& packet) {
+  return packet.HasExtension<TransportSequenceNumber>() ||
+         packet.HasExtension<TransportSequenceNumberV2>();
+}
 }  // namespace
 
 void ReceiveSideCongestionController::OnRttUpdate(int64_t avg_rtt_ms,
@@ -84,9 +90,7 @@ ReceiveSideCongestionController::ReceiveSideCongestionController(
 void ReceiveSideCongestionController::OnReceivedPacket(
     const RtpPacketReceived& packet,
     MediaType media_type) {
-  bool has_transport_sequence_number =
-      packet.HasExtension<TransportSequenceNumber>() ||
-      packet.HasExtension<TransportSequenceNumberV2>();
+  bool has_transport_sequence_number = HasTransportSequenceNumber(packet);
   if (media_type == MediaType::AUDIO && !has_transport_sequence_number) {
     // For audio, we only support send side BWE.
     return;
@@ -103,6 +107,32 @@ void ReceiveSideCongestionController::OnReceivedPacket(
   }
 }
 
+void ReceiveSideCongestionController::OnReceivedPackets(
+    rtc::ArrayView<const RtpPacketReceived* const> packets,
+    MediaType media_type) {
+  absl::InlinedVector<const RtpPacketReceived*, 16> send_side_packets;
+  absl::InlinedVector<const RtpPacketReceived*, 16> receive_side_packets;
+  for (const RtpPacketReceived* packet : packets) {
+    if (HasTransportSequenceNumber(*packet)) {
+      send_side_packets.push_back(packet);
+    } else if (media_type != MediaType::AUDIO) {
+      // For audio, we only support send side BWE.
+      receive_side_packets.push_back(packet);
+    }
+  }
+
+  if (!send_side_packets.empty()) {
+    remote_estimator_proxy_.IncomingPackets(send_side_packets);
+  }
+  if (!receive_side_packets.empty()) {
+    MutexLock lock(&mutex_);
+    for (const RtpPacketReceived* packet : receive_side_packets) {
+      PickEstimator(packet->HasExtension<AbsoluteSendTime>());
+      rbe_->IncomingPacket(*packet);
+    }
+  }
+}
+
 void ReceiveSideCongestionController::OnBitrateChanged(int bitrate_bps) {
   remote_estimator_proxy_.OnBitrateChanged(bitrate_bps);
 }
@@ -33,6 +33,7 @@ using ::testing::_;
 using ::testing::AtLeast;
 using ::testing::ElementsAre;
 using ::testing::MockFunction;
+using ::testing::SizeIs;
 
 constexpr DataRate kInitialBitrate = DataRate::BitsPerSec(60'000);
 
@@ -66,6 +67,38 @@ TEST(ReceiveSideCongestionControllerTest, SendsRembWithAbsSendTime) {
   }
 }
 
+TEST(ReceiveSideCongestionControllerTest,
+     SendsTransportFeedbackForBatchOfPackets) {
+  MockFunction<void(std::vector<std::unique_ptr<rtcp::RtcpPacket>>)>
+      feedback_sender;
+  MockFunction<void(uint64_t, std::vector<uint32_t>)> remb_sender;
+  SimulatedClock clock_(123456);
+
+  ReceiveSideCongestionController controller(
+      &clock_, feedback_sender.AsStdFunction(), remb_sender.AsStdFunction(),
+      nullptr);
+
+  RtpHeaderExtensionMap extensions;
+  extensions.Register<TransportSequenceNumber>(1);
+  std::vector<RtpPacketReceived> packets;
+  std::vector<const RtpPacketReceived*> burst;
+  for (int i = 0; i < 5; ++i) {
+    RtpPacketReceived& packet =
+        packets.emplace_back(&extensions, clock_.CurrentTime());
+    packet.SetSsrc(0x11eb21c);
+    packet.SetExtension<TransportSequenceNumber>(i);
+  }
+  for (const RtpPacketReceived& packet : packets) {
+    burst.push_back(&packet);
+  }
+  controller.OnReceivedPackets(burst, MediaType::VIDEO);
+
+  EXPECT_CALL(feedback_sender, Call(SizeIs(1)));
+  EXPECT_CALL(remb_sender, Call).Times(0);
+  clock_.AdvanceTime(TimeDelta::Seconds(1));
+  controller.MaybeProcess();
+}
+
 TEST(ReceiveSideCongestionControllerTest,
      SendsRembAfterSetMaxDesiredReceiveBitrate) {
   MockFunction<void(std::vector<std::unique_ptr<rtcp::RtcpPacket>>)>
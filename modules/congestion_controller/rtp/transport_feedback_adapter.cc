@@ -27,6 +27,14 @@ namespace webrtc {
 
 constexpr TimeDelta kSendTimeHistoryWindow = TimeDelta::Seconds(60);
 
+namespace {
+// Slots in the history are empty until a packet is added, and after it has
+// been reported as received.
+bool IsEmpty(const PacketFeedback& packet) {
+  return packet.creation_time.IsInfinite();
+}
+}  // namespace
+
 void InFlightBytesTracker::AddInFlightPacketBytes(
     const PacketFeedback& packet) {
   RTC_DCHECK(packet.sent.send_time.IsFinite());
@@ -98,14 +106,31 @@ void TransportFeedbackAdapter::AddPacket(const RtpPacketSendInfo& packet_info,
   packet.sent.pacing_info = packet_info.pacing_info;
 
   while (!history_.empty() &&
-         creation_time - history_.begin()->second.creation_time >
+         creation_time - history_.front().creation_time >
              kSendTimeHistoryWindow) {
     // TODO(sprang): Warn if erasing (too many) old items?
-    if (history_.begin()->second.sent.sequence_number > last_ack_seq_num_)
-      in_flight_.RemoveInFlightPacketBytes(history_.begin()->second);
-    history_.erase(history_.begin());
+    if (history_begin_seq_num_ > last_ack_seq_num_)
+      in_flight_.RemoveInFlightPacketBytes(history_.front());
+    history_.pop_front();
+    ++history_begin_seq_num_;
+    PopEmptyHistoryFront();
   }
-  history_.insert(std::make_pair(packet.sent.sequence_number, packet));
+
+  int64_t seq_num = packet.sent.sequence_number;
+  if (history_.empty()) {
+    history_begin_seq_num_ = seq_num;
+  } else if (seq_num < history_begin_seq_num_) {
+    history_.insert(history_.begin(), history_begin_seq_num_ - seq_num,
+                    PacketFeedback());
+    history_begin_seq_num_ = seq_num;
+  }
+  size_t index = seq_num - history_begin_seq_num_;
+  if (index >= history_.size())
+    history_.resize(index + 1);
+  // Like before, a duplicate sequence number does not replace the packet
+  // already in the history.
+  if (IsEmpty(history_[index]))
+    history_[index] = packet;
 }
 
 absl::optional<SentPacket> TransportFeedbackAdapter::ProcessSentPacket(
@@ -115,10 +140,9 @@ absl::optional<SentPacket> TransportFeedbackAdapter::ProcessSentPacket(
   if (sent_packet.info.included_in_feedback || sent_packet.packet_id != -1) {
     int64_t unwrapped_seq_num =
         seq_num_unwrapper_.Unwrap(sent_packet.packet_id);
-    auto it = history_.find(unwrapped_seq_num);
-    if (it != history_.end()) {
-      bool packet_retransmit = it->second.sent.send_time.IsFinite();
-      it->second.sent.send_time = send_time;
+    if (PacketFeedback* packet = FindInHistory(unwrapped_seq_num)) {
+      bool packet_retransmit = packet->sent.send_time.IsFinite();
+      packet->sent.send_time = send_time;
       last_send_time_ = std::max(last_send_time_, send_time);
       // TODO(srte): Don't do this on retransmit.
       if (!pending_untracked_size_.IsZero()) {
@@ -126,14 +150,14 @@ absl::optional<SentPacket> TransportFeedbackAdapter::ProcessSentPacket(
           RTC_LOG(LS_WARNING)
               << "appending acknowledged data for out of order packet. (Diff: "
               << ToString(last_untracked_send_time_ - send_time) << " ms.)";
-        it->second.sent.prior_unacked_data += pending_untracked_size_;
+        packet->sent.prior_unacked_data += pending_untracked_size_;
         pending_untracked_size_ = DataSize::Zero();
       }
       if (!packet_retransmit) {
-        if (it->second.sent.sequence_number > last_ack_seq_num_)
-          in_flight_.AddInFlightPacketBytes(it->second);
-        it->second.sent.data_in_flight = GetOutstandingData();
-        return it->second.sent;
+        if (packet->sent.sequence_number > last_ack_seq_num_)
+          in_flight_.AddInFlightPacketBytes(*packet);
+        packet->sent.data_in_flight = GetOutstandingData();
+        return packet->sent;
       }
     }
   } else if (sent_packet.info.included_in_allocation) {
@@ -165,9 +189,8 @@ TransportFeedbackAdapter::ProcessTransportFeedback(
   if (msg.packet_feedbacks.empty())
     return absl::nullopt;
 
-  auto it = history_.find(last_ack_seq_num_);
-  if (it != history_.end()) {
-    msg.first_unacked_send_time = it->second.sent.send_time;
+  if (const PacketFeedback* packet = FindInHistory(last_ack_seq_num_)) {
+    msg.first_unacked_send_time = packet->sent.send_time;
   }
   msg.data_in_flight = in_flight_.GetOutstandingData(network_route_);
 
@@ -183,6 +206,23 @@ DataSize TransportFeedbackAdapter::GetOutstandingData() const {
   return in_flight_.GetOutstandingData(network_route_);
 }
 
+PacketFeedback* TransportFeedbackAdapter::FindInHistory(int64_t seq_num) {
+  if (seq_num < history_begin_seq_num_ ||
+      seq_num - history_begin_seq_num_ >=
+          static_cast<int64_t>(history_.size())) {
+    return nullptr;
+  }
+  PacketFeedback& packet = history_[seq_num - history_begin_seq_num_];
+  return IsEmpty(packet) ? nullptr : &packet;
+}
+
+void TransportFeedbackAdapter::PopEmptyHistoryFront() {
+  while (!history_.empty() && IsEmpty(history_.front())) {
+    history_.pop_front();
+    ++history_begin_seq_num_;
+  }
+}
+
 std::vector<PacketResult>
 TransportFeedbackAdapter::ProcessTransportFeedbackInner(
     const rtcp::TransportFeedback& feedback,
@@ -217,22 +257,26 @@ TransportFeedbackAdapter::ProcessTransportFeedbackInner(
         int64_t seq_num = seq_num_unwrapper_.Unwrap(sequence_number);
 
         if (seq_num > last_ack_seq_num_) {
-          // Starts at history_.begin() if last_ack_seq_num_ < 0, since any
-          // valid sequence number is >= 0.
-          for (auto it = history_.upper_bound(last_ack_seq_num_);
-               it != history_.upper_bound(seq_num); ++it) {
-            in_flight_.RemoveInFlightPacketBytes(it->second);
+          // Empty slots have an infinite send time and are ignored by
+          // RemoveInFlightPacketBytes.
+          int64_t history_end_seq_num =
+              history_begin_seq_num_ + static_cast<int64_t>(history_.size());
+          for (int64_t i =
+                   std::max(last_ack_seq_num_ + 1, history_begin_seq_num_);
+               i <= seq_num && i < history_end_seq_num; ++i) {
+            in_flight_.RemoveInFlightPacketBytes(
+                history_[i - history_begin_seq_num_]);
           }
           last_ack_seq_num_ = seq_num;
         }
 
-        auto it = history_.find(seq_num);
-        if (it == history_.end()) {
+        PacketFeedback* packet = FindInHistory(seq_num);
+        if (packet == nullptr) {
           ++failed_lookups;
           return;
         }
 
-        if (it->second.sent.send_time.IsInfinite()) {
+        if (packet->sent.send_time.IsInfinite()) {
           // TODO(srte): Fix the tests that makes this happen and make this a
           // DCHECK.
           RTC_DLOG(LS_ERROR)
@@ -240,14 +284,15 @@ TransportFeedbackAdapter::ProcessTransportFeedbackInner(
           return;
         }
 
-        PacketFeedback packet_feedback = it->second;
+        PacketFeedback packet_feedback = *packet;
         if (delta_since_base.IsFinite()) {
           packet_feedback.receive_time =
               current_offset_ +
               delta_since_base.RoundDownTo(TimeDelta::Millis(1));
           // Note: Lost packets are not removed from history because they might
           // be reported as received by a later feedback.
-          history_.erase(it);
+          *packet = PacketFeedback();
+          PopEmptyHistoryFront();
         }
         if (packet_feedback.network_route == network_route_) {
           PacketResult result;
@@ -80,11 +80,21 @@ class TransportFeedbackAdapter {
       const rtcp::TransportFeedback& feedback,
       Timestamp feedback_receive_time);
 
+  // Returns the packet with unwrapped sequence number `seq_num`, or nullptr if
+  // it is not in the history.
+  PacketFeedback* FindInHistory(int64_t seq_num);
+  // Drops empty slots from the front of `history_`.
+  void PopEmptyHistoryFront();
+
   DataSize pending_untracked_size_ = DataSize::Zero();
   Timestamp last_send_time_ = Timestamp::MinusInfinity();
   Timestamp last_untracked_send_time_ = Timestamp::MinusInfinity();
   RtpSequenceNumberUnwrapper seq_num_unwrapper_;
-  std::map<int64_t, PacketFeedback> history_;
+  // Packets indexed by unwrapped transport sequence number, starting at
+  // `history_begin_seq_num_`. Sequence numbers are assigned in send order, so
+  // packets are appended at the back and expire from the front.
+  std::deque<PacketFeedback> history_;
+  int64_t history_begin_seq_num_ = 0;
 
   // Sequence numbers are never negative, using -1 as it always < a real
   // sequence number.
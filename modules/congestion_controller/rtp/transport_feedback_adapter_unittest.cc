@@ -178,6 +178,43 @@ TEST_F(TransportFeedbackAdapterTest, FeedbackVectorReportsUnreceived) {
   ComparePacketFeedbackVectors(sent_packets, res->packet_feedbacks);
 }
 
+TEST_F(TransportFeedbackAdapterTest, LostPacketCanBeReportedReceivedLater) {
+  std::vector<PacketResult> sent_packets = {
+      CreatePacket(100, 200, 0, 1500, kPacingInfo0),
+      CreatePacket(110, 210, 1, 1500, kPacingInfo0),
+      CreatePacket(120, 220, 2, 1500, kPacingInfo0)};
+  for (const auto& packet : sent_packets)
+    OnSentPacket(packet);
+  EXPECT_EQ(adapter_->GetOutstandingData(), DataSize::Bytes(3 * 1500));
+
+  rtcp::TransportFeedback feedback;
+  feedback.SetBase(0, sent_packets[0].receive_time);
+  EXPECT_TRUE(feedback.AddReceivedPacket(0, sent_packets[0].receive_time));
+  EXPECT_TRUE(feedback.AddReceivedPacket(2, sent_packets[2].receive_time));
+  feedback.Build();
+  auto res = adapter_->ProcessTransportFeedback(feedback, clock_.CurrentTime());
+  ASSERT_TRUE(res);
+  ASSERT_EQ(res->packet_feedbacks.size(), 3u);
+  EXPECT_FALSE(res->packet_feedbacks[1].IsReceived());
+  EXPECT_EQ(adapter_->GetOutstandingData(), DataSize::Zero());
+
+  rtcp::TransportFeedback late_feedback;
+  late_feedback.SetBase(1, sent_packets[1].receive_time);
+  EXPECT_TRUE(
+      late_feedback.AddReceivedPacket(1, sent_packets[1].receive_time));
+  late_feedback.Build();
+  res = adapter_->ProcessTransportFeedback(late_feedback, clock_.CurrentTime());
+  ASSERT_TRUE(res);
+  ASSERT_EQ(res->packet_feedbacks.size(), 1u);
+  EXPECT_TRUE(res->packet_feedbacks[0].IsReceived());
+  EXPECT_EQ(res->packet_feedbacks[0].sent_packet.send_time,
+            sent_packets[1].sent_packet.send_time);
+
+  // Packets already reported as received are no longer in the history.
+  res = adapter_->ProcessTransportFeedback(late_feedback, clock_.CurrentTime());
+  EXPECT_FALSE(res);
+}
+
 TEST_F(TransportFeedbackAdapterTest, HandlesDroppedPackets) {
   std::vector<PacketResult> packets;
   packets.push_back(CreatePacket(100, 200, 0, 1500, kPacingInfo0));
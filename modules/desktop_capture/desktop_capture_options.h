@@ -105,6 +105,14 @@ class RTC_EXPORT DesktopCaptureOptions {
     detect_updated_region_ = detect_updated_region;
   }
 
+  // Maximum number of threads, including the capture thread, that compare
+  // large frames when detect_updated_region() is set. Each thread compares a
+  // horizontal stripe of the frame.
+  int max_differ_threads() const { return max_differ_threads_; }
+  void set_max_differ_threads(int max_differ_threads) {
+    max_differ_threads_ = max_differ_threads;
+  }
+
   // Indicates that the capturer should try to include the cursor in the frame.
   // If it is able to do so it will set `DesktopFrame::may_contain_cursor()`.
   // Not all capturers will support including the cursor. If this value is false
@@ -142,6 +150,19 @@ class RTC_EXPORT DesktopCaptureOptions {
     allow_directx_capturer_ = enabled;
   }
 
+  // Makes the DirectX capturer export monitors as D3D11 textures, see
+  // DxgiTextureDesktopFrame, instead of reading them back into the pixels of
+  // the DesktopFrame. Meant for consumers feeding a hardware encoder, which
+  // can then skip the copy to and from the CPU. The entire desktop, rotated
+  // monitors and adapters that keep the desktop in system memory are still
+  // read back.
+  bool allow_directx_texture_passthrough() const {
+    return allow_directx_texture_passthrough_;
+  }
+  void set_allow_directx_texture_passthrough(bool allow) {
+    allow_directx_texture_passthrough_ = allow;
+  }
+
   // Flag that may be set to allow use of the cropping window capturer (which
   // captures the screen & crops that to the window region in some cases). An
   // advantage of using this is significantly higher capture frame rates than
@@ -242,6 +263,7 @@ class RTC_EXPORT DesktopCaptureOptions {
 #if defined(WEBRTC_WIN)
   bool enumerate_current_process_windows_ = true;
   bool allow_directx_capturer_ = false;
+  bool allow_directx_texture_passthrough_ = false;
   bool allow_cropping_window_capturer_ = false;
 #if defined(RTC_ENABLE_WIN_WGC)
   bool allow_wgc_screen_capturer_ = false;
@@ -257,6 +279,7 @@ class RTC_EXPORT DesktopCaptureOptions {
 #endif
   bool disable_effects_ = true;
   bool detect_updated_region_ = false;
+  int max_differ_threads_ = 1;
   bool prefer_cursor_embedded_ = false;
 #if defined(WEBRTC_USE_PIPEWIRE)
   bool allow_pipewire_ = false;
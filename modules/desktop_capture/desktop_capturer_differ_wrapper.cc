@@ -13,12 +13,17 @@
 #include <stdint.h>
 #include <string.h>
 
+#include <algorithm>
 #include <utility>
+#include <vector>
 
+#include "api/function_view.h"
 #include "modules/desktop_capture/desktop_geometry.h"
 #include "modules/desktop_capture/desktop_region.h"
 #include "modules/desktop_capture/differ_block.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
 #include "rtc_base/time_utils.h"
 
 namespace webrtc {
@@ -109,44 +114,115 @@ void CompareRow(const uint8_t* old_buffer,
   }
 }
 
-// Compares `rect` area in `old_frame` and `new_frame`, and outputs dirty
-// regions into `output`.
-void CompareFrames(const DesktopFrame& old_frame,
-                   const DesktopFrame& new_frame,
-                   DesktopRect rect,
-                   DesktopRegion* const output) {
-  RTC_DCHECK(old_frame.size().equals(new_frame.size()));
-  RTC_DCHECK_EQ(old_frame.stride(), new_frame.stride());
-  rect.IntersectWith(DesktopRect::MakeSize(old_frame.size()));
+// Areas smaller than this are compared on a single thread, as handing them to
+// other threads costs more than it saves.
+constexpr int kMinPixelsPerStripe = 1024 * 1024;
 
-  const int y_block_count = (rect.height() - 1) / kBlockSize;
-  const int last_y_block_height = rect.height() - y_block_count * kBlockSize;
+// Compares block-rows in the range of [`first_y_block`, `end_y_block`) of the
+// `rect` area in `old_frame` and `new_frame`, and outputs dirty regions into
+// `output`. `rect` must be inside both frames.
+void CompareBlockRows(const DesktopFrame& old_frame,
+                      const DesktopFrame& new_frame,
+                      const DesktopRect& rect,
+                      int first_y_block,
+                      int end_y_block,
+                      DesktopRegion* const output) {
   // Offset from the start of one block-row to the next.
   const int block_y_stride = old_frame.stride() * kBlockSize;
   const uint8_t* prev_block_row_start =
-      old_frame.GetFrameDataAtPos(rect.top_left());
+      old_frame.GetFrameDataAtPos(rect.top_left()) +
+      first_y_block * block_y_stride;
   const uint8_t* curr_block_row_start =
-      new_frame.GetFrameDataAtPos(rect.top_left());
+      new_frame.GetFrameDataAtPos(rect.top_left()) +
+      first_y_block * block_y_stride;
 
-  int top = rect.top();
-  // The last row may have a different height, so we handle it separately.
-  for (int y = 0; y < y_block_count; y++) {
+  // The last row may have a different height.
+  for (int y = first_y_block; y < end_y_block; y++) {
+    const int top = rect.top() + y * kBlockSize;
+    const int bottom = std::min(top + kBlockSize, rect.bottom());
     CompareRow(prev_block_row_start, curr_block_row_start, rect.left(),
-               rect.right(), top, top + kBlockSize, old_frame.stride(), output);
-    top += kBlockSize;
+               rect.right(), top, bottom, old_frame.stride(), output);
     prev_block_row_start += block_y_stride;
     curr_block_row_start += block_y_stride;
   }
-  CompareRow(prev_block_row_start, curr_block_row_start, rect.left(),
-             rect.right(), top, top + last_y_block_height, old_frame.stride(),
-             output);
 }
 
 }  // namespace
 
+// Threads that compare stripes of a frame together with the capture thread.
+// Each worker thread waits for its start event, compares its stripes and
+// signals its done event.
+class DesktopCapturerDifferWrapper::DiffWorkers {
+ public:
+  explicit DiffWorkers(int num_threads) {
+    RTC_DCHECK_GT(num_threads, 1);
+    for (int i = 1; i < num_threads; ++i) {
+      workers_.push_back(std::make_unique<Worker>());
+      workers_.back()->thread = rtc::PlatformThread::SpawnJoinable(
+          [this, i] { WorkerLoop(i); }, "DesktopDiffWorker",
+          rtc::ThreadAttributes().SetPriority(rtc::ThreadPriority::kHigh));
+    }
+  }
+
+  ~DiffWorkers() {
+    stop_ = true;
+    for (auto& worker : workers_) {
+      worker->start.Set();
+      worker->thread.Finalize();
+    }
+  }
+
+  int num_threads() const { return static_cast<int>(workers_.size()) + 1; }
+
+  // Runs `job(i)` for all i in [0, `num_jobs`) and returns when all are done.
+  // Job i runs on thread i % num_threads(), where thread 0 is the caller.
+  void Run(int num_jobs, rtc::FunctionView<void(int)> job) {
+    num_jobs_ = num_jobs;
+    job_ = job;
+    int num_workers = std::min(num_jobs, num_threads()) - 1;
+    for (int i = 0; i < num_workers; ++i)
+      workers_[i]->start.Set();
+    RunJobs(/*thread_index=*/0);
+    for (int i = 0; i < num_workers; ++i)
+      workers_[i]->done.Wait(rtc::Event::kForever);
+  }
+
+ private:
+  struct Worker {
+    rtc::Event start;
+    rtc::Event done;
+    rtc::PlatformThread thread;
+  };
+
+  void RunJobs(int thread_index) {
+    for (int i = thread_index; i < num_jobs_; i += num_threads())
+      job_(i);
+  }
+
+  void WorkerLoop(int thread_index) {
+    Worker& worker = *workers_[thread_index - 1];
+    while (true) {
+      worker.start.Wait(rtc::Event::kForever);
+      if (stop_)
+        return;
+      RunJobs(thread_index);
+      worker.done.Set();
+    }
+  }
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  // Written before the start events are set, read by the worker threads.
+  int num_jobs_ = 0;
+  rtc::FunctionView<void(int)> job_;
+  bool stop_ = false;
+};
+
 DesktopCapturerDifferWrapper::DesktopCapturerDifferWrapper(
-    std::unique_ptr<DesktopCapturer> base_capturer)
-    : base_capturer_(std::move(base_capturer)) {
+    std::unique_ptr<DesktopCapturer> base_capturer,
+    int max_threads)
+    : base_capturer_(std::move(base_capturer)),
+      diff_workers_(max_threads > 1 ? std::make_unique<DiffWorkers>(max_threads)
+                                    : nullptr) {
   RTC_DCHECK(base_capturer_);
 }
 
@@ -192,6 +268,45 @@ DesktopCaptureMetadata DesktopCapturerDifferWrapper::GetMetadata() {
 }
 #endif  // defined(WEBRTC_USE_GIO)
 
+void DesktopCapturerDifferWrapper::CompareFrames(
+    const DesktopFrame& old_frame,
+    const DesktopFrame& new_frame,
+    DesktopRect rect,
+    DesktopRegion* const output) {
+  RTC_DCHECK(old_frame.size().equals(new_frame.size()));
+  RTC_DCHECK_EQ(old_frame.stride(), new_frame.stride());
+  rect.IntersectWith(DesktopRect::MakeSize(old_frame.size()));
+  if (rect.is_empty()) {
+    return;
+  }
+
+  const int y_block_count = (rect.height() - 1) / kBlockSize + 1;
+  int num_stripes = 1;
+  if (diff_workers_) {
+    const int64_t pixels = static_cast<int64_t>(rect.width()) * rect.height();
+    num_stripes = static_cast<int>(std::min<int64_t>(
+        {diff_workers_->num_threads(), y_block_count,
+         pixels / kMinPixelsPerStripe}));
+  }
+  if (num_stripes <= 1) {
+    CompareBlockRows(old_frame, new_frame, rect, 0, y_block_count, output);
+    return;
+  }
+
+  // Each stripe collects its dirty regions separately. They are merged after
+  // all stripes have been compared.
+  std::vector<DesktopRegion> stripe_regions(num_stripes);
+  diff_workers_->Run(num_stripes, [&](int stripe) {
+    CompareBlockRows(old_frame, new_frame, rect,
+                     y_block_count * stripe / num_stripes,
+                     y_block_count * (stripe + 1) / num_stripes,
+                     &stripe_regions[stripe]);
+  });
+  for (const DesktopRegion& region : stripe_regions) {
+    output->AddRegion(region);
+  }
+}
+
 void DesktopCapturerDifferWrapper::OnCaptureResult(
     Result result,
     std::unique_ptr<DesktopFrame> input_frame) {
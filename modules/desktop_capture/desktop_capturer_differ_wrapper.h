@@ -33,14 +33,19 @@ namespace webrtc {
 //
 // This class marks entire frame as updated if the frame size or frame stride
 // has been changed.
+//
+// Large frames may be compared by several threads, each comparing a stripe of
+// block-rows.
 class RTC_EXPORT DesktopCapturerDifferWrapper
     : public DesktopCapturer,
       public DesktopCapturer::Callback {
  public:
   // Creates a DesktopCapturerDifferWrapper with a DesktopCapturer
-  // implementation, and takes its ownership.
+  // implementation, and takes its ownership. Frames are compared on up to
+  // `max_threads` threads, including the capture thread.
   explicit DesktopCapturerDifferWrapper(
-      std::unique_ptr<DesktopCapturer> base_capturer);
+      std::unique_ptr<DesktopCapturer> base_capturer,
+      int max_threads = 1);
 
   ~DesktopCapturerDifferWrapper() override;
 
@@ -58,13 +63,25 @@ class RTC_EXPORT DesktopCapturerDifferWrapper
   DesktopCaptureMetadata GetMetadata() override;
 #endif  // defined(WEBRTC_USE_GIO)
  private:
+  class DiffWorkers;
+
   // DesktopCapturer::Callback interface.
   void OnCaptureResult(Result result,
                        std::unique_ptr<DesktopFrame> frame) override;
 
+  // Compares `rect` area in `old_frame` and `new_frame`, and outputs dirty
+  // regions into `output`. Large areas are split into stripes of block-rows
+  // compared on `diff_workers_`, if any.
+  void CompareFrames(const DesktopFrame& old_frame,
+                     const DesktopFrame& new_frame,
+                     DesktopRect rect,
+                     DesktopRegion* output);
+
   const std::unique_ptr<DesktopCapturer> base_capturer_;
   DesktopCapturer::Callback* callback_;
   std::unique_ptr<SharedDesktopFrame> last_frame_;
+  // Null if frames are compared on the capture thread only.
+  const std::unique_ptr<DiffWorkers> diff_workers_;
 };
 
 }  // namespace webrtc
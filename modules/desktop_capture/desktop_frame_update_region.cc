@@ -0,0 +1,42 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/desktop_capture/desktop_frame_update_region.h"
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+std::vector<VideoFrame::UpdateRect> ToVideoFrameUpdateRegion(
+    const DesktopRegion& region,
+    const DesktopSize& frame_size) {
+  const DesktopRect frame_rect = DesktopRect::MakeSize(frame_size);
+  std::vector<VideoFrame::UpdateRect> update_region;
+  for (DesktopRegion::Iterator it(region); !it.IsAtEnd(); it.Advance()) {
+    DesktopRect rect = it.rect();
+    rect.IntersectWith(frame_rect);
+    if (rect.is_empty()) {
+      continue;
+    }
+    update_region.push_back(VideoFrame::UpdateRect{
+        rect.left(), rect.top(), rect.width(), rect.height()});
+  }
+  return update_region;
+}
+
+void SetUpdateRegionFromDesktopFrame(const DesktopFrame& frame,
+                                     VideoFrame& video_frame) {
+  RTC_DCHECK_EQ(frame.size().width(), video_frame.width());
+  RTC_DCHECK_EQ(frame.size().height(), video_frame.height());
+  video_frame.set_update_region(
+      ToVideoFrameUpdateRegion(frame.updated_region(), frame.size()));
+}
+
+}  // namespace webrtc
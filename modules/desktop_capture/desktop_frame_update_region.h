@@ -0,0 +1,36 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_DESKTOP_CAPTURE_DESKTOP_FRAME_UPDATE_REGION_H_
+#define MODULES_DESKTOP_CAPTURE_DESKTOP_FRAME_UPDATE_REGION_H_
+
+#include <vector>
+
+#include "api/video/video_frame.h"
+#include "modules/desktop_capture/desktop_frame.h"
+#include "modules/desktop_capture/desktop_region.h"
+#include "rtc_base/system/rtc_export.h"
+
+namespace webrtc {
+
+// Converts `region`, clipped to a frame of `frame_size`, to rectangles for
+// VideoFrame::set_update_region().
+RTC_EXPORT std::vector<VideoFrame::UpdateRect> ToVideoFrameUpdateRegion(
+    const DesktopRegion& region,
+    const DesktopSize& frame_size);
+
+// Sets the update region of `video_frame` to the updated_region() of `frame`,
+// which the video frame was converted from and has the same size as.
+RTC_EXPORT void SetUpdateRegionFromDesktopFrame(const DesktopFrame& frame,
+                                                VideoFrame& video_frame);
+
+}  // namespace webrtc
+
+#endif  // MODULES_DESKTOP_CAPTURE_DESKTOP_FRAME_UPDATE_REGION_H_
@@ -0,0 +1,65 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/desktop_capture/desktop_frame_update_region.h"
+
+#include "api/video/i420_buffer.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+using UpdateRect = VideoFrame::UpdateRect;
+
+TEST(DesktopFrameUpdateRegionTest, ConvertsEachRect) {
+  DesktopRegion region;
+  region.AddRect(DesktopRect::MakeLTRB(0, 0, 10, 10));
+  region.AddRect(DesktopRect::MakeLTRB(50, 20, 60, 40));
+
+  EXPECT_THAT(
+      ToVideoFrameUpdateRegion(region, DesktopSize(100, 100)),
+      ElementsAre(UpdateRect{0, 0, 10, 10}, UpdateRect{50, 20, 10, 20}));
+}
+
+TEST(DesktopFrameUpdateRegionTest, ClipsToFrame) {
+  DesktopRegion region;
+  region.AddRect(DesktopRect::MakeLTRB(90, 90, 120, 120));
+  region.AddRect(DesktopRect::MakeLTRB(200, 0, 210, 10));
+
+  EXPECT_THAT(ToVideoFrameUpdateRegion(region, DesktopSize(100, 100)),
+              ElementsAre(UpdateRect{90, 90, 10, 10}));
+}
+
+TEST(DesktopFrameUpdateRegionTest, SetsVideoFrameUpdateRegion) {
+  BasicDesktopFrame frame(DesktopSize(64, 48));
+  frame.mutable_updated_region()->AddRect(DesktopRect::MakeLTRB(0, 0, 8, 8));
+  frame.mutable_updated_region()->AddRect(
+      DesktopRect::MakeLTRB(32, 40, 64, 48));
+  VideoFrame video_frame =
+      VideoFrame::Builder()
+          .set_video_frame_buffer(I420Buffer::Create(64, 48))
+          .build();
+
+  SetUpdateRegionFromDesktopFrame(frame, video_frame);
+
+  EXPECT_THAT(video_frame.update_region(),
+              ElementsAre(UpdateRect{0, 0, 8, 8}, UpdateRect{32, 40, 32, 8}));
+  EXPECT_EQ(video_frame.update_rect(), (UpdateRect{0, 0, 64, 48}));
+
+  video_frame.clear_update_rect();
+  EXPECT_THAT(video_frame.update_region(), IsEmpty());
+}
+
+}  // namespace
+}  // namespace webrtc
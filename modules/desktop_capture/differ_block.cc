@@ -18,7 +18,10 @@
 // This needs to be after rtc_base/system/arch.h which defines
 // architecture macros.
 #if defined(WEBRTC_ARCH_X86_FAMILY)
+#include "modules/desktop_capture/differ_vector_avx2.h"
 #include "modules/desktop_capture/differ_vector_sse2.h"
+#elif defined(WEBRTC_HAS_NEON)
+#include "modules/desktop_capture/differ_vector_neon.h"
 #endif
 
 namespace webrtc {
@@ -36,18 +39,23 @@ bool VectorDifference(const uint8_t* image1, const uint8_t* image2) {
 
   if (!diff_proc) {
 #if defined(WEBRTC_ARCH_X86_FAMILY)
+    bool have_avx2 = GetCPUInfo(kAVX2) != 0;
     bool have_sse2 = GetCPUInfo(kSSE2) != 0;
-    // For x86 processors, check if SSE2 is supported.
-    if (have_sse2 && kBlockSize == 32) {
+    // For x86 processors, prefer AVX2 and fall back to SSE2.
+    if (have_avx2 && kBlockSize == 32) {
+      diff_proc = &VectorDifference_AVX2_W32;
+    } else if (have_sse2 && kBlockSize == 32) {
       diff_proc = &VectorDifference_SSE2_W32;
     } else if (have_sse2 && kBlockSize == 16) {
       diff_proc = &VectorDifference_SSE2_W16;
     } else {
       diff_proc = &VectorDifference_C;
     }
+#elif defined(WEBRTC_HAS_NEON)
+    diff_proc =
+        kBlockSize == 32 ? &VectorDifference_NEON_W32 : &VectorDifference_C;
 #else
     // For other processors, always use C version.
-    // TODO(hclam): Implement a NEON version.
     diff_proc = &VectorDifference_C;
 #endif
   }
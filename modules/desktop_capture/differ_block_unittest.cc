@@ -86,4 +86,19 @@ TEST(BlockDifferenceTestFirst, BlockDifference) {
   }
 }
 
+TEST(VectorDifferenceTest, DetectsDifferenceInEachByte) {
+  uint8_t* block1;
+  uint8_t* block2;
+  PrepareBuffers(block1, block2);
+  // Unaligned vectors are compared too.
+  for (int offset : {0, 1}) {
+    EXPECT_FALSE(VectorDifference(block1 + offset, block2 + offset));
+    for (int i = 0; i < kBlockSize * kBytesPerPixel; ++i) {
+      block2[offset + i] += 1;
+      EXPECT_TRUE(VectorDifference(block1 + offset, block2 + offset)) << i;
+      block2[offset + i] -= 1;
+    }
+  }
+}
+
 }  // namespace webrtc
@@ -0,0 +1,29 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/desktop_capture/differ_vector_neon.h"
+
+#include <arm_neon.h>
+
+namespace webrtc {
+
+extern bool VectorDifference_NEON_W32(const uint8_t* image1,
+                                      const uint8_t* image2) {
+  // 32 pixels of 4 bytes, compared 16 bytes at a time. Only whether any byte
+  // differs matters, so the differences are OR-ed rather than summed.
+  uint8x16_t acc = veorq_u8(vld1q_u8(image1), vld1q_u8(image2));
+  for (int i = 16; i < 128; i += 16) {
+    acc = vorrq_u8(acc, veorq_u8(vld1q_u8(image1 + i), vld1q_u8(image2 + i)));
+  }
+  uint64x2_t acc64 = vreinterpretq_u64_u8(acc);
+  return (vgetq_lane_u64(acc64, 0) | vgetq_lane_u64(acc64, 1)) != 0;
+}
+
+}  // namespace webrtc
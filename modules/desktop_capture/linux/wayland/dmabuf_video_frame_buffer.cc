@@ -0,0 +1,139 @@
+/*
+ *  Copyright 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/desktop_capture/linux/wayland/dmabuf_video_frame_buffer.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <spa/param/video/raw.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <utility>
+
+#include "api/make_ref_counted.h"
+#include "api/video/i420_buffer.h"
+#include "modules/desktop_capture/linux/wayland/egl_dmabuf.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "third_party/libyuv/include/libyuv/convert.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr int kBytesPerPixel = 4;
+
+void ClosePlanes(const std::vector<DmaBufVideoFrameBuffer::Plane>& planes) {
+  for (const DmaBufVideoFrameBuffer::Plane& plane : planes) {
+    close(plane.fd);
+  }
+}
+
+}  // namespace
+
+// static
+rtc::scoped_refptr<DmaBufVideoFrameBuffer> DmaBufVideoFrameBuffer::Create(
+    std::shared_ptr<EglDmaBuf> egl_dmabuf,
+    uint32_t spa_format,
+    uint64_t modifier,
+    const DesktopSize& stream_size,
+    const DesktopRect& crop,
+    const std::vector<Plane>& planes,
+    absl::AnyInvocable<void() &&> release_callback) {
+  RTC_DCHECK(egl_dmabuf);
+  RTC_DCHECK(!planes.empty());
+  std::vector<Plane> owned_planes;
+  owned_planes.reserve(planes.size());
+  for (const Plane& plane : planes) {
+    const int fd = fcntl(plane.fd, F_DUPFD_CLOEXEC, 0);
+    if (fd < 0) {
+      RTC_LOG(LS_ERROR) << "Failed to duplicate DMA-BUF file descriptor: "
+                        << std::strerror(errno);
+      ClosePlanes(owned_planes);
+      return nullptr;
+    }
+    owned_planes.push_back({fd, plane.stride, plane.offset});
+  }
+  return rtc::make_ref_counted<DmaBufVideoFrameBuffer>(
+      std::move(egl_dmabuf), spa_format, modifier, stream_size, crop,
+      std::move(owned_planes), std::move(release_callback));
+}
+
+DmaBufVideoFrameBuffer::DmaBufVideoFrameBuffer(
+    std::shared_ptr<EglDmaBuf> egl_dmabuf,
+    uint32_t spa_format,
+    uint64_t modifier,
+    const DesktopSize& stream_size,
+    const DesktopRect& crop,
+    std::vector<Plane> planes,
+    absl::AnyInvocable<void() &&> release_callback)
+    : egl_dmabuf_(std::move(egl_dmabuf)),
+      spa_format_(spa_format),
+      modifier_(modifier),
+      stream_size_(stream_size),
+      crop_(crop),
+      planes_(std::move(planes)),
+      release_callback_(std::move(release_callback)) {}
+
+DmaBufVideoFrameBuffer::~DmaBufVideoFrameBuffer() {
+  ClosePlanes(planes_);
+  if (release_callback_) {
+    std::move(release_callback_)();
+  }
+}
+
+VideoFrameBuffer::Type DmaBufVideoFrameBuffer::type() const {
+  return Type::kNative;
+}
+
+int DmaBufVideoFrameBuffer::width() const {
+  return crop_.width();
+}
+
+int DmaBufVideoFrameBuffer::height() const {
+  return crop_.height();
+}
+
+uint32_t DmaBufVideoFrameBuffer::drm_format() const {
+  return SpaPixelFormatToDrmFormat(spa_format_);
+}
+
+rtc::scoped_refptr<I420BufferInterface> DmaBufVideoFrameBuffer::ToI420() {
+  std::vector<EglDmaBuf::PlaneData> plane_datas;
+  plane_datas.reserve(planes_.size());
+  for (const Plane& plane : planes_) {
+    plane_datas.push_back({plane.fd, plane.stride, plane.offset});
+  }
+
+  const int stride = width() * kBytesPerPixel;
+  std::unique_ptr<uint8_t[]> pixels(new uint8_t[stride * height()]);
+  if (!egl_dmabuf_->ImageFromDmaBuf(stream_size_, spa_format_, plane_datas,
+                                    modifier_, crop_.top_left(), crop_.size(),
+                                    pixels.get())) {
+    RTC_LOG(LS_ERROR) << "Failed to read back DMA-BUF frame";
+    return nullptr;
+  }
+
+  rtc::scoped_refptr<I420Buffer> i420_buffer =
+      I420Buffer::Create(width(), height());
+  // The pixels are read back in the byte order of the DMA-BUF. RGBx in memory
+  // is what libyuv calls ABGR, and BGRx is what it calls ARGB.
+  const bool is_rgb = spa_format_ == SPA_VIDEO_FORMAT_RGBx ||
+                      spa_format_ == SPA_VIDEO_FORMAT_RGBA;
+  const auto convert = is_rgb ? libyuv::ABGRToI420 : libyuv::ARGBToI420;
+  convert(pixels.get(), stride, i420_buffer->MutableDataY(),
+          i420_buffer->StrideY(), i420_buffer->MutableDataU(),
+          i420_buffer->StrideU(), i420_buffer->MutableDataV(),
+          i420_buffer->StrideV(), width(), height());
+  return i420_buffer;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,98 @@
+/*
+ *  Copyright 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_DESKTOP_CAPTURE_LINUX_WAYLAND_DMABUF_VIDEO_FRAME_BUFFER_H_
+#define MODULES_DESKTOP_CAPTURE_LINUX_WAYLAND_DMABUF_VIDEO_FRAME_BUFFER_H_
+
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "absl/functional/any_invocable.h"
+#include "api/scoped_refptr.h"
+#include "api/video/video_frame_buffer.h"
+#include "modules/desktop_capture/desktop_geometry.h"
+#include "rtc_base/system/rtc_export.h"
+
+namespace webrtc {
+
+class EglDmaBuf;
+
+// A frame captured from PipeWire into a DMA-BUF, exposed without copying the
+// pixels to CPU memory. Encoders that can import DMA-BUFs (e.g. through
+// VA-API) check for type() == kNative, downcast and use the planes directly.
+// Everyone else gets the pixels through ToI420(), which reads the DMA-BUF back
+// using EGL.
+//
+// The buffer keeps the PipeWire buffer it was captured into, so the
+// compositor doesn't draw the next frame into it while it's in use. Holding
+// on to too many of them stalls the stream.
+class RTC_EXPORT DmaBufVideoFrameBuffer : public VideoFrameBuffer {
+ public:
+  struct Plane {
+    // Owned by the frame buffer, and closed when it's destroyed.
+    int fd;
+    uint32_t stride;
+    uint32_t offset;
+  };
+
+  // Duplicates the file descriptors of `planes`, so that they stay valid
+  // after PipeWire drops the buffer. `crop` is the part of the
+  // `stream_size` DMA-BUF that holds the frame. `release_callback` is run
+  // when the frame buffer is destroyed. Returns nullptr if the file
+  // descriptors can't be duplicated.
+  static rtc::scoped_refptr<DmaBufVideoFrameBuffer> Create(
+      std::shared_ptr<EglDmaBuf> egl_dmabuf,
+      uint32_t spa_format,
+      uint64_t modifier,
+      const DesktopSize& stream_size,
+      const DesktopRect& crop,
+      const std::vector<Plane>& planes,
+      absl::AnyInvocable<void() &&> release_callback);
+
+  Type type() const override;
+  int width() const override;
+  int height() const override;
+  rtc::scoped_refptr<I420BufferInterface> ToI420() override;
+
+  // DRM fourcc code (e.g. DRM_FORMAT_XRGB8888) and format modifier of the
+  // DMA-BUF. The modifier is DRM_FORMAT_MOD_INVALID if the buffer was
+  // negotiated without one.
+  uint32_t drm_format() const;
+  uint64_t modifier() const { return modifier_; }
+  const std::vector<Plane>& planes() const { return planes_; }
+  // Size of the whole DMA-BUF and the part of it that holds the frame.
+  const DesktopSize& stream_size() const { return stream_size_; }
+  const DesktopRect& crop() const { return crop_; }
+
+ protected:
+  DmaBufVideoFrameBuffer(std::shared_ptr<EglDmaBuf> egl_dmabuf,
+                         uint32_t spa_format,
+                         uint64_t modifier,
+                         const DesktopSize& stream_size,
+                         const DesktopRect& crop,
+                         std::vector<Plane> planes,
+                         absl::AnyInvocable<void() &&> release_callback);
+  ~DmaBufVideoFrameBuffer() override;
+
+ private:
+  const std::shared_ptr<EglDmaBuf> egl_dmabuf_;
+  const uint32_t spa_format_;
+  const uint64_t modifier_;
+  const DesktopSize stream_size_;
+  const DesktopRect crop_;
+  const std::vector<Plane> planes_;
+  absl::AnyInvocable<void() &&> release_callback_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_DESKTOP_CAPTURE_LINUX_WAYLAND_DMABUF_VIDEO_FRAME_BUFFER_H_
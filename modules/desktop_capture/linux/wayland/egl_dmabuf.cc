@@ -195,7 +195,7 @@ static const std::string FormatEGLError(EGLint err) {
   }
 }
 
-static uint32_t SpaPixelFormatToDrmFormat(uint32_t spa_format) {
+uint32_t SpaPixelFormatToDrmFormat(uint32_t spa_format) {
   switch (spa_format) {
     case SPA_VIDEO_FORMAT_RGBA:
       return DRM_FORMAT_ABGR8888;
@@ -516,6 +516,23 @@ bool EglDmaBuf::ImageFromDmaBuf(const DesktopSize& size,
     return false;
   }
 
+  MutexLock lock(&mutex_);
+  const bool result = ReadPixelsFromDmaBuf(size, format, plane_datas, modifier,
+                                           offset, buffer_size, data);
+  // Release the context, so that the next call can bind it on another thread.
+  EglMakeCurrent(egl_.display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+  return result;
+}
+
+RTC_NO_SANITIZE("cfi-icall")
+bool EglDmaBuf::ReadPixelsFromDmaBuf(const DesktopSize& size,
+                                     uint32_t format,
+                                     const std::vector<PlaneData>& plane_datas,
+                                     uint64_t modifier,
+                                     const DesktopVector& offset,
+                                     const DesktopSize& buffer_size,
+                                     uint8_t* data) {
+
   if (plane_datas.size() <= 0) {
     RTC_LOG(LS_ERROR) << "Failed to process buffer: invalid number of planes";
     return false;
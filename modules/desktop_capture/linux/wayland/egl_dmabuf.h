@@ -21,9 +21,15 @@
 
 #include "absl/types/optional.h"
 #include "modules/desktop_capture/desktop_geometry.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
 
 namespace webrtc {
 
+// Returns the DRM fourcc code matching a SPA_VIDEO_FORMAT_* value, or
+// DRM_FORMAT_INVALID if the format isn't supported.
+uint32_t SpaPixelFormatToDrmFormat(uint32_t spa_format);
+
 class EglDmaBuf {
  public:
   struct EGLStruct {
@@ -42,7 +48,8 @@ class EglDmaBuf {
   ~EglDmaBuf();
 
   // Returns whether the image was successfully imported from
-  // given DmaBuf and its parameters
+  // given DmaBuf and its parameters. Can be called from any thread, calls
+  // are serialized.
   bool ImageFromDmaBuf(const DesktopSize& size,
                        uint32_t format,
                        const std::vector<PlaneData>& plane_datas,
@@ -56,14 +63,22 @@ class EglDmaBuf {
 
  private:
   bool GetClientExtensions(EGLDisplay dpy, EGLint name);
+  bool ReadPixelsFromDmaBuf(const DesktopSize& size,
+                            uint32_t format,
+                            const std::vector<PlaneData>& plane_datas,
+                            uint64_t modifiers,
+                            const DesktopVector& offset,
+                            const DesktopSize& buffer_size,
+                            uint8_t* data) RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
   bool egl_initialized_ = false;
   bool has_image_dma_buf_import_ext_ = false;
   int32_t drm_fd_ = -1;               // for GBM buffer mmap
   gbm_device* gbm_device_ = nullptr;  // for passed GBM buffer retrieval
 
-  GLuint fbo_ = 0;
-  GLuint texture_ = 0;
+  Mutex mutex_;
+  GLuint fbo_ RTC_GUARDED_BY(mutex_) = 0;
+  GLuint texture_ RTC_GUARDED_BY(mutex_) = 0;
   EGLStruct egl_;
 
   absl::optional<std::string> GetRenderNode();
@@ -16,6 +16,7 @@
 #include <spa/param/video/format-utils.h>
 #include <sys/mman.h>
 
+#include <set>
 #include <vector>
 
 #include "absl/memory/memory.h"
@@ -69,6 +70,47 @@ class ScopedBuf {
   int fd_;
 };
 
+// Collects the PipeWire buffers released by native frame buffers, which can
+// happen on any thread and after the stream is stopped, and wakes up the
+// PipeWire loop to queue them back to the stream.
+class ReleasedBufferQueue {
+ public:
+  ReleasedBufferQueue(pw_loop* loop, spa_source* event)
+      : loop_(loop), event_(event) {}
+
+  RTC_NO_SANITIZE("cfi-icall")
+  void Release(pw_buffer* buffer) {
+    webrtc::MutexLock lock(&mutex_);
+    if (!loop_) {
+      return;
+    }
+    buffers_.push_back(buffer);
+    pw_loop_signal_event(loop_, event_);
+  }
+
+  std::vector<pw_buffer*> TakeBuffers() {
+    webrtc::MutexLock lock(&mutex_);
+    std::vector<pw_buffer*> buffers;
+    buffers.swap(buffers_);
+    return buffers;
+  }
+
+  // Drops buffers released from now on. Called before the stream is
+  // destroyed.
+  void Stop() {
+    webrtc::MutexLock lock(&mutex_);
+    loop_ = nullptr;
+    event_ = nullptr;
+    buffers_.clear();
+  }
+
+ private:
+  webrtc::Mutex mutex_;
+  pw_loop* loop_ RTC_GUARDED_BY(mutex_);
+  spa_source* event_ RTC_GUARDED_BY(mutex_);
+  std::vector<pw_buffer*> buffers_ RTC_GUARDED_BY(mutex_);
+};
+
 class SharedScreenCastStreamPrivate {
  public:
   SharedScreenCastStreamPrivate();
@@ -88,6 +130,10 @@ class SharedScreenCastStreamPrivate {
   void SetObserver(SharedScreenCastStream::Observer* observer) {
     observer_ = observer;
   }
+  void SetNativeFrameCallback(
+      SharedScreenCastStream::NativeFrameCallback* callback) {
+    native_frame_callback_ = callback;
+  }
   void StopScreenCastStream();
   std::unique_ptr<SharedDesktopFrame> CaptureFrame();
   std::unique_ptr<MouseCursor> CaptureCursor();
@@ -98,6 +144,8 @@ class SharedScreenCastStreamPrivate {
   void StopAndCleanupStream();
 
   SharedScreenCastStream::Observer* observer_ = nullptr;
+  SharedScreenCastStream::NativeFrameCallback* native_frame_callback_ =
+      nullptr;
 
   // Track damage region updates that were reported since the last time
   // frame was captured
@@ -115,7 +163,8 @@ class SharedScreenCastStreamPrivate {
   DesktopVector mouse_cursor_position_ = DesktopVector(-1, -1);
 
   int64_t modifier_;
-  std::unique_ptr<EglDmaBuf> egl_dmabuf_;
+  // Shared with the native frame buffers, which use it for reading back.
+  std::shared_ptr<EglDmaBuf> egl_dmabuf_;
   // List of modifiers we query as supported by the graphics card/driver
   std::vector<uint64_t> modifiers_;
 
@@ -125,6 +174,13 @@ class SharedScreenCastStreamPrivate {
   struct pw_stream* pw_stream_ = nullptr;
   struct pw_thread_loop* pw_main_loop_ = nullptr;
   struct spa_source* renegotiate_ = nullptr;
+  struct spa_source* release_buffers_ = nullptr;
+
+  // Buffers held by native frame buffers, and the queue they're returned
+  // through once released. `native_buffers_` is only used on the PipeWire
+  // thread.
+  std::set<pw_buffer*> native_buffers_;
+  std::shared_ptr<ReleasedBufferQueue> released_buffers_;
 
   spa_hook spa_core_listener_;
   spa_hook spa_stream_listener_;
@@ -155,7 +211,10 @@ class SharedScreenCastStreamPrivate {
 
   struct spa_video_info_raw spa_video_format_;
 
-  void ProcessBuffer(pw_buffer* buffer);
+  // Returns true if `buffer` was passed on in a native frame buffer, in which
+  // case it's queued back to the stream once the frame buffer is released.
+  bool ProcessBuffer(pw_buffer* buffer);
+  bool ProcessNativeDMABuffer(pw_buffer* buffer, const DesktopVector& offset);
   bool ProcessMemFDBuffer(pw_buffer* buffer,
                           DesktopFrame& frame,
                           const DesktopVector& offset);
@@ -183,11 +242,14 @@ class SharedScreenCastStreamPrivate {
                                    pw_stream_state state,
                                    const char* error_message);
   static void OnStreamProcess(void* data);
+  static void OnStreamRemoveBuffer(void* data, pw_buffer* buffer);
   // This will be invoked in case we fail to process DMA-BUF PW buffer using
   // negotiated stream parameters (modifier). We will drop the modifier we
   // failed to use and try to use a different one or fallback to shared memory
   // buffers.
   static void OnRenegotiateFormat(void* data, uint64_t);
+  // Queues the buffers released by native frame buffers back to the stream.
+  static void OnReleaseBuffers(void* data, uint64_t);
 
   DesktopCapturer::Callback* callback_;
 };
@@ -351,9 +413,34 @@ void SharedScreenCastStreamPrivate::OnStreamProcess(void* data) {
     return;
   }
 
-  that->ProcessBuffer(buffer);
+  if (!that->ProcessBuffer(buffer)) {
+    pw_stream_queue_buffer(that->pw_stream_, buffer);
+  }
+}
+
+// static
+void SharedScreenCastStreamPrivate::OnStreamRemoveBuffer(void* data,
+                                                         pw_buffer* buffer) {
+  SharedScreenCastStreamPrivate* that =
+      static_cast<SharedScreenCastStreamPrivate*>(data);
+  RTC_DCHECK(that);
+
+  // The buffer is gone, e.g. due to renegotiation, and must not be queued
+  // once the native frame buffer holding it is released.
+  that->native_buffers_.erase(buffer);
+}
 
-  pw_stream_queue_buffer(that->pw_stream_, buffer);
+// static
+void SharedScreenCastStreamPrivate::OnReleaseBuffers(void* data, uint64_t) {
+  SharedScreenCastStreamPrivate* that =
+      static_cast<SharedScreenCastStreamPrivate*>(data);
+  RTC_DCHECK(that);
+
+  for (pw_buffer* buffer : that->released_buffers_->TakeBuffers()) {
+    if (that->native_buffers_.erase(buffer)) {
+      pw_stream_queue_buffer(that->pw_stream_, buffer);
+    }
+  }
 }
 
 void SharedScreenCastStreamPrivate::OnRenegotiateFormat(void* data, uint64_t) {
@@ -412,7 +499,7 @@ bool SharedScreenCastStreamPrivate::StartScreenCastStream(
     RTC_LOG(LS_ERROR) << "Unable to open PipeWire library";
     return false;
   }
-  egl_dmabuf_ = std::make_unique<EglDmaBuf>();
+  egl_dmabuf_ = std::make_shared<EglDmaBuf>();
 
   pw_stream_node_id_ = stream_node_id;
 
@@ -444,6 +531,7 @@ bool SharedScreenCastStreamPrivate::StartScreenCastStream(
   pw_stream_events_.state_changed = &OnStreamStateChanged;
   pw_stream_events_.param_changed = &OnStreamParamChanged;
   pw_stream_events_.process = &OnStreamProcess;
+  pw_stream_events_.remove_buffer = &OnStreamRemoveBuffer;
 
   {
     PipeWireThreadLoopLock thread_loop_lock(pw_main_loop_);
@@ -465,6 +553,10 @@ bool SharedScreenCastStreamPrivate::StartScreenCastStream(
     // Add an event that can be later invoked by pw_loop_signal_event()
     renegotiate_ = pw_loop_add_event(pw_thread_loop_get_loop(pw_main_loop_),
                                      OnRenegotiateFormat, this);
+    release_buffers_ = pw_loop_add_event(
+        pw_thread_loop_get_loop(pw_main_loop_), OnReleaseBuffers, this);
+    released_buffers_ = std::make_shared<ReleasedBufferQueue>(
+        pw_thread_loop_get_loop(pw_main_loop_), release_buffers_);
 
     server_version_sync_ =
         pw_core_sync(pw_core_, PW_ID_CORE, server_version_sync_);
@@ -591,6 +683,14 @@ void SharedScreenCastStreamPrivate::StopAndCleanupStream() {
   pw_thread_loop_wait(pw_main_loop_);
   pw_thread_loop_stop(pw_main_loop_);
 
+  // Native frame buffers may outlive the stream, their buffers are dropped
+  // along with it.
+  if (released_buffers_) {
+    released_buffers_->Stop();
+    released_buffers_ = nullptr;
+  }
+  native_buffers_.clear();
+
   if (pw_stream_) {
     pw_stream_disconnect(pw_stream_);
     pw_stream_destroy(pw_stream_);
@@ -693,7 +793,7 @@ void SharedScreenCastStreamPrivate::NotifyCallbackOfNewFrame(
 }
 
 RTC_NO_SANITIZE("cfi-icall")
-void SharedScreenCastStreamPrivate::ProcessBuffer(pw_buffer* buffer) {
+bool SharedScreenCastStreamPrivate::ProcessBuffer(pw_buffer* buffer) {
   int64_t capture_start_time_nanos = rtc::TimeNanos();
   if (callback_) {
     callback_->OnFrameCaptureStart();
@@ -738,7 +838,7 @@ void SharedScreenCastStreamPrivate::ProcessBuffer(pw_buffer* buffer) {
   }
 
   if (spa_buffer->datas[0].chunk->size == 0) {
-    return;
+    return false;
   }
 
   // Use SPA_META_VideoCrop metadata to get the frame size. KDE and GNOME do
@@ -769,7 +869,7 @@ void SharedScreenCastStreamPrivate::ProcessBuffer(pw_buffer* buffer) {
       observer_->OnFailedToProcessBuffer();
     }
 
-    return;
+    return false;
   }
 
   // Use SPA_META_VideoCrop metadata to get the DesktopFrame size in case
@@ -814,6 +914,11 @@ void SharedScreenCastStreamPrivate::ProcessBuffer(pw_buffer* buffer) {
           : 0;
   DesktopVector offset = DesktopVector(x_offset, y_offset);
 
+  if (native_frame_callback_ &&
+      spa_buffer->datas[0].type == SPA_DATA_DmaBuf) {
+    return ProcessNativeDMABuffer(buffer, offset);
+  }
+
   webrtc::MutexLock lock(&queue_lock_);
 
   queue_.MoveToNextFrame();
@@ -844,7 +949,7 @@ void SharedScreenCastStreamPrivate::ProcessBuffer(pw_buffer* buffer) {
     if (observer_) {
       observer_->OnFailedToProcessBuffer();
     }
-    return;
+    return false;
   }
 
   if (spa_video_format_.format == SPA_VIDEO_FORMAT_RGBx ||
@@ -872,6 +977,41 @@ void SharedScreenCastStreamPrivate::ProcessBuffer(pw_buffer* buffer) {
                                rtc::kNumNanosecsPerMillisec);
     NotifyCallbackOfNewFrame(std::move(frame));
   }
+
+  return false;
+}
+
+RTC_NO_SANITIZE("cfi-icall")
+bool SharedScreenCastStreamPrivate::ProcessNativeDMABuffer(
+    pw_buffer* buffer,
+    const DesktopVector& offset) {
+  spa_buffer* spa_buffer = buffer->buffer;
+
+  std::vector<DmaBufVideoFrameBuffer::Plane> planes;
+  for (uint32_t i = 0; i < spa_buffer->n_datas; ++i) {
+    planes.push_back(
+        {static_cast<int>(spa_buffer->datas[i].fd),
+         static_cast<uint32_t>(spa_buffer->datas[i].chunk->stride),
+         static_cast<uint32_t>(spa_buffer->datas[i].chunk->offset)});
+  }
+
+  rtc::scoped_refptr<DmaBufVideoFrameBuffer> frame_buffer =
+      DmaBufVideoFrameBuffer::Create(
+          egl_dmabuf_, spa_video_format_.format, modifier_, stream_size_,
+          DesktopRect::MakeOriginSize(offset, frame_size_), planes,
+          [released_buffers = released_buffers_, buffer] {
+            released_buffers->Release(buffer);
+          });
+  if (!frame_buffer) {
+    if (observer_) {
+      observer_->OnFailedToProcessBuffer();
+    }
+    return false;
+  }
+
+  native_buffers_.insert(buffer);
+  native_frame_callback_->OnNativeFrame(std::move(frame_buffer));
+  return true;
 }
 
 RTC_NO_SANITIZE("cfi-icall")
@@ -1011,6 +1151,11 @@ void SharedScreenCastStream::SetObserver(
   private_->SetObserver(observer);
 }
 
+void SharedScreenCastStream::SetNativeFrameCallback(
+    NativeFrameCallback* callback) {
+  private_->SetNativeFrameCallback(callback);
+}
+
 void SharedScreenCastStream::StopScreenCastStream() {
   private_->StopScreenCastStream();
 }
@@ -17,6 +17,7 @@
 #include "api/ref_counted_base.h"
 #include "api/scoped_refptr.h"
 #include "modules/desktop_capture/desktop_capturer.h"
+#include "modules/desktop_capture/linux/wayland/dmabuf_video_frame_buffer.h"
 #include "modules/desktop_capture/mouse_cursor.h"
 #include "modules/desktop_capture/screen_capture_frame_queue.h"
 #include "modules/desktop_capture/shared_desktop_frame.h"
@@ -43,6 +44,17 @@ class RTC_EXPORT SharedScreenCastStream
     virtual ~Observer() = default;
   };
 
+  // Receives the frames captured into DMA-BUFs when set with
+  // SetNativeFrameCallback(). Called on the PipeWire thread.
+  class NativeFrameCallback {
+   public:
+    virtual void OnNativeFrame(
+        rtc::scoped_refptr<DmaBufVideoFrameBuffer> frame_buffer) = 0;
+
+   protected:
+    virtual ~NativeFrameCallback() = default;
+  };
+
   static rtc::scoped_refptr<SharedScreenCastStream> CreateDefault();
 
   bool StartScreenCastStream(uint32_t stream_node_id);
@@ -56,6 +68,12 @@ class RTC_EXPORT SharedScreenCastStream
   void UpdateScreenCastStreamFrameRate(uint32_t frame_rate);
   void SetUseDamageRegion(bool use_damage_region);
   void SetObserver(SharedScreenCastStream::Observer* observer);
+  // When set, buffers that PipeWire delivers as DMA-BUFs are passed to
+  // `callback` as native frame buffers instead of being read back into a
+  // DesktopFrame, so they're neither returned by CaptureFrame() nor passed to
+  // the DesktopCapturer::Callback. Shared memory buffers still are. Must be
+  // called before StartScreenCastStream().
+  void SetNativeFrameCallback(NativeFrameCallback* callback);
   void StopScreenCastStream();
 
   // Below functions return the most recent information we get from a
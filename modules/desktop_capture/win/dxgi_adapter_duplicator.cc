@@ -131,7 +131,7 @@ bool DxgiAdapterDuplicator::Duplicate(Context* context,
   for (size_t i = 0; i < duplicators_.size(); i++) {
     if (!duplicators_[i].Duplicate(&context->contexts[i],
                                    duplicators_[i].desktop_rect().top_left(),
-                                   target)) {
+                                   target, /*texture=*/nullptr)) {
       return false;
     }
   }
@@ -140,12 +140,13 @@ bool DxgiAdapterDuplicator::Duplicate(Context* context,
 
 bool DxgiAdapterDuplicator::DuplicateMonitor(Context* context,
                                              int monitor_id,
-                                             SharedDesktopFrame* target) {
+                                             SharedDesktopFrame* target,
+                                             DxgiSharedTexture* texture) {
   RTC_DCHECK_GE(monitor_id, 0);
   RTC_DCHECK_LT(monitor_id, duplicators_.size());
   RTC_DCHECK_EQ(context->contexts.size(), duplicators_.size());
   return duplicators_[monitor_id].Duplicate(&context->contexts[monitor_id],
-                                            DesktopVector(), target);
+                                            DesktopVector(), target, texture);
 }
 
 DesktopRect DxgiAdapterDuplicator::ScreenRect(int id) const {
@@ -20,6 +20,7 @@
 #include "modules/desktop_capture/win/d3d_device.h"
 #include "modules/desktop_capture/win/dxgi_context.h"
 #include "modules/desktop_capture/win/dxgi_output_duplicator.h"
+#include "modules/desktop_capture/win/dxgi_shared_texture.h"
 
 namespace webrtc {
 
@@ -46,11 +47,12 @@ class DxgiAdapterDuplicator {
   // instances owned by this instance, and writes into `target`.
   bool Duplicate(Context* context, SharedDesktopFrame* target);
 
-  // Captures one monitor and writes into `target`. `monitor_id` should be
-  // between [0, screen_count()).
+  // Captures one monitor and writes into `target`, or into `texture` if it is
+  // not null. `monitor_id` should be between [0, screen_count()).
   bool DuplicateMonitor(Context* context,
                         int monitor_id,
-                        SharedDesktopFrame* target);
+                        SharedDesktopFrame* target,
+                        DxgiSharedTexture* texture);
 
   // Returns desktop rect covered by this DxgiAdapterDuplicator.
   DesktopRect desktop_rect() const { return desktop_rect_; }
@@ -195,7 +195,8 @@ DxgiDuplicatorController::Result DxgiDuplicatorController::DoDuplicate(
 
   frame->frame()->mutable_updated_region()->Clear();
 
-  if (DoDuplicateUnlocked(frame->context(), monitor_id, frame->frame())) {
+  if (DoDuplicateUnlocked(frame->context(), monitor_id, frame->frame(),
+                          frame->texture())) {
     succeeded_duplications_++;
     return Result::SUCCEEDED;
   }
@@ -328,7 +329,8 @@ void DxgiDuplicatorController::Setup(Context* context) {
 
 bool DxgiDuplicatorController::DoDuplicateUnlocked(Context* context,
                                                    int monitor_id,
-                                                   SharedDesktopFrame* target) {
+                                                   SharedDesktopFrame* target,
+                                                   DxgiSharedTexture* texture) {
   Setup(context);
 
   if (!EnsureFrameCaptured(context, target)) {
@@ -340,7 +342,7 @@ bool DxgiDuplicatorController::DoDuplicateUnlocked(Context* context,
     // Capture entire screen.
     result = DoDuplicateAll(context, target);
   } else {
-    result = DoDuplicateOne(context, monitor_id, target);
+    result = DoDuplicateOne(context, monitor_id, target, texture);
   }
 
   if (result) {
@@ -363,7 +365,8 @@ bool DxgiDuplicatorController::DoDuplicateAll(Context* context,
 
 bool DxgiDuplicatorController::DoDuplicateOne(Context* context,
                                               int monitor_id,
-                                              SharedDesktopFrame* target) {
+                                              SharedDesktopFrame* target,
+                                              DxgiSharedTexture* texture) {
   RTC_DCHECK(monitor_id >= 0);
   for (size_t i = 0; i < duplicators_.size() && i < context->contexts.size();
        i++) {
@@ -371,7 +374,7 @@ bool DxgiDuplicatorController::DoDuplicateOne(Context* context,
       monitor_id -= duplicators_[i].screen_count();
     } else {
       if (duplicators_[i].DuplicateMonitor(&context->contexts[i], monitor_id,
-                                           target)) {
+                                           target, texture)) {
         target->set_top_left(duplicators_[i].ScreenRect(monitor_id).top_left());
         return true;
       }
@@ -25,6 +25,7 @@
 #include "modules/desktop_capture/win/dxgi_adapter_duplicator.h"
 #include "modules/desktop_capture/win/dxgi_context.h"
 #include "modules/desktop_capture/win/dxgi_frame.h"
+#include "modules/desktop_capture/win/dxgi_shared_texture.h"
 #include "rtc_base/synchronization/mutex.h"
 #include "rtc_base/system/rtc_export.h"
 
@@ -185,17 +186,19 @@ class RTC_EXPORT DxgiDuplicatorController {
 
   bool DoDuplicateUnlocked(Context* context,
                            int monitor_id,
-                           SharedDesktopFrame* target)
+                           SharedDesktopFrame* target,
+                           DxgiSharedTexture* texture)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
   // Captures all monitors.
   bool DoDuplicateAll(Context* context, SharedDesktopFrame* target)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
-  // Captures one monitor.
+  // Captures one monitor, into `texture` if it is not null.
   bool DoDuplicateOne(Context* context,
                       int monitor_id,
-                      SharedDesktopFrame* target)
+                      SharedDesktopFrame* target,
+                      DxgiSharedTexture* texture)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
   // The minimum GetNumFramesCaptured() returned by `duplicators_`.
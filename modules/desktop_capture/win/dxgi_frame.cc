@@ -21,7 +21,13 @@
 
 namespace webrtc {
 
-DxgiFrame::DxgiFrame(SharedMemoryFactory* factory) : factory_(factory) {}
+DxgiFrame::DxgiFrame(SharedMemoryFactory* factory)
+    : DxgiFrame(factory, /*texture_passthrough=*/false) {}
+
+DxgiFrame::DxgiFrame(SharedMemoryFactory* factory, bool texture_passthrough)
+    : factory_(factory),
+      texture_(texture_passthrough ? std::make_unique<DxgiSharedTexture>()
+                                   : nullptr) {}
 
 DxgiFrame::~DxgiFrame() = default;
 
@@ -32,6 +38,10 @@ bool DxgiFrame::Prepare(DesktopSize size, DesktopCapturer::SourceId source_id) {
     context_.Reset();
   }
 
+  if (texture_) {
+    texture_->Invalidate();
+  }
+
   if (resolution_tracker_.SetResolution(size)) {
     // Once the output size changed, recreate the SharedDesktopFrame.
     frame_.reset();
@@ -69,6 +79,13 @@ SharedDesktopFrame* DxgiFrame::frame() const {
   return frame_.get();
 }
 
+DxgiSharedTexture* DxgiFrame::texture() {
+  if (source_id_ == kFullDesktopScreenId) {
+    return nullptr;
+  }
+  return texture_.get();
+}
+
 DxgiFrame::Context* DxgiFrame::context() {
   RTC_DCHECK(frame_);
   return &context_;
@@ -21,6 +21,7 @@
 #include "modules/desktop_capture/shared_desktop_frame.h"
 #include "modules/desktop_capture/shared_memory.h"
 #include "modules/desktop_capture/win/dxgi_context.h"
+#include "modules/desktop_capture/win/dxgi_shared_texture.h"
 
 namespace webrtc {
 
@@ -35,11 +36,20 @@ class DxgiFrame final {
   // DxgiFrame does not take ownership of `factory`, consumers should ensure it
   // outlives this instance. nullptr is acceptable.
   explicit DxgiFrame(SharedMemoryFactory* factory);
+  // With `texture_passthrough`, monitors are captured into a
+  // DxgiSharedTexture instead of the pixels of frame(). See
+  // DesktopCaptureOptions::allow_directx_texture_passthrough().
+  DxgiFrame(SharedMemoryFactory* factory, bool texture_passthrough);
   ~DxgiFrame();
 
   // Should not be called if Prepare() is not executed or returns false.
   SharedDesktopFrame* frame() const;
 
+  // Returns the texture the current source is captured into, or nullptr if it
+  // is captured into frame(). The entire desktop is always captured into
+  // frame(), since its monitors may be on different adapters.
+  DxgiSharedTexture* texture();
+
  private:
   // Allows DxgiDuplicatorController to access Prepare() and context() function
   // as well as Context class.
@@ -55,6 +65,7 @@ class DxgiFrame final {
   ResolutionTracker resolution_tracker_;
   DesktopCapturer::SourceId source_id_ = kFullDesktopScreenId;
   std::unique_ptr<SharedDesktopFrame> frame_;
+  const std::unique_ptr<DxgiSharedTexture> texture_;
   Context context_;
 };
 
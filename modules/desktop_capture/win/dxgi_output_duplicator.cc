@@ -177,10 +177,16 @@ bool DxgiOutputDuplicator::ContainsMouseCursor(
 
 bool DxgiOutputDuplicator::Duplicate(Context* context,
                                      DesktopVector offset,
-                                     SharedDesktopFrame* target) {
+                                     SharedDesktopFrame* target,
+                                     DxgiSharedTexture* texture) {
   RTC_DCHECK(duplication_);
   RTC_DCHECK(texture_);
   RTC_DCHECK(target);
+  if (rotation_ != Rotation::CLOCK_WISE_0 || desc_.DesktopImageInSystemMemory) {
+    // Rotating, or mapping a desktop image in system memory, is done on the
+    // CPU anyway.
+    texture = nullptr;
+  }
   if (!DesktopRect::MakeSize(target->size())
            .ContainsRect(GetTranslatedDesktopRect(offset))) {
     // target size is not large enough to cover current output region.
@@ -208,6 +214,19 @@ bool DxgiOutputDuplicator::Duplicate(Context* context,
   if (error.Error() == S_OK && frame_info.AccumulatedFrames > 0 && resource) {
     DetectUpdatedRegion(frame_info, &context->updated_region);
     SpreadContextChange(context);
+    if (texture) {
+      updated_region.AddRegion(context->updated_region);
+      if (!CopyToTexture(resource.Get(), updated_region, texture)) {
+        return false;
+      }
+      last_frame_.reset();
+      last_texture_ = texture->texture();
+      updated_region.Translate(offset.x(), offset.y());
+      target->mutable_updated_region()->AddRegion(updated_region);
+      target->set_may_contain_cursor(cursor_embedded_in_frame);
+      num_frames_captured_++;
+      return ReleaseFrame();
+    }
     if (!texture_->CopyFrom(frame_info, resource.Get())) {
       return false;
     }
@@ -236,6 +255,7 @@ bool DxgiOutputDuplicator::Duplicate(Context* context,
     }
     last_frame_ = target->Share();
     last_frame_offset_ = offset;
+    last_texture_.Reset();
     updated_region.Translate(offset.x(), offset.y());
     target->mutable_updated_region()->AddRegion(updated_region);
     target->set_may_contain_cursor(cursor_embedded_in_frame);
@@ -243,7 +263,16 @@ bool DxgiOutputDuplicator::Duplicate(Context* context,
     return texture_->Release() && ReleaseFrame();
   }
 
-  if (last_frame_) {
+  if (texture && last_texture_) {
+    // No change since last frame or AcquireNextFrame() timed out, we will
+    // copy the changes this texture missed from the last texture.
+    if (!CopyToTexture(nullptr, updated_region, texture)) {
+      return false;
+    }
+    updated_region.Translate(offset.x(), offset.y());
+    target->mutable_updated_region()->AddRegion(updated_region);
+    target->set_may_contain_cursor(cursor_embedded_in_frame);
+  } else if (last_frame_ && !texture) {
     // No change since last frame or AcquireNextFrame() timed out, we will
     // export last frame to the target.
     for (DesktopRegion::Iterator it(updated_region); !it.IsAtEnd();
@@ -261,14 +290,47 @@ bool DxgiOutputDuplicator::Duplicate(Context* context,
     target->set_may_contain_cursor(cursor_embedded_in_frame);
   } else {
     // If we were at the very first frame, and capturing failed, the
-    // context->updated_region should be kept unchanged for next attempt.
+    // context->updated_region should be kept unchanged for next attempt. The
+    // same applies if the last frame was captured in the other mode; its
+    // changes are copied from the next acquired frame.
     context->updated_region.Swap(&updated_region);
+    if (texture) {
+      // The texture still holds the frame it was last captured with.
+      texture->KeepContent();
+    }
   }
   // If AcquireNextFrame() failed with timeout error, we do not need to release
   // the frame.
   return error.Error() == DXGI_ERROR_WAIT_TIMEOUT || ReleaseFrame();
 }
 
+bool DxgiOutputDuplicator::CopyToTexture(IDXGIResource* resource,
+                                         const DesktopRegion& updated_region,
+                                         DxgiSharedTexture* texture) {
+  ComPtr<ID3D11Texture2D> source = last_texture_;
+  std::vector<DxgiMoveRect> move_rects;
+  if (resource) {
+    _com_error error = resource->QueryInterface(
+        __uuidof(ID3D11Texture2D),
+        reinterpret_cast<void**>(source.ReleaseAndGetAddressOf()));
+    if (error.Error() != S_OK || !source) {
+      RTC_LOG(LS_ERROR) << "Failed to convert IDXGIResource to "
+                           "ID3D11Texture2D: "
+                        << desktop_capture::utils::ComErrorToString(error);
+      return false;
+    }
+    move_rects = move_rects_;
+  }
+  RTC_DCHECK(source);
+  if (source.Get() == texture->texture()) {
+    // `texture` holds the latest content already.
+    texture->KeepContent();
+    return true;
+  }
+  return texture->CopyFrom(device_, source.Get(), updated_region,
+                           std::move(move_rects));
+}
+
 DesktopRect DxgiOutputDuplicator::GetTranslatedDesktopRect(
     DesktopVector offset) const {
   DesktopRect result(DesktopRect::MakeSize(desktop_size()));
@@ -289,6 +351,7 @@ void DxgiOutputDuplicator::DetectUpdatedRegion(
     updated_region->IntersectWith(GetUntranslatedDesktopRect());
   } else {
     updated_region->SetRect(GetUntranslatedDesktopRect());
+    move_rects_.clear();
   }
 }
 
@@ -297,6 +360,7 @@ bool DxgiOutputDuplicator::DoDetectUpdatedRegion(
     DesktopRegion* updated_region) {
   RTC_DCHECK(updated_region);
   updated_region->Clear();
+  move_rects_.clear();
   if (frame_info.TotalMetadataBufferSize == 0) {
     // This should not happen, since frame_info.AccumulatedFrames > 0.
     RTC_LOG(LS_ERROR) << "frame_info.AccumulatedFrames > 0, "
@@ -356,6 +420,12 @@ bool DxgiOutputDuplicator::DoDetectUpdatedRegion(
                                            move_rects->DestinationRect.right,
                                            move_rects->DestinationRect.bottom),
                      unrotated_size_, rotation_));
+      move_rects_.push_back(
+          {DesktopVector(move_rects->SourcePoint.x, move_rects->SourcePoint.y),
+           DesktopRect::MakeLTRB(move_rects->DestinationRect.left,
+                                 move_rects->DestinationRect.top,
+                                 move_rects->DestinationRect.right,
+                                 move_rects->DestinationRect.bottom)});
     } else {
       RTC_LOG(LS_INFO) << "Unmoved move_rect detected, ["
                        << move_rects->DestinationRect.left << ", "
@@ -409,7 +479,7 @@ DesktopSize DxgiOutputDuplicator::desktop_size() const {
 
 int64_t DxgiOutputDuplicator::num_frames_captured() const {
 #if !defined(NDEBUG)
-  RTC_DCHECK_EQ(!!last_frame_, num_frames_captured_ > 0);
+  RTC_DCHECK_EQ(last_frame_ || last_texture_, num_frames_captured_ > 0);
 #endif
   return num_frames_captured_;
 }
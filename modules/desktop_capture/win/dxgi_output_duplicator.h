@@ -12,6 +12,7 @@
 #define MODULES_DESKTOP_CAPTURE_WIN_DXGI_OUTPUT_DUPLICATOR_H_
 
 #include <comdef.h>
+#include <d3d11.h>
 #include <dxgi.h>
 #include <dxgi1_2.h>
 #include <wrl/client.h>
@@ -26,6 +27,7 @@
 #include "modules/desktop_capture/shared_desktop_frame.h"
 #include "modules/desktop_capture/win/d3d_device.h"
 #include "modules/desktop_capture/win/dxgi_context.h"
+#include "modules/desktop_capture/win/dxgi_shared_texture.h"
 #include "modules/desktop_capture/win/dxgi_texture.h"
 #include "rtc_base/thread_annotations.h"
 
@@ -66,9 +68,14 @@ class DxgiOutputDuplicator {
   // (Or in other words, if the call to IDXGIOutputDuplication::AcquireNextFrame
   // indicates that there is not yet a new frame, this is usually because no
   // updates have occurred to the frame).
+  // If `texture` is not null, the content is copied into it on the GPU instead
+  // of being read back into `target`, whose updated region and cursor flag
+  // are still set. Rotated outputs are always read back, leaving `texture`
+  // out of date.
   bool Duplicate(Context* context,
                  DesktopVector offset,
-                 SharedDesktopFrame* target);
+                 SharedDesktopFrame* target,
+                 DxgiSharedTexture* texture);
 
   // Returns the desktop rect covered by this DxgiOutputDuplicator.
   DesktopRect desktop_rect() const { return desktop_rect_; }
@@ -104,6 +111,12 @@ class DxgiOutputDuplicator {
 
   bool ReleaseFrame();
 
+  // Copies `updated_region` of the acquired `resource`, or of
+  // `last_texture_` if `resource` is null, into `texture`.
+  bool CopyToTexture(IDXGIResource* resource,
+                     const DesktopRegion& updated_region,
+                     DxgiSharedTexture* texture);
+
   // Initializes duplication_ instance. Expects duplication_ is in empty status.
   // Returns false if system does not support IDXGIOutputDuplication.
   bool DuplicateOutput();
@@ -130,6 +143,8 @@ class DxgiOutputDuplicator {
   Microsoft::WRL::ComPtr<IDXGIOutputDuplication> duplication_;
   DXGI_OUTDUPL_DESC desc_;
   std::vector<uint8_t> metadata_;
+  // The unrotated move rectangles found by the last DoDetectUpdatedRegion().
+  std::vector<DxgiMoveRect> move_rects_;
   std::unique_ptr<DxgiTexture> texture_;
   Rotation rotation_;
   DesktopSize unrotated_size_;
@@ -145,6 +160,10 @@ class DxgiOutputDuplicator {
   // `last_frame_`.
   std::unique_ptr<SharedDesktopFrame> last_frame_;
   DesktopVector last_frame_offset_;
+  // The same for frames captured in texture passthrough mode. At most one of
+  // `last_frame_` and `last_texture_` is set, the one holding the latest
+  // content.
+  Microsoft::WRL::ComPtr<ID3D11Texture2D> last_texture_;
 
   int64_t num_frames_captured_ = 0;
 };
@@ -0,0 +1,127 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/desktop_capture/win/dxgi_shared_texture.h"
+
+#include <comdef.h>
+#include <dxgi.h>
+#include <string.h>
+
+#include <utility>
+
+#include "modules/desktop_capture/win/desktop_capture_utils.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+using Microsoft::WRL::ComPtr;
+
+namespace webrtc {
+
+DxgiSharedTexture::DxgiSharedTexture() = default;
+DxgiSharedTexture::~DxgiSharedTexture() = default;
+
+bool DxgiSharedTexture::CopyFrom(const D3dDevice& device,
+                                 ID3D11Texture2D* source,
+                                 const DesktopRegion& updated_region,
+                                 std::vector<DxgiMoveRect> move_rects) {
+  RTC_DCHECK(source);
+  D3D11_TEXTURE2D_DESC desc = {0};
+  source->GetDesc(&desc);
+  desc.ArraySize = 1;
+  desc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_RENDER_TARGET;
+  desc.CPUAccessFlags = 0;
+  desc.MipLevels = 1;
+  desc.MiscFlags = D3D11_RESOURCE_MISC_SHARED;
+  desc.SampleDesc.Count = 1;
+  desc.SampleDesc.Quality = 0;
+  desc.Usage = D3D11_USAGE_DEFAULT;
+
+  bool created = false;
+  if (!EnsureTexture(device, desc, &created)) {
+    up_to_date_ = false;
+    return false;
+  }
+
+  ID3D11DeviceContext* context = device.context();
+  if (created) {
+    context->CopyResource(texture_.Get(), source);
+  } else {
+    for (DesktopRegion::Iterator it(updated_region); !it.IsAtEnd();
+         it.Advance()) {
+      const DesktopRect& rect = it.rect();
+      D3D11_BOX box = {static_cast<UINT>(rect.left()),
+                       static_cast<UINT>(rect.top()),
+                       0,
+                       static_cast<UINT>(rect.right()),
+                       static_cast<UINT>(rect.bottom()),
+                       1};
+      context->CopySubresourceRegion(texture_.Get(), 0, box.left, box.top, 0,
+                                     source, 0, &box);
+    }
+  }
+  // Submits the copies, so that other devices opening the texture see them.
+  context->Flush();
+  move_rects_ = std::move(move_rects);
+  up_to_date_ = true;
+  return true;
+}
+
+void DxgiSharedTexture::KeepContent() {
+  move_rects_.clear();
+  up_to_date_ = !!texture_;
+}
+
+void DxgiSharedTexture::Invalidate() {
+  up_to_date_ = false;
+}
+
+bool DxgiSharedTexture::EnsureTexture(const D3dDevice& device,
+                                      const D3D11_TEXTURE2D_DESC& desc,
+                                      bool* created) {
+  if (texture_) {
+    ComPtr<ID3D11Device> texture_device;
+    texture_->GetDevice(texture_device.GetAddressOf());
+    D3D11_TEXTURE2D_DESC current_desc;
+    texture_->GetDesc(&current_desc);
+    if (texture_device.Get() == device.d3d_device() &&
+        memcmp(&desc, &current_desc, sizeof(D3D11_TEXTURE2D_DESC)) == 0) {
+      return true;
+    }
+    // The output moved to another adapter or changed its mode.
+    texture_.Reset();
+    shared_handle_ = nullptr;
+  }
+
+  _com_error error = device.d3d_device()->CreateTexture2D(
+      &desc, nullptr, texture_.GetAddressOf());
+  if (error.Error() != S_OK || !texture_) {
+    RTC_LOG(LS_ERROR) << "Failed to create a shared ID3D11Texture2D: "
+                      << desktop_capture::utils::ComErrorToString(error);
+    texture_.Reset();
+    return false;
+  }
+
+  ComPtr<IDXGIResource> resource;
+  error = texture_.As(&resource);
+  if (error.Error() == S_OK) {
+    error = resource->GetSharedHandle(&shared_handle_);
+  }
+  if (error.Error() != S_OK || !shared_handle_) {
+    RTC_LOG(LS_ERROR) << "Failed to get the shared handle of a texture: "
+                      << desktop_capture::utils::ComErrorToString(error);
+    texture_.Reset();
+    shared_handle_ = nullptr;
+    return false;
+  }
+  *created = true;
+  return true;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,85 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_DESKTOP_CAPTURE_WIN_DXGI_SHARED_TEXTURE_H_
+#define MODULES_DESKTOP_CAPTURE_WIN_DXGI_SHARED_TEXTURE_H_
+
+#include <d3d11.h>
+#include <windows.h>
+#include <wrl/client.h>
+
+#include <vector>
+
+#include "modules/desktop_capture/desktop_geometry.h"
+#include "modules/desktop_capture/desktop_region.h"
+#include "modules/desktop_capture/win/d3d_device.h"
+
+namespace webrtc {
+
+// A DXGI move rectangle: the content of `destination` has been moved there
+// from the rectangle of the same size at `source` since the previous frame.
+struct DxgiMoveRect {
+  DesktopVector source;
+  DesktopRect destination;
+};
+
+// A D3D11 texture holding the content of one output, which other devices and
+// processes can open through `shared_handle()`. DxgiOutputDuplicator copies
+// duplicated frames into it on the GPU in texture passthrough mode, so that
+// they never need to be read back to the CPU. See
+// DesktopCaptureOptions::allow_directx_texture_passthrough().
+class DxgiSharedTexture {
+ public:
+  DxgiSharedTexture();
+  ~DxgiSharedTexture();
+
+  DxgiSharedTexture(const DxgiSharedTexture&) = delete;
+  DxgiSharedTexture& operator=(const DxgiSharedTexture&) = delete;
+
+  // Copies the `updated_region` of `source` into this texture on the GPU of
+  // `device`. The entire `source` is copied if the texture had to be
+  // (re)created. Returns false in case of a failure.
+  bool CopyFrom(const D3dDevice& device,
+                ID3D11Texture2D* source,
+                const DesktopRegion& updated_region,
+                std::vector<DxgiMoveRect> move_rects);
+
+  // Marks the texture as holding the current frame although nothing was
+  // copied, as the content did not change. Does nothing if the texture has
+  // never been copied to.
+  void KeepContent();
+
+  // Marks the texture as not holding the current frame; it is up to date
+  // again after the next CopyFrom() or KeepContent().
+  void Invalidate();
+
+  bool up_to_date() const { return up_to_date_; }
+  ID3D11Texture2D* texture() const { return texture_.Get(); }
+  // A legacy shared handle, which must not be closed by its users.
+  HANDLE shared_handle() const { return shared_handle_; }
+  // The move rectangles of the last CopyFrom().
+  const std::vector<DxgiMoveRect>& move_rects() const { return move_rects_; }
+
+ private:
+  // Creates `texture_` if it does not match `desc`. Returns false in case of
+  // a failure, and sets `created` if a new texture was created.
+  bool EnsureTexture(const D3dDevice& device,
+                     const D3D11_TEXTURE2D_DESC& desc,
+                     bool* created);
+
+  Microsoft::WRL::ComPtr<ID3D11Texture2D> texture_;
+  HANDLE shared_handle_ = nullptr;
+  std::vector<DxgiMoveRect> move_rects_;
+  bool up_to_date_ = false;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_DESKTOP_CAPTURE_WIN_DXGI_SHARED_TEXTURE_H_
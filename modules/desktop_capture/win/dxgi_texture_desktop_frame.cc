@@ -0,0 +1,36 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/desktop_capture/win/dxgi_texture_desktop_frame.h"
+
+#include <utility>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+DxgiTextureDesktopFrame::DxgiTextureDesktopFrame(
+    std::unique_ptr<DesktopFrame> frame,
+    const DxgiSharedTexture& texture)
+    : DesktopFrame(frame->size(),
+                   frame->stride(),
+                   frame->data(),
+                   frame->shared_memory()),
+      frame_(std::move(frame)),
+      texture_(texture.texture()),
+      shared_handle_(texture.shared_handle()),
+      move_rects_(texture.move_rects()) {
+  RTC_DCHECK(texture.up_to_date());
+  MoveFrameInfoFrom(frame_.get());
+}
+
+DxgiTextureDesktopFrame::~DxgiTextureDesktopFrame() = default;
+
+}  // namespace webrtc
@@ -0,0 +1,62 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_DESKTOP_CAPTURE_WIN_DXGI_TEXTURE_DESKTOP_FRAME_H_
+#define MODULES_DESKTOP_CAPTURE_WIN_DXGI_TEXTURE_DESKTOP_FRAME_H_
+
+#include <d3d11.h>
+#include <windows.h>
+#include <wrl/client.h>
+
+#include <memory>
+#include <vector>
+
+#include "modules/desktop_capture/desktop_frame.h"
+#include "modules/desktop_capture/win/dxgi_shared_texture.h"
+#include "rtc_base/system/rtc_export.h"
+
+namespace webrtc {
+
+// A DesktopFrame captured by the DirectX screen capturer in texture
+// passthrough mode. The content is in a D3D11 texture that other devices,
+// e.g. the one of a hardware encoder, can open with `shared_handle()`. The
+// pixel data of the DesktopFrame itself is NOT updated. updated_region() holds
+// the dirty rectangles and both ends of the move rectangles, and
+// `move_rects()` the moves themselves, relative to the previous frame
+// captured from the same monitor.
+// Consumers recognize these frames by the capturer id
+// DesktopCapturerId::kScreenCapturerWinDirectx combined with
+// DesktopCaptureOptions::allow_directx_texture_passthrough(), and should
+// release them quickly since the capturer only rotates between a few
+// textures.
+class RTC_EXPORT DxgiTextureDesktopFrame final : public DesktopFrame {
+ public:
+  DxgiTextureDesktopFrame(std::unique_ptr<DesktopFrame> frame,
+                          const DxgiSharedTexture& texture);
+  ~DxgiTextureDesktopFrame() override;
+
+  DxgiTextureDesktopFrame(const DxgiTextureDesktopFrame&) = delete;
+  DxgiTextureDesktopFrame& operator=(const DxgiTextureDesktopFrame&) = delete;
+
+  ID3D11Texture2D* texture() const { return texture_.Get(); }
+  HANDLE shared_handle() const { return shared_handle_; }
+  const std::vector<DxgiMoveRect>& move_rects() const { return move_rects_; }
+
+ private:
+  // Owns the memory the DesktopFrame points to.
+  const std::unique_ptr<DesktopFrame> frame_;
+  const Microsoft::WRL::ComPtr<ID3D11Texture2D> texture_;
+  const HANDLE shared_handle_;
+  const std::vector<DxgiMoveRect> move_rects_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_DESKTOP_CAPTURE_WIN_DXGI_TEXTURE_DESKTOP_FRAME_H_
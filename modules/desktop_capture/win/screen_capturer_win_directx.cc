@@ -19,6 +19,7 @@
 #include "modules/desktop_capture/desktop_capture_metrics_helper.h"
 #include "modules/desktop_capture/desktop_capture_types.h"
 #include "modules/desktop_capture/desktop_frame.h"
+#include "modules/desktop_capture/win/dxgi_texture_desktop_frame.h"
 #include "modules/desktop_capture/win/screen_capture_utils.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
@@ -139,8 +140,9 @@ void ScreenCapturerWinDirectx::CaptureFrame() {
   frames.MoveToNextFrame();
 
   if (!frames.current_frame()) {
-    frames.ReplaceCurrentFrame(
-        std::make_unique<DxgiFrame>(shared_memory_factory_.get()));
+    frames.ReplaceCurrentFrame(std::make_unique<DxgiFrame>(
+        shared_memory_factory_.get(),
+        options_.allow_directx_texture_passthrough()));
   }
 
   DxgiDuplicatorController::Result result;
@@ -189,6 +191,11 @@ void ScreenCapturerWinDirectx::CaptureFrame() {
     case DuplicateResult::SUCCEEDED: {
       std::unique_ptr<DesktopFrame> frame =
           frames.current_frame()->frame()->Share();
+      DxgiSharedTexture* texture = frames.current_frame()->texture();
+      if (texture && texture->up_to_date()) {
+        frame = std::make_unique<DxgiTextureDesktopFrame>(std::move(frame),
+                                                          *texture);
+      }
 
       int capture_time_ms = (rtc::TimeNanos() - capture_start_time_nanos) /
                             rtc::kNumNanosecsPerMillisec;
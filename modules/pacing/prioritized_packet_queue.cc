@@ -79,65 +79,69 @@ DataSize PrioritizedPacketQueue::QueuedPacket::PacketSize() const {
 }
 
 PrioritizedPacketQueue::StreamQueue::StreamQueue(Timestamp creation_time)
-    : last_enqueue_time_(creation_time), num_keyframe_packets_(0) {}
+    : last_enqueue_time_(creation_time),
+      num_keyframe_packets_(0),
+      size_packets_(0),
+      enqueue_time_sum_(TimeDelta::Zero()) {}
 
-bool PrioritizedPacketQueue::StreamQueue::EnqueuePacket(QueuedPacket packet,
+bool PrioritizedPacketQueue::StreamQueue::EnqueuePacket(QueuedPacket* packet,
                                                         int priority_level) {
-  if (packet.packet->is_key_frame()) {
+  if (packet->packet->is_key_frame()) {
     ++num_keyframe_packets_;
   }
-  bool first_packet_at_level = packets_[priority_level].empty();
-  packets_[priority_level].push_back(std::move(packet));
+  ++size_packets_;
+  enqueue_time_sum_ += packet->enqueue_time - Timestamp::Zero();
+
+  Fifo& fifo = packets_[priority_level];
+  packet->next = nullptr;
+  bool first_packet_at_level = fifo.head == nullptr;
+  if (first_packet_at_level) {
+    fifo.head = packet;
+  } else {
+    fifo.tail->next = packet;
+  }
+  fifo.tail = packet;
   return first_packet_at_level;
 }
 
-PrioritizedPacketQueue::QueuedPacket
+PrioritizedPacketQueue::QueuedPacket*
 PrioritizedPacketQueue::StreamQueue::DequeuePacket(int priority_level) {
-  RTC_DCHECK(!packets_[priority_level].empty());
-  QueuedPacket packet = std::move(packets_[priority_level].front());
-  packets_[priority_level].pop_front();
-  if (packet.packet->is_key_frame()) {
+  Fifo& fifo = packets_[priority_level];
+  RTC_DCHECK(fifo.head != nullptr);
+  QueuedPacket* packet = fifo.head;
+  fifo.head = packet->next;
+  if (fifo.head == nullptr) {
+    fifo.tail = nullptr;
+  }
+  packet->next = nullptr;
+  if (packet->packet->is_key_frame()) {
     RTC_DCHECK_GT(num_keyframe_packets_, 0);
     --num_keyframe_packets_;
   }
+  --size_packets_;
+  enqueue_time_sum_ -= packet->enqueue_time - Timestamp::Zero();
   return packet;
 }
 
 bool PrioritizedPacketQueue::StreamQueue::HasPacketsAtPrio(
     int priority_level) const {
-  return !packets_[priority_level].empty();
+  return packets_[priority_level].head != nullptr;
 }
 
 bool PrioritizedPacketQueue::StreamQueue::IsEmpty() const {
-  for (const std::deque<QueuedPacket>& queue : packets_) {
-    if (!queue.empty()) {
-      return false;
-    }
-  }
-  return true;
+  return size_packets_ == 0;
 }
 
 Timestamp PrioritizedPacketQueue::StreamQueue::LeadingPacketEnqueueTime(
     int priority_level) const {
-  RTC_DCHECK(!packets_[priority_level].empty());
-  return packets_[priority_level].begin()->enqueue_time;
+  RTC_DCHECK(packets_[priority_level].head != nullptr);
+  return packets_[priority_level].head->enqueue_time;
 }
 
 Timestamp PrioritizedPacketQueue::StreamQueue::LastEnqueueTime() const {
   return last_enqueue_time_;
 }
 
-std::array<std::deque<PrioritizedPacketQueue::QueuedPacket>,
-           PrioritizedPacketQueue::kNumPriorityLevels>
-PrioritizedPacketQueue::StreamQueue::DequeueAll() {
-  std::array<std::deque<QueuedPacket>, kNumPriorityLevels> packets_by_prio;
-  for (int i = 0; i < kNumPriorityLevels; ++i) {
-    packets_by_prio[i].swap(packets_[i]);
-  }
-  num_keyframe_packets_ = 0;
-  return packets_by_prio;
-}
-
 PrioritizedPacketQueue::PrioritizedPacketQueue(
     Timestamp creation_time,
     bool prioritize_audio_retransmission,
@@ -152,7 +156,10 @@ PrioritizedPacketQueue::PrioritizedPacketQueue(
       last_update_time_(creation_time),
       paused_(false),
       last_culling_time_(creation_time),
-      top_active_prio_level_(-1) {}
+      top_active_prio_level_(-1),
+      oldest_packet_(nullptr),
+      newest_packet_(nullptr),
+      free_packets_(nullptr) {}
 
 void PrioritizedPacketQueue::Push(Timestamp enqueue_time,
                                   std::unique_ptr<RtpPacketToSend> packet) {
@@ -163,8 +170,6 @@ void PrioritizedPacketQueue::Push(Timestamp enqueue_time,
   }
   stream_queue = it->second.get();
 
-  auto enqueue_time_iterator =
-      enqueue_times_.insert(enqueue_times_.end(), enqueue_time);
   RTC_DCHECK(packet->packet_type().has_value());
   RtpPacketMediaType packet_type = packet->packet_type().value();
   int prio_level =
@@ -174,9 +179,9 @@ void PrioritizedPacketQueue::Push(Timestamp enqueue_time,
   PurgeOldPacketsAtPriorityLevel(prio_level, enqueue_time);
   RTC_DCHECK_GE(prio_level, 0);
   RTC_DCHECK_LT(prio_level, kNumPriorityLevels);
-  QueuedPacket queued_packed = {.packet = std::move(packet),
-                                .enqueue_time = enqueue_time,
-                                .enqueue_time_iterator = enqueue_time_iterator};
+  QueuedPacket* queued_packet = AllocateQueuedPacket();
+  queued_packet->packet = std::move(packet);
+  queued_packet->original_enqueue_time = enqueue_time;
   // In order to figure out how much time a packet has spent in the queue
   // while not in a paused state, we subtract the total amount of time the
   // queue has been paused so far, and when the packet is popped we subtract
@@ -184,14 +189,23 @@ void PrioritizedPacketQueue::Push(Timestamp enqueue_time,
   // way we subtract the total amount of time the packet has spent in the
   // queue while in a paused state.
   UpdateAverageQueueTime(enqueue_time);
-  queued_packed.enqueue_time -= pause_time_sum_;
+  queued_packet->enqueue_time = enqueue_time - pause_time_sum_;
   ++size_packets_;
   ++size_packets_per_media_type_[static_cast<size_t>(packet_type)];
-  size_payload_ += queued_packed.PacketSize();
+  size_payload_ += queued_packet->PacketSize();
+
+  queued_packet->older = newest_packet_;
+  queued_packet->newer = nullptr;
+  if (newest_packet_ != nullptr) {
+    newest_packet_->newer = queued_packet;
+  } else {
+    oldest_packet_ = queued_packet;
+  }
+  newest_packet_ = queued_packet;
 
-  if (stream_queue->EnqueuePacket(std::move(queued_packed), prio_level)) {
+  if (stream_queue->EnqueuePacket(queued_packet, prio_level)) {
     // Number packets at `prio_level` for this steam is now non-zero.
-    streams_by_prio_[prio_level].push_back(stream_queue);
+    AppendActiveStream(prio_level, stream_queue);
   }
   if (top_active_prio_level_ < 0 || prio_level < top_active_prio_level_) {
     top_active_prio_level_ = prio_level;
@@ -217,20 +231,22 @@ std::unique_ptr<RtpPacketToSend> PrioritizedPacketQueue::Pop() {
   }
 
   RTC_DCHECK_GE(top_active_prio_level_, 0);
-  StreamQueue& stream_queue = *streams_by_prio_[top_active_prio_level_].front();
-  QueuedPacket packet = stream_queue.DequeuePacket(top_active_prio_level_);
-  DequeuePacketInternal(packet);
+  StreamQueue& stream_queue = *streams_by_prio_[top_active_prio_level_].head;
+  QueuedPacket* packet = stream_queue.DequeuePacket(top_active_prio_level_);
+  DequeuePacketInternal(*packet);
+  std::unique_ptr<RtpPacketToSend> rtp_packet = std::move(packet->packet);
+  FreeQueuedPacket(packet);
 
   // Remove StreamQueue from head of fifo-queue for this prio level, and
   // and add it to the end if it still has packets.
-  streams_by_prio_[top_active_prio_level_].pop_front();
+  RemoveActiveStream(top_active_prio_level_, &stream_queue);
   if (stream_queue.HasPacketsAtPrio(top_active_prio_level_)) {
-    streams_by_prio_[top_active_prio_level_].push_back(&stream_queue);
+    AppendActiveStream(top_active_prio_level_, &stream_queue);
   } else {
     MaybeUpdateTopPrioLevel();
   }
 
-  return std::move(packet.packet);
+  return rtp_packet;
 }
 
 int PrioritizedPacketQueue::SizeInPackets() const {
@@ -254,10 +270,10 @@ Timestamp PrioritizedPacketQueue::LeadingPacketEnqueueTime(
     RtpPacketMediaType type) const {
   RTC_DCHECK(type != RtpPacketMediaType::kRetransmission);
   const int priority_level = GetPriorityForType(type, absl::nullopt);
-  if (streams_by_prio_[priority_level].empty()) {
+  if (!HasActiveStreams(priority_level)) {
     return Timestamp::MinusInfinity();
   }
-  return streams_by_prio_[priority_level].front()->LeadingPacketEnqueueTime(
+  return streams_by_prio_[priority_level].head->LeadingPacketEnqueueTime(
       priority_level);
 }
 
@@ -266,10 +282,10 @@ Timestamp PrioritizedPacketQueue::LeadingPacketEnqueueTimeForRetransmission()
   if (!prioritize_audio_retransmission_) {
     const int priority_level =
         GetPriorityForType(RtpPacketMediaType::kRetransmission, absl::nullopt);
-    if (streams_by_prio_[priority_level].empty()) {
+    if (!HasActiveStreams(priority_level)) {
       return Timestamp::PlusInfinity();
     }
-    return streams_by_prio_[priority_level].front()->LeadingPacketEnqueueTime(
+    return streams_by_prio_[priority_level].head->LeadingPacketEnqueueTime(
         priority_level);
   }
   const int audio_priority_level =
@@ -280,23 +296,21 @@ Timestamp PrioritizedPacketQueue::LeadingPacketEnqueueTimeForRetransmission()
                          RtpPacketToSend::OriginalType::kVideo);
 
   Timestamp next_audio =
-      streams_by_prio_[audio_priority_level].empty()
+      !HasActiveStreams(audio_priority_level)
           ? Timestamp::PlusInfinity()
           : streams_by_prio_[audio_priority_level]
-                .front()
-                ->LeadingPacketEnqueueTime(audio_priority_level);
+                .head->LeadingPacketEnqueueTime(audio_priority_level);
   Timestamp next_video =
-      streams_by_prio_[video_priority_level].empty()
+      !HasActiveStreams(video_priority_level)
           ? Timestamp::PlusInfinity()
           : streams_by_prio_[video_priority_level]
-                .front()
-                ->LeadingPacketEnqueueTime(video_priority_level);
+                .head->LeadingPacketEnqueueTime(video_priority_level);
   return std::min(next_audio, next_video);
 }
 
 Timestamp PrioritizedPacketQueue::OldestEnqueueTime() const {
-  return enqueue_times_.empty() ? Timestamp::MinusInfinity()
-                                : enqueue_times_.front();
+  return oldest_packet_ == nullptr ? Timestamp::MinusInfinity()
+                                   : oldest_packet_->original_enqueue_time;
 }
 
 TimeDelta PrioritizedPacketQueue::AverageQueueTime() const {
@@ -306,6 +320,23 @@ TimeDelta PrioritizedPacketQueue::AverageQueueTime() const {
   return queue_time_sum_ / size_packets_;
 }
 
+TimeDelta PrioritizedPacketQueue::AverageQueueTimeForSsrc(
+    uint32_t ssrc) const {
+  auto it = streams_.find(ssrc);
+  if (it == streams_.end() || it->second->IsEmpty()) {
+    return TimeDelta::Zero();
+  }
+  // The time in queue of a packet, not counting pauses, is
+  // `last_update_time_ - pause_time_sum_ - enqueue_time`; see
+  // DequeuePacketInternal().
+  const StreamQueue& stream_queue = *it->second;
+  TimeDelta adjusted_now = last_update_time_ - pause_time_sum_ -
+                           Timestamp::Zero();
+  return (adjusted_now * stream_queue.size_packets() -
+          stream_queue.enqueue_time_sum()) /
+         stream_queue.size_packets();
+}
+
 void PrioritizedPacketQueue::UpdateAverageQueueTime(Timestamp now) {
   RTC_CHECK_GE(now, last_update_time_);
   if (now == last_update_time_) {
@@ -333,38 +364,18 @@ void PrioritizedPacketQueue::RemovePacketsForSsrc(uint32_t ssrc) {
   if (kv != streams_.end()) {
     // Dequeue all packets from the queue for this SSRC.
     StreamQueue& queue = *kv->second;
-    std::array<std::deque<QueuedPacket>, kNumPriorityLevels> packets_by_prio =
-        queue.DequeueAll();
     for (int i = 0; i < kNumPriorityLevels; ++i) {
-      std::deque<QueuedPacket>& packet_queue = packets_by_prio[i];
-      if (packet_queue.empty()) {
+      if (!queue.HasPacketsAtPrio(i)) {
         continue;
       }
-
       // First erase all packets at this prio level.
-      while (!packet_queue.empty()) {
-        QueuedPacket packet = std::move(packet_queue.front());
-        packet_queue.pop_front();
-        DequeuePacketInternal(packet);
+      while (queue.HasPacketsAtPrio(i)) {
+        QueuedPacket* packet = queue.DequeuePacket(i);
+        DequeuePacketInternal(*packet);
+        FreeQueuedPacket(packet);
       }
-
       // Next, deregister this `StreamQueue` from the round-robin tables.
-      RTC_DCHECK(!streams_by_prio_[i].empty());
-      if (streams_by_prio_[i].size() == 1) {
-        // This is the last and only queue that had packets for this prio level.
-        // Update the global top prio level if neccessary.
-        RTC_DCHECK(streams_by_prio_[i].front() == &queue);
-        streams_by_prio_[i].pop_front();
-      } else {
-        // More than stream had packets at this prio level, filter this one out.
-        std::deque<StreamQueue*> filtered_queue;
-        for (StreamQueue* queue_ptr : streams_by_prio_[i]) {
-          if (queue_ptr != &queue) {
-            filtered_queue.push_back(queue_ptr);
-          }
-        }
-        streams_by_prio_[i].swap(filtered_queue);
-      }
+      RemoveActiveStream(i, &queue);
     }
   }
   MaybeUpdateTopPrioLevel();
@@ -405,20 +416,90 @@ void PrioritizedPacketQueue::DequeuePacketInternal(QueuedPacket& packet) {
 
   RTC_DCHECK(size_packets_ > 0 || queue_time_sum_ == TimeDelta::Zero());
 
-  RTC_CHECK(packet.enqueue_time_iterator != enqueue_times_.end());
-  enqueue_times_.erase(packet.enqueue_time_iterator);
+  // Unlink from the list of packets ordered by enqueue time.
+  if (packet.older != nullptr) {
+    packet.older->newer = packet.newer;
+  } else {
+    RTC_DCHECK_EQ(oldest_packet_, &packet);
+    oldest_packet_ = packet.newer;
+  }
+  if (packet.newer != nullptr) {
+    packet.newer->older = packet.older;
+  } else {
+    RTC_DCHECK_EQ(newest_packet_, &packet);
+    newest_packet_ = packet.older;
+  }
+  packet.older = nullptr;
+  packet.newer = nullptr;
+}
+
+PrioritizedPacketQueue::QueuedPacket*
+PrioritizedPacketQueue::AllocateQueuedPacket() {
+  if (free_packets_ == nullptr) {
+    return &packet_storage_.emplace_back();
+  }
+  QueuedPacket* packet = free_packets_;
+  free_packets_ = packet->next;
+  packet->next = nullptr;
+  return packet;
+}
+
+void PrioritizedPacketQueue::FreeQueuedPacket(QueuedPacket* packet) {
+  packet->packet = nullptr;
+  packet->next = free_packets_;
+  free_packets_ = packet;
+}
+
+bool PrioritizedPacketQueue::HasActiveStreams(int prio_level) const {
+  return streams_by_prio_[prio_level].head != nullptr;
+}
+
+void PrioritizedPacketQueue::AppendActiveStream(int prio_level,
+                                                StreamQueue* stream_queue) {
+  RoundRobinList& list = streams_by_prio_[prio_level];
+  StreamQueue::RoundRobinLinks& links =
+      stream_queue->round_robin_links[prio_level];
+  links.prev = list.tail;
+  links.next = nullptr;
+  if (list.tail != nullptr) {
+    list.tail->round_robin_links[prio_level].next = stream_queue;
+  } else {
+    list.head = stream_queue;
+  }
+  list.tail = stream_queue;
+}
+
+void PrioritizedPacketQueue::RemoveActiveStream(int prio_level,
+                                                StreamQueue* stream_queue) {
+  RoundRobinList& list = streams_by_prio_[prio_level];
+  StreamQueue::RoundRobinLinks& links =
+      stream_queue->round_robin_links[prio_level];
+  if (links.prev != nullptr) {
+    links.prev->round_robin_links[prio_level].next = links.next;
+  } else {
+    RTC_DCHECK_EQ(list.head, stream_queue);
+    list.head = links.next;
+  }
+  if (links.next != nullptr) {
+    links.next->round_robin_links[prio_level].prev = links.prev;
+  } else {
+    RTC_DCHECK_EQ(list.tail, stream_queue);
+    list.tail = links.prev;
+  }
+  links.prev = nullptr;
+  links.next = nullptr;
 }
 
 void PrioritizedPacketQueue::MaybeUpdateTopPrioLevel() {
   if (top_active_prio_level_ != -1 &&
-      !streams_by_prio_[top_active_prio_level_].empty()) {
+      HasActiveStreams(top_active_prio_level_)) {
     return;
   }
   // No stream queues have packets at top_active_prio_level_, find top priority
   // that is not empty.
   for (int i = 0; i < kNumPriorityLevels; ++i) {
     PurgeOldPacketsAtPriorityLevel(i, last_update_time_);
-    if (!streams_by_prio_[i].empty()) {
+    if (HasActiveStreams(i)) {
       top_active_prio_level_ = i;
       break;
     }
@@ -438,26 +519,25 @@ void PrioritizedPacketQueue::PurgeOldPacketsAtPriorityLevel(int prio_level,
     return;
   }
 
-  std::deque<StreamQueue*>& queues = streams_by_prio_[prio_level];
-  auto iter = queues.begin();
-  while (iter != queues.end()) {
-    StreamQueue* queue_ptr = *iter;
+  StreamQueue* queue_ptr = streams_by_prio_[prio_level].head;
+  while (queue_ptr != nullptr) {
+    StreamQueue* next_queue = queue_ptr->round_robin_links[prio_level].next;
     while (queue_ptr->HasPacketsAtPrio(prio_level) &&
            (now - queue_ptr->LeadingPacketEnqueueTime(prio_level)) >
                time_to_live) {
-      QueuedPacket packet = queue_ptr->DequeuePacket(prio_level);
+      QueuedPacket* packet = queue_ptr->DequeuePacket(prio_level);
       RTC_LOG(LS_INFO) << "Dropping old packet on SSRC: "
-                       << packet.packet->Ssrc()
-                       << " seq:" << packet.packet->SequenceNumber()
-                       << " time in queue:" << (now - packet.enqueue_time).ms()
+                       << packet->packet->Ssrc()
+                       << " seq:" << packet->packet->SequenceNumber()
+                       << " time in queue:" << (now - packet->enqueue_time).ms()
                        << " ms";
-      DequeuePacketInternal(packet);
+      DequeuePacketInternal(*packet);
+      FreeQueuedPacket(packet);
     }
     if (!queue_ptr->HasPacketsAtPrio(prio_level)) {
-      iter = queues.erase(iter);
-    } else {
-      ++iter;
+      RemoveActiveStream(prio_level, queue_ptr);
     }
+    queue_ptr = next_queue;
   }
 }
 
@@ -15,7 +15,6 @@
 
 #include <array>
 #include <deque>
-#include <list>
 #include <memory>
 #include <unordered_map>
 
@@ -93,6 +92,11 @@ class PrioritizedPacketQueue {
   // Set the pause state, while `paused` is true queuing time is not counted.
   void SetPauseState(bool paused, Timestamp now);
 
+  // Average queue time for the packets of the given SSRC currently in the
+  // queue, computed the same way as AverageQueueTime(). Returns
+  // TimeDelta::Zero() if there are no such packets.
+  TimeDelta AverageQueueTimeForSsrc(uint32_t ssrc) const;
+
   // Remove any packets matching the given SSRC.
   void RemovePacketsForSsrc(uint32_t ssrc);
 
@@ -103,13 +107,22 @@ class PrioritizedPacketQueue {
  private:
   static constexpr int kNumPriorityLevels = 5;
 
+  // Queue entry. Entries are pooled and linked into intrusive lists, so that
+  // pushing and popping packets doesn't allocate once the pool is warm.
   class QueuedPacket {
    public:
     DataSize PacketSize() const;
 
     std::unique_ptr<RtpPacketToSend> packet;
-    Timestamp enqueue_time;
-    std::list<Timestamp>::iterator enqueue_time_iterator;
+    // Enqueue time with the pause time at the time of enqueueing subtracted.
+    Timestamp enqueue_time = Timestamp::MinusInfinity();
+    // Enqueue time as given to Push().
+    Timestamp original_enqueue_time = Timestamp::MinusInfinity();
+    // Next packet of the same stream and priority level, or next free entry.
+    QueuedPacket* next = nullptr;
+    // Neighbours in the list of all queued packets, ordered by enqueue time.
+    QueuedPacket* older = nullptr;
+    QueuedPacket* newer = nullptr;
   };
 
   // Class containing packets for an RTP stream.
@@ -117,35 +130,63 @@ class PrioritizedPacketQueue {
   class StreamQueue {
    public:
     explicit StreamQueue(Timestamp creation_time);
-    StreamQueue(StreamQueue&&) = default;
-    StreamQueue& operator=(StreamQueue&&) = default;
 
     StreamQueue(const StreamQueue&) = delete;
     StreamQueue& operator=(const StreamQueue&) = delete;
 
     // Enqueue packet at the given priority level. Returns true if the packet
     // count for that priority level went from zero to non-zero.
-    bool EnqueuePacket(QueuedPacket packet, int priority_level);
+    bool EnqueuePacket(QueuedPacket* packet, int priority_level);
 
-    QueuedPacket DequeuePacket(int priority_level);
+    QueuedPacket* DequeuePacket(int priority_level);
 
     bool HasPacketsAtPrio(int priority_level) const;
     bool IsEmpty() const;
     Timestamp LeadingPacketEnqueueTime(int priority_level) const;
     Timestamp LastEnqueueTime() const;
     bool has_keyframe_packets() const { return num_keyframe_packets_ > 0; }
-
-    std::array<std::deque<QueuedPacket>, kNumPriorityLevels> DequeueAll();
+    int size_packets() const { return size_packets_; }
+    // Sum of `enqueue_time` over all packets in this stream queue.
+    TimeDelta enqueue_time_sum() const { return enqueue_time_sum_; }
+
+    // Links in the round-robin list of streams that have packets pending at a
+    // given priority level. Only valid while the stream is in that list.
+    struct RoundRobinLinks {
+      StreamQueue* prev = nullptr;
+      StreamQueue* next = nullptr;
+    };
+    std::array<RoundRobinLinks, kNumPriorityLevels> round_robin_links;
 
    private:
-    std::deque<QueuedPacket> packets_[kNumPriorityLevels];
+    struct Fifo {
+      QueuedPacket* head = nullptr;
+      QueuedPacket* tail = nullptr;
+    };
+    std::array<Fifo, kNumPriorityLevels> packets_;
     Timestamp last_enqueue_time_;
     int num_keyframe_packets_;
+    int size_packets_;
+    TimeDelta enqueue_time_sum_;
+  };
+
+  // Round-robin list of streams with packets pending at one priority level.
+  struct RoundRobinList {
+    StreamQueue* head = nullptr;
+    StreamQueue* tail = nullptr;
   };
 
   // Remove the packet from the internal state, e.g. queue time / size etc.
   void DequeuePacketInternal(QueuedPacket& packet);
 
+  // Takes an entry from the pool, or allocates one if the pool is empty.
+  QueuedPacket* AllocateQueuedPacket();
+  // Returns an entry to the pool.
+  void FreeQueuedPacket(QueuedPacket* packet);
+
+  bool HasActiveStreams(int prio_level) const;
+  void AppendActiveStream(int prio_level, StreamQueue* stream_queue);
+  void RemoveActiveStream(int prio_level, StreamQueue* stream_queue);
+
   // Check if the queue pointed to by `top_active_prio_level_` is empty and
   // if so move it to the lowest non-empty index.
   void MaybeUpdateTopPrioLevel();
@@ -179,17 +220,22 @@ class PrioritizedPacketQueue {
   // Map from SSRC to packet queues for the associated RTP stream.
   std::unordered_map<uint32_t, std::unique_ptr<StreamQueue>> streams_;
 
-  // For each priority level, a queue of StreamQueues which have at least one
-  // packet pending for that prio level.
-  std::deque<StreamQueue*> streams_by_prio_[kNumPriorityLevels];
+  // For each priority level, a round-robin list of StreamQueues which have at
+  // least one packet pending for that prio level.
+  std::array<RoundRobinList, kNumPriorityLevels> streams_by_prio_;
 
   // The first index into `stream_by_prio_` that is non-empty.
   int top_active_prio_level_;
 
-  // Ordered list of enqueue times. Additions are always increasing and added to
-  // the end. QueuedPacket instances have a iterators into this list for fast
-  // removal.
-  std::list<Timestamp> enqueue_times_;
+  // All queued packets, ordered by enqueue time. Additions are always
+  // increasing and added to the newest end.
+  QueuedPacket* oldest_packet_;
+  QueuedPacket* newest_packet_;
+
+  // Backing storage for queue entries; a deque never moves its elements.
+  // Unused entries are linked from `free_packets_`.
+  std::deque<QueuedPacket> packet_storage_;
+  QueuedPacket* free_packets_;
 };
 
 }  // namespace webrtc
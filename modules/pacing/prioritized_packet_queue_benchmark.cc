@@ -0,0 +1,75 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "benchmark/benchmark.h"
+#include "modules/pacing/prioritized_packet_queue.h"
+#include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/system/unused.h"
+#include "test/benchmark_allocation_counter.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kPacketsPerStream = 10;
+
+// Packets of `num_streams` streams, each with an audio packet, a
+// retransmission and video packets.
+std::vector<std::unique_ptr<RtpPacketToSend>> CreatePackets(int num_streams) {
+  std::vector<std::unique_ptr<RtpPacketToSend>> packets;
+  for (int stream = 0; stream < num_streams; ++stream) {
+    for (int i = 0; i < kPacketsPerStream; ++i) {
+      const bool audio = i == 0;
+      auto packet = std::make_unique<RtpPacketToSend>(/*extensions=*/nullptr);
+      packet->set_packet_type(audio ? RtpPacketMediaType::kAudio
+                                    : RtpPacketMediaType::kVideo);
+      if (i == 1)
+        packet->set_packet_type(RtpPacketMediaType::kRetransmission);
+      packet->SetSsrc(1000 + stream * 2 + audio);
+      packet->SetSequenceNumber(i);
+      packet->SetPayloadSize(audio ? 100 : 1000);
+      packets.push_back(std::move(packet));
+    }
+  }
+  return packets;
+}
+
+// Pushes a burst of packets of `state.range(0)` streams and pops them all in
+// priority order. The packets are reused between iterations, so only the
+// queue itself allocates.
+void BM_PrioritizedPacketQueuePushPop(benchmark::State& state) {
+  std::vector<std::unique_ptr<RtpPacketToSend>> packets =
+      CreatePackets(state.range(0));
+  Timestamp now = Timestamp::Seconds(1000);
+  PrioritizedPacketQueue queue(now);
+  test::ScopedAllocationCounter allocations(state);
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    for (std::unique_ptr<RtpPacketToSend>& packet : packets)
+      queue.Push(now, std::move(packet));
+    packets.clear();
+    while (!queue.Empty())
+      packets.push_back(queue.Pop());
+    now += TimeDelta::Millis(5);
+  }
+  state.SetItemsProcessed(state.iterations() * packets.size());
+}
+
+BENCHMARK(BM_PrioritizedPacketQueuePushPop)->Arg(1)->Arg(10)->Arg(100);
+
+}  // namespace
+}  // namespace webrtc
@@ -262,6 +262,37 @@ TEST(PrioritizedPacketQueue, SubtractsPusedTimeFromAverageQueueTime) {
   EXPECT_EQ(queue.AverageQueueTime(), TimeDelta::Millis(750));
 }
 
+TEST(PrioritizedPacketQueue, ReportsAverageQueueTimePerSsrc) {
+  PrioritizedPacketQueue queue(/*creation_time=*/Timestamp::Zero());
+  EXPECT_EQ(queue.AverageQueueTimeForSsrc(kDefaultSsrc), TimeDelta::Zero());
+
+  queue.Push(Timestamp::Millis(10),
+             CreatePacket(RtpPacketMediaType::kVideo, /*seq=*/1, /*ssrc=*/1));
+  queue.Push(Timestamp::Millis(20),
+             CreatePacket(RtpPacketMediaType::kVideo, /*seq=*/2, /*ssrc=*/2));
+  queue.Push(Timestamp::Millis(30),
+             CreatePacket(RtpPacketMediaType::kVideo, /*seq=*/3, /*ssrc=*/1));
+
+  queue.UpdateAverageQueueTime(Timestamp::Millis(40));
+  // SSRC 1 packets have waited 30 and 10 ms, SSRC 2 packet 20 ms.
+  EXPECT_EQ(queue.AverageQueueTimeForSsrc(1), TimeDelta::Millis(20));
+  EXPECT_EQ(queue.AverageQueueTimeForSsrc(2), TimeDelta::Millis(20));
+
+  // Paused time is not counted.
+  queue.SetPauseState(true, Timestamp::Millis(40));
+  queue.SetPauseState(false, Timestamp::Millis(140));
+  queue.UpdateAverageQueueTime(Timestamp::Millis(150));
+  EXPECT_EQ(queue.AverageQueueTimeForSsrc(1), TimeDelta::Millis(30));
+
+  queue.Pop();  // Pop SSRC 1 packet with enqueue time 10.
+  EXPECT_EQ(queue.AverageQueueTimeForSsrc(1), TimeDelta::Millis(20));
+  EXPECT_EQ(queue.AverageQueueTimeForSsrc(2), TimeDelta::Millis(30));
+
+  queue.RemovePacketsForSsrc(2);
+  EXPECT_EQ(queue.AverageQueueTimeForSsrc(2), TimeDelta::Zero());
+  EXPECT_EQ(queue.AverageQueueTime(), TimeDelta::Millis(20));
+}
+
 TEST(PrioritizedPacketQueue, ReportsLeadingPacketEnqueueTime) {
   PrioritizedPacketQueue queue(/*creation_time=*/Timestamp::Zero());
   EXPECT_EQ(queue.LeadingPacketEnqueueTime(RtpPacketMediaType::kAudio),
@@ -430,6 +461,27 @@ TEST(PrioritizedPacketQueue, ClearPacketsAffectsOnlySpecifiedSsrc) {
   EXPECT_TRUE(queue.Empty());
 }
 
+TEST(PrioritizedPacketQueue, ClearPacketsKeepsRoundRobinOrderOfOtherSsrcs) {
+  PrioritizedPacketQueue queue(/*creation_time=*/Timestamp::Zero());
+  for (uint16_t seq = 0; seq < 2; ++seq) {
+    for (uint32_t ssrc = 1; ssrc <= 3; ++ssrc) {
+      queue.Push(Timestamp::Millis(seq),
+                 CreatePacket(RtpPacketMediaType::kVideo, seq, ssrc));
+    }
+  }
+
+  queue.RemovePacketsForSsrc(2);
+  EXPECT_EQ(queue.SizeInPackets(), 4);
+  EXPECT_EQ(queue.OldestEnqueueTime(), Timestamp::Millis(0));
+
+  EXPECT_EQ(queue.Pop()->Ssrc(), 1u);
+  EXPECT_EQ(queue.Pop()->Ssrc(), 3u);
+  EXPECT_EQ(queue.Pop()->Ssrc(), 1u);
+  EXPECT_EQ(queue.Pop()->Ssrc(), 3u);
+  EXPECT_TRUE(queue.Empty());
+  EXPECT_EQ(queue.OldestEnqueueTime(), Timestamp::MinusInfinity());
+}
+
 TEST(PrioritizedPacketQueue, ReportsKeyframePackets) {
   Timestamp now = Timestamp::Zero();
   PrioritizedPacketQueue queue(now);
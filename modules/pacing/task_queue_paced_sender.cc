@@ -28,12 +28,16 @@ TaskQueuePacedSender::TaskQueuePacedSender(
     PacingController::PacketSender* packet_sender,
     const FieldTrialsView& field_trials,
     TimeDelta max_hold_back_window,
-    int max_hold_back_window_in_packets)
+    int max_hold_back_window_in_packets,
+    Metronome* metronome)
     : clock_(clock),
       max_hold_back_window_(max_hold_back_window),
       max_hold_back_window_in_packets_(max_hold_back_window_in_packets),
-      pacing_controller_(clock, packet_sender, field_trials),
+      metronome_(metronome),
+      caching_clock_(clock),
+      pacing_controller_(&caching_clock_, packet_sender, field_trials),
       next_process_time_(Timestamp::MinusInfinity()),
+      tick_requested_(false),
       is_started_(false),
       is_shutdown_(false),
       packet_size_(/*alpha=*/0.95),
@@ -220,7 +224,12 @@ void TaskQueuePacedSender::MaybeProcessPackets(
 
   // Process packets and update stats.
   while (next_send_time <= now + early_execute_margin) {
-    pacing_controller_.ProcessPackets();
+    {
+      // One time read for the whole iteration, shared with any other
+      // CachingClock read while sending the packets.
+      ScopedClockCache clock_cache;
+      pacing_controller_.ProcessPackets();
+    }
     next_send_time = pacing_controller_.NextSendTime();
     RTC_DCHECK(next_send_time.IsFinite());
 
@@ -260,6 +269,21 @@ void TaskQueuePacedSender::MaybeProcessPackets(
       std::max(hold_back_window, next_send_time - now - early_execute_margin);
   next_send_time = now + time_to_next_process;
 
+  // Unless probing, a wait that ends within the next metronome tick is taken
+  // over by the metronome, coalescing it with the wakeups of other pacers.
+  if (metronome_ != nullptr && !pacing_controller_.IsProbing() &&
+      time_to_next_process <= metronome_->TickPeriod()) {
+    if (!tick_requested_) {
+      tick_requested_ = true;
+      metronome_->RequestCallOnNextTick(SafeTask(safety_.flag(), [this] {
+        RTC_DCHECK_RUN_ON(task_queue_);
+        tick_requested_ = false;
+        MaybeProcessPackets(Timestamp::MinusInfinity());
+      }));
+    }
+    return;
+  }
+
   // If no in flight task or in flight task is later than `next_send_time`,
   // schedule a new one. Previous in flight task will be retired.
   if (next_process_time_.IsMinusInfinity() ||
@@ -19,6 +19,7 @@
 #include <utility>
 #include <vector>
 
+#include "api/metronome/test/fake_metronome.h"
 #include "api/task_queue/task_queue_base.h"
 #include "api/task_queue/task_queue_factory.h"
 #include "api/transport/network_types.h"
@@ -693,6 +694,52 @@ TEST(TaskQueuePacedSenderTest, PostedPacketsNotSendFromRemovePacketsForSsrc) {
   EXPECT_EQ(pacer.ExpectedQueueTime(), TimeDelta::Zero());
 }
 
+TEST(TaskQueuePacedSenderTest, WakesUpOnSharedMetronomeTick) {
+  GlobalSimulatedTimeController time_controller(Timestamp::Millis(1234));
+  ScopedKeyValueConfig trials;
+  ForcedTickMetronome metronome(TimeDelta::Millis(10));
+  NiceMock<MockPacketRouter> packet_router;
+  TaskQueuePacedSender pacer1(time_controller.GetClock(), &packet_router,
+                              trials, PacingController::kMinSleepTime,
+                              TaskQueuePacedSender::kNoPacketHoldback,
+                              &metronome);
+  TaskQueuePacedSender pacer2(time_controller.GetClock(), &packet_router,
+                              trials, PacingController::kMinSleepTime,
+                              TaskQueuePacedSender::kNoPacketHoldback,
+                              &metronome);
+
+  // One packet every 5ms, which is shorter than the tick period.
+  const DataRate kPacingRate = DataRate::BytesPerSec(kDefaultPacketSize * 200);
+  for (TaskQueuePacedSender* pacer : {&pacer1, &pacer2}) {
+    pacer->SetSendBurstInterval(TimeDelta::Zero());
+    pacer->SetPacingRates(kPacingRate, DataRate::Zero());
+    pacer->EnsureStarted();
+  }
+
+  size_t packets_sent = 0;
+  EXPECT_CALL(packet_router, SendPacket).WillRepeatedly([&] {
+    ++packets_sent;
+  });
+  pacer1.EnqueuePackets(GeneratePackets(RtpPacketMediaType::kVideo, 100));
+  pacer2.EnqueuePackets(GeneratePackets(RtpPacketMediaType::kVideo, 100));
+  time_controller.AdvanceTime(TimeDelta::Zero());
+
+  // The first packet of each pacer goes out right away, after which both
+  // pacers wait for the next tick rather than on timers of their own.
+  EXPECT_EQ(packets_sent, 2u);
+  EXPECT_EQ(metronome.NumListeners(), 2u);
+  time_controller.AdvanceTime(TimeDelta::Millis(50));
+  EXPECT_EQ(packets_sent, 2u);
+
+  // On the tick, both pacers catch up on what they owe and go back to waiting
+  // for the metronome.
+  metronome.Tick();
+  time_controller.AdvanceTime(TimeDelta::Zero());
+  EXPECT_GE(packets_sent, 4u);
+  EXPECT_LT(packets_sent, 200u);
+  EXPECT_EQ(metronome.NumListeners(), 2u);
+}
+
 TEST(TaskQueuePacedSenderTest, Stats) {
   static constexpr Timestamp kStartTime = Timestamp::Millis(1234);
   GlobalSimulatedTimeController time_controller(kStartTime);
@@ -84,6 +84,19 @@ void RemoteEstimatorProxy::MaybeCullOldPackets(int64_t sequence_number,
 }
 
 void RemoteEstimatorProxy::IncomingPacket(const RtpPacketReceived& packet) {
+  MutexLock lock(&lock_);
+  AddPacket(packet);
+}
+
+void RemoteEstimatorProxy::IncomingPackets(
+    rtc::ArrayView<const RtpPacketReceived* const> packets) {
+  MutexLock lock(&lock_);
+  for (const RtpPacketReceived* packet : packets) {
+    AddPacket(*packet);
+  }
+}
+
+void RemoteEstimatorProxy::AddPacket(const RtpPacketReceived& packet) {
   if (packet.arrival_time().IsInfinite()) {
     RTC_LOG(LS_WARNING) << "Arrival time not set.";
     return;
@@ -103,7 +116,6 @@ void RemoteEstimatorProxy::IncomingPacket(const RtpPacketReceived& packet) {
     return;
   }
 
-  MutexLock lock(&lock_);
   send_periodic_feedback_ = packet.HasExtension<TransportSequenceNumber>();
 
   media_ssrc_ = packet.Ssrc();
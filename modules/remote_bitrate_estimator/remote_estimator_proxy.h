@@ -17,6 +17,7 @@
 #include <vector>
 
 #include "absl/types/optional.h"
+#include "api/array_view.h"
 #include "api/field_trials_view.h"
 #include "api/rtp_headers.h"
 #include "api/transport/network_control.h"
@@ -46,6 +47,9 @@ class RemoteEstimatorProxy {
   ~RemoteEstimatorProxy();
 
   void IncomingPacket(const RtpPacketReceived& packet);
+  // Same as calling IncomingPacket for each of `packets`, but only takes the
+  // lock once. Useful when a burst of packets is received at once.
+  void IncomingPackets(rtc::ArrayView<const RtpPacketReceived* const> packets);
 
   // Sends periodic feedback if it is time to send it.
   // Returns time until next call to Process should be made.
@@ -55,6 +59,8 @@ class RemoteEstimatorProxy {
   void SetTransportOverhead(DataSize overhead_per_packet);
 
  private:
+  void AddPacket(const RtpPacketReceived& packet)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(&lock_);
   void MaybeCullOldPackets(int64_t sequence_number, Timestamp arrival_time)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(&lock_);
   void SendPeriodicFeedbacks() RTC_EXCLUSIVE_LOCKS_REQUIRED(&lock_);
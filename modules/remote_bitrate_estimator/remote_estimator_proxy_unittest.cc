@@ -165,6 +165,36 @@ TEST_F(RemoteEstimatorProxyTest, DuplicatedPackets) {
   Process();
 }
 
+TEST_F(RemoteEstimatorProxyTest, SendsFeedbackForBatchOfPackets) {
+  RtpHeaderExtensionMap map;
+  map.Register<TransportSequenceNumber>(1);
+  std::vector<RtpPacketReceived> packets;
+  for (int i = 0; i < 3; ++i) {
+    RtpPacketReceived& packet = packets.emplace_back(
+        &map, kBaseTime + TimeDelta::Millis(i));
+    packet.SetSsrc(kMediaSsrc);
+    packet.SetExtension<TransportSequenceNumber>(kBaseSeq + i);
+  }
+  std::vector<const RtpPacketReceived*> burst = {&packets[0], &packets[2],
+                                                 &packets[1], &packets[2]};
+  proxy_.IncomingPackets(burst);
+
+  EXPECT_CALL(feedback_sender_, Call)
+      .WillOnce(Invoke(
+          [](std::vector<std::unique_ptr<rtcp::RtcpPacket>> feedback_packets) {
+            rtcp::TransportFeedback* feedback_packet =
+                static_cast<rtcp::TransportFeedback*>(
+                    feedback_packets[0].get());
+            EXPECT_THAT(SequenceNumbers(*feedback_packet),
+                        ElementsAre(kBaseSeq, kBaseSeq + 1, kBaseSeq + 2));
+            EXPECT_THAT(Timestamps(*feedback_packet),
+                        ElementsAre(kBaseTime, kBaseTime + TimeDelta::Millis(1),
+                                    kBaseTime + TimeDelta::Millis(2)));
+          }));
+
+  Process();
+}
+
 TEST_F(RemoteEstimatorProxyTest, FeedbackWithMissingStart) {
   // First feedback.
   IncomingPacket(kBaseSeq, kBaseTime);
@@ -79,6 +79,7 @@ class MockRtpRtcpInterface : public RtpRtcpInterface {
   MOCK_METHOD(bool, IsAudioConfigured, (), (const, override));
   MOCK_METHOD(void, SetAsPartOfAllocation, (bool), (override));
   MOCK_METHOD(RtpSendRates, GetSendRates, (), (const, override));
+  MOCK_METHOD(size_t, GetPacketHistoryMemoryUsageBytes, (), (const, override));
   MOCK_METHOD(bool,
               OnSendingRtpFrame,
               (uint32_t, int64_t, int, bool),
@@ -21,6 +21,7 @@
 #include "modules/rtp_rtcp/source/byte_io.h"
 #include "modules/rtp_rtcp/source/flexfec_03_header_reader_writer.h"
 #include "modules/rtp_rtcp/source/forward_error_correction_internal.h"
+#include "modules/rtp_rtcp/source/forward_error_correction_xor.h"
 #include "modules/rtp_rtcp/source/ulpfec_header_reader_writer.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
@@ -62,6 +63,24 @@ bool ForwardErrorCorrection::SortablePacket::LessThan::operator()(
   return IsNewerSequenceNumber(second->seq_num, first->seq_num);
 }
 
+namespace {
+
+// Returns where to insert `packet` to keep `list` sorted. Searches from the
+// back, since packets mostly arrive in order. Takes the derived packet type,
+// since ReceivedFecPacket shadows the `ssrc` of SortablePacket.
+template <typename List, typename PacketType>
+typename List::iterator SortedInsertPosition(List& list,
+                                             const PacketType& packet) {
+  ForwardErrorCorrection::SortablePacket::LessThan less_than;
+  auto it = list.end();
+  while (it != list.begin() && less_than(&packet, *std::prev(it))) {
+    --it;
+  }
+  return it;
+}
+
+}  // namespace
+
 ForwardErrorCorrection::ReceivedPacket::ReceivedPacket() = default;
 ForwardErrorCorrection::ReceivedPacket::~ReceivedPacket() = default;
 
@@ -341,8 +360,56 @@ void ForwardErrorCorrection::FinalizeFecHeaders(size_t num_fec_packets,
 void ForwardErrorCorrection::ResetState(
     RecoveredPacketList* recovered_packets) {
   // Free the memory for any existing recovered packets, if the caller hasn't.
-  recovered_packets->clear();
-  received_fec_packets_.clear();
+  DiscardRecoveredPackets(*recovered_packets, recovered_packets->begin(),
+                          recovered_packets->end());
+  DiscardFecPackets(received_fec_packets_, received_fec_packets_.begin(),
+                    received_fec_packets_.end());
+}
+
+void ForwardErrorCorrection::AddRecoveredPacket(RecoveredPacketList& list) {
+  if (recovered_packet_pool_.empty()) {
+    list.push_back(std::make_unique<RecoveredPacket>());
+  } else {
+    list.splice(list.end(), recovered_packet_pool_,
+                recovered_packet_pool_.begin());
+  }
+}
+
+void ForwardErrorCorrection::AddFecPacket(ReceivedFecPacketList& list) {
+  if (fec_packet_pool_.empty()) {
+    list.push_back(std::make_unique<ReceivedFecPacket>());
+  } else {
+    list.splice(list.end(), fec_packet_pool_, fec_packet_pool_.begin());
+  }
+}
+
+ForwardErrorCorrection::RecoveredPacketList::iterator
+ForwardErrorCorrection::DiscardRecoveredPackets(
+    RecoveredPacketList& list,
+    RecoveredPacketList::iterator first,
+    RecoveredPacketList::iterator last) {
+  for (auto it = first; it != last; ++it) {
+    (*it)->pkt = nullptr;
+  }
+  recovered_packet_pool_.splice(recovered_packet_pool_.end(), list, first,
+                                last);
+  return last;
+}
+
+ForwardErrorCorrection::ReceivedFecPacketList::iterator
+ForwardErrorCorrection::DiscardFecPackets(
+    ReceivedFecPacketList& list,
+    ReceivedFecPacketList::iterator first,
+    ReceivedFecPacketList::iterator last) {
+  for (auto it = first; it != last; ++it) {
+    ReceivedFecPacket& fec_packet = **it;
+    // Keeps the capacity of `protected_packets`.
+    fec_packet.protected_packets.clear();
+    fec_packet.protected_streams.clear();
+    fec_packet.pkt = nullptr;
+  }
+  fec_packet_pool_.splice(fec_packet_pool_.end(), list, first, last);
+  return last;
 }
 
 void ForwardErrorCorrection::InsertMediaPacket(
@@ -359,20 +426,19 @@ void ForwardErrorCorrection::InsertMediaPacket(
     }
   }
 
-  std::unique_ptr<RecoveredPacket> recovered_packet(new RecoveredPacket());
+  RecoveredPacketList new_packet;
+  AddRecoveredPacket(new_packet);
+  RecoveredPacket& recovered_packet = *new_packet.front();
   // This "recovered packet" was not recovered using parity packets.
-  recovered_packet->was_recovered = false;
+  recovered_packet.was_recovered = false;
   // This media packet has already been passed on.
-  recovered_packet->returned = true;
-  recovered_packet->ssrc = received_packet.ssrc;
-  recovered_packet->seq_num = received_packet.seq_num;
-  recovered_packet->pkt = received_packet.pkt;
-  // TODO(holmer): Consider replacing this with a binary search for the right
-  // position, and then just insert the new packet. Would get rid of the sort.
-  RecoveredPacket* recovered_packet_ptr = recovered_packet.get();
-  recovered_packets->push_back(std::move(recovered_packet));
-  recovered_packets->sort(SortablePacket::LessThan());
-  UpdateCoveringFecPackets(*recovered_packet_ptr);
+  recovered_packet.returned = true;
+  recovered_packet.ssrc = received_packet.ssrc;
+  recovered_packet.seq_num = received_packet.seq_num;
+  recovered_packet.pkt = received_packet.pkt;
+  recovered_packets->splice(
+      SortedInsertPosition(*recovered_packets, recovered_packet), new_packet);
+  UpdateCoveringFecPackets(recovered_packet);
 }
 
 void ForwardErrorCorrection::UpdateCoveringFecPackets(
@@ -380,11 +446,16 @@ void ForwardErrorCorrection::UpdateCoveringFecPackets(
   for (auto& fec_packet : received_fec_packets_) {
     // Is this FEC packet protecting the media packet `packet`?
     auto protected_it = absl::c_lower_bound(
-        fec_packet->protected_packets, &packet, SortablePacket::LessThan());
+        fec_packet->protected_packets, packet,
+        [](const ProtectedPacket& protected_packet,
+           const RecoveredPacket& recovered_packet) {
+          return IsNewerSequenceNumber(recovered_packet.seq_num,
+                                       protected_packet.seq_num);
+        });
     if (protected_it != fec_packet->protected_packets.end() &&
-        (*protected_it)->seq_num == packet.seq_num) {
+        protected_it->seq_num == packet.seq_num) {
       // Found an FEC packet which is protecting `packet`.
-      (*protected_it)->pkt = packet.pkt;
+      protected_it->pkt = packet.pkt;
     }
   }
 }
@@ -403,14 +474,41 @@ void ForwardErrorCorrection::InsertFecPacket(
     }
   }
 
-  std::unique_ptr<ReceivedFecPacket> fec_packet(new ReceivedFecPacket());
+  ReceivedFecPacketList new_packet;
+  AddFecPacket(new_packet);
+  ReceivedFecPacket* fec_packet = new_packet.front().get();
+  if (!ParseFecPacket(received_packet, fec_packet)) {
+    DiscardFecPackets(new_packet, new_packet.begin(), new_packet.end());
+    return;
+  }
+
+  if (fec_packet->protected_packets.empty()) {
+    // All-zero packet mask; we can discard this FEC packet.
+    RTC_LOG(LS_WARNING) << "Received FEC packet has an all-zero packet mask.";
+    DiscardFecPackets(new_packet, new_packet.begin(), new_packet.end());
+  } else {
+    AssignRecoveredPackets(recovered_packets, fec_packet);
+    received_fec_packets_.splice(
+        SortedInsertPosition(received_fec_packets_, *fec_packet), new_packet);
+    const size_t max_fec_packets = fec_header_reader_->MaxFecPackets();
+    if (received_fec_packets_.size() > max_fec_packets) {
+      DiscardFecPackets(received_fec_packets_, received_fec_packets_.begin(),
+                        std::next(received_fec_packets_.begin()));
+    }
+    RTC_DCHECK_LE(received_fec_packets_.size(), max_fec_packets);
+  }
+}
+
+bool ForwardErrorCorrection::ParseFecPacket(
+    const ReceivedPacket& received_packet,
+    ReceivedFecPacket* fec_packet) const {
   fec_packet->pkt = received_packet.pkt;
   fec_packet->ssrc = received_packet.ssrc;
   fec_packet->seq_num = received_packet.seq_num;
   // Parse ULPFEC/FlexFEC header specific info.
-  bool ret = fec_header_reader_->ReadFecHeader(fec_packet.get());
+  bool ret = fec_header_reader_->ReadFecHeader(fec_packet);
   if (!ret) {
-    return;
+    return false;
   }
 
   RTC_CHECK_EQ(fec_packet->protected_streams.size(), 1);
@@ -418,17 +516,20 @@ void ForwardErrorCorrection::InsertFecPacket(
   if (fec_packet->protected_streams[0].ssrc != protected_media_ssrc_) {
     RTC_LOG(LS_INFO)
         << "Received FEC packet is protecting an unknown media SSRC; dropping.";
-    return;
+    return false;
   }
 
   if (fec_packet->protected_streams[0].packet_mask_offset +
           fec_packet->protected_streams[0].packet_mask_size >
       fec_packet->pkt->data.size()) {
     RTC_LOG(LS_INFO) << "Received corrupted FEC packet; dropping.";
-    return;
+    return false;
   }
 
   // Parse packet mask from header and represent as protected packets.
+  // Reusing a discarded packet, this reserves nothing once the pool is warm.
+  fec_packet->protected_packets.reserve(
+      fec_packet->protected_streams[0].packet_mask_size * 8);
   for (uint16_t byte_idx = 0;
        byte_idx < fec_packet->protected_streams[0].packet_mask_size;
        ++byte_idx) {
@@ -438,57 +539,40 @@ void ForwardErrorCorrection::InsertFecPacket(
                    byte_idx];
     for (uint16_t bit_idx = 0; bit_idx < 8; ++bit_idx) {
       if (packet_mask & (1 << (7 - bit_idx))) {
-        std::unique_ptr<ProtectedPacket> protected_packet(
-            new ProtectedPacket());
+        ProtectedPacket& protected_packet =
+            fec_packet->protected_packets.emplace_back();
         // This wraps naturally with the sequence number.
-        protected_packet->ssrc = protected_media_ssrc_;
-        protected_packet->seq_num = static_cast<uint16_t>(
+        protected_packet.ssrc = protected_media_ssrc_;
+        protected_packet.seq_num = static_cast<uint16_t>(
             fec_packet->protected_streams[0].seq_num_base + (byte_idx << 3) +
             bit_idx);
-        protected_packet->pkt = nullptr;
-        fec_packet->protected_packets.push_back(std::move(protected_packet));
+        protected_packet.pkt = nullptr;
       }
     }
   }
-
-  if (fec_packet->protected_packets.empty()) {
-    // All-zero packet mask; we can discard this FEC packet.
-    RTC_LOG(LS_WARNING) << "Received FEC packet has an all-zero packet mask.";
-  } else {
-    AssignRecoveredPackets(recovered_packets, fec_packet.get());
-    // TODO(holmer): Consider replacing this with a binary search for the right
-    // position, and then just insert the new packet. Would get rid of the sort.
-    received_fec_packets_.push_back(std::move(fec_packet));
-    received_fec_packets_.sort(SortablePacket::LessThan());
-    const size_t max_fec_packets = fec_header_reader_->MaxFecPackets();
-    if (received_fec_packets_.size() > max_fec_packets) {
-      received_fec_packets_.pop_front();
-    }
-    RTC_DCHECK_LE(received_fec_packets_.size(), max_fec_packets);
-  }
+  return true;
 }
 
 void ForwardErrorCorrection::AssignRecoveredPackets(
     const RecoveredPacketList& recovered_packets,
     ReceivedFecPacket* fec_packet) {
   ProtectedPacketList* protected_packets = &fec_packet->protected_packets;
-  std::vector<RecoveredPacket*> recovered_protected_packets;
 
   // Find intersection between the (sorted) containers `protected_packets`
   // and `recovered_packets`, i.e. all protected packets that have already
   // been recovered. Update the corresponding protected packets to point to
   // the recovered packets.
-  auto it_p = protected_packets->cbegin();
+  auto it_p = protected_packets->begin();
   auto it_r = recovered_packets.cbegin();
   SortablePacket::LessThan less_than;
   while (it_p != protected_packets->end() && it_r != recovered_packets.end()) {
-    if (less_than(*it_p, *it_r)) {
+    if (less_than(&*it_p, *it_r)) {
       ++it_p;
-    } else if (less_than(*it_r, *it_p)) {
+    } else if (less_than(*it_r, &*it_p)) {
       ++it_r;
     } else {  // *it_p == *it_r.
       // This protected packet has already been recovered.
-      (*it_p)->pkt = (*it_r)->pkt;
+      it_p->pkt = (*it_r)->pkt;
       ++it_p;
       ++it_r;
     }
@@ -514,7 +598,7 @@ void ForwardErrorCorrection::InsertPacket(
     while (it != received_fec_packets_.end()) {
       uint16_t seq_num_diff = MinDiff(received_packet.seq_num, (*it)->seq_num);
       if (seq_num_diff > kOldSequenceThreshold) {
-        it = received_fec_packets_.erase(it);
+        it = DiscardFecPackets(received_fec_packets_, it, std::next(it));
       } else {
         // No need to keep iterating, since `received_fec_packets_` is sorted.
         break;
@@ -635,11 +719,8 @@ void ForwardErrorCorrection::XorPayloads(const Packet& src,
     dst->data.SetSize(new_size);
     memset(dst->data.MutableData() + old_size, 0, new_size - old_size);
   }
-  uint8_t* dst_data = dst->data.MutableData();
-  const uint8_t* src_data = src.data.cdata();
-  for (size_t i = 0; i < payload_length; ++i) {
-    dst_data[dst_offset + i] ^= src_data[kRtpHeaderSize + i];
-  }
+  internal::XorBytes(src.data.cdata() + kRtpHeaderSize, payload_length,
+                     dst->data.MutableData() + dst_offset);
 }
 
 bool ForwardErrorCorrection::RecoverPacket(const ReceivedFecPacket& fec_packet,
@@ -648,14 +729,14 @@ bool ForwardErrorCorrection::RecoverPacket(const ReceivedFecPacket& fec_packet,
     return false;
   }
   for (const auto& protected_packet : fec_packet.protected_packets) {
-    if (protected_packet->pkt == nullptr) {
+    if (protected_packet.pkt == nullptr) {
       // This is the packet we're recovering.
-      recovered_packet->seq_num = protected_packet->seq_num;
-      recovered_packet->ssrc = protected_packet->ssrc;
+      recovered_packet->seq_num = protected_packet.seq_num;
+      recovered_packet->ssrc = protected_packet.ssrc;
     } else {
-      XorHeaders(*protected_packet->pkt, recovered_packet->pkt.get());
-      XorPayloads(*protected_packet->pkt,
-                  protected_packet->pkt->data.size() - kRtpHeaderSize,
+      XorHeaders(*protected_packet.pkt, recovered_packet->pkt.get());
+      XorPayloads(*protected_packet.pkt,
+                  protected_packet.pkt->data.size() - kRtpHeaderSize,
                   kRtpHeaderSize, recovered_packet->pkt.get());
     }
   }
@@ -677,27 +758,29 @@ size_t ForwardErrorCorrection::AttemptRecovery(
     // We can only recover one packet with an FEC packet.
     if (packets_missing == 1) {
       // Recovery possible.
-      std::unique_ptr<RecoveredPacket> recovered_packet(new RecoveredPacket());
-      recovered_packet->pkt = nullptr;
-      if (!RecoverPacket(**fec_packet_it, recovered_packet.get())) {
+      RecoveredPacketList new_packet;
+      AddRecoveredPacket(new_packet);
+      RecoveredPacket& recovered_packet = *new_packet.front();
+      if (!RecoverPacket(**fec_packet_it, &recovered_packet)) {
         // Can't recover using this packet, drop it.
-        fec_packet_it = received_fec_packets_.erase(fec_packet_it);
+        DiscardRecoveredPackets(new_packet, new_packet.begin(),
+                                new_packet.end());
+        fec_packet_it = DiscardFecPackets(received_fec_packets_, fec_packet_it,
+                                          std::next(fec_packet_it));
         continue;
       }
 
       ++num_recovered_packets;
 
-      auto* recovered_packet_ptr = recovered_packet.get();
       // Add recovered packet to the list of recovered packets and update any
       // FEC packets covering this packet with a pointer to the data.
-      // TODO(holmer): Consider replacing this with a binary search for the
-      // right position, and then just insert the new packet. Would get rid of
-      // the sort.
-      recovered_packets->push_back(std::move(recovered_packet));
-      recovered_packets->sort(SortablePacket::LessThan());
-      UpdateCoveringFecPackets(*recovered_packet_ptr);
+      recovered_packets->splice(
+          SortedInsertPosition(*recovered_packets, recovered_packet),
+          new_packet);
+      UpdateCoveringFecPackets(recovered_packet);
       DiscardOldRecoveredPackets(recovered_packets);
-      fec_packet_it = received_fec_packets_.erase(fec_packet_it);
+      DiscardFecPackets(received_fec_packets_, fec_packet_it,
+                        std::next(fec_packet_it));
 
       // A packet has been recovered. We need to check the FEC list again, as
       // this may allow additional packets to be recovered.
@@ -707,7 +790,8 @@ size_t ForwardErrorCorrection::AttemptRecovery(
                IsOldFecPacket(**fec_packet_it, recovered_packets)) {
       // Either all protected packets arrived or have been recovered, or the FEC
       // packet is old. We can discard this FEC packet.
-      fec_packet_it = received_fec_packets_.erase(fec_packet_it);
+      fec_packet_it = DiscardFecPackets(received_fec_packets_, fec_packet_it,
+                                        std::next(fec_packet_it));
     } else {
       fec_packet_it++;
     }
@@ -720,7 +804,7 @@ int ForwardErrorCorrection::NumCoveredPacketsMissing(
     const ReceivedFecPacket& fec_packet) {
   int packets_missing = 0;
   for (const auto& protected_packet : fec_packet.protected_packets) {
-    if (protected_packet->pkt == nullptr) {
+    if (protected_packet.pkt == nullptr) {
       ++packets_missing;
       if (packets_missing > 1) {
         break;  // We can't recover more than one packet.
@@ -733,8 +817,11 @@ int ForwardErrorCorrection::NumCoveredPacketsMissing(
 void ForwardErrorCorrection::DiscardOldRecoveredPackets(
     RecoveredPacketList* recovered_packets) {
   const size_t max_media_packets = fec_header_reader_->MaxMediaPackets();
-  while (recovered_packets->size() > max_media_packets) {
-    recovered_packets->pop_front();
+  if (recovered_packets->size() > max_media_packets) {
+    DiscardRecoveredPackets(
+        *recovered_packets, recovered_packets->begin(),
+        std::next(recovered_packets->begin(),
+                  recovered_packets->size() - max_media_packets));
   }
   RTC_DCHECK_LE(recovered_packets->size(), max_media_packets);
 }
@@ -748,7 +835,7 @@ bool ForwardErrorCorrection::IsOldFecPacket(
 
   const uint16_t back_recovered_seq_num = recovered_packets->back()->seq_num;
   const uint16_t last_protected_seq_num =
-      fec_packet.protected_packets.back()->seq_num;
+      fec_packet.protected_packets.back().seq_num;
 
   // FEC packet is old if its last protected sequence number is much
   // older than the latest protected sequence number received.
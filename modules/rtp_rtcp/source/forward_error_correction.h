@@ -117,7 +117,8 @@ class ForwardErrorCorrection {
     rtc::scoped_refptr<ForwardErrorCorrection::Packet> pkt;
   };
 
-  using ProtectedPacketList = std::list<std::unique_ptr<ProtectedPacket>>;
+  // Sorted by sequence number.
+  using ProtectedPacketList = std::vector<ProtectedPacket>;
 
   struct ProtectedStream {
     uint32_t ssrc = 0;
@@ -246,7 +247,8 @@ class ForwardErrorCorrection {
   size_t MaxPacketOverhead() const;
 
   // Reset internal states from last frame and clear `recovered_packets`.
-  // Frees all memory allocated by this class.
+  // Releases all packet data held by this class, but keeps the emptied
+  // packets for reuse.
   void ResetState(RecoveredPacketList* recovered_packets);
 
   // TODO(brandtr): Remove these functions when the Packet classes
@@ -300,6 +302,28 @@ class ForwardErrorCorrection {
   void InsertFecPacket(const RecoveredPacketList& recovered_packets,
                        const ReceivedPacket& received_packet);
 
+  // Parses the FEC header of `received_packet` into `fec_packet`, including
+  // the list of protected packets. Returns false if the packet is unusable.
+  bool ParseFecPacket(const ReceivedPacket& received_packet,
+                      ReceivedFecPacket* fec_packet) const;
+
+  // Moves an empty packet to the end of `list`, taking it from the pool of
+  // discarded packets when possible so that steady state decoding doesn't
+  // allocate.
+  void AddRecoveredPacket(RecoveredPacketList& list);
+  void AddFecPacket(ReceivedFecPacketList& list);
+
+  // Releases the data of packets [`first`, `last`) of `list` and moves them to
+  // the pool of discarded packets. Returns `last`.
+  RecoveredPacketList::iterator DiscardRecoveredPackets(
+      RecoveredPacketList& list,
+      RecoveredPacketList::iterator first,
+      RecoveredPacketList::iterator last);
+  ReceivedFecPacketList::iterator DiscardFecPackets(
+      ReceivedFecPacketList& list,
+      ReceivedFecPacketList::iterator first,
+      ReceivedFecPacketList::iterator last);
+
   // Assigns pointers to already recovered packets covered by `fec_packet`.
   static void AssignRecoveredPackets(
       const RecoveredPacketList& recovered_packets,
@@ -361,6 +385,11 @@ class ForwardErrorCorrection {
   std::vector<Packet> generated_fec_packets_;
   ReceivedFecPacketList received_fec_packets_;
 
+  // Discarded packets kept for reuse. Both the list nodes and the packets,
+  // including the capacity of their protected packet lists, are recycled.
+  RecoveredPacketList recovered_packet_pool_;
+  ReceivedFecPacketList fec_packet_pool_;
+
   // Arrays used to avoid dynamically allocating memory when generating
   // the packet masks.
   // (There are never more than `kUlpfecMaxMediaPackets` FEC packets generated.)
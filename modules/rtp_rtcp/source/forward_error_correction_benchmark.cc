@@ -0,0 +1,127 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "modules/include/module_fec_types.h"
+#include "modules/rtp_rtcp/source/byte_io.h"
+#include "modules/rtp_rtcp/source/fec_test_helper.h"
+#include "modules/rtp_rtcp/source/forward_error_correction.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/random.h"
+#include "rtc_base/system/unused.h"
+#include "test/benchmark_allocation_counter.h"
+
+namespace webrtc {
+namespace {
+
+constexpr uint32_t kMediaSsrc = 83542;
+constexpr size_t kRtpHeaderSize = 12;
+constexpr size_t kMaxPacketSize = 1200;
+// About 30% overhead, in Q8.
+constexpr uint8_t kProtectionFactor = 77;
+
+ForwardErrorCorrection::PacketList CreateMediaPackets(int num_packets) {
+  // Fixed seed, so that every run benchmarks the same packets.
+  Random random(0xabcdef123456);
+  test::fec::MediaPacketGenerator generator(kRtpHeaderSize, kMaxPacketSize,
+                                            kMediaSsrc, &random);
+  return generator.ConstructMediaPackets(num_packets, /*start_seq_num=*/1000);
+}
+
+// Protects a frame of `state.range(0)` media packets with ULPFEC.
+void BM_UlpfecEncode(benchmark::State& state) {
+  const ForwardErrorCorrection::PacketList media_packets =
+      CreateMediaPackets(state.range(0));
+  std::unique_ptr<ForwardErrorCorrection> fec =
+      ForwardErrorCorrection::CreateUlpfec(kMediaSsrc);
+  std::list<ForwardErrorCorrection::Packet*> fec_packets;
+  test::ScopedAllocationCounter allocations(state);
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    fec_packets.clear();
+    fec->EncodeFec(media_packets, kProtectionFactor,
+                   /*num_important_packets=*/0,
+                   /*use_unequal_protection=*/false, kFecMaskRandom,
+                   &fec_packets);
+    benchmark::DoNotOptimize(fec_packets.size());
+  }
+}
+
+// Recovers the first media packet of a frame of `state.range(0)` media
+// packets from the rest of the packets and the ULPFEC packets.
+void BM_UlpfecDecode(benchmark::State& state) {
+  const int num_media_packets = state.range(0);
+  const ForwardErrorCorrection::PacketList media_packets =
+      CreateMediaPackets(num_media_packets);
+  std::unique_ptr<ForwardErrorCorrection> fec =
+      ForwardErrorCorrection::CreateUlpfec(kMediaSsrc);
+  std::list<ForwardErrorCorrection::Packet*> fec_packets;
+  fec->EncodeFec(media_packets, kProtectionFactor,
+                 /*num_important_packets=*/0,
+                 /*use_unequal_protection=*/false, kFecMaskRandom,
+                 &fec_packets);
+
+  std::vector<std::unique_ptr<ForwardErrorCorrection::ReceivedPacket>>
+      received_packets;
+  // Decoding rewrites the FEC headers in place, so the packets are restored
+  // from these before every iteration.
+  std::vector<rtc::CopyOnWriteBuffer> received_data;
+  auto add_received_packet = [&](const ForwardErrorCorrection::Packet& packet,
+                                 uint16_t seq_num, bool is_fec) {
+    auto received = std::make_unique<ForwardErrorCorrection::ReceivedPacket>();
+    received->pkt = new ForwardErrorCorrection::Packet();
+    received->pkt->data = packet.data;
+    received->ssrc = kMediaSsrc;
+    received->seq_num = seq_num;
+    received->is_fec = is_fec;
+    received->is_recovered = false;
+    received_packets.push_back(std::move(received));
+    received_data.push_back(packet.data);
+  };
+  uint16_t seq_num = 0;
+  for (const auto& packet : media_packets) {
+    seq_num = ByteReader<uint16_t>::ReadBigEndian(packet->data.data() + 2);
+    // The first media packet is lost.
+    if (packet != media_packets.front())
+      add_received_packet(*packet, seq_num, /*is_fec=*/false);
+  }
+  // ULPFEC packets follow the media packets of the frame.
+  for (const ForwardErrorCorrection::Packet* packet : fec_packets)
+    add_received_packet(*packet, ++seq_num, /*is_fec=*/true);
+
+  std::unique_ptr<ForwardErrorCorrection> decoder =
+      ForwardErrorCorrection::CreateUlpfec(kMediaSsrc);
+  ForwardErrorCorrection::RecoveredPacketList recovered_packets;
+  test::ScopedAllocationCounter allocations(state);
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    decoder->ResetState(&recovered_packets);
+    size_t num_recovered = 0;
+    for (size_t i = 0; i < received_packets.size(); ++i) {
+      received_packets[i]->pkt->data = received_data[i];
+      num_recovered += decoder->DecodeFec(*received_packets[i],
+                                          &recovered_packets)
+                           .num_recovered_packets;
+    }
+    RTC_DCHECK_EQ(num_recovered, 1);
+  }
+}
+
+BENCHMARK(BM_UlpfecEncode)->Arg(4)->Arg(16)->Arg(48);
+BENCHMARK(BM_UlpfecDecode)->Arg(4)->Arg(16)->Arg(48);
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,95 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/forward_error_correction_xor.h"
+
+#include <string.h>
+
+#include "system_wrappers/include/cpu_features_wrapper.h"
+
+// This needs to be after rtc_base/system/arch.h which defines
+// architecture macros.
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#endif
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace webrtc {
+namespace internal {
+namespace {
+
+using XorFunction = void (*)(const uint8_t*, size_t, uint8_t*);
+
+XorFunction SelectXorFunction() {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (GetCPUInfo(kAVX2) != 0) {
+    return &XorBytes_AVX2;
+  }
+  if (GetCPUInfo(kSSE2) != 0) {
+    return &XorBytes_SSE2;
+  }
+#endif
+#if defined(WEBRTC_HAS_NEON)
+  return &XorBytes_NEON;
+#else
+  return &XorBytes_C;
+#endif
+}
+
+}  // namespace
+
+void XorBytes(const uint8_t* src, size_t size, uint8_t* dst) {
+  static const XorFunction xor_function = SelectXorFunction();
+  xor_function(src, size, dst);
+}
+
+void XorBytes_C(const uint8_t* src, size_t size, uint8_t* dst) {
+  size_t i = 0;
+  // memcpy lets the compiler use unaligned word loads and stores.
+  for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+    uint64_t src_word;
+    uint64_t dst_word;
+    memcpy(&src_word, src + i, sizeof(src_word));
+    memcpy(&dst_word, dst + i, sizeof(dst_word));
+    dst_word ^= src_word;
+    memcpy(dst + i, &dst_word, sizeof(dst_word));
+  }
+  for (; i < size; ++i) {
+    dst[i] ^= src[i];
+  }
+}
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void XorBytes_SSE2(const uint8_t* src, size_t size, uint8_t* dst) {
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    const __m128i s =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_xor_si128(s, d));
+  }
+  XorBytes_C(src + i, size - i, dst + i);
+}
+#endif
+
+#if defined(WEBRTC_HAS_NEON)
+void XorBytes_NEON(const uint8_t* src, size_t size, uint8_t* dst) {
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    vst1q_u8(dst + i, veorq_u8(vld1q_u8(src + i), vld1q_u8(dst + i)));
+  }
+  XorBytes_C(src + i, size - i, dst + i);
+}
+#endif
+
+}  // namespace internal
+}  // namespace webrtc
@@ -0,0 +1,41 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_FORWARD_ERROR_CORRECTION_XOR_H_
+#define MODULES_RTP_RTCP_SOURCE_FORWARD_ERROR_CORRECTION_XOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rtc_base/system/arch.h"
+
+namespace webrtc {
+namespace internal {
+
+// XORs `size` bytes of `src` into `dst`, i.e. dst[i] ^= src[i]. The buffers
+// may be unaligned, but must not overlap. Uses the widest vector instructions
+// the CPU supports.
+void XorBytes(const uint8_t* src, size_t size, uint8_t* dst);
+
+// Variants of XorBytes() for a given instruction set, exposed for testing.
+void XorBytes_C(const uint8_t* src, size_t size, uint8_t* dst);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void XorBytes_SSE2(const uint8_t* src, size_t size, uint8_t* dst);
+// Must only be called when GetCPUInfo(kAVX2) is set.
+void XorBytes_AVX2(const uint8_t* src, size_t size, uint8_t* dst);
+#endif
+#if defined(WEBRTC_HAS_NEON)
+void XorBytes_NEON(const uint8_t* src, size_t size, uint8_t* dst);
+#endif
+
+}  // namespace internal
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_FORWARD_ERROR_CORRECTION_XOR_H_
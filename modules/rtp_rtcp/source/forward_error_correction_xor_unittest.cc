@@ -0,0 +1,88 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/forward_error_correction_xor.h"
+
+#include <vector>
+
+#include "rtc_base/random.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace internal {
+namespace {
+
+using ::testing::ElementsAreArray;
+
+using XorFunction = void (*)(const uint8_t*, size_t, uint8_t*);
+
+// Checks `xor_function` against a plain loop for all sizes up to a few vector
+// registers and for unaligned buffers.
+void VerifyXor(XorFunction xor_function) {
+  Random random(/*seed=*/1234);
+  for (size_t offset = 0; offset < 4; ++offset) {
+    for (size_t size = 0; size <= 100; ++size) {
+      SCOPED_TRACE(size);
+      std::vector<uint8_t> src(offset + size);
+      std::vector<uint8_t> dst(offset + size + 1);
+      for (uint8_t& byte : src) {
+        byte = random.Rand<uint8_t>();
+      }
+      for (uint8_t& byte : dst) {
+        byte = random.Rand<uint8_t>();
+      }
+      std::vector<uint8_t> expected = dst;
+      for (size_t i = 0; i < size; ++i) {
+        expected[offset + i] ^= src[offset + i];
+      }
+
+      xor_function(src.data() + offset, size, dst.data() + offset);
+
+      // Including the byte past the end, which should be left untouched.
+      EXPECT_THAT(dst, ElementsAreArray(expected));
+    }
+  }
+}
+
+TEST(ForwardErrorCorrectionXorTest, XorBytes) {
+  VerifyXor(&XorBytes);
+}
+
+TEST(ForwardErrorCorrectionXorTest, XorBytesC) {
+  VerifyXor(&XorBytes_C);
+}
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+TEST(ForwardErrorCorrectionXorTest, XorBytesSse2) {
+  if (GetCPUInfo(kSSE2) == 0) {
+    GTEST_SKIP() << "SSE2 is not supported.";
+  }
+  VerifyXor(&XorBytes_SSE2);
+}
+
+TEST(ForwardErrorCorrectionXorTest, XorBytesAvx2) {
+  if (GetCPUInfo(kAVX2) == 0) {
+    GTEST_SKIP() << "AVX2 is not supported.";
+  }
+  VerifyXor(&XorBytes_AVX2);
+}
+#endif
+
+#if defined(WEBRTC_HAS_NEON)
+TEST(ForwardErrorCorrectionXorTest, XorBytesNeon) {
+  VerifyXor(&XorBytes_NEON);
+}
+#endif
+
+}  // namespace
+}  // namespace internal
+}  // namespace webrtc
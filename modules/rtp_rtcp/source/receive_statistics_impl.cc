@@ -430,4 +430,95 @@ std::vector<rtcp::ReportBlock> ReceiveStatisticsImpl::RtcpReportBlocks(
   return result;
 }
 
+ReceiveStatisticsLocked::ReceiveStatisticsLocked(
+    Clock* clock,
+    std::function<std::unique_ptr<StreamStatisticianImplInterface>(
+        uint32_t ssrc,
+        Clock* clock,
+        int max_reordering_threshold)> stream_statistician_factory)
+    : clock_(clock),
+      stream_statistician_factory_(std::move(stream_statistician_factory)),
+      last_returned_idx_(0),
+      max_reordering_threshold_(kDefaultMaxReorderingThreshold) {}
+
+const ReceiveStatisticsLocked::Shard& ReceiveStatisticsLocked::ShardFor(
+    uint32_t ssrc) const {
+  // Fibonacci hashing, to spread SSRCs evenly even if they aren't random.
+  return shards_[(ssrc * 0x9E3779B1u) >> (32 - kNumShardsLog2)];
+}
+
+ReceiveStatisticsLocked::Shard& ReceiveStatisticsLocked::ShardFor(
+    uint32_t ssrc) {
+  return const_cast<Shard&>(
+      static_cast<const ReceiveStatisticsLocked&>(*this).ShardFor(ssrc));
+}
+
+void ReceiveStatisticsLocked::OnRtpPacket(const RtpPacketReceived& packet) {
+  // The shard lock is released before updating the statistician, which has
+  // its own locking and outlives the lookup.
+  GetOrCreateStatistician(packet.Ssrc())->UpdateCounters(packet);
+}
+
+StreamStatistician* ReceiveStatisticsLocked::GetStatistician(
+    uint32_t ssrc) const {
+  const Shard& shard = ShardFor(ssrc);
+  MutexLock lock(&shard.lock);
+  auto it = shard.statisticians.find(ssrc);
+  if (it == shard.statisticians.end())
+    return nullptr;
+  return it->second.get();
+}
+
+StreamStatisticianImplInterface*
+ReceiveStatisticsLocked::GetOrCreateStatistician(uint32_t ssrc) {
+  Shard& shard = ShardFor(ssrc);
+  MutexLock lock(&shard.lock);
+  std::unique_ptr<StreamStatisticianImplInterface>& impl =
+      shard.statisticians[ssrc];
+  if (impl == nullptr) {  // new element
+    MutexLock streams_lock(&streams_lock_);
+    impl =
+        stream_statistician_factory_(ssrc, clock_, max_reordering_threshold_);
+    all_statisticians_.push_back(impl.get());
+  }
+  return impl.get();
+}
+
+void ReceiveStatisticsLocked::SetMaxReorderingThreshold(
+    int max_reordering_threshold) {
+  MutexLock lock(&streams_lock_);
+  max_reordering_threshold_ = max_reordering_threshold;
+  for (StreamStatisticianImplInterface* statistician : all_statisticians_) {
+    statistician->SetMaxReorderingThreshold(max_reordering_threshold);
+  }
+}
+
+void ReceiveStatisticsLocked::SetMaxReorderingThreshold(
+    uint32_t ssrc,
+    int max_reordering_threshold) {
+  GetOrCreateStatistician(ssrc)->SetMaxReorderingThreshold(
+      max_reordering_threshold);
+}
+
+void ReceiveStatisticsLocked::EnableRetransmitDetection(uint32_t ssrc,
+                                                        bool enable) {
+  GetOrCreateStatistician(ssrc)->EnableRetransmitDetection(enable);
+}
+
+std::vector<rtcp::ReportBlock> ReceiveStatisticsLocked::RtcpReportBlocks(
+    size_t max_blocks) {
+  MutexLock lock(&streams_lock_);
+  std::vector<rtcp::ReportBlock> result;
+  result.reserve(std::min(max_blocks, all_statisticians_.size()));
+
+  size_t idx = 0;
+  for (size_t i = 0;
+       i < all_statisticians_.size() && result.size() < max_blocks; ++i) {
+    idx = (last_returned_idx_ + i + 1) % all_statisticians_.size();
+    all_statisticians_[idx]->MaybeAppendReportBlockAndReset(result);
+  }
+  last_returned_idx_ = idx;
+  return result;
+}
+
 }  // namespace webrtc
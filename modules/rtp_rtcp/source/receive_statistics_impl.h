@@ -12,6 +12,7 @@
 #define MODULES_RTP_RTCP_SOURCE_RECEIVE_STATISTICS_IMPL_H_
 
 #include <algorithm>
+#include <array>
 #include <functional>
 #include <memory>
 #include <utility>
@@ -205,47 +206,66 @@ class ReceiveStatisticsImpl : public ReceiveStatistics {
       statisticians_;
 };
 
-// Thread-safe implementation wrapping access to ReceiveStatisticsImpl with a
-// mutex.
+// Thread-safe implementation of ReceiveStatistics. Statisticians are spread
+// over a fixed number of shards keyed by SSRC, each with its own mutex, so that
+// packets of different streams don't serialize on a single lock. RTCP report
+// generation walks the streams without taking any shard lock, and each report
+// block is a consistent snapshot taken under the statistician's own lock.
 class ReceiveStatisticsLocked : public ReceiveStatistics {
  public:
-  explicit ReceiveStatisticsLocked(
+  ReceiveStatisticsLocked(
       Clock* clock,
       std::function<std::unique_ptr<StreamStatisticianImplInterface>(
           uint32_t ssrc,
           Clock* clock,
-          int max_reordering_threshold)> stream_statitician_factory)
-      : impl_(clock, std::move(stream_statitician_factory)) {}
+          int max_reordering_threshold)> stream_statistician_factory);
   ~ReceiveStatisticsLocked() override = default;
-  std::vector<rtcp::ReportBlock> RtcpReportBlocks(size_t max_blocks) override {
-    MutexLock lock(&receive_statistics_lock_);
-    return impl_.RtcpReportBlocks(max_blocks);
-  }
-  void OnRtpPacket(const RtpPacketReceived& packet) override {
-    MutexLock lock(&receive_statistics_lock_);
-    return impl_.OnRtpPacket(packet);
-  }
-  StreamStatistician* GetStatistician(uint32_t ssrc) const override {
-    MutexLock lock(&receive_statistics_lock_);
-    return impl_.GetStatistician(ssrc);
-  }
-  void SetMaxReorderingThreshold(int max_reordering_threshold) override {
-    MutexLock lock(&receive_statistics_lock_);
-    return impl_.SetMaxReorderingThreshold(max_reordering_threshold);
-  }
+
+  // Implements ReceiveStatisticsProvider.
+  std::vector<rtcp::ReportBlock> RtcpReportBlocks(size_t max_blocks) override;
+
+  // Implements RtpPacketSinkInterface
+  void OnRtpPacket(const RtpPacketReceived& packet) override;
+
+  // Implements ReceiveStatistics.
+  StreamStatistician* GetStatistician(uint32_t ssrc) const override;
+  void SetMaxReorderingThreshold(int max_reordering_threshold) override;
   void SetMaxReorderingThreshold(uint32_t ssrc,
-                                 int max_reordering_threshold) override {
-    MutexLock lock(&receive_statistics_lock_);
-    return impl_.SetMaxReorderingThreshold(ssrc, max_reordering_threshold);
-  }
-  void EnableRetransmitDetection(uint32_t ssrc, bool enable) override {
-    MutexLock lock(&receive_statistics_lock_);
-    return impl_.EnableRetransmitDetection(ssrc, enable);
-  }
+                                 int max_reordering_threshold) override;
+  void EnableRetransmitDetection(uint32_t ssrc, bool enable) override;
 
  private:
-  mutable Mutex receive_statistics_lock_;
-  ReceiveStatisticsImpl impl_ RTC_GUARDED_BY(&receive_statistics_lock_);
+  static constexpr int kNumShardsLog2 = 4;
+
+  struct Shard {
+    mutable Mutex lock;
+    flat_map<uint32_t /*ssrc*/,
+             std::unique_ptr<StreamStatisticianImplInterface>>
+        statisticians RTC_GUARDED_BY(lock);
+  };
+
+  const Shard& ShardFor(uint32_t ssrc) const;
+  Shard& ShardFor(uint32_t ssrc);
+  StreamStatisticianImplInterface* GetOrCreateStatistician(uint32_t ssrc);
+
+  Clock* const clock_;
+  const std::function<std::unique_ptr<StreamStatisticianImplInterface>(
+      uint32_t ssrc,
+      Clock* clock,
+      int max_reordering_threshold)>
+      stream_statistician_factory_;
+  std::array<Shard, 1 << kNumShardsLog2> shards_;
+
+  // Guards state shared by all shards. When both are needed, a shard lock is
+  // always taken before `streams_lock_`.
+  Mutex streams_lock_;
+  // All statisticians in creation order. They are owned by `shards_` and are
+  // only destroyed together with `this`.
+  std::vector<StreamStatisticianImplInterface*> all_statisticians_
+      RTC_GUARDED_BY(streams_lock_);
+  // The index within `all_statisticians_` that was last returned.
+  size_t last_returned_idx_ RTC_GUARDED_BY(streams_lock_);
+  int max_reordering_threshold_ RTC_GUARDED_BY(streams_lock_);
 };
 
 }  // namespace webrtc
@@ -10,6 +10,7 @@
 
 #include "modules/rtp_rtcp/include/receive_statistics.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 #include <vector>
@@ -24,6 +25,8 @@
 namespace webrtc {
 namespace {
 
+using ::testing::IsEmpty;
+using ::testing::Not;
 using ::testing::SizeIs;
 using ::testing::UnorderedElementsAre;
 
@@ -209,6 +212,34 @@ TEST_P(ReceiveStatisticsTest,
               UnorderedElementsAre(kSsrc1, kSsrc2, kSsrc3, kSsrc4));
 }
 
+TEST_P(ReceiveStatisticsTest, ReportsAllOfManySsrcsInRoundRobin) {
+  constexpr uint32_t kNumSsrcs = 100;
+  for (uint32_t ssrc = 1; ssrc <= kNumSsrcs; ++ssrc) {
+    receive_statistics_->OnRtpPacket(CreateRtpPacket(ssrc, kPacketSize1));
+  }
+  for (uint32_t ssrc = 1; ssrc <= kNumSsrcs; ++ssrc) {
+    StreamStatistician* statistician =
+        receive_statistics_->GetStatistician(ssrc);
+    ASSERT_TRUE(statistician != nullptr);
+    EXPECT_EQ(statistician->GetReceiveStreamDataCounters().transmitted.packets,
+              1u);
+  }
+
+  std::vector<uint32_t> observed_ssrcs;
+  while (observed_ssrcs.size() < kNumSsrcs) {
+    std::vector<rtcp::ReportBlock> report_blocks =
+        receive_statistics_->RtcpReportBlocks(31);
+    ASSERT_THAT(report_blocks, Not(IsEmpty()));
+    for (const rtcp::ReportBlock& block : report_blocks) {
+      observed_ssrcs.push_back(block.source_ssrc());
+    }
+  }
+  observed_ssrcs.resize(kNumSsrcs);
+  std::sort(observed_ssrcs.begin(), observed_ssrcs.end());
+  EXPECT_EQ(std::unique(observed_ssrcs.begin(), observed_ssrcs.end()),
+            observed_ssrcs.end());
+}
+
 TEST_P(ReceiveStatisticsTest, ActiveStatisticians) {
   receive_statistics_->OnRtpPacket(packet1_);
   IncrementSequenceNumber(&packet1_);
@@ -0,0 +1,238 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "modules/rtp_rtcp/source/rtcp_packet/congestion_control_feedback.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "api/units/time_delta.h"
+#include "modules/rtp_rtcp/source/byte_io.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/common_header.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/network/ecn_marking.h"
+#include "rtc_base/numerics/safe_conversions.h"
+
+namespace webrtc {
+namespace rtcp {
+namespace {
+// RFC 8888, Section 3.1.
+//
+//    0                   1                   2                   3
+//    0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//   |V=2|P| FMT=11  |   PT = 205    |          length               |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//   |                 SSRC of RTCP packet sender                    |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//   |                   SSRC of 1st RTP Stream                      |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//   |          begin_seq            |          num_reports          |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//   |R|ECN|  Arrival time offset    | ...                           .
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//   .                                                               .
+//   .                                                               .
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//   |                   SSRC of nth RTP Stream                      |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//   |          begin_seq            |          num_reports          |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//   |R|ECN|  Arrival time offset    | ...                           |
+//   .                                                               .
+//   .                                                               .
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//   |                 Report Timestamp (32 bits)                    |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//
+// Each report block is padded to a multiple of 32 bits. The arrival time
+// offset counts 1/1024 seconds back from the report timestamp.
+
+constexpr size_t kSenderSsrcLength = 4;
+constexpr size_t kReportTimestampLength = 4;
+constexpr size_t kBlockHeaderLength = 8;
+constexpr size_t kMetricLength = 2;
+// RFC 8888, Section 3.1: num_reports must not exceed 16384.
+constexpr size_t kMaxReportsPerBlock = 16384;
+
+constexpr uint16_t kReceivedBit = 0x8000;
+constexpr int kEcnShift = 13;
+constexpr uint16_t kAtoMask = 0x1FFF;
+constexpr uint16_t kAtoOverRange = 0x1FFE;
+constexpr uint16_t kAtoUnavailable = 0x1FFF;
+
+size_t ReportBlockLength(size_t num_reports) {
+  size_t metrics_length = num_reports * kMetricLength;
+  // Pad to 32 bits.
+  return kBlockHeaderLength + metrics_length + metrics_length % 4;
+}
+
+uint16_t ToAto(TimeDelta arrival_time_offset) {
+  if (!arrival_time_offset.IsFinite())
+    return kAtoUnavailable;
+  int64_t ato = (std::max(arrival_time_offset, TimeDelta::Zero()).us() * 1024 +
+                 500'000) /
+                1'000'000;
+  return static_cast<uint16_t>(std::min<int64_t>(ato, kAtoOverRange));
+}
+
+TimeDelta FromAto(uint16_t ato) {
+  if (ato >= kAtoOverRange)
+    return TimeDelta::PlusInfinity();
+  return TimeDelta::Micros((int64_t{ato} * 1'000'000 + 512) / 1024);
+}
+
+// Calls `block_callback` with the packets of each report block, i.e. each
+// run of packets with the same SSRC.
+template <typename BlockCallback>
+void ForEachBlock(rtc::ArrayView<const CongestionControlFeedback::PacketInfo>
+                      packets,
+                  BlockCallback block_callback) {
+  size_t begin = 0;
+  while (begin < packets.size()) {
+    size_t end = begin + 1;
+    while (end < packets.size() && packets[end].ssrc == packets[begin].ssrc)
+      ++end;
+    block_callback(packets.subview(begin, end - begin));
+    begin = end;
+  }
+}
+
+size_t NumReports(
+    rtc::ArrayView<const CongestionControlFeedback::PacketInfo> block) {
+  uint16_t span =
+      block[block.size() - 1].sequence_number - block[0].sequence_number;
+  return size_t{span} + 1;
+}
+
+}  // namespace
+
+constexpr uint8_t CongestionControlFeedback::kFeedbackMessageType;
+
+CongestionControlFeedback::CongestionControlFeedback(
+    std::vector<PacketInfo> packets,
+    uint32_t report_timestamp_compact_ntp)
+    : packets_(std::move(packets)),
+      report_timestamp_compact_ntp_(report_timestamp_compact_ntp) {
+  ForEachBlock(packets_, [](rtc::ArrayView<const PacketInfo> block) {
+    RTC_DCHECK_LE(NumReports(block), kMaxReportsPerBlock);
+    RTC_DCHECK_LE(block.size(), NumReports(block))
+        << "Packets of an SSRC must be sorted by sequence number.";
+  });
+}
+
+bool CongestionControlFeedback::Parse(const CommonHeader& packet) {
+  RTC_DCHECK_EQ(packet.type(), kPacketType);
+  RTC_DCHECK_EQ(packet.fmt(), kFeedbackMessageType);
+
+  const size_t payload_size = packet.payload_size_bytes();
+  if (payload_size < kSenderSsrcLength + kReportTimestampLength) {
+    RTC_LOG(LS_WARNING) << "Payload length " << payload_size
+                        << " is too small for congestion control feedback.";
+    return false;
+  }
+  const uint8_t* const payload = packet.payload();
+  SetSenderSsrc(ByteReader<uint32_t>::ReadBigEndian(payload));
+  const size_t blocks_end = payload_size - kReportTimestampLength;
+  report_timestamp_compact_ntp_ =
+      ByteReader<uint32_t>::ReadBigEndian(payload + blocks_end);
+
+  packets_.clear();
+  size_t offset = kSenderSsrcLength;
+  while (offset < blocks_end) {
+    if (blocks_end - offset < kBlockHeaderLength) {
+      RTC_LOG(LS_WARNING) << "Truncated report block header.";
+      return false;
+    }
+    const uint32_t ssrc = ByteReader<uint32_t>::ReadBigEndian(payload + offset);
+    const uint16_t begin_seq =
+        ByteReader<uint16_t>::ReadBigEndian(payload + offset + 4);
+    const uint16_t num_reports =
+        ByteReader<uint16_t>::ReadBigEndian(payload + offset + 6);
+    if (num_reports > kMaxReportsPerBlock ||
+        blocks_end - offset < ReportBlockLength(num_reports)) {
+      RTC_LOG(LS_WARNING) << "Invalid report block with " << num_reports
+                          << " reports.";
+      return false;
+    }
+    const uint8_t* metric = payload + offset + kBlockHeaderLength;
+    for (uint16_t i = 0; i < num_reports; ++i, metric += kMetricLength) {
+      const uint16_t value = ByteReader<uint16_t>::ReadBigEndian(metric);
+      PacketInfo& info = packets_.emplace_back();
+      info.ssrc = ssrc;
+      info.sequence_number = begin_seq + i;
+      if (value & kReceivedBit) {
+        info.ecn = static_cast<rtc::EcnMarking>((value >> kEcnShift) & 0x3);
+        info.arrival_time_offset = FromAto(value & kAtoMask);
+      }
+    }
+    offset += ReportBlockLength(num_reports);
+  }
+  return true;
+}
+
+size_t CongestionControlFeedback::BlockLength() const {
+  size_t length = kHeaderLength + kSenderSsrcLength + kReportTimestampLength;
+  ForEachBlock(packets_, [&](rtc::ArrayView<const PacketInfo> block) {
+    length += ReportBlockLength(NumReports(block));
+  });
+  return length;
+}
+
+bool CongestionControlFeedback::Create(uint8_t* packet,
+                                       size_t* position,
+                                       size_t max_length,
+                                       PacketReadyCallback callback) const {
+  const size_t length = BlockLength();
+  while (*position + length > max_length) {
+    if (!OnBufferFull(packet, position, callback))
+      return false;
+  }
+  const size_t index_end = *position + length;
+  CreateHeader(kFeedbackMessageType, kPacketType, HeaderLength(), packet,
+               position);
+  ByteWriter<uint32_t>::WriteBigEndian(packet + *position, sender_ssrc());
+  *position += kSenderSsrcLength;
+
+  ForEachBlock(packets_, [&](rtc::ArrayView<const PacketInfo> block) {
+    const uint16_t begin_seq = block[0].sequence_number;
+    const size_t num_reports = NumReports(block);
+    ByteWriter<uint32_t>::WriteBigEndian(packet + *position,
+                                         block[0].ssrc);
+    ByteWriter<uint16_t>::WriteBigEndian(packet + *position + 4, begin_seq);
+    ByteWriter<uint16_t>::WriteBigEndian(
+        packet + *position + 6, rtc::dchecked_cast<uint16_t>(num_reports));
+    uint8_t* metrics = packet + *position + kBlockHeaderLength;
+    const size_t block_length = ReportBlockLength(num_reports);
+    // Unreported sequence numbers and padding stay zero, i.e. not received.
+    std::fill(metrics, packet + *position + block_length, 0);
+    for (const PacketInfo& info : block) {
+      if (!info.received())
+        continue;
+      const uint16_t i = info.sequence_number - begin_seq;
+      const uint16_t value =
+          kReceivedBit | (static_cast<uint16_t>(info.ecn) << kEcnShift) |
+          ToAto(info.arrival_time_offset);
+      ByteWriter<uint16_t>::WriteBigEndian(metrics + i * kMetricLength, value);
+    }
+    *position += block_length;
+  });
+
+  ByteWriter<uint32_t>::WriteBigEndian(packet + *position,
+                                       report_timestamp_compact_ntp_);
+  *position += kReportTimestampLength;
+  RTC_DCHECK_EQ(*position, index_end);
+  return true;
+}
+
+}  // namespace rtcp
+}  // namespace webrtc
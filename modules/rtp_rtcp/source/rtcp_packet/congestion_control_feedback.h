@@ -0,0 +1,80 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#ifndef MODULES_RTP_RTCP_SOURCE_RTCP_PACKET_CONGESTION_CONTROL_FEEDBACK_H_
+#define MODULES_RTP_RTCP_SOURCE_RTCP_PACKET_CONGESTION_CONTROL_FEEDBACK_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "api/array_view.h"
+#include "api/units/time_delta.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/rtpfb.h"
+#include "rtc_base/network/ecn_marking.h"
+
+namespace webrtc {
+namespace rtcp {
+class CommonHeader;
+
+// Congestion control feedback (RFC 8888). Reports, per RTP stream, which
+// packets arrived, when and with which ECN marking.
+class CongestionControlFeedback : public Rtpfb {
+ public:
+  static constexpr uint8_t kFeedbackMessageType = 11;
+
+  struct PacketInfo {
+    uint32_t ssrc = 0;
+    uint16_t sequence_number = 0;
+    // Time the packet arrived, relative to the report timestamp. Minus
+    // infinity if the packet has not been received. Plus infinity if it has
+    // been received but the arrival time can not be represented.
+    TimeDelta arrival_time_offset = TimeDelta::MinusInfinity();
+    rtc::EcnMarking ecn = rtc::EcnMarking::kNotEct;
+
+    bool received() const { return !arrival_time_offset.IsMinusInfinity(); }
+  };
+
+  CongestionControlFeedback() = default;
+  // Packets of the same SSRC must be grouped together and sorted by sequence
+  // number. Sequence numbers missing within a group are reported as lost.
+  CongestionControlFeedback(std::vector<PacketInfo> packets,
+                            uint32_t report_timestamp_compact_ntp);
+  ~CongestionControlFeedback() override = default;
+
+  // Parse assumes header is already parsed and validated. All reported
+  // packets, received or not, end up in `packets()`.
+  bool Parse(const CommonHeader& packet);
+
+  rtc::ArrayView<const PacketInfo> packets() const { return packets_; }
+  uint32_t report_timestamp_compact_ntp() const {
+    return report_timestamp_compact_ntp_;
+  }
+
+  size_t BlockLength() const override;
+
+  bool Create(uint8_t* packet,
+              size_t* position,
+              size_t max_length,
+              PacketReadyCallback callback) const override;
+
+ private:
+  // The packet has no media source SSRC, each report block has its own.
+  void SetMediaSsrc(uint32_t);
+  uint32_t media_ssrc() const;
+
+  std::vector<PacketInfo> packets_;
+  uint32_t report_timestamp_compact_ntp_ = 0;
+};
+
+}  // namespace rtcp
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_RTCP_PACKET_CONGESTION_CONTROL_FEEDBACK_H_
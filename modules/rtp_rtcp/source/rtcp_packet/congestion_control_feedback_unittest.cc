@@ -0,0 +1,149 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/rtcp_packet/congestion_control_feedback.h"
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "api/units/time_delta.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/network/ecn_marking.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+#include "test/rtcp_packet_parser.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAreArray;
+using ::testing::SizeIs;
+using rtcp::CongestionControlFeedback;
+using PacketInfo = CongestionControlFeedback::PacketInfo;
+
+constexpr uint32_t kSenderSsrc = 0x12345678;
+constexpr uint32_t kSsrc1 = 0x23456789;
+constexpr uint32_t kSsrc2 = 0x3456789a;
+constexpr uint32_t kReportTimestamp = 0x11223344;
+
+// Sender SSRC, one block of SSRC 0x23456789 reporting packets 0xfffe to 1,
+// and the report timestamp. Packet 0xffff is lost, packet 0 arrived 1/1024 s
+// before the report with ECT(1) and packet 1 0x100/1024 s before with CE.
+const uint8_t kPacket[] = {0x8b, 205,  0x00, 0x06, 0x12, 0x34, 0x56, 0x78,
+                           0x23, 0x45, 0x67, 0x89, 0xff, 0xfe, 0x00, 0x04,
+                           0x80, 0x00, 0x00, 0x00, 0xa0, 0x01, 0xe1, 0x00,
+                           0x11, 0x22, 0x33, 0x44};
+
+PacketInfo Received(uint32_t ssrc,
+                    uint16_t sequence_number,
+                    TimeDelta arrival_time_offset,
+                    rtc::EcnMarking ecn = rtc::EcnMarking::kNotEct) {
+  PacketInfo info;
+  info.ssrc = ssrc;
+  info.sequence_number = sequence_number;
+  info.arrival_time_offset = arrival_time_offset;
+  info.ecn = ecn;
+  return info;
+}
+
+MATCHER_P(PacketInfoEq, expected, "") {
+  return arg.ssrc == expected.ssrc &&
+         arg.sequence_number == expected.sequence_number &&
+         arg.arrival_time_offset == expected.arrival_time_offset &&
+         arg.ecn == expected.ecn;
+}
+
+TEST(RtcpPacketCongestionControlFeedbackTest, Create) {
+  CongestionControlFeedback feedback(
+      {Received(kSsrc1, 0xfffe, TimeDelta::Zero()),
+       Received(kSsrc1, 0, TimeDelta::Micros(977), rtc::EcnMarking::kEct1),
+       Received(kSsrc1, 1, TimeDelta::Millis(250), rtc::EcnMarking::kCe)},
+      kReportTimestamp);
+  feedback.SetSenderSsrc(kSenderSsrc);
+
+  rtc::Buffer packet = feedback.Build();
+
+  EXPECT_THAT(packet, ElementsAreArray(kPacket));
+}
+
+TEST(RtcpPacketCongestionControlFeedbackTest, Parse) {
+  CongestionControlFeedback feedback;
+  ASSERT_TRUE(test::ParseSinglePacket(kPacket, &feedback));
+
+  EXPECT_EQ(feedback.sender_ssrc(), kSenderSsrc);
+  EXPECT_EQ(feedback.report_timestamp_compact_ntp(), kReportTimestamp);
+  PacketInfo lost;
+  lost.ssrc = kSsrc1;
+  lost.sequence_number = 0xffff;
+  EXPECT_THAT(
+      feedback.packets(),
+      ElementsAreArray(
+          {PacketInfoEq(Received(kSsrc1, 0xfffe, TimeDelta::Zero())),
+           PacketInfoEq(lost),
+           PacketInfoEq(Received(kSsrc1, 0, TimeDelta::Micros(977),
+                                 rtc::EcnMarking::kEct1)),
+           PacketInfoEq(Received(kSsrc1, 1, TimeDelta::Millis(250),
+                                 rtc::EcnMarking::kCe))}));
+}
+
+TEST(RtcpPacketCongestionControlFeedbackTest, CreateAndParseSeveralSsrcs) {
+  std::vector<PacketInfo> packets = {
+      Received(kSsrc1, 17, TimeDelta::Millis(20), rtc::EcnMarking::kEct0),
+      Received(kSsrc1, 18, TimeDelta::Millis(10), rtc::EcnMarking::kEct0),
+      Received(kSsrc2, 100, TimeDelta::Millis(15), rtc::EcnMarking::kEct1),
+      Received(kSsrc2, 101, TimeDelta::Millis(5), rtc::EcnMarking::kEct1),
+      Received(kSsrc2, 102, TimeDelta::Zero(), rtc::EcnMarking::kEct1)};
+  CongestionControlFeedback feedback(packets, kReportTimestamp);
+  rtc::Buffer packet = feedback.Build();
+  EXPECT_EQ(packet.size(), feedback.BlockLength());
+
+  CongestionControlFeedback parsed;
+  ASSERT_TRUE(test::ParseSinglePacket(packet, &parsed));
+  ASSERT_THAT(parsed.packets(), SizeIs(packets.size()));
+  for (size_t i = 0; i < packets.size(); ++i) {
+    EXPECT_EQ(parsed.packets()[i].ssrc, packets[i].ssrc);
+    EXPECT_EQ(parsed.packets()[i].sequence_number, packets[i].sequence_number);
+    EXPECT_EQ(parsed.packets()[i].ecn, packets[i].ecn);
+    // Arrival times are sent with 1/1024 s resolution.
+    EXPECT_NEAR(parsed.packets()[i].arrival_time_offset.us(),
+                packets[i].arrival_time_offset.us(), 500);
+  }
+}
+
+TEST(RtcpPacketCongestionControlFeedbackTest,
+     ReportsArrivalTimeOutOfRangeAsUnknown) {
+  CongestionControlFeedback feedback(
+      {Received(kSsrc1, 1, TimeDelta::Seconds(10)),
+       Received(kSsrc1, 2, TimeDelta::PlusInfinity())},
+      kReportTimestamp);
+  rtc::Buffer packet = feedback.Build();
+
+  CongestionControlFeedback parsed;
+  ASSERT_TRUE(test::ParseSinglePacket(packet, &parsed));
+  ASSERT_THAT(parsed.packets(), SizeIs(2));
+  EXPECT_TRUE(parsed.packets()[0].received());
+  EXPECT_TRUE(parsed.packets()[0].arrival_time_offset.IsPlusInfinity());
+  EXPECT_TRUE(parsed.packets()[1].received());
+  EXPECT_TRUE(parsed.packets()[1].arrival_time_offset.IsPlusInfinity());
+}
+
+TEST(RtcpPacketCongestionControlFeedbackTest, ParseFailsOnTruncatedBlock) {
+  // Claims 5 reports in a block with room for 4.
+  uint8_t packet[sizeof(kPacket)];
+  memcpy(packet, kPacket, sizeof(kPacket));
+  packet[15] = 0x05;
+
+  CongestionControlFeedback feedback;
+  EXPECT_FALSE(test::ParseSinglePacket(packet, &feedback));
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -11,6 +11,7 @@
 #include "modules/rtp_rtcp/source/rtcp_packet/nack.h"
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <utility>
 
@@ -78,6 +79,31 @@ bool Nack::Parse(const CommonHeader& packet) {
   return true;
 }
 
+bool Nack::ForEachPacketId(const CommonHeader& packet,
+                           rtc::FunctionView<void(uint16_t)> callback) {
+  RTC_DCHECK_EQ(packet.type(), kPacketType);
+  RTC_DCHECK_EQ(packet.fmt(), kFeedbackMessageType);
+
+  if (packet.payload_size_bytes() < kCommonFeedbackLength + kNackItemLength) {
+    RTC_LOG(LS_WARNING) << "Payload length " << packet.payload_size_bytes()
+                        << " is too small for a Nack.";
+    return false;
+  }
+  const uint8_t* const end = packet.payload() + packet.payload_size_bytes();
+  for (const uint8_t* next_nack = packet.payload() + kCommonFeedbackLength;
+       end - next_nack >= static_cast<ptrdiff_t>(kNackItemLength);
+       next_nack += kNackItemLength) {
+    uint16_t pid = ByteReader<uint16_t>::ReadBigEndian(next_nack);
+    callback(pid++);
+    for (uint16_t bitmask = ByteReader<uint16_t>::ReadBigEndian(next_nack + 2);
+         bitmask != 0; bitmask >>= 1, ++pid) {
+      if (bitmask & 1)
+        callback(pid);
+    }
+  }
+  return true;
+}
+
 size_t Nack::BlockLength() const {
   return kHeaderLength + kCommonFeedbackLength +
          packed_.size() * kNackItemLength;
@@ -13,6 +13,7 @@
 
 #include <vector>
 
+#include "api/function_view.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/rtpfb.h"
 
 namespace webrtc {
@@ -29,6 +30,13 @@ class Nack : public Rtpfb {
   // Parse assumes header is already parsed and validated.
   bool Parse(const CommonHeader& packet);
 
+  // Alternative to Parse() for receivers that only need the packet ids, which
+  // doesn't allocate: calls `callback` with each packet id of `packet`, in
+  // order. Returns false, without calling `callback`, if `packet` isn't a
+  // valid Nack.
+  static bool ForEachPacketId(const CommonHeader& packet,
+                              rtc::FunctionView<void(uint16_t)> callback);
+
   void SetPacketIds(const uint16_t* nack_list, size_t length);
   void SetPacketIds(std::vector<uint16_t> nack_list);
   const std::vector<uint16_t>& packet_ids() const { return packet_ids_; }
@@ -10,6 +10,9 @@
 
 #include "modules/rtp_rtcp/source/rtcp_packet/nack.h"
 
+#include <vector>
+
+#include "modules/rtp_rtcp/source/rtcp_packet/common_header.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 #include "test/rtcp_packet_parser.h"
@@ -168,4 +171,23 @@ TEST(RtcpPacketNackTest, ParseFailsWithTooSmallBuffer) {
   EXPECT_FALSE(test::ParseSinglePacket(kTooSmallPacket, &parsed));
 }
 
+TEST(RtcpPacketNackTest, ForEachPacketIdReadsPacketInPlace) {
+  rtcp::CommonHeader header;
+  ASSERT_TRUE(header.Parse(kWrapPacket, sizeof(kWrapPacket)));
+  EXPECT_EQ(rtcp::Rtpfb::ParseMediaSsrc(header), kRemoteSsrc);
+
+  std::vector<uint16_t> packet_ids;
+  EXPECT_TRUE(Nack::ForEachPacketId(
+      header, [&](uint16_t packet_id) { packet_ids.push_back(packet_id); }));
+  EXPECT_THAT(packet_ids, ElementsAreArray(kWrapList));
+}
+
+TEST(RtcpPacketNackTest, ForEachPacketIdFailsWithTooSmallBuffer) {
+  rtcp::CommonHeader header;
+  ASSERT_TRUE(header.Parse(kTooSmallPacket, sizeof(kTooSmallPacket)));
+  MockFunction<void(uint16_t)> callback;
+  EXPECT_CALL(callback, Call(_)).Times(0);
+  EXPECT_FALSE(Nack::ForEachPacketId(header, callback.AsStdFunction()));
+}
+
 }  // namespace webrtc
@@ -11,6 +11,7 @@
 #include "modules/rtp_rtcp/source/rtcp_packet/rtpfb.h"
 
 #include "modules/rtp_rtcp/source/byte_io.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/common_header.h"
 
 namespace webrtc {
 namespace rtcp {
@@ -36,6 +37,13 @@ void Rtpfb::ParseCommonFeedback(const uint8_t* payload) {
   SetMediaSsrc(ByteReader<uint32_t>::ReadBigEndian(&payload[4]));
 }
 
+absl::optional<uint32_t> Rtpfb::ParseMediaSsrc(const CommonHeader& packet) {
+  if (packet.payload_size_bytes() < kCommonFeedbackLength) {
+    return absl::nullopt;
+  }
+  return ByteReader<uint32_t>::ReadBigEndian(&packet.payload()[4]);
+}
+
 void Rtpfb::CreateCommonFeedback(uint8_t* payload) const {
   ByteWriter<uint32_t>::WriteBigEndian(&payload[0], sender_ssrc());
   ByteWriter<uint32_t>::WriteBigEndian(&payload[4], media_ssrc());
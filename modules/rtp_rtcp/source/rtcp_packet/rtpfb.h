@@ -15,10 +15,12 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "absl/types/optional.h"
 #include "modules/rtp_rtcp/source/rtcp_packet.h"
 
 namespace webrtc {
 namespace rtcp {
+class CommonHeader;
 
 // RTPFB: Transport layer feedback message.
 // RFC4585, Section 6.2
@@ -33,6 +35,10 @@ class Rtpfb : public RtcpPacket {
 
   uint32_t media_ssrc() const { return media_ssrc_; }
 
+  // Returns the media source SSRC of `packet` without parsing the rest of it,
+  // or nullopt if `packet` is too short to hold one.
+  static absl::optional<uint32_t> ParseMediaSsrc(const CommonHeader& packet);
+
  protected:
   static constexpr size_t kCommonFeedbackLength = 8;
   void ParseCommonFeedback(const uint8_t* payload);
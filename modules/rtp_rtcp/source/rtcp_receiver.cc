@@ -719,21 +719,24 @@ bool RTCPReceiver::HandleSdes(const CommonHeader& rtcp_block,
 
 bool RTCPReceiver::HandleNack(const CommonHeader& rtcp_block,
                               PacketInformation* packet_information) {
-  rtcp::Nack nack;
-  if (!nack.Parse(rtcp_block)) {
-    return false;
+  // The packet ids are read in place rather than through an rtcp::Nack, which
+  // would allocate two vectors for each NACK.
+  if (receiver_only_ ||
+      rtcp::Rtpfb::ParseMediaSsrc(rtcp_block) != local_media_ssrc()) {
+    // Not to us, but still has to be valid.
+    return rtcp::Nack::ForEachPacketId(rtcp_block, [](uint16_t) {});
   }
 
-  if (receiver_only_ || local_media_ssrc() != nack.media_ssrc())  // Not to us.
-    return true;
-
-  packet_information->nack_sequence_numbers.insert(
-      packet_information->nack_sequence_numbers.end(),
-      nack.packet_ids().begin(), nack.packet_ids().end());
-  for (uint16_t packet_id : nack.packet_ids())
-    nack_stats_.ReportRequest(packet_id);
+  size_t num_packet_ids = 0;
+  if (!rtcp::Nack::ForEachPacketId(rtcp_block, [&](uint16_t packet_id) {
+        packet_information->nack_sequence_numbers.push_back(packet_id);
+        nack_stats_.ReportRequest(packet_id);
+        ++num_packet_ids;
+      })) {
+    return false;
+  }
 
-  if (!nack.packet_ids().empty()) {
+  if (num_packet_ids > 0) {
     packet_information->packet_type_flags |= kRtcpNack;
     ++packet_type_counter_.nack_packets;
     packet_type_counter_.nack_requests = nack_stats_.requests();
@@ -1032,21 +1035,25 @@ bool RTCPReceiver::HandleFir(const CommonHeader& rtcp_block,
 void RTCPReceiver::HandleTransportFeedback(
     const CommonHeader& rtcp_block,
     PacketInformation* packet_information) {
+  // Feedback for other senders, e.g. ones sharing the transport, isn't
+  // parsed at all.
+  absl::optional<uint32_t> media_source_ssrc =
+      rtcp::Rtpfb::ParseMediaSsrc(rtcp_block);
+  if (media_source_ssrc && *media_source_ssrc != local_media_ssrc() &&
+      !registered_ssrcs_.contains(*media_source_ssrc)) {
+    return;
+  }
   std::unique_ptr<rtcp::TransportFeedback> transport_feedback(
       new rtcp::TransportFeedback());
-  if (!transport_feedback->Parse(rtcp_block)) {
+  if (!media_source_ssrc || !transport_feedback->Parse(rtcp_block)) {
     ++num_skipped_packets_;
     // Application layer feedback message doesn't have a standard format.
     // Failing to parse it as transport feedback messages doesn't indicate an
     // invalid RTCP.
     return;
   }
-  uint32_t media_source_ssrc = transport_feedback->media_ssrc();
-  if (media_source_ssrc == local_media_ssrc() ||
-      registered_ssrcs_.contains(media_source_ssrc)) {
-    packet_information->packet_type_flags |= kRtcpTransportFeedback;
-    packet_information->transport_feedback = std::move(transport_feedback);
-  }
+  packet_information->packet_type_flags |= kRtcpTransportFeedback;
+  packet_information->transport_feedback = std::move(transport_feedback);
 }
 
 void RTCPReceiver::NotifyTmmbrUpdated() {
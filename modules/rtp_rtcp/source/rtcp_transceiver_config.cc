@@ -56,6 +56,11 @@ bool RtcpTransceiverConfig::Validate() const {
                       << "ms between reports should be positive.";
     return false;
   }
+  if (max_packets_per_periodic_report == 0) {
+    RTC_LOG(LS_ERROR) << debug_id
+                      << "periodic report should be allowed at least 1 packet.";
+    return false;
+  }
   if (schedule_periodic_compound_packets && task_queue == nullptr) {
     RTC_LOG(LS_ERROR) << debug_id
                       << "missing task queue for periodic compound packets";
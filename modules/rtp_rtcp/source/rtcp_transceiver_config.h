@@ -145,6 +145,13 @@ struct RtcpTransceiverConfig {
   // Period between periodic compound packets.
   TimeDelta report_period = TimeDelta::Seconds(1);
 
+  // Maximum number of compound packets a periodic report may be split into.
+  // With a single packet, streams that don't fit are reported in the following
+  // periods. With more packets, report blocks for all received streams and
+  // sender reports for all active senders are sent together on each period,
+  // each packet filled up to `max_packet_size`.
+  size_t max_packets_per_periodic_report = 1;
+
   //
   // Flags for features and experiments.
   //
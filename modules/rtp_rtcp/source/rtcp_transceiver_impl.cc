@@ -610,6 +610,7 @@ void RtcpTransceiverImpl::SchedulePeriodicCompoundPackets(TimeDelta delay) {
 std::vector<uint32_t> RtcpTransceiverImpl::FillReports(
     Timestamp now,
     ReservedBytes reserved,
+    PendingReports* pending,
     PacketSender& rtcp_sender) {
   // Sender/receiver reports should be first in the RTCP packet.
   RTC_DCHECK(rtcp_sender.IsEmpty());
@@ -639,8 +640,17 @@ std::vector<uint32_t> RtcpTransceiverImpl::FillReports(
         rtcp::ReportBlock::kLength;
   }
 
-  std::vector<rtcp::ReportBlock> report_blocks =
-      CreateReportBlocks(now, max_report_blocks);
+  std::vector<rtcp::ReportBlock> report_blocks;
+  if (pending == nullptr) {
+    report_blocks = CreateReportBlocks(now, max_report_blocks);
+  } else {
+    auto first_unsent = pending->report_blocks.begin() +
+                        std::min(max_report_blocks,
+                                 pending->report_blocks.size());
+    report_blocks.assign(pending->report_blocks.begin(), first_unsent);
+    pending->report_blocks.erase(pending->report_blocks.begin(),
+                                 first_unsent);
+  }
   // Previous calculation of max number of sender report made space for max
   // number of report blocks per sender report, but if number of report blocks
   // is low, more sender reports may fit in.
@@ -651,8 +661,8 @@ std::vector<uint32_t> RtcpTransceiverImpl::FillReports(
   auto last_handled_sender_it = local_senders_.end();
   auto report_block_it = report_blocks.begin();
   std::vector<uint32_t> sender_ssrcs;
-  for (auto it = local_senders_.begin();
-       it != local_senders_.end() && sender_ssrcs.size() < max_sender_reports;
+  auto it = local_senders_.begin();
+  for (; it != local_senders_.end() && sender_ssrcs.size() < max_sender_reports;
        ++it) {
     LocalSenderState& rtp_sender = *it;
     RtpStreamRtcpHandler::RtpStats stats = rtp_sender.handler->SentStats();
@@ -699,6 +709,9 @@ std::vector<uint32_t> RtcpTransceiverImpl::FillReports(
                           local_senders_.begin(),
                           std::next(last_handled_sender_it));
   }
+  if (pending != nullptr) {
+    pending->may_have_senders = it != local_senders_.end();
+  }
 
   // Calculcate number of receiver reports to attach remaining report blocks to.
   size_t num_receiver_reports =
@@ -731,17 +744,25 @@ std::vector<uint32_t> RtcpTransceiverImpl::FillReports(
   return sender_ssrcs;
 }
 
+absl::optional<rtcp::Sdes> RtcpTransceiverImpl::CreateSdes() const {
+  if (config_.cname.empty()) {
+    return absl::nullopt;
+  }
+  absl::optional<rtcp::Sdes> sdes(absl::in_place);
+  bool added = sdes->AddCName(config_.feedback_ssrc, config_.cname);
+  RTC_DCHECK(added) << "Failed to add CNAME " << config_.cname
+                    << " to RTCP SDES packet.";
+  return sdes;
+}
+
 void RtcpTransceiverImpl::CreateCompoundPacket(Timestamp now,
                                                size_t reserved_bytes,
+                                               PendingReports* pending,
                                                PacketSender& sender) {
   RTC_DCHECK(sender.IsEmpty());
   ReservedBytes reserved = {.per_packet = reserved_bytes};
-  absl::optional<rtcp::Sdes> sdes;
-  if (!config_.cname.empty()) {
-    sdes.emplace();
-    bool added = sdes->AddCName(config_.feedback_ssrc, config_.cname);
-    RTC_DCHECK(added) << "Failed to add CNAME " << config_.cname
-                      << " to RTCP SDES packet.";
+  absl::optional<rtcp::Sdes> sdes = CreateSdes();
+  if (sdes.has_value()) {
     reserved.per_packet += sdes->BlockLength();
   }
   if (remb_.has_value()) {
@@ -778,7 +799,8 @@ void RtcpTransceiverImpl::CreateCompoundPacket(Timestamp now,
     reserved.per_packet += (4 + 4 + rtcp::Rrtr::kLength);
   }
 
-  std::vector<uint32_t> sender_ssrcs = FillReports(now, reserved, sender);
+  std::vector<uint32_t> sender_ssrcs =
+      FillReports(now, reserved, pending, sender);
   bool has_sender_report = !sender_ssrcs.empty();
   uint32_t sender_ssrc =
       has_sender_report ? sender_ssrcs.front() : config_.feedback_ssrc;
@@ -812,11 +834,48 @@ void RtcpTransceiverImpl::CreateCompoundPacket(Timestamp now,
   }
 }
 
+void RtcpTransceiverImpl::CreateContinuationPacket(Timestamp now,
+                                                   PendingReports& pending,
+                                                   PacketSender& sender) {
+  RTC_DCHECK(sender.IsEmpty());
+  // REMB and extended reports went into the first packet of the periodic
+  // report, but every compound packet carries the CNAME.
+  absl::optional<rtcp::Sdes> sdes = CreateSdes();
+  ReservedBytes reserved;
+  if (sdes.has_value()) {
+    reserved.per_packet += sdes->BlockLength();
+  }
+  FillReports(now, reserved, &pending, sender);
+  if (sdes.has_value() && !sender.IsEmpty()) {
+    sender.AppendPacket(*sdes);
+  }
+}
+
 void RtcpTransceiverImpl::SendPeriodicCompoundPacket() {
   Timestamp now = config_.clock->CurrentTime();
   PacketSender sender(rtcp_transport_, config_.max_packet_size);
-  CreateCompoundPacket(now, /*reserved_bytes=*/0, sender);
+  if (config_.max_packets_per_periodic_report == 1) {
+    CreateCompoundPacket(now, /*reserved_bytes=*/0, /*pending=*/nullptr,
+                         sender);
+    sender.Send();
+    return;
+  }
+
+  // Collect report blocks for all received streams at once, so that each is
+  // reported once per period no matter how many packets it takes.
+  PendingReports pending;
+  pending.report_blocks = CreateReportBlocks(
+      now, config_.max_packets_per_periodic_report *
+               (config_.max_packet_size / rtcp::ReportBlock::kLength));
+  CreateCompoundPacket(now, /*reserved_bytes=*/0, &pending, sender);
   sender.Send();
+  for (size_t num_packets = 1;
+       num_packets < config_.max_packets_per_periodic_report &&
+       (!pending.report_blocks.empty() || pending.may_have_senders);
+       ++num_packets) {
+    CreateContinuationPacket(now, pending, sender);
+    sender.Send();
+  }
 }
 
 void RtcpTransceiverImpl::SendCombinedRtcpPacket(
@@ -838,7 +897,7 @@ void RtcpTransceiverImpl::SendImmediateFeedback(
   if (config_.rtcp_mode == RtcpMode::kCompound) {
     Timestamp now = config_.clock->CurrentTime();
     CreateCompoundPacket(now, /*reserved_bytes=*/rtcp_packet.BlockLength(),
-                         sender);
+                         /*pending=*/nullptr, sender);
   }
 
   sender.AppendPacket(rtcp_packet);
@@ -23,6 +23,7 @@
 #include "modules/rtp_rtcp/source/rtcp_packet/dlrr.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/remb.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/report_block.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/sdes.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/target_bitrate.h"
 #include "modules/rtp_rtcp/source/rtcp_transceiver_config.h"
 #include "rtc_base/containers/flat_map.h"
@@ -125,9 +126,19 @@ class RtcpTransceiverImpl {
 
   void ReschedulePeriodicCompoundPackets();
   void SchedulePeriodicCompoundPackets(TimeDelta delay);
+  // Reports of a periodic report spread over several compound packets that are
+  // yet to be sent.
+  struct PendingReports {
+    std::vector<rtcp::ReportBlock> report_blocks;
+    // Set when sender reports didn't fit, though some of the remaining senders
+    // may turn out to have nothing to report.
+    bool may_have_senders = false;
+  };
   // Appends RTCP sender and receiver reports to the `sender`.
   // Both sender and receiver reports may have attached report blocks.
   // Uses up to `config_.max_packet_size - reserved_bytes.per_packet`
+  // When `pending` is set, attaches report blocks taken from it and updates it
+  // with what didn't fit, otherwise creates as many report blocks as fit.
   // Returns list of sender ssrc in sender reports.
   struct ReservedBytes {
     size_t per_packet = 0;
@@ -135,13 +146,21 @@ class RtcpTransceiverImpl {
   };
   std::vector<uint32_t> FillReports(Timestamp now,
                                     ReservedBytes reserved_bytes,
+                                    PendingReports* pending,
                                     PacketSender& rtcp_sender);
 
   // Creates compound RTCP packet, as defined in
   // https://tools.ietf.org/html/rfc5506#section-2
   void CreateCompoundPacket(Timestamp now,
                             size_t reserved_bytes,
+                            PendingReports* pending,
                             PacketSender& rtcp_sender);
+  // Creates compound RTCP packet with just the reports from `pending` that
+  // follows the first packet of a periodic report.
+  void CreateContinuationPacket(Timestamp now,
+                                PendingReports& pending,
+                                PacketSender& rtcp_sender);
+  absl::optional<rtcp::Sdes> CreateSdes() const;
 
   // Sends RTCP packets.
   void SendPeriodicCompoundPacket();
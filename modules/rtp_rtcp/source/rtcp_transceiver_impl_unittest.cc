@@ -49,6 +49,7 @@ using ::testing::Return;
 using ::testing::SizeIs;
 using ::testing::StrictMock;
 using ::testing::UnorderedElementsAre;
+using ::testing::UnorderedElementsAreArray;
 using ::testing::WithArg;
 using ::webrtc::rtcp::Bye;
 using ::webrtc::rtcp::CompoundPacket;
@@ -1660,5 +1661,91 @@ TEST_F(RtcpTransceiverImplTest, SkipsSenderReportForInactiveSender) {
   EXPECT_EQ(rtcp_parser.sender_report()->num_packets(), 6);
 }
 
+TEST_F(RtcpTransceiverImplTest, SpreadsPeriodicReportOverSeveralPackets) {
+  static constexpr int kNumRemoteSsrcs = 100;
+  std::vector<ReportBlock> statistics_report_blocks(kNumRemoteSsrcs);
+  std::vector<uint32_t> remote_ssrcs;
+  for (int i = 0; i < kNumRemoteSsrcs; ++i) {
+    remote_ssrcs.push_back(1000 + i);
+    statistics_report_blocks[i].SetMediaSsrc(remote_ssrcs.back());
+  }
+  MockReceiveStatisticsProvider receive_statistics;
+  EXPECT_CALL(receive_statistics,
+              RtcpReportBlocks(/*max_blocks=*/Ge(size_t{kNumRemoteSsrcs})))
+      .WillOnce(Return(statistics_report_blocks));
+
+  // Receive reports as if remote ssrcs were local senders of the other side.
+  RtcpTransceiverImpl rtcp_receiver(DefaultTestConfig());
+  NiceMock<MockRtpStreamRtcpHandler> remote_sender;
+  std::vector<uint32_t> reported_ssrcs;
+  ON_CALL(remote_sender, OnReport)
+      .WillByDefault([&](const ReportBlockData& report_block) {
+        reported_ssrcs.push_back(report_block.source_ssrc());
+      });
+  for (uint32_t ssrc : remote_ssrcs) {
+    rtcp_receiver.AddMediaSender(ssrc, &remote_sender);
+  }
+
+  int num_packets = 0;
+  RtcpTransceiverConfig config = DefaultTestConfig();
+  config.cname = "cname";
+  config.receive_statistics = &receive_statistics;
+  config.max_packets_per_periodic_report = 4;
+  config.rtcp_transport = [&](rtc::ArrayView<const uint8_t> packet) {
+    ++num_packets;
+    // Each packet should be a valid compound packet on its own.
+    RtcpPacketParser rtcp_parser;
+    EXPECT_TRUE(rtcp_parser.Parse(packet));
+    EXPECT_GE(rtcp_parser.receiver_report()->num_packets(), 1);
+    EXPECT_EQ(rtcp_parser.sdes()->num_packets(), 1);
+    rtcp_receiver.ReceivePacket(packet, CurrentTime());
+  };
+  RtcpTransceiverImpl rtcp_transceiver(config);
+
+  rtcp_transceiver.SendCompoundPacket();
+
+  // 1200 bytes minus 16 bytes for the SDES fit 47 report blocks, thus 100
+  // blocks need 3 packets.
+  EXPECT_EQ(num_packets, 3);
+  EXPECT_THAT(reported_ssrcs, UnorderedElementsAreArray(remote_ssrcs));
+}
+
+TEST_F(RtcpTransceiverImplTest,
+       SendsSenderReportsForAllSendersInSinglePeriodicReport) {
+  static constexpr int kNumSenders = 6;
+  static constexpr uint32_t kSenderSsrc[kNumSenders] = {10, 20, 30, 40, 50, 60};
+  static constexpr int kSendersPerPacket = 5;
+  RtcpTransceiverImpl rtcp_receiver(DefaultTestConfig());
+  NiceMock<MockMediaReceiverRtcpObserver> receiver[kNumSenders];
+  for (int i = 0; i < kNumSenders; ++i) {
+    EXPECT_CALL(receiver[i], OnSenderReport(kSenderSsrc[i], _, _));
+    rtcp_receiver.AddMediaReceiverRtcpObserver(kSenderSsrc[i], &receiver[i]);
+  }
+
+  MockFunction<void(rtc::ArrayView<const uint8_t>)> transport;
+  EXPECT_CALL(transport, Call)
+      .Times(2)
+      .WillRepeatedly([&](rtc::ArrayView<const uint8_t> packet) {
+        rtcp_receiver.ReceivePacket(packet, CurrentTime());
+      });
+  RtcpTransceiverConfig config = DefaultTestConfig();
+  config.rtcp_transport = transport.AsStdFunction();
+  config.max_packets_per_periodic_report = 3;
+  // Limit packet to have space just for kSendersPerPacket sender reports.
+  // Sender report without report blocks require 28 bytes.
+  config.max_packet_size = kSendersPerPacket * 28;
+  RtcpTransceiverImpl rtcp_transceiver(config);
+  RtpStreamRtcpHandler::RtpStats sender_stats;
+  sender_stats.set_num_sent_packets(10);
+  sender_stats.set_num_sent_bytes(1'000);
+  NiceMock<MockRtpStreamRtcpHandler> sender[kNumSenders];
+  for (int i = 0; i < kNumSenders; ++i) {
+    ON_CALL(sender[i], SentStats).WillByDefault(Return(sender_stats));
+    rtcp_transceiver.AddMediaSender(kSenderSsrc[i], &sender[i]);
+  }
+
+  rtcp_transceiver.SendCompoundPacket();
+}
+
 }  // namespace
 }  // namespace webrtc
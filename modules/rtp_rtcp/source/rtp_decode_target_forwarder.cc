@@ -0,0 +1,210 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/rtp_decode_target_forwarder.h"
+
+#include <iterator>
+#include <memory>
+#include <utility>
+
+#include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/rtp_dependency_descriptor_extension.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+namespace {
+
+// Packets kept track of for reordering and NACK translation.
+constexpr size_t kMaxSequenceNumberHistory = 1000;
+
+std::bitset<32> AllDecodeTargets(const FrameDependencyStructure& structure) {
+  return (uint64_t{1} << structure.num_decode_targets) - 1;
+}
+
+}  // namespace
+
+RtpDecodeTargetForwarder::RtpDecodeTargetForwarder(int decode_target)
+    : decode_target_(decode_target) {
+  RTC_DCHECK_GE(decode_target, 0);
+  RTC_DCHECK_LT(decode_target, DependencyDescriptor::kMaxDecodeTargets);
+}
+
+RtpDecodeTargetForwarder::~RtpDecodeTargetForwarder() = default;
+
+void RtpDecodeTargetForwarder::SetDecodeTarget(int decode_target) {
+  RTC_DCHECK_GE(decode_target, 0);
+  RTC_DCHECK_LT(decode_target, DependencyDescriptor::kMaxDecodeTargets);
+  if (decode_target == decode_target_) {
+    pending_decode_target_ = absl::nullopt;
+    return;
+  }
+  pending_decode_target_ = decode_target;
+}
+
+std::bitset<32> RtpDecodeTargetForwarder::ForwardedDecodeTargets(
+    int decode_target) const {
+  RTC_DCHECK(structure_);
+  std::bitset<32> forwarded = AllDecodeTargets(*structure_);
+  for (const FrameDependencyTemplate& frame_template : structure_->templates) {
+    if (frame_template.decode_target_indications[decode_target] !=
+        DecodeTargetIndication::kNotPresent) {
+      continue;
+    }
+    // Frames of this template are dropped, so the decode targets that need
+    // them can't be decoded anymore.
+    for (int i = 0; i < structure_->num_decode_targets; ++i) {
+      if (frame_template.decode_target_indications[i] !=
+          DecodeTargetIndication::kNotPresent) {
+        forwarded[i] = false;
+      }
+    }
+  }
+  return forwarded;
+}
+
+bool RtpDecodeTargetForwarder::IsSwitchPoint(
+    const DependencyDescriptor& descriptor,
+    int decode_target) const {
+  if (decode_target >= structure_->num_decode_targets) {
+    return false;
+  }
+  return descriptor.attached_structure != nullptr ||
+         descriptor.frame_dependencies
+                 .decode_target_indications[decode_target] ==
+             DecodeTargetIndication::kSwitch;
+}
+
+bool RtpDecodeTargetForwarder::ForwardPacket(RtpPacket& packet) {
+  DependencyDescriptor descriptor;
+  if (!packet.GetExtension<RtpDependencyDescriptorExtension>(structure_.get(),
+                                                             &descriptor)) {
+    UpdateSequenceNumbers(packet.SequenceNumber(), /*forwarded=*/false);
+    return false;
+  }
+  const bool new_structure = descriptor.attached_structure != nullptr;
+  if (new_structure) {
+    structure_ = std::move(descriptor.attached_structure);
+    sender_active_decode_targets_ = AllDecodeTargets(*structure_);
+  }
+  if (descriptor.active_decode_targets_bitmask) {
+    sender_active_decode_targets_ = *descriptor.active_decode_targets_bitmask;
+  }
+
+  const int64_t frame_id =
+      frame_number_unwrapper_.Unwrap(descriptor.frame_number);
+  const bool new_frame = descriptor.first_packet_in_frame &&
+                         (!last_frame_id_ || frame_id > *last_frame_id_);
+  if (new_frame) {
+    if (pending_decode_target_ &&
+        IsSwitchPoint(descriptor, *pending_decode_target_)) {
+      decode_target_ = *pending_decode_target_;
+      pending_decode_target_ = absl::nullopt;
+      forwarded_decode_targets_ = ForwardedDecodeTargets(decode_target_);
+    } else if (new_structure) {
+      forwarded_decode_targets_ = ForwardedDecodeTargets(decode_target_);
+    }
+  }
+
+  if (decode_target_ >= structure_->num_decode_targets) {
+    RTC_LOG(LS_WARNING) << "Decode target " << decode_target_
+                        << " not in structure with "
+                        << structure_->num_decode_targets << " targets.";
+    UpdateSequenceNumbers(packet.SequenceNumber(), /*forwarded=*/false);
+    return false;
+  }
+  if (descriptor.frame_dependencies.decode_target_indications[decode_target_] ==
+      DecodeTargetIndication::kNotPresent) {
+    UpdateSequenceNumbers(packet.SequenceNumber(), /*forwarded=*/false);
+    return false;
+  }
+
+  if (new_frame) {
+    last_frame_id_ = frame_id;
+    active_decode_targets_helper_.OnFrame(
+        structure_->decode_target_protected_by_chain,
+        forwarded_decode_targets_ & sender_active_decode_targets_,
+        /*is_keyframe=*/new_structure, frame_id,
+        descriptor.frame_dependencies.chain_diffs);
+  }
+  // Only rewrite the extension when the bitmask the receiver needs differs
+  // from the one the sender attached.
+  absl::optional<uint32_t> active_decode_targets =
+      active_decode_targets_helper_.ActiveDecodeTargetsBitmask();
+  if (new_structure && !active_decode_targets) {
+    // Implied by the attached structure.
+    active_decode_targets = AllDecodeTargets(*structure_).to_ulong();
+  }
+  if (descriptor.first_packet_in_frame &&
+      active_decode_targets != descriptor.active_decode_targets_bitmask) {
+    descriptor.active_decode_targets_bitmask = active_decode_targets;
+    if (new_structure) {
+      descriptor.attached_structure =
+          std::make_unique<FrameDependencyStructure>(*structure_);
+    }
+    packet.RemoveExtension(kRtpExtensionDependencyDescriptor);
+    if (!packet.SetExtension<RtpDependencyDescriptorExtension>(
+            *structure_, active_decode_targets_helper_.ActiveChainsBitmask(),
+            descriptor)) {
+      RTC_LOG(LS_WARNING) << "Failed to rewrite dependency descriptor.";
+      UpdateSequenceNumbers(packet.SequenceNumber(), /*forwarded=*/false);
+      return false;
+    }
+  }
+
+  const uint16_t incoming_sequence_number = packet.SequenceNumber();
+  packet.SetSequenceNumber(
+      UpdateSequenceNumbers(incoming_sequence_number, /*forwarded=*/true));
+  forwarded_sequence_numbers_.emplace_back(packet.SequenceNumber(),
+                                           incoming_sequence_number);
+  if (forwarded_sequence_numbers_.size() > kMaxSequenceNumberHistory) {
+    forwarded_sequence_numbers_.pop_front();
+  }
+  return true;
+}
+
+uint16_t RtpDecodeTargetForwarder::UpdateSequenceNumbers(
+    uint16_t sequence_number,
+    bool forwarded) {
+  const int64_t unwrapped = sequence_number_unwrapper_.Unwrap(sequence_number);
+  auto it = sequence_numbers_.lower_bound(unwrapped);
+  int64_t num_dropped_before = 0;
+  if (it != sequence_numbers_.begin()) {
+    num_dropped_before = std::prev(it)->second.num_dropped;
+  } else if (it != sequence_numbers_.end()) {
+    // Older than all packets in the history.
+    num_dropped_before = it->second.num_dropped -
+                         (it->second.forwarded ? 0 : 1);
+  }
+  if (it != sequence_numbers_.end() && it->first == unwrapped) {
+    // Duplicate, keep the decision and sequence number of the original.
+    return static_cast<uint16_t>(unwrapped - num_dropped_before);
+  }
+  sequence_numbers_.emplace_hint(
+      it, unwrapped,
+      SequenceNumberInfo{num_dropped_before + (forwarded ? 0 : 1), forwarded});
+  if (sequence_numbers_.size() > kMaxSequenceNumberHistory) {
+    sequence_numbers_.erase(sequence_numbers_.begin());
+  }
+  return static_cast<uint16_t>(unwrapped - num_dropped_before);
+}
+
+absl::optional<uint16_t> RtpDecodeTargetForwarder::IncomingSequenceNumber(
+    uint16_t forwarded_sequence_number) const {
+  for (auto it = forwarded_sequence_numbers_.rbegin();
+       it != forwarded_sequence_numbers_.rend(); ++it) {
+    if (it->first == forwarded_sequence_number) {
+      return it->second;
+    }
+  }
+  return absl::nullopt;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,94 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_RTP_DECODE_TARGET_FORWARDER_H_
+#define MODULES_RTP_RTCP_SOURCE_RTP_DECODE_TARGET_FORWARDER_H_
+
+#include <stdint.h>
+
+#include <bitset>
+#include <deque>
+#include <map>
+#include <memory>
+#include <utility>
+
+#include "absl/types/optional.h"
+#include "api/transport/rtp/dependency_descriptor.h"
+#include "modules/rtp_rtcp/source/active_decode_targets_helper.h"
+#include "modules/rtp_rtcp/source/rtp_packet.h"
+#include "rtc_base/numerics/sequence_number_unwrapper.h"
+
+namespace webrtc {
+
+// Forwards the packets of one scalable video stream that are needed to decode
+// a single decode target, using the dependency descriptor rtp header
+// extension, e.g. for an SFU that sends each receiver the layers it can take.
+// Packets of frames the target doesn't depend on are dropped, the sequence
+// numbers of the remaining packets are rewritten to stay contiguous, and the
+// active decode targets bitmask is rewritten so that the receiver knows which
+// decode targets it can still decode.
+// Switching to another decode target takes effect on the next frame that is a
+// switch point for it, or a key frame.
+// This class is thread-compatible.
+class RtpDecodeTargetForwarder {
+ public:
+  explicit RtpDecodeTargetForwarder(int decode_target);
+  RtpDecodeTargetForwarder(const RtpDecodeTargetForwarder&) = delete;
+  RtpDecodeTargetForwarder& operator=(const RtpDecodeTargetForwarder&) =
+      delete;
+  ~RtpDecodeTargetForwarder();
+
+  void SetDecodeTarget(int decode_target);
+  int decode_target() const { return decode_target_; }
+
+  // Returns false if `packet` should be dropped. Otherwise rewrites its
+  // sequence number and, when needed, its dependency descriptor for
+  // forwarding. Packets are dropped until a key frame carrying the template
+  // structure has been seen.
+  bool ForwardPacket(RtpPacket& packet);
+
+  // Maps the sequence number of a recently forwarded packet back to the
+  // sequence number it had when received, e.g. to translate NACKs.
+  absl::optional<uint16_t> IncomingSequenceNumber(
+      uint16_t forwarded_sequence_number) const;
+
+ private:
+  struct SequenceNumberInfo {
+    // Number of packets dropped up to and including this one.
+    int64_t num_dropped;
+    bool forwarded;
+  };
+
+  // Decode targets whose frames are all needed by `decode_target_`.
+  std::bitset<32> ForwardedDecodeTargets(int decode_target) const;
+  bool IsSwitchPoint(const DependencyDescriptor& descriptor,
+                     int decode_target) const;
+  // Returns the forwarded sequence number.
+  uint16_t UpdateSequenceNumbers(uint16_t sequence_number, bool forwarded);
+
+  int decode_target_;
+  absl::optional<int> pending_decode_target_;
+  std::unique_ptr<FrameDependencyStructure> structure_;
+  std::bitset<32> forwarded_decode_targets_;
+  // Decode targets the sender marks as active.
+  std::bitset<32> sender_active_decode_targets_;
+  ActiveDecodeTargetsHelper active_decode_targets_helper_;
+  SeqNumUnwrapper<uint16_t> frame_number_unwrapper_;
+  absl::optional<int64_t> last_frame_id_;
+
+  SeqNumUnwrapper<uint16_t> sequence_number_unwrapper_;
+  std::map<int64_t, SequenceNumberInfo> sequence_numbers_;
+  // Forwarded and incoming sequence numbers of recently forwarded packets.
+  std::deque<std::pair<uint16_t, uint16_t>> forwarded_sequence_numbers_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_RTP_DECODE_TARGET_FORWARDER_H_
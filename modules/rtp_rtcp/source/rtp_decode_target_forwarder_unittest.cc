@@ -0,0 +1,184 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/rtp_decode_target_forwarder.h"
+
+#include <memory>
+
+#include "api/transport/rtp/dependency_descriptor.h"
+#include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
+#include "modules/rtp_rtcp/source/rtp_dependency_descriptor_extension.h"
+#include "modules/rtp_rtcp/source/rtp_packet.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::Optional;
+
+constexpr int kDependencyDescriptorId = 1;
+
+// L1T2: decode target 0 is the base layer, decode target 1 adds the upper
+// temporal layer. One chain protects both.
+FrameDependencyStructure L1T2() {
+  FrameDependencyStructure structure;
+  structure.num_decode_targets = 2;
+  structure.num_chains = 1;
+  structure.decode_target_protected_by_chain = {0, 0};
+  structure.templates = {
+      FrameDependencyTemplate().T(0).Dtis("SS").ChainDiffs({0}),
+      FrameDependencyTemplate().T(0).Dtis("SS").ChainDiffs({2}).FrameDiffs(
+          {2}),
+      FrameDependencyTemplate().T(1).Dtis("-D").ChainDiffs({1}).FrameDiffs(
+          {1}),
+  };
+  return structure;
+}
+
+class RtpDecodeTargetForwarderTest : public ::testing::Test {
+ protected:
+  RtpDecodeTargetForwarderTest() {
+    extensions_.Register<RtpDependencyDescriptorExtension>(
+        kDependencyDescriptorId);
+  }
+
+  // Creates a single packet frame using template `template_index`.
+  RtpPacket Frame(uint16_t sequence_number,
+                  uint16_t frame_number,
+                  int template_index,
+                  bool key_frame = false) {
+    RtpPacket packet(&extensions_);
+    packet.SetSequenceNumber(sequence_number);
+    DependencyDescriptor descriptor;
+    descriptor.frame_number = frame_number;
+    descriptor.frame_dependencies = structure_.templates[template_index];
+    if (key_frame) {
+      descriptor.attached_structure =
+          std::make_unique<FrameDependencyStructure>(structure_);
+    }
+    EXPECT_TRUE(
+        packet.SetExtension<RtpDependencyDescriptorExtension>(structure_,
+                                                              descriptor));
+    return packet;
+  }
+
+  DependencyDescriptor ReadDescriptor(const RtpPacket& packet) {
+    DependencyDescriptor descriptor;
+    EXPECT_TRUE(packet.GetExtension<RtpDependencyDescriptorExtension>(
+        &structure_, &descriptor));
+    return descriptor;
+  }
+
+  RtpHeaderExtensionMap extensions_;
+  const FrameDependencyStructure structure_ = L1T2();
+};
+
+TEST_F(RtpDecodeTargetForwarderTest, DropsPacketsUntilKeyFrame) {
+  RtpDecodeTargetForwarder forwarder(/*decode_target=*/1);
+  RtpPacket delta = Frame(100, 1, 1);
+  EXPECT_FALSE(forwarder.ForwardPacket(delta));
+  RtpPacket key = Frame(101, 2, 0, /*key_frame=*/true);
+  EXPECT_TRUE(forwarder.ForwardPacket(key));
+}
+
+TEST_F(RtpDecodeTargetForwarderTest, ForwardsAllFramesOfTopDecodeTarget) {
+  RtpDecodeTargetForwarder forwarder(/*decode_target=*/1);
+  RtpPacket key = Frame(100, 1, 0, /*key_frame=*/true);
+  ASSERT_TRUE(forwarder.ForwardPacket(key));
+  EXPECT_THAT(ReadDescriptor(key).active_decode_targets_bitmask,
+              Optional(0b11u));
+
+  RtpPacket packets[] = {Frame(101, 2, 2), Frame(102, 3, 1), Frame(103, 4, 2)};
+  for (RtpPacket& packet : packets) {
+    const uint16_t sequence_number = packet.SequenceNumber();
+    EXPECT_TRUE(forwarder.ForwardPacket(packet));
+    EXPECT_EQ(packet.SequenceNumber(), sequence_number);
+    EXPECT_EQ(ReadDescriptor(packet).active_decode_targets_bitmask,
+              absl::nullopt);
+  }
+}
+
+TEST_F(RtpDecodeTargetForwarderTest, DropsUpperLayerAndRewritesSequence) {
+  RtpDecodeTargetForwarder forwarder(/*decode_target=*/0);
+  RtpPacket key = Frame(65534, 1, 0, /*key_frame=*/true);
+  RtpPacket t1 = Frame(65535, 2, 2);
+  RtpPacket t0 = Frame(0, 3, 1);
+  RtpPacket t1_2 = Frame(1, 4, 2);
+  RtpPacket t0_2 = Frame(2, 5, 1);
+
+  EXPECT_TRUE(forwarder.ForwardPacket(key));
+  EXPECT_FALSE(forwarder.ForwardPacket(t1));
+  EXPECT_TRUE(forwarder.ForwardPacket(t0));
+  EXPECT_FALSE(forwarder.ForwardPacket(t1_2));
+  EXPECT_TRUE(forwarder.ForwardPacket(t0_2));
+
+  EXPECT_EQ(key.SequenceNumber(), 65534);
+  EXPECT_EQ(t0.SequenceNumber(), 65535);
+  EXPECT_EQ(t0_2.SequenceNumber(), 0);
+  EXPECT_THAT(forwarder.IncomingSequenceNumber(0), Optional(2));
+  EXPECT_EQ(forwarder.IncomingSequenceNumber(1), absl::nullopt);
+}
+
+TEST_F(RtpDecodeTargetForwarderTest, MarksDroppedDecodeTargetsInactive) {
+  RtpDecodeTargetForwarder forwarder(/*decode_target=*/0);
+  RtpPacket key = Frame(100, 1, 0, /*key_frame=*/true);
+  ASSERT_TRUE(forwarder.ForwardPacket(key));
+  DependencyDescriptor descriptor = ReadDescriptor(key);
+  EXPECT_THAT(descriptor.active_decode_targets_bitmask, Optional(0b01u));
+  EXPECT_NE(descriptor.attached_structure, nullptr);
+
+  // Bitmask is sent until a frame on the chain was delivered with it.
+  RtpPacket t1 = Frame(101, 2, 2);
+  EXPECT_FALSE(forwarder.ForwardPacket(t1));
+  RtpPacket t0 = Frame(102, 3, 1);
+  ASSERT_TRUE(forwarder.ForwardPacket(t0));
+  EXPECT_EQ(ReadDescriptor(t0).active_decode_targets_bitmask, absl::nullopt);
+}
+
+TEST_F(RtpDecodeTargetForwarderTest, SwitchesUpAtSwitchPoint) {
+  RtpDecodeTargetForwarder forwarder(/*decode_target=*/0);
+  RtpPacket key = Frame(100, 1, 0, /*key_frame=*/true);
+  ASSERT_TRUE(forwarder.ForwardPacket(key));
+
+  forwarder.SetDecodeTarget(1);
+  // Not a switch point for decode target 1.
+  RtpPacket t1 = Frame(101, 2, 2);
+  EXPECT_FALSE(forwarder.ForwardPacket(t1));
+  EXPECT_EQ(forwarder.decode_target(), 0);
+
+  RtpPacket t0 = Frame(102, 3, 1);
+  EXPECT_TRUE(forwarder.ForwardPacket(t0));
+  EXPECT_EQ(forwarder.decode_target(), 1);
+  EXPECT_THAT(ReadDescriptor(t0).active_decode_targets_bitmask,
+              Optional(0b11u));
+
+  RtpPacket t1_2 = Frame(103, 4, 2);
+  EXPECT_TRUE(forwarder.ForwardPacket(t1_2));
+  EXPECT_EQ(t1_2.SequenceNumber(), 102);
+}
+
+TEST_F(RtpDecodeTargetForwarderTest, KeepsSequenceNumbersOfReorderedPackets) {
+  RtpDecodeTargetForwarder forwarder(/*decode_target=*/0);
+  RtpPacket key = Frame(100, 1, 0, /*key_frame=*/true);
+  RtpPacket t1 = Frame(101, 2, 2);
+  RtpPacket t0 = Frame(102, 3, 1);
+  RtpPacket t0_2 = Frame(103, 5, 1);
+
+  ASSERT_TRUE(forwarder.ForwardPacket(key));
+  ASSERT_TRUE(forwarder.ForwardPacket(t0_2));
+  ASSERT_FALSE(forwarder.ForwardPacket(t1));
+  ASSERT_TRUE(forwarder.ForwardPacket(t0));
+  EXPECT_EQ(t0_2.SequenceNumber(), 103);
+  EXPECT_EQ(t0.SequenceNumber(), 101);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -78,7 +78,7 @@ void RtpPacket::IdentifyExtensions(ExtensionManager extensions) {
 }
 
 bool RtpPacket::Parse(const uint8_t* buffer, size_t buffer_size) {
-  if (!ParseBuffer(buffer, buffer_size)) {
+  if (!ParseBuffer(buffer, buffer_size, ExtensionParsing::kEager)) {
     Clear();
     return false;
   }
@@ -92,7 +92,12 @@ bool RtpPacket::Parse(rtc::ArrayView<const uint8_t> packet) {
 }
 
 bool RtpPacket::Parse(rtc::CopyOnWriteBuffer buffer) {
-  if (!ParseBuffer(buffer.cdata(), buffer.size())) {
+  return Parse(std::move(buffer), ExtensionParsing::kEager);
+}
+
+bool RtpPacket::Parse(rtc::CopyOnWriteBuffer buffer,
+                      ExtensionParsing extension_parsing) {
+  if (!ParseBuffer(buffer.cdata(), buffer.size(), extension_parsing)) {
     Clear();
     return false;
   }
@@ -123,6 +128,7 @@ void RtpPacket::CopyHeaderFrom(const RtpPacket& packet) {
   extensions_ = packet.extensions_;
   extension_entries_ = packet.extension_entries_;
   extensions_size_ = packet.extensions_size_;
+  extensions_indexed_ = packet.extensions_indexed_;
   buffer_ = packet.buffer_.Slice(0, packet.headers_size());
   // Reset payload and padding.
   payload_size_ = 0;
@@ -160,6 +166,7 @@ void RtpPacket::SetSsrc(uint32_t ssrc) {
 }
 
 void RtpPacket::ZeroMutableExtensions() {
+  EnsureExtensionsIndexed();
   for (const ExtensionInfo& extension : extension_entries_) {
     switch (extensions_.GetType(extension.id)) {
       case RTPExtensionType::kRtpExtensionNone: {
@@ -210,6 +217,7 @@ void RtpPacket::ZeroMutableExtensions() {
 }
 
 void RtpPacket::SetCsrcs(rtc::ArrayView<const uint32_t> csrcs) {
+  EnsureExtensionsIndexed();
   RTC_DCHECK_EQ(extensions_size_, 0);
   RTC_DCHECK_EQ(payload_size_, 0);
   RTC_DCHECK_EQ(padding_size_, 0);
@@ -425,6 +433,21 @@ bool RtpPacket::SetPadding(size_t padding_bytes) {
   return true;
 }
 
+void RtpPacket::RemovePayloadPrefix(size_t size_bytes) {
+  RTC_DCHECK_LE(size_bytes, payload_size_);
+  const size_t payload_size = payload_size_ - size_bytes;
+  uint8_t* const data = WriteAt(0);
+  data[0] &= ~0x20;  // Clear padding bit.
+  if (size_bytes > 0) {
+    memmove(data + size_bytes, data, payload_offset_);
+  }
+  // Header extension offsets are relative to the start of the packet, so they
+  // stay valid.
+  buffer_ = buffer_.Slice(size_bytes, payload_offset_ + payload_size);
+  payload_size_ = payload_size;
+  padding_size_ = 0;
+}
+
 void RtpPacket::Clear() {
   marker_ = false;
   payload_type_ = 0;
@@ -436,13 +459,16 @@ void RtpPacket::Clear() {
   padding_size_ = 0;
   extensions_size_ = 0;
   extension_entries_.clear();
+  extensions_indexed_ = true;
 
   memset(WriteAt(0), 0, kFixedHeaderSize);
   buffer_.SetSize(kFixedHeaderSize);
   WriteAt(0, kRtpVersion << 6);
 }
 
-bool RtpPacket::ParseBuffer(const uint8_t* buffer, size_t size) {
+bool RtpPacket::ParseBuffer(const uint8_t* buffer,
+                            size_t size,
+                            ExtensionParsing extension_parsing) {
   if (size < kFixedHeaderSize) {
     return false;
   }
@@ -466,6 +492,7 @@ bool RtpPacket::ParseBuffer(const uint8_t* buffer, size_t size) {
 
   extensions_size_ = 0;
   extension_entries_.clear();
+  extensions_indexed_ = true;
   if (has_extension) {
     /* RTP header extension, RFC 3550.
      0                   1                   2                   3
@@ -492,54 +519,10 @@ bool RtpPacket::ParseBuffer(const uint8_t* buffer, size_t size) {
         (profile & kTwobyteExtensionProfileIdAppBitsFilter) !=
             kTwoByteExtensionProfileId) {
       RTC_LOG(LS_WARNING) << "Unsupported rtp extension " << profile;
+    } else if (extension_parsing == ExtensionParsing::kLazy) {
+      extensions_indexed_ = false;
     } else {
-      size_t extension_header_length = profile == kOneByteExtensionProfileId
-                                           ? kOneByteExtensionHeaderLength
-                                           : kTwoByteExtensionHeaderLength;
-      constexpr uint8_t kPaddingByte = 0;
-      constexpr uint8_t kPaddingId = 0;
-      constexpr uint8_t kOneByteHeaderExtensionReservedId = 15;
-      while (extensions_size_ + extension_header_length < extensions_capacity) {
-        if (buffer[extension_offset + extensions_size_] == kPaddingByte) {
-          extensions_size_++;
-          continue;
-        }
-        int id;
-        uint8_t length;
-        if (profile == kOneByteExtensionProfileId) {
-          id = buffer[extension_offset + extensions_size_] >> 4;
-          length = 1 + (buffer[extension_offset + extensions_size_] & 0xf);
-          if (id == kOneByteHeaderExtensionReservedId ||
-              (id == kPaddingId && length != 1)) {
-            break;
-          }
-        } else {
-          id = buffer[extension_offset + extensions_size_];
-          length = buffer[extension_offset + extensions_size_ + 1];
-        }
-
-        if (extensions_size_ + extension_header_length + length >
-            extensions_capacity) {
-          RTC_LOG(LS_WARNING) << "Oversized rtp header extension.";
-          break;
-        }
-
-        ExtensionInfo& extension_info = FindOrCreateExtensionInfo(id);
-        if (extension_info.length != 0) {
-          RTC_LOG(LS_VERBOSE)
-              << "Duplicate rtp header extension id " << id << ". Overwriting.";
-        }
-
-        size_t offset =
-            extension_offset + extensions_size_ + extension_header_length;
-        if (!rtc::IsValueInRangeForNumericType<uint16_t>(offset)) {
-          RTC_DLOG(LS_WARNING) << "Oversized rtp header extension.";
-          break;
-        }
-        extension_info.offset = static_cast<uint16_t>(offset);
-        extension_info.length = length;
-        extensions_size_ += extension_header_length + length;
-      }
+      IndexExtensions(buffer, extension_offset, extensions_capacity, profile);
     }
     payload_offset_ = extension_offset + extensions_capacity;
   }
@@ -561,7 +544,71 @@ bool RtpPacket::ParseBuffer(const uint8_t* buffer, size_t size) {
   return true;
 }
 
+void RtpPacket::IndexExtensions(const uint8_t* buffer,
+                                size_t extension_offset,
+                                size_t extensions_capacity,
+                                uint16_t profile) const {
+  size_t extension_header_length = profile == kOneByteExtensionProfileId
+                                       ? kOneByteExtensionHeaderLength
+                                       : kTwoByteExtensionHeaderLength;
+  constexpr uint8_t kPaddingByte = 0;
+  constexpr uint8_t kPaddingId = 0;
+  constexpr uint8_t kOneByteHeaderExtensionReservedId = 15;
+  while (extensions_size_ + extension_header_length < extensions_capacity) {
+    if (buffer[extension_offset + extensions_size_] == kPaddingByte) {
+      extensions_size_++;
+      continue;
+    }
+    int id;
+    uint8_t length;
+    if (profile == kOneByteExtensionProfileId) {
+      id = buffer[extension_offset + extensions_size_] >> 4;
+      length = 1 + (buffer[extension_offset + extensions_size_] & 0xf);
+      if (id == kOneByteHeaderExtensionReservedId ||
+          (id == kPaddingId && length != 1)) {
+        break;
+      }
+    } else {
+      id = buffer[extension_offset + extensions_size_];
+      length = buffer[extension_offset + extensions_size_ + 1];
+    }
+
+    if (extensions_size_ + extension_header_length + length >
+        extensions_capacity) {
+      RTC_LOG(LS_WARNING) << "Oversized rtp header extension.";
+      break;
+    }
+
+    ExtensionInfo& extension_info = FindOrCreateExtensionInfo(id);
+    if (extension_info.length != 0) {
+      RTC_LOG(LS_VERBOSE)
+          << "Duplicate rtp header extension id " << id << ". Overwriting.";
+    }
+
+    size_t offset =
+        extension_offset + extensions_size_ + extension_header_length;
+    if (!rtc::IsValueInRangeForNumericType<uint16_t>(offset)) {
+      RTC_DLOG(LS_WARNING) << "Oversized rtp header extension.";
+      break;
+    }
+    extension_info.offset = static_cast<uint16_t>(offset);
+    extension_info.length = length;
+    extensions_size_ += extension_header_length + length;
+  }
+}
+
+void RtpPacket::IndexParsedExtensions() const {
+  RTC_DCHECK(!extensions_indexed_);
+  extensions_indexed_ = true;
+  const size_t num_csrc = data()[0] & 0x0F;
+  const size_t extension_offset = kFixedHeaderSize + num_csrc * 4 + 4;
+  IndexExtensions(
+      data(), extension_offset, payload_offset_ - extension_offset,
+      ByteReader<uint16_t>::ReadBigEndian(data() + extension_offset - 4));
+}
+
 const RtpPacket::ExtensionInfo* RtpPacket::FindExtensionInfo(int id) const {
+  EnsureExtensionsIndexed();
   for (const ExtensionInfo& extension : extension_entries_) {
     if (extension.id == id) {
       return &extension;
@@ -570,7 +617,7 @@ const RtpPacket::ExtensionInfo* RtpPacket::FindExtensionInfo(int id) const {
   return nullptr;
 }
 
-RtpPacket::ExtensionInfo& RtpPacket::FindOrCreateExtensionInfo(int id) {
+RtpPacket::ExtensionInfo& RtpPacket::FindOrCreateExtensionInfo(int id) const {
   for (ExtensionInfo& extension : extension_entries_) {
     if (extension.id == id) {
       return extension;
@@ -645,6 +692,7 @@ bool RtpPacket::RemoveExtension(ExtensionType type) {
   new_packet.IdentifyExtensions(extensions_);
 
   // Copy all extensions, except the one we are removing.
+  EnsureExtensionsIndexed();
   bool found_extension = false;
   for (const ExtensionInfo& ext : extension_entries_) {
     if (ext.id == id_to_remove) {
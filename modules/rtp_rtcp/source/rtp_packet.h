@@ -27,6 +27,18 @@ class RtpPacket {
   using ExtensionType = RTPExtensionType;
   using ExtensionManager = RtpHeaderExtensionMap;
 
+  // How Parse() handles the header extensions of the packet.
+  enum class ExtensionParsing {
+    // Finds and indexes all header extensions while parsing.
+    kEager,
+    // Only locates the header extension block while parsing. The extensions
+    // are indexed when first accessed, so a packet that is only routed by its
+    // fixed header never pays for it. As indexing modifies the packet,
+    // methods accessing extensions, const ones included, must not be called
+    // concurrently before that.
+    kLazy,
+  };
+
   // `extensions` required for SetExtension/ReserveExtension functions during
   // packet creating and used if available in Parse function.
   // Adding and getting extensions will fail until `extensions` is
@@ -53,6 +65,7 @@ class RtpPacket {
 
   // Parse and move given buffer into Packet.
   bool Parse(rtc::CopyOnWriteBuffer packet);
+  bool Parse(rtc::CopyOnWriteBuffer packet, ExtensionParsing extension_parsing);
 
   // Maps extensions id to their types.
   void IdentifyExtensions(ExtensionManager extensions);
@@ -164,6 +177,11 @@ class RtpPacket {
 
   bool SetPadding(size_t padding_size);
 
+  // Removes the first `size_bytes` of the payload, e.g. an RTX header, and
+  // the padding. Moves the headers rather than the payload, and copies the
+  // packet at most once, if its buffer is shared.
+  void RemovePayloadPrefix(size_t size_bytes);
+
   // Returns debug string of RTP packet (without detailed extension info).
   std::string ToString() const;
 
@@ -179,7 +197,24 @@ class RtpPacket {
 
   // Helper function for Parse. Fill header fields using data in given buffer,
   // but does not touch packet own buffer, leaving packet in invalid state.
-  bool ParseBuffer(const uint8_t* buffer, size_t size);
+  bool ParseBuffer(const uint8_t* buffer,
+                   size_t size,
+                   ExtensionParsing extension_parsing);
+
+  // Fills `extension_entries_` and `extensions_size_` from the header
+  // extension block of `extensions_capacity` bytes at `extension_offset`.
+  void IndexExtensions(const uint8_t* buffer,
+                       size_t extension_offset,
+                       size_t extensions_capacity,
+                       uint16_t profile) const;
+
+  // Indexes the header extensions if parsing was lazy.
+  void EnsureExtensionsIndexed() const {
+    if (!extensions_indexed_) {
+      IndexParsedExtensions();
+    }
+  }
+  void IndexParsedExtensions() const;
 
   // Returns pointer to extension info for a given id. Returns nullptr if not
   // found.
@@ -187,7 +222,7 @@ class RtpPacket {
 
   // Returns reference to extension info for a given id. Creates a new entry
   // with the specified id if not found.
-  ExtensionInfo& FindOrCreateExtensionInfo(int id);
+  ExtensionInfo& FindOrCreateExtensionInfo(int id) const;
 
   // Allocates and returns place to store rtp header extension.
   // Returns empty arrayview on failure.
@@ -216,8 +251,10 @@ class RtpPacket {
   size_t payload_size_;
 
   ExtensionManager extensions_;
-  std::vector<ExtensionInfo> extension_entries_;
-  size_t extensions_size_ = 0;  // Unaligned.
+  // Mutable to allow indexing lazily parsed extensions on first access.
+  mutable std::vector<ExtensionInfo> extension_entries_;
+  mutable size_t extensions_size_ = 0;  // Unaligned.
+  mutable bool extensions_indexed_ = true;
   rtc::CopyOnWriteBuffer buffer_;
 };
 
@@ -0,0 +1,126 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "benchmark/benchmark.h"
+#include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
+#include "modules/rtp_rtcp/source/rtp_header_extensions.h"
+#include "modules/rtp_rtcp/source/rtp_packet_history.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/system/unused.h"
+#include "system_wrappers/include/clock.h"
+#include "test/benchmark_allocation_counter.h"
+
+namespace webrtc {
+namespace {
+
+constexpr uint32_t kSsrc = 0x12345678;
+constexpr int kPayloadType = 96;
+constexpr int kTransportSequenceNumberId = 1;
+constexpr int kAbsoluteSendTimeId = 2;
+constexpr int kAudioLevelId = 3;
+constexpr int kTransmissionOffsetId = 4;
+
+RtpHeaderExtensionMap CreateExtensions() {
+  RtpHeaderExtensionMap extensions;
+  extensions.Register<TransportSequenceNumber>(kTransportSequenceNumberId);
+  extensions.Register<AbsoluteSendTime>(kAbsoluteSendTimeId);
+  extensions.Register<AudioLevel>(kAudioLevelId);
+  extensions.Register<TransmissionOffset>(kTransmissionOffsetId);
+  return extensions;
+}
+
+// Writes the header, the extensions typically sent with media and a payload
+// of `payload_size` bytes to `packet`.
+void BuildPacket(uint16_t sequence_number,
+                 size_t payload_size,
+                 RtpPacketToSend& packet) {
+  packet.SetPayloadType(kPayloadType);
+  packet.SetSequenceNumber(sequence_number);
+  packet.SetTimestamp(sequence_number * 90);
+  packet.SetSsrc(kSsrc);
+  packet.SetExtension<TransportSequenceNumber>(sequence_number);
+  packet.SetExtension<AbsoluteSendTime>(
+      AbsoluteSendTime::To24Bits(Timestamp::Millis(sequence_number)));
+  packet.SetExtension<AudioLevel>(/*voice_activity=*/true, /*audio_level=*/30);
+  packet.SetExtension<TransmissionOffset>(0);
+  uint8_t* payload = packet.AllocatePayload(payload_size);
+  memset(payload, 0x5a, payload_size);
+}
+
+void BM_RtpPacketBuild(benchmark::State& state) {
+  const RtpHeaderExtensionMap extensions = CreateExtensions();
+  const size_t payload_size = state.range(0);
+  uint16_t sequence_number = 0;
+  test::ScopedAllocationCounter allocations(state);
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    RtpPacketToSend packet(&extensions);
+    BuildPacket(sequence_number++, payload_size, packet);
+    benchmark::DoNotOptimize(packet.data());
+  }
+}
+
+void BM_RtpPacketParse(benchmark::State& state) {
+  const RtpHeaderExtensionMap extensions = CreateExtensions();
+  RtpPacketToSend packet(&extensions);
+  BuildPacket(/*sequence_number=*/1, state.range(0), packet);
+  const rtc::CopyOnWriteBuffer buffer = packet.Buffer();
+  RtpPacketReceived received(&extensions);
+  test::ScopedAllocationCounter allocations(state);
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    benchmark::DoNotOptimize(received.Parse(buffer));
+    benchmark::DoNotOptimize(
+        received.GetExtension<TransportSequenceNumber>());
+  }
+}
+
+// Stores one sent packet per iteration and retransmits an older one, as for a
+// stream with about one percent of the packets nacked.
+void BM_RtpPacketHistory(benchmark::State& state) {
+  const RtpHeaderExtensionMap extensions = CreateExtensions();
+  SimulatedClock clock(Timestamp::Seconds(1000));
+  RtpPacketHistory history(&clock,
+                           RtpPacketHistory::PaddingMode::kPriority);
+  history.SetStorePacketsStatus(RtpPacketHistory::StorageMode::kStoreAndCull,
+                                /*number_to_store=*/600);
+  history.SetRtt(TimeDelta::Millis(50));
+  uint16_t sequence_number = 0;
+  test::ScopedAllocationCounter allocations(state);
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    auto packet = std::make_unique<RtpPacketToSend>(&extensions);
+    BuildPacket(sequence_number, /*payload_size=*/1000, *packet);
+    packet->set_allow_retransmission(true);
+    history.PutRtpPacket(std::move(packet), clock.CurrentTime());
+    if (sequence_number % 100 == 0) {
+      const uint16_t nacked = sequence_number - 90;
+      if (history.GetPacketAndMarkAsPending(nacked))
+        history.MarkPacketAsSent(nacked);
+    }
+    ++sequence_number;
+    clock.AdvanceTime(TimeDelta::Millis(1));
+  }
+}
+
+BENCHMARK(BM_RtpPacketBuild)->Arg(100)->Arg(1200);
+BENCHMARK(BM_RtpPacketParse)->Arg(100)->Arg(1200);
+BENCHMARK(BM_RtpPacketHistory);
+
+}  // namespace
+}  // namespace webrtc
@@ -15,6 +15,7 @@
 #include <limits>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "modules/include/module_common_types_public.h"
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
@@ -28,6 +29,7 @@ namespace {
 
 constexpr size_t kOldPayloadPaddingSizeHysteresis = 100;
 constexpr uint16_t kMaxOldPayloadPaddingSequenceNumber = 1 << 13;
+constexpr size_t kMinHistoryCapacity = 16;
 
 }  // namespace
 
@@ -46,35 +48,6 @@ RtpPacketHistory::StoredPacket& RtpPacketHistory::StoredPacket::operator=(
     RtpPacketHistory::StoredPacket&&) = default;
 RtpPacketHistory::StoredPacket::~StoredPacket() = default;
 
-void RtpPacketHistory::StoredPacket::IncrementTimesRetransmitted(
-    PacketPrioritySet* priority_set) {
-  // Check if this StoredPacket is in the priority set. If so, we need to remove
-  // it before updating `times_retransmitted_` since that is used in sorting,
-  // and then add it back.
-  const bool in_priority_set = priority_set && priority_set->erase(this) > 0;
-  ++times_retransmitted_;
-  if (in_priority_set) {
-    auto it = priority_set->insert(this);
-    RTC_DCHECK(it.second)
-        << "ERROR: Priority set already contains matching packet! In set: "
-           "insert order = "
-        << (*it.first)->insert_order_
-        << ", times retransmitted = " << (*it.first)->times_retransmitted_
-        << ". Trying to add: insert order = " << insert_order_
-        << ", times retransmitted = " << times_retransmitted_;
-  }
-}
-
-bool RtpPacketHistory::MoreUseful::operator()(StoredPacket* lhs,
-                                              StoredPacket* rhs) const {
-  // Prefer to send packets we haven't already sent as padding.
-  if (lhs->times_retransmitted() != rhs->times_retransmitted()) {
-    return lhs->times_retransmitted() < rhs->times_retransmitted();
-  }
-  // All else being equal, prefer newer packets.
-  return lhs->insert_order() > rhs->insert_order();
-}
-
 RtpPacketHistory::RtpPacketHistory(Clock* clock, PaddingMode padding_mode)
     : clock_(clock),
       padding_mode_(padding_mode),
@@ -128,27 +101,31 @@ void RtpPacketHistory::PutRtpPacket(std::unique_ptr<RtpPacketToSend> packet,
   // Store packet.
   const uint16_t rtp_seq_no = packet->SequenceNumber();
   int packet_index = GetPacketIndex(rtp_seq_no);
-  if (packet_index >= 0 &&
-      static_cast<size_t>(packet_index) < packet_history_.size() &&
-      packet_history_[packet_index].packet_ != nullptr) {
+  if (packet_index >= 0 && static_cast<size_t>(packet_index) < history_size_ &&
+      EntryAt(packet_index).packet_ != nullptr) {
     RTC_LOG(LS_WARNING) << "Duplicate packet inserted: " << rtp_seq_no;
     // Remove previous packet to avoid inconsistent state.
     RemovePacket(packet_index);
     packet_index = GetPacketIndex(rtp_seq_no);
   }
 
-  // Packet to be inserted ahead of first packet, expand front.
-  for (; packet_index < 0; ++packet_index) {
-    packet_history_.emplace_front();
-  }
-  // Packet to be inserted behind last packet, expand back.
-  while (static_cast<int>(packet_history_.size()) <= packet_index) {
-    packet_history_.emplace_back();
+  if (packet_index < 0) {
+    // Packet to be inserted ahead of first packet, expand front.
+    const size_t num_new_entries = -packet_index;
+    ReserveEntries(history_size_ + num_new_entries);
+    history_begin_ = (history_begin_ - num_new_entries) &
+                     (packet_history_.size() - 1);
+    history_size_ += num_new_entries;
+    packet_index = 0;
+  } else if (static_cast<size_t>(packet_index) >= history_size_) {
+    // Packet to be inserted behind last packet, expand back.
+    ReserveEntries(packet_index + 1);
+    history_size_ = packet_index + 1;
   }
 
   RTC_DCHECK_GE(packet_index, 0);
-  RTC_DCHECK_LT(packet_index, packet_history_.size());
-  RTC_DCHECK(packet_history_[packet_index].packet_ == nullptr);
+  RTC_DCHECK_LT(packet_index, history_size_);
+  RTC_DCHECK(EntryAt(packet_index).packet_ == nullptr);
 
   if (padding_mode_ == PaddingMode::kRecentLargePacket) {
     if ((!large_payload_packet_ ||
@@ -161,15 +138,18 @@ void RtpPacketHistory::PutRtpPacket(std::unique_ptr<RtpPacketToSend> packet,
     }
   }
 
-  packet_history_[packet_index] =
+  StoredPacket& stored_packet = EntryAt(packet_index);
+  stored_packet =
       StoredPacket(std::move(packet), send_time, packets_inserted_++);
 
   if (padding_priority_enabled()) {
-    if (padding_priority_.size() >= kMaxPaddingHistory - 1) {
-      padding_priority_.erase(std::prev(padding_priority_.end()));
+    if (num_padding_candidates_ >= kMaxPaddingHistory - 1) {
+      // Drop the least useful candidate: the oldest of the ones that have
+      // been retransmitted the most times.
+      RemovePaddingCandidate(*GetStoredPacket(
+          static_cast<uint16_t>(padding_buckets_.back().oldest)));
     }
-    auto prio_it = padding_priority_.insert(&packet_history_[packet_index]);
-    RTC_DCHECK(prio_it.second) << "Failed to insert packet into prio set.";
+    AddPaddingCandidate(stored_packet);
   }
 }
 
@@ -230,8 +210,7 @@ void RtpPacketHistory::MarkPacketAsSent(uint16_t sequence_number) {
   // transmission count.
   packet->set_send_time(clock_->CurrentTime());
   packet->pending_transmission_ = false;
-  packet->IncrementTimesRetransmitted(
-      padding_priority_enabled() ? &padding_priority_ : nullptr);
+  IncrementTimesRetransmitted(*packet);
 }
 
 bool RtpPacketHistory::GetPacketState(uint16_t sequence_number) const {
@@ -241,11 +220,10 @@ bool RtpPacketHistory::GetPacketState(uint16_t sequence_number) const {
   }
 
   int packet_index = GetPacketIndex(sequence_number);
-  if (packet_index < 0 ||
-      static_cast<size_t>(packet_index) >= packet_history_.size()) {
+  if (packet_index < 0 || static_cast<size_t>(packet_index) >= history_size_) {
     return false;
   }
-  const StoredPacket& packet = packet_history_[packet_index];
+  const StoredPacket& packet = EntryAt(packet_index);
   if (packet.packet_ == nullptr) {
     return false;
   }
@@ -281,51 +259,38 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPayloadPaddingPacket(
     rtc::FunctionView<std::unique_ptr<RtpPacketToSend>(const RtpPacketToSend&)>
         encapsulate) {
   MutexLock lock(&lock_);
-  if (mode_ == StorageMode::kDisabled) {
+  StoredPacket* stored_packet;
+  const RtpPacketToSend* packet = GetPaddingCandidate(stored_packet);
+  if (packet == nullptr) {
     return nullptr;
   }
-  if (padding_mode_ == PaddingMode::kRecentLargePacket &&
-      large_payload_packet_) {
-    return encapsulate(*large_payload_packet_);
-  }
 
-  StoredPacket* best_packet = nullptr;
-  if (padding_priority_enabled() && !padding_priority_.empty()) {
-    auto best_packet_it = padding_priority_.begin();
-    best_packet = *best_packet_it;
-  } else if (!padding_priority_enabled() && !packet_history_.empty()) {
-    // Prioritization not available, pick the last packet.
-    for (auto it = packet_history_.rbegin(); it != packet_history_.rend();
-         ++it) {
-      if (it->packet_ != nullptr) {
-        best_packet = &(*it);
-        break;
-      }
-    }
-  }
-  if (best_packet == nullptr) {
+  auto padding_packet = encapsulate(*packet);
+  if (!padding_packet) {
     return nullptr;
   }
 
-  if (best_packet->pending_transmission_) {
-    // Because PacedSender releases it's lock when it calls
-    // GeneratePadding() there is the potential for a race where a new
-    // packet ends up here instead of the regular transmit path. In such a
-    // case, just return empty and it will be picked up on the next
-    // Process() call.
-    return nullptr;
+  if (stored_packet != nullptr) {
+    MarkSentAsPadding(*stored_packet, clock_->CurrentTime());
   }
+  return padding_packet;
+}
 
-  auto padding_packet = encapsulate(*best_packet->packet_);
-  if (!padding_packet) {
-    return nullptr;
+std::vector<RtpPacketToSend> RtpPacketHistory::GetPayloadPaddingPackets(
+    rtc::FunctionView<bool(const RtpPacketToSend&)> select) {
+  std::vector<RtpPacketToSend> padding_packets;
+  MutexLock lock(&lock_);
+  const Timestamp now = clock_->CurrentTime();
+  StoredPacket* stored_packet;
+  const RtpPacketToSend* packet;
+  while ((packet = GetPaddingCandidate(stored_packet)) != nullptr &&
+         select(*packet)) {
+    padding_packets.push_back(*packet);
+    if (stored_packet != nullptr) {
+      MarkSentAsPadding(*stored_packet, now);
+    }
   }
-
-  best_packet->set_send_time(clock_->CurrentTime());
-  best_packet->IncrementTimesRetransmitted(
-      padding_priority_enabled() ? &padding_priority_ : nullptr);
-
-  return padding_packet;
+  return padding_packets;
 }
 
 void RtpPacketHistory::CullAcknowledgedPackets(
@@ -334,7 +299,8 @@ void RtpPacketHistory::CullAcknowledgedPackets(
   for (uint16_t sequence_number : sequence_numbers) {
     int packet_index = GetPacketIndex(sequence_number);
     if (packet_index < 0 ||
-        static_cast<size_t>(packet_index) >= packet_history_.size()) {
+        static_cast<size_t>(packet_index) >= history_size_ ||
+        EntryAt(packet_index).packet_ == nullptr) {
       continue;
     }
     RemovePacket(packet_index);
@@ -346,9 +312,29 @@ void RtpPacketHistory::Clear() {
   Reset();
 }
 
+size_t RtpPacketHistory::GetMemoryUsageBytes() const {
+  MutexLock lock(&lock_);
+  size_t bytes = packet_history_.capacity() * sizeof(StoredPacket) +
+                 padding_buckets_.capacity() * sizeof(PaddingBucket);
+  for (size_t i = 0; i < history_size_; ++i) {
+    const StoredPacket& stored_packet = EntryAt(i);
+    if (stored_packet.packet_ != nullptr) {
+      bytes += sizeof(RtpPacketToSend) + stored_packet.packet_->capacity();
+    }
+  }
+  if (large_payload_packet_) {
+    bytes += large_payload_packet_->capacity();
+  }
+  return bytes;
+}
+
 void RtpPacketHistory::Reset() {
   packet_history_.clear();
-  padding_priority_.clear();
+  history_begin_ = 0;
+  history_size_ = 0;
+  padding_buckets_.clear();
+  num_padding_candidates_ = 0;
+  first_padding_bucket_ = 0;
   large_payload_packet_ = absl::nullopt;
 }
 
@@ -358,15 +344,15 @@ void RtpPacketHistory::CullOldPackets() {
       rtt_.IsFinite()
           ? std::max(kMinPacketDurationRtt * rtt_, kMinPacketDuration)
           : kMinPacketDuration;
-  while (!packet_history_.empty()) {
-    if (packet_history_.size() >= kMaxCapacity) {
+  while (history_size_ > 0) {
+    if (history_size_ >= kMaxCapacity) {
       // We have reached the absolute max capacity, remove one packet
       // unconditionally.
       RemovePacket(0);
       continue;
     }
 
-    const StoredPacket& stored_packet = packet_history_.front();
+    const StoredPacket& stored_packet = EntryAt(0);
     if (stored_packet.pending_transmission_) {
       // Don't remove packets in the pacer queue, pending tranmission.
       return;
@@ -377,7 +363,7 @@ void RtpPacketHistory::CullOldPackets() {
       return;
     }
 
-    if (packet_history_.size() >= number_to_store_ ||
+    if (history_size_ >= number_to_store_ ||
         stored_packet.send_time() +
                 (packet_duration * kPacketCullingDelayFactor) <=
             now) {
@@ -393,19 +379,21 @@ void RtpPacketHistory::CullOldPackets() {
 
 std::unique_ptr<RtpPacketToSend> RtpPacketHistory::RemovePacket(
     int packet_index) {
+  StoredPacket& stored_packet = EntryAt(packet_index);
+  // Erase from padding priority buckets, if eligible.
+  if (stored_packet.in_padding_priority_) {
+    RemovePaddingCandidate(stored_packet);
+  }
+
   // Move the packet out from the StoredPacket container.
   std::unique_ptr<RtpPacketToSend> rtp_packet =
-      std::move(packet_history_[packet_index].packet_);
-
-  // Erase from padding priority set, if eligible.
-  if (padding_mode_ == PaddingMode::kPriority) {
-    padding_priority_.erase(&packet_history_[packet_index]);
-  }
+      std::move(stored_packet.packet_);
+  stored_packet = StoredPacket();
 
   if (packet_index == 0) {
-    while (!packet_history_.empty() &&
-           packet_history_.front().packet_ == nullptr) {
-      packet_history_.pop_front();
+    while (history_size_ > 0 && EntryAt(0).packet_ == nullptr) {
+      history_begin_ = (history_begin_ + 1) & (packet_history_.size() - 1);
+      --history_size_;
     }
   }
 
@@ -413,12 +401,12 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::RemovePacket(
 }
 
 int RtpPacketHistory::GetPacketIndex(uint16_t sequence_number) const {
-  if (packet_history_.empty()) {
+  if (history_size_ == 0) {
     return 0;
   }
 
-  RTC_DCHECK(packet_history_.front().packet_ != nullptr);
-  int first_seq = packet_history_.front().packet_->SequenceNumber();
+  RTC_DCHECK(EntryAt(0).packet_ != nullptr);
+  int first_seq = EntryAt(0).packet_->SequenceNumber();
   if (first_seq == sequence_number) {
     return 0;
   }
@@ -442,11 +430,179 @@ int RtpPacketHistory::GetPacketIndex(uint16_t sequence_number) const {
 RtpPacketHistory::StoredPacket* RtpPacketHistory::GetStoredPacket(
     uint16_t sequence_number) {
   int index = GetPacketIndex(sequence_number);
-  if (index < 0 || static_cast<size_t>(index) >= packet_history_.size() ||
-      packet_history_[index].packet_ == nullptr) {
+  if (index < 0 || static_cast<size_t>(index) >= history_size_ ||
+      EntryAt(index).packet_ == nullptr) {
+    return nullptr;
+  }
+  return &EntryAt(index);
+}
+
+RtpPacketHistory::StoredPacket& RtpPacketHistory::EntryAt(
+    size_t packet_index) {
+  RTC_DCHECK_LT(packet_index, history_size_);
+  return packet_history_[(history_begin_ + packet_index) &
+                         (packet_history_.size() - 1)];
+}
+
+const RtpPacketHistory::StoredPacket& RtpPacketHistory::EntryAt(
+    size_t packet_index) const {
+  RTC_DCHECK_LT(packet_index, history_size_);
+  return packet_history_[(history_begin_ + packet_index) &
+                         (packet_history_.size() - 1)];
+}
+
+void RtpPacketHistory::ReserveEntries(size_t num_entries) {
+  if (num_entries <= packet_history_.size()) {
+    return;
+  }
+  size_t capacity = std::max(packet_history_.size(), kMinHistoryCapacity);
+  while (capacity < num_entries) {
+    capacity *= 2;
+  }
+  std::vector<StoredPacket> packet_history(capacity);
+  for (size_t i = 0; i < history_size_; ++i) {
+    packet_history[i] = std::move(EntryAt(i));
+  }
+  packet_history_ = std::move(packet_history);
+  history_begin_ = 0;
+}
+
+void RtpPacketHistory::AddPaddingCandidate(StoredPacket& packet) {
+  RTC_DCHECK(!packet.in_padding_priority_);
+  const size_t bucket_index = packet.times_retransmitted();
+  if (bucket_index >= padding_buckets_.size()) {
+    padding_buckets_.resize(bucket_index + 1);
+  }
+  PaddingBucket& bucket = padding_buckets_[bucket_index];
+
+  // Find the position by insert order. New packets are the newest of the
+  // first bucket, and a retransmitted packet is typically older than the
+  // packets in its new bucket, so search from the oldest end.
+  int older = kNoPacket;
+  int newer = bucket.oldest;
+  while (newer != kNoPacket) {
+    const StoredPacket* newer_packet =
+        GetStoredPacket(static_cast<uint16_t>(newer));
+    if (newer_packet->insert_order() > packet.insert_order()) {
+      break;
+    }
+    older = newer;
+    newer = newer_packet->newer_padding_packet_;
+  }
+
+  const int sequence_number = packet.packet_->SequenceNumber();
+  packet.older_padding_packet_ = older;
+  packet.newer_padding_packet_ = newer;
+  if (older == kNoPacket) {
+    bucket.oldest = sequence_number;
+  } else {
+    GetStoredPacket(static_cast<uint16_t>(older))->newer_padding_packet_ =
+        sequence_number;
+  }
+  if (newer == kNoPacket) {
+    bucket.newest = sequence_number;
+  } else {
+    GetStoredPacket(static_cast<uint16_t>(newer))->older_padding_packet_ =
+        sequence_number;
+  }
+  packet.in_padding_priority_ = true;
+
+  if (num_padding_candidates_ == 0 || bucket_index < first_padding_bucket_) {
+    first_padding_bucket_ = bucket_index;
+  }
+  ++num_padding_candidates_;
+}
+
+void RtpPacketHistory::RemovePaddingCandidate(StoredPacket& packet) {
+  RTC_DCHECK(packet.in_padding_priority_);
+  const size_t bucket_index = packet.times_retransmitted();
+  PaddingBucket& bucket = padding_buckets_[bucket_index];
+  const int older = packet.older_padding_packet_;
+  const int newer = packet.newer_padding_packet_;
+  if (older == kNoPacket) {
+    bucket.oldest = newer;
+  } else {
+    GetStoredPacket(static_cast<uint16_t>(older))->newer_padding_packet_ =
+        newer;
+  }
+  if (newer == kNoPacket) {
+    bucket.newest = older;
+  } else {
+    GetStoredPacket(static_cast<uint16_t>(newer))->older_padding_packet_ =
+        older;
+  }
+  packet.in_padding_priority_ = false;
+  packet.older_padding_packet_ = kNoPacket;
+  packet.newer_padding_packet_ = kNoPacket;
+
+  --num_padding_candidates_;
+  while (!padding_buckets_.empty() &&
+         padding_buckets_.back().newest == kNoPacket) {
+    padding_buckets_.pop_back();
+  }
+  while (first_padding_bucket_ < padding_buckets_.size() &&
+         padding_buckets_[first_padding_bucket_].newest == kNoPacket) {
+    ++first_padding_bucket_;
+  }
+}
+
+void RtpPacketHistory::IncrementTimesRetransmitted(StoredPacket& packet) {
+  // The retransmission count selects the padding bucket, so move the packet
+  // to its new bucket if it is a candidate.
+  const bool in_padding_priority = packet.in_padding_priority_;
+  if (in_padding_priority) {
+    RemovePaddingCandidate(packet);
+  }
+  packet.IncrementTimesRetransmitted();
+  if (in_padding_priority) {
+    AddPaddingCandidate(packet);
+  }
+}
+
+const RtpPacketToSend* RtpPacketHistory::GetPaddingCandidate(
+    StoredPacket*& stored_packet) {
+  stored_packet = nullptr;
+  if (mode_ == StorageMode::kDisabled) {
     return nullptr;
   }
-  return &packet_history_[index];
+  if (padding_mode_ == PaddingMode::kRecentLargePacket &&
+      large_payload_packet_) {
+    return &*large_payload_packet_;
+  }
+
+  StoredPacket* best_packet = nullptr;
+  if (padding_priority_enabled() && num_padding_candidates_ > 0) {
+    best_packet = GetStoredPacket(static_cast<uint16_t>(
+        padding_buckets_[first_padding_bucket_].newest));
+  } else if (!padding_priority_enabled()) {
+    // Prioritization not available, pick the last packet.
+    for (size_t i = history_size_; i > 0; --i) {
+      if (EntryAt(i - 1).packet_ != nullptr) {
+        best_packet = &EntryAt(i - 1);
+        break;
+      }
+    }
+  }
+  if (best_packet == nullptr) {
+    return nullptr;
+  }
+
+  if (best_packet->pending_transmission_) {
+    // Because PacedSender releases it's lock when it calls
+    // GeneratePadding() there is the potential for a race where a new
+    // packet ends up here instead of the regular transmit path. In such a
+    // case, just return empty and it will be picked up on the next
+    // Process() call.
+    return nullptr;
+  }
+
+  stored_packet = best_packet;
+  return best_packet->packet_.get();
+}
+
+void RtpPacketHistory::MarkSentAsPadding(StoredPacket& packet, Timestamp now) {
+  packet.set_send_time(now);
+  IncrementTimesRetransmitted(packet);
 }
 
 bool RtpPacketHistory::padding_priority_enabled() const {
@@ -11,10 +11,7 @@
 #ifndef MODULES_RTP_RTCP_SOURCE_RTP_PACKET_HISTORY_H_
 #define MODULES_RTP_RTCP_SOURCE_RTP_PACKET_HISTORY_H_
 
-#include <deque>
-#include <map>
 #include <memory>
-#include <set>
 #include <utility>
 #include <vector>
 
@@ -122,6 +119,14 @@ class RtpPacketHistory {
       rtc::FunctionView<std::unique_ptr<RtpPacketToSend>(
           const RtpPacketToSend&)> encapsulate);
 
+  // Same as calling GetPayloadPaddingPacket() for as long as `select` accepts
+  // the packet it would return, but the lock is held once for all of them.
+  // The selected packets are returned as copies that share their buffers
+  // with the history, so that the caller can encapsulate them without
+  // holding up retransmissions.
+  std::vector<RtpPacketToSend> GetPayloadPaddingPackets(
+      rtc::FunctionView<bool(const RtpPacketToSend&)> select);
+
   // Cull packets that have been acknowledged as received by the remote end.
   void CullAcknowledgedPackets(rtc::ArrayView<const uint16_t> sequence_numbers);
 
@@ -129,10 +134,13 @@ class RtpPacketHistory {
   // capacity.
   void Clear();
 
+  // Returns the number of bytes held by the stored packets and the history
+  // itself.
+  size_t GetMemoryUsageBytes() const;
+
  private:
-  struct MoreUseful;
-  class StoredPacket;
-  using PacketPrioritySet = std::set<StoredPacket*, MoreUseful>;
+  // Marks the end of a list of packets linked by sequence number.
+  static constexpr int kNoPacket = -1;
 
   class StoredPacket {
    public:
@@ -146,7 +154,7 @@ class RtpPacketHistory {
 
     uint64_t insert_order() const { return insert_order_; }
     size_t times_retransmitted() const { return times_retransmitted_; }
-    void IncrementTimesRetransmitted(PacketPrioritySet* priority_set);
+    void IncrementTimesRetransmitted() { ++times_retransmitted_; }
 
     // The time of last transmission, including retransmissions.
     Timestamp send_time() const { return send_time_; }
@@ -156,20 +164,31 @@ class RtpPacketHistory {
     std::unique_ptr<RtpPacketToSend> packet_;
 
     // True if the packet is currently in the pacer queue pending transmission.
-    bool pending_transmission_;
+    bool pending_transmission_ = false;
+
+    // True if the packet is a padding candidate. Its neighbours among the
+    // candidates with the same retransmission count are then identified by
+    // sequence number, or kNoPacket.
+    bool in_padding_priority_ = false;
+    int newer_padding_packet_ = kNoPacket;
+    int older_padding_packet_ = kNoPacket;
 
    private:
     Timestamp send_time_ = Timestamp::Zero();
 
     // Unique number per StoredPacket, incremented by one for each added
     // packet. Used to sort on insert order.
-    uint64_t insert_order_;
+    uint64_t insert_order_ = 0;
 
     // Number of times RE-transmitted, ie excluding the first transmission.
-    size_t times_retransmitted_;
+    size_t times_retransmitted_ = 0;
   };
-  struct MoreUseful {
-    bool operator()(StoredPacket* lhs, StoredPacket* rhs) const;
+
+  // The padding candidates that have been retransmitted a given number of
+  // times, from newest to oldest.
+  struct PaddingBucket {
+    int newest = kNoPacket;
+    int oldest = kNoPacket;
   };
 
   bool padding_priority_enabled() const;
@@ -188,6 +207,28 @@ class RtpPacketHistory {
   StoredPacket* GetStoredPacket(uint16_t sequence_number)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
 
+  // Returns the entry at `packet_index` of `packet_history_`.
+  StoredPacket& EntryAt(size_t packet_index)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  const StoredPacket& EntryAt(size_t packet_index) const
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Makes room for at least `num_entries` entries without moving any.
+  void ReserveEntries(size_t num_entries) RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  void AddPaddingCandidate(StoredPacket& packet)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  void RemovePaddingCandidate(StoredPacket& packet)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  void IncrementTimesRetransmitted(StoredPacket& packet)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  // Returns the packet to send as payload padding, if any, and sets
+  // `stored_packet` to its entry, or to null for `large_payload_packet_`.
+  const RtpPacketToSend* GetPaddingCandidate(StoredPacket*& stored_packet)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  void MarkSentAsPadding(StoredPacket& packet, Timestamp now)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
   Clock* const clock_;
   const PaddingMode padding_mode_;
   mutable Mutex lock_;
@@ -195,19 +236,27 @@ class RtpPacketHistory {
   StorageMode mode_ RTC_GUARDED_BY(lock_);
   TimeDelta rtt_ RTC_GUARDED_BY(lock_);
 
-  // Queue of stored packets, ordered by sequence number, with older packets in
-  // the front and new packets being added to the back. Note that there may be
-  // wrap-arounds so the back may have a lower sequence number.
+  // Ring buffer of stored packets, ordered by sequence number, with older
+  // packets in the front and new packets being added to the back. Note that
+  // there may be wrap-arounds so the back may have a lower sequence number.
+  // The `history_size_` entries start at `history_begin_`, and the size of
+  // the ring is a power of two. Entries outside of that range are empty.
   // Packets may also be removed out-of-order, in which case there will be
-  // instances of StoredPacket with `packet_` set to nullptr. The first and last
-  // entry in the queue will however always be populated.
-  std::deque<StoredPacket> packet_history_ RTC_GUARDED_BY(lock_);
+  // entries with `packet_` set to nullptr. The first and last entry will
+  // however always be populated.
+  std::vector<StoredPacket> packet_history_ RTC_GUARDED_BY(lock_);
+  size_t history_begin_ RTC_GUARDED_BY(lock_) = 0;
+  size_t history_size_ RTC_GUARDED_BY(lock_) = 0;
 
   // Total number of packets with inserted.
   uint64_t packets_inserted_ RTC_GUARDED_BY(lock_);
-  // Objects from `packet_history_` ordered by "most likely to be useful", used
-  // in GetPayloadPaddingPacket().
-  PacketPrioritySet padding_priority_ RTC_GUARDED_BY(lock_);
+  // Packets of `packet_history_` used in GetPayloadPaddingPacket(), by number
+  // of retransmissions. The most useful candidate is the newest one that has
+  // been retransmitted the fewest times. The last bucket is never empty.
+  std::vector<PaddingBucket> padding_buckets_ RTC_GUARDED_BY(lock_);
+  size_t num_padding_candidates_ RTC_GUARDED_BY(lock_) = 0;
+  // Index of the first non-empty bucket, if there are any candidates.
+  size_t first_padding_bucket_ RTC_GUARDED_BY(lock_) = 0;
 
   absl::optional<RtpPacketToSend> large_payload_packet_ RTC_GUARDED_BY(lock_);
 };
@@ -125,6 +125,19 @@ TEST_P(RtpPacketHistoryTest, NoStoreStatus) {
   EXPECT_FALSE(hist_.GetPacketState(kStartSeqNum));
 }
 
+TEST_P(RtpPacketHistoryTest, MemoryUsageFollowsStoredPackets) {
+  hist_.SetStorePacketsStatus(StorageMode::kStoreAndCull, 10);
+  const size_t empty_usage = hist_.GetMemoryUsageBytes();
+  std::unique_ptr<RtpPacketToSend> packet = CreateRtpPacket(kStartSeqNum);
+  const size_t packet_capacity = packet->capacity();
+  hist_.PutRtpPacket(std::move(packet),
+                     /*send_time=*/fake_clock_.CurrentTime());
+  EXPECT_GE(hist_.GetMemoryUsageBytes(), empty_usage + packet_capacity);
+
+  hist_.Clear();
+  EXPECT_LT(hist_.GetMemoryUsageBytes(), packet_capacity);
+}
+
 TEST_P(RtpPacketHistoryTest, GetRtpPacket_NotStored) {
   hist_.SetStorePacketsStatus(StorageMode::kStoreAndCull, 10);
   EXPECT_FALSE(hist_.GetPacketState(0));
@@ -613,6 +626,32 @@ TEST_P(RtpPacketHistoryTest, PayloadPaddingWithEncapsulation) {
   EXPECT_EQ(padding_packet->SequenceNumber(), kStartSeqNum + 1);
 }
 
+TEST_P(RtpPacketHistoryTest, GetsPayloadPaddingPacketsInOneBatch) {
+  if (GetParam() != RtpPacketHistory::PaddingMode::kPriority) {
+    GTEST_SKIP() << "Padding prioritization required for this test";
+  }
+
+  hist_.SetStorePacketsStatus(StorageMode::kStoreAndCull, 2);
+  hist_.PutRtpPacket(CreateRtpPacket(kStartSeqNum), fake_clock_.CurrentTime());
+  hist_.PutRtpPacket(CreateRtpPacket(kStartSeqNum + 1),
+                     fake_clock_.CurrentTime());
+  fake_clock_.AdvanceTimeMilliseconds(1);
+
+  // Packets are selected in the order GetPayloadPaddingPacket() would return
+  // them, until the selection stops.
+  int num_selected = 0;
+  std::vector<RtpPacketToSend> padding_packets =
+      hist_.GetPayloadPaddingPackets(
+          [&](const RtpPacketToSend&) { return ++num_selected <= 3; });
+  ASSERT_EQ(padding_packets.size(), 3u);
+  EXPECT_EQ(padding_packets[0].SequenceNumber(), kStartSeqNum + 1);
+  EXPECT_EQ(padding_packets[1].SequenceNumber(), kStartSeqNum);
+  EXPECT_EQ(padding_packets[2].SequenceNumber(), kStartSeqNum + 1);
+
+  // The packet not selected was not marked as sent, so it is next in turn.
+  EXPECT_EQ(hist_.GetPayloadPaddingPacket()->SequenceNumber(), kStartSeqNum);
+}
+
 TEST_P(RtpPacketHistoryTest, NackAfterAckIsNoop) {
   hist_.SetStorePacketsStatus(StorageMode::kStoreAndCull, 2);
   // Add two sent packets.
@@ -651,6 +690,55 @@ TEST_P(RtpPacketHistoryTest, OutOfOrderInsertRemoval) {
   }
 }
 
+TEST_P(RtpPacketHistoryTest, KeepsPacketsWhenGrowingAfterFrontInsert) {
+  hist_.SetStorePacketsStatus(StorageMode::kStoreAndCull, 100);
+
+  // Insert older packets ahead of the first one, wrapping the ring buffer
+  // backwards, before it has to grow.
+  hist_.PutRtpPacket(CreateRtpPacket(kStartSeqNum), fake_clock_.CurrentTime());
+  for (int i = 1; i <= 5; ++i) {
+    hist_.PutRtpPacket(CreateRtpPacket(To16u(kStartSeqNum - i)),
+                       fake_clock_.CurrentTime());
+  }
+  for (int i = 1; i < 50; ++i) {
+    hist_.PutRtpPacket(CreateRtpPacket(To16u(kStartSeqNum + i)),
+                       fake_clock_.CurrentTime());
+  }
+
+  for (int i = -5; i < 50; ++i) {
+    EXPECT_TRUE(hist_.GetPacketState(To16u(kStartSeqNum + i)));
+  }
+  EXPECT_FALSE(hist_.GetPacketState(To16u(kStartSeqNum - 6)));
+  EXPECT_FALSE(hist_.GetPacketState(To16u(kStartSeqNum + 50)));
+}
+
+TEST_P(RtpPacketHistoryTest, RetransmittedPacketsAreLessUsefulPadding) {
+  if (GetParam() != RtpPacketHistory::PaddingMode::kPriority) {
+    GTEST_SKIP() << "Padding prioritization required for this test";
+  }
+
+  hist_.SetStorePacketsStatus(StorageMode::kStoreAndCull, 10);
+  for (int i = 0; i < 4; ++i) {
+    hist_.PutRtpPacket(CreateRtpPacket(To16u(kStartSeqNum + i)),
+                       fake_clock_.CurrentTime());
+    hist_.MarkPacketAsSent(To16u(kStartSeqNum + i));
+  }
+  fake_clock_.AdvanceTimeMilliseconds(1);
+
+  // Retransmit the two newest packets, e.g. as a response to a NACK.
+  for (int i : {3, 2}) {
+    ASSERT_TRUE(hist_.GetPacketAndMarkAsPending(To16u(kStartSeqNum + i)));
+    hist_.MarkPacketAsSent(To16u(kStartSeqNum + i));
+  }
+
+  // Packets not retransmitted go first, newest first, then the others in the
+  // same order.
+  for (int i : {1, 0, 3, 2, 1, 0}) {
+    EXPECT_EQ(hist_.GetPayloadPaddingPacket()->SequenceNumber(),
+              To16u(kStartSeqNum + i));
+  }
+}
+
 TEST_P(RtpPacketHistoryTest, UsesLastPacketAsPaddingWithPrioOff) {
   if (GetParam() != RtpPacketHistory::PaddingMode::kDefault) {
     GTEST_SKIP() << "Default padding prioritization required for this test";
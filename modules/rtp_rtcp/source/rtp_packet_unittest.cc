@@ -426,6 +426,38 @@ TEST(RtpPacketTest, CreatePurePadding) {
   EXPECT_EQ(packet.size(), packet.capacity());
 }
 
+TEST(RtpPacketTest, RemovePayloadPrefixKeepsHeaderAndExtensions) {
+  RtpPacketToSend::ExtensionManager extensions;
+  extensions.Register<TransmissionOffset>(kTransmissionOffsetExtensionId);
+  RtpPacketToSend packet(&extensions);
+  packet.SetPayloadType(kPayloadType);
+  packet.SetSequenceNumber(kSeqNum);
+  packet.SetTimestamp(kTimestamp);
+  packet.SetSsrc(kSsrc);
+  packet.SetExtension<TransmissionOffset>(kTimeOffset);
+  const uint8_t kPayload[] = {1, 2, 3, 4, 5};
+  memcpy(packet.AllocatePayload(sizeof(kPayload)), kPayload, sizeof(kPayload));
+  EXPECT_TRUE(packet.SetPadding(7));
+  const RtpPacketToSend original = packet;
+
+  packet.RemovePayloadPrefix(2);
+  EXPECT_THAT(packet.payload(), ElementsAre(3, 4, 5));
+  EXPECT_FALSE(packet.has_padding());
+  EXPECT_EQ(packet.padding_size(), 0u);
+  EXPECT_EQ(packet.headers_size(), original.headers_size());
+  EXPECT_EQ(packet.SequenceNumber(), kSeqNum);
+  EXPECT_EQ(packet.Ssrc(), kSsrc);
+  EXPECT_EQ(packet.GetExtension<TransmissionOffset>(), kTimeOffset);
+  // The original shared the buffer and is left intact.
+  EXPECT_THAT(original.payload(), ElementsAreArray(kPayload));
+  EXPECT_EQ(original.padding_size(), 7u);
+
+  // The result can still be modified.
+  packet.SetSsrc(kSsrc + 1);
+  EXPECT_EQ(packet.Ssrc(), kSsrc + 1);
+  EXPECT_THAT(packet.payload(), ElementsAre(3, 4, 5));
+}
+
 TEST(RtpPacketTest, CreateUnalignedPadding) {
   const size_t kPayloadSize = 3;  // Make padding start at unaligned address.
   RtpPacketToSend packet(nullptr, 12 + kPayloadSize + kMaxPaddingSize);
@@ -707,6 +739,55 @@ TEST(RtpPacketTest, ParseSecondPacketWithFewerExtensions) {
   EXPECT_FALSE(packet.HasExtension<AudioLevel>());
 }
 
+TEST(RtpPacketTest, ParseWithLazyExtensions) {
+  RtpPacketToSend::ExtensionManager extensions;
+  extensions.Register<TransmissionOffset>(kTransmissionOffsetExtensionId);
+  extensions.Register<AudioLevel>(kAudioLevelExtensionId);
+  RtpPacketReceived packet(&extensions);
+  EXPECT_TRUE(packet.Parse(
+      rtc::CopyOnWriteBuffer(kPacketWithTOAndAL, sizeof(kPacketWithTOAndAL)),
+      RtpPacket::ExtensionParsing::kLazy));
+  EXPECT_EQ(kSsrc, packet.Ssrc());
+  EXPECT_EQ(packet.size(), sizeof(kPacketWithTOAndAL));
+
+  // A copy made before the extensions are accessed indexes them on its own.
+  RtpPacketReceived copy = packet;
+  EXPECT_EQ(packet.GetExtension<TransmissionOffset>(), kTimeOffset);
+  bool voice_active;
+  uint8_t audio_level;
+  EXPECT_TRUE(packet.GetExtension<AudioLevel>(&voice_active, &audio_level));
+  EXPECT_EQ(kAudioLevel, audio_level);
+  EXPECT_TRUE(copy.HasExtension<AudioLevel>());
+  EXPECT_EQ(copy.GetExtension<TransmissionOffset>(), kTimeOffset);
+
+  // Second packet without audio level.
+  EXPECT_TRUE(packet.Parse(
+      rtc::CopyOnWriteBuffer(kPacketWithTO, sizeof(kPacketWithTO)),
+      RtpPacket::ExtensionParsing::kLazy));
+  EXPECT_TRUE(packet.HasExtension<TransmissionOffset>());
+  EXPECT_FALSE(packet.HasExtension<AudioLevel>());
+}
+
+TEST(RtpPacketTest, ModifiesLazilyParsedExtensions) {
+  RtpPacketToSend::ExtensionManager extensions;
+  extensions.Register<TransmissionOffset>(kTransmissionOffsetExtensionId);
+  extensions.Register<AudioLevel>(kAudioLevelExtensionId);
+  RtpPacketReceived packet(&extensions);
+  EXPECT_TRUE(packet.Parse(
+      rtc::CopyOnWriteBuffer(kPacketWithTO, sizeof(kPacketWithTO)),
+      RtpPacket::ExtensionParsing::kLazy));
+  // Rewriting an existing extension in place keeps the packet layout.
+  EXPECT_TRUE(packet.SetExtension<TransmissionOffset>(kTimeOffset + 1));
+  EXPECT_EQ(packet.GetExtension<TransmissionOffset>(), kTimeOffset + 1);
+  EXPECT_EQ(packet.size(), sizeof(kPacketWithTO));
+
+  EXPECT_TRUE(packet.Parse(
+      rtc::CopyOnWriteBuffer(kPacketWithTOAndAL, sizeof(kPacketWithTOAndAL)),
+      RtpPacket::ExtensionParsing::kLazy));
+  EXPECT_TRUE(packet.RemoveExtension(kRtpExtensionAudioLevel));
+  EXPECT_THAT(kPacketWithTO, ElementsAreArray(packet.data(), packet.size()));
+}
+
 TEST(RtpPacketTest, ParseWith2ExtensionsInvalidPadding) {
   RtpPacketToSend::ExtensionManager extensions;
   extensions.Register<TransmissionOffset>(kTransmissionOffsetExtensionId);
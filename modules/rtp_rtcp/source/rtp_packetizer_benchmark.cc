@@ -0,0 +1,153 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "api/video/video_codec_type.h"
+#include "api/video/video_frame_type.h"
+#include "benchmark/benchmark.h"
+#include "modules/rtp_rtcp/source/rtp_format.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "modules/rtp_rtcp/source/rtp_video_header.h"
+#include "modules/video_coding/codecs/h264/include/h264_globals.h"
+#include "modules/video_coding/codecs/vp8/include/vp8_globals.h"
+#include "modules/video_coding/codecs/vp9/include/vp9_globals.h"
+#include "rtc_base/system/unused.h"
+#include "test/benchmark_allocation_counter.h"
+
+namespace webrtc {
+namespace {
+
+constexpr uint8_t kPayloadByte = 0x5a;
+
+// An H.264 key frame in Annex B format: SPS, PPS and one IDR slice filling up
+// the rest of the `frame_size` bytes.
+std::vector<uint8_t> CreateH264Frame(size_t frame_size) {
+  std::vector<uint8_t> frame;
+  auto add_nalu = [&](uint8_t header, size_t size) {
+    frame.insert(frame.end(), {0, 0, 0, 1, header});
+    frame.insert(frame.end(), size - 1, kPayloadByte);
+  };
+  add_nalu(/*header=*/0x67, /*size=*/16);
+  add_nalu(/*header=*/0x68, /*size=*/4);
+  add_nalu(/*header=*/0x65, frame_size - frame.size() - 4);
+  return frame;
+}
+
+// An AV1 temporal unit with a single frame OBU with a size field.
+std::vector<uint8_t> CreateAv1Frame(size_t frame_size) {
+  std::vector<uint8_t> frame = {/*obu_type=OBU_FRAME, has_size_field=*/0x32};
+  size_t leb128_size = 1;
+  while (frame_size - 1 - leb128_size >= (size_t{1} << (7 * leb128_size)))
+    ++leb128_size;
+  size_t obu_size = frame_size - 1 - leb128_size;
+  do {
+    uint8_t byte = obu_size & 0x7f;
+    obu_size >>= 7;
+    frame.push_back(obu_size > 0 ? (byte | 0x80) : byte);
+  } while (obu_size > 0);
+  frame.resize(frame_size, kPayloadByte);
+  return frame;
+}
+
+RTPVideoHeader CreateVideoHeader(VideoCodecType codec) {
+  RTPVideoHeader header;
+  header.codec = codec;
+  header.frame_type = VideoFrameType::kVideoFrameKey;
+  header.is_last_frame_in_picture = true;
+  switch (codec) {
+    case kVideoCodecVP8: {
+      RTPVideoHeaderVP8 vp8;
+      vp8.InitRTPVideoHeaderVP8();
+      vp8.pictureId = 1;
+      header.video_type_header = vp8;
+      break;
+    }
+    case kVideoCodecVP9: {
+      RTPVideoHeaderVP9 vp9;
+      vp9.InitRTPVideoHeaderVP9();
+      vp9.picture_id = 1;
+      header.video_type_header = vp9;
+      break;
+    }
+    case kVideoCodecH264: {
+      RTPVideoHeaderH264 h264;
+      h264.packetization_mode = H264PacketizationMode::NonInterleaved;
+      header.video_type_header = h264;
+      break;
+    }
+    default:
+      break;
+  }
+  return header;
+}
+
+// Packetizes a key frame of `state.range(0)` bytes into packets with the
+// usual size limits for video.
+void PacketizeFrames(benchmark::State& state, VideoCodecType codec) {
+  const size_t frame_size = state.range(0);
+  std::vector<uint8_t> frame;
+  if (codec == kVideoCodecH264) {
+    frame = CreateH264Frame(frame_size);
+  } else if (codec == kVideoCodecAV1) {
+    frame = CreateAv1Frame(frame_size);
+  } else {
+    frame.assign(frame_size, kPayloadByte);
+  }
+  const RTPVideoHeader video_header = CreateVideoHeader(codec);
+  RtpPacketizer::PayloadSizeLimits limits;
+  limits.max_payload_len = 1200;
+  limits.last_packet_reduction_len = 20;
+  RtpPacketToSend packet(/*extensions=*/nullptr);
+  test::ScopedAllocationCounter allocations(state);
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    std::unique_ptr<RtpPacketizer> packetizer =
+        RtpPacketizer::Create(codec, frame, limits, video_header);
+    do {
+      // Packetizers fill the free capacity of the packet, so clear the
+      // payload of the previous one.
+      packet.SetPayloadSize(0);
+    } while (packetizer->NextPacket(&packet));
+    benchmark::DoNotOptimize(packet.data());
+  }
+  state.SetBytesProcessed(state.iterations() * frame_size);
+}
+
+void BM_PacketizeGeneric(benchmark::State& state) {
+  PacketizeFrames(state, kVideoCodecGeneric);
+}
+
+void BM_PacketizeVp8(benchmark::State& state) {
+  PacketizeFrames(state, kVideoCodecVP8);
+}
+
+void BM_PacketizeVp9(benchmark::State& state) {
+  PacketizeFrames(state, kVideoCodecVP9);
+}
+
+void BM_PacketizeH264(benchmark::State& state) {
+  PacketizeFrames(state, kVideoCodecH264);
+}
+
+void BM_PacketizeAv1(benchmark::State& state) {
+  PacketizeFrames(state, kVideoCodecAV1);
+}
+
+BENCHMARK(BM_PacketizeGeneric)->Arg(1000)->Arg(50000);
+BENCHMARK(BM_PacketizeVp8)->Arg(1000)->Arg(50000);
+BENCHMARK(BM_PacketizeVp9)->Arg(1000)->Arg(50000);
+BENCHMARK(BM_PacketizeH264)->Arg(1000)->Arg(50000);
+BENCHMARK(BM_PacketizeAv1)->Arg(1000)->Arg(50000);
+
+}  // namespace
+}  // namespace webrtc
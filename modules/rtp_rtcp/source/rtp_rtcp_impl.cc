@@ -648,6 +648,10 @@ RtpSendRates ModuleRtpRtcpImpl::GetSendRates() const {
   return rtp_sender_->packet_sender.GetSendRates();
 }
 
+size_t ModuleRtpRtcpImpl::GetPacketHistoryMemoryUsageBytes() const {
+  return rtp_sender_ ? rtp_sender_->packet_history.GetMemoryUsageBytes() : 0;
+}
+
 void ModuleRtpRtcpImpl::OnRequestSendReport() {
   SendRTCP(kRtcpSr);
 }
@@ -225,6 +225,8 @@ class ABSL_DEPRECATED("") ModuleRtpRtcpImpl
 
   RtpSendRates GetSendRates() const override;
 
+  size_t GetPacketHistoryMemoryUsageBytes() const override;
+
   void OnReceivedNack(
       const std::vector<uint16_t>& nack_sequence_numbers) override;
   void OnReceivedRtcpReportBlocks(
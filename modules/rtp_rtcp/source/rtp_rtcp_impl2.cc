@@ -659,6 +659,10 @@ RtpSendRates ModuleRtpRtcpImpl2::GetSendRates() const {
   return rtp_sender_->packet_sender.GetSendRates(clock_->CurrentTime());
 }
 
+size_t ModuleRtpRtcpImpl2::GetPacketHistoryMemoryUsageBytes() const {
+  return rtp_sender_ ? rtp_sender_->packet_history.GetMemoryUsageBytes() : 0;
+}
+
 void ModuleRtpRtcpImpl2::OnRequestSendReport() {
   SendRTCP(kRtcpSr);
 }
@@ -235,6 +235,8 @@ class ModuleRtpRtcpImpl2 final : public RtpRtcpInterface,
 
   RtpSendRates GetSendRates() const override;
 
+  size_t GetPacketHistoryMemoryUsageBytes() const override;
+
   void OnReceivedNack(
       const std::vector<uint16_t>& nack_sequence_numbers) override;
   void OnReceivedRtcpReportBlocks(
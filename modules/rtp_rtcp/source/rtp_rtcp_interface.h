@@ -297,6 +297,10 @@ class RtpRtcpInterface : public RtcpFeedbackSenderInterface {
   // Returns bitrate sent (post-pacing) per packet type.
   virtual RtpSendRates GetSendRates() const = 0;
 
+  // Returns the number of bytes held by the history of sent packets kept for
+  // retransmissions and padding.
+  virtual size_t GetPacketHistoryMemoryUsageBytes() const = 0;
+
   virtual RTPSender* RtpSender() = 0;
   virtual const RTPSender* RtpSender() const = 0;
 
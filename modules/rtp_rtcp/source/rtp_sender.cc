@@ -11,11 +11,13 @@
 #include "modules/rtp_rtcp/source/rtp_sender.h"
 
 #include <algorithm>
+#include <bitset>
 #include <limits>
 #include <memory>
 #include <string>
 #include <utility>
 
+#include "absl/algorithm/container.h"
 #include "absl/strings/match.h"
 #include "absl/strings/string_view.h"
 #include "api/array_view.h"
@@ -204,6 +206,8 @@ rtc::ArrayView<const RtpExtensionSize> RTPSender::AudioExtensionSizes() {
 void RTPSender::SetExtmapAllowMixed(bool extmap_allow_mixed) {
   MutexLock lock(&send_mutex_);
   rtp_header_extension_map_.SetExtmapAllowMixed(extmap_allow_mixed);
+  packet_template_.reset();
+  padding_packet_template_.reset();
 }
 
 bool RTPSender::RegisterRtpHeaderExtension(absl::string_view uri, int id) {
@@ -231,6 +235,7 @@ void RTPSender::SetMaxRtpPacketSize(size_t max_packet_size) {
   RTC_DCHECK_LE(max_packet_size, IP_PACKET_SIZE);
   MutexLock lock(&send_mutex_);
   max_packet_size_ = max_packet_size;
+  packet_template_.reset();
 }
 
 size_t RTPSender::MaxRtpPacketSize() const {
@@ -246,6 +251,7 @@ void RTPSender::SetRtxStatus(int mode) {
     return;
   }
   rtx_ = mode;
+  padding_packet_template_.reset();
 }
 
 int RTPSender::RtxStatus() const {
@@ -264,6 +270,7 @@ void RTPSender::SetRtxPayloadType(int payload_type,
   }
 
   rtx_payload_type_map_[associated_payload_type] = payload_type;
+  padding_packet_template_.reset();
 }
 
 int32_t RTPSender::ReSendPacket(uint16_t packet_id) {
@@ -363,33 +370,47 @@ std::vector<std::unique_ptr<RtpPacketToSend>> RTPSender::GeneratePadding(
     bool media_has_been_sent,
     bool can_send_padding_on_media_ssrc) {
   // This method does not actually send packets, it just generates
-  // them and puts them in the pacer queue. Since this should incur
-  // low overhead, keep the lock for the scope of the method in order
-  // to make the code more readable.
-
+  // them and puts them in the pacer queue.
   std::vector<std::unique_ptr<RtpPacketToSend>> padding_packets;
   size_t bytes_left = target_size_bytes;
   if (SupportsRtxPayloadPadding()) {
-    while (bytes_left >= kMinPayloadPaddingBytes) {
-      std::unique_ptr<RtpPacketToSend> packet =
-          packet_history_->GetPayloadPaddingPacket(
-              [&](const RtpPacketToSend& packet)
-                  -> std::unique_ptr<RtpPacketToSend> {
-                // Limit overshoot, generate <= `kMaxPaddingSizeFactor` *
-                // `target_size_bytes`.
-                const size_t max_overshoot_bytes = static_cast<size_t>(
-                    ((kMaxPaddingSizeFactor - 1.0) * target_size_bytes) + 0.5);
-                if (packet.payload_size() + kRtxHeaderSize >
-                    max_overshoot_bytes + bytes_left) {
-                  return nullptr;
-                }
-                return BuildRtxPacket(packet);
-              });
+    // The payload types that have an RTX payload type mapped to them, so
+    // that packets are only selected if BuildRtxPacket() can send them.
+    std::bitset<128> rtx_associated_payload_types;
+    {
+      MutexLock lock(&send_mutex_);
+      for (const auto& [associated_payload_type, rtx_payload_type] :
+           rtx_payload_type_map_) {
+        if (associated_payload_type >= 0) {
+          rtx_associated_payload_types.set(associated_payload_type);
+        }
+      }
+    }
+    // Limit overshoot, generate <= `kMaxPaddingSizeFactor` *
+    // `target_size_bytes`.
+    const size_t max_overshoot_bytes = static_cast<size_t>(
+        ((kMaxPaddingSizeFactor - 1.0) * target_size_bytes) + 0.5);
+    std::vector<RtpPacketToSend> media_packets =
+        packet_history_->GetPayloadPaddingPackets(
+            [&](const RtpPacketToSend& packet) {
+              const size_t rtx_payload_size =
+                  packet.payload_size() + kRtxHeaderSize;
+              if (bytes_left < kMinPayloadPaddingBytes ||
+                  rtx_payload_size > max_overshoot_bytes + bytes_left ||
+                  !rtx_associated_payload_types[packet.PayloadType()]) {
+                return false;
+              }
+              bytes_left -= std::min(bytes_left, rtx_payload_size);
+              return true;
+            });
+    // The payloads are copied into the RTX packets without the history
+    // locked, so that retransmissions don't wait for it.
+    for (const RtpPacketToSend& media_packet : media_packets) {
+      std::unique_ptr<RtpPacketToSend> packet = BuildRtxPacket(media_packet);
       if (!packet) {
-        break;
+        // Media sending was stopped meanwhile.
+        return {};
       }
-
-      bytes_left -= std::min(bytes_left, packet->payload_size());
       packet->set_packet_type(RtpPacketMediaType::kPadding);
       padding_packets.push_back(std::move(packet));
     }
@@ -416,43 +437,48 @@ std::vector<std::unique_ptr<RtpPacketToSend>> RTPSender::GeneratePadding(
     padding_bytes_in_packet = rtc::SafeMin(max_payload_size, kMaxPaddingLength);
   }
 
-  while (bytes_left > 0) {
-    auto padding_packet =
-        std::make_unique<RtpPacketToSend>(&rtp_header_extension_map_);
-    padding_packet->set_packet_type(RtpPacketMediaType::kPadding);
-    padding_packet->SetMarker(false);
+  if (bytes_left == 0) {
+    return padding_packets;
+  }
+  if (rtx_ == kRtxOff) {
+    if (!can_send_padding_on_media_ssrc) {
+      return padding_packets;
+    }
+  } else {
+    // Without abs-send-time or transport sequence number a media packet
+    // must be sent before padding so that the timestamps used for
+    // estimation are correct.
+    if (!media_has_been_sent &&
+        !(rtp_header_extension_map_.IsRegistered(AbsoluteSendTime::kId) ||
+          rtp_header_extension_map_.IsRegistered(
+              TransportSequenceNumber::kId))) {
+      return padding_packets;
+    }
+  }
+
+  if (!padding_packet_template_) {
+    RtpPacketToSend& padding_packet =
+        padding_packet_template_.emplace(&rtp_header_extension_map_);
+    padding_packet.set_packet_type(RtpPacketMediaType::kPadding);
+    padding_packet.SetMarker(false);
     if (rtx_ == kRtxOff) {
-      if (!can_send_padding_on_media_ssrc) {
-        break;
-      }
-      padding_packet->SetSsrc(ssrc_);
+      padding_packet.SetSsrc(ssrc_);
     } else {
-      // Without abs-send-time or transport sequence number a media packet
-      // must be sent before padding so that the timestamps used for
-      // estimation are correct.
-      if (!media_has_been_sent &&
-          !(rtp_header_extension_map_.IsRegistered(AbsoluteSendTime::kId) ||
-            rtp_header_extension_map_.IsRegistered(
-                TransportSequenceNumber::kId))) {
-        break;
-      }
-
       RTC_DCHECK(rtx_ssrc_);
       RTC_DCHECK(!rtx_payload_type_map_.empty());
-      padding_packet->SetSsrc(*rtx_ssrc_);
-      padding_packet->SetPayloadType(rtx_payload_type_map_.begin()->second);
-    }
-
-    if (rtp_header_extension_map_.IsRegistered(TransportSequenceNumber::kId)) {
-      padding_packet->ReserveExtension<TransportSequenceNumber>();
-    }
-    if (rtp_header_extension_map_.IsRegistered(TransmissionOffset::kId)) {
-      padding_packet->ReserveExtension<TransmissionOffset>();
-    }
-    if (rtp_header_extension_map_.IsRegistered(AbsoluteSendTime::kId)) {
-      padding_packet->ReserveExtension<AbsoluteSendTime>();
+      padding_packet.SetSsrc(*rtx_ssrc_);
+      padding_packet.SetPayloadType(rtx_payload_type_map_.begin()->second);
     }
+    // Reserve extensions, if registered.
+    padding_packet.ReserveExtension<TransportSequenceNumber>();
+    padding_packet.ReserveExtension<TransmissionOffset>();
+    padding_packet.ReserveExtension<AbsoluteSendTime>();
+  }
 
+  while (bytes_left > 0) {
+    // Copying the template shares its buffer until the padding is written.
+    auto padding_packet =
+        std::make_unique<RtpPacketToSend>(*padding_packet_template_);
     padding_packet->SetPadding(padding_bytes_in_packet);
     bytes_left -= std::min(bytes_left, padding_bytes_in_packet);
     padding_packets.push_back(std::move(padding_packet));
@@ -495,15 +521,22 @@ std::unique_ptr<RtpPacketToSend> RTPSender::AllocatePacket(
     max_num_csrcs_ = csrcs.size();
     UpdateHeaderSizes();
   }
-  auto packet = std::make_unique<RtpPacketToSend>(&rtp_header_extension_map_,
-                                                  max_packet_size_);
-  packet->SetSsrc(ssrc_);
-  packet->SetCsrcs(csrcs);
+  if (packet_template_ && absl::c_equal(csrcs, packet_template_csrcs_)) {
+    // Copying the template shares its buffer until the first write, which
+    // then copies just the header into a buffer of the same capacity.
+    return std::make_unique<RtpPacketToSend>(*packet_template_);
+  }
+
+  RtpPacketToSend& packet =
+      packet_template_.emplace(&rtp_header_extension_map_, max_packet_size_);
+  packet_template_csrcs_.assign(csrcs.begin(), csrcs.end());
+  packet.SetSsrc(ssrc_);
+  packet.SetCsrcs(csrcs);
 
   // Reserve extensions, if registered, RtpSender set in SendToNetwork.
-  packet->ReserveExtension<AbsoluteSendTime>();
-  packet->ReserveExtension<TransmissionOffset>();
-  packet->ReserveExtension<TransportSequenceNumber>();
+  packet.ReserveExtension<AbsoluteSendTime>();
+  packet.ReserveExtension<TransmissionOffset>();
+  packet.ReserveExtension<TransportSequenceNumber>();
 
   // BUNDLE requires that the receiver "bind" the received SSRC to the values
   // in the MID and/or (R)RID header extensions if present. Therefore, the
@@ -520,13 +553,13 @@ std::unique_ptr<RtpPacketToSend> RTPSender::AllocatePacket(
   if (always_send_mid_and_rid_ || !ssrc_has_acked_) {
     // These are no-ops if the corresponding header extension is not registered.
     if (!mid_.empty()) {
-      packet->SetExtension<RtpMid>(mid_);
+      packet.SetExtension<RtpMid>(mid_);
     }
     if (!rid_.empty()) {
-      packet->SetExtension<RtpStreamId>(rid_);
+      packet.SetExtension<RtpStreamId>(rid_);
     }
   }
-  return packet;
+  return std::make_unique<RtpPacketToSend>(packet);
 }
 
 size_t RTPSender::RtxPacketOverhead() const {
@@ -743,6 +776,10 @@ RtpState RTPSender::GetRtxRtpState() const {
 }
 
 void RTPSender::UpdateHeaderSizes() {
+  // Whatever changed the header sizes also changes the headers to allocate.
+  packet_template_.reset();
+  padding_packet_template_.reset();
+
   const size_t rtp_header_length =
       kRtpHeaderLength + sizeof(uint32_t) * max_num_csrcs_;
 
@@ -201,6 +201,15 @@ class RTPSender {
   bool rtx_ssrc_has_acked_ RTC_GUARDED_BY(send_mutex_);
   // Maximum number of csrcs this sender is used with.
   size_t max_num_csrcs_ RTC_GUARDED_BY(send_mutex_) = 0;
+  // Header with the reserved extensions of the packets returned by
+  // AllocatePacket(), for `packet_template_csrcs_`. Built on first use after
+  // anything changes what goes into the header.
+  absl::optional<RtpPacketToSend> packet_template_ RTC_GUARDED_BY(send_mutex_);
+  std::vector<uint32_t> packet_template_csrcs_ RTC_GUARDED_BY(send_mutex_);
+  // Header of the padding-only packets returned by GeneratePadding(), built
+  // on first use after anything changes what goes into it.
+  absl::optional<RtpPacketToSend> padding_packet_template_
+      RTC_GUARDED_BY(send_mutex_);
   int rtx_ RTC_GUARDED_BY(send_mutex_);
   // Mapping rtx_payload_type_map_[associated] = rtx.
   std::map<int8_t, int8_t> rtx_payload_type_map_ RTC_GUARDED_BY(send_mutex_);
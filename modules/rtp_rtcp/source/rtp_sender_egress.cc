@@ -228,8 +228,24 @@ void RtpSenderEgress::SendPacket(std::unique_ptr<RtpPacketToSend> packet,
 
 void RtpSenderEgress::OnBatchComplete() {
   RTC_DCHECK_RUN_ON(worker_queue_);
-  for (auto& packet : packets_to_send_) {
-    CompleteSendPacket(packet, &packet == &packets_to_send_.back());
+  if (packets_to_send_.empty()) {
+    return;
+  }
+  std::vector<Transport::BatchedRtpPacket> batch;
+  batch.reserve(packets_to_send_.size());
+  for (const Packet& packet : packets_to_send_) {
+    Transport::BatchedRtpPacket& batched = batch.emplace_back();
+    batched.packet = packet.rtp_packet->Buffer();
+    batched.options =
+        PrepareToSend(packet, &packet == &packets_to_send_.back());
+  }
+  if (transport_) {
+    transport_->SendRtpBatch(batch);
+  }
+  for (size_t i = 0; i < packets_to_send_.size(); ++i) {
+    const Packet& packet = packets_to_send_[i];
+    OnPacketSent(packet, OnSentToNetwork(*packet.rtp_packet, packet.info,
+                                         batch[i].sent));
   }
   packets_to_send_.clear();
 }
@@ -237,6 +253,15 @@ void RtpSenderEgress::OnBatchComplete() {
 void RtpSenderEgress::CompleteSendPacket(const Packet& compound_packet,
                                          bool last_in_batch) {
   RTC_DCHECK_RUN_ON(worker_queue_);
+  PacketOptions options = PrepareToSend(compound_packet, last_in_batch);
+  OnPacketSent(compound_packet,
+               SendPacketToNetwork(*compound_packet.rtp_packet, options,
+                                   compound_packet.info));
+}
+
+PacketOptions RtpSenderEgress::PrepareToSend(const Packet& compound_packet,
+                                             bool last_in_batch) {
+  RTC_DCHECK_RUN_ON(worker_queue_);
   auto& [packet, pacing_info, now] = compound_packet;
   RTC_CHECK(packet);
   const bool is_media = packet->packet_type() == RtpPacketMediaType::kAudio ||
@@ -267,7 +292,15 @@ void RtpSenderEgress::CompleteSendPacket(const Packet& compound_packet,
   }
   options.batchable = enable_send_packet_batching_ && !is_audio_;
   options.last_packet_in_batch = last_in_batch;
-  const bool send_success = SendPacketToNetwork(*packet, options, pacing_info);
+  return options;
+}
+
+void RtpSenderEgress::OnPacketSent(const Packet& compound_packet,
+                                   bool send_success) {
+  RTC_DCHECK_RUN_ON(worker_queue_);
+  auto& [packet, pacing_info, now] = compound_packet;
+  const bool is_media = packet->packet_type() == RtpPacketMediaType::kAudio ||
+                        packet->packet_type() == RtpPacketMediaType::kVideo;
 
   // Put packet in retransmission history or update pending status even if
   // actual sending fails.
@@ -441,21 +474,25 @@ bool RtpSenderEgress::SendPacketToNetwork(const RtpPacketToSend& packet,
                                           const PacketOptions& options,
                                           const PacedPacketInfo& pacing_info) {
   RTC_DCHECK_RUN_ON(worker_queue_);
-  int bytes_sent = -1;
+  bool sent = false;
   if (transport_) {
-    bytes_sent = transport_->SendRtp(packet, options)
-                     ? static_cast<int>(packet.size())
-                     : -1;
-    if (event_log_ && bytes_sent > 0) {
-      event_log_->Log(std::make_unique<RtcEventRtpPacketOutgoing>(
-          packet, pacing_info.probe_cluster_id));
-    }
+    sent = transport_->SendRtpBuffer(packet.Buffer(), options);
   }
+  return OnSentToNetwork(packet, pacing_info, sent);
+}
 
-  if (bytes_sent <= 0) {
+bool RtpSenderEgress::OnSentToNetwork(const RtpPacketToSend& packet,
+                                      const PacedPacketInfo& pacing_info,
+                                      bool sent) {
+  RTC_DCHECK_RUN_ON(worker_queue_);
+  if (!sent || packet.size() == 0) {
     RTC_LOG(LS_WARNING) << "Transport failed to send packet.";
     return false;
   }
+  if (event_log_) {
+    event_log_->Log(std::make_unique<RtcEventRtpPacketOutgoing>(
+        packet, pacing_info.probe_cluster_id));
+  }
   return true;
 }
 
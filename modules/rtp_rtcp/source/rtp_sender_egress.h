@@ -109,6 +109,12 @@ class RtpSenderEgress {
     Timestamp now;
   };
   void CompleteSendPacket(const Packet& compound_packet, bool last_in_batch);
+  // Notifies observers that `compound_packet` is about to be sent, and returns
+  // the options it should be sent with.
+  PacketOptions PrepareToSend(const Packet& compound_packet,
+                              bool last_in_batch);
+  // Stores the packet for retransmission and updates the send statistics.
+  void OnPacketSent(const Packet& compound_packet, bool send_success);
   bool HasCorrectSsrc(const RtpPacketToSend& packet) const;
   void AddPacketToTransportFeedback(uint16_t packet_id,
                                     const RtpPacketToSend& packet,
@@ -118,6 +124,11 @@ class RtpSenderEgress {
   bool SendPacketToNetwork(const RtpPacketToSend& packet,
                            const PacketOptions& options,
                            const PacedPacketInfo& pacing_info);
+  // Logs the outcome of handing `packet` to `transport_` and returns whether
+  // it was sent.
+  bool OnSentToNetwork(const RtpPacketToSend& packet,
+                       const PacedPacketInfo& pacing_info,
+                       bool sent);
   void UpdateRtpStats(Timestamp now,
                       uint32_t packet_ssrc,
                       RtpPacketMediaType packet_type,
@@ -11,6 +11,7 @@
 #include "modules/rtp_rtcp/source/rtp_sender_egress.h"
 
 #include <string>
+#include <vector>
 
 #include "absl/types/optional.h"
 #include "api/array_view.h"
@@ -36,6 +37,7 @@ namespace {
 
 using ::testing::_;
 using ::testing::AllOf;
+using ::testing::ElementsAre;
 using ::testing::Eq;
 using ::testing::Field;
 using ::testing::InSequence;
@@ -245,6 +247,70 @@ TEST_F(RtpSenderEgressTest, CollectsPacketsWhenBatchingWithVideo) {
   sender->OnBatchComplete();
 }
 
+TEST_F(RtpSenderEgressTest, SharesPacketBufferWithTransport) {
+  class BufferTransport : public Transport {
+   public:
+    bool SendRtp(rtc::ArrayView<const uint8_t> packet,
+                 const PacketOptions& options) override {
+      RTC_CHECK_NOTREACHED();
+    }
+    bool SendRtpBuffer(rtc::CopyOnWriteBuffer packet,
+                       const PacketOptions& options) override {
+      sent_buffer = std::move(packet);
+      return true;
+    }
+    bool SendRtcp(rtc::ArrayView<const uint8_t>) override {
+      RTC_CHECK_NOTREACHED();
+    }
+    rtc::CopyOnWriteBuffer sent_buffer;
+  } buffer_transport;
+  auto config = DefaultConfig();
+  config.outgoing_transport = &buffer_transport;
+  auto sender = std::make_unique<RtpSenderEgress>(config, &packet_history_);
+
+  std::unique_ptr<RtpPacketToSend> packet = BuildRtpPacket();
+  packet->AllocatePayload(100);
+  const uint8_t* packet_data = packet->data();
+  const size_t packet_size = packet->size();
+  sender->SendPacket(std::move(packet), PacedPacketInfo());
+
+  EXPECT_EQ(buffer_transport.sent_buffer.cdata(), packet_data);
+  EXPECT_EQ(buffer_transport.sent_buffer.size(), packet_size);
+}
+
+TEST_F(RtpSenderEgressTest, HandsCollectedBatchToTransportInOneCall) {
+  class BatchTransport : public Transport {
+   public:
+    bool SendRtp(rtc::ArrayView<const uint8_t> packet,
+                 const PacketOptions& options) override {
+      RTC_CHECK_NOTREACHED();
+    }
+    void SendRtpBatch(rtc::ArrayView<BatchedRtpPacket> packets) override {
+      batch_sizes.push_back(packets.size());
+      for (BatchedRtpPacket& packet : packets) {
+        packet.sent = true;
+      }
+    }
+    bool SendRtcp(rtc::ArrayView<const uint8_t>) override {
+      RTC_CHECK_NOTREACHED();
+    }
+    std::vector<size_t> batch_sizes;
+  } batch_transport;
+  auto config = DefaultConfig();
+  config.outgoing_transport = &batch_transport;
+  config.enable_send_packet_batching = true;
+  auto sender = std::make_unique<RtpSenderEgress>(config, &packet_history_);
+
+  EXPECT_CALL(mock_rtp_stats_callback_, DataCountersUpdated).Times(3);
+  sender->SendPacket(BuildRtpPacket(), PacedPacketInfo());
+  sender->SendPacket(BuildRtpPacket(), PacedPacketInfo());
+  sender->SendPacket(BuildRtpPacket(), PacedPacketInfo());
+  sender->OnBatchComplete();
+  sender->OnBatchComplete();
+
+  EXPECT_THAT(batch_transport.batch_sizes, ElementsAre(3u));
+}
+
 TEST_F(RtpSenderEgressTest, PacketOptionsIsRetransmitSetByPacketType) {
   std::unique_ptr<RtpSenderEgress> sender = CreateRtpSenderEgress();
 
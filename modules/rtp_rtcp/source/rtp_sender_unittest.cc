@@ -309,6 +309,30 @@ TEST_F(RtpSenderTest, AllocatePacketReserveExtensions) {
   EXPECT_FALSE(packet->HasExtension<VideoOrientation>());
 }
 
+TEST_F(RtpSenderTest, AllocatesIndependentPacketsWithUpToDateHeaders) {
+  ASSERT_TRUE(rtp_sender_->RegisterRtpHeaderExtension(
+      TransportSequenceNumber::Uri(), kTransportSequenceNumberExtensionId));
+  uint32_t csrcs[] = {0x23456789};
+
+  auto first_packet = rtp_sender_->AllocatePacket(csrcs);
+  auto second_packet = rtp_sender_->AllocatePacket(csrcs);
+  ASSERT_TRUE(first_packet && second_packet);
+  EXPECT_TRUE(second_packet->HasExtension<TransportSequenceNumber>());
+  EXPECT_THAT(second_packet->Csrcs(), ElementsAreArray(csrcs));
+  first_packet->SetSequenceNumber(1);
+  second_packet->SetSequenceNumber(2);
+  EXPECT_EQ(first_packet->SequenceNumber(), 1);
+  EXPECT_EQ(second_packet->SequenceNumber(), 2);
+
+  // Changes to the registered extensions and CSRCs apply to packets allocated
+  // after them.
+  rtp_sender_->DeregisterRtpHeaderExtension(TransportSequenceNumber::Uri());
+  auto packet = rtp_sender_->AllocatePacket(csrcs);
+  EXPECT_FALSE(packet->HasExtension<TransportSequenceNumber>());
+  packet = rtp_sender_->AllocatePacket();
+  EXPECT_THAT(packet->Csrcs(), IsEmpty());
+}
+
 TEST_F(RtpSenderTest, PaddingAlwaysAllowedOnAudio) {
   RtpRtcpInterface::Configuration config = GetDefaultConfig();
   config.audio = true;
@@ -1212,6 +1236,34 @@ TEST_F(RtpSenderTest, GeneratePaddingCreatesPurePaddingWithoutRtx) {
             kExpectedNumPaddingPackets * kMaxPaddingLength);
 }
 
+TEST_F(RtpSenderTest, GeneratedPaddingFollowsConfigurationChanges) {
+  // Send a dummy video packet, so that padding may be sent on the media SSRC.
+  std::unique_ptr<RtpPacketToSend> packet =
+      BuildRtpPacket(kPayload, true, 0, clock_->CurrentTime());
+  packet->set_packet_type(RtpPacketMediaType::kVideo);
+  sequencer_->Sequence(*packet);
+
+  std::vector<std::unique_ptr<RtpPacketToSend>> padding_packets =
+      GeneratePadding(/*target_size_bytes=*/1);
+  ASSERT_THAT(padding_packets, SizeIs(1));
+  EXPECT_EQ(padding_packets[0]->Ssrc(), kSsrc);
+  EXPECT_FALSE(padding_packets[0]->HasExtension<TransportSequenceNumber>());
+
+  ASSERT_TRUE(rtp_sender_->RegisterRtpHeaderExtension(
+      TransportSequenceNumber::Uri(), kTransportSequenceNumberExtensionId));
+  padding_packets = GeneratePadding(/*target_size_bytes=*/1);
+  ASSERT_THAT(padding_packets, SizeIs(1));
+  EXPECT_EQ(padding_packets[0]->Ssrc(), kSsrc);
+  EXPECT_TRUE(padding_packets[0]->HasExtension<TransportSequenceNumber>());
+
+  EnableRtx();
+  padding_packets = GeneratePadding(/*target_size_bytes=*/1);
+  ASSERT_THAT(padding_packets, SizeIs(1));
+  EXPECT_EQ(padding_packets[0]->Ssrc(), kRtxSsrc);
+  EXPECT_EQ(padding_packets[0]->PayloadType(), kRtxPayload);
+  EXPECT_TRUE(padding_packets[0]->HasExtension<TransportSequenceNumber>());
+}
+
 TEST_F(RtpSenderTest, SupportsPadding) {
   bool kSendingMediaStats[] = {true, false};
   bool kEnableRedundantPayloads[] = {true, false};
@@ -64,6 +64,19 @@ class TransformableVideoSenderFrame : public TransformableVideoFrameInterface {
 
   void SetData(rtc::ArrayView<const uint8_t> data) override {
     encoded_data_ = EncodedImageBuffer::Create(data.data(), data.size());
+    owns_encoded_data_ = true;
+  }
+
+  rtc::ArrayView<uint8_t> GetMutableData() override {
+    // The encoded image buffer may still be referenced by other consumers of
+    // the encoder output, copy it once before handing out a writable view.
+    if (!owns_encoded_data_) {
+      encoded_data_ = EncodedImageBuffer::Create(encoded_data_->data(),
+                                                 encoded_data_->size());
+      owns_encoded_data_ = true;
+    }
+    return rtc::ArrayView<uint8_t>(encoded_data_->data(),
+                                   encoded_data_->size());
   }
 
   size_t GetPreTransformPayloadSize() const {
@@ -115,6 +128,7 @@ class TransformableVideoSenderFrame : public TransformableVideoFrameInterface {
 
  private:
   rtc::scoped_refptr<EncodedImageBufferInterface> encoded_data_;
+  bool owns_encoded_data_ = false;
   const size_t pre_transform_payload_size_;
   RTPVideoHeader header_;
   const VideoFrameType frame_type_;
@@ -138,6 +152,7 @@ RTPSenderVideoFrameTransformerDelegate::RTPSenderVideoFrameTransformerDelegate(
     : sender_(sender),
       frame_transformer_(std::move(frame_transformer)),
       ssrc_(ssrc),
+      transforms_synchronously_(frame_transformer_->TransformsSynchronously()),
       transformation_queue_(task_queue_factory->CreateTaskQueue(
           "video_frame_transformer",
           TaskQueueFactory::Priority::NORMAL)) {}
@@ -179,6 +194,11 @@ void RTPSenderVideoFrameTransformerDelegate::OnTransformedFrame(
   if (!sender_) {
     return;
   }
+  if (transforms_synchronously_) {
+    // Called from within TransformFrame(), send without a thread hop.
+    SendVideoLocked(std::move(frame));
+    return;
+  }
   rtc::scoped_refptr<RTPSenderVideoFrameTransformerDelegate> delegate(this);
   transformation_queue_->PostTask(
       [delegate = std::move(delegate), frame = std::move(frame)]() mutable {
@@ -198,6 +218,11 @@ void RTPSenderVideoFrameTransformerDelegate::SendVideo(
   MutexLock lock(&sender_lock_);
   if (!sender_)
     return;
+  SendVideoLocked(std::move(transformed_frame));
+}
+
+void RTPSenderVideoFrameTransformerDelegate::SendVideoLocked(
+    std::unique_ptr<TransformableFrameInterface> transformed_frame) const {
   if (transformed_frame->GetDirection() ==
       TransformableFrameInterface::Direction::kSender) {
     auto* transformed_video_frame =
@@ -71,7 +71,8 @@ class RTPSenderVideoFrameTransformerDelegate : public TransformedFrameCallback {
                       TimeDelta expected_retransmission_time);
 
   // Implements TransformedFrameCallback. Can be called on any thread. Posts
-  // the transformed frame to be sent on the `encoder_queue_`.
+  // the transformed frame to be sent on the `encoder_queue_`, or sends it
+  // directly if the transformer transforms synchronously.
   void OnTransformedFrame(
       std::unique_ptr<TransformableFrameInterface> frame) override;
 
@@ -102,10 +103,14 @@ class RTPSenderVideoFrameTransformerDelegate : public TransformedFrameCallback {
  private:
   void EnsureEncoderQueueCreated();
 
+  void SendVideoLocked(std::unique_ptr<TransformableFrameInterface> frame) const
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(sender_lock_);
+
   mutable Mutex sender_lock_;
   RTPVideoFrameSenderInterface* sender_ RTC_GUARDED_BY(sender_lock_);
   rtc::scoped_refptr<FrameTransformerInterface> frame_transformer_;
   const uint32_t ssrc_;
+  const bool transforms_synchronously_;
   // Used when the encoded frames arrives without a current task queue. This can
   // happen if a hardware encoder was used.
   std::unique_ptr<TaskQueueBase, TaskQueueDeleter> transformation_queue_;
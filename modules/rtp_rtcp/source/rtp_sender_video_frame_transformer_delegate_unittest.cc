@@ -313,5 +313,66 @@ TEST_F(RtpSenderVideoFrameTransformerDelegateTest,
       /*expected_retransmission_time=*/TimeDelta::Millis(10));
 }
 
+TEST_F(RtpSenderVideoFrameTransformerDelegateTest,
+       SynchronousTransformerSendsWithoutThreadHop) {
+  EXPECT_CALL(*frame_transformer_, TransformsSynchronously)
+      .WillRepeatedly(Return(true));
+  auto delegate = rtc::make_ref_counted<RTPSenderVideoFrameTransformerDelegate>(
+      &test_sender_, frame_transformer_,
+      /*ssrc=*/1111, time_controller_.CreateTaskQueueFactory().get());
+  rtc::scoped_refptr<TransformedFrameCallback> callback;
+  EXPECT_CALL(*frame_transformer_, RegisterTransformedFrameSinkCallback)
+      .WillOnce(SaveArg<0>(&callback));
+  delegate->Init();
+  ASSERT_TRUE(callback);
+
+  EXPECT_CALL(*frame_transformer_, Transform)
+      .WillOnce([&](std::unique_ptr<TransformableFrameInterface> frame) {
+        callback->OnTransformedFrame(std::move(frame));
+      });
+  // Sent before TransformFrame() returns.
+  EXPECT_CALL(test_sender_, SendVideo).WillOnce(Return(true));
+
+  EncodedImage encoded_image;
+  encoded_image.SetEncodedData(EncodedImageBuffer::Create(1));
+  delegate->TransformFrame(
+      /*payload_type=*/1, VideoCodecType::kVideoCodecVP8, /*rtp_timestamp=*/2,
+      encoded_image, RTPVideoHeader(),
+      /*expected_retransmission_time=*/TimeDelta::Millis(10));
+  ::testing::Mock::VerifyAndClearExpectations(&test_sender_);
+}
+
+TEST_F(RtpSenderVideoFrameTransformerDelegateTest,
+       MutableDataLeavesEncodedImageUnchanged) {
+  auto delegate = rtc::make_ref_counted<RTPSenderVideoFrameTransformerDelegate>(
+      &test_sender_, frame_transformer_,
+      /*ssrc=*/1111, time_controller_.CreateTaskQueueFactory().get());
+
+  const uint8_t payload[] = {1, 2, 3};
+  EncodedImage encoded_image;
+  encoded_image.SetEncodedData(
+      EncodedImageBuffer::Create(payload, sizeof(payload)));
+  std::unique_ptr<TransformableFrameInterface> frame;
+  EXPECT_CALL(*frame_transformer_, Transform)
+      .WillOnce([&](std::unique_ptr<TransformableFrameInterface>
+                        frame_to_transform) {
+        frame = std::move(frame_to_transform);
+      });
+  delegate->TransformFrame(
+      /*payload_type=*/1, VideoCodecType::kVideoCodecVP8, /*rtp_timestamp=*/2,
+      encoded_image, RTPVideoHeader(),
+      /*expected_retransmission_time=*/TimeDelta::Millis(10));
+  ASSERT_TRUE(frame);
+
+  rtc::ArrayView<uint8_t> data = frame->GetMutableData();
+  ASSERT_EQ(data.size(), sizeof(payload));
+  for (uint8_t& byte : data)
+    byte ^= 0xff;
+  // Writes through the view land in the frame, without calling SetData().
+  EXPECT_EQ(frame->GetMutableData().data(), data.data());
+  EXPECT_EQ(frame->GetData()[0], 0xfe);
+  EXPECT_EQ(encoded_image.data()[0], 1);
+}
+
 }  // namespace
 }  // namespace webrtc
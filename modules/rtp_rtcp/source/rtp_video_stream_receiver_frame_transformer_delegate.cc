@@ -47,6 +47,14 @@ class TransformableVideoReceiverFrame
         EncodedImageBuffer::Create(data.data(), data.size()));
   }
 
+  // The frame assembled from the received packets is the only owner of its
+  // encoded data, which can be modified in place.
+  rtc::ArrayView<uint8_t> GetMutableData() override {
+    rtc::scoped_refptr<EncodedImageBufferInterface> data =
+        frame_->GetEncodedData();
+    return rtc::ArrayView<uint8_t>(data->data(), data->size());
+  }
+
   uint8_t GetPayloadType() const override { return frame_->PayloadType(); }
   uint32_t GetSsrc() const override { return Metadata().GetSsrc(); }
   uint32_t GetTimestamp() const override { return frame_->RtpTimestamp(); }
@@ -102,7 +110,9 @@ RtpVideoStreamReceiverFrameTransformerDelegate::
       frame_transformer_(std::move(frame_transformer)),
       network_thread_(network_thread),
       ssrc_(ssrc),
-      clock_(clock) {}
+      clock_(clock),
+      transforms_synchronously_(
+          frame_transformer_->TransformsSynchronously()) {}
 
 void RtpVideoStreamReceiverFrameTransformerDelegate::Init() {
   RTC_DCHECK_RUN_ON(&network_sequence_checker_);
@@ -132,6 +142,12 @@ void RtpVideoStreamReceiverFrameTransformerDelegate::TransformFrame(
 
 void RtpVideoStreamReceiverFrameTransformerDelegate::OnTransformedFrame(
     std::unique_ptr<TransformableFrameInterface> frame) {
+  if (transforms_synchronously_ && network_thread_->IsCurrent()) {
+    // Called from within TransformFrame(), hand the frame back without a
+    // thread hop.
+    ManageFrame(std::move(frame));
+    return;
+  }
   rtc::scoped_refptr<RtpVideoStreamReceiverFrameTransformerDelegate> delegate(
       this);
   network_thread_->PostTask(
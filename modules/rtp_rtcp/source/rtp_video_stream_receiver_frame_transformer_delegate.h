@@ -51,7 +51,8 @@ class RtpVideoStreamReceiverFrameTransformerDelegate
   void TransformFrame(std::unique_ptr<RtpFrameObject> frame);
 
   // Implements TransformedFrameCallback. Can be called on any thread. Posts
-  // the transformed frame to be managed on the `network_thread_`.
+  // the transformed frame to be managed on the `network_thread_`, unless it's
+  // called there by a transformer that transforms synchronously.
   void OnTransformedFrame(
       std::unique_ptr<TransformableFrameInterface> frame) override;
 
@@ -74,6 +75,7 @@ class RtpVideoStreamReceiverFrameTransformerDelegate
   rtc::Thread* const network_thread_;
   const uint32_t ssrc_;
   Clock* const clock_;
+  const bool transforms_synchronously_;
   bool short_circuit_ RTC_GUARDED_BY(network_sequence_checker_) = false;
 };
 
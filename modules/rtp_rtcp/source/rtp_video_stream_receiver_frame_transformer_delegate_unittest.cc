@@ -372,5 +372,49 @@ TEST(RtpVideoStreamReceiverFrameTransformerDelegateTest,
   delegate->TransformFrame(CreateRtpFrameObject());
 }
 
+TEST(RtpVideoStreamReceiverFrameTransformerDelegateTest,
+     SynchronousTransformerTransformsInPlaceWithoutThreadHop) {
+  rtc::AutoThread main_thread_;
+  TestRtpVideoFrameReceiver receiver;
+  auto mock_frame_transformer =
+      rtc::make_ref_counted<NiceMock<MockFrameTransformer>>();
+  ON_CALL(*mock_frame_transformer, TransformsSynchronously)
+      .WillByDefault(Return(true));
+  SimulatedClock clock(0);
+  auto delegate =
+      rtc::make_ref_counted<RtpVideoStreamReceiverFrameTransformerDelegate>(
+          &receiver, &clock, mock_frame_transformer, rtc::Thread::Current(),
+          1111);
+  rtc::scoped_refptr<TransformedFrameCallback> callback;
+  EXPECT_CALL(*mock_frame_transformer, RegisterTransformedFrameSinkCallback)
+      .WillOnce(SaveArg<0>(&callback));
+  delegate->Init();
+  ASSERT_TRUE(callback);
+
+  const uint8_t payload[] = {1, 2, 3};
+  std::unique_ptr<RtpFrameObject> frame = CreateRtpFrameObject();
+  frame->SetEncodedData(EncodedImageBuffer::Create(payload, sizeof(payload)));
+  const uint8_t* received_data = frame->data();
+
+  ON_CALL(*mock_frame_transformer, Transform)
+      .WillByDefault(
+          [&](std::unique_ptr<TransformableFrameInterface> transformable) {
+            rtc::ArrayView<uint8_t> data = transformable->GetMutableData();
+            ASSERT_EQ(data.size(), sizeof(payload));
+            for (uint8_t& byte : data)
+              byte ^= 0xff;
+            callback->OnTransformedFrame(std::move(transformable));
+          });
+  // Managed before TransformFrame() returns, with the received data modified
+  // in place.
+  EXPECT_CALL(receiver, ManageFrame)
+      .WillOnce([&](std::unique_ptr<RtpFrameObject> transformed_frame) {
+        EXPECT_EQ(transformed_frame->data(), received_data);
+        EXPECT_EQ(transformed_frame->data()[0], 0xfe);
+      });
+  delegate->TransformFrame(std::move(frame));
+  ::testing::Mock::VerifyAndClearExpectations(&receiver);
+}
+
 }  // namespace
 }  // namespace webrtc
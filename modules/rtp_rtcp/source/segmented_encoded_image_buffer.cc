@@ -0,0 +1,103 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/segmented_encoded_image_buffer.h"
+
+#include <string.h>
+
+#include <utility>
+
+#include "api/make_ref_counted.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+
+size_t TotalSize(const std::vector<rtc::CopyOnWriteBuffer>& segments) {
+  size_t size = 0;
+  for (const rtc::CopyOnWriteBuffer& segment : segments) {
+    size += segment.size();
+  }
+  return size;
+}
+
+}  // namespace
+
+// static
+rtc::scoped_refptr<SegmentedEncodedImageBuffer>
+SegmentedEncodedImageBuffer::Create(
+    std::vector<rtc::CopyOnWriteBuffer> segments) {
+  return rtc::make_ref_counted<SegmentedEncodedImageBuffer>(
+      std::move(segments));
+}
+
+SegmentedEncodedImageBuffer::SegmentedEncodedImageBuffer(
+    std::vector<rtc::CopyOnWriteBuffer> segments)
+    : segments_(std::move(segments)), size_(TotalSize(segments_)) {}
+
+SegmentedEncodedImageBuffer::~SegmentedEncodedImageBuffer() = default;
+
+const uint8_t* SegmentedEncodedImageBuffer::data() const {
+  if (segments_.size() == 1) {
+    // A single segment is contiguous already, unless it has been copied for
+    // mutable access.
+    MutexLock lock(&mutex_);
+    return linearized_ ? linearized_->data() : segments_[0].cdata();
+  }
+  return Linearized()->data();
+}
+
+uint8_t* SegmentedEncodedImageBuffer::data() {
+  // The segments may be shared with other owners of the packets, so writes
+  // always go to a copy.
+  return Linearized()->data();
+}
+
+size_t SegmentedEncodedImageBuffer::size() const {
+  return size_;
+}
+
+void SegmentedEncodedImageBuffer::ForEachChunk(
+    rtc::FunctionView<void(rtc::ArrayView<const uint8_t>)> callback) const {
+  EncodedImageBuffer* linearized;
+  {
+    MutexLock lock(&mutex_);
+    linearized = linearized_.get();
+  }
+  if (linearized) {
+    callback(rtc::ArrayView<const uint8_t>(linearized->data(),
+                                           linearized->size()));
+    return;
+  }
+  for (const rtc::CopyOnWriteBuffer& segment : segments_) {
+    callback(rtc::ArrayView<const uint8_t>(segment.cdata(), segment.size()));
+  }
+}
+
+bool SegmentedEncodedImageBuffer::IsLinearized() const {
+  MutexLock lock(&mutex_);
+  return linearized_ != nullptr;
+}
+
+EncodedImageBuffer* SegmentedEncodedImageBuffer::Linearized() const {
+  MutexLock lock(&mutex_);
+  if (!linearized_) {
+    linearized_ = EncodedImageBuffer::Create(size_);
+    uint8_t* write_at = linearized_->data();
+    for (const rtc::CopyOnWriteBuffer& segment : segments_) {
+      memcpy(write_at, segment.cdata(), segment.size());
+      write_at += segment.size();
+    }
+    RTC_DCHECK_EQ(write_at - linearized_->data(), size_);
+  }
+  return linearized_.get();
+}
+
+}  // namespace webrtc
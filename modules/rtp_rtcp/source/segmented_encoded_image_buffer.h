@@ -0,0 +1,68 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_SEGMENTED_ENCODED_IMAGE_BUFFER_H_
+#define MODULES_RTP_RTCP_SOURCE_SEGMENTED_ENCODED_IMAGE_BUFFER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "api/array_view.h"
+#include "api/function_view.h"
+#include "api/scoped_refptr.h"
+#include "api/video/encoded_image.h"
+#include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Encoded image made of the payloads of the RTP packets of a frame, which are
+// referenced rather than copied. The segments are only copied into one
+// contiguous buffer when `data()` is first called on a frame that has more
+// than one of them. `ForEachChunk()` never copies, unless the bytes have been
+// made contiguous already, in which case that copy is used.
+class SegmentedEncodedImageBuffer : public EncodedImageBufferInterface {
+ public:
+  static rtc::scoped_refptr<SegmentedEncodedImageBuffer> Create(
+      std::vector<rtc::CopyOnWriteBuffer> segments);
+
+  const uint8_t* data() const override;
+  uint8_t* data() override;
+  size_t size() const override;
+  void ForEachChunk(rtc::FunctionView<void(rtc::ArrayView<const uint8_t>)>
+                        callback) const override;
+
+  // Returns true if the bytes have been copied into a contiguous buffer.
+  bool IsLinearized() const;
+
+ protected:
+  explicit SegmentedEncodedImageBuffer(
+      std::vector<rtc::CopyOnWriteBuffer> segments);
+  ~SegmentedEncodedImageBuffer() override;
+
+ private:
+  // Returns the contiguous copy of the segments, creating it if needed.
+  EncodedImageBuffer* Linearized() const;
+
+  const std::vector<rtc::CopyOnWriteBuffer> segments_;
+  const size_t size_;
+  // The buffer may be shared by the decoder and encoded frame sinks on other
+  // threads, so creating the contiguous copy is guarded.
+  mutable Mutex mutex_;
+  mutable rtc::scoped_refptr<EncodedImageBuffer> linearized_
+      RTC_GUARDED_BY(mutex_);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_SEGMENTED_ENCODED_IMAGE_BUFFER_H_
@@ -0,0 +1,91 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/segmented_encoded_image_buffer.h"
+
+#include <vector>
+
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+
+std::vector<uint8_t> Chunks(const EncodedImageBufferInterface& buffer,
+                            int* num_chunks) {
+  std::vector<uint8_t> bytes;
+  *num_chunks = 0;
+  buffer.ForEachChunk([&](rtc::ArrayView<const uint8_t> chunk) {
+    bytes.insert(bytes.end(), chunk.begin(), chunk.end());
+    ++*num_chunks;
+  });
+  return bytes;
+}
+
+TEST(SegmentedEncodedImageBufferTest, SingleSegmentIsNotCopied) {
+  const uint8_t kPayload[] = {1, 2, 3};
+  rtc::CopyOnWriteBuffer payload(kPayload);
+  auto buffer = SegmentedEncodedImageBuffer::Create({payload});
+
+  const EncodedImageBufferInterface& const_buffer = *buffer;
+  EXPECT_EQ(const_buffer.size(), 3u);
+  EXPECT_EQ(const_buffer.data(), payload.cdata());
+  EXPECT_FALSE(buffer->IsLinearized());
+}
+
+TEST(SegmentedEncodedImageBufferTest, ChunksReferenceSegments) {
+  const uint8_t kFirst[] = {1, 2};
+  const uint8_t kSecond[] = {3, 4, 5};
+  auto buffer = SegmentedEncodedImageBuffer::Create(
+      {rtc::CopyOnWriteBuffer(kFirst), rtc::CopyOnWriteBuffer(kSecond)});
+
+  int num_chunks;
+  EXPECT_THAT(Chunks(*buffer, &num_chunks), ElementsAre(1, 2, 3, 4, 5));
+  EXPECT_EQ(num_chunks, 2);
+  EXPECT_FALSE(buffer->IsLinearized());
+}
+
+TEST(SegmentedEncodedImageBufferTest, DataLinearizesOnce) {
+  const uint8_t kFirst[] = {1, 2};
+  const uint8_t kSecond[] = {3, 4, 5};
+  auto buffer = SegmentedEncodedImageBuffer::Create(
+      {rtc::CopyOnWriteBuffer(kFirst), rtc::CopyOnWriteBuffer(kSecond)});
+
+  const EncodedImageBufferInterface& const_buffer = *buffer;
+  const uint8_t* data = const_buffer.data();
+  EXPECT_THAT(rtc::MakeArrayView(data, const_buffer.size()),
+              ElementsAre(1, 2, 3, 4, 5));
+  EXPECT_TRUE(buffer->IsLinearized());
+  EXPECT_EQ(const_buffer.data(), data);
+
+  // Once contiguous, chunks come from the contiguous copy.
+  int num_chunks;
+  EXPECT_THAT(Chunks(*buffer, &num_chunks), ElementsAre(1, 2, 3, 4, 5));
+  EXPECT_EQ(num_chunks, 1);
+}
+
+TEST(SegmentedEncodedImageBufferTest, WritesDoNotModifySegments) {
+  const uint8_t kPayload[] = {1, 2, 3};
+  rtc::CopyOnWriteBuffer payload(kPayload);
+  auto buffer = SegmentedEncodedImageBuffer::Create({payload});
+
+  buffer->data()[0] = 9;
+  EXPECT_EQ(payload.cdata()[0], 1);
+
+  const EncodedImageBufferInterface& const_buffer = *buffer;
+  EXPECT_EQ(const_buffer.data()[0], 9);
+  int num_chunks;
+  EXPECT_THAT(Chunks(*buffer, &num_chunks), ElementsAre(9, 2, 3));
+}
+
+}  // namespace
+}  // namespace webrtc
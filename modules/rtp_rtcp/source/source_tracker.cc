@@ -29,17 +29,38 @@ void SourceTracker::OnFrameDelivered(RtpPacketInfos packet_infos) {
   }
 
   Timestamp now = clock_->CurrentTime();
-  worker_thread_->PostTask(
-      SafeTask(worker_safety_.flag(),
-               [this, packet_infos = std::move(packet_infos), now]() {
-                 RTC_DCHECK_RUN_ON(worker_thread_);
-                 OnFrameDeliveredInternal(now, packet_infos);
-               }));
+  bool schedule_update;
+  {
+    MutexLock lock(&pending_updates_lock_);
+    // A task is already scheduled if there are pending updates.
+    schedule_update = pending_updates_.empty();
+    pending_updates_.push_back({now, std::move(packet_infos)});
+  }
+  if (schedule_update) {
+    worker_thread_->PostDelayedTask(
+        SafeTask(worker_safety_.flag(),
+                 [this] {
+                   RTC_DCHECK_RUN_ON(worker_thread_);
+                   ApplyPendingUpdates();
+                 }),
+        kUpdateInterval);
+  }
+}
+
+void SourceTracker::ApplyPendingUpdates() const {
+  {
+    MutexLock lock(&pending_updates_lock_);
+    pending_updates_.swap(updates_to_apply_);
+  }
+  for (const PendingUpdate& update : updates_to_apply_) {
+    OnFrameDeliveredInternal(update.now, update.packet_infos);
+  }
+  updates_to_apply_.clear();
 }
 
 void SourceTracker::OnFrameDeliveredInternal(
     Timestamp now,
-    const RtpPacketInfos& packet_infos) {
+    const RtpPacketInfos& packet_infos) const {
   TRACE_EVENT0("webrtc", "SourceTracker::OnFrameDelivered");
 
   for (const RtpPacketInfo& packet_info : packet_infos) {
@@ -71,6 +92,7 @@ void SourceTracker::OnFrameDeliveredInternal(
 std::vector<RtpSource> SourceTracker::GetSources() const {
   RTC_DCHECK_RUN_ON(worker_thread_);
 
+  ApplyPendingUpdates();
   PruneEntries(clock_->CurrentTime());
 
   std::vector<RtpSource> sources;
@@ -89,7 +111,8 @@ std::vector<RtpSource> SourceTracker::GetSources() const {
   return sources;
 }
 
-SourceTracker::SourceEntry& SourceTracker::UpdateEntry(const SourceKey& key) {
+SourceTracker::SourceEntry& SourceTracker::UpdateEntry(
+    const SourceKey& key) const {
   // We intentionally do |find() + emplace()|, instead of checking the return
   // value of `emplace()`, for performance reasons. It's much more likely for
   // the key to already exist than for it not to.
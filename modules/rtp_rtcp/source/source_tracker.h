@@ -24,6 +24,8 @@
 #include "api/transport/rtp/rtp_source.h"
 #include "api/units/time_delta.h"
 #include "api/units/timestamp.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
 #include "rtc_base/time_utils.h"
 #include "system_wrappers/include/clock.h"
 
@@ -40,6 +42,11 @@ class SourceTracker {
   // https://w3c.github.io/webrtc-pc/#dom-rtcrtpreceiver-getcontributingsources
   static constexpr TimeDelta kTimeout = TimeDelta::Seconds(10);
 
+  // Interval at which updates from OnFrameDelivered() are applied on the
+  // worker thread. GetSources() applies any pending updates itself, so this
+  // doesn't delay what it returns.
+  static constexpr TimeDelta kUpdateInterval = TimeDelta::Millis(100);
+
   explicit SourceTracker(Clock* clock);
 
   SourceTracker(const SourceTracker& other) = delete;
@@ -48,7 +55,9 @@ class SourceTracker {
   SourceTracker& operator=(SourceTracker&& other) = delete;
 
   // Updates the source entries when a frame is delivered to the
-  // RTCRtpReceiver's MediaStreamTrack.
+  // RTCRtpReceiver's MediaStreamTrack. May be called on any thread. The
+  // update is queued and applied in a batch on the worker thread, so that
+  // frequent frames don't each post a task.
   void OnFrameDelivered(RtpPacketInfos packet_infos);
 
   // Returns an `RtpSource` for each unique SSRC and CSRC identifier updated in
@@ -116,13 +125,23 @@ class SourceTracker {
                                        SourceKeyHasher,
                                        SourceKeyComparator>;
 
+  struct PendingUpdate {
+    Timestamp now;
+    RtpPacketInfos packet_infos;
+  };
+
+  // Applies the updates queued by OnFrameDelivered(). Marked as "const" so
+  // that the getters can apply them.
+  void ApplyPendingUpdates() const RTC_RUN_ON(worker_thread_);
+
   void OnFrameDeliveredInternal(Timestamp now,
-                                const RtpPacketInfos& packet_infos)
+                                const RtpPacketInfos& packet_infos) const
       RTC_RUN_ON(worker_thread_);
 
   // Updates an entry by creating it (if it didn't previously exist) and moving
   // it to the front of the list. Returns a reference to the entry.
-  SourceEntry& UpdateEntry(const SourceKey& key) RTC_RUN_ON(worker_thread_);
+  SourceEntry& UpdateEntry(const SourceKey& key) const
+      RTC_RUN_ON(worker_thread_);
 
   // Removes entries that have timed out. Marked as "const" so that we can do
   // pruning in getters.
@@ -136,6 +155,14 @@ class SourceTracker {
   // pruning in const functions.
   mutable SourceList list_ RTC_GUARDED_BY(worker_thread_);
   mutable SourceMap map_ RTC_GUARDED_BY(worker_thread_);
+
+  // Only held to hand updates over to the worker thread.
+  mutable Mutex pending_updates_lock_;
+  mutable std::vector<PendingUpdate> pending_updates_
+      RTC_GUARDED_BY(pending_updates_lock_);
+  // Updates being applied. Kept to reuse its capacity.
+  mutable std::vector<PendingUpdate> updates_to_apply_
+      RTC_GUARDED_BY(worker_thread_);
   ScopedTaskSafety worker_safety_;
 };
 
@@ -535,4 +535,32 @@ TEST(SourceTrackerTest, TimedOutSourcesAreRemoved) {
                                     kRtpTimestamp1, extensions1)));
 }
 
+TEST(SourceTrackerTest, GetSourcesIncludesUpdatesNotYetApplied) {
+  constexpr uint32_t kSsrc = 10;
+  constexpr uint32_t kRtpTimestamp0 = 40;
+  constexpr uint32_t kRtpTimestamp1 = 41;
+  constexpr Timestamp kReceiveTime = Timestamp::Millis(60);
+
+  GlobalSimulatedTimeController time_controller(Timestamp::Seconds(1000));
+  SourceTracker tracker(time_controller.GetClock());
+
+  tracker.OnFrameDelivered(RtpPacketInfos(
+      {RtpPacketInfo(kSsrc, /*csrcs=*/{}, kRtpTimestamp0, kReceiveTime)}));
+  time_controller.AdvanceTime(TimeDelta::Millis(20));
+  tracker.OnFrameDelivered(RtpPacketInfos(
+      {RtpPacketInfo(kSsrc, /*csrcs=*/{}, kRtpTimestamp1, kReceiveTime)}));
+  Timestamp timestamp_1 = time_controller.GetClock()->CurrentTime();
+
+  // Both updates are still queued for the worker thread.
+  EXPECT_THAT(tracker.GetSources(),
+              ElementsAre(RtpSource(timestamp_1, kSsrc, RtpSourceType::SSRC,
+                                    kRtpTimestamp1, RtpSource::Extensions())));
+
+  // Applying the batch later doesn't change the result.
+  time_controller.AdvanceTime(SourceTracker::kUpdateInterval);
+  EXPECT_THAT(tracker.GetSources(),
+              ElementsAre(RtpSource(timestamp_1, kSsrc, RtpSourceType::SSRC,
+                                    kRtpTimestamp1, RtpSource::Extensions())));
+}
+
 }  // namespace webrtc
@@ -13,9 +13,12 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <vector>
+
 #include "api/array_view.h"
 #include "api/scoped_refptr.h"
 #include "api/video/encoded_image.h"
+#include "modules/rtp_rtcp/source/segmented_encoded_image_buffer.h"
 #include "rtc_base/checks.h"
 
 namespace webrtc {
@@ -39,4 +42,12 @@ rtc::scoped_refptr<EncodedImageBuffer> VideoRtpDepacketizer::AssembleFrame(
   return bitstream;
 }
 
+rtc::scoped_refptr<EncodedImageBufferInterface>
+VideoRtpDepacketizer::AssembleFrameFromPayloads(
+    rtc::ArrayView<const rtc::CopyOnWriteBuffer> rtp_payloads) {
+  return SegmentedEncodedImageBuffer::Create(
+      std::vector<rtc::CopyOnWriteBuffer>(rtp_payloads.begin(),
+                                          rtp_payloads.end()));
+}
+
 }  // namespace webrtc
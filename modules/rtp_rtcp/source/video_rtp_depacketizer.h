@@ -34,6 +34,12 @@ class VideoRtpDepacketizer {
       rtc::CopyOnWriteBuffer rtp_payload) = 0;
   virtual rtc::scoped_refptr<EncodedImageBuffer> AssembleFrame(
       rtc::ArrayView<const rtc::ArrayView<const uint8_t>> rtp_payloads);
+  // Same as AssembleFrame, but the returned buffer references `rtp_payloads`
+  // instead of copying them, unless the depacketizer needs to rewrite them.
+  // Depacketizers that override AssembleFrame must override this too.
+  virtual rtc::scoped_refptr<EncodedImageBufferInterface>
+  AssembleFrameFromPayloads(
+      rtc::ArrayView<const rtc::CopyOnWriteBuffer> rtp_payloads);
 };
 
 }  // namespace webrtc
@@ -0,0 +1,145 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_capture/linux/v4l2_frame_buffer.h"
+
+#include <utility>
+
+#include "absl/algorithm/container.h"
+#include "api/make_ref_counted.h"
+#include "api/video/i420_buffer.h"
+#include "common_video/include/video_frame_buffer.h"
+#include "rtc_base/logging.h"
+#include "third_party/libyuv/include/libyuv.h"
+
+namespace webrtc {
+namespace videocapturemodule {
+
+namespace {
+
+// NV12 view of an NV12 V4L2FrameBuffer, which it keeps alive.
+class MappedNV12Buffer : public NV12BufferInterface {
+ public:
+  explicit MappedNV12Buffer(rtc::scoped_refptr<V4L2FrameBuffer> frame)
+      : frame_(std::move(frame)) {}
+
+  int width() const override { return frame_->width(); }
+  int height() const override { return frame_->height(); }
+  int StrideY() const override { return frame_->bytes_per_line(); }
+  int StrideUV() const override { return frame_->bytes_per_line(); }
+  const uint8_t* DataY() const override { return frame_->data(); }
+  const uint8_t* DataUV() const override {
+    return frame_->data() + StrideY() * height();
+  }
+
+  rtc::scoped_refptr<I420BufferInterface> ToI420() override {
+    rtc::scoped_refptr<I420Buffer> i420_buffer =
+        I420Buffer::Create(width(), height());
+    libyuv::NV12ToI420(DataY(), StrideY(), DataUV(), StrideUV(),
+                       i420_buffer->MutableDataY(), i420_buffer->StrideY(),
+                       i420_buffer->MutableDataU(), i420_buffer->StrideU(),
+                       i420_buffer->MutableDataV(), i420_buffer->StrideV(),
+                       width(), height());
+    return i420_buffer;
+  }
+
+ private:
+  const rtc::scoped_refptr<V4L2FrameBuffer> frame_;
+};
+
+}  // namespace
+
+// static
+rtc::scoped_refptr<V4L2FrameBuffer> V4L2FrameBuffer::Create(
+    VideoType video_type,
+    int width,
+    int height,
+    int bytes_per_line,
+    const uint8_t* data,
+    size_t size,
+    int dmabuf_fd,
+    absl::AnyInvocable<void() &&> release_callback) {
+  return rtc::make_ref_counted<V4L2FrameBuffer>(
+      video_type, width, height, bytes_per_line, data, size, dmabuf_fd,
+      std::move(release_callback));
+}
+
+V4L2FrameBuffer::V4L2FrameBuffer(
+    VideoType video_type,
+    int width,
+    int height,
+    int bytes_per_line,
+    const uint8_t* data,
+    size_t size,
+    int dmabuf_fd,
+    absl::AnyInvocable<void() &&> release_callback)
+    : video_type_(video_type),
+      width_(width),
+      height_(height),
+      bytes_per_line_(bytes_per_line),
+      data_(data),
+      size_(size),
+      dmabuf_fd_(dmabuf_fd),
+      release_callback_(std::move(release_callback)) {}
+
+V4L2FrameBuffer::~V4L2FrameBuffer() {
+  std::move(release_callback_)();
+}
+
+VideoFrameBuffer::Type V4L2FrameBuffer::type() const {
+  return Type::kNative;
+}
+
+int V4L2FrameBuffer::width() const {
+  return width_;
+}
+
+int V4L2FrameBuffer::height() const {
+  return height_;
+}
+
+rtc::scoped_refptr<I420BufferInterface> V4L2FrameBuffer::ToI420() {
+  rtc::scoped_refptr<I420Buffer> i420_buffer =
+      I420Buffer::Create(width_, height_);
+  const int result = libyuv::ConvertToI420(
+      data_, size_, i420_buffer->MutableDataY(), i420_buffer->StrideY(),
+      i420_buffer->MutableDataU(), i420_buffer->StrideU(),
+      i420_buffer->MutableDataV(), i420_buffer->StrideV(), 0, 0, width_,
+      height_, width_, height_, libyuv::kRotate0,
+      ConvertVideoType(video_type_));
+  if (result != 0) {
+    RTC_LOG(LS_ERROR) << "Failed to convert capture frame from type "
+                      << static_cast<int>(video_type_) << " to I420.";
+    return nullptr;
+  }
+  return i420_buffer;
+}
+
+rtc::scoped_refptr<VideoFrameBuffer> V4L2FrameBuffer::GetMappedFrameBuffer(
+    rtc::ArrayView<Type> types) {
+  if (video_type_ == VideoType::kNV12 &&
+      absl::c_linear_search(types, Type::kNV12)) {
+    return rtc::make_ref_counted<MappedNV12Buffer>(
+        rtc::scoped_refptr<V4L2FrameBuffer>(this));
+  }
+  if (video_type_ == VideoType::kI420 &&
+      absl::c_linear_search(types, Type::kI420)) {
+    const int stride_uv = (bytes_per_line_ + 1) / 2;
+    const uint8_t* data_u = data_ + bytes_per_line_ * height_;
+    const uint8_t* data_v = data_u + stride_uv * ((height_ + 1) / 2);
+    return WrapI420Buffer(
+        width_, height_, data_, bytes_per_line_, data_u, stride_uv, data_v,
+        stride_uv, [frame = rtc::scoped_refptr<V4L2FrameBuffer>(this)] {});
+  }
+  return nullptr;
+}
+
+}  // namespace videocapturemodule
+}  // namespace webrtc
@@ -0,0 +1,93 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CAPTURE_LINUX_V4L2_FRAME_BUFFER_H_
+#define MODULES_VIDEO_CAPTURE_LINUX_V4L2_FRAME_BUFFER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "absl/functional/any_invocable.h"
+#include "api/array_view.h"
+#include "api/scoped_refptr.h"
+#include "api/video/video_frame_buffer.h"
+#include "common_video/libyuv/include/webrtc_libyuv.h"
+#include "rtc_base/system/rtc_export.h"
+
+namespace webrtc {
+namespace videocapturemodule {
+
+// A captured frame that still lives in the V4L2 buffer it was dequeued from,
+// in the pixel format of the camera (e.g. MJPEG, YUY2 or NV12). Encoders that
+// can import DMA-BUFs (e.g. through VA-API) check for type() == kNative,
+// downcast and use dmabuf_fd(). Everyone else gets the pixels through
+// GetMappedFrameBuffer() for NV12 and I420 cameras, or ToI420(), which
+// converts (and for MJPEG, decodes) on the calling thread rather than the
+// capture thread.
+//
+// The V4L2 buffer is queued back to the device when the frame buffer is
+// destroyed, so holding on to frames stalls the capturer.
+class RTC_EXPORT V4L2FrameBuffer : public VideoFrameBuffer {
+ public:
+  // `data` is the mmap:ed V4L2 buffer holding `size` bytes of the frame, and
+  // `dmabuf_fd` the DMA-BUF it's exported as, or -1 if the driver can't
+  // export it. Both stay owned by the capturer and valid until
+  // `release_callback` has run, which happens when the frame buffer is
+  // destroyed.
+  static rtc::scoped_refptr<V4L2FrameBuffer> Create(
+      VideoType video_type,
+      int width,
+      int height,
+      int bytes_per_line,
+      const uint8_t* data,
+      size_t size,
+      int dmabuf_fd,
+      absl::AnyInvocable<void() &&> release_callback);
+
+  Type type() const override;
+  int width() const override;
+  int height() const override;
+  rtc::scoped_refptr<I420BufferInterface> ToI420() override;
+  rtc::scoped_refptr<VideoFrameBuffer> GetMappedFrameBuffer(
+      rtc::ArrayView<Type> types) override;
+
+  VideoType video_type() const { return video_type_; }
+  // Bytes per row of the luma plane, or 0 for compressed formats.
+  int bytes_per_line() const { return bytes_per_line_; }
+  const uint8_t* data() const { return data_; }
+  size_t size() const { return size_; }
+  int dmabuf_fd() const { return dmabuf_fd_; }
+
+ protected:
+  V4L2FrameBuffer(VideoType video_type,
+                  int width,
+                  int height,
+                  int bytes_per_line,
+                  const uint8_t* data,
+                  size_t size,
+                  int dmabuf_fd,
+                  absl::AnyInvocable<void() &&> release_callback);
+  ~V4L2FrameBuffer() override;
+
+ private:
+  const VideoType video_type_;
+  const int width_;
+  const int height_;
+  const int bytes_per_line_;
+  const uint8_t* const data_;
+  const size_t size_;
+  const int dmabuf_fd_;
+  absl::AnyInvocable<void() &&> release_callback_;
+};
+
+}  // namespace videocapturemodule
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CAPTURE_LINUX_V4L2_FRAME_BUFFER_H_
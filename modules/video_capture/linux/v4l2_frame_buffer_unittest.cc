@@ -0,0 +1,82 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_capture/linux/v4l2_frame_buffer.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "api/scoped_refptr.h"
+#include "api/video/video_frame_buffer.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace videocapturemodule {
+namespace {
+
+constexpr int kWidth = 4;
+constexpr int kHeight = 2;
+
+rtc::scoped_refptr<V4L2FrameBuffer> CreateNV12Frame(
+    const std::vector<uint8_t>& data,
+    bool* released) {
+  return V4L2FrameBuffer::Create(VideoType::kNV12, kWidth, kHeight, kWidth,
+                                 data.data(), data.size(), /*dmabuf_fd=*/-1,
+                                 [released] { *released = true; });
+}
+
+TEST(V4L2FrameBufferTest, ReleasesCaptureBufferWhenDestroyed) {
+  std::vector<uint8_t> data(kWidth * kHeight * 3 / 2);
+  bool released = false;
+  rtc::scoped_refptr<V4L2FrameBuffer> frame = CreateNV12Frame(data, &released);
+  EXPECT_EQ(frame->type(), VideoFrameBuffer::Type::kNative);
+  EXPECT_FALSE(released);
+  frame = nullptr;
+  EXPECT_TRUE(released);
+}
+
+TEST(V4L2FrameBufferTest, MapsNV12WithoutCopy) {
+  std::vector<uint8_t> data(kWidth * kHeight * 3 / 2);
+  bool released = false;
+  rtc::scoped_refptr<V4L2FrameBuffer> frame = CreateNV12Frame(data, &released);
+
+  VideoFrameBuffer::Type types[] = {VideoFrameBuffer::Type::kNV12};
+  rtc::scoped_refptr<VideoFrameBuffer> mapped =
+      frame->GetMappedFrameBuffer(types);
+  ASSERT_TRUE(mapped);
+  const NV12BufferInterface* nv12 = mapped->GetNV12();
+  EXPECT_EQ(nv12->DataY(), data.data());
+  EXPECT_EQ(nv12->DataUV(), data.data() + kWidth * kHeight);
+
+  // The mapped buffer keeps the capture buffer.
+  frame = nullptr;
+  EXPECT_FALSE(released);
+  mapped = nullptr;
+  EXPECT_TRUE(released);
+}
+
+TEST(V4L2FrameBufferTest, DoesNotMapOtherFormats) {
+  std::vector<uint8_t> data(kWidth * kHeight * 2);
+  rtc::scoped_refptr<V4L2FrameBuffer> frame = V4L2FrameBuffer::Create(
+      VideoType::kYUY2, kWidth, kHeight, kWidth * 2, data.data(), data.size(),
+      /*dmabuf_fd=*/-1, [] {});
+
+  VideoFrameBuffer::Type types[] = {VideoFrameBuffer::Type::kI420,
+                                    VideoFrameBuffer::Type::kNV12};
+  EXPECT_FALSE(frame->GetMappedFrameBuffer(types));
+  rtc::scoped_refptr<I420BufferInterface> i420 = frame->ToI420();
+  ASSERT_TRUE(i420);
+  EXPECT_EQ(i420->width(), kWidth);
+  EXPECT_EQ(i420->height(), kHeight);
+}
+
+}  // namespace
+}  // namespace videocapturemodule
+}  // namespace webrtc
@@ -57,7 +57,8 @@ rtc::scoped_refptr<VideoCaptureModule> VideoCaptureImpl::Create(
   }
 #endif
   if (options->allow_v4l2()) {
-    auto implementation = rtc::make_ref_counted<VideoCaptureModuleV4L2>();
+    auto implementation =
+        rtc::make_ref_counted<VideoCaptureModuleV4L2>(*options);
 
     if (implementation->Init(deviceUniqueId) == 0)
       return implementation;
@@ -21,10 +21,15 @@
 #include <time.h>
 #include <unistd.h>
 
+#include <memory>
 #include <new>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "api/scoped_refptr.h"
+#include "api/task_queue/default_task_queue_factory.h"
+#include "api/task_queue/task_queue_factory.h"
 #include "media/base/video_common.h"
 #include "modules/video_capture/video_capture.h"
 #include "rtc_base/logging.h"
@@ -49,13 +54,93 @@
 
 namespace webrtc {
 namespace videocapturemodule {
+
+// The mmap:ed V4L2 buffers. Shared with the V4L2FrameBuffers wrapping them, so
+// that the mappings stay valid until the last frame is released, also after
+// capture is stopped.
+class V4L2CaptureBuffers
+    : public std::enable_shared_from_this<V4L2CaptureBuffers> {
+ public:
+  struct Buffer {
+    void* start;
+    size_t length;
+    // -1 if the buffer isn't exported as a DMA-BUF.
+    int dmabuf_fd;
+  };
+
+  explicit V4L2CaptureBuffers(int device_fd) : device_fd_(device_fd) {}
+
+  ~V4L2CaptureBuffers() {
+    for (const Buffer& buffer : buffers_) {
+      munmap(buffer.start, buffer.length);
+      if (buffer.dmabuf_fd != -1)
+        close(buffer.dmabuf_fd);
+    }
+  }
+
+  // Takes ownership of the mapping and DMA-BUF of the buffer with the next
+  // index. Only called before capture starts.
+  void Add(const Buffer& buffer) { buffers_.push_back(buffer); }
+
+  // Queues the buffer back to the device for capturing into. Can be called
+  // on any thread.
+  bool Queue(uint32_t index) {
+    MutexLock lock(&mutex_);
+    if (stopped_)
+      return true;
+
+    struct v4l2_buffer buffer;
+    memset(&buffer, 0, sizeof(v4l2_buffer));
+    buffer.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buffer.memory = V4L2_MEMORY_MMAP;
+    buffer.index = index;
+    if (ioctl(device_fd_, VIDIOC_QBUF, &buffer) < 0) {
+      RTC_LOG(LS_INFO) << "Failed to enqueue capture buffer";
+      return false;
+    }
+    return true;
+  }
+
+  // Called before the device is closed. Buffers released after this are
+  // not queued back.
+  void Stop() {
+    MutexLock lock(&mutex_);
+    stopped_ = true;
+  }
+
+  // Wraps the dequeued buffer `index` holding `size` bytes of a frame. The
+  // buffer is queued back once the frame buffer is released.
+  rtc::scoped_refptr<V4L2FrameBuffer> Wrap(
+      uint32_t index,
+      size_t size,
+      const VideoCaptureCapability& capability,
+      int bytes_per_line) {
+    const Buffer& buffer = buffers_[index];
+    return V4L2FrameBuffer::Create(
+        capability.videoType, capability.width, capability.height,
+        bytes_per_line, static_cast<const uint8_t*>(buffer.start), size,
+        buffer.dmabuf_fd,
+        [buffers = shared_from_this(), index] { buffers->Queue(index); });
+  }
+
+ private:
+  const int device_fd_;
+  std::vector<Buffer> buffers_;
+  Mutex mutex_;
+  bool stopped_ RTC_GUARDED_BY(mutex_) = false;
+};
+
 VideoCaptureModuleV4L2::VideoCaptureModuleV4L2()
+    : VideoCaptureModuleV4L2(VideoCaptureOptions()) {}
+
+VideoCaptureModuleV4L2::VideoCaptureModuleV4L2(
+    const VideoCaptureOptions& options)
     : VideoCaptureImpl(),
+      native_frames_(options.v4l2_native_frames()),
+      threaded_mjpeg_decode_(options.v4l2_threaded_mjpeg_decode()),
       _deviceId(-1),
       _deviceFd(-1),
-      _buffersAllocatedByDevice(-1),
-      _captureStarted(false),
-      _pool(NULL) {}
+      _captureStarted(false) {}
 
 int32_t VideoCaptureModuleV4L2::Init(const char* deviceUniqueIdUTF8) {
   RTC_DCHECK_RUN_ON(&api_checker_);
@@ -102,7 +187,7 @@ int32_t VideoCaptureModuleV4L2::Init(const char* deviceUniqueIdUTF8) {
 
 VideoCaptureModuleV4L2::~VideoCaptureModuleV4L2() {
   RTC_DCHECK_RUN_ON(&api_checker_);
-  RTC_CHECK_RUNS_SERIALIZED(&capture_checker_);
+  RTC_CHECK_RUNS_SERIALIZED(&device_checker_);
 
   StopCapture();
   if (_deviceFd != -1)
@@ -121,12 +206,12 @@ int32_t VideoCaptureModuleV4L2::StartCapture(
     }
   }
 
-  // We don't want members above to be guarded by capture_checker_ as
+  // We don't want members above to be guarded by device_checker_ as
   // it's meant to be for members that are accessed on the API thread
   // only when we are not capturing. The code above can be called many
   // times while sharing instance of VideoCaptureV4L2 between websites
   // and therefore it would not follow the requirements of this checker.
-  RTC_CHECK_RUNS_SERIALIZED(&capture_checker_);
+  RTC_CHECK_RUNS_SERIALIZED(&device_checker_);
 
   // Set a baseline of configured parameters. It is updated here during
   // configuration, then read from the capture thread.
@@ -239,6 +324,7 @@ int32_t VideoCaptureModuleV4L2::StartCapture(
   // initialize current width and height
   configured_capability_.width = video_fmt.fmt.pix.width;
   configured_capability_.height = video_fmt.fmt.pix.height;
+  bytes_per_line_ = video_fmt.fmt.pix.bytesperline;
 
   // Trying to set frame rate, before check driver capability.
   bool driver_framerate_support = true;
@@ -291,6 +377,12 @@ int32_t VideoCaptureModuleV4L2::StartCapture(
   _captureStarted = true;
   _streaming = true;
 
+  if (threaded_mjpeg_decode_ &&
+      configured_capability_.videoType == VideoType::kMJPEG) {
+    mjpeg_decode_queue_ = CreateDefaultTaskQueueFactory()->CreateTaskQueue(
+        "V4L2MjpegDecode", TaskQueueFactory::Priority::HIGH);
+  }
+
   // start capture thread;
   if (_captureThread.empty()) {
     quit_ = false;
@@ -319,7 +411,11 @@ int32_t VideoCaptureModuleV4L2::StopCapture() {
 
   _captureStarted = false;
 
-  RTC_CHECK_RUNS_SERIALIZED(&capture_checker_);
+  RTC_CHECK_RUNS_SERIALIZED(&device_checker_);
+  // Waits for the frame being decoded, and drops the ones queued up.
+  mjpeg_decode_queue_ = nullptr;
+  mjpeg_decode_pending_ = false;
+
   MutexLock lock(&capture_lock_);
   if (_streaming) {
     _streaming = false;
@@ -337,26 +433,26 @@ int32_t VideoCaptureModuleV4L2::StopCapture() {
 // critical section protected by the caller
 
 bool VideoCaptureModuleV4L2::AllocateVideoBuffers() {
-  RTC_CHECK_RUNS_SERIALIZED(&capture_checker_);
+  RTC_CHECK_RUNS_SERIALIZED(&device_checker_);
+  const unsigned int max_buffers =
+      native_frames_ ? kNoOfNativeV4L2Buffers : kNoOfV4L2Bufffers;
   struct v4l2_requestbuffers rbuffer;
   memset(&rbuffer, 0, sizeof(v4l2_requestbuffers));
 
   rbuffer.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
   rbuffer.memory = V4L2_MEMORY_MMAP;
-  rbuffer.count = kNoOfV4L2Bufffers;
+  rbuffer.count = max_buffers;
 
   if (ioctl(_deviceFd, VIDIOC_REQBUFS, &rbuffer) < 0) {
     RTC_LOG(LS_INFO) << "Could not get buffers from device. errno = " << errno;
     return false;
   }
 
-  if (rbuffer.count > kNoOfV4L2Bufffers)
-    rbuffer.count = kNoOfV4L2Bufffers;
-
-  _buffersAllocatedByDevice = rbuffer.count;
+  if (rbuffer.count > max_buffers)
+    rbuffer.count = max_buffers;
 
   // Map the buffers
-  _pool = new Buffer[rbuffer.count];
+  auto buffers = std::make_shared<V4L2CaptureBuffers>(_deviceFd);
 
   for (unsigned int i = 0; i < rbuffer.count; i++) {
     struct v4l2_buffer buffer;
@@ -369,31 +465,49 @@ bool VideoCaptureModuleV4L2::AllocateVideoBuffers() {
       return false;
     }
 
-    _pool[i].start = mmap(NULL, buffer.length, PROT_READ | PROT_WRITE,
-                          MAP_SHARED, _deviceFd, buffer.m.offset);
+    void* start = mmap(NULL, buffer.length, PROT_READ | PROT_WRITE,
+                       MAP_SHARED, _deviceFd, buffer.m.offset);
 
-    if (MAP_FAILED == _pool[i].start) {
-      for (unsigned int j = 0; j < i; j++)
-        munmap(_pool[j].start, _pool[j].length);
+    if (MAP_FAILED == start) {
       return false;
     }
 
-    _pool[i].length = buffer.length;
+    // Export the buffer, so that native frames can be imported by e.g.
+    // hardware encoders without a copy. Drivers without support still get
+    // native frames backed by the mapping.
+    int dmabuf_fd = -1;
+    if (native_frames_) {
+      struct v4l2_exportbuffer expbuf;
+      memset(&expbuf, 0, sizeof(v4l2_exportbuffer));
+      expbuf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+      expbuf.index = i;
+      expbuf.flags = O_RDONLY | O_CLOEXEC;
+      if (ioctl(_deviceFd, VIDIOC_EXPBUF, &expbuf) == 0) {
+        dmabuf_fd = expbuf.fd;
+      } else {
+        RTC_LOG(LS_INFO) << "Could not export buffer as DMA-BUF. errno = "
+                         << errno;
+      }
+    }
+
+    buffers->Add({start, buffer.length, dmabuf_fd});
 
-    if (ioctl(_deviceFd, VIDIOC_QBUF, &buffer) < 0) {
+    if (!buffers->Queue(i)) {
       return false;
     }
   }
+  buffers_ = std::move(buffers);
   return true;
 }
 
 bool VideoCaptureModuleV4L2::DeAllocateVideoBuffers() {
-  RTC_CHECK_RUNS_SERIALIZED(&capture_checker_);
-  // unmap buffers
-  for (int i = 0; i < _buffersAllocatedByDevice; i++)
-    munmap(_pool[i].start, _pool[i].length);
-
-  delete[] _pool;
+  RTC_CHECK_RUNS_SERIALIZED(&device_checker_);
+  // The buffers are unmapped once the last frame referencing them is
+  // released.
+  if (buffers_) {
+    buffers_->Stop();
+    buffers_ = nullptr;
+  }
 
   // turn off stream
   enum v4l2_buf_type type;
@@ -411,7 +525,7 @@ bool VideoCaptureModuleV4L2::CaptureStarted() {
 }
 
 bool VideoCaptureModuleV4L2::CaptureProcess() {
-  RTC_CHECK_RUNS_SERIALIZED(&capture_checker_);
+  RTC_CHECK_RUNS_SERIALIZED(&device_checker_);
 
   int retVal = 0;
   fd_set rSet;
@@ -457,12 +571,22 @@ bool VideoCaptureModuleV4L2::CaptureProcess() {
         }
       }
 
-      // convert to to I420 if needed
-      IncomingFrame(reinterpret_cast<uint8_t*>(_pool[buf.index].start),
-                    buf.bytesused, configured_capability_);
-      // enqueue the buffer again
-      if (ioctl(_deviceFd, VIDIOC_QBUF, &buf) == -1) {
-        RTC_LOG(LS_INFO) << "Failed to enqueue capture buffer";
+      // The buffer is enqueued again when `frame` is released.
+      rtc::scoped_refptr<V4L2FrameBuffer> frame = buffers_->Wrap(
+          buf.index, buf.bytesused, configured_capability_, bytes_per_line_);
+      if (mjpeg_decode_queue_) {
+        // Drop the frame if the previous one is still being decoded, rather
+        // than falling behind the camera.
+        if (!mjpeg_decode_pending_.exchange(true)) {
+          mjpeg_decode_queue_->PostTask(
+              [this, frame = std::move(frame),
+               capability = configured_capability_]() mutable {
+                DeliverFrame(std::move(frame), capability);
+                mjpeg_decode_pending_ = false;
+              });
+        }
+      } else {
+        DeliverFrame(std::move(frame), configured_capability_);
       }
     }
   }
@@ -470,6 +594,17 @@ bool VideoCaptureModuleV4L2::CaptureProcess() {
   return true;
 }
 
+void VideoCaptureModuleV4L2::DeliverFrame(
+    rtc::scoped_refptr<V4L2FrameBuffer> frame,
+    const VideoCaptureCapability& capability) {
+  if (native_frames_ && IncomingFrameBuffer(frame) == 0) {
+    return;
+  }
+  // convert to to I420 if needed
+  IncomingFrame(const_cast<uint8_t*>(frame->data()), frame->size(),
+                capability);
+}
+
 int32_t VideoCaptureModuleV4L2::CaptureSettings(
     VideoCaptureCapability& settings) {
   RTC_DCHECK_RUN_ON(&api_checker_);
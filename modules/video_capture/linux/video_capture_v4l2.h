@@ -14,18 +14,27 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <atomic>
 #include <memory>
 
+#include "api/scoped_refptr.h"
+#include "api/task_queue/task_queue_base.h"
+#include "modules/video_capture/linux/v4l2_frame_buffer.h"
 #include "modules/video_capture/video_capture_defines.h"
 #include "modules/video_capture/video_capture_impl.h"
+#include "modules/video_capture/video_capture_options.h"
 #include "rtc_base/platform_thread.h"
+#include "rtc_base/race_checker.h"
 #include "rtc_base/synchronization/mutex.h"
 
 namespace webrtc {
 namespace videocapturemodule {
+class V4L2CaptureBuffers;
+
 class VideoCaptureModuleV4L2 : public VideoCaptureImpl {
  public:
   VideoCaptureModuleV4L2();
+  explicit VideoCaptureModuleV4L2(const VideoCaptureOptions& options);
   ~VideoCaptureModuleV4L2() override;
   int32_t Init(const char* deviceUniqueId);
   int32_t StartCapture(const VideoCaptureCapability& capability) override;
@@ -35,28 +44,42 @@ class VideoCaptureModuleV4L2 : public VideoCaptureImpl {
 
  private:
   enum { kNoOfV4L2Bufffers = 4 };
+  // Native frames are held downstream, e.g. by the encoder, while the next
+  // ones are captured.
+  enum { kNoOfNativeV4L2Buffers = 8 };
 
   static void CaptureThread(void*);
   bool CaptureProcess();
   bool AllocateVideoBuffers() RTC_EXCLUSIVE_LOCKS_REQUIRED(capture_lock_);
   bool DeAllocateVideoBuffers() RTC_EXCLUSIVE_LOCKS_REQUIRED(capture_lock_);
+  void DeliverFrame(rtc::scoped_refptr<V4L2FrameBuffer> frame,
+                    const VideoCaptureCapability& capability);
+
+  // Like capture_checker_, but for the members of this class. Separate,
+  // since with threaded MJPEG decoding frames are delivered on the decode
+  // thread while the capture thread keeps dequeuing.
+  rtc::RaceChecker device_checker_;
+
+  const bool native_frames_;
+  const bool threaded_mjpeg_decode_;
 
   rtc::PlatformThread _captureThread RTC_GUARDED_BY(api_checker_);
   Mutex capture_lock_ RTC_ACQUIRED_BEFORE(api_lock_);
   bool quit_ RTC_GUARDED_BY(capture_lock_);
   int32_t _deviceId RTC_GUARDED_BY(api_checker_);
-  int32_t _deviceFd RTC_GUARDED_BY(capture_checker_);
+  int32_t _deviceFd RTC_GUARDED_BY(device_checker_);
 
-  int32_t _buffersAllocatedByDevice RTC_GUARDED_BY(capture_lock_);
   VideoCaptureCapability configured_capability_
-      RTC_GUARDED_BY(capture_checker_);
-  bool _streaming RTC_GUARDED_BY(capture_checker_);
+      RTC_GUARDED_BY(device_checker_);
+  int bytes_per_line_ RTC_GUARDED_BY(device_checker_) = 0;
+  bool _streaming RTC_GUARDED_BY(device_checker_);
   bool _captureStarted RTC_GUARDED_BY(api_checker_);
-  struct Buffer {
-    void* start;
-    size_t length;
-  };
-  Buffer* _pool RTC_GUARDED_BY(capture_lock_);
+  std::shared_ptr<V4L2CaptureBuffers> buffers_ RTC_GUARDED_BY(capture_lock_);
+
+  // Set while capturing MJPEG with threaded decoding.
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> mjpeg_decode_queue_
+      RTC_GUARDED_BY(device_checker_);
+  std::atomic<bool> mjpeg_decode_pending_{false};
 };
 }  // namespace videocapturemodule
 }  // namespace webrtc
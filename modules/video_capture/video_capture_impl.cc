@@ -13,13 +13,17 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <utility>
+
 #include "api/video/i420_buffer.h"
+#include "api/video/nv12_buffer.h"
 #include "api/video/video_frame_buffer.h"
 #include "common_video/libyuv/include/webrtc_libyuv.h"
 #include "modules/video_capture/video_capture_config.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/time_utils.h"
 #include "rtc_base/trace_event.h"
+#include "system_wrappers/include/field_trial.h"
 #include "third_party/libyuv/include/libyuv.h"
 
 namespace webrtc {
@@ -81,7 +85,8 @@ VideoCaptureImpl::VideoCaptureImpl()
       _rawDataCallBack(NULL),
       _lastProcessFrameTimeNanos(rtc::TimeNanos()),
       _rotateFrame(kVideoRotation_0),
-      apply_rotation_(false) {
+      apply_rotation_(false),
+      keep_nv12_(field_trial::IsEnabled("WebRTC-Video-CaptureNV12")) {
   _requestedCapability.width = kDefaultWidth;
   _requestedCapability.height = kDefaultHeight;
   _requestedCapability.maxFPS = 30;
@@ -183,6 +188,28 @@ int32_t VideoCaptureImpl::IncomingFrame(uint8_t* videoFrame,
     }
   }
 
+  // NV12 is what hardware encoders and the libvpx and libaom encoders take,
+  // pass it on unless the frame needs to be rotated or flipped.
+  if (keep_nv12_ && frameInfo.videoType == VideoType::kNV12 && height > 0 &&
+      (!apply_rotation_ || _rotateFrame == kVideoRotation_0)) {
+    rtc::scoped_refptr<NV12Buffer> buffer = NV12Buffer::Create(width, height);
+    const int src_stride_uv = (width + 1) / 2 * 2;
+    libyuv::NV12Copy(videoFrame, width, videoFrame + width * height,
+                     src_stride_uv, buffer->MutableDataY(), buffer->StrideY(),
+                     buffer->MutableDataUV(), buffer->StrideUV(), width,
+                     height);
+    VideoFrame captureFrame =
+        VideoFrame::Builder()
+            .set_video_frame_buffer(buffer)
+            .set_timestamp_rtp(0)
+            .set_timestamp_ms(rtc::TimeMillis())
+            .set_rotation(!apply_rotation_ ? _rotateFrame : kVideoRotation_0)
+            .build();
+    captureFrame.set_ntp_time_ms(captureTime);
+    DeliverCapturedFrame(captureFrame);
+    return 0;
+  }
+
   // Setting absolute height (in case it was negative).
   // In Windows, the image starts bottom left, instead of top left.
   // Setting a negative source height, inverts the image (within LibYuv).
@@ -234,6 +261,34 @@ int32_t VideoCaptureImpl::IncomingFrame(uint8_t* videoFrame,
   return 0;
 }
 
+int32_t VideoCaptureImpl::IncomingFrameBuffer(
+    rtc::scoped_refptr<VideoFrameBuffer> buffer,
+    int64_t captureTime /*=0*/) {
+  RTC_CHECK_RUNS_SERIALIZED(&capture_checker_);
+  MutexLock lock(&api_lock_);
+
+  TRACE_EVENT1("webrtc", "VC::IncomingFrameBuffer", "capture_time",
+               captureTime);
+
+  if (_rawDataCallBack ||
+      (apply_rotation_ && _rotateFrame != kVideoRotation_0)) {
+    return -1;
+  }
+
+  VideoFrame captureFrame =
+      VideoFrame::Builder()
+          .set_video_frame_buffer(std::move(buffer))
+          .set_timestamp_rtp(0)
+          .set_timestamp_ms(rtc::TimeMillis())
+          .set_rotation(!apply_rotation_ ? _rotateFrame : kVideoRotation_0)
+          .build();
+  captureFrame.set_ntp_time_ms(captureTime);
+
+  DeliverCapturedFrame(captureFrame);
+
+  return 0;
+}
+
 int32_t VideoCaptureImpl::StartCapture(
     const VideoCaptureCapability& capability) {
   RTC_DCHECK_RUN_ON(&api_checker_);
@@ -77,6 +77,13 @@ class RTC_EXPORT VideoCaptureImpl : public VideoCaptureModule {
                         size_t videoFrameLength,
                         const VideoCaptureCapability& frameInfo,
                         int64_t captureTime = 0);
+  // Delivers a frame that is passed on as is, e.g. a native frame buffer
+  // wrapping the capture buffer. Returns -1 without delivering it if the
+  // frame would have to be converted, i.e. if a raw data callback is
+  // registered or the frame has to be rotated, in which case the caller
+  // falls back to IncomingFrame().
+  int32_t IncomingFrameBuffer(rtc::scoped_refptr<VideoFrameBuffer> buffer,
+                              int64_t captureTime = 0);
 
   // Platform dependent
   int32_t StartCapture(const VideoCaptureCapability& capability) override;
@@ -127,6 +134,10 @@ class RTC_EXPORT VideoCaptureImpl : public VideoCaptureModule {
 
   // Indicate whether rotation should be applied before delivered externally.
   bool apply_rotation_ RTC_GUARDED_BY(api_lock_);
+
+  // Deliver NV12 frames that need no rotation as NV12 rather than converting
+  // them to I420.
+  const bool keep_nv12_;
 };
 }  // namespace videocapturemodule
 }  // namespace webrtc
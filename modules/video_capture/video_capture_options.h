@@ -58,6 +58,20 @@ class RTC_EXPORT VideoCaptureOptions {
 #if defined(WEBRTC_LINUX)
   bool allow_v4l2() const { return allow_v4l2_; }
   void set_allow_v4l2(bool allow) { allow_v4l2_ = allow; }
+  // Deliver V4L2 frames as native frame buffers wrapping the capture buffers,
+  // exported as DMA-BUFs where the driver supports it, instead of converting
+  // them to I420 on the capture thread. See V4L2FrameBuffer.
+  bool v4l2_native_frames() const { return v4l2_native_frames_; }
+  void set_v4l2_native_frames(bool enable) { v4l2_native_frames_ = enable; }
+  // Decode V4L2 MJPEG frames on a separate thread, so that the capture thread
+  // keeps dequeuing frames while the previous one is decoded. Frames that
+  // arrive while the decoder is busy are dropped.
+  bool v4l2_threaded_mjpeg_decode() const {
+    return v4l2_threaded_mjpeg_decode_;
+  }
+  void set_v4l2_threaded_mjpeg_decode(bool enable) {
+    v4l2_threaded_mjpeg_decode_ = enable;
+  }
 #endif
 
 #if defined(WEBRTC_USE_PIPEWIRE)
@@ -70,6 +84,8 @@ class RTC_EXPORT VideoCaptureOptions {
  private:
 #if defined(WEBRTC_LINUX)
   bool allow_v4l2_ = false;
+  bool v4l2_native_frames_ = false;
+  bool v4l2_threaded_mjpeg_decode_ = false;
 #endif
 #if defined(WEBRTC_USE_PIPEWIRE)
   bool allow_pipewire_ = false;
@@ -11,13 +11,16 @@
 #include "modules/video_coding/codecs/av1/dav1d_decoder.h"
 
 #include <algorithm>
+#include <deque>
 
 #include "api/scoped_refptr.h"
 #include "api/video/encoded_image.h"
 #include "api/video/video_frame_buffer.h"
 #include "common_video/include/video_frame_buffer.h"
 #include "modules/video_coding/include/video_error_codes.h"
+#include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/logging.h"
+#include "system_wrappers/include/field_trial.h"
 #include "third_party/dav1d/libdav1d/include/dav1d/dav1d.h"
 #include "third_party/libyuv/include/libyuv/convert.h"
 #include "third_party/libyuv/include/libyuv/planar_functions.h"
@@ -27,7 +30,7 @@ namespace {
 
 class Dav1dDecoder : public VideoDecoder {
  public:
-  Dav1dDecoder();
+  explicit Dav1dDecoder(const Dav1dDecoderSettings& settings);
   Dav1dDecoder(const Dav1dDecoder&) = delete;
   Dav1dDecoder& operator=(const Dav1dDecoder&) = delete;
 
@@ -43,8 +46,23 @@ class Dav1dDecoder : public VideoDecoder {
   const char* ImplementationName() const override;
 
  private:
+  // What is needed from an EncodedImage to deliver its picture, which may come
+  // out of dav1d after later frames have been sent in.
+  struct FrameMetadata {
+    uint32_t rtp_timestamp;
+    int64_t ntp_time_ms;
+    absl::optional<ColorSpace> color_space;
+  };
+
+  // Delivers all pictures dav1d has finished decoding.
+  int32_t DeliverPictures();
+
+  const Dav1dDecoderSettings settings_;
   Dav1dContext* context_ = nullptr;
   DecodedImageCallback* decode_complete_callback_ = nullptr;
+  // Frames sent to dav1d whose pictures haven't been delivered, in decode
+  // order.
+  std::deque<FrameMetadata> pending_frames_;
 };
 
 class ScopedDav1dData {
@@ -74,7 +92,20 @@ constexpr char kDav1dName[] = "dav1d";
 // Calling `dav1d_data_wrap` requires a `free_callback` to be registered.
 void NullFreeCallback(const uint8_t* buffer, void* opaque) {}
 
-Dav1dDecoder::Dav1dDecoder() = default;
+Dav1dDecoderSettings GetFieldTrialSettings() {
+  Dav1dDecoderSettings settings;
+  FieldTrialParameter<int> max_threads("max_threads", settings.max_threads);
+  FieldTrialParameter<int> max_frame_delay("max_frame_delay",
+                                           settings.max_frame_delay);
+  ParseFieldTrial({&max_threads, &max_frame_delay},
+                  field_trial::FindFullName("WebRTC-Dav1dDecoder-Threading"));
+  settings.max_threads = std::max(0, max_threads.Get());
+  settings.max_frame_delay = std::max(1, max_frame_delay.Get());
+  return settings;
+}
+
+Dav1dDecoder::Dav1dDecoder(const Dav1dDecoderSettings& settings)
+    : settings_(settings) {}
 
 Dav1dDecoder::~Dav1dDecoder() {
   Release();
@@ -85,7 +116,10 @@ bool Dav1dDecoder::Configure(const Settings& settings) {
   dav1d_default_settings(&s);
 
   s.n_threads = std::max(2, settings.number_of_cores());
-  s.max_frame_delay = 1;   // For low latency decoding.
+  if (settings_.max_threads > 0) {
+    s.n_threads = std::min(s.n_threads, settings_.max_threads);
+  }
+  s.max_frame_delay = settings_.max_frame_delay;
   s.all_layers = 0;        // Don't output a frame for every spatial layer.
   s.operating_point = 31;  // Decode all operating points.
 
@@ -99,6 +133,7 @@ int32_t Dav1dDecoder::RegisterDecodeCompleteCallback(
 }
 
 int32_t Dav1dDecoder::Release() {
+  pending_frames_.clear();
   dav1d_close(&context_);
   if (context_ != nullptr) {
     return WEBRTC_VIDEO_CODEC_MEMORY;
@@ -128,77 +163,130 @@ int32_t Dav1dDecoder::Decode(const EncodedImage& encoded_image,
   dav1d_data_wrap(&dav1d_data, encoded_image.data(), encoded_image.size(),
                   /*free_callback=*/&NullFreeCallback,
                   /*user_data=*/nullptr);
-
-  if (int decode_res = dav1d_send_data(context_, &dav1d_data)) {
-    RTC_LOG(LS_WARNING)
-        << "Dav1dDecoder::Decode decoding failed with error code "
-        << decode_res;
-    return WEBRTC_VIDEO_CODEC_ERROR;
-  }
-
-  rtc::scoped_refptr<ScopedDav1dPicture> scoped_dav1d_picture(
-      new ScopedDav1dPicture{});
-  Dav1dPicture& dav1d_picture = scoped_dav1d_picture->Picture();
-  if (int get_picture_res = dav1d_get_picture(context_, &dav1d_picture)) {
-    RTC_LOG(LS_WARNING)
-        << "Dav1dDecoder::Decode getting picture failed with error code "
-        << get_picture_res;
-    return WEBRTC_VIDEO_CODEC_ERROR;
-  }
-
-  if (dav1d_picture.p.bpc != 8) {
-    // Only accept 8 bit depth.
-    RTC_LOG(LS_ERROR) << "Dav1dDecoder::Decode unhandled bit depth: "
-                      << dav1d_picture.p.bpc;
-    return WEBRTC_VIDEO_CODEC_ERROR;
+  dav1d_data.m.timestamp = encoded_image.RtpTimestamp();
+  pending_frames_.push_back(
+      {encoded_image.RtpTimestamp(), encoded_image.ntp_time_ms_,
+       encoded_image.ColorSpace()
+           ? absl::make_optional(*encoded_image.ColorSpace())
+           : absl::nullopt});
+
+  // With frame threading dav1d refuses new data while all its frame slots are
+  // busy. Finished pictures have to be taken out before it accepts more.
+  while (dav1d_data.sz > 0) {
+    int decode_res = dav1d_send_data(context_, &dav1d_data);
+    if (decode_res == DAV1D_ERR(EAGAIN)) {
+      const size_t num_pending = pending_frames_.size();
+      int32_t deliver_res = DeliverPictures();
+      if (deliver_res != WEBRTC_VIDEO_CODEC_OK) {
+        return deliver_res;
+      }
+      if (pending_frames_.size() == num_pending) {
+        RTC_LOG(LS_WARNING) << "Dav1dDecoder::Decode decoder is stalled";
+        return WEBRTC_VIDEO_CODEC_ERROR;
+      }
+      continue;
+    }
+    if (decode_res) {
+      RTC_LOG(LS_WARNING)
+          << "Dav1dDecoder::Decode decoding failed with error code "
+          << decode_res;
+      return WEBRTC_VIDEO_CODEC_ERROR;
+    }
   }
 
-  rtc::scoped_refptr<VideoFrameBuffer> wrapped_buffer;
-  if (dav1d_picture.p.layout == DAV1D_PIXEL_LAYOUT_I420) {
-    wrapped_buffer = WrapI420Buffer(
-        dav1d_picture.p.w, dav1d_picture.p.h,
-        static_cast<uint8_t*>(dav1d_picture.data[0]), dav1d_picture.stride[0],
-        static_cast<uint8_t*>(dav1d_picture.data[1]), dav1d_picture.stride[1],
-        static_cast<uint8_t*>(dav1d_picture.data[2]), dav1d_picture.stride[1],
-        // To keep |scoped_dav1d_picture.Picture()| alive
-        [scoped_dav1d_picture] {});
-  } else if (dav1d_picture.p.layout == DAV1D_PIXEL_LAYOUT_I444) {
-    wrapped_buffer = WrapI444Buffer(
-        dav1d_picture.p.w, dav1d_picture.p.h,
-        static_cast<uint8_t*>(dav1d_picture.data[0]), dav1d_picture.stride[0],
-        static_cast<uint8_t*>(dav1d_picture.data[1]), dav1d_picture.stride[1],
-        static_cast<uint8_t*>(dav1d_picture.data[2]), dav1d_picture.stride[1],
-        // To keep |scoped_dav1d_picture.Picture()| alive
-        [scoped_dav1d_picture] {});
-  } else {
-    // Only accept I420 or I444 pixel format.
-    RTC_LOG(LS_ERROR) << "Dav1dDecoder::Decode unhandled pixel layout: "
-                      << dav1d_picture.p.layout;
-    return WEBRTC_VIDEO_CODEC_ERROR;
-  }
+  return DeliverPictures();
+}
 
-  if (!wrapped_buffer.get()) {
-    return WEBRTC_VIDEO_CODEC_ERROR;
+int32_t Dav1dDecoder::DeliverPictures() {
+  while (true) {
+    rtc::scoped_refptr<ScopedDav1dPicture> scoped_dav1d_picture(
+        new ScopedDav1dPicture{});
+    Dav1dPicture& dav1d_picture = scoped_dav1d_picture->Picture();
+    int get_picture_res = dav1d_get_picture(context_, &dav1d_picture);
+    if (get_picture_res == DAV1D_ERR(EAGAIN)) {
+      // No more finished pictures, or the pipeline is still filling up.
+      return WEBRTC_VIDEO_CODEC_OK;
+    }
+    if (get_picture_res) {
+      RTC_LOG(LS_WARNING)
+          << "Dav1dDecoder::Decode getting picture failed with error code "
+          << get_picture_res;
+      return WEBRTC_VIDEO_CODEC_ERROR;
+    }
+
+    // Frames without a shown picture have no entry in the output, skip them.
+    absl::optional<FrameMetadata> metadata;
+    while (!pending_frames_.empty()) {
+      FrameMetadata front = std::move(pending_frames_.front());
+      pending_frames_.pop_front();
+      if (front.rtp_timestamp == dav1d_picture.m.timestamp) {
+        metadata = std::move(front);
+        break;
+      }
+    }
+    if (!metadata) {
+      RTC_LOG(LS_WARNING) << "Dav1dDecoder::Decode unexpected picture "
+                          << dav1d_picture.m.timestamp;
+      continue;
+    }
+
+    if (dav1d_picture.p.bpc != 8) {
+      // Only accept 8 bit depth.
+      RTC_LOG(LS_ERROR) << "Dav1dDecoder::Decode unhandled bit depth: "
+                        << dav1d_picture.p.bpc;
+      return WEBRTC_VIDEO_CODEC_ERROR;
+    }
+
+    rtc::scoped_refptr<VideoFrameBuffer> wrapped_buffer;
+    if (dav1d_picture.p.layout == DAV1D_PIXEL_LAYOUT_I420) {
+      wrapped_buffer = WrapI420Buffer(
+          dav1d_picture.p.w, dav1d_picture.p.h,
+          static_cast<uint8_t*>(dav1d_picture.data[0]), dav1d_picture.stride[0],
+          static_cast<uint8_t*>(dav1d_picture.data[1]), dav1d_picture.stride[1],
+          static_cast<uint8_t*>(dav1d_picture.data[2]), dav1d_picture.stride[1],
+          // To keep |scoped_dav1d_picture.Picture()| alive
+          [scoped_dav1d_picture] {});
+    } else if (dav1d_picture.p.layout == DAV1D_PIXEL_LAYOUT_I444) {
+      wrapped_buffer = WrapI444Buffer(
+          dav1d_picture.p.w, dav1d_picture.p.h,
+          static_cast<uint8_t*>(dav1d_picture.data[0]), dav1d_picture.stride[0],
+          static_cast<uint8_t*>(dav1d_picture.data[1]), dav1d_picture.stride[1],
+          static_cast<uint8_t*>(dav1d_picture.data[2]), dav1d_picture.stride[1],
+          // To keep |scoped_dav1d_picture.Picture()| alive
+          [scoped_dav1d_picture] {});
+    } else {
+      // Only accept I420 or I444 pixel format.
+      RTC_LOG(LS_ERROR) << "Dav1dDecoder::Decode unhandled pixel layout: "
+                        << dav1d_picture.p.layout;
+      return WEBRTC_VIDEO_CODEC_ERROR;
+    }
+
+    if (!wrapped_buffer.get()) {
+      return WEBRTC_VIDEO_CODEC_ERROR;
+    }
+
+    VideoFrame decoded_frame =
+        VideoFrame::Builder()
+            .set_video_frame_buffer(wrapped_buffer)
+            .set_timestamp_rtp(metadata->rtp_timestamp)
+            .set_ntp_time_ms(metadata->ntp_time_ms)
+            .set_color_space(metadata->color_space)
+            .build();
+
+    decode_complete_callback_->Decoded(decoded_frame, absl::nullopt,
+                                       absl::nullopt);
   }
-
-  VideoFrame decoded_frame =
-      VideoFrame::Builder()
-          .set_video_frame_buffer(wrapped_buffer)
-          .set_timestamp_rtp(encoded_image.RtpTimestamp())
-          .set_ntp_time_ms(encoded_image.ntp_time_ms_)
-          .set_color_space(encoded_image.ColorSpace())
-          .build();
-
-  decode_complete_callback_->Decoded(decoded_frame, absl::nullopt,
-                                     absl::nullopt);
-
-  return WEBRTC_VIDEO_CODEC_OK;
 }
 
 }  // namespace
 
 std::unique_ptr<VideoDecoder> CreateDav1dDecoder() {
-  return std::make_unique<Dav1dDecoder>();
+  return CreateDav1dDecoder(GetFieldTrialSettings());
+}
+
+std::unique_ptr<VideoDecoder> CreateDav1dDecoder(
+    const Dav1dDecoderSettings& settings) {
+  return std::make_unique<Dav1dDecoder>(settings);
 }
 
 }  // namespace webrtc
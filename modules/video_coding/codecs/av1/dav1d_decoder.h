@@ -16,7 +16,25 @@
 
 namespace webrtc {
 
+// Trades decoding latency for throughput.
+struct Dav1dDecoderSettings {
+  // Maximum number of threads one decoder uses. 0 picks the count from the
+  // number of cores given to Configure(). Hosts that decode many streams
+  // should cap it, since every decoder owns its threads.
+  int max_threads = 0;
+  // Number of frames dav1d may decode in parallel, which also is how many
+  // frames output may lag behind input. 1 gives the lowest latency and only
+  // uses tile and post-filter threads, which suits interactive receivers.
+  // Larger values enable frame threading, for receivers that record or
+  // forward streams and care about throughput.
+  int max_frame_delay = 1;
+};
+
+// Uses the settings from the "WebRTC-Dav1dDecoder-Threading" field trial, or
+// the defaults above.
 std::unique_ptr<VideoDecoder> CreateDav1dDecoder();
+std::unique_ptr<VideoDecoder> CreateDav1dDecoder(
+    const Dav1dDecoderSettings& settings);
 
 }  // namespace webrtc
 
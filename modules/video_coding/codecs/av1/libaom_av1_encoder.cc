@@ -12,6 +12,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -134,6 +135,7 @@ class LibaomAv1Encoder final : public VideoEncoder {
   // after frame dropping is fully rolled out.
   bool disable_frame_dropping_;
   int max_consec_frame_drop_;
+  VideoEncoder::Settings::ThreadingPolicy threading_policy_;
 };
 
 int32_t VerifyCodecSettings(const VideoCodec& codec_settings) {
@@ -205,6 +207,7 @@ int LibaomAv1Encoder::InitEncode(const VideoCodec* codec_settings,
     Release();
   }
   encoder_settings_ = *codec_settings;
+  threading_policy_ = settings.threading_policy;
 
   // Sanity checks for encoder configuration.
   const int32_t result = VerifyCodecSettings(encoder_settings_);
@@ -246,7 +249,10 @@ int LibaomAv1Encoder::InitEncode(const VideoCodec* codec_settings,
   cfg_.g_w = encoder_settings_.width;
   cfg_.g_h = encoder_settings_.height;
   cfg_.g_threads =
-      NumberOfThreads(cfg_.g_w, cfg_.g_h, settings.number_of_cores);
+      threading_policy_.num_threads
+          ? std::max(1, std::min(*threading_policy_.num_threads,
+                                 settings.number_of_cores))
+          : NumberOfThreads(cfg_.g_w, cfg_.g_h, settings.number_of_cores);
   cfg_.g_timebase.num = 1;
   cfg_.g_timebase.den = kRtpTicksPerSecond;
   cfg_.rc_target_bitrate = encoder_settings_.startBitrate;  // kilobits/sec.
@@ -313,7 +319,10 @@ int LibaomAv1Encoder::InitEncode(const VideoCodec* codec_settings,
                                       max_consec_frame_drop_);
   }
 
-  if (cfg_.g_threads == 8) {
+  if (threading_policy_.log2_tile_columns) {
+    SET_ENCODER_PARAM_OR_RETURN_ERROR(AV1E_SET_TILE_COLUMNS,
+                                      *threading_policy_.log2_tile_columns);
+  } else if (cfg_.g_threads == 8) {
     // Values passed to AV1E_SET_TILE_ROWS and AV1E_SET_TILE_COLUMNS are log2()
     // based.
     // Use 4 tile columns x 2 tile rows for 8 threads.
@@ -328,7 +337,8 @@ int LibaomAv1Encoder::InitEncode(const VideoCodec* codec_settings,
                                       static_cast<int>(log2(cfg_.g_threads)));
   }
 
-  SET_ENCODER_PARAM_OR_RETURN_ERROR(AV1E_SET_ROW_MT, 1);
+  SET_ENCODER_PARAM_OR_RETURN_ERROR(
+      AV1E_SET_ROW_MT, threading_policy_.row_mt.value_or(true) ? 1 : 0);
   SET_ENCODER_PARAM_OR_RETURN_ERROR(AV1E_SET_ENABLE_OBMC, 0);
   SET_ENCODER_PARAM_OR_RETURN_ERROR(AV1E_SET_NOISE_SENSITIVITY, 0);
   SET_ENCODER_PARAM_OR_RETURN_ERROR(AV1E_SET_ENABLE_WARPED_MOTION, 0);
@@ -377,6 +387,9 @@ bool LibaomAv1Encoder::SetEncoderControlParameters(int param_id,
 // Only positive speeds, range for real-time coding currently is: 6 - 8.
 // Lower means slower/better quality, higher means fastest/lower quality.
 int LibaomAv1Encoder::GetCpuSpeed(int width, int height) {
+  if (absl::optional<int> speed = threading_policy_.GetSpeed(width * height)) {
+    return *speed;
+  }
   if (aux_config_) {
     if (auto it = aux_config_->max_pixel_count_to_cpu_speed.lower_bound(width *
                                                                         height);
@@ -844,6 +857,7 @@ VideoEncoder::EncoderInfo LibaomAv1Encoder::GetEncoderInfo() const {
   info.implementation_name = "libaom";
   info.has_trusted_rate_controller = true;
   info.is_hardware_accelerated = false;
+  info.num_threads = inited_ ? static_cast<int>(cfg_.g_threads) : 1;
   info.scaling_settings =
       (inited_ && !encoder_settings_.AV1().automatic_resize_on)
           ? VideoEncoder::ScalingSettings::kOff
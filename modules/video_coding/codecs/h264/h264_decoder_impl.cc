@@ -33,6 +33,7 @@ extern "C" {
 #include "modules/video_coding/codecs/h264/h264_color_space.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
+#include "system_wrappers/include/field_trial.h"
 #include "system_wrappers/include/metrics.h"
 
 namespace webrtc {
@@ -47,6 +48,9 @@ const size_t kYPlaneIndex = 0;
 const size_t kUPlaneIndex = 1;
 const size_t kVPlaneIndex = 2;
 
+const char kSharedFrameBufferPoolFieldTrial[] =
+    "WebRTC-Video-SharedFrameBufferPool";
+
 // Used by histograms. Values of entries should not be changed.
 enum H264DecoderImplEvent {
   kH264DecoderEventInit = 0,
@@ -261,7 +265,12 @@ void H264DecoderImpl::AVFreeBuffer2(void* opaque, uint8_t* data) {
 }
 
 H264DecoderImpl::H264DecoderImpl()
-    : ffmpeg_buffer_pool_(true),
+    : ffmpeg_buffer_pool_(
+          true,
+          std::numeric_limits<size_t>::max(),
+          field_trial::IsEnabled(kSharedFrameBufferPoolFieldTrial)
+              ? &SharedVideoFrameBufferPool::Default()
+              : nullptr),
       decoded_image_callback_(nullptr),
       has_reported_init_(false),
       has_reported_error_(false) {}
@@ -237,6 +237,7 @@ int32_t H264EncoderImpl::InitEncode(const VideoCodec* inst,
   max_payload_size_ = settings.max_payload_size;
   number_of_cores_ = settings.number_of_cores;
   encoder_thread_limit_ = settings.encoder_thread_limit;
+  policy_num_threads_ = settings.threading_policy.num_threads;
   codec_ = *inst;
 
   // Code expects simulcastStream resolutions to be correct, make sure they are
@@ -648,9 +649,7 @@ SEncParamExt H264EncoderImpl::CreateEncoderParams(size_t i) const {
   //  0: auto (dynamic imp. internal encoder)
   //  1: single thread (default value)
   // >1: number of threads
-  encoder_params.iMultipleThreadIdc =
-      NumberOfThreads(encoder_thread_limit_, encoder_params.iPicWidth,
-                      encoder_params.iPicHeight, number_of_cores_);
+  encoder_params.iMultipleThreadIdc = NumberOfEncoderThreads(i);
   // The base spatial layer 0 is the only one we use.
   encoder_params.sSpatialLayers[0].iVideoWidth = encoder_params.iPicWidth;
   encoder_params.sSpatialLayers[0].iVideoHeight = encoder_params.iPicHeight;
@@ -711,6 +710,14 @@ void H264EncoderImpl::ReportError() {
   has_reported_error_ = true;
 }
 
+int H264EncoderImpl::NumberOfEncoderThreads(size_t i) const {
+  if (policy_num_threads_) {
+    return std::max(1, std::min(*policy_num_threads_, number_of_cores_));
+  }
+  return NumberOfThreads(encoder_thread_limit_, configurations_[i].width,
+                         configurations_[i].height, number_of_cores_);
+}
+
 VideoEncoder::EncoderInfo H264EncoderImpl::GetEncoderInfo() const {
   EncoderInfo info;
   info.supports_native_handle = false;
@@ -718,6 +725,10 @@ VideoEncoder::EncoderInfo H264EncoderImpl::GetEncoderInfo() const {
   info.scaling_settings =
       VideoEncoder::ScalingSettings(kLowH264QpThreshold, kHighH264QpThreshold);
   info.is_hardware_accelerated = false;
+  // Simulcast layers are encoded one after the other.
+  for (size_t i = 0; i < configurations_.size(); ++i) {
+    info.num_threads = std::max(info.num_threads, NumberOfEncoderThreads(i));
+  }
   info.supports_simulcast = true;
   info.preferred_pixel_formats = {VideoFrameBuffer::Type::kI420};
   return info;
@@ -91,6 +91,8 @@ class H264EncoderImpl : public H264Encoder {
 
  private:
   SEncParamExt CreateEncoderParams(size_t i) const;
+  // Number of threads to encode layer `i` with.
+  int NumberOfEncoderThreads(size_t i) const;
 
   webrtc::H264BitstreamParser h264_bitstream_parser_;
   // Reports statistics with histograms.
@@ -111,6 +113,7 @@ class H264EncoderImpl : public H264Encoder {
   size_t max_payload_size_;
   int32_t number_of_cores_;
   absl::optional<int> encoder_thread_limit_;
+  absl::optional<int> policy_num_threads_;
   EncodedImageCallback* encoded_image_callback_;
 
   bool has_reported_init_;
@@ -8,6 +8,7 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <cstdio>
 #include <memory>
 #include <string>
 #include <vector>
@@ -69,6 +70,23 @@ ABSL_FLAG(bool, dump_decoder_output, false, "Dump decoder output.");
 ABSL_FLAG(bool, dump_encoder_input, false, "Dump encoder input.");
 ABSL_FLAG(bool, dump_encoder_output, false, "Dump encoder output.");
 ABSL_FLAG(bool, write_csv, false, "Write metrics to a CSV file.");
+ABSL_FLAG(int,
+          num_instances,
+          1,
+          "Throughput test: number of concurrent encoder/decoder pairs.");
+ABSL_FLAG(std::vector<std::string>,
+          resolutions,
+          {"1280x720"},
+          "Throughput test: resolutions (WxH) to sweep.");
+ABSL_FLAG(std::vector<std::string>,
+          complexities,
+          {"0"},
+          "Throughput test: encoder complexities to sweep, from -1 (low) to 3 "
+          "(max). Software encoders map these to their speed presets.");
+ABSL_FLAG(std::vector<std::string>,
+          num_cores,
+          {"1"},
+          "Throughput test: number of cores per encoder and decoder to sweep.");
 
 namespace webrtc {
 namespace test {
@@ -164,6 +182,13 @@ std::unique_ptr<VideoDecoderFactory> CreateDecoderFactory(std::string impl) {
 #endif
 }
 
+std::vector<int> ParseIntList(const std::vector<std::string>& list) {
+  std::vector<int> values;
+  std::transform(list.begin(), list.end(), std::back_inserter(values),
+                 [](const std::string& str) { return std::stoi(str); });
+  return values;
+}
+
 std::string TestName() {
   std::string test_name = absl::GetFlag(FLAGS_test_name);
   if (!test_name.empty()) {
@@ -539,11 +564,8 @@ TEST(VideoCodecTest, DISABLED_EncodeDecode) {
       CreateEnvironment(std::make_unique<ExplicitKeyValueConfig>(
           absl::GetFlag(FLAGS_field_trials)));
 
-  std::vector<std::string> bitrate_str = absl::GetFlag(FLAGS_bitrate_kbps);
-  std::vector<int> bitrate_kbps;
-  std::transform(bitrate_str.begin(), bitrate_str.end(),
-                 std::back_inserter(bitrate_kbps),
-                 [](const std::string& str) { return std::stoi(str); });
+  std::vector<int> bitrate_kbps =
+      ParseIntList(absl::GetFlag(FLAGS_bitrate_kbps));
 
   std::map<uint32_t, EncodingSettings> frames_settings =
       VideoCodecTester::CreateEncodingSettings(
@@ -592,6 +614,80 @@ TEST(VideoCodecTest, DISABLED_EncodeDecode) {
   }
 }
 
+// Runs `--num_instances` encoder/decoder pairs concurrently without pacing,
+// for every combination of `--resolutions`, `--complexities` and
+// `--num_cores`, and logs the aggregate frame rate per core and the latency
+// distribution of each combination.
+TEST(VideoCodecTest, DISABLED_Throughput) {
+  ScopedFieldTrials field_trials(absl::GetFlag(FLAGS_field_trials));
+  const Environment env =
+      CreateEnvironment(std::make_unique<ExplicitKeyValueConfig>(
+          absl::GetFlag(FLAGS_field_trials)));
+
+  std::unique_ptr<VideoEncoderFactory> encoder_factory =
+      CreateEncoderFactory(CodecNameToCodecImpl(absl::GetFlag(FLAGS_encoder)));
+  std::unique_ptr<VideoDecoderFactory> decoder_factory =
+      CreateDecoderFactory(CodecNameToCodecImpl(absl::GetFlag(FLAGS_decoder)));
+  ASSERT_NE(nullptr, encoder_factory);
+  ASSERT_NE(nullptr, decoder_factory);
+
+  const VideoInfo& video_info = kRawVideos.at(absl::GetFlag(FLAGS_video_name));
+  VideoSourceSettings source_settings{
+      .file_path = ResourcePath(video_info.name, "yuv"),
+      .resolution = video_info.resolution,
+      .framerate = video_info.framerate};
+  const int num_instances = absl::GetFlag(FLAGS_num_instances);
+  std::vector<int> bitrate_kbps =
+      ParseIntList(absl::GetFlag(FLAGS_bitrate_kbps));
+
+  for (const std::string& resolution : absl::GetFlag(FLAGS_resolutions)) {
+    int width = 0;
+    int height = 0;
+    ASSERT_EQ(sscanf(resolution.c_str(), "%dx%d", &width, &height), 2)
+        << "Invalid resolution " << resolution;
+    for (int complexity : ParseIntList(absl::GetFlag(FLAGS_complexities))) {
+      for (int num_cores : ParseIntList(absl::GetFlag(FLAGS_num_cores))) {
+        std::map<uint32_t, EncodingSettings> frames_settings =
+            VideoCodecTester::CreateEncodingSettings(
+                CodecNameToCodecType(absl::GetFlag(FLAGS_encoder)),
+                absl::GetFlag(FLAGS_scalability_mode), width, height,
+                bitrate_kbps, absl::GetFlag(FLAGS_framerate_fps),
+                absl::GetFlag(FLAGS_num_frames));
+
+        VideoCodecTester::EncoderSettings encoder_settings;
+        encoder_settings.number_of_cores = num_cores;
+        encoder_settings.complexity =
+            static_cast<VideoCodecComplexity>(complexity);
+        VideoCodecTester::DecoderSettings decoder_settings;
+        decoder_settings.number_of_cores = num_cores;
+
+        VideoCodecTester::ThroughputStats stats =
+            VideoCodecTester::RunThroughputTest(
+                env, source_settings, encoder_factory.get(),
+                decoder_factory.get(), encoder_settings, decoder_settings,
+                frames_settings, num_instances);
+
+        std::string metric_name_prefix =
+            (rtc::StringBuilder() << resolution << "_complexity" << complexity
+                                  << "_cores" << num_cores << "_")
+                .str();
+        stats.LogMetrics(GetGlobalMetricsLogger(), TestName(),
+                         metric_name_prefix,
+                         /*metadata=*/
+                         {{"encoder", absl::GetFlag(FLAGS_encoder)},
+                          {"decoder", absl::GetFlag(FLAGS_decoder)},
+                          {"resolution", resolution},
+                          {"complexity", std::to_string(complexity)},
+                          {"num_cores", std::to_string(num_cores)},
+                          {"num_instances", std::to_string(num_instances)}});
+        RTC_LOG(LS_INFO) << metric_name_prefix << "fps=" << stats.fps()
+                         << " fps_per_core=" << stats.fps_per_core()
+                         << " num_instances=" << num_instances;
+      }
+    }
+  }
+}
+
 }  // namespace test
 
 }  // namespace webrtc
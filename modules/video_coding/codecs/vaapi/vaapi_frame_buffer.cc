@@ -0,0 +1,130 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/codecs/vaapi/vaapi_frame_buffer.h"
+
+extern "C" {
+#include "third_party/ffmpeg/libavutil/frame.h"
+#include "third_party/ffmpeg/libavutil/hwcontext.h"
+#include "third_party/ffmpeg/libavutil/hwcontext_drm.h"
+}  // extern "C"
+
+#include "api/make_ref_counted.h"
+#include "api/video/i420_buffer.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "third_party/libyuv/include/libyuv/convert.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr uint32_t FourCC(char a, char b, char c, char d) {
+  return static_cast<uint32_t>(a) | (static_cast<uint32_t>(b) << 8) |
+         (static_cast<uint32_t>(c) << 16) | (static_cast<uint32_t>(d) << 24);
+}
+
+// Values of DRM_FORMAT_NV12 and DRM_FORMAT_P010 from drm_fourcc.h.
+constexpr uint32_t kDrmFormatNV12 = FourCC('N', 'V', '1', '2');
+constexpr uint32_t kDrmFormatP010 = FourCC('P', '0', '1', '0');
+
+uint32_t SurfaceDrmFormat(const AVFrame& surface_frame) {
+  if (!surface_frame.hw_frames_ctx) {
+    return 0;
+  }
+  const AVHWFramesContext* frames_context =
+      reinterpret_cast<const AVHWFramesContext*>(
+          surface_frame.hw_frames_ctx->data);
+  switch (frames_context->sw_format) {
+    case AV_PIX_FMT_NV12:
+      return kDrmFormatNV12;
+    case AV_PIX_FMT_P010:
+      return kDrmFormatP010;
+    default:
+      return 0;
+  }
+}
+
+}  // namespace
+
+// static
+rtc::scoped_refptr<VaapiFrameBuffer> VaapiFrameBuffer::Create(
+    AVFrame* surface_frame,
+    AVFrame* drm_frame) {
+  return rtc::make_ref_counted<VaapiFrameBuffer>(surface_frame, drm_frame);
+}
+
+VaapiFrameBuffer::VaapiFrameBuffer(AVFrame* surface_frame, AVFrame* drm_frame)
+    : surface_frame_(surface_frame), drm_frame_(drm_frame) {
+  RTC_DCHECK(surface_frame_);
+  drm_format_ = SurfaceDrmFormat(*surface_frame_);
+  if (!drm_frame_) {
+    return;
+  }
+  // VA-API exports NV12 and P010 surfaces as one layer per plane, so the
+  // planes are collected across layers.
+  const AVDRMFrameDescriptor* descriptor =
+      reinterpret_cast<const AVDRMFrameDescriptor*>(drm_frame_->data[0]);
+  modifier_ = descriptor->objects[0].format_modifier;
+  for (int i = 0; i < descriptor->nb_layers; ++i) {
+    const AVDRMLayerDescriptor& layer = descriptor->layers[i];
+    for (int j = 0; j < layer.nb_planes; ++j) {
+      const AVDRMPlaneDescriptor& plane = layer.planes[j];
+      planes_.push_back({descriptor->objects[plane.object_index].fd,
+                         static_cast<uint32_t>(plane.offset),
+                         static_cast<uint32_t>(plane.pitch)});
+    }
+  }
+}
+
+VaapiFrameBuffer::~VaapiFrameBuffer() {
+  // The mapping references the surface, so it goes first.
+  av_frame_free(&drm_frame_);
+  av_frame_free(&surface_frame_);
+}
+
+VideoFrameBuffer::Type VaapiFrameBuffer::type() const {
+  return Type::kNative;
+}
+
+int VaapiFrameBuffer::width() const {
+  return surface_frame_->width;
+}
+
+int VaapiFrameBuffer::height() const {
+  return surface_frame_->height;
+}
+
+rtc::scoped_refptr<I420BufferInterface> VaapiFrameBuffer::ToI420() {
+  AVFrame* nv12_frame = av_frame_alloc();
+  if (!nv12_frame) {
+    return nullptr;
+  }
+  nv12_frame->format = AV_PIX_FMT_NV12;
+  const int result = av_hwframe_transfer_data(nv12_frame, surface_frame_, 0);
+  if (result < 0) {
+    RTC_LOG(LS_ERROR) << "Failed to download VA-API surface: " << result;
+    av_frame_free(&nv12_frame);
+    return nullptr;
+  }
+
+  rtc::scoped_refptr<I420Buffer> i420_buffer =
+      I420Buffer::Create(width(), height());
+  libyuv::NV12ToI420(nv12_frame->data[0], nv12_frame->linesize[0],
+                     nv12_frame->data[1], nv12_frame->linesize[1],
+                     i420_buffer->MutableDataY(), i420_buffer->StrideY(),
+                     i420_buffer->MutableDataU(), i420_buffer->StrideU(),
+                     i420_buffer->MutableDataV(), i420_buffer->StrideV(),
+                     width(), height());
+  av_frame_free(&nv12_frame);
+  return i420_buffer;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,74 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CODING_CODECS_VAAPI_VAAPI_FRAME_BUFFER_H_
+#define MODULES_VIDEO_CODING_CODECS_VAAPI_VAAPI_FRAME_BUFFER_H_
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "api/scoped_refptr.h"
+#include "api/video/video_frame_buffer.h"
+#include "rtc_base/system/rtc_export.h"
+
+struct AVFrame;
+
+namespace webrtc {
+
+// A frame decoded by the VA-API decoder that still lives in the VA surface it
+// was decoded into. Renderers and encoders that can import DMA-BUFs check for
+// type() == kNative, downcast and use planes(). Everyone else gets the pixels
+// through ToI420(), which downloads the surface on the calling thread rather
+// than the decoder thread.
+//
+// The surface is returned to the decoder's pool when the frame buffer is
+// destroyed, so holding on to frames stalls decoding.
+class RTC_EXPORT VaapiFrameBuffer : public VideoFrameBuffer {
+ public:
+  struct Plane {
+    int fd;
+    uint32_t offset;
+    uint32_t pitch;
+  };
+
+  // Takes ownership of `surface_frame`, a decoded AV_PIX_FMT_VAAPI frame, and
+  // `drm_frame`, its AV_PIX_FMT_DRM_PRIME mapping, or null if the surface
+  // couldn't be exported.
+  static rtc::scoped_refptr<VaapiFrameBuffer> Create(AVFrame* surface_frame,
+                                                     AVFrame* drm_frame);
+
+  Type type() const override;
+  int width() const override;
+  int height() const override;
+  rtc::scoped_refptr<I420BufferInterface> ToI420() override;
+
+  // DRM fourcc of the surface, e.g. DRM_FORMAT_NV12, or 0 if it isn't known.
+  uint32_t drm_format() const { return drm_format_; }
+  uint64_t modifier() const { return modifier_; }
+  // DMA-BUF planes of the surface, in plane order. The file descriptors are
+  // owned by the frame buffer. Empty if the surface couldn't be exported.
+  const std::vector<Plane>& planes() const { return planes_; }
+
+ protected:
+  VaapiFrameBuffer(AVFrame* surface_frame, AVFrame* drm_frame);
+  ~VaapiFrameBuffer() override;
+
+ private:
+  AVFrame* surface_frame_;
+  AVFrame* drm_frame_;
+  uint32_t drm_format_ = 0;
+  uint64_t modifier_ = 0;
+  std::vector<Plane> planes_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CODING_CODECS_VAAPI_VAAPI_FRAME_BUFFER_H_
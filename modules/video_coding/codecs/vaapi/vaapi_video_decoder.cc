@@ -0,0 +1,319 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/codecs/vaapi/vaapi_video_decoder.h"
+
+#include <limits>
+#include <memory>
+
+extern "C" {
+#include "third_party/ffmpeg/libavcodec/avcodec.h"
+#include "third_party/ffmpeg/libavutil/hwcontext.h"
+}  // extern "C"
+
+#include "absl/types/optional.h"
+#include "api/scoped_refptr.h"
+#include "api/video/encoded_image.h"
+#include "api/video/video_frame.h"
+#include "api/video_codecs/video_codec.h"
+#include "common_video/h264/h264_bitstream_parser.h"
+#include "modules/video_coding/codecs/vaapi/vaapi_frame_buffer.h"
+#include "modules/video_coding/include/video_error_codes.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+namespace {
+
+constexpr char kVaapiName[] = "VA-API";
+
+// Surfaces allocated on top of what the codec needs for reference frames.
+// Decoded frames keep their surface until they are rendered, so without these
+// the pool runs dry as soon as a few frames are queued for rendering.
+constexpr int kExtraHwFrames = 8;
+
+struct AVCodecContextDeleter {
+  void operator()(AVCodecContext* context) const {
+    avcodec_free_context(&context);
+  }
+};
+struct AVBufferDeleter {
+  void operator()(AVBufferRef* buffer) const { av_buffer_unref(&buffer); }
+};
+struct AVFrameDeleter {
+  void operator()(AVFrame* frame) const { av_frame_free(&frame); }
+};
+struct AVPacketDeleter {
+  void operator()(AVPacket* packet) const { av_packet_free(&packet); }
+};
+
+const AVCodec* FindDecoder(VideoCodecType codec_type) {
+  switch (codec_type) {
+    case kVideoCodecH264:
+      return avcodec_find_decoder(AV_CODEC_ID_H264);
+    case kVideoCodecAV1:
+      // Only FFmpeg's native AV1 decoder supports hwaccel, libdav1d doesn't.
+      return avcodec_find_decoder_by_name("av1");
+    default:
+      return nullptr;
+  }
+}
+
+bool SupportsVaapiDevice(const AVCodec* codec) {
+  for (int i = 0;; ++i) {
+    const AVCodecHWConfig* config = avcodec_get_hw_config(codec, i);
+    if (!config) {
+      return false;
+    }
+    if (config->device_type == AV_HWDEVICE_TYPE_VAAPI &&
+        (config->methods & AV_CODEC_HW_CONFIG_METHOD_HW_DEVICE_CTX)) {
+      return true;
+    }
+  }
+}
+
+// Opens the default DRM render node.
+std::unique_ptr<AVBufferRef, AVBufferDeleter> CreateVaapiDevice() {
+  AVBufferRef* device = nullptr;
+  const int result = av_hwdevice_ctx_create(&device, AV_HWDEVICE_TYPE_VAAPI,
+                                            /*device=*/nullptr,
+                                            /*opts=*/nullptr, /*flags=*/0);
+  if (result < 0) {
+    RTC_LOG(LS_INFO) << "Failed to open VA-API device: " << result;
+    return nullptr;
+  }
+  return std::unique_ptr<AVBufferRef, AVBufferDeleter>(device);
+}
+
+bool ProbeVaapiDecoder(VideoCodecType codec_type) {
+  const AVCodec* codec = FindDecoder(codec_type);
+  if (!codec || !SupportsVaapiDevice(codec)) {
+    return false;
+  }
+  return CreateVaapiDevice() != nullptr;
+}
+
+class VaapiVideoDecoder : public VideoDecoder {
+ public:
+  explicit VaapiVideoDecoder(VideoCodecType codec_type);
+  VaapiVideoDecoder(const VaapiVideoDecoder&) = delete;
+  VaapiVideoDecoder& operator=(const VaapiVideoDecoder&) = delete;
+
+  ~VaapiVideoDecoder() override;
+
+  bool Configure(const Settings& settings) override;
+  int32_t Decode(const EncodedImage& encoded_image,
+                 int64_t render_time_ms) override;
+  int32_t RegisterDecodeCompleteCallback(
+      DecodedImageCallback* callback) override;
+  int32_t Release() override;
+  DecoderInfo GetDecoderInfo() const override;
+  const char* ImplementationName() const override;
+
+ private:
+  // Called by FFmpeg to pick the output format. Anything but VA-API surfaces
+  // means the hardware can't decode the stream.
+  static AVPixelFormat GetFormat(AVCodecContext* context,
+                                 const AVPixelFormat* formats);
+
+  const VideoCodecType codec_type_;
+  std::unique_ptr<AVCodecContext, AVCodecContextDeleter> context_;
+  DecodedImageCallback* decode_complete_callback_ = nullptr;
+  // Set by GetFormat() when the stream isn't supported by the hardware.
+  bool hw_format_rejected_ = false;
+  bool has_logged_export_failure_ = false;
+  H264BitstreamParser h264_bitstream_parser_;
+};
+
+VaapiVideoDecoder::VaapiVideoDecoder(VideoCodecType codec_type)
+    : codec_type_(codec_type) {}
+
+VaapiVideoDecoder::~VaapiVideoDecoder() {
+  Release();
+}
+
+bool VaapiVideoDecoder::Configure(const Settings& settings) {
+  Release();
+  if (settings.codec_type() != codec_type_) {
+    return false;
+  }
+  const AVCodec* codec = FindDecoder(codec_type_);
+  if (!codec) {
+    RTC_LOG(LS_ERROR) << "FFmpeg decoder not found for "
+                      << CodecTypeToPayloadString(codec_type_);
+    return false;
+  }
+  std::unique_ptr<AVBufferRef, AVBufferDeleter> device = CreateVaapiDevice();
+  if (!device) {
+    return false;
+  }
+
+  context_.reset(avcodec_alloc_context3(codec));
+  if (!context_) {
+    return false;
+  }
+  const RenderResolution& resolution = settings.max_render_resolution();
+  if (resolution.Valid()) {
+    context_->coded_width = resolution.Width();
+    context_->coded_height = resolution.Height();
+  }
+  context_->hw_device_ctx = av_buffer_ref(device.get());
+  context_->get_format = GetFormat;
+  context_->opaque = this;
+  context_->extra_hw_frames = kExtraHwFrames;
+  // Output every frame as soon as it is decoded. WebRTC streams don't reorder.
+  context_->flags |= AV_CODEC_FLAG_LOW_DELAY;
+  context_->thread_count = 1;
+
+  const int result = avcodec_open2(context_.get(), codec, nullptr);
+  if (result < 0) {
+    RTC_LOG(LS_ERROR) << "avcodec_open2 error: " << result;
+    Release();
+    return false;
+  }
+  return true;
+}
+
+int32_t VaapiVideoDecoder::RegisterDecodeCompleteCallback(
+    DecodedImageCallback* decode_complete_callback) {
+  decode_complete_callback_ = decode_complete_callback;
+  return WEBRTC_VIDEO_CODEC_OK;
+}
+
+int32_t VaapiVideoDecoder::Release() {
+  context_.reset();
+  hw_format_rejected_ = false;
+  return WEBRTC_VIDEO_CODEC_OK;
+}
+
+VideoDecoder::DecoderInfo VaapiVideoDecoder::GetDecoderInfo() const {
+  DecoderInfo info;
+  info.implementation_name = kVaapiName;
+  info.is_hardware_accelerated = true;
+  return info;
+}
+
+const char* VaapiVideoDecoder::ImplementationName() const {
+  return kVaapiName;
+}
+
+// static
+AVPixelFormat VaapiVideoDecoder::GetFormat(AVCodecContext* context,
+                                           const AVPixelFormat* formats) {
+  for (const AVPixelFormat* format = formats; *format != AV_PIX_FMT_NONE;
+       ++format) {
+    if (*format == AV_PIX_FMT_VAAPI) {
+      return *format;
+    }
+  }
+  RTC_LOG(LS_WARNING) << "VA-API can't decode this stream.";
+  static_cast<VaapiVideoDecoder*>(context->opaque)->hw_format_rejected_ = true;
+  return AV_PIX_FMT_NONE;
+}
+
+int32_t VaapiVideoDecoder::Decode(const EncodedImage& encoded_image,
+                                  int64_t /*render_time_ms*/) {
+  if (!context_ || !decode_complete_callback_) {
+    return WEBRTC_VIDEO_CODEC_UNINITIALIZED;
+  }
+  if (!encoded_image.data() || !encoded_image.size()) {
+    return WEBRTC_VIDEO_CODEC_ERR_PARAMETER;
+  }
+  if (encoded_image.size() >
+      static_cast<size_t>(std::numeric_limits<int>::max())) {
+    return WEBRTC_VIDEO_CODEC_ERROR;
+  }
+
+  std::unique_ptr<AVPacket, AVPacketDeleter> packet(av_packet_alloc());
+  if (!packet) {
+    return WEBRTC_VIDEO_CODEC_MEMORY;
+  }
+  // packet.data has a non-const type, but isn't modified by
+  // avcodec_send_packet.
+  packet->data = const_cast<uint8_t*>(encoded_image.data());
+  packet->size = static_cast<int>(encoded_image.size());
+
+  int result = avcodec_send_packet(context_.get(), packet.get());
+  if (hw_format_rejected_) {
+    return WEBRTC_VIDEO_CODEC_FALLBACK_SOFTWARE;
+  }
+  if (result < 0) {
+    RTC_LOG(LS_ERROR) << "avcodec_send_packet error: " << result;
+    return WEBRTC_VIDEO_CODEC_ERROR;
+  }
+
+  std::unique_ptr<AVFrame, AVFrameDeleter> surface_frame(av_frame_alloc());
+  result = avcodec_receive_frame(context_.get(), surface_frame.get());
+  if (result == AVERROR(EAGAIN)) {
+    // No output for this packet, e.g. a frame that is not shown.
+    return WEBRTC_VIDEO_CODEC_OK;
+  }
+  if (result < 0) {
+    RTC_LOG(LS_ERROR) << "avcodec_receive_frame error: " << result;
+    return WEBRTC_VIDEO_CODEC_ERROR;
+  }
+  if (surface_frame->format != AV_PIX_FMT_VAAPI) {
+    RTC_LOG(LS_WARNING) << "Decoded frame is not a VA-API surface.";
+    return WEBRTC_VIDEO_CODEC_FALLBACK_SOFTWARE;
+  }
+
+  // Export the surface as DMA-BUFs. Frames that can't be exported are still
+  // delivered, consumers then have to download them with ToI420().
+  std::unique_ptr<AVFrame, AVFrameDeleter> drm_frame(av_frame_alloc());
+  drm_frame->format = AV_PIX_FMT_DRM_PRIME;
+  result = av_hwframe_map(drm_frame.get(), surface_frame.get(),
+                          AV_HWFRAME_MAP_READ);
+  if (result < 0) {
+    if (!has_logged_export_failure_) {
+      RTC_LOG(LS_WARNING) << "Failed to export VA-API surface: " << result;
+      has_logged_export_failure_ = true;
+    }
+    drm_frame.reset();
+  }
+
+  absl::optional<int> qp;
+  if (codec_type_ == kVideoCodecH264) {
+    h264_bitstream_parser_.ParseBitstream(encoded_image);
+    qp = h264_bitstream_parser_.GetLastSliceQp();
+  }
+
+  VideoFrame decoded_frame =
+      VideoFrame::Builder()
+          .set_video_frame_buffer(VaapiFrameBuffer::Create(
+              surface_frame.release(), drm_frame.release()))
+          .set_timestamp_rtp(encoded_image.RtpTimestamp())
+          .set_color_space(encoded_image.ColorSpace())
+          .build();
+
+  decode_complete_callback_->Decoded(decoded_frame, absl::nullopt, qp);
+  return WEBRTC_VIDEO_CODEC_OK;
+}
+
+}  // namespace
+
+bool IsVaapiDecoderSupported(VideoCodecType codec_type) {
+  switch (codec_type) {
+    case kVideoCodecH264: {
+      static const bool supported = ProbeVaapiDecoder(kVideoCodecH264);
+      return supported;
+    }
+    case kVideoCodecAV1: {
+      static const bool supported = ProbeVaapiDecoder(kVideoCodecAV1);
+      return supported;
+    }
+    default:
+      return false;
+  }
+}
+
+std::unique_ptr<VideoDecoder> CreateVaapiDecoder(VideoCodecType codec_type) {
+  return std::make_unique<VaapiVideoDecoder>(codec_type);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,35 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CODING_CODECS_VAAPI_VAAPI_VIDEO_DECODER_H_
+#define MODULES_VIDEO_CODING_CODECS_VAAPI_VAAPI_VIDEO_DECODER_H_
+
+#include <memory>
+
+#include "api/video/video_codec_type.h"
+#include "api/video_codecs/video_decoder.h"
+
+namespace webrtc {
+
+// Returns true if FFmpeg can decode `codec_type` with VA-API and a VA-API
+// device can be opened. Only H.264 and AV1 are supported. The result is probed
+// once per codec type and cached.
+bool IsVaapiDecoderSupported(VideoCodecType codec_type);
+
+// Creates a hardware decoder that decodes through FFmpeg's VA-API hwaccel and
+// outputs VaapiFrameBuffers. Decode() returns
+// WEBRTC_VIDEO_CODEC_FALLBACK_SOFTWARE for streams the hardware can't decode,
+// so the decoder is meant to be wrapped with
+// CreateVideoDecoderSoftwareFallbackWrapper().
+std::unique_ptr<VideoDecoder> CreateVaapiDecoder(VideoCodecType codec_type);
+
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CODING_CODECS_VAAPI_VAAPI_VIDEO_DECODER_H_
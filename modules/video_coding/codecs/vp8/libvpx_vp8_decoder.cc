@@ -44,6 +44,8 @@ constexpr long kDecodeDeadlineRealtime = 1;  // NOLINT
 
 const char kVp8PostProcArmFieldTrial[] = "WebRTC-VP8-Postproc-Config-Arm";
 const char kVp8PostProcFieldTrial[] = "WebRTC-VP8-Postproc-Config";
+const char kSharedFrameBufferPoolFieldTrial[] =
+    "WebRTC-Video-SharedFrameBufferPool";
 
 #if defined(WEBRTC_ARCH_ARM) || defined(WEBRTC_ARCH_ARM64) || \
     defined(WEBRTC_ANDROID)
@@ -117,7 +119,12 @@ LibvpxVp8Decoder::LibvpxVp8Decoder()
     : use_postproc_(
           kIsArm ? webrtc::field_trial::IsEnabled(kVp8PostProcArmFieldTrial)
                  : true),
-      buffer_pool_(false, 300 /* max_number_of_buffers*/),
+      buffer_pool_(false,
+                   300 /* max_number_of_buffers*/,
+                   webrtc::field_trial::IsEnabled(
+                       kSharedFrameBufferPoolFieldTrial)
+                       ? &SharedVideoFrameBufferPool::Default()
+                       : nullptr),
       decode_complete_callback_(NULL),
       inited_(false),
       decoder_(NULL),
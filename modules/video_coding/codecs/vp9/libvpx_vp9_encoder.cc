@@ -559,6 +559,9 @@ int LibvpxVp9Encoder::InitEncode(const VideoCodec* inst,
   absl::optional<vpx_img_fmt_t> previous_img_fmt =
       raw_ ? absl::make_optional<vpx_img_fmt_t>(raw_->fmt) : absl::nullopt;
 
+  active_map_valid_ = false;
+  active_map_enabled_ = false;
+
   int ret_val = Release();
   if (ret_val < 0) {
     return ret_val;
@@ -575,6 +578,7 @@ int LibvpxVp9Encoder::InitEncode(const VideoCodec* inst,
   if (&codec_ != inst) {
     codec_ = *inst;
   }
+  threading_policy_ = settings.threading_policy;
   memset(&svc_params_, 0, sizeof(vpx_svc_extra_cfg_t));
 
   force_key_frame_ = true;
@@ -696,7 +700,11 @@ int LibvpxVp9Encoder::InitEncode(const VideoCodec* inst,
   }
   // Determine number of threads based on the image size and #cores.
   config_->g_threads =
-      NumberOfThreads(config_->g_w, config_->g_h, settings.number_of_cores);
+      threading_policy_.num_threads
+          ? std::max(1, std::min(*threading_policy_.num_threads,
+                                 settings.number_of_cores))
+          : NumberOfThreads(config_->g_w, config_->g_h,
+                            settings.number_of_cores);
 
   is_flexible_mode_ = inst->VP9().flexibleMode;
 
@@ -949,10 +957,12 @@ int LibvpxVp9Encoder::InitAndSetControlSettings(const VideoCodec* inst) {
   // The number tile columns will be capped by the encoder based on image size
   // (minimum width of tile column is 256 pixels, maximum is 4096).
   libvpx_->codec_control(encoder_, VP9E_SET_TILE_COLUMNS,
-                         static_cast<int>((config_->g_threads >> 1)));
+                         threading_policy_.log2_tile_columns.value_or(
+                             static_cast<int>(config_->g_threads >> 1)));
 
-  // Turn on row-based multithreading.
-  libvpx_->codec_control(encoder_, VP9E_SET_ROW_MT, 1);
+  // Turn on row-based multithreading, unless disabled by the settings.
+  libvpx_->codec_control(encoder_, VP9E_SET_ROW_MT,
+                         threading_policy_.row_mt.value_or(true) ? 1 : 0);
 
   if (AllowDenoising() && !performance_flags_.use_per_layer_speed) {
     libvpx_->codec_control(encoder_, VP9E_SET_NOISE_SENSITIVITY,
@@ -998,6 +1008,10 @@ int LibvpxVp9Encoder::Encode(const VideoFrame& input_image,
     return WEBRTC_VIDEO_CODEC_OK;
   }
 
+  // Done before any frame dropping, so that the changes of dropped frames are
+  // encoded with the next picture.
+  UpdateActiveMap(input_image);
+
   // We only support one stream at the moment.
   if (frame_types && !frame_types->empty()) {
     if ((*frame_types)[0] == VideoFrameType::kVideoFrameKey) {
@@ -1141,10 +1155,11 @@ int LibvpxVp9Encoder::Encode(const VideoFrame& input_image,
                       svc_params_.scaling_factor_den[i];
           int height = (svc_params_.scaling_factor_num[i] * config_->g_h) /
                        svc_params_.scaling_factor_den[i];
-          int speed =
+          const int pixel_count = width * height;
+          int speed = threading_policy_.GetSpeed(pixel_count).value_or(
               std::prev(performance_flags_.settings_by_resolution.lower_bound(
-                            width * height))
-                  ->second.base_layer_speed;
+                            pixel_count))
+                  ->second.base_layer_speed);
           libvpx_->codec_control(encoder_, VP8E_SET_CPUUSED, speed);
           break;
         }
@@ -1243,6 +1258,8 @@ int LibvpxVp9Encoder::Encode(const VideoFrame& input_image,
                            &ref_config);
   }
 
+  ApplyActiveMap();
+
   first_frame_in_picture_ = true;
 
   // TODO(ssilkin): Frame duration should be specified per spatial layer
@@ -1703,6 +1720,10 @@ void LibvpxVp9Encoder::GetEncodedLayerFrame(const vpx_codec_cx_pkt* pkt) {
     return;
   }
 
+  // The next picture references this one, so only later changes matter.
+  std::fill(active_map_.begin(), active_map_.end(), 0);
+  active_map_valid_ = true;
+
   vpx_svc_layer_id_t layer_id = {0};
   libvpx_->codec_control(encoder_, VP9E_GET_SVC_LAYER_ID, &layer_id);
 
@@ -1755,6 +1776,63 @@ void LibvpxVp9Encoder::GetEncodedLayerFrame(const vpx_codec_cx_pkt* pkt) {
   DeliverBufferedFrame(end_of_picture);
 }
 
+void LibvpxVp9Encoder::UpdateActiveMap(const VideoFrame& frame) {
+  // With several layers, pictures may reference other pictures than the
+  // previous one, so the changes since the previous picture are not enough.
+  if (codec_.mode != VideoCodecMode::kScreensharing ||
+      num_spatial_layers_ != 1 || num_temporal_layers_ != 1) {
+    active_map_valid_ = false;
+    return;
+  }
+
+  const int rows = (frame.height() + 15) / 16;
+  const int cols = (frame.width() + 15) / 16;
+  if (rows != active_map_rows_ || cols != active_map_cols_) {
+    active_map_.assign(rows * cols, 0);
+    active_map_rows_ = rows;
+    active_map_cols_ = cols;
+    active_map_valid_ = false;
+  }
+
+  // Frames without update region, including repeated frames with an empty
+  // update rect, are encoded in full. This lets the quality of static content
+  // converge.
+  if (frame.update_region().empty()) {
+    active_map_valid_ = false;
+    return;
+  }
+  for (VideoFrame::UpdateRect rect : frame.update_region()) {
+    rect.Intersect(VideoFrame::UpdateRect{0, 0, frame.width(), frame.height()});
+    if (rect.IsEmpty()) {
+      continue;
+    }
+    const int first_col = rect.offset_x / 16;
+    const int last_col = (rect.offset_x + rect.width - 1) / 16;
+    const int last_row = (rect.offset_y + rect.height - 1) / 16;
+    for (int row = rect.offset_y / 16; row <= last_row; ++row) {
+      std::fill_n(active_map_.begin() + row * cols + first_col,
+                  last_col - first_col + 1, 1);
+    }
+  }
+}
+
+void LibvpxVp9Encoder::ApplyActiveMap() {
+  const bool use_active_map = active_map_valid_ && !force_key_frame_;
+  if (!use_active_map && !active_map_enabled_) {
+    return;
+  }
+  vpx_active_map_t map;
+  map.active_map = use_active_map ? active_map_.data() : nullptr;
+  map.rows = active_map_rows_;
+  map.cols = active_map_cols_;
+  if (libvpx_->codec_control(encoder_, VP8E_SET_ACTIVEMAP, &map) !=
+      VPX_CODEC_OK) {
+    RTC_LOG(LS_WARNING) << "Failed to set active map.";
+    return;
+  }
+  active_map_enabled_ = use_active_map;
+}
+
 void LibvpxVp9Encoder::DeliverBufferedFrame(bool end_of_picture) {
   if (encoded_image_.size() > 0) {
     if (num_spatial_layers_ > 1) {
@@ -1816,6 +1894,7 @@ VideoEncoder::EncoderInfo LibvpxVp9Encoder::GetEncoderInfo() const {
   info.has_trusted_rate_controller = trusted_rate_controller_;
   info.is_hardware_accelerated = false;
   if (inited_) {
+    info.num_threads = static_cast<int>(config_->g_threads);
     // Find the max configured fps of any active spatial layer.
     float max_fps = 0.0;
     for (size_t si = 0; si < num_spatial_layers_; ++si) {
@@ -1931,7 +2010,13 @@ void LibvpxVp9Encoder::UpdatePerformanceFlags() {
   const auto find_speed = [&](int min_pixel_count) {
     RTC_DCHECK(!params_by_resolution.empty());
     auto it = params_by_resolution.upper_bound(min_pixel_count);
-    return std::prev(it)->second;
+    PerformanceFlags::ParameterSet params = std::prev(it)->second;
+    if (absl::optional<int> speed =
+            threading_policy_.GetSpeed(min_pixel_count)) {
+      params.base_layer_speed = *speed;
+      params.high_layer_speed = std::max(params.high_layer_speed, *speed);
+    }
+    return params;
   };
   performance_flags_by_spatial_index_.clear();
 
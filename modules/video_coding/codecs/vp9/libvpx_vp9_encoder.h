@@ -90,6 +90,13 @@ class LibvpxVp9Encoder : public VP9Encoder {
 
   void GetEncodedLayerFrame(const vpx_codec_cx_pkt* pkt);
 
+  // Marks the blocks in the update region of `frame` as changed in
+  // `active_map_`, or invalidates the map if the changes are unknown.
+  void UpdateActiveMap(const VideoFrame& frame);
+  // Makes libvpx only encode the changed blocks of the next picture if the
+  // active map is valid, and all blocks otherwise.
+  void ApplyActiveMap();
+
   // Callback function for outputting packets per spatial layer.
   static void EncoderOutputCodedPacketCallback(vpx_codec_cx_pkt* pkt,
                                                void* user_data);
@@ -226,6 +233,8 @@ class LibvpxVp9Encoder : public VP9Encoder {
   // specified in `codec_.spatialLayer[i]`.
   std::vector<PerformanceFlags::ParameterSet>
       performance_flags_by_spatial_index_;
+  // Threading and speed overrides from the encoder settings.
+  VideoEncoder::Settings::ThreadingPolicy threading_policy_;
   void UpdatePerformanceFlags();
   static PerformanceFlags ParsePerformanceFlagsFromTrials(
       const FieldTrialsView& trials);
@@ -235,6 +244,18 @@ class LibvpxVp9Encoder : public VP9Encoder {
   // Only set config when this flag is set.
   bool config_changed_;
 
+  // Single layer screen sharing only encodes the 16x16 blocks that changed
+  // since the last encoded picture, according to the update regions of the
+  // input frames. Non-zero entries mark changed blocks.
+  std::vector<uint8_t> active_map_;
+  int active_map_rows_ = 0;
+  int active_map_cols_ = 0;
+  // False if a frame with unknown changes was input since the last encoded
+  // picture.
+  bool active_map_valid_ = false;
+  // True if libvpx currently has an active map set.
+  bool active_map_enabled_ = false;
+
   const LibvpxVp9EncoderInfoSettings encoder_info_override_;
 };
 
@@ -2459,4 +2459,99 @@ TEST(Vp9SpeedSettingsTrialsTest, DefaultPerLayerFlagsWithSvc) {
   }
 }
 
+TEST(Vp9ActiveMapTest, ScreenshareEncodesOnlyBlocksInUpdateRegion) {
+  // The active map has one entry per 16x16 block.
+  constexpr size_t kMapRows = (kHeight + 15) / 16;
+  constexpr size_t kMapCols = (kWidth + 15) / 16;
+  test::ExplicitKeyValueConfig trials("");
+  auto* const vpx = new NiceMock<MockLibvpxInterface>();
+  LibvpxVp9Encoder encoder(cricket::CreateVideoCodec(cricket::kVp9CodecName),
+                           absl::WrapUnique<LibvpxInterface>(vpx), trials);
+
+  VideoCodec settings = DefaultCodecSettings();
+  settings.mode = VideoCodecMode::kScreensharing;
+  settings.maxFramerate = 5;
+  ConfigureSvc(settings, /*num_spatial_layers=*/1);
+  vpx_image_t img;
+  ON_CALL(*vpx, img_wrap).WillByDefault(GetWrapImageFunction(&img));
+  ON_CALL(*vpx, codec_enc_config_default)
+      .WillByDefault(DoAll(WithArg<1>([](vpx_codec_enc_cfg_t* cfg) {
+                             memset(cfg, 0, sizeof(vpx_codec_enc_cfg_t));
+                           }),
+                           Return(VPX_CODEC_OK)));
+  vpx_codec_priv_output_cx_pkt_cb_pair_t callback_pointer = {};
+  EXPECT_CALL(*vpx, codec_control(_, VP9E_REGISTER_CX_CALLBACK, A<void*>()))
+      .WillOnce(WithArg<2>([&](void* cbp) {
+        callback_pointer =
+            *reinterpret_cast<vpx_codec_priv_output_cx_pkt_cb_pair_t*>(cbp);
+        return VPX_CODEC_OK;
+      }));
+  ASSERT_EQ(WEBRTC_VIDEO_CODEC_OK, encoder.InitEncode(&settings, kSettings));
+
+  VideoBitrateAllocation bitrate_allocation;
+  bitrate_allocation.SetBitrate(0, 0, settings.startBitrate * 1000);
+  encoder.SetRates(VideoEncoder::RateControlParameters(bitrate_allocation,
+                                                       settings.maxFramerate));
+  NiceMock<MockEncodedImageCallback> callback;
+  ON_CALL(callback, OnEncodedImage)
+      .WillByDefault(Return(
+          EncodedImageCallback::Result(EncodedImageCallback::Result::OK)));
+  encoder.RegisterEncodeCompleteCallback(&callback);
+
+  // Records the active maps set while encoding a frame. Null maps are
+  // recorded as empty vectors.
+  std::vector<std::vector<uint8_t>> active_maps;
+  ON_CALL(*vpx,
+          codec_control(_, VP8E_SET_ACTIVEMAP, A<vpx_active_map_t*>()))
+      .WillByDefault(WithArg<2>([&](vpx_active_map_t* map) {
+        EXPECT_EQ(map->rows, kMapRows);
+        EXPECT_EQ(map->cols, kMapCols);
+        active_maps.emplace_back();
+        if (map->active_map) {
+          active_maps.back().assign(map->active_map,
+                                    map->active_map + map->rows * map->cols);
+        }
+        return VPX_CODEC_OK;
+      }));
+
+  uint8_t data[1] = {0};
+  vpx_codec_cx_pkt encoded_data = {};
+  encoded_data.data.frame.buf = &data;
+  encoded_data.data.frame.sz = 1;
+  encoded_data.data.frame.flags = VPX_FRAME_IS_KEY;
+  uint32_t rtp_timestamp = 0;
+  auto encode = [&](const std::vector<VideoFrame::UpdateRect>& update_region) {
+    VideoFrame frame =
+        VideoFrame::Builder()
+            .set_video_frame_buffer(I420Buffer::Create(kWidth, kHeight))
+            .set_timestamp_rtp(rtp_timestamp)
+            .build();
+    if (!update_region.empty()) {
+      frame.set_update_region(update_region);
+    }
+    rtp_timestamp += kVideoPayloadTypeFrequency / settings.maxFramerate;
+    active_maps.clear();
+    EXPECT_EQ(encoder.Encode(frame, nullptr), WEBRTC_VIDEO_CODEC_OK);
+    callback_pointer.output_cx_pkt(&encoded_data, callback_pointer.user_priv);
+    encoded_data.data.frame.flags = 0;
+  };
+
+  // The key frame is encoded in full.
+  encode({VideoFrame::UpdateRect{0, 0, 16, 16}});
+  EXPECT_THAT(active_maps, IsEmpty());
+
+  // Only the blocks touched by the update region are active.
+  encode({VideoFrame::UpdateRect{0, 0, 16, 16},
+          VideoFrame::UpdateRect{40, 20, 8, 8}});
+  ASSERT_THAT(active_maps, SizeIs(1));
+  std::vector<uint8_t> expected_map(kMapRows * kMapCols, 0);
+  expected_map[0] = 1;
+  expected_map[1 * kMapCols + 2] = 1;
+  EXPECT_EQ(active_maps[0], expected_map);
+
+  // A frame with unknown changes is encoded in full.
+  encode({});
+  EXPECT_THAT(active_maps, ElementsAre(IsEmpty()));
+}
+
 }  // namespace webrtc
@@ -23,20 +23,29 @@ VCMDecoderDatabase::VCMDecoderDatabase() {
 }
 
 void VCMDecoderDatabase::DeregisterExternalDecoder(uint8_t payload_type) {
+  TakeExternalDecoder(payload_type);
+}
+
+std::unique_ptr<VideoDecoder> VCMDecoderDatabase::TakeExternalDecoder(
+    uint8_t payload_type) {
   RTC_DCHECK_RUN_ON(&decoder_sequence_checker_);
   auto it = decoders_.find(payload_type);
   if (it == decoders_.end()) {
-    return;
+    return nullptr;
   }
 
   // We can't use payload_type to check if the decoder is currently in use,
   // because payload type may be out of date (e.g. before we decode the first
   // frame after RegisterReceiveCodec).
   if (current_decoder_ && current_decoder_->IsSameDecoder(it->second.get())) {
-    // Release it if it was registered and in use.
+    // Release it if it was registered and in use, so that a decoder
+    // registered later is initialized for the next frame.
     current_decoder_ = absl::nullopt;
+    current_payload_type_ = absl::nullopt;
   }
+  std::unique_ptr<VideoDecoder> decoder = std::move(it->second);
   decoders_.erase(it);
+  return decoder;
 }
 
 // Add the external decoder object to the list of external decoders.
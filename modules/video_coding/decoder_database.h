@@ -34,6 +34,9 @@ class VCMDecoderDatabase {
   // Returns a pointer to the previously registered decoder or nullptr if none
   // was registered for the `payload_type`.
   void DeregisterExternalDecoder(uint8_t payload_type);
+  // Like DeregisterExternalDecoder(), but returns the decoder, released if it
+  // was in use, rather than destroying it.
+  std::unique_ptr<VideoDecoder> TakeExternalDecoder(uint8_t payload_type);
   void RegisterExternalDecoder(uint8_t payload_type,
                                std::unique_ptr<VideoDecoder> external_decoder);
   bool IsExternalDecoderRegistered(uint8_t payload_type) const;
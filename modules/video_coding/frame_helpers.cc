@@ -10,15 +10,41 @@
 
 #include "modules/video_coding/frame_helpers.h"
 
+#include <string.h>
+
+#include <algorithm>
 #include <utility>
 
+#include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 
 namespace webrtc {
 
 namespace {
 constexpr TimeDelta kMaxVideoDelay = TimeDelta::Millis(10000);
+
+// Copies the encoded data of `frame` to `buffer` chunk by chunk, so that
+// segmented buffers are not made contiguous first. Returns the end of the copy.
+uint8_t* CopyEncodedData(const EncodedFrame& frame, uint8_t* buffer) {
+  size_t remaining = frame.size();
+  rtc::scoped_refptr<EncodedImageBufferInterface> encoded_data =
+      frame.GetEncodedData();
+  if (!encoded_data) {
+    RTC_DCHECK_EQ(remaining, 0);
+    return buffer;
+  }
+  encoded_data->ForEachChunk([&](rtc::ArrayView<const uint8_t> chunk) {
+    size_t bytes = std::min(remaining, chunk.size());
+    if (bytes == 0)
+      return;
+    memcpy(buffer, chunk.data(), bytes);
+    buffer += bytes;
+    remaining -= bytes;
+  });
+  RTC_DCHECK_EQ(remaining, 0);
+  return buffer;
 }
+}  // namespace
 
 bool FrameHasBadRenderTiming(Timestamp render_time, Timestamp now) {
   // Zero render time means render immediately.
@@ -68,8 +94,7 @@ std::unique_ptr<EncodedFrame> CombineAndDeleteFrames(
   uint8_t* buffer = encoded_image_buffer->data();
   first_frame->SetSpatialLayerFrameSize(first_frame->SpatialIndex().value_or(0),
                                         first_frame->size());
-  memcpy(buffer, first_frame->data(), first_frame->size());
-  buffer += first_frame->size();
+  buffer = CopyEncodedData(*first_frame, buffer);
 
   // Spatial index of combined frame is set equal to spatial index of its top
   // spatial layer.
@@ -86,8 +111,7 @@ std::unique_ptr<EncodedFrame> CombineAndDeleteFrames(
     std::unique_ptr<EncodedFrame> next_frame = std::move(frames[i]);
     first_frame->SetSpatialLayerFrameSize(
         next_frame->SpatialIndex().value_or(0), next_frame->size());
-    memcpy(buffer, next_frame->data(), next_frame->size());
-    buffer += next_frame->size();
+    buffer = CopyEncodedData(*next_frame, buffer);
   }
   first_frame->SetEncodedData(encoded_image_buffer);
   return first_frame;
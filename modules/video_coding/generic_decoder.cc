@@ -128,7 +128,7 @@ void VCMDecodedFrameCallback::Decoded(VideoFrame& decodedImage,
   }
 
   decodedImage.set_ntp_time_ms(frame_info->ntp_time_ms);
-  decodedImage.set_packet_infos(frame_info->packet_infos);
+  decodedImage.set_packet_infos(std::move(frame_info->packet_infos));
   decodedImage.set_rotation(frame_info->rotation);
   VideoFrame::RenderParameters render_parameters = _timing->RenderParameters();
   if (render_parameters.max_composition_delay_in_frames) {
@@ -0,0 +1,227 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/h265_vps_sps_pps_tracker.h"
+
+#include <utility>
+
+#include "absl/types/optional.h"
+#include "common_video/h265/h265_bitstream_parser.h"
+#include "common_video/h265/h265_common.h"
+#include "common_video/h265/h265_pps_parser.h"
+#include "common_video/h265/h265_sps_parser.h"
+#include "common_video/h265/h265_vps_parser.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+namespace video_coding {
+
+namespace {
+const uint8_t start_code_h265[] = {0, 0, 0, 1};
+
+H265::NaluType ParseNaluType(const uint8_t* nalu) {
+  return H265::ParseNaluType(nalu[0]);
+}
+
+bool IsIrap(H265::NaluType type) {
+  return type >= H265::NaluType::kBlaWLp &&
+         type <= H265::NaluType::kRsvIrapVcl23;
+}
+}  // namespace
+
+H265VpsSpsPpsTracker::H265VpsSpsPpsTracker() = default;
+H265VpsSpsPpsTracker::~H265VpsSpsPpsTracker() = default;
+
+H265VpsSpsPpsTracker::FixedBitstream H265VpsSpsPpsTracker::MaybeFixBitstream(
+    rtc::CopyOnWriteBuffer bitstream,
+    RTPVideoHeader* video_header) {
+  RTC_DCHECK(video_header);
+  RTC_DCHECK(video_header->codec == kVideoCodecH265);
+  RTC_DCHECK_GT(bitstream.size(), 0);
+
+  // Only the first fragment of a fragmentation unit starts with a NALU.
+  if (!video_header->is_first_packet_in_frame) {
+    return {kInsert, std::move(bitstream)};
+  }
+
+  const VpsInfo* vps = nullptr;
+  const SpsInfo* sps = nullptr;
+  const PpsInfo* pps = nullptr;
+  for (const H265::NaluIndex& index :
+       H265::FindNaluIndices(bitstream.cdata(), bitstream.size())) {
+    const uint8_t* nalu = bitstream.cdata() + index.payload_start_offset;
+    if (index.payload_size < H265::kNaluHeaderSize) {
+      continue;
+    }
+    H265::NaluType type = ParseNaluType(nalu);
+    switch (type) {
+      case H265::NaluType::kVps:
+        InsertVps(nalu, index.payload_size, /*out_of_band=*/false);
+        break;
+      case H265::NaluType::kSps:
+        InsertSps(nalu, index.payload_size, /*out_of_band=*/false);
+        break;
+      case H265::NaluType::kPps:
+        InsertPps(nalu, index.payload_size, /*out_of_band=*/false);
+        break;
+      default: {
+        // Only the first slice of an IRAP picture needs the parameter sets to
+        // be checked, and the slice header to be parsed.
+        if (!IsIrap(type) || index.payload_size <= H265::kNaluHeaderSize ||
+            !(nalu[H265::kNaluHeaderSize] & 0x80)) {
+          break;
+        }
+        absl::optional<uint32_t> pps_id =
+            H265BitstreamParser::ParsePpsIdFromSliceSegmentLayerRbsp(
+                nalu + H265::kNaluHeaderSize,
+                index.payload_size - H265::kNaluHeaderSize, type);
+        if (!pps_id) {
+          RTC_LOG(LS_WARNING) << "No PPS id in IRAP slice.";
+          return {kRequestKeyframe};
+        }
+
+        auto pps_it = pps_data_.find(*pps_id);
+        if (pps_it == pps_data_.end()) {
+          RTC_LOG(LS_WARNING) << "No PPS with id " << *pps_id << " received";
+          return {kRequestKeyframe};
+        }
+
+        auto sps_it = sps_data_.find(pps_it->second.sps_id);
+        if (sps_it == sps_data_.end()) {
+          RTC_LOG(LS_WARNING)
+              << "No SPS with id " << pps_it->second.sps_id << " received";
+          return {kRequestKeyframe};
+        }
+
+        auto vps_it = vps_data_.find(sps_it->second.vps_id);
+        if (vps_it == vps_data_.end()) {
+          RTC_LOG(LS_WARNING)
+              << "No VPS with id " << sps_it->second.vps_id << " received";
+          return {kRequestKeyframe};
+        }
+
+        // The resolution may only have been provided out of band.
+        video_header->width = sps_it->second.width;
+        video_header->height = sps_it->second.height;
+        vps = &vps_it->second;
+        sps = &sps_it->second;
+        pps = &pps_it->second;
+        break;
+      }
+    }
+  }
+
+  // Parameter sets received in band are already part of the stream.
+  size_t required_size = 0;
+  for (const rtc::Buffer* data :
+       {vps ? &vps->data : nullptr, sps ? &sps->data : nullptr,
+        pps ? &pps->data : nullptr}) {
+    if (data && !data->empty()) {
+      required_size += sizeof(start_code_h265) + data->size();
+    }
+  }
+  if (required_size == 0) {
+    return {kInsert, std::move(bitstream)};
+  }
+
+  FixedBitstream fixed;
+  fixed.action = kInsert;
+  fixed.bitstream.EnsureCapacity(required_size + bitstream.size());
+  for (const rtc::Buffer* data : {&vps->data, &sps->data, &pps->data}) {
+    if (!data->empty()) {
+      fixed.bitstream.AppendData(start_code_h265);
+      fixed.bitstream.AppendData(*data);
+    }
+  }
+  fixed.bitstream.AppendData(bitstream);
+  return fixed;
+}
+
+void H265VpsSpsPpsTracker::InsertVpsSpsPpsNalus(
+    const std::vector<uint8_t>& vps,
+    const std::vector<uint8_t>& sps,
+    const std::vector<uint8_t>& pps) {
+  if (vps.size() < H265::kNaluHeaderSize ||
+      ParseNaluType(vps.data()) != H265::NaluType::kVps) {
+    RTC_LOG(LS_WARNING) << "VPS Nalu header missing";
+    return;
+  }
+  if (sps.size() < H265::kNaluHeaderSize ||
+      ParseNaluType(sps.data()) != H265::NaluType::kSps) {
+    RTC_LOG(LS_WARNING) << "SPS Nalu header missing";
+    return;
+  }
+  if (pps.size() < H265::kNaluHeaderSize ||
+      ParseNaluType(pps.data()) != H265::NaluType::kPps) {
+    RTC_LOG(LS_WARNING) << "PPS Nalu header missing";
+    return;
+  }
+
+  if (!InsertVps(vps.data(), vps.size(), /*out_of_band=*/true) ||
+      !InsertSps(sps.data(), sps.size(), /*out_of_band=*/true) ||
+      !InsertPps(pps.data(), pps.size(), /*out_of_band=*/true)) {
+    return;
+  }
+  RTC_LOG(LS_INFO) << "Inserted out of band VPS, SPS and PPS.";
+}
+
+bool H265VpsSpsPpsTracker::InsertVps(const uint8_t* nalu,
+                                     size_t size,
+                                     bool out_of_band) {
+  absl::optional<H265VpsParser::VpsState> parsed_vps =
+      H265VpsParser::ParseVps(nalu + H265::kNaluHeaderSize,
+                              size - H265::kNaluHeaderSize);
+  if (!parsed_vps) {
+    RTC_LOG(LS_WARNING) << "Failed to parse VPS.";
+    return false;
+  }
+  VpsInfo& vps_info = vps_data_[parsed_vps->id];
+  vps_info.data.SetData(nalu, out_of_band ? size : 0);
+  return true;
+}
+
+bool H265VpsSpsPpsTracker::InsertSps(const uint8_t* nalu,
+                                     size_t size,
+                                     bool out_of_band) {
+  absl::optional<H265SpsParser::SpsState> parsed_sps =
+      H265SpsParser::ParseSps(nalu + H265::kNaluHeaderSize,
+                              size - H265::kNaluHeaderSize);
+  if (!parsed_sps) {
+    RTC_LOG(LS_WARNING) << "Failed to parse SPS.";
+    return false;
+  }
+  SpsInfo& sps_info = sps_data_[parsed_sps->sps_id];
+  sps_info.vps_id = parsed_sps->vps_id;
+  sps_info.width = parsed_sps->width;
+  sps_info.height = parsed_sps->height;
+  sps_info.data.SetData(nalu, out_of_band ? size : 0);
+  return true;
+}
+
+bool H265VpsSpsPpsTracker::InsertPps(const uint8_t* nalu,
+                                     size_t size,
+                                     bool out_of_band) {
+  uint32_t pps_id;
+  uint32_t sps_id;
+  if (!H265PpsParser::ParsePpsIds(nalu + H265::kNaluHeaderSize,
+                                  size - H265::kNaluHeaderSize, &pps_id,
+                                  &sps_id)) {
+    RTC_LOG(LS_WARNING) << "Failed to parse PPS.";
+    return false;
+  }
+  PpsInfo& pps_info = pps_data_[pps_id];
+  pps_info.sps_id = sps_id;
+  pps_info.data.SetData(nalu, out_of_band ? size : 0);
+  return true;
+}
+
+}  // namespace video_coding
+}  // namespace webrtc
@@ -0,0 +1,88 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CODING_H265_VPS_SPS_PPS_TRACKER_H_
+#define MODULES_VIDEO_CODING_H265_VPS_SPS_PPS_TRACKER_H_
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "modules/rtp_rtcp/source/rtp_video_header.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/copy_on_write_buffer.h"
+
+namespace webrtc {
+namespace video_coding {
+
+// Keeps track of the H.265 parameter sets of a stream, the counterpart of
+// H264SpsPpsTracker. The H.265 depacketizer already turns aggregation and
+// fragmentation units into Annex B byte streams, so unlike for H.264 the
+// bitstream is only copied when parameter sets have to be inserted.
+class H265VpsSpsPpsTracker {
+ public:
+  enum PacketAction { kInsert, kDrop, kRequestKeyframe };
+  struct FixedBitstream {
+    PacketAction action;
+    rtc::CopyOnWriteBuffer bitstream;
+  };
+
+  H265VpsSpsPpsTracker();
+  ~H265VpsSpsPpsTracker();
+
+  // Records the parameter sets in `bitstream`, the Annex B output of the H.265
+  // depacketizer. Asks for a keyframe if an IRAP picture starts in `bitstream`
+  // before its VPS, SPS and PPS were received, and prepends the ones that were
+  // only provided out of band. Sets the resolution of `video_header` for IRAP
+  // pictures.
+  FixedBitstream MaybeFixBitstream(rtc::CopyOnWriteBuffer bitstream,
+                                   RTPVideoHeader* video_header);
+
+  // Inserts parameter sets provided out of band, e.g. through the sprop-vps,
+  // sprop-sps and sprop-pps SDP parameters. Each NALU starts with its header.
+  void InsertVpsSpsPpsNalus(const std::vector<uint8_t>& vps,
+                            const std::vector<uint8_t>& sps,
+                            const std::vector<uint8_t>& pps);
+
+ private:
+  struct VpsInfo {
+    // Only set if provided out of band.
+    rtc::Buffer data;
+  };
+
+  struct SpsInfo {
+    uint32_t vps_id = 0;
+    int width = -1;
+    int height = -1;
+    // Only set if provided out of band.
+    rtc::Buffer data;
+  };
+
+  struct PpsInfo {
+    uint32_t sps_id = 0;
+    // Only set if provided out of band.
+    rtc::Buffer data;
+  };
+
+  // Parses a parameter set NALU, starting with its header, and replaces the
+  // stored one with the same id. Returns false if it can't be parsed.
+  bool InsertVps(const uint8_t* nalu, size_t size, bool out_of_band);
+  bool InsertSps(const uint8_t* nalu, size_t size, bool out_of_band);
+  bool InsertPps(const uint8_t* nalu, size_t size, bool out_of_band);
+
+  std::map<uint32_t, VpsInfo> vps_data_;
+  std::map<uint32_t, SpsInfo> sps_data_;
+  std::map<uint32_t, PpsInfo> pps_data_;
+};
+
+}  // namespace video_coding
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CODING_H265_VPS_SPS_PPS_TRACKER_H_
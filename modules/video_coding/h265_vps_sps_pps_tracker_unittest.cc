@@ -0,0 +1,188 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/h265_vps_sps_pps_tracker.h"
+
+#include <vector>
+
+#include "modules/rtp_rtcp/source/rtp_video_header.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace video_coding {
+namespace {
+
+using ::testing::ElementsAreArray;
+
+const uint8_t kStartCode[] = {0, 0, 0, 1};
+
+// Parameter sets and the beginning of the first IDR slice of a 1920x1080
+// stream, each NALU starting with its header.
+const uint8_t kVps[] = {0x40, 0x01, 0x0c, 0x01, 0xff, 0xff, 0x04, 0x08,
+                        0x00, 0x00, 0x03, 0x00, 0x9d, 0x08, 0x00, 0x00,
+                        0x03, 0x00, 0x00, 0x78, 0x95, 0x98, 0x09};
+const uint8_t kSps[] = {0x42, 0x01, 0x01, 0x04, 0x08, 0x00, 0x00, 0x03, 0x00,
+                        0x9d, 0x08, 0x00, 0x00, 0x03, 0x00, 0x00, 0x78, 0xb0,
+                        0x03, 0xc0, 0x80, 0x10, 0xe5, 0x96, 0x56, 0x69, 0x24,
+                        0xca, 0xe0, 0x10, 0x00, 0x00, 0x03, 0x00, 0x10, 0x00,
+                        0x00, 0x03, 0x01, 0xe0, 0x80};
+const uint8_t kPps[] = {0x44, 0x01, 0xc1, 0x72, 0xb4, 0x62, 0x40};
+const uint8_t kIdr[] = {0x26, 0x01, 0xaf, 0x08, 0x42, 0x23, 0x10, 0x5d};
+// Trailing picture slice, which doesn't need parameter sets to be checked.
+const uint8_t kTrail[] = {0x00, 0x01, 0xe0, 0x24, 0xbf, 0x82, 0x05};
+// Continuation of a fragmentation unit.
+const uint8_t kFuContinuation[] = {0x10, 0x5d, 0x2b, 0x51, 0xf9};
+
+constexpr int kWidth = 1920;
+constexpr int kHeight = 1080;
+
+rtc::ArrayView<const uint8_t> Bitstream(
+    const H265VpsSpsPpsTracker::FixedBitstream& fixed) {
+  return fixed.bitstream;
+}
+
+std::vector<uint8_t> AnnexB(
+    std::initializer_list<rtc::ArrayView<const uint8_t>> nalus) {
+  std::vector<uint8_t> bitstream;
+  for (rtc::ArrayView<const uint8_t> nalu : nalus) {
+    bitstream.insert(bitstream.end(), std::begin(kStartCode),
+                     std::end(kStartCode));
+    bitstream.insert(bitstream.end(), nalu.begin(), nalu.end());
+  }
+  return bitstream;
+}
+
+class H265VideoHeader : public RTPVideoHeader {
+ public:
+  H265VideoHeader() {
+    codec = kVideoCodecH265;
+    is_first_packet_in_frame = true;
+  }
+};
+
+class TestH265VpsSpsPpsTracker : public ::testing::Test {
+ protected:
+  H265VpsSpsPpsTracker::FixedBitstream Fix(const std::vector<uint8_t>& data,
+                                           RTPVideoHeader* header) {
+    return tracker_.MaybeFixBitstream(rtc::CopyOnWriteBuffer(data), header);
+  }
+
+  H265VpsSpsPpsTracker tracker_;
+};
+
+TEST_F(TestH265VpsSpsPpsTracker, FuContinuationIsNotParsed) {
+  H265VideoHeader header;
+  header.is_first_packet_in_frame = false;
+  rtc::CopyOnWriteBuffer data(kFuContinuation);
+
+  H265VpsSpsPpsTracker::FixedBitstream fixed =
+      tracker_.MaybeFixBitstream(data, &header);
+
+  EXPECT_EQ(fixed.action, H265VpsSpsPpsTracker::kInsert);
+  // Not copied.
+  EXPECT_EQ(fixed.bitstream.cdata(), data.cdata());
+}
+
+TEST_F(TestH265VpsSpsPpsTracker, TrailingSliceWithoutParameterSets) {
+  H265VideoHeader header;
+  std::vector<uint8_t> data = AnnexB({kTrail});
+
+  H265VpsSpsPpsTracker::FixedBitstream fixed = Fix(data, &header);
+
+  EXPECT_EQ(fixed.action, H265VpsSpsPpsTracker::kInsert);
+  EXPECT_THAT(Bitstream(fixed), ElementsAreArray(data));
+}
+
+TEST_F(TestH265VpsSpsPpsTracker, IdrWithoutParameterSetsRequestsKeyframe) {
+  H265VideoHeader header;
+  EXPECT_EQ(Fix(AnnexB({kIdr}), &header).action,
+            H265VpsSpsPpsTracker::kRequestKeyframe);
+}
+
+TEST_F(TestH265VpsSpsPpsTracker, IdrWithoutPpsRequestsKeyframe) {
+  H265VideoHeader header;
+  EXPECT_EQ(Fix(AnnexB({kVps, kSps, kIdr}), &header).action,
+            H265VpsSpsPpsTracker::kRequestKeyframe);
+}
+
+TEST_F(TestH265VpsSpsPpsTracker, IdrWithParameterSetsInSamePacket) {
+  H265VideoHeader header;
+  std::vector<uint8_t> data = AnnexB({kVps, kSps, kPps, kIdr});
+
+  H265VpsSpsPpsTracker::FixedBitstream fixed = Fix(data, &header);
+
+  EXPECT_EQ(fixed.action, H265VpsSpsPpsTracker::kInsert);
+  EXPECT_THAT(Bitstream(fixed), ElementsAreArray(data));
+  EXPECT_EQ(header.width, kWidth);
+  EXPECT_EQ(header.height, kHeight);
+}
+
+TEST_F(TestH265VpsSpsPpsTracker, IdrWithParameterSetsInEarlierPackets) {
+  H265VideoHeader header;
+  EXPECT_EQ(Fix(AnnexB({kVps}), &header).action,
+            H265VpsSpsPpsTracker::kInsert);
+  EXPECT_EQ(Fix(AnnexB({kSps}), &header).action,
+            H265VpsSpsPpsTracker::kInsert);
+  EXPECT_EQ(Fix(AnnexB({kPps}), &header).action,
+            H265VpsSpsPpsTracker::kInsert);
+
+  H265VideoHeader idr_header;
+  std::vector<uint8_t> data = AnnexB({kIdr});
+  H265VpsSpsPpsTracker::FixedBitstream fixed = Fix(data, &idr_header);
+
+  EXPECT_EQ(fixed.action, H265VpsSpsPpsTracker::kInsert);
+  EXPECT_THAT(Bitstream(fixed), ElementsAreArray(data));
+  EXPECT_EQ(idr_header.width, kWidth);
+  EXPECT_EQ(idr_header.height, kHeight);
+}
+
+TEST_F(TestH265VpsSpsPpsTracker, OutOfBandParameterSetsArePrepended) {
+  tracker_.InsertVpsSpsPpsNalus(std::vector<uint8_t>(kVps, std::end(kVps)),
+                                std::vector<uint8_t>(kSps, std::end(kSps)),
+                                std::vector<uint8_t>(kPps, std::end(kPps)));
+
+  H265VideoHeader header;
+  H265VpsSpsPpsTracker::FixedBitstream fixed = Fix(AnnexB({kIdr}), &header);
+
+  EXPECT_EQ(fixed.action, H265VpsSpsPpsTracker::kInsert);
+  EXPECT_THAT(Bitstream(fixed),
+              ElementsAreArray(AnnexB({kVps, kSps, kPps, kIdr})));
+  EXPECT_EQ(header.width, kWidth);
+  EXPECT_EQ(header.height, kHeight);
+}
+
+TEST_F(TestH265VpsSpsPpsTracker, InBandParameterSetsReplaceOutOfBandOnes) {
+  tracker_.InsertVpsSpsPpsNalus(std::vector<uint8_t>(kVps, std::end(kVps)),
+                                std::vector<uint8_t>(kSps, std::end(kSps)),
+                                std::vector<uint8_t>(kPps, std::end(kPps)));
+
+  H265VideoHeader header;
+  std::vector<uint8_t> data = AnnexB({kVps, kSps, kPps, kIdr});
+  H265VpsSpsPpsTracker::FixedBitstream fixed = Fix(data, &header);
+
+  EXPECT_EQ(fixed.action, H265VpsSpsPpsTracker::kInsert);
+  EXPECT_THAT(Bitstream(fixed), ElementsAreArray(data));
+}
+
+TEST_F(TestH265VpsSpsPpsTracker, InvalidOutOfBandParameterSetsAreIgnored) {
+  // The SPS is passed as PPS.
+  tracker_.InsertVpsSpsPpsNalus(std::vector<uint8_t>(kVps, std::end(kVps)),
+                                std::vector<uint8_t>(kSps, std::end(kSps)),
+                                std::vector<uint8_t>(kSps, std::end(kSps)));
+
+  H265VideoHeader header;
+  EXPECT_EQ(Fix(AnnexB({kIdr}), &header).action,
+            H265VpsSpsPpsTracker::kRequestKeyframe);
+}
+
+}  // namespace
+}  // namespace video_coding
+}  // namespace webrtc
@@ -133,6 +133,8 @@ NackRequester::~NackRequester() {
 
 void NackRequester::ProcessNacks() {
   RTC_DCHECK_RUN_ON(worker_thread_);
+  if (nack_list_.empty())
+    return;
   std::vector<uint16_t> nack_batch = GetNackBatch(kTimeOnly);
   if (!nack_batch.empty()) {
     // This batch of NACKs is triggered externally; there is no external
@@ -168,10 +170,10 @@ int NackRequester::OnReceivedPacket(uint16_t seq_num,
 
   if (AheadOf(newest_seq_num_, seq_num)) {
     // An out of order packet has been received.
-    auto nack_list_it = nack_list_.find(seq_num);
+    auto nack_list_it = FindNack(seq_num);
     int nacks_sent_for_packet = 0;
     if (nack_list_it != nack_list_.end()) {
-      nacks_sent_for_packet = nack_list_it->second.retries;
+      nacks_sent_for_packet = nack_list_it->retries;
       nack_list_.erase(nack_list_it);
     }
     if (!is_retransmitted)
@@ -180,12 +182,10 @@ int NackRequester::OnReceivedPacket(uint16_t seq_num,
   }
 
   if (is_recovered) {
-    recovered_list_.insert(seq_num);
+    recovered_list_.Insert(seq_num);
 
     // Remove old ones so we don't accumulate recovered packets.
-    auto it = recovered_list_.lower_bound(seq_num - kMaxPacketAge);
-    if (it != recovered_list_.begin())
-      recovered_list_.erase(recovered_list_.begin(), it);
+    recovered_list_.EraseUpTo(seq_num - kMaxPacketAge - 1);
 
     // Do not send nack for packets recovered by FEC or RTX.
     return 0;
@@ -212,9 +212,9 @@ void NackRequester::ClearUpTo(uint16_t seq_num) {
   // needs to be posted to the worker thread if callers migrate to the network
   // thread.
   RTC_DCHECK_RUN_ON(worker_thread_);
-  nack_list_.erase(nack_list_.begin(), nack_list_.lower_bound(seq_num));
-  recovered_list_.erase(recovered_list_.begin(),
-                        recovered_list_.lower_bound(seq_num));
+  while (!nack_list_.empty() && AheadOf(seq_num, nack_list_.front().seq_num))
+    nack_list_.pop_front();
+  recovered_list_.EraseUpTo(seq_num - 1);
 }
 
 void NackRequester::UpdateRtt(int64_t rtt_ms) {
@@ -226,8 +226,11 @@ void NackRequester::AddPacketsToNack(uint16_t seq_num_start,
                                      uint16_t seq_num_end) {
   // Called on worker_thread_.
   // Remove old packets.
-  auto it = nack_list_.lower_bound(seq_num_end - kMaxPacketAge);
-  nack_list_.erase(nack_list_.begin(), it);
+  const uint16_t oldest_seq_num = seq_num_end - kMaxPacketAge;
+  while (!nack_list_.empty() &&
+         AheadOf(oldest_seq_num, nack_list_.front().seq_num)) {
+    nack_list_.pop_front();
+  }
 
   uint16_t num_new_nacks = ForwardDiff(seq_num_start, seq_num_end);
   if (nack_list_.size() + num_new_nacks > kMaxNackPackets) {
@@ -238,14 +241,15 @@ void NackRequester::AddPacketsToNack(uint16_t seq_num_start,
     return;
   }
 
+  const Timestamp now = clock_->CurrentTime();
+  const int wait_number_of_packets = WaitNumberOfPackets(0.5);
   for (uint16_t seq_num = seq_num_start; seq_num != seq_num_end; ++seq_num) {
     // Do not send nack for packets that are already recovered by FEC or RTX
-    if (recovered_list_.find(seq_num) != recovered_list_.end())
+    if (recovered_list_.Contains(seq_num))
       continue;
-    NackInfo nack_info(seq_num, seq_num + WaitNumberOfPackets(0.5),
-                       clock_->CurrentTime());
-    RTC_DCHECK(nack_list_.find(seq_num) == nack_list_.end());
-    nack_list_[seq_num] = nack_info;
+    RTC_DCHECK(nack_list_.empty() ||
+               AheadOf(seq_num, nack_list_.back().seq_num));
+    nack_list_.emplace_back(seq_num, seq_num + wait_number_of_packets, now);
   }
 }
 
@@ -256,32 +260,48 @@ std::vector<uint16_t> NackRequester::GetNackBatch(NackFilterOptions options) {
   bool consider_timestamp = options != kSeqNumOnly;
   Timestamp now = clock_->CurrentTime();
   std::vector<uint16_t> nack_batch;
-  auto it = nack_list_.begin();
-  while (it != nack_list_.end()) {
-    bool delay_timed_out = now - it->second.created_at_time >= send_nack_delay_;
-    bool nack_on_rtt_passed = now - it->second.sent_at_time >= rtt_;
+  bool max_retries_reached = false;
+  for (NackInfo& nack_info : nack_list_) {
+    bool delay_timed_out = now - nack_info.created_at_time >= send_nack_delay_;
+    bool nack_on_rtt_passed = now - nack_info.sent_at_time >= rtt_;
     bool nack_on_seq_num_passed =
-        it->second.sent_at_time.IsInfinite() &&
-        AheadOrAt(newest_seq_num_, it->second.send_at_seq_num);
+        nack_info.sent_at_time.IsInfinite() &&
+        AheadOrAt(newest_seq_num_, nack_info.send_at_seq_num);
     if (delay_timed_out && ((consider_seq_num && nack_on_seq_num_passed) ||
                             (consider_timestamp && nack_on_rtt_passed))) {
-      nack_batch.emplace_back(it->second.seq_num);
-      ++it->second.retries;
-      it->second.sent_at_time = now;
-      if (it->second.retries >= kMaxNackRetries) {
-        RTC_LOG(LS_WARNING) << "Sequence number " << it->second.seq_num
+      nack_batch.emplace_back(nack_info.seq_num);
+      ++nack_info.retries;
+      nack_info.sent_at_time = now;
+      if (nack_info.retries >= kMaxNackRetries) {
+        RTC_LOG(LS_WARNING) << "Sequence number " << nack_info.seq_num
                             << " removed from NACK list due to max retries.";
-        it = nack_list_.erase(it);
-      } else {
-        ++it;
+        max_retries_reached = true;
       }
-      continue;
     }
-    ++it;
+  }
+  if (max_retries_reached) {
+    nack_list_.erase(std::remove_if(nack_list_.begin(), nack_list_.end(),
+                                    [](const NackInfo& nack_info) {
+                                      return nack_info.retries >=
+                                             kMaxNackRetries;
+                                    }),
+                     nack_list_.end());
   }
   return nack_batch;
 }
 
+std::deque<NackRequester::NackInfo>::iterator NackRequester::FindNack(
+    uint16_t seq_num) {
+  // Called on worker_thread_.
+  auto it = std::lower_bound(nack_list_.begin(), nack_list_.end(), seq_num,
+                             [](const NackInfo& nack_info, uint16_t seq_num) {
+                               return AheadOf(seq_num, nack_info.seq_num);
+                             });
+  if (it != nack_list_.end() && it->seq_num == seq_num)
+    return it;
+  return nack_list_.end();
+}
+
 void NackRequester::UpdateReorderingStatistics(uint16_t seq_num) {
   // Running on worker_thread_.
   RTC_DCHECK(AheadOf(newest_seq_num_, seq_num));
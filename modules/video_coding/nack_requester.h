@@ -13,8 +13,7 @@
 
 #include <stdint.h>
 
-#include <map>
-#include <set>
+#include <deque>
 #include <vector>
 
 #include "api/field_trials_view.h"
@@ -25,6 +24,7 @@
 #include "api/units/timestamp.h"
 #include "modules/include/module_common_types.h"
 #include "modules/video_coding/histogram.h"
+#include "modules/video_coding/sequence_number_bitmap.h"
 #include "rtc_base/numerics/sequence_number_util.h"
 #include "rtc_base/task_utils/repeating_task.h"
 #include "rtc_base/thread_annotations.h"
@@ -111,6 +111,10 @@ class NackRequester final : public NackRequesterBase {
   std::vector<uint16_t> GetNackBatch(NackFilterOptions options)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(worker_thread_);
 
+  // Returns the entry for `seq_num` in `nack_list_`, or end() if there is none.
+  std::deque<NackInfo>::iterator FindNack(uint16_t seq_num)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(worker_thread_);
+
   // Update the reordering distribution.
   void UpdateReorderingStatistics(uint16_t seq_num)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(worker_thread_);
@@ -128,10 +132,13 @@ class NackRequester final : public NackRequesterBase {
   // TODO(philipel): Some of the variables below are consistently used on a
   // known thread (e.g. see `initialized_`). Those probably do not need
   // synchronized access.
-  std::map<uint16_t, NackInfo, DescendingSeqNumComp<uint16_t>> nack_list_
-      RTC_GUARDED_BY(worker_thread_);
-  std::set<uint16_t, DescendingSeqNumComp<uint16_t>> recovered_list_
-      RTC_GUARDED_BY(worker_thread_);
+  // Packets to nack, ordered by sequence number. Kept contiguous so that
+  // GetNackBatch, which runs for every received packet and every periodic
+  // process, is a linear scan.
+  std::deque<NackInfo> nack_list_ RTC_GUARDED_BY(worker_thread_);
+  // Packets recovered by FEC or RTX, covering at least the last
+  // `kMaxPacketAge` sequence numbers.
+  SequenceNumberBitmap<16384> recovered_list_ RTC_GUARDED_BY(worker_thread_);
   video_coding::Histogram reordering_histogram_ RTC_GUARDED_BY(worker_thread_);
   bool initialized_ RTC_GUARDED_BY(worker_thread_);
   TimeDelta rtt_ RTC_GUARDED_BY(worker_thread_);
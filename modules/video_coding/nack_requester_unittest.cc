@@ -253,6 +253,28 @@ TEST_F(TestNackRequester, HandleFecRecoveredPacket) {
   EXPECT_EQ(2u, sent_nacks_.size());
 }
 
+TEST_F(TestNackRequester, BurstLossWithRecoveredPackets) {
+  NackRequester& nack_module = CreateNackModule(TimeDelta::Millis(1));
+  nack_module.OnReceivedPacket(0xffff - 100);
+  nack_module.OnReceivedPacket(0xffff - 50, /*is_recovered=*/true);
+  nack_module.OnReceivedPacket(300);
+  // 0xffff - 99 through 299, except the recovered one.
+  EXPECT_EQ(399u, sent_nacks_.size());
+
+  // Retransmissions arriving out of order are removed from the nack list.
+  for (uint16_t seq_num = 0; seq_num < 300; ++seq_num)
+    EXPECT_EQ(1, nack_module.OnReceivedPacket(seq_num));
+
+  sent_nacks_.clear();
+  clock_->AdvanceTimeMilliseconds(kDefaultRttMs);
+  WaitForSendNack();
+  ASSERT_EQ(99u, sent_nacks_.size());
+  EXPECT_EQ(0xffff - 99, sent_nacks_.front());
+  EXPECT_EQ(0xffff, sent_nacks_.back());
+  EXPECT_EQ(sent_nacks_.end(),
+            std::find(sent_nacks_.begin(), sent_nacks_.end(), 0xffff - 50));
+}
+
 TEST_F(TestNackRequester, SendNackWithoutDelay) {
   NackRequester& nack_module = CreateNackModule();
   nack_module.OnReceivedPacket(0);
@@ -114,9 +114,7 @@ PacketBuffer::InsertResult PacketBuffer::InsertPacket(
 
   UpdateMissingPackets(seq_num);
 
-  received_padding_.erase(
-      received_padding_.begin(),
-      received_padding_.lower_bound(seq_num - (buffer_.size() / 4)));
+  received_padding_.EraseUpTo(seq_num - (buffer_.size() / 4) - 1);
 
   result.packets = FindFrames(seq_num);
   return result;
@@ -151,11 +149,8 @@ void PacketBuffer::ClearTo(uint16_t seq_num) {
   first_seq_num_ = seq_num;
 
   is_cleared_to_first_seq_num_ = true;
-  missing_packets_.erase(missing_packets_.begin(),
-                         missing_packets_.lower_bound(seq_num));
-
-  received_padding_.erase(received_padding_.begin(),
-                          received_padding_.lower_bound(seq_num));
+  missing_packets_.EraseUpTo(seq_num - 1);
+  received_padding_.EraseUpTo(seq_num - 1);
 }
 
 void PacketBuffer::Clear() {
@@ -165,7 +160,7 @@ void PacketBuffer::Clear() {
 PacketBuffer::InsertResult PacketBuffer::InsertPadding(uint16_t seq_num) {
   PacketBuffer::InsertResult result;
   UpdateMissingPackets(seq_num);
-  received_padding_.insert(seq_num);
+  received_padding_.Insert(seq_num);
   result.packets = FindFrames(static_cast<uint16_t>(seq_num + 1));
   return result;
 }
@@ -178,6 +173,15 @@ void PacketBuffer::ResetSpsPpsIdrIsH264Keyframe() {
   sps_pps_idr_is_h264_keyframe_ = false;
 }
 
+size_t PacketBuffer::GetMemoryUsageBytes() const {
+  size_t bytes = buffer_.capacity() * sizeof(std::unique_ptr<Packet>);
+  for (const std::unique_ptr<Packet>& packet : buffer_) {
+    if (packet != nullptr)
+      bytes += sizeof(Packet) + packet->video_payload.capacity();
+  }
+  return bytes;
+}
+
 void PacketBuffer::ClearInternal() {
   for (auto& entry : buffer_) {
     entry = nullptr;
@@ -186,8 +190,8 @@ void PacketBuffer::ClearInternal() {
   first_packet_received_ = false;
   is_cleared_to_first_seq_num_ = false;
   newest_inserted_seq_num_.reset();
-  missing_packets_.clear();
-  received_padding_.clear();
+  missing_packets_.Clear();
+  received_padding_.Clear();
 }
 
 bool PacketBuffer::ExpandBufferSize() {
@@ -239,7 +243,7 @@ std::vector<std::unique_ptr<PacketBuffer::Packet>> PacketBuffer::FindFrames(
   auto start = seq_num;
 
   for (size_t i = 0; i < buffer_.size(); ++i) {
-    if (received_padding_.find(seq_num) != received_padding_.end()) {
+    if (received_padding_.Contains(seq_num)) {
       seq_num += 1;
       continue;
     }
@@ -262,21 +266,27 @@ std::vector<std::unique_ptr<PacketBuffer::Packet>> PacketBuffer::FindFrames(
       size_t tested_packets = 0;
       int64_t frame_timestamp = buffer_[start_index]->timestamp;
 
-      // Identify H.264 keyframes by means of SPS, PPS, and IDR.
+      // Identify H.264 keyframes by means of SPS, PPS, and IDR, and H.265
+      // keyframes by means of IRAP pictures.
       bool is_generic = buffer_[start_index]->video_header.generic.has_value();
       bool is_h264_descriptor =
           (buffer_[start_index]->codec() == kVideoCodecH264) && !is_generic;
+      bool is_h265_descriptor =
+          (buffer_[start_index]->codec() == kVideoCodecH265) && !is_generic;
+      // Neither H.264 nor H.265 packets tell where a frame begins.
+      bool is_h26x_descriptor = is_h264_descriptor || is_h265_descriptor;
       bool has_h264_sps = false;
       bool has_h264_pps = false;
       bool has_h264_idr = false;
-      bool is_h264_keyframe = false;
+      bool has_h265_irap = false;
+      bool is_h26x_keyframe = false;
       int idr_width = -1;
       int idr_height = -1;
       bool full_frame_found = false;
       while (true) {
         ++tested_packets;
 
-        if (!is_h264_descriptor) {
+        if (!is_h26x_descriptor) {
           if (buffer_[start_index] == nullptr ||
               buffer_[start_index]->is_first_packet_in_frame()) {
             full_frame_found = buffer_[start_index] != nullptr;
@@ -302,7 +312,7 @@ std::vector<std::unique_ptr<PacketBuffer::Packet>> PacketBuffer::FindFrames(
           if ((sps_pps_idr_is_h264_keyframe_ && has_h264_idr && has_h264_sps &&
                has_h264_pps) ||
               (!sps_pps_idr_is_h264_keyframe_ && has_h264_idr)) {
-            is_h264_keyframe = true;
+            is_h26x_keyframe = true;
             // Store the resolution of key frame which is the packet with
             // smallest index and valid resolution; typically its IDR or SPS
             // packet; there may be packet preceeding this packet, IDR's
@@ -315,18 +325,34 @@ std::vector<std::unique_ptr<PacketBuffer::Packet>> PacketBuffer::FindFrames(
           }
         }
 
+        if (is_h265_descriptor) {
+          // The H.265 depacketizer marks packets carrying IRAP slices as key.
+          has_h265_irap |= buffer_[start_index]->video_header.frame_type ==
+                           VideoFrameType::kVideoFrameKey;
+          if (has_h265_irap) {
+            is_h26x_keyframe = true;
+            // Parameter sets usually precede the IRAP slices, so the
+            // resolution parsed from the SPS is found on an earlier packet.
+            if (buffer_[start_index]->width() > 0 &&
+                buffer_[start_index]->height() > 0) {
+              idr_width = buffer_[start_index]->width();
+              idr_height = buffer_[start_index]->height();
+            }
+          }
+        }
+
         if (tested_packets == buffer_.size())
           break;
 
         start_index = start_index > 0 ? start_index - 1 : buffer_.size() - 1;
 
-        // In the case of H264 we don't have a frame_begin bit (yes,
+        // In the case of H264 and H265 we don't have a frame_begin bit (yes,
         // `frame_begin` might be set to true but that is a lie). So instead
         // we traverese backwards as long as we have a previous packet and
         // the timestamp of that packet is the same as this one. This may cause
         // the PacketBuffer to hand out incomplete frames.
         // See: https://bugs.chromium.org/p/webrtc/issues/detail?id=7106
-        if (is_h264_descriptor &&
+        if (is_h26x_descriptor &&
             (buffer_[start_index] == nullptr ||
              buffer_[start_index]->timestamp != frame_timestamp)) {
           break;
@@ -346,12 +372,14 @@ std::vector<std::unique_ptr<PacketBuffer::Packet>> PacketBuffer::FindFrames(
               << " frame since WebRTC-SpsPpsIdrIsH264Keyframe is "
               << (sps_pps_idr_is_h264_keyframe_ ? "enabled." : "disabled");
         }
+      }
 
+      if (is_h26x_descriptor) {
         // Now that we have decided whether to treat this frame as a key frame
         // or delta frame in the frame buffer, we update the field that
         // determines if the RtpFrameObject is a key frame or delta frame.
         const size_t first_packet_index = start_seq_num % buffer_.size();
-        if (is_h264_keyframe) {
+        if (is_h26x_keyframe) {
           buffer_[first_packet_index]->video_header.frame_type =
               VideoFrameType::kVideoFrameKey;
           if (idr_width > 0 && idr_height > 0) {
@@ -367,13 +395,12 @@ std::vector<std::unique_ptr<PacketBuffer::Packet>> PacketBuffer::FindFrames(
 
         // If this is not a keyframe, make sure there are no gaps in the packet
         // sequence numbers up until this point.
-        if (!is_h264_keyframe && missing_packets_.upper_bound(start_seq_num) !=
-                                     missing_packets_.begin()) {
+        if (!is_h26x_keyframe && missing_packets_.AnyUpTo(start_seq_num)) {
           return found_frames;
         }
       }
 
-      if (is_h264_descriptor || full_frame_found) {
+      if (is_h26x_descriptor || full_frame_found) {
         const uint16_t end_seq_num = seq_num + 1;
         // Use uint16_t type to handle sequence number wrap around case.
         uint16_t num_packets = end_seq_num - start_seq_num;
@@ -388,10 +415,8 @@ std::vector<std::unique_ptr<PacketBuffer::Packet>> PacketBuffer::FindFrames(
           found_frames.push_back(std::move(packet));
         }
 
-        missing_packets_.erase(missing_packets_.begin(),
-                               missing_packets_.upper_bound(seq_num));
-        received_padding_.erase(received_padding_.lower_bound(start),
-                                received_padding_.upper_bound(seq_num));
+        missing_packets_.EraseUpTo(seq_num);
+        received_padding_.EraseRange(start, seq_num);
       }
     }
     ++seq_num;
@@ -406,8 +431,7 @@ void PacketBuffer::UpdateMissingPackets(uint16_t seq_num) {
   const int kMaxPaddingAge = 1000;
   if (AheadOf(seq_num, *newest_inserted_seq_num_)) {
     uint16_t old_seq_num = seq_num - kMaxPaddingAge;
-    auto erase_to = missing_packets_.lower_bound(old_seq_num);
-    missing_packets_.erase(missing_packets_.begin(), erase_to);
+    missing_packets_.EraseUpTo(old_seq_num - 1);
 
     // Guard against inserting a large amount of missing packets if there is a
     // jump in the sequence number.
@@ -416,11 +440,11 @@ void PacketBuffer::UpdateMissingPackets(uint16_t seq_num) {
 
     ++*newest_inserted_seq_num_;
     while (AheadOf(seq_num, *newest_inserted_seq_num_)) {
-      missing_packets_.insert(*newest_inserted_seq_num_);
+      missing_packets_.Insert(*newest_inserted_seq_num_);
       ++*newest_inserted_seq_num_;
     }
   } else {
-    missing_packets_.erase(seq_num);
+    missing_packets_.Erase(seq_num);
   }
 }
 
@@ -13,15 +13,16 @@
 
 #include <memory>
 #include <queue>
-#include <set>
 #include <vector>
 
 #include "absl/base/attributes.h"
+#include "absl/types/optional.h"
 #include "api/rtp_packet_info.h"
 #include "api/units/timestamp.h"
 #include "api/video/encoded_image.h"
 #include "modules/rtp_rtcp/source/rtp_packet_received.h"
 #include "modules/rtp_rtcp/source/rtp_video_header.h"
+#include "modules/video_coding/sequence_number_bitmap.h"
 #include "rtc_base/copy_on_write_buffer.h"
 #include "rtc_base/numerics/sequence_number_util.h"
 #include "rtc_base/thread_annotations.h"
@@ -84,6 +85,9 @@ class PacketBuffer {
   void ForceSpsPpsIdrIsH264Keyframe();
   void ResetSpsPpsIdrIsH264Keyframe();
 
+  // Bytes held by the buffer slots and the payloads of the buffered packets.
+  size_t GetMemoryUsageBytes() const;
+
  private:
   void ClearInternal();
 
@@ -116,9 +120,9 @@ class PacketBuffer {
   std::vector<std::unique_ptr<Packet>> buffer_;
 
   absl::optional<uint16_t> newest_inserted_seq_num_;
-  std::set<uint16_t, DescendingSeqNumComp<uint16_t>> missing_packets_;
+  SequenceNumberBitmap<1024> missing_packets_;
 
-  std::set<uint16_t, DescendingSeqNumComp<uint16_t>> received_padding_;
+  SequenceNumberBitmap<1024> received_padding_;
 
   // Indicates if we should require SPS, PPS, and IDR for a particular
   // RTP timestamp to treat the corresponding frame as a keyframe.
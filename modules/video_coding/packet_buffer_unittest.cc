@@ -211,6 +211,22 @@ TEST_F(PacketBufferTest, ExpandBuffer) {
       Insert(seq_num + kStartSize, kKeyFrame, kNotFirst, kLast).buffer_cleared);
 }
 
+TEST_F(PacketBufferTest, MemoryUsageFollowsBufferedPackets) {
+  const uint16_t seq_num = Rand();
+  const size_t empty_usage = packet_buffer_.GetMemoryUsageBytes();
+  EXPECT_GT(empty_usage, 0u);
+
+  const uint8_t payload[1000] = {};
+  Insert(seq_num, kKeyFrame, kFirst, kNotLast, payload);
+  EXPECT_GE(packet_buffer_.GetMemoryUsageBytes(),
+            empty_usage + sizeof(payload));
+
+  // The completed frame is handed out, which empties the buffer.
+  EXPECT_THAT(Insert(seq_num + 1, kKeyFrame, kNotFirst, kLast).packets,
+              SizeIs(2));
+  EXPECT_EQ(packet_buffer_.GetMemoryUsageBytes(), empty_usage);
+}
+
 TEST_F(PacketBufferTest, SingleFrameExpandsBuffer) {
   const uint16_t seq_num = Rand();
 
@@ -742,6 +758,18 @@ TEST_P(PacketBufferH264ParameterizedTest, FindFramesOnReorderedPadding) {
               StartSeqNumsAre(1, 4));
 }
 
+TEST_P(PacketBufferH264ParameterizedTest, TracksMissingPacketsAcrossWrap) {
+  EXPECT_THAT(InsertH264(65533, kKeyFrame, kFirst, kLast, 1000),
+              StartSeqNumsAre(65533));
+  EXPECT_THAT(InsertH264(1, kDeltaFrame, kFirst, kLast, 1004).packets,
+              IsEmpty());
+  EXPECT_THAT(InsertH264(65534, kDeltaFrame, kFirst, kLast, 1001),
+              StartSeqNumsAre(65534));
+  EXPECT_THAT(InsertH264(65535, kDeltaFrame, kFirst, kLast, 1002),
+              StartSeqNumsAre(65535));
+  EXPECT_THAT(packet_buffer_.InsertPadding(0), StartSeqNumsAre(1));
+}
+
 class PacketBufferH264XIsKeyframeTest : public PacketBufferH264Test {
  protected:
   const uint16_t kSeqNum = 5;
@@ -855,6 +883,58 @@ TEST_F(PacketBufferH264FrameGap, DisallowFrameGapForH264NoGeneric) {
               IsEmpty());
 }
 
+class PacketBufferH265Test : public PacketBufferTest {
+ protected:
+  // The H.265 depacketizer marks every packet that doesn't continue a
+  // fragmentation unit as the first packet of a frame, and packets carrying
+  // IRAP slices as keyframes.
+  PacketBufferInsertResult InsertH265(uint16_t seq_num,
+                                      IsKeyFrame keyframe,
+                                      IsLast last,
+                                      uint32_t timestamp,
+                                      uint32_t width = 0,
+                                      uint32_t height = 0) {
+    auto packet = std::make_unique<PacketBuffer::Packet>();
+    packet->video_header.codec = kVideoCodecH265;
+    packet->seq_num = seq_num;
+    packet->timestamp = timestamp;
+    packet->video_header.frame_type = keyframe == kKeyFrame
+                                          ? VideoFrameType::kVideoFrameKey
+                                          : VideoFrameType::kVideoFrameDelta;
+    packet->video_header.width = width;
+    packet->video_header.height = height;
+    packet->video_header.is_first_packet_in_frame = true;
+    packet->video_header.is_last_packet_in_frame = last == kLast;
+
+    return PacketBufferInsertResult(
+        packet_buffer_.InsertPacket(std::move(packet)));
+  }
+};
+
+TEST_F(PacketBufferH265Test, AssemblesFrameFromPacketsWithSameTimestamp) {
+  // Parameter sets, then two IRAP slices.
+  IgnoreResult(InsertH265(1, kDeltaFrame, kNotLast, 1000, 320, 180));
+  IgnoreResult(InsertH265(2, kKeyFrame, kNotLast, 1000));
+  auto packets = InsertH265(3, kKeyFrame, kLast, 1000).packets;
+
+  ASSERT_THAT(StartSeqNums(packets), ElementsAre(1));
+  ASSERT_THAT(packets, SizeIs(3));
+  EXPECT_THAT(packets[0], KeyFrame());
+  EXPECT_EQ(packets[0]->width(), 320);
+  EXPECT_EQ(packets[0]->height(), 180);
+}
+
+TEST_F(PacketBufferH265Test, DeltaFrameAfterGapIsNotReturned) {
+  IgnoreResult(InsertH265(1, kKeyFrame, kLast, 1000));
+  EXPECT_THAT(InsertH265(3, kDeltaFrame, kLast, 2000).packets, IsEmpty());
+}
+
+TEST_F(PacketBufferH265Test, KeyFrameAfterGapIsReturned) {
+  IgnoreResult(InsertH265(1, kKeyFrame, kLast, 1000));
+  EXPECT_THAT(InsertH265(3, kKeyFrame, kLast, 2000).packets,
+              ElementsAre(KeyFrame()));
+}
+
 }  // namespace
 }  // namespace video_coding
 }  // namespace webrtc
@@ -0,0 +1,101 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CODING_RING_MAP_H_
+#define MODULES_VIDEO_CODING_RING_MAP_H_
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <utility>
+
+namespace webrtc {
+
+// Map from unwrapped (monotonic) 64 bit keys to values, stored in a ring of
+// `kSize` slots indexed by the key. Keys that are a multiple of `kSize` apart
+// share a slot, of which the newer key wins. Meant for state that is only kept
+// for a window of recent keys smaller than `kSize`, where it replaces a
+// std::map without allocating per entry. `T` must be default constructible.
+template <typename T, int kSize>
+class RingMap {
+ public:
+  static_assert(kSize > 0 && (kSize & (kSize - 1)) == 0,
+                "kSize must be a power of two");
+
+  // Returns the value of `key`, or nullptr if there is none.
+  T* Find(int64_t key) {
+    size_t index = Index(key);
+    return keys_[index] == key ? &values_[index] : nullptr;
+  }
+
+  // Inserts `value` for `key` unless there already is a value for it, and
+  // returns the value of `key`. Returns nullptr if the slot is taken by a
+  // newer key.
+  T* Emplace(int64_t key, T value) {
+    size_t index = Index(key);
+    if (keys_[index] > key)
+      return nullptr;
+    if (keys_[index] != key) {
+      keys_[index] = key;
+      values_[index] = std::move(value);
+      min_key_ = std::min(min_key_, key);
+    }
+    return &values_[index];
+  }
+
+  // Erases the values of all keys less than `key`.
+  void EraseBefore(int64_t key) {
+    // Usually there is nothing to erase, avoid scanning the slots then.
+    if (key <= min_key_)
+      return;
+    min_key_ = kMaxKey;
+    for (int64_t& slot_key : keys_) {
+      if (slot_key == kNoKey)
+        continue;
+      if (slot_key < key) {
+        slot_key = kNoKey;
+      } else {
+        min_key_ = std::min(min_key_, slot_key);
+      }
+    }
+  }
+
+  void Clear() {
+    keys_.fill(kNoKey);
+    min_key_ = kMaxKey;
+  }
+
+ private:
+  static constexpr int64_t kNoKey = std::numeric_limits<int64_t>::min();
+  static constexpr int64_t kMaxKey = std::numeric_limits<int64_t>::max();
+
+  static size_t Index(int64_t key) {
+    return static_cast<uint64_t>(key) % kSize;
+  }
+
+  // Keys are kept apart from the values so that EraseBefore() scans little
+  // memory.
+  std::array<int64_t, kSize> keys_ = MakeEmptyKeys();
+  std::array<T, kSize> values_ = {};
+  // Lower bound of the keys in the map.
+  int64_t min_key_ = kMaxKey;
+
+  static std::array<int64_t, kSize> MakeEmptyKeys() {
+    std::array<int64_t, kSize> keys;
+    keys.fill(kNoKey);
+    return keys;
+  }
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CODING_RING_MAP_H_
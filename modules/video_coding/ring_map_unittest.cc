@@ -0,0 +1,63 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/ring_map.h"
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+TEST(RingMapTest, EmplaceDoesNotOverwrite) {
+  RingMap<int, 8> map;
+  EXPECT_EQ(map.Find(3), nullptr);
+  ASSERT_NE(map.Emplace(3, 30), nullptr);
+  EXPECT_EQ(*map.Emplace(3, 31), 30);
+  EXPECT_EQ(*map.Find(3), 30);
+  EXPECT_EQ(map.Find(4), nullptr);
+}
+
+TEST(RingMapTest, NewerKeyWinsSlot) {
+  RingMap<int, 8> map;
+  map.Emplace(3, 30);
+  ASSERT_NE(map.Emplace(3 + 8, 110), nullptr);
+  EXPECT_EQ(map.Find(3), nullptr);
+  EXPECT_EQ(*map.Find(3 + 8), 110);
+
+  EXPECT_EQ(map.Emplace(3, 30), nullptr);
+  EXPECT_EQ(*map.Find(3 + 8), 110);
+}
+
+TEST(RingMapTest, HandlesNegativeKeys) {
+  RingMap<int, 8> map;
+  map.Emplace(-1, 10);
+  map.Emplace(-9, 90);
+  EXPECT_EQ(*map.Find(-1), 10);
+  EXPECT_EQ(map.Find(-9), nullptr);
+  EXPECT_EQ(map.Find(7), nullptr);
+}
+
+TEST(RingMapTest, EraseBefore) {
+  RingMap<int, 8> map;
+  for (int key = 10; key < 15; ++key)
+    map.Emplace(key, key);
+
+  map.EraseBefore(12);
+  EXPECT_EQ(map.Find(10), nullptr);
+  EXPECT_EQ(map.Find(11), nullptr);
+  EXPECT_EQ(*map.Find(12), 12);
+  EXPECT_EQ(*map.Find(14), 14);
+
+  map.Clear();
+  EXPECT_EQ(map.Find(14), nullptr);
+}
+
+}  // namespace
+}  // namespace webrtc
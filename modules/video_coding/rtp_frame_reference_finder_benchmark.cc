@@ -0,0 +1,196 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "modules/rtp_rtcp/source/frame_object.h"
+#include "modules/video_coding/codecs/vp9/include/vp9_globals.h"
+#include "modules/video_coding/rtp_vp8_ref_finder.h"
+#include "modules/video_coding/rtp_vp9_ref_finder.h"
+
+namespace webrtc {
+namespace {
+
+// Frames fed to the finder per benchmark iteration, ten seconds at 30 fps.
+constexpr int kFramesPerBatch = 300;
+// Temporal layer of the frames of a L1T3 pattern.
+constexpr int kL1T3TemporalIdx[] = {0, 2, 1, 2};
+
+std::unique_ptr<RtpFrameObject> CreateFrame(const RTPVideoHeader& video_header,
+                                            VideoCodecType codec) {
+  // clang-format off
+  return std::make_unique<RtpFrameObject>(
+      /*seq_num_start=*/0,
+      /*seq_num_end=*/0,
+      /*markerBit=*/true,
+      /*times_nacked=*/0,
+      /*first_packet_received_time=*/0,
+      /*last_packet_received_time=*/0,
+      /*rtp_timestamp=*/0,
+      /*ntp_time_ms=*/0,
+      VideoSendTiming(),
+      /*payload_type=*/0,
+      codec,
+      kVideoRotation_0,
+      VideoContentType::UNSPECIFIED,
+      video_header,
+      /*color_space=*/absl::nullopt,
+      RtpPacketInfos(),
+      EncodedImageBuffer::Create(/*size=*/0));
+  // clang-format on
+}
+
+// Delivers every tenth frame after the one following it when `reorder` is set,
+// which makes the finders track not yet received frames and stash frames.
+void Reorder(std::vector<std::unique_ptr<RtpFrameObject>>& frames,
+             bool reorder) {
+  if (!reorder)
+    return;
+  for (size_t i = 5; i + 1 < frames.size(); i += 10)
+    std::swap(frames[i], frames[i + 1]);
+}
+
+class Vp8L1T3Stream {
+ public:
+  std::vector<std::unique_ptr<RtpFrameObject>> NextFrames(int num_frames) {
+    std::vector<std::unique_ptr<RtpFrameObject>> frames;
+    for (int i = 0; i < num_frames; ++i, ++frame_num_) {
+      int temporal_idx = kL1T3TemporalIdx[frame_num_ % 4];
+      if (temporal_idx == 0 && frame_num_ > 0)
+        ++tl0_pic_idx_;
+      RTPVideoHeaderVP8 vp8_header{};
+      vp8_header.pictureId = frame_num_ & 0x7FFF;
+      vp8_header.temporalIdx = temporal_idx;
+      vp8_header.tl0PicIdx = tl0_pic_idx_ & 0xFF;
+      vp8_header.layerSync = frame_num_ < 4 && temporal_idx > 0;
+
+      RTPVideoHeader video_header;
+      video_header.frame_type = frame_num_ == 0
+                                    ? VideoFrameType::kVideoFrameKey
+                                    : VideoFrameType::kVideoFrameDelta;
+      video_header.video_type_header = vp8_header;
+      frames.push_back(CreateFrame(video_header, kVideoCodecVP8));
+    }
+    return frames;
+  }
+
+ private:
+  int frame_num_ = 0;
+  int tl0_pic_idx_ = 0;
+};
+
+// Non flexible mode stream with three spatial layers.
+class Vp9L3T3Stream {
+ public:
+  Vp9L3T3Stream() { gof_.SetGofInfoVP9(kTemporalStructureMode3); }
+
+  std::vector<std::unique_ptr<RtpFrameObject>> NextFrames(int num_frames) {
+    std::vector<std::unique_ptr<RtpFrameObject>> frames;
+    for (int i = 0; i < num_frames; ++i) {
+      int spatial_idx = frame_num_ % 3;
+      int picture_num = frame_num_ / 3;
+      int temporal_idx = kL1T3TemporalIdx[picture_num % 4];
+      if (spatial_idx == 0 && temporal_idx == 0 && picture_num > 0)
+        ++tl0_pic_idx_;
+      bool keyframe = picture_num == 0;
+      RTPVideoHeaderVP9 vp9_header{};
+      vp9_header.picture_id = picture_num & 0x7FFF;
+      vp9_header.spatial_idx = spatial_idx;
+      vp9_header.temporal_idx = temporal_idx;
+      vp9_header.tl0_pic_idx = tl0_pic_idx_ & 0xFF;
+      vp9_header.flexible_mode = false;
+      vp9_header.temporal_up_switch = temporal_idx > 0;
+      vp9_header.inter_layer_predicted = spatial_idx > 0;
+      vp9_header.inter_pic_predicted = !keyframe;
+      if (keyframe && spatial_idx == 0) {
+        vp9_header.ss_data_available = true;
+        vp9_header.gof = gof_;
+      }
+
+      RTPVideoHeader video_header;
+      video_header.frame_type = keyframe ? VideoFrameType::kVideoFrameKey
+                                         : VideoFrameType::kVideoFrameDelta;
+      video_header.video_type_header = vp9_header;
+      frames.push_back(CreateFrame(video_header, kVideoCodecVP9));
+      ++frame_num_;
+    }
+    return frames;
+  }
+
+ private:
+  GofInfoVP9 gof_;
+  int frame_num_ = 0;
+  int tl0_pic_idx_ = 0;
+};
+
+template <typename RefFinder, typename Stream>
+void RunRefFinder(benchmark::State& state) {
+  RefFinder ref_finder;
+  Stream stream;
+  std::vector<std::unique_ptr<EncodedFrame>> handed_off;
+  for (auto s : state) {
+    state.PauseTiming();
+    std::vector<std::unique_ptr<RtpFrameObject>> frames =
+        stream.NextFrames(kFramesPerBatch);
+    Reorder(frames, state.range(0));
+    handed_off.clear();
+    state.ResumeTiming();
+    for (auto& frame : frames) {
+      for (auto& f : ref_finder.ManageFrame(std::move(frame)))
+        handed_off.push_back(std::move(f));
+    }
+  }
+  benchmark::DoNotOptimize(handed_off.size());
+  state.SetItemsProcessed(state.iterations() * kFramesPerBatch);
+}
+
+void BM_Vp8L1T3(benchmark::State& state) {
+  RunRefFinder<RtpVp8RefFinder, Vp8L1T3Stream>(state);
+}
+
+void BM_Vp9L3T3(benchmark::State& state) {
+  RunRefFinder<RtpVp9RefFinder, Vp9L3T3Stream>(state);
+}
+
+BENCHMARK(BM_Vp8L1T3)->ArgName("reorder")->Arg(0)->Arg(1);
+BENCHMARK(BM_Vp9L3T3)->ArgName("reorder")->Arg(0)->Arg(1);
+
+}  // namespace
+}  // namespace webrtc
+
+/*
+
+Results:
+
+Frames are handed to the finders of a single stream, in order or with every
+tenth frame reordered.
+
+std::map and std::set based state (Linux):
+-------------------------------------------------------------------------------
+Benchmark                     Time             CPU   Iterations UserCounters...
+-------------------------------------------------------------------------------
+BM_Vp8L1T3/reorder:0      35751 ns        35182 ns        18838 items_per_second=8.52703M/s
+BM_Vp8L1T3/reorder:1      43104 ns        42861 ns        18193 items_per_second=6.9994M/s
+BM_Vp9L3T3/reorder:0      44870 ns        44070 ns        19848 items_per_second=6.80732M/s
+BM_Vp9L3T3/reorder:1      52094 ns        51293 ns        13205 items_per_second=5.84879M/s
+
+RingMap and SequenceNumberBitmap based state (Linux):
+-------------------------------------------------------------------------------
+Benchmark                     Time             CPU   Iterations UserCounters...
+-------------------------------------------------------------------------------
+BM_Vp8L1T3/reorder:0      23274 ns        22884 ns        30848 items_per_second=13.1095M/s
+BM_Vp8L1T3/reorder:1      26451 ns        26017 ns        29018 items_per_second=11.5308M/s
+BM_Vp9L3T3/reorder:0      23397 ns        22971 ns        31551 items_per_second=13.0601M/s
+BM_Vp9L3T3/reorder:1      23049 ns        22579 ns        29239 items_per_second=13.2869M/s
+
+*/
@@ -65,9 +65,8 @@ RtpVp8RefFinder::FrameDecision RtpVp8RefFinder::ManageFrameInternal(
   // Clean up info about not yet received frames that are too old.
   uint16_t old_picture_id =
       Subtract<kFrameIdLength>(frame->Id(), kMaxNotYetReceivedFrames);
-  auto clean_frames_to = not_yet_received_frames_.lower_bound(old_picture_id);
-  not_yet_received_frames_.erase(not_yet_received_frames_.begin(),
-                                 clean_frames_to);
+  not_yet_received_frames_.EraseUpTo(
+      Subtract<kFrameIdLength>(old_picture_id, 1));
   // Avoid re-adding picture ids that were just erased.
   if (AheadOf<uint16_t, kFrameIdLength>(old_picture_id, last_picture_id_)) {
     last_picture_id_ = old_picture_id;
@@ -77,40 +76,43 @@ RtpVp8RefFinder::FrameDecision RtpVp8RefFinder::ManageFrameInternal(
   if (AheadOf<uint16_t, kFrameIdLength>(frame->Id(), last_picture_id_)) {
     do {
       last_picture_id_ = Add<kFrameIdLength>(last_picture_id_, 1);
-      not_yet_received_frames_.insert(last_picture_id_);
+      not_yet_received_frames_.Insert(last_picture_id_);
     } while (last_picture_id_ != frame->Id());
   }
 
   // Clean up info for base layers that are too old.
-  int64_t old_tl0_pic_idx = unwrapped_tl0 - kMaxLayerInfo;
-  auto clean_layer_info_to = layer_info_.lower_bound(old_tl0_pic_idx);
-  layer_info_.erase(layer_info_.begin(), clean_layer_info_to);
+  layer_info_.EraseBefore(unwrapped_tl0 - kMaxLayerInfo);
 
   if (frame->frame_type() == VideoFrameType::kVideoFrameKey) {
     if (codec_header.temporalIdx != 0) {
       return kDrop;
     }
+    LayerInfo* layer_info = layer_info_.Emplace(unwrapped_tl0, LayerInfo());
+    // Too old to be tracked.
+    if (!layer_info)
+      return kDrop;
     frame->num_references = 0;
-    layer_info_[unwrapped_tl0].fill(-1);
+    layer_info->fill(-1);
     UpdateLayerInfoVp8(frame, unwrapped_tl0, codec_header.temporalIdx);
     return kHandOff;
   }
 
-  auto layer_info_it = layer_info_.find(
+  LayerInfo* layer_info = layer_info_.Find(
       codec_header.temporalIdx == 0 ? unwrapped_tl0 - 1 : unwrapped_tl0);
 
   // If we don't have the base layer frame yet, stash this frame.
-  if (layer_info_it == layer_info_.end())
+  if (!layer_info)
     return kStash;
 
   // A non keyframe base layer frame has been received, copy the layer info
   // from the previous base layer frame and set a reference to the previous
   // base layer frame.
   if (codec_header.temporalIdx == 0) {
-    layer_info_it =
-        layer_info_.emplace(unwrapped_tl0, layer_info_it->second).first;
+    layer_info = layer_info_.Emplace(unwrapped_tl0, *layer_info);
+    if (!layer_info)
+      return kDrop;
     frame->num_references = 1;
-    int64_t last_pid_on_layer = layer_info_it->second[0];
+    int64_t last_pid_on_layer = (*layer_info)[0];
 
     // Is this an old frame that has already been used to update the state? If
     // so, drop it.
@@ -126,7 +128,7 @@ RtpVp8RefFinder::FrameDecision RtpVp8RefFinder::ManageFrameInternal(
   // Layer sync frame, this frame only references its base layer frame.
   if (codec_header.layerSync) {
     frame->num_references = 1;
-    int64_t last_pid_on_layer = layer_info_it->second[codec_header.temporalIdx];
+    int64_t last_pid_on_layer = (*layer_info)[codec_header.temporalIdx];
 
     // Is this an old frame that has already been used to update the state? If
     // so, drop it.
@@ -135,7 +137,7 @@ RtpVp8RefFinder::FrameDecision RtpVp8RefFinder::ManageFrameInternal(
       return kDrop;
     }
 
-    frame->references[0] = layer_info_it->second[0];
+    frame->references[0] = (*layer_info)[0];
     UpdateLayerInfoVp8(frame, unwrapped_tl0, codec_header.temporalIdx);
     return kHandOff;
   }
@@ -145,29 +147,26 @@ RtpVp8RefFinder::FrameDecision RtpVp8RefFinder::ManageFrameInternal(
   for (uint8_t layer = 0; layer <= codec_header.temporalIdx; ++layer) {
     // If we have not yet received a previous frame on this temporal layer,
     // stash this frame.
-    if (layer_info_it->second[layer] == -1)
+    if ((*layer_info)[layer] == -1)
       return kStash;
 
     // If the last frame on this layer is ahead of this frame it means that
     // a layer sync frame has been received after this frame for the same
     // base layer frame, drop this frame.
-    if (AheadOf<uint16_t, kFrameIdLength>(layer_info_it->second[layer],
-                                          frame->Id())) {
+    if (AheadOf<uint16_t, kFrameIdLength>((*layer_info)[layer], frame->Id())) {
       return kDrop;
     }
 
     // If we have not yet received a frame between this frame and the referenced
     // frame then we have to wait for that frame to be completed first.
-    auto not_received_frame_it =
-        not_yet_received_frames_.upper_bound(layer_info_it->second[layer]);
-    if (not_received_frame_it != not_yet_received_frames_.end() &&
-        AheadOf<uint16_t, kFrameIdLength>(frame->Id(),
-                                          *not_received_frame_it)) {
+    if (not_yet_received_frames_.AnyInRange(
+            Add<kFrameIdLength>((*layer_info)[layer], 1),
+            Subtract<kFrameIdLength>(frame->Id(), 1))) {
       return kStash;
     }
 
     if (!(AheadOf<uint16_t, kFrameIdLength>(frame->Id(),
-                                            layer_info_it->second[layer]))) {
+                                            (*layer_info)[layer]))) {
       RTC_LOG(LS_WARNING) << "Frame with picture id " << frame->Id()
                           << " and packet range [" << frame->first_seq_num()
                           << ", " << frame->last_seq_num()
@@ -177,7 +176,7 @@ RtpVp8RefFinder::FrameDecision RtpVp8RefFinder::ManageFrameInternal(
     }
 
     ++frame->num_references;
-    frame->references[layer] = layer_info_it->second[layer];
+    frame->references[layer] = (*layer_info)[layer];
   }
 
   UpdateLayerInfoVp8(frame, unwrapped_tl0, codec_header.temporalIdx);
@@ -187,23 +186,23 @@ RtpVp8RefFinder::FrameDecision RtpVp8RefFinder::ManageFrameInternal(
 void RtpVp8RefFinder::UpdateLayerInfoVp8(RtpFrameObject* frame,
                                          int64_t unwrapped_tl0,
                                          uint8_t temporal_idx) {
-  auto layer_info_it = layer_info_.find(unwrapped_tl0);
+  LayerInfo* layer_info = layer_info_.Find(unwrapped_tl0);
 
   // Update this layer info and newer.
-  while (layer_info_it != layer_info_.end()) {
-    if (layer_info_it->second[temporal_idx] != -1 &&
-        AheadOf<uint16_t, kFrameIdLength>(layer_info_it->second[temporal_idx],
+  while (layer_info) {
+    if ((*layer_info)[temporal_idx] != -1 &&
+        AheadOf<uint16_t, kFrameIdLength>((*layer_info)[temporal_idx],
                                           frame->Id())) {
       // The frame was not newer, then no subsequent layer info have to be
       // update.
       break;
     }
 
-    layer_info_it->second[temporal_idx] = frame->Id();
+    (*layer_info)[temporal_idx] = frame->Id();
     ++unwrapped_tl0;
-    layer_info_it = layer_info_.find(unwrapped_tl0);
+    layer_info = layer_info_.Find(unwrapped_tl0);
   }
-  not_yet_received_frames_.erase(frame->Id());
+  not_yet_received_frames_.Erase(frame->Id());
 
   UnwrapPictureIds(frame);
 }
@@ -11,14 +11,15 @@
 #ifndef MODULES_VIDEO_CODING_RTP_VP8_REF_FINDER_H_
 #define MODULES_VIDEO_CODING_RTP_VP8_REF_FINDER_H_
 
+#include <array>
 #include <deque>
-#include <map>
 #include <memory>
-#include <set>
 
 #include "absl/container/inlined_vector.h"
 #include "modules/rtp_rtcp/source/frame_object.h"
+#include "modules/video_coding/ring_map.h"
 #include "modules/video_coding/rtp_frame_reference_finder.h"
+#include "modules/video_coding/sequence_number_bitmap.h"
 #include "rtc_base/numerics/sequence_number_unwrapper.h"
 
 namespace webrtc {
@@ -60,8 +61,7 @@ class RtpVp8RefFinder {
 
   // Frames earlier than the last received frame that have not yet been
   // fully received.
-  std::set<uint16_t, DescendingSeqNumComp<uint16_t, kFrameIdLength>>
-      not_yet_received_frames_;
+  SequenceNumberBitmap<128, kFrameIdLength> not_yet_received_frames_;
 
   // Frames that have been fully received but didn't have all the information
   // needed to determine their references.
@@ -69,7 +69,8 @@ class RtpVp8RefFinder {
 
   // Holds the information about the last completed frame for a given temporal
   // layer given an unwrapped Tl0 picture index.
-  std::map<int64_t, std::array<int64_t, kMaxTemporalLayers>> layer_info_;
+  using LayerInfo = std::array<int64_t, kMaxTemporalLayers>;
+  RingMap<LayerInfo, 64> layer_info_;
 
   // Unwrapper used to unwrap VP8/VP9 streams which have their picture id
   // specified.
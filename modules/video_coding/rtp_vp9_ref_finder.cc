@@ -115,17 +115,15 @@ RtpVp9RefFinder::FrameDecision RtpVp9RefFinder::ManageFrameGof(
       current_ss_idx_ = Add<kMaxGofSaved>(current_ss_idx_, 1);
       scalability_structures_[current_ss_idx_] = gof;
       scalability_structures_[current_ss_idx_].pid_start = frame->Id();
-      gof_info_.emplace(
+      gof_info_.Emplace(
           unwrapped_tl0,
           GofInfo(&scalability_structures_[current_ss_idx_], frame->Id()));
     }
 
-    const auto gof_info_it = gof_info_.find(unwrapped_tl0);
-    if (gof_info_it == gof_info_.end())
+    info = gof_info_.Find(unwrapped_tl0);
+    if (!info)
       return kStash;
 
-    info = &gof_info_it->second;
-
     if (frame->frame_type() == VideoFrameType::kVideoFrameKey) {
       frame->num_references = 0;
       FrameReceivedVp9(frame->Id(), info);
@@ -137,38 +135,36 @@ RtpVp9RefFinder::FrameDecision RtpVp9RefFinder::ManageFrameGof(
       RTC_LOG(LS_WARNING) << "Received keyframe without scalability structure";
       return kDrop;
     }
-    const auto gof_info_it = gof_info_.find(unwrapped_tl0);
-    if (gof_info_it == gof_info_.end())
+    info = gof_info_.Find(unwrapped_tl0);
+    if (!info)
       return kStash;
 
-    info = &gof_info_it->second;
-
     frame->num_references = 0;
     FrameReceivedVp9(frame->Id(), info);
     FlattenFrameIdAndRefs(frame, codec_header.inter_layer_predicted);
     return kHandOff;
   } else {
-    auto gof_info_it = gof_info_.find(
-        (codec_header.temporal_idx == 0) ? unwrapped_tl0 - 1 : unwrapped_tl0);
+    info = gof_info_.Find((codec_header.temporal_idx == 0) ? unwrapped_tl0 - 1
+                                                           : unwrapped_tl0);
 
     // Gof info for this frame is not available yet, stash this frame.
-    if (gof_info_it == gof_info_.end())
+    if (!info)
       return kStash;
 
     if (codec_header.temporal_idx == 0) {
-      gof_info_it = gof_info_
-                        .emplace(unwrapped_tl0,
-                                 GofInfo(gof_info_it->second.gof, frame->Id()))
-                        .first;
+      info = gof_info_.Emplace(unwrapped_tl0, GofInfo(info->gof, frame->Id()));
+      // Too old to be tracked.
+      if (!info)
+        return kDrop;
     }
-
-    info = &gof_info_it->second;
   }
 
   // Clean up info for base layers that are too old.
-  int64_t old_tl0_pic_idx = unwrapped_tl0 - kMaxGofSaved;
-  auto clean_gof_info_to = gof_info_.lower_bound(old_tl0_pic_idx);
-  gof_info_.erase(gof_info_.begin(), clean_gof_info_to);
+  gof_info_.EraseBefore(unwrapped_tl0 - kMaxGofSaved);
+  uint16_t old_missing_picture_id =
+      Subtract<kFrameIdLength>(frame->Id(), kMaxMissingFrameAge);
+  for (auto& missing_frames : missing_frames_for_layer_)
+    missing_frames.EraseUpTo(old_missing_picture_id);
 
   FrameReceivedVp9(frame->Id(), info);
 
@@ -177,13 +173,19 @@ RtpVp9RefFinder::FrameDecision RtpVp9RefFinder::ManageFrameGof(
   if (MissingRequiredFrameVp9(frame->Id(), *info))
     return kStash;
 
-  if (codec_header.temporal_up_switch)
-    up_switch_.emplace(frame->Id(), codec_header.temporal_idx);
+  if (codec_header.temporal_up_switch &&
+      std::none_of(up_switch_.begin(), up_switch_.end(),
+                   [&](const auto& up_switch) {
+                     return up_switch.Contains(frame->Id());
+                   })) {
+    up_switch_[codec_header.temporal_idx].Insert(frame->Id());
+  }
 
   // Clean out old info about up switch frames.
-  uint16_t old_picture_id = Subtract<kFrameIdLength>(frame->Id(), 50);
-  auto up_switch_erase_to = up_switch_.lower_bound(old_picture_id);
-  up_switch_.erase(up_switch_.begin(), up_switch_erase_to);
+  uint16_t old_picture_id =
+      Subtract<kFrameIdLength>(frame->Id(), kMaxUpSwitchAge + 1);
+  for (auto& up_switch : up_switch_)
+    up_switch.EraseUpTo(old_picture_id);
 
   size_t diff =
       ForwardDiff<uint16_t, kFrameIdLength>(info->gof->pid_start, frame->Id());
@@ -237,9 +239,8 @@ bool RtpVp9RefFinder::MissingRequiredFrameVp9(uint16_t picture_id,
     uint16_t ref_pid =
         Subtract<kFrameIdLength>(picture_id, info.gof->pid_diff[gof_idx][i]);
     for (size_t l = 0; l < temporal_idx; ++l) {
-      auto missing_frame_it = missing_frames_for_layer_[l].lower_bound(ref_pid);
-      if (missing_frame_it != missing_frames_for_layer_[l].end() &&
-          AheadOf<uint16_t, kFrameIdLength>(picture_id, *missing_frame_it)) {
+      if (missing_frames_for_layer_[l].AnyInRange(
+              ref_pid, Subtract<kFrameIdLength>(picture_id, 1))) {
         return true;
       }
     }
@@ -272,7 +273,7 @@ void RtpVp9RefFinder::FrameReceivedVp9(uint16_t picture_id, GofInfo* info) {
         return;
       }
 
-      missing_frames_for_layer_[temporal_idx].insert(last_picture_id);
+      missing_frames_for_layer_[temporal_idx].Insert(last_picture_id);
       last_picture_id = Add<kFrameIdLength>(last_picture_id, 1);
     }
 
@@ -291,21 +292,19 @@ void RtpVp9RefFinder::FrameReceivedVp9(uint16_t picture_id, GofInfo* info) {
       return;
     }
 
-    missing_frames_for_layer_[temporal_idx].erase(picture_id);
+    missing_frames_for_layer_[temporal_idx].Erase(picture_id);
   }
 }
 
 bool RtpVp9RefFinder::UpSwitchInIntervalVp9(uint16_t picture_id,
                                             uint8_t temporal_idx,
                                             uint16_t pid_ref) {
-  for (auto up_switch_it = up_switch_.upper_bound(pid_ref);
-       up_switch_it != up_switch_.end() &&
-       AheadOf<uint16_t, kFrameIdLength>(picture_id, up_switch_it->first);
-       ++up_switch_it) {
-    if (up_switch_it->second < temporal_idx)
+  for (uint8_t l = 0; l < temporal_idx; ++l) {
+    if (up_switch_[l].AnyInRange(Add<kFrameIdLength>(pid_ref, 1),
+                                 Subtract<kFrameIdLength>(picture_id, 1))) {
       return true;
+    }
   }
-
   return false;
 }
 
@@ -11,14 +11,15 @@
 #ifndef MODULES_VIDEO_CODING_RTP_VP9_REF_FINDER_H_
 #define MODULES_VIDEO_CODING_RTP_VP9_REF_FINDER_H_
 
+#include <array>
 #include <deque>
-#include <map>
 #include <memory>
-#include <set>
 
 #include "absl/container/inlined_vector.h"
 #include "modules/rtp_rtcp/source/frame_object.h"
+#include "modules/video_coding/ring_map.h"
 #include "modules/video_coding/rtp_frame_reference_finder.h"
+#include "modules/video_coding/sequence_number_bitmap.h"
 #include "rtc_base/numerics/sequence_number_unwrapper.h"
 
 namespace webrtc {
@@ -38,14 +39,19 @@ class RtpVp9RefFinder {
   static constexpr int kMaxNotYetReceivedFrames = 100;
   static constexpr int kMaxStashedFrames = 100;
   static constexpr int kMaxTemporalLayers = 5;
+  static constexpr int kMaxUpSwitchAge = 50;
+  // Missing frames older than this are forgotten. References reach at most
+  // 255 picture ids back.
+  static constexpr int kMaxMissingFrameAge = 512;
 
   enum FrameDecision { kStash, kHandOff, kDrop };
 
   struct GofInfo {
+    GofInfo() = default;
     GofInfo(GofInfoVP9* gof, uint16_t last_picture_id)
         : gof(gof), last_picture_id(last_picture_id) {}
-    GofInfoVP9* gof;
-    uint16_t last_picture_id;
+    GofInfoVP9* gof = nullptr;
+    uint16_t last_picture_id = 0;
   };
 
   struct UnwrappedTl0Frame {
@@ -81,15 +87,15 @@ class RtpVp9RefFinder {
   std::array<GofInfoVP9, kMaxGofSaved> scalability_structures_;
 
   // Holds the the Gof information for a given unwrapped TL0 picture index.
-  std::map<int64_t, GofInfo> gof_info_;
+  RingMap<GofInfo, 64> gof_info_;
 
-  // Keep track of which picture id and which temporal layer that had the
-  // up switch flag set.
-  std::map<uint16_t, uint8_t, DescendingSeqNumComp<uint16_t, kFrameIdLength>>
+  // For every temporal layer, keep track of which picture ids had the up switch
+  // flag set.
+  std::array<SequenceNumberBitmap<128, kFrameIdLength>, kMaxTemporalLayers>
       up_switch_;
 
   // For every temporal layer, keep a set of which frames that are missing.
-  std::array<std::set<uint16_t, DescendingSeqNumComp<uint16_t, kFrameIdLength>>,
+  std::array<SequenceNumberBitmap<kMaxMissingFrameAge, kFrameIdLength>,
              kMaxTemporalLayers>
       missing_frames_for_layer_;
 
@@ -0,0 +1,164 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CODING_SEQUENCE_NUMBER_BITMAP_H_
+#define MODULES_VIDEO_CODING_SEQUENCE_NUMBER_BITMAP_H_
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <array>
+
+#include "absl/types/optional.h"
+#include "rtc_base/numerics/mod_ops.h"
+#include "rtc_base/numerics/sequence_number_util.h"
+
+namespace webrtc {
+
+// Set of 16 bit sequence numbers stored as a ring of `kSize` bits. Only
+// sequence numbers less than `kSize` behind the newest inserted one are kept,
+// older ones are dropped. All operations are constant time or word-wise scans
+// of at most `kSize` bits. Sequence numbers wrap at `M`, or at 2^16 if `M` is
+// zero.
+template <int kSize, uint16_t M = 0>
+class SequenceNumberBitmap {
+ public:
+  static_assert(kSize >= 64 && kSize <= (1 << 14) && (kSize & (kSize - 1)) == 0,
+                "kSize must be a power of two in [64, 16384]");
+  static_assert(M == 0 || (M >= 2 * kSize && M % kSize == 0),
+                "M must be a multiple of kSize, and at least twice as large");
+
+  void Insert(uint16_t seq_num) {
+    if (!newest_) {
+      newest_ = seq_num;
+    } else if (AheadOf<uint16_t, M>(seq_num, *newest_)) {
+      // Bits of sequence numbers falling out of the window are reused for the
+      // sequence numbers entering it.
+      ClearBits(Offset(*newest_, 1),
+                std::min<int>(ForwardDiff<uint16_t, M>(*newest_, seq_num),
+                              kSize));
+      newest_ = seq_num;
+    } else if (!InWindow(seq_num)) {
+      return;
+    }
+    size_t index = seq_num % kSize;
+    bits_[index / 64] |= uint64_t{1} << (index % 64);
+  }
+
+  void Erase(uint16_t seq_num) {
+    if (InWindow(seq_num))
+      ClearBits(seq_num, 1);
+  }
+
+  bool Contains(uint16_t seq_num) const {
+    return InWindow(seq_num) && AnyBits(seq_num, 1);
+  }
+
+  // Erases all sequence numbers up to and including `seq_num`.
+  void EraseUpTo(uint16_t seq_num) {
+    if (!newest_)
+      return;
+    if (!AheadOf<uint16_t, M>(*newest_, seq_num)) {
+      bits_.fill(0);
+      return;
+    }
+    int newer = ForwardDiff<uint16_t, M>(seq_num, *newest_);
+    if (newer < kSize)
+      ClearBits(Offset(*newest_, 1 - kSize), kSize - newer);
+  }
+
+  // Erases all sequence numbers in [`first`, `last`].
+  void EraseRange(uint16_t first, uint16_t last) {
+    if (!newest_ || AheadOf<uint16_t, M>(first, *newest_))
+      return;
+    if (AheadOf<uint16_t, M>(last, *newest_))
+      last = *newest_;
+    if (!InWindow(first))
+      first = Offset(*newest_, 1 - kSize);
+    if (AheadOf<uint16_t, M>(first, last))
+      return;
+    ClearBits(first, ForwardDiff<uint16_t, M>(first, last) + 1);
+  }
+
+  // Returns true if any sequence number in [`first`, `last`] is in the set.
+  bool AnyInRange(uint16_t first, uint16_t last) const {
+    if (!newest_ || AheadOf<uint16_t, M>(first, *newest_))
+      return false;
+    if (AheadOf<uint16_t, M>(last, *newest_))
+      last = *newest_;
+    if (!InWindow(first))
+      first = Offset(*newest_, 1 - kSize);
+    if (AheadOf<uint16_t, M>(first, last))
+      return false;
+    return AnyBits(first, ForwardDiff<uint16_t, M>(first, last) + 1);
+  }
+
+  // Returns true if any sequence number up to and including `seq_num` is in
+  // the set.
+  bool AnyUpTo(uint16_t seq_num) const {
+    if (!newest_)
+      return false;
+    if (!AheadOf<uint16_t, M>(*newest_, seq_num))
+      return AnyBits(Offset(*newest_, 1), kSize);
+    int newer = ForwardDiff<uint16_t, M>(seq_num, *newest_);
+    return newer < kSize && AnyBits(Offset(*newest_, 1 - kSize), kSize - newer);
+  }
+
+  void Clear() {
+    newest_.reset();
+    bits_.fill(0);
+  }
+
+ private:
+  bool InWindow(uint16_t seq_num) const {
+    return newest_ && ForwardDiff<uint16_t, M>(seq_num, *newest_) < kSize;
+  }
+
+  static uint16_t Offset(uint16_t seq_num, int offset) {
+    if (M == 0)
+      return static_cast<uint16_t>(seq_num + offset);
+    return static_cast<uint16_t>((seq_num + M + offset) % M);
+  }
+
+  static uint64_t Mask(int bit, int count) {
+    return (count == 64 ? ~uint64_t{0} : (uint64_t{1} << count) - 1) << bit;
+  }
+
+  void ClearBits(uint16_t first, int count) {
+    while (count > 0) {
+      size_t index = first % kSize;
+      int bit = index % 64;
+      int n = std::min(count, 64 - bit);
+      bits_[index / 64] &= ~Mask(bit, n);
+      first += n;
+      count -= n;
+    }
+  }
+
+  bool AnyBits(uint16_t first, int count) const {
+    while (count > 0) {
+      size_t index = first % kSize;
+      int bit = index % 64;
+      int n = std::min(count, 64 - bit);
+      if (bits_[index / 64] & Mask(bit, n))
+        return true;
+      first += n;
+      count -= n;
+    }
+    return false;
+  }
+
+  absl::optional<uint16_t> newest_;
+  std::array<uint64_t, kSize / 64> bits_ = {};
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CODING_SEQUENCE_NUMBER_BITMAP_H_
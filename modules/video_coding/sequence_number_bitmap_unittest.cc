@@ -0,0 +1,132 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/sequence_number_bitmap.h"
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+TEST(SequenceNumberBitmapTest, InsertAndErase) {
+  SequenceNumberBitmap<64> bitmap;
+  EXPECT_FALSE(bitmap.Contains(10));
+  bitmap.Insert(10);
+  bitmap.Insert(12);
+  EXPECT_TRUE(bitmap.Contains(10));
+  EXPECT_FALSE(bitmap.Contains(11));
+  EXPECT_TRUE(bitmap.Contains(12));
+  // Same bit position in the ring, but a different sequence number.
+  EXPECT_FALSE(bitmap.Contains(10 + 64));
+
+  bitmap.Erase(10);
+  EXPECT_FALSE(bitmap.Contains(10));
+  EXPECT_TRUE(bitmap.Contains(12));
+}
+
+TEST(SequenceNumberBitmapTest, DropsSequenceNumbersOutsideWindow) {
+  SequenceNumberBitmap<64> bitmap;
+  bitmap.Insert(100);
+  bitmap.Insert(100 - 64);
+  EXPECT_FALSE(bitmap.Contains(100 - 64));
+
+  bitmap.Insert(100 + 63);
+  EXPECT_TRUE(bitmap.Contains(100));
+  bitmap.Insert(100 + 64);
+  EXPECT_FALSE(bitmap.Contains(100));
+  EXPECT_TRUE(bitmap.Contains(100 + 63));
+  EXPECT_TRUE(bitmap.Contains(100 + 64));
+}
+
+TEST(SequenceNumberBitmapTest, LargeJumpClearsOldSequenceNumbers) {
+  SequenceNumberBitmap<64> bitmap;
+  bitmap.Insert(1);
+  bitmap.Insert(1 + 1000);
+  EXPECT_FALSE(bitmap.AnyUpTo(1000));
+  EXPECT_TRUE(bitmap.Contains(1 + 1000));
+}
+
+TEST(SequenceNumberBitmapTest, EraseUpToAndAnyUpToHandleWrap) {
+  SequenceNumberBitmap<128> bitmap;
+  bitmap.Insert(65530);
+  bitmap.Insert(65535);
+  bitmap.Insert(2);
+
+  EXPECT_FALSE(bitmap.AnyUpTo(65529));
+  EXPECT_TRUE(bitmap.AnyUpTo(65530));
+  EXPECT_TRUE(bitmap.AnyUpTo(100));
+
+  bitmap.EraseUpTo(65535);
+  EXPECT_FALSE(bitmap.Contains(65530));
+  EXPECT_FALSE(bitmap.Contains(65535));
+  EXPECT_TRUE(bitmap.Contains(2));
+  EXPECT_FALSE(bitmap.AnyUpTo(1));
+  EXPECT_TRUE(bitmap.AnyUpTo(2));
+}
+
+TEST(SequenceNumberBitmapTest, EraseRange) {
+  SequenceNumberBitmap<256> bitmap;
+  for (uint16_t seq_num = 0; seq_num < 200; ++seq_num)
+    bitmap.Insert(seq_num);
+
+  bitmap.EraseRange(10, 150);
+  EXPECT_TRUE(bitmap.Contains(9));
+  EXPECT_FALSE(bitmap.Contains(10));
+  EXPECT_FALSE(bitmap.Contains(150));
+  EXPECT_TRUE(bitmap.Contains(151));
+
+  // Ranges reaching beyond the window are clamped to it.
+  bitmap.EraseRange(180, 1000);
+  EXPECT_TRUE(bitmap.Contains(179));
+  EXPECT_FALSE(bitmap.Contains(199));
+}
+
+TEST(SequenceNumberBitmapTest, AnyInRange) {
+  SequenceNumberBitmap<128> bitmap;
+  bitmap.Insert(65534);
+  bitmap.Insert(3);
+
+  EXPECT_TRUE(bitmap.AnyInRange(65530, 65534));
+  EXPECT_FALSE(bitmap.AnyInRange(65535, 2));
+  EXPECT_TRUE(bitmap.AnyInRange(65535, 3));
+  EXPECT_FALSE(bitmap.AnyInRange(4, 100));
+  // Empty range.
+  EXPECT_FALSE(bitmap.AnyInRange(3, 2));
+}
+
+TEST(SequenceNumberBitmapTest, WrapsAtModulus) {
+  constexpr uint16_t kModulus = 1 << 15;
+  SequenceNumberBitmap<128, kModulus> bitmap;
+  bitmap.Insert(kModulus - 2);
+  bitmap.Insert(1);
+  EXPECT_TRUE(bitmap.Contains(kModulus - 2));
+  EXPECT_TRUE(bitmap.Contains(1));
+  EXPECT_FALSE(bitmap.AnyInRange(kModulus - 1, 0));
+  EXPECT_TRUE(bitmap.AnyInRange(kModulus - 1, 1));
+
+  bitmap.EraseUpTo(kModulus - 1);
+  EXPECT_FALSE(bitmap.Contains(kModulus - 2));
+  EXPECT_TRUE(bitmap.Contains(1));
+
+  // Crossing the modulus drops sequence numbers falling out of the window.
+  bitmap.Insert(1 + 128);
+  EXPECT_FALSE(bitmap.Contains(1));
+}
+
+TEST(SequenceNumberBitmapTest, Clear) {
+  SequenceNumberBitmap<64> bitmap;
+  bitmap.Insert(5);
+  bitmap.Clear();
+  EXPECT_FALSE(bitmap.Contains(5));
+  EXPECT_FALSE(bitmap.AnyUpTo(5));
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -24,6 +24,7 @@
 #include "api/units/timestamp.h"
 #include "modules/video_coding/timing/rtt_filter.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/experiments/parsed_field_trial_cache.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/numerics/safe_conversions.h"
 #include "system_wrappers/include/clock.h"
@@ -131,7 +132,7 @@ JitterEstimator::Config JitterEstimator::Config::ParseAndValidate(
 
 JitterEstimator::JitterEstimator(Clock* clock,
                                  const FieldTrialsView& field_trials)
-    : config_(Config::ParseAndValidate(
+    : config_(ParseFieldTrialCached<&Config::ParseAndValidate>(
           field_trials.Lookup(Config::kFieldTrialsKey))),
       avg_frame_size_median_bytes_(static_cast<size_t>(
           config_.frame_size_window.value_or(kDefaultFrameSizeWindow))),
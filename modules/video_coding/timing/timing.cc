@@ -61,6 +61,8 @@ VCMTiming::VCMTiming(Clock* clock, const FieldTrialsView& field_trials)
       last_decode_scheduled_(Timestamp::Zero()) {
   ParseFieldTrial({&zero_playout_delay_min_pacing_},
                   field_trials.Lookup("WebRTC-ZeroPlayoutDelay"));
+  MutexLock lock(&mutex_);
+  PublishSnapshot();
 }
 
 void VCMTiming::Reset() {
@@ -72,16 +74,17 @@ void VCMTiming::Reset() {
   jitter_delay_ = TimeDelta::Zero();
   current_delay_ = TimeDelta::Zero();
   prev_frame_timestamp_ = 0;
+  PublishSnapshot();
 }
 
 void VCMTiming::set_render_delay(TimeDelta render_delay) {
   MutexLock lock(&mutex_);
   render_delay_ = render_delay;
+  PublishSnapshot();
 }
 
 TimeDelta VCMTiming::min_playout_delay() const {
-  MutexLock lock(&mutex_);
-  return min_playout_delay_;
+  return snapshot_.Load().min_playout_delay;
 }
 
 void VCMTiming::set_min_playout_delay(TimeDelta min_playout_delay) {
@@ -89,6 +92,7 @@ void VCMTiming::set_min_playout_delay(TimeDelta min_playout_delay) {
   if (min_playout_delay_ != min_playout_delay) {
     CheckDelaysValid(min_playout_delay, max_playout_delay_);
     min_playout_delay_ = min_playout_delay;
+    PublishSnapshot();
   }
 }
 
@@ -97,9 +101,16 @@ void VCMTiming::set_max_playout_delay(TimeDelta max_playout_delay) {
   if (max_playout_delay_ != max_playout_delay) {
     CheckDelaysValid(min_playout_delay_, max_playout_delay);
     max_playout_delay_ = max_playout_delay;
+    PublishSnapshot();
   }
 }
 
+bool VCMTiming::HasZeroPlayoutDelay() const {
+  Snapshot snapshot = snapshot_.Load();
+  return snapshot.min_playout_delay.IsZero() &&
+         snapshot.max_playout_delay.IsZero();
+}
+
 void VCMTiming::SetJitterDelay(TimeDelta jitter_delay) {
   MutexLock lock(&mutex_);
   if (jitter_delay != jitter_delay_) {
@@ -108,6 +119,7 @@ void VCMTiming::SetJitterDelay(TimeDelta jitter_delay) {
     if (current_delay_.IsZero()) {
       current_delay_ = jitter_delay_;
     }
+    PublishSnapshot();
   }
 }
 
@@ -150,6 +162,7 @@ void VCMTiming::UpdateCurrentDelay(uint32_t frame_timestamp) {
     current_delay_ = current_delay_ + delay_diff;
   }
   prev_frame_timestamp_ = frame_timestamp;
+  PublishSnapshot();
 }
 
 void VCMTiming::UpdateCurrentDelay(Timestamp render_time,
@@ -168,6 +181,7 @@ void VCMTiming::UpdateCurrentDelay(Timestamp render_time,
   } else {
     current_delay_ = target_delay;
   }
+  PublishSnapshot();
 }
 
 void VCMTiming::StopDecodeTimer(TimeDelta decode_time, Timestamp now) {
@@ -175,6 +189,7 @@ void VCMTiming::StopDecodeTimer(TimeDelta decode_time, Timestamp now) {
   decode_time_filter_->AddTiming(decode_time.ms(), now.ms());
   RTC_DCHECK_GE(decode_time, TimeDelta::Zero());
   ++num_decoded_frames_;
+  PublishSnapshot();
 }
 
 void VCMTiming::IncomingTimestamp(uint32_t rtp_timestamp, Timestamp now) {
@@ -243,8 +258,7 @@ TimeDelta VCMTiming::MaxWaitingTime(Timestamp render_time,
 }
 
 TimeDelta VCMTiming::TargetVideoDelay() const {
-  MutexLock lock(&mutex_);
-  return TargetDelayInternal();
+  return snapshot_.Load().target_delay;
 }
 
 TimeDelta VCMTiming::TargetDelayInternal() const {
@@ -260,9 +274,7 @@ TimeDelta VCMTiming::StatsTargetDelayInternal() const {
 }
 
 VideoFrame::RenderParameters VCMTiming::RenderParameters() const {
-  MutexLock lock(&mutex_);
-  return {.use_low_latency_rendering = UseLowLatencyRendering(),
-          .max_composition_delay_in_frames = max_composition_delay_in_frames_};
+  return snapshot_.Load().render_parameters;
 }
 
 bool VCMTiming::UseLowLatencyRendering() const {
@@ -275,16 +287,33 @@ bool VCMTiming::UseLowLatencyRendering() const {
 }
 
 VCMTiming::VideoDelayTimings VCMTiming::GetTimings() const {
-  MutexLock lock(&mutex_);
+  Snapshot snapshot = snapshot_.Load();
   return VideoDelayTimings{
+      .num_decoded_frames = snapshot.num_decoded_frames,
+      .minimum_delay = snapshot.jitter_delay,
+      .estimated_max_decode_time = snapshot.estimated_max_decode_time,
+      .render_delay = snapshot.render_delay,
+      .min_playout_delay = snapshot.min_playout_delay,
+      .max_playout_delay = snapshot.max_playout_delay,
+      .target_delay = snapshot.stats_target_delay,
+      .current_delay = snapshot.current_delay};
+}
+
+void VCMTiming::PublishSnapshot() {
+  snapshot_.Store(Snapshot{
       .num_decoded_frames = num_decoded_frames_,
-      .minimum_delay = jitter_delay_,
+      .jitter_delay = jitter_delay_,
       .estimated_max_decode_time = EstimatedMaxDecodeTime(),
       .render_delay = render_delay_,
       .min_playout_delay = min_playout_delay_,
       .max_playout_delay = max_playout_delay_,
-      .target_delay = StatsTargetDelayInternal(),
-      .current_delay = current_delay_};
+      .target_delay = TargetDelayInternal(),
+      .stats_target_delay = StatsTargetDelayInternal(),
+      .current_delay = current_delay_,
+      .render_parameters = {
+          .use_low_latency_rendering = UseLowLatencyRendering(),
+          .max_composition_delay_in_frames =
+              max_composition_delay_in_frames_}});
 }
 
 void VCMTiming::SetTimingFrameInfo(const TimingFrameInfo& info) {
@@ -301,6 +330,7 @@ void VCMTiming::SetMaxCompositionDelayInFrames(
     absl::optional<int> max_composition_delay_in_frames) {
   MutexLock lock(&mutex_);
   max_composition_delay_in_frames_ = max_composition_delay_in_frames;
+  PublishSnapshot();
 }
 
 }  // namespace webrtc
@@ -22,11 +22,17 @@
 #include "modules/video_coding/timing/timestamp_extrapolator.h"
 #include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/synchronization/seq_lock.h"
 #include "rtc_base/thread_annotations.h"
 #include "system_wrappers/include/clock.h"
 
 namespace webrtc {
 
+// State is updated from the worker and decode threads under a mutex. The
+// values read by stats and the decode path (`GetTimings()`,
+// `TargetVideoDelay()`, `RenderParameters()` and the playout delay getters) are
+// published as a snapshot on every update and read without taking the mutex,
+// so that polling stats never blocks the threads that update the timing.
 class VCMTiming {
  public:
   struct VideoDelayTimings {
@@ -76,6 +82,10 @@ class VCMTiming {
   // Set/get the maximum playout delay from capture to render in ms.
   void set_max_playout_delay(TimeDelta max_playout_delay);
 
+  // Returns true if both the minimum and maximum playout delay are zero, i.e.
+  // frames should be decoded and rendered as soon as they are complete.
+  bool HasZeroPlayoutDelay() const;
+
   // Increases or decreases the current delay to get closer to the target delay.
   // Calculates how long it has been since the previous call to this function,
   // and increases/decreases the delay in proportion to the time difference.
@@ -138,8 +148,26 @@ class VCMTiming {
   TimeDelta StatsTargetDelayInternal() const
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
   bool UseLowLatencyRendering() const RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  // Publishes the current state to `snapshot_`, must be called after every
+  // change to state that is part of the snapshot.
+  void PublishSnapshot() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  struct Snapshot {
+    size_t num_decoded_frames = 0;
+    TimeDelta jitter_delay = TimeDelta::Zero();
+    TimeDelta estimated_max_decode_time = TimeDelta::Zero();
+    TimeDelta render_delay = TimeDelta::Zero();
+    TimeDelta min_playout_delay = TimeDelta::Zero();
+    TimeDelta max_playout_delay = TimeDelta::Zero();
+    TimeDelta target_delay = TimeDelta::Zero();
+    TimeDelta stats_target_delay = TimeDelta::Zero();
+    TimeDelta current_delay = TimeDelta::Zero();
+    VideoFrame::RenderParameters render_parameters;
+  };
 
   mutable Mutex mutex_;
+  // Written with `mutex_` held, read without it.
+  SeqLock<Snapshot> snapshot_;
   Clock* const clock_;
   const std::unique_ptr<TimestampExtrapolator> ts_extrapolator_
       RTC_PT_GUARDED_BY(mutex_);
@@ -67,6 +67,12 @@ void VideoReceiver2::RegisterExternalDecoder(
   }
 }
 
+std::unique_ptr<VideoDecoder> VideoReceiver2::TakeExternalDecoder(
+    uint8_t payload_type) {
+  RTC_DCHECK_RUN_ON(&decoder_sequence_checker_);
+  return codec_database_.TakeExternalDecoder(payload_type);
+}
+
 bool VideoReceiver2::IsExternalDecoderRegistered(uint8_t payload_type) const {
   RTC_DCHECK_RUN_ON(&decoder_sequence_checker_);
   return codec_database_.IsExternalDecoderRegistered(payload_type);
@@ -46,6 +46,10 @@ class VideoReceiver2 {
   void RegisterExternalDecoder(std::unique_ptr<VideoDecoder> decoder,
                                uint8_t payload_type);
 
+  // Deregisters the decoder for `payload_type` and returns it, released if it
+  // was in use. Returns null if there is none.
+  std::unique_ptr<VideoDecoder> TakeExternalDecoder(uint8_t payload_type);
+
   bool IsExternalDecoderRegistered(uint8_t payload_type) const;
   int32_t RegisterReceiveCallback(VCMReceiveCallback* receive_callback);
 
@@ -14,6 +14,7 @@
 #include <cstdint>
 #include <string>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "absl/types/optional.h"
@@ -88,7 +89,7 @@ absl::optional<SackChunk> SackChunk::Parse(rtc::ArrayView<const uint8_t> data) {
     offset += kGapAckBlockSize;
   }
 
-  std::set<TSN> duplicate_tsns;
+  webrtc::flat_set<TSN> duplicate_tsns;
   for (int i = 0; i < nbr_of_dup_tsns; ++i) {
     BoundedByteReader<kDupTsnBlockSize> sub_reader =
         reader->sub_reader<kDupTsnBlockSize>(offset);
@@ -98,7 +99,8 @@ absl::optional<SackChunk> SackChunk::Parse(rtc::ArrayView<const uint8_t> data) {
   }
   RTC_DCHECK(offset == reader->variable_data_size());
 
-  return SackChunk(tsn_ack, a_rwnd, gap_ack_blocks, duplicate_tsns);
+  return SackChunk(tsn_ack, a_rwnd, std::move(gap_ack_blocks),
+                   std::move(duplicate_tsns));
 }
 
 void SackChunk::SerializeTo(std::vector<uint8_t>& out) const {
@@ -12,7 +12,6 @@
 #include <stddef.h>
 
 #include <cstdint>
-#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -21,6 +20,7 @@
 #include "api/array_view.h"
 #include "net/dcsctp/packet/chunk/chunk.h"
 #include "net/dcsctp/packet/tlv_trait.h"
+#include "rtc_base/containers/flat_set.h"
 
 namespace dcsctp {
 
@@ -49,7 +49,7 @@ class SackChunk : public Chunk, public TLVTrait<SackChunkConfig> {
   SackChunk(TSN cumulative_tsn_ack,
             uint32_t a_rwnd,
             std::vector<GapAckBlock> gap_ack_blocks,
-            std::set<TSN> duplicate_tsns)
+            webrtc::flat_set<TSN> duplicate_tsns)
       : cumulative_tsn_ack_(cumulative_tsn_ack),
         a_rwnd_(a_rwnd),
         gap_ack_blocks_(std::move(gap_ack_blocks)),
@@ -64,7 +64,7 @@ class SackChunk : public Chunk, public TLVTrait<SackChunkConfig> {
   rtc::ArrayView<const GapAckBlock> gap_ack_blocks() const {
     return gap_ack_blocks_;
   }
-  const std::set<TSN>& duplicate_tsns() const { return duplicate_tsns_; }
+  const webrtc::flat_set<TSN>& duplicate_tsns() const { return duplicate_tsns_; }
 
  private:
   static constexpr size_t kGapAckBlockSize = 4;
@@ -73,7 +73,7 @@ class SackChunk : public Chunk, public TLVTrait<SackChunkConfig> {
   const TSN cumulative_tsn_ack_;
   const uint32_t a_rwnd_;
   std::vector<GapAckBlock> gap_ack_blocks_;
-  std::set<TSN> duplicate_tsns_;
+  webrtc::flat_set<TSN> duplicate_tsns_;
 };
 }  // namespace dcsctp
 
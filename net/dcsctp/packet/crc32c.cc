@@ -9,21 +9,38 @@
  */
 #include "net/dcsctp/packet/crc32c.h"
 
+#include <cstddef>
 #include <cstdint>
 
+#include "rtc_base/checks.h"
 #include "third_party/crc32c/src/include/crc32c/crc32c.h"
 
 namespace dcsctp {
+namespace {
+constexpr uint8_t kZeros[4] = {0, 0, 0, 0};
 
-uint32_t GenerateCrc32C(rtc::ArrayView<const uint8_t> data) {
-  uint32_t crc32c = crc32c_value(data.data(), data.size());
-
+uint32_t ToNetworkByteOrder(uint32_t crc32c) {
   // Byte swapping for little endian byte order:
   uint8_t byte0 = crc32c;
   uint8_t byte1 = crc32c >> 8;
   uint8_t byte2 = crc32c >> 16;
   uint8_t byte3 = crc32c >> 24;
-  crc32c = ((byte0 << 24) | (byte1 << 16) | (byte2 << 8) | byte3);
-  return crc32c;
+  return ((byte0 << 24) | (byte1 << 16) | (byte2 << 8) | byte3);
+}
+}  // namespace
+
+uint32_t GenerateCrc32C(rtc::ArrayView<const uint8_t> data) {
+  return ToNetworkByteOrder(crc32c_value(data.data(), data.size()));
+}
+
+uint32_t GenerateCrc32C(rtc::ArrayView<const uint8_t> data,
+                        size_t zeroed_offset) {
+  RTC_DCHECK_LE(zeroed_offset + sizeof(kZeros), data.size());
+  uint32_t crc32c = crc32c_extend(0, data.data(), zeroed_offset);
+  crc32c = crc32c_extend(crc32c, kZeros, sizeof(kZeros));
+  size_t rest_offset = zeroed_offset + sizeof(kZeros);
+  crc32c = crc32c_extend(crc32c, data.data() + rest_offset,
+                         data.size() - rest_offset);
+  return ToNetworkByteOrder(crc32c);
 }
 }  // namespace dcsctp
@@ -10,6 +10,7 @@
 #ifndef NET_DCSCTP_PACKET_CRC32C_H_
 #define NET_DCSCTP_PACKET_CRC32C_H_
 
+#include <cstddef>
 #include <cstdint>
 
 #include "api/array_view.h"
@@ -19,6 +20,12 @@ namespace dcsctp {
 // Generates the CRC32C checksum of `data`.
 uint32_t GenerateCrc32C(rtc::ArrayView<const uint8_t> data);
 
+// Generates the CRC32C checksum of `data`, as if the four bytes starting at
+// `zeroed_offset` were zero. This allows a checksum that is stored within
+// `data` to be verified without modifying or copying `data`.
+uint32_t GenerateCrc32C(rtc::ArrayView<const uint8_t> data,
+                        size_t zeroed_offset);
+
 }  // namespace dcsctp
 
 #endif  // NET_DCSCTP_PACKET_CRC32C_H_
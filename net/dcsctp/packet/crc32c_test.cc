@@ -9,6 +9,8 @@
  */
 #include "net/dcsctp/packet/crc32c.h"
 
+#include <vector>
+
 #include "test/gmock.h"
 
 namespace dcsctp {
@@ -54,5 +56,22 @@ TEST(Crc32Test, TestVectors) {
   EXPECT_EQ(GenerateCrc32C(kISCSICommandPDU), 0x563a96d9U);
 }
 
+TEST(Crc32Test, CanTreatFieldAsZero) {
+  std::vector<uint8_t> zeroed_middle(k32Incrementing.begin(),
+                                     k32Incrementing.end());
+  zeroed_middle[8] = zeroed_middle[9] = zeroed_middle[10] = 0;
+  zeroed_middle[11] = 0;
+  EXPECT_EQ(GenerateCrc32C(k32Incrementing, /*zeroed_offset=*/8),
+            GenerateCrc32C(zeroed_middle));
+
+  std::vector<uint8_t> zeroed_end(k32Ones.begin(), k32Ones.end());
+  zeroed_end[28] = zeroed_end[29] = zeroed_end[30] = zeroed_end[31] = 0;
+  EXPECT_EQ(GenerateCrc32C(k32Ones, /*zeroed_offset=*/28),
+            GenerateCrc32C(zeroed_end));
+
+  EXPECT_EQ(GenerateCrc32C(kShort, /*zeroed_offset=*/0),
+            GenerateCrc32C(kManyZeros));
+}
+
 }  // namespace
 }  // namespace dcsctp
@@ -11,14 +11,68 @@
 #define NET_DCSCTP_PACKET_DATA_H_
 
 #include <cstdint>
+#include <memory>
 #include <utility>
 #include <vector>
 
 #include "net/dcsctp/common/internal_types.h"
 #include "net/dcsctp/public/types.h"
+#include "rtc_base/checks.h"
 
 namespace dcsctp {
 
+// A view of a range of bytes in a reference counted buffer, which is never
+// modified once created. A message that is fragmented into several chunks, and
+// the copies of those chunks that are retained for retransmission, all share
+// the buffer of the message instead of copying its bytes.
+class Payload {
+ public:
+  using value_type = uint8_t;
+  using const_iterator = const uint8_t*;
+
+  Payload() = default;
+  explicit Payload(std::vector<uint8_t> bytes)
+      : buffer_(std::make_shared<std::vector<uint8_t>>(std::move(bytes))),
+        size_(buffer_->size()) {}
+
+  // Returns a view of `size` bytes starting at `offset`, sharing this buffer.
+  Payload Slice(size_t offset, size_t size) const {
+    RTC_DCHECK_LE(offset + size, size_);
+    Payload slice;
+    slice.buffer_ = buffer_;
+    slice.offset_ = offset_ + offset;
+    slice.size_ = size;
+    return slice;
+  }
+
+  const uint8_t* data() const {
+    return buffer_ != nullptr ? buffer_->data() + offset_ : nullptr;
+  }
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  const_iterator begin() const { return data(); }
+  const_iterator end() const { return data() + size_; }
+
+  // Extracts the bytes, as a destructive action. The buffer is moved out
+  // without copying if this is the only view of it and it spans all of it.
+  std::vector<uint8_t> ReleaseBytes() && {
+    std::vector<uint8_t> bytes;
+    if (buffer_ != nullptr && buffer_.use_count() == 1 && offset_ == 0 &&
+        size_ == buffer_->size()) {
+      bytes = std::move(*buffer_);
+    } else {
+      bytes.assign(begin(), end());
+    }
+    *this = Payload();
+    return bytes;
+  }
+
+ private:
+  std::shared_ptr<std::vector<uint8_t>> buffer_;
+  size_t offset_ = 0;
+  size_t size_ = 0;
+};
+
 // Represents data that is either received and extracted from a DATA/I-DATA
 // chunk, or data that is supposed to be sent, and wrapped in a DATA/I-DATA
 // chunk (depending on peer capabilities).
@@ -49,6 +103,25 @@ struct Data {
        IsBeginning is_beginning,
        IsEnd is_end,
        IsUnordered is_unordered)
+      : Data(stream_id,
+             ssn,
+             mid,
+             fsn,
+             ppid,
+             Payload(std::move(payload)),
+             is_beginning,
+             is_end,
+             is_unordered) {}
+
+  Data(StreamID stream_id,
+       SSN ssn,
+       MID mid,
+       FSN fsn,
+       PPID ppid,
+       Payload payload,
+       IsBeginning is_beginning,
+       IsEnd is_end,
+       IsUnordered is_unordered)
       : stream_id(stream_id),
         ssn(ssn),
         mid(mid),
@@ -63,7 +136,7 @@ struct Data {
   Data(Data&& other) = default;
   Data& operator=(Data&& other) = default;
 
-  // Creates a copy of this `Data` object.
+  // Creates a copy of this `Data` object. The payload is shared, not copied.
   Data Clone() const {
     return Data(stream_id, ssn, mid, fsn, ppid, payload, is_beginning, is_end,
                 is_unordered);
@@ -90,7 +163,7 @@ struct Data {
   PPID ppid;
 
   // The actual data payload.
-  std::vector<uint8_t> payload;
+  Payload payload;
 
   // If this data represents the first, last or a middle chunk.
   IsBeginning is_beginning;
@@ -121,10 +121,6 @@ absl::optional<SctpPacket> SctpPacket::Parse(rtc::ArrayView<const uint8_t> data,
   common_header.verification_tag = VerificationTag(reader.Load32<4>());
   common_header.checksum = reader.Load32<8>();
 
-  // Create a copy of the packet, which will be held by this object.
-  std::vector<uint8_t> data_copy =
-      std::vector<uint8_t>(data.begin(), data.end());
-
   if (options.disable_checksum_verification ||
       (options.enable_zero_checksum && common_header.checksum == 0u)) {
     // https://www.ietf.org/archive/id/draft-tuexen-tsvwg-sctp-zero-checksum-01.html#section-4.3:
@@ -133,9 +129,10 @@ absl::optional<SctpPacket> SctpPacket::Parse(rtc::ArrayView<const uint8_t> data,
     // checksum value of zero in addition to SCTP packets containing the correct
     // CRC32c checksum value for this association.
   } else {
-    // Verify the checksum. The checksum field must be zero when that's done.
-    BoundedByteWriter<kHeaderSize>(data_copy).Store32<8>(0);
-    uint32_t calculated_checksum = GenerateCrc32C(data_copy);
+    // Verify the checksum, which is calculated as if the checksum field was
+    // zero. That's done on the received data, before it's copied, so that
+    // invalid packets are dropped without allocating anything.
+    uint32_t calculated_checksum = GenerateCrc32C(data, /*zeroed_offset=*/8);
     if (calculated_checksum != common_header.checksum) {
       RTC_DLOG(LS_WARNING) << rtc::StringFormat(
           "Invalid packet checksum, packet_checksum=0x%08x, "
@@ -143,11 +140,12 @@ absl::optional<SctpPacket> SctpPacket::Parse(rtc::ArrayView<const uint8_t> data,
           common_header.checksum, calculated_checksum);
       return absl::nullopt;
     }
-    // Restore the checksum in the header.
-    BoundedByteWriter<kHeaderSize>(data_copy).Store32<8>(
-        common_header.checksum);
   }
 
+  // Create a copy of the packet, which will be held by this object.
+  std::vector<uint8_t> data_copy =
+      std::vector<uint8_t>(data.begin(), data.end());
+
   // Validate and parse the chunk headers in the message.
   /*
     0                   1                   2                   3
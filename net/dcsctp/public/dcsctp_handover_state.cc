@@ -9,12 +9,108 @@
  */
 #include "net/dcsctp/public/dcsctp_handover_state.h"
 
+#include <cstdint>
+#include <limits>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "api/array_view.h"
 
 namespace dcsctp {
 namespace {
+// Increased whenever the serialization format changes.
+constexpr uint8_t kSerializationVersion = 1;
+
+// Writes values in the serialization format. Integers are written as LEB128
+// variable length integers, as most of them are small.
+class Writer {
+ public:
+  void Write(uint64_t value) {
+    while (value >= 0x80) {
+      out_.push_back(static_cast<uint8_t>(value) | 0x80);
+      value >>= 7;
+    }
+    out_.push_back(static_cast<uint8_t>(value));
+  }
+
+  void Write(const std::vector<uint8_t>& bytes) {
+    Write(bytes.size());
+    out_.insert(out_.end(), bytes.begin(), bytes.end());
+  }
+
+  std::vector<uint8_t> Release() && { return std::move(out_); }
+
+ private:
+  std::vector<uint8_t> out_;
+};
+
+// Reads values written by `Writer`. When a read fails, all subsequent reads
+// fail as well, so that errors only need to be checked once, at the end.
+class Reader {
+ public:
+  explicit Reader(rtc::ArrayView<const uint8_t> data) : data_(data) {}
+
+  bool ok() const { return ok_; }
+  bool at_end() const { return offset_ == data_.size(); }
+
+  template <typename T>
+  void Read(T& value) {
+    uint64_t v = ReadVarint();
+    if (v > static_cast<uint64_t>(std::numeric_limits<T>::max())) {
+      ok_ = false;
+      return;
+    }
+    value = static_cast<T>(v);
+  }
+
+  void Read(std::vector<uint8_t>& bytes) {
+    size_t size = 0;
+    Read(size);
+    if (!ok_ || size > data_.size() - offset_) {
+      ok_ = false;
+      return;
+    }
+    bytes.assign(data_.begin() + offset_, data_.begin() + offset_ + size);
+    offset_ += size;
+  }
+
+  // Reads the number of elements of a list, of which each is serialized as at
+  // least one byte. That bounds the size of a corrupt list.
+  size_t ReadCount() {
+    size_t count = 0;
+    Read(count);
+    if (count > data_.size() - offset_) {
+      ok_ = false;
+      return 0;
+    }
+    return count;
+  }
+
+ private:
+  uint64_t ReadVarint() {
+    uint64_t value = 0;
+    for (int shift = 0; ok_ && shift < 64; shift += 7) {
+      if (offset_ == data_.size()) {
+        break;
+      }
+      uint8_t byte = data_[offset_++];
+      value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0) {
+        return value;
+      }
+    }
+    ok_ = false;
+    return 0;
+  }
+
+  const rtc::ArrayView<const uint8_t> data_;
+  size_t offset_ = 0;
+  bool ok_ = true;
+};
+
 constexpr absl::string_view HandoverUnreadinessReasonToString(
     HandoverUnreadinessReason reason) {
   switch (reason) {
@@ -65,4 +161,153 @@ std::string HandoverReadinessStatus::ToString() const {
   }
   return result;
 }
+
+std::vector<uint8_t> SerializeHandoverState(
+    const DcSctpSocketHandoverState& state) {
+  Writer w;
+  w.Write(kSerializationVersion);
+  w.Write(static_cast<uint64_t>(state.socket_state));
+  w.Write(state.my_verification_tag);
+  w.Write(state.my_initial_tsn);
+  w.Write(state.peer_verification_tag);
+  w.Write(state.peer_initial_tsn);
+  w.Write(state.tie_tag);
+
+  w.Write(state.capabilities.partial_reliability);
+  w.Write(state.capabilities.message_interleaving);
+  w.Write(state.capabilities.reconfig);
+  w.Write(state.capabilities.zero_checksum);
+  w.Write(state.capabilities.negotiated_maximum_incoming_streams);
+  w.Write(state.capabilities.negotiated_maximum_outgoing_streams);
+
+  w.Write(state.tx.next_tsn);
+  w.Write(state.tx.next_reset_req_sn);
+  w.Write(state.tx.cwnd);
+  w.Write(state.tx.rwnd);
+  w.Write(state.tx.ssthresh);
+  w.Write(state.tx.partial_bytes_acked);
+  w.Write(state.tx.streams.size());
+  for (const DcSctpSocketHandoverState::OutgoingStream& stream :
+       state.tx.streams) {
+    w.Write(stream.id);
+    w.Write(stream.next_ssn);
+    w.Write(stream.next_unordered_mid);
+    w.Write(stream.next_ordered_mid);
+    w.Write(stream.priority);
+  }
+  w.Write(state.tx.messages.size());
+  for (const DcSctpSocketHandoverState::OutgoingMessage& message :
+       state.tx.messages) {
+    w.Write(message.stream_id);
+    w.Write(message.ppid);
+    w.Write(message.unordered);
+    w.Write(message.max_retransmissions);
+    // Offset by one, to encode the absence of a lifetime as zero.
+    w.Write(message.remaining_lifetime_ms < 0
+                ? 0
+                : static_cast<uint64_t>(message.remaining_lifetime_ms) + 1);
+    w.Write(message.lifecycle_id);
+    w.Write(message.payload);
+  }
+
+  w.Write(state.rx.seen_packet);
+  w.Write(state.rx.last_cumulative_acked_tsn);
+  w.Write(state.rx.last_assembled_tsn);
+  w.Write(state.rx.last_completed_deferred_reset_req_sn);
+  w.Write(state.rx.last_completed_reset_req_sn);
+  w.Write(state.rx.ordered_streams.size());
+  for (const DcSctpSocketHandoverState::OrderedStream& stream :
+       state.rx.ordered_streams) {
+    w.Write(stream.id);
+    w.Write(stream.next_ssn);
+  }
+  w.Write(state.rx.unordered_streams.size());
+  for (const DcSctpSocketHandoverState::UnorderedStream& stream :
+       state.rx.unordered_streams) {
+    w.Write(stream.id);
+  }
+  return std::move(w).Release();
+}
+
+absl::optional<DcSctpSocketHandoverState> DeserializeHandoverState(
+    rtc::ArrayView<const uint8_t> data) {
+  Reader r(data);
+  uint8_t version = 0;
+  r.Read(version);
+  if (!r.ok() || version != kSerializationVersion) {
+    return absl::nullopt;
+  }
+
+  DcSctpSocketHandoverState state;
+  uint8_t socket_state = 0;
+  r.Read(socket_state);
+  if (socket_state >
+      static_cast<uint8_t>(DcSctpSocketHandoverState::SocketState::kConnected)) {
+    return absl::nullopt;
+  }
+  state.socket_state =
+      static_cast<DcSctpSocketHandoverState::SocketState>(socket_state);
+  r.Read(state.my_verification_tag);
+  r.Read(state.my_initial_tsn);
+  r.Read(state.peer_verification_tag);
+  r.Read(state.peer_initial_tsn);
+  r.Read(state.tie_tag);
+
+  r.Read(state.capabilities.partial_reliability);
+  r.Read(state.capabilities.message_interleaving);
+  r.Read(state.capabilities.reconfig);
+  r.Read(state.capabilities.zero_checksum);
+  r.Read(state.capabilities.negotiated_maximum_incoming_streams);
+  r.Read(state.capabilities.negotiated_maximum_outgoing_streams);
+
+  r.Read(state.tx.next_tsn);
+  r.Read(state.tx.next_reset_req_sn);
+  r.Read(state.tx.cwnd);
+  r.Read(state.tx.rwnd);
+  r.Read(state.tx.ssthresh);
+  r.Read(state.tx.partial_bytes_acked);
+  state.tx.streams.resize(r.ReadCount());
+  for (DcSctpSocketHandoverState::OutgoingStream& stream : state.tx.streams) {
+    r.Read(stream.id);
+    r.Read(stream.next_ssn);
+    r.Read(stream.next_unordered_mid);
+    r.Read(stream.next_ordered_mid);
+    r.Read(stream.priority);
+  }
+  state.tx.messages.resize(r.ReadCount());
+  for (DcSctpSocketHandoverState::OutgoingMessage& message :
+       state.tx.messages) {
+    r.Read(message.stream_id);
+    r.Read(message.ppid);
+    r.Read(message.unordered);
+    r.Read(message.max_retransmissions);
+    int64_t lifetime = 0;
+    r.Read(lifetime);
+    message.remaining_lifetime_ms = lifetime - 1;
+    r.Read(message.lifecycle_id);
+    r.Read(message.payload);
+  }
+
+  r.Read(state.rx.seen_packet);
+  r.Read(state.rx.last_cumulative_acked_tsn);
+  r.Read(state.rx.last_assembled_tsn);
+  r.Read(state.rx.last_completed_deferred_reset_req_sn);
+  r.Read(state.rx.last_completed_reset_req_sn);
+  state.rx.ordered_streams.resize(r.ReadCount());
+  for (DcSctpSocketHandoverState::OrderedStream& stream :
+       state.rx.ordered_streams) {
+    r.Read(stream.id);
+    r.Read(stream.next_ssn);
+  }
+  state.rx.unordered_streams.resize(r.ReadCount());
+  for (DcSctpSocketHandoverState::UnorderedStream& stream :
+       state.rx.unordered_streams) {
+    r.Read(stream.id);
+  }
+
+  if (!r.ok() || !r.at_end()) {
+    return absl::nullopt;
+  }
+  return state;
+}
 }  // namespace dcsctp
@@ -14,6 +14,8 @@
 #include <string>
 #include <vector>
 
+#include "absl/types/optional.h"
+#include "api/array_view.h"
 #include "rtc_base/strong_alias.h"
 
 namespace dcsctp {
@@ -21,8 +23,8 @@ namespace dcsctp {
 // Stores state snapshot of a dcSCTP socket. The snapshot can be used to
 // recreate the socket - possibly in another process. This state should be
 // treaded as opaque - the calling client should not inspect or alter it except
-// for serialization. Serialization is not provided by dcSCTP. If needed it has
-// to be implemented in the calling client.
+// for serialization. A compact binary serialization is provided by
+// `SerializeHandoverState` and `DeserializeHandoverState`.
 struct DcSctpSocketHandoverState {
   enum class SocketState {
     kClosed,
@@ -53,6 +55,17 @@ struct DcSctpSocketHandoverState {
     uint32_t next_ordered_mid = 0;
     uint16_t priority = 0;
   };
+  // A message in the send queue, of which no fragment has been sent yet.
+  struct OutgoingMessage {
+    uint32_t stream_id = 0;
+    uint32_t ppid = 0;
+    bool unordered = false;
+    uint16_t max_retransmissions = 0xFFFF;
+    // The time left until the message expires, or -1 if it doesn't expire.
+    int64_t remaining_lifetime_ms = -1;
+    uint64_t lifecycle_id = 0;
+    std::vector<uint8_t> payload;
+  };
   struct Transmission {
     uint32_t next_tsn = 0;
     uint32_t next_reset_req_sn = 0;
@@ -61,6 +74,7 @@ struct DcSctpSocketHandoverState {
     uint32_t ssthresh = 0;
     uint32_t partial_bytes_acked = 0;
     std::vector<OutgoingStream> streams;
+    std::vector<OutgoingMessage> messages;
   };
   Transmission tx;
 
@@ -83,9 +97,24 @@ struct DcSctpSocketHandoverState {
   Receive rx;
 };
 
+// Serializes `state` to a compact binary format, which can be parsed by
+// `DeserializeHandoverState`. The format is only meant to be used between
+// sockets of the same dcSCTP version, e.g. when moving an association between
+// threads or hosts, and not for persistent storage.
+std::vector<uint8_t> SerializeHandoverState(
+    const DcSctpSocketHandoverState& state);
+
+// Parses a state serialized by `SerializeHandoverState`. Returns nullopt if
+// `data` is not a valid serialized state.
+absl::optional<DcSctpSocketHandoverState> DeserializeHandoverState(
+    rtc::ArrayView<const uint8_t> data);
+
 // A list of possible reasons for a socket to be not ready for handover.
 enum class HandoverUnreadinessReason : uint32_t {
   kWrongConnectionState = 1,
+  // A message in the send queue has been partially sent, or is on a stream
+  // that is being reset, or the socket is closed. Otherwise, queued messages
+  // are handed over.
   kSendQueueNotEmpty = 2,
   kPendingStreamResetRequest = 4,
   kDataTrackerTsnBlocksPending = 8,
@@ -0,0 +1,114 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "net/dcsctp/public/dcsctp_handover_state.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "net/dcsctp/testing/testing_macros.h"
+#include "rtc_base/gunit.h"
+#include "test/gmock.h"
+
+namespace dcsctp {
+namespace {
+using ::testing::ElementsAre;
+
+DcSctpSocketHandoverState CreateState() {
+  DcSctpSocketHandoverState state;
+  state.socket_state = DcSctpSocketHandoverState::SocketState::kConnected;
+  state.my_verification_tag = 0xFFFFFFFF;
+  state.my_initial_tsn = 2;
+  state.peer_verification_tag = 3;
+  state.peer_initial_tsn = 4;
+  state.tie_tag = 0xFFFFFFFFFFFFFFFF;
+  state.capabilities.partial_reliability = true;
+  state.capabilities.reconfig = true;
+  state.capabilities.negotiated_maximum_incoming_streams = 65535;
+  state.capabilities.negotiated_maximum_outgoing_streams = 1024;
+  state.tx.next_tsn = 5;
+  state.tx.cwnd = 100000;
+  state.tx.streams.push_back({.id = 1, .next_ssn = 2, .priority = 256});
+  state.tx.messages.push_back({.stream_id = 1,
+                               .ppid = 51,
+                               .unordered = true,
+                               .max_retransmissions = 0,
+                               .remaining_lifetime_ms = 0,
+                               .lifecycle_id = 42,
+                               .payload = {1, 2, 3}});
+  state.tx.messages.push_back({.stream_id = 2, .ppid = 53, .payload = {4}});
+  state.rx.seen_packet = true;
+  state.rx.last_cumulative_acked_tsn = 6;
+  state.rx.ordered_streams.push_back({.id = 1, .next_ssn = 7});
+  state.rx.unordered_streams.push_back({.id = 2});
+  return state;
+}
+
+TEST(DcSctpHandoverStateTest, CanSerializeAndDeserialize) {
+  std::vector<uint8_t> data = SerializeHandoverState(CreateState());
+  ASSERT_HAS_VALUE_AND_ASSIGN(DcSctpSocketHandoverState state,
+                              DeserializeHandoverState(data));
+
+  EXPECT_EQ(state.socket_state,
+            DcSctpSocketHandoverState::SocketState::kConnected);
+  EXPECT_EQ(state.my_verification_tag, 0xFFFFFFFF);
+  EXPECT_EQ(state.tie_tag, 0xFFFFFFFFFFFFFFFF);
+  EXPECT_TRUE(state.capabilities.partial_reliability);
+  EXPECT_FALSE(state.capabilities.message_interleaving);
+  EXPECT_EQ(state.capabilities.negotiated_maximum_incoming_streams, 65535);
+  EXPECT_EQ(state.tx.cwnd, 100000u);
+  ASSERT_EQ(state.tx.streams.size(), 1u);
+  EXPECT_EQ(state.tx.streams[0].priority, 256);
+  ASSERT_EQ(state.tx.messages.size(), 2u);
+  EXPECT_TRUE(state.tx.messages[0].unordered);
+  EXPECT_EQ(state.tx.messages[0].max_retransmissions, 0);
+  EXPECT_EQ(state.tx.messages[0].remaining_lifetime_ms, 0);
+  EXPECT_EQ(state.tx.messages[0].lifecycle_id, 42u);
+  EXPECT_THAT(state.tx.messages[0].payload, ElementsAre(1, 2, 3));
+  EXPECT_EQ(state.tx.messages[1].max_retransmissions, 0xFFFF);
+  EXPECT_EQ(state.tx.messages[1].remaining_lifetime_ms, -1);
+  EXPECT_THAT(state.tx.messages[1].payload, ElementsAre(4));
+  EXPECT_TRUE(state.rx.seen_packet);
+  ASSERT_EQ(state.rx.ordered_streams.size(), 1u);
+  EXPECT_EQ(state.rx.ordered_streams[0].next_ssn, 7u);
+  ASSERT_EQ(state.rx.unordered_streams.size(), 1u);
+  EXPECT_EQ(state.rx.unordered_streams[0].id, 2u);
+
+  // All fields are included.
+  EXPECT_EQ(SerializeHandoverState(state), data);
+}
+
+TEST(DcSctpHandoverStateTest, SerializationIsCompact) {
+  DcSctpSocketHandoverState state;
+  state.socket_state = DcSctpSocketHandoverState::SocketState::kConnected;
+  state.tx.streams.resize(100);
+  // One byte per small integer.
+  EXPECT_LT(SerializeHandoverState(state).size(), 100u * 5 + 32);
+}
+
+TEST(DcSctpHandoverStateTest, RejectsInvalidData) {
+  std::vector<uint8_t> data = SerializeHandoverState(CreateState());
+
+  for (size_t size = 0; size < data.size(); ++size) {
+    EXPECT_FALSE(DeserializeHandoverState(
+                     rtc::ArrayView<const uint8_t>(data).subview(0, size))
+                     .has_value());
+  }
+
+  std::vector<uint8_t> trailing_data = data;
+  trailing_data.push_back(0);
+  EXPECT_FALSE(DeserializeHandoverState(trailing_data).has_value());
+
+  std::vector<uint8_t> wrong_version = data;
+  wrong_version[0] = 0;
+  EXPECT_FALSE(DeserializeHandoverState(wrong_version).has_value());
+}
+
+}  // namespace
+}  // namespace dcsctp
@@ -160,6 +160,19 @@ struct DcSctpOptions {
   // https://tools.ietf.org/html/rfc4960#section-7.2.3.
   size_t cwnd_mtus_min = 4;
 
+  // The maximum congestion window increase, in number of MTUs, for every SACK
+  // that advances the cumulative TSN ack point during slow start. RFC4960
+  // mandates one MTU, while https://tools.ietf.org/html/rfc3465#section-2.3
+  // allows up to two to compensate for delayed acknowledgements.
+  size_t slow_start_cwnd_increase_mtus = 1;
+
+  // The congestion window increase, in number of MTUs, for every congestion
+  // window worth of acknowledged data during congestion avoidance. RFC4960
+  // mandates one MTU. Larger values recover faster after packet loss on paths
+  // with a high bandwidth-delay product, at the cost of being less fair to
+  // competing flows.
+  size_t congestion_avoidance_cwnd_increase_mtus = 1;
+
   // When the congestion window is at or above this number of MTUs, the
   // congestion control algorithm will avoid filling the congestion window
   // fully, if that results in fragmenting large messages into quite small
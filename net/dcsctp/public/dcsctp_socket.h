@@ -299,6 +299,29 @@ class DcSctpSocketCallbacks {
     return SendPacketStatus::kSuccess;
   }
 
+  // Called when the library wants several packets, produced in one go (e.g.
+  // when the congestion window opens up), to be sent. Implementations may send
+  // them back-to-back to amortize per-packet costs, such as system calls.
+  //
+  // Returns the status of every packet that was attempted to be sent, in
+  // order. Sending stops at the first packet that fails to be sent. The
+  // default implementation calls `SendPacketWithStatus` for every packet.
+  //
+  // Note that it's NOT ALLOWED to call into this library from within this
+  // callback.
+  virtual std::vector<SendPacketStatus> SendPacketsWithStatus(
+      rtc::ArrayView<const rtc::ArrayView<const uint8_t>> packets) {
+    std::vector<SendPacketStatus> statuses;
+    statuses.reserve(packets.size());
+    for (rtc::ArrayView<const uint8_t> packet : packets) {
+      statuses.push_back(SendPacketWithStatus(packet));
+      if (statuses.back() != SendPacketStatus::kSuccess) {
+        break;
+      }
+    }
+    return statuses;
+  }
+
   // Called when the library wants to create a Timeout. The callback must return
   // an object that implements that interface.
   //
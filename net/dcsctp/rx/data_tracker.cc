@@ -12,7 +12,6 @@
 #include <algorithm>
 #include <cstdint>
 #include <iterator>
-#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -281,7 +280,7 @@ SackChunk DataTracker::CreateSelectiveAck(size_t a_rwnd) {
   // that. So this SACK produced is more like a NR-SACK as explained in
   // https://ieeexplore.ieee.org/document/4697037 and which there is an RFC
   // draft at https://tools.ietf.org/html/draft-tuexen-tsvwg-sctp-multipath-17.
-  std::set<TSN> duplicate_tsns;
+  webrtc::flat_set<TSN> duplicate_tsns;
   duplicate_tsns_.swap(duplicate_tsns);
 
   return SackChunk(last_cumulative_acked_tsn_.Wrap(), a_rwnd,
@@ -14,7 +14,6 @@
 #include <stdint.h>
 
 #include <cstdint>
-#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -26,6 +25,7 @@
 #include "net/dcsctp/packet/data.h"
 #include "net/dcsctp/public/dcsctp_handover_state.h"
 #include "net/dcsctp/timer/timer.h"
+#include "rtc_base/containers/flat_set.h"
 
 namespace dcsctp {
 
@@ -188,7 +188,7 @@ class DataTracker {
   UnwrappedTSN last_cumulative_acked_tsn_;
   // Received TSNs that are not directly following `last_cumulative_acked_tsn_`.
   AdditionalTsnBlocks additional_tsn_blocks_;
-  std::set<TSN> duplicate_tsns_;
+  webrtc::flat_set<TSN> duplicate_tsns_;
 };
 }  // namespace dcsctp
 
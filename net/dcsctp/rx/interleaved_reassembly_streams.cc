@@ -37,14 +37,13 @@ InterleavedReassemblyStreams::InterleavedReassemblyStreams(
 
 size_t InterleavedReassemblyStreams::Stream::TryToAssembleMessage(
     UnwrappedMID mid) {
-  std::map<UnwrappedMID, ChunkMap>::const_iterator it =
-      chunks_by_mid_.find(mid);
+  std::map<UnwrappedMID, ChunkMap>::iterator it = chunks_by_mid_.find(mid);
   if (it == chunks_by_mid_.end()) {
     RTC_DLOG(LS_VERBOSE) << parent_.log_prefix_ << "TryToAssembleMessage "
                          << *mid.Wrap() << " - no chunks";
     return 0;
   }
-  const ChunkMap& chunks = it->second;
+  ChunkMap& chunks = it->second;
   if (!chunks.begin()->second.second.is_beginning ||
       !chunks.rbegin()->second.second.is_end) {
     RTC_DLOG(LS_VERBOSE) << parent_.log_prefix_ << "TryToAssembleMessage "
@@ -70,16 +69,12 @@ size_t InterleavedReassemblyStreams::Stream::TryToAssembleMessage(
 }
 
 size_t InterleavedReassemblyStreams::Stream::AssembleMessage(
-    const ChunkMap& tsn_chunks) {
+    ChunkMap& tsn_chunks) {
   size_t count = tsn_chunks.size();
   if (count == 1) {
     // Fast path - zero-copy
-    const Data& data = tsn_chunks.begin()->second.second;
-    size_t payload_size = data.size();
-    UnwrappedTSN tsns[1] = {tsn_chunks.begin()->second.first};
-    DcSctpMessage message(data.stream_id, data.ppid, std::move(data.payload));
-    parent_.on_assembled_message_(tsns, std::move(message));
-    return payload_size;
+    auto& [tsn, data] = tsn_chunks.begin()->second;
+    return AssembleMessage(tsn, std::move(data));
   }
 
   // Slow path - will need to concatenate the payload.
@@ -106,6 +101,17 @@ size_t InterleavedReassemblyStreams::Stream::AssembleMessage(
   return payload_size;
 }
 
+size_t InterleavedReassemblyStreams::Stream::AssembleMessage(UnwrappedTSN tsn,
+                                                             Data data) {
+  // Fast path - zero-copy
+  size_t payload_size = data.size();
+  UnwrappedTSN tsns[1] = {tsn};
+  DcSctpMessage message(data.stream_id, data.ppid,
+                        std::move(data.payload).ReleaseBytes());
+  parent_.on_assembled_message_(tsns, std::move(message));
+  return payload_size;
+}
+
 size_t InterleavedReassemblyStreams::Stream::EraseTo(MID mid) {
   UnwrappedMID unwrapped_mid = mid_unwrapper_.Unwrap(mid);
 
@@ -136,6 +142,19 @@ int InterleavedReassemblyStreams::Stream::Add(UnwrappedTSN tsn, Data data) {
   RTC_DCHECK_EQ(*data.stream_id, *stream_id_.stream_id);
   int queued_bytes = data.size();
   UnwrappedMID mid = mid_unwrapper_.Unwrap(data.mid);
+  if (data.is_beginning && data.is_end &&
+      (stream_id_.unordered || mid == next_mid_) &&
+      chunks_by_mid_.find(mid) == chunks_by_mid_.end()) {
+    // Fastpath for messages that were sent in a single fragment, and which can
+    // be delivered right away without being queued.
+    AssembleMessage(tsn, std::move(data));
+    if (!stream_id_.unordered) {
+      next_mid_.Increment();
+      return -static_cast<int>(TryToAssembleMessages());
+    }
+    return 0;
+  }
+
   FSN fsn = data.fsn;
   auto [unused, inserted] =
       chunks_by_mid_[mid].emplace(fsn, std::make_pair(tsn, std::move(data)));
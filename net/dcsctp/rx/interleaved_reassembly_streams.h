@@ -21,6 +21,7 @@
 #include "net/dcsctp/packet/chunk/forward_tsn_common.h"
 #include "net/dcsctp/packet/data.h"
 #include "net/dcsctp/rx/reassembly_streams.h"
+#include "rtc_base/containers/flat_map.h"
 
 namespace dcsctp {
 
@@ -76,12 +77,16 @@ class InterleavedReassemblyStreams : public ReassemblyStreams {
     void AddHandoverState(DcSctpSocketHandoverState& state) const;
 
    private:
-    using ChunkMap = std::map<FSN, std::pair<UnwrappedTSN, Data>>;
+    // The received fragments of a message, stored contiguously.
+    using ChunkMap = webrtc::flat_map<FSN, std::pair<UnwrappedTSN, Data>>;
 
     // Try to assemble one message identified by `mid`.
     // Returns the number of bytes assembled if a message was assembled.
     size_t TryToAssembleMessage(UnwrappedMID mid);
-    size_t AssembleMessage(const ChunkMap& tsn_chunks);
+    size_t AssembleMessage(ChunkMap& tsn_chunks);
+    // Delivers a message that was received in a single fragment, without
+    // queuing it.
+    size_t AssembleMessage(UnwrappedTSN tsn, Data data);
     // Try to assemble one or several messages in order from the stream.
     // Returns the number of bytes assembled if one or more messages were
     // assembled.
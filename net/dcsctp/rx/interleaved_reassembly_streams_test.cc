@@ -17,6 +17,7 @@
 #include "net/dcsctp/packet/chunk/forward_tsn_common.h"
 #include "net/dcsctp/packet/chunk/iforward_tsn_chunk.h"
 #include "net/dcsctp/packet/data.h"
+#include "net/dcsctp/public/dcsctp_message.h"
 #include "net/dcsctp/rx/reassembly_streams.h"
 #include "net/dcsctp/testing/data_generator.h"
 #include "rtc_base/gunit.h"
@@ -24,8 +25,11 @@
 
 namespace dcsctp {
 namespace {
+using ::testing::ElementsAre;
+using ::testing::InSequence;
 using ::testing::MockFunction;
 using ::testing::NiceMock;
+using ::testing::Property;
 
 class InterleavedReassemblyStreamsTest : public testing::Test {
  protected:
@@ -150,5 +154,36 @@ TEST_F(InterleavedReassemblyStreamsTest,
   EXPECT_EQ(streams.HandleForwardTsn(tsn(4), skipped), 8u);
 }
 
+TEST_F(InterleavedReassemblyStreamsTest,
+       SingleFragmentOrderedMessagesAreDeliveredInOrder) {
+  NiceMock<MockFunction<ReassemblyStreams::OnAssembledMessage>> on_assembled;
+  {
+    InSequence s;
+    EXPECT_CALL(on_assembled,
+                Call(ElementsAre(tsn(1), tsn(2)),
+                     Property(&DcSctpMessage::payload, ElementsAre(1, 2))));
+    EXPECT_CALL(on_assembled,
+                Call(ElementsAre(tsn(3)),
+                     Property(&DcSctpMessage::payload, ElementsAre(3))));
+    EXPECT_CALL(on_assembled,
+                Call(ElementsAre(tsn(4)),
+                     Property(&DcSctpMessage::payload, ElementsAre(4))));
+  }
+
+  InterleavedReassemblyStreams streams("", on_assembled.AsStdFunction());
+
+  Data first_begin = gen_.Ordered({1}, "B");
+  Data first_end = gen_.Ordered({2}, "E");
+  Data second = gen_.Ordered({3}, "BE");
+  Data third = gen_.Ordered({4}, "BE");
+
+  EXPECT_EQ(streams.Add(tsn(1), std::move(first_begin)), 1);
+  // Can't be delivered before the first message, so it's queued.
+  EXPECT_EQ(streams.Add(tsn(3), std::move(second)), 1);
+  EXPECT_EQ(streams.Add(tsn(2), std::move(first_end)), -2);
+  // Delivered right away, without being queued.
+  EXPECT_EQ(streams.Add(tsn(4), std::move(third)), 0);
+}
+
 }  // namespace
 }  // namespace dcsctp
@@ -35,9 +35,10 @@ namespace {
 // function will return an iterator to the first chunk in that message, which
 // has the `is_beginning` flag set. If there are any gaps, or if the beginning
 // can't be found, `absl::nullopt` is returned.
-absl::optional<std::map<UnwrappedTSN, Data>::iterator> FindBeginning(
-    const std::map<UnwrappedTSN, Data>& chunks,
-    std::map<UnwrappedTSN, Data>::iterator iter) {
+template <typename ChunkMap>
+absl::optional<typename ChunkMap::iterator> FindBeginning(
+    const ChunkMap& chunks,
+    typename ChunkMap::iterator iter) {
   UnwrappedTSN prev_tsn = iter->first;
   for (;;) {
     if (iter->second.is_beginning) {
@@ -58,9 +59,10 @@ absl::optional<std::map<UnwrappedTSN, Data>::iterator> FindBeginning(
 // function will return an iterator to the chunk after the last chunk in that
 // message, which has the `is_end` flag set. If there are any gaps, or if the
 // end can't be found, `absl::nullopt` is returned.
-absl::optional<std::map<UnwrappedTSN, Data>::iterator> FindEnd(
-    std::map<UnwrappedTSN, Data>& chunks,
-    std::map<UnwrappedTSN, Data>::iterator iter) {
+template <typename ChunkMap>
+absl::optional<typename ChunkMap::iterator> FindEnd(
+    ChunkMap& chunks,
+    typename ChunkMap::iterator iter) {
   UnwrappedTSN prev_tsn = iter->first;
   for (;;) {
     if (iter->second.is_end) {
@@ -161,7 +163,8 @@ size_t TraditionalReassemblyStreams::StreamBase::AssembleMessage(
   // Fast path - zero-copy
   size_t payload_size = data.size();
   UnwrappedTSN tsns[1] = {tsn};
-  DcSctpMessage message(data.stream_id, data.ppid, std::move(data.payload));
+  DcSctpMessage message(data.stream_id, data.ppid,
+                        std::move(data.payload).ReleaseBytes());
   parent_.on_assembled_message_(tsns, std::move(message));
   return payload_size;
 }
@@ -21,6 +21,7 @@
 #include "net/dcsctp/packet/chunk/forward_tsn_common.h"
 #include "net/dcsctp/packet/data.h"
 #include "net/dcsctp/rx/reassembly_streams.h"
+#include "rtc_base/containers/flat_map.h"
 
 namespace dcsctp {
 
@@ -46,7 +47,8 @@ class TraditionalReassemblyStreams : public ReassemblyStreams {
   void RestoreFromState(const DcSctpSocketHandoverState& state) override;
 
  private:
-  using ChunkMap = std::map<UnwrappedTSN, Data>;
+  // Received fragments in TSN order, stored contiguously.
+  using ChunkMap = webrtc::flat_map<UnwrappedTSN, Data>;
 
   // Base class for `UnorderedStream` and `OrderedStream`.
   class StreamBase {
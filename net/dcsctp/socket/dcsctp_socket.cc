@@ -365,7 +365,7 @@ void DcSctpSocket::RestoreFromState(const DcSctpSocketHandoverState& state) {
       capabilities.negotiated_maximum_outgoing_streams =
           state.capabilities.negotiated_maximum_outgoing_streams;
 
-      send_queue_.RestoreFromState(state);
+      send_queue_.RestoreFromState(callbacks_.Now(), state);
 
       CreateTransmissionControlBlock(
           capabilities, my_verification_tag, TSN(state.my_initial_tsn),
@@ -377,6 +377,11 @@ void DcSctpSocket::RestoreFromState(const DcSctpSocketHandoverState& state) {
 
       SetState(State::kEstablished, "restored from handover state");
       callbacks_.OnConnected();
+
+      // Send the messages that were queued when the state was created.
+      if (!send_queue_.IsEmpty()) {
+        tcb_->SendBufferedPackets(callbacks_.Now());
+      }
     }
   }
 
@@ -1776,6 +1781,10 @@ HandoverReadinessStatus DcSctpSocket::GetHandoverReadiness() const {
     status.Add(HandoverUnreadinessReason::kWrongConnectionState);
   }
   status.Add(send_queue_.GetHandoverReadiness());
+  if (state_ == State::kClosed && !send_queue_.IsEmpty()) {
+    // Queued messages are only handed over for established connections.
+    status.Add(HandoverUnreadinessReason::kSendQueueNotEmpty);
+  }
   if (tcb_) {
     status.Add(tcb_->GetHandoverReadiness());
   }
@@ -1797,7 +1806,7 @@ DcSctpSocket::GetHandoverStateAndClose() {
   } else if (state_ == State::kEstablished) {
     state.socket_state = DcSctpSocketHandoverState::SocketState::kConnected;
     tcb_->AddHandoverState(state);
-    send_queue_.AddHandoverState(state);
+    send_queue_.AddHandoverState(callbacks_.Now(), state);
     InternalClose(ErrorKind::kNoError, "handover");
   }
 
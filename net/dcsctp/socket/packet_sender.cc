@@ -13,6 +13,7 @@
 #include <vector>
 
 #include "net/dcsctp/public/types.h"
+#include "rtc_base/checks.h"
 
 namespace dcsctp {
 
@@ -28,7 +29,45 @@ bool PacketSender::Send(SctpPacket::Builder& builder, bool write_checksum) {
 
   std::vector<uint8_t> payload = builder.Build(write_checksum);
 
-  SendPacketStatus status = callbacks_.SendPacketWithStatus(payload);
+  return OnSent(payload, callbacks_.SendPacketWithStatus(payload));
+}
+
+bool PacketSender::AddToBatch(SctpPacket::Builder& builder,
+                              bool write_checksum) {
+  if (builder.empty()) {
+    return false;
+  }
+  batch_.push_back(builder.Build(write_checksum));
+  return true;
+}
+
+bool PacketSender::FlushBatch() {
+  if (batch_.empty()) {
+    return false;
+  }
+  std::vector<std::vector<uint8_t>> batch = std::move(batch_);
+  batch_.clear();
+
+  if (batch.size() == 1) {
+    return OnSent(batch[0], callbacks_.SendPacketWithStatus(batch[0]));
+  }
+
+  std::vector<rtc::ArrayView<const uint8_t>> packets(batch.begin(),
+                                                     batch.end());
+  std::vector<SendPacketStatus> statuses =
+      callbacks_.SendPacketsWithStatus(packets);
+  RTC_DCHECK_LE(statuses.size(), packets.size());
+  bool all_sent = statuses.size() == packets.size();
+  for (size_t i = 0; i < statuses.size(); ++i) {
+    if (!OnSent(packets[i], statuses[i])) {
+      all_sent = false;
+    }
+  }
+  return all_sent;
+}
+
+bool PacketSender::OnSent(rtc::ArrayView<const uint8_t> payload,
+                          SendPacketStatus status) {
   on_sent_packet_(payload, status);
   switch (status) {
     case SendPacketStatus::kSuccess: {
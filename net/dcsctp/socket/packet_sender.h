@@ -10,6 +10,11 @@
 #ifndef NET_DCSCTP_SOCKET_PACKET_SENDER_H_
 #define NET_DCSCTP_SOCKET_PACKET_SENDER_H_
 
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "api/array_view.h"
 #include "net/dcsctp/packet/sctp_packet.h"
 #include "net/dcsctp/public/dcsctp_socket.h"
 
@@ -27,13 +32,26 @@ class PacketSender {
   // Sends the packet, and returns true if it was sent successfully.
   bool Send(SctpPacket::Builder& builder, bool write_checksum = true);
 
+  // Builds a packet, which will be sent together with all other packets added
+  // to the batch on `FlushBatch`. Returns false if there was nothing to add.
+  bool AddToBatch(SctpPacket::Builder& builder, bool write_checksum = true);
+
+  // Sends all packets added with `AddToBatch`, and returns true if all of them
+  // were sent successfully.
+  bool FlushBatch();
+
  private:
+  // Reports the send attempt of `payload`, returning true if it succeeded.
+  bool OnSent(rtc::ArrayView<const uint8_t> payload, SendPacketStatus status);
+
   DcSctpSocketCallbacks& callbacks_;
 
   // Callback that will be triggered for every send attempt, indicating the
   // status of the operation.
   std::function<void(rtc::ArrayView<const uint8_t>, SendPacketStatus)>
       on_sent_packet_;
+
+  std::vector<std::vector<uint8_t>> batch_;
 };
 }  // namespace dcsctp
 
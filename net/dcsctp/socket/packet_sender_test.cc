@@ -46,5 +46,31 @@ TEST_F(PacketSenderTest, SendPacketCallsCallback) {
   EXPECT_FALSE(sender_.Send(PacketBuilder().Add(CookieAckChunk())));
 }
 
+TEST_F(PacketSenderTest, SendsBatchWhenFlushed) {
+  EXPECT_CALL(callbacks_, SendPacketWithStatus).Times(0);
+  EXPECT_TRUE(sender_.AddToBatch(PacketBuilder().Add(CookieAckChunk())));
+  EXPECT_TRUE(sender_.AddToBatch(PacketBuilder().Add(CookieAckChunk())));
+  SctpPacket::Builder empty_builder = PacketBuilder();
+  EXPECT_FALSE(sender_.AddToBatch(empty_builder));
+
+  testing::Mock::VerifyAndClearExpectations(&callbacks_);
+  EXPECT_CALL(callbacks_, SendPacketWithStatus).Times(2);
+  EXPECT_CALL(on_send_fn_, Call(_, SendPacketStatus::kSuccess)).Times(2);
+  EXPECT_TRUE(sender_.FlushBatch());
+
+  // The batch is empty after having been flushed.
+  EXPECT_FALSE(sender_.FlushBatch());
+}
+
+TEST_F(PacketSenderTest, StopsSendingBatchOnFailure) {
+  EXPECT_TRUE(sender_.AddToBatch(PacketBuilder().Add(CookieAckChunk())));
+  EXPECT_TRUE(sender_.AddToBatch(PacketBuilder().Add(CookieAckChunk())));
+
+  EXPECT_CALL(callbacks_, SendPacketWithStatus)
+      .WillOnce(testing::Return(SendPacketStatus::kTemporaryFailure));
+  EXPECT_CALL(on_send_fn_, Call(_, SendPacketStatus::kTemporaryFailure));
+  EXPECT_FALSE(sender_.FlushBatch());
+}
+
 }  // namespace
 }  // namespace dcsctp
@@ -259,7 +259,7 @@ void TransmissionControlBlock::SendBufferedPackets(SctpPacket::Builder& builder,
     // ECHO chunk."
     bool write_checksum =
         !capabilities_.zero_checksum || cookie_echo_chunk_.has_value();
-    if (!packet_sender_.Send(builder, write_checksum)) {
+    if (!packet_sender_.AddToBatch(builder, write_checksum)) {
       break;
     }
 
@@ -270,6 +270,9 @@ void TransmissionControlBlock::SendBufferedPackets(SctpPacket::Builder& builder,
       break;
     }
   }
+  // All packets of the burst are handed to the client together, so that it
+  // can send them to the network back-to-back.
+  packet_sender_.FlushBatch();
 }
 
 std::string TransmissionControlBlock::ToString() const {
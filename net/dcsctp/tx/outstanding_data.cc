@@ -10,7 +10,6 @@
 #include "net/dcsctp/tx/outstanding_data.h"
 
 #include <algorithm>
-#include <set>
 #include <utility>
 #include <vector>
 
@@ -80,13 +79,13 @@ bool OutstandingData::IsConsistent() const {
   size_t actual_unacked_bytes = 0;
   size_t actual_unacked_items = 0;
 
-  std::set<UnwrappedTSN> combined_to_be_retransmitted;
+  webrtc::flat_set<UnwrappedTSN> combined_to_be_retransmitted;
   combined_to_be_retransmitted.insert(to_be_retransmitted_.begin(),
                                       to_be_retransmitted_.end());
   combined_to_be_retransmitted.insert(to_be_fast_retransmitted_.begin(),
                                       to_be_fast_retransmitted_.end());
 
-  std::set<UnwrappedTSN> actual_combined_to_be_retransmitted;
+  webrtc::flat_set<UnwrappedTSN> actual_combined_to_be_retransmitted;
   UnwrappedTSN tsn = last_cumulative_tsn_ack_;
   for (const Item& item : outstanding_data_) {
     tsn.Increment();
@@ -115,11 +114,10 @@ void OutstandingData::AckChunk(AckInfo& ack_info,
       unacked_bytes_ -= serialized_size;
       --unacked_items_;
     }
-    if (item.should_be_retransmitted()) {
-      RTC_DCHECK(to_be_fast_retransmitted_.find(tsn) ==
-                 to_be_fast_retransmitted_.end());
-      to_be_retransmitted_.erase(tsn);
-    }
+    // If the chunk was to be retransmitted, it's erased from
+    // `to_be_retransmitted_` by `EraseAckedFromRetransmissions`.
+    RTC_DCHECK(!item.should_be_retransmitted() ||
+               !to_be_fast_retransmitted_.contains(tsn));
     item.Ack();
     ack_info.highest_tsn_acked = std::max(ack_info.highest_tsn_acked, tsn);
   }
@@ -135,6 +133,7 @@ OutstandingData::AckInfo OutstandingData::HandleSack(
 
   // ACK packets reported in the gap ack blocks
   AckGapBlocks(cumulative_tsn_ack, gap_ack_blocks, ack_info);
+  EraseAckedFromRetransmissions();
 
   // NACK and possibly mark for retransmit chunks that weren't acked.
   NackBetweenAckBlocks(cumulative_tsn_ack, gap_ack_blocks, is_in_fast_recovery,
@@ -144,6 +143,18 @@ OutstandingData::AckInfo OutstandingData::HandleSack(
   return ack_info;
 }
 
+void OutstandingData::EraseAckedFromRetransmissions() {
+  // Chunks that were acked by the cumulative ack have already been removed,
+  // and those acked by gap ack blocks are no longer to be retransmitted. Both
+  // are erased in a single pass rather than one at a time as they are acked.
+  to_be_retransmitted_.erase(
+      to_be_retransmitted_.begin(),
+      to_be_retransmitted_.upper_bound(last_cumulative_tsn_ack_));
+  webrtc::EraseIf(to_be_retransmitted_, [this](UnwrappedTSN tsn) {
+    return !GetItem(tsn).should_be_retransmitted();
+  });
+}
+
 OutstandingData::Item& OutstandingData::GetItem(UnwrappedTSN tsn) {
   RTC_DCHECK(tsn > last_cumulative_tsn_ack_);
   RTC_DCHECK(tsn < next_tsn());
@@ -326,12 +337,11 @@ void OutstandingData::AbandonAllFor(const Item& item) {
 }
 
 std::vector<std::pair<TSN, Data>> OutstandingData::ExtractChunksThatCanFit(
-    std::set<UnwrappedTSN>& chunks,
+    webrtc::flat_set<UnwrappedTSN>& chunks,
     size_t max_size) {
   std::vector<std::pair<TSN, Data>> result;
 
-  for (auto it = chunks.begin(); it != chunks.end();) {
-    UnwrappedTSN tsn = *it;
+  for (UnwrappedTSN tsn : chunks) {
     Item& item = GetItem(tsn);
     RTC_DCHECK(item.should_be_retransmitted());
     RTC_DCHECK(!item.is_outstanding());
@@ -345,15 +355,20 @@ std::vector<std::pair<TSN, Data>> OutstandingData::ExtractChunksThatCanFit(
       max_size -= serialized_size;
       unacked_bytes_ += serialized_size;
       ++unacked_items_;
-      it = chunks.erase(it);
-    } else {
-      ++it;
     }
     // No point in continuing if the packet is full.
     if (max_size <= data_chunk_header_size_) {
       break;
     }
   }
+  // The extracted chunks are no longer to be retransmitted. Erase them all at
+  // once, as erasing them one at a time would shift the remaining ones each
+  // time.
+  if (!result.empty()) {
+    webrtc::EraseIf(chunks, [this](UnwrappedTSN tsn) {
+      return !GetItem(tsn).should_be_retransmitted();
+    });
+  }
   return result;
 }
 
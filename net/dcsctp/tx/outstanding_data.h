@@ -12,7 +12,6 @@
 
 #include <deque>
 #include <map>
-#include <set>
 #include <utility>
 #include <vector>
 
@@ -342,9 +341,12 @@ class OutstandingData {
   void AbandonAllFor(const OutstandingData::Item& item);
 
   std::vector<std::pair<TSN, Data>> ExtractChunksThatCanFit(
-      std::set<UnwrappedTSN>& chunks,
+      webrtc::flat_set<UnwrappedTSN>& chunks,
       size_t max_size);
 
+  // Erases chunks that have been acked from `to_be_retransmitted_`.
+  void EraseAckedFromRetransmissions();
+
   bool IsConsistent() const;
 
   // The size of the data chunk (DATA/I-DATA) header that is used.
@@ -364,9 +366,9 @@ class OutstandingData {
   // nacked).
   size_t unacked_items_ = 0;
   // Data chunks that are eligible for fast retransmission.
-  std::set<UnwrappedTSN> to_be_fast_retransmitted_;
+  webrtc::flat_set<UnwrappedTSN> to_be_fast_retransmitted_;
   // Data chunks that are to be retransmitted.
-  std::set<UnwrappedTSN> to_be_retransmitted_;
+  webrtc::flat_set<UnwrappedTSN> to_be_retransmitted_;
   // Wben a stream reset has begun, the "next TSN to assign" is added to this
   // set, and removed when the cum-ack TSN reaches it. This is used to limit a
   // FORWARD-TSN to reset streams past a "stream reset last assigned TSN".
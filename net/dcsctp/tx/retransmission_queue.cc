@@ -130,7 +130,10 @@ void RetransmissionQueue::HandleIncreasedCumulativeTsnAck(
       // conditions are met, then cwnd MUST be increased by, at most, the
       // lesser of 1) the total size of the previously outstanding DATA
       // chunk(s) acknowledged, and 2) the destination's path MTU."
-      cwnd_ += std::min(total_bytes_acked, options_.mtu);
+      // The increase may be scaled up as allowed by RFC3465 (Appropriate
+      // Byte Counting), to compensate for delayed acknowledgements.
+      cwnd_ += std::min(total_bytes_acked,
+                        options_.slow_start_cwnd_increase_mtus * options_.mtu);
       RTC_DLOG(LS_VERBOSE) << log_prefix_ << "SS increase cwnd=" << cwnd_
                            << " (" << old_cwnd << ")";
     }
@@ -154,7 +157,7 @@ void RetransmissionQueue::HandleIncreasedCumulativeTsnAck(
 
       // Errata: https://datatracker.ietf.org/doc/html/rfc8540#section-3.12
       partial_bytes_acked_ -= cwnd_;
-      cwnd_ += options_.mtu;
+      cwnd_ += options_.congestion_avoidance_cwnd_increase_mtus * options_.mtu;
       RTC_DLOG(LS_VERBOSE) << log_prefix_ << "CA increase cwnd=" << cwnd_
                            << " (" << old_cwnd << ") ssthresh=" << ssthresh_
                            << ", pba=" << partial_bytes_acked_ << " ("
@@ -1439,6 +1439,31 @@ TEST_F(RetransmissionQueueTest, OnlySendsLargePacketsOnLargeCongestionWindow) {
   EXPECT_EQ(queue.cwnd(), intial_cwnd + kMaxMtu);
 }
 
+TEST_F(RetransmissionQueueTest, SlowStartCwndIncreaseCanBeScaled) {
+  options_.slow_start_cwnd_increase_mtus = 2;
+  RetransmissionQueue queue = CreateQueue();
+  size_t intial_cwnd = 4 * options_.mtu;
+  queue.set_cwnd(intial_cwnd);
+
+  // Fill the congestion window with a message spanning several MTUs.
+  size_t chunk_size = intial_cwnd - 500;
+  EXPECT_CALL(producer_, Produce)
+      .WillOnce([chunk_size, this](Timestamp, size_t) {
+        return SendQueue::DataToSend(
+            OutgoingMessageId(0),
+            gen_.Ordered(std::vector<uint8_t>(chunk_size), "BE"));
+      })
+      .WillRepeatedly([](Timestamp, size_t) { return absl::nullopt; });
+
+  EXPECT_THAT(queue.GetChunksToSend(now_, 10000),
+              ElementsAre(Pair(TSN(10), _)));
+
+  queue.HandleSack(now_, SackChunk(TSN(10), kArwnd, {}, {}));
+
+  // Increased by at most two MTUs, rather than the RFC4960 single MTU.
+  EXPECT_EQ(queue.cwnd(), intial_cwnd + 2 * kMaxMtu);
+}
+
 TEST_F(RetransmissionQueueTest, AllowsSmallFragmentsOnSmallCongestionWindow) {
   RetransmissionQueue queue = CreateQueue();
   size_t intial_cwnd =
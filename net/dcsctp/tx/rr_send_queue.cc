@@ -9,6 +9,7 @@
  */
 #include "net/dcsctp/tx/rr_send_queue.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <deque>
 #include <limits>
@@ -64,11 +65,39 @@ size_t RRSendQueue::OutgoingStream::bytes_to_send_in_next_message() const {
 }
 
 void RRSendQueue::OutgoingStream::AddHandoverState(
-    DcSctpSocketHandoverState::OutgoingStream& state) const {
+    Timestamp now,
+    DcSctpSocketHandoverState::OutgoingStream& state,
+    std::vector<DcSctpSocketHandoverState::OutgoingMessage>& messages) {
+  RTC_DCHECK(IsReadyForHandover());
   state.next_ssn = next_ssn_.value();
   state.next_ordered_mid = next_ordered_mid_.value();
   state.next_unordered_mid = next_unordered_mid_.value();
   state.priority = *scheduler_stream_->priority();
+
+  if (items_.empty()) {
+    return;
+  }
+  for (Item& item : items_) {
+    DcSctpSocketHandoverState::OutgoingMessage& message =
+        messages.emplace_back();
+    message.stream_id = item.stream_id.value();
+    message.ppid = item.ppid.value();
+    message.unordered = item.attributes.unordered.value();
+    message.max_retransmissions = item.attributes.max_retransmissions.value();
+    if (item.attributes.expires_at.IsFinite()) {
+      // See `RRSendQueue::Add` for the extra millisecond.
+      message.remaining_lifetime_ms = std::max<int64_t>(
+          0, (item.attributes.expires_at - now - TimeDelta::Millis(1)).ms());
+    }
+    message.lifecycle_id = item.attributes.lifecycle_id.value();
+    message.payload = std::move(item.payload).ReleaseBytes();
+  }
+  items_.clear();
+  size_t bytes = buffered_amount_.value();
+  buffered_amount_.Decrease(bytes);
+  parent_.total_buffered_amount_.Decrease(bytes);
+  scheduler_stream_->MakeInactive();
+  RTC_DCHECK(IsConsistent());
 }
 
 bool RRSendQueue::IsConsistent() const {
@@ -82,6 +111,12 @@ bool RRSendQueue::IsConsistent() const {
     if (stream.bytes_to_send_in_next_message() > 0) {
       expected_active_streams.emplace(stream_id);
     }
+    if (stream.IsReadyToBeReset() !=
+            (streams_ready_to_be_reset_.count(stream_id) > 0) ||
+        stream.IsResetting() != (resetting_streams_.count(stream_id) > 0)) {
+      RTC_DLOG(LS_ERROR) << "Reset state mismatch for stream " << *stream_id;
+      return false;
+    }
   }
   if (expected_active_streams != actual_active_streams) {
     auto fn = [&](rtc::StringBuilder& sb, const auto& p) { sb << *p; };
@@ -146,7 +181,6 @@ absl::optional<SendQueue::DataToSend> RRSendQueue::OutgoingStream::Produce(
 
   while (!items_.empty()) {
     Item& item = items_.front();
-    DcSctpMessage& message = item.message;
 
     // Allocate Message ID and SSN when the first fragment is sent.
     if (!item.mid.has_value()) {
@@ -168,22 +202,18 @@ absl::optional<SendQueue::DataToSend> RRSendQueue::OutgoingStream::Produce(
     }
 
     // Grab the next `max_size` fragment from this message and calculate flags.
-    rtc::ArrayView<const uint8_t> chunk_payload =
-        item.message.payload().subview(item.remaining_offset, max_size);
-    rtc::ArrayView<const uint8_t> message_payload = message.payload();
-    Data::IsBeginning is_beginning(chunk_payload.data() ==
-                                   message_payload.data());
-    Data::IsEnd is_end((chunk_payload.data() + chunk_payload.size()) ==
-                       (message_payload.data() + message_payload.size()));
-
-    StreamID stream_id = message.stream_id();
-    PPID ppid = message.ppid();
-
-    // Zero-copy the payload if the message fits in a single chunk.
-    std::vector<uint8_t> payload =
+    size_t fragment_size = std::min(max_size, item.remaining_size);
+    Data::IsBeginning is_beginning(item.remaining_offset == 0);
+    Data::IsEnd is_end(fragment_size == item.remaining_size);
+
+    StreamID stream_id = item.stream_id;
+    PPID ppid = item.ppid;
+
+    // The fragment is a view into the message payload, which isn't copied.
+    Payload payload =
         is_beginning && is_end
-            ? std::move(message).ReleasePayload()
-            : std::vector<uint8_t>(chunk_payload.begin(), chunk_payload.end());
+            ? std::move(item.payload)
+            : item.payload.Slice(item.remaining_offset, fragment_size);
 
     FSN fsn(item.current_fsn);
     item.current_fsn = FSN(*item.current_fsn + 1);
@@ -207,13 +237,13 @@ absl::optional<SendQueue::DataToSend> RRSendQueue::OutgoingStream::Produce(
       if (pause_state_ == PauseState::kPending) {
         RTC_DLOG(LS_VERBOSE) << "Pause state on " << *stream_id
                              << " is moving from pending to paused";
-        pause_state_ = PauseState::kPaused;
+        SetPauseState(PauseState::kPaused);
       }
     } else {
-      item.remaining_offset += chunk_payload.size();
-      item.remaining_size -= chunk_payload.size();
+      item.remaining_offset += fragment_size;
+      item.remaining_size -= fragment_size;
       RTC_DCHECK(item.remaining_offset + item.remaining_size ==
-                 item.message.payload().size());
+                 item.payload.size());
       RTC_DCHECK(item.remaining_size > 0);
     }
     RTC_DCHECK(IsConsistent());
@@ -250,7 +280,7 @@ bool RRSendQueue::OutgoingStream::Discard(OutgoingMessageId message_id) {
       scheduler_stream_->ForceReschedule();
 
       if (pause_state_ == PauseState::kPending) {
-        pause_state_ = PauseState::kPaused;
+        SetPauseState(PauseState::kPaused);
         scheduler_stream_->MakeInactive();
       } else if (bytes_to_send_in_next_message() == 0) {
         scheduler_stream_->MakeInactive();
@@ -294,9 +324,9 @@ void RRSendQueue::OutgoingStream::Pause() {
     }
   }
 
-  pause_state_ = (items_.empty() || items_.front().remaining_offset == 0)
-                     ? PauseState::kPaused
-                     : PauseState::kPending;
+  SetPauseState((items_.empty() || items_.front().remaining_offset == 0)
+                    ? PauseState::kPaused
+                    : PauseState::kPending);
 
   if (had_pending_items && pause_state_ == PauseState::kPaused) {
     RTC_DLOG(LS_VERBOSE) << "Stream " << *stream_id()
@@ -307,9 +337,29 @@ void RRSendQueue::OutgoingStream::Pause() {
   RTC_DCHECK(IsConsistent());
 }
 
+void RRSendQueue::OutgoingStream::SetPauseState(PauseState pause_state) {
+  auto index = [this](PauseState state) -> std::set<StreamID>* {
+    switch (state) {
+      case PauseState::kPaused:
+        return &parent_.streams_ready_to_be_reset_;
+      case PauseState::kResetting:
+        return &parent_.resetting_streams_;
+      default:
+        return nullptr;
+    }
+  };
+  if (std::set<StreamID>* from = index(pause_state_); from != nullptr) {
+    from->erase(stream_id());
+  }
+  if (std::set<StreamID>* to = index(pause_state); to != nullptr) {
+    to->insert(stream_id());
+  }
+  pause_state_ = pause_state;
+}
+
 void RRSendQueue::OutgoingStream::Resume() {
   RTC_DCHECK(pause_state_ == PauseState::kResetting);
-  pause_state_ = PauseState::kNotPaused;
+  SetPauseState(PauseState::kNotPaused);
   scheduler_stream_->MaybeMakeActive();
   RTC_DCHECK(IsConsistent());
 }
@@ -319,7 +369,7 @@ void RRSendQueue::OutgoingStream::Reset() {
   // to, or when the entire SendQueue is reset due to detecting the peer having
   // restarted. The stream may be in any state at this time.
   PauseState old_pause_state = pause_state_;
-  pause_state_ = PauseState::kNotPaused;
+  SetPauseState(PauseState::kNotPaused);
   next_ordered_mid_ = MID(0);
   next_unordered_mid_ = MID(0);
   next_ssn_ = SSN(0);
@@ -327,12 +377,12 @@ void RRSendQueue::OutgoingStream::Reset() {
     // If this message has been partially sent, reset it so that it will be
     // re-sent.
     auto& item = items_.front();
-    buffered_amount_.Increase(item.message.payload().size() -
+    buffered_amount_.Increase(item.payload.size() -
                               item.remaining_size);
-    parent_.total_buffered_amount_.Increase(item.message.payload().size() -
+    parent_.total_buffered_amount_.Increase(item.payload.size() -
                                             item.remaining_size);
     item.remaining_offset = 0;
-    item.remaining_size = item.message.payload().size();
+    item.remaining_size = item.payload.size();
     item.mid = absl::nullopt;
     item.ssn = absl::nullopt;
     item.current_fsn = FSN(0);
@@ -405,47 +455,32 @@ void RRSendQueue::PrepareResetStream(StreamID stream_id) {
 }
 
 bool RRSendQueue::HasStreamsReadyToBeReset() const {
-  for (auto& [unused, stream] : streams_) {
-    if (stream.IsReadyToBeReset()) {
-      return true;
-    }
-  }
-  return false;
+  return !streams_ready_to_be_reset_.empty();
 }
 std::vector<StreamID> RRSendQueue::GetStreamsReadyToBeReset() {
-  RTC_DCHECK(absl::c_count_if(streams_, [](const auto& p) {
-               return p.second.IsResetting();
-             }) == 0);
-  std::vector<StreamID> ready;
-  for (auto& [stream_id, stream] : streams_) {
-    if (stream.IsReadyToBeReset()) {
-      stream.SetAsResetting();
-      ready.push_back(stream_id);
-    }
+  RTC_DCHECK(resetting_streams_.empty());
+  std::vector<StreamID> ready(streams_ready_to_be_reset_.begin(),
+                              streams_ready_to_be_reset_.end());
+  for (StreamID stream_id : ready) {
+    streams_.find(stream_id)->second.SetAsResetting();
   }
   return ready;
 }
 
 void RRSendQueue::CommitResetStreams() {
-  RTC_DCHECK(absl::c_count_if(streams_, [](const auto& p) {
-               return p.second.IsResetting();
-             }) > 0);
-  for (auto& [unused, stream] : streams_) {
-    if (stream.IsResetting()) {
-      stream.Reset();
-    }
+  RTC_DCHECK(!resetting_streams_.empty());
+  // Resetting a stream removes it from `resetting_streams_`.
+  while (!resetting_streams_.empty()) {
+    streams_.find(*resetting_streams_.begin())->second.Reset();
   }
   RTC_DCHECK(IsConsistent());
 }
 
 void RRSendQueue::RollbackResetStreams() {
-  RTC_DCHECK(absl::c_count_if(streams_, [](const auto& p) {
-               return p.second.IsResetting();
-             }) > 0);
-  for (auto& [unused, stream] : streams_) {
-    if (stream.IsResetting()) {
-      stream.Resume();
-    }
+  RTC_DCHECK(!resetting_streams_.empty());
+  // Resuming a stream removes it from `resetting_streams_`.
+  while (!resetting_streams_.empty()) {
+    streams_.find(*resetting_streams_.begin())->second.Resume();
   }
   RTC_DCHECK(IsConsistent());
 }
@@ -515,22 +550,28 @@ StreamPriority RRSendQueue::GetStreamPriority(StreamID stream_id) const {
 
 HandoverReadinessStatus RRSendQueue::GetHandoverReadiness() const {
   HandoverReadinessStatus status;
-  if (!IsEmpty()) {
-    status.Add(HandoverUnreadinessReason::kSendQueueNotEmpty);
+  for (const auto& [unused, stream] : streams_) {
+    if (!stream.IsReadyForHandover()) {
+      status.Add(HandoverUnreadinessReason::kSendQueueNotEmpty);
+      break;
+    }
   }
   return status;
 }
 
-void RRSendQueue::AddHandoverState(DcSctpSocketHandoverState& state) {
-  for (const auto& [stream_id, stream] : streams_) {
+void RRSendQueue::AddHandoverState(Timestamp now,
+                                   DcSctpSocketHandoverState& state) {
+  for (auto& [stream_id, stream] : streams_) {
     DcSctpSocketHandoverState::OutgoingStream state_stream;
     state_stream.id = stream_id.value();
-    stream.AddHandoverState(state_stream);
+    stream.AddHandoverState(now, state_stream, state.tx.messages);
     state.tx.streams.push_back(std::move(state_stream));
   }
+  RTC_DCHECK(IsConsistent());
 }
 
-void RRSendQueue::RestoreFromState(const DcSctpSocketHandoverState& state) {
+void RRSendQueue::RestoreFromState(Timestamp now,
+                                   const DcSctpSocketHandoverState& state) {
   for (const DcSctpSocketHandoverState::OutgoingStream& state_stream :
        state.tx.streams) {
     StreamID stream_id(state_stream.id);
@@ -541,5 +582,22 @@ void RRSendQueue::RestoreFromState(const DcSctpSocketHandoverState& state) {
             [this, stream_id]() { callbacks_.OnBufferedAmountLow(stream_id); },
             &state_stream));
   }
+  for (const DcSctpSocketHandoverState::OutgoingMessage& message :
+       state.tx.messages) {
+    MessageAttributes attributes = {
+        .unordered = IsUnordered(message.unordered),
+        .max_retransmissions = MaxRetransmits(message.max_retransmissions),
+        .expires_at = message.remaining_lifetime_ms >= 0
+                          ? now + TimeDelta::Millis(
+                                      message.remaining_lifetime_ms + 1)
+                          : Timestamp::PlusInfinity(),
+        .lifecycle_id = LifecycleId(message.lifecycle_id),
+    };
+    StreamID stream_id(message.stream_id);
+    GetOrCreateStreamInfo(stream_id).Add(
+        DcSctpMessage(stream_id, PPID(message.ppid), message.payload),
+        std::move(attributes));
+  }
+  RTC_DCHECK(IsConsistent());
 }
 }  // namespace dcsctp
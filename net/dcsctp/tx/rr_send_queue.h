@@ -14,6 +14,7 @@
 #include <deque>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -23,6 +24,7 @@
 #include "absl/types/optional.h"
 #include "api/array_view.h"
 #include "net/dcsctp/common/internal_types.h"
+#include "net/dcsctp/packet/data.h"
 #include "net/dcsctp/public/dcsctp_message.h"
 #include "net/dcsctp/public/dcsctp_socket.h"
 #include "net/dcsctp/public/types.h"
@@ -98,8 +100,12 @@ class RRSendQueue : public SendQueue {
   void SetStreamPriority(StreamID stream_id, StreamPriority priority);
   StreamPriority GetStreamPriority(StreamID stream_id) const;
   HandoverReadinessStatus GetHandoverReadiness() const;
-  void AddHandoverState(DcSctpSocketHandoverState& state);
-  void RestoreFromState(const DcSctpSocketHandoverState& state);
+  // Adds the streams and the queued messages to `state`. The messages are
+  // moved out of the send queue, to be sent by the socket restored from it.
+  void AddHandoverState(webrtc::Timestamp now,
+                        DcSctpSocketHandoverState& state);
+  void RestoreFromState(webrtc::Timestamp now,
+                        const DcSctpSocketHandoverState& state);
 
  private:
   struct MessageAttributes {
@@ -179,7 +185,7 @@ class RRSendQueue : public SendQueue {
 
     void SetAsResetting() {
       RTC_DCHECK(pause_state_ == PauseState::kPaused);
-      pause_state_ = PauseState::kResetting;
+      SetPauseState(PauseState::kResetting);
     }
 
     // Resets this stream, meaning MIDs and SSNs are set to zero.
@@ -193,8 +199,19 @@ class RRSendQueue : public SendQueue {
       scheduler_stream_->SetPriority(priority);
     }
 
+    // Indicates if the queued messages of this stream can be handed over,
+    // which is when none of them has started to be sent.
+    bool IsReadyForHandover() const {
+      return items_.empty() || (pause_state_ == PauseState::kNotPaused &&
+                                !has_partially_sent_message());
+    }
+
+    // Adds the stream state to `state`, and moves the queued messages to
+    // `messages`.
     void AddHandoverState(
-        DcSctpSocketHandoverState::OutgoingStream& state) const;
+        webrtc::Timestamp now,
+        DcSctpSocketHandoverState::OutgoingStream& state,
+        std::vector<DcSctpSocketHandoverState::OutgoingMessage>& messages);
 
    private:
     // Streams are paused before they can be reset. To reset a stream, the
@@ -223,12 +240,17 @@ class RRSendQueue : public SendQueue {
                     DcSctpMessage msg,
                     MessageAttributes attributes)
           : message_id(message_id),
-            message(std::move(msg)),
+            stream_id(msg.stream_id()),
+            ppid(msg.ppid()),
+            payload(std::move(msg).ReleasePayload()),
             attributes(std::move(attributes)),
             remaining_offset(0),
-            remaining_size(message.payload().size()) {}
+            remaining_size(payload.size()) {}
       OutgoingMessageId message_id;
-      DcSctpMessage message;
+      StreamID stream_id;
+      PPID ppid;
+      // The message payload, which produced fragments are views into.
+      Payload payload;
       MessageAttributes attributes;
       // The remaining payload (offset and size) to be sent, when it has been
       // fragmented.
@@ -244,6 +266,9 @@ class RRSendQueue : public SendQueue {
 
     bool IsConsistent() const;
     void HandleMessageExpired(OutgoingStream::Item& item);
+    // Changes `pause_state_`, and keeps the parent's index of streams that are
+    // ready to be reset, or are resetting, up to date.
+    void SetPauseState(PauseState pause_state);
 
     RRSendQueue& parent_;
 
@@ -281,6 +306,12 @@ class RRSendQueue : public SendQueue {
 
   // All streams, and messages added to those.
   std::map<StreamID, OutgoingStream> streams_;
+
+  // Streams that are paused and ready to be reset, and streams that are
+  // included in an outgoing stream reset request, respectively. Kept to avoid
+  // iterating over all streams when resetting a few of them.
+  std::set<StreamID> streams_ready_to_be_reset_;
+  std::set<StreamID> resetting_streams_;
 };
 }  // namespace dcsctp
 
@@ -0,0 +1,82 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <cstdint>
+#include <vector>
+
+#include "api/units/timestamp.h"
+#include "benchmark/benchmark.h"
+#include "net/dcsctp/public/dcsctp_message.h"
+#include "net/dcsctp/public/types.h"
+#include "net/dcsctp/socket/mock_dcsctp_socket_callbacks.h"
+#include "net/dcsctp/tx/rr_send_queue.h"
+#include "rtc_base/system/unused.h"
+
+namespace dcsctp {
+namespace {
+
+constexpr webrtc::Timestamp kNow = webrtc::Timestamp::Zero();
+constexpr PPID kPPID(53);
+constexpr size_t kMtu = 1100;
+constexpr size_t kPayloadSize = 100;
+constexpr size_t kBufferSize = 1 << 30;
+
+// Enqueues a message on each of `num_streams` streams, so that they are all
+// active in the scheduler.
+void AddMessageToStreams(RRSendQueue& queue, int num_streams) {
+  for (int i = 0; i < num_streams; ++i) {
+    queue.Add(kNow, DcSctpMessage(StreamID(i), kPPID,
+                                  std::vector<uint8_t>(kPayloadSize)));
+  }
+}
+
+// Sends a message on one stream, while `state.range(0)` streams are active.
+void BM_SendWithManyActiveStreams(benchmark::State& state) {
+  testing::NiceMock<MockDcSctpSocketCallbacks> callbacks;
+  const int num_streams = state.range(0);
+  RRSendQueue queue("", &callbacks, kBufferSize, kMtu, StreamPriority(256),
+                    /*total_buffered_amount_low_threshold=*/0);
+  AddMessageToStreams(queue, num_streams);
+  int stream = 0;
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    queue.Add(kNow, DcSctpMessage(StreamID(stream), kPPID,
+                                  std::vector<uint8_t>(kPayloadSize)));
+    benchmark::DoNotOptimize(queue.Produce(kNow, kMtu));
+    stream = (stream + 1) % num_streams;
+  }
+}
+
+// Resets one stream, while `state.range(0)` streams are active.
+void BM_ResetStreamWithManyActiveStreams(benchmark::State& state) {
+  testing::NiceMock<MockDcSctpSocketCallbacks> callbacks;
+  const int num_streams = state.range(0);
+  RRSendQueue queue("", &callbacks, kBufferSize, kMtu, StreamPriority(256),
+                    /*total_buffered_amount_low_threshold=*/0);
+  AddMessageToStreams(queue, num_streams);
+  // A stream without any messages, which is reset over and over again.
+  const StreamID reset_stream(num_streams);
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    queue.PrepareResetStream(reset_stream);
+    benchmark::DoNotOptimize(queue.HasStreamsReadyToBeReset());
+    benchmark::DoNotOptimize(queue.GetStreamsReadyToBeReset());
+    queue.CommitResetStreams();
+  }
+}
+
+BENCHMARK(BM_SendWithManyActiveStreams)->Arg(10)->Arg(1000)->Arg(10000);
+BENCHMARK(BM_ResetStreamWithManyActiveStreams)
+    ->Arg(10)
+    ->Arg(1000)
+    ->Arg(10000);
+
+}  // namespace
+}  // namespace dcsctp
@@ -27,6 +27,7 @@
 
 namespace dcsctp {
 namespace {
+using ::testing::ElementsAre;
 using ::testing::SizeIs;
 using ::testing::UnorderedElementsAre;
 using ::webrtc::TimeDelta;
@@ -100,6 +101,27 @@ TEST_F(RRSendQueueTest, CarveOutBeginningMiddleAndEnd) {
   EXPECT_FALSE(buf_.Produce(kNow, kOneFragmentPacketSize).has_value());
 }
 
+TEST_F(RRSendQueueTest, FragmentsShareMessagePayload) {
+  std::vector<uint8_t> payload(60);
+  for (size_t i = 0; i < payload.size(); ++i) {
+    payload[i] = static_cast<uint8_t>(i);
+  }
+  buf_.Add(kNow, DcSctpMessage(kStreamID, kPPID, payload));
+
+  ASSERT_HAS_VALUE_AND_ASSIGN(SendQueue::DataToSend chunk1,
+                              buf_.Produce(kNow, /*max_size=*/20));
+  ASSERT_HAS_VALUE_AND_ASSIGN(SendQueue::DataToSend chunk2,
+                              buf_.Produce(kNow, /*max_size=*/40));
+  EXPECT_THAT(chunk1.data.payload, SizeIs(20));
+  EXPECT_THAT(chunk2.data.payload, SizeIs(40));
+  EXPECT_EQ(chunk1.data.payload.data() + 20, chunk2.data.payload.data());
+  EXPECT_EQ(chunk2.data.payload.data()[0], 20);
+
+  // Retained copies of the fragments don't copy the payload either.
+  Data retained = chunk2.data.Clone();
+  EXPECT_EQ(retained.payload.data(), chunk2.data.payload.data());
+}
+
 TEST_F(RRSendQueueTest, GetChunksFromTwoMessages) {
   std::vector<uint8_t> payload(60);
   buf_.Add(kNow, DcSctpMessage(kStreamID, kPPID, payload));
@@ -811,15 +833,72 @@ TEST_F(RRSendQueueTest, WillHandoverPriority) {
   buf_.SetStreamPriority(StreamID(2), StreamPriority(42));
 
   DcSctpSocketHandoverState state;
-  buf_.AddHandoverState(state);
+  buf_.AddHandoverState(kNow, state);
 
   RRSendQueue q2("log: ", &callbacks_, kMaxQueueSize, kMtu, kDefaultPriority,
                  kBufferedAmountLowThreshold);
-  q2.RestoreFromState(state);
+  q2.RestoreFromState(kNow, state);
   EXPECT_EQ(q2.GetStreamPriority(StreamID(1)), StreamPriority(42));
   EXPECT_EQ(q2.GetStreamPriority(StreamID(2)), StreamPriority(42));
 }
 
+TEST_F(RRSendQueueTest, WillHandoverQueuedMessages) {
+  buf_.Add(kNow, DcSctpMessage(StreamID(1), kPPID, {1, 2, 3}));
+  buf_.Add(kNow, DcSctpMessage(StreamID(2), kPPID, {4, 5}),
+           SendOptions{.unordered = IsUnordered(true),
+                       .lifetime = DurationMs(1000),
+                       .max_retransmissions = 2,
+                       .lifecycle_id = LifecycleId(1)});
+  buf_.Add(kNow, DcSctpMessage(StreamID(1), kPPID, {6}));
+  EXPECT_TRUE(buf_.GetHandoverReadiness().IsReady());
+
+  DcSctpSocketHandoverState state;
+  buf_.AddHandoverState(kNow, state);
+  EXPECT_TRUE(buf_.IsEmpty());
+  EXPECT_EQ(buf_.total_buffered_amount(), 0u);
+  EXPECT_FALSE(buf_.Produce(kNow, kOneFragmentPacketSize).has_value());
+
+  RRSendQueue q2("log: ", &callbacks_, kMaxQueueSize, kMtu, kDefaultPriority,
+                 kBufferedAmountLowThreshold);
+  const Timestamp later = kNow + TimeDelta::Millis(500);
+  q2.RestoreFromState(later, state);
+  EXPECT_EQ(q2.total_buffered_amount(), 6u);
+  EXPECT_EQ(q2.buffered_amount(StreamID(1)), 4u);
+  EXPECT_EQ(q2.buffered_amount(StreamID(2)), 2u);
+
+  ASSERT_HAS_VALUE_AND_ASSIGN(SendQueue::DataToSend chunk1,
+                              q2.Produce(later, kOneFragmentPacketSize));
+  EXPECT_EQ(chunk1.data.stream_id, StreamID(1));
+  EXPECT_THAT(chunk1.data.payload, ElementsAre(1, 2, 3));
+
+  ASSERT_HAS_VALUE_AND_ASSIGN(SendQueue::DataToSend chunk2,
+                              q2.Produce(later, kOneFragmentPacketSize));
+  EXPECT_EQ(chunk2.data.stream_id, StreamID(2));
+  EXPECT_THAT(chunk2.data.payload, ElementsAre(4, 5));
+  EXPECT_TRUE(chunk2.data.is_unordered);
+  EXPECT_EQ(chunk2.max_retransmissions, MaxRetransmits(2));
+  // The remaining lifetime is counted from when the state is restored.
+  EXPECT_EQ(chunk2.expires_at, later + TimeDelta::Millis(1001));
+  EXPECT_EQ(chunk2.lifecycle_id, LifecycleId(1));
+
+  ASSERT_HAS_VALUE_AND_ASSIGN(SendQueue::DataToSend chunk3,
+                              q2.Produce(later, kOneFragmentPacketSize));
+  EXPECT_EQ(chunk3.data.stream_id, StreamID(1));
+  EXPECT_THAT(chunk3.data.payload, ElementsAre(6));
+}
+
+TEST_F(RRSendQueueTest, IsNotReadyForHandoverWithPartiallySentMessage) {
+  buf_.Add(kNow, DcSctpMessage(StreamID(1), kPPID, std::vector<uint8_t>(20)));
+  EXPECT_TRUE(buf_.GetHandoverReadiness().IsReady());
+
+  ASSERT_TRUE(buf_.Produce(kNow, 10).has_value());
+  EXPECT_TRUE(buf_.GetHandoverReadiness().Contains(
+      HandoverUnreadinessReason::kSendQueueNotEmpty));
+
+  ASSERT_TRUE(buf_.Produce(kNow, 10).has_value());
+  EXPECT_TRUE(buf_.GetHandoverReadiness().IsReady());
+}
+
 TEST_F(RRSendQueueTest, WillSendMessagesByPrio) {
   buf_.EnableMessageInterleaving(true);
   buf_.SetStreamPriority(StreamID(1), StreamPriority(10));
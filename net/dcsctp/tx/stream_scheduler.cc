@@ -10,6 +10,7 @@
 #include "net/dcsctp/tx/stream_scheduler.h"
 
 #include <algorithm>
+#include <utility>
 
 #include "absl/algorithm/container.h"
 #include "absl/types/optional.h"
@@ -42,23 +43,23 @@ absl::optional<SendQueue::DataToSend> StreamScheduler::Produce(
   RTC_DLOG(LS_VERBOSE) << log_prefix_
                        << "Producing data, rescheduling=" << rescheduling
                        << ", active="
-                       << StrJoin(active_streams_, ", ",
-                                  [&](rtc::StringBuilder& sb, const auto& p) {
-                                    sb << *p->stream_id() << "@"
-                                       << *p->next_finish_time();
-                                  });
+                       << webrtc::StrJoin(
+                              active_streams_, ", ",
+                              [&](rtc::StringBuilder& sb, const auto& p) {
+                                sb << *p->stream_id() << "@"
+                                   << *p->next_finish_time();
+                              });
 
   RTC_DCHECK(rescheduling || current_stream_ != nullptr);
 
   absl::optional<SendQueue::DataToSend> data;
   while (!data.has_value() && !active_streams_.empty()) {
     if (rescheduling) {
-      auto it = active_streams_.begin();
-      current_stream_ = *it;
+      spare_node_ = active_streams_.extract(active_streams_.begin());
+      current_stream_ = spare_node_.value();
       RTC_DLOG(LS_VERBOSE) << log_prefix_ << "Rescheduling to stream "
                            << *current_stream_->stream_id();
 
-      active_streams_.erase(it);
       current_stream_->ForceMarkInactive();
     } else {
       RTC_DLOG(LS_VERBOSE) << log_prefix_ << "Producing from previous stream: "
@@ -178,7 +179,12 @@ void StreamScheduler::Stream::MakeActive(size_t bytes_to_send_next) {
   next_finish_time_ = next_finish_time;
   RTC_DCHECK(!absl::c_any_of(parent_.active_streams_,
                              [this](const auto* p) { return p == this; }));
-  parent_.active_streams_.emplace(this);
+  if (parent_.spare_node_.empty()) {
+    parent_.active_streams_.emplace(this);
+  } else {
+    parent_.spare_node_.value() = this;
+    parent_.active_streams_.insert(std::move(parent_.spare_node_));
+  }
 }
 
 void StreamScheduler::Stream::ForceMarkInactive() {
@@ -189,9 +195,10 @@ void StreamScheduler::Stream::ForceMarkInactive() {
 }
 
 void StreamScheduler::Stream::MakeInactive() {
+  // Must be removed before its finish time, which orders the set, is cleared.
+  parent_.spare_node_ = parent_.active_streams_.extract(this);
+  RTC_DCHECK(!parent_.spare_node_.empty());
   ForceMarkInactive();
-  webrtc::EraseIf(parent_.active_streams_,
-                  [&](const auto* s) { return s == this; });
 }
 
 std::set<StreamID> StreamScheduler::ActiveStreamsForTesting() const {
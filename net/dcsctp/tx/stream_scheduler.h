@@ -31,7 +31,6 @@
 #include "net/dcsctp/public/dcsctp_socket.h"
 #include "net/dcsctp/public/types.h"
 #include "net/dcsctp/tx/send_queue.h"
-#include "rtc_base/containers/flat_set.h"
 #include "rtc_base/strong_alias.h"
 
 namespace dcsctp {
@@ -217,8 +216,13 @@ class StreamScheduler {
   // stream until that message has been sent in full.
   bool currently_sending_a_message_ = false;
 
-  // The currently active streams, ordered by virtual finish time.
-  webrtc::flat_set<Stream*, ActiveStreamComparator> active_streams_;
+  // The currently active streams, ordered by virtual finish time. A tree-based
+  // set, as streams are frequently inserted and removed, and there may be
+  // thousands of them.
+  std::set<Stream*, ActiveStreamComparator> active_streams_;
+  // A node recently removed from `active_streams_`, which is reused when a
+  // stream is made active, to avoid allocating a new node every time.
+  std::set<Stream*, ActiveStreamComparator>::node_type spare_node_;
 };
 
 }  // namespace dcsctp
@@ -75,13 +75,13 @@ int AsyncStunTCPSocket::Send(const void* pv,
   if (cb != expected_pkt_len)
     return -1;
 
-  AppendToOutBuffer(pv, cb);
-
   RTC_DCHECK(pad_bytes < 4);
-  char padding[4] = {0};
-  AppendToOutBuffer(padding, pad_bytes);
+  static constexpr uint8_t kPadding[4] = {0};
+  const rtc::ArrayView<const uint8_t> frame[] = {
+      rtc::MakeArrayView(static_cast<const uint8_t*>(pv), cb),
+      rtc::MakeArrayView(kPadding, pad_bytes)};
 
-  int res = FlushOutBuffer();
+  int res = SendFrame(frame);
   if (res <= 0) {
     // drop packet if we made no progress
     ClearOutBuffer();
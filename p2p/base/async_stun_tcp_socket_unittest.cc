@@ -294,6 +294,25 @@ TEST_F(AsyncStunTCPSocketTest, TestWithSmallSendBuffer) {
                         sizeof(kTurnChannelDataMessageWithOddLength)));
 }
 
+// Test that packets are received in order when they arrive split across
+// several reads.
+TEST_F(AsyncStunTCPSocketTest, TestPacketsSplitAcrossReads) {
+  vss_->set_send_buffer_capacity(3);
+  EXPECT_TRUE(Send(kTurnChannelDataMessageWithOddLength,
+                   sizeof(kTurnChannelDataMessageWithOddLength)));
+  EXPECT_TRUE(Send(kStunMessageWithZeroLength,
+                   sizeof(kStunMessageWithZeroLength)));
+  EXPECT_TRUE(Send(kTurnChannelDataMessageWithOddLength,
+                   sizeof(kTurnChannelDataMessageWithOddLength)));
+  ASSERT_EQ(3u, recv_packets_.size());
+  EXPECT_TRUE(CheckData(kTurnChannelDataMessageWithOddLength,
+                        sizeof(kTurnChannelDataMessageWithOddLength)));
+  EXPECT_TRUE(CheckData(kStunMessageWithZeroLength,
+                        sizeof(kStunMessageWithZeroLength)));
+  EXPECT_TRUE(CheckData(kTurnChannelDataMessageWithOddLength,
+                        sizeof(kTurnChannelDataMessageWithOddLength)));
+}
+
 // Test that SignalSentPacket is fired when a packet is sent.
 TEST_F(AsyncStunTCPSocketTest, SignalSentPacketFiredWhenPacketSent) {
   ASSERT_TRUE(
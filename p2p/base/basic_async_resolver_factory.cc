@@ -16,12 +16,46 @@
 #include "absl/memory/memory.h"
 #include "api/async_dns_resolver.h"
 #include "rtc_base/async_dns_resolver.h"
+#include "rtc_base/experiments/field_trial_parser.h"
+#include "rtc_base/experiments/field_trial_units.h"
 #include "rtc_base/logging.h"
 
 namespace webrtc {
+namespace {
+
+absl::optional<DnsCacheConfig> ParseDnsCacheConfig(
+    const FieldTrialsView& field_trials) {
+  DnsCacheConfig defaults;
+  FieldTrialFlag enabled("Enabled");
+  FieldTrialParameter<TimeDelta> ttl("ttl", defaults.ttl);
+  FieldTrialParameter<TimeDelta> negative_ttl("negative_ttl",
+                                              defaults.negative_ttl);
+  ParseFieldTrial({&enabled, &ttl, &negative_ttl},
+                  field_trials.Lookup("WebRTC-DnsCache"));
+  if (!enabled) {
+    return absl::nullopt;
+  }
+  DnsCacheConfig config;
+  config.ttl = ttl.Get();
+  config.negative_ttl = negative_ttl.Get();
+  return config;
+}
+
+}  // namespace
+
+BasicAsyncDnsResolverFactory::BasicAsyncDnsResolverFactory(
+    absl::optional<DnsCacheConfig> cache_config)
+    : cache_config_(cache_config) {}
+
+BasicAsyncDnsResolverFactory::BasicAsyncDnsResolverFactory(
+    const FieldTrialsView& field_trials)
+    : cache_config_(ParseDnsCacheConfig(field_trials)) {}
 
 std::unique_ptr<webrtc::AsyncDnsResolverInterface>
 BasicAsyncDnsResolverFactory::Create() {
+  if (cache_config_) {
+    return std::make_unique<AsyncDnsResolver>(*cache_config_);
+  }
   return std::make_unique<AsyncDnsResolver>();
 }
 
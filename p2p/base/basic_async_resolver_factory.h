@@ -15,7 +15,10 @@
 #include <memory>
 #include <utility>
 
+#include "absl/types/optional.h"
 #include "api/async_dns_resolver.h"
+#include "api/field_trials_view.h"
+#include "rtc_base/async_dns_resolver.h"
 
 namespace webrtc {
 
@@ -24,6 +27,14 @@ class BasicAsyncDnsResolverFactory final
     : public AsyncDnsResolverFactoryInterface {
  public:
   BasicAsyncDnsResolverFactory() = default;
+  // Vends resolvers sharing the process-wide cache of resolutions, with the
+  // TTLs of `cache_config`, if set.
+  explicit BasicAsyncDnsResolverFactory(
+      absl::optional<DnsCacheConfig> cache_config);
+  // Vends resolvers sharing the process-wide cache of resolutions if the
+  // field trial WebRTC-DnsCache is enabled, e.g. with
+  // "WebRTC-DnsCache/Enabled,ttl:60s,negative_ttl:5s/".
+  explicit BasicAsyncDnsResolverFactory(const FieldTrialsView& field_trials);
 
   std::unique_ptr<webrtc::AsyncDnsResolverInterface> CreateAndResolve(
       const rtc::SocketAddress& addr,
@@ -35,6 +46,9 @@ class BasicAsyncDnsResolverFactory final
       absl::AnyInvocable<void()> callback) override;
 
   std::unique_ptr<webrtc::AsyncDnsResolverInterface> Create() override;
+
+ private:
+  const absl::optional<DnsCacheConfig> cache_config_;
 };
 
 }  // namespace webrtc
@@ -46,6 +46,9 @@ DefaultIceTransportFactory::CreateIceTransport(
     IceTransportInit init) {
   BasicIceControllerFactory factory;
   init.set_ice_controller_factory(&factory);
+  if (ping_scheduler_) {
+    init.set_ping_scheduler(ping_scheduler_);
+  }
   return rtc::make_ref_counted<DefaultIceTransport>(
       cricket::P2PTransportChannel::Create(transport_name, component,
                                            std::move(init)));
@@ -44,6 +44,10 @@ class DefaultIceTransport : public IceTransportInterface {
 class DefaultIceTransportFactory : public IceTransportFactory {
  public:
   DefaultIceTransportFactory() = default;
+  // The transports schedule their connectivity checks with `ping_scheduler`,
+  // which must outlive them.
+  explicit DefaultIceTransportFactory(cricket::IcePingScheduler* ping_scheduler)
+      : ping_scheduler_(ping_scheduler) {}
   ~DefaultIceTransportFactory() = default;
 
   // Must be called on the network thread and returns a DefaultIceTransport.
@@ -51,6 +55,9 @@ class DefaultIceTransportFactory : public IceTransportFactory {
       const std::string& transport_name,
       int component,
       IceTransportInit init) override;
+
+ private:
+  cricket::IcePingScheduler* const ping_scheduler_ = nullptr;
 };
 
 }  // namespace webrtc
@@ -97,13 +97,18 @@ rtc::StreamResult StreamInterfaceChannel::Write(
   // Always succeeds, since this is an unreliable transport anyway.
   // TODO(zhihuang): Should this block if ice_transport_'s temporarily
   // unwritable?
-  rtc::PacketOptions packet_options;
   ice_transport_->SendPacket(reinterpret_cast<const char*>(data.data()),
-                             data.size(), packet_options);
+                             data.size(), packet_options_);
   written = data.size();
   return rtc::SR_SUCCESS;
 }
 
+void StreamInterfaceChannel::SetPacketOptions(
+    const rtc::PacketOptions& options) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  packet_options_ = options;
+}
+
 bool StreamInterfaceChannel::OnPacketReceived(const char* data, size_t size) {
   RTC_DCHECK_RUN_ON(&sequence_checker_);
   if (packets_.size() > 0) {
@@ -452,12 +457,14 @@ int DtlsTransport::SendPacket(const char* data,
       } else {
         size_t written;
         int error;
-        return (dtls_->WriteAll(
-                    rtc::MakeArrayView(reinterpret_cast<const uint8_t*>(data),
-                                       size),
-                    written, error) == rtc::SR_SUCCESS)
-                   ? static_cast<int>(size)
-                   : -1;
+        // The record is sent with the caller's options, e.g. so that batched
+        // packets are still batched after being encrypted.
+        downward_->SetPacketOptions(options);
+        rtc::StreamResult result = dtls_->WriteAll(
+            rtc::MakeArrayView(reinterpret_cast<const uint8_t*>(data), size),
+            written, error);
+        downward_->SetPacketOptions(rtc::PacketOptions());
+        return result == rtc::SR_SUCCESS ? static_cast<int>(size) : -1;
       }
     case webrtc::DtlsTransportState::kFailed:
       // Can't send anything when we're failed.
@@ -21,6 +21,7 @@
 #include "api/sequence_checker.h"
 #include "p2p/base/dtls_transport_internal.h"
 #include "p2p/base/ice_transport_internal.h"
+#include "rtc_base/async_packet_socket.h"
 #include "rtc_base/buffer.h"
 #include "rtc_base/buffer_queue.h"
 #include "rtc_base/ssl_stream_adapter.h"
@@ -46,6 +47,9 @@ class StreamInterfaceChannel : public rtc::StreamInterface {
   // Push in a packet; this gets pulled out from Read().
   bool OnPacketReceived(const char* data, size_t size);
 
+  // Options for the packets written to the ICE transport, until changed.
+  void SetPacketOptions(const rtc::PacketOptions& options);
+
   // Implementations of StreamInterface
   rtc::StreamState GetState() const override;
   void Close() override;
@@ -61,6 +65,7 @@ class StreamInterfaceChannel : public rtc::StreamInterface {
   IceTransportInternal* const ice_transport_;  // owned by DtlsTransport
   rtc::StreamState state_ RTC_GUARDED_BY(sequence_checker_);
   rtc::BufferQueue packets_ RTC_GUARDED_BY(sequence_checker_);
+  rtc::PacketOptions packet_options_ RTC_GUARDED_BY(sequence_checker_);
 };
 
 // This class provides a DTLS SSLStreamAdapter inside a TransportChannel-style
@@ -0,0 +1,113 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/ice_ping_scheduler.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/time_utils.h"
+
+namespace cricket {
+
+IcePingScheduler::IcePingScheduler(webrtc::TimeDelta slack)
+    : network_thread_(webrtc::TaskQueueBase::Current()),
+      slack_ms_(slack.ms()) {
+  RTC_DCHECK(network_thread_);
+  RTC_DCHECK_GE(slack_ms_, 0);
+}
+
+IcePingScheduler::~IcePingScheduler() {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  RTC_DCHECK(scheduled_.empty()) << "Clients must be cancelled first.";
+}
+
+void IcePingScheduler::Schedule(Client* client, webrtc::TimeDelta delay) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  RTC_DCHECK(client);
+  int64_t due_ms = rtc::TimeMillis() + std::max<int64_t>(delay.ms(), 0);
+  if (slack_ms_ > 0) {
+    due_ms = (due_ms + slack_ms_ - 1) / slack_ms_ * slack_ms_;
+  }
+  auto it = scheduled_.find(client);
+  if (it != scheduled_.end()) {
+    if (it->second->first == due_ms) {
+      return;
+    }
+    queue_.erase(it->second);
+    it->second = queue_.emplace(due_ms, client);
+  } else {
+    scheduled_.emplace(client, queue_.emplace(due_ms, client));
+  }
+  MaybeArmTimer();
+}
+
+void IcePingScheduler::Cancel(Client* client) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  auto it = scheduled_.find(client);
+  if (it != scheduled_.end()) {
+    queue_.erase(it->second);
+    scheduled_.erase(it);
+  }
+  // The client may be about to be called from OnTimer().
+  std::replace(due_clients_.begin(), due_clients_.end(), client,
+               static_cast<Client*>(nullptr));
+}
+
+bool IcePingScheduler::IsScheduled(const Client* client) const {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  return scheduled_.find(client) != scheduled_.end();
+}
+
+void IcePingScheduler::MaybeArmTimer() {
+  if (queue_.empty()) {
+    return;
+  }
+  const int64_t due_ms = queue_.begin()->first;
+  if (timer_due_ms_ && *timer_due_ms_ <= due_ms) {
+    return;
+  }
+  // A later timer task may still be pending; OnTimer() ignores it.
+  timer_due_ms_ = due_ms;
+  network_thread_->PostDelayedTask(
+      webrtc::SafeTask(task_safety_.flag(),
+                       [this, due_ms] {
+                         RTC_DCHECK_RUN_ON(&sequence_checker_);
+                         OnTimer(due_ms);
+                       }),
+      webrtc::TimeDelta::Millis(
+          std::max<int64_t>(due_ms - rtc::TimeMillis(), 0)));
+}
+
+void IcePingScheduler::OnTimer(int64_t due_ms) {
+  if (timer_due_ms_ != due_ms) {
+    return;
+  }
+  timer_due_ms_ = absl::nullopt;
+
+  const int64_t now_ms = rtc::TimeMillis();
+  RTC_DCHECK(due_clients_.empty());
+  while (!queue_.empty() && queue_.begin()->first <= now_ms) {
+    Client* client = queue_.begin()->second;
+    due_clients_.push_back(client);
+    scheduled_.erase(client);
+    queue_.erase(queue_.begin());
+  }
+  // Clients may schedule or cancel themselves, or each other, when called.
+  for (size_t i = 0; i < due_clients_.size(); ++i) {
+    if (due_clients_[i]) {
+      due_clients_[i]->OnPingDue();
+    }
+  }
+  due_clients_.clear();
+  MaybeArmTimer();
+}
+
+}  // namespace cricket
@@ -0,0 +1,95 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef P2P_BASE_ICE_PING_SCHEDULER_H_
+#define P2P_BASE_ICE_PING_SCHEDULER_H_
+
+#include <stdint.h>
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/sequence_checker.h"
+#include "api/task_queue/pending_task_safety_flag.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/units/time_delta.h"
+#include "rtc_base/system/no_unique_address.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace cricket {
+
+// Schedules the connectivity checks of many ICE transports on one timer.
+// Without it, each ICE controller posts its own delayed task for every ping
+// it may send, so a process with thousands of transports wakes up the network
+// thread thousands of times per ping interval. The scheduler keeps the clients
+// ordered by the time their next check is due, and rounds that time up to a
+// multiple of `slack`, so that all the checks due in the same slot run in one
+// wake up.
+//
+// Must be created, used and destroyed on the network thread, and must outlive
+// its clients.
+class IcePingScheduler {
+ public:
+  class Client {
+   public:
+    // Called on the network thread when the check scheduled with Schedule()
+    // is due. The client is no longer scheduled when this is called.
+    virtual void OnPingDue() = 0;
+
+   protected:
+    virtual ~Client() = default;
+  };
+
+  static constexpr webrtc::TimeDelta kDefaultSlack =
+      webrtc::TimeDelta::Millis(5);
+
+  explicit IcePingScheduler(webrtc::TimeDelta slack = kDefaultSlack);
+  ~IcePingScheduler();
+
+  IcePingScheduler(const IcePingScheduler&) = delete;
+  IcePingScheduler& operator=(const IcePingScheduler&) = delete;
+
+  // Calls `client->OnPingDue()` once `delay` has passed, at most `slack`
+  // later. Replaces the check already scheduled for `client`, if any.
+  void Schedule(Client* client, webrtc::TimeDelta delay);
+
+  // Cancels the check scheduled for `client`, if any. Must be called before
+  // `client` is destroyed.
+  void Cancel(Client* client);
+
+  bool IsScheduled(const Client* client) const;
+
+ private:
+  using Queue = std::multimap<int64_t, Client*>;
+
+  // Makes sure that a task runs when the earliest check is due.
+  void MaybeArmTimer() RTC_RUN_ON(sequence_checker_);
+  void OnTimer(int64_t due_ms) RTC_RUN_ON(sequence_checker_);
+
+  RTC_NO_UNIQUE_ADDRESS webrtc::SequenceChecker sequence_checker_;
+  webrtc::TaskQueueBase* const network_thread_;
+  const int64_t slack_ms_;
+
+  // The scheduled clients, ordered by the time their check is due, in ms.
+  Queue queue_ RTC_GUARDED_BY(sequence_checker_);
+  std::unordered_map<const Client*, Queue::iterator> scheduled_
+      RTC_GUARDED_BY(sequence_checker_);
+  // The time of the pending timer task, if any.
+  absl::optional<int64_t> timer_due_ms_ RTC_GUARDED_BY(sequence_checker_);
+  // The clients being called by OnTimer(). Cancelled clients are set to null.
+  std::vector<Client*> due_clients_ RTC_GUARDED_BY(sequence_checker_);
+  webrtc::ScopedTaskSafety task_safety_;
+};
+
+}  // namespace cricket
+
+#endif  // P2P_BASE_ICE_PING_SCHEDULER_H_
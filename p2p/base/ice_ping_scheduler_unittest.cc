@@ -0,0 +1,135 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/ice_ping_scheduler.h"
+
+#include <functional>
+#include <vector>
+
+#include "rtc_base/fake_clock.h"
+#include "rtc_base/gunit.h"
+#include "rtc_base/thread.h"
+
+namespace cricket {
+namespace {
+
+using ::webrtc::TimeDelta;
+
+class FakeClient : public IcePingScheduler::Client {
+ public:
+  FakeClient(int id, std::vector<int>* calls) : id_(id), calls_(calls) {}
+
+  void OnPingDue() override {
+    calls_->push_back(id_);
+    if (on_ping_due_) {
+      on_ping_due_();
+    }
+  }
+
+  std::function<void()> on_ping_due_;
+
+ private:
+  const int id_;
+  std::vector<int>* const calls_;
+};
+
+class IcePingSchedulerTest : public ::testing::Test {
+ protected:
+  IcePingSchedulerTest() {
+    // Start on a slot boundary, so that delays are not rounded.
+    clock_.SetTime(webrtc::Timestamp::Seconds(1));
+  }
+
+  rtc::AutoThread main_thread_;
+  rtc::ScopedFakeClock clock_;
+  std::vector<int> calls_;
+};
+
+TEST_F(IcePingSchedulerTest, CallsClientsInDueOrder) {
+  IcePingScheduler scheduler(/*slack=*/TimeDelta::Zero());
+  FakeClient a(1, &calls_), b(2, &calls_), c(3, &calls_);
+  scheduler.Schedule(&a, TimeDelta::Millis(30));
+  scheduler.Schedule(&b, TimeDelta::Millis(10));
+  scheduler.Schedule(&c, TimeDelta::Millis(20));
+  EXPECT_TRUE(scheduler.IsScheduled(&a));
+
+  clock_.AdvanceTime(TimeDelta::Millis(9));
+  EXPECT_TRUE(calls_.empty());
+  clock_.AdvanceTime(TimeDelta::Millis(1));
+  EXPECT_EQ(calls_, std::vector<int>({2}));
+  EXPECT_FALSE(scheduler.IsScheduled(&b));
+  clock_.AdvanceTime(TimeDelta::Millis(20));
+  EXPECT_EQ(calls_, std::vector<int>({2, 3, 1}));
+}
+
+TEST_F(IcePingSchedulerTest, CoalescesChecksDueInTheSameSlot) {
+  IcePingScheduler scheduler(/*slack=*/TimeDelta::Millis(10));
+  FakeClient a(1, &calls_), b(2, &calls_), c(3, &calls_);
+  scheduler.Schedule(&a, TimeDelta::Millis(1));
+  scheduler.Schedule(&b, TimeDelta::Millis(7));
+  scheduler.Schedule(&c, TimeDelta::Millis(11));
+
+  // `a` and `b` both run at the end of the first slot, and no earlier.
+  clock_.AdvanceTime(TimeDelta::Millis(9));
+  EXPECT_TRUE(calls_.empty());
+  clock_.AdvanceTime(TimeDelta::Millis(1));
+  EXPECT_EQ(calls_, std::vector<int>({1, 2}));
+  clock_.AdvanceTime(TimeDelta::Millis(10));
+  EXPECT_EQ(calls_, std::vector<int>({1, 2, 3}));
+}
+
+TEST_F(IcePingSchedulerTest, RescheduleReplacesPendingCheck) {
+  IcePingScheduler scheduler(/*slack=*/TimeDelta::Zero());
+  FakeClient a(1, &calls_);
+  scheduler.Schedule(&a, TimeDelta::Millis(50));
+  scheduler.Schedule(&a, TimeDelta::Millis(10));
+  clock_.AdvanceTime(TimeDelta::Millis(10));
+  EXPECT_EQ(calls_, std::vector<int>({1}));
+  clock_.AdvanceTime(TimeDelta::Millis(100));
+  EXPECT_EQ(calls_, std::vector<int>({1}));
+
+  scheduler.Schedule(&a, TimeDelta::Millis(10));
+  scheduler.Schedule(&a, TimeDelta::Millis(50));
+  clock_.AdvanceTime(TimeDelta::Millis(49));
+  EXPECT_EQ(calls_, std::vector<int>({1}));
+  clock_.AdvanceTime(TimeDelta::Millis(1));
+  EXPECT_EQ(calls_, std::vector<int>({1, 1}));
+}
+
+TEST_F(IcePingSchedulerTest, CancelledClientIsNotCalled) {
+  IcePingScheduler scheduler(/*slack=*/TimeDelta::Zero());
+  FakeClient a(1, &calls_), b(2, &calls_);
+  scheduler.Schedule(&a, TimeDelta::Millis(10));
+  scheduler.Schedule(&b, TimeDelta::Millis(10));
+  scheduler.Cancel(&a);
+  EXPECT_FALSE(scheduler.IsScheduled(&a));
+  clock_.AdvanceTime(TimeDelta::Millis(10));
+  EXPECT_EQ(calls_, std::vector<int>({2}));
+}
+
+TEST_F(IcePingSchedulerTest, ClientsCanRescheduleAndCancelWhenCalled) {
+  IcePingScheduler scheduler(/*slack=*/TimeDelta::Zero());
+  FakeClient a(1, &calls_), b(2, &calls_);
+  // `a` reschedules itself and cancels `b`, which was due at the same time.
+  a.on_ping_due_ = [&] {
+    scheduler.Schedule(&a, TimeDelta::Millis(10));
+    scheduler.Cancel(&b);
+  };
+  scheduler.Schedule(&a, TimeDelta::Millis(10));
+  scheduler.Schedule(&b, TimeDelta::Millis(10));
+  clock_.AdvanceTime(TimeDelta::Millis(10));
+  EXPECT_EQ(calls_, std::vector<int>({1}));
+  clock_.AdvanceTime(TimeDelta::Millis(10));
+  EXPECT_EQ(calls_, std::vector<int>({1, 1}));
+  scheduler.Cancel(&a);
+}
+
+}  // namespace
+}  // namespace cricket
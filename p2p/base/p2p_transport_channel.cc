@@ -42,6 +42,7 @@
 #include "rtc_base/network.h"
 #include "rtc_base/network_constants.h"
 #include "rtc_base/string_encode.h"
+#include "rtc_base/strings/string_builder.h"
 #include "rtc_base/time_utils.h"
 #include "rtc_base/trace_event.h"
 #include "system_wrappers/include/metrics.h"
@@ -120,7 +121,7 @@ std::unique_ptr<P2PTransportChannel> P2PTransportChannel::Create(
       transport_name, component, init.port_allocator(),
       init.async_dns_resolver_factory(), nullptr, init.event_log(),
       init.ice_controller_factory(), init.active_ice_controller_factory(),
-      init.field_trials()));
+      init.ping_scheduler(), init.field_trials()));
 }
 
 P2PTransportChannel::P2PTransportChannel(
@@ -136,6 +137,7 @@ P2PTransportChannel::P2PTransportChannel(
                           /* event_log= */ nullptr,
                           /* ice_controller_factory= */ nullptr,
                           /* active_ice_controller_factory= */ nullptr,
+                          /* ping_scheduler= */ nullptr,
                           field_trials) {}
 
 // Private constructor, called from Create()
@@ -149,6 +151,7 @@ P2PTransportChannel::P2PTransportChannel(
     webrtc::RtcEventLog* event_log,
     IceControllerFactoryInterface* ice_controller_factory,
     ActiveIceControllerFactoryInterface* active_ice_controller_factory,
+    IcePingScheduler* ping_scheduler,
     const webrtc::FieldTrialsView* field_trials)
     : transport_name_(transport_name),
       component_(component),
@@ -210,7 +213,7 @@ P2PTransportChannel::P2PTransportChannel(
     ice_controller_ = active_ice_controller_factory->Create(active_args);
   } else {
     ice_controller_ = std::make_unique<WrappingActiveIceController>(
-        /* ice_agent= */ this, ice_controller_factory, args);
+        /* ice_agent= */ this, ice_controller_factory, args, ping_scheduler);
   }
 }
 
@@ -289,6 +292,44 @@ void P2PTransportChannel::AddConnection(Connection* connection) {
 
   connections_.push_back(connection);
   ice_controller_->OnConnectionAdded(connection);
+
+  if (ice_field_trials_.fast_reconnect &&
+      absl::c_linear_search(validated_paths_, GetNetworkPath(connection))) {
+    RTC_LOG(LS_INFO) << ToString()
+                     << ": Checking previously validated network path first: "
+                     << connection->ToString();
+    fast_reconnect_connections_.insert(connection);
+    // The remote credentials are not known yet for candidates that arrived
+    // before them, and the connection is then pinged later.
+    if (!connection->remote_candidate().username().empty() &&
+        !connection->remote_candidate().password().empty()) {
+      SendPingRequestInternal(connection);
+    }
+  }
+}
+
+std::string P2PTransportChannel::GetNetworkPath(
+    const Connection* connection) const {
+  // The ports and the ICE credentials change with an ICE restart, while the
+  // local network and the addresses do not.
+  rtc::StringBuilder path;
+  path << connection->network()->name() << "/"
+       << connection->local_candidate().type() << "/"
+       << connection->local_candidate().protocol() << "/"
+       << connection->local_candidate().address().ipaddr().ToString() << "/"
+       << connection->remote_candidate().address().ipaddr().ToString();
+  return path.Release();
+}
+
+void P2PTransportChannel::RememberValidatedPath(const Connection* connection) {
+  std::string path = GetNetworkPath(connection);
+  auto it = absl::c_find(validated_paths_, path);
+  if (it != validated_paths_.end()) {
+    validated_paths_.erase(it);
+  } else if (validated_paths_.size() == kMaxValidatedPaths) {
+    validated_paths_.pop_back();
+  }
+  validated_paths_.push_front(std::move(path));
 }
 
 void P2PTransportChannel::ForgetLearnedStateForConnections(
@@ -728,7 +769,9 @@ void P2PTransportChannel::ParseFieldTrials(
       &ice_field_trials_.stop_gather_on_strongly_connected,
       // GOOG_DELTA
       "enable_goog_delta", &ice_field_trials_.enable_goog_delta,
-      "answer_goog_delta", &ice_field_trials_.answer_goog_delta)
+      "answer_goog_delta", &ice_field_trials_.answer_goog_delta,
+      // Check the previously validated network paths first.
+      "fast_reconnect", &ice_field_trials_.fast_reconnect)
       ->Parse(field_trials->Lookup("WebRTC-IceFieldTrials"));
 
   if (ice_field_trials_.dead_connection_timeout_ms < 30000) {
@@ -2082,6 +2125,18 @@ void P2PTransportChannel::OnConnectionStateChange(Connection* connection) {
       MaybeStopPortAllocatorSessions();
     }
   }
+
+  if (ice_field_trials_.fast_reconnect && connection->writable()) {
+    RememberValidatedPath(connection);
+    if (fast_reconnect_connections_.erase(connection) > 0) {
+      // The connection is on a path that was used before, so switch to it
+      // without waiting for the others.
+      ice_controller_->OnImmediateSortAndSwitchRequest(
+          IceSwitchReason::CONNECT_STATE_CHANGE);
+      return;
+    }
+  }
+
   // We have to unroll the stack before doing this because we may be changing
   // the state of connections while sorting.
   ice_controller_->OnSortAndSwitchRequest(
@@ -2125,6 +2180,7 @@ void P2PTransportChannel::RemoveConnection(Connection* connection) {
   RTC_DCHECK(it != connections_.end());
   connection->DeregisterReceivedPacketCallback();
   connections_.erase(it);
+  fast_reconnect_connections_.erase(connection);
   connection->ClearStunDictConsumer();
   ice_controller_->OnConnectionDestroyed(connection);
 }
@@ -24,6 +24,7 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <deque>
 #include <map>
 #include <memory>
 #include <set>
@@ -51,6 +52,7 @@
 #include "p2p/base/ice_agent_interface.h"
 #include "p2p/base/ice_controller_factory_interface.h"
 #include "p2p/base/ice_controller_interface.h"
+#include "p2p/base/ice_ping_scheduler.h"
 #include "p2p/base/ice_switch_reason.h"
 #include "p2p/base/ice_transport_internal.h"
 #include "p2p/base/p2p_constants.h"
@@ -265,6 +267,7 @@ class RTC_EXPORT P2PTransportChannel : public IceTransportInternal,
       webrtc::RtcEventLog* event_log,
       IceControllerFactoryInterface* ice_controller_factory,
       ActiveIceControllerFactoryInterface* active_ice_controller_factory,
+      IcePingScheduler* ping_scheduler,
       const webrtc::FieldTrialsView* field_trials);
 
   bool IsGettingPorts() {
@@ -306,6 +309,11 @@ class RTC_EXPORT P2PTransportChannel : public IceTransportInternal,
   void PingConnection(Connection* conn);
   void AddAllocatorSession(std::unique_ptr<PortAllocatorSession> session);
   void AddConnection(Connection* connection);
+  // Returns the part of the connection's candidate pair that does not change
+  // with an ICE restart, and remembers it once the connection is writable.
+  std::string GetNetworkPath(const Connection* connection) const;
+  void RememberValidatedPath(const Connection* connection)
+      RTC_RUN_ON(network_thread_);
 
   void OnPortReady(PortAllocatorSession* session, PortInterface* port);
   void OnPortsPruned(PortAllocatorSession* session,
@@ -508,6 +516,14 @@ class RTC_EXPORT P2PTransportChannel : public IceTransportInternal,
   // Parsed field trials.
   IceFieldTrials ice_field_trials_;
 
+  // The network paths of the connections that were writable, most recent
+  // first, and the connections created on one of them that have not been
+  // writable yet. Used by the fast_reconnect field trial.
+  static constexpr size_t kMaxValidatedPaths = 8;
+  std::deque<std::string> validated_paths_ RTC_GUARDED_BY(network_thread_);
+  std::set<const Connection*> fast_reconnect_connections_
+      RTC_GUARDED_BY(network_thread_);
+
   // A dictionary of attributes that will be reflected to peer.
   StunDictionaryWriter stun_dict_writer_;
 
@@ -74,6 +74,11 @@ struct IceFieldTrials {
   // Announce/enable GOOG_DELTA
   bool enable_goog_delta = true;  // send GOOG DELTA
   bool answer_goog_delta = true;  // answer GOOG DELTA
+
+  // Remember the network paths of the connections that became writable, and
+  // when a connection is created on one of them again, e.g. after an ICE
+  // restart, ping it right away and select it as soon as it is writable.
+  bool fast_reconnect = false;
 };
 
 }  // namespace cricket
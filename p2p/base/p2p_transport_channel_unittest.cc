@@ -4074,6 +4074,42 @@ TEST_F(P2PTransportChannelPingTest, TestPingOnNomination) {
   EXPECT_EQ(conn1->num_pings_sent(), before + 1);
 }
 
+// With fast_reconnect, the connections created after an ICE restart on a
+// network path that was writable before are pinged right away.
+TEST_F(P2PTransportChannelPingTest, TestFastReconnectAfterIceRestart) {
+  rtc::ScopedFakeClock clock;
+  webrtc::test::ScopedKeyValueConfig field_trials(
+      field_trials_, "WebRTC-IceFieldTrials/fast_reconnect:true/");
+  FakePortAllocator pa(rtc::Thread::Current(), packet_socket_factory(),
+                       &field_trials_);
+  P2PTransportChannel ch("fast reconnect", 1, &pa, &field_trials);
+  PrepareChannel(&ch);
+  ch.MaybeStartGathering();
+  ch.AddRemoteCandidate(CreateUdpCandidate(LOCAL_PORT_TYPE, "1.1.1.1", 1, 1));
+  Connection* conn1 = WaitForConnectionTo(&ch, "1.1.1.1", 1, &clock);
+  ASSERT_TRUE(conn1 != nullptr);
+  conn1->ReceivedPingResponse(LOW_RTT, "id");
+  EXPECT_EQ_SIMULATED_WAIT(conn1, ch.selected_connection(), kDefaultTimeout,
+                           clock);
+
+  ch.SetIceParameters(kIceParams[2]);
+  ch.SetRemoteIceParameters(kIceParams[3]);
+  ch.MaybeStartGathering();
+  EXPECT_EQ_SIMULATED_WAIT(2u, ch.ports().size() + ch.pruned_ports().size(),
+                           kDefaultTimeout, clock);
+
+  // The remote side restarted too, and its candidate has a new port.
+  ch.AddRemoteCandidate(CreateUdpCandidate(LOCAL_PORT_TYPE, "1.1.1.1", 2, 1));
+  int new_connections = 0;
+  for (Connection* conn : ch.connections()) {
+    if (conn->remote_candidate().address().port() == 2) {
+      ++new_connections;
+      EXPECT_EQ(1, conn->num_pings_sent());
+    }
+  }
+  EXPECT_GT(new_connections, 0);
+}
+
 // Test the field trial send_ping_on_switch_ice_controlling
 // that sends a ping directly when switching to a new connection
 // on the ICE_CONTROLLING-side.
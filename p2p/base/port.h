@@ -20,6 +20,7 @@
 #include <set>
 #include <string>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -282,9 +283,17 @@ class RTC_EXPORT Port : public PortInterface, public sigslot::has_slots<> {
   void SubscribePortDestroyed(
       std::function<void(PortInterface*)> callback) override;
   void SendPortDestroyed(Port* port);
+  // Hashes a remote address consistently with SocketAddress::operator==.
+  struct AddressHash {
+    size_t operator()(const rtc::SocketAddress& address) const {
+      return address.Hash();
+    }
+  };
   // Returns a map containing all of the connections of this port, keyed by the
-  // remote address.
-  typedef std::map<rtc::SocketAddress, Connection*> AddressMap;
+  // remote address. It is looked up for every received packet, and has no
+  // particular order.
+  typedef std::unordered_map<rtc::SocketAddress, Connection*, AddressHash>
+      AddressMap;
   const AddressMap& connections() { return connections_; }
 
   // Returns the connection to the given address or NULL if none exists.
@@ -10,6 +10,8 @@
 
 #include "p2p/base/stun_request.h"
 
+#include <string.h>
+
 #include <algorithm>
 #include <memory>
 #include <utility>
@@ -43,6 +45,13 @@ const int STUN_MAX_RETRANSMISSIONS = 8;  // Total sends: 9
 // work well.
 const int STUN_MAX_RTO = 8000;  // milliseconds, or 5 doublings
 
+size_t StunRequestManager::TransactionIdHash::operator()(
+    const std::string& id) const {
+  uint64_t hash = 0;
+  memcpy(&hash, id.data(), std::min(id.size(), sizeof(hash)));
+  return static_cast<size_t>(hash);
+}
+
 StunRequestManager::StunRequestManager(
     webrtc::TaskQueueBase* thread,
     std::function<void(const void*, size_t, StunRequest*)> send_packet)
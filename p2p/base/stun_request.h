@@ -18,6 +18,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 
 #include "api/task_queue/pending_task_safety_flag.h"
 #include "api/task_queue/task_queue_base.h"
@@ -79,7 +80,14 @@ class StunRequestManager {
   void SendPacket(const void* data, size_t size, StunRequest* request);
 
  private:
-  typedef std::map<std::string, std::unique_ptr<StunRequest>> RequestMap;
+  // Transaction IDs are random, so their first bytes make a good hash.
+  struct TransactionIdHash {
+    size_t operator()(const std::string& id) const;
+  };
+  typedef std::unordered_map<std::string,
+                             std::unique_ptr<StunRequest>,
+                             TransactionIdHash>
+      RequestMap;
 
   webrtc::TaskQueueBase* const thread_;
   RequestMap requests_ RTC_GUARDED_BY(thread_);
@@ -11,6 +11,7 @@
 #include "p2p/base/turn_port.h"
 
 #include <cstdint>
+#include <cstring>
 #include <functional>
 #include <memory>
 #include <utility>
@@ -26,6 +27,7 @@
 #include "p2p/base/connection.h"
 #include "p2p/base/p2p_constants.h"
 #include "rtc_base/async_packet_socket.h"
+#include "rtc_base/buffer.h"
 #include "rtc_base/byte_order.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/experiments/field_trial_parser.h"
@@ -1776,34 +1778,43 @@ int TurnEntry::Send(const void* data,
                     size_t size,
                     bool payload,
                     const rtc::PacketOptions& options) {
-  rtc::ByteBufferWriter buf;
-  if (state_ != STATE_BOUND ||
-      !port_->TurnCustomizerAllowChannelData(data, size, payload)) {
-    // If we haven't bound the channel yet, we have to use a Send Indication.
-    // The turn_customizer_ can also make us use Send Indication.
-    TurnMessage msg(TURN_SEND_INDICATION);
-    msg.AddAttribute(std::make_unique<StunXorAddressAttribute>(
-        STUN_ATTR_XOR_PEER_ADDRESS, ext_addr_));
-    msg.AddAttribute(
-        std::make_unique<StunByteStringAttribute>(STUN_ATTR_DATA, data, size));
-
-    port_->TurnCustomizerMaybeModifyOutgoingStunMessage(&msg);
-
-    const bool success = msg.Write(&buf);
-    RTC_DCHECK(success);
-
-    // If we're sending real data, request a channel bind that we can use later.
-    if (state_ == STATE_UNBOUND && payload) {
-      SendChannelBindRequest(0);
-      state_ = STATE_BINDING;
+  rtc::PacketOptions modified_options(options);
+  if (state_ == STATE_BOUND &&
+      port_->TurnCustomizerAllowChannelData(data, size, payload)) {
+    // If the channel is bound, we can send the data as a Channel Message. It
+    // is written to a buffer that the port reuses for every packet, so that
+    // the payload is copied once, without allocating.
+    rtc::Buffer& packet = port_->channel_data_buffer_;
+    packet.SetSize(TURN_CHANNEL_HEADER_SIZE + size);
+    rtc::SetBE16(packet.data(), channel_id_);
+    rtc::SetBE16(packet.data() + 2, static_cast<uint16_t>(size));
+    if (size > 0) {
+      memcpy(packet.data() + TURN_CHANNEL_HEADER_SIZE, data, size);
     }
-  } else {
-    // If the channel is bound, we can send the data as a Channel Message.
-    buf.WriteUInt16(channel_id_);
-    buf.WriteUInt16(static_cast<uint16_t>(size));
-    buf.WriteBytes(reinterpret_cast<const uint8_t*>(data), size);
+    modified_options.info_signaled_after_sent.turn_overhead_bytes =
+        TURN_CHANNEL_HEADER_SIZE;
+    return port_->Send(packet.data(), packet.size(), modified_options);
+  }
+
+  // If we haven't bound the channel yet, we have to use a Send Indication.
+  // The turn_customizer_ can also make us use Send Indication.
+  rtc::ByteBufferWriter buf;
+  TurnMessage msg(TURN_SEND_INDICATION);
+  msg.AddAttribute(std::make_unique<StunXorAddressAttribute>(
+      STUN_ATTR_XOR_PEER_ADDRESS, ext_addr_));
+  msg.AddAttribute(
+      std::make_unique<StunByteStringAttribute>(STUN_ATTR_DATA, data, size));
+
+  port_->TurnCustomizerMaybeModifyOutgoingStunMessage(&msg);
+
+  const bool success = msg.Write(&buf);
+  RTC_DCHECK(success);
+
+  // If we're sending real data, request a channel bind that we can use later.
+  if (state_ == STATE_UNBOUND && payload) {
+    SendChannelBindRequest(0);
+    state_ = STATE_BINDING;
   }
-  rtc::PacketOptions modified_options(options);
   modified_options.info_signaled_after_sent.turn_overhead_bytes =
       buf.Length() - size;
   return port_->Send(buf.Data(), buf.Length(), modified_options);
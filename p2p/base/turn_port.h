@@ -28,6 +28,7 @@
 #include "p2p/base/port_allocator.h"
 #include "p2p/client/relay_port_factory_interface.h"
 #include "rtc_base/async_packet_socket.h"
+#include "rtc_base/buffer.h"
 #include "rtc_base/network/received_packet.h"
 #include "rtc_base/ssl_certificate.h"
 
@@ -337,6 +338,8 @@ class TurnPort : public Port {
 
   int next_channel_number_;
   std::vector<std::unique_ptr<TurnEntry>> entries_;
+  // Holds the ChannelData message being sent, reused across packets.
+  rtc::Buffer channel_data_buffer_;
 
   PortState state_;
   // By default the value will be set to 0. This value will be used in
@@ -10,12 +10,13 @@
 
 #include "p2p/base/turn_server.h"
 
+#include <string.h>
+
 #include <algorithm>
 #include <memory>
 #include <tuple>  // for std::tie
 #include <utility>
 
-#include "absl/algorithm/container.h"
 #include "absl/memory/memory.h"
 #include "absl/strings/string_view.h"
 #include "api/array_view.h"
@@ -24,6 +25,7 @@
 #include "api/transport/stun.h"
 #include "p2p/base/async_stun_tcp_socket.h"
 #include "rtc_base/byte_buffer.h"
+#include "rtc_base/byte_order.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/helpers.h"
 #include "rtc_base/logging.h"
@@ -484,14 +486,14 @@ void TurnServer::SendStun(TurnServerConnection* conn, StunMessage* msg) {
         STUN_ATTR_SOFTWARE, software_));
   }
   msg->Write(&buf);
-  Send(conn, buf);
+  Send(conn, buf.DataView());
 }
 
 void TurnServer::Send(TurnServerConnection* conn,
-                      const rtc::ByteBufferWriter& buf) {
+                      rtc::ArrayView<const uint8_t> packet) {
   RTC_DCHECK_RUN_ON(thread_);
   rtc::PacketOptions options;
-  conn->socket()->SendTo(buf.Data(), buf.Length(), conn->src(), options);
+  conn->socket()->SendTo(packet.data(), packet.size(), conn->src(), options);
 }
 
 void TurnServer::DestroyAllocation(TurnServerAllocation* allocation) {
@@ -541,6 +543,11 @@ bool TurnServerConnection::operator<(const TurnServerConnection& c) const {
   return std::tie(src_, dst_, proto_) < std::tie(c.src_, c.dst_, c.proto_);
 }
 
+size_t TurnServerConnection::Hash::operator()(
+    const TurnServerConnection& c) const {
+  return c.src_.Hash() ^ (c.dst_.Hash() * 31) ^ c.proto_;
+}
+
 std::string TurnServerConnection::ToString() const {
   const char* const kProtos[] = {"unknown", "udp", "tcp", "ssltcp"};
   rtc::StringBuilder ost;
@@ -568,6 +575,7 @@ TurnServerAllocation::TurnServerAllocation(TurnServer* server,
 
 TurnServerAllocation::~TurnServerAllocation() {
   channels_.clear();
+  channel_ids_.clear();
   perms_.clear();
   RTC_LOG(LS_INFO) << ToString() << ": Allocation destroyed";
 }
@@ -728,23 +736,25 @@ void TurnServerAllocation::HandleChannelBindRequest(const TurnMessage* msg) {
 
   // Check that this channel id isn't bound to another transport address, and
   // that this transport address isn't bound to another channel id.
-  auto channel1 = FindChannel(channel_id);
-  auto channel2 = FindChannel(peer_attr->GetAddress());
-  if (channel1 != channel2) {
+  const Channel* bound_channel = FindChannel(channel_id);
+  const int* bound_channel_id = FindChannelId(peer_attr->GetAddress());
+  if ((bound_channel != nullptr) != (bound_channel_id != nullptr) ||
+      (bound_channel_id && *bound_channel_id != channel_id)) {
     SendBadRequestResponse(msg);
     return;
   }
 
   // Add or refresh this channel.
-  if (channel1 == channels_.end()) {
-    channel1 = channels_.insert(
-        channels_.end(), {.id = channel_id, .peer = peer_attr->GetAddress()});
+  Channel& channel = channels_[channel_id];
+  if (bound_channel) {
+    channel.pending_delete.reset();
   } else {
-    channel1->pending_delete.reset();
+    channel.peer = peer_attr->GetAddress();
+    channel_ids_.emplace(channel.peer, channel_id);
   }
   thread_->PostDelayedTask(
-      SafeTask(channel1->pending_delete.flag(),
-               [this, channel1] { channels_.erase(channel1); }),
+      SafeTask(channel.pending_delete.flag(),
+               [this, channel_id] { RemoveChannel(channel_id); }),
       kChannelTimeout);
 
   // Channel binds also refresh permissions.
@@ -763,8 +773,8 @@ void TurnServerAllocation::HandleChannelData(
     rtc::ArrayView<const uint8_t> payload) {
   // Extract the channel number from the data.
   uint16_t channel_id = rtc::GetBE16(payload.data());
-  auto channel = FindChannel(channel_id);
-  if (channel != channels_.end()) {
+  const Channel* channel = FindChannel(channel_id);
+  if (channel) {
     // Send the data to the peer address.
     SendExternal(payload.data() + TURN_CHANNEL_HEADER_SIZE,
                  payload.size() - TURN_CHANNEL_HEADER_SIZE, channel->peer);
@@ -778,13 +788,19 @@ void TurnServerAllocation::HandleChannelData(
 void TurnServerAllocation::OnExternalPacket(rtc::AsyncPacketSocket* socket,
                                             const rtc::ReceivedPacket& packet) {
   RTC_DCHECK(external_socket_.get() == socket);
-  auto channel = FindChannel(packet.source_address());
-  if (channel != channels_.end()) {
-    // There is a channel bound to this address. Send as a channel message.
-    rtc::ByteBufferWriter buf;
-    buf.WriteUInt16(channel->id);
-    buf.WriteUInt16(static_cast<uint16_t>(packet.payload().size()));
-    buf.WriteBytes(packet.payload().data(), packet.payload().size());
+  const int* channel_id = FindChannelId(packet.source_address());
+  if (channel_id) {
+    // There is a channel bound to this address. Send as a channel message,
+    // written to a buffer that the server reuses for every packet.
+    rtc::Buffer& buf = server_->channel_data_buffer_;
+    buf.SetSize(TURN_CHANNEL_HEADER_SIZE + packet.payload().size());
+    rtc::SetBE16(buf.data(), static_cast<uint16_t>(*channel_id));
+    rtc::SetBE16(buf.data() + 2,
+                 static_cast<uint16_t>(packet.payload().size()));
+    if (!packet.payload().empty()) {
+      memcpy(buf.data() + TURN_CHANNEL_HEADER_SIZE, packet.payload().data(),
+             packet.payload().size());
+    }
     server_->Send(&conn_, buf);
   } else if (!server_->enable_permission_checks_ ||
              HasPermission(packet.source_address().ipaddr())) {
@@ -811,37 +827,37 @@ TimeDelta TurnServerAllocation::ComputeLifetime(const TurnMessage& msg) {
 }
 
 bool TurnServerAllocation::HasPermission(const rtc::IPAddress& addr) {
-  return FindPermission(addr) != perms_.end();
+  return perms_.find(addr) != perms_.end();
 }
 
 void TurnServerAllocation::AddPermission(const rtc::IPAddress& addr) {
-  auto perm = FindPermission(addr);
-  if (perm == perms_.end()) {
-    perm = perms_.insert(perms_.end(), {.peer = addr});
-  } else {
-    perm->pending_delete.reset();
+  auto [perm, inserted] = perms_.try_emplace(addr);
+  if (!inserted) {
+    perm->second.reset();
   }
-  thread_->PostDelayedTask(SafeTask(perm->pending_delete.flag(),
-                                    [this, perm] { perms_.erase(perm); }),
-                           kPermissionTimeout);
+  thread_->PostDelayedTask(
+      SafeTask(perm->second.flag(), [this, addr] { perms_.erase(addr); }),
+      kPermissionTimeout);
 }
 
-TurnServerAllocation::PermissionList::iterator
-TurnServerAllocation::FindPermission(const rtc::IPAddress& addr) {
-  return absl::c_find_if(perms_,
-                         [&](const Permission& p) { return p.peer == addr; });
+const TurnServerAllocation::Channel* TurnServerAllocation::FindChannel(
+    int channel_id) const {
+  auto it = channels_.find(channel_id);
+  return it != channels_.end() ? &it->second : nullptr;
 }
 
-TurnServerAllocation::ChannelList::iterator TurnServerAllocation::FindChannel(
-    int channel_id) {
-  return absl::c_find_if(channels_,
-                         [&](const Channel& c) { return c.id == channel_id; });
+const int* TurnServerAllocation::FindChannelId(
+    const rtc::SocketAddress& addr) const {
+  auto it = channel_ids_.find(addr);
+  return it != channel_ids_.end() ? &it->second : nullptr;
 }
 
-TurnServerAllocation::ChannelList::iterator TurnServerAllocation::FindChannel(
-    const rtc::SocketAddress& addr) {
-  return absl::c_find_if(channels_,
-                         [&](const Channel& c) { return c.peer == addr; });
+void TurnServerAllocation::RemoveChannel(int channel_id) {
+  auto it = channels_.find(channel_id);
+  if (it != channels_.end()) {
+    channel_ids_.erase(it->second.peer);
+    channels_.erase(it);
+  }
 }
 
 void TurnServerAllocation::SendResponse(TurnMessage* msg) {
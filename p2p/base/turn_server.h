@@ -11,21 +11,24 @@
 #ifndef P2P_BASE_TURN_SERVER_H_
 #define P2P_BASE_TURN_SERVER_H_
 
-#include <list>
 #include <map>
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "absl/strings/string_view.h"
+#include "api/array_view.h"
 #include "api/sequence_checker.h"
 #include "api/task_queue/pending_task_safety_flag.h"
 #include "api/task_queue/task_queue_base.h"
 #include "api/units/time_delta.h"
 #include "p2p/base/port_interface.h"
 #include "rtc_base/async_packet_socket.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/ip_address.h"
 #include "rtc_base/network/received_packet.h"
 #include "rtc_base/socket_address.h"
 #include "rtc_base/ssl_adapter.h"
@@ -58,6 +61,10 @@ class TurnServerConnection {
   bool operator<(const TurnServerConnection& t) const;
   std::string ToString() const;
 
+  struct Hash {
+    size_t operator()(const TurnServerConnection& c) const;
+  };
+
  private:
   rtc::SocketAddress src_;
   rtc::SocketAddress dst_;
@@ -96,15 +103,27 @@ class TurnServerAllocation {
  private:
   struct Channel {
     webrtc::ScopedTaskSafety pending_delete;
-    int id;
     rtc::SocketAddress peer;
   };
-  struct Permission {
-    webrtc::ScopedTaskSafety pending_delete;
-    rtc::IPAddress peer;
+  struct IPAddressHash {
+    size_t operator()(const rtc::IPAddress& ip) const {
+      return rtc::HashIP(ip);
+    }
+  };
+  struct SocketAddressHash {
+    size_t operator()(const rtc::SocketAddress& addr) const {
+      return addr.Hash();
+    }
   };
-  using PermissionList = std::list<Permission>;
-  using ChannelList = std::list<Channel>;
+  // Permissions by peer IP address. Destroying the safety flag cancels the
+  // expiration of the permission.
+  using PermissionMap = std::unordered_map<rtc::IPAddress,
+                                           webrtc::ScopedTaskSafety,
+                                           IPAddressHash>;
+  // Channels by channel number, and channel numbers by peer address.
+  using ChannelMap = std::unordered_map<int, Channel>;
+  using ChannelIdMap =
+      std::unordered_map<rtc::SocketAddress, int, SocketAddressHash>;
 
   void PostDeleteSelf(webrtc::TimeDelta delay);
 
@@ -120,9 +139,10 @@ class TurnServerAllocation {
   static webrtc::TimeDelta ComputeLifetime(const TurnMessage& msg);
   bool HasPermission(const rtc::IPAddress& addr);
   void AddPermission(const rtc::IPAddress& addr);
-  PermissionList::iterator FindPermission(const rtc::IPAddress& addr);
-  ChannelList::iterator FindChannel(int channel_id);
-  ChannelList::iterator FindChannel(const rtc::SocketAddress& addr);
+  // Returns the channel bound to `channel_id` or to `addr`, or nullptr.
+  const Channel* FindChannel(int channel_id) const;
+  const int* FindChannelId(const rtc::SocketAddress& addr) const;
+  void RemoveChannel(int channel_id);
 
   void SendResponse(TurnMessage* msg);
   void SendBadRequestResponse(const TurnMessage* req);
@@ -141,8 +161,9 @@ class TurnServerAllocation {
   std::string transaction_id_;
   std::string username_;
   std::string last_nonce_;
-  PermissionList perms_;
-  ChannelList channels_;
+  PermissionMap perms_;
+  ChannelMap channels_;
+  ChannelIdMap channel_ids_;
   webrtc::ScopedTaskSafety safety_;
 };
 
@@ -179,7 +200,9 @@ class StunMessageObserver {
 // Not yet wired up: TCP support.
 class TurnServer : public sigslot::has_slots<> {
  public:
-  typedef std::map<TurnServerConnection, std::unique_ptr<TurnServerAllocation>>
+  typedef std::unordered_map<TurnServerConnection,
+                             std::unique_ptr<TurnServerAllocation>,
+                             TurnServerConnection::Hash>
       AllocationMap;
 
   explicit TurnServer(webrtc::TaskQueueBase* thread);
@@ -315,7 +338,7 @@ class TurnServer : public sigslot::has_slots<> {
       RTC_RUN_ON(thread_);
 
   void SendStun(TurnServerConnection* conn, StunMessage* msg);
-  void Send(TurnServerConnection* conn, const rtc::ByteBufferWriter& buf);
+  void Send(TurnServerConnection* conn, rtc::ArrayView<const uint8_t> packet);
 
   void DestroyAllocation(TurnServerAllocation* allocation) RTC_RUN_ON(thread_);
   void DestroyInternalSocket(rtc::AsyncPacketSocket* socket)
@@ -349,6 +372,9 @@ class TurnServer : public sigslot::has_slots<> {
   rtc::SocketAddress external_addr_ RTC_GUARDED_BY(thread_);
 
   AllocationMap allocations_ RTC_GUARDED_BY(thread_);
+  // Holds the ChannelData message being relayed to a client, reused across
+  // packets.
+  rtc::Buffer channel_data_buffer_ RTC_GUARDED_BY(thread_);
 
   // For testing only. If this is non-zero, the next NONCE will be generated
   // from this value, and it will be reset to 0 after generating the NONCE.
@@ -37,8 +37,10 @@ namespace cricket {
 
 WrappingActiveIceController::WrappingActiveIceController(
     IceAgentInterface* ice_agent,
-    std::unique_ptr<IceControllerInterface> wrapped)
+    std::unique_ptr<IceControllerInterface> wrapped,
+    IcePingScheduler* ping_scheduler)
     : network_thread_(rtc::Thread::Current()),
+      ping_scheduler_(ping_scheduler),
       wrapped_(std::move(wrapped)),
       agent_(*ice_agent) {
   RTC_DCHECK(ice_agent != nullptr);
@@ -47,8 +49,11 @@ WrappingActiveIceController::WrappingActiveIceController(
 WrappingActiveIceController::WrappingActiveIceController(
     IceAgentInterface* ice_agent,
     IceControllerFactoryInterface* wrapped_factory,
-    const IceControllerFactoryArgs& wrapped_factory_args)
-    : network_thread_(rtc::Thread::Current()), agent_(*ice_agent) {
+    const IceControllerFactoryArgs& wrapped_factory_args,
+    IcePingScheduler* ping_scheduler)
+    : network_thread_(rtc::Thread::Current()),
+      ping_scheduler_(ping_scheduler),
+      agent_(*ice_agent) {
   RTC_DCHECK(ice_agent != nullptr);
   if (wrapped_factory) {
     wrapped_ = wrapped_factory->Create(wrapped_factory_args);
@@ -57,7 +62,11 @@ WrappingActiveIceController::WrappingActiveIceController(
   }
 }
 
-WrappingActiveIceController::~WrappingActiveIceController() {}
+WrappingActiveIceController::~WrappingActiveIceController() {
+  if (ping_scheduler_) {
+    ping_scheduler_->Cancel(this);
+  }
+}
 
 void WrappingActiveIceController::SetIceConfig(const IceConfig& config) {
   RTC_DCHECK_RUN_ON(network_thread_);
@@ -111,13 +120,30 @@ void WrappingActiveIceController::MaybeStartPinging() {
   }
 
   if (wrapped_->HasPingableConnection()) {
-    network_thread_->PostTask(
-        SafeTask(task_safety_.flag(), [this]() { SelectAndPingConnection(); }));
+    SchedulePing(TimeDelta::Zero());
     agent_.OnStartedPinging();
     started_pinging_ = true;
   }
 }
 
+void WrappingActiveIceController::SchedulePing(TimeDelta delay) {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  if (ping_scheduler_) {
+    ping_scheduler_->Schedule(this, delay);
+  } else if (delay.IsZero()) {
+    network_thread_->PostTask(
+        SafeTask(task_safety_.flag(), [this]() { SelectAndPingConnection(); }));
+  } else {
+    network_thread_->PostDelayedTask(
+        SafeTask(task_safety_.flag(), [this]() { SelectAndPingConnection(); }),
+        delay);
+  }
+}
+
+void WrappingActiveIceController::OnPingDue() {
+  SelectAndPingConnection();
+}
+
 void WrappingActiveIceController::SelectAndPingConnection() {
   RTC_DCHECK_RUN_ON(network_thread_);
   agent_.UpdateConnectionStates();
@@ -135,9 +161,7 @@ void WrappingActiveIceController::HandlePingResult(
     agent_.SendPingRequest(result.connection.value());
   }
 
-  network_thread_->PostDelayedTask(
-      SafeTask(task_safety_.flag(), [this]() { SelectAndPingConnection(); }),
-      TimeDelta::Millis(result.recheck_delay_ms));
+  SchedulePing(TimeDelta::Millis(result.recheck_delay_ms));
 }
 
 void WrappingActiveIceController::OnSortAndSwitchRequest(
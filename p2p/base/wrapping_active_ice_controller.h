@@ -15,11 +15,13 @@
 
 #include "absl/types/optional.h"
 #include "api/task_queue/pending_task_safety_flag.h"
+#include "api/units/time_delta.h"
 #include "p2p/base/active_ice_controller_interface.h"
 #include "p2p/base/connection.h"
 #include "p2p/base/ice_agent_interface.h"
 #include "p2p/base/ice_controller_factory_interface.h"
 #include "p2p/base/ice_controller_interface.h"
+#include "p2p/base/ice_ping_scheduler.h"
 #include "p2p/base/ice_switch_reason.h"
 #include "p2p/base/ice_transport_internal.h"
 #include "p2p/base/transport_description.h"
@@ -30,13 +32,18 @@ namespace cricket {
 
 // WrappingActiveIceController provides the functionality of a legacy passive
 // ICE controller but packaged as an active ICE Controller.
-class WrappingActiveIceController : public ActiveIceControllerInterface {
+class WrappingActiveIceController : public ActiveIceControllerInterface,
+                                    private IcePingScheduler::Client {
  public:
   // Constructs an active ICE controller wrapping an already constructed legacy
   // ICE controller. Does not take ownership of the ICE agent, which must
   // already exist and outlive the ICE controller.
+  // If a ping scheduler is supplied, the connectivity checks are scheduled
+  // with it, instead of with a task of their own. It must outlive the ICE
+  // controller.
   WrappingActiveIceController(IceAgentInterface* ice_agent,
-                              std::unique_ptr<IceControllerInterface> wrapped);
+                              std::unique_ptr<IceControllerInterface> wrapped,
+                              IcePingScheduler* ping_scheduler = nullptr);
   // Constructs an active ICE controller that wraps over a legacy ICE
   // controller. The legacy ICE controller is constructed through a factory, if
   // one is supplied. If not, a default BasicIceController is wrapped instead.
@@ -45,7 +52,8 @@ class WrappingActiveIceController : public ActiveIceControllerInterface {
   WrappingActiveIceController(
       IceAgentInterface* ice_agent,
       IceControllerFactoryInterface* wrapped_factory,
-      const IceControllerFactoryArgs& wrapped_factory_args);
+      const IceControllerFactoryArgs& wrapped_factory_args,
+      IcePingScheduler* ping_scheduler = nullptr);
   virtual ~WrappingActiveIceController();
 
   void SetIceConfig(const IceConfig& config) override;
@@ -69,7 +77,11 @@ class WrappingActiveIceController : public ActiveIceControllerInterface {
 
  private:
   void MaybeStartPinging();
+  // Runs SelectAndPingConnection() after `delay`.
+  void SchedulePing(webrtc::TimeDelta delay);
   void SelectAndPingConnection();
+  // IcePingScheduler::Client implementation.
+  void OnPingDue() override;
   void HandlePingResult(IceControllerInterface::PingResult result);
 
   void SortAndSwitchToBestConnection(IceSwitchReason reason);
@@ -80,6 +92,7 @@ class WrappingActiveIceController : public ActiveIceControllerInterface {
   void PruneConnections();
 
   rtc::Thread* const network_thread_;
+  IcePingScheduler* const ping_scheduler_;
   webrtc::ScopedTaskSafety task_safety_;
 
   bool started_pinging_ RTC_GUARDED_BY(network_thread_) = false;
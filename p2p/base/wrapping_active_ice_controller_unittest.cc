@@ -15,6 +15,7 @@
 #include <vector>
 
 #include "p2p/base/connection.h"
+#include "p2p/base/ice_ping_scheduler.h"
 #include "p2p/base/mock_ice_agent.h"
 #include "p2p/base/mock_ice_controller.h"
 #include "rtc_base/fake_clock.h"
@@ -28,6 +29,7 @@ using ::cricket::IceConfig;
 using ::cricket::IceControllerFactoryArgs;
 using ::cricket::IceControllerInterface;
 using ::cricket::IceMode;
+using ::cricket::IcePingScheduler;
 using ::cricket::IceRecheckEvent;
 using ::cricket::IceSwitchReason;
 using ::cricket::MockIceAgent;
@@ -48,6 +50,7 @@ using ::rtc::AutoThread;
 using ::rtc::Event;
 using ::rtc::ScopedFakeClock;
 using ::webrtc::TimeDelta;
+using ::webrtc::Timestamp;
 
 using NiceMockIceController = NiceMock<MockIceController>;
 
@@ -312,4 +315,55 @@ TEST(WrappingActiveIceControllerTest, StartPingingAfterSortAndSwitch) {
   clock.AdvanceTime(TimeDelta::Millis(recheck_delay_ms));
 }
 
+TEST(WrappingActiveIceControllerTest, PingsWithSharedScheduler) {
+  AutoThread main;
+  ScopedFakeClock clock;
+  // Start on a slot boundary of the scheduler.
+  clock.SetTime(Timestamp::Seconds(1));
+  IcePingScheduler scheduler(/*slack=*/TimeDelta::Millis(10));
+
+  NiceMock<MockIceAgent> agent_one;
+  std::unique_ptr<NiceMockIceController> will_move_one =
+      std::make_unique<NiceMockIceController>(IceControllerFactoryArgs{});
+  NiceMockIceController* wrapped_one = will_move_one.get();
+  WrappingActiveIceController controller_one(
+      &agent_one, std::move(will_move_one), &scheduler);
+
+  NiceMock<MockIceAgent> agent_two;
+  std::unique_ptr<NiceMockIceController> will_move_two =
+      std::make_unique<NiceMockIceController>(IceControllerFactoryArgs{});
+  NiceMockIceController* wrapped_two = will_move_two.get();
+  WrappingActiveIceController controller_two(
+      &agent_two, std::move(will_move_two), &scheduler);
+
+  ON_CALL(*wrapped_one, HasPingableConnection()).WillByDefault(Return(true));
+  ON_CALL(*wrapped_one, SelectConnectionToPing(_))
+      .WillByDefault(Return(IceControllerInterface::PingResult(
+          kConnection, /* recheck_delay_ms= */ 3)));
+  ON_CALL(*wrapped_two, HasPingableConnection()).WillByDefault(Return(true));
+  ON_CALL(*wrapped_two, SelectConnectionToPing(_))
+      .WillByDefault(Return(IceControllerInterface::PingResult(
+          kConnectionTwo, /* recheck_delay_ms= */ 7)));
+
+  // Both start pinging right away.
+  EXPECT_CALL(agent_one, SendPingRequest(kConnection)).Times(1);
+  EXPECT_CALL(agent_two, SendPingRequest(kConnectionTwo)).Times(1);
+  controller_one.OnImmediateSortAndSwitchRequest(IceSwitchReason::UNKNOWN);
+  controller_two.OnImmediateSortAndSwitchRequest(IceSwitchReason::UNKNOWN);
+  clock.AdvanceTime(TimeDelta::Zero());
+  ::testing::Mock::VerifyAndClearExpectations(&agent_one);
+  ::testing::Mock::VerifyAndClearExpectations(&agent_two);
+
+  // The rechecks are coalesced at the end of the slot.
+  EXPECT_CALL(agent_one, SendPingRequest(_)).Times(0);
+  EXPECT_CALL(agent_two, SendPingRequest(_)).Times(0);
+  clock.AdvanceTime(TimeDelta::Millis(9));
+  ::testing::Mock::VerifyAndClearExpectations(&agent_one);
+  ::testing::Mock::VerifyAndClearExpectations(&agent_two);
+
+  EXPECT_CALL(agent_one, SendPingRequest(kConnection)).Times(1);
+  EXPECT_CALL(agent_two, SendPingRequest(kConnectionTwo)).Times(1);
+  clock.AdvanceTime(kTick);
+}
+
 }  // namespace
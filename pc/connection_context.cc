@@ -15,6 +15,7 @@
 #include <vector>
 
 #include "api/environment/environment.h"
+#include "api/thread_policy.h"
 #include "media/base/media_engine.h"
 #include "media/sctp/sctp_transport_factory.h"
 #include "pc/media_factory.h"
@@ -27,8 +28,21 @@ namespace webrtc {
 
 namespace {
 
+// Applies `attributes`, if set, to the thread started as `thread`.
+void MaybeApplyThreadAttributes(
+    rtc::Thread* thread,
+    const absl::optional<rtc::ThreadAttributes>& attributes) {
+  if (!attributes) {
+    return;
+  }
+  thread->PostTask([attributes = *attributes, name = thread->name()] {
+    ApplyThreadAttributes(attributes, name);
+  });
+}
+
 rtc::Thread* MaybeStartNetworkThread(
     rtc::Thread* old_thread,
+    const absl::optional<rtc::ThreadAttributes>& attributes,
     std::unique_ptr<rtc::SocketFactory>& socket_factory_holder,
     std::unique_ptr<rtc::Thread>& thread_holder) {
   if (old_thread) {
@@ -41,6 +55,7 @@ rtc::Thread* MaybeStartNetworkThread(
 
   thread_holder->SetName("pc_network_thread", nullptr);
   thread_holder->Start();
+  MaybeApplyThreadAttributes(thread_holder.get(), attributes);
   return thread_holder.get();
 }
 
@@ -83,19 +98,32 @@ rtc::scoped_refptr<ConnectionContext> ConnectionContext::Create(
       new ConnectionContext(env, dependencies));
 }
 
+// Static
+rtc::scoped_refptr<ConnectionContext> ConnectionContext::CreateNetworkShard(
+    rtc::scoped_refptr<ConnectionContext> parent) {
+  RTC_DCHECK(parent);
+  RTC_DCHECK(!parent->parent_);
+  return rtc::scoped_refptr<ConnectionContext>(
+      new ConnectionContext(std::move(parent)));
+}
+
 ConnectionContext::ConnectionContext(
     const Environment& env,
     PeerConnectionFactoryDependencies* dependencies)
-    : network_thread_(MaybeStartNetworkThread(dependencies->network_thread,
-                                              owned_socket_factory_,
-                                              owned_network_thread_)),
-      worker_thread_(dependencies->worker_thread,
-                     []() {
-                       auto thread_holder = rtc::Thread::Create();
-                       thread_holder->SetName("pc_worker_thread", nullptr);
-                       thread_holder->Start();
-                       return thread_holder;
-                     }),
+    : network_thread_(
+          MaybeStartNetworkThread(dependencies->network_thread,
+                                  dependencies->thread_policy.network,
+                                  owned_socket_factory_,
+                                  owned_network_thread_)),
+      worker_thread_(
+          dependencies->worker_thread,
+          [&attributes = dependencies->thread_policy.worker]() {
+            auto thread_holder = rtc::Thread::Create();
+            thread_holder->SetName("pc_worker_thread", nullptr);
+            thread_holder->Start();
+            MaybeApplyThreadAttributes(thread_holder.get(), attributes);
+            return thread_holder;
+          }),
       signaling_thread_(MaybeWrapThread(dependencies->signaling_thread,
                                         wraps_current_thread_)),
       env_(env),
@@ -112,11 +140,54 @@ ConnectionContext::ConnectionContext(
       sctp_factory_(
           MaybeCreateSctpFactory(std::move(dependencies->sctp_factory),
                                  network_thread())),
-      use_rtx_(true) {
+      use_rtx_(true),
+      network_thread_attributes_(dependencies->thread_policy.network) {
   RTC_DCHECK_RUN_ON(signaling_thread_);
   RTC_DCHECK(!(default_network_manager_ && network_monitor_factory_))
       << "You can't set both network_manager and network_monitor_factory.";
 
+  rtc::InitRandom(rtc::Time32());
+
+  InitializeNetwork(dependencies->socket_factory,
+                    network_monitor_factory_.get());
+
+  if (media_engine_) {
+    // TODO(tommi): Change VoiceEngine to do ctor time initialization so that
+    // this isn't necessary.
+    worker_thread_->BlockingCall([&] { media_engine_->Init(); });
+  }
+}
+
+ConnectionContext::ConnectionContext(
+    rtc::scoped_refptr<ConnectionContext> parent)
+    : wraps_current_thread_(false),
+      network_thread_(
+          MaybeStartNetworkThread(/*old_thread=*/nullptr,
+                                  parent->network_thread_attributes_,
+                                  owned_socket_factory_,
+                                  owned_network_thread_)),
+      worker_thread_(parent->worker_thread(),
+                     []() -> std::unique_ptr<rtc::Thread> {
+                       RTC_DCHECK_NOTREACHED();
+                       return nullptr;
+                     }),
+      signaling_thread_(parent->signaling_thread()),
+      env_(parent->env()),
+      sctp_factory_(MaybeCreateSctpFactory(/*factory=*/nullptr,
+                                           network_thread())),
+      use_rtx_(parent->use_rtx_),
+      network_thread_attributes_(parent->network_thread_attributes_),
+      parent_(std::move(parent)) {
+  RTC_DCHECK_RUN_ON(signaling_thread_);
+  // The parent's network monitor factory outlives this context, which holds a
+  // reference to the parent.
+  InitializeNetwork(/*socket_factory=*/nullptr,
+                    parent_->network_monitor_factory_.get());
+}
+
+void ConnectionContext::InitializeNetwork(
+    rtc::SocketFactory* socket_factory,
+    rtc::NetworkMonitorFactory* network_monitor_factory) {
   signaling_thread_->AllowInvokesToThread(worker_thread());
   signaling_thread_->AllowInvokesToThread(network_thread_);
   worker_thread_->AllowInvokesToThread(network_thread_);
@@ -135,9 +206,6 @@ ConnectionContext::ConnectionContext(
         });
   }
 
-  rtc::InitRandom(rtc::Time32());
-
-  rtc::SocketFactory* socket_factory = dependencies->socket_factory;
   if (socket_factory == nullptr) {
     if (owned_socket_factory_) {
       socket_factory = owned_socket_factory_.get();
@@ -154,7 +222,7 @@ ConnectionContext::ConnectionContext(
     // If network_monitor_factory_ is non-null, it will be used to create a
     // network monitor while on the network thread.
     default_network_manager_ = std::make_unique<rtc::BasicNetworkManager>(
-        network_monitor_factory_.get(), socket_factory, &env_.field_trials());
+        network_monitor_factory, socket_factory, &env_.field_trials());
   }
   if (!default_socket_factory_) {
     default_socket_factory_ =
@@ -168,12 +236,6 @@ ConnectionContext::ConnectionContext(
   signaling_thread_->SetDispatchWarningMs(100);
   worker_thread_->SetDispatchWarningMs(30);
   network_thread_->SetDispatchWarningMs(10);
-
-  if (media_engine_) {
-    // TODO(tommi): Change VoiceEngine to do ctor time initialization so that
-    // this isn't necessary.
-    worker_thread_->BlockingCall([&] { media_engine_->Init(); });
-  }
 }
 
 ConnectionContext::~ConnectionContext() {
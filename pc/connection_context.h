@@ -14,6 +14,7 @@
 #include <memory>
 #include <string>
 
+#include "absl/types/optional.h"
 #include "api/environment/environment.h"
 #include "api/media_stream_interface.h"
 #include "api/peer_connection_interface.h"
@@ -26,6 +27,7 @@
 #include "rtc_base/checks.h"
 #include "rtc_base/network.h"
 #include "rtc_base/network_monitor_factory.h"
+#include "rtc_base/platform_thread.h"
 #include "rtc_base/rtc_certificate_generator.h"
 #include "rtc_base/socket_factory.h"
 #include "rtc_base/thread.h"
@@ -54,6 +56,13 @@ class ConnectionContext final
       const Environment& env,
       PeerConnectionFactoryDependencies* dependencies);
 
+  // Creates a ConnectionContext with its own network thread, network manager,
+  // packet socket factory and SCTP transport factory, sharing everything else
+  // (threads, media engine, SSRC generator, environment) with `parent`.
+  // Used to spread PeerConnections over several network threads.
+  static rtc::scoped_refptr<ConnectionContext> CreateNetworkShard(
+      rtc::scoped_refptr<ConnectionContext> parent);
+
   // This class is not copyable or movable.
   ConnectionContext(const ConnectionContext&) = delete;
   ConnectionContext& operator=(const ConnectionContext&) = delete;
@@ -64,7 +73,7 @@ class ConnectionContext final
   }
 
   cricket::MediaEngineInterface* media_engine() const {
-    return media_engine_.get();
+    return parent_ ? parent_->media_engine() : media_engine_.get();
   }
 
   rtc::Thread* signaling_thread() { return signaling_thread_; }
@@ -90,26 +99,50 @@ class ConnectionContext final
   }
   MediaFactory* call_factory() {
     RTC_DCHECK_RUN_ON(worker_thread());
-    return call_factory_.get();
+    return parent_ ? parent_->call_factory() : call_factory_.get();
+  }
+  rtc::UniqueRandomIdGenerator* ssrc_generator() {
+    return parent_ ? parent_->ssrc_generator() : &ssrc_generator_;
   }
-  rtc::UniqueRandomIdGenerator* ssrc_generator() { return &ssrc_generator_; }
   // Note: There is lots of code that wants to know whether or not we
   // use RTX, but so far, no code has been found that sets it to false.
   // Kept in the API in order to ease introduction if we want to resurrect
   // the functionality.
-  bool use_rtx() { return use_rtx_; }
+  bool use_rtx() { return parent_ ? parent_->use_rtx() : use_rtx_; }
 
   // For use by tests.
   void set_use_rtx(bool use_rtx) { use_rtx_ = use_rtx; }
 
+  // Tracks the number of PeerConnections using this context, by which the
+  // factory balances new PeerConnections over the network threads.
+  void AddPeerConnection() {
+    RTC_DCHECK_RUN_ON(signaling_thread_);
+    ++num_peer_connections_;
+  }
+  void RemovePeerConnection() {
+    RTC_DCHECK_RUN_ON(signaling_thread_);
+    RTC_DCHECK_GT(num_peer_connections_, 0);
+    --num_peer_connections_;
+  }
+  int num_peer_connections() const {
+    RTC_DCHECK_RUN_ON(signaling_thread_);
+    return num_peer_connections_;
+  }
+
  protected:
   ConnectionContext(const Environment& env,
                     PeerConnectionFactoryDependencies* dependencies);
+  explicit ConnectionContext(rtc::scoped_refptr<ConnectionContext> parent);
 
   friend class rtc::RefCountedNonVirtual<ConnectionContext>;
   ~ConnectionContext();
 
  private:
+  // Sets up thread invoke permissions and creates the default network manager
+  // and packet socket factory, if not injected.
+  void InitializeNetwork(rtc::SocketFactory* socket_factory,
+                         rtc::NetworkMonitorFactory* network_monitor_factory);
+
   // The following three variables are used to communicate between the
   // constructor and the destructor, and are never exposed externally.
   bool wraps_current_thread_;
@@ -145,6 +178,16 @@ class ConnectionContext final
   // Controls whether to announce support for the the rfc4588 payload format
   // for retransmitted video packets.
   bool use_rtx_;
+
+  // Attributes of the network threads started by this context and its network
+  // shards, from PeerConnectionFactoryDependencies::thread_policy.
+  const absl::optional<rtc::ThreadAttributes> network_thread_attributes_;
+
+  int num_peer_connections_ RTC_GUARDED_BY(signaling_thread_) = 0;
+
+  // Set for contexts created by CreateNetworkShard(). Shared resources are
+  // taken from, and kept alive by, the parent.
+  const rtc::scoped_refptr<ConnectionContext> parent_;
 };
 
 }  // namespace webrtc
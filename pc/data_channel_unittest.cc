@@ -29,6 +29,7 @@
 #include "rtc_base/null_socket_server.h"
 #include "rtc_base/ssl_stream_adapter.h"
 #include "rtc_base/thread.h"
+#include "test/gmock.h"
 #include "test/gtest.h"
 #include "test/run_loop.h"
 
@@ -40,6 +41,8 @@ namespace webrtc {
 
 namespace {
 
+using ::testing::ElementsAre;
+
 static constexpr int kDefaultTimeout = 10000;
 
 class FakeDataChannelObserver : public DataChannelObserver {
@@ -52,9 +55,13 @@ class FakeDataChannelObserver : public DataChannelObserver {
     ++on_buffered_amount_change_count_;
   }
 
-  void OnMessage(const DataBuffer& buffer) override { ++messages_received_; }
+  void OnMessage(const DataBuffer& buffer) override {
+    ++messages_received_;
+    messages_.emplace_back(buffer.data.cdata<char>(), buffer.size());
+  }
 
   size_t messages_received() const { return messages_received_; }
+  const std::vector<std::string>& messages() const { return messages_; }
 
   void ResetOnStateChangeCount() { on_state_change_count_ = 0; }
 
@@ -70,6 +77,7 @@ class FakeDataChannelObserver : public DataChannelObserver {
 
  private:
   size_t messages_received_ = 0u;
+  std::vector<std::string> messages_;
   size_t on_state_change_count_ = 0u;
   size_t on_buffered_amount_change_count_ = 0u;
 };
@@ -702,6 +710,45 @@ TEST_F(SctpDataChannelTest, ReceiveDataWithValidId) {
   EXPECT_EQ(1U, observer_->messages_received());
 }
 
+// Tests that a burst of messages received on the network thread is delivered
+// to the observer on the signaling thread, in order.
+TEST_F(SctpDataChannelTest, ReceiveBurstOfMessagesInOrder) {
+  SetChannelSid(inner_channel_, StreamId(1));
+  SetChannelReady();
+
+  AddObserver();
+
+  network_thread_.BlockingCall([&] {
+    for (const char* message : {"one", "two", "three"}) {
+      inner_channel_->OnDataReceived(DataMessageType::kText,
+                                     DataBuffer(message).data);
+    }
+  });
+  run_loop_.Flush();
+  EXPECT_THAT(observer_->messages(), ElementsAre("one", "two", "three"));
+}
+
+// Tests that messages which haven't been delivered when the observer is
+// replaced are not delivered to the new observer.
+TEST_F(SctpDataChannelTest, ReplacedObserverDoesNotGetPendingMessages) {
+  SetChannelSid(inner_channel_, StreamId(1));
+  SetChannelReady();
+
+  AddObserver();
+
+  network_thread_.BlockingCall([&] {
+    inner_channel_->OnDataReceived(DataMessageType::kText,
+                                   DataBuffer("abcd").data);
+  });
+  AddObserver();
+  network_thread_.BlockingCall([&] {
+    inner_channel_->OnDataReceived(DataMessageType::kText,
+                                   DataBuffer("efgh").data);
+  });
+  run_loop_.Flush();
+  EXPECT_THAT(observer_->messages(), ElementsAre("efgh"));
+}
+
 // Tests that no CONTROL message is sent if the datachannel is negotiated and
 // not created from an OPEN message.
 TEST_F(SctpDataChannelTest, NoMsgSentIfNegotiatedAndNotFromOpenMsg) {
@@ -56,6 +56,7 @@ struct DataChannelStats {
   uint32_t messages_received;
   uint64_t bytes_sent;
   uint64_t bytes_received;
+  uint64_t buffered_amount;
 };
 
 }  // namespace webrtc
@@ -27,8 +27,8 @@ BEGIN_PRIMARY_PROXY_MAP(AudioTrack)
 PROXY_PRIMARY_THREAD_DESTRUCTOR()
 BYPASS_PROXY_CONSTMETHOD0(std::string, kind)
 BYPASS_PROXY_CONSTMETHOD0(std::string, id)
-PROXY_CONSTMETHOD0(TrackState, state)
-PROXY_CONSTMETHOD0(bool, enabled)
+SNAPSHOT_PROXY_CONSTMETHOD0(TrackState, state)
+SNAPSHOT_PROXY_CONSTMETHOD0(bool, enabled)
 BYPASS_PROXY_CONSTMETHOD0(AudioSourceInterface*, GetSource)
 PROXY_METHOD1(void, AddSink, AudioTrackSinkInterface*)
 PROXY_METHOD1(void, RemoveSink, AudioTrackSinkInterface*)
@@ -43,8 +43,8 @@ BEGIN_PROXY_MAP(VideoTrack)
 PROXY_PRIMARY_THREAD_DESTRUCTOR()
 BYPASS_PROXY_CONSTMETHOD0(std::string, kind)
 BYPASS_PROXY_CONSTMETHOD0(std::string, id)
-PROXY_SECONDARY_CONSTMETHOD0(TrackState, state)
-PROXY_CONSTMETHOD0(bool, enabled)
+SNAPSHOT_PROXY_CONSTMETHOD0(TrackState, state)
+SNAPSHOT_PROXY_CONSTMETHOD0(bool, enabled)
 PROXY_METHOD1(bool, set_enabled, bool)
 PROXY_CONSTMETHOD0(ContentHint, content_hint)
 PROXY_METHOD1(void, set_content_hint, ContentHint)
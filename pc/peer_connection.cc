@@ -445,6 +445,7 @@ bool PeerConnectionInterface::RTCConfiguration::operator==(
     std::vector<rtc::NetworkMask> vpn_list;
     PortAllocatorConfig port_allocator_config;
     absl::optional<TimeDelta> pacer_burst_interval;
+    absl::optional<TimeDelta> ice_candidate_batch_window;
   };
   static_assert(sizeof(stuff_being_tested_for_equality) == sizeof(*this),
                 "Did you add something to RTCConfiguration and forget to "
@@ -506,7 +507,8 @@ bool PeerConnectionInterface::RTCConfiguration::operator==(
          port_allocator_config.min_port == o.port_allocator_config.min_port &&
          port_allocator_config.max_port == o.port_allocator_config.max_port &&
          port_allocator_config.flags == o.port_allocator_config.flags &&
-         pacer_burst_interval == o.pacer_burst_interval;
+         pacer_burst_interval == o.pacer_burst_interval &&
+         ice_candidate_batch_window == o.ice_candidate_batch_window;
 }
 
 bool PeerConnectionInterface::RTCConfiguration::operator!=(
@@ -535,6 +537,13 @@ RTCErrorOr<rtc::scoped_refptr<PeerConnection>> PeerConnection::Create(
     return config_error;
   }
 
+  if (configuration.ice_candidate_batch_window &&
+      (*configuration.ice_candidate_batch_window <= TimeDelta::Zero() ||
+       *configuration.ice_candidate_batch_window > TimeDelta::Seconds(1))) {
+    LOG_AND_RETURN_ERROR(RTCErrorType::INVALID_RANGE,
+                         "ice_candidate_batch_window must be in (0, 1] s.");
+  }
+
   if (!dependencies.allocator) {
     RTC_LOG(LS_ERROR)
         << "PeerConnection initialized without a PortAllocator? "
@@ -558,7 +567,7 @@ RTCErrorOr<rtc::scoped_refptr<PeerConnection>> PeerConnection::Create(
 
   if (!dependencies.async_dns_resolver_factory) {
       dependencies.async_dns_resolver_factory =
-          std::make_unique<BasicAsyncDnsResolverFactory>();
+          std::make_unique<BasicAsyncDnsResolverFactory>(env.field_trials());
   }
 
   // The PeerConnection constructor consumes some, but not all, dependencies.
@@ -602,11 +611,13 @@ PeerConnection::PeerConnection(
       // LLONG_MAX.
       session_id_(rtc::ToString(rtc::CreateRandomId64() & LLONG_MAX)),
       dtls_enabled_(dtls_enabled),
+      setup_timeline_(env_.clock().CurrentTime()),
       data_channel_controller_(this),
       message_handler_(signaling_thread()),
       weak_factory_(this) {
   // Field trials specific to the peerconnection should be owned by the `env`,
   RTC_DCHECK(dependencies.trials == nullptr);
+  context_->AddPeerConnection();
 }
 
 PeerConnection::~PeerConnection() {
@@ -666,6 +677,7 @@ PeerConnection::~PeerConnection() {
   });
 
   data_channel_controller_.PrepareForShutdown();
+  context_->RemovePeerConnection();
 }
 
 RTCError PeerConnection::Initialize(
@@ -774,6 +786,7 @@ JsepTransportController* PeerConnection::InitializeTransportController_n(
       };
 
   config.field_trials = &env_.field_trials();
+  ice_candidate_batch_window_ = configuration.ice_candidate_batch_window;
 
   transport_controller_.reset(new JsepTransportController(
       network_thread(), port_allocator_.get(),
@@ -809,6 +822,7 @@ JsepTransportController* PeerConnection::InitializeTransportController_n(
   transport_controller_->SubscribeIceGatheringState(
       [this](cricket::IceGatheringState s) {
         RTC_DCHECK_RUN_ON(network_thread());
+        FlushGatheredCandidates_n();
         signaling_thread()->PostTask(
             SafeTask(signaling_thread_safety_.flag(), [this, s]() {
               RTC_DCHECK_RUN_ON(signaling_thread());
@@ -819,6 +833,10 @@ JsepTransportController* PeerConnection::InitializeTransportController_n(
       [this](const std::string& transport,
              const std::vector<cricket::Candidate>& candidates) {
         RTC_DCHECK_RUN_ON(network_thread());
+        if (ice_candidate_batch_window_) {
+          BatchGatheredCandidates_n(transport, candidates);
+          return;
+        }
         signaling_thread()->PostTask(
             SafeTask(signaling_thread_safety_.flag(),
                      [this, t = transport, c = candidates]() {
@@ -838,6 +856,7 @@ JsepTransportController* PeerConnection::InitializeTransportController_n(
   transport_controller_->SubscribeIceCandidatesRemoved(
       [this](const std::vector<cricket::Candidate>& c) {
         RTC_DCHECK_RUN_ON(network_thread());
+        FlushGatheredCandidates_n();
         signaling_thread()->PostTask(
             SafeTask(signaling_thread_safety_.flag(), [this, c = c]() {
               RTC_DCHECK_RUN_ON(signaling_thread());
@@ -1383,6 +1402,19 @@ void PeerConnection::GetStats(
   RTC_DCHECK_BLOCK_COUNT_NO_MORE_THAN(2);
 }
 
+void PeerConnection::GetStats(
+    const StatsRequest& request,
+    rtc::scoped_refptr<RTCStatsCollectorCallback> callback) {
+  TRACE_EVENT0("webrtc", "PeerConnection::GetStats");
+  RTC_DCHECK_RUN_ON(signaling_thread());
+  RTC_DCHECK(callback);
+  RTC_DCHECK(stats_collector_);
+  RTC_LOG_THREAD_BLOCK_COUNT();
+  stats_collector_->GetStatsReport(request.types, request.unchanged_since,
+                                   std::move(callback));
+  RTC_DCHECK_BLOCK_COUNT_NO_MORE_THAN(2);
+}
+
 PeerConnectionInterface::SignalingState PeerConnection::signaling_state() {
   RTC_DCHECK_RUN_ON(signaling_thread());
   return sdp_handler_->signaling_state();
@@ -1674,6 +1706,16 @@ RTCError PeerConnection::SetBitrate(const BitrateSettings& bitrate) {
                            "max_bitrate_bps < 0");
     }
   }
+  if (bitrate.capacity_hint_bps.has_value()) {
+    if (*bitrate.capacity_hint_bps <= 0) {
+      LOG_AND_RETURN_ERROR(RTCErrorType::INVALID_PARAMETER,
+                           "capacity_hint_bps <= 0");
+    } else if (!(bitrate.capacity_hint_confidence > 0 &&
+                 bitrate.capacity_hint_confidence <= 1)) {
+      LOG_AND_RETURN_ERROR(RTCErrorType::INVALID_PARAMETER,
+                           "capacity_hint_confidence not in (0, 1]");
+    }
+  }
 
   RTC_DCHECK(call_.get());
   call_->SetClientBitratePreferences(bitrate);
@@ -1931,6 +1973,9 @@ void PeerConnection::SetStandardizedIceConnectionState(
                    << standardized_ice_connection_state_ << " => " << new_state;
 
   standardized_ice_connection_state_ = new_state;
+  if (new_state == kIceConnectionConnected) {
+    NoteSetupPhase(SetupPhase::kIceConnected);
+  }
   Observer()->OnStandardizedIceConnectionChange(new_state);
 }
 
@@ -1941,6 +1986,9 @@ void PeerConnection::SetConnectionState(
   if (IsClosed())
     return;
   connection_state_ = new_state;
+  if (new_state == PeerConnectionState::kConnected) {
+    NoteSetupPhase(SetupPhase::kConnected);
+  }
   Observer()->OnConnectionChange(new_state);
 
   // The first connection state change to connected happens once per
@@ -2029,6 +2077,9 @@ void PeerConnection::OnIceGatheringChange(
     return;
   }
   ice_gathering_state_ = new_state;
+  if (new_state == kIceGatheringComplete) {
+    NoteSetupPhase(SetupPhase::kIceGatheringComplete);
+  }
   Observer()->OnIceGatheringChange(ice_gathering_state_);
 }
 
@@ -2038,6 +2089,7 @@ void PeerConnection::OnIceCandidate(
     return;
   }
   ReportIceCandidateCollected(candidate->candidate());
+  NoteSetupPhase(SetupPhase::kFirstCandidateGathered);
   ClearStatsCache();
   Observer()->OnIceCandidate(candidate.get());
 }
@@ -2424,6 +2476,75 @@ void PeerConnection::OnTransportControllerCandidatesGathered(
   }
 }
 
+void PeerConnection::OnTransportControllerCandidatesBatchGathered(
+    const std::vector<std::pair<std::string, cricket::Candidates>>& batch) {
+  std::vector<std::unique_ptr<IceCandidateInterface>> candidates;
+  for (const auto& [transport_name, transport_candidates] : batch) {
+    int sdp_mline_index;
+    if (!GetLocalCandidateMediaIndex(transport_name, &sdp_mline_index)) {
+      RTC_LOG(LS_ERROR)
+          << "OnTransportControllerCandidatesBatchGathered: content name "
+          << transport_name << " not found";
+      continue;
+    }
+    for (const cricket::Candidate& transport_candidate :
+         transport_candidates) {
+      // Use transport_name as the candidate media id.
+      auto candidate = std::make_unique<JsepIceCandidate>(
+          transport_name, sdp_mline_index, transport_candidate);
+      sdp_handler_->AddLocalIceCandidate(candidate.get());
+      candidates.push_back(std::move(candidate));
+    }
+  }
+  if (candidates.empty() || IsClosed()) {
+    return;
+  }
+
+  std::vector<const IceCandidateInterface*> observed_candidates;
+  observed_candidates.reserve(candidates.size());
+  for (const std::unique_ptr<IceCandidateInterface>& candidate : candidates) {
+    ReportIceCandidateCollected(candidate->candidate());
+    observed_candidates.push_back(candidate.get());
+  }
+  NoteSetupPhase(SetupPhase::kFirstCandidateGathered);
+  ClearStatsCache();
+  Observer()->OnIceCandidatesBatch(observed_candidates);
+}
+
+void PeerConnection::BatchGatheredCandidates_n(
+    const std::string& transport_name,
+    const cricket::Candidates& candidates) {
+  if (pending_gathered_candidates_.empty()) {
+    network_thread()->PostDelayedTask(
+        SafeTask(network_thread_safety_,
+                 [this] {
+                   RTC_DCHECK_RUN_ON(network_thread());
+                   FlushGatheredCandidates_n();
+                 }),
+        *ice_candidate_batch_window_);
+  }
+  if (!pending_gathered_candidates_.empty() &&
+      pending_gathered_candidates_.back().first == transport_name) {
+    cricket::Candidates& pending = pending_gathered_candidates_.back().second;
+    pending.insert(pending.end(), candidates.begin(), candidates.end());
+  } else {
+    pending_gathered_candidates_.emplace_back(transport_name, candidates);
+  }
+}
+
+void PeerConnection::FlushGatheredCandidates_n() {
+  if (pending_gathered_candidates_.empty()) {
+    return;
+  }
+  signaling_thread()->PostTask(SafeTask(
+      signaling_thread_safety_.flag(),
+      [this, batch = std::move(pending_gathered_candidates_)]() {
+        RTC_DCHECK_RUN_ON(signaling_thread());
+        OnTransportControllerCandidatesBatchGathered(batch);
+      }));
+  pending_gathered_candidates_.clear();
+}
+
 void PeerConnection::OnTransportControllerCandidateError(
     const cricket::IceCandidateErrorEvent& event) {
   OnIceCandidateError(event.address, event.port, event.url, event.error_code,
@@ -2627,6 +2748,16 @@ void PeerConnection::NoteUsageEvent(UsageEvent event) {
   usage_pattern_.NoteUsageEvent(event);
 }
 
+void PeerConnection::NoteSetupPhase(SetupPhase phase) {
+  RTC_DCHECK_RUN_ON(signaling_thread());
+  setup_timeline_.NoteSetupPhase(phase, env_.clock().CurrentTime());
+}
+
+std::map<SetupPhase, TimeDelta> PeerConnection::GetSetupTimeline() const {
+  RTC_DCHECK_RUN_ON(signaling_thread());
+  return setup_timeline_.delays();
+}
+
 // Asynchronously adds remote candidates on the network thread.
 void PeerConnection::AddRemoteCandidate(const std::string& mid,
                                         const cricket::Candidate& candidate) {
@@ -18,6 +18,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "absl/types/optional.h"
@@ -51,6 +52,7 @@
 #include "api/transport/data_channel_transport_interface.h"
 #include "api/transport/enums.h"
 #include "api/turn_customizer.h"
+#include "api/units/time_delta.h"
 #include "call/call.h"
 #include "modules/rtp_rtcp/source/rtp_packet_received.h"
 #include "p2p/base/ice_transport_internal.h"
@@ -75,6 +77,7 @@
 #include "pc/session_description.h"
 #include "pc/transceiver_list.h"
 #include "pc/transport_stats.h"
+#include "pc/setup_timeline.h"
 #include "pc/usage_pattern.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/copy_on_write_buffer.h"
@@ -174,6 +177,9 @@ class PeerConnection : public PeerConnectionInternal,
   void GetStats(
       rtc::scoped_refptr<RtpReceiverInterface> selector,
       rtc::scoped_refptr<RTCStatsCollectorCallback> callback) override;
+  void GetStats(
+      const StatsRequest& request,
+      rtc::scoped_refptr<RTCStatsCollectorCallback> callback) override;
   void ClearStatsCache() override;
 
   SignalingState signaling_state() override;
@@ -285,6 +291,7 @@ class PeerConnection : public PeerConnectionInternal,
   }
 
   std::vector<DataChannelStats> GetDataChannelStats() const override;
+  std::map<SetupPhase, TimeDelta> GetSetupTimeline() const override;
 
   absl::optional<std::string> sctp_transport_name() const override;
   absl::optional<std::string> sctp_mid() const override;
@@ -370,6 +377,7 @@ class PeerConnection : public PeerConnectionInternal,
   }
   void SetIceConnectionState(IceConnectionState new_state) override;
   void NoteUsageEvent(UsageEvent event) override;
+  void NoteSetupPhase(SetupPhase phase) override;
 
   // Asynchronously adds a remote candidate on the network thread.
   void AddRemoteCandidate(const std::string& mid,
@@ -546,6 +554,16 @@ class PeerConnection : public PeerConnectionInternal,
       const std::string& transport_name,
       const std::vector<cricket::Candidate>& candidates)
       RTC_RUN_ON(signaling_thread());
+  void OnTransportControllerCandidatesBatchGathered(
+      const std::vector<std::pair<std::string, cricket::Candidates>>& batch)
+      RTC_RUN_ON(signaling_thread());
+  // Adds gathered candidates to the pending batch, see
+  // RTCConfiguration::ice_candidate_batch_window.
+  void BatchGatheredCandidates_n(const std::string& transport_name,
+                                 const cricket::Candidates& candidates)
+      RTC_RUN_ON(network_thread());
+  // Delivers the pending batch of gathered candidates, if any.
+  void FlushGatheredCandidates_n() RTC_RUN_ON(network_thread());
   void OnTransportControllerCandidateError(
       const cricket::IceCandidateErrorEvent& event)
       RTC_RUN_ON(signaling_thread());
@@ -669,6 +687,13 @@ class PeerConnection : public PeerConnectionInternal,
   // thread, but applied first on the networking thread via an invoke().
   absl::optional<std::string> sctp_mid_s_ RTC_GUARDED_BY(signaling_thread());
   absl::optional<std::string> sctp_mid_n_ RTC_GUARDED_BY(network_thread());
+
+  absl::optional<TimeDelta> ice_candidate_batch_window_
+      RTC_GUARDED_BY(network_thread());
+  // Candidates gathered within the current ice_candidate_batch_window, by
+  // transport name, in the order they were gathered.
+  std::vector<std::pair<std::string, cricket::Candidates>>
+      pending_gathered_candidates_ RTC_GUARDED_BY(network_thread());
   std::string sctp_transport_name_s_ RTC_GUARDED_BY(signaling_thread());
 
   // The machinery for handling offers and answers. Const after initialization.
@@ -678,6 +703,7 @@ class PeerConnection : public PeerConnectionInternal,
   const bool dtls_enabled_;
 
   UsagePattern usage_pattern_ RTC_GUARDED_BY(signaling_thread());
+  SetupTimeline setup_timeline_ RTC_GUARDED_BY(signaling_thread());
   bool return_histogram_very_quickly_ RTC_GUARDED_BY(signaling_thread()) =
       false;
 
@@ -22,9 +22,12 @@
 #include "api/packet_socket_factory.h"
 #include "api/rtc_event_log/rtc_event_log.h"
 #include "api/sequence_checker.h"
+#include "api/task_queue/default_task_queue_factory.h"
+#include "api/thread_policy.h"
 #include "api/transport/bitrate_settings.h"
 #include "api/units/data_rate.h"
 #include "call/audio_state.h"
+#include "call/network_route_estimate_cache.h"
 #include "call/rtp_transport_controller_send_factory.h"
 #include "media/base/media_engine.h"
 #include "p2p/base/basic_packet_socket_factory.h"
@@ -50,9 +53,34 @@
 #include "rtc_base/numerics/safe_conversions.h"
 #include "rtc_base/rtc_certificate_generator.h"
 #include "rtc_base/system/file_wrapper.h"
+#include "rtc_base/task_queue_thread_pool.h"
 
 namespace webrtc {
 
+namespace {
+
+Environment CreateFactoryEnvironment(
+    PeerConnectionFactoryDependencies& dependencies) {
+  if (!dependencies.task_queue_factory &&
+      dependencies.num_task_queue_threads > 0) {
+    dependencies.task_queue_factory =
+        CreateTaskQueueThreadPoolFactory(dependencies.num_task_queue_threads);
+  } else if (dependencies.thread_policy.video_encoder ||
+             dependencies.thread_policy.video_decoder ||
+             dependencies.thread_policy.audio) {
+    if (!dependencies.task_queue_factory) {
+      dependencies.task_queue_factory =
+          CreateDefaultTaskQueueFactory(dependencies.trials.get());
+    }
+    dependencies.task_queue_factory = CreateThreadPolicyTaskQueueFactory(
+        std::move(dependencies.task_queue_factory), dependencies.thread_policy);
+  }
+  return CreateEnvironment(std::move(dependencies.trials),
+                           std::move(dependencies.task_queue_factory));
+}
+
+}  // namespace
+
 rtc::scoped_refptr<PeerConnectionFactoryInterface>
 CreateModularPeerConnectionFactory(
     PeerConnectionFactoryDependencies dependencies) {
@@ -79,9 +107,7 @@ CreateModularPeerConnectionFactory(
 rtc::scoped_refptr<PeerConnectionFactory> PeerConnectionFactory::Create(
     PeerConnectionFactoryDependencies dependencies) {
   auto context = ConnectionContext::Create(
-      CreateEnvironment(std::move(dependencies.trials),
-                        std::move(dependencies.task_queue_factory)),
-      &dependencies);
+      CreateFactoryEnvironment(dependencies), &dependencies);
   if (!context) {
     return nullptr;
   }
@@ -104,15 +130,21 @@ PeerConnectionFactory::PeerConnectionFactory(
               ? std::move(dependencies->transport_controller_send_factory)
               : std::make_unique<RtpTransportControllerSendFactory>()),
       decode_metronome_(std::move(dependencies->decode_metronome)),
-      encode_metronome_(std::move(dependencies->encode_metronome)) {}
+      encode_metronome_(std::move(dependencies->encode_metronome)),
+      pacer_metronome_(std::move(dependencies->pacer_metronome)),
+      route_estimate_cache_(NetworkRouteEstimateCache::CreateFromFieldTrials(
+          context_->env().field_trials())) {
+  RTC_DCHECK_RUN_ON(signaling_thread());
+  for (int i = 1; i < dependencies->num_network_threads; ++i) {
+    network_shards_.push_back(ConnectionContext::CreateNetworkShard(context_));
+  }
+}
 
 PeerConnectionFactory::PeerConnectionFactory(
     PeerConnectionFactoryDependencies dependencies)
     : PeerConnectionFactory(
-          ConnectionContext::Create(
-              CreateEnvironment(std::move(dependencies.trials),
-                                std::move(dependencies.task_queue_factory)),
-              &dependencies),
+          ConnectionContext::Create(CreateFactoryEnvironment(dependencies),
+                                    &dependencies),
           &dependencies) {}
 
 PeerConnectionFactory::~PeerConnectionFactory() {
@@ -121,11 +153,24 @@ PeerConnectionFactory::~PeerConnectionFactory() {
     RTC_DCHECK_RUN_ON(worker_thread());
     decode_metronome_ = nullptr;
     encode_metronome_ = nullptr;
+    pacer_metronome_ = nullptr;
   });
 }
 
 void PeerConnectionFactory::SetOptions(const Options& options) {
   RTC_DCHECK_RUN_ON(signaling_thread());
+  if (options.certificate_pool_size != options_.certificate_pool_size ||
+      options.certificate_pool_max_age != options_.certificate_pool_max_age) {
+    // The PeerConnections created before keep the previous pool, if any.
+    certificate_pool_ = nullptr;
+    if (options.certificate_pool_size > 0) {
+      rtc::RTCCertificatePool::Config config;
+      config.size = options.certificate_pool_size;
+      config.max_age = options.certificate_pool_max_age;
+      certificate_pool_ =
+          rtc::make_ref_counted<rtc::RTCCertificatePool>(config);
+    }
+  }
   options_ = options;
 }
 
@@ -230,15 +275,18 @@ PeerConnectionFactory::CreatePeerConnectionOrError(
 
   const Environment env = env_factory.Create();
 
+  rtc::scoped_refptr<ConnectionContext> context = NextNetworkContext();
+  rtc::Thread* const network_thread = context->network_thread();
+
   // Set internal defaults if optional dependencies are not set.
   if (!dependencies.cert_generator) {
     dependencies.cert_generator =
-        std::make_unique<rtc::RTCCertificateGenerator>(signaling_thread(),
-                                                       network_thread());
+        std::make_unique<rtc::RTCCertificateGenerator>(
+            signaling_thread(), network_thread, certificate_pool_);
   }
   if (!dependencies.allocator) {
     dependencies.allocator = std::make_unique<cricket::BasicPortAllocator>(
-        context_->default_network_manager(), context_->default_socket_factory(),
+        context->default_network_manager(), context->default_socket_factory(),
         configuration.turn_customizer, /*relay_port_factory=*/nullptr,
         &env.field_trials());
     dependencies.allocator->SetPortRange(
@@ -257,11 +305,12 @@ PeerConnectionFactory::CreatePeerConnectionOrError(
   dependencies.allocator->SetVpnList(configuration.vpn_list);
 
   std::unique_ptr<Call> call =
-      worker_thread()->BlockingCall([this, &env, &configuration] {
-        return CreateCall_w(env, configuration);
+      worker_thread()->BlockingCall([this, &env, &configuration,
+                                     network_thread] {
+        return CreateCall_w(env, configuration, network_thread);
       });
 
-  auto result = PeerConnection::Create(env, context_, options_, std::move(call),
+  auto result = PeerConnection::Create(env, context, options_, std::move(call),
                                        configuration, std::move(dependencies));
   if (!result.ok()) {
     return result.MoveError();
@@ -273,11 +322,23 @@ PeerConnectionFactory::CreatePeerConnectionOrError(
   // worker_thread()).  All such methods have thread checks though, so the code
   // should still be clear (outside of macro expansion).
   rtc::scoped_refptr<PeerConnectionInterface> result_proxy =
-      PeerConnectionProxy::Create(signaling_thread(), network_thread(),
+      PeerConnectionProxy::Create(signaling_thread(), network_thread,
                                   result.MoveValue());
   return result_proxy;
 }
 
+rtc::scoped_refptr<ConnectionContext>
+PeerConnectionFactory::NextNetworkContext() {
+  RTC_DCHECK_RUN_ON(signaling_thread());
+  rtc::scoped_refptr<ConnectionContext> context = context_;
+  for (const auto& shard : network_shards_) {
+    if (shard->num_peer_connections() < context->num_peer_connections()) {
+      context = shard;
+    }
+  }
+  return context;
+}
+
 rtc::scoped_refptr<MediaStreamInterface>
 PeerConnectionFactory::CreateLocalMediaStream(const std::string& stream_id) {
   RTC_DCHECK(signaling_thread()->IsCurrent());
@@ -305,10 +366,11 @@ rtc::scoped_refptr<AudioTrackInterface> PeerConnectionFactory::CreateAudioTrack(
 
 std::unique_ptr<Call> PeerConnectionFactory::CreateCall_w(
     const Environment& env,
-    const PeerConnectionInterface::RTCConfiguration& configuration) {
+    const PeerConnectionInterface::RTCConfiguration& configuration,
+    rtc::Thread* network_thread) {
   RTC_DCHECK_RUN_ON(worker_thread());
 
-  CallConfig call_config(env, network_thread());
+  CallConfig call_config(env, network_thread);
   if (!media_engine() || !context_->call_factory()) {
     return nullptr;
   }
@@ -347,6 +409,8 @@ std::unique_ptr<Call> PeerConnectionFactory::CreateCall_w(
       transport_controller_send_factory_.get();
   call_config.decode_metronome = decode_metronome_.get();
   call_config.encode_metronome = encode_metronome_.get();
+  call_config.pacer_metronome = pacer_metronome_.get();
+  call_config.route_estimate_cache = route_estimate_cache_.get();
   call_config.pacer_burst_interval = configuration.pacer_burst_interval;
   return context_->call_factory()->CreateCall(call_config);
 }
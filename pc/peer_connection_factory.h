@@ -17,6 +17,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "absl/strings/string_view.h"
 #include "api/audio_options.h"
@@ -36,11 +37,13 @@
 #include "api/transport/network_control.h"
 #include "api/transport/sctp_transport_factory_interface.h"
 #include "call/call.h"
+#include "call/network_route_estimate_cache.h"
 #include "call/rtp_transport_controller_send_factory_interface.h"
 #include "p2p/base/port_allocator.h"
 #include "pc/connection_context.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/rtc_certificate_generator.h"
+#include "rtc_base/rtc_certificate_pool.h"
 #include "rtc_base/thread.h"
 #include "rtc_base/thread_annotations.h"
 
@@ -108,6 +111,13 @@ class PeerConnectionFactory : public PeerConnectionFactoryInterface {
     return options_;
   }
 
+  // The pool of the certificates generated ahead of time, if enabled with
+  // `Options::certificate_pool_size`.
+  rtc::RTCCertificatePool* certificate_pool() const {
+    RTC_DCHECK_RUN_ON(signaling_thread());
+    return certificate_pool_.get();
+  }
+
   const FieldTrialsView& field_trials() const {
     return context_->env().field_trials();
   }
@@ -127,17 +137,26 @@ class PeerConnectionFactory : public PeerConnectionFactoryInterface {
   virtual ~PeerConnectionFactory();
 
  private:
-  rtc::Thread* network_thread() const { return context_->network_thread(); }
-
   bool IsTrialEnabled(absl::string_view key) const;
 
+  // Returns the context of the network thread the next PeerConnection should
+  // be created on, i.e. the one with the fewest PeerConnections.
+  rtc::scoped_refptr<ConnectionContext> NextNetworkContext();
+
   std::unique_ptr<Call> CreateCall_w(
       const Environment& env,
-      const PeerConnectionInterface::RTCConfiguration& configuration);
+      const PeerConnectionInterface::RTCConfiguration& configuration,
+      rtc::Thread* network_thread);
 
   rtc::scoped_refptr<ConnectionContext> context_;
+  // Additional contexts, each with its own network thread, created when
+  // `num_network_threads` is larger than one.
+  std::vector<rtc::scoped_refptr<ConnectionContext>> network_shards_
+      RTC_GUARDED_BY(signaling_thread());
   PeerConnectionFactoryInterface::Options options_
       RTC_GUARDED_BY(signaling_thread());
+  rtc::scoped_refptr<rtc::RTCCertificatePool> certificate_pool_
+      RTC_GUARDED_BY(signaling_thread());
   std::unique_ptr<RtcEventLogFactoryInterface> event_log_factory_;
   std::unique_ptr<FecControllerFactoryInterface> fec_controller_factory_;
   std::unique_ptr<NetworkStatePredictorFactoryInterface>
@@ -149,6 +168,10 @@ class PeerConnectionFactory : public PeerConnectionFactoryInterface {
       transport_controller_send_factory_;
   std::unique_ptr<Metronome> decode_metronome_ RTC_GUARDED_BY(worker_thread());
   std::unique_ptr<Metronome> encode_metronome_ RTC_GUARDED_BY(worker_thread());
+  std::unique_ptr<Metronome> pacer_metronome_ RTC_GUARDED_BY(worker_thread());
+  // Shared by all calls created by the factory, null unless enabled by field
+  // trial.
+  const std::unique_ptr<NetworkRouteEstimateCache> route_estimate_cache_;
 };
 
 }  // namespace webrtc
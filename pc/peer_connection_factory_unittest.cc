@@ -720,5 +720,65 @@ TEST(PeerConnectionFactoryDependenciesTest, UsesPacketSocketFactory) {
   called.Wait(kWaitTimeout);
 }
 
+TEST(PeerConnectionFactoryDependenciesTest,
+     CreatesPeerConnectionsOnMultipleNetworkThreads) {
+  constexpr TimeDelta kWaitTimeout = TimeDelta::Seconds(10);
+  auto mock_network_manager = std::make_unique<NiceMock<MockNetworkManager>>();
+
+  rtc::Event called;
+  EXPECT_CALL(*mock_network_manager, StartUpdating())
+      .Times(AtLeast(1))
+      .WillRepeatedly(InvokeWithoutArgs([&] { called.Set(); }));
+
+  PeerConnectionFactoryDependencies pcf_dependencies;
+  pcf_dependencies.network_manager = std::move(mock_network_manager);
+  pcf_dependencies.num_network_threads = 2;
+
+  rtc::scoped_refptr<PeerConnectionFactoryInterface> pcf =
+      CreateModularPeerConnectionFactory(std::move(pcf_dependencies));
+
+  PeerConnectionInterface::RTCConfiguration config;
+  config.ice_candidate_pool_size = 2;
+  NullPeerConnectionObserver observer;
+  // The first PeerConnection is placed on the primary network thread, which
+  // uses the injected network manager; the following ones go to the network
+  // thread with the fewest PeerConnections, alternating between the additional
+  // and the primary network thread.
+  std::vector<rtc::scoped_refptr<PeerConnectionInterface>> pcs;
+  for (int i = 0; i < 3; ++i) {
+    auto pc = pcf->CreatePeerConnectionOrError(
+        config, PeerConnectionDependencies(&observer));
+    ASSERT_TRUE(pc.ok());
+    pcs.push_back(pc.MoveValue());
+  }
+
+  called.Wait(kWaitTimeout);
+  for (auto& pc : pcs) {
+    pc->Close();
+  }
+}
+
+TEST(PeerConnectionFactoryDependenciesTest,
+     CreatesPeerConnectionsWithPooledTaskQueues) {
+  PeerConnectionFactoryDependencies pcf_dependencies;
+  pcf_dependencies.num_task_queue_threads = 2;
+
+  rtc::scoped_refptr<PeerConnectionFactoryInterface> pcf =
+      CreateModularPeerConnectionFactory(std::move(pcf_dependencies));
+
+  PeerConnectionInterface::RTCConfiguration config;
+  NullPeerConnectionObserver observer;
+  std::vector<rtc::scoped_refptr<PeerConnectionInterface>> pcs;
+  for (int i = 0; i < 3; ++i) {
+    auto pc = pcf->CreatePeerConnectionOrError(
+        config, PeerConnectionDependencies(&observer));
+    ASSERT_TRUE(pc.ok());
+    pcs.push_back(pc.MoveValue());
+  }
+  for (auto& pc : pcs) {
+    pc->Close();
+  }
+}
+
 }  // namespace
 }  // namespace webrtc
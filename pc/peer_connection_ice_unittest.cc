@@ -27,6 +27,7 @@
 #include "api/peer_connection_interface.h"
 #include "api/rtc_error.h"
 #include "api/scoped_refptr.h"
+#include "api/units/time_delta.h"
 #include "modules/audio_device/include/audio_device.h"
 #include "modules/audio_processing/include/audio_processing.h"
 #include "p2p/base/fake_port_allocator.h"
@@ -730,6 +731,38 @@ TEST_P(PeerConnectionIceTest, CandidatesGeneratedForEachLocalInterface) {
   EXPECT_PRED_FORMAT2(AssertIpInCandidates, kLocalAddress2, candidates);
 }
 
+TEST_P(PeerConnectionIceTest, CandidatesGatheredWithinBatchWindowAreBatched) {
+  const SocketAddress kLocalAddress1("1.1.1.1", 0);
+  const SocketAddress kLocalAddress2("2.2.2.2", 0);
+
+  RTCConfiguration config;
+  config.ice_candidate_batch_window = TimeDelta::Seconds(1);
+  auto caller = CreatePeerConnectionWithAudioVideo(config);
+  caller->network()->AddInterface(kLocalAddress1);
+  caller->network()->AddInterface(kLocalAddress2);
+
+  caller->CreateOfferAndSetAsLocal();
+  EXPECT_TRUE_WAIT(caller->IsIceGatheringDone(), kIceCandidatesTimeout);
+
+  // The pending batch is delivered before gathering completes.
+  auto candidates = caller->observer()->GetCandidatesByMline(0);
+  EXPECT_PRED_FORMAT2(AssertIpInCandidates, kLocalAddress1, candidates);
+  EXPECT_PRED_FORMAT2(AssertIpInCandidates, kLocalAddress2, candidates);
+  EXPECT_LT(0u, caller->observer()->GetCandidatesByMline(1).size());
+  EXPECT_LT(caller->observer()->num_candidate_batches_,
+            static_cast<int>(caller->observer()->GetAllCandidates().size()));
+  auto offer = caller->CreateOffer();
+  EXPECT_EQ(candidates.size(), offer->candidates(0)->count());
+}
+
+TEST_P(PeerConnectionIceTest, CandidateBatchWindowOutOfRangeFails) {
+  RTCConfiguration config;
+  config.ice_candidate_batch_window = TimeDelta::Zero();
+  EXPECT_FALSE(CreatePeerConnection(config));
+  config.ice_candidate_batch_window = TimeDelta::Seconds(2);
+  EXPECT_FALSE(CreatePeerConnection(config));
+}
+
 TEST_P(PeerConnectionIceTest, TrickledSingleCandidateAddedToRemoteDescription) {
   const SocketAddress kCallerAddress("1.1.1.1", 1111);
 
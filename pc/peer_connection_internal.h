@@ -19,6 +19,7 @@
 
 #include "absl/types/optional.h"
 #include "api/peer_connection_interface.h"
+#include "api/units/time_delta.h"
 #include "call/call.h"
 #include "modules/audio_device/include/audio_device.h"
 #include "pc/jsep_transport_controller.h"
@@ -26,6 +27,7 @@
 #include "pc/rtp_transceiver.h"
 #include "pc/rtp_transmission_manager.h"
 #include "pc/sctp_data_channel.h"
+#include "pc/setup_timeline.h"
 
 namespace webrtc {
 
@@ -82,6 +84,7 @@ class PeerConnectionSdpMethods {
   virtual void SetIceConnectionState(
       PeerConnectionInterface::IceConnectionState new_state) = 0;
   virtual void NoteUsageEvent(UsageEvent event) = 0;
+  virtual void NoteSetupPhase(SetupPhase phase) = 0;
   virtual bool IsClosed() const = 0;
   // Returns true if the PeerConnection is configured to use Unified Plan
   // semantics for creating offers/answers and setting local/remote
@@ -150,6 +153,12 @@ class PeerConnectionInternal : public PeerConnectionInterface,
     return {};
   }
 
+  // Returns the time from creation until each setup phase that has been
+  // reached.
+  virtual std::map<SetupPhase, TimeDelta> GetSetupTimeline() const {
+    return {};
+  }
+
   virtual absl::optional<std::string> sctp_transport_name() const = 0;
 
   virtual cricket::CandidateStatsList GetPooledCandidateStats() const = 0;
@@ -82,6 +82,10 @@ PROXY_METHOD2(void,
               GetStats,
               rtc::scoped_refptr<RtpReceiverInterface>,
               rtc::scoped_refptr<RTCStatsCollectorCallback>)
+PROXY_METHOD2(void,
+              GetStats,
+              const StatsRequest&,
+              rtc::scoped_refptr<RTCStatsCollectorCallback>)
 PROXY_METHOD0(void, ClearStatsCache)
 PROXY_METHOD2(RTCErrorOr<rtc::scoped_refptr<DataChannelInterface>>,
               CreateDataChannelOrError,
@@ -52,6 +52,10 @@
 // The variant defined with BEGIN_PRIMARY_PROXY_MAP is unaware of
 // the secondary thread, and invokes all methods on the primary thread.
 //
+// Getters of state that never changes, or that the implementation keeps
+// readable from any thread, don't need a thread hop and can use
+// BYPASS_PROXY_CONSTMETHOD0 or SNAPSHOT_PROXY_CONSTMETHOD0 respectively.
+//
 
 #ifndef PC_PROXY_H_
 #define PC_PROXY_H_
@@ -469,6 +473,15 @@ class ConstMethodCall {
     TRACE_BOILERPLATE(method);               \
     return c_->method();                     \
   }
+// For use when returning state that may change, but that the implementation
+// keeps as a snapshot that is safe to read from any thread, e.g. an atomic or
+// a lock protected copy. The value may be stale by the time it is used, so
+// only use this for getters where that is acceptable, e.g. to display it.
+#define SNAPSHOT_PROXY_CONSTMETHOD0(r, method) \
+  r method() const override {                  \
+    TRACE_BOILERPLATE(method);                 \
+    return c_->method();                       \
+  }
 // Allows a custom implementation of a method where the otherwise proxied
 // implementation can do a more efficient, yet thread-safe, job than the proxy
 // can do by default or when more flexibility is needed than can be provided
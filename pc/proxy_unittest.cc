@@ -32,6 +32,7 @@ class FakeInterface : public rtc::RefCountInterface {
   virtual void VoidMethod0() = 0;
   virtual std::string Method0() = 0;
   virtual std::string ConstMethod0() const = 0;
+  virtual std::string SnapshotMethod0() const = 0;
   virtual std::string Method1(std::string s) = 0;
   virtual std::string ConstMethod1(std::string s) const = 0;
   virtual std::string Method2(std::string s1, std::string s2) = 0;
@@ -52,6 +53,7 @@ class Fake : public FakeInterface {
   MOCK_METHOD(void, VoidMethod0, (), (override));
   MOCK_METHOD(std::string, Method0, (), (override));
   MOCK_METHOD(std::string, ConstMethod0, (), (const, override));
+  MOCK_METHOD(std::string, SnapshotMethod0, (), (const, override));
 
   MOCK_METHOD(std::string, Method1, (std::string), (override));
   MOCK_METHOD(std::string, ConstMethod1, (std::string), (const, override));
@@ -69,6 +71,7 @@ PROXY_SECONDARY_THREAD_DESTRUCTOR()
 PROXY_METHOD0(void, VoidMethod0)
 PROXY_METHOD0(std::string, Method0)
 PROXY_CONSTMETHOD0(std::string, ConstMethod0)
+SNAPSHOT_PROXY_CONSTMETHOD0(std::string, SnapshotMethod0)
 PROXY_SECONDARY_METHOD1(std::string, Method1, std::string)
 PROXY_CONSTMETHOD1(std::string, ConstMethod1, std::string)
 PROXY_SECONDARY_METHOD2(std::string, Method2, std::string, std::string)
@@ -82,6 +85,7 @@ PROXY_PRIMARY_THREAD_DESTRUCTOR()
 PROXY_METHOD0(void, VoidMethod0)
 PROXY_METHOD0(std::string, Method0)
 PROXY_CONSTMETHOD0(std::string, ConstMethod0)
+SNAPSHOT_PROXY_CONSTMETHOD0(std::string, SnapshotMethod0)
 PROXY_METHOD1(std::string, Method1, std::string)
 PROXY_CONSTMETHOD1(std::string, ConstMethod1, std::string)
 PROXY_METHOD2(std::string, Method2, std::string, std::string)
@@ -143,6 +147,16 @@ TEST_F(SignalingProxyTest, ConstMethod0) {
   EXPECT_EQ("ConstMethod0", fake_signaling_proxy_->ConstMethod0());
 }
 
+TEST_F(SignalingProxyTest, SnapshotMethod0IsCalledOnTheCallingThread) {
+  EXPECT_CALL(*fake_, SnapshotMethod0())
+      .Times(Exactly(1))
+      .WillOnce(DoAll(InvokeWithoutArgs([this] {
+                        EXPECT_FALSE(signaling_thread_->IsCurrent());
+                      }),
+                      Return("SnapshotMethod0")));
+  EXPECT_EQ("SnapshotMethod0", fake_signaling_proxy_->SnapshotMethod0());
+}
+
 TEST_F(SignalingProxyTest, Method1) {
   const std::string arg1 = "arg1";
   EXPECT_CALL(*fake_, Method1(arg1))
@@ -22,6 +22,7 @@
 #include <utility>
 #include <vector>
 
+#include "absl/algorithm/container.h"
 #include "absl/functional/bind_front.h"
 #include "absl/strings/string_view.h"
 #include "api/array_view.h"
@@ -52,6 +53,7 @@
 #include "pc/rtc_stats_traversal.h"
 #include "pc/rtp_receiver_proxy.h"
 #include "pc/rtp_sender_proxy.h"
+#include "pc/setup_timeline.h"
 #include "pc/webrtc_sdp.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/ip_address.h"
@@ -508,6 +510,10 @@ std::unique_ptr<RTCInboundRtpStreamStats> CreateInboundAudioStreamStats(
   inbound_audio->total_interruption_duration =
       static_cast<double>(voice_receiver_info.total_interruption_duration_ms) /
       rtc::kNumMillisecsPerSec;
+  if (voice_receiver_info.total_decode_cpu_time.has_value()) {
+    inbound_audio->total_decode_cpu_time =
+        voice_receiver_info.total_decode_cpu_time->seconds<double>();
+  }
   return inbound_audio;
 }
 
@@ -637,6 +643,10 @@ CreateInboundRTPStreamStatsFromVideoReceiverInfo(
       video_receiver_info.total_decode_time.seconds<double>();
   inbound_video->total_processing_delay =
       video_receiver_info.total_processing_delay.seconds<double>();
+  if (video_receiver_info.total_decode_cpu_time.has_value()) {
+    inbound_video->total_decode_cpu_time =
+        video_receiver_info.total_decode_cpu_time->seconds<double>();
+  }
   inbound_video->total_assembly_time =
       video_receiver_info.total_assembly_time.seconds<double>();
   inbound_video->frames_assembled_from_multiple_packets =
@@ -797,6 +807,10 @@ CreateOutboundRTPStreamStatsFromVideoSenderInfo(
       rtc::kNumMillisecsPerSec;
   outbound_video->total_encoded_bytes_target =
       video_sender_info.total_encoded_bytes_target;
+  if (video_sender_info.total_encode_cpu_time.has_value()) {
+    outbound_video->total_encode_cpu_time =
+        video_sender_info.total_encode_cpu_time->seconds<double>();
+  }
   if (video_sender_info.send_frame_width > 0) {
     outbound_video->frame_width =
         static_cast<uint32_t>(video_sender_info.send_frame_width);
@@ -1082,6 +1096,28 @@ RTCStatsCollector::CreateReportFilteredBySelector(
   return TakeReferencedStats(report->Copy(), rtpstream_ids);
 }
 
+rtc::scoped_refptr<RTCStatsReport>
+RTCStatsCollector::CreateReportFilteredByTypes(
+    rtc::scoped_refptr<const RTCStatsReport> report,
+    const std::set<std::string>& types,
+    rtc::scoped_refptr<const RTCStatsReport> unchanged_since) {
+  rtc::scoped_refptr<RTCStatsReport> filtered_report =
+      RTCStatsReport::Create(report->timestamp());
+  for (const RTCStats& stats : *report) {
+    if (!types.empty() && types.find(stats.type()) == types.end()) {
+      continue;
+    }
+    if (unchanged_since) {
+      const RTCStats* previous_stats = unchanged_since->Get(stats.id());
+      if (previous_stats && *previous_stats == stats) {
+        continue;
+      }
+    }
+    filtered_report->AddStats(stats.copy());
+  }
+  return filtered_report;
+}
+
 RTCStatsCollector::CertificateStatsPair
 RTCStatsCollector::CertificateStatsPair::Copy() const {
   CertificateStatsPair copy;
@@ -1110,6 +1146,31 @@ RTCStatsCollector::RequestInfo::RequestInfo(
                   nullptr,
                   std::move(selector)) {}
 
+RTCStatsCollector::RequestInfo::RequestInfo(
+    std::set<std::string> types,
+    rtc::scoped_refptr<const RTCStatsReport> unchanged_since,
+    rtc::scoped_refptr<RTCStatsCollectorCallback> callback)
+    : RequestInfo(FilterMode::kTypes, std::move(callback), nullptr, nullptr) {
+  types_ = std::move(types);
+  unchanged_since_ = std::move(unchanged_since);
+}
+
+bool RTCStatsCollector::RequestInfo::NeedsMediaStats() const {
+  if (filter_mode_ != FilterMode::kTypes || types_.empty()) {
+    return true;
+  }
+  for (const char* type :
+       {RTCInboundRtpStreamStats::kType, RTCOutboundRtpStreamStats::kType,
+        RTCRemoteInboundRtpStreamStats::kType,
+        RTCRemoteOutboundRtpStreamStats::kType, RTCCodecStats::kType,
+        RTCAudioSourceStats::kType, RTCAudioPlayoutStats::kType}) {
+    if (types_.find(type) != types_.end()) {
+      return true;
+    }
+  }
+  return false;
+}
+
 RTCStatsCollector::RequestInfo::RequestInfo(
     RTCStatsCollector::RequestInfo::FilterMode filter_mode,
     rtc::scoped_refptr<RTCStatsCollectorCallback> callback,
@@ -1169,52 +1230,75 @@ void RTCStatsCollector::GetStatsReport(
   GetStatsReportInternal(RequestInfo(std::move(selector), std::move(callback)));
 }
 
+void RTCStatsCollector::GetStatsReport(
+    std::set<std::string> types,
+    rtc::scoped_refptr<const RTCStatsReport> unchanged_since,
+    rtc::scoped_refptr<RTCStatsCollectorCallback> callback) {
+  GetStatsReportInternal(RequestInfo(std::move(types),
+                                     std::move(unchanged_since),
+                                     std::move(callback)));
+}
+
 void RTCStatsCollector::GetStatsReportInternal(
     RTCStatsCollector::RequestInfo request) {
   RTC_DCHECK_RUN_ON(signaling_thread_);
-  requests_.push_back(std::move(request));
 
   // "Now" using a monotonically increasing timer.
   int64_t cache_now_us = rtc::TimeMicros();
   if (cached_report_ &&
-      cache_now_us - cache_timestamp_us_ <= cache_lifetime_us_) {
+      cache_now_us - cache_timestamp_us_ <= cache_lifetime_us_ &&
+      CachedReportSatisfies(request)) {
     // We have a fresh cached report to deliver. Deliver asynchronously, since
     // the caller may not be expecting a synchronous callback, and it avoids
     // reentrancy problems.
+    std::vector<RequestInfo> requests;
+    requests.push_back(std::move(request));
     signaling_thread_->PostTask(
         absl::bind_front(&RTCStatsCollector::DeliverCachedReport,
                          rtc::scoped_refptr<RTCStatsCollector>(this),
-                         cached_report_, std::move(requests_)));
-  } else if (!num_pending_partial_reports_) {
-    // Only start gathering stats if we're not already gathering stats. In the
-    // case of already gathering stats, `callback_` will be invoked when there
-    // are no more pending partial reports.
-
-    // "Now" using a system clock, relative to the UNIX epoch (Jan 1, 1970,
-    // UTC), in microseconds. The system clock could be modified and is not
-    // necessarily monotonically increasing.
-    Timestamp timestamp = Timestamp::Micros(rtc::TimeUTCMicros());
-
-    num_pending_partial_reports_ = 2;
-    partial_report_timestamp_us_ = cache_now_us;
-
-    // Prepare `transceiver_stats_infos_` and `call_stats_` for use in
-    // `ProducePartialResultsOnNetworkThread` and
-    // `ProducePartialResultsOnSignalingThread`.
-    PrepareTransceiverStatsInfosAndCallStats_s_w_n();
-    // Don't touch `network_report_` on the signaling thread until
-    // ProducePartialResultsOnNetworkThread() has signaled the
-    // `network_report_event_`.
-    network_report_event_.Reset();
-    rtc::scoped_refptr<RTCStatsCollector> collector(this);
-    network_thread_->PostTask([collector,
-                               sctp_transport_name = pc_->sctp_transport_name(),
-                               timestamp]() mutable {
-      collector->ProducePartialResultsOnNetworkThread(
-          timestamp, std::move(sctp_transport_name));
-    });
-    ProducePartialResultsOnSignalingThread(timestamp);
+                         cached_report_, std::move(requests)));
+    return;
   }
+  requests_.push_back(std::move(request));
+  // Only start gathering stats if we're not already gathering stats. In the
+  // case of already gathering stats, `callback_` will be invoked when there
+  // are no more pending partial reports.
+  if (!num_pending_partial_reports_) {
+    StartCollection(cache_now_us);
+  }
+}
+
+void RTCStatsCollector::StartCollection(int64_t cache_now_us) {
+  RTC_DCHECK_RUN_ON(signaling_thread_);
+  RTC_DCHECK(!requests_.empty());
+  RTC_DCHECK_EQ(num_pending_partial_reports_, 0);
+  // "Now" using a system clock, relative to the UNIX epoch (Jan 1, 1970,
+  // UTC), in microseconds. The system clock could be modified and is not
+  // necessarily monotonically increasing.
+  Timestamp timestamp = Timestamp::Micros(rtc::TimeUTCMicros());
+
+  num_pending_partial_reports_ = 2;
+  partial_report_timestamp_us_ = cache_now_us;
+  collecting_media_stats_ = absl::c_any_of(
+      requests_,
+      [](const RequestInfo& request) { return request.NeedsMediaStats(); });
+
+  // Prepare `transceiver_stats_infos_` and `call_stats_` for use in
+  // `ProducePartialResultsOnNetworkThread` and
+  // `ProducePartialResultsOnSignalingThread`.
+  PrepareTransceiverStatsInfosAndCallStats_s_w_n();
+  // Don't touch `network_report_` on the signaling thread until
+  // ProducePartialResultsOnNetworkThread() has signaled the
+  // `network_report_event_`.
+  network_report_event_.Reset();
+  rtc::scoped_refptr<RTCStatsCollector> collector(this);
+  network_thread_->PostTask([collector,
+                             sctp_transport_name = pc_->sctp_transport_name(),
+                             timestamp]() mutable {
+    collector->ProducePartialResultsOnNetworkThread(
+        timestamp, std::move(sctp_transport_name));
+  });
+  ProducePartialResultsOnSignalingThread(timestamp);
 }
 
 void RTCStatsCollector::ClearCachedStatsReport() {
@@ -1227,8 +1311,12 @@ void RTCStatsCollector::ClearCachedStatsReport() {
 void RTCStatsCollector::WaitForPendingRequest() {
   RTC_DCHECK_RUN_ON(signaling_thread_);
   // If a request is pending, blocks until the `network_report_event_` is
-  // signaled and then delivers the result. Otherwise this is a NO-OP.
-  MergeNetworkReport_s();
+  // signaled and then delivers the result. Otherwise this is a NO-OP. Merging
+  // may start another collection for the requests that need media stats the
+  // pending one did not gather.
+  do {
+    MergeNetworkReport_s();
+  } while (num_pending_partial_reports_ > 0);
 }
 
 void RTCStatsCollector::ProducePartialResultsOnSignalingThread(
@@ -1254,9 +1342,13 @@ void RTCStatsCollector::ProducePartialResultsOnSignalingThreadImpl(
   RTC_DCHECK_RUN_ON(signaling_thread_);
   rtc::Thread::ScopedDisallowBlockingCalls no_blocking_calls;
 
-  ProduceMediaSourceStats_s(timestamp, partial_report);
+  if (collecting_media_stats_) {
+    ProduceMediaSourceStats_s(timestamp, partial_report);
+  }
   ProducePeerConnectionStats_s(timestamp, partial_report);
-  ProduceAudioPlayoutStats_s(timestamp, partial_report);
+  if (collecting_media_stats_) {
+    ProduceAudioPlayoutStats_s(timestamp, partial_report);
+  }
 }
 
 void RTCStatsCollector::ProducePartialResultsOnNetworkThread(
@@ -1314,7 +1406,10 @@ void RTCStatsCollector::ProducePartialResultsOnNetworkThreadImpl(
                                     call_stats_, partial_report);
   ProduceTransportStats_n(timestamp, transport_stats_by_name,
                           transport_cert_stats, partial_report);
-  ProduceRTPStreamStats_n(timestamp, transceiver_stats_infos_, partial_report);
+  if (collecting_media_stats_) {
+    ProduceRTPStreamStats_n(timestamp, transceiver_stats_infos_,
+                            partial_report);
+  }
 }
 
 void RTCStatsCollector::MergeNetworkReport_s() {
@@ -1344,6 +1439,7 @@ void RTCStatsCollector::MergeNetworkReport_s() {
   RTC_DCHECK_EQ(num_pending_partial_reports_, 0);
   cache_timestamp_us_ = partial_report_timestamp_us_;
   cached_report_ = partial_report_;
+  cached_report_has_media_stats_ = collecting_media_stats_;
   partial_report_ = nullptr;
   transceiver_stats_infos_.clear();
   // Trace WebRTC Stats when getStats is called on Javascript.
@@ -1352,10 +1448,33 @@ void RTCStatsCollector::MergeNetworkReport_s() {
   TRACE_EVENT_INSTANT1("webrtc_stats", "webrtc_stats", "report",
                        cached_report_->ToJson());
 
-  // Deliver report and clear `requests_`.
+  // Deliver report to the requests it satisfies and remove them from
+  // `requests_`.
   std::vector<RequestInfo> requests;
-  requests.swap(requests_);
-  DeliverCachedReport(cached_report_, std::move(requests));
+  std::vector<RequestInfo> unsatisfied_requests;
+  for (RequestInfo& request : requests_) {
+    if (CachedReportSatisfies(request)) {
+      requests.push_back(std::move(request));
+    } else {
+      unsatisfied_requests.push_back(std::move(request));
+    }
+  }
+  requests_ = std::move(unsatisfied_requests);
+  if (!requests.empty()) {
+    DeliverCachedReport(cached_report_, std::move(requests));
+  }
+  // The requests that arrived during a collection without media stats, and
+  // need them, get a collection of their own. Delivering may already have
+  // started one.
+  if (!requests_.empty() && !num_pending_partial_reports_) {
+    StartCollection(rtc::TimeMicros());
+  }
+}
+
+bool RTCStatsCollector::CachedReportSatisfies(
+    const RequestInfo& request) const {
+  RTC_DCHECK_RUN_ON(signaling_thread_);
+  return cached_report_has_media_stats_ || !request.NeedsMediaStats();
 }
 
 void RTCStatsCollector::DeliverCachedReport(
@@ -1368,6 +1487,9 @@ void RTCStatsCollector::DeliverCachedReport(
   for (const RequestInfo& request : requests) {
     if (request.filter_mode() == RequestInfo::FilterMode::kAll) {
       request.callback()->OnStatsDelivered(cached_report);
+    } else if (request.filter_mode() == RequestInfo::FilterMode::kTypes) {
+      request.callback()->OnStatsDelivered(CreateReportFilteredByTypes(
+          cached_report, request.types(), request.unchanged_since()));
     } else {
       bool filter_by_sender_selector;
       rtc::scoped_refptr<RtpSenderInternal> sender_selector;
@@ -1647,6 +1769,28 @@ void RTCStatsCollector::ProducePeerConnectionStats_s(
   auto stats(std::make_unique<RTCPeerConnectionStats>("P", timestamp));
   stats->data_channels_opened = internal_record_.data_channels_opened;
   stats->data_channels_closed = internal_record_.data_channels_closed;
+  std::map<SetupPhase, TimeDelta> setup_timeline = pc_->GetSetupTimeline();
+  if (!setup_timeline.empty()) {
+    std::map<std::string, double> delays;
+    for (const auto& [phase, delay] : setup_timeline) {
+      delays[std::string(SetupPhaseToString(phase))] = delay.seconds<double>();
+    }
+    stats->setup_timeline = std::move(delays);
+  }
+  std::map<std::string, uint64_t> memory_usage;
+  for (const auto& [component, bytes] :
+       call_stats_.memory_usage_bytes_by_component) {
+    memory_usage[component] = static_cast<uint64_t>(bytes);
+  }
+  if (data_channel_buffered_bytes_ > 0)
+    memory_usage["dataChannelSendQueue"] = data_channel_buffered_bytes_;
+  if (!memory_usage.empty()) {
+    uint64_t total_memory_usage = 0;
+    for (const auto& [component, bytes] : memory_usage)
+      total_memory_usage += bytes;
+    stats->memory_usage_bytes = total_memory_usage;
+    stats->memory_usage_bytes_by_component = std::move(memory_usage);
+  }
   report->AddStats(std::move(stats));
 }
 
@@ -2044,6 +2188,10 @@ void RTCStatsCollector::PrepareTransceiverStatsInfosAndCallStats_s_w_n() {
   network_thread_->BlockingCall([&] {
     rtc::Thread::ScopedDisallowBlockingCalls no_blocking_calls;
 
+    data_channel_buffered_bytes_ = 0;
+    for (const DataChannelStats& stats : pc_->GetDataChannelStats())
+      data_channel_buffered_bytes_ += stats.buffered_amount;
+
     for (const auto& transceiver_proxy : transceivers) {
       RtpTransceiver* transceiver = transceiver_proxy->internal();
       cricket::MediaType media_type = transceiver->media_type();
@@ -2063,6 +2211,10 @@ void RTCStatsCollector::PrepareTransceiverStatsInfosAndCallStats_s_w_n() {
 
       stats.mid = channel->mid();
       stats.transport_name = std::string(channel->transport_name());
+      if (!collecting_media_stats_) {
+        // Only the transport is needed.
+        continue;
+      }
 
       if (media_type == cricket::MEDIA_TYPE_AUDIO) {
         auto voice_send_channel = channel->voice_media_send_channel();
@@ -2126,6 +2278,10 @@ void RTCStatsCollector::PrepareTransceiverStatsInfosAndCallStats_s_w_n() {
     // and keep track of whether we have at least one audio receiver.
     bool has_audio_receiver = false;
     for (auto& stats : transceiver_stats_infos_) {
+      if (!collecting_media_stats_) {
+        // The media channels were not queried.
+        break;
+      }
       auto transceiver = stats.transceiver;
       absl::optional<cricket::VoiceMediaInfo> voice_media_info;
       absl::optional<cricket::VideoMediaInfo> video_media_info;
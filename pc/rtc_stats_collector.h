@@ -16,6 +16,7 @@
 #include <cstdint>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -78,6 +79,13 @@ class RTCStatsCollector : public rtc::RefCountInterface {
   // as: no RTP streams are received by selector). The result is empty.
   void GetStatsReport(rtc::scoped_refptr<RtpReceiverInternal> selector,
                       rtc::scoped_refptr<RTCStatsCollectorCallback> callback);
+  // Only delivers the stats of the given `types` (all types if empty), leaving
+  // out those that are in `unchanged_since` with the same values. The RTP
+  // stream, codec and media source stats are only gathered from the media
+  // channels if one of their types is requested.
+  void GetStatsReport(std::set<std::string> types,
+                      rtc::scoped_refptr<const RTCStatsReport> unchanged_since,
+                      rtc::scoped_refptr<RTCStatsCollectorCallback> callback);
   // Clears the cache's reference to the most recent stats report. Subsequently
   // calling `GetStatsReport` guarantees fresh stats. This method must be called
   // any time the PeerConnection visibly changes as a result of an API call as
@@ -119,7 +127,12 @@ class RTCStatsCollector : public rtc::RefCountInterface {
  private:
   class RequestInfo {
    public:
-    enum class FilterMode { kAll, kSenderSelector, kReceiverSelector };
+    enum class FilterMode {
+      kAll,
+      kSenderSelector,
+      kReceiverSelector,
+      kTypes
+    };
 
     // Constructs with FilterMode::kAll.
     explicit RequestInfo(
@@ -132,6 +145,10 @@ class RTCStatsCollector : public rtc::RefCountInterface {
     // applied even if `selector` is null, resulting in an empty report.
     RequestInfo(rtc::scoped_refptr<RtpReceiverInternal> selector,
                 rtc::scoped_refptr<RTCStatsCollectorCallback> callback);
+    // Constructs with FilterMode::kTypes.
+    RequestInfo(std::set<std::string> types,
+                rtc::scoped_refptr<const RTCStatsReport> unchanged_since,
+                rtc::scoped_refptr<RTCStatsCollectorCallback> callback);
 
     FilterMode filter_mode() const { return filter_mode_; }
     rtc::scoped_refptr<RTCStatsCollectorCallback> callback() const {
@@ -145,6 +162,17 @@ class RTCStatsCollector : public rtc::RefCountInterface {
       RTC_DCHECK(filter_mode_ == FilterMode::kReceiverSelector);
       return receiver_selector_;
     }
+    const std::set<std::string>& types() const {
+      RTC_DCHECK(filter_mode_ == FilterMode::kTypes);
+      return types_;
+    }
+    rtc::scoped_refptr<const RTCStatsReport> unchanged_since() const {
+      RTC_DCHECK(filter_mode_ == FilterMode::kTypes);
+      return unchanged_since_;
+    }
+    // Whether the stats of the media channels are needed, which are gathered
+    // on the worker thread.
+    bool NeedsMediaStats() const;
 
    private:
     RequestInfo(FilterMode filter_mode,
@@ -156,9 +184,13 @@ class RTCStatsCollector : public rtc::RefCountInterface {
     rtc::scoped_refptr<RTCStatsCollectorCallback> callback_;
     rtc::scoped_refptr<RtpSenderInternal> sender_selector_;
     rtc::scoped_refptr<RtpReceiverInternal> receiver_selector_;
+    std::set<std::string> types_;
+    rtc::scoped_refptr<const RTCStatsReport> unchanged_since_;
   };
 
   void GetStatsReportInternal(RequestInfo request);
+  // Starts gathering the stats needed by `requests_`.
+  void StartCollection(int64_t cache_now_us);
 
   // Structure for tracking stats about each RtpTransceiver managed by the
   // PeerConnection. This can either by a Plan B style or Unified Plan style
@@ -244,12 +276,18 @@ class RTCStatsCollector : public rtc::RefCountInterface {
   // Merges `network_report_` into `partial_report_` and completes the request.
   // This is a NO-OP if `network_report_` is null.
   void MergeNetworkReport_s();
+  // Returns false if the cached report lacks the stats needed by `request`.
+  bool CachedReportSatisfies(const RequestInfo& request) const;
 
   rtc::scoped_refptr<RTCStatsReport> CreateReportFilteredBySelector(
       bool filter_by_sender_selector,
       rtc::scoped_refptr<const RTCStatsReport> report,
       rtc::scoped_refptr<RtpSenderInternal> sender_selector,
       rtc::scoped_refptr<RtpReceiverInternal> receiver_selector);
+  static rtc::scoped_refptr<RTCStatsReport> CreateReportFilteredByTypes(
+      rtc::scoped_refptr<const RTCStatsReport> report,
+      const std::set<std::string>& types,
+      rtc::scoped_refptr<const RTCStatsReport> unchanged_since);
 
   PeerConnectionInternal* const pc_;
   rtc::Thread* const signaling_thread_;
@@ -284,6 +322,10 @@ class RTCStatsCollector : public rtc::RefCountInterface {
   // now get rid of the variable and keep the data scoped within a stats
   // collection sequence.
   std::vector<RtpTransceiverStatsInfo> transceiver_stats_infos_;
+  // Whether the pending collection gathers the stats of the media channels.
+  // Set on the signaling thread before the collection starts, like
+  // `transceiver_stats_infos_`.
+  bool collecting_media_stats_ = true;
   // This cache avoids having to call rtc::SSLCertChain::GetStats(), which can
   // relatively expensive. ClearCachedStatsReport() needs to be called on
   // negotiation to ensure the cache is not obsolete.
@@ -292,6 +334,9 @@ class RTCStatsCollector : public rtc::RefCountInterface {
       RTC_GUARDED_BY(cached_certificates_mutex_);
 
   Call::Stats call_stats_;
+  // Bytes queued in the send buffers of the data channels, summed on the
+  // network thread alongside `transceiver_stats_infos_`.
+  uint64_t data_channel_buffered_bytes_ = 0;
 
   absl::optional<AudioDeviceModule::Stats> audio_device_stats_;
 
@@ -302,6 +347,7 @@ class RTCStatsCollector : public rtc::RefCountInterface {
   int64_t cache_timestamp_us_;
   int64_t cache_lifetime_us_;
   rtc::scoped_refptr<const RTCStatsReport> cached_report_;
+  bool cached_report_has_media_stats_ = false;
 
   // Data recorded and maintained by the stats collector during its lifetime.
   // Some stats are produced from this record instead of other components.
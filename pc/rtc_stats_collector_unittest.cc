@@ -17,6 +17,7 @@
 #include <initializer_list>
 #include <memory>
 #include <ostream>
+#include <set>
 #include <string>
 #include <type_traits>
 #include <utility>
@@ -460,6 +461,15 @@ class RTCStatsCollectorWrapper {
     return WaitForReport(callback);
   }
 
+  rtc::scoped_refptr<const RTCStatsReport> GetStatsReportOfTypes(
+      std::set<std::string> types,
+      rtc::scoped_refptr<const RTCStatsReport> unchanged_since = nullptr) {
+    rtc::scoped_refptr<RTCStatsObtainer> callback = RTCStatsObtainer::Create();
+    stats_collector_->GetStatsReport(std::move(types),
+                                     std::move(unchanged_since), callback);
+    return WaitForReport(callback);
+  }
+
   rtc::scoped_refptr<const RTCStatsReport> GetFreshStatsReport() {
     stats_collector_->ClearCachedStatsReport();
     return GetStatsReport();
@@ -2165,6 +2175,34 @@ TEST_F(RTCStatsCollectorTest, CollectRTCPeerConnectionStats) {
   }
 }
 
+TEST_F(RTCStatsCollectorTest, CollectRTCPeerConnectionStatsSetupTimeline) {
+  pc_->SetSetupTimeline(
+      {{SetupPhase::kLocalDescriptionSet, TimeDelta::Millis(20)},
+       {SetupPhase::kConnected, TimeDelta::Millis(1500)}});
+
+  rtc::scoped_refptr<const RTCStatsReport> report = stats_->GetStatsReport();
+  ASSERT_TRUE(report->Get("P"));
+  const auto& stats = report->Get("P")->cast_to<RTCPeerConnectionStats>();
+  EXPECT_EQ(stats.setup_timeline,
+            (std::map<std::string, double>{{"localDescriptionSet", 0.02},
+                                           {"connected", 1.5}}));
+}
+
+TEST_F(RTCStatsCollectorTest, CollectRTCPeerConnectionStatsMemoryUsage) {
+  Call::Stats call_stats;
+  call_stats.memory_usage_bytes_by_component = {{"rtpPacketHistory", 3000},
+                                                {"netEqBuffer", 500}};
+  pc_->SetCallStats(call_stats);
+
+  rtc::scoped_refptr<const RTCStatsReport> report = stats_->GetStatsReport();
+  ASSERT_TRUE(report->Get("P"));
+  const auto& stats = report->Get("P")->cast_to<RTCPeerConnectionStats>();
+  EXPECT_EQ(stats.memory_usage_bytes, 3500u);
+  EXPECT_EQ(stats.memory_usage_bytes_by_component,
+            (std::map<std::string, uint64_t>{{"rtpPacketHistory", 3000},
+                                             {"netEqBuffer", 500}}));
+}
+
 TEST_F(RTCStatsCollectorTest, CollectRTCInboundRtpStreamStats_Audio) {
   cricket::VoiceMediaInfo voice_media_info;
 
@@ -2200,6 +2238,7 @@ TEST_F(RTCStatsCollectorTest, CollectRTCInboundRtpStreamStats_Audio) {
   voice_media_info.receivers[0].relative_packet_arrival_delay_seconds = 16;
   voice_media_info.receivers[0].interruption_count = 7788;
   voice_media_info.receivers[0].total_interruption_duration_ms = 778899;
+  voice_media_info.receivers[0].total_decode_cpu_time = TimeDelta::Millis(250);
   voice_media_info.receivers[0].last_packet_received = absl::nullopt;
 
   RtpCodecParameters codec_parameters;
@@ -2258,6 +2297,7 @@ TEST_F(RTCStatsCollectorTest, CollectRTCInboundRtpStreamStats_Audio) {
   expected_audio.relative_packet_arrival_delay = 16;
   expected_audio.interruption_count = 7788;
   expected_audio.total_interruption_duration = 778.899;
+  expected_audio.total_decode_cpu_time = 0.25;
   expected_audio.playout_id = "AP";
 
   ASSERT_TRUE(report->Get(expected_audio.id()));
@@ -2343,6 +2383,7 @@ TEST_F(RTCStatsCollectorTest, CollectRTCInboundRtpStreamStats_Video) {
   video_media_info.receivers[0].qp_sum = absl::nullopt;
   video_media_info.receivers[0].total_decode_time = TimeDelta::Seconds(9);
   video_media_info.receivers[0].total_processing_delay = TimeDelta::Millis(600);
+  video_media_info.receivers[0].total_decode_cpu_time = TimeDelta::Millis(700);
   video_media_info.receivers[0].total_assembly_time = TimeDelta::Millis(500);
   video_media_info.receivers[0].frames_assembled_from_multiple_packets = 23;
   video_media_info.receivers[0].total_inter_frame_delay = 0.123;
@@ -2414,6 +2455,7 @@ TEST_F(RTCStatsCollectorTest, CollectRTCInboundRtpStreamStats_Video) {
   // `expected_video.qp_sum` should be undefined.
   expected_video.total_decode_time = 9.0;
   expected_video.total_processing_delay = 0.6;
+  expected_video.total_decode_cpu_time = 0.7;
   expected_video.total_assembly_time = 0.5;
   expected_video.frames_assembled_from_multiple_packets = 23;
   expected_video.total_inter_frame_delay = 0.123;
@@ -2620,6 +2662,7 @@ TEST_F(RTCStatsCollectorTest, CollectRTCOutboundRtpStreamStats_Video) {
   video_media_info.senders[0].key_frames_encoded = 3;
   video_media_info.senders[0].total_encode_time_ms = 9000;
   video_media_info.senders[0].total_encoded_bytes_target = 1234;
+  video_media_info.senders[0].total_encode_cpu_time = TimeDelta::Millis(800);
   video_media_info.senders[0].total_packet_send_delay = TimeDelta::Seconds(10);
   video_media_info.senders[0].quality_limitation_reason =
       QualityLimitationReason::kBandwidth;
@@ -2681,6 +2724,7 @@ TEST_F(RTCStatsCollectorTest, CollectRTCOutboundRtpStreamStats_Video) {
   expected_video.key_frames_encoded = 3;
   expected_video.total_encode_time = 9.0;
   expected_video.total_encoded_bytes_target = 1234;
+  expected_video.total_encode_cpu_time = 0.8;
   expected_video.total_packet_send_delay = 10.0;
   expected_video.quality_limitation_reason = "bandwidth";
   expected_video.quality_limitation_durations = std::map<std::string, double>{
@@ -3635,6 +3679,54 @@ TEST_F(RTCStatsCollectorTest, GetStatsWithReceiverSelector) {
   EXPECT_FALSE(receiver_report->Get(graph.media_source_id));
 }
 
+TEST_F(RTCStatsCollectorTest, GetStatsOfTypes) {
+  ExampleStatsGraph graph = SetupExampleStatsGraphForSelectorTests();
+  rtc::scoped_refptr<const RTCStatsReport> report =
+      stats_->GetStatsReportOfTypes(
+          {RTCOutboundRtpStreamStats::kType, RTCTransportStats::kType});
+  EXPECT_EQ(report->timestamp(), graph.full_report->timestamp());
+  EXPECT_EQ(report->size(), 2u);
+  EXPECT_TRUE(report->Get(graph.outbound_rtp_id));
+  EXPECT_TRUE(report->Get(graph.transport_id));
+  EXPECT_FALSE(report->Get(graph.inbound_rtp_id));
+  EXPECT_FALSE(report->Get(graph.peer_connection_id));
+}
+
+TEST_F(RTCStatsCollectorTest, GetStatsOfTypesWithoutMediaStats) {
+  ExampleStatsGraph graph = SetupExampleStatsGraphForSelectorTests();
+  stats_->stats_collector()->ClearCachedStatsReport();
+  rtc::scoped_refptr<const RTCStatsReport> report =
+      stats_->GetStatsReportOfTypes({RTCTransportStats::kType});
+  EXPECT_EQ(report->size(), 1u);
+  EXPECT_TRUE(report->Get(graph.transport_id));
+  // The cached report lacks the RTP stream stats, so they are collected anew.
+  report = stats_->GetStatsReportOfTypes({RTCInboundRtpStreamStats::kType});
+  EXPECT_EQ(report->size(), 1u);
+  EXPECT_TRUE(report->Get(graph.inbound_rtp_id));
+  // A request for all stats is not served the cached partial report either.
+  report = stats_->GetStatsReport();
+  EXPECT_TRUE(report->Get(graph.outbound_rtp_id));
+  EXPECT_TRUE(report->Get(graph.media_source_id));
+}
+
+TEST_F(RTCStatsCollectorTest, GetStatsUnchangedSince) {
+  ExampleStatsGraph graph = SetupExampleStatsGraphForSelectorTests();
+  // Compared to an empty report, nothing is left out.
+  rtc::scoped_refptr<const RTCStatsReport> report =
+      stats_->GetStatsReportOfTypes(
+          {}, RTCStatsReport::Create(graph.full_report->timestamp()));
+  EXPECT_EQ(report->size(), graph.full_report->size());
+  // Compared to the report it is made from, everything is left out.
+  EXPECT_EQ(stats_->GetStatsReportOfTypes({}, graph.full_report)->size(), 0u);
+  // Only the stats whose members changed are left in a fresh report.
+  stats_->stats_collector()->ClearCachedStatsReport();
+  report = stats_->GetStatsReportOfTypes({}, graph.full_report);
+  for (const RTCStats& stats : *report) {
+    const RTCStats* previous_stats = graph.full_report->Get(stats.id());
+    EXPECT_TRUE(!previous_stats || *previous_stats != stats);
+  }
+}
+
 TEST_F(RTCStatsCollectorTest, GetStatsWithNullSenderSelector) {
   ExampleStatsGraph graph = SetupExampleStatsGraphForSelectorTests();
   rtc::scoped_refptr<const RTCStatsReport> empty_report =
@@ -577,6 +577,11 @@ class RTCStatsReportVerifier {
         peer_connection.data_channels_opened);
     verifier.TestAttributeIsNonNegative<uint32_t>(
         peer_connection.data_channels_closed);
+    verifier.TestAttributeIsDefined(peer_connection.setup_timeline);
+    verifier.TestAttributeIsNonNegative<uint64_t>(
+        peer_connection.memory_usage_bytes);
+    verifier.TestAttributeIsDefined(
+        peer_connection.memory_usage_bytes_by_component);
     return verifier.ExpectAllAttributesSuccessfullyTested();
   }
 
@@ -795,6 +800,8 @@ class RTCStatsReportVerifier {
       verifier.TestAttributeIsUndefined(inbound_stream.min_playout_delay);
       verifier.TestAttributeIsUndefined(inbound_stream.goog_timing_frame_info);
     }
+    // Only defined when the "WebRTC-PerStreamCpuTime" field trial is enabled.
+    verifier.TestAttributeIsUndefined(inbound_stream.total_decode_cpu_time);
     if (inbound_stream.kind.has_value() && *inbound_stream.kind == "audio") {
       verifier.TestAttributeIsDefined(inbound_stream.playout_id);
     } else {
@@ -906,6 +913,8 @@ class RTCStatsReportVerifier {
       verifier.TestAttributeIsUndefined(outbound_stream.scalability_mode);
       verifier.TestAttributeIsUndefined(outbound_stream.rtx_ssrc);
     }
+    // Only defined when the "WebRTC-PerStreamCpuTime" field trial is enabled.
+    verifier.TestAttributeIsUndefined(outbound_stream.total_encode_cpu_time);
     return verifier.ExpectAllAttributesSuccessfullyTested();
   }
 
@@ -757,7 +757,7 @@ void AudioRtpSender::SetSend() {
                                                sink_adapter_.get());
   });
   if (!success) {
-    RTC_LOG(LS_ERROR) << "SetAudioSend: ssrc is incorrect: " << ssrc_;
+    RTC_LOG(LS_ERROR) << "SetAudioSend: ssrc is incorrect: " << ssrc();
   }
 }
 
@@ -774,7 +774,7 @@ void AudioRtpSender::ClearSend() {
     return voice_media_channel()->SetAudioSend(ssrc_, false, &options, nullptr);
   });
   if (!success) {
-    RTC_LOG(LS_WARNING) << "ClearAudioSend: ssrc is incorrect: " << ssrc_;
+    RTC_LOG(LS_WARNING) << "ClearAudioSend: ssrc is incorrect: " << ssrc();
   }
 }
 
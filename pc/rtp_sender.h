@@ -18,6 +18,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
@@ -152,11 +153,10 @@ class RtpSenderBase : public RtpSenderInternal, public ObserverInterface {
   // underlying transport (this occurs if the sender isn't seen in a local
   // description).
   void SetSsrc(uint32_t ssrc) override;
+  // May be called on any thread, e.g. from the worker thread by
+  // RTCStatsCollector::PrepareTransceiverStatsInfosAndCallStats_s_w_n.
   uint32_t ssrc() const override {
-    // This method is currently called from the worker thread by
-    // RTCStatsCollector::PrepareTransceiverStatsInfosAndCallStats_s_w_n.
-    // RTC_DCHECK_RUN_ON(signaling_thread_);
-    return ssrc_;
+    return ssrc_.load(std::memory_order_relaxed);
   }
 
   std::vector<std::string> stream_ids() const override {
@@ -253,7 +253,9 @@ class RtpSenderBase : public RtpSenderInternal, public ObserverInterface {
 
   rtc::Thread* const signaling_thread_;
   rtc::Thread* const worker_thread_;
-  uint32_t ssrc_ = 0;
+  // Only written on the signaling thread, atomic so that it can be read on
+  // any thread.
+  std::atomic<uint32_t> ssrc_{0};
   bool stopped_ RTC_GUARDED_BY(signaling_thread_) = false;
   bool is_transceiver_stopped_ RTC_GUARDED_BY(signaling_thread_) = false;
   int attachment_id_ = 0;
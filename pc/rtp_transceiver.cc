@@ -366,6 +366,7 @@ void RtpTransceiver::SetChannel(
         });
   });
   PushNewMediaChannelAndDeleteChannel(nullptr);
+  applied_contents_ = {};
 
   RTC_DCHECK_BLOCK_COUNT_NO_MORE_THAN(2);
 }
@@ -395,6 +396,7 @@ void RtpTransceiver::ClearChannel() {
 
   RTC_DCHECK_BLOCK_COUNT_NO_MORE_THAN(1);
   PushNewMediaChannelAndDeleteChannel(std::move(channel_to_delete));
+  applied_contents_ = {};
 
   RTC_DCHECK_BLOCK_COUNT_NO_MORE_THAN(2);
 }
@@ -446,6 +448,7 @@ void RtpTransceiver::AddSender(
           ? send_codecs
           : MatchCodecPreferences(codec_preferences_, send_codecs));
   senders_.push_back(sender);
+  NotifyLookupKeysChanged();
 }
 
 bool RtpTransceiver::RemoveSender(RtpSenderInterface* sender) {
@@ -459,6 +462,7 @@ bool RtpTransceiver::RemoveSender(RtpSenderInterface* sender) {
   }
   (*it)->internal()->Stop();
   senders_.erase(it);
+  NotifyLookupKeysChanged();
   return true;
 }
 
@@ -472,6 +476,7 @@ void RtpTransceiver::AddReceiver(
   RTC_DCHECK_EQ(media_type(), receiver->media_type());
   RTC_DCHECK(!absl::c_linear_search(receivers_, receiver));
   receivers_.push_back(receiver);
+  NotifyLookupKeysChanged();
 }
 
 bool RtpTransceiver::RemoveReceiver(RtpReceiverInterface* receiver) {
@@ -492,6 +497,7 @@ bool RtpTransceiver::RemoveReceiver(RtpReceiverInterface* receiver) {
   });
 
   receivers_.erase(it);
+  NotifyLookupKeysChanged();
   return true;
 }
 
@@ -513,6 +519,7 @@ cricket::MediaType RtpTransceiver::media_type() const {
 }
 
 absl::optional<std::string> RtpTransceiver::mid() const {
+  MutexLock lock(&mid_mutex_);
   return mid_;
 }
 
@@ -535,7 +542,7 @@ rtc::scoped_refptr<RtpReceiverInterface> RtpTransceiver::receiver() const {
 }
 
 void RtpTransceiver::set_current_direction(RtpTransceiverDirection direction) {
-  RTC_LOG(LS_INFO) << "Changing transceiver (MID=" << mid_.value_or("<not set>")
+  RTC_LOG(LS_INFO) << "Changing transceiver (MID=" << mid().value_or("<not set>")
                    << ") current direction from "
                    << (current_direction_ ? RtpTransceiverDirectionToString(
                                                 *current_direction_)
@@ -807,6 +814,28 @@ void RtpTransceiver::OnNegotiationUpdate(
     negotiated_header_extensions_ = content->rtp_header_extensions();
 }
 
+bool RtpTransceiver::IsContentApplied(
+    cricket::ContentSource source,
+    SdpType sdp_type,
+    const cricket::MediaContentDescription& content) const {
+  RTC_DCHECK_RUN_ON(thread_);
+  const AppliedContent& applied = applied_contents_[source];
+  // A shared content that is still the same object has not been modified.
+  return applied.content && applied.sdp_type == sdp_type &&
+         (applied.content.get() == &content ||
+          applied.content->IsEquivalent(content));
+}
+
+void RtpTransceiver::OnContentApplied(
+    cricket::ContentSource source,
+    SdpType sdp_type,
+    std::shared_ptr<const cricket::MediaContentDescription> content) {
+  RTC_DCHECK_RUN_ON(thread_);
+  AppliedContent& applied = applied_contents_[source];
+  applied.sdp_type = sdp_type;
+  applied.content = std::move(content);
+}
+
 void RtpTransceiver::SetPeerConnectionClosed() {
   is_pc_closed_ = true;
 }
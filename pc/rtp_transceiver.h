@@ -13,6 +13,7 @@
 
 #include <stddef.h>
 
+#include <array>
 #include <functional>
 #include <memory>
 #include <string>
@@ -47,6 +48,7 @@
 #include "pc/rtp_sender_proxy.h"
 #include "pc/rtp_transport_internal.h"
 #include "pc/session_description.h"
+#include "rtc_base/synchronization/mutex.h"
 #include "rtc_base/thread_annotations.h"
 
 namespace cricket {
@@ -87,6 +89,17 @@ class PeerConnectionSdpMethods;
 // will have VideoRtpSenders, VideoRtpReceivers, and a VideoChannel.
 class RtpTransceiver : public RtpTransceiverInterface {
  public:
+  // Notified on the signaling thread when the MID or the set of senders or
+  // receivers of a transceiver changes, so that lookup tables keyed on them
+  // (see TransceiverList) can be kept up to date.
+  class LookupObserver {
+   public:
+    virtual void OnLookupKeysChanged(RtpTransceiver* transceiver) = 0;
+
+   protected:
+    virtual ~LookupObserver() = default;
+  };
+
   // Construct a Plan B-style RtpTransceiver with no senders, receivers, or
   // channel set.
   // `media_type` specifies the type of RtpTransceiver (and, by transitivity,
@@ -211,7 +224,20 @@ class RtpTransceiver : public RtpTransceiverInterface {
   // Sets the MID for this transceiver. If the MID is not null, then the
   // transceiver is considered "associated" with the media section that has the
   // same MID.
-  void set_mid(const absl::optional<std::string>& mid) { mid_ = mid; }
+  void set_mid(const absl::optional<std::string>& mid) {
+    {
+      MutexLock lock(&mid_mutex_);
+      mid_ = mid;
+    }
+    NotifyLookupKeysChanged();
+  }
+
+  // Sets the observer to notify when the MID, senders or receivers change.
+  // At most one observer can be set; pass null to clear it.
+  void SetLookupObserver(LookupObserver* observer) {
+    RTC_DCHECK(!observer || !lookup_observer_);
+    lookup_observer_ = observer;
+  }
 
   // Sets the intended direction for this transceiver. Intended to be used
   // internally over SetDirection since this does not trigger a negotiation
@@ -296,6 +322,21 @@ class RtpTransceiver : public RtpTransceiverInterface {
   void OnNegotiationUpdate(SdpType sdp_type,
                            const cricket::MediaContentDescription* content);
 
+  // Returns true if `content` is equivalent to the content last applied to the
+  // channel from `source` with `sdp_type`. Applying it again would not change
+  // the channel, so renegotiations skip the media sections that are unchanged.
+  bool IsContentApplied(cricket::ContentSource source,
+                        SdpType sdp_type,
+                        const cricket::MediaContentDescription& content) const;
+  // Remembers the content applied to the channel from `source`. A null
+  // `content` forgets it, e.g. when it failed to apply. The content is shared
+  // with the applied description (see ContentInfo::shared_media_description),
+  // so remembering it does not copy it.
+  void OnContentApplied(
+      cricket::ContentSource source,
+      SdpType sdp_type,
+      std::shared_ptr<const cricket::MediaContentDescription> content);
+
  private:
   cricket::MediaEngineInterface* media_engine() const {
     return context_->media_engine();
@@ -307,6 +348,11 @@ class RtpTransceiver : public RtpTransceiverInterface {
   // are updated before deleting it.
   void PushNewMediaChannelAndDeleteChannel(
       std::unique_ptr<cricket::ChannelInterface> channel_to_delete);
+  void NotifyLookupKeysChanged() {
+    if (lookup_observer_) {
+      lookup_observer_->OnLookupKeysChanged(this);
+    }
+  }
 
   // Enforce that this object is created, used and destroyed on one thread.
   TaskQueueBase* const thread_;
@@ -325,7 +371,9 @@ class RtpTransceiver : public RtpTransceiverInterface {
   RtpTransceiverDirection direction_ = RtpTransceiverDirection::kInactive;
   absl::optional<RtpTransceiverDirection> current_direction_;
   absl::optional<RtpTransceiverDirection> fired_direction_;
-  absl::optional<std::string> mid_;
+  // Protected by a lock so that the proxy can read it on any thread.
+  mutable Mutex mid_mutex_;
+  absl::optional<std::string> mid_ RTC_GUARDED_BY(mid_mutex_);
   absl::optional<size_t> mline_index_;
   bool created_by_addtrack_ = false;
   bool reused_for_addtrack_ = false;
@@ -345,14 +393,23 @@ class RtpTransceiver : public RtpTransceiverInterface {
   cricket::RtpHeaderExtensions negotiated_header_extensions_
       RTC_GUARDED_BY(thread_);
 
+  struct AppliedContent {
+    SdpType sdp_type = SdpType::kOffer;
+    std::shared_ptr<const cricket::MediaContentDescription> content;
+  };
+  // The contents last applied to `channel_`, indexed by ContentSource.
+  // Cleared when the channel changes.
+  std::array<AppliedContent, 2> applied_contents_ RTC_GUARDED_BY(thread_);
+
   const std::function<void()> on_negotiation_needed_;
+  LookupObserver* lookup_observer_ = nullptr;
 };
 
 BEGIN_PRIMARY_PROXY_MAP(RtpTransceiver)
 
 PROXY_PRIMARY_THREAD_DESTRUCTOR()
 BYPASS_PROXY_CONSTMETHOD0(cricket::MediaType, media_type)
-PROXY_CONSTMETHOD0(absl::optional<std::string>, mid)
+SNAPSHOT_PROXY_CONSTMETHOD0(absl::optional<std::string>, mid)
 PROXY_CONSTMETHOD0(rtc::scoped_refptr<RtpSenderInterface>, sender)
 PROXY_CONSTMETHOD0(rtc::scoped_refptr<RtpReceiverInterface>, receiver)
 PROXY_CONSTMETHOD0(bool, stopped)
@@ -20,11 +20,14 @@
 #include "api/environment/environment_factory.h"
 #include "api/peer_connection_interface.h"
 #include "api/rtp_parameters.h"
+#include "media/base/codec.h"
 #include "media/base/media_engine.h"
+#include "pc/session_description.h"
 #include "pc/test/enable_fake_media.h"
 #include "pc/test/mock_channel_interface.h"
 #include "pc/test/mock_rtp_receiver_internal.h"
 #include "pc/test/mock_rtp_sender_internal.h"
+#include "pc/transceiver_list.h"
 #include "rtc_base/thread.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
@@ -134,6 +137,46 @@ TEST_F(RtpTransceiverTest, CanUnsetChannelOnStoppedTransceiver) {
   EXPECT_EQ(nullptr, transceiver->channel());
 }
 
+// Checks that the applied content is remembered per source, and forgotten
+// when the channel is cleared.
+TEST_F(RtpTransceiverTest, RemembersAppliedContentForTheChannel) {
+  const std::string content_name("my_mid");
+  auto transceiver = rtc::make_ref_counted<RtpTransceiver>(
+      cricket::MediaType::MEDIA_TYPE_VIDEO, context());
+  auto channel = std::make_unique<cricket::MockChannelInterface>();
+  EXPECT_CALL(*channel, media_type())
+      .WillRepeatedly(Return(cricket::MediaType::MEDIA_TYPE_VIDEO));
+  EXPECT_CALL(*channel, mid()).WillRepeatedly(ReturnRef(content_name));
+  EXPECT_CALL(*channel, SetFirstPacketReceivedCallback(_))
+      .WillRepeatedly(testing::Return());
+  EXPECT_CALL(*channel, SetRtpTransport(_)).WillRepeatedly(Return(true));
+  transceiver->SetChannel(std::move(channel),
+                          [](const std::string&) { return nullptr; });
+
+  cricket::VideoContentDescription content;
+  content.AddCodec(cricket::CreateVideoCodec(96, "VP8"));
+  EXPECT_FALSE(transceiver->IsContentApplied(cricket::CS_LOCAL,
+                                             SdpType::kOffer, content));
+  transceiver->OnContentApplied(cricket::CS_LOCAL, SdpType::kOffer,
+                                content.Clone());
+  EXPECT_TRUE(transceiver->IsContentApplied(cricket::CS_LOCAL,
+                                            SdpType::kOffer, content));
+  EXPECT_FALSE(transceiver->IsContentApplied(cricket::CS_LOCAL,
+                                             SdpType::kAnswer, content));
+  EXPECT_FALSE(transceiver->IsContentApplied(cricket::CS_REMOTE,
+                                             SdpType::kOffer, content));
+
+  content.set_direction(RtpTransceiverDirection::kRecvOnly);
+  EXPECT_FALSE(transceiver->IsContentApplied(cricket::CS_LOCAL,
+                                             SdpType::kOffer, content));
+  transceiver->OnContentApplied(cricket::CS_LOCAL, SdpType::kOffer,
+                                content.Clone());
+
+  transceiver->ClearChannel();
+  EXPECT_FALSE(transceiver->IsContentApplied(cricket::CS_LOCAL,
+                                             SdpType::kOffer, content));
+}
+
 class RtpTransceiverUnifiedPlanTest : public RtpTransceiverTest {
  public:
   RtpTransceiverUnifiedPlanTest()
@@ -188,6 +231,37 @@ TEST_F(RtpTransceiverUnifiedPlanTest, StopSetsDirection) {
             *transceiver_->current_direction());
 }
 
+// Checks that a TransceiverList finds the transceiver by its current MID and
+// its sender and receiver by id.
+TEST_F(RtpTransceiverUnifiedPlanTest, TransceiverListLookups) {
+  EXPECT_CALL(*sender_.get(), id()).WillRepeatedly(Return("sender"));
+  EXPECT_CALL(*receiver_.get(), id()).WillRepeatedly(Return("receiver"));
+  auto proxy = RtpTransceiverProxyWithInternal<RtpTransceiver>::Create(
+      rtc::Thread::Current(), transceiver_);
+  TransceiverList transceivers;
+  transceivers.Add(proxy);
+
+  EXPECT_EQ(transceivers.FindByMid("0"), nullptr);
+  transceiver_->set_mid("0");
+  EXPECT_EQ(transceivers.FindByMid("0"), proxy);
+  transceiver_->set_mid("1");
+  EXPECT_EQ(transceivers.FindByMid("0"), nullptr);
+  EXPECT_EQ(transceivers.FindByMid("1"), proxy);
+
+  EXPECT_EQ(transceivers.FindBySender(transceiver_->sender()), proxy);
+  EXPECT_EQ(transceivers.FindSenderById("sender"), transceiver_->sender());
+  EXPECT_EQ(transceivers.FindReceiverById("receiver"),
+            transceiver_->receiver());
+  EXPECT_EQ(transceivers.FindSenderById("receiver"), nullptr);
+
+  transceivers.Remove(proxy);
+  EXPECT_EQ(transceivers.FindByMid("1"), nullptr);
+  EXPECT_EQ(transceivers.FindSenderById("sender"), nullptr);
+  // The removed transceiver no longer notifies the list.
+  transceiver_->set_mid("2");
+  EXPECT_EQ(transceivers.FindByMid("2"), nullptr);
+}
+
 class RtpTransceiverTestForHeaderExtensions : public RtpTransceiverTest {
  public:
   RtpTransceiverTestForHeaderExtensions()
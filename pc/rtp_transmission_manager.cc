@@ -700,27 +700,13 @@ RtpTransmissionManager::FindSenderForTrack(
 rtc::scoped_refptr<RtpSenderProxyWithInternal<RtpSenderInternal>>
 RtpTransmissionManager::FindSenderById(const std::string& sender_id) const {
   RTC_DCHECK_RUN_ON(signaling_thread());
-  for (const auto& transceiver : transceivers_.List()) {
-    for (auto sender : transceiver->internal()->senders()) {
-      if (sender->id() == sender_id) {
-        return sender;
-      }
-    }
-  }
-  return nullptr;
+  return transceivers_.FindSenderById(sender_id);
 }
 
 rtc::scoped_refptr<RtpReceiverProxyWithInternal<RtpReceiverInternal>>
 RtpTransmissionManager::FindReceiverById(const std::string& receiver_id) const {
   RTC_DCHECK_RUN_ON(signaling_thread());
-  for (const auto& transceiver : transceivers_.List()) {
-    for (auto receiver : transceiver->internal()->receivers()) {
-      if (receiver->id() == receiver_id) {
-        return receiver;
-      }
-    }
-  }
-  return nullptr;
+  return transceivers_.FindReceiverById(receiver_id);
 }
 
 cricket::MediaEngineInterface* RtpTransmissionManager::media_engine() const {
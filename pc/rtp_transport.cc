@@ -190,7 +190,10 @@ void RtpTransport::DemuxPacket(rtc::CopyOnWriteBuffer packet,
                                   packet_time_us == -1
                                       ? Timestamp::MinusInfinity()
                                       : Timestamp::Micros(packet_time_us));
-  if (!parsed_packet.Parse(std::move(packet))) {
+  // Most packets are demuxed by SSRC alone, so only index the header
+  // extensions once something asks for them.
+  if (!parsed_packet.Parse(std::move(packet),
+                           RtpPacket::ExtensionParsing::kLazy)) {
     RTC_LOG(LS_ERROR)
         << "Failed to parse the incoming RTP packet before demuxing. Drop it.";
     return;
@@ -274,7 +277,7 @@ void RtpTransport::OnReadPacket(rtc::PacketTransportInternal* transport,
     return;
   }
 
-  rtc::CopyOnWriteBuffer packet(data, len);
+  rtc::CopyOnWriteBuffer packet = receive_buffer_pool_->Create(data, len);
   if (packet_type == cricket::RtpPacketType::kRtcp) {
     OnRtcpPacketReceived(std::move(packet), packet_time_us);
   } else {
@@ -17,6 +17,8 @@
 #include <string>
 
 #include "absl/types/optional.h"
+#include "api/make_ref_counted.h"
+#include "api/scoped_refptr.h"
 #include "api/task_queue/pending_task_safety_flag.h"
 #include "call/rtp_demuxer.h"
 #include "call/video_receive_stream.h"
@@ -142,6 +144,9 @@ class RtpTransport : public RtpTransportInternal {
   // Guard against recursive "ready to send" signals
   bool processing_ready_to_send_ = false;
   bool processing_sent_packet_ = false;
+  // Storage for received packets, recycled once the packet has been consumed.
+  const rtc::scoped_refptr<rtc::CopyOnWriteBufferPool> receive_buffer_pool_ =
+      rtc::make_ref_counted<rtc::CopyOnWriteBufferPool>();
   ScopedTaskSafety safety_;
 };
 
@@ -14,11 +14,14 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
+#include "absl/functional/any_invocable.h"
 #include "media/sctp/sctp_transport_internal.h"
 #include "pc/proxy.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/synchronization/mutex.h"
 #include "rtc_base/system/unused.h"
 #include "rtc_base/thread.h"
 
@@ -187,6 +190,10 @@ class SctpDataChannel::ObserverAdapter : public DataChannelObserver {
     RTC_DCHECK_RUN_ON(signaling_thread());
     delegate_ = delegate;
     safety_.reset(PendingTaskSafetyFlag::CreateDetached());
+    // Callbacks that haven't been delivered yet were meant for the previous
+    // delegate. The task that would have delivered them is cancelled above.
+    MutexLock lock(&pending_callbacks_mutex_);
+    pending_callbacks_.clear();
   }
 
   static void DeleteOnSignalingThread(
@@ -233,36 +240,24 @@ class SctpDataChannel::ObserverAdapter : public DataChannelObserver {
   };
 
   void OnStateChange() override {
-    RTC_DCHECK_RUN_ON(network_thread());
-    signaling_thread()->PostTask(
-        SafeTask(safety_.flag(),
-                 [this, cached_state = std::make_unique<CachedGetters>(this)] {
-                   RTC_DCHECK_RUN_ON(signaling_thread());
-                   if (cached_state->PrepareForCallback())
-                     delegate_->OnStateChange();
-                 }));
+    PostToSignalingThread([this] {
+      RTC_DCHECK_RUN_ON(signaling_thread());
+      delegate_->OnStateChange();
+    });
   }
 
   void OnMessage(const DataBuffer& buffer) override {
-    RTC_DCHECK_RUN_ON(network_thread());
-    signaling_thread()->PostTask(SafeTask(
-        safety_.flag(), [this, buffer = buffer,
-                         cached_state = std::make_unique<CachedGetters>(this)] {
-          RTC_DCHECK_RUN_ON(signaling_thread());
-          if (cached_state->PrepareForCallback())
-            delegate_->OnMessage(buffer);
-        }));
+    PostToSignalingThread([this, buffer = buffer] {
+      RTC_DCHECK_RUN_ON(signaling_thread());
+      delegate_->OnMessage(buffer);
+    });
   }
 
   void OnBufferedAmountChange(uint64_t sent_data_size) override {
-    RTC_DCHECK_RUN_ON(network_thread());
-    signaling_thread()->PostTask(SafeTask(
-        safety_.flag(), [this, sent_data_size,
-                         cached_state = std::make_unique<CachedGetters>(this)] {
-          RTC_DCHECK_RUN_ON(signaling_thread());
-          if (cached_state->PrepareForCallback())
-            delegate_->OnBufferedAmountChange(sent_data_size);
-        }));
+    PostToSignalingThread([this, sent_data_size] {
+      RTC_DCHECK_RUN_ON(signaling_thread());
+      delegate_->OnBufferedAmountChange(sent_data_size);
+    });
   }
 
   bool IsOkToCallOnTheNetworkThread() override { return true; }
@@ -270,6 +265,51 @@ class SctpDataChannel::ObserverAdapter : public DataChannelObserver {
   rtc::Thread* signaling_thread() const { return signaling_thread_; }
   rtc::Thread* network_thread() const { return channel_->network_thread_; }
 
+  // Queues `callback` to be invoked on the signaling thread, with the getters
+  // returning the state of the channel at the time of queueing. All callbacks
+  // that are queued before the signaling thread gets to run are delivered by
+  // a single task, so that e.g. a burst of received messages doesn't result in
+  // one posted task per message.
+  void PostToSignalingThread(absl::AnyInvocable<void() &&> callback) {
+    RTC_DCHECK_RUN_ON(network_thread());
+    bool post_task;
+    {
+      MutexLock lock(&pending_callbacks_mutex_);
+      post_task = pending_callbacks_.empty();
+      pending_callbacks_.push_back(
+          {std::make_unique<CachedGetters>(this), std::move(callback)});
+    }
+    if (post_task) {
+      signaling_thread()->PostTask(
+          SafeTask(safety_.flag(), [this, safety = safety_.flag()] {
+            DeliverPendingCallbacks(safety);
+          }));
+    }
+  }
+
+  void DeliverPendingCallbacks(
+      const rtc::scoped_refptr<PendingTaskSafetyFlag>& safety) {
+    RTC_DCHECK_RUN_ON(signaling_thread());
+    std::vector<PendingCallback> callbacks;
+    {
+      MutexLock lock(&pending_callbacks_mutex_);
+      callbacks.swap(pending_callbacks_);
+    }
+    for (PendingCallback& pending : callbacks) {
+      // A previous callback may have changed the delegate.
+      if (!safety->alive())
+        return;
+      if (pending.cached_getters->PrepareForCallback())
+        std::move(pending.callback)();
+      pending.cached_getters = nullptr;
+    }
+  }
+
+  struct PendingCallback {
+    std::unique_ptr<CachedGetters> cached_getters;
+    absl::AnyInvocable<void() &&> callback;
+  };
+
   DataChannelObserver* delegate_ RTC_GUARDED_BY(signaling_thread()) = nullptr;
   SctpDataChannel* const channel_;
   // Make sure to keep our own signaling_thread_ pointer to avoid dereferencing
@@ -278,6 +318,9 @@ class SctpDataChannel::ObserverAdapter : public DataChannelObserver {
   ScopedTaskSafety safety_;
   rtc::scoped_refptr<PendingTaskSafetyFlag> signaling_safety_;
   CachedGetters* cached_getters_ RTC_GUARDED_BY(signaling_thread()) = nullptr;
+  Mutex pending_callbacks_mutex_;
+  std::vector<PendingCallback> pending_callbacks_
+      RTC_GUARDED_BY(pending_callbacks_mutex_);
 };
 
 // static
@@ -665,7 +708,8 @@ DataChannelStats SctpDataChannel::GetStats() const {
   RTC_DCHECK_RUN_ON(network_thread_);
   DataChannelStats stats{internal_id_,        id(),         label(),
                          protocol(),          state(),      messages_sent(),
-                         messages_received(), bytes_sent(), bytes_received()};
+                         messages_received(), bytes_sent(), bytes_received(),
+                         buffered_amount()};
   return stats;
 }
 
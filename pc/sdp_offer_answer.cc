@@ -51,6 +51,7 @@
 #include "pc/rtp_receiver_proxy.h"
 #include "pc/rtp_sender.h"
 #include "pc/rtp_sender_proxy.h"
+#include "pc/setup_timeline.h"
 #include "pc/simulcast_description.h"
 #include "pc/usage_pattern.h"
 #include "pc/used_ids.h"
@@ -1386,6 +1387,7 @@ void SdpOfferAnswerHandler::Initialize(
           [this](const rtc::scoped_refptr<rtc::RTCCertificate>& certificate) {
             RTC_DCHECK_RUN_ON(signaling_thread());
             transport_controller_s()->SetLocalCertificate(certificate);
+            pc_->NoteSetupPhase(SetupPhase::kCertificateReady);
           },
           pc_->trials());
 
@@ -1990,8 +1992,12 @@ RTCError SdpOfferAnswerHandler::ReplaceRemoteDescription(
   const auto* local = local_description();
 
   // NOTE: This will perform a BlockingCall() to the network thread.
-  return transport_controller_s()->SetRemoteDescription(
+  RTCError error = transport_controller_s()->SetRemoteDescription(
       sdp_type, local ? local->description() : nullptr, session_desc);
+  if (error.ok()) {
+    pc_->NoteSetupPhase(SetupPhase::kTransportsCreated);
+  }
+  return error;
 }
 
 void SdpOfferAnswerHandler::ApplyRemoteDescription(
@@ -2361,17 +2367,14 @@ void SdpOfferAnswerHandler::DoSetLocalDescription(
   }
   RTC_DCHECK(local_description());
 
-  if (local_description()->GetType() == SdpType::kAnswer) {
+  const bool was_answer = local_description()->GetType() == SdpType::kAnswer;
+  if (was_answer) {
     RemoveStoppedTransceivers();
-
-    // TODO(deadbeef): We already had to hop to the network thread for
-    // MaybeStartGathering...
-    context_->network_thread()->BlockingCall(
-        [this] { port_allocator()->DiscardCandidatePool(); });
   }
 
   observer->OnSetLocalDescriptionComplete(RTCError::OK());
   pc_->NoteUsageEvent(UsageEvent::SET_LOCAL_DESCRIPTION_SUCCEEDED);
+  pc_->NoteSetupPhase(SetupPhase::kLocalDescriptionSet);
 
   // Check if negotiation is needed. We must do this after informing the
   // observer that SetLocalDescription() has completed to ensure negotiation is
@@ -2390,8 +2393,15 @@ void SdpOfferAnswerHandler::DoSetLocalDescription(
 
   // MaybeStartGathering needs to be called after informing the observer so that
   // we don't signal any candidates before signaling that SetLocalDescription
-  // completed.
-  transport_controller_s()->MaybeStartGathering();
+  // completed. The unused pooled candidates of an answer are discarded in the
+  // same hop to the network thread.
+  context_->network_thread()->BlockingCall([this, was_answer] {
+    RTC_DCHECK_RUN_ON(network_thread());
+    if (was_answer) {
+      port_allocator()->DiscardCandidatePool();
+    }
+    transport_controller_n()->MaybeStartGathering();
+  });
 }
 
 void SdpOfferAnswerHandler::DoCreateOffer(
@@ -2573,6 +2583,7 @@ void SdpOfferAnswerHandler::SetRemoteDescriptionPostProcess(bool was_answer) {
   }
 
   pc_->NoteUsageEvent(UsageEvent::SET_REMOTE_DESCRIPTION_SUCCEEDED);
+  pc_->NoteSetupPhase(SetupPhase::kRemoteDescriptionSet);
 
   // Check if negotiation is needed. We must do this after informing the
   // observer that SetRemoteDescription() has completed to ensure negotiation
@@ -3947,6 +3958,7 @@ RTCError SdpOfferAnswerHandler::UpdateTransceiverChannel(
       if (!error.ok()) {
         return error;
       }
+      pc_->NoteSetupPhase(SetupPhase::kChannelsCreated);
     }
   }
   return RTCError::OK();
@@ -4824,10 +4836,14 @@ RTCError SdpOfferAnswerHandler::PushdownMediaDescription(
     }
 
     // Push down the new SDP media section for each audio/video transceiver.
+    // Media sections that are the same as the ones already applied to their
+    // channel are skipped, so that renegotiating with many transceivers only
+    // costs a worker thread hop for the ones that changed.
+    const bool skip_unchanged_sections =
+        !pc_->trials().IsDisabled("WebRTC-SkipUnchangedMediaSections");
     auto rtp_transceivers = transceivers()->ListInternal();
-    std::vector<
-        std::pair<cricket::ChannelInterface*, const MediaContentDescription*>>
-        channels;
+    std::vector<std::pair<RtpTransceiver*, const ContentInfo*>>
+        changed_sections;
     for (const auto& transceiver : rtp_transceivers) {
       const ContentInfo* content_info =
           FindMediaSectionForTransceiver(transceiver, sdesc);
@@ -4842,7 +4858,11 @@ RTCError SdpOfferAnswerHandler::PushdownMediaDescription(
       }
 
       transceiver->OnNegotiationUpdate(type, content_desc);
-      channels.push_back(std::make_pair(channel, content_desc));
+      if (skip_unchanged_sections &&
+          transceiver->IsContentApplied(source, type, *content_desc)) {
+        continue;
+      }
+      changed_sections.push_back(std::make_pair(transceiver, content_info));
     }
 
     // This for-loop of invokes helps audio impairment during re-negotiations.
@@ -4855,16 +4875,24 @@ RTCError SdpOfferAnswerHandler::PushdownMediaDescription(
     // - bugs.webrtc.org/12462
     // - crbug.com/1157227
     // - crbug.com/1187289
-    for (const auto& entry : channels) {
+    for (const auto& entry : changed_sections) {
+      cricket::ChannelInterface* channel = entry.first->channel();
+      const MediaContentDescription* content_desc =
+          entry.second->media_description();
       std::string error;
       bool success = context_->worker_thread()->BlockingCall([&]() {
         return (source == cricket::CS_LOCAL)
-                   ? entry.first->SetLocalContent(entry.second, type, error)
-                   : entry.first->SetRemoteContent(entry.second, type, error);
+                   ? channel->SetLocalContent(content_desc, type, error)
+                   : channel->SetRemoteContent(content_desc, type, error);
       });
       if (!success) {
+        entry.first->OnContentApplied(source, type, nullptr);
         LOG_AND_RETURN_ERROR(RTCErrorType::INVALID_PARAMETER, error);
       }
+      if (skip_unchanged_sections) {
+        entry.first->OnContentApplied(source, type,
+                                      entry.second->shared_media_description());
+      }
     }
   }
   // Need complete offer/answer with an SCTP m= section before starting SCTP,
@@ -4900,19 +4928,24 @@ RTCError SdpOfferAnswerHandler::PushdownTransportDescription(
   TRACE_EVENT0("webrtc", "SdpOfferAnswerHandler::PushdownTransportDescription");
   RTC_DCHECK_RUN_ON(signaling_thread());
 
+  RTCError error;
   if (source == cricket::CS_LOCAL) {
     const SessionDescriptionInterface* sdesc = local_description();
     RTC_DCHECK(sdesc);
     const auto* remote = remote_description();
-    return transport_controller_s()->SetLocalDescription(
+    error = transport_controller_s()->SetLocalDescription(
         type, sdesc->description(), remote ? remote->description() : nullptr);
   } else {
     const SessionDescriptionInterface* sdesc = remote_description();
     RTC_DCHECK(sdesc);
     const auto* local = local_description();
-    return transport_controller_s()->SetRemoteDescription(
+    error = transport_controller_s()->SetRemoteDescription(
         type, local ? local->description() : nullptr, sdesc->description());
   }
+  if (error.ok()) {
+    pc_->NoteSetupPhase(SetupPhase::kTransportsCreated);
+  }
+  return error;
 }
 
 void SdpOfferAnswerHandler::RemoveStoppedTransceivers() {
@@ -5174,6 +5207,7 @@ RTCError SdpOfferAnswerHandler::CreateChannels(const SessionDescription& desc) {
                          "Failed to create data channel.");
   }
 
+  pc_->NoteSetupPhase(SetupPhase::kChannelsCreated);
   return RTCError::OK();
 }
 
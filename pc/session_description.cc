@@ -31,6 +31,49 @@ ContentInfo* FindContentInfoByName(ContentInfos* contents,
 
 }  // namespace
 
+bool MediaContentDescription::IsEquivalent(
+    const MediaContentDescription& other) const {
+  if (type() != other.type() || protocol_ != other.protocol_ ||
+      rtcp_mux_ != other.rtcp_mux_ ||
+      rtcp_reduced_size_ != other.rtcp_reduced_size_ ||
+      remote_estimate_ != other.remote_estimate_ ||
+      bandwidth_ != other.bandwidth_ ||
+      bandwidth_type_ != other.bandwidth_type_ ||
+      rtp_header_extensions_ != other.rtp_header_extensions_ ||
+      rtp_header_extensions_set_ != other.rtp_header_extensions_set_ ||
+      send_streams_ != other.send_streams_ ||
+      conference_mode_ != other.conference_mode_ ||
+      direction_ != other.direction_ ||
+      connection_address_ != other.connection_address_ ||
+      extmap_allow_mixed_enum_ != other.extmap_allow_mixed_enum_ ||
+      !absl::c_equal(simulcast_.send_layers(),
+                     other.simulcast_.send_layers()) ||
+      !absl::c_equal(simulcast_.receive_layers(),
+                     other.simulcast_.receive_layers()) ||
+      receive_rids_ != other.receive_rids_) {
+    return false;
+  }
+  if (const SctpDataContentDescription* sctp = as_sctp()) {
+    const SctpDataContentDescription* other_sctp = other.as_sctp();
+    if (sctp->use_sctpmap() != other_sctp->use_sctpmap() ||
+        sctp->port() != other_sctp->port() ||
+        sctp->max_message_size() != other_sctp->max_message_size()) {
+      return false;
+    }
+  }
+  if (const UnsupportedContentDescription* unsupported = as_unsupported()) {
+    if (unsupported->media_type() != other.as_unsupported()->media_type()) {
+      return false;
+    }
+  }
+  return absl::c_equal(codecs_, other.codecs_,
+                       [](const Codec& a, const Codec& b) {
+                         return a == b &&
+                                a.scalability_modes == b.scalability_modes &&
+                                a.tx_mode == b.tx_mode;
+                       });
+}
+
 const ContentInfo* FindContentInfoByName(const ContentInfos& contents,
                                          const std::string& name) {
   for (ContentInfos::const_iterator content = contents.begin();
@@ -184,7 +227,7 @@ void SessionDescription::AddContent(
 void SessionDescription::AddContent(ContentInfo&& content) {
   if (extmap_allow_mixed()) {
     // Mixed support on session level overrides setting on media level.
-    content.media_description()->set_extmap_allow_mixed_enum(
+    content.UnsharedMediaDescription()->set_extmap_allow_mixed_enum(
         MediaContentDescription::kSession);
   }
   contents_.push_back(std::move(content));
@@ -289,14 +332,22 @@ ContentInfo::ContentInfo(const ContentInfo& o)
       type(o.type),
       rejected(o.rejected),
       bundle_only(o.bundle_only),
-      description_(o.description_->Clone()) {}
+      description_(o.description_exposed_ && o.description_
+                       ? o.description_->Clone()
+                       : o.description_) {}
 
 ContentInfo& ContentInfo::operator=(const ContentInfo& o) {
+  if (this == &o) {
+    return *this;
+  }
   name = o.name;
   type = o.type;
   rejected = o.rejected;
   bundle_only = o.bundle_only;
-  description_ = o.description_->Clone();
+  description_ = o.description_exposed_ && o.description_
+                     ? o.description_->Clone()
+                     : o.description_;
+  description_exposed_ = false;
   return *this;
 }
 
@@ -305,7 +356,23 @@ const MediaContentDescription* ContentInfo::media_description() const {
 }
 
 MediaContentDescription* ContentInfo::media_description() {
+  description_exposed_ = true;
+  return UnsharedMediaDescription();
+}
+
+MediaContentDescription* ContentInfo::UnsharedMediaDescription() {
+  if (description_ && description_.use_count() > 1) {
+    description_ = description_->Clone();
+  }
   return description_.get();
 }
 
+std::shared_ptr<const MediaContentDescription>
+ContentInfo::shared_media_description() const {
+  if (description_exposed_ && description_) {
+    return description_->Clone();
+  }
+  return description_;
+}
+
 }  // namespace cricket
@@ -79,6 +79,11 @@ class MediaContentDescription {
     return nullptr;
   }
 
+  // Returns true if `other` describes the same media section, including the
+  // codec fields that Codec::operator== ignores. Must compare every field, it
+  // decides whether a renegotiated media section has to be applied again.
+  bool IsEquivalent(const MediaContentDescription& other) const;
+
   // Copy operator that returns an unique_ptr.
   // Not a virtual function.
   // If a type-specific variant of Clone() is desired, override it, or
@@ -225,9 +230,11 @@ class MediaContentDescription {
   // Codecs should be in preference order (most preferred codec first).
   const std::vector<Codec>& codecs() const { return codecs_; }
   void set_codecs(const std::vector<Codec>& codecs) { codecs_ = codecs; }
+  // Lets the codecs be updated in place, without copying all of them.
+  std::vector<Codec>& mutable_codecs() { return codecs_; }
   virtual bool has_codecs() const { return !codecs_.empty(); }
   bool HasCodec(int id) {
-    return absl::c_find_if(codecs_, [id](const cricket::Codec codec) {
+    return absl::c_find_if(codecs_, [id](const cricket::Codec& codec) {
              return codec.id == id;
            }) != codecs_.end();
   }
@@ -388,6 +395,11 @@ enum class MediaProtocolType {
 // Represents a session description section. Most information about the section
 // is stored in the description, which is a subclass of MediaContentDescription.
 // Owns the description.
+//
+// Copies of a ContentInfo share the description until one of them is accessed
+// through the non-const media_description(), which then makes a copy of its
+// own. Because the returned pointer may be used to modify the description
+// later on, a ContentInfo that has handed it out is always copied in full.
 class RTC_EXPORT ContentInfo {
  public:
   explicit ContentInfo(MediaProtocolType type) : type(type) {}
@@ -406,8 +418,14 @@ class RTC_EXPORT ContentInfo {
   MediaContentDescription* media_description();
   const MediaContentDescription* media_description() const;
 
+  // Returns a reference to the description that is not affected by later
+  // changes to this ContentInfo. Shares the description when possible.
+  std::shared_ptr<const MediaContentDescription> shared_media_description()
+      const;
+
   void set_media_description(std::unique_ptr<MediaContentDescription> desc) {
     description_ = std::move(desc);
+    description_exposed_ = false;
   }
 
   // TODO(bugs.webrtc.org/8620): Rename this to mid.
@@ -418,7 +436,14 @@ class RTC_EXPORT ContentInfo {
 
  private:
   friend class SessionDescription;
-  std::unique_ptr<MediaContentDescription> description_;
+
+  // Like media_description(), for changes made by SessionDescription that do
+  // not hand out the pointer.
+  MediaContentDescription* UnsharedMediaDescription();
+
+  std::shared_ptr<MediaContentDescription> description_;
+  // Set when a mutable pointer to `description_` has been handed out.
+  bool description_exposed_ = false;
 };
 
 typedef std::vector<std::string> ContentNames;
@@ -564,10 +589,12 @@ class SessionDescription {
         supported ? MediaContentDescription::kSession
                   : MediaContentDescription::kNo;
     for (auto& content : contents_) {
+      MediaContentDescription::ExtmapAllowMixed current_setting =
+          content.description_->extmap_allow_mixed_enum();
       // Do not set to kNo if the current setting is kMedia.
-      if (supported || content.media_description()->extmap_allow_mixed_enum() !=
-                           MediaContentDescription::kMedia) {
-        content.media_description()->set_extmap_allow_mixed_enum(
+      if (current_setting != media_level_setting &&
+          (supported || current_setting != MediaContentDescription::kMedia)) {
+        content.UnsharedMediaDescription()->set_extmap_allow_mixed_enum(
             media_level_setting);
       }
     }
@@ -9,6 +9,8 @@
  */
 #include "pc/session_description.h"
 
+#include <memory>
+
 #include "test/gtest.h"
 
 namespace cricket {
@@ -55,6 +57,24 @@ TEST(MediaContentDescriptionTest, MixedOneTwoByteHeaderSupported) {
   EXPECT_TRUE(video_desc.extmap_allow_mixed());
 }
 
+TEST(MediaContentDescriptionTest, IsEquivalent) {
+  VideoContentDescription video_desc;
+  video_desc.AddCodec(CreateVideoCodec(96, "VP8"));
+  std::unique_ptr<MediaContentDescription> copy = video_desc.Clone();
+  EXPECT_TRUE(video_desc.IsEquivalent(*copy));
+  EXPECT_FALSE(video_desc.IsEquivalent(AudioContentDescription()));
+
+  copy->set_direction(webrtc::RtpTransceiverDirection::kRecvOnly);
+  EXPECT_FALSE(video_desc.IsEquivalent(*copy));
+
+  // Scalability modes are not compared by Codec::operator==.
+  copy = video_desc.Clone();
+  copy->mutable_codecs()[0].scalability_modes.push_back(
+      webrtc::ScalabilityMode::kL1T2);
+  EXPECT_EQ(video_desc.codecs(), copy->codecs());
+  EXPECT_FALSE(video_desc.IsEquivalent(*copy));
+}
+
 TEST(SessionDescriptionTest, SetExtmapAllowMixed) {
   SessionDescription session_desc;
   session_desc.set_extmap_allow_mixed(true);
@@ -130,4 +150,55 @@ TEST(SessionDescriptionTest, AddContentTransfersExtmapAllowMixedSetting) {
                 ->extmap_allow_mixed_enum());
 }
 
+TEST(SessionDescriptionTest, CloneSharesContentUntilModified) {
+  SessionDescription session_desc;
+  session_desc.AddContent("audio", MediaProtocolType::kRtp,
+                          std::make_unique<AudioContentDescription>());
+  std::unique_ptr<SessionDescription> clone = session_desc.Clone();
+  const SessionDescription& const_desc = session_desc;
+  const SessionDescription& const_clone = *clone;
+  EXPECT_EQ(const_desc.GetContentDescriptionByName("audio"),
+            const_clone.GetContentDescriptionByName("audio"));
+
+  // Modifying the clone gives it a content of its own.
+  clone->GetContentDescriptionByName("audio")->set_bandwidth(1000);
+  EXPECT_NE(const_desc.GetContentDescriptionByName("audio"),
+            const_clone.GetContentDescriptionByName("audio"));
+  EXPECT_EQ(const_desc.GetContentDescriptionByName("audio")->bandwidth(),
+            kAutoBandwidth);
+  EXPECT_EQ(const_clone.GetContentDescriptionByName("audio")->bandwidth(),
+            1000);
+}
+
+TEST(SessionDescriptionTest, CloneCopiesContentWithHandedOutPointer) {
+  SessionDescription session_desc;
+  session_desc.AddContent("audio", MediaProtocolType::kRtp,
+                          std::make_unique<AudioContentDescription>());
+  MediaContentDescription* audio_desc =
+      session_desc.GetContentDescriptionByName("audio");
+  std::unique_ptr<SessionDescription> clone = session_desc.Clone();
+
+  // Modifications through the pointer must not affect the clone.
+  audio_desc->set_bandwidth(1000);
+  const SessionDescription& const_clone = *clone;
+  EXPECT_EQ(const_clone.GetContentDescriptionByName("audio")->bandwidth(),
+            kAutoBandwidth);
+}
+
+TEST(ContentInfoTest, SharedMediaDescriptionIsNotAffectedByChanges) {
+  ContentInfo content(MediaProtocolType::kRtp);
+  content.set_media_description(std::make_unique<AudioContentDescription>());
+  std::shared_ptr<const MediaContentDescription> shared =
+      content.shared_media_description();
+  const ContentInfo& const_content = content;
+  EXPECT_EQ(shared.get(), const_content.media_description());
+
+  content.media_description()->set_bandwidth(1000);
+  EXPECT_EQ(shared->bandwidth(), kAutoBandwidth);
+  EXPECT_EQ(const_content.media_description()->bandwidth(), 1000);
+  // The content has handed out a mutable pointer, so it is no longer shared.
+  EXPECT_NE(content.shared_media_description().get(),
+            const_content.media_description());
+}
+
 }  // namespace cricket
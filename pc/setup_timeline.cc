@@ -0,0 +1,54 @@
+/*
+ *  Copyright 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "pc/setup_timeline.h"
+
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/trace_event.h"
+
+namespace webrtc {
+
+absl::string_view SetupPhaseToString(SetupPhase phase) {
+  switch (phase) {
+    case SetupPhase::kCertificateReady:
+      return "certificateReady";
+    case SetupPhase::kTransportsCreated:
+      return "transportsCreated";
+    case SetupPhase::kChannelsCreated:
+      return "channelsCreated";
+    case SetupPhase::kLocalDescriptionSet:
+      return "localDescriptionSet";
+    case SetupPhase::kRemoteDescriptionSet:
+      return "remoteDescriptionSet";
+    case SetupPhase::kFirstCandidateGathered:
+      return "firstCandidateGathered";
+    case SetupPhase::kIceGatheringComplete:
+      return "iceGatheringComplete";
+    case SetupPhase::kIceConnected:
+      return "iceConnected";
+    case SetupPhase::kConnected:
+      return "connected";
+  }
+  RTC_CHECK_NOTREACHED();
+}
+
+void SetupTimeline::NoteSetupPhase(SetupPhase phase, Timestamp time) {
+  if (!delays_.emplace(phase, time - start_).second) {
+    return;
+  }
+  // The names are string literals, which is what the trace events require.
+  TRACE_EVENT_INSTANT1("webrtc", "PeerConnection::SetupPhase", "phase",
+                       SetupPhaseToString(phase).data());
+  RTC_LOG(LS_INFO) << "Setup phase " << SetupPhaseToString(phase)
+                   << " reached after " << ToString(time - start_);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,71 @@
+/*
+ *  Copyright 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef PC_SETUP_TIMELINE_H_
+#define PC_SETUP_TIMELINE_H_
+
+#include <map>
+
+#include "absl/strings/string_view.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+
+namespace webrtc {
+
+// The steps between creating a PeerConnection and it being connected. A phase
+// is reached when its defining event occurs for the first time.
+enum class SetupPhase : int {
+  // The local DTLS certificate has been generated, or taken from the
+  // configuration.
+  kCertificateReady,
+  // The transports of a local or remote description have been created by
+  // `JsepTransportController`.
+  kTransportsCreated,
+  // The channels of a local or remote description have been created.
+  kChannelsCreated,
+  // `SetLocalDescription` returns successfully.
+  kLocalDescriptionSet,
+  // `SetRemoteDescription` returns successfully.
+  kRemoteDescriptionSet,
+  // A local candidate is collected.
+  kFirstCandidateGathered,
+  // The ICE gathering state changes to complete.
+  kIceGatheringComplete,
+  // The standardized ICE connection state changes to connected.
+  kIceConnected,
+  // The peer connection state changes to connected, i.e. ICE and DTLS are
+  // connected.
+  kConnected,
+};
+
+// Returns the name of `phase` as used in RTCPeerConnectionStats, e.g.
+// "certificateReady".
+absl::string_view SetupPhaseToString(SetupPhase phase);
+
+// Records when each SetupPhase is first reached, relative to the creation of
+// the PeerConnection.
+class SetupTimeline {
+ public:
+  explicit SetupTimeline(Timestamp start) : start_(start) {}
+
+  // Records `time` for `phase` unless the phase has been reached before.
+  void NoteSetupPhase(SetupPhase phase, Timestamp time);
+
+  // Returns the time from the creation of the PeerConnection until each phase
+  // that has been reached.
+  const std::map<SetupPhase, TimeDelta>& delays() const { return delays_; }
+
+ private:
+  const Timestamp start_;
+  std::map<SetupPhase, TimeDelta> delays_;
+};
+
+}  // namespace webrtc
+#endif  // PC_SETUP_TIMELINE_H_
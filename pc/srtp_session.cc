@@ -167,7 +167,36 @@ bool SrtpSession::ProtectRtp(void* p, int in_len, int max_len, int* out_len) {
     RTC_LOG(LS_WARNING) << "Failed to protect SRTP packet: no SRTP Session";
     return false;
   }
+  return DoProtectRtp(p, in_len, max_len, out_len);
+}
 
+int SrtpSession::ProtectRtp(rtc::ArrayView<RtpPacketBuffer> packets) {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+  if (!session_) {
+    RTC_LOG(LS_WARNING) << "Failed to protect " << packets.size()
+                        << " SRTP packets: no SRTP Session";
+    for (RtpPacketBuffer& packet : packets) {
+      packet.ok = false;
+    }
+    return 0;
+  }
+  int num_protected = 0;
+  for (RtpPacketBuffer& packet : packets) {
+    int out_len = 0;
+    packet.ok = DoProtectRtp(packet.data, packet.len, packet.max_len, &out_len);
+    if (packet.ok) {
+      packet.len = out_len;
+      ++num_protected;
+    }
+  }
+  return num_protected;
+}
+
+bool SrtpSession::DoProtectRtp(void* p,
+                               int in_len,
+                               int max_len,
+                               int* out_len) {
+  RTC_DCHECK(session_);
   // Note: the need_len differs from the libsrtp recommendatіon to ensure
   // SRTP_MAX_TRAILER_LEN bytes of free space after the data. WebRTC
   // never includes a MKI, therefore the amount of bytes added by the
@@ -243,7 +272,33 @@ bool SrtpSession::UnprotectRtp(void* p, int in_len, int* out_len) {
     RTC_LOG(LS_WARNING) << "Failed to unprotect SRTP packet: no SRTP Session";
     return false;
   }
+  return DoUnprotectRtp(p, in_len, out_len);
+}
 
+int SrtpSession::UnprotectRtp(rtc::ArrayView<RtpPacketBuffer> packets) {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+  if (!session_) {
+    RTC_LOG(LS_WARNING) << "Failed to unprotect " << packets.size()
+                        << " SRTP packets: no SRTP Session";
+    for (RtpPacketBuffer& packet : packets) {
+      packet.ok = false;
+    }
+    return 0;
+  }
+  int num_unprotected = 0;
+  for (RtpPacketBuffer& packet : packets) {
+    int out_len = 0;
+    packet.ok = DoUnprotectRtp(packet.data, packet.len, &out_len);
+    if (packet.ok) {
+      packet.len = out_len;
+      ++num_unprotected;
+    }
+  }
+  return num_unprotected;
+}
+
+bool SrtpSession::DoUnprotectRtp(void* p, int in_len, int* out_len) {
+  RTC_DCHECK(session_);
   *out_len = in_len;
   int err = srtp_unprotect(session_, p, out_len);
   if (err != srtp_err_status_ok) {
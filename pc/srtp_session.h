@@ -16,6 +16,7 @@
 
 #include <vector>
 
+#include "api/array_view.h"
 #include "api/field_trials_view.h"
 #include "api/scoped_refptr.h"
 #include "api/sequence_checker.h"
@@ -79,6 +80,24 @@ class SrtpSession {
   bool UnprotectRtp(void* data, int in_len, int* out_len);
   bool UnprotectRtcp(void* data, int in_len, int* out_len);
 
+  // A packet in a batch passed to the batched ProtectRtp() and UnprotectRtp().
+  // The packet at `data` is transformed in-place and `len` is updated to the
+  // resulting length.
+  struct RtpPacketBuffer {
+    void* data = nullptr;
+    int len = 0;
+    // Size of the buffer at `data`. Only used when protecting.
+    int max_len = 0;
+    // Whether the packet was transformed successfully.
+    bool ok = false;
+  };
+  // Encrypts/signs or decrypts/verifies a batch of RTP packets, in-place.
+  // The per-call session checks are done once for the whole batch, and a
+  // failure for one packet does not affect the others. Returns the number of
+  // packets that were transformed successfully.
+  int ProtectRtp(rtc::ArrayView<RtpPacketBuffer> packets);
+  int UnprotectRtp(rtc::ArrayView<RtpPacketBuffer> packets);
+
   // Helper method to get authentication params.
   bool GetRtpAuthParams(uint8_t** key, int* key_len, int* tag_len);
 
@@ -121,6 +140,10 @@ class SrtpSession {
                  const uint8_t* key,
                  size_t len,
                  const std::vector<int>& extension_ids);
+  // Per-packet part of ProtectRtp() and UnprotectRtp(), `session_` must be
+  // set.
+  bool DoProtectRtp(void* data, int in_len, int max_len, int* out_len);
+  bool DoUnprotectRtp(void* data, int in_len, int* out_len);
   // Returns send stream current packet index from srtp db.
   bool GetSendStreamPacketIndex(void* data, int in_len, int64_t* index);
 
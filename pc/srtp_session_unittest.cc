@@ -283,4 +283,38 @@ TEST_F(SrtpSessionTest, RemoveSsrc) {
   EXPECT_TRUE(s2_.RemoveSsrcFromSession(1));
 }
 
+TEST_F(SrtpSessionTest, ProtectAndUnprotectBatch) {
+  EXPECT_TRUE(s1_.SetSend(kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen,
+                          kEncryptedHeaderExtensionIds));
+  EXPECT_TRUE(s2_.SetRecv(kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen,
+                          kEncryptedHeaderExtensionIds));
+  constexpr int kNumPackets = 3;
+  char packets[kNumPackets][sizeof(kPcmuFrame) + 10];
+  cricket::SrtpSession::RtpPacketBuffer batch[kNumPackets];
+  for (int i = 0; i < kNumPackets; ++i) {
+    memcpy(packets[i], kPcmuFrame, rtp_len_);
+    SetBE16(reinterpret_cast<uint8_t*>(packets[i]) + 2, 100 + i);
+    batch[i] = {.data = packets[i], .len = rtp_len_,
+                .max_len = sizeof(packets[i])};
+  }
+
+  EXPECT_EQ(s1_.ProtectRtp(batch), kNumPackets);
+  for (const auto& packet : batch) {
+    EXPECT_TRUE(packet.ok);
+    EXPECT_EQ(packet.len, rtp_len_ + rtp_auth_tag_len(kCsAesCm128HmacSha1_80));
+  }
+
+  // Tamper with the middle packet; the others must still be unprotected.
+  packets[1][rtp_len_ - 1] ^= 0x01;
+  EXPECT_EQ(s2_.UnprotectRtp(batch), kNumPackets - 1);
+  EXPECT_TRUE(batch[0].ok);
+  EXPECT_FALSE(batch[1].ok);
+  EXPECT_TRUE(batch[2].ok);
+  for (int i : {0, 2}) {
+    EXPECT_EQ(batch[i].len, rtp_len_);
+    EXPECT_EQ(GetBE16(reinterpret_cast<uint8_t*>(packets[i]) + 2), 100 + i);
+    EXPECT_EQ(0, memcmp(packets[i] + 4, kPcmuFrame + 4, rtp_len_ - 4));
+  }
+}
+
 }  // namespace rtc
@@ -333,6 +333,7 @@ class FakePeerConnectionBase : public PeerConnectionInternal {
   void SetIceConnectionState(
       PeerConnectionInterface::IceConnectionState new_state) override {}
   void NoteUsageEvent(UsageEvent event) override {}
+  void NoteSetupPhase(SetupPhase phase) override {}
   bool IsClosed() const override { return false; }
   bool IsUnifiedPlan() const override { return true; }
   bool ValidateBundleSettings(
@@ -386,6 +386,10 @@ class FakePeerConnectionForStats : public FakePeerConnectionBase {
 
   void SetCallStats(const Call::Stats& call_stats) { call_stats_ = call_stats; }
 
+  void SetSetupTimeline(std::map<SetupPhase, TimeDelta> setup_timeline) {
+    setup_timeline_ = std::move(setup_timeline);
+  }
+
   void SetAudioDeviceStats(
       absl::optional<AudioDeviceModule::Stats> audio_device_stats) {
     audio_device_stats_ = audio_device_stats;
@@ -456,6 +460,10 @@ class FakePeerConnectionForStats : public FakePeerConnectionBase {
     return stats;
   }
 
+  std::map<SetupPhase, TimeDelta> GetSetupTimeline() const override {
+    return setup_timeline_;
+  }
+
   cricket::CandidateStatsList GetPooledCandidateStats() const override {
     return {};
   }
@@ -556,6 +564,7 @@ class FakePeerConnectionForStats : public FakePeerConnectionBase {
   std::map<std::string, cricket::TransportStats> transport_stats_by_name_;
 
   Call::Stats call_stats_;
+  std::map<SetupPhase, TimeDelta> setup_timeline_;
 
   absl::optional<AudioDeviceModule::Stats> audio_device_stats_;
 
@@ -245,6 +245,7 @@ class MockPeerConnectionInternal : public PeerConnectionInternal {
               (PeerConnectionInterface::IceConnectionState),
               (override));
   MOCK_METHOD(void, NoteUsageEvent, (UsageEvent), (override));
+  MOCK_METHOD(void, NoteSetupPhase, (SetupPhase), (override));
   MOCK_METHOD(bool, IsClosed, (), (const, override));
   MOCK_METHOD(bool, IsUnifiedPlan, (), (const, override));
   MOCK_METHOD(bool,
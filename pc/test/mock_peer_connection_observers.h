@@ -124,6 +124,12 @@ class MockPeerConnectionObserver : public PeerConnectionObserver {
     callback_triggered_ = true;
   }
 
+  void OnIceCandidatesBatch(
+      const std::vector<const IceCandidateInterface*>& candidates) override {
+    num_candidate_batches_++;
+    PeerConnectionObserver::OnIceCandidatesBatch(candidates);
+  }
+
   void OnIceCandidatesRemoved(
       const std::vector<cricket::Candidate>& candidates) override {
     num_candidates_removed_++;
@@ -247,6 +253,7 @@ class MockPeerConnectionObserver : public PeerConnectionObserver {
   std::vector<rtc::scoped_refptr<RtpTransceiverInterface>>
       on_track_transceivers_;
   int num_candidates_removed_ = 0;
+  int num_candidate_batches_ = 0;
 
  private:
   rtc::scoped_refptr<MediaStreamInterface> last_added_stream_;
@@ -10,12 +10,34 @@
 
 #include "pc/transceiver_list.h"
 
+#include <algorithm>
+#include <map>
 #include <string>
+#include <utility>
 
 #include "rtc_base/checks.h"
 
 namespace webrtc {
 
+namespace {
+
+// Returns the entry for `key` in `index` that was added to the list first.
+template <typename IndexedKeys>
+const IndexedKeys* FindFirst(
+    const std::multimap<std::string, const IndexedKeys*>& index,
+    const std::string& key) {
+  const IndexedKeys* found = nullptr;
+  auto [begin, end] = index.equal_range(key);
+  for (auto it = begin; it != end; ++it) {
+    if (!found || it->second->order < found->order) {
+      found = it->second;
+    }
+  }
+  return found;
+}
+
+}  // namespace
+
 void TransceiverStableState::set_newly_created() {
   RTC_DCHECK(!has_m_section_);
   newly_created_ = true;
@@ -52,26 +74,107 @@ std::vector<RtpTransceiver*> TransceiverList::ListInternal() const {
   return internals;
 }
 
+TransceiverList::~TransceiverList() {
+  for (auto& [transceiver, keys] : indexed_keys_) {
+    keys.transceiver->internal()->SetLookupObserver(nullptr);
+  }
+}
+
+void TransceiverList::Add(RtpTransceiverProxyRefPtr transceiver) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  transceivers_.push_back(transceiver);
+  auto [it, inserted] = indexed_keys_.emplace(
+      transceiver->internal(), IndexedKeys{transceiver, next_order_++});
+  RTC_DCHECK(inserted) << "Transceiver added twice";
+  Index(it->second);
+  transceiver->internal()->SetLookupObserver(this);
+}
+
+void TransceiverList::Remove(RtpTransceiverProxyRefPtr transceiver) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  transceivers_.erase(
+      std::remove(transceivers_.begin(), transceivers_.end(), transceiver),
+      transceivers_.end());
+  auto it = indexed_keys_.find(transceiver->internal());
+  if (it == indexed_keys_.end()) {
+    return;
+  }
+  transceiver->internal()->SetLookupObserver(nullptr);
+  Unindex(it->second);
+  indexed_keys_.erase(it);
+}
+
+void TransceiverList::OnLookupKeysChanged(RtpTransceiver* transceiver) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  auto it = indexed_keys_.find(transceiver);
+  RTC_DCHECK(it != indexed_keys_.end());
+  Unindex(it->second);
+  Index(it->second);
+}
+
+void TransceiverList::Index(IndexedKeys& keys) {
+  RtpTransceiver* transceiver = keys.transceiver->internal();
+  keys.mid = transceiver->mid();
+  if (keys.mid) {
+    transceivers_by_mid_.emplace(*keys.mid, &keys);
+  }
+  keys.sender_ids.clear();
+  for (const auto& sender : transceiver->senders()) {
+    keys.sender_ids.push_back(sender->internal()->id());
+    transceivers_by_sender_id_.emplace(keys.sender_ids.back(), &keys);
+  }
+  keys.receiver_ids.clear();
+  for (const auto& receiver : transceiver->receivers()) {
+    keys.receiver_ids.push_back(receiver->internal()->id());
+    transceivers_by_receiver_id_.emplace(keys.receiver_ids.back(), &keys);
+  }
+}
+
+void TransceiverList::Unindex(const IndexedKeys& keys) {
+  auto erase = [&keys](std::multimap<std::string, const IndexedKeys*>& index,
+                       const std::string& key) {
+    auto [begin, end] = index.equal_range(key);
+    for (auto it = begin; it != end; ++it) {
+      if (it->second == &keys) {
+        index.erase(it);
+        return;
+      }
+    }
+    RTC_DCHECK_NOTREACHED();
+  };
+  if (keys.mid) {
+    erase(transceivers_by_mid_, *keys.mid);
+  }
+  for (const std::string& id : keys.sender_ids) {
+    erase(transceivers_by_sender_id_, id);
+  }
+  for (const std::string& id : keys.receiver_ids) {
+    erase(transceivers_by_receiver_id_, id);
+  }
+}
+
 RtpTransceiverProxyRefPtr TransceiverList::FindBySender(
     rtc::scoped_refptr<RtpSenderInterface> sender) const {
   RTC_DCHECK_RUN_ON(&sequence_checker_);
-  for (auto transceiver : transceivers_) {
-    if (transceiver->sender() == sender) {
-      return transceiver;
+  if (!sender) {
+    return nullptr;
+  }
+  const IndexedKeys* found = nullptr;
+  auto [begin, end] = transceivers_by_sender_id_.equal_range(sender->id());
+  for (auto it = begin; it != end; ++it) {
+    if ((!found || it->second->order < found->order) &&
+        it->second->transceiver->sender() == sender) {
+      found = it->second;
     }
   }
-  return nullptr;
+  return found ? found->transceiver : nullptr;
 }
 
 RtpTransceiverProxyRefPtr TransceiverList::FindByMid(
     const std::string& mid) const {
   RTC_DCHECK_RUN_ON(&sequence_checker_);
-  for (auto transceiver : transceivers_) {
-    if (transceiver->mid() == mid) {
-      return transceiver;
-    }
-  }
-  return nullptr;
+  const IndexedKeys* found = FindFirst(transceivers_by_mid_, mid);
+  return found ? found->transceiver : nullptr;
 }
 
 RtpTransceiverProxyRefPtr TransceiverList::FindByMLineIndex(
@@ -85,4 +188,37 @@ RtpTransceiverProxyRefPtr TransceiverList::FindByMLineIndex(
   return nullptr;
 }
 
+rtc::scoped_refptr<RtpSenderProxyWithInternal<RtpSenderInternal>>
+TransceiverList::FindSenderById(const std::string& sender_id) const {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  const IndexedKeys* found = FindFirst(transceivers_by_sender_id_, sender_id);
+  if (!found) {
+    return nullptr;
+  }
+  for (const auto& sender : found->transceiver->internal()->senders()) {
+    if (sender->internal()->id() == sender_id) {
+      return sender;
+    }
+  }
+  RTC_DCHECK_NOTREACHED();
+  return nullptr;
+}
+
+rtc::scoped_refptr<RtpReceiverProxyWithInternal<RtpReceiverInternal>>
+TransceiverList::FindReceiverById(const std::string& receiver_id) const {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  const IndexedKeys* found =
+      FindFirst(transceivers_by_receiver_id_, receiver_id);
+  if (!found) {
+    return nullptr;
+  }
+  for (const auto& receiver : found->transceiver->internal()->receivers()) {
+    if (receiver->internal()->id() == receiver_id) {
+      return receiver;
+    }
+  }
+  RTC_DCHECK_NOTREACHED();
+  return nullptr;
+}
+
 }  // namespace webrtc
@@ -12,6 +12,7 @@
 #define PC_TRANSCEIVER_LIST_H_
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include <algorithm>
 #include <map>
@@ -25,6 +26,8 @@
 #include "api/rtp_sender_interface.h"
 #include "api/scoped_refptr.h"
 #include "api/sequence_checker.h"
+#include "pc/rtp_receiver_proxy.h"
+#include "pc/rtp_sender_proxy.h"
 #include "pc/rtp_transceiver.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/system/no_unique_address.h"
@@ -91,8 +94,19 @@ class TransceiverStableState {
 // PeerConnection, and offers convenient functions on that list.
 // It is a single-thread class; all operations must be performed
 // on the same thread.
-class TransceiverList {
+//
+// Lookups by MID and by sender or receiver id are served from indices that
+// are updated when transceivers are added or removed and, through
+// RtpTransceiver::LookupObserver, when the keys of a listed transceiver
+// change. If several transceivers match, the one added first is returned.
+class TransceiverList : public RtpTransceiver::LookupObserver {
  public:
+  TransceiverList() = default;
+  ~TransceiverList();
+
+  TransceiverList(const TransceiverList&) = delete;
+  TransceiverList& operator=(const TransceiverList&) = delete;
+
   // Returns a copy of the currently active list of transceivers. The
   // list consists of rtc::scoped_refptrs, which will keep the transceivers
   // from being deallocated, even if they are removed from the TransceiverList.
@@ -111,20 +125,16 @@ class TransceiverList {
   // be consumed on the same thread.
   std::vector<RtpTransceiver*> ListInternal() const;
 
-  void Add(RtpTransceiverProxyRefPtr transceiver) {
-    RTC_DCHECK_RUN_ON(&sequence_checker_);
-    transceivers_.push_back(transceiver);
-  }
-  void Remove(RtpTransceiverProxyRefPtr transceiver) {
-    RTC_DCHECK_RUN_ON(&sequence_checker_);
-    transceivers_.erase(
-        std::remove(transceivers_.begin(), transceivers_.end(), transceiver),
-        transceivers_.end());
-  }
+  void Add(RtpTransceiverProxyRefPtr transceiver);
+  void Remove(RtpTransceiverProxyRefPtr transceiver);
   RtpTransceiverProxyRefPtr FindBySender(
       rtc::scoped_refptr<RtpSenderInterface> sender) const;
   RtpTransceiverProxyRefPtr FindByMid(const std::string& mid) const;
   RtpTransceiverProxyRefPtr FindByMLineIndex(size_t mline_index) const;
+  rtc::scoped_refptr<RtpSenderProxyWithInternal<RtpSenderInternal>>
+  FindSenderById(const std::string& sender_id) const;
+  rtc::scoped_refptr<RtpReceiverProxyWithInternal<RtpReceiverInternal>>
+  FindReceiverById(const std::string& receiver_id) const;
 
   // Find or create the stable state for a transceiver.
   TransceiverStableState* StableState(RtpTransceiverProxyRefPtr transceiver) {
@@ -143,10 +153,38 @@ class TransceiverList {
   }
 
  private:
+  // The keys under which a transceiver is currently indexed, kept so that
+  // its index entries can be found again when the keys change.
+  struct IndexedKeys {
+    RtpTransceiverProxyRefPtr transceiver;
+    // Position of the transceiver in `transceivers_` relative to the others,
+    // used to return the first match like a scan of the list would.
+    uint64_t order = 0;
+    absl::optional<std::string> mid;
+    std::vector<std::string> sender_ids;
+    std::vector<std::string> receiver_ids;
+  };
+
+  // RtpTransceiver::LookupObserver implementation.
+  void OnLookupKeysChanged(RtpTransceiver* transceiver) override;
+
+  void Index(IndexedKeys& keys);
+  void Unindex(const IndexedKeys& keys);
+
   RTC_NO_UNIQUE_ADDRESS SequenceChecker sequence_checker_;
   std::vector<RtpTransceiverProxyRefPtr> transceivers_;
   // TODO(bugs.webrtc.org/12692): Add RTC_GUARDED_BY(sequence_checker_);
 
+  uint64_t next_order_ RTC_GUARDED_BY(sequence_checker_) = 0;
+  std::map<const RtpTransceiver*, IndexedKeys> indexed_keys_
+      RTC_GUARDED_BY(sequence_checker_);
+  std::multimap<std::string, const IndexedKeys*> transceivers_by_mid_
+      RTC_GUARDED_BY(sequence_checker_);
+  std::multimap<std::string, const IndexedKeys*> transceivers_by_sender_id_
+      RTC_GUARDED_BY(sequence_checker_);
+  std::multimap<std::string, const IndexedKeys*> transceivers_by_receiver_id_
+      RTC_GUARDED_BY(sequence_checker_);
+
   // Holds changes made to transceivers during applying descriptors for
   // potential rollback. Gets cleared once signaling state goes to stable.
   std::map<RtpTransceiverProxyRefPtr, TransceiverStableState>
@@ -112,15 +112,10 @@ bool VideoTrack::enabled() const {
     RTC_DCHECK_RUN_ON(worker_thread_);
     return enabled_w_;
   }
-  RTC_DCHECK_RUN_ON(&signaling_thread_);
+  // Otherwise the atomic value is read, on any thread.
   return MediaStreamTrack<VideoTrackInterface>::enabled();
 }
 
-MediaStreamTrackInterface::TrackState VideoTrack::state() const {
-  RTC_DCHECK_RUN_ON(worker_thread_);
-  return MediaStreamTrack<VideoTrackInterface>::state();
-}
-
 void VideoTrack::OnChanged() {
   RTC_DCHECK_RUN_ON(&signaling_thread_);
   rtc::Thread::ScopedDisallowBlockingCalls no_blocking_calls;
@@ -52,7 +52,6 @@ class VideoTrack : public MediaStreamTrack<VideoTrackInterface>,
   void set_content_hint(ContentHint hint) override;
   bool set_enabled(bool enable) override;
   bool enabled() const override;
-  MediaStreamTrackInterface::TrackState state() const override;
   std::string kind() const override;
 
   // Direct access to the non-proxied source object for internal implementation.
@@ -2658,7 +2658,7 @@ static std::unique_ptr<MediaContentDescription> ParseContentDescription(
   for (int pt : payload_types) {
     payload_type_preferences[pt] = preference--;
   }
-  std::vector<cricket::Codec> codecs = media_desc->codecs();
+  std::vector<cricket::Codec>& codecs = media_desc->mutable_codecs();
   absl::c_sort(codecs, [&payload_type_preferences](const cricket::Codec& a,
                                                    const cricket::Codec& b) {
     return payload_type_preferences[a.id] > payload_type_preferences[b.id];
@@ -2666,7 +2666,6 @@ static std::unique_ptr<MediaContentDescription> ParseContentDescription(
   // Backfill any default parameters.
   BackfillCodecParameters(codecs);
 
-  media_desc->set_codecs(codecs);
   return media_desc;
 }
 
@@ -2884,42 +2883,25 @@ void AddFeedbackParameters(const cricket::FeedbackParams& feedback_params,
   }
 }
 
-// Gets the current codec setting associated with `payload_type`. If there
-// is no Codec associated with that payload type it returns an empty codec
-// with that payload type.
-cricket::Codec GetCodecWithPayloadType(
-    cricket::MediaType type,
-    const std::vector<cricket::Codec>& codecs,
+// Gets the codec associated with `payload_type` in the media description.
+// If there is no Codec associated with that payload type, an empty codec with
+// that payload type is added. The codecs are updated in place, since copying
+// all of them for each attribute line is quadratic in the number of codecs.
+cricket::Codec& GetOrAddCodecWithPayloadType(
+    MediaContentDescription* content_desc,
     int payload_type) {
-  const cricket::Codec* codec = FindCodecById(codecs, payload_type);
-  if (codec)
-    return *codec;
-  // Return empty codec with `payload_type`.
-  if (type == cricket::MEDIA_TYPE_AUDIO) {
-    return cricket::CreateAudioCodec(payload_type, "", 0, 0);
-  } else {
-    return cricket::CreateVideoCodec(payload_type, "");
-  }
-}
-
-// Updates or creates a new codec entry in the media description.
-void AddOrReplaceCodec(MediaContentDescription* content_desc,
-                       const cricket::Codec& codec) {
-  std::vector<cricket::Codec> codecs = content_desc->codecs();
-  bool found = false;
-  for (cricket::Codec& existing_codec : codecs) {
-    if (codec.id == existing_codec.id) {
-      // Overwrite existing codec with the new codec.
-      existing_codec = codec;
-      found = true;
-      break;
+  std::vector<cricket::Codec>& codecs = content_desc->mutable_codecs();
+  for (cricket::Codec& codec : codecs) {
+    if (codec.id == payload_type) {
+      return codec;
     }
   }
-  if (!found) {
-    content_desc->AddCodec(codec);
-    return;
+  if (content_desc->type() == cricket::MEDIA_TYPE_AUDIO) {
+    codecs.push_back(cricket::CreateAudioCodec(payload_type, "", 0, 0));
+  } else {
+    codecs.push_back(cricket::CreateVideoCodec(payload_type, ""));
   }
-  content_desc->set_codecs(codecs);
+  return codecs.back();
 }
 
 // Adds or updates existing codec corresponding to `payload_type` according
@@ -2928,10 +2910,8 @@ void UpdateCodec(MediaContentDescription* content_desc,
                  int payload_type,
                  const webrtc::CodecParameterMap& parameters) {
   // Codec might already have been populated (from rtpmap).
-  cricket::Codec new_codec = GetCodecWithPayloadType(
-      content_desc->type(), content_desc->codecs(), payload_type);
-  AddParameters(parameters, &new_codec);
-  AddOrReplaceCodec(content_desc, new_codec);
+  AddParameters(parameters,
+                &GetOrAddCodecWithPayloadType(content_desc, payload_type));
 }
 
 // Adds or updates existing codec corresponding to `payload_type` according
@@ -2940,10 +2920,9 @@ void UpdateCodec(MediaContentDescription* content_desc,
                  int payload_type,
                  const cricket::FeedbackParam& feedback_param) {
   // Codec might already have been populated (from rtpmap).
-  cricket::Codec new_codec = GetCodecWithPayloadType(
-      content_desc->type(), content_desc->codecs(), payload_type);
-  AddFeedbackParameter(feedback_param, &new_codec);
-  AddOrReplaceCodec(content_desc, new_codec);
+  cricket::Codec& codec =
+      GetOrAddCodecWithPayloadType(content_desc, payload_type);
+  AddFeedbackParameter(feedback_param, &codec);
 }
 
 // Adds or updates existing video codec corresponding to `payload_type`
@@ -2957,10 +2936,8 @@ void UpdateVideoCodecPacketization(MediaContentDescription* desc,
   }
 
   // Codec might already have been populated (from rtpmap).
-  cricket::Codec codec =
-      GetCodecWithPayloadType(desc->type(), desc->codecs(), payload_type);
-  codec.packetization = std::string(packetization);
-  AddOrReplaceCodec(desc, codec);
+  GetOrAddCodecWithPayloadType(desc, payload_type).packetization =
+      std::string(packetization);
 }
 
 absl::optional<cricket::Codec> PopWildcardCodec(
@@ -2978,7 +2955,7 @@ absl::optional<cricket::Codec> PopWildcardCodec(
 
 void UpdateFromWildcardCodecs(cricket::MediaContentDescription* desc) {
   RTC_DCHECK(desc);
-  auto codecs = desc->codecs();
+  std::vector<cricket::Codec>& codecs = desc->mutable_codecs();
   absl::optional<cricket::Codec> wildcard_codec = PopWildcardCodec(&codecs);
   if (!wildcard_codec) {
     return;
@@ -2986,7 +2963,6 @@ void UpdateFromWildcardCodecs(cricket::MediaContentDescription* desc) {
   for (auto& codec : codecs) {
     AddFeedbackParameters(wildcard_codec->feedback_params, &codec);
   }
-  desc->set_codecs(codecs);
 }
 
 void AddAudioAttribute(const std::string& name,
@@ -2996,11 +2972,9 @@ void AddAudioAttribute(const std::string& name,
   if (value.empty()) {
     return;
   }
-  std::vector<cricket::Codec> codecs = desc->codecs();
-  for (cricket::Codec& codec : codecs) {
+  for (cricket::Codec& codec : desc->mutable_codecs()) {
     codec.params[name] = std::string(value);
   }
-  desc->set_codecs(codecs);
 }
 
 bool ParseContent(absl::string_view message,
@@ -3544,13 +3518,11 @@ void UpdateCodec(int payload_type,
                  MediaContentDescription* desc) {
   // Codec may already be populated with (only) optional parameters
   // (from an fmtp).
-  cricket::Codec codec =
-      GetCodecWithPayloadType(desc->type(), desc->codecs(), payload_type);
+  cricket::Codec& codec = GetOrAddCodecWithPayloadType(desc, payload_type);
   codec.name = std::string(name);
   codec.clockrate = clockrate;
   codec.bitrate = bitrate;
   codec.channels = channels;
-  AddOrReplaceCodec(desc, codec);
 }
 
 // Updates or creates a new codec entry in the video description according to
@@ -3560,10 +3532,7 @@ void UpdateCodec(int payload_type,
                  MediaContentDescription* desc) {
   // Codec may already be populated with (only) optional parameters
   // (from an fmtp).
-  cricket::Codec codec =
-      GetCodecWithPayloadType(desc->type(), desc->codecs(), payload_type);
-  codec.name = std::string(name);
-  AddOrReplaceCodec(desc, codec);
+  GetOrAddCodecWithPayloadType(desc, payload_type).name = std::string(name);
 }
 
 bool ParseRtpmapAttribute(absl::string_view line,
@@ -0,0 +1,97 @@
+/*
+ *  Copyright 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string>
+
+#include "api/jsep.h"
+#include "api/jsep_session_description.h"
+#include "benchmark/benchmark.h"
+#include "pc/webrtc_sdp.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/strings/string_builder.h"
+#include "rtc_base/system/unused.h"
+
+namespace webrtc {
+namespace {
+
+// Returns an offer with `num_video_sections` video m-sections, each with the
+// codecs and the rtcp-fb and fmtp lines of a typical browser offer.
+std::string CreateOffer(int num_video_sections) {
+  rtc::StringBuilder sdp;
+  sdp << "v=0\r\n"
+         "o=- 4131505339648218884 2 IN IP4 127.0.0.1\r\n"
+         "s=-\r\n"
+         "t=0 0\r\n"
+         "a=group:BUNDLE";
+  for (int i = 0; i < num_video_sections; ++i) {
+    sdp << " " << i;
+  }
+  sdp << "\r\na=msid-semantic: WMS\r\n";
+  constexpr int kNumCodecs = 16;
+  for (int i = 0; i < num_video_sections; ++i) {
+    sdp << "m=video 9 UDP/TLS/RTP/SAVPF";
+    for (int pt = 96; pt < 96 + 2 * kNumCodecs; ++pt) {
+      sdp << " " << pt;
+    }
+    sdp << "\r\n"
+           "c=IN IP4 0.0.0.0\r\n"
+           "a=rtcp:9 IN IP4 0.0.0.0\r\n"
+           "a=ice-ufrag:ETEn\r\n"
+           "a=ice-pwd:OtSK0WpNtpUjkY4+86js7Z/l\r\n"
+           "a=fingerprint:sha-256 "
+           "19:E2:1C:3B:4B:9F:81:E6:B8:5C:F4:A5:A8:D8:73:04:BB:05:2F:70:9F:04:"
+           "A9:0E:05:E9:26:33:E8:70:88:A2\r\n"
+           "a=setup:actpass\r\n"
+        << "a=mid:" << i << "\r\n"
+        << "a=extmap:1 urn:ietf:params:rtp-hdrext:toffset\r\n"
+           "a=extmap:2 "
+           "http://www.webrtc.org/experiments/rtp-hdrext/abs-send-time\r\n"
+           "a=sendrecv\r\n"
+           "a=rtcp-mux\r\n"
+           "a=rtcp-rsize\r\n";
+    for (int pt = 96; pt < 96 + 2 * kNumCodecs; pt += 2) {
+      sdp << "a=rtpmap:" << pt << " VP8/90000\r\n"
+          << "a=rtcp-fb:" << pt << " goog-remb\r\n"
+          << "a=rtcp-fb:" << pt << " transport-cc\r\n"
+          << "a=rtcp-fb:" << pt << " ccm fir\r\n"
+          << "a=rtcp-fb:" << pt << " nack\r\n"
+          << "a=rtcp-fb:" << pt << " nack pli\r\n"
+          << "a=rtpmap:" << pt + 1 << " rtx/90000\r\n"
+          << "a=fmtp:" << pt + 1 << " apt=" << pt << "\r\n";
+    }
+  }
+  return sdp.Release();
+}
+
+void BM_SdpDeserialize(benchmark::State& state) {
+  const std::string sdp = CreateOffer(state.range(0));
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    JsepSessionDescription jdesc(SdpType::kOffer);
+    RTC_CHECK(SdpDeserialize(sdp, &jdesc, nullptr));
+    benchmark::DoNotOptimize(jdesc);
+  }
+}
+
+void BM_SdpSerialize(benchmark::State& state) {
+  JsepSessionDescription jdesc(SdpType::kOffer);
+  RTC_CHECK(SdpDeserialize(CreateOffer(state.range(0)), &jdesc, nullptr));
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    std::string sdp = SdpSerialize(jdesc);
+    benchmark::DoNotOptimize(sdp);
+  }
+}
+
+BENCHMARK(BM_SdpDeserialize)->Arg(1)->Arg(20)->Arg(200);
+BENCHMARK(BM_SdpSerialize)->Arg(1)->Arg(20)->Arg(200);
+
+}  // namespace
+}  // namespace webrtc
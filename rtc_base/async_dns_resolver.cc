@@ -10,14 +10,19 @@
 
 #include "rtc_base/async_dns_resolver.h"
 
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "absl/strings/ascii.h"
 #include "api/make_ref_counted.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/platform_thread.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+#include "rtc_base/time_utils.h"
 
 #if defined(WEBRTC_MAC) || defined(WEBRTC_IOS)
 #include <dispatch/dispatch.h>
@@ -97,6 +102,123 @@ void PostTaskToGlobalQueue(
 }
 #endif  // defined(WEBRTC_MAC) || defined(WEBRTC_IOS)
 
+// Runs `function` on a thread that may block.
+void RunDetached(std::function<void()> function) {
+#if defined(WEBRTC_MAC) || defined(WEBRTC_IOS)
+  PostTaskToGlobalQueue(
+      std::make_unique<absl::AnyInvocable<void() &&>>(std::move(function)));
+#else
+  rtc::PlatformThread::SpawnDetached(std::move(function), "AsyncResolver");
+#endif
+}
+
+using Completion = std::function<void(int, std::vector<rtc::IPAddress>)>;
+
+// The process-wide cache of resolutions shared by AsyncDnsResolvers created
+// with a DnsCacheConfig.
+class DnsCache {
+ public:
+  static DnsCache& Get() {
+    static DnsCache* const cache = new DnsCache();
+    return *cache;
+  }
+
+  // Calls `completion` with the resolution of `hostname`, from this thread if
+  // it is cached and otherwise from the thread looking it up.
+  void Resolve(absl::string_view hostname,
+               int family,
+               const DnsCacheConfig& config,
+               Completion completion) {
+    Key key(absl::AsciiStrToLower(hostname), family);
+    int error;
+    std::vector<rtc::IPAddress> addresses;
+    {
+      MutexLock lock(&mutex_);
+      auto it = entries_.find(key);
+      if (it == entries_.end()) {
+        RemoveExpiredEntries();
+        it = entries_.emplace(key, Entry()).first;
+      }
+      Entry& entry = it->second;
+      if (!entry.waiters.empty()) {
+        // A lookup is in flight.
+        entry.waiters.push_back(std::move(completion));
+        return;
+      }
+      if (rtc::TimeMillis() >= entry.expiry_ms) {
+        entry.waiters.push_back(std::move(completion));
+        ++num_lookups_;
+        RunDetached([this, key, config] { Lookup(key, config); });
+        return;
+      }
+      error = entry.error;
+      addresses = entry.addresses;
+    }
+    completion(error, std::move(addresses));
+  }
+
+  void Clear() {
+    MutexLock lock(&mutex_);
+    for (auto it = entries_.begin(); it != entries_.end();) {
+      it = it->second.waiters.empty() ? entries_.erase(it) : std::next(it);
+    }
+  }
+
+  int num_lookups() {
+    MutexLock lock(&mutex_);
+    return num_lookups_;
+  }
+
+ private:
+  using Key = std::pair<std::string, int>;
+
+  struct Entry {
+    int error = 0;
+    std::vector<rtc::IPAddress> addresses;
+    int64_t expiry_ms = 0;
+    // Resolvers waiting for the lookup in flight, if any.
+    std::vector<Completion> waiters;
+  };
+
+  // Bounds the memory used by lookups of many different hostnames.
+  static constexpr size_t kMaxEntries = 1000;
+
+  void Lookup(const Key& key, const DnsCacheConfig& config) {
+    std::vector<rtc::IPAddress> addresses;
+    int error = ResolveHostname(key.first, key.second, addresses);
+    const TimeDelta ttl =
+        error == 0 && !addresses.empty() ? config.ttl : config.negative_ttl;
+    std::vector<Completion> waiters;
+    {
+      MutexLock lock(&mutex_);
+      Entry& entry = entries_[key];
+      entry.error = error;
+      entry.addresses = addresses;
+      entry.expiry_ms = rtc::TimeMillis() + ttl.ms();
+      waiters.swap(entry.waiters);
+    }
+    for (Completion& waiter : waiters) {
+      waiter(error, addresses);
+    }
+  }
+
+  void RemoveExpiredEntries() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    if (entries_.size() < kMaxEntries) {
+      return;
+    }
+    const int64_t now_ms = rtc::TimeMillis();
+    for (auto it = entries_.begin(); it != entries_.end();) {
+      it = it->second.waiters.empty() && now_ms >= it->second.expiry_ms
+               ? entries_.erase(it)
+               : std::next(it);
+    }
+  }
+
+  Mutex mutex_;
+  std::map<Key, Entry> entries_ RTC_GUARDED_BY(mutex_);
+  int num_lookups_ RTC_GUARDED_BY(mutex_) = 0;
+};
+
 }  // namespace
 
 class AsyncDnsResolver::State : public rtc::RefCountedBase {
@@ -131,6 +253,9 @@ class AsyncDnsResolver::State : public rtc::RefCountedBase {
 
 AsyncDnsResolver::AsyncDnsResolver() : state_(State::Create()) {}
 
+AsyncDnsResolver::AsyncDnsResolver(const DnsCacheConfig& cache_config)
+    : cache_config_(cache_config), state_(State::Create()) {}
+
 AsyncDnsResolver::~AsyncDnsResolver() {
   state_->Kill();
 }
@@ -147,11 +272,23 @@ void AsyncDnsResolver::Start(const rtc::SocketAddress& addr,
   RTC_DCHECK_RUN_ON(&result_.sequence_checker_);
   result_.addr_ = addr;
   callback_ = std::move(callback);
-  auto thread_function = [this, addr, family, flag = safety_.flag(),
-                          caller_task_queue = webrtc::TaskQueueBase::Current(),
-                          state = state_] {
+  if (cache_config_) {
+    DnsCache::Get().Resolve(addr.hostname(), family, *cache_config_,
+                            CreateCompletion());
+    return;
+  }
+  RunDetached([addr, family, completion = CreateCompletion()] {
     std::vector<rtc::IPAddress> addresses;
     int error = ResolveHostname(addr.hostname(), family, addresses);
+    completion(error, std::move(addresses));
+  });
+}
+
+std::function<void(int, std::vector<rtc::IPAddress>)>
+AsyncDnsResolver::CreateCompletion() {
+  return [this, flag = safety_.flag(),
+          caller_task_queue = webrtc::TaskQueueBase::Current(),
+          state = state_](int error, std::vector<rtc::IPAddress> addresses) {
     // We assume that the caller task queue is still around if the
     // AsyncDnsResolver has not been destroyed.
     state->Finish([this, error, flag, caller_task_queue,
@@ -165,13 +302,14 @@ void AsyncDnsResolver::Start(const rtc::SocketAddress& addr,
           }));
     });
   };
-#if defined(WEBRTC_MAC) || defined(WEBRTC_IOS)
-  PostTaskToGlobalQueue(
-      std::make_unique<absl::AnyInvocable<void() &&>>(thread_function));
-#else
-  rtc::PlatformThread::SpawnDetached(std::move(thread_function),
-                                     "AsyncResolver");
-#endif
+}
+
+void AsyncDnsResolver::ClearCacheForTesting() {
+  DnsCache::Get().Clear();
+}
+
+int AsyncDnsResolver::CacheLookupsForTesting() {
+  return DnsCache::Get().num_lookups();
 }
 
 const AsyncDnsResolverResult& AsyncDnsResolver::result() const {
@@ -10,11 +10,14 @@
 #ifndef RTC_BASE_ASYNC_DNS_RESOLVER_H_
 #define RTC_BASE_ASYNC_DNS_RESOLVER_H_
 
+#include <functional>
 #include <vector>
 
+#include "absl/types/optional.h"
 #include "api/async_dns_resolver.h"
 #include "api/sequence_checker.h"
 #include "api/task_queue/pending_task_safety_flag.h"
+#include "api/units/time_delta.h"
 #include "rtc_base/ref_counted_object.h"
 #include "rtc_base/system/rtc_export.h"
 #include "rtc_base/thread_annotations.h"
@@ -38,9 +41,25 @@ class AsyncDnsResolverResultImpl : public AsyncDnsResolverResult {
   int error_ RTC_GUARDED_BY(sequence_checker_);
 };
 
+// Settings of the process-wide cache of resolutions that AsyncDnsResolvers
+// can share. getaddrinfo() doesn't report the TTLs of the DNS records, so
+// resolutions are cached for fixed times instead.
+struct DnsCacheConfig {
+  // How long successful resolutions are reused.
+  TimeDelta ttl = TimeDelta::Seconds(60);
+  // How long failed resolutions, and resolutions without any address, are
+  // reused.
+  TimeDelta negative_ttl = TimeDelta::Seconds(5);
+};
+
 class RTC_EXPORT AsyncDnsResolver : public AsyncDnsResolverInterface {
  public:
   AsyncDnsResolver();
+  // Creates a resolver that shares resolutions through the process-wide
+  // cache: a hostname resolved within the TTLs of `cache_config` isn't
+  // resolved again, and concurrent resolutions of the same hostname wait for
+  // a single lookup.
+  explicit AsyncDnsResolver(const DnsCacheConfig& cache_config);
   ~AsyncDnsResolver();
   // Start address resolution of the hostname in `addr`.
   void Start(const rtc::SocketAddress& addr,
@@ -51,8 +70,19 @@ class RTC_EXPORT AsyncDnsResolver : public AsyncDnsResolverInterface {
              absl::AnyInvocable<void()> callback) override;
   const AsyncDnsResolverResult& result() const override;
 
+  // Empties the process-wide cache.
+  static void ClearCacheForTesting();
+  // Returns how many hostname lookups the process-wide cache has made.
+  static int CacheLookupsForTesting();
+
  private:
   class State;
+  // Returns a function, callable from any thread, storing the result of a
+  // resolution and posting `callback_` to the current task queue, unless this
+  // resolver has been destroyed meanwhile.
+  std::function<void(int, std::vector<rtc::IPAddress>)> CreateCompletion();
+
+  const absl::optional<DnsCacheConfig> cache_config_;
   ScopedTaskSafety safety_;          // To check for client going away
   rtc::scoped_refptr<State> state_;  // To check for "this" going away
   AsyncDnsResolverResultImpl result_;
@@ -54,5 +54,45 @@ TEST(AsyncDnsResolver, ResolveAfterDeleteDoesNotReturn) {
   EXPECT_FALSE(done);                  // Expect no result.
 }
 
+TEST(AsyncDnsResolver, CachingResolversShareLookups) {
+  test::RunLoop loop;
+  AsyncDnsResolver::ClearCacheForTesting();
+  const int lookups = AsyncDnsResolver::CacheLookupsForTesting();
+  rtc::SocketAddress address("localhost", kPortNumber);
+  AsyncDnsResolver resolver1((DnsCacheConfig()));
+  AsyncDnsResolver resolver2((DnsCacheConfig()));
+  int done = 0;
+  resolver1.Start(address, [&done] { ++done; });
+  resolver2.Start(address, [&done] { ++done; });
+  ASSERT_TRUE_WAIT(done == 2, kDefaultTimeout);
+  EXPECT_EQ(resolver1.result().GetError(), resolver2.result().GetError());
+
+  // The resolution is cached, but still delivered asynchronously.
+  AsyncDnsResolver resolver3((DnsCacheConfig()));
+  bool done3 = false;
+  resolver3.Start(address, [&done3] { done3 = true; });
+  EXPECT_FALSE(done3);
+  ASSERT_TRUE_WAIT(done3, kDefaultTimeout);
+  EXPECT_EQ(resolver3.result().GetError(), resolver1.result().GetError());
+  EXPECT_EQ(AsyncDnsResolver::CacheLookupsForTesting(), lookups + 1);
+}
+
+TEST(AsyncDnsResolver, CachingResolverLooksUpExpiredResolutionsAgain) {
+  test::RunLoop loop;
+  AsyncDnsResolver::ClearCacheForTesting();
+  const int lookups = AsyncDnsResolver::CacheLookupsForTesting();
+  DnsCacheConfig config;
+  config.ttl = TimeDelta::Zero();
+  config.negative_ttl = TimeDelta::Zero();
+  rtc::SocketAddress address("localhost", kPortNumber);
+  for (int i = 0; i < 2; ++i) {
+    AsyncDnsResolver resolver(config);
+    bool done = false;
+    resolver.Start(address, [&done] { done = true; });
+    ASSERT_TRUE_WAIT(done, kDefaultTimeout);
+  }
+  EXPECT_EQ(AsyncDnsResolver::CacheLookupsForTesting(), lookups + 2);
+}
+
 }  // namespace
 }  // namespace webrtc
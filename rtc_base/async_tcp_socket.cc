@@ -175,6 +175,33 @@ void AsyncTCPSocketBase::AppendToOutBuffer(const void* pv, size_t cb) {
   outbuf_.AppendData(static_cast<const uint8_t*>(pv), cb);
 }
 
+int AsyncTCPSocketBase::SendFrame(
+    rtc::ArrayView<const rtc::ArrayView<const uint8_t>> parts) {
+  RTC_DCHECK(IsOutBufferEmpty());
+  int res = socket_->SendGathered(parts);
+  if (res <= 0) {
+    return res;
+  }
+  // Keep the unsent rest of the frame, if any.
+  size_t sent = static_cast<size_t>(res);
+  for (rtc::ArrayView<const uint8_t> part : parts) {
+    if (sent >= part.size()) {
+      sent -= part.size();
+      continue;
+    }
+    AppendToOutBuffer(part.data() + sent, part.size() - sent);
+    sent = 0;
+  }
+  RTC_DCHECK_EQ(sent, 0);
+  if (IsOutBufferEmpty()) {
+    return res;
+  }
+  // Continue until the socket blocks, so that it signals when it is writable
+  // again.
+  int flushed = FlushOutBuffer();
+  return flushed > 0 ? res + flushed : res;
+}
+
 void AsyncTCPSocketBase::OnConnectEvent(Socket* socket) {
   SignalConnect(this);
 }
@@ -185,6 +212,14 @@ void AsyncTCPSocketBase::OnReadEvent(Socket* socket) {
   size_t total_recv = 0;
   while (true) {
     size_t free_size = inbuf_.capacity() - inbuf_.size();
+    if (free_size < kMinimumRecvSize && inbuf_start_ > 0) {
+      // Move the unprocessed rest to the front to make room.
+      size_t bytes_remaining = inbuf_.size() - inbuf_start_;
+      memmove(inbuf_.data(), inbuf_.data() + inbuf_start_, bytes_remaining);
+      inbuf_.SetSize(bytes_remaining);
+      inbuf_start_ = 0;
+      free_size = inbuf_.capacity() - inbuf_.size();
+    }
     if (free_size < kMinimumRecvSize && inbuf_.capacity() < max_insize_) {
       inbuf_.EnsureCapacity(std::min(max_insize_, inbuf_.capacity() * 2));
       free_size = inbuf_.capacity() - inbuf_.size();
@@ -211,17 +246,18 @@ void AsyncTCPSocketBase::OnReadEvent(Socket* socket) {
     return;
   }
 
-  size_t processed = ProcessInput(inbuf_);
-  size_t bytes_remaining = inbuf_.size() - processed;
-  if (processed > inbuf_.size()) {
+  rtc::ArrayView<const uint8_t> input =
+      rtc::ArrayView<const uint8_t>(inbuf_).subview(inbuf_start_);
+  size_t processed = ProcessInput(input);
+  if (processed > input.size()) {
     RTC_LOG(LS_ERROR) << "input buffer overflow";
     RTC_DCHECK_NOTREACHED();
+    processed = input.size();
+  }
+  inbuf_start_ += processed;
+  if (inbuf_start_ == inbuf_.size()) {
     inbuf_.Clear();
-  } else {
-    if (bytes_remaining > 0) {
-      memmove(inbuf_.data(), inbuf_.data() + processed, bytes_remaining);
-    }
-    inbuf_.SetSize(bytes_remaining);
+    inbuf_start_ = 0;
   }
 }
 
@@ -267,11 +303,12 @@ int AsyncTCPSocket::Send(const void* pv,
   if (!IsOutBufferEmpty())
     return static_cast<int>(cb);
 
-  PacketLength pkt_len = HostToNetwork16(static_cast<PacketLength>(cb));
-  AppendToOutBuffer(&pkt_len, kPacketLenSize);
-  AppendToOutBuffer(pv, cb);
+  uint8_t pkt_len[kPacketLenSize];
+  SetBE16(pkt_len, static_cast<PacketLength>(cb));
+  const rtc::ArrayView<const uint8_t> frame[] = {
+      pkt_len, rtc::MakeArrayView(static_cast<const uint8_t*>(pv), cb)};
 
-  int res = FlushOutBuffer();
+  int res = SendFrame(frame);
   if (res <= 0) {
     // drop packet if we made no progress
     ClearOutBuffer();
@@ -66,6 +66,11 @@ class AsyncTCPSocketBase : public AsyncPacketSocket {
   int FlushOutBuffer();
   // Add data to `outbuf_`.
   void AppendToOutBuffer(const void* pv, size_t cb);
+  // Sends the concatenation of `parts`, e.g. a frame header and its payload,
+  // with a single send call and no intermediate copy. What the socket does
+  // not accept is moved to `outbuf_` and flushed. Requires an empty
+  // `outbuf_`, and returns like FlushOutBuffer().
+  int SendFrame(rtc::ArrayView<const rtc::ArrayView<const uint8_t>> parts);
 
   // Helper methods for `outpos_`.
   bool IsOutBufferEmpty() const { return outbuf_.size() == 0; }
@@ -79,7 +84,10 @@ class AsyncTCPSocketBase : public AsyncPacketSocket {
   void OnCloseEvent(Socket* socket, int error);
 
   std::unique_ptr<Socket> socket_;
+  // Received data. Bytes before `inbuf_start_` have been processed already;
+  // they are only moved out when room is needed, not after every read.
   Buffer inbuf_;
+  size_t inbuf_start_ = 0;
   Buffer outbuf_;
   size_t max_insize_;
   size_t max_outsize_;
@@ -10,9 +10,14 @@
 
 #include "rtc_base/async_udp_socket.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "absl/types/optional.h"
+#include "api/task_queue/task_queue_base.h"
 #include "api/units/time_delta.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/network/received_packet.h"
 #include "rtc_base/network/sent_packet.h"
@@ -27,6 +32,20 @@ static bool IsScmTimeStampExperimentDisabled() {
   return webrtc::field_trial::IsDisabled("WebRTC-SCM-Timestamp");
 }
 
+// Maximum number of datagrams to receive per read event, parsed from the
+// "WebRTC-UdpBatchedReceive" field trial. Returns 1 (no batching) unless the
+// trial is enabled.
+static size_t GetReceiveBatchSize() {
+  constexpr char kFieldTrial[] = "WebRTC-UdpBatchedReceive";
+  if (!webrtc::field_trial::IsEnabled(kFieldTrial)) {
+    return 1;
+  }
+  webrtc::FieldTrialParameter<int> max_packets("max_packets", 16);
+  webrtc::ParseFieldTrial({&max_packets},
+                          webrtc::field_trial::FindFullName(kFieldTrial));
+  return std::max(1, max_packets.Get());
+}
+
 AsyncUDPSocket* AsyncUDPSocket::Create(Socket* socket,
                                        const SocketAddress& bind_address) {
   std::unique_ptr<Socket> owned_socket(socket);
@@ -45,7 +64,8 @@ AsyncUDPSocket* AsyncUDPSocket::Create(SocketFactory* factory,
   return Create(socket, bind_address);
 }
 
-AsyncUDPSocket::AsyncUDPSocket(Socket* socket) : socket_(socket) {
+AsyncUDPSocket::AsyncUDPSocket(Socket* socket)
+    : socket_(socket), receive_batch_size_(GetReceiveBatchSize()) {
   sequence_checker_.Detach();
   // The socket should start out readable but not writable.
   socket_->SignalReadEvent.connect(this, &AsyncUDPSocket::OnReadEvent);
@@ -78,11 +98,79 @@ int AsyncUDPSocket::SendTo(const void* pv,
   rtc::SentPacket sent_packet(options.packet_id, rtc::TimeMillis(),
                               options.info_signaled_after_sent);
   CopySocketInformationToPacketInfo(cb, *this, true, &sent_packet.info);
+  if (options.batchable) {
+    return SendToBatched(pv, cb, addr, sent_packet,
+                         options.last_packet_in_batch);
+  }
   int ret = socket_->SendTo(pv, cb, addr);
   SignalSentPacket(this, sent_packet);
   return ret;
 }
 
+int AsyncUDPSocket::SendToBatched(const void* pv,
+                                  size_t cb,
+                                  const SocketAddress& addr,
+                                  const rtc::SentPacket& sent_packet,
+                                  bool last_packet_in_batch) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  // Maximum number of packets held back waiting for the end of a batch.
+  static constexpr size_t kMaxPendingPackets = 32;
+
+  pending_packets_.push_back(
+      {.payload = Buffer(static_cast<const uint8_t*>(pv), cb),
+       .destination = addr,
+       .sent_packet = sent_packet});
+  if (last_packet_in_batch ||
+      pending_packets_.size() >= kMaxPendingPackets) {
+    FlushPendingPackets();
+  } else if (pending_packets_.size() == 1) {
+    // The end of the batch may never reach this socket, e.g. if the last
+    // packet is dropped or routed elsewhere. Make sure queued packets are not
+    // delayed beyond the current task.
+    if (webrtc::TaskQueueBase* current = webrtc::TaskQueueBase::Current()) {
+      current->PostTask(webrtc::SafeTask(
+          task_safety_.flag(), [this] { FlushPendingPackets(); }));
+    } else {
+      FlushPendingPackets();
+    }
+  }
+  // Errors are reported when the batch is flushed; from the caller's point of
+  // view the packet has been handed to the network.
+  return static_cast<int>(cb);
+}
+
+void AsyncUDPSocket::FlushPendingPackets() {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  if (pending_packets_.empty()) {
+    return;
+  }
+  std::vector<Socket::SendBuffer> packets;
+  packets.reserve(pending_packets_.size());
+  for (const PendingPacket& packet : pending_packets_) {
+    packets.push_back({.payload = packet.payload,
+                       .destination = packet.destination});
+  }
+  size_t offset = 0;
+  while (offset < packets.size()) {
+    int sent = socket_->SendToBatch(
+        rtc::ArrayView<const Socket::SendBuffer>(packets).subview(offset));
+    if (sent <= 0) {
+      RTC_LOG(LS_VERBOSE) << "AsyncUDPSocket dropped "
+                          << packets.size() - offset
+                          << " batched packets, error " << GetError();
+      break;
+    }
+    offset += sent;
+  }
+  // Like the unbatched path, signal sent packets regardless of the outcome.
+  int64_t now_ms = rtc::TimeMillis();
+  for (PendingPacket& packet : pending_packets_) {
+    packet.sent_packet.send_time_ms = now_ms;
+    SignalSentPacket(this, packet.sent_packet);
+  }
+  pending_packets_.clear();
+}
+
 int AsyncUDPSocket::Close() {
   return socket_->Close();
 }
@@ -111,6 +199,11 @@ void AsyncUDPSocket::OnReadEvent(Socket* socket) {
   RTC_DCHECK(socket_.get() == socket);
   RTC_DCHECK_RUN_ON(&sequence_checker_);
 
+  if (receive_batch_size_ > 1) {
+    ReadBatch();
+    return;
+  }
+
   Socket::ReceiveBuffer receive_buffer(buffer_);
   int len = socket_->RecvFrom(receive_buffer);
   if (len < 0) {
@@ -127,7 +220,42 @@ void AsyncUDPSocket::OnReadEvent(Socket* socket) {
     // Spurios wakeup.
     return;
   }
+  DeliverPacket(receive_buffer);
+}
+
+void AsyncUDPSocket::ReadBatch() {
+  // Datagrams larger than this are dropped in batched mode. This comfortably
+  // covers RTP, RTCP, STUN and DTLS packets on the usual path MTUs.
+  static constexpr size_t kBatchedPacketCapacity = 2048;
+  if (batch_buffers_.empty()) {
+    batch_buffers_.resize(receive_batch_size_);
+    for (Buffer& buffer : batch_buffers_) {
+      buffer.EnsureCapacity(kBatchedPacketCapacity);
+    }
+  }
+  std::vector<Socket::ReceiveBuffer> receive_buffers;
+  receive_buffers.reserve(batch_buffers_.size());
+  for (Buffer& buffer : batch_buffers_) {
+    receive_buffers.emplace_back(buffer);
+  }
+
+  int count = socket_->RecvFromBatch(receive_buffers);
+  if (count < 0) {
+    // See comment in OnReadEvent.
+    SocketAddress local_addr = socket_->GetLocalAddress();
+    RTC_LOG(LS_INFO) << "AsyncUDPSocket[" << local_addr.ToSensitiveString()
+                     << "] receive failed with error " << socket_->GetError();
+    return;
+  }
+  for (int i = 0; i < count; ++i) {
+    if (receive_buffers[i].payload.empty()) {
+      continue;
+    }
+    DeliverPacket(receive_buffers[i]);
+  }
+}
 
+void AsyncUDPSocket::DeliverPacket(Socket::ReceiveBuffer& receive_buffer) {
   if (!receive_buffer.arrival_time) {
     // Timestamp from socket is not available.
     receive_buffer.arrival_time = webrtc::Timestamp::Micros(rtc::TimeMicros());
@@ -145,9 +273,9 @@ void AsyncUDPSocket::OnReadEvent(Socket* socket) {
     }
     *receive_buffer.arrival_time += *socket_time_offset_;
   }
-  NotifyPacketReceived(ReceivedPacket(receive_buffer.payload,
-                                      receive_buffer.source_address,
-                                      receive_buffer.arrival_time));
+  NotifyPacketReceived(ReceivedPacket(
+      receive_buffer.payload, receive_buffer.source_address,
+      receive_buffer.arrival_time, receive_buffer.ecn));
 }
 
 void AsyncUDPSocket::OnWriteEvent(Socket* socket) {
@@ -15,11 +15,15 @@
 
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "absl/types/optional.h"
 #include "api/sequence_checker.h"
+#include "api/task_queue/pending_task_safety_flag.h"
 #include "api/units/time_delta.h"
 #include "rtc_base/async_packet_socket.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/network/sent_packet.h"
 #include "rtc_base/socket.h"
 #include "rtc_base/socket_address.h"
 #include "rtc_base/socket_factory.h"
@@ -49,6 +53,9 @@ class AsyncUDPSocket : public AsyncPacketSocket {
   int Send(const void* pv,
            size_t cb,
            const rtc::PacketOptions& options) override;
+  // Packets with `options.batchable` set are queued and sent together with
+  // Socket::SendToBatch() once `options.last_packet_in_batch` is seen, or at
+  // the latest when the current task finishes.
   int SendTo(const void* pv,
              size_t cb,
              const SocketAddress& addr,
@@ -66,10 +73,33 @@ class AsyncUDPSocket : public AsyncPacketSocket {
   void OnReadEvent(Socket* socket);
   // Called when the underlying socket is ready to send.
   void OnWriteEvent(Socket* socket);
+  // Drains up to `receive_batch_size_` datagrams from the socket.
+  void ReadBatch() RTC_RUN_ON(sequence_checker_);
+  void DeliverPacket(Socket::ReceiveBuffer& receive_buffer)
+      RTC_RUN_ON(sequence_checker_);
+  int SendToBatched(const void* pv,
+                    size_t cb,
+                    const SocketAddress& addr,
+                    const rtc::SentPacket& sent_packet,
+                    bool last_packet_in_batch);
+  void FlushPendingPackets();
+
+  struct PendingPacket {
+    Buffer payload;
+    SocketAddress destination;
+    rtc::SentPacket sent_packet;
+  };
 
   RTC_NO_UNIQUE_ADDRESS webrtc::SequenceChecker sequence_checker_;
   std::unique_ptr<Socket> socket_;
+  // Number of datagrams read per read event. Batching is enabled with the
+  // "WebRTC-UdpBatchedReceive" field trial.
+  const size_t receive_batch_size_;
   rtc::Buffer buffer_ RTC_GUARDED_BY(sequence_checker_);
+  std::vector<rtc::Buffer> batch_buffers_ RTC_GUARDED_BY(sequence_checker_);
+  std::vector<PendingPacket> pending_packets_
+      RTC_GUARDED_BY(sequence_checker_);
+  webrtc::ScopedTaskSafetyDetached task_safety_;
   absl::optional<webrtc::TimeDelta> socket_time_offset_
       RTC_GUARDED_BY(sequence_checker_);
 };
@@ -0,0 +1,146 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/blocking_call_instrumentation.h"
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/strings/string_builder.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+#include "system_wrappers/include/metrics.h"
+
+namespace webrtc {
+namespace {
+
+constexpr char kWaitTimeHistogram[] = "WebRTC.Thread.BlockingCallWaitTimeUs";
+// Waits of 10 s and longer end up in the overflow bucket.
+constexpr int kMaxWaitTimeUs = 10'000'000;
+
+// 0 while disabled, and otherwise the sampling interval, negated if the waits
+// of recorded calls are to be traced.
+std::atomic<int> g_mode{0};
+std::atomic<uint32_t> g_call_count{0};
+
+class Registry {
+ public:
+  static Registry& Get() {
+    static Registry* const registry = new Registry();
+    return *registry;
+  }
+
+  void Add(std::string caller,
+           std::string callee,
+           std::string location,
+           TimeDelta wait_time) {
+    MutexLock lock(&mutex_);
+    stats_[{std::move(caller), std::move(callee), std::move(location)}].Add(
+        wait_time);
+  }
+
+  std::vector<BlockingCallInstrumentation::CallStats> GetStats() {
+    std::vector<BlockingCallInstrumentation::CallStats> result;
+    MutexLock lock(&mutex_);
+    result.reserve(stats_.size());
+    for (const auto& [key, wait_time] : stats_) {
+      const auto& [caller, callee, location] = key;
+      result.push_back({caller, callee, location, wait_time});
+    }
+    return result;
+  }
+
+  void Reset() {
+    MutexLock lock(&mutex_);
+    stats_.clear();
+  }
+
+ private:
+  Mutex mutex_;
+  std::map<std::tuple<std::string, std::string, std::string>,
+           TaskQueueInstrumentation::Histogram>
+      stats_ RTC_GUARDED_BY(mutex_);
+};
+
+std::string ThreadNameForStats(absl::string_view name) {
+  return name.empty() ? "unnamed" : std::string(name);
+}
+
+}  // namespace
+
+void BlockingCallInstrumentation::Enable(int sampling_interval,
+                                         bool trace_events) {
+  RTC_DCHECK_GT(sampling_interval, 0);
+  g_mode.store(trace_events ? -sampling_interval : sampling_interval,
+               std::memory_order_relaxed);
+}
+
+void BlockingCallInstrumentation::Disable() {
+  g_mode.store(0, std::memory_order_relaxed);
+}
+
+bool BlockingCallInstrumentation::IsEnabled() {
+  return g_mode.load(std::memory_order_relaxed) != 0;
+}
+
+std::vector<BlockingCallInstrumentation::CallStats>
+BlockingCallInstrumentation::GetStats() {
+  return Registry::Get().GetStats();
+}
+
+void BlockingCallInstrumentation::Reset() {
+  Registry::Get().Reset();
+}
+
+bool BlockingCallInstrumentation::ShouldRecord(bool& trace_event) {
+  const int mode = g_mode.load(std::memory_order_relaxed);
+  if (mode == 0) {
+    return false;
+  }
+  const uint32_t sampling_interval = mode < 0 ? -mode : mode;
+  if (sampling_interval > 1 &&
+      g_call_count.fetch_add(1, std::memory_order_relaxed) %
+              sampling_interval !=
+          0) {
+    return false;
+  }
+  trace_event = mode < 0;
+  return true;
+}
+
+void BlockingCallInstrumentation::Record(absl::string_view caller,
+                                         absl::string_view callee,
+                                         const Location& location,
+                                         TimeDelta wait_time) {
+  std::string caller_name = ThreadNameForStats(caller);
+  std::string callee_name = ThreadNameForStats(callee);
+  const int wait_time_us = static_cast<int>(
+      std::min<int64_t>(wait_time.us(), kMaxWaitTimeUs));
+  RTC_HISTOGRAM_COUNTS(kWaitTimeHistogram, wait_time_us, 1, kMaxWaitTimeUs,
+                       50);
+  rtc::StringBuilder histogram_name;
+  histogram_name << kWaitTimeHistogram << "." << caller_name << "."
+                 << callee_name;
+  RTC_HISTOGRAM_COUNTS_SPARSE(histogram_name.str(), wait_time_us, 1,
+                              kMaxWaitTimeUs, 50);
+
+  rtc::StringBuilder location_string;
+  location_string << location.file_name() << ":" << location.line_number();
+  Registry::Get().Add(std::move(caller_name), std::move(callee_name),
+                      location_string.Release(), wait_time);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,75 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_BLOCKING_CALL_INSTRUMENTATION_H_
+#define RTC_BASE_BLOCKING_CALL_INSTRUMENTATION_H_
+
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "api/location.h"
+#include "api/units/time_delta.h"
+#include "rtc_base/system/rtc_export.h"
+#include "rtc_base/task_queue_instrumentation.h"
+
+namespace webrtc {
+
+// Sampled instrumentation of rtc::Thread::BlockingCall(), cheap enough to be
+// enabled in production. While enabled, every `sampling_interval`th blocking
+// call from one thread to another is recorded with the names of the calling
+// and the called thread, the Location of the call and how long the caller
+// waited for it. Samples are reported to the metrics histograms
+//   WebRTC.Thread.BlockingCallWaitTimeUs
+//   WebRTC.Thread.BlockingCallWaitTimeUs.<caller>.<callee>
+// and aggregated in memory, see GetStats(). While disabled, a blocking call
+// only pays for reading an atomic.
+//
+// Instrumentation is process wide.
+class RTC_EXPORT BlockingCallInstrumentation {
+ public:
+  struct CallStats {
+    // Thread names, or "unnamed" for threads without one and "unknown" for
+    // callers that aren't wrapped by an rtc::Thread.
+    std::string caller;
+    std::string callee;
+    // "file:line" of where the calls were made from.
+    std::string location;
+    TaskQueueInstrumentation::Histogram wait_time;
+  };
+
+  // Starts recording every `sampling_interval`th blocking call. If
+  // `trace_events` is true, the waits of recorded calls also run within a
+  // TRACE_EVENT naming the called thread and the location.
+  static void Enable(int sampling_interval = 1, bool trace_events = false);
+  // Stops recording blocking calls. Recorded stats are kept.
+  static void Disable();
+  static bool IsEnabled();
+
+  // Returns the stats of all caller, callee and location triples with
+  // samples, ordered by caller, callee and location.
+  static std::vector<CallStats> GetStats();
+  // Discards all stats recorded in memory.
+  static void Reset();
+
+  // For rtc::Thread, called before blocking on a call to another thread.
+  // Returns whether the call is to be recorded, and sets `trace_event` if its
+  // wait is to be traced too.
+  static bool ShouldRecord(bool& trace_event);
+  // For rtc::Thread, records a call that ShouldRecord() selected.
+  static void Record(absl::string_view caller,
+                     absl::string_view callee,
+                     const Location& location,
+                     TimeDelta wait_time);
+};
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_BLOCKING_CALL_INSTRUMENTATION_H_
@@ -0,0 +1,99 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/blocking_call_instrumentation.h"
+
+#include <memory>
+#include <vector>
+
+#include "rtc_base/thread.h"
+#include "system_wrappers/include/metrics.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::HasSubstr;
+using ::testing::IsEmpty;
+
+class BlockingCallInstrumentationTest : public ::testing::Test {
+ protected:
+  BlockingCallInstrumentationTest()
+      : caller_(rtc::Thread::Create()), callee_(rtc::Thread::Create()) {
+    BlockingCallInstrumentation::Reset();
+    metrics::Reset();
+    caller_->SetName("caller", nullptr);
+    callee_->SetName("callee", nullptr);
+    caller_->Start();
+    callee_->Start();
+  }
+  ~BlockingCallInstrumentationTest() override {
+    BlockingCallInstrumentation::Disable();
+    BlockingCallInstrumentation::Reset();
+  }
+
+  // Makes `num_calls` blocking calls from `caller_` to `callee_`.
+  void MakeBlockingCalls(int num_calls) {
+    caller_->BlockingCall([&] {
+      for (int i = 0; i < num_calls; ++i) {
+        callee_->BlockingCall([] {});
+      }
+    });
+  }
+
+  const std::unique_ptr<rtc::Thread> caller_;
+  const std::unique_ptr<rtc::Thread> callee_;
+};
+
+TEST_F(BlockingCallInstrumentationTest, DoesNotRecordWhenDisabled) {
+  MakeBlockingCalls(3);
+  EXPECT_THAT(BlockingCallInstrumentation::GetStats(), IsEmpty());
+  EXPECT_EQ(metrics::NumSamples("WebRTC.Thread.BlockingCallWaitTimeUs"), 0);
+}
+
+TEST_F(BlockingCallInstrumentationTest, RecordsCallsPerThreadsAndLocation) {
+  BlockingCallInstrumentation::Enable();
+  MakeBlockingCalls(3);
+  BlockingCallInstrumentation::Disable();
+
+  std::vector<BlockingCallInstrumentation::CallStats> stats =
+      BlockingCallInstrumentation::GetStats();
+  // The call to `caller_` is made from the test's main thread.
+  ASSERT_EQ(stats.size(), 2u);
+  EXPECT_EQ(stats[0].caller, "caller");
+  EXPECT_EQ(stats[0].callee, "callee");
+  EXPECT_THAT(stats[0].location,
+              HasSubstr("blocking_call_instrumentation_unittest.cc:"));
+  EXPECT_EQ(stats[0].wait_time.num_samples, 3);
+  EXPECT_EQ(stats[1].callee, "caller");
+  EXPECT_EQ(stats[1].wait_time.num_samples, 1);
+  EXPECT_GE(stats[1].wait_time.max, stats[0].wait_time.max);
+
+  EXPECT_EQ(metrics::NumSamples("WebRTC.Thread.BlockingCallWaitTimeUs"), 4);
+  EXPECT_EQ(metrics::NumSamples(
+                "WebRTC.Thread.BlockingCallWaitTimeUs.caller.callee"),
+            3);
+
+  BlockingCallInstrumentation::Reset();
+  EXPECT_THAT(BlockingCallInstrumentation::GetStats(), IsEmpty());
+}
+
+TEST_F(BlockingCallInstrumentationTest, SamplesCalls) {
+  BlockingCallInstrumentation::Enable(/*sampling_interval=*/4,
+                                      /*trace_events=*/true);
+  MakeBlockingCalls(/*num_calls=*/39);
+  BlockingCallInstrumentation::Disable();
+
+  EXPECT_EQ(metrics::NumSamples("WebRTC.Thread.BlockingCallWaitTimeUs"), 10);
+}
+
+}  // namespace
+}  // namespace webrtc
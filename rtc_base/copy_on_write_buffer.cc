@@ -11,10 +11,40 @@
 #include "rtc_base/copy_on_write_buffer.h"
 
 #include <stddef.h>
+#include <string.h>
+
+#include <utility>
 
 #include "absl/strings/string_view.h"
 
 namespace rtc {
+namespace {
+
+// Index of the smallest pool size class that fits `capacity` bytes.
+size_t SizeClassIndex(size_t capacity) {
+  size_t index = 0;
+  while ((CopyOnWriteBufferPool::kMinCapacity << index) < capacity) {
+    ++index;
+  }
+  return index;
+}
+
+}  // namespace
+
+RefCountReleaseStatus CopyOnWriteBuffer::RefCountedBuffer::Release() const {
+  const RefCountReleaseStatus status = ref_count_.DecRef();
+  if (status == RefCountReleaseStatus::kDroppedLastRef) {
+    if (CopyOnWriteBufferPool* pool = pool_) {
+      pool_ = nullptr;
+      pool->Recycle(const_cast<RefCountedBuffer*>(this));
+      // May delete the pool, and with it this object.
+      pool->Release();
+    } else {
+      delete this;
+    }
+  }
+  return status;
+}
 
 CopyOnWriteBuffer::CopyOnWriteBuffer() : offset_(0), size_(0) {
   RTC_DCHECK(IsConsistent());
@@ -124,4 +154,97 @@ void CopyOnWriteBuffer::UnshareAndEnsureCapacity(size_t new_capacity) {
   RTC_DCHECK(IsConsistent());
 }
 
+void CopyOnWriteBuffer::PrependBytes(const uint8_t* data, size_t size) {
+  RTC_DCHECK(IsConsistent());
+  if (size == 0) {
+    return;
+  }
+  if (buffer_ && buffer_->HasOneRef() && size <= offset_) {
+    offset_ -= size;
+    size_ += size;
+    memcpy(buffer_->data() + offset_, data, size);
+    RTC_DCHECK(IsConsistent());
+    return;
+  }
+
+  // Keep the room the buffer had for appending.
+  const size_t tailroom = capacity() - size_;
+  scoped_refptr<RefCountedBuffer> buffer(
+      new RefCountedBuffer(data, size, size + size_ + tailroom));
+  if (buffer_) {
+    buffer->AppendData(buffer_->data() + offset_, size_);
+  }
+  buffer_ = std::move(buffer);
+  offset_ = 0;
+  size_ += size;
+  RTC_DCHECK(IsConsistent());
+}
+
+CopyOnWriteBufferPool::CopyOnWriteBufferPool(
+    size_t max_free_buffers_per_size_class)
+    : max_free_buffers_per_size_class_(max_free_buffers_per_size_class) {}
+
+CopyOnWriteBufferPool::~CopyOnWriteBufferPool() = default;
+
+CopyOnWriteBuffer CopyOnWriteBufferPool::Create(size_t capacity,
+                                                size_t headroom) {
+  if (headroom + capacity > kMaxCapacity) {
+    CopyOnWriteBuffer buffer(headroom, headroom + capacity);
+    buffer.offset_ = headroom;
+    buffer.size_ = 0;
+    RTC_DCHECK(buffer.IsConsistent());
+    return buffer;
+  }
+  const size_t index = SizeClassIndex(headroom + capacity);
+  std::unique_ptr<RefCountedBuffer> storage;
+  {
+    webrtc::MutexLock lock(&mutex_);
+    std::vector<std::unique_ptr<RefCountedBuffer>>& free_list =
+        free_buffers_[index];
+    if (!free_list.empty()) {
+      storage = std::move(free_list.back());
+      free_list.pop_back();
+    }
+  }
+  if (!storage) {
+    storage = std::make_unique<RefCountedBuffer>(0, kMinCapacity << index);
+  }
+  AddRef();
+  storage->pool_ = this;
+
+  storage->SetSize(headroom);
+
+  CopyOnWriteBuffer buffer;
+  buffer.buffer_ = storage.release();
+  buffer.offset_ = headroom;
+  RTC_DCHECK(buffer.IsConsistent());
+  return buffer;
+}
+
+size_t CopyOnWriteBufferPool::num_free_buffers() const {
+  webrtc::MutexLock lock(&mutex_);
+  size_t count = 0;
+  for (const auto& free_list : free_buffers_) {
+    count += free_list.size();
+  }
+  return count;
+}
+
+void CopyOnWriteBufferPool::Recycle(RefCountedBuffer* buffer) {
+  std::unique_ptr<RefCountedBuffer> storage(buffer);
+  storage->Clear();
+  const size_t index = SizeClassIndex(storage->capacity());
+  // Storage may have grown while not shared; only keep exact size classes.
+  if (index >= kNumSizeClasses ||
+      storage->capacity() != (kMinCapacity << index)) {
+    return;
+  }
+  webrtc::MutexLock lock(&mutex_);
+  std::vector<std::unique_ptr<RefCountedBuffer>>& free_list =
+      free_buffers_[index];
+  if (free_list.size() < max_free_buffers_per_size_class_) {
+    free_list.push_back(std::move(storage));
+  }
+}
+
 }  // namespace rtc
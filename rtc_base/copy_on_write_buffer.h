@@ -14,21 +14,29 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <array>
 #include <cstring>
+#include <memory>
 #include <string>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "absl/strings/string_view.h"
 #include "api/scoped_refptr.h"
 #include "rtc_base/buffer.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/ref_counted_object.h"
+#include "rtc_base/ref_counter.h"
+#include "rtc_base/synchronization/mutex.h"
 #include "rtc_base/system/rtc_export.h"
+#include "rtc_base/thread_annotations.h"
 #include "rtc_base/type_traits.h"
 
 namespace rtc {
 
+class CopyOnWriteBufferPool;
+
 class RTC_EXPORT CopyOnWriteBuffer {
  public:
   // An empty buffer.
@@ -257,6 +265,41 @@ class RTC_EXPORT CopyOnWriteBuffer {
     AppendData(v.data(), v.size());
   }
 
+  // Prepend data to the buffer. Accepts the same types as the constructors.
+  // Writes into the headroom when there is enough of it and the storage isn't
+  // shared, otherwise copies the buffer.
+  template <typename T,
+            typename std::enable_if<
+                internal::BufferCompat<uint8_t, T>::value>::type* = nullptr>
+  void PrependData(const T* data, size_t size) {
+    PrependBytes(reinterpret_cast<const uint8_t*>(data), size);
+  }
+
+  template <typename T,
+            size_t N,
+            typename std::enable_if<
+                internal::BufferCompat<uint8_t, T>::value>::type* = nullptr>
+  void PrependData(const T (&array)[N]) {
+    PrependData(array, N);
+  }
+
+  template <typename VecT,
+            typename ElemT = typename std::remove_pointer_t<
+                decltype(std::declval<VecT>().data())>,
+            typename std::enable_if_t<
+                HasDataAndSize<VecT, ElemT>::value &&
+                internal::BufferCompat<uint8_t, ElemT>::value>* = nullptr>
+  void PrependData(const VecT& v) {
+    PrependData(v.data(), v.size());
+  }
+
+  // Number of bytes in front of the data that PrependData can use without
+  // reallocating, as long as the storage isn't shared.
+  size_t headroom() const {
+    RTC_DCHECK(IsConsistent());
+    return offset_;
+  }
+
   // Sets the size of the buffer. If the new size is smaller than the old, the
   // buffer contents will be kept but truncated; if the new size is greater,
   // the existing contents will be kept and the new space will be
@@ -289,11 +332,36 @@ class RTC_EXPORT CopyOnWriteBuffer {
   }
 
  private:
-  using RefCountedBuffer = FinalRefCountedObject<Buffer>;
+  friend class CopyOnWriteBufferPool;
+
+  // Reference counted storage. Storage handed out by a CopyOnWriteBufferPool
+  // is given back to the pool, rather than deleted, when the last reference
+  // is dropped.
+  class RefCountedBuffer final : public Buffer {
+   public:
+    template <typename... Args>
+    explicit RefCountedBuffer(Args&&... args)
+        : Buffer(std::forward<Args>(args)...) {}
+
+    void AddRef() const { ref_count_.IncRef(); }
+    RefCountReleaseStatus Release() const;
+    bool HasOneRef() const { return ref_count_.HasOneRef(); }
+
+   private:
+    friend class CopyOnWriteBufferPool;
+
+    mutable webrtc::webrtc_impl::RefCounter ref_count_{0};
+    // The owning pool, holding a reference to it, while the storage is in use.
+    // Null for storage that isn't pooled.
+    mutable CopyOnWriteBufferPool* pool_ = nullptr;
+  };
+
   // Create a copy of the underlying data if it is referenced from other Buffer
   // objects or there is not enough capacity.
   void UnshareAndEnsureCapacity(size_t new_capacity);
 
+  void PrependBytes(const uint8_t* data, size_t size);
+
   // Pre- and postcondition of all methods.
   bool IsConsistent() const {
     if (buffer_) {
@@ -313,6 +381,58 @@ class RTC_EXPORT CopyOnWriteBuffer {
                    // Should be 0 if the buffer_ is empty.
 };
 
+// Thread-safe pool of CopyOnWriteBuffer storage, grouped in power of two size
+// classes. The storage of a buffer created by the pool goes back to the pool
+// when the last CopyOnWriteBuffer referring to it is destroyed, so that buffers
+// created at a high rate, e.g. one per received packet, don't need a heap
+// allocation each. Buffers may be released on any thread, and keep the pool
+// alive until they are.
+class RTC_EXPORT CopyOnWriteBufferPool : public RefCountInterface {
+ public:
+  // Capacities are rounded up to a power of two no smaller than this.
+  static constexpr size_t kMinCapacity = 256;
+  // Larger buffers are allocated without pooling.
+  static constexpr size_t kMaxCapacity = 64 * 1024;
+  static constexpr size_t kDefaultMaxFreeBuffersPerSizeClass = 64;
+
+  explicit CopyOnWriteBufferPool(
+      size_t max_free_buffers_per_size_class =
+          kDefaultMaxFreeBuffersPerSizeClass);
+  ~CopyOnWriteBufferPool() override;
+
+  // Returns an empty buffer with a capacity of at least `capacity` bytes,
+  // and `headroom` bytes in front of it to prepend headers to, e.g. TURN
+  // channel data headers, without a copy.
+  CopyOnWriteBuffer Create(size_t capacity, size_t headroom = 0);
+  // Returns a buffer holding a copy of `size` bytes from `data`. The source
+  // array may be (const) uint8_t*, int8_t*, or char*.
+  template <typename T,
+            typename std::enable_if<
+                internal::BufferCompat<uint8_t, T>::value>::type* = nullptr>
+  CopyOnWriteBuffer Create(const T* data, size_t size) {
+    CopyOnWriteBuffer buffer = Create(size);
+    buffer.AppendData(data, size);
+    return buffer;
+  }
+
+  // Number of buffers currently waiting for reuse, for tests and stats.
+  size_t num_free_buffers() const;
+
+ private:
+  friend class CopyOnWriteBuffer::RefCountedBuffer;
+  using RefCountedBuffer = CopyOnWriteBuffer::RefCountedBuffer;
+
+  static constexpr size_t kNumSizeClasses = 9;
+  static_assert(kMinCapacity << (kNumSizeClasses - 1) == kMaxCapacity, "");
+
+  void Recycle(RefCountedBuffer* buffer);
+
+  const size_t max_free_buffers_per_size_class_;
+  mutable webrtc::Mutex mutex_;
+  std::array<std::vector<std::unique_ptr<RefCountedBuffer>>, kNumSizeClasses>
+      free_buffers_ RTC_GUARDED_BY(mutex_);
+};
+
 }  // namespace rtc
 
 #endif  // RTC_BASE_COPY_ON_WRITE_BUFFER_H_
@@ -11,7 +11,10 @@
 #include "rtc_base/copy_on_write_buffer.h"
 
 #include <cstdint>
+#include <cstring>
+#include <vector>
 
+#include "api/make_ref_counted.h"
 #include "test/gtest.h"
 
 namespace rtc {
@@ -387,4 +390,114 @@ TEST(CopyOnWriteBufferTest, AcceptsVectorLikeTypes) {
   EXPECT_EQ(all.size(), 8U);
 }
 
+TEST(CopyOnWriteBufferTest, PrependDataCopiesWithoutHeadroom) {
+  CopyOnWriteBuffer buf(kTestData + 3, 3, 10);
+  EXPECT_EQ(buf.headroom(), 0u);
+  buf.PrependData(kTestData, 3);
+  EXPECT_EQ(buf.size(), 6u);
+  EXPECT_EQ(buf.capacity(), 13u);
+  EXPECT_EQ(0, memcmp(buf.cdata(), kTestData, 6));
+}
+
+TEST(CopyOnWriteBufferTest, PrependDataToSliceCopiesSharedData) {
+  CopyOnWriteBuffer buf(kTestData, 10);
+  CopyOnWriteBuffer slice = buf.Slice(4, 2);
+  EXPECT_EQ(slice.headroom(), 4u);
+  const uint8_t header[] = {0xaa, 0xbb};
+  slice.PrependData(header);
+  EXPECT_NE(slice.cdata(), buf.cdata() + 2);
+  EXPECT_EQ(0, memcmp(buf.cdata(), kTestData, 10));
+  EXPECT_EQ(slice.size(), 4u);
+  EXPECT_EQ(slice[0], 0xaa);
+  EXPECT_EQ(slice[1], 0xbb);
+  EXPECT_EQ(slice[2], kTestData[4]);
+}
+
+TEST(CopyOnWriteBufferPoolTest, ReusesStorageOfReleasedBuffers) {
+  auto pool = make_ref_counted<CopyOnWriteBufferPool>();
+  CopyOnWriteBuffer buf = pool->Create(kTestData, 10);
+  EXPECT_EQ(buf.size(), 10u);
+  EXPECT_EQ(buf.capacity(), CopyOnWriteBufferPool::kMinCapacity);
+  EXPECT_EQ(0, memcmp(buf.cdata(), kTestData, 10));
+  const uint8_t* storage = buf.cdata();
+
+  buf = CopyOnWriteBuffer();
+  EXPECT_EQ(pool->num_free_buffers(), 1u);
+
+  CopyOnWriteBuffer reused = pool->Create(100);
+  EXPECT_EQ(reused.cdata(), storage);
+  EXPECT_EQ(reused.size(), 0u);
+  EXPECT_EQ(pool->num_free_buffers(), 0u);
+}
+
+TEST(CopyOnWriteBufferPoolTest, StorageReturnsWhenLastSliceIsReleased) {
+  auto pool = make_ref_counted<CopyOnWriteBufferPool>();
+  CopyOnWriteBuffer slice = pool->Create(kTestData, 10).Slice(2, 5);
+  EXPECT_EQ(pool->num_free_buffers(), 0u);
+  EXPECT_EQ(slice[0], kTestData[2]);
+
+  slice = CopyOnWriteBuffer();
+  EXPECT_EQ(pool->num_free_buffers(), 1u);
+}
+
+TEST(CopyOnWriteBufferPoolTest, UsesSizeClasses) {
+  auto pool = make_ref_counted<CopyOnWriteBufferPool>();
+  EXPECT_EQ(pool->Create(1500).capacity(), 2048u);
+  EXPECT_EQ(pool->Create(2048).capacity(), 2048u);
+  EXPECT_EQ(pool->num_free_buffers(), 1u);
+
+  // Requests above the largest size class are not pooled.
+  CopyOnWriteBuffer large =
+      pool->Create(CopyOnWriteBufferPool::kMaxCapacity + 1);
+  EXPECT_GE(large.capacity(), CopyOnWriteBufferPool::kMaxCapacity + 1);
+  large = CopyOnWriteBuffer();
+  EXPECT_EQ(pool->num_free_buffers(), 1u);
+}
+
+TEST(CopyOnWriteBufferPoolTest, PrependsToHeadroomWithoutCopying) {
+  auto pool = make_ref_counted<CopyOnWriteBufferPool>();
+  CopyOnWriteBuffer buf = pool->Create(1000, /*headroom=*/4);
+  EXPECT_EQ(buf.headroom(), 4u);
+  EXPECT_GE(buf.capacity(), 1000u);
+  buf.AppendData(kTestData + 4, 6);
+  const uint8_t* data = buf.cdata();
+
+  buf.PrependData(kTestData, 4);
+  EXPECT_EQ(buf.cdata(), data - 4);
+  EXPECT_EQ(buf.headroom(), 0u);
+  EXPECT_EQ(buf.size(), 10u);
+  EXPECT_EQ(0, memcmp(buf.cdata(), kTestData, 10));
+}
+
+TEST(CopyOnWriteBufferPoolTest, KeepsHeadroomOfUnpooledBuffers) {
+  auto pool = make_ref_counted<CopyOnWriteBufferPool>();
+  CopyOnWriteBuffer buf =
+      pool->Create(CopyOnWriteBufferPool::kMaxCapacity, /*headroom=*/4);
+  EXPECT_EQ(buf.headroom(), 4u);
+  EXPECT_EQ(buf.size(), 0u);
+  EXPECT_EQ(buf.capacity(), CopyOnWriteBufferPool::kMaxCapacity);
+}
+
+TEST(CopyOnWriteBufferPoolTest, KeepsABoundedNumberOfFreeBuffers) {
+  auto pool = make_ref_counted<CopyOnWriteBufferPool>(
+      /*max_free_buffers_per_size_class=*/2);
+  {
+    std::vector<CopyOnWriteBuffer> buffers;
+    for (int i = 0; i < 5; ++i) {
+      buffers.push_back(pool->Create(100));
+    }
+  }
+  EXPECT_EQ(pool->num_free_buffers(), 2u);
+}
+
+TEST(CopyOnWriteBufferPoolTest, BuffersMayOutliveThePoolReference) {
+  auto pool = make_ref_counted<CopyOnWriteBufferPool>();
+  CopyOnWriteBuffer buf = pool->Create(kTestData, 10);
+  pool = nullptr;
+  EXPECT_EQ(0, memcmp(buf.cdata(), kTestData, 10));
+  CopyOnWriteBuffer copy = buf;
+  copy.MutableData()[0] = 0xaa;
+  EXPECT_EQ(buf[0], kTestData[0]);
+}
+
 }  // namespace rtc
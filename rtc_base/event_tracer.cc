@@ -14,7 +14,13 @@
 #include <stdio.h>
 #include <string.h>
 
+#if (defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)) || defined(WEBRTC_MAC)
+#include <pthread.h>
+#endif
+
 #include <atomic>
+#include <iterator>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -83,7 +89,20 @@ namespace {
 // Atomic-int fast path for avoiding logging when disabled.
 static std::atomic<int> g_event_logging_active(0);
 
-// TODO(pbos): Log metadata for all threads, etc.
+// Ids of EventLogger instances, so that a thread can tell if its cached
+// buffer belongs to the current logger.
+static std::atomic<uint64_t> g_next_event_logger_id(1);
+
+std::string CurrentThreadName() {
+#if (defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)) || defined(WEBRTC_MAC)
+  char name[64] = {};
+  if (pthread_getname_np(pthread_self(), name, sizeof(name)) == 0) {
+    return name;
+  }
+#endif
+  return std::string();
+}
+
 class EventLogger final {
  public:
   ~EventLogger() { RTC_DCHECK(thread_checker_.IsCurrent()); }
@@ -114,9 +133,12 @@ class EventLogger final {
         arg.value.as_string = str_copy;
       }
     }
-    webrtc::MutexLock lock(&mutex_);
-    trace_events_.push_back(
-        {name, category_enabled, phase, args, timestamp, 1, thread_id});
+    // Each thread adds events to its own buffer, so the lock is only contended
+    // when the logging thread collects the events.
+    ThreadBuffer* buffer = GetThreadBuffer(thread_id);
+    webrtc::MutexLock lock(&buffer->mutex);
+    buffer->events.push_back({name, category_enabled, phase, std::move(args),
+                              timestamp, 1, thread_id});
   }
 
   // The TraceEvent format is documented here:
@@ -130,9 +152,23 @@ class EventLogger final {
     while (true) {
       bool shutting_down = shutdown_event_.Wait(kLoggingInterval);
       std::vector<TraceEvent> events;
-      {
-        webrtc::MutexLock lock(&mutex_);
-        trace_events_.swap(events);
+      std::vector<std::pair<rtc::PlatformThreadId, std::string>> new_threads;
+      CollectEvents(events, new_threads);
+      // Name the threads, so that the trace viewer can show them by name.
+      for (const auto& [tid, thread_name] : new_threads) {
+        fprintf(output_file_,
+                "%s{ \"name\": \"thread_name\""
+                ", \"ph\": \"M\""
+                ", \"pid\": 1"
+#if defined(WEBRTC_WIN)
+                ", \"tid\": %lu"
+#else
+                ", \"tid\": %d"
+#endif  // defined(WEBRTC_WIN)
+                ", \"args\": { \"name\": \"%s\" }"
+                "}\n",
+                has_logged_event ? "," : " ", tid, thread_name.c_str());
+        has_logged_event = true;
       }
       std::string args_str;
       args_str.reserve(kEventLoggerArgsStrBufferInitialSize);
@@ -191,12 +227,16 @@ class EventLogger final {
     output_file_ = file;
     output_file_owned_ = owned;
     {
-      webrtc::MutexLock lock(&mutex_);
+      webrtc::MutexLock lock(&buffers_mutex_);
       // Since the atomic fast-path for adding events to the queue can be
       // bypassed while the logging thread is shutting down there may be some
-      // stale events in the queue, hence the vector needs to be cleared to not
-      // log events from a previous logging session (which may be days old).
-      trace_events_.clear();
+      // stale events in the buffers, hence they need to be cleared to not log
+      // events from a previous logging session (which may be days old).
+      for (const auto& buffer : thread_buffers_) {
+        webrtc::MutexLock buffer_lock(&buffer->mutex);
+        buffer->events.clear();
+        buffer->name_logged = false;
+      }
     }
     // Enable event logging (fast-path). This should be disabled since starting
     // shouldn't be done twice.
@@ -214,7 +254,7 @@ class EventLogger final {
     TRACE_EVENT_INSTANT0("webrtc", "EventLogger::Stop");
     // Try to stop. Abort if we're not currently logging.
     int one = 1;
-    if (g_event_logging_active.compare_exchange_strong(one, 0))
+    if (!g_event_logging_active.compare_exchange_strong(one, 0))
       return;
 
     // Wake up logging thread to finish writing.
@@ -254,6 +294,56 @@ class EventLogger final {
     rtc::PlatformThreadId tid;
   };
 
+  // Events added by one thread, waiting to be written by the logging thread.
+  struct ThreadBuffer {
+    ThreadBuffer(rtc::PlatformThreadId tid, std::string name)
+        : tid(tid), name(std::move(name)) {}
+    const rtc::PlatformThreadId tid;
+    const std::string name;
+    webrtc::Mutex mutex;
+    std::vector<TraceEvent> events RTC_GUARDED_BY(mutex);
+    // Whether the thread name has been written in the current session.
+    bool name_logged RTC_GUARDED_BY(mutex) = false;
+  };
+
+  // Returns the buffer of the current thread, creating it the first time the
+  // thread adds an event. Buffers live as long as the logger.
+  ThreadBuffer* GetThreadBuffer(rtc::PlatformThreadId thread_id) {
+    static thread_local uint64_t t_logger_id = 0;
+    static thread_local ThreadBuffer* t_buffer = nullptr;
+    if (t_logger_id != id_) {
+      webrtc::MutexLock lock(&buffers_mutex_);
+      thread_buffers_.push_back(
+          std::make_unique<ThreadBuffer>(thread_id, CurrentThreadName()));
+      t_buffer = thread_buffers_.back().get();
+      t_logger_id = id_;
+    }
+    return t_buffer;
+  }
+
+  // Moves the events of all threads to `events`, and adds the threads that
+  // haven't been named yet to `new_threads`.
+  void CollectEvents(
+      std::vector<TraceEvent>& events,
+      std::vector<std::pair<rtc::PlatformThreadId, std::string>>&
+          new_threads) {
+    webrtc::MutexLock lock(&buffers_mutex_);
+    for (const auto& buffer : thread_buffers_) {
+      webrtc::MutexLock buffer_lock(&buffer->mutex);
+      if (buffer->events.empty()) {
+        continue;
+      }
+      if (!buffer->name_logged && !buffer->name.empty()) {
+        new_threads.emplace_back(buffer->tid, buffer->name);
+        buffer->name_logged = true;
+      }
+      events.insert(events.end(),
+                    std::make_move_iterator(buffer->events.begin()),
+                    std::make_move_iterator(buffer->events.end()));
+      buffer->events.clear();
+    }
+  }
+
   static std::string TraceArgValueAsString(TraceArg arg) {
     std::string output;
 
@@ -314,8 +404,10 @@ class EventLogger final {
     return output;
   }
 
-  webrtc::Mutex mutex_;
-  std::vector<TraceEvent> trace_events_ RTC_GUARDED_BY(mutex_);
+  const uint64_t id_ = g_next_event_logger_id++;
+  webrtc::Mutex buffers_mutex_;
+  std::vector<std::unique_ptr<ThreadBuffer>> thread_buffers_
+      RTC_GUARDED_BY(buffers_mutex_);
   rtc::PlatformThread logging_thread_;
   rtc::Event shutdown_event_;
   webrtc::SequenceChecker thread_checker_;
@@ -10,6 +10,11 @@
 
 #include "rtc_base/event_tracer.h"
 
+#include <stdio.h>
+
+#include <string>
+
+#include "rtc_base/platform_thread.h"
 #include "rtc_base/synchronization/mutex.h"
 #include "rtc_base/thread_annotations.h"
 #include "rtc_base/trace_event.h"
@@ -70,6 +75,33 @@ TEST(EventTracerTest, ScopedTraceEvent) {
   EXPECT_EQ(2, TestStatistics::Get()->Count());
   TestStatistics::Get()->Reset();
 }
+
+TEST(EventTracerTest, InternalTracerWritesEventsAndNamesOfAllThreads) {
+  rtc::tracing::SetupInternalTracer(/*enable_all_categories=*/true);
+  FILE* file = tmpfile();
+  ASSERT_TRUE(file);
+  rtc::tracing::StartInternalCaptureToFile(file);
+  TRACE_EVENT_INSTANT0("test", "OnMainThread");
+  rtc::PlatformThread::SpawnJoinable(
+      [] { TRACE_EVENT_INSTANT0("test", "OnWorkerThread"); },
+      "TraceTestThread");
+  rtc::tracing::StopInternalCapture();
+  rtc::tracing::ShutdownInternalTracer();
+
+  std::string trace;
+  rewind(file);
+  char buffer[256];
+  size_t read;
+  while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+    trace.append(buffer, read);
+  }
+  fclose(file);
+  EXPECT_NE(trace.find("\"OnMainThread\""), std::string::npos);
+  EXPECT_NE(trace.find("\"OnWorkerThread\""), std::string::npos);
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+  EXPECT_NE(trace.find("\"TraceTestThread\""), std::string::npos);
+#endif
+}
 #endif
 
 }  // namespace webrtc
@@ -0,0 +1,61 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#ifndef RTC_BASE_EXPERIMENTS_PARSED_FIELD_TRIAL_CACHE_H_
+#define RTC_BASE_EXPERIMENTS_PARSED_FIELD_TRIAL_CACHE_H_
+
+#include <stddef.h>
+
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "rtc_base/containers/flat_map.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+namespace parsed_field_trial_cache_impl {
+// Bounds the memory used by a cache when values keep changing, e.g. in tests.
+// Values beyond that are parsed on every call.
+constexpr size_t kMaxCachedValues = 16;
+}  // namespace parsed_field_trial_cache_impl
+
+// Returns `Parse(value)`, parsing each distinct field trial `value` once per
+// process. Meant for configs of objects created per stream or per
+// PeerConnection, which otherwise parse the same field trial string every
+// time one is created. `Parse` must only depend on `value`, and its result
+// must be copyable. Thread safe.
+//
+// Example:
+//   config_(ParseFieldTrialCached<&Config::Parse>(
+//       field_trials.Lookup(Config::kKey)))
+template <auto Parse>
+auto ParseFieldTrialCached(absl::string_view value) {
+  using Result = decltype(Parse(value));
+  struct Cache {
+    Mutex mutex;
+    flat_map<std::string, Result> parsed RTC_GUARDED_BY(mutex);
+  };
+  static Cache* const cache = new Cache();
+
+  MutexLock lock(&cache->mutex);
+  auto it = cache->parsed.find(value);
+  if (it != cache->parsed.end()) {
+    return it->second;
+  }
+  Result result = Parse(value);
+  if (cache->parsed.size() < parsed_field_trial_cache_impl::kMaxCachedValues) {
+    cache->parsed.emplace(std::string(value), result);
+  }
+  return result;
+}
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_EXPERIMENTS_PARSED_FIELD_TRIAL_CACHE_H_
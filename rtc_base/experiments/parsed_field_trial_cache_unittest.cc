@@ -0,0 +1,52 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "rtc_base/experiments/parsed_field_trial_cache.h"
+
+#include <string>
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+int num_parses = 0;
+
+struct Config {
+  std::string value;
+
+  static Config Parse(absl::string_view value) {
+    ++num_parses;
+    return {std::string(value)};
+  }
+};
+
+TEST(ParsedFieldTrialCacheTest, ParsesEachValueOnce) {
+  num_parses = 0;
+  EXPECT_EQ(ParseFieldTrialCached<&Config::Parse>("a:1").value, "a:1");
+  EXPECT_EQ(ParseFieldTrialCached<&Config::Parse>("a:2").value, "a:2");
+  EXPECT_EQ(ParseFieldTrialCached<&Config::Parse>("a:1").value, "a:1");
+  EXPECT_EQ(ParseFieldTrialCached<&Config::Parse>("").value, "");
+  EXPECT_EQ(ParseFieldTrialCached<&Config::Parse>("a:2").value, "a:2");
+  EXPECT_EQ(num_parses, 3);
+}
+
+TEST(ParsedFieldTrialCacheTest, ParsesValuesBeyondCacheSizeEveryTime) {
+  for (size_t i = 0; i < parsed_field_trial_cache_impl::kMaxCachedValues;
+       ++i) {
+    ParseFieldTrialCached<&Config::Parse>("fill:" + std::to_string(i));
+  }
+  num_parses = 0;
+  EXPECT_EQ(ParseFieldTrialCached<&Config::Parse>("b:1").value, "b:1");
+  EXPECT_EQ(ParseFieldTrialCached<&Config::Parse>("b:1").value, "b:1");
+  EXPECT_EQ(num_parses, 2);
+}
+
+}  // namespace
+}  // namespace webrtc
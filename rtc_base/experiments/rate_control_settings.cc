@@ -17,6 +17,7 @@
 
 #include "absl/strings/match.h"
 #include "api/transport/field_trial_based_config.h"
+#include "rtc_base/experiments/parsed_field_trial_cache.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/numerics/safe_conversions.h"
 
@@ -81,7 +82,8 @@ RateControlSettings::RateControlSettings(
           ? kCongestionWindowDefaultFieldTrialString
           : key_value_config->Lookup(CongestionWindowConfig::kKey);
   congestion_window_config_ =
-      CongestionWindowConfig::Parse(congestion_window_config);
+      ParseFieldTrialCached<&CongestionWindowConfig::Parse>(
+          congestion_window_config);
   video_config_.vp8_base_heavy_tl3_alloc = IsEnabled(
       key_value_config, kUseBaseHeavyVp8Tl3RateAllocationFieldTrialName);
   video_config_.Parser()->Parse(
@@ -0,0 +1,186 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/io_uring_ring.h"
+
+#include <errno.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+namespace rtc {
+namespace {
+
+template <typename T>
+T* RingPointer(void* ring, uint32_t offset) {
+  return reinterpret_cast<T*>(static_cast<uint8_t*>(ring) + offset);
+}
+
+// The ring indices are shared with the kernel. The producer publishes with
+// release semantics and the consumer reads with acquire semantics.
+uint32_t LoadAcquire(const uint32_t* p) {
+  return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+void StoreRelease(uint32_t* p, uint32_t value) {
+  __atomic_store_n(p, value, __ATOMIC_RELEASE);
+}
+
+}  // namespace
+
+std::unique_ptr<IoUringRing> IoUringRing::Create(uint32_t entries) {
+  io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  int fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+  if (fd < 0) {
+    RTC_LOG_E(LS_WARNING, EN, errno) << "io_uring_setup";
+    return nullptr;
+  }
+  std::unique_ptr<IoUringRing> ring(new IoUringRing(fd));
+  if (!(params.features & IORING_FEAT_EXT_ARG)) {
+    RTC_LOG(LS_WARNING) << "io_uring lacks IORING_FEAT_EXT_ARG.";
+    return nullptr;
+  }
+  if (!ring->Map(params)) {
+    return nullptr;
+  }
+  return ring;
+}
+
+IoUringRing::IoUringRing(int fd) : fd_(fd) {}
+
+IoUringRing::~IoUringRing() {
+  if (sqes_) {
+    munmap(sqes_, sqes_size_);
+  }
+  if (cq_ring_ && cq_ring_ != sq_ring_) {
+    munmap(cq_ring_, cq_ring_size_);
+  }
+  if (sq_ring_) {
+    munmap(sq_ring_, sq_ring_size_);
+  }
+  close(fd_);
+}
+
+bool IoUringRing::Map(const io_uring_params& params) {
+  sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+  cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+  if (single_mmap) {
+    sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+  }
+
+  sq_ring_ = mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE,
+                  MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQ_RING);
+  if (sq_ring_ == MAP_FAILED) {
+    sq_ring_ = nullptr;
+    RTC_LOG_E(LS_WARNING, EN, errno) << "mmap IORING_OFF_SQ_RING";
+    return false;
+  }
+  if (single_mmap) {
+    cq_ring_ = sq_ring_;
+  } else {
+    cq_ring_ = mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_CQ_RING);
+    if (cq_ring_ == MAP_FAILED) {
+      cq_ring_ = nullptr;
+      RTC_LOG_E(LS_WARNING, EN, errno) << "mmap IORING_OFF_CQ_RING";
+      return false;
+    }
+  }
+  sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+  void* sqes = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQES);
+  if (sqes == MAP_FAILED) {
+    RTC_LOG_E(LS_WARNING, EN, errno) << "mmap IORING_OFF_SQES";
+    return false;
+  }
+  sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+  sq_head_ = RingPointer<uint32_t>(sq_ring_, params.sq_off.head);
+  sq_tail_ = RingPointer<uint32_t>(sq_ring_, params.sq_off.tail);
+  sq_mask_ = *RingPointer<uint32_t>(sq_ring_, params.sq_off.ring_mask);
+  sq_entries_ = *RingPointer<uint32_t>(sq_ring_, params.sq_off.ring_entries);
+  sq_array_ = RingPointer<uint32_t>(sq_ring_, params.sq_off.array);
+  cq_head_ = RingPointer<uint32_t>(cq_ring_, params.cq_off.head);
+  cq_tail_ = RingPointer<uint32_t>(cq_ring_, params.cq_off.tail);
+  cq_mask_ = *RingPointer<uint32_t>(cq_ring_, params.cq_off.ring_mask);
+  cqes_ = RingPointer<io_uring_cqe>(cq_ring_, params.cq_off.cqes);
+  return true;
+}
+
+io_uring_sqe* IoUringRing::GetSqe() {
+  const uint32_t tail = *sq_tail_ + to_submit_;
+  if (tail - LoadAcquire(sq_head_) >= sq_entries_) {
+    return nullptr;
+  }
+  const uint32_t index = tail & sq_mask_;
+  io_uring_sqe* sqe = &sqes_[index];
+  memset(sqe, 0, sizeof(*sqe));
+  sq_array_[index] = index;
+  ++to_submit_;
+  return sqe;
+}
+
+int IoUringRing::Submit() {
+  return Enter(/*min_complete=*/0, /*timeout_ms=*/0);
+}
+
+int IoUringRing::SubmitAndWait(int timeout_ms) {
+  return Enter(/*min_complete=*/1, timeout_ms);
+}
+
+int IoUringRing::Enter(uint32_t min_complete, int timeout_ms) {
+  const uint32_t to_submit = to_submit_;
+  if (to_submit > 0) {
+    StoreRelease(sq_tail_, *sq_tail_ + to_submit);
+    to_submit_ = 0;
+  }
+  if (to_submit == 0 && min_complete == 0) {
+    return 0;
+  }
+
+  uint32_t flags = 0;
+  __kernel_timespec ts = {};
+  io_uring_getevents_arg arg = {};
+  if (min_complete > 0) {
+    flags |= IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG;
+    if (timeout_ms >= 0) {
+      ts.tv_sec = timeout_ms / 1000;
+      ts.tv_nsec = (timeout_ms % 1000) * 1000000LL;
+      arg.ts = reinterpret_cast<uint64_t>(&ts);
+    }
+  }
+  int result = static_cast<int>(
+      syscall(__NR_io_uring_enter, fd_, to_submit, min_complete, flags,
+              min_complete > 0 ? &arg : nullptr,
+              min_complete > 0 ? sizeof(arg) : 0));
+  return result < 0 ? -errno : result;
+}
+
+int IoUringRing::ProcessCompletions(
+    rtc::FunctionView<void(const io_uring_cqe&)> callback) {
+  uint32_t head = *cq_head_;
+  const uint32_t tail = LoadAcquire(cq_tail_);
+  int count = 0;
+  for (; head != tail; ++head, ++count) {
+    callback(cqes_[head & cq_mask_]);
+  }
+  StoreRelease(cq_head_, head);
+  return count;
+}
+
+}  // namespace rtc
@@ -0,0 +1,89 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_IO_URING_RING_H_
+#define RTC_BASE_IO_URING_RING_H_
+
+#include <linux/io_uring.h>
+#include <stddef.h>
+
+#include <cstdint>
+#include <memory>
+
+#include "api/function_view.h"
+
+namespace rtc {
+
+// Minimal wrapper around an io_uring submission and completion queue pair,
+// built directly on the io_uring_setup() and io_uring_enter() system calls.
+//
+// The class is not thread safe and must be used from one thread at a time.
+class IoUringRing {
+ public:
+  // Returns nullptr if io_uring is not available, or if the kernel does not
+  // support timed waits through IORING_FEAT_EXT_ARG (Linux 5.11).
+  static std::unique_ptr<IoUringRing> Create(uint32_t entries);
+
+  ~IoUringRing();
+
+  IoUringRing(const IoUringRing&) = delete;
+  IoUringRing& operator=(const IoUringRing&) = delete;
+
+  // Returns a zeroed submission queue entry, or nullptr if the submission
+  // queue is full. Entries are handed to the kernel by the next Submit() or
+  // SubmitAndWait() call.
+  io_uring_sqe* GetSqe();
+
+  // Submits queued entries without waiting. Returns the number of entries
+  // submitted, or a negative errno value.
+  int Submit();
+
+  // Submits queued entries and waits up to `timeout_ms` milliseconds (-1 for
+  // forever) for at least one completion. Returns a non-negative value on
+  // success and a negative errno value otherwise; -ETIME means the timeout
+  // expired.
+  int SubmitAndWait(int timeout_ms);
+
+  // Invokes `callback` for every available completion queue entry and marks
+  // them as consumed. Returns the number of entries processed.
+  int ProcessCompletions(
+      rtc::FunctionView<void(const io_uring_cqe&)> callback);
+
+ private:
+  explicit IoUringRing(int fd);
+  bool Map(const io_uring_params& params);
+  int Enter(uint32_t min_complete, int timeout_ms);
+
+  const int fd_;
+
+  void* sq_ring_ = nullptr;
+  size_t sq_ring_size_ = 0;
+  void* cq_ring_ = nullptr;
+  size_t cq_ring_size_ = 0;
+  io_uring_sqe* sqes_ = nullptr;
+  size_t sqes_size_ = 0;
+
+  uint32_t* sq_head_ = nullptr;
+  uint32_t* sq_tail_ = nullptr;
+  uint32_t sq_mask_ = 0;
+  uint32_t sq_entries_ = 0;
+  uint32_t* sq_array_ = nullptr;
+  uint32_t* cq_head_ = nullptr;
+  uint32_t* cq_tail_ = nullptr;
+  uint32_t cq_mask_ = 0;
+  io_uring_cqe* cqes_ = nullptr;
+
+  // Entries handed out by GetSqe() but not yet submitted.
+  uint32_t to_submit_ = 0;
+};
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_IO_URING_RING_H_
@@ -0,0 +1,79 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/io_uring_ring.h"
+
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <memory>
+
+#include "test/gtest.h"
+
+namespace rtc {
+namespace {
+
+TEST(IoUringRingTest, WaitTimesOutWithoutCompletions) {
+  std::unique_ptr<IoUringRing> ring = IoUringRing::Create(8);
+  if (!ring) {
+    GTEST_SKIP() << "io_uring not supported";
+  }
+  EXPECT_EQ(-ETIME, ring->SubmitAndWait(/*timeout_ms=*/1));
+  EXPECT_EQ(0, ring->ProcessCompletions([](const io_uring_cqe&) {}));
+}
+
+TEST(IoUringRingTest, PollCompletesWhenDescriptorBecomesReadable) {
+  std::unique_ptr<IoUringRing> ring = IoUringRing::Create(8);
+  if (!ring) {
+    GTEST_SKIP() << "io_uring not supported";
+  }
+  int fds[2];
+  ASSERT_EQ(0, pipe(fds));
+
+  io_uring_sqe* sqe = ring->GetSqe();
+  ASSERT_NE(sqe, nullptr);
+  sqe->opcode = IORING_OP_POLL_ADD;
+  sqe->fd = fds[0];
+  sqe->poll32_events = POLLIN;
+  sqe->user_data = 42;
+  EXPECT_EQ(1, ring->Submit());
+  EXPECT_EQ(0, ring->ProcessCompletions([](const io_uring_cqe&) {}));
+
+  const char byte = 0;
+  ASSERT_EQ(1, write(fds[1], &byte, 1));
+  EXPECT_GE(ring->SubmitAndWait(/*timeout_ms=*/1000), 0);
+  int completions = ring->ProcessCompletions([](const io_uring_cqe& cqe) {
+    EXPECT_EQ(42u, cqe.user_data);
+    EXPECT_TRUE(cqe.res & POLLIN);
+  });
+  EXPECT_EQ(1, completions);
+
+  close(fds[0]);
+  close(fds[1]);
+}
+
+TEST(IoUringRingTest, GetSqeReturnsNullWhenSubmissionQueueIsFull) {
+  std::unique_ptr<IoUringRing> ring = IoUringRing::Create(4);
+  if (!ring) {
+    GTEST_SKIP() << "io_uring not supported";
+  }
+  for (int i = 0; i < 4; ++i) {
+    io_uring_sqe* sqe = ring->GetSqe();
+    ASSERT_NE(sqe, nullptr);
+    sqe->opcode = IORING_OP_NOP;
+  }
+  EXPECT_EQ(ring->GetSqe(), nullptr);
+  EXPECT_EQ(4, ring->Submit());
+  EXPECT_NE(ring->GetSqe(), nullptr);
+}
+
+}  // namespace
+}  // namespace rtc
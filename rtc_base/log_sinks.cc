@@ -14,9 +14,12 @@
 
 #include <cstdio>
 #include <string>
+#include <utility>
 
 #include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/strings/string_builder.h"
 
 namespace rtc {
 
@@ -83,4 +86,79 @@ CallSessionFileRotatingLogSink::CallSessionFileRotatingLogSink(
 
 CallSessionFileRotatingLogSink::~CallSessionFileRotatingLogSink() {}
 
+AsyncLogSink::AsyncLogSink(std::unique_ptr<LogSink> sink,
+                           size_t max_pending_bytes)
+    : sink_(std::move(sink)), max_pending_bytes_(max_pending_bytes) {
+  RTC_DCHECK(sink_);
+  writer_ = PlatformThread::SpawnJoinable([this] { WriteMessages(); },
+                                          "AsyncLogSink");
+}
+
+AsyncLogSink::~AsyncLogSink() {
+  stopping_.store(true);
+  wakeup_.Set();
+  writer_.Finalize();
+}
+
+void AsyncLogSink::OnLogMessage(const std::string& message) {
+  OnLogMessage(absl::string_view(message));
+}
+
+void AsyncLogSink::OnLogMessage(absl::string_view message) {
+  Enqueue({.text = std::string(message)});
+}
+
+void AsyncLogSink::OnLogMessage(const LogLineRef& line) {
+  Enqueue({.text = line.DefaultLogLine(),
+           .has_severity = true,
+           .severity = line.severity(),
+           .tag = std::string(line.tag())});
+}
+
+void AsyncLogSink::Enqueue(Message message) {
+  const size_t size = message.text.size();
+  if (pending_bytes_.fetch_add(size) + size > max_pending_bytes_) {
+    pending_bytes_.fetch_sub(size);
+    dropped_messages_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  queue_.Push(std::move(message));
+  if (!wakeup_pending_.exchange(true)) {
+    wakeup_.Set();
+  }
+}
+
+void AsyncLogSink::WriteMessages() {
+  bool stopping = false;
+  while (!stopping) {
+    wakeup_.Wait(Event::kForever);
+    // Read the stop flag before draining, so that messages logged before
+    // destruction started are all written.
+    stopping = stopping_.load();
+    // Cleared before draining: messages pushed from now on signal the event
+    // again, while messages pushed before are picked up below.
+    wakeup_pending_.store(false);
+    while (absl::optional<Message> message = queue_.Pop()) {
+      pending_bytes_.fetch_sub(message->text.size());
+      if (message->has_severity) {
+        // Same as LogSink::OnLogMessage(const LogLineRef&).
+#if defined(WEBRTC_ANDROID)
+        sink_->OnLogMessage(absl::string_view(message->text),
+                            message->severity, message->tag.c_str());
+#else
+        sink_->OnLogMessage(absl::string_view(message->text),
+                            message->severity);
+#endif
+      } else {
+        sink_->OnLogMessage(absl::string_view(message->text));
+      }
+    }
+    if (int dropped = dropped_messages_.exchange(0); dropped > 0) {
+      StringBuilder sb;
+      sb << "AsyncLogSink: dropped " << dropped << " log messages.\n";
+      sink_->OnLogMessage(sb.Release(), LS_WARNING);
+    }
+  }
+}
+
 }  // namespace rtc
@@ -13,12 +13,16 @@
 
 #include <stddef.h>
 
+#include <atomic>
 #include <memory>
 #include <string>
 
 #include "absl/strings/string_view.h"
+#include "rtc_base/event.h"
 #include "rtc_base/file_rotating_stream.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/mpsc_queue.h"
+#include "rtc_base/platform_thread.h"
 
 namespace rtc {
 
@@ -75,6 +79,53 @@ class CallSessionFileRotatingLogSink : public FileRotatingLogSink {
       const CallSessionFileRotatingLogSink&) = delete;
 };
 
+// Log sink that hands messages over to a background thread, which forwards
+// them to the wrapped sink. Logging threads only format the message and push
+// it on a lock-free queue, so that slow sinks such as FileRotatingLogSink
+// don't block them, e.g. on disk I/O. Once more than `max_pending_bytes` of
+// messages are waiting to be written, further messages are dropped, and the
+// number of dropped messages is logged to the wrapped sink.
+// The sink must be removed with LogMessage::RemoveLogToStream() before it's
+// destroyed. Destruction writes all pending messages.
+class AsyncLogSink : public LogSink {
+ public:
+  explicit AsyncLogSink(std::unique_ptr<LogSink> sink,
+                        size_t max_pending_bytes = 1 << 20);
+  ~AsyncLogSink() override;
+
+  AsyncLogSink(const AsyncLogSink&) = delete;
+  AsyncLogSink& operator=(const AsyncLogSink&) = delete;
+
+  void OnLogMessage(const std::string& message) override;
+  void OnLogMessage(absl::string_view message) override;
+  void OnLogMessage(const LogLineRef& line) override;
+
+ private:
+  struct Message {
+    std::string text;
+    bool has_severity = false;
+    LoggingSeverity severity = LS_NONE;
+    std::string tag;
+  };
+
+  void Enqueue(Message message);
+  void WriteMessages();
+
+  const std::unique_ptr<LogSink> sink_;
+  const size_t max_pending_bytes_;
+  webrtc::MpscQueue<Message> queue_;
+  std::atomic<size_t> pending_bytes_{0};
+  std::atomic<int> dropped_messages_{0};
+  // Set when `wakeup_` is signaled and the writer hasn't picked it up yet, to
+  // signal the event only once per batch of messages.
+  std::atomic<bool> wakeup_pending_{false};
+  std::atomic<bool> stopping_{false};
+  Event wakeup_;
+  // Declared last, so that the writer is stopped before the members it uses
+  // are destroyed.
+  PlatformThread writer_;
+};
+
 }  // namespace rtc
 
 #endif  // RTC_BASE_LOG_SINKS_H_
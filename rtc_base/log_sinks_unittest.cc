@@ -0,0 +1,115 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/log_sinks.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "rtc_base/event.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace rtc {
+namespace {
+
+using ::testing::HasSubstr;
+using ::testing::IsEmpty;
+
+// Collects messages and optionally blocks the writer until unblocked.
+class CollectingSink : public LogSink {
+ public:
+  CollectingSink(std::vector<std::string>* messages,
+                 webrtc::Mutex* mutex,
+                 Event* unblock)
+      : messages_(messages), mutex_(mutex), unblock_(unblock) {}
+
+  void OnLogMessage(const std::string& message) override {
+    OnLogMessage(absl::string_view(message));
+  }
+  void OnLogMessage(absl::string_view message) override {
+    if (unblock_) {
+      unblock_->Wait(Event::kForever);
+    }
+    webrtc::MutexLock lock(mutex_);
+    messages_->emplace_back(message);
+  }
+
+ private:
+  std::vector<std::string>* const messages_;
+  webrtc::Mutex* const mutex_;
+  Event* const unblock_;
+};
+
+TEST(AsyncLogSinkTest, WritesAllMessagesInOrderBeforeDestruction) {
+  std::vector<std::string> messages;
+  webrtc::Mutex mutex;
+  {
+    AsyncLogSink sink(
+        std::make_unique<CollectingSink>(&messages, &mutex, nullptr));
+    for (int i = 0; i < 100; ++i) {
+      sink.OnLogMessage(std::to_string(i));
+    }
+  }
+  ASSERT_EQ(messages.size(), 100u);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(messages[i], std::to_string(i));
+  }
+}
+
+TEST(AsyncLogSinkTest, DoesNotBlockOnSlowSinkAndDropsOverLimit) {
+  std::vector<std::string> messages;
+  webrtc::Mutex mutex;
+  Event unblock(/*manual_reset=*/true, /*initially_signaled=*/false);
+  {
+    AsyncLogSink sink(
+        std::make_unique<CollectingSink>(&messages, &mutex, &unblock),
+        /*max_pending_bytes=*/10);
+    // The writer blocks on the first message, the following ones queue up.
+    sink.OnLogMessage(std::string("first"));
+    sink.OnLogMessage(std::string("12345"));
+    sink.OnLogMessage(std::string("67890"));
+    sink.OnLogMessage(std::string("dropped"));
+    {
+      webrtc::MutexLock lock(&mutex);
+      EXPECT_THAT(messages, IsEmpty());
+    }
+    unblock.Set();
+  }
+  ASSERT_FALSE(messages.empty());
+  EXPECT_THAT(messages.back(), HasSubstr("dropped"));
+  EXPECT_THAT(messages.back(), HasSubstr("log messages"));
+  for (const std::string& message : messages) {
+    EXPECT_NE(message, "dropped");
+  }
+}
+
+TEST(AsyncLogSinkTest, ForwardsMessagesFromLogMessage) {
+  std::vector<std::string> messages;
+  webrtc::Mutex mutex;
+  {
+    AsyncLogSink sink(
+        std::make_unique<CollectingSink>(&messages, &mutex, nullptr));
+    LogMessage::AddLogToStream(&sink, LS_INFO);
+    PlatformThread::SpawnJoinable(
+        [] { RTC_LOG(LS_INFO) << "Logged on another thread"; }, "Logger");
+    LogMessage::RemoveLogToStream(&sink);
+  }
+  ASSERT_EQ(messages.size(), 1u);
+  EXPECT_THAT(messages[0], HasSubstr("Logged on another thread"));
+}
+
+}  // namespace
+}  // namespace rtc
@@ -541,6 +541,18 @@ void Log(const LogArgType* fmt, ...) {
   va_end(args);
 }
 
+bool ShouldLogAfterInterval(std::atomic<int64_t>& last_log_ms,
+                            int64_t interval_ms) {
+  const int64_t now_ms = rtc::TimeMillis();
+  int64_t last_ms = last_log_ms.load(std::memory_order_relaxed);
+  if (last_ms != kNeverLoggedMs && now_ms - last_ms < interval_ms) {
+    return false;
+  }
+  // Only one of several threads racing to log wins.
+  return last_log_ms.compare_exchange_strong(last_ms, now_ms,
+                                             std::memory_order_relaxed);
+}
+
 }  // namespace webrtc_logging_impl
 }  // namespace rtc
 #endif
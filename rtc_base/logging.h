@@ -51,6 +51,8 @@
 #include <errno.h>
 
 #include <atomic>
+#include <cstdint>
+#include <limits>
 #include <sstream>  // no-presubmit-check TODO(webrtc:8982)
 #include <string>
 #include <type_traits>
@@ -368,6 +370,21 @@ inline void Log(const LogArgType* fmt, ...) {
 }
 #endif
 
+// Value of a call site's last log time before its first message.
+constexpr int64_t kNeverLoggedMs = std::numeric_limits<int64_t>::min();
+
+// Returns true if at least `interval_ms` have passed since `last_log_ms`, and
+// then sets it to the current time. Used by RTC_LOG_EVERY_N_MS.
+#if RTC_LOG_ENABLED()
+bool ShouldLogAfterInterval(std::atomic<int64_t>& last_log_ms,
+                            int64_t interval_ms);
+#else
+inline bool ShouldLogAfterInterval(std::atomic<int64_t>& last_log_ms,
+                                   int64_t interval_ms) {
+  return false;
+}
+#endif
+
 // Ephemeral type that represents the result of the logging << operator.
 template <typename... Ts>
 class LogStreamer;
@@ -655,6 +672,18 @@ class LogMessage {
   !::rtc::LogMessage::IsNoop<::rtc::sev>() && (condition) && \
       RTC_LOG_FILE_LINE(::rtc::sev, __FILE__, __LINE__)
 
+// Logs at most once every `interval_ms` from the call site, e.g. for verbose
+// logging on hot paths such as per-packet processing. Messages in between
+// are neither formatted nor passed to the sinks.
+#define RTC_LOG_EVERY_N_MS(sev, interval_ms)                               \
+  RTC_LOG_IF(sev, ::rtc::webrtc_logging_impl::ShouldLogAfterInterval(      \
+                      []() -> std::atomic<int64_t>& {                      \
+                        static std::atomic<int64_t> last_log_ms(           \
+                            ::rtc::webrtc_logging_impl::kNeverLoggedMs);   \
+                        return last_log_ms;                                \
+                      }(),                                                 \
+                      interval_ms))
+
 // The _V version is for when a variable is passed in.
 #define RTC_LOG_V(sev) \
   !::rtc::LogMessage::IsNoop(sev) && RTC_LOG_FILE_LINE(sev, __FILE__, __LINE__)
@@ -17,9 +17,11 @@
 #include <algorithm>
 
 #include "absl/strings/string_view.h"
+#include "api/units/time_delta.h"
 #include "rtc_base/arraysize.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/event.h"
+#include "rtc_base/fake_clock.h"
 #include "rtc_base/platform_thread.h"
 #include "rtc_base/time_utils.h"
 #include "test/gmock.h"
@@ -382,5 +384,30 @@ TEST(LogTest, ToLogStringUsedForUnknownTypes) {
   LogMessage::RemoveLogToStream(&stream);
 }
 
+TEST(LogTest, EveryNMsLogsOncePerInterval) {
+  ScopedFakeClock clock;
+  clock.AdvanceTime(webrtc::TimeDelta::Seconds(1));
+  std::string str;
+  LogSinkImpl stream(&str);
+  LogMessage::AddLogToStream(&stream, LS_INFO);
+  int formatted = 0;
+  auto log = [&formatted] {
+    RTC_LOG_EVERY_N_MS(LS_INFO, 100) << "Message " << ++formatted;
+  };
+
+  log();
+  log();
+  EXPECT_EQ(formatted, 1);
+  clock.AdvanceTime(webrtc::TimeDelta::Millis(99));
+  log();
+  EXPECT_EQ(formatted, 1);
+  clock.AdvanceTime(webrtc::TimeDelta::Millis(1));
+  log();
+  EXPECT_EQ(formatted, 2);
+  EXPECT_THAT(str, ::testing::HasSubstr("Message 1"));
+  EXPECT_THAT(str, ::testing::HasSubstr("Message 2"));
+  LogMessage::RemoveLogToStream(&stream);
+}
+
 }  // namespace rtc
 #endif  // RTC_LOG_ENABLED()
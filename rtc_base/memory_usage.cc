@@ -82,4 +82,14 @@ int64_t GetProcessResidentSizeBytes() {
 #endif
 }
 
+void MemoryUsageVisitor::Add(absl::string_view component, int64_t bytes) {
+  total_bytes_ += bytes;
+  auto it = bytes_by_component_.find(component);
+  if (it == bytes_by_component_.end()) {
+    bytes_by_component_.emplace(component, bytes);
+  } else {
+    it->second += bytes;
+  }
+}
+
 }  // namespace rtc
@@ -12,6 +12,12 @@
 
 #include <stdint.h>
 
+#include <functional>
+#include <map>
+#include <string>
+
+#include "absl/strings/string_view.h"
+
 namespace rtc {
 
 // Returns current memory used by the process in bytes (working set size on
@@ -19,6 +25,24 @@ namespace rtc {
 // Returns -1 on failure.
 int64_t GetProcessResidentSizeBytes();
 
+// Collects the memory held by the buffers of a session, e.g. its packet
+// histories and jitter buffers. Components report their usage with Add(),
+// keyed by a component name; usage added for the same name is summed.
+class MemoryUsageVisitor {
+ public:
+  void Add(absl::string_view component, int64_t bytes);
+
+  int64_t total_bytes() const { return total_bytes_; }
+  const std::map<std::string, int64_t, std::less<>>& bytes_by_component()
+      const {
+    return bytes_by_component_;
+  }
+
+ private:
+  int64_t total_bytes_ = 0;
+  std::map<std::string, int64_t, std::less<>> bytes_by_component_;
+};
+
 }  // namespace rtc
 
 #endif  // RTC_BASE_MEMORY_USAGE_H_
@@ -19,4 +19,15 @@ TEST(GetMemoryUsage, SimpleTest) {
   EXPECT_GE(used_bytes, 0);
 }
 
+TEST(MemoryUsageVisitor, SumsUsagePerComponent) {
+  MemoryUsageVisitor visitor;
+  visitor.Add("packetHistory", 1000);
+  visitor.Add("jitterBuffer", 300);
+  visitor.Add("packetHistory", 200);
+  EXPECT_EQ(visitor.total_bytes(), 1500);
+  EXPECT_EQ(visitor.bytes_by_component().size(), 2u);
+  EXPECT_EQ(visitor.bytes_by_component().at("packetHistory"), 1200);
+  EXPECT_EQ(visitor.bytes_by_component().at("jitterBuffer"), 300);
+}
+
 }  // namespace rtc
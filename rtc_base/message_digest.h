@@ -16,6 +16,7 @@
 #include <string>
 
 #include "absl/strings/string_view.h"
+#include "api/array_view.h"
 
 namespace rtc {
 
@@ -111,6 +112,15 @@ size_t ComputeHmac(absl::string_view alg,
                    size_t in_len,
                    void* output,
                    size_t out_len);
+// Like the first function, but the input is the concatenation of
+// `input_segments`, which saves copying them into one buffer.
+size_t ComputeHmac(
+    MessageDigest* digest,
+    const void* key,
+    size_t key_len,
+    rtc::ArrayView<const rtc::ArrayView<const uint8_t>> input_segments,
+    void* output,
+    size_t out_len);
 // Computes the HMAC of `input` using the `digest` hash implementation and `key`
 // to key the HMAC, and returns it as a hex-encoded string.
 std::string ComputeHmac(MessageDigest* digest,
@@ -0,0 +1,141 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_MPSC_QUEUE_H_
+#define RTC_BASE_MPSC_QUEUE_H_
+
+#include <stddef.h>
+
+#include <atomic>
+#include <utility>
+
+#include "absl/types/optional.h"
+#include "rtc_base/synchronization/yield.h"
+
+namespace webrtc {
+
+// Unbounded lock-free multi-producer, single-consumer FIFO queue, used as the
+// intake of task queues. Push() is wait-free and may be called from any
+// thread. All other methods are consumer methods; at most one thread at a
+// time may call them.
+//
+// The queue is a singly linked list of nodes, each holding one value, after
+// D. Vyukov's node-based MPSC queue with a stub node. A producer links in its
+// node with one atomic exchange and one store.
+template <typename T>
+class MpscQueue {
+ public:
+  MpscQueue() : head_(&stub_), tail_(&stub_) {}
+  MpscQueue(const MpscQueue&) = delete;
+  MpscQueue& operator=(const MpscQueue&) = delete;
+  ~MpscQueue() { Clear(); }
+
+  void Push(T value) { PushNode(new Node(std::move(value))); }
+
+  // Removes and returns the oldest value, or nullopt if the queue is empty.
+  // If a producer is in the middle of pushing, waits for it to finish, so
+  // that values pushed before by the same thread aren't skipped.
+  absl::optional<T> Pop() {
+    while (true) {
+      if (NodeBase* node = TryPop()) {
+        Node* value_node = static_cast<Node*>(node);
+        T value = std::move(value_node->value);
+        delete value_node;
+        return value;
+      }
+      if (empty()) {
+        return absl::nullopt;
+      }
+      YieldCurrentThread();
+    }
+  }
+
+  // Returns true if no values are queued, and no push is in progress.
+  // Sequentially consistent with Push(), which allows to use it together with
+  // a flag to decide if the consumer needs to be woken up.
+  bool empty() const {
+    return tail_ == &stub_ && head_.load(std::memory_order_seq_cst) == &stub_;
+  }
+
+  // Number of queued values. O(n), intended for tests and diagnostics.
+  size_t size() const {
+    size_t size = 0;
+    for (const NodeBase* node = tail_; node != nullptr;
+         node = node->next.load(std::memory_order_acquire)) {
+      if (node != &stub_) {
+        ++size;
+      }
+    }
+    return size;
+  }
+
+  // Destroys all queued values.
+  void Clear() {
+    while (Pop()) {
+    }
+  }
+
+ private:
+  struct NodeBase {
+    std::atomic<NodeBase*> next{nullptr};
+  };
+  struct Node : NodeBase {
+    explicit Node(T value) : value(std::move(value)) {}
+    T value;
+  };
+
+  void PushNode(NodeBase* node) {
+    node->next.store(nullptr, std::memory_order_relaxed);
+    NodeBase* prev = head_.exchange(node, std::memory_order_seq_cst);
+    // Between the exchange and this store, the consumer can't reach `node`.
+    prev->next.store(node, std::memory_order_release);
+  }
+
+  // Returns the oldest node, or null if the queue is empty or the next node
+  // is not linked in yet.
+  NodeBase* TryPop() {
+    NodeBase* tail = tail_;
+    NodeBase* next = tail->next.load(std::memory_order_acquire);
+    if (tail == &stub_) {
+      if (next == nullptr) {
+        return nullptr;
+      }
+      tail_ = next;
+      tail = next;
+      next = next->next.load(std::memory_order_acquire);
+    }
+    if (next != nullptr) {
+      tail_ = next;
+      return tail;
+    }
+    if (tail != head_.load(std::memory_order_acquire)) {
+      return nullptr;
+    }
+    // `tail` is the last node. Put the stub behind it so that it can be
+    // handed out without leaving the list empty.
+    PushNode(&stub_);
+    next = tail->next.load(std::memory_order_acquire);
+    if (next != nullptr) {
+      tail_ = next;
+      return tail;
+    }
+    return nullptr;
+  }
+
+  // Producer end: the most recently pushed node.
+  std::atomic<NodeBase*> head_;
+  // Consumer end: the oldest node, or the stub.
+  NodeBase* tail_;
+  NodeBase stub_;
+};
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_MPSC_QUEUE_H_
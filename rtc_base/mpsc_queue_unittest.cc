@@ -0,0 +1,90 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/mpsc_queue.h"
+
+#include <memory>
+#include <vector>
+
+#include "rtc_base/platform_thread.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::Optional;
+
+TEST(MpscQueueTest, PopsInPushOrder) {
+  MpscQueue<int> queue;
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(queue.Pop(), absl::nullopt);
+  queue.Push(1);
+  queue.Push(2);
+  EXPECT_FALSE(queue.empty());
+  EXPECT_EQ(queue.size(), 2u);
+  EXPECT_THAT(queue.Pop(), Optional(1));
+  queue.Push(3);
+  EXPECT_THAT(queue.Pop(), Optional(2));
+  EXPECT_THAT(queue.Pop(), Optional(3));
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(queue.Pop(), absl::nullopt);
+  queue.Push(4);
+  EXPECT_THAT(queue.Pop(), Optional(4));
+  EXPECT_EQ(queue.size(), 0u);
+}
+
+TEST(MpscQueueTest, DestroysQueuedValues) {
+  auto value = std::make_shared<int>(1);
+  {
+    MpscQueue<std::shared_ptr<int>> queue;
+    queue.Push(value);
+    queue.Push(value);
+    EXPECT_EQ(value.use_count(), 3);
+  }
+  EXPECT_EQ(value.use_count(), 1);
+}
+
+TEST(MpscQueueTest, KeepsOrderOfEachProducer) {
+  constexpr int kNumProducers = 4;
+  constexpr int kNumValues = 20'000;
+  struct Value {
+    int producer;
+    int sequence;
+  };
+  MpscQueue<Value> queue;
+  std::vector<rtc::PlatformThread> producers;
+  for (int producer = 0; producer < kNumProducers; ++producer) {
+    producers.push_back(rtc::PlatformThread::SpawnJoinable(
+        [&queue, producer] {
+          for (int i = 0; i < kNumValues; ++i) {
+            queue.Push({.producer = producer, .sequence = i});
+          }
+        },
+        "producer"));
+  }
+
+  std::vector<int> next_sequence(kNumProducers, 0);
+  int num_popped = 0;
+  while (num_popped < kNumProducers * kNumValues) {
+    absl::optional<Value> value = queue.Pop();
+    if (!value) {
+      continue;
+    }
+    ASSERT_EQ(value->sequence, next_sequence[value->producer]);
+    ++next_sequence[value->producer];
+    ++num_popped;
+  }
+  producers.clear();
+  EXPECT_TRUE(queue.empty());
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -43,6 +43,7 @@
 #include "rtc_base/string_utils.h"
 #include "rtc_base/strings/string_builder.h"
 #include "rtc_base/thread.h"
+#include "rtc_base/time_utils.h"
 
 namespace rtc {
 namespace {
@@ -568,6 +569,9 @@ BasicNetworkManager::~BasicNetworkManager() {
 void BasicNetworkManager::OnNetworksChanged() {
   RTC_DCHECK_RUN_ON(thread_);
   RTC_LOG(LS_INFO) << "Network change was observed";
+  // Make sure that the networks are enumerated again by the next client, if
+  // this update is skipped because no client is updating.
+  last_update_time_ms_ = absl::nullopt;
   UpdateNetworksOnce();
 }
 
@@ -971,10 +975,30 @@ void BasicNetworkManager::StartUpdating() {
   } else {
     RTC_DCHECK(task_safety_flag_ == nullptr);
     task_safety_flag_ = webrtc::PendingTaskSafetyFlag::Create();
-    thread_->PostTask(SafeTask(task_safety_flag_, [this] {
-      RTC_DCHECK_RUN_ON(thread_);
-      UpdateNetworksContinually();
-    }));
+    const int64_t age_ms =
+        last_update_time_ms_ ? TimeMillis() - *last_update_time_ms_ : -1;
+    if (age_ms >= 0 && age_ms < kNetworksUpdateIntervalMs) {
+      // The networks were enumerated recently, for clients that have stopped
+      // since. Signal them right away, so that the new clients can start
+      // allocating ports, and enumerate again when the next update is due.
+      thread_->PostTask(SafeTask(task_safety_flag_, [this] {
+        RTC_DCHECK_RUN_ON(thread_);
+        sent_first_update_ = true;
+        SignalNetworksChanged();
+      }));
+      thread_->PostDelayedTask(
+          SafeTask(task_safety_flag_,
+                   [this] {
+                     RTC_DCHECK_RUN_ON(thread_);
+                     UpdateNetworksContinually();
+                   }),
+          TimeDelta::Millis(kNetworksUpdateIntervalMs - age_ms));
+    } else {
+      thread_->PostTask(SafeTask(task_safety_flag_, [this] {
+        RTC_DCHECK_RUN_ON(thread_);
+        UpdateNetworksContinually();
+      }));
+    }
     StartNetworkMonitor();
   }
   ++start_count_;
@@ -1070,6 +1094,7 @@ void BasicNetworkManager::UpdateNetworksOnce() {
     MergeNetworkList(std::move(list), &changed, &stats);
     set_default_local_addresses(QueryDefaultLocalAddress(AF_INET),
                                 QueryDefaultLocalAddress(AF_INET6));
+    last_update_time_ms_ = TimeMillis();
     if (changed || !sent_first_update_) {
       SignalNetworksChanged();
       sent_first_update_ = true;
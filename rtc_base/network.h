@@ -21,6 +21,7 @@
 
 #include "absl/base/attributes.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
 #include "api/array_view.h"
 #include "api/field_trials_view.h"
 #include "api/sequence_checker.h"
@@ -360,6 +361,10 @@ class RTC_EXPORT BasicNetworkManager : public NetworkManagerBase,
   Thread* thread_ = nullptr;
   bool sent_first_update_ = true;
   int start_count_ = 0;
+  // When the networks were last enumerated, in ms. Clients that start
+  // updating within an update interval of it, after all the previous ones
+  // stopped, are given these networks without enumerating them again.
+  absl::optional<int64_t> last_update_time_ms_ RTC_GUARDED_BY(thread_);
 
   webrtc::AlwaysValidPointer<const webrtc::FieldTrialsView,
                              webrtc::FieldTrialBasedConfig>
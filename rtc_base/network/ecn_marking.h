@@ -0,0 +1,28 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_NETWORK_ECN_MARKING_H_
+#define RTC_BASE_NETWORK_ECN_MARKING_H_
+
+namespace rtc {
+
+// The ECN codepoint carried in the two least significant bits of the IP
+// DiffServ field, https://www.rfc-editor.org/rfc/rfc3168#section-5. The
+// values match the bits on the wire.
+enum class EcnMarking {
+  kNotEct = 0,  // Not ECN-Capable Transport.
+  kEct1 = 1,    // ECN-Capable Transport, used by L4S (RFC 9331).
+  kEct0 = 2,    // ECN-Capable Transport, classic ECN.
+  kCe = 3,      // Congestion Experienced.
+};
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_NETWORK_ECN_MARKING_H_
@@ -18,9 +18,11 @@ namespace rtc {
 
 ReceivedPacket::ReceivedPacket(rtc::ArrayView<const uint8_t> payload,
                                const SocketAddress& source_address,
-                               absl::optional<webrtc::Timestamp> arrival_time)
+                               absl::optional<webrtc::Timestamp> arrival_time,
+                               EcnMarking ecn)
     : payload_(payload),
       arrival_time_(std::move(arrival_time)),
+      ecn_(ecn),
       source_address_(source_address) {}
 
 // static
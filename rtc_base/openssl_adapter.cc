@@ -18,12 +18,22 @@
 #ifdef OPENSSL_IS_BORINGSSL
 #include <openssl/pool.h>
 #endif
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
 #include <openssl/rand.h>
 #include <openssl/x509.h>
 #include <string.h>
 #include <time.h>
 
 #include <memory>
+#include <utility>
+
+#if defined(WEBRTC_LINUX)
+#include <linux/tls.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#endif
 
 // Use CRYPTO_BUFFER APIs if available and we have no dependency on X509
 // objects.
@@ -33,6 +43,7 @@
 #endif
 
 #include "absl/memory/memory.h"
+#include "absl/strings/match.h"
 #include "api/units/time_delta.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
@@ -44,9 +55,30 @@
 #include "rtc_base/openssl_identity.h"
 #endif
 #include "rtc_base/openssl_utility.h"
+#include "rtc_base/string_encode.h"
 #include "rtc_base/strings/str_join.h"
 #include "rtc_base/strings/string_builder.h"
 #include "rtc_base/thread.h"
+#include "rtc_base/zero_memory.h"
+#include "system_wrappers/include/field_trial.h"
+
+// Kernel TLS (kTLS) takes over the record encryption of TLS 1.3 connections
+// on Linux, see OpenSSLAdapter::MaybeEnableKernelTlsTx().
+#if defined(WEBRTC_LINUX) && defined(TLS_1_3_VERSION)
+#define WEBRTC_USE_KERNEL_TLS
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+#ifndef TCP_ULP
+#define TCP_ULP 31
+#endif
+#endif
+
+namespace {
+
+constexpr char kKernelTlsOffloadFieldTrial[] = "WebRTC-KernelTlsOffload";
+
+}  // namespace
 
 //////////////////////////////////////////////////////////////////////
 // SocketBIO
@@ -146,6 +178,89 @@ static long socket_ctrl(BIO* b, int cmd, long num, void* ptr) {  // NOLINT
   }
 }
 
+#if defined(WEBRTC_USE_KERNEL_TLS)
+//////////////////////////////////////////////////////////////////////
+// DiscardBIO
+//////////////////////////////////////////////////////////////////////
+
+// Write BIO of connections whose records are sent by the kernel. It drops
+// what OpenSSL still writes on its own, such as responses to key updates,
+// which keeps the kernel the only writer of the TLS stream.
+static int discard_write(BIO* b, const char* in, int inl) {
+  return inl;
+}
+
+static BIO_METHOD* BIO_discard_method() {
+  static BIO_METHOD* methods = [] {
+    BIO_METHOD* methods = BIO_meth_new(BIO_TYPE_BIO, "discard");
+    BIO_meth_set_write(methods, discard_write);
+    BIO_meth_set_ctrl(methods, socket_ctrl);
+    BIO_meth_set_create(methods, socket_new);
+    BIO_meth_set_destroy(methods, socket_free);
+    return methods;
+  }();
+  return methods;
+}
+
+// HKDF-Expand-Label(secret, label, "", out.size()) of RFC 8446, section 7.1,
+// for outputs of at most one hash length.
+static bool ExpandTls13Label(const EVP_MD* md,
+                             rtc::ArrayView<const uint8_t> secret,
+                             absl::string_view label,
+                             rtc::ArrayView<uint8_t> out) {
+  if (out.size() > static_cast<size_t>(EVP_MD_size(md))) {
+    return false;
+  }
+  std::string info;
+  info.push_back(static_cast<char>(out.size() >> 8));
+  info.push_back(static_cast<char>(out.size() & 0xff));
+  info.push_back(static_cast<char>(6 + label.size()));
+  info.append("tls13 ");
+  info.append(label.data(), label.size());
+  // Empty context, followed by the counter of the first HKDF-Expand block.
+  info.push_back(0);
+  info.push_back(1);
+  uint8_t block[EVP_MAX_MD_SIZE];
+  unsigned int block_size = 0;
+  if (!HMAC(md, secret.data(), secret.size(),
+            reinterpret_cast<const uint8_t*>(info.data()), info.size(), block,
+            &block_size)) {
+    return false;
+  }
+  memcpy(out.data(), block, out.size());
+  rtc::ExplicitZeroMemory(block, sizeof(block));
+  return true;
+}
+
+// Sets the TLS 1.3 transmit key and IV derived from the application traffic
+// `secret` on the socket `fd`, with the record sequence number 0.
+// `CryptoInfo` is the Linux kTLS parameter struct of the cipher.
+template <typename CryptoInfo>
+static bool SetKernelTlsTxKey(int fd,
+                              uint16_t cipher_type,
+                              const EVP_MD* md,
+                              rtc::ArrayView<const uint8_t> secret) {
+  static_assert(sizeof(CryptoInfo::salt) + sizeof(CryptoInfo::iv) == 12,
+                "TLS 1.3 uses 96 bit nonces");
+  CryptoInfo crypto_info = {};
+  crypto_info.info.version = TLS_1_3_VERSION;
+  crypto_info.info.cipher_type = cipher_type;
+  uint8_t iv[12];
+  bool success = ExpandTls13Label(md, secret, "key", crypto_info.key) &&
+                 ExpandTls13Label(md, secret, "iv", iv);
+  if (success) {
+    memcpy(crypto_info.salt, iv, sizeof(crypto_info.salt));
+    memcpy(crypto_info.iv, iv + sizeof(crypto_info.salt),
+           sizeof(crypto_info.iv));
+    success = setsockopt(fd, SOL_TLS, TLS_TX, &crypto_info,
+                         sizeof(crypto_info)) == 0;
+  }
+  rtc::ExplicitZeroMemory(&crypto_info, sizeof(crypto_info));
+  rtc::ExplicitZeroMemory(iv, sizeof(iv));
+  return success;
+}
+#endif  // WEBRTC_USE_KERNEL_TLS
+
 static void LogSslError() {
   // Walk down the error stack to find the SSL error.
   uint32_t error_code;
@@ -310,6 +425,9 @@ int OpenSSLAdapter::BeginSSL() {
   }
 
   SSL_set_app_data(ssl_, this);
+  kernel_tls_enabled_ =
+      ssl_mode_ == SSL_MODE_TLS && role_ == SSL_CLIENT &&
+      webrtc::field_trial::IsEnabled(kKernelTlsOffloadFieldTrial);
 
   // SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER allows different buffers to be passed
   // into SSL_write when a record could only be partially transmitted (and thus
@@ -392,6 +510,7 @@ int OpenSSLAdapter::ContinueSSL() {
       }
 
       state_ = SSL_CONNECTED;
+      MaybeEnableKernelTlsTx();
       AsyncSocketAdapter::OnConnectEvent(this);
       // TODO(benwright): Refactor this code path.
       // Don't let ourselves go away during the callbacks
@@ -443,6 +562,11 @@ void OpenSSLAdapter::Cleanup() {
   ssl_write_needs_read_ = false;
   custom_cert_verifier_status_ = false;
   pending_data_.Clear();
+  kernel_tls_enabled_ = false;
+  ExplicitZeroMemory(
+      ArrayView<char>(&kernel_tls_tx_secret_[0], kernel_tls_tx_secret_.size()));
+  kernel_tls_tx_secret_.clear();
+  kernel_tls_tx_ = false;
 
   if (ssl_) {
     SSL_free(ssl_);
@@ -516,6 +640,10 @@ int OpenSSLAdapter::Send(const void* pv, size_t cb) {
       return SOCKET_ERROR;
   }
 
+  if (kernel_tls_tx_) {
+    return AsyncSocketAdapter::Send(pv, cb);
+  }
+
   int ret;
   int error;
 
@@ -944,6 +1072,78 @@ int OpenSSLAdapter::SSLVerifyInternal(int previous_status,
 }
 #endif  // !defined(WEBRTC_USE_CRYPTO_BUFFER_CALLBACK)
 
+void OpenSSLAdapter::MaybeEnableKernelTlsTx() {
+#if defined(WEBRTC_USE_KERNEL_TLS)
+  if (!kernel_tls_enabled_) {
+    return;
+  }
+  // Only a client is known not to have sent any record with the application
+  // traffic secret yet, which lets the kernel start at sequence number 0.
+  std::string secret = std::move(kernel_tls_tx_secret_);
+  kernel_tls_tx_secret_.clear();
+  const SSL_CIPHER* cipher = SSL_get_current_cipher(ssl_);
+  int fd = GetSocket()->GetNativeDescriptor();
+  if (role_ == SSL_CLIENT && SSL_version(ssl_) == TLS1_3_VERSION &&
+      cipher && !secret.empty() && pending_data_.empty() && fd >= 0) {
+    ArrayView<const uint8_t> key(
+        reinterpret_cast<const uint8_t*>(secret.data()), secret.size());
+    // The "tls" upper layer protocol leaves the socket unchanged until keys
+    // are installed, so failing after attaching it is harmless.
+    bool success =
+        setsockopt(fd, IPPROTO_TCP, TCP_ULP, "tls", sizeof("tls")) == 0;
+    if (success) {
+      switch (SSL_CIPHER_get_protocol_id(cipher)) {
+        case 0x1301:  // TLS_AES_128_GCM_SHA256
+          success = SetKernelTlsTxKey<tls12_crypto_info_aes_gcm_128>(
+              fd, TLS_CIPHER_AES_GCM_128, EVP_sha256(), key);
+          break;
+        case 0x1302:  // TLS_AES_256_GCM_SHA384
+          success = SetKernelTlsTxKey<tls12_crypto_info_aes_gcm_256>(
+              fd, TLS_CIPHER_AES_GCM_256, EVP_sha384(), key);
+          break;
+#if defined(TLS_CIPHER_CHACHA20_POLY1305)
+        case 0x1303:  // TLS_CHACHA20_POLY1305_SHA256
+          success = SetKernelTlsTxKey<tls12_crypto_info_chacha20_poly1305>(
+              fd, TLS_CIPHER_CHACHA20_POLY1305, EVP_sha256(), key);
+          break;
+#endif
+        default:
+          success = false;
+          break;
+      }
+    }
+    if (success) {
+      // From now on the kernel is the only writer of the TLS stream.
+      SSL_set0_wbio(ssl_, BIO_new(BIO_discard_method()));
+      kernel_tls_tx_ = true;
+      RTC_LOG(LS_INFO) << "Kernel TLS enabled for sending to "
+                       << ssl_host_name_;
+    } else {
+      RTC_LOG(LS_INFO) << "Kernel TLS not available for "
+                       << SSL_CIPHER_get_name(cipher) << ", errno=" << errno;
+    }
+  }
+  ExplicitZeroMemory(ArrayView<char>(&secret[0], secret.size()));
+#endif  // WEBRTC_USE_KERNEL_TLS
+}
+
+void OpenSSLAdapter::KeyLogCallback(const SSL* ssl, const char* line) {
+  OpenSSLAdapter* stream =
+      reinterpret_cast<OpenSSLAdapter*>(SSL_get_app_data(ssl));
+  // Lines are "<label> <client random> <secret>", all but the label in hex.
+  constexpr absl::string_view kLabel = "CLIENT_TRAFFIC_SECRET_0 ";
+  absl::string_view log_line(line);
+  if (!stream || !stream->kernel_tls_enabled_ ||
+      !absl::StartsWith(log_line, kLabel)) {
+    return;
+  }
+  absl::string_view secret_hex = log_line.substr(log_line.rfind(' ') + 1);
+  std::string secret(secret_hex.size() / 2, '\0');
+  secret.resize(hex_decode(ArrayView<char>(&secret[0], secret.size()),
+                           secret_hex));
+  stream->kernel_tls_tx_secret_ = std::move(secret);
+}
+
 int OpenSSLAdapter::NewSSLSessionCallback(SSL* ssl, SSL_SESSION* session) {
   OpenSSLAdapter* stream =
       reinterpret_cast<OpenSSLAdapter*>(SSL_get_app_data(ssl));
@@ -1015,6 +1215,13 @@ SSL_CTX* OpenSSLAdapter::CreateContext(SSLMode mode, bool enable_cache) {
     SSL_CTX_sess_set_new_cb(ctx, &OpenSSLAdapter::NewSSLSessionCallback);
   }
 
+#if defined(WEBRTC_USE_KERNEL_TLS)
+  if (mode == SSL_MODE_TLS &&
+      webrtc::field_trial::IsEnabled(kKernelTlsOffloadFieldTrial)) {
+    SSL_CTX_set_keylog_callback(ctx, &OpenSSLAdapter::KeyLogCallback);
+  }
+#endif
+
   return ctx;
 }
 
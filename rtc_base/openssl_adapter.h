@@ -116,6 +116,14 @@ class OpenSSLAdapter final : public SSLAdapter {
   int DoSslWrite(const void* pv, size_t cb, int* error);
   bool SSLPostConnectionCheck(SSL* ssl, absl::string_view host);
 
+  // Once a TLS 1.3 client handshake completes, hands the encryption of sent
+  // records to the kernel (Linux kTLS) if the "WebRTC-KernelTlsOffload" field
+  // trial is enabled and the socket, kernel and cipher suite support it.
+  // Received records are still decrypted by SSL_read.
+  void MaybeEnableKernelTlsTx();
+  // Captures the client application traffic secret for kernel TLS.
+  static void KeyLogCallback(const SSL* ssl, const char* line);
+
   // Logs info about the state of the SSL connection.
   static void SSLInfoCallback(const SSL* ssl, int where, int ret);
 
@@ -174,6 +182,13 @@ class OpenSSLAdapter final : public SSLAdapter {
   bool custom_cert_verifier_status_;
   // Flag to cancel pending timeout task.
   webrtc::ScopedTaskSafety timer_;
+  // Whether kernel TLS is enabled for this connection, and the client
+  // application traffic secret captured for it during the handshake.
+  bool kernel_tls_enabled_ = false;
+  std::string kernel_tls_tx_secret_;
+  // True once the kernel encrypts the records written to the socket; Send()
+  // then bypasses SSL_write.
+  bool kernel_tls_tx_ = false;
 };
 
 // The OpenSSLAdapterFactory is responsbile for creating multiple new
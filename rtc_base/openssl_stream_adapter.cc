@@ -415,6 +415,11 @@ SSLProtocolVersion OpenSSLStreamAdapter::GetSslVersion() const {
     } else if (ssl_version == DTLS1_2_VERSION) {
       return SSL_PROTOCOL_DTLS_12;
     }
+#ifdef DTLS1_3_VERSION
+    if (ssl_version == DTLS1_3_VERSION) {
+      return SSL_PROTOCOL_DTLS_13;
+    }
+#endif
   } else {
     if (ssl_version == TLS1_VERSION) {
       return SSL_PROTOCOL_TLS_10;
@@ -422,6 +427,8 @@ SSLProtocolVersion OpenSSLStreamAdapter::GetSslVersion() const {
       return SSL_PROTOCOL_TLS_11;
     } else if (ssl_version == TLS1_2_VERSION) {
       return SSL_PROTOCOL_TLS_12;
+    } else if (ssl_version == TLS1_3_VERSION) {
+      return SSL_PROTOCOL_TLS_13;
     }
   }
 
@@ -1015,8 +1022,22 @@ SSL_CTX* OpenSSLStreamAdapter::SetupSSLContext() {
 
   SSL_CTX_set_min_proto_version(
       ctx, ssl_mode_ == SSL_MODE_DTLS ? DTLS1_2_VERSION : TLS1_2_VERSION);
-  SSL_CTX_set_max_proto_version(
-      ctx, ssl_mode_ == SSL_MODE_DTLS ? DTLS1_2_VERSION : TLS1_2_VERSION);
+  // (D)TLS 1.3 takes one round trip less, and is negotiated down to 1.2 with
+  // the peers that do not offer it. DTLS 1.3 is only available in the
+  // libraries that define DTLS1_3_VERSION, otherwise DTLS 1.2 is used.
+  int max_version =
+      ssl_mode_ == SSL_MODE_DTLS ? DTLS1_2_VERSION : TLS1_2_VERSION;
+  if (ssl_max_version_ >= SSL_PROTOCOL_TLS_13) {
+    if (ssl_mode_ == SSL_MODE_TLS) {
+      max_version = TLS1_3_VERSION;
+    }
+#ifdef DTLS1_3_VERSION
+    if (ssl_mode_ == SSL_MODE_DTLS) {
+      max_version = DTLS1_3_VERSION;
+    }
+#endif
+  }
+  SSL_CTX_set_max_proto_version(ctx, max_version);
 
 #ifdef OPENSSL_IS_BORINGSSL
   // SSL_CTX_set_current_time_cb is only supported in BoringSSL.
@@ -1182,6 +1203,8 @@ bool OpenSSLStreamAdapter::IsBoringSsl() {
 
 #define CDEF(X) \
   { static_cast<uint16_t>(TLS1_CK_##X & 0xffff), "TLS_" #X }
+#define CDEF13(X) \
+  { static_cast<uint16_t>(TLS1_3_CK_##X & 0xffff), "TLS_" #X }
 
 struct cipher_list {
   uint16_t cipher;
@@ -1199,6 +1222,10 @@ static const cipher_list OK_RSA_ciphers[] = {
 #ifdef TLS1_CK_ECDHE_RSA_WITH_CHACHA20_POLY1305_SHA256
     CDEF(ECDHE_RSA_WITH_CHACHA20_POLY1305_SHA256),
 #endif
+    // The (D)TLS 1.3 cipher suites do not depend on the key type.
+    CDEF13(AES_128_GCM_SHA256),
+    CDEF13(AES_256_GCM_SHA384),
+    CDEF13(CHACHA20_POLY1305_SHA256),
 };
 
 static const cipher_list OK_ECDSA_ciphers[] = {
@@ -1211,7 +1238,11 @@ static const cipher_list OK_ECDSA_ciphers[] = {
 #ifdef TLS1_CK_ECDHE_ECDSA_WITH_CHACHA20_POLY1305_SHA256
     CDEF(ECDHE_ECDSA_WITH_CHACHA20_POLY1305_SHA256),
 #endif
+    CDEF13(AES_128_GCM_SHA256),
+    CDEF13(AES_256_GCM_SHA384),
+    CDEF13(CHACHA20_POLY1305_SHA256),
 };
+#undef CDEF13
 #undef CDEF
 
 bool OpenSSLStreamAdapter::IsAcceptableCipher(int cipher, KeyType key_type) {
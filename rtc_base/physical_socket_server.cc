@@ -9,6 +9,7 @@
  */
 #include "rtc_base/physical_socket_server.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <utility>
 
@@ -30,6 +31,7 @@
 #endif
 #include <sys/ioctl.h>
 #include <sys/select.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #endif
 
@@ -125,6 +127,45 @@ class ScopedSetTrue {
 bool IsScmTimeStampExperimentDisabled() {
   return webrtc::field_trial::IsDisabled("WebRTC-SCM-Timestamp");
 }
+
+#if defined(WEBRTC_POSIX)
+// Room for an SCM_TIMESTAMP and an IP_TOS or IPV6_TCLASS control message.
+constexpr size_t kControlDataSize =
+    CMSG_SPACE(sizeof(struct timeval)) + CMSG_SPACE(sizeof(int));
+
+// Reads the SCM_TIMESTAMP, in microseconds, and the ECN codepoint carried in
+// the control data of `msg`. Either output may be null. The timestamp is -1
+// and the codepoint `kNotEct` if the control data has none.
+void ParseControlData(msghdr* msg, int64_t* timestamp, rtc::EcnMarking* ecn) {
+  if (timestamp)
+    *timestamp = -1;
+  if (ecn)
+    *ecn = rtc::EcnMarking::kNotEct;
+  for (cmsghdr* cmsg = CMSG_FIRSTHDR(msg); cmsg;
+       cmsg = CMSG_NXTHDR(msg, cmsg)) {
+    if (timestamp && cmsg->cmsg_level == SOL_SOCKET &&
+        cmsg->cmsg_type == SCM_TIMESTAMP) {
+      timeval* ts = reinterpret_cast<timeval*>(CMSG_DATA(cmsg));
+      *timestamp = rtc::kNumMicrosecsPerSec * static_cast<int64_t>(ts->tv_sec) +
+                   static_cast<int64_t>(ts->tv_usec);
+    } else if (ecn && cmsg->cmsg_level == IPPROTO_IP &&
+               (cmsg->cmsg_type == IP_TOS
+#if defined(IP_RECVTOS) && defined(WEBRTC_MAC)
+                || cmsg->cmsg_type == IP_RECVTOS
+#endif
+                )) {
+      // The IPv4 TOS byte.
+      uint8_t tos = *reinterpret_cast<uint8_t*>(CMSG_DATA(cmsg));
+      *ecn = static_cast<rtc::EcnMarking>(tos & 0x3);
+    } else if (ecn && cmsg->cmsg_level == IPPROTO_IPV6 &&
+               cmsg->cmsg_type == IPV6_TCLASS) {
+      int traffic_class;
+      memcpy(&traffic_class, CMSG_DATA(cmsg), sizeof(traffic_class));
+      *ecn = static_cast<rtc::EcnMarking>(traffic_class & 0x3);
+    }
+  }
+}
+#endif  // WEBRTC_POSIX
 }  // namespace
 
 namespace rtc {
@@ -314,6 +355,11 @@ int PhysicalSocket::GetOption(Option opt, int* value) {
 #if defined(WEBRTC_POSIX)
     // unshift DSCP value to get six most significant bits of IP DiffServ field
     *value >>= 2;
+#endif
+  } else if (opt == OPT_SEND_ECN) {
+#if defined(WEBRTC_POSIX)
+    // ECN codepoint is the two least significant bits of IP DiffServ field
+    *value &= 0x3;
 #endif
   }
   return ret;
@@ -330,16 +376,27 @@ int PhysicalSocket::SetOption(Option opt, int value) {
 #endif
   } else if (opt == OPT_DSCP) {
 #if defined(WEBRTC_POSIX)
-    // shift DSCP value to fit six most significant bits of IP DiffServ field
-    value <<= 2;
+    // shift DSCP value to fit six most significant bits of IP DiffServ field,
+    // keeping the ECN codepoint in the two least significant bits.
+    dscp_ = value;
+    value = (value << 2) | ecn_;
+#endif
+  } else if (opt == OPT_SEND_ECN) {
+#if defined(WEBRTC_POSIX)
+    // Both share the IP DiffServ field.
+    ecn_ = value & 0x3;
+    value = (dscp_ << 2) | ecn_;
 #endif
   }
 #if defined(WEBRTC_POSIX)
+  // Set the IPv4 option in all cases to support dual-stack sockets.
+  // Don't bother checking the return code, as this is expected to fail if
+  // it's not actually dual-stack.
   if (sopt == IPV6_TCLASS) {
-    // Set the IPv4 option in all cases to support dual-stack sockets.
-    // Don't bother checking the return code, as this is expected to fail if
-    // it's not actually dual-stack.
     ::setsockopt(s_, IPPROTO_IP, IP_TOS, (SockOptArg)&value, sizeof(value));
+  } else if (sopt == IPV6_RECVTCLASS) {
+    ::setsockopt(s_, IPPROTO_IP, IP_RECVTOS, (SockOptArg)&value,
+                 sizeof(value));
   }
 #endif
   int result =
@@ -350,6 +407,12 @@ int PhysicalSocket::SetOption(Option opt, int value) {
   return result;
 }
 
+#if defined(WEBRTC_POSIX)
+int PhysicalSocket::GetNativeDescriptor() const {
+  return s_;
+}
+#endif
+
 int PhysicalSocket::Send(const void* pv, size_t cb) {
   int sent = DoSend(
       s_, reinterpret_cast<const char*>(pv), static_cast<int>(cb),
@@ -375,6 +438,43 @@ int PhysicalSocket::Send(const void* pv, size_t cb) {
   return sent;
 }
 
+int PhysicalSocket::SendGathered(
+    rtc::ArrayView<const rtc::ArrayView<const uint8_t>> buffers) {
+#if defined(WEBRTC_POSIX)
+  if (buffers.size() <= 1 || buffers.size() > kMaxSendGatherSize) {
+    return Socket::SendGathered(buffers);
+  }
+  iovec iovs[kMaxSendGatherSize];
+  size_t total_size = 0;
+  for (size_t i = 0; i < buffers.size(); ++i) {
+    iovs[i] = {.iov_base = const_cast<uint8_t*>(buffers[i].data()),
+               .iov_len = buffers[i].size()};
+    total_size += buffers[i].size();
+  }
+  msghdr msg = {};
+  msg.msg_iov = iovs;
+  msg.msg_iovlen = static_cast<int>(buffers.size());
+  // Suppress SIGPIPE. See PhysicalSocket::Send() for explanation.
+  int sent = ::sendmsg(s_, &msg,
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+                       MSG_NOSIGNAL
+#else
+                       0
+#endif
+  );
+  UpdateLastError();
+  MaybeRemapSendError();
+  RTC_DCHECK(sent <= static_cast<int>(total_size));
+  if ((sent > 0 && sent < static_cast<int>(total_size)) ||
+      (sent < 0 && IsBlockingError(GetError()))) {
+    EnableEvents(DE_WRITE);
+  }
+  return sent;
+#else
+  return Socket::SendGathered(buffers);
+#endif
+}
+
 int PhysicalSocket::SendTo(const void* buffer,
                            size_t length,
                            const SocketAddress& addr) {
@@ -400,9 +500,45 @@ int PhysicalSocket::SendTo(const void* buffer,
   return sent;
 }
 
+int PhysicalSocket::SendToBatch(rtc::ArrayView<const SendBuffer> packets) {
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+  if (!udp_ || packets.size() <= 1) {
+    return Socket::SendToBatch(packets);
+  }
+  const size_t count = std::min(packets.size(), kMaxSendBatchSize);
+  mmsghdr msgs[kMaxSendBatchSize] = {};
+  iovec iovs[kMaxSendBatchSize];
+  sockaddr_storage addrs[kMaxSendBatchSize];
+  for (size_t i = 0; i < count; ++i) {
+    iovs[i] = {.iov_base = const_cast<uint8_t*>(packets[i].payload.data()),
+               .iov_len = packets[i].payload.size()};
+    msghdr& msg = msgs[i].msg_hdr;
+    msg.msg_iov = &iovs[i];
+    msg.msg_iovlen = 1;
+    msg.msg_name = &addrs[i];
+    msg.msg_namelen =
+        static_cast<socklen_t>(packets[i].destination.ToSockAddrStorage(
+            &addrs[i]));
+  }
+  // Suppress SIGPIPE. See PhysicalSocket::Send() for explanation.
+  int sent = ::sendmmsg(s_, msgs, static_cast<unsigned int>(count),
+                        MSG_NOSIGNAL);
+  UpdateLastError();
+  MaybeRemapSendError();
+  if (sent < static_cast<int>(count) &&
+      (sent >= 0 || IsBlockingError(GetError()))) {
+    EnableEvents(DE_WRITE);
+  }
+  return sent;
+#else
+  return Socket::SendToBatch(packets);
+#endif
+}
+
 int PhysicalSocket::Recv(void* buffer, size_t length, int64_t* timestamp) {
   int received =
-      DoReadFromSocket(buffer, length, /*out_addr*/ nullptr, timestamp);
+      DoReadFromSocket(buffer, length, /*out_addr*/ nullptr, timestamp,
+                       /*ecn=*/nullptr);
   if ((received == 0) && (length != 0)) {
     // Note: on graceful shutdown, recv can return 0.  In this case, we
     // pretend it is blocking, and then signal close, so that simplifying
@@ -431,7 +567,8 @@ int PhysicalSocket::RecvFrom(void* buffer,
                              size_t length,
                              SocketAddress* out_addr,
                              int64_t* timestamp) {
-  int received = DoReadFromSocket(buffer, length, out_addr, timestamp);
+  int received = DoReadFromSocket(buffer, length, out_addr, timestamp,
+                                  /*ecn=*/nullptr);
 
   UpdateLastError();
   int error = GetError();
@@ -452,7 +589,7 @@ int PhysicalSocket::RecvFrom(ReceiveBuffer& buffer) {
 
   int received =
       DoReadFromSocket(buffer.payload.data(), buffer.payload.capacity(),
-                       &buffer.source_address, &timestamp);
+                       &buffer.source_address, &timestamp, &buffer.ecn);
   buffer.payload.SetSize(received > 0 ? received : 0);
   if (received > 0 && timestamp != -1) {
     buffer.arrival_time = webrtc::Timestamp::Micros(timestamp);
@@ -469,10 +606,72 @@ int PhysicalSocket::RecvFrom(ReceiveBuffer& buffer) {
   return received;
 }
 
+int PhysicalSocket::RecvFromBatch(rtc::ArrayView<ReceiveBuffer> buffers) {
+#if defined(WEBRTC_LINUX)
+  // Without SCM timestamps the arrival time is read with SIOCGSTAMP, which
+  // only reports the last datagram, so batching is limited to that mode.
+  if (!udp_ || !read_scm_timestamp_experiment_ || buffers.size() <= 1) {
+    return Socket::RecvFromBatch(buffers);
+  }
+  const size_t count = std::min(buffers.size(), kMaxRecvBatchSize);
+  mmsghdr msgs[kMaxRecvBatchSize] = {};
+  iovec iovs[kMaxRecvBatchSize];
+  sockaddr_storage addrs[kMaxRecvBatchSize];
+  char controls[kMaxRecvBatchSize][kControlDataSize] = {};
+  for (size_t i = 0; i < count; ++i) {
+    // The caller decides how large each datagram may be.
+    RTC_DCHECK_GT(buffers[i].payload.capacity(), 0);
+    iovs[i] = {.iov_base = buffers[i].payload.data(),
+               .iov_len = buffers[i].payload.capacity()};
+    msghdr& msg = msgs[i].msg_hdr;
+    msg.msg_iov = &iovs[i];
+    msg.msg_iovlen = 1;
+    msg.msg_name = &addrs[i];
+    msg.msg_namelen = sizeof(addrs[i]);
+    msg.msg_control = controls[i];
+    msg.msg_controllen = sizeof(controls[i]);
+  }
+
+  int received = ::recvmmsg(s_, msgs, static_cast<unsigned int>(count),
+                            MSG_DONTWAIT, /*timeout=*/nullptr);
+  UpdateLastError();
+  if (received < 0) {
+    int error = GetError();
+    if (!IsBlockingError(error)) {
+      RTC_LOG_F(LS_VERBOSE) << "Error = " << error;
+    }
+    EnableEvents(DE_READ);
+    return received;
+  }
+  for (int i = 0; i < received; ++i) {
+    ReceiveBuffer& buffer = buffers[i];
+    if (msgs[i].msg_hdr.msg_flags & MSG_TRUNC) {
+      RTC_LOG(LS_WARNING) << "Dropping datagram larger than "
+                          << buffer.payload.capacity() << " bytes.";
+      buffer.payload.SetSize(0);
+    } else {
+      buffer.payload.SetSize(msgs[i].msg_len);
+    }
+    SocketAddressFromSockAddrStorage(addrs[i], &buffer.source_address);
+    int64_t timestamp;
+    ParseControlData(&msgs[i].msg_hdr, &timestamp, &buffer.ecn);
+    buffer.arrival_time =
+        timestamp != -1
+            ? absl::make_optional(webrtc::Timestamp::Micros(timestamp))
+            : absl::nullopt;
+  }
+  EnableEvents(DE_READ);
+  return received;
+#else
+  return Socket::RecvFromBatch(buffers);
+#endif
+}
+
 int PhysicalSocket::DoReadFromSocket(void* buffer,
                                      size_t length,
                                      SocketAddress* out_addr,
-                                     int64_t* timestamp) {
+                                     int64_t* timestamp,
+                                     EcnMarking* ecn) {
   sockaddr_storage addr_storage;
   socklen_t addr_len = sizeof(addr_storage);
   sockaddr* addr = reinterpret_cast<sockaddr*>(&addr_storage);
@@ -487,31 +686,20 @@ int PhysicalSocket::DoReadFromSocket(void* buffer,
       msg.msg_name = addr;
       msg.msg_namelen = addr_len;
     }
-    char control[CMSG_SPACE(sizeof(struct timeval))] = {};
-    if (timestamp) {
-      *timestamp = -1;
+    char control[kControlDataSize] = {};
+    if (timestamp || ecn) {
       msg.msg_control = &control;
       msg.msg_controllen = sizeof(control);
     }
+    if (timestamp) {
+      *timestamp = -1;
+    }
     received = ::recvmsg(s_, &msg, 0);
     if (received <= 0) {
       // An error occured or shut down.
       return received;
     }
-    if (timestamp) {
-      struct cmsghdr* cmsg;
-      for (cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
-        if (cmsg->cmsg_level != SOL_SOCKET)
-          continue;
-        if (cmsg->cmsg_type == SCM_TIMESTAMP) {
-          timeval* ts = reinterpret_cast<timeval*>(CMSG_DATA(cmsg));
-          *timestamp =
-              rtc::kNumMicrosecsPerSec * static_cast<int64_t>(ts->tv_sec) +
-              static_cast<int64_t>(ts->tv_usec);
-          break;
-        }
-      }
-    }
+    ParseControlData(&msg, timestamp, ecn);
     if (out_addr) {
       SocketAddressFromSockAddrStorage(addr_storage, out_addr);
     }
@@ -687,6 +875,7 @@ int PhysicalSocket::TranslateOption(Option opt, int* slevel, int* sopt) {
       *sopt = TCP_NODELAY;
       break;
     case OPT_DSCP:
+    case OPT_SEND_ECN:
 #if defined(WEBRTC_POSIX)
       if (family_ == AF_INET6) {
         *slevel = IPPROTO_IPV6;
@@ -697,7 +886,21 @@ int PhysicalSocket::TranslateOption(Option opt, int* slevel, int* sopt) {
       }
       break;
 #else
-      RTC_LOG(LS_WARNING) << "Socket::OPT_DSCP not supported.";
+      RTC_LOG(LS_WARNING) << "Socket::OPT_DSCP and OPT_SEND_ECN not supported.";
+      return -1;
+#endif
+    case OPT_RECV_ECN:
+#if defined(WEBRTC_POSIX)
+      if (family_ == AF_INET6) {
+        *slevel = IPPROTO_IPV6;
+        *sopt = IPV6_RECVTCLASS;
+      } else {
+        *slevel = IPPROTO_IP;
+        *sopt = IP_RECVTOS;
+      }
+      break;
+#else
+      RTC_LOG(LS_WARNING) << "Socket::OPT_RECV_ECN not supported.";
       return -1;
 #endif
     case OPT_RTP_SENDTIME_EXTN_ID:
@@ -764,6 +967,26 @@ bool SocketDispatcher::Initialize() {
     RTC_DLOG(LS_ERROR) << "::setsockopt failed. errno: " << LAST_SYSTEM_ERROR;
   }
 #endif
+#if defined(SO_BUSY_POLL)
+  const int busy_poll_us = ss_->busy_poll_config().socket_busy_poll_us;
+  if (busy_poll_us > 0) {
+    // Raising SO_BUSY_POLL above net.core.busy_read needs CAP_NET_ADMIN, so
+    // failing is expected in many deployments.
+    if (::setsockopt(s_, SOL_SOCKET, SO_BUSY_POLL, &busy_poll_us,
+                     sizeof(busy_poll_us)) != 0) {
+      RTC_DLOG(LS_WARNING) << "SO_BUSY_POLL failed. errno: "
+                           << LAST_SYSTEM_ERROR;
+    }
+#if defined(SO_PREFER_BUSY_POLL)
+    int value = 1;
+    if (::setsockopt(s_, SOL_SOCKET, SO_PREFER_BUSY_POLL, &value,
+                     sizeof(value)) != 0) {
+      RTC_DLOG(LS_WARNING) << "SO_PREFER_BUSY_POLL failed. errno: "
+                           << LAST_SYSTEM_ERROR;
+    }
+#endif  // SO_PREFER_BUSY_POLL
+  }
+#endif  // SO_BUSY_POLL
   ss_->Add(this);
   return true;
 }
@@ -1183,6 +1406,13 @@ PhysicalSocketServer::PhysicalSocketServer()
     RTC_LOG_E(LS_WARNING, EN, errno) << "epoll_create";
     // Note that -1 == INVALID_SOCKET, the alias used by later checks.
   }
+#endif
+#if defined(WEBRTC_USE_IO_URING)
+  io_uring_ = IoUringRing::Create(kNumIoUringEntries);
+  if (!io_uring_) {
+    // Not an error, will fall back to "epoll" below.
+    RTC_LOG(LS_WARNING) << "io_uring unavailable, falling back to epoll.";
+  }
 #endif
   // The `fWait_` flag to be cleared by the Signaler.
   signal_wakeup_ = new Signaler(this, fWait_);
@@ -1226,6 +1456,17 @@ Socket* PhysicalSocketServer::WrapSocket(SOCKET s) {
   }
 }
 
+void PhysicalSocketServer::SetBusyPollConfig(const BusyPollConfig& config) {
+  RTC_DCHECK(!waiting_);
+  RTC_DCHECK_GE(config.max_spin, webrtc::TimeDelta::Zero());
+  RTC_DCHECK_GE(config.max_cpu_share, 0.0);
+  RTC_DCHECK_LE(config.max_cpu_share, 1.0);
+  busy_poll_config_ = config;
+  busy_poll_spin_us_ = config.max_spin.us();
+  busy_poll_window_start_us_ = 0;
+  busy_poll_spent_us_ = 0;
+}
+
 void PhysicalSocketServer::Add(Dispatcher* pdispatcher) {
   CritScope cs(&crit_);
   if (key_by_dispatcher_.count(pdispatcher)) {
@@ -1236,6 +1477,12 @@ void PhysicalSocketServer::Add(Dispatcher* pdispatcher) {
   uint64_t key = next_dispatcher_key_++;
   dispatcher_by_key_.emplace(key, pdispatcher);
   key_by_dispatcher_.emplace(pdispatcher, key);
+#if defined(WEBRTC_USE_IO_URING)
+  if (io_uring_) {
+    MarkIoUringDirty(key);
+    return;
+  }
+#endif  // WEBRTC_USE_IO_URING
 #if defined(WEBRTC_USE_EPOLL)
   if (epoll_fd_ != INVALID_SOCKET) {
     AddEpoll(pdispatcher, key);
@@ -1254,6 +1501,12 @@ void PhysicalSocketServer::Remove(Dispatcher* pdispatcher) {
   uint64_t key = key_by_dispatcher_.at(pdispatcher);
   key_by_dispatcher_.erase(pdispatcher);
   dispatcher_by_key_.erase(key);
+#if defined(WEBRTC_USE_IO_URING)
+  if (io_uring_) {
+    MarkIoUringDirty(key);
+    return;
+  }
+#endif  // WEBRTC_USE_IO_URING
 #if defined(WEBRTC_USE_EPOLL)
   if (epoll_fd_ != INVALID_SOCKET) {
     RemoveEpoll(pdispatcher);
@@ -1273,6 +1526,12 @@ void PhysicalSocketServer::Update(Dispatcher* pdispatcher) {
     return;
   }
 
+#if defined(WEBRTC_USE_IO_URING)
+  if (io_uring_) {
+    MarkIoUringDirty(key_by_dispatcher_.at(pdispatcher));
+    return;
+  }
+#endif  // WEBRTC_USE_IO_URING
   UpdateEpoll(pdispatcher, key_by_dispatcher_.at(pdispatcher));
 #endif
 }
@@ -1301,7 +1560,13 @@ bool PhysicalSocketServer::Wait(webrtc::TimeDelta max_wait_duration,
   // "select" to support sockets larger than FD_SETSIZE.
   if (!process_io) {
     return WaitPollOneDispatcher(cmsWait, signal_wakeup_);
-  } else if (epoll_fd_ != INVALID_SOCKET) {
+  }
+#if defined(WEBRTC_USE_IO_URING)
+  if (io_uring_) {
+    return WaitIoUring(cmsWait);
+  }
+#endif
+  if (epoll_fd_ != INVALID_SOCKET) {
     return WaitEpoll(cmsWait);
   }
 #endif
@@ -1617,8 +1882,14 @@ bool PhysicalSocketServer::WaitEpoll(int cmsWait) {
     // < 0 means error
     // 0 means timeout
     // > 0 means count of descriptors ready
-    int n = epoll_wait(epoll_fd_, epoll_events_.data(), epoll_events_.size(),
-                       static_cast<int>(msWait));
+    int n = 0;
+    if (msWait != 0 && busy_poll_spin_us_ > 0) {
+      n = SpinEpoll();
+    }
+    if (n == 0) {
+      n = epoll_wait(epoll_fd_, epoll_events_.data(), epoll_events_.size(),
+                     static_cast<int>(msWait));
+    }
     if (n < 0) {
       if (errno != EINTR) {
         RTC_LOG_E(LS_ERROR, EN, errno) << "epoll";
@@ -1663,6 +1934,190 @@ bool PhysicalSocketServer::WaitEpoll(int cmsWait) {
   return true;
 }
 
+int PhysicalSocketServer::SpinEpoll() {
+  // The spin never drops below this, so that it can grow back.
+  constexpr int64_t kMinSpinUs = 5;
+  constexpr int64_t kBudgetWindowUs = kNumMicrosecsPerSec;
+
+  const int64_t start_us = TimeMicros();
+  if (start_us - busy_poll_window_start_us_ >= kBudgetWindowUs) {
+    busy_poll_window_start_us_ = start_us;
+    busy_poll_spent_us_ = 0;
+  }
+  const int64_t budget_us = static_cast<int64_t>(
+      kBudgetWindowUs * busy_poll_config_.max_cpu_share);
+  const int64_t spin_us =
+      std::min(busy_poll_spin_us_, budget_us - busy_poll_spent_us_);
+  if (spin_us <= 0) {
+    return 0;
+  }
+
+  int n = 0;
+  int64_t now_us = start_us;
+  do {
+    n = epoll_wait(epoll_fd_, epoll_events_.data(), epoll_events_.size(), 0);
+    now_us = TimeMicros();
+  } while (n == 0 && now_us - start_us < spin_us);
+  busy_poll_spent_us_ += now_us - start_us;
+
+  const int64_t max_spin_us = busy_poll_config_.max_spin.us();
+  if (n > 0) {
+    busy_poll_spin_us_ = std::min(2 * busy_poll_spin_us_, max_spin_us);
+  } else if (n == 0) {
+    busy_poll_spin_us_ =
+        std::max(busy_poll_spin_us_ / 2, std::min(kMinSpinUs, max_spin_us));
+  }
+  return n;
+}
+
+#if defined(WEBRTC_USE_IO_URING)
+
+namespace {
+// user_data of requests whose completions are ignored.
+constexpr uint64_t kIoUringIgnoredUserData = ~uint64_t{0};
+
+uint64_t IoUringUserData(uint64_t key, uint8_t generation) {
+  return (key << 8) | generation;
+}
+}  // namespace
+
+void PhysicalSocketServer::MarkIoUringDirty(uint64_t key) {
+  io_uring_dirty_keys_.push_back(key);
+  if (io_uring_waiting_) {
+    // The waiting thread re-arms dirty dispatchers before it blocks next.
+    signal_wakeup_->Signal();
+  }
+}
+
+io_uring_sqe* PhysicalSocketServer::GetIoUringSqe() {
+  io_uring_sqe* sqe = io_uring_->GetSqe();
+  if (!sqe) {
+    // Submission queue is full; hand the queued requests to the kernel.
+    io_uring_->Submit();
+    sqe = io_uring_->GetSqe();
+  }
+  return sqe;
+}
+
+void PhysicalSocketServer::ArmIoUringPolls() {
+  for (uint64_t key : io_uring_dirty_keys_) {
+    auto dispatcher_it = dispatcher_by_key_.find(key);
+    uint32_t events = 0;
+    if (dispatcher_it != dispatcher_by_key_.end()) {
+      events = GetEpollEvents(dispatcher_it->second->GetRequestedEvents());
+    }
+    auto poll_it = io_uring_polls_.find(key);
+    if (poll_it != io_uring_polls_.end() &&
+        poll_it->second.armed_events == events) {
+      continue;
+    }
+    if (poll_it != io_uring_polls_.end() && poll_it->second.armed_events) {
+      io_uring_sqe* sqe = GetIoUringSqe();
+      if (!sqe) {
+        RTC_LOG(LS_ERROR) << "io_uring submission queue exhausted.";
+        continue;
+      }
+      sqe->opcode = IORING_OP_POLL_REMOVE;
+      sqe->fd = -1;
+      sqe->addr = IoUringUserData(key, poll_it->second.generation);
+      sqe->user_data = kIoUringIgnoredUserData;
+      poll_it->second.armed_events = 0;
+    }
+    if (events == 0) {
+      // Dispatchers without requested events (e.g. closed sockets) and removed
+      // dispatchers are not polled.
+      if (dispatcher_it == dispatcher_by_key_.end() &&
+          poll_it != io_uring_polls_.end()) {
+        io_uring_polls_.erase(poll_it);
+      }
+      continue;
+    }
+    io_uring_sqe* sqe = GetIoUringSqe();
+    if (!sqe) {
+      RTC_LOG(LS_ERROR) << "io_uring submission queue exhausted.";
+      continue;
+    }
+    IoUringPoll& poll = io_uring_polls_[key];
+    ++poll.generation;
+    poll.armed_events = events;
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = dispatcher_it->second->GetDescriptor();
+    sqe->poll32_events = events;
+    sqe->user_data = IoUringUserData(key, poll.generation);
+  }
+  io_uring_dirty_keys_.clear();
+}
+
+bool PhysicalSocketServer::WaitIoUring(int cmsWait) {
+  RTC_DCHECK(io_uring_);
+  int64_t msWait = -1;
+  int64_t msStop = -1;
+  if (cmsWait != kForeverMs) {
+    msWait = cmsWait;
+    msStop = TimeAfter(cmsWait);
+  }
+
+  fWait_ = true;
+  while (fWait_) {
+    {
+      CritScope cr(&crit_);
+      ArmIoUringPolls();
+      io_uring_waiting_ = true;
+    }
+    // Re-armed polls are submitted in the same system call that waits for
+    // completions.
+    int result = io_uring_->SubmitAndWait(static_cast<int>(msWait));
+    CritScope cr(&crit_);
+    io_uring_waiting_ = false;
+    if (result < 0 && result != -ETIME && result != -EINTR) {
+      RTC_LOG_E(LS_ERROR, EN, -result) << "io_uring_enter";
+      return false;
+    }
+    int n = io_uring_->ProcessCompletions([&](const io_uring_cqe& cqe) {
+      if (cqe.user_data == kIoUringIgnoredUserData || cqe.res < 0) {
+        // Poll removals, and polls cancelled by them.
+        return;
+      }
+      const uint64_t key = cqe.user_data >> 8;
+      auto poll_it = io_uring_polls_.find(key);
+      if (poll_it == io_uring_polls_.end() ||
+          poll_it->second.generation != static_cast<uint8_t>(cqe.user_data)) {
+        // Completion of a poll request that has since been replaced.
+        return;
+      }
+      // One-shot poll requests are disarmed by their completion.
+      poll_it->second.armed_events = 0;
+      io_uring_dirty_keys_.push_back(key);
+      auto dispatcher_it = dispatcher_by_key_.find(key);
+      if (dispatcher_it == dispatcher_by_key_.end()) {
+        // The dispatcher for this socket no longer exists.
+        return;
+      }
+      const uint32_t revents = static_cast<uint32_t>(cqe.res);
+      bool readable = (revents & (POLLIN | POLLPRI));
+      bool writable = (revents & POLLOUT);
+      bool error = (revents & (POLLRDHUP | POLLERR | POLLHUP));
+      ProcessEvents(dispatcher_it->second, readable, writable, error, error);
+    });
+    if (result == -ETIME && n == 0) {
+      // If timeout, return success
+      return true;
+    }
+
+    if (cmsWait != kForeverMs) {
+      msWait = TimeDiff(msStop, TimeMillis());
+      if (msWait <= 0) {
+        // Return success on timeout.
+        return true;
+      }
+    }
+  }
+
+  return true;
+}
+
+#endif  // WEBRTC_USE_IO_URING
+
 bool PhysicalSocketServer::WaitPollOneDispatcher(int cmsWait,
                                                  Dispatcher* dispatcher) {
   RTC_DCHECK(dispatcher);
@@ -23,6 +23,12 @@
 #include <sys/epoll.h>
 
 #define WEBRTC_USE_EPOLL 1
+
+// io_uring is opt-in through the rtc_use_io_uring build flag, which defines
+// WEBRTC_USE_IO_URING. epoll remains the fallback if io_uring is unavailable.
+#if defined(WEBRTC_USE_IO_URING)
+#include "rtc_base/io_uring_ring.h"
+#endif
 #elif defined(WEBRTC_FUCHSIA)
 // Fuchsia implements select and poll but not epoll, and testing shows that poll
 // is faster than select.
@@ -99,9 +105,33 @@ class RTC_EXPORT PhysicalSocketServer : public SocketServer {
   void Remove(Dispatcher* dispatcher);
   void Update(Dispatcher* dispatcher);
 
+  // Opt-in busy polling, for latency critical deployments with CPU to spare.
+  // Before Wait() blocks it polls for events for up to `max_spin`, which
+  // saves the scheduler latency of waking up when an event arrives during
+  // the spin. The spin adapts to the traffic: it grows while spinning
+  // catches events and shrinks while it does not.
+  struct BusyPollConfig {
+    // Longest spin before blocking. Zero disables spinning.
+    webrtc::TimeDelta max_spin = webrtc::TimeDelta::Zero();
+    // Share of wall time, measured over one second, that may be spent
+    // spinning. Wait() blocks right away once it is used up.
+    double max_cpu_share = 0.5;
+    // SO_BUSY_POLL value, in microseconds, set on new sockets where the
+    // platform supports it, along with SO_PREFER_BUSY_POLL. Zero leaves
+    // sockets alone.
+    int socket_busy_poll_us = 0;
+  };
+  // Must be called before the server is used, or on the thread calling
+  // Wait(). Spinning is only done by the epoll implementation, not with
+  // io_uring.
+  void SetBusyPollConfig(const BusyPollConfig& config);
+  const BusyPollConfig& busy_poll_config() const { return busy_poll_config_; }
+
  private:
   // The number of events to process with one call to "epoll_wait".
   static constexpr size_t kNumEpollEvents = 128;
+  // The size of the io_uring submission queue.
+  static constexpr uint32_t kNumIoUringEntries = 1024;
   // A local historical definition of "foreverness", in milliseconds.
   static constexpr int kForeverMs = -1;
 
@@ -115,6 +145,9 @@ class RTC_EXPORT PhysicalSocketServer : public SocketServer {
   void RemoveEpoll(Dispatcher* dispatcher);
   void UpdateEpoll(Dispatcher* dispatcher, uint64_t key);
   bool WaitEpoll(int cmsWait);
+  // Polls for events without blocking for up to the current spin duration.
+  // Returns the result of the last epoll_wait().
+  int SpinEpoll();
   bool WaitPollOneDispatcher(int cmsWait, Dispatcher* dispatcher);
 
   // This array is accessed in isolation by a thread calling into Wait().
@@ -124,6 +157,29 @@ class RTC_EXPORT PhysicalSocketServer : public SocketServer {
   std::array<epoll_event, kNumEpollEvents> epoll_events_;
   const int epoll_fd_ = INVALID_SOCKET;
 
+#if defined(WEBRTC_USE_IO_URING)
+  // One-shot poll requests are used rather than multishot ones to keep the
+  // level-triggered semantics of the epoll implementation. The submission
+  // queue is only touched by the thread calling Wait(); other threads mark
+  // dispatchers as dirty and wake the waiting thread up.
+  struct IoUringPoll {
+    // Events of the currently armed poll request, or 0 if none is armed.
+    uint32_t armed_events = 0;
+    // Distinguishes completions of the armed request from stale ones.
+    uint8_t generation = 0;
+  };
+  void MarkIoUringDirty(uint64_t key) RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  void ArmIoUringPolls() RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  io_uring_sqe* GetIoUringSqe();
+  bool WaitIoUring(int cmsWait);
+
+  std::unique_ptr<IoUringRing> io_uring_;
+  std::unordered_map<uint64_t, IoUringPoll> io_uring_polls_
+      RTC_GUARDED_BY(crit_);
+  std::vector<uint64_t> io_uring_dirty_keys_ RTC_GUARDED_BY(crit_);
+  bool io_uring_waiting_ RTC_GUARDED_BY(crit_) = false;
+#endif  // WEBRTC_USE_IO_URING
+
 #elif defined(WEBRTC_USE_POLL)
   void AddPoll(Dispatcher* dispatcher, uint64_t key);
   void RemovePoll(Dispatcher* dispatcher);
@@ -155,6 +211,11 @@ class RTC_EXPORT PhysicalSocketServer : public SocketServer {
   const WSAEVENT socket_ev_;
 #endif
   bool fWait_;
+  BusyPollConfig busy_poll_config_;
+  // Current adaptive spin duration, and the CPU budget accounting.
+  int64_t busy_poll_spin_us_ = 0;
+  int64_t busy_poll_window_start_us_ = 0;
+  int64_t busy_poll_spent_us_ = 0;
   // Are we currently in a select()/epoll()/WSAWaitForMultipleEvents loop?
   // Used for a DCHECK, because we don't support reentrant waiting.
   bool waiting_ = false;
@@ -162,6 +223,10 @@ class RTC_EXPORT PhysicalSocketServer : public SocketServer {
 
 class PhysicalSocket : public Socket, public sigslot::has_slots<> {
  public:
+  static constexpr size_t kMaxRecvBatchSize = 32;
+  static constexpr size_t kMaxSendBatchSize = 32;
+  static constexpr size_t kMaxSendGatherSize = 8;
+
   PhysicalSocket(PhysicalSocketServer* ss, SOCKET s = INVALID_SOCKET);
   ~PhysicalSocket() override;
 
@@ -181,11 +246,21 @@ class PhysicalSocket : public Socket, public sigslot::has_slots<> {
 
   int GetOption(Option opt, int* value) override;
   int SetOption(Option opt, int value) override;
+#if defined(WEBRTC_POSIX)
+  int GetNativeDescriptor() const override;
+#endif
 
   int Send(const void* pv, size_t cb) override;
+  // On POSIX, sends up to `kMaxSendGatherSize` buffers with a single
+  // sendmsg() call.
+  int SendGathered(
+      rtc::ArrayView<const rtc::ArrayView<const uint8_t>> buffers) override;
   int SendTo(const void* buffer,
              size_t length,
              const SocketAddress& addr) override;
+  // On Linux, UDP sockets send up to `kMaxSendBatchSize` datagrams with a
+  // single sendmmsg() call.
+  int SendToBatch(rtc::ArrayView<const SendBuffer> packets) override;
 
   int Recv(void* buffer, size_t length, int64_t* timestamp) override;
   // TODO(webrtc:15368): Deprecate and remove.
@@ -194,6 +269,10 @@ class PhysicalSocket : public Socket, public sigslot::has_slots<> {
                SocketAddress* out_addr,
                int64_t* timestamp) override;
   int RecvFrom(ReceiveBuffer& buffer) override;
+  // On Linux, UDP sockets receive up to `kMaxRecvBatchSize` datagrams with a
+  // single recvmmsg() call. Each datagram is limited to the capacity of the
+  // corresponding payload buffer; larger datagrams are dropped.
+  int RecvFromBatch(rtc::ArrayView<ReceiveBuffer> buffers) override;
 
   int Listen(int backlog) override;
   Socket* Accept(SocketAddress* out_addr) override;
@@ -221,10 +300,13 @@ class PhysicalSocket : public Socket, public sigslot::has_slots<> {
                        const struct sockaddr* dest_addr,
                        socklen_t addrlen);
 
+  // `ecn` is only filled in when the SCM timestamp experiment is enabled,
+  // which is the default.
   int DoReadFromSocket(void* buffer,
                        size_t length,
                        SocketAddress* out_addr,
-                       int64_t* timestamp);
+                       int64_t* timestamp,
+                       EcnMarking* ecn);
 
   void OnResolveResult(const webrtc::AsyncDnsResolverResult& resolver);
 
@@ -254,6 +336,10 @@ class PhysicalSocket : public Socket, public sigslot::has_slots<> {
  private:
   const bool read_scm_timestamp_experiment_;
   uint8_t enabled_events_ = 0;
+  // Both are written to the IP DiffServ field, so one is kept to set the
+  // other.
+  int dscp_ = 0;
+  int ecn_ = 0;
 };
 
 class SocketDispatcher : public Dispatcher, public PhysicalSocket {
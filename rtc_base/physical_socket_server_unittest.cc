@@ -14,6 +14,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <vector>
 
 #include "rtc_base/gunit.h"
 #include "rtc_base/ip_address.h"
@@ -523,6 +524,127 @@ TEST_F(PhysicalSocketTest,
 
 #endif
 
+#if defined(WEBRTC_LINUX)
+TEST_F(PhysicalSocketTest, RecvFromBatchReceivesMultipleDatagrams) {
+  MAYBE_SKIP_IPV4;
+  std::unique_ptr<Socket> receiver(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  std::unique_ptr<Socket> sender(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, receiver->Bind(SocketAddress(kIPv4Loopback, 0)));
+  ASSERT_EQ(0, sender->Bind(SocketAddress(kIPv4Loopback, 0)));
+  const SocketAddress receiver_address = receiver->GetLocalAddress();
+
+  constexpr int kNumPackets = 3;
+  for (int i = 0; i < kNumPackets; ++i) {
+    const uint8_t payload[] = {static_cast<uint8_t>(i), 0xAB};
+    ASSERT_EQ(2, sender->SendTo(payload, sizeof(payload), receiver_address));
+  }
+
+  std::vector<Buffer> payloads(4);
+  std::vector<Socket::ReceiveBuffer> buffers;
+  for (Buffer& payload : payloads) {
+    payload.EnsureCapacity(1500);
+    buffers.emplace_back(payload);
+  }
+  int received = 0;
+  for (int attempt = 0; attempt < 100 && received < kNumPackets; ++attempt) {
+    int result = receiver->RecvFromBatch(
+        rtc::ArrayView<Socket::ReceiveBuffer>(buffers).subview(received));
+    if (result > 0) {
+      received += result;
+    } else {
+      Thread::SleepMs(1);
+    }
+  }
+  ASSERT_EQ(kNumPackets, received);
+  for (int i = 0; i < kNumPackets; ++i) {
+    ASSERT_EQ(2u, buffers[i].payload.size());
+    EXPECT_EQ(i, buffers[i].payload[0]);
+    EXPECT_EQ(sender->GetLocalAddress(), buffers[i].source_address);
+    EXPECT_TRUE(buffers[i].arrival_time.has_value());
+  }
+}
+
+TEST_F(PhysicalSocketTest, SendGatheredSendsBuffersAsOneDatagram) {
+  MAYBE_SKIP_IPV4;
+  std::unique_ptr<Socket> receiver(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  std::unique_ptr<Socket> sender(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, receiver->Bind(SocketAddress(kIPv4Loopback, 0)));
+  ASSERT_EQ(0, sender->Bind(SocketAddress(kIPv4Loopback, 0)));
+  ASSERT_EQ(0, sender->Connect(receiver->GetLocalAddress()));
+
+  const uint8_t header[] = {0x00, 0x03};
+  const uint8_t payload[] = {'a', 'b', 'c'};
+  const rtc::ArrayView<const uint8_t> buffers[] = {header, payload};
+  ASSERT_EQ(5, sender->SendGathered(buffers));
+
+  uint8_t received[16];
+  int result = -1;
+  for (int attempt = 0; attempt < 100 && result < 0; ++attempt) {
+    result = receiver->Recv(received, sizeof(received), nullptr);
+    if (result < 0) {
+      Thread::SleepMs(1);
+    }
+  }
+  ASSERT_EQ(5, result);
+  EXPECT_EQ(0, memcmp(received, "\x00\x03" "abc", 5));
+}
+
+TEST_F(PhysicalSocketTest, SendsAndReceivesEcnMarking) {
+  MAYBE_SKIP_IPV4;
+  std::unique_ptr<Socket> receiver(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  std::unique_ptr<Socket> sender(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, receiver->Bind(SocketAddress(kIPv4Loopback, 0)));
+  ASSERT_EQ(0, sender->Bind(SocketAddress(kIPv4Loopback, 0)));
+  ASSERT_EQ(0, receiver->SetOption(Socket::OPT_RECV_ECN, 1));
+  ASSERT_EQ(0, sender->SetOption(Socket::OPT_DSCP, 46));
+  ASSERT_EQ(0, sender->SetOption(Socket::OPT_SEND_ECN,
+                                 static_cast<int>(EcnMarking::kEct1)));
+
+  // DSCP and ECN share a header field without overwriting each other.
+  int value = 0;
+  ASSERT_EQ(0, sender->GetOption(Socket::OPT_DSCP, &value));
+  EXPECT_EQ(46, value);
+  ASSERT_EQ(0, sender->GetOption(Socket::OPT_SEND_ECN, &value));
+  EXPECT_EQ(static_cast<int>(EcnMarking::kEct1), value);
+
+  const uint8_t payload[] = {1, 2, 3};
+  ASSERT_EQ(3, sender->SendTo(payload, sizeof(payload),
+                              receiver->GetLocalAddress()));
+  Buffer receive_payload;
+  Socket::ReceiveBuffer buffer(receive_payload);
+  int received = -1;
+  for (int attempt = 0; attempt < 100 && received <= 0; ++attempt) {
+    received = receiver->RecvFrom(buffer);
+    if (received <= 0) {
+      Thread::SleepMs(1);
+    }
+  }
+  ASSERT_EQ(3, received);
+  EXPECT_EQ(EcnMarking::kEct1, buffer.ecn);
+}
+#endif
+
+TEST_F(PhysicalSocketTest, BusyPollingDeliversReadEvents) {
+  MAYBE_SKIP_IPV4;
+  PhysicalSocketServer::BusyPollConfig config;
+  config.max_spin = webrtc::TimeDelta::Millis(1);
+  config.socket_busy_poll_us = 50;
+  server_.SetBusyPollConfig(config);
+
+  std::unique_ptr<Socket> receiver(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  std::unique_ptr<Socket> sender(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, receiver->Bind(SocketAddress(kIPv4Loopback, 0)));
+  ASSERT_EQ(0, sender->Bind(SocketAddress(kIPv4Loopback, 0)));
+  webrtc::testing::StreamSink sink;
+  sink.Monitor(receiver.get());
+
+  const uint8_t payload[] = {1, 2};
+  ASSERT_EQ(2, sender->SendTo(payload, sizeof(payload),
+                              receiver->GetLocalAddress()));
+  EXPECT_TRUE_WAIT((sink.Check(receiver.get(), webrtc::testing::SSE_READ)),
+                   kTimeout);
+}
+
 TEST_F(PhysicalSocketTest, UdpSocketRecvTimestampUseRtcEpochIPv4) {
   MAYBE_SKIP_IPV4;
   SocketTest::TestUdpSocketRecvTimestampUseRtcEpochIPv4();
@@ -37,7 +37,8 @@ int Win32PriorityFromThreadPriority(ThreadPriority priority) {
 }
 #endif
 
-bool SetPriority(ThreadPriority priority) {
+bool SetPriority(ThreadPriority priority,
+                 ThreadSchedulingPolicy scheduling_policy) {
 #if defined(WEBRTC_WIN)
   return SetThreadPriority(GetCurrentThread(),
                            Win32PriorityFromThreadPriority(priority)) != FALSE;
@@ -49,7 +50,13 @@ bool SetPriority(ThreadPriority priority) {
   // thread priorities.
   return true;
 #else
-  const int policy = SCHED_FIFO;
+  if (scheduling_policy == ThreadSchedulingPolicy::kTimeSharing) {
+    sched_param param = {};
+    return pthread_setschedparam(pthread_self(), SCHED_OTHER, &param) == 0;
+  }
+  const int policy =
+      scheduling_policy == ThreadSchedulingPolicy::kRoundRobin ? SCHED_RR
+                                                               : SCHED_FIFO;
   const int min_prio = sched_get_priority_min(policy);
   const int max_prio = sched_get_priority_max(policy);
   if (min_prio == -1 || max_prio == -1) {
@@ -83,6 +90,29 @@ bool SetPriority(ThreadPriority priority) {
 #endif  // defined(WEBRTC_WIN)
 }
 
+bool SetCpuAffinity(uint64_t cpu_affinity_mask) {
+  if (cpu_affinity_mask == 0) {
+    return true;
+  }
+#if defined(WEBRTC_WIN)
+  return SetThreadAffinityMask(GetCurrentThread(),
+                               static_cast<DWORD_PTR>(cpu_affinity_mask)) != 0;
+#elif defined(WEBRTC_LINUX)
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  for (int cpu = 0; cpu < 64; ++cpu) {
+    if (cpu_affinity_mask & (uint64_t{1} << cpu)) {
+      CPU_SET(cpu, &cpus);
+    }
+  }
+  // On Linux, a pid of 0 refers to the calling thread.
+  return sched_setaffinity(0, sizeof(cpus), &cpus) == 0;
+#else
+  // Not supported by the other platforms.
+  return false;
+#endif
+}
+
 #if defined(WEBRTC_WIN)
 DWORD WINAPI RunPlatformThread(void* param) {
   // The GetLastError() function only returns valid results when it is called
@@ -106,6 +136,13 @@ void* RunPlatformThread(void* param) {
 
 }  // namespace
 
+bool SetCurrentThreadAttributes(const ThreadAttributes& attributes) {
+  bool priority_set =
+      SetPriority(attributes.priority, attributes.scheduling_policy);
+  bool affinity_set = SetCpuAffinity(attributes.cpu_affinity_mask);
+  return priority_set && affinity_set;
+}
+
 PlatformThread::PlatformThread(Handle handle, bool joinable)
     : handle_(handle), joinable_(joinable) {}
 
@@ -181,7 +218,7 @@ PlatformThread PlatformThread::SpawnThread(
       new std::function<void()>([thread_function = std::move(thread_function),
                                  name = std::string(name), attributes] {
         rtc::SetCurrentThreadName(name.c_str());
-        SetPriority(attributes.priority);
+        SetCurrentThreadAttributes(attributes);
         thread_function();
       });
 #if defined(WEBRTC_WIN)
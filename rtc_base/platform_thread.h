@@ -11,6 +11,7 @@
 #ifndef RTC_BASE_PLATFORM_THREAD_H_
 #define RTC_BASE_PLATFORM_THREAD_H_
 
+#include <cstdint>
 #include <functional>
 #include <string>
 #if !defined(WEBRTC_WIN)
@@ -30,14 +31,42 @@ enum class ThreadPriority {
   kRealtime,
 };
 
+enum class ThreadSchedulingPolicy {
+  // The platform's scheduling of `priority`, SCHED_FIFO on POSIX systems.
+  kDefault,
+  // The time-sharing scheduler, SCHED_OTHER on POSIX systems, for threads
+  // that must not preempt real-time ones. `priority` is not applied then.
+  kTimeSharing,
+  // SCHED_RR on POSIX systems, which shares the CPU between threads of the
+  // same priority.
+  kRoundRobin,
+};
+
 struct ThreadAttributes {
   ThreadPriority priority = ThreadPriority::kNormal;
+  // Only applied on POSIX systems.
+  ThreadSchedulingPolicy scheduling_policy = ThreadSchedulingPolicy::kDefault;
+  // CPUs the thread may run on, bit i standing for CPU i. Zero leaves the
+  // affinity unchanged. Only applied on Linux and Windows.
+  uint64_t cpu_affinity_mask = 0;
   ThreadAttributes& SetPriority(ThreadPriority priority_param) {
     priority = priority_param;
     return *this;
   }
+  ThreadAttributes& SetSchedulingPolicy(ThreadSchedulingPolicy policy_param) {
+    scheduling_policy = policy_param;
+    return *this;
+  }
+  ThreadAttributes& SetCpuAffinityMask(uint64_t mask_param) {
+    cpu_affinity_mask = mask_param;
+    return *this;
+  }
 };
 
+// Applies `attributes` to the calling thread. Returns false if some of them
+// could not be applied, e.g. real-time scheduling without the privilege.
+bool SetCurrentThreadAttributes(const ThreadAttributes& attributes);
+
 // Represents a simple worker thread.
 class PlatformThread final {
  public:
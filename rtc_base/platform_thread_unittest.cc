@@ -10,6 +10,10 @@
 
 #include "rtc_base/platform_thread.h"
 
+#if defined(WEBRTC_LINUX)
+#include <sched.h>
+#endif
+
 #include "absl/types/optional.h"
 #include "rtc_base/event.h"
 #include "system_wrappers/include/sleep.h"
@@ -106,4 +110,41 @@ TEST(PlatformThreadTest, StopsBeforeDetachedThreadExits) {
   EXPECT_TRUE(flag);
 }
 
+TEST(PlatformThreadTest, TimeSharingThreadsNeedNoPrivilege) {
+  bool attributes_set = false;
+  PlatformThread::SpawnJoinable(
+      [&] {
+        attributes_set = SetCurrentThreadAttributes(
+            ThreadAttributes().SetSchedulingPolicy(
+                ThreadSchedulingPolicy::kTimeSharing));
+      },
+      "T");
+  EXPECT_TRUE(attributes_set);
+}
+
+#if defined(WEBRTC_LINUX)
+TEST(PlatformThreadTest, AppliesCpuAffinity) {
+  cpu_set_t cpus;
+  ASSERT_EQ(sched_getaffinity(0, sizeof(cpus), &cpus), 0);
+  int cpu = 0;
+  while (cpu < 64 && !CPU_ISSET(cpu, &cpus)) {
+    ++cpu;
+  }
+  ASSERT_LT(cpu, 64);
+
+  int cpus_allowed = 0;
+  bool cpu_allowed = false;
+  PlatformThread::SpawnJoinable(
+      [&] {
+        cpu_set_t thread_cpus;
+        sched_getaffinity(0, sizeof(thread_cpus), &thread_cpus);
+        cpus_allowed = CPU_COUNT(&thread_cpus);
+        cpu_allowed = CPU_ISSET(cpu, &thread_cpus);
+      },
+      "T", ThreadAttributes().SetCpuAffinityMask(uint64_t{1} << cpu));
+  EXPECT_EQ(cpus_allowed, 1);
+  EXPECT_TRUE(cpu_allowed);
+}
+#endif
+
 }  // namespace rtc
@@ -61,7 +61,15 @@ scoped_refptr<RTCCertificate> RTCCertificateGenerator::GenerateCertificate(
 
 RTCCertificateGenerator::RTCCertificateGenerator(Thread* signaling_thread,
                                                  Thread* worker_thread)
-    : signaling_thread_(signaling_thread), worker_thread_(worker_thread) {
+    : RTCCertificateGenerator(signaling_thread, worker_thread, nullptr) {}
+
+RTCCertificateGenerator::RTCCertificateGenerator(
+    Thread* signaling_thread,
+    Thread* worker_thread,
+    scoped_refptr<RTCCertificatePool> pool)
+    : signaling_thread_(signaling_thread),
+      worker_thread_(worker_thread),
+      pool_(std::move(pool)) {
   RTC_DCHECK(signaling_thread_);
   RTC_DCHECK(worker_thread_);
 }
@@ -73,6 +81,17 @@ void RTCCertificateGenerator::GenerateCertificateAsync(
   RTC_DCHECK(signaling_thread_->IsCurrent());
   RTC_DCHECK(callback);
 
+  if (pool_ && !expires_ms) {
+    scoped_refptr<RTCCertificate> certificate = pool_->Take(key_params);
+    if (certificate) {
+      signaling_thread_->PostTask(
+          [cert = std::move(certificate), cb = std::move(callback)]() mutable {
+            std::move(cb)(std::move(cert));
+          });
+      return;
+    }
+  }
+
   worker_thread_->PostTask([key_params, expires_ms,
                             signaling_thread = signaling_thread_,
                             cb = std::move(callback)]() mutable {
@@ -17,6 +17,7 @@
 #include "absl/types/optional.h"
 #include "api/scoped_refptr.h"
 #include "rtc_base/rtc_certificate.h"
+#include "rtc_base/rtc_certificate_pool.h"
 #include "rtc_base/ssl_identity.h"
 #include "rtc_base/system/rtc_export.h"
 #include "rtc_base/thread.h"
@@ -61,6 +62,11 @@ class RTC_EXPORT RTCCertificateGenerator
       const absl::optional<uint64_t>& expires_ms);
 
   RTCCertificateGenerator(Thread* signaling_thread, Thread* worker_thread);
+  // Takes the certificates from `pool` when it has one ready for the
+  // requested key parameters and no expiration time is requested.
+  RTCCertificateGenerator(Thread* signaling_thread,
+                          Thread* worker_thread,
+                          scoped_refptr<RTCCertificatePool> pool);
   ~RTCCertificateGenerator() override {}
 
   // `RTCCertificateGeneratorInterface` overrides.
@@ -75,6 +81,7 @@ class RTC_EXPORT RTCCertificateGenerator
  private:
   Thread* const signaling_thread_;
   Thread* const worker_thread_;
+  const scoped_refptr<RTCCertificatePool> pool_;
 };
 
 }  // namespace rtc
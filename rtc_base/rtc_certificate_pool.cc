@@ -0,0 +1,123 @@
+/*
+ *  Copyright 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/rtc_certificate_pool.h"
+
+#include <utility>
+
+#include "absl/types/optional.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/rtc_certificate_generator.h"
+#include "rtc_base/time_utils.h"
+
+namespace rtc {
+
+namespace {
+
+bool SameKeyParams(const KeyParams& a, const KeyParams& b) {
+  if (a.type() != b.type()) {
+    return false;
+  }
+  if (a.type() == KT_RSA) {
+    return a.rsa_params().mod_size == b.rsa_params().mod_size &&
+           a.rsa_params().pub_exp == b.rsa_params().pub_exp;
+  }
+  return a.ec_curve() == b.ec_curve();
+}
+
+}  // namespace
+
+RTCCertificatePool::RTCCertificatePool(const Config& config)
+    : config_(config), thread_(Thread::Create()) {
+  RTC_DCHECK(config_.key_params.IsValid());
+  RTC_DCHECK_GT(config_.max_age, webrtc::TimeDelta::Zero());
+  thread_->SetName("rtc_certificate_pool", this);
+  thread_->Start();
+  {
+    webrtc::MutexLock lock(&mutex_);
+    MaybeGenerate();
+  }
+  // Checking twice per `max_age` keeps the certificates at most 1.5 times
+  // that old between two requests.
+  rotation_task_ = webrtc::RepeatingTaskHandle::DelayedStart(
+      thread_.get(), config_.max_age / 2, [this] {
+        webrtc::MutexLock lock(&mutex_);
+        DropOldCertificates();
+        MaybeGenerate();
+        return config_.max_age / 2;
+      });
+}
+
+RTCCertificatePool::~RTCCertificatePool() {
+  thread_->BlockingCall([this] { rotation_task_.Stop(); });
+  // Waits for the generation in progress, if any. The other tasks are dropped.
+  thread_->Stop();
+}
+
+scoped_refptr<RTCCertificate> RTCCertificatePool::Take(
+    const KeyParams& key_params) {
+  if (!SameKeyParams(key_params, config_.key_params)) {
+    return nullptr;
+  }
+  webrtc::MutexLock lock(&mutex_);
+  DropOldCertificates();
+  scoped_refptr<RTCCertificate> certificate;
+  if (certificates_.empty()) {
+    ++stats_.misses;
+  } else {
+    ++stats_.hits;
+    certificate = std::move(certificates_.front().certificate);
+    certificates_.pop_front();
+  }
+  MaybeGenerate();
+  return certificate;
+}
+
+RTCCertificatePool::Stats RTCCertificatePool::GetStats() const {
+  webrtc::MutexLock lock(&mutex_);
+  Stats stats = stats_;
+  stats.available = certificates_.size();
+  return stats;
+}
+
+void RTCCertificatePool::MaybeGenerate() {
+  while (certificates_.size() + pending_ < config_.size) {
+    ++pending_;
+    thread_->PostTask([this] { Generate(); });
+  }
+}
+
+void RTCCertificatePool::Generate() {
+  RTC_DCHECK_RUN_ON(thread_.get());
+  scoped_refptr<RTCCertificate> certificate =
+      RTCCertificateGenerator::GenerateCertificate(config_.key_params,
+                                                   absl::nullopt);
+  webrtc::MutexLock lock(&mutex_);
+  --pending_;
+  if (!certificate) {
+    // Not retried until the next request or rotation, generation is unlikely
+    // to succeed right away.
+    ++stats_.generation_failures;
+    return;
+  }
+  ++stats_.generated;
+  certificates_.push_back({std::move(certificate), TimeMillis()});
+}
+
+void RTCCertificatePool::DropOldCertificates() {
+  const int64_t oldest_ms = TimeMillis() - config_.max_age.ms();
+  while (!certificates_.empty() &&
+         certificates_.front().created_ms <= oldest_ms) {
+    ++stats_.rotated;
+    certificates_.pop_front();
+  }
+}
+
+}  // namespace rtc
@@ -0,0 +1,103 @@
+/*
+ *  Copyright 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_RTC_CERTIFICATE_POOL_H_
+#define RTC_BASE_RTC_CERTIFICATE_POOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <deque>
+#include <memory>
+
+#include "api/ref_counted_base.h"
+#include "api/scoped_refptr.h"
+#include "api/units/time_delta.h"
+#include "rtc_base/rtc_certificate.h"
+#include "rtc_base/ssl_identity.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/system/rtc_export.h"
+#include "rtc_base/task_utils/repeating_task.h"
+#include "rtc_base/thread.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace rtc {
+
+// Keeps a number of certificates generated ahead of time, so that creating a
+// PeerConnection does not have to wait for a new key. The certificates are
+// generated on a background thread owned by the pool, each one is handed out
+// at most once, and a new one is generated for every certificate taken.
+// Certificates that stay in the pool for longer than `max_age` are replaced,
+// so that the ones handed out have nearly all their lifetime left.
+//
+// The pool is thread safe.
+class RTC_EXPORT RTCCertificatePool
+    : public RefCountedNonVirtual<RTCCertificatePool> {
+ public:
+  struct Config {
+    // The parameters of the pooled keys. Requests for other parameters are
+    // not served from the pool.
+    KeyParams key_params;
+    // The number of certificates to keep ready.
+    size_t size = 0;
+    webrtc::TimeDelta max_age = webrtc::TimeDelta::Seconds(24 * 60 * 60);
+  };
+
+  struct Stats {
+    // Requests served from the pool.
+    uint64_t hits = 0;
+    // Requests made while the pool was empty.
+    uint64_t misses = 0;
+    uint64_t generated = 0;
+    uint64_t generation_failures = 0;
+    // Certificates dropped for being older than `max_age`.
+    uint64_t rotated = 0;
+    // Certificates ready to be taken.
+    size_t available = 0;
+  };
+
+  explicit RTCCertificatePool(const Config& config);
+  ~RTCCertificatePool();
+
+  RTCCertificatePool(const RTCCertificatePool&) = delete;
+  RTCCertificatePool& operator=(const RTCCertificatePool&) = delete;
+
+  // Returns a certificate with a key generated with `key_params`, or null if
+  // none is ready, in which case the caller generates its own.
+  scoped_refptr<RTCCertificate> Take(const KeyParams& key_params);
+
+  Stats GetStats() const;
+
+ private:
+  struct Entry {
+    scoped_refptr<RTCCertificate> certificate;
+    int64_t created_ms;
+  };
+
+  // Posts the generation of the missing certificates.
+  void MaybeGenerate() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  void Generate();
+  void DropOldCertificates() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  const Config config_;
+  const std::unique_ptr<Thread> thread_;
+  webrtc::RepeatingTaskHandle rotation_task_;
+
+  mutable webrtc::Mutex mutex_;
+  // Oldest first.
+  std::deque<Entry> certificates_ RTC_GUARDED_BY(mutex_);
+  // Certificates being generated.
+  size_t pending_ RTC_GUARDED_BY(mutex_) = 0;
+  Stats stats_ RTC_GUARDED_BY(mutex_);
+};
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_RTC_CERTIFICATE_POOL_H_
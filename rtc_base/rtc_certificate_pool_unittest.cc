@@ -0,0 +1,101 @@
+/*
+ *  Copyright 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/rtc_certificate_pool.h"
+
+#include <memory>
+
+#include "absl/types/optional.h"
+#include "api/make_ref_counted.h"
+#include "rtc_base/gunit.h"
+#include "rtc_base/rtc_certificate_generator.h"
+#include "rtc_base/thread.h"
+#include "test/gtest.h"
+
+namespace rtc {
+namespace {
+
+constexpr int kGenerationTimeoutMs = 10000;
+
+scoped_refptr<RTCCertificatePool> CreatePool(size_t size) {
+  RTCCertificatePool::Config config;
+  config.size = size;
+  return make_ref_counted<RTCCertificatePool>(config);
+}
+
+class RTCCertificatePoolTest : public ::testing::Test {
+ protected:
+  AutoThread main_thread_;
+};
+
+TEST_F(RTCCertificatePoolTest, HandsOutEachCertificateOnce) {
+  scoped_refptr<RTCCertificatePool> pool = CreatePool(2);
+  EXPECT_EQ_WAIT(2u, pool->GetStats().available, kGenerationTimeoutMs);
+
+  scoped_refptr<RTCCertificate> first = pool->Take(KeyParams());
+  scoped_refptr<RTCCertificate> second = pool->Take(KeyParams());
+  ASSERT_TRUE(first);
+  ASSERT_TRUE(second);
+  EXPECT_NE(first, second);
+  EXPECT_EQ(2u, pool->GetStats().hits);
+
+  // The pool is refilled.
+  EXPECT_EQ_WAIT(2u, pool->GetStats().available, kGenerationTimeoutMs);
+  EXPECT_EQ(4u, pool->GetStats().generated);
+}
+
+TEST_F(RTCCertificatePoolTest, DoesNotServeOtherKeyParams) {
+  scoped_refptr<RTCCertificatePool> pool = CreatePool(1);
+  EXPECT_EQ_WAIT(1u, pool->GetStats().available, kGenerationTimeoutMs);
+  EXPECT_FALSE(pool->Take(KeyParams::RSA()));
+  EXPECT_EQ(0u, pool->GetStats().misses);
+  EXPECT_EQ(1u, pool->GetStats().available);
+}
+
+TEST_F(RTCCertificatePoolTest, ReplacesOldCertificates) {
+  RTCCertificatePool::Config config;
+  config.size = 1;
+  config.max_age = webrtc::TimeDelta::Millis(50);
+  auto pool = make_ref_counted<RTCCertificatePool>(config);
+  EXPECT_TRUE_WAIT(
+      pool->GetStats().rotated > 0 && pool->GetStats().generated > 1,
+      kGenerationTimeoutMs);
+}
+
+TEST_F(RTCCertificatePoolTest, GeneratorTakesCertificatesFromPool) {
+  std::unique_ptr<Thread> worker_thread = Thread::Create();
+  worker_thread->Start();
+  scoped_refptr<RTCCertificatePool> pool = CreatePool(1);
+  RTCCertificateGenerator generator(Thread::Current(), worker_thread.get(),
+                                    pool);
+  EXPECT_EQ_WAIT(1u, pool->GetStats().available, kGenerationTimeoutMs);
+
+  scoped_refptr<RTCCertificate> certificate;
+  generator.GenerateCertificateAsync(
+      KeyParams(), absl::nullopt,
+      [&](scoped_refptr<RTCCertificate> generated) {
+        certificate = std::move(generated);
+      });
+  EXPECT_TRUE_WAIT(certificate, kGenerationTimeoutMs);
+  EXPECT_EQ(1u, pool->GetStats().hits);
+
+  // Certificates with a requested expiration are always generated.
+  certificate = nullptr;
+  generator.GenerateCertificateAsync(
+      KeyParams(), 60 * 60 * 1000,
+      [&](scoped_refptr<RTCCertificate> generated) {
+        certificate = std::move(generated);
+      });
+  EXPECT_TRUE_WAIT(certificate, kGenerationTimeoutMs);
+  EXPECT_EQ(1u, pool->GetStats().hits);
+}
+
+}  // namespace
+}  // namespace rtc
@@ -12,6 +12,7 @@
 
 #include <cstdint>
 
+#include "api/array_view.h"
 #include "rtc_base/buffer.h"
 
 namespace rtc {
@@ -30,4 +31,37 @@ int Socket::RecvFrom(ReceiveBuffer& buffer) {
   return len;
 }
 
+int Socket::SendGathered(
+    rtc::ArrayView<const rtc::ArrayView<const uint8_t>> buffers) {
+  if (buffers.size() == 1) {
+    return Send(buffers[0].data(), buffers[0].size());
+  }
+  Buffer data;
+  for (rtc::ArrayView<const uint8_t> buffer : buffers) {
+    data.AppendData(buffer.data(), buffer.size());
+  }
+  return Send(data.data(), data.size());
+}
+
+int Socket::SendToBatch(rtc::ArrayView<const SendBuffer> packets) {
+  int sent = 0;
+  for (const SendBuffer& packet : packets) {
+    int result = SendTo(packet.payload.data(), packet.payload.size(),
+                        packet.destination);
+    if (result < 0) {
+      return sent > 0 ? sent : result;
+    }
+    ++sent;
+  }
+  return sent;
+}
+
+int Socket::RecvFromBatch(rtc::ArrayView<ReceiveBuffer> buffers) {
+  if (buffers.empty()) {
+    return 0;
+  }
+  int len = RecvFrom(buffers[0]);
+  return len > 0 ? 1 : len;
+}
+
 }  // namespace rtc
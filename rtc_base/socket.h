@@ -28,8 +28,10 @@
 #include "rtc_base/win32.h"
 #endif
 
+#include "api/array_view.h"
 #include "api/units/timestamp.h"
 #include "rtc_base/buffer.h"
+#include "rtc_base/network/ecn_marking.h"
 #include "rtc_base/socket_address.h"
 #include "rtc_base/system/rtc_export.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
@@ -91,8 +93,14 @@ class RTC_EXPORT Socket {
 
     absl::optional<webrtc::Timestamp> arrival_time;
     SocketAddress source_address;
+    // Only read if OPT_RECV_ECN is enabled.
+    EcnMarking ecn = EcnMarking::kNotEct;
     Buffer& payload;
   };
+  struct SendBuffer {
+    rtc::ArrayView<const uint8_t> payload;
+    SocketAddress destination;
+  };
   virtual ~Socket() {}
 
   Socket(const Socket&) = delete;
@@ -109,7 +117,18 @@ class RTC_EXPORT Socket {
   virtual int Bind(const SocketAddress& addr) = 0;
   virtual int Connect(const SocketAddress& addr) = 0;
   virtual int Send(const void* pv, size_t cb) = 0;
+  // Sends the concatenation of `buffers` like a single Send() of it, and
+  // returns the number of bytes sent. Lets stream sockets send a frame header
+  // and its payload without copying them together. Default implementation
+  // copies them into one buffer and calls Send().
+  virtual int SendGathered(
+      rtc::ArrayView<const rtc::ArrayView<const uint8_t>> buffers);
   virtual int SendTo(const void* pv, size_t cb, const SocketAddress& addr) = 0;
+  // Sends the datagrams in `packets`, in order, in as few system calls as
+  // possible. Returns the number of datagrams sent, which may be less than
+  // `packets.size()`, or a negative value if the first datagram could not be
+  // sent. Default implementation calls SendTo() for each datagram.
+  virtual int SendToBatch(rtc::ArrayView<const SendBuffer> packets);
   // `timestamp` is in units of microseconds.
   virtual int Recv(void* pv, size_t cb, int64_t* timestamp) = 0;
   // TODO(webrtc:15368): Deprecate and remove.
@@ -124,6 +143,11 @@ class RTC_EXPORT Socket {
   // Default implementation calls RecvFrom(void* ...) with 64Kbyte buffer.
   // Returns number of bytes received or a negative value on error.
   virtual int RecvFrom(ReceiveBuffer& buffer);
+  // Receives up to `buffers.size()` datagrams in one call, filling
+  // `buffers` in order. Returns the number of datagrams received, or a
+  // negative value on error. Default implementation receives a single
+  // datagram using RecvFrom(ReceiveBuffer&).
+  virtual int RecvFromBatch(rtc::ArrayView<ReceiveBuffer> buffers);
   virtual int Listen(int backlog) = 0;
   virtual Socket* Accept(SocketAddress* paddr) = 0;
   virtual int Close() = 0;
@@ -144,10 +168,18 @@ class RTC_EXPORT Socket {
     OPT_RTP_SENDTIME_EXTN_ID,  // This is a non-traditional socket option param.
                                // This is specific to libjingle and will be used
                                // if SendTime option is needed at socket level.
+    OPT_SEND_ECN,              // ECN codepoint (EcnMarking) of sent packets.
+    OPT_RECV_ECN,              // Whether to read the ECN codepoint of
+                               // received packets.
   };
   virtual int GetOption(Option opt, int* value) = 0;
   virtual int SetOption(Option opt, int value) = 0;
 
+  // Returns the POSIX descriptor of the OS socket that carries the data of
+  // this socket unchanged, or -1 if there is none, e.g. because this socket
+  // transforms the data or is not backed by an OS socket.
+  virtual int GetNativeDescriptor() const { return -1; }
+
   // SignalReadEvent and SignalWriteEvent use multi_threaded_local to allow
   // access concurrently from different thread.
   // For example SignalReadEvent::connect will be called in AsyncUDPSocket ctor
@@ -100,8 +100,10 @@ enum SSLProtocolVersion {
   SSL_PROTOCOL_TLS_10 = 0,
   SSL_PROTOCOL_TLS_11,
   SSL_PROTOCOL_TLS_12,
+  SSL_PROTOCOL_TLS_13,
   SSL_PROTOCOL_DTLS_10 = SSL_PROTOCOL_TLS_11,
   SSL_PROTOCOL_DTLS_12 = SSL_PROTOCOL_TLS_12,
+  SSL_PROTOCOL_DTLS_13 = SSL_PROTOCOL_TLS_13,
 };
 enum class SSLPeerCertificateDigestError {
   NONE,
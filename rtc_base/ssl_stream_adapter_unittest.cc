@@ -1591,6 +1591,51 @@ TEST_P(SSLStreamAdapterTestDTLS, TestGetSslCipherSuite) {
       server_cipher, ::testing::get<1>(GetParam()).type()));
 }
 
+// DTLS 1.3 enabled for the server only -> DTLS 1.2 will be used.
+TEST_P(SSLStreamAdapterTestDTLS, TestGetSslVersionDtls13Server) {
+  SetupProtocolVersions(rtc::SSL_PROTOCOL_DTLS_13, rtc::SSL_PROTOCOL_DTLS_12);
+  TestHandshake();
+
+  ASSERT_EQ(rtc::SSL_PROTOCOL_DTLS_12, GetSslVersion(true));
+  ASSERT_EQ(rtc::SSL_PROTOCOL_DTLS_12, GetSslVersion(false));
+}
+
+// DTLS 1.3 enabled for both, which is used when the SSL library supports it.
+TEST_P(SSLStreamAdapterTestDTLS, TestGetSslCipherSuiteDtls13Both) {
+  SetupProtocolVersions(rtc::SSL_PROTOCOL_DTLS_13, rtc::SSL_PROTOCOL_DTLS_13);
+  TestHandshake();
+
+  int client_cipher;
+  ASSERT_TRUE(GetSslCipherSuite(true, &client_cipher));
+  int server_cipher;
+  ASSERT_TRUE(GetSslCipherSuite(false, &server_cipher));
+
+  EXPECT_EQ(GetSslVersion(true), GetSslVersion(false));
+  EXPECT_GE(GetSslVersion(true), rtc::SSL_PROTOCOL_DTLS_12);
+
+  ASSERT_EQ(client_cipher, server_cipher);
+  ASSERT_TRUE(rtc::SSLStreamAdapter::IsAcceptableCipher(
+      server_cipher, ::testing::get<1>(GetParam()).type()));
+}
+
+// TLS 1.3 enabled for client and server -> TLS 1.3 will be used.
+TEST_P(SSLStreamAdapterTestTLS, TestGetSslCipherSuiteTls13Both) {
+  SetupProtocolVersions(rtc::SSL_PROTOCOL_TLS_13, rtc::SSL_PROTOCOL_TLS_13);
+  TestHandshake();
+
+  int client_cipher;
+  ASSERT_TRUE(GetSslCipherSuite(true, &client_cipher));
+  int server_cipher;
+  ASSERT_TRUE(GetSslCipherSuite(false, &server_cipher));
+
+  ASSERT_EQ(rtc::SSL_PROTOCOL_TLS_13, GetSslVersion(true));
+  ASSERT_EQ(rtc::SSL_PROTOCOL_TLS_13, GetSslVersion(false));
+
+  ASSERT_EQ(client_cipher, server_cipher);
+  ASSERT_TRUE(rtc::SSLStreamAdapter::IsAcceptableCipher(
+      server_cipher, ::testing::get<1>(GetParam()).type()));
+}
+
 // The RSA keysizes here might look strange, why not include the RFC's size
 // 2048?. The reason is test case slowness; testing two sizes to exercise
 // parametrization is sufficient.
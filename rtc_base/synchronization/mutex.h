@@ -28,20 +28,51 @@
 #error Unsupported platform.
 #endif
 
+#if defined(WEBRTC_MUTEX_PROFILING)
+#include "api/location.h"                            // nogncheck
+#include "rtc_base/synchronization/mutex_profiler.h"  // nogncheck
+#include "rtc_base/time_utils.h"                     // nogncheck
+#endif
+
 namespace webrtc {
 
 // The Mutex guarantees exclusive access and aims to follow Abseil semantics
 // (i.e. non-reentrant etc).
 class RTC_LOCKABLE Mutex final {
  public:
+#if defined(WEBRTC_MUTEX_PROFILING)
+  // Contention is recorded per construction site, see mutex_profiler.h.
+  Mutex(const Location& location = Location::Current())
+      : contention_site_(GetMutexContentionSite(location)) {}
+#else
   Mutex() = default;
+#endif
   Mutex(const Mutex&) = delete;
   Mutex& operator=(const Mutex&) = delete;
 
+#if defined(WEBRTC_MUTEX_PROFILING)
+  void Lock() RTC_EXCLUSIVE_LOCK_FUNCTION() {
+    if (impl_.TryLock()) {
+      contention_site_->RecordLock();
+      return;
+    }
+    const int64_t wait_start_ns = rtc::TimeNanos();
+    impl_.Lock();
+    contention_site_->RecordContendedLock(rtc::TimeNanos() - wait_start_ns);
+  }
+  ABSL_MUST_USE_RESULT bool TryLock() RTC_EXCLUSIVE_TRYLOCK_FUNCTION(true) {
+    if (!impl_.TryLock()) {
+      return false;
+    }
+    contention_site_->RecordLock();
+    return true;
+  }
+#else
   void Lock() RTC_EXCLUSIVE_LOCK_FUNCTION() { impl_.Lock(); }
   ABSL_MUST_USE_RESULT bool TryLock() RTC_EXCLUSIVE_TRYLOCK_FUNCTION(true) {
     return impl_.TryLock();
   }
+#endif
   // Return immediately if this thread holds the mutex, or RTC_DCHECK_IS_ON==0.
   // Otherwise, may report an error (typically by crashing with a diagnostic),
   // or may return immediately.
@@ -50,6 +81,9 @@ class RTC_LOCKABLE Mutex final {
 
  private:
   MutexImpl impl_;
+#if defined(WEBRTC_MUTEX_PROFILING)
+  MutexContentionSite* const contention_site_;
+#endif
 };
 
 // MutexLock, for serializing execution through a scope.
@@ -0,0 +1,156 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/synchronization/mutex_profiler.h"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <utility>
+
+#include "absl/strings/string_view.h"
+#include "rtc_base/strings/string_builder.h"
+// The registry is guarded by the platform mutex rather than webrtc::Mutex, so
+// that it is not profiled itself.
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+namespace {
+
+class MutexContentionRegistry {
+ public:
+  MutexContentionSite* GetSite(const Location& location) {
+    impl_.Lock();
+    std::unique_ptr<MutexContentionSite>& site =
+        sites_[std::make_pair(absl::string_view(location.file_name()),
+                              location.line_number())];
+    if (site == nullptr) {
+      site = std::make_unique<MutexContentionSite>(location.file_name(),
+                                                   location.line_number());
+    }
+    MutexContentionSite* result = site.get();
+    impl_.Unlock();
+    return result;
+  }
+
+  std::vector<MutexContentionStats> GetStats() {
+    std::vector<MutexContentionStats> stats;
+    impl_.Lock();
+    stats.reserve(sites_.size());
+    for (const auto& [key, site] : sites_) {
+      stats.push_back(site->GetStats());
+    }
+    impl_.Unlock();
+    return stats;
+  }
+
+  void Reset() {
+    impl_.Lock();
+    for (const auto& [key, site] : sites_) {
+      site->Reset();
+    }
+    impl_.Unlock();
+  }
+
+ private:
+  MutexImpl impl_;
+  // File names come from __builtin_FILE() and have static storage duration.
+  std::map<std::pair<absl::string_view, int>,
+           std::unique_ptr<MutexContentionSite>>
+      sites_ RTC_GUARDED_BY(impl_);
+};
+
+MutexContentionRegistry& GetRegistry() {
+  // Leaked, since mutexes may be constructed and locked during static
+  // destruction.
+  static MutexContentionRegistry* const registry =
+      new MutexContentionRegistry();
+  return *registry;
+}
+
+}  // namespace
+
+MutexContentionSite::MutexContentionSite(const char* file_name,
+                                         int line_number)
+    : file_name_(file_name), line_number_(line_number) {}
+
+void MutexContentionSite::RecordContendedLock(int64_t wait_time_ns) {
+  lock_count_.fetch_add(1, std::memory_order_relaxed);
+  contended_lock_count_.fetch_add(1, std::memory_order_relaxed);
+  total_wait_time_ns_.fetch_add(wait_time_ns, std::memory_order_relaxed);
+  int64_t max_wait_time_ns = max_wait_time_ns_.load(std::memory_order_relaxed);
+  while (wait_time_ns > max_wait_time_ns &&
+         !max_wait_time_ns_.compare_exchange_weak(max_wait_time_ns,
+                                                  wait_time_ns,
+                                                  std::memory_order_relaxed)) {
+  }
+}
+
+MutexContentionStats MutexContentionSite::GetStats() const {
+  MutexContentionStats stats;
+  stats.file_name = file_name_;
+  stats.line_number = line_number_;
+  stats.lock_count = lock_count_.load(std::memory_order_relaxed);
+  stats.contended_lock_count =
+      contended_lock_count_.load(std::memory_order_relaxed);
+  stats.total_wait_time = TimeDelta::Micros(
+      total_wait_time_ns_.load(std::memory_order_relaxed) / 1000);
+  stats.max_wait_time = TimeDelta::Micros(
+      max_wait_time_ns_.load(std::memory_order_relaxed) / 1000);
+  return stats;
+}
+
+void MutexContentionSite::Reset() {
+  lock_count_.store(0, std::memory_order_relaxed);
+  contended_lock_count_.store(0, std::memory_order_relaxed);
+  total_wait_time_ns_.store(0, std::memory_order_relaxed);
+  max_wait_time_ns_.store(0, std::memory_order_relaxed);
+}
+
+MutexContentionSite* GetMutexContentionSite(const Location& location) {
+  return GetRegistry().GetSite(location);
+}
+
+std::vector<MutexContentionStats> GetTopContendedMutexes(size_t max_count) {
+  std::vector<MutexContentionStats> stats = GetRegistry().GetStats();
+  auto by_wait_time = [](const MutexContentionStats& a,
+                         const MutexContentionStats& b) {
+    if (a.total_wait_time != b.total_wait_time)
+      return a.total_wait_time > b.total_wait_time;
+    return a.contended_lock_count > b.contended_lock_count;
+  };
+  if (stats.size() > max_count) {
+    std::partial_sort(stats.begin(), stats.begin() + max_count, stats.end(),
+                      by_wait_time);
+    stats.resize(max_count);
+  } else {
+    std::sort(stats.begin(), stats.end(), by_wait_time);
+  }
+  return stats;
+}
+
+std::string GetMutexContentionReport(size_t max_count) {
+  rtc::StringBuilder report;
+  for (const MutexContentionStats& stats : GetTopContendedMutexes(max_count)) {
+    report << stats.file_name << ":" << stats.line_number
+           << " locks: " << stats.lock_count
+           << ", contended: " << stats.contended_lock_count
+           << ", total_wait_us: " << stats.total_wait_time.us()
+           << ", max_wait_us: " << stats.max_wait_time.us() << "\n";
+  }
+  return report.Release();
+}
+
+void ResetMutexContentionStats() {
+  GetRegistry().Reset();
+}
+
+}  // namespace webrtc
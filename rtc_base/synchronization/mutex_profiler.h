@@ -0,0 +1,83 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_SYNCHRONIZATION_MUTEX_PROFILER_H_
+#define RTC_BASE_SYNCHRONIZATION_MUTEX_PROFILER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "api/location.h"
+#include "api/units/time_delta.h"
+
+// Contention profiling of webrtc::Mutex, compiled in when building with
+// rtc_enable_mutex_profiling = true. Every Mutex then counts its
+// acquisitions and the time spent waiting for it, aggregated per
+// construction site, so that all instances created by the same line of code
+// (e.g. the mutex of every RtpPacketHistory) share one record.
+
+namespace webrtc {
+
+struct MutexContentionStats {
+  // Where the mutexes were constructed.
+  const char* file_name = nullptr;
+  int line_number = 0;
+  // Number of times the mutexes were acquired, and how many of those had to
+  // wait for another thread to release them.
+  int64_t lock_count = 0;
+  int64_t contended_lock_count = 0;
+  TimeDelta total_wait_time = TimeDelta::Zero();
+  TimeDelta max_wait_time = TimeDelta::Zero();
+};
+
+// Contention counters shared by the mutexes constructed at one site. The
+// counters are relaxed atomics, since they are only read for reporting.
+class MutexContentionSite {
+ public:
+  MutexContentionSite(const char* file_name, int line_number);
+  MutexContentionSite(const MutexContentionSite&) = delete;
+  MutexContentionSite& operator=(const MutexContentionSite&) = delete;
+
+  void RecordLock() { lock_count_.fetch_add(1, std::memory_order_relaxed); }
+  void RecordContendedLock(int64_t wait_time_ns);
+
+  MutexContentionStats GetStats() const;
+  void Reset();
+
+ private:
+  const char* const file_name_;
+  const int line_number_;
+  std::atomic<int64_t> lock_count_{0};
+  std::atomic<int64_t> contended_lock_count_{0};
+  std::atomic<int64_t> total_wait_time_ns_{0};
+  std::atomic<int64_t> max_wait_time_ns_{0};
+};
+
+// Returns the record for mutexes constructed at `location`, creating it on
+// first use. Records are never deleted.
+MutexContentionSite* GetMutexContentionSite(const Location& location);
+
+// Debug API. Returns the `max_count` construction sites with the longest total
+// wait time, longest first.
+std::vector<MutexContentionStats> GetTopContendedMutexes(size_t max_count);
+
+// Same as GetTopContendedMutexes(), formatted as one line per site.
+std::string GetMutexContentionReport(size_t max_count);
+
+// Clears the counters of all sites, e.g. to profile a single call.
+void ResetMutexContentionStats();
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_SYNCHRONIZATION_MUTEX_PROFILER_H_
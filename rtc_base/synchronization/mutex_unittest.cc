@@ -13,12 +13,14 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <algorithm>
 #include <atomic>
 #include <memory>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "absl/strings/match.h"
 #include "benchmark/benchmark.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/event.h"
@@ -27,6 +29,10 @@
 #include "rtc_base/thread.h"
 #include "test/gtest.h"
 
+#if defined(WEBRTC_MUTEX_PROFILING)
+#include "rtc_base/synchronization/mutex_profiler.h"  // nogncheck
+#endif
+
 namespace webrtc {
 namespace {
 
@@ -174,5 +180,37 @@ TEST(MutexTest, ProtectsSharedResourceWithMutexAndMutexLocker) {
   EXPECT_EQ(0, runner.shared_value());
 }
 
+#if defined(WEBRTC_MUTEX_PROFILING)
+TEST(MutexTest, ProfilingRecordsContentionPerConstructionSite) {
+  ResetMutexContentionStats();
+  const int construction_line = __LINE__ + 1;
+  Mutex mutex;
+  mutex.Lock();
+  Event unlocked;
+  std::unique_ptr<Thread> thread(Thread::Create());
+  thread->Start();
+  thread->PostTask([&] {
+    mutex.Lock();
+    mutex.Unlock();
+    unlocked.Set();
+  });
+  // Give the thread time to block on the mutex.
+  Thread::SleepMs(100);
+  mutex.Unlock();
+  ASSERT_TRUE(unlocked.Wait(TimeDelta::Seconds(10)));
+
+  std::vector<MutexContentionStats> top = GetTopContendedMutexes(1000);
+  auto it = std::find_if(top.begin(), top.end(), [&](const auto& stats) {
+    return stats.line_number == construction_line &&
+           absl::EndsWith(stats.file_name, "mutex_unittest.cc");
+  });
+  ASSERT_NE(it, top.end());
+  EXPECT_EQ(it->lock_count, 2);
+  EXPECT_EQ(it->contended_lock_count, 1);
+  EXPECT_GT(it->total_wait_time, TimeDelta::Zero());
+  EXPECT_EQ(it->max_wait_time, it->total_wait_time);
+}
+#endif
+
 }  // namespace
 }  // namespace webrtc
@@ -0,0 +1,79 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_SYNCHRONIZATION_SEQ_LOCK_H_
+#define RTC_BASE_SYNCHRONIZATION_SEQ_LOCK_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <array>
+#include <atomic>
+#include <type_traits>
+
+namespace webrtc {
+
+// Publishes a small trivially copyable value from one writer to any number of
+// readers without blocking the writer. `Load()` never takes a lock; it retries
+// if a `Store()` ran concurrently, so it always returns a value that was
+// stored as a whole. Concurrent calls to `Store()` must be serialized by the
+// caller.
+template <typename T>
+class SeqLock {
+ public:
+  static_assert(std::is_trivially_copyable<T>::value,
+                "T must be trivially copyable");
+
+  SeqLock() : SeqLock(T()) {}
+  explicit SeqLock(const T& value) { Store(value); }
+
+  SeqLock(const SeqLock&) = delete;
+  SeqLock& operator=(const SeqLock&) = delete;
+
+  void Store(const T& value) {
+    std::array<uint64_t, kWords> words = {};
+    memcpy(words.data(), &value, sizeof(T));
+    // An odd sequence number tells readers that a store is in progress.
+    uint32_t sequence = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < kWords; ++i)
+      words_[i].store(words[i], std::memory_order_relaxed);
+    sequence_.store(sequence + 2, std::memory_order_release);
+  }
+
+  T Load() const {
+    static_assert(std::is_default_constructible<T>::value,
+                  "T must be default constructible");
+    std::array<uint64_t, kWords> words;
+    uint32_t sequence;
+    do {
+      sequence = sequence_.load(std::memory_order_acquire);
+      for (size_t i = 0; i < kWords; ++i)
+        words[i] = words_[i].load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+    } while ((sequence & 1) != 0 ||
+             sequence != sequence_.load(std::memory_order_relaxed));
+    T value;
+    memcpy(&value, words.data(), sizeof(T));
+    return value;
+  }
+
+ private:
+  static constexpr size_t kWords = (sizeof(T) + 7) / 8;
+
+  std::atomic<uint32_t> sequence_{0};
+  std::array<std::atomic<uint64_t>, kWords> words_;
+};
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_SYNCHRONIZATION_SEQ_LOCK_H_
@@ -0,0 +1,69 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/synchronization/seq_lock.h"
+
+#include <stdint.h>
+
+#include <atomic>
+
+#include "rtc_base/platform_thread.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+struct Values {
+  int64_t a = 0;
+  int64_t b = 0;
+  int32_t c = 0;
+  bool d = false;
+};
+
+TEST(SeqLockTest, LoadReturnsStoredValue) {
+  SeqLock<Values> lock;
+  EXPECT_EQ(lock.Load().a, 0);
+
+  lock.Store({.a = 1, .b = 2, .c = 3, .d = true});
+  Values values = lock.Load();
+  EXPECT_EQ(values.a, 1);
+  EXPECT_EQ(values.b, 2);
+  EXPECT_EQ(values.c, 3);
+  EXPECT_TRUE(values.d);
+}
+
+TEST(SeqLockTest, ReaderNeverSeesPartialStore) {
+  constexpr int64_t kNumStores = 200000;
+  SeqLock<Values> lock;
+  std::atomic<bool> done(false);
+
+  auto writer = rtc::PlatformThread::SpawnJoinable(
+      [&] {
+        for (int64_t i = 1; i <= kNumStores; ++i) {
+          lock.Store({.a = i, .b = -i, .c = static_cast<int32_t>(i)});
+        }
+        done.store(true);
+      },
+      "SeqLockWriter");
+
+  int64_t last = 0;
+  while (!done.load()) {
+    Values values = lock.Load();
+    ASSERT_EQ(values.b, -values.a);
+    ASSERT_EQ(values.c, static_cast<int32_t>(values.a));
+    ASSERT_GE(values.a, last);
+    last = values.a;
+  }
+  writer.Finalize();
+  EXPECT_EQ(lock.Load().a, kNumStores);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,195 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/task_queue_instrumentation.h"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/numeric/bits.h"
+#include "rtc_base/strings/string_builder.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+#include "rtc_base/time_utils.h"
+#include "rtc_base/trace_event.h"
+
+namespace webrtc {
+namespace {
+
+enum Mode : int { kDisabled, kEnabled, kEnabledWithTraceEvents };
+
+std::atomic<int> g_mode{kDisabled};
+
+// Samples of the tasks posted to one task queue from one location.
+struct Entry {
+  Entry(absl::string_view queue_name, std::string location)
+      : queue_name(queue_name), location(std::move(location)) {}
+
+  const std::string queue_name;
+  const std::string location;
+  Mutex mutex;
+  TaskQueueInstrumentation::Histogram queueing_delay RTC_GUARDED_BY(mutex);
+  TaskQueueInstrumentation::Histogram run_time RTC_GUARDED_BY(mutex);
+};
+
+class Registry {
+ public:
+  static Registry& Get() {
+    static Registry* const registry = new Registry();
+    return *registry;
+  }
+
+  Entry* GetEntry(absl::string_view queue_name, const Location& location) {
+    MutexLock lock(&mutex_);
+    auto queue = queues_.find(queue_name);
+    if (queue == queues_.end()) {
+      queue = queues_.emplace(std::string(queue_name), Locations()).first;
+    }
+    std::unique_ptr<Entry>& entry =
+        queue->second[{location.file_name(), location.line_number()}];
+    if (!entry) {
+      rtc::StringBuilder location_string;
+      location_string << location.file_name() << ":"
+                      << location.line_number();
+      entry = std::make_unique<Entry>(queue_name, location_string.Release());
+    }
+    return entry.get();
+  }
+
+  std::vector<TaskQueueInstrumentation::TaskStats> GetStats() {
+    std::map<std::pair<absl::string_view, absl::string_view>,
+             TaskQueueInstrumentation::TaskStats>
+        stats;
+    MutexLock lock(&mutex_);
+    for (const auto& [queue_name, locations] : queues_) {
+      for (const auto& [key, entry] : locations) {
+        MutexLock entry_lock(&entry->mutex);
+        if (entry->queueing_delay.num_samples == 0) {
+          continue;
+        }
+        // The same file may be reported with different string literals.
+        TaskQueueInstrumentation::TaskStats& task_stats =
+            stats[{entry->queue_name, entry->location}];
+        task_stats.queue_name = entry->queue_name;
+        task_stats.location = entry->location;
+        Merge(entry->queueing_delay, task_stats.queueing_delay);
+        Merge(entry->run_time, task_stats.run_time);
+      }
+    }
+    std::vector<TaskQueueInstrumentation::TaskStats> result;
+    result.reserve(stats.size());
+    for (auto& [key, task_stats] : stats) {
+      result.push_back(std::move(task_stats));
+    }
+    return result;
+  }
+
+  void Reset() {
+    MutexLock lock(&mutex_);
+    for (const auto& [queue_name, locations] : queues_) {
+      for (const auto& [key, entry] : locations) {
+        MutexLock entry_lock(&entry->mutex);
+        entry->queueing_delay = {};
+        entry->run_time = {};
+      }
+    }
+  }
+
+ private:
+  using Locations =
+      std::map<std::pair<const char*, int>, std::unique_ptr<Entry>>;
+
+  static void Merge(const TaskQueueInstrumentation::Histogram& from,
+                    TaskQueueInstrumentation::Histogram& to) {
+    for (int i = 0; i < TaskQueueInstrumentation::Histogram::kNumBuckets;
+         ++i) {
+      to.buckets[i] += from.buckets[i];
+    }
+    to.num_samples += from.num_samples;
+    to.sum += from.sum;
+    to.max = std::max(to.max, from.max);
+  }
+
+  Mutex mutex_;
+  // Entries are never removed, so that tasks in flight can keep pointers to
+  // them.
+  std::map<std::string, Locations, std::less<>> queues_ RTC_GUARDED_BY(mutex_);
+};
+
+}  // namespace
+
+void TaskQueueInstrumentation::Histogram::Add(TimeDelta duration) {
+  const int64_t us = std::max<int64_t>(duration.us(), 0);
+  const int bucket = std::min(
+      static_cast<int>(absl::bit_width(static_cast<uint64_t>(us))),
+      kNumBuckets - 1);
+  ++buckets[bucket];
+  ++num_samples;
+  sum += TimeDelta::Micros(us);
+  max = std::max(max, TimeDelta::Micros(us));
+}
+
+void TaskQueueInstrumentation::Enable(bool trace_events) {
+  g_mode.store(trace_events ? kEnabledWithTraceEvents : kEnabled,
+               std::memory_order_relaxed);
+}
+
+void TaskQueueInstrumentation::Disable() {
+  g_mode.store(kDisabled, std::memory_order_relaxed);
+}
+
+bool TaskQueueInstrumentation::IsEnabled() {
+  return g_mode.load(std::memory_order_relaxed) != kDisabled;
+}
+
+std::vector<TaskQueueInstrumentation::TaskStats>
+TaskQueueInstrumentation::GetStats() {
+  return Registry::Get().GetStats();
+}
+
+void TaskQueueInstrumentation::Reset() {
+  Registry::Get().Reset();
+}
+
+absl::AnyInvocable<void() &&> TaskQueueInstrumentation::Instrument(
+    absl::string_view queue_name,
+    const Location& location,
+    TimeDelta delay,
+    absl::AnyInvocable<void() &&> task) {
+  const int mode = g_mode.load(std::memory_order_relaxed);
+  if (mode == kDisabled) {
+    return task;
+  }
+  return [entry = Registry::Get().GetEntry(queue_name, location),
+          trace_events = mode == kEnabledWithTraceEvents,
+          due_us = rtc::TimeMicros() + delay.us(),
+          task = std::move(task)]() mutable {
+    const int64_t start_us = rtc::TimeMicros();
+    if (trace_events) {
+      TRACE_EVENT2("webrtc", "TaskQueue::RunTask", "queue",
+                   entry->queue_name.c_str(), "location",
+                   entry->location.c_str());
+      std::move(task)();
+    } else {
+      std::move(task)();
+    }
+    const int64_t end_us = rtc::TimeMicros();
+    MutexLock lock(&entry->mutex);
+    entry->queueing_delay.Add(TimeDelta::Micros(start_us - due_us));
+    entry->run_time.Add(TimeDelta::Micros(end_us - start_us));
+  };
+}
+
+}  // namespace webrtc
@@ -0,0 +1,86 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_TASK_QUEUE_INSTRUMENTATION_H_
+#define RTC_BASE_TASK_QUEUE_INSTRUMENTATION_H_
+
+#include <stdint.h>
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "absl/functional/any_invocable.h"
+#include "absl/strings/string_view.h"
+#include "api/location.h"
+#include "api/units/time_delta.h"
+#include "rtc_base/system/rtc_export.h"
+
+namespace webrtc {
+
+// Opt-in instrumentation of task queues. While enabled, the task queue
+// implementations in rtc_base, and rtc::Thread, record for every task posted
+// how long it waited before it started running, and how long it ran. The
+// waiting time of a delayed task counts from when the task became due.
+// Samples are aggregated per task queue name and posting Location.
+//
+// Instrumentation is process wide. It's meant for diagnosing which tasks keep
+// a thread busy, e.g. a network thread that falls behind.
+class RTC_EXPORT TaskQueueInstrumentation {
+ public:
+  // Histogram of durations with power-of-two buckets. Bucket 0 counts
+  // durations below 1 us, bucket i durations in [2^(i-1), 2^i) us. The last
+  // bucket also counts all longer durations (8.4 s and up).
+  struct Histogram {
+    static constexpr int kNumBuckets = 25;
+
+    void Add(TimeDelta duration);
+
+    std::array<int64_t, kNumBuckets> buckets = {};
+    int64_t num_samples = 0;
+    TimeDelta sum = TimeDelta::Zero();
+    TimeDelta max = TimeDelta::Zero();
+  };
+
+  struct TaskStats {
+    std::string queue_name;
+    // "file:line" of where the tasks were posted from.
+    std::string location;
+    Histogram queueing_delay;
+    Histogram run_time;
+  };
+
+  // Starts instrumenting tasks that are posted from now on. If `trace_events`
+  // is true, instrumented tasks also run within a TRACE_EVENT naming their
+  // task queue and location.
+  static void Enable(bool trace_events = false);
+  // Stops instrumenting newly posted tasks. Recorded stats are kept.
+  static void Disable();
+  static bool IsEnabled();
+
+  // Returns the stats of all task queue name and location pairs with
+  // samples, ordered by queue name and location.
+  static std::vector<TaskStats> GetStats();
+  // Discards all recorded samples.
+  static void Reset();
+
+  // For task queue implementations, called when posting a task. Returns
+  // `task` if instrumentation is disabled, or otherwise a task that runs
+  // `task` and records its samples. `delay` is the delay of a delayed task.
+  static absl::AnyInvocable<void() &&> Instrument(
+      absl::string_view queue_name,
+      const Location& location,
+      TimeDelta delay,
+      absl::AnyInvocable<void() &&> task);
+};
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_TASK_QUEUE_INSTRUMENTATION_H_
@@ -0,0 +1,118 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/task_queue_instrumentation.h"
+
+#include <memory>
+#include <vector>
+
+#include "api/units/time_delta.h"
+#include "rtc_base/event.h"
+#include "rtc_base/thread.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::Field;
+using ::testing::HasSubstr;
+using ::testing::IsEmpty;
+using ::testing::UnorderedElementsAre;
+
+class TaskQueueInstrumentationTest : public ::testing::Test {
+ protected:
+  TaskQueueInstrumentationTest() { TaskQueueInstrumentation::Reset(); }
+  ~TaskQueueInstrumentationTest() override {
+    TaskQueueInstrumentation::Disable();
+    TaskQueueInstrumentation::Reset();
+  }
+};
+
+TEST(TaskQueueInstrumentationHistogramTest, BucketsByPowersOfTwo) {
+  TaskQueueInstrumentation::Histogram histogram;
+  histogram.Add(TimeDelta::Zero());
+  histogram.Add(TimeDelta::Micros(1));
+  histogram.Add(TimeDelta::Micros(3));
+  histogram.Add(TimeDelta::Micros(4));
+  histogram.Add(TimeDelta::Seconds(100));
+  EXPECT_EQ(histogram.buckets[0], 1);
+  EXPECT_EQ(histogram.buckets[1], 1);
+  EXPECT_EQ(histogram.buckets[2], 1);
+  EXPECT_EQ(histogram.buckets[3], 1);
+  EXPECT_EQ(histogram.buckets.back(), 1);
+  EXPECT_EQ(histogram.num_samples, 5);
+  EXPECT_EQ(histogram.sum, TimeDelta::Seconds(100) + TimeDelta::Micros(8));
+  EXPECT_EQ(histogram.max, TimeDelta::Seconds(100));
+}
+
+TEST_F(TaskQueueInstrumentationTest, DoesNotRecordWhenDisabled) {
+  std::unique_ptr<rtc::Thread> thread = rtc::Thread::Create();
+  thread->SetName("instrumented", nullptr);
+  thread->Start();
+  rtc::Event done;
+  thread->PostTask([&] { done.Set(); });
+  ASSERT_TRUE(done.Wait(TimeDelta::Seconds(5)));
+  thread->Stop();
+  EXPECT_THAT(TaskQueueInstrumentation::GetStats(), IsEmpty());
+}
+
+TEST_F(TaskQueueInstrumentationTest, RecordsTasksPerQueueAndLocation) {
+  TaskQueueInstrumentation::Enable();
+  std::unique_ptr<rtc::Thread> thread = rtc::Thread::Create();
+  thread->SetName("instrumented", nullptr);
+  thread->Start();
+  rtc::Event done;
+  thread->PostTask([] {});
+  thread->PostTask([] {});
+  thread->PostDelayedTask([&] { done.Set(); }, TimeDelta::Millis(1));
+  ASSERT_TRUE(done.Wait(TimeDelta::Seconds(5)));
+  thread->Stop();
+
+  std::vector<TaskQueueInstrumentation::TaskStats> stats =
+      TaskQueueInstrumentation::GetStats();
+  ASSERT_EQ(stats.size(), 3u);
+  for (const TaskQueueInstrumentation::TaskStats& task_stats : stats) {
+    EXPECT_EQ(task_stats.queue_name, "instrumented");
+    EXPECT_THAT(task_stats.location,
+                HasSubstr("task_queue_instrumentation_unittest.cc:"));
+    EXPECT_EQ(task_stats.queueing_delay.num_samples, 1);
+    EXPECT_EQ(task_stats.run_time.num_samples, 1);
+  }
+
+  TaskQueueInstrumentation::Reset();
+  EXPECT_THAT(TaskQueueInstrumentation::GetStats(), IsEmpty());
+}
+
+TEST_F(TaskQueueInstrumentationTest, AggregatesTasksPostedFromOneLocation) {
+  TaskQueueInstrumentation::Enable(/*trace_events=*/true);
+  std::unique_ptr<rtc::Thread> thread = rtc::Thread::Create();
+  thread->SetName("instrumented", nullptr);
+  thread->Start();
+  rtc::Event done;
+  for (int i = 0; i < 10; ++i) {
+    thread->PostTask([&done, i] {
+      if (i == 9) {
+        done.Set();
+      }
+    });
+  }
+  ASSERT_TRUE(done.Wait(TimeDelta::Seconds(5)));
+  thread->Stop();
+
+  EXPECT_THAT(
+      TaskQueueInstrumentation::GetStats(),
+      UnorderedElementsAre(Field(
+          &TaskQueueInstrumentation::TaskStats::run_time,
+          Field(&TaskQueueInstrumentation::Histogram::num_samples, 10))));
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -20,6 +20,7 @@
 
 #include <list>
 #include <memory>
+#include <string>
 #include <type_traits>
 #include <utility>
 
@@ -34,6 +35,7 @@
 #include "rtc_base/platform_thread.h"
 #include "rtc_base/platform_thread_types.h"
 #include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/task_queue_instrumentation.h"
 #include "rtc_base/thread_annotations.h"
 #include "rtc_base/time_utils.h"
 #include "third_party/libevent/event.h"
@@ -120,6 +122,8 @@ class TaskQueueLibevent final : public TaskQueueBase {
  private:
   struct TimerEvent;
 
+  // Queues `task` to run on the task queue's thread.
+  void Enqueue(absl::AnyInvocable<void() &&> task);
   void PostDelayedTaskOnTaskQueue(absl::AnyInvocable<void() &&> task,
                                   TimeDelta delay);
 
@@ -128,6 +132,7 @@ class TaskQueueLibevent final : public TaskQueueBase {
   static void OnWakeup(int socket, short flags, void* context);  // NOLINT
   static void RunTimer(int fd, short flags, void* context);      // NOLINT
 
+  const std::string name_;
   bool is_active_ = true;
   int wakeup_pipe_in_ = -1;
   int wakeup_pipe_out_ = -1;
@@ -153,7 +158,7 @@ struct TaskQueueLibevent::TimerEvent {
 
 TaskQueueLibevent::TaskQueueLibevent(absl::string_view queue_name,
                                      rtc::ThreadPriority priority)
-    : event_base_(event_base_new()) {
+    : name_(queue_name), event_base_(event_base_new()) {
   int fds[2];
   RTC_CHECK(pipe(fds) == 0);
   SetNonBlocking(fds[0]);
@@ -218,6 +223,12 @@ void TaskQueueLibevent::Delete() {
 void TaskQueueLibevent::PostTaskImpl(absl::AnyInvocable<void() &&> task,
                                      const PostTaskTraits& traits,
                                      const Location& location) {
+  Enqueue(TaskQueueInstrumentation::Instrument(name_, location,
+                                               TimeDelta::Zero(),
+                                               std::move(task)));
+}
+
+void TaskQueueLibevent::Enqueue(absl::AnyInvocable<void() &&> task) {
   {
     MutexLock lock(&pending_lock_);
     bool had_pending_tasks = !pending_.empty();
@@ -260,11 +271,13 @@ void TaskQueueLibevent::PostDelayedTaskImpl(absl::AnyInvocable<void() &&> task,
                                             TimeDelta delay,
                                             const PostDelayedTaskTraits& traits,
                                             const Location& location) {
+  task = TaskQueueInstrumentation::Instrument(name_, location, delay,
+                                              std::move(task));
   if (IsCurrent()) {
     PostDelayedTaskOnTaskQueue(std::move(task), delay);
   } else {
     int64_t posted_us = rtc::TimeMicros();
-    PostTask([posted_us, delay, task = std::move(task), this]() mutable {
+    Enqueue([posted_us, delay, task = std::move(task), this]() mutable {
       // Compensate for the time that has passed since the posting.
       TimeDelta post_time = TimeDelta::Micros(rtc::TimeMicros() - posted_us);
       PostDelayedTaskOnTaskQueue(
@@ -13,9 +13,10 @@
 #include <string.h>
 
 #include <algorithm>
-#include <map>
+#include <atomic>
 #include <memory>
 #include <queue>
+#include <string>
 #include <utility>
 
 #include "absl/functional/any_invocable.h"
@@ -25,11 +26,14 @@
 #include "rtc_base/checks.h"
 #include "rtc_base/event.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/mpsc_queue.h"
 #include "rtc_base/numerics/divide_round.h"
 #include "rtc_base/platform_thread.h"
 #include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/task_queue_instrumentation.h"
 #include "rtc_base/thread_annotations.h"
 #include "rtc_base/time_utils.h"
+#include "rtc_base/timer_wheel.h"
 
 namespace webrtc {
 namespace {
@@ -65,16 +69,9 @@ class TaskQueueStdlib final : public TaskQueueBase {
  private:
   using OrderId = uint64_t;
 
-  struct DelayedEntryTimeout {
-    // TODO(bugs.webrtc.org/13756): Migrate to Timestamp.
-    int64_t next_fire_at_us{};
-    OrderId order{};
-
-    bool operator<(const DelayedEntryTimeout& o) const {
-      return std::tie(next_fire_at_us, order) <
-             std::tie(o.next_fire_at_us, o.order);
-    }
-  };
+  // Low precision delayed tasks are coalesced to fire together, as permitted
+  // by TaskQueueBase::DelayPrecision::kLow.
+  static constexpr int64_t kLowPrecisionLeewayMs = 16;
 
   struct NextTask {
     bool final_task = false;
@@ -92,30 +89,38 @@ class TaskQueueStdlib final : public TaskQueueBase {
 
   void NotifyWake();
 
+  const std::string name_;
+
   // Signaled whenever a new task is pending.
   rtc::Event flag_notify_;
 
-  Mutex pending_lock_;
-
-  // Indicates if the worker thread needs to shutdown now.
-  bool thread_should_quit_ RTC_GUARDED_BY(pending_lock_) = false;
+  // Set by the worker thread before it waits on `flag_notify_`. Immediate
+  // tasks only need to signal `flag_notify_` if it's set.
+  std::atomic<bool> waiting_{false};
 
   // Holds the next order to use for the next task to be
   // put into one of the pending queues.
-  OrderId thread_posting_order_ RTC_GUARDED_BY(pending_lock_) = 0;
+  std::atomic<OrderId> thread_posting_order_{0};
+
+  // Immediate tasks posted from any thread, moved to `pending_queue_` by the
+  // worker thread.
+  MpscQueue<std::pair<OrderId, absl::AnyInvocable<void() &&>>> incoming_queue_;
 
   // The list of all pending tasks that need to be processed in the
-  // FIFO queue ordering on the worker thread.
-  std::queue<std::pair<OrderId, absl::AnyInvocable<void() &&>>> pending_queue_
-      RTC_GUARDED_BY(pending_lock_);
+  // FIFO queue ordering on the worker thread. Only accessed on the worker
+  // thread.
+  std::queue<std::pair<OrderId, absl::AnyInvocable<void() &&>>> pending_queue_;
+
+  Mutex pending_lock_;
+
+  // Indicates if the worker thread needs to shutdown now.
+  bool thread_should_quit_ RTC_GUARDED_BY(pending_lock_) = false;
 
   // The list of all pending tasks that need to be processed at a future
   // time based upon a delay. On the off change the delayed task should
   // happen at exactly the same time interval as another task then the
-  // task is processed based on FIFO ordering. std::priority_queue was
-  // considered but rejected due to its inability to extract the
-  // move-only value out of the queue without the presence of a hack.
-  std::map<DelayedEntryTimeout, absl::AnyInvocable<void() &&>> delayed_queue_
+  // task is processed based on FIFO ordering.
+  TimerWheel<absl::AnyInvocable<void() &&>> delayed_queue_
       RTC_GUARDED_BY(pending_lock_);
 
   // Contains the active worker thread assigned to processing
@@ -127,7 +132,8 @@ class TaskQueueStdlib final : public TaskQueueBase {
 
 TaskQueueStdlib::TaskQueueStdlib(absl::string_view queue_name,
                                  rtc::ThreadPriority priority)
-    : flag_notify_(/*manual_reset=*/false, /*initially_signaled=*/false),
+    : name_(queue_name),
+      flag_notify_(/*manual_reset=*/false, /*initially_signaled=*/false),
       thread_(InitializeThread(this, queue_name, priority)) {}
 
 // static
@@ -163,26 +169,36 @@ void TaskQueueStdlib::Delete() {
 void TaskQueueStdlib::PostTaskImpl(absl::AnyInvocable<void() &&> task,
                                    const PostTaskTraits& traits,
                                    const Location& location) {
-  {
-    MutexLock lock(&pending_lock_);
-    pending_queue_.push(
-        std::make_pair(++thread_posting_order_, std::move(task)));
+  incoming_queue_.Push(std::make_pair(
+      thread_posting_order_.fetch_add(1) + 1,
+      TaskQueueInstrumentation::Instrument(name_, location, TimeDelta::Zero(),
+                                           std::move(task))));
+
+  // Only wake up the worker thread if it's waiting, or about to. Otherwise it
+  // finds the task before it waits.
+  if (waiting_.exchange(false)) {
+    NotifyWake();
   }
-
-  NotifyWake();
 }
 
 void TaskQueueStdlib::PostDelayedTaskImpl(absl::AnyInvocable<void() &&> task,
                                           TimeDelta delay,
                                           const PostDelayedTaskTraits& traits,
                                           const Location& location) {
-  DelayedEntryTimeout delayed_entry;
-  delayed_entry.next_fire_at_us = rtc::TimeMicros() + delay.us();
+  task = TaskQueueInstrumentation::Instrument(name_, location, delay,
+                                              std::move(task));
+  const int64_t now_ms = rtc::TimeMillis();
+  int64_t fire_at_ms = now_ms + delay.RoundUpTo(TimeDelta::Millis(1)).ms();
+  if (!traits.high_precision) {
+    fire_at_ms = TimerWheel<absl::AnyInvocable<void() &&>>::CoalesceFireTime(
+        fire_at_ms, kLowPrecisionLeewayMs);
+  }
 
   {
     MutexLock lock(&pending_lock_);
-    delayed_entry.order = ++thread_posting_order_;
-    delayed_queue_[delayed_entry] = std::move(task);
+    delayed_queue_.Insert(now_ms, fire_at_ms,
+                          thread_posting_order_.fetch_add(1) + 1,
+                          std::move(task));
   }
 
   NotifyWake();
@@ -191,7 +207,13 @@ void TaskQueueStdlib::PostDelayedTaskImpl(absl::AnyInvocable<void() &&> task,
 TaskQueueStdlib::NextTask TaskQueueStdlib::GetNextTask() {
   NextTask result;
 
+  while (absl::optional<std::pair<OrderId, absl::AnyInvocable<void() &&>>>
+             entry = incoming_queue_.Pop()) {
+    pending_queue_.push(*std::move(entry));
+  }
+
   const int64_t tick_us = rtc::TimeMicros();
+  const int64_t tick_ms = tick_us / 1'000;
 
   MutexLock lock(&pending_lock_);
 
@@ -200,29 +222,26 @@ TaskQueueStdlib::NextTask TaskQueueStdlib::GetNextTask() {
     return result;
   }
 
-  if (delayed_queue_.size() > 0) {
-    auto delayed_entry = delayed_queue_.begin();
-    const auto& delay_info = delayed_entry->first;
-    auto& delay_run = delayed_entry->second;
-    if (tick_us >= delay_info.next_fire_at_us) {
+  if (!delayed_queue_.empty()) {
+    delayed_queue_.Advance(tick_ms);
+    if (delayed_queue_.HasExpired()) {
       if (pending_queue_.size() > 0) {
         auto& entry = pending_queue_.front();
         auto& entry_order = entry.first;
         auto& entry_run = entry.second;
-        if (entry_order < delay_info.order) {
+        if (entry_order < delayed_queue_.NextExpiredKey().order) {
           result.run_task = std::move(entry_run);
           pending_queue_.pop();
           return result;
         }
       }
 
-      result.run_task = std::move(delay_run);
-      delayed_queue_.erase(delayed_entry);
+      result.run_task = delayed_queue_.PopExpired();
       return result;
     }
 
     result.sleep_time = TimeDelta::Millis(
-        DivideRoundUp(delay_info.next_fire_at_us - tick_us, 1'000));
+        DivideRoundUp(*delayed_queue_.NextWakeUpMs() * 1'000 - tick_us, 1'000));
   }
 
   if (pending_queue_.size() > 0) {
@@ -249,21 +268,21 @@ void TaskQueueStdlib::ProcessTasks() {
       continue;
     }
 
-    flag_notify_.Wait(task.sleep_time);
+    // Announce the wait before checking for new immediate tasks one last
+    // time. Both are sequentially consistent, so that either the check finds
+    // a task posted concurrently, or the poster sees `waiting_` and wakes up
+    // the thread.
+    waiting_.store(true);
+    if (incoming_queue_.empty()) {
+      flag_notify_.Wait(task.sleep_time);
+    }
+    waiting_.store(false, std::memory_order_relaxed);
   }
 
   // Ensure remaining deleted tasks are destroyed with Current() set up to this
   // task queue.
-  std::queue<std::pair<OrderId, absl::AnyInvocable<void() &&>>> pending_queue;
-  {
-    MutexLock lock(&pending_lock_);
-    pending_queue_.swap(pending_queue);
-  }
-  pending_queue = {};
-#if RTC_DCHECK_IS_ON
-  MutexLock lock(&pending_lock_);
-  RTC_DCHECK(pending_queue_.empty());
-#endif
+  incoming_queue_.Clear();
+  pending_queue_ = {};
 }
 
 void TaskQueueStdlib::NotifyWake() {
@@ -277,8 +296,10 @@ void TaskQueueStdlib::NotifyWake() {
   // wait on flag_notify_ until signaled that a task has been added (or the
   // thread to be told to shutdown).
 
-  // In all cases, when a new immediate task, delayed task, or request to
-  // shutdown the thread is added the flag_notify_ is signaled after. If the
+  // When a new delayed task or request to shutdown the thread is added the
+  // flag_notify_ is signaled after. The same goes for a new immediate task if
+  // the thread announced that it's about to wait; otherwise the thread picks
+  // up the task before it waits, and signaling can be skipped. If the
   // thread was waiting then the thread will wake up immediately and re-assess
   // what task needs to be run next (i.e. run a task now, wait for the nearest
   // timed delayed task, or shutdown the thread). If the thread was not waiting
@@ -0,0 +1,495 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/task_queue_thread_pool.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/base/attributes.h"
+#include "absl/functional/any_invocable.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "api/scoped_refptr.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/units/time_delta.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/ref_counter.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/task_queue_instrumentation.h"
+#include "rtc_base/thread_annotations.h"
+#include "rtc_base/time_utils.h"
+#include "rtc_base/timer_wheel.h"
+
+namespace webrtc {
+namespace {
+
+// Runnable queues are kept in one list per priority, highest first.
+constexpr int kNumPriorities = 3;
+
+// Number of tasks a worker runs from a task queue before it moves on to other
+// runnable task queues.
+constexpr int kMaxTasksPerSlice = 8;
+
+// Low precision delayed tasks are coalesced to fire together, as permitted
+// by TaskQueueBase::DelayPrecision::kLow.
+constexpr int64_t kLowPrecisionLeewayMs = 16;
+
+int PriorityIndex(TaskQueueFactory::Priority priority) {
+  switch (priority) {
+    case TaskQueueFactory::Priority::HIGH:
+      return 0;
+    case TaskQueueFactory::Priority::NORMAL:
+      return 1;
+    case TaskQueueFactory::Priority::LOW:
+      return 2;
+  }
+}
+
+class ThreadPool;
+
+class PooledTaskQueue final : public TaskQueueBase {
+ public:
+  PooledTaskQueue(ThreadPool* pool,
+                  absl::string_view name,
+                  int priority_index)
+      : pool_(pool), name_(name), priority_index_(priority_index) {}
+
+  void AddRef() const { ref_count_.IncRef(); }
+  void Release() const {
+    if (ref_count_.DecRef() == rtc::RefCountReleaseStatus::kDroppedLastRef) {
+      delete this;
+    }
+  }
+
+  void Delete() override;
+
+  int priority_index() const { return priority_index_; }
+
+  // Called by a worker thread of the pool. Runs up to `kMaxTasksPerSlice`
+  // tasks and returns true if the queue should be scheduled again.
+  bool RunTasks();
+
+  // Queues a task, scheduling the queue to run if it wasn't already.
+  void Enqueue(absl::AnyInvocable<void() &&> task);
+
+ protected:
+  void PostTaskImpl(absl::AnyInvocable<void() &&> task,
+                    const PostTaskTraits& traits,
+                    const Location& location) override {
+    Enqueue(TaskQueueInstrumentation::Instrument(name_, location,
+                                                 TimeDelta::Zero(),
+                                                 std::move(task)));
+  }
+  void PostDelayedTaskImpl(absl::AnyInvocable<void() &&> task,
+                           TimeDelta delay,
+                           const PostDelayedTaskTraits& traits,
+                           const Location& location) override;
+
+ private:
+  ~PooledTaskQueue() override = default;
+
+  ThreadPool* const pool_;
+  const std::string name_;
+  const int priority_index_;
+  // The owner of the task queue holds one reference until Delete(). Others
+  // are held while the queue is runnable, and by its pending delayed tasks.
+  mutable webrtc_impl::RefCounter ref_count_{1};
+
+  Mutex mutex_;
+  std::queue<absl::AnyInvocable<void() &&>> tasks_ RTC_GUARDED_BY(mutex_);
+  // True while the queue is in a list of runnable queues, or being run.
+  bool scheduled_ RTC_GUARDED_BY(mutex_) = false;
+  bool running_task_ RTC_GUARDED_BY(mutex_) = false;
+  bool deleted_ RTC_GUARDED_BY(mutex_) = false;
+  // Signaled when the task running at the time of Delete() has completed.
+  rtc::Event task_done_;
+};
+
+class ThreadPool {
+ public:
+  explicit ThreadPool(int num_threads);
+  ~ThreadPool();
+
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> CreateTaskQueue(
+      absl::string_view name,
+      TaskQueueFactory::Priority priority);
+
+  // Makes `queue` runnable, taking a reference to it.
+  void Schedule(PooledTaskQueue* queue);
+
+  void PostDelayedTask(PooledTaskQueue* queue,
+                       absl::AnyInvocable<void() &&> task,
+                       TimeDelta delay,
+                       bool high_precision);
+
+  void OnQueueDeleted() { num_live_queues_.fetch_sub(1); }
+
+ private:
+  struct Worker {
+    Mutex mutex;
+    std::array<std::deque<PooledTaskQueue*>, kNumPriorities> runnable
+        RTC_GUARDED_BY(mutex);
+    rtc::Event wake_up;
+    rtc::PlatformThread thread;
+  };
+
+  struct DelayedTask {
+    rtc::scoped_refptr<PooledTaskQueue> queue;
+    absl::AnyInvocable<void() &&> task;
+  };
+
+  void RunWorker(int index);
+  // Takes the next queue to run for worker `index`, from its own list of
+  // runnable queues or, failing that, from the back of another worker's list.
+  PooledTaskQueue* NextRunnable(int index);
+  void PushRunnable(int index, PooledTaskQueue* queue);
+  void WakeUpIdleWorker();
+  void RunTimer();
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::atomic<uint32_t> next_worker_{0};
+  std::atomic<int> num_live_queues_{0};
+
+  Mutex idle_mutex_;
+  std::vector<int> idle_workers_ RTC_GUARDED_BY(idle_mutex_);
+  bool stop_ RTC_GUARDED_BY(idle_mutex_) = false;
+
+  Mutex timer_mutex_;
+  TimerWheel<DelayedTask> delayed_tasks_ RTC_GUARDED_BY(timer_mutex_);
+  uint64_t next_delayed_task_order_ RTC_GUARDED_BY(timer_mutex_) = 0;
+  bool stop_timer_ RTC_GUARDED_BY(timer_mutex_) = false;
+  rtc::Event timer_wake_up_;
+  rtc::PlatformThread timer_thread_;
+};
+
+// The pool and worker index of the current thread, if it's a worker thread.
+ABSL_CONST_INIT thread_local const ThreadPool* current_pool = nullptr;
+ABSL_CONST_INIT thread_local int current_worker_index = -1;
+
+void PooledTaskQueue::Delete() {
+  RTC_DCHECK(!IsCurrent());
+  std::queue<absl::AnyInvocable<void() &&>> tasks;
+  bool wait_for_running_task;
+  {
+    MutexLock lock(&mutex_);
+    deleted_ = true;
+    tasks_.swap(tasks);
+    wait_for_running_task = running_task_;
+  }
+  if (wait_for_running_task) {
+    task_done_.Wait(rtc::Event::kForever);
+  }
+  {
+    // Destroy the pending tasks with Current() set up to this task queue.
+    CurrentTaskQueueSetter set_current(this);
+    tasks = {};
+  }
+  pool_->OnQueueDeleted();
+  Release();
+}
+
+bool PooledTaskQueue::RunTasks() {
+  absl::AnyInvocable<void() &&> task;
+  for (int i = 0;; ++i) {
+    {
+      MutexLock lock(&mutex_);
+      if (running_task_) {
+        running_task_ = false;
+        if (deleted_) {
+          task_done_.Set();
+        }
+      }
+      if (deleted_ || tasks_.empty()) {
+        scheduled_ = false;
+        return false;
+      }
+      if (i == kMaxTasksPerSlice) {
+        return true;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop();
+      running_task_ = true;
+    }
+    CurrentTaskQueueSetter set_current(this);
+    std::move(task)();
+    // Destroy the task's captures before yielding Current().
+    task = nullptr;
+  }
+}
+
+void PooledTaskQueue::Enqueue(absl::AnyInvocable<void() &&> task) {
+  bool deleted;
+  bool schedule = false;
+  {
+    MutexLock lock(&mutex_);
+    deleted = deleted_;
+    if (!deleted) {
+      tasks_.push(std::move(task));
+      if (!scheduled_) {
+        scheduled_ = true;
+        schedule = true;
+      }
+    }
+  }
+  if (deleted) {
+    // Only delayed tasks that became due after Delete() end up here.
+    CurrentTaskQueueSetter set_current(this);
+    task = nullptr;
+    return;
+  }
+  if (schedule) {
+    pool_->Schedule(this);
+  }
+}
+
+void PooledTaskQueue::PostDelayedTaskImpl(absl::AnyInvocable<void() &&> task,
+                                          TimeDelta delay,
+                                          const PostDelayedTaskTraits& traits,
+                                          const Location& location) {
+  pool_->PostDelayedTask(this,
+                         TaskQueueInstrumentation::Instrument(
+                             name_, location, delay, std::move(task)),
+                         delay, traits.high_precision);
+}
+
+ThreadPool::ThreadPool(int num_threads) {
+  RTC_DCHECK_GT(num_threads, 0);
+  for (int i = 0; i < num_threads; ++i) {
+    workers_.push_back(std::make_unique<Worker>());
+  }
+  for (int i = 0; i < num_threads; ++i) {
+    workers_[i]->thread = rtc::PlatformThread::SpawnJoinable(
+        [this, i] { RunWorker(i); }, "TaskQueuePool" + std::to_string(i));
+  }
+  timer_thread_ = rtc::PlatformThread::SpawnJoinable([this] { RunTimer(); },
+                                                     "TaskQueuePoolTimer");
+}
+
+ThreadPool::~ThreadPool() {
+  RTC_DCHECK_EQ(num_live_queues_.load(), 0)
+      << "All task queues must be deleted before their factory.";
+  {
+    MutexLock lock(&idle_mutex_);
+    stop_ = true;
+  }
+  for (auto& worker : workers_) {
+    worker->wake_up.Set();
+  }
+  for (auto& worker : workers_) {
+    worker->thread.Finalize();
+  }
+  {
+    MutexLock lock(&timer_mutex_);
+    stop_timer_ = true;
+  }
+  timer_wake_up_.Set();
+  timer_thread_.Finalize();
+
+  // Drop the references of whatever deleted task queues are still around.
+  {
+    MutexLock lock(&timer_mutex_);
+    delayed_tasks_.Clear();
+  }
+  for (auto& worker : workers_) {
+    MutexLock lock(&worker->mutex);
+    for (auto& runnable : worker->runnable) {
+      for (PooledTaskQueue* queue : runnable) {
+        queue->Release();
+      }
+      runnable.clear();
+    }
+  }
+}
+
+std::unique_ptr<TaskQueueBase, TaskQueueDeleter> ThreadPool::CreateTaskQueue(
+    absl::string_view name,
+    TaskQueueFactory::Priority priority) {
+  num_live_queues_.fetch_add(1);
+  return std::unique_ptr<TaskQueueBase, TaskQueueDeleter>(
+      new PooledTaskQueue(this, name, PriorityIndex(priority)));
+}
+
+void ThreadPool::Schedule(PooledTaskQueue* queue) {
+  queue->AddRef();
+  // Prefer the worker that made the queue runnable; its caches are warm.
+  const int index = current_pool == this
+                        ? current_worker_index
+                        : next_worker_.fetch_add(1) % workers_.size();
+  PushRunnable(index, queue);
+  WakeUpIdleWorker();
+}
+
+void ThreadPool::PushRunnable(int index, PooledTaskQueue* queue) {
+  Worker& worker = *workers_[index];
+  MutexLock lock(&worker.mutex);
+  worker.runnable[queue->priority_index()].push_back(queue);
+}
+
+PooledTaskQueue* ThreadPool::NextRunnable(int index) {
+  const int num_workers = static_cast<int>(workers_.size());
+  for (int priority = 0; priority < kNumPriorities; ++priority) {
+    {
+      Worker& worker = *workers_[index];
+      MutexLock lock(&worker.mutex);
+      std::deque<PooledTaskQueue*>& runnable = worker.runnable[priority];
+      if (!runnable.empty()) {
+        PooledTaskQueue* queue = runnable.front();
+        runnable.pop_front();
+        return queue;
+      }
+    }
+    for (int i = 1; i < num_workers; ++i) {
+      Worker& victim = *workers_[(index + i) % num_workers];
+      MutexLock lock(&victim.mutex);
+      std::deque<PooledTaskQueue*>& runnable = victim.runnable[priority];
+      if (!runnable.empty()) {
+        PooledTaskQueue* queue = runnable.back();
+        runnable.pop_back();
+        return queue;
+      }
+    }
+  }
+  return nullptr;
+}
+
+void ThreadPool::WakeUpIdleWorker() {
+  int index;
+  {
+    MutexLock lock(&idle_mutex_);
+    if (idle_workers_.empty()) {
+      return;
+    }
+    index = idle_workers_.back();
+    idle_workers_.pop_back();
+  }
+  workers_[index]->wake_up.Set();
+}
+
+void ThreadPool::RunWorker(int index) {
+  current_pool = this;
+  current_worker_index = index;
+  while (true) {
+    PooledTaskQueue* queue = NextRunnable(index);
+    if (!queue) {
+      {
+        MutexLock lock(&idle_mutex_);
+        if (stop_) {
+          break;
+        }
+        idle_workers_.push_back(index);
+      }
+      // Check again after registering as idle, so that a queue made runnable
+      // in between isn't left waiting for another wake up.
+      queue = NextRunnable(index);
+      if (!queue) {
+        workers_[index]->wake_up.Wait(rtc::Event::kForever);
+      }
+      MutexLock lock(&idle_mutex_);
+      idle_workers_.erase(
+          std::remove(idle_workers_.begin(), idle_workers_.end(), index),
+          idle_workers_.end());
+      if (!queue) {
+        continue;
+      }
+    }
+    if (queue->RunTasks()) {
+      // Let other runnable queues have a go before continuing with this one.
+      PushRunnable(index, queue);
+    } else {
+      queue->Release();
+    }
+  }
+  current_pool = nullptr;
+  current_worker_index = -1;
+}
+
+void ThreadPool::PostDelayedTask(PooledTaskQueue* queue,
+                                 absl::AnyInvocable<void() &&> task,
+                                 TimeDelta delay,
+                                 bool high_precision) {
+  const int64_t now_ms = rtc::TimeMillis();
+  int64_t fire_at_ms = now_ms + delay.RoundUpTo(TimeDelta::Millis(1)).ms();
+  if (!high_precision) {
+    fire_at_ms = TimerWheel<DelayedTask>::CoalesceFireTime(
+        fire_at_ms, kLowPrecisionLeewayMs);
+  }
+  {
+    MutexLock lock(&timer_mutex_);
+    delayed_tasks_.Insert(
+        now_ms, fire_at_ms, ++next_delayed_task_order_,
+        {.queue = rtc::scoped_refptr<PooledTaskQueue>(queue),
+         .task = std::move(task)});
+  }
+  timer_wake_up_.Set();
+}
+
+void ThreadPool::RunTimer() {
+  std::vector<DelayedTask> expired;
+  while (true) {
+    TimeDelta wait = rtc::Event::kForever;
+    {
+      MutexLock lock(&timer_mutex_);
+      if (stop_timer_) {
+        break;
+      }
+      const int64_t now_ms = rtc::TimeMillis();
+      delayed_tasks_.Advance(now_ms);
+      while (delayed_tasks_.HasExpired()) {
+        expired.push_back(delayed_tasks_.PopExpired());
+      }
+      if (absl::optional<int64_t> next = delayed_tasks_.NextWakeUpMs()) {
+        wait = TimeDelta::Millis(*next - now_ms);
+      }
+    }
+    if (!expired.empty()) {
+      for (DelayedTask& delayed_task : expired) {
+        delayed_task.queue->Enqueue(std::move(delayed_task.task));
+      }
+      expired.clear();
+      continue;
+    }
+    timer_wake_up_.Wait(wait);
+  }
+}
+
+class TaskQueueThreadPoolFactory final : public TaskQueueFactory {
+ public:
+  explicit TaskQueueThreadPoolFactory(int num_threads) : pool_(num_threads) {}
+
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> CreateTaskQueue(
+      absl::string_view name,
+      Priority priority) const override {
+    return pool_.CreateTaskQueue(name, priority);
+  }
+
+ private:
+  mutable ThreadPool pool_;
+};
+
+}  // namespace
+
+std::unique_ptr<TaskQueueFactory> CreateTaskQueueThreadPoolFactory(
+    int num_threads) {
+  return std::make_unique<TaskQueueThreadPoolFactory>(num_threads);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,34 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_TASK_QUEUE_THREAD_POOL_H_
+#define RTC_BASE_TASK_QUEUE_THREAD_POOL_H_
+
+#include <memory>
+
+#include "api/task_queue/task_queue_factory.h"
+
+namespace webrtc {
+
+// Creates a TaskQueueFactory whose task queues share a fixed pool of
+// `num_threads` worker threads, instead of getting a thread each. Every task
+// queue remains sequential: its tasks run one at a time, in FIFO order, with
+// TaskQueueBase::Current() set to the queue. Task queues with pending tasks
+// are distributed over the workers, and idle workers steal work from busy
+// ones. Runnable task queues of higher priority are picked before those of
+// lower priority. Delayed tasks are handled by one additional timer thread.
+//
+// All task queues created by the factory must be deleted before the factory.
+std::unique_ptr<TaskQueueFactory> CreateTaskQueueThreadPoolFactory(
+    int num_threads);
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_TASK_QUEUE_THREAD_POOL_H_
@@ -0,0 +1,104 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/task_queue_thread_pool.h"
+
+#include <memory>
+#include <vector>
+
+#include "api/task_queue/task_queue_base.h"
+#include "api/task_queue/task_queue_test.h"
+#include "api/units/time_delta.h"
+#include "rtc_base/event.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+std::unique_ptr<TaskQueueFactory> CreateTaskQueueFactory(
+    const webrtc::FieldTrialsView*) {
+  return CreateTaskQueueThreadPoolFactory(/*num_threads=*/4);
+}
+
+INSTANTIATE_TEST_SUITE_P(TaskQueueThreadPool,
+                         TaskQueueTest,
+                         ::testing::Values(CreateTaskQueueFactory));
+
+TEST(TaskQueueThreadPoolTest, KeepsTasksOfEachQueueInOrder) {
+  constexpr int kNumQueues = 16;
+  constexpr int kNumTasks = 200;
+  std::unique_ptr<TaskQueueFactory> factory =
+      CreateTaskQueueThreadPoolFactory(/*num_threads=*/2);
+  std::vector<std::unique_ptr<TaskQueueBase, TaskQueueDeleter>> queues;
+  for (int i = 0; i < kNumQueues; ++i) {
+    queues.push_back(factory->CreateTaskQueue(
+        "queue", i % 2 ? TaskQueueFactory::Priority::HIGH
+                       : TaskQueueFactory::Priority::NORMAL));
+  }
+
+  Mutex mutex;
+  std::vector<std::vector<int>> executed(kNumQueues);
+  int num_not_current = 0;
+  rtc::Event done;
+  int remaining = kNumQueues * kNumTasks;
+  for (int task = 0; task < kNumTasks; ++task) {
+    for (int i = 0; i < kNumQueues; ++i) {
+      TaskQueueBase* queue = queues[i].get();
+      queue->PostTask([&, queue, i, task] {
+        MutexLock lock(&mutex);
+        if (!queue->IsCurrent()) {
+          ++num_not_current;
+        }
+        executed[i].push_back(task);
+        if (--remaining == 0) {
+          done.Set();
+        }
+      });
+    }
+  }
+  ASSERT_TRUE(done.Wait(TimeDelta::Seconds(10)));
+
+  MutexLock lock(&mutex);
+  EXPECT_EQ(num_not_current, 0);
+  for (int i = 0; i < kNumQueues; ++i) {
+    ASSERT_EQ(executed[i].size(), static_cast<size_t>(kNumTasks));
+    for (int task = 0; task < kNumTasks; ++task) {
+      EXPECT_EQ(executed[i][task], task);
+    }
+  }
+}
+
+TEST(TaskQueueThreadPoolTest, RunsQueuesConcurrently) {
+  std::unique_ptr<TaskQueueFactory> factory =
+      CreateTaskQueueThreadPoolFactory(/*num_threads=*/2);
+  auto queue1 =
+      factory->CreateTaskQueue("queue1", TaskQueueFactory::Priority::NORMAL);
+  auto queue2 =
+      factory->CreateTaskQueue("queue2", TaskQueueFactory::Priority::NORMAL);
+
+  // Each task blocks until the other one runs, which requires two workers.
+  rtc::Event started1;
+  rtc::Event started2;
+  rtc::Event done;
+  queue1->PostTask([&] {
+    started1.Set();
+    EXPECT_TRUE(started2.Wait(TimeDelta::Seconds(10)));
+  });
+  queue2->PostTask([&] {
+    started2.Set();
+    EXPECT_TRUE(started1.Wait(TimeDelta::Seconds(10)));
+    done.Set();
+  });
+  EXPECT_TRUE(done.Wait(TimeDelta::Seconds(10)));
+}
+
+}  // namespace
+}  // namespace webrtc
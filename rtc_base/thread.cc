@@ -35,13 +35,16 @@
 
 #include "absl/algorithm/container.h"
 #include "absl/cleanup/cleanup.h"
+#include "absl/types/optional.h"
 #include "api/sequence_checker.h"
+#include "rtc_base/blocking_call_instrumentation.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/event.h"
 #include "rtc_base/internal/default_socket_server.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/null_socket_server.h"
 #include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/task_queue_instrumentation.h"
 #include "rtc_base/time_utils.h"
 #include "rtc_base/trace_event.h"
 
@@ -363,8 +366,9 @@ void Thread::DoDestroy() {
   ThreadManager::Remove(this);
   // Clear.
   CurrentTaskQueueSetter set_current(this);
+  incoming_messages_.Clear();
   messages_ = {};
-  delayed_messages_ = {};
+  delayed_messages_.Clear();
 }
 
 SocketServer* Thread::socketserver() {
@@ -402,16 +406,20 @@ absl::AnyInvocable<void() &&> Thread::Get(int cmsWait) {
       // All queue operations need to be locked, but nothing else in this loop
       // can happen while holding the `mutex_`.
       MutexLock lock(&mutex_);
+      // Posted messages go first, so that delayed messages that have been
+      // triggered queue up behind the messages posted before them.
+      DrainIncomingMessages();
       // Check for delayed messages that have been triggered and calculate the
       // next trigger time.
-      while (!delayed_messages_.empty()) {
-        if (msCurrent < delayed_messages_.top().run_time_ms) {
-          cmsDelayNext =
-              TimeDiff(delayed_messages_.top().run_time_ms, msCurrent);
-          break;
+      if (!delayed_messages_.empty()) {
+        delayed_messages_.Advance(msCurrent);
+        while (delayed_messages_.HasExpired()) {
+          messages_.push(delayed_messages_.PopExpired());
+        }
+        absl::optional<int64_t> next = delayed_messages_.NextWakeUpMs();
+        if (next) {
+          cmsDelayNext = TimeDiff(*next, msCurrent);
         }
-        messages_.push(std::move(delayed_messages_.top().functor));
-        delayed_messages_.pop();
       }
       // Pull a message off the message queue, if available.
       if (!messages_.empty()) {
@@ -419,6 +427,15 @@ absl::AnyInvocable<void() &&> Thread::Get(int cmsWait) {
         messages_.pop();
         return task;
       }
+      // Nothing to do. Announce that posting needs to wake up the socket
+      // server before checking for new messages one last time. Both are
+      // sequentially consistent, so that either the check finds a message
+      // posted concurrently, or the poster sees the flag.
+      waiting_for_messages_.store(true);
+      if (!incoming_messages_.empty()) {
+        waiting_for_messages_.store(false, std::memory_order_relaxed);
+        continue;
+      }
     }
 
     if (IsQuitting())
@@ -437,9 +454,12 @@ absl::AnyInvocable<void() &&> Thread::Get(int cmsWait) {
 
     {
       // Wait and multiplex in the meantime
-      if (!ss_->Wait(cmsNext == kForever ? SocketServer::kForever
-                                         : webrtc::TimeDelta::Millis(cmsNext),
-                     /*process_io=*/true))
+      bool waited =
+          ss_->Wait(cmsNext == kForever ? SocketServer::kForever
+                                        : webrtc::TimeDelta::Millis(cmsNext),
+                    /*process_io=*/true);
+      waiting_for_messages_.store(false, std::memory_order_relaxed);
+      if (!waited)
         return nullptr;
     }
 
@@ -462,15 +482,13 @@ void Thread::PostTaskImpl(absl::AnyInvocable<void() &&> task,
     return;
   }
 
-  // Keep thread safe
-  // Add the message to the end of the queue
-  // Signal for the multiplexer to return
-
-  {
-    MutexLock lock(&mutex_);
-    messages_.push(std::move(task));
+  // Add the message to the end of the lock-free intake queue.
+  // Signal for the multiplexer to return, if it's waiting.
+  incoming_messages_.Push(webrtc::TaskQueueInstrumentation::Instrument(
+      name_, location, webrtc::TimeDelta::Zero(), std::move(task)));
+  if (waiting_for_messages_.exchange(false)) {
+    WakeUpSocketServer();
   }
-  WakeUpSocketServer();
 }
 
 void Thread::PostDelayedTaskImpl(absl::AnyInvocable<void() &&> task,
@@ -485,19 +503,15 @@ void Thread::PostDelayedTaskImpl(absl::AnyInvocable<void() &&> task,
   // Add to the priority queue. Gets sorted soonest first.
   // Signal for the multiplexer to return.
 
+  task = webrtc::TaskQueueInstrumentation::Instrument(name_, location, delay,
+                                                      std::move(task));
   int64_t delay_ms = delay.RoundUpTo(webrtc::TimeDelta::Millis(1)).ms<int>();
-  int64_t run_time_ms = TimeAfter(delay_ms);
+  int64_t now_ms = TimeMillis();
   {
     MutexLock lock(&mutex_);
-    delayed_messages_.push({.delay_ms = delay_ms,
-                            .run_time_ms = run_time_ms,
-                            .message_number = delayed_next_num_,
-                            .functor = std::move(task)});
-    // If this message queue processes 1 message every millisecond for 50 days,
-    // we will wrap this number.  Even then, only messages with identical times
-    // will be misordered, and then only briefly.  This is probably ok.
+    delayed_messages_.Insert(now_ms, now_ms + delay_ms, delayed_next_num_,
+                             std::move(task));
     ++delayed_next_num_;
-    RTC_DCHECK_NE(0, delayed_next_num_);
   }
   WakeUpSocketServer();
 }
@@ -505,11 +519,11 @@ void Thread::PostDelayedTaskImpl(absl::AnyInvocable<void() &&> task,
 int Thread::GetDelay() {
   MutexLock lock(&mutex_);
 
-  if (!messages_.empty())
+  if (!messages_.empty() || !incoming_messages_.empty())
     return 0;
 
-  if (!delayed_messages_.empty()) {
-    int delay = TimeUntil(delayed_messages_.top().run_time_ms);
+  if (absl::optional<int64_t> next = delayed_messages_.NextWakeUpMs()) {
+    int delay = TimeUntil(*next);
     if (delay < 0)
       delay = 0;
     return delay;
@@ -518,6 +532,13 @@ int Thread::GetDelay() {
   return kForever;
 }
 
+void Thread::DrainIncomingMessages() {
+  while (absl::optional<absl::AnyInvocable<void() &&>> task =
+             incoming_messages_.Pop()) {
+    messages_.push(*std::move(task));
+  }
+}
+
 void Thread::Dispatch(absl::AnyInvocable<void() &&> task) {
   TRACE_EVENT0("webrtc", "Thread::Dispatch");
   RTC_DCHECK_RUN_ON(this);
@@ -752,10 +773,29 @@ void Thread::BlockingCallImpl(rtc::FunctionView<void()> functor,
   }
 #endif
 
+  bool trace_event = false;
+  const bool record =
+      webrtc::BlockingCallInstrumentation::ShouldRecord(trace_event);
+  const int64_t start_us = record ? TimeMicros() : 0;
+
   Event done;
   absl::Cleanup cleanup = [&done] { done.Set(); };
   PostTask([functor, cleanup = std::move(cleanup)] { functor(); });
-  done.Wait(Event::kForever);
+  if (trace_event) {
+    TRACE_EVENT2("webrtc", "Thread::BlockingCall::Wait", "callee",
+                 name().c_str(), "location", location.file_name());
+    done.Wait(Event::kForever);
+  } else {
+    done.Wait(Event::kForever);
+  }
+
+  if (record) {
+    Thread* current_thread = Thread::Current();
+    webrtc::BlockingCallInstrumentation::Record(
+        current_thread ? absl::string_view(current_thread->name())
+                       : absl::string_view("unknown"),
+        name(), location, webrtc::TimeDelta::Micros(TimeMicros() - start_us));
+  }
 }
 
 // Called by the ThreadManager when being set as the current thread.
@@ -13,6 +13,7 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <list>
 #include <map>
 #include <memory>
@@ -35,11 +36,13 @@
 #include "api/task_queue/task_queue_base.h"
 #include "api/units/time_delta.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/mpsc_queue.h"
 #include "rtc_base/platform_thread_types.h"
 #include "rtc_base/socket_server.h"
 #include "rtc_base/synchronization/mutex.h"
 #include "rtc_base/system/rtc_export.h"
 #include "rtc_base/thread_annotations.h"
+#include "rtc_base/timer_wheel.h"
 
 #if defined(WEBRTC_WIN)
 #include "rtc_base/win32.h"
@@ -268,7 +271,8 @@ class RTC_LOCKABLE RTC_EXPORT Thread : public webrtc::TaskQueueBase {
   bool empty() const { return size() == 0u; }
   size_t size() const {
     webrtc::MutexLock lock(&mutex_);
-    return messages_.size() + delayed_messages_.size();
+    return incoming_messages_.size() + messages_.size() +
+           delayed_messages_.size();
   }
 
   bool IsCurrent() const;
@@ -308,7 +312,8 @@ class RTC_LOCKABLE RTC_EXPORT Thread : public webrtc::TaskQueueBase {
   // NOTE: This function can only be called when synchronous calls are allowed.
   // See ScopedDisallowBlockingCalls for details.
   // NOTE: Blocking calls are DISCOURAGED, consider if what you're doing can
-  // be achieved with PostTask() and callbacks instead.
+  // be achieved with PostTask() and callbacks instead. Their cost in
+  // production can be measured with webrtc::BlockingCallInstrumentation.
   void BlockingCall(
       FunctionView<void()> functor,
       const webrtc::Location& location = webrtc::Location::Current()) {
@@ -394,26 +399,6 @@ class RTC_LOCKABLE RTC_EXPORT Thread : public webrtc::TaskQueueBase {
     rtc::Thread* const previous_;
   };
 
-  // DelayedMessage goes into a priority queue, sorted by trigger time. Messages
-  // with the same trigger time are processed in num_ (FIFO) order.
-  struct DelayedMessage {
-    bool operator<(const DelayedMessage& dmsg) const {
-      return (dmsg.run_time_ms < run_time_ms) ||
-             ((dmsg.run_time_ms == run_time_ms) &&
-              (dmsg.message_number < message_number));
-    }
-
-    int64_t delay_ms;  // for debugging
-    int64_t run_time_ms;
-    // Monotonicaly incrementing number used for ordering of messages
-    // targeted to execute at the same time.
-    uint32_t message_number;
-    // std::priority_queue doesn't allow to extract elements, but functor
-    // is move-only and thus need to be changed when pulled out of the
-    // priority queue. That is ok because `functor` doesn't affect operator<
-    mutable absl::AnyInvocable<void() &&> functor;
-  };
-
   // TaskQueueBase implementation.
   void PostTaskImpl(absl::AnyInvocable<void() &&> task,
                     const PostTaskTraits& traits,
@@ -485,9 +470,21 @@ class RTC_LOCKABLE RTC_EXPORT Thread : public webrtc::TaskQueueBase {
   // Called by the ThreadManager when being unset as the current thread.
   void ClearCurrentTaskQueue();
 
+  // Moves `incoming_messages_` to `messages_`.
+  void DrainIncomingMessages() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  // Immediate tasks posted from any thread. Posting doesn't take `mutex_`,
+  // which only serializes the consumer side of the queue.
+  webrtc::MpscQueue<absl::AnyInvocable<void() &&>> incoming_messages_;
+  // Set while Get() waits on the socket server, or is about to. Posting an
+  // immediate task only wakes up the socket server if it's set.
+  std::atomic<bool> waiting_for_messages_{false};
   std::queue<absl::AnyInvocable<void() &&>> messages_ RTC_GUARDED_BY(mutex_);
-  std::priority_queue<DelayedMessage> delayed_messages_ RTC_GUARDED_BY(mutex_);
-  uint32_t delayed_next_num_ RTC_GUARDED_BY(mutex_);
+  // Delayed messages, sorted by trigger time. Messages with the same trigger
+  // time are processed in `delayed_next_num_` (FIFO) order.
+  webrtc::TimerWheel<absl::AnyInvocable<void() &&>> delayed_messages_
+      RTC_GUARDED_BY(mutex_);
+  uint64_t delayed_next_num_ RTC_GUARDED_BY(mutex_);
 #if RTC_DCHECK_IS_ON
   uint32_t blocking_call_count_ RTC_GUARDED_BY(this) = 0;
   uint32_t could_be_blocking_call_count_ RTC_GUARDED_BY(this) = 0;
@@ -0,0 +1,283 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_TIMER_WHEEL_H_
+#define RTC_BASE_TIMER_WHEEL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <array>
+#include <utility>
+#include <vector>
+
+#include "absl/numeric/bits.h"
+#include "absl/types/optional.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+// Hierarchical timer wheel with millisecond ticks, used to hold the delayed
+// tasks of task queues. Inserting a timer and expiring it are O(1) amortized;
+// a timer is moved down at most once per level before it expires. Timer
+// storage is recycled, so a steady state of pending timers doesn't allocate.
+//
+// Every timer has a fire time and an order. Expired timers are handed out
+// sorted by (fire time, order), which keeps the FIFO semantics of timers
+// firing in the same millisecond.
+//
+// The wheel is not thread safe.
+template <typename T>
+class TimerWheel {
+ public:
+  struct Key {
+    int64_t fire_at_ms;
+    uint64_t order;
+  };
+
+  TimerWheel() { heads_.fill(-1); }
+  TimerWheel(const TimerWheel&) = delete;
+  TimerWheel& operator=(const TimerWheel&) = delete;
+
+  // Returns the time in [`fire_at_ms`, `fire_at_ms` + `leeway_ms`] at which a
+  // timer should fire so that it coalesces with other timers given the same
+  // leeway. Used for low precision timers.
+  static int64_t CoalesceFireTime(int64_t fire_at_ms, int64_t leeway_ms) {
+    if (leeway_ms <= 0) {
+      return fire_at_ms;
+    }
+    const int64_t granularity =
+        int64_t{1} << (absl::bit_width(static_cast<uint64_t>(leeway_ms + 1)) -
+                       1);
+    return (fire_at_ms + granularity - 1) / granularity * granularity;
+  }
+
+  bool empty() const { return size_ == 0; }
+  size_t size() const { return size_; }
+
+  // Adds a timer firing at `fire_at_ms`. `now_ms` is the current time.
+  void Insert(int64_t now_ms, int64_t fire_at_ms, uint64_t order, T value) {
+    if (empty() || now_ms < current_ms_) {
+      // Only the relative position of timers matters, which allows to follow
+      // the clock to wherever it is. Going backwards requires rebuilding the
+      // wheel, which is expected to only happen with simulated clocks.
+      Rebase(now_ms);
+    }
+    int32_t index;
+    if (free_.empty()) {
+      index = static_cast<int32_t>(nodes_.size());
+      nodes_.emplace_back();
+    } else {
+      index = free_.back();
+      free_.pop_back();
+    }
+    Node& node = nodes_[index];
+    node.key = {.fire_at_ms = fire_at_ms, .order = order};
+    node.value = std::move(value);
+    ++size_;
+    Place(index);
+  }
+
+  // Moves all timers firing at or before `now_ms` to the set of expired
+  // timers.
+  void Advance(int64_t now_ms) {
+    while (current_ms_ < now_ms) {
+      absl::optional<int64_t> next = NextEvent();
+      if (!next || *next > now_ms) {
+        current_ms_ = now_ms;
+        return;
+      }
+      current_ms_ = *next;
+      ProcessEvent();
+    }
+  }
+
+  // Returns true if there are expired timers. Requires a prior Advance().
+  bool HasExpired() const { return !expired_.empty(); }
+
+  // Key of the expired timer that should run first.
+  const Key& NextExpiredKey() const {
+    RTC_DCHECK(HasExpired());
+    return nodes_[expired_.front()].key;
+  }
+
+  // Removes and returns the expired timer that should run first.
+  T PopExpired() {
+    RTC_DCHECK(HasExpired());
+    std::pop_heap(expired_.begin(), expired_.end(), ExpiresLater{&nodes_});
+    const int32_t index = expired_.back();
+    expired_.pop_back();
+    T value = std::move(nodes_[index].value);
+    nodes_[index].value = T();
+    free_.push_back(index);
+    --size_;
+    return value;
+  }
+
+  // Returns the earliest time at which Advance() may expire a timer, or
+  // nullopt if there are no pending timers. Timers far in the future are
+  // reported with the granularity of the wheel level they're in, so this can
+  // be earlier than the actual fire time of any timer, never later.
+  absl::optional<int64_t> NextWakeUpMs() const {
+    if (HasExpired()) {
+      return current_ms_;
+    }
+    return NextEvent();
+  }
+
+  // Destroys all timers. Timers may be inserted while their values are being
+  // destroyed.
+  void Clear() {
+    std::vector<Node> nodes = std::move(nodes_);
+    nodes_.clear();
+    free_.clear();
+    expired_.clear();
+    overflow_.clear();
+    heads_.fill(-1);
+    occupied_.fill(0);
+    size_ = 0;
+  }
+
+ private:
+  static constexpr int kBitsPerLevel = 6;
+  static constexpr int kSlotsPerLevel = 1 << kBitsPerLevel;
+  // Covers 2^36 ms, a bit more than two years. Timers that are further away
+  // are kept in an overflow list.
+  static constexpr int kNumLevels = 6;
+  static constexpr int kWheelBits = kBitsPerLevel * kNumLevels;
+
+  struct Node {
+    Key key = {};
+    int32_t next = -1;
+    T value;
+  };
+
+  // Heap order for `expired_`, earliest on top.
+  struct ExpiresLater {
+    bool operator()(int32_t a, int32_t b) const {
+      const Key& ka = (*nodes)[a].key;
+      const Key& kb = (*nodes)[b].key;
+      return ka.fire_at_ms != kb.fire_at_ms ? ka.fire_at_ms > kb.fire_at_ms
+                                            : ka.order > kb.order;
+    }
+    const std::vector<Node>* nodes;
+  };
+
+  static int Slot(int64_t time_ms, int level) {
+    return static_cast<int>((time_ms >> (level * kBitsPerLevel)) &
+                            (kSlotsPerLevel - 1));
+  }
+
+  // A timer is kept at the level of the most significant base-64 digit in
+  // which its fire time differs from `current_ms_`, in the slot given by its
+  // own digit at that level. Hence all occupied slots of a level come after
+  // the slot of `current_ms_`.
+  void Place(int32_t index) {
+    const int64_t fire_at_ms = nodes_[index].key.fire_at_ms;
+    if (fire_at_ms <= current_ms_) {
+      expired_.push_back(index);
+      std::push_heap(expired_.begin(), expired_.end(), ExpiresLater{&nodes_});
+      return;
+    }
+    const int level =
+        (absl::bit_width(static_cast<uint64_t>(fire_at_ms ^ current_ms_)) - 1) /
+        kBitsPerLevel;
+    if (level >= kNumLevels) {
+      overflow_.push_back(index);
+      return;
+    }
+    const int slot = Slot(fire_at_ms, level);
+    int32_t& head = heads_[level * kSlotsPerLevel + slot];
+    nodes_[index].next = head;
+    head = index;
+    occupied_[level] |= uint64_t{1} << slot;
+  }
+
+  // Returns the next time at which timers need to be moved, or nullopt if
+  // there are no pending timers.
+  absl::optional<int64_t> NextEvent() const {
+    for (int level = 0; level < kNumLevels; ++level) {
+      if (occupied_[level] != 0) {
+        const int shift = level * kBitsPerLevel;
+        const int64_t base = (current_ms_ >> (shift + kBitsPerLevel))
+                             << (shift + kBitsPerLevel);
+        return base | (int64_t{absl::countr_zero(occupied_[level])} << shift);
+      }
+    }
+    if (!overflow_.empty()) {
+      return ((current_ms_ >> kWheelBits) + 1) << kWheelBits;
+    }
+    return absl::nullopt;
+  }
+
+  // Moves timers of the slot reached at `current_ms_` down the wheel.
+  void ProcessEvent() {
+    for (int level = 0; level < kNumLevels; ++level) {
+      if (occupied_[level] == 0) {
+        continue;
+      }
+      const int slot = absl::countr_zero(occupied_[level]);
+      RTC_DCHECK_EQ(slot, Slot(current_ms_, level));
+      occupied_[level] &= ~(uint64_t{1} << slot);
+      int32_t index = std::exchange(heads_[level * kSlotsPerLevel + slot], -1);
+      while (index != -1) {
+        const int32_t next = nodes_[index].next;
+        Place(index);
+        index = next;
+      }
+      return;
+    }
+    std::vector<int32_t> overflow = std::move(overflow_);
+    overflow_.clear();
+    for (int32_t index : overflow) {
+      Place(index);
+    }
+  }
+
+  // Re-places all pending timers relative to `now_ms`.
+  void Rebase(int64_t now_ms) {
+    std::vector<int32_t> pending = std::move(overflow_);
+    overflow_.clear();
+    for (int level = 0; level < kNumLevels; ++level) {
+      while (occupied_[level] != 0) {
+        const int slot = absl::countr_zero(occupied_[level]);
+        occupied_[level] &= ~(uint64_t{1} << slot);
+        int32_t index = std::exchange(heads_[level * kSlotsPerLevel + slot], -1);
+        while (index != -1) {
+          pending.push_back(index);
+          index = nodes_[index].next;
+        }
+      }
+    }
+    current_ms_ = now_ms;
+    for (int32_t index : pending) {
+      Place(index);
+    }
+  }
+
+  int64_t current_ms_ = 0;
+  size_t size_ = 0;
+  std::vector<Node> nodes_;
+  // Indices of unused `nodes_`.
+  std::vector<int32_t> free_;
+  // Heap of indices of expired timers.
+  std::vector<int32_t> expired_;
+  // Indices of timers beyond the range of the wheel.
+  std::vector<int32_t> overflow_;
+  // Index of the first timer in each slot, linked through Node::next.
+  std::array<int32_t, kNumLevels * kSlotsPerLevel> heads_;
+  // Bit mask of non-empty slots per level.
+  std::array<uint64_t, kNumLevels> occupied_ = {};
+};
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_TIMER_WHEEL_H_
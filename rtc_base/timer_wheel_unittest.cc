@@ -0,0 +1,174 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/timer_wheel.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <map>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "rtc_base/random.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+using ::testing::Optional;
+
+std::vector<int> PopAllExpired(TimerWheel<int>& wheel) {
+  std::vector<int> values;
+  while (wheel.HasExpired()) {
+    values.push_back(wheel.PopExpired());
+  }
+  return values;
+}
+
+TEST(TimerWheelTest, ExpiresTimersInFireTimeOrder) {
+  TimerWheel<int> wheel;
+  wheel.Insert(/*now_ms=*/1000, /*fire_at_ms=*/1030, /*order=*/1, 30);
+  wheel.Insert(1000, 1010, 2, 10);
+  wheel.Insert(1000, 1020, 3, 20);
+  EXPECT_EQ(wheel.size(), 3u);
+
+  wheel.Advance(1009);
+  EXPECT_FALSE(wheel.HasExpired());
+  wheel.Advance(1025);
+  EXPECT_THAT(PopAllExpired(wheel), ElementsAre(10, 20));
+  wheel.Advance(1030);
+  EXPECT_THAT(PopAllExpired(wheel), ElementsAre(30));
+  EXPECT_TRUE(wheel.empty());
+}
+
+TEST(TimerWheelTest, TimersFiringAtTheSameTimeExpireInOrder) {
+  TimerWheel<int> wheel;
+  wheel.Insert(0, 5000, /*order=*/3, 3);
+  wheel.Insert(0, 5000, /*order=*/1, 1);
+  wheel.Insert(0, 5000, /*order=*/2, 2);
+  wheel.Advance(5000);
+  EXPECT_THAT(PopAllExpired(wheel), ElementsAre(1, 2, 3));
+}
+
+TEST(TimerWheelTest, TimersDueNowExpireImmediately) {
+  TimerWheel<int> wheel;
+  wheel.Insert(100, 100, 1, 1);
+  wheel.Insert(100, 50, 2, 2);
+  ASSERT_TRUE(wheel.HasExpired());
+  EXPECT_EQ(wheel.NextExpiredKey().fire_at_ms, 50);
+  EXPECT_THAT(PopAllExpired(wheel), ElementsAre(2, 1));
+}
+
+TEST(TimerWheelTest, NextWakeUpIsNeverLaterThanTheEarliestTimer) {
+  TimerWheel<int> wheel;
+  EXPECT_EQ(wheel.NextWakeUpMs(), absl::nullopt);
+  wheel.Insert(0, 10, 1, 1);
+  EXPECT_THAT(wheel.NextWakeUpMs(), Optional(10));
+
+  wheel.Insert(0, 100'000, 2, 2);
+  int64_t now = 10;
+  wheel.Advance(now);
+  EXPECT_THAT(PopAllExpired(wheel), ElementsAre(1));
+  int wake_ups = 0;
+  while (!wheel.HasExpired()) {
+    absl::optional<int64_t> wake_up = wheel.NextWakeUpMs();
+    ASSERT_TRUE(wake_up);
+    EXPECT_GT(*wake_up, now);
+    EXPECT_LE(*wake_up, 100'000);
+    now = *wake_up;
+    wheel.Advance(now);
+    ++wake_ups;
+  }
+  EXPECT_EQ(now, 100'000);
+  // One wake up per wheel level at most.
+  EXPECT_LE(wake_ups, 3);
+}
+
+TEST(TimerWheelTest, HandlesTimersBeyondTheWheelRange) {
+  TimerWheel<int> wheel;
+  const int64_t kFarAway = int64_t{1} << 40;
+  wheel.Insert(0, kFarAway, 1, 1);
+  wheel.Insert(0, 1, 2, 2);
+  wheel.Advance(kFarAway - 1);
+  EXPECT_THAT(PopAllExpired(wheel), ElementsAre(2));
+  wheel.Advance(kFarAway);
+  EXPECT_THAT(PopAllExpired(wheel), ElementsAre(1));
+}
+
+TEST(TimerWheelTest, FollowsClockGoingBackwards) {
+  TimerWheel<int> wheel;
+  wheel.Insert(1'000'000, 1'000'100, 1, 1);
+  wheel.Insert(/*now_ms=*/500, /*fire_at_ms=*/600, 2, 2);
+  wheel.Advance(600);
+  EXPECT_THAT(PopAllExpired(wheel), ElementsAre(2));
+  wheel.Advance(1'000'099);
+  EXPECT_THAT(PopAllExpired(wheel), IsEmpty());
+  wheel.Advance(1'000'100);
+  EXPECT_THAT(PopAllExpired(wheel), ElementsAre(1));
+}
+
+TEST(TimerWheelTest, ReusesStorageOfExpiredTimers) {
+  TimerWheel<int> wheel;
+  for (int i = 0; i < 100; ++i) {
+    wheel.Insert(i, i + 10, i, i);
+    wheel.Advance(i);
+    PopAllExpired(wheel);
+  }
+  wheel.Advance(200);
+  EXPECT_EQ(PopAllExpired(wheel).size(), 10u);
+  EXPECT_TRUE(wheel.empty());
+}
+
+TEST(TimerWheelTest, CoalescesWithinLeeway) {
+  EXPECT_EQ(TimerWheel<int>::CoalesceFireTime(1001, 0), 1001);
+  EXPECT_EQ(TimerWheel<int>::CoalesceFireTime(1001, 15), 1008);
+  EXPECT_EQ(TimerWheel<int>::CoalesceFireTime(1001, 16), 1008);
+  EXPECT_EQ(TimerWheel<int>::CoalesceFireTime(1009, 16), 1024);
+  EXPECT_EQ(TimerWheel<int>::CoalesceFireTime(1024, 16), 1024);
+  for (int64_t t = 0; t < 100; ++t) {
+    const int64_t coalesced = TimerWheel<int>::CoalesceFireTime(t, 17);
+    EXPECT_GE(coalesced, t);
+    EXPECT_LE(coalesced, t + 17);
+  }
+}
+
+TEST(TimerWheelTest, MatchesOrderedMapForRandomTimers) {
+  Random random(4711);
+  TimerWheel<int> wheel;
+  std::map<std::pair<int64_t, uint64_t>, int> reference;
+  int64_t now = 12345;
+  uint64_t order = 0;
+  for (int round = 0; round < 2000; ++round) {
+    const int num_inserts = random.Rand(0, 5);
+    for (int i = 0; i < num_inserts; ++i) {
+      const int64_t delay =
+          random.Rand(0, 1) ? random.Rand(0, 100) : random.Rand(0, 1'000'000);
+      wheel.Insert(now, now + delay, ++order, round * 10 + i);
+      reference[{now + delay, order}] = round * 10 + i;
+    }
+    now += random.Rand(0, 1) ? random.Rand(0, 10) : random.Rand(0, 100'000);
+    wheel.Advance(now);
+    std::vector<int> expected;
+    while (!reference.empty() && reference.begin()->first.first <= now) {
+      expected.push_back(reference.begin()->second);
+      reference.erase(reference.begin());
+    }
+    ASSERT_EQ(PopAllExpired(wheel), expected);
+    ASSERT_EQ(wheel.size(), reference.size());
+  }
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -1041,6 +1041,53 @@ TEST_F(VirtualSocketServerTest, SetSendingBlockedWithUdpSocket) {
   EXPECT_EQ(3, client1->SendTo("foo", 3, socket2->GetLocalAddress()));
 }
 
+class SentPacketCounter : public sigslot::has_slots<> {
+ public:
+  explicit SentPacketCounter(AsyncPacketSocket* socket) {
+    socket->SignalSentPacket.connect(this, &SentPacketCounter::OnSentPacket);
+  }
+  int count() const { return count_; }
+
+ private:
+  void OnSentPacket(AsyncPacketSocket*, const SentPacket&) { ++count_; }
+
+  int count_ = 0;
+};
+
+TEST_F(VirtualSocketServerTest, BatchablePacketsAreSentAtEndOfBatch) {
+  std::unique_ptr<AsyncUDPSocket> sender = absl::WrapUnique(
+      AsyncUDPSocket::Create(&ss_, SocketAddress("1.1.1.1", 5000)));
+  std::unique_ptr<Socket> receiver =
+      absl::WrapUnique(ss_.CreateSocket(AF_INET, SOCK_DGRAM));
+  receiver->Bind(SocketAddress("2.2.2.2", 5000));
+  auto client = std::make_unique<TestClient>(
+      std::make_unique<AsyncUDPSocket>(receiver.release()), &fake_clock_);
+  SentPacketCounter sent_packets(sender.get());
+
+  PacketOptions options;
+  options.batchable = true;
+  EXPECT_EQ(3, sender->SendTo("foo", 3, client->address(), options));
+  EXPECT_EQ(0, sent_packets.count());
+  options.last_packet_in_batch = true;
+  EXPECT_EQ(3, sender->SendTo("bar", 3, client->address(), options));
+  EXPECT_EQ(2, sent_packets.count());
+  EXPECT_TRUE(client->CheckNextPacket("foo", 3, nullptr));
+  EXPECT_TRUE(client->CheckNextPacket("bar", 3, nullptr));
+}
+
+TEST_F(VirtualSocketServerTest, UnterminatedBatchIsFlushedAfterCurrentTask) {
+  std::unique_ptr<AsyncUDPSocket> sender = absl::WrapUnique(
+      AsyncUDPSocket::Create(&ss_, SocketAddress("1.1.1.1", 5000)));
+  SentPacketCounter sent_packets(sender.get());
+
+  PacketOptions options;
+  options.batchable = true;
+  sender->SendTo("foo", 3, SocketAddress("2.2.2.2", 5000), options);
+  EXPECT_EQ(0, sent_packets.count());
+  ss_.ProcessMessagesUntilIdle();
+  EXPECT_EQ(1, sent_packets.count());
+}
+
 TEST_F(VirtualSocketServerTest, SetSendingBlockedWithTcpSocket) {
   constexpr size_t kBufferSize = 1024;
   ss_.set_send_buffer_capacity(kBufferSize);
@@ -12,22 +12,46 @@
  *  Create a server using: ./data_channel_benchmark --server --port 12345
  *  Start the flow of data from the server to a client using:
  *  ./data_channel_benchmark --port 12345 --transfer_size 100 --packet_size 8196
- *  The throughput is reported on the server console.
+ *  The throughput and latency are reported on the client console, and the CPU
+ *  usage of the sender on the server console.
+ *
+ *  The data can be sent over several concurrent data channels (--channels),
+ *  unordered (--ordered=false) and/or with partial reliability
+ *  (--max_retransmits). Several message sizes can be measured in one run by
+ *  giving a comma separated list to --packet_size.
+ *
+ *  Every message starts with the time it was sent, which the receiver uses to
+ *  compute the one-way latency. This requires the clocks of both hosts to be
+ *  synchronized, e.g. by running both peers on the same host. To measure on a
+ *  lossy network, use e.g. `tc qdisc add dev lo root netem loss 1% delay 50ms`.
  *
  *  The negotiation does not require a 3rd party server and is done over a gRPC
  *  transport. No TURN server is configured, so both peers need to be reachable
  *  using STUN only.
  */
 #include <inttypes.h>
+#include <string.h>
 
 #include <charconv>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include "absl/cleanup/cleanup.h"
 #include "absl/flags/flag.h"
 #include "absl/flags/parse.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "api/numerics/samples_stats_counter.h"
+#include "rtc_base/cpu_time.h"
 #include "rtc_base/event.h"
 #include "rtc_base/ssl_adapter.h"
+#include "rtc_base/string_encode.h"
+#include "rtc_base/string_to_number.h"
+#include "rtc_base/strings/string_builder.h"
+#include "rtc_base/synchronization/mutex.h"
 #include "rtc_base/thread.h"
+#include "rtc_base/time_utils.h"
 #include "rtc_tools/data_channel_benchmark/grpc_signaling.h"
 #include "rtc_tools/data_channel_benchmark/peer_connection_client.h"
 #include "system_wrappers/include/field_trial.h"
@@ -38,7 +62,18 @@ ABSL_FLAG(bool, oneshot, true, "Terminate after serving a client");
 ABSL_FLAG(std::string, address, "localhost", "Connect to server address");
 ABSL_FLAG(uint16_t, port, 0, "Connect to port (0 for random)");
 ABSL_FLAG(uint64_t, transfer_size, 2, "Transfer size (MiB)");
-ABSL_FLAG(uint64_t, packet_size, 256 * 1024, "Packet size");
+ABSL_FLAG(std::string,
+          packet_size,
+          "262144",
+          "Packet size, or a comma separated list of packet sizes to measure "
+          "one after the other");
+ABSL_FLAG(int, channels, 1, "Number of data channels to send data over");
+ABSL_FLAG(bool, ordered, true, "Send the data over ordered data channels");
+ABSL_FLAG(int,
+          max_retransmits,
+          -1,
+          "Maximum number of retransmissions of each message, or -1 for "
+          "reliable data channels");
 ABSL_FLAG(std::string,
           force_fieldtrials,
           "",
@@ -46,14 +81,30 @@ ABSL_FLAG(std::string,
           "E.g. running with --force_fieldtrials=WebRTC-FooFeature/Enable/"
           " will assign the group Enable to field trial WebRTC-FooFeature.");
 
+namespace {
+
+// Label of the data channel used to configure a transfer and to signal its
+// end. The data itself is sent over other data channels.
+constexpr char kControlLabel[] = "control";
+// Sent by the server on the control channel when all data has been sent.
+constexpr char kEndMessage[] = "end";
+// With partial reliability, not all data will be received. The transfer is
+// then considered finished when no data has been received for this long after
+// the server has sent all data.
+constexpr int64_t kUnreliableIdleTimeoutMs = 1000;
+
 struct SetupMessage {
   size_t packet_size;
   size_t transfer_size;
+  int channels = 1;
+  bool ordered = true;
+  int max_retransmits = -1;
 
-  std::string ToString() {
-    char buffer[64];
+  std::string ToString() const {
+    char buffer[128];
     rtc::SimpleStringBuilder sb(buffer);
-    sb << packet_size << "," << transfer_size;
+    sb << packet_size << "," << transfer_size << "," << channels << ","
+       << (ordered ? 1 : 0) << "," << max_retransmits;
 
     return sb.str();
   }
@@ -61,26 +112,126 @@ struct SetupMessage {
   static SetupMessage FromString(absl::string_view sv) {
     SetupMessage result;
     auto parameters = rtc::split(sv, ',');
-    std::from_chars(parameters[0].data(),
-                    parameters[0].data() + parameters[0].size(),
-                    result.packet_size, 10);
-    std::from_chars(parameters[1].data(),
-                    parameters[1].data() + parameters[1].size(),
-                    result.transfer_size, 10);
+    RTC_CHECK_EQ(parameters.size(), 5);
+    auto parse = [](absl::string_view s, auto& value) {
+      std::from_chars(s.data(), s.data() + s.size(), value, 10);
+    };
+    parse(parameters[0], result.packet_size);
+    parse(parameters[1], result.transfer_size);
+    parse(parameters[2], result.channels);
+    int ordered = 1;
+    parse(parameters[3], ordered);
+    result.ordered = ordered != 0;
+    parse(parameters[4], result.max_retransmits);
     return result;
   }
 };
 
+// Writes the current time at the beginning of `buffer`, to let the receiver
+// compute the one-way latency.
+void WriteSendTime(webrtc::DataBuffer& buffer) {
+  int64_t now_us = rtc::TimeUTCMicros();
+  if (buffer.size() >= sizeof(now_us)) {
+    memcpy(buffer.data.MutableData(), &now_us, sizeof(now_us));
+  }
+}
+
+absl::optional<int64_t> ReadSendTime(const webrtc::DataBuffer& buffer) {
+  int64_t send_time_us;
+  if (buffer.size() < sizeof(send_time_us)) {
+    return absl::nullopt;
+  }
+  memcpy(&send_time_us, buffer.data.cdata(), sizeof(send_time_us));
+  return send_time_us;
+}
+
+double CpuMsPerMiB(int64_t cpu_time_ns, size_t bytes) {
+  return bytes == 0 ? 0 : (cpu_time_ns / 1e6) / (bytes / 1024. / 1024.);
+}
+
+// Observes the control channel, on either side.
+class ControlChannelObserverImpl : public webrtc::DataChannelObserver {
+ public:
+  explicit ControlChannelObserverImpl(webrtc::DataChannelInterface* dc)
+      : dc_(dc) {}
+
+  void OnStateChange() override {
+    RTC_LOG(LS_INFO) << "Control channel state changed to " << dc_->state();
+    switch (dc_->state()) {
+      case webrtc::DataChannelInterface::DataState::kOpen:
+        open_event_.Set();
+        break;
+      case webrtc::DataChannelInterface::DataState::kClosed: {
+        webrtc::MutexLock lock(&mutex_);
+        closed_ = true;
+        message_event_.Set();
+        break;
+      }
+      default:
+        break;
+    }
+  }
+
+  void OnMessage(const webrtc::DataBuffer& buffer) override {
+    webrtc::MutexLock lock(&mutex_);
+    messages_.emplace_back(buffer.data.cdata<char>(), buffer.data.size());
+    message_event_.Set();
+  }
+
+  void OnBufferedAmountChange(uint64_t sent_data_size) override {}
+  bool IsOkToCallOnTheNetworkThread() override { return true; }
+
+  bool WaitForOpenState() { return open_event_.Wait(rtc::Event::kForever); }
+
+  // Returns the next received message, or nullopt if the channel was closed
+  // or no message was received within `timeout`.
+  absl::optional<std::string> WaitForMessage(webrtc::TimeDelta timeout) {
+    while (true) {
+      {
+        webrtc::MutexLock lock(&mutex_);
+        if (!messages_.empty()) {
+          std::string message = std::move(messages_.front());
+          messages_.erase(messages_.begin());
+          return message;
+        }
+        if (closed_) {
+          return absl::nullopt;
+        }
+      }
+      if (!message_event_.Wait(timeout)) {
+        return absl::nullopt;
+      }
+    }
+  }
+
+ private:
+  webrtc::DataChannelInterface* const dc_;
+  rtc::Event open_event_;
+  rtc::Event message_event_;
+  webrtc::Mutex mutex_;
+  std::vector<std::string> messages_ RTC_GUARDED_BY(mutex_);
+  bool closed_ RTC_GUARDED_BY(mutex_) = false;
+};
+
+// Sends `transfer_size` bytes in messages of `packet_size` bytes over a data
+// channel, as soon as it is open.
 class DataChannelServerObserverImpl : public webrtc::DataChannelObserver {
  public:
-  explicit DataChannelServerObserverImpl(webrtc::DataChannelInterface* dc,
-                                         rtc::Thread* signaling_thread)
-      : dc_(dc), signaling_thread_(signaling_thread) {}
+  DataChannelServerObserverImpl(webrtc::DataChannelInterface* dc,
+                                rtc::Thread* signaling_thread,
+                                size_t packet_size,
+                                size_t transfer_size)
+      : dc_(dc),
+        signaling_thread_(signaling_thread),
+        packet_size_(packet_size),
+        transfer_size_(transfer_size),
+        remaining_data_(transfer_size) {}
 
   void OnStateChange() override {
     RTC_LOG(LS_INFO) << "Server state changed to " << dc_->state();
     switch (dc_->state()) {
       case webrtc::DataChannelInterface::DataState::kOpen:
+        StartSending();
         break;
       case webrtc::DataChannelInterface::DataState::kClosed:
         closed_event_.Set();
@@ -90,20 +241,14 @@ class DataChannelServerObserverImpl : public webrtc::DataChannelObserver {
     }
   }
 
-  void OnMessage(const webrtc::DataBuffer& buffer) override {
-    if (!buffer.binary) {
-      std::string setup_message(buffer.data.cdata<char>(), buffer.data.size());
-      setup_ = SetupMessage::FromString(setup_message);
-      remaining_data_ = setup_.transfer_size;
-      setup_message_event_.Set();
-    }
-  }
+  void OnMessage(const webrtc::DataBuffer& buffer) override {}
 
   void OnBufferedAmountChange(uint64_t sent_data_size) override {
     remaining_data_ -= sent_data_size;
     // Allow the transport buffer to be drained before starting again.
     if (buffer_ && dc_->buffered_amount() <= ok_to_resume_sending_threshold_) {
       total_queued_up_ += buffer_->size();
+      WriteSendTime(*buffer_);
       dc_->SendAsync(*buffer_, [this, buffer = buffer_](webrtc::RTCError err) {
         OnSendAsyncComplete(err, buffer);
       });
@@ -115,25 +260,27 @@ class DataChannelServerObserverImpl : public webrtc::DataChannelObserver {
 
   bool WaitForClosedState() { return closed_event_.Wait(rtc::Event::kForever); }
 
-  bool WaitForSetupMessage() {
-    return setup_message_event_.Wait(rtc::Event::kForever);
+  bool WaitForAllDataSent() {
+    return all_sent_event_.Wait(rtc::Event::kForever);
   }
 
+ private:
   void StartSending() {
-    RTC_CHECK(remaining_data_) << "Error: no data to send";
-    std::string data(std::min(setup_.packet_size, remaining_data_), '0');
+    if (remaining_data_ == 0) {
+      all_sent_event_.Set();
+      return;
+    }
+    std::string data(std::min(packet_size_, remaining_data_), '0');
     webrtc::DataBuffer* data_buffer =
         new webrtc::DataBuffer(rtc::CopyOnWriteBuffer(data), true);
     total_queued_up_ = data_buffer->size();
+    WriteSendTime(*data_buffer);
     dc_->SendAsync(*data_buffer,
                    [this, data_buffer = data_buffer](webrtc::RTCError err) {
                      OnSendAsyncComplete(err, data_buffer);
                    });
   }
 
-  const struct SetupMessage& parameters() const { return setup_; }
-
- private:
   void OnSendAsyncComplete(webrtc::RTCError error, webrtc::DataBuffer* buffer) {
     total_queued_up_ -= buffer->size();
     if (!error.ok()) {
@@ -145,14 +292,19 @@ class DataChannelServerObserverImpl : public webrtc::DataChannelObserver {
     }
     signaling_thread_->PostTask([this, buffer = buffer,
                                  remaining_data = remaining_data_]() {
-      fprintf(stderr, "Progress: %zu / %zu (%zu%%)\n",
-              (setup_.transfer_size - remaining_data), setup_.transfer_size,
-              (100 - remaining_data * 100 / setup_.transfer_size));
+      size_t percent = 100 - remaining_data * 100 / transfer_size_;
+      if (percent != last_reported_percent_) {
+        last_reported_percent_ = percent;
+        fprintf(stderr, "Progress %s: %zu / %zu (%zu%%)\n",
+                dc_->label().c_str(), (transfer_size_ - remaining_data),
+                transfer_size_, percent);
+      }
 
       if (!remaining_data) {
         RTC_CHECK(!total_queued_up_);
         // We're done.
         delete buffer;
+        all_sent_event_.Set();
         return;
       }
 
@@ -161,6 +313,7 @@ class DataChannelServerObserverImpl : public webrtc::DataChannelObserver {
       }
 
       total_queued_up_ += buffer->size();
+      WriteSendTime(*buffer);
       dc_->SendAsync(*buffer, [this, buffer = buffer](webrtc::RTCError err) {
         OnSendAsyncComplete(err, buffer);
       });
@@ -169,58 +322,142 @@ class DataChannelServerObserverImpl : public webrtc::DataChannelObserver {
 
   webrtc::DataChannelInterface* const dc_;
   rtc::Thread* const signaling_thread_;
+  const size_t packet_size_;
+  const size_t transfer_size_;
   rtc::Event closed_event_;
-  rtc::Event setup_message_event_;
-  size_t remaining_data_ = 0u;
+  rtc::Event all_sent_event_;
+  size_t remaining_data_;
   size_t total_queued_up_ = 0u;
-  struct SetupMessage setup_;
+  size_t last_reported_percent_ = 0u;
   webrtc::DataBuffer* buffer_ = nullptr;
   const uint64_t ok_to_resume_sending_threshold_ =
       webrtc::DataChannelInterface::MaxSendQueueSize() / 2;
 };
 
-class DataChannelClientObserverImpl : public webrtc::DataChannelObserver {
+// Statistics of the data received over all data channels of a transfer.
+class ReceiveStats {
  public:
-  explicit DataChannelClientObserverImpl(webrtc::DataChannelInterface* dc,
-                                         uint64_t bytes_received_threshold)
-      : dc_(dc), bytes_received_threshold_(bytes_received_threshold) {}
-
-  void OnStateChange() override {
-    RTC_LOG(LS_INFO) << "Client state changed to " << dc_->state();
-    switch (dc_->state()) {
-      case webrtc::DataChannelInterface::DataState::kOpen:
-        open_event_.Set();
-        break;
-      default:
-        break;
-    }
+  void Reset(uint64_t bytes_received_threshold) {
+    webrtc::MutexLock lock(&mutex_);
+    bytes_received_threshold_ = bytes_received_threshold;
+    bytes_received_ = 0;
+    last_receive_time_ms_ = rtc::TimeMillis();
+    latency_ms_ = webrtc::SamplesStatsCounter();
+    bytes_received_event_.Reset();
   }
 
-  void OnMessage(const webrtc::DataBuffer& buffer) override {
+  void OnMessage(const webrtc::DataBuffer& buffer) {
+    int64_t now_us = rtc::TimeUTCMicros();
+    webrtc::MutexLock lock(&mutex_);
     bytes_received_ += buffer.data.size();
+    last_receive_time_ms_ = rtc::TimeMillis();
+    if (absl::optional<int64_t> send_time_us = ReadSendTime(buffer)) {
+      latency_ms_.AddSample((now_us - *send_time_us) / 1000.);
+    }
     if (bytes_received_ >= bytes_received_threshold_) {
       bytes_received_event_.Set();
     }
   }
 
-  void OnBufferedAmountChange(uint64_t sent_data_size) override {}
-  bool IsOkToCallOnTheNetworkThread() override { return true; }
+  // Wait until the received byte count reaches the desired value.
+  bool WaitForBytesReceivedThreshold(webrtc::TimeDelta timeout) {
+    return bytes_received_event_.Wait(timeout);
+  }
 
-  bool WaitForOpenState() { return open_event_.Wait(rtc::Event::kForever); }
+  uint64_t bytes_received() const {
+    webrtc::MutexLock lock(&mutex_);
+    return bytes_received_;
+  }
+  int64_t last_receive_time_ms() const {
+    webrtc::MutexLock lock(&mutex_);
+    return last_receive_time_ms_;
+  }
+  webrtc::SamplesStatsCounter latency_ms() const {
+    webrtc::MutexLock lock(&mutex_);
+    return latency_ms_;
+  }
 
-  // Wait until the received byte count reaches the desired value.
-  bool WaitForBytesReceivedThreshold() {
-    return bytes_received_event_.Wait(rtc::Event::kForever);
+ private:
+  mutable webrtc::Mutex mutex_;
+  rtc::Event bytes_received_event_;
+  uint64_t bytes_received_threshold_ RTC_GUARDED_BY(mutex_) = 0;
+  uint64_t bytes_received_ RTC_GUARDED_BY(mutex_) = 0;
+  int64_t last_receive_time_ms_ RTC_GUARDED_BY(mutex_) = 0;
+  webrtc::SamplesStatsCounter latency_ms_ RTC_GUARDED_BY(mutex_);
+};
+
+class DataChannelClientObserverImpl : public webrtc::DataChannelObserver {
+ public:
+  DataChannelClientObserverImpl(webrtc::DataChannelInterface* dc,
+                                ReceiveStats* stats)
+      : dc_(dc), stats_(stats) {}
+
+  void OnStateChange() override {
+    RTC_LOG(LS_INFO) << "Client state changed to " << dc_->state();
   }
 
+  void OnMessage(const webrtc::DataBuffer& buffer) override {
+    stats_->OnMessage(buffer);
+  }
+
+  void OnBufferedAmountChange(uint64_t sent_data_size) override {}
+  bool IsOkToCallOnTheNetworkThread() override { return true; }
+
  private:
   webrtc::DataChannelInterface* const dc_;
-  rtc::Event open_event_;
-  rtc::Event bytes_received_event_;
-  const uint64_t bytes_received_threshold_;
-  uint64_t bytes_received_ = 0u;
+  ReceiveStats* const stats_;
 };
 
+// Sends the data requested by `setup` from the server, over newly created data
+// channels.
+void ServeTransfer(webrtc::PeerConnectionInterface* peer_connection,
+                   rtc::Thread* signaling_thread,
+                   webrtc::DataChannelInterface* control_channel,
+                   const SetupMessage& setup) {
+  webrtc::DataChannelInit init;
+  init.ordered = setup.ordered;
+  if (setup.max_retransmits >= 0) {
+    init.maxRetransmits = setup.max_retransmits;
+  }
+
+  std::vector<rtc::scoped_refptr<webrtc::DataChannelInterface>> channels;
+  std::vector<std::unique_ptr<DataChannelServerObserverImpl>> observers;
+  int64_t begin_cpu_ns = rtc::GetProcessCpuTimeNanos();
+  auto begin_time = webrtc::Clock::GetRealTimeClock()->CurrentTime();
+  for (int i = 0; i < setup.channels; ++i) {
+    // Any remainder is sent over the first channel.
+    size_t transfer_size = setup.transfer_size / setup.channels;
+    if (i == 0) {
+      transfer_size += setup.transfer_size % setup.channels;
+    }
+    auto dc_or_error = peer_connection->CreateDataChannelOrError(
+        "data-" + std::to_string(i), &init);
+    RTC_CHECK(dc_or_error.ok());
+    channels.push_back(dc_or_error.MoveValue());
+    observers.push_back(std::make_unique<DataChannelServerObserverImpl>(
+        channels.back().get(), signaling_thread, setup.packet_size,
+        transfer_size));
+    channels.back()->RegisterObserver(observers.back().get());
+  }
+
+  for (auto& observer : observers) {
+    observer->WaitForAllDataSent();
+  }
+  auto end_time = webrtc::Clock::GetRealTimeClock()->CurrentTime();
+  int64_t cpu_ns = rtc::GetProcessCpuTimeNanos() - begin_cpu_ns;
+  control_channel->Send(webrtc::DataBuffer(kEndMessage));
+
+  printf("Sent %zu bytes in %" PRId64 "ms over %d channel(s), CPU %.1fms/MiB\n",
+         setup.transfer_size, (end_time - begin_time).ms(), setup.channels,
+         CpuMsPerMiB(cpu_ns, setup.transfer_size));
+
+  // The client closes the data channels when it has received the data.
+  for (size_t i = 0; i < channels.size(); ++i) {
+    observers[i]->WaitForClosedState();
+    channels[i]->UnregisterObserver();
+  }
+}
+
 int RunServer() {
   bool oneshot = absl::GetFlag(FLAGS_oneshot);
   uint16_t port = absl::GetFlag(FLAGS_port);
@@ -240,43 +477,36 @@ int RunServer() {
           client.StartPeerConnection();
           auto peer_connection = client.peerConnection();
 
-          // Set up the data channel
+          // Set up the control channel.
           auto dc_or_error =
-              peer_connection->CreateDataChannelOrError("benchmark", nullptr);
+              peer_connection->CreateDataChannelOrError(kControlLabel, nullptr);
           RTC_CHECK(dc_or_error.ok());
-          auto data_channel = dc_or_error.MoveValue();
-          auto data_channel_observer =
-              std::make_unique<DataChannelServerObserverImpl>(
-                  data_channel.get(), signaling_thread);
-          data_channel->RegisterObserver(data_channel_observer.get());
+          auto control_channel = dc_or_error.MoveValue();
+          auto control_observer = std::make_unique<ControlChannelObserverImpl>(
+              control_channel.get());
+          control_channel->RegisterObserver(control_observer.get());
           absl::Cleanup unregister_observer(
-              [data_channel] { data_channel->UnregisterObserver(); });
-
-          // Wait for a first message from the remote peer.
-          // It configures how much data should be sent and how big the packets
-          // should be.
-          // First message is "packet_size,transfer_size".
-          data_channel_observer->WaitForSetupMessage();
-
-          // Wait for the sender and receiver peers to stabilize (send all ACKs)
-          // This makes it easier to isolate the sending part when profiling.
-          absl::SleepFor(absl::Seconds(1));
-
-          auto begin_time = webrtc::Clock::GetRealTimeClock()->CurrentTime();
-
-          data_channel_observer->StartSending();
-
-          // Receiver signals the data channel close event when it has received
-          // all the data it requested.
-          data_channel_observer->WaitForClosedState();
-
-          auto end_time = webrtc::Clock::GetRealTimeClock()->CurrentTime();
-          auto duration_ms = (end_time - begin_time).ms<size_t>();
-          double throughput =
-              (data_channel_observer->parameters().transfer_size / 1024. /
-               1024.) /
-              (duration_ms / 1000.);
-          printf("Elapsed time: %zums %gMiB/s\n", duration_ms, throughput);
+              [control_channel] { control_channel->UnregisterObserver(); });
+
+          // Every message from the remote peer configures a transfer. It
+          // configures how much data should be sent, how big the packets
+          // should be and over how many data channels of which kind. The
+          // client closes the control channel when it's done.
+          bool first_transfer = true;
+          while (absl::optional<std::string> message =
+                     control_observer->WaitForMessage(
+                         rtc::Event::kForever)) {
+            SetupMessage setup = SetupMessage::FromString(*message);
+            if (first_transfer) {
+              // Wait for the sender and receiver peers to stabilize (send all
+              // ACKs). This makes it easier to isolate the sending part when
+              // profiling.
+              absl::SleepFor(absl::Seconds(1));
+              first_transfer = false;
+            }
+            ServeTransfer(peer_connection.get(), signaling_thread,
+                          control_channel.get(), setup);
+          }
         },
         port, oneshot);
     grpc_server->Start();
@@ -289,11 +519,81 @@ int RunServer() {
   return 0;
 }
 
+// Requests a transfer from the server, and reports its results once received.
+bool RunTransfer(webrtc::DataChannelInterface* control_channel,
+                 ControlChannelObserverImpl* control_observer,
+                 ReceiveStats* stats,
+                 const SetupMessage& setup) {
+  bool reliable = setup.max_retransmits < 0;
+  stats->Reset(setup.transfer_size);
+  int64_t begin_cpu_ns = rtc::GetProcessCpuTimeNanos();
+  int64_t begin_time_ms = rtc::TimeMillis();
+  if (!control_channel->Send(webrtc::DataBuffer(setup.ToString()))) {
+    fprintf(stderr, "Failed to send parameter string\n");
+    return false;
+  }
+
+  // Wait until we have received all the data, or - if some of it may have been
+  // lost - until the server is done sending and no more data arrives.
+  bool sender_done = false;
+  while (
+      !stats->WaitForBytesReceivedThreshold(webrtc::TimeDelta::Millis(100))) {
+    if (!sender_done) {
+      absl::optional<std::string> message =
+          control_observer->WaitForMessage(webrtc::TimeDelta::Zero());
+      sender_done = message == kEndMessage;
+    }
+    if (sender_done && !reliable &&
+        rtc::TimeMillis() - stats->last_receive_time_ms() >
+            kUnreliableIdleTimeoutMs) {
+      break;
+    }
+  }
+  if (!sender_done) {
+    control_observer->WaitForMessage(rtc::Event::kForever);
+  }
+
+  int64_t cpu_ns = rtc::GetProcessCpuTimeNanos() - begin_cpu_ns;
+  int64_t duration_ms = stats->last_receive_time_ms() - begin_time_ms;
+  uint64_t bytes_received = stats->bytes_received();
+  double throughput = (bytes_received / 1024. / 1024.) /
+                      (std::max<int64_t>(duration_ms, 1) / 1000.);
+  printf("packet_size=%zu channels=%d ordered=%d max_retransmits=%d: "
+         "received %" PRIu64 "/%zu bytes in %" PRId64
+         "ms, %gMiB/s, CPU %.1fms/MiB\n",
+         setup.packet_size, setup.channels, setup.ordered,
+         setup.max_retransmits, bytes_received, setup.transfer_size,
+         duration_ms, throughput, CpuMsPerMiB(cpu_ns, bytes_received));
+  webrtc::SamplesStatsCounter latency_ms = stats->latency_ms();
+  if (!latency_ms.IsEmpty()) {
+    printf("  one-way latency: min=%.1fms p50=%.1fms p90=%.1fms p99=%.1fms "
+           "max=%.1fms\n",
+           latency_ms.GetMin(), latency_ms.GetPercentile(0.5),
+           latency_ms.GetPercentile(0.9), latency_ms.GetPercentile(0.99),
+           latency_ms.GetMax());
+  }
+  return true;
+}
+
 int RunClient() {
   uint16_t port = absl::GetFlag(FLAGS_port);
   std::string server_address = absl::GetFlag(FLAGS_address);
   size_t transfer_size = absl::GetFlag(FLAGS_transfer_size) * 1024 * 1024;
-  size_t packet_size = absl::GetFlag(FLAGS_packet_size);
+  std::vector<size_t> packet_sizes;
+  for (absl::string_view size :
+       rtc::split(absl::GetFlag(FLAGS_packet_size), ',')) {
+    absl::optional<size_t> packet_size = rtc::StringToNumber<size_t>(size);
+    if (!packet_size || *packet_size == 0) {
+      fprintf(stderr, "Invalid packet size: %s\n", std::string(size).c_str());
+      return 1;
+    }
+    packet_sizes.push_back(*packet_size);
+  }
+  int channels = absl::GetFlag(FLAGS_channels);
+  if (channels < 1) {
+    fprintf(stderr, "At least one channel is required\n");
+    return 1;
+  }
 
   auto signaling_thread = rtc::Thread::Create();
   signaling_thread->Start();
@@ -305,19 +605,31 @@ int RunClient() {
     webrtc::PeerConnectionClient client(factory.get(),
                                         grpc_client->signaling_client());
 
-    std::unique_ptr<DataChannelClientObserverImpl> observer;
+    ReceiveStats stats;
+    webrtc::Mutex mutex;
+    std::unique_ptr<ControlChannelObserverImpl> control_observer;
+    rtc::scoped_refptr<webrtc::DataChannelInterface> control_channel;
+    std::vector<rtc::scoped_refptr<webrtc::DataChannelInterface>> data_channels;
+    std::vector<std::unique_ptr<DataChannelClientObserverImpl>> observers;
 
-    // Set up the callback to receive the data channel from the sender.
-    rtc::scoped_refptr<webrtc::DataChannelInterface> data_channel;
-    rtc::Event got_data_channel;
+    // Set up the callback to receive the data channels from the sender.
+    rtc::Event got_control_channel;
     client.SetOnDataChannel(
         [&](rtc::scoped_refptr<webrtc::DataChannelInterface> channel) {
-          data_channel = std::move(channel);
           // DataChannel needs an observer to drain the read queue.
-          observer = std::make_unique<DataChannelClientObserverImpl>(
-              data_channel.get(), transfer_size);
-          data_channel->RegisterObserver(observer.get());
-          got_data_channel.Set();
+          if (channel->label() == kControlLabel) {
+            control_channel = std::move(channel);
+            control_observer = std::make_unique<ControlChannelObserverImpl>(
+                control_channel.get());
+            control_channel->RegisterObserver(control_observer.get());
+            got_control_channel.Set();
+            return;
+          }
+          webrtc::MutexLock lock(&mutex);
+          observers.push_back(std::make_unique<DataChannelClientObserverImpl>(
+              channel.get(), &stats));
+          channel->RegisterObserver(observers.back().get());
+          data_channels.push_back(std::move(channel));
         });
 
     // Connect to the server.
@@ -326,30 +638,41 @@ int RunClient() {
       return 1;
     }
 
-    // Wait for the data channel to be received
-    got_data_channel.Wait(rtc::Event::kForever);
+    // Wait for the control channel to be received
+    got_control_channel.Wait(rtc::Event::kForever);
 
     absl::Cleanup unregister_observer(
-        [data_channel] { data_channel->UnregisterObserver(); });
-
-    // Send a configuration string to the server to tell it to send
-    // 'packet_size' bytes packets and send a total of 'transfer_size' MB.
-    observer->WaitForOpenState();
-    SetupMessage setup_message = {
-        .packet_size = packet_size,
-        .transfer_size = transfer_size,
-    };
-    if (!data_channel->Send(webrtc::DataBuffer(setup_message.ToString()))) {
-      fprintf(stderr, "Failed to send parameter string\n");
-      return 1;
-    }
+        [control_channel] { control_channel->UnregisterObserver(); });
+
+    control_observer->WaitForOpenState();
+    for (size_t packet_size : packet_sizes) {
+      // Ask the server to send 'packet_size' bytes packets and a total of
+      // 'transfer_size' bytes.
+      SetupMessage setup_message = {
+          .packet_size = packet_size,
+          .transfer_size = transfer_size,
+          .channels = channels,
+          .ordered = absl::GetFlag(FLAGS_ordered),
+          .max_retransmits = absl::GetFlag(FLAGS_max_retransmits),
+      };
+      if (!RunTransfer(control_channel.get(), control_observer.get(), &stats,
+                       setup_message)) {
+        return 1;
+      }
 
-    // Wait until we have received all the data
-    observer->WaitForBytesReceivedThreshold();
+      // Close the data channels, signaling to the server that this transfer
+      // is complete.
+      webrtc::MutexLock lock(&mutex);
+      for (auto& data_channel : data_channels) {
+        data_channel->UnregisterObserver();
+        data_channel->Close();
+      }
+      data_channels.clear();
+      observers.clear();
+    }
 
-    // Close the data channel, signaling to the server we have received
-    // all the requested data.
-    data_channel->Close();
+    // Close the control channel, signaling to the server we are done.
+    control_channel->Close();
   }
 
   signaling_thread->Stop();
@@ -357,6 +680,8 @@ int RunClient() {
   return 0;
 }
 
+}  // namespace
+
 int main(int argc, char** argv) {
   rtc::InitializeSSL();
   absl::ParseCommandLine(argc, argv);
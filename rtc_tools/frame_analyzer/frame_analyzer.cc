@@ -60,6 +60,11 @@ ABSL_FLAG(std::string,
           "",
           "Where to store perf result in chartjson format, if not present, no "
           "perf result will be stored");
+ABSL_FLAG(int,
+          threads,
+          1,
+          "Number of threads used to compare the aligned frames. The results "
+          "do not depend on the number of threads.");
 
 namespace {
 
@@ -151,7 +156,8 @@ int main(int argc, char* argv[]) {
       AdjustColors(color_transformation, test_video);
 
   results.frames = webrtc::test::RunAnalysis(
-      aligned_reference_video, color_adjusted_test_video, matching_indices);
+      aligned_reference_video, color_adjusted_test_video, matching_indices,
+      absl::GetFlag(FLAGS_threads));
 
   const std::vector<webrtc::test::Cluster> clusters =
       webrtc::test::CalculateFrameClusters(matching_indices);
@@ -12,12 +12,14 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstddef>
 
 #include "api/numerics/samples_stats_counter.h"
 #include "api/test/metrics/metric.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/platform_thread.h"
 #include "third_party/libyuv/include/libyuv/compare.h"
 
 namespace webrtc {
@@ -57,22 +59,48 @@ double Ssim(const rtc::scoped_refptr<I420BufferInterface>& ref_buffer,
 std::vector<AnalysisResult> RunAnalysis(
     const rtc::scoped_refptr<webrtc::test::Video>& reference_video,
     const rtc::scoped_refptr<webrtc::test::Video>& test_video,
-    const std::vector<size_t>& test_frame_indices) {
-  std::vector<AnalysisResult> results;
-  for (size_t i = 0; i < test_video->number_of_frames(); ++i) {
-    const rtc::scoped_refptr<I420BufferInterface>& test_frame =
-        test_video->GetFrame(i);
-    const rtc::scoped_refptr<I420BufferInterface>& reference_frame =
-        reference_video->GetFrame(i);
-
-    // Fill in the result struct.
-    AnalysisResult result;
-    result.frame_number = test_frame_indices[i];
-    result.psnr_value = Psnr(reference_frame, test_frame);
-    result.ssim_value = Ssim(reference_frame, test_frame);
-    results.push_back(result);
+    const std::vector<size_t>& test_frame_indices,
+    int num_threads) {
+  RTC_CHECK_GE(reference_video->number_of_frames(),
+               test_video->number_of_frames());
+  std::vector<AnalysisResult> results =
+      CalculateFrameMetrics(reference_video, test_video, num_threads);
+  for (AnalysisResult& result : results) {
+    result.frame_number = test_frame_indices[result.frame_number];
   }
+  return results;
+}
 
+std::vector<AnalysisResult> CalculateFrameMetrics(
+    const rtc::scoped_refptr<webrtc::test::Video>& reference_video,
+    const rtc::scoped_refptr<webrtc::test::Video>& test_video,
+    int num_threads) {
+  const size_t num_frames = std::min(reference_video->number_of_frames(),
+                                     test_video->number_of_frames());
+  std::vector<AnalysisResult> results(num_frames);
+  // Frames are handed out one at a time, which balances the load also when
+  // some frames take longer to read or align than others.
+  std::atomic<size_t> next_frame(0);
+  auto compare_frames = [&] {
+    for (size_t i = next_frame++; i < num_frames; i = next_frame++) {
+      const rtc::scoped_refptr<I420BufferInterface> test_frame =
+          test_video->GetFrame(i);
+      const rtc::scoped_refptr<I420BufferInterface> reference_frame =
+          reference_video->GetFrame(i);
+      results[i] = AnalysisResult(static_cast<int>(i),
+                                  Psnr(reference_frame, test_frame),
+                                  Ssim(reference_frame, test_frame));
+    }
+  };
+
+  std::vector<rtc::PlatformThread> threads;
+  for (int i = 1; i < num_threads; ++i) {
+    threads.push_back(
+        rtc::PlatformThread::SpawnJoinable(compare_frames, "CompareFrames"));
+  }
+  compare_frames();
+  // Joins the threads.
+  threads.clear();
   return results;
 }
 
@@ -51,11 +51,25 @@ struct ResultsContainer {
 // comprises the frames that were captured during the quality measurement test.
 // There may be missing or duplicate frames. Also the frames start at a random
 // position in the original video. We also need to provide a map from test frame
-// indices to reference frame indices.
+// indices to reference frame indices. The frames are compared on
+// `num_threads` threads, see CalculateFrameMetrics().
 std::vector<AnalysisResult> RunAnalysis(
     const rtc::scoped_refptr<webrtc::test::Video>& reference_video,
     const rtc::scoped_refptr<webrtc::test::Video>& test_video,
-    const std::vector<size_t>& test_frame_indices);
+    const std::vector<size_t>& test_frame_indices,
+    int num_threads = 1);
+
+// Computes PSNR and SSIM of the frames with the same index in
+// `reference_video` and `test_video`, up to the length of the shorter video.
+// The frames are read and compared on `num_threads` threads, so both videos
+// must allow concurrent GetFrame() calls, as the videos from
+// video_file_reader.h and the aligners do. The results are in frame order,
+// with `frame_number` set to the frame index, and don't depend on
+// `num_threads`.
+std::vector<AnalysisResult> CalculateFrameMetrics(
+    const rtc::scoped_refptr<webrtc::test::Video>& reference_video,
+    const rtc::scoped_refptr<webrtc::test::Video>& test_video,
+    int num_threads);
 
 // Compute PSNR for an I420 buffer (all planes). The max return value (in the
 // case where the test and reference frames are exactly the same) will be 48.
@@ -14,6 +14,8 @@
 
 #include "api/test/metrics/metric.h"
 #include "api/test/metrics/metrics_logger.h"
+#include "rtc_tools/frame_analyzer/video_temporal_aligner.h"
+#include "rtc_tools/video_file_reader.h"
 #include "system_wrappers/include/clock.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
@@ -187,6 +189,29 @@ TEST(VideoQualityAnalysisTest,
                .mean = 3}}));
 }
 
+TEST(VideoQualityAnalysisTest, CalculateFrameMetricsOnThreads) {
+  const rtc::scoped_refptr<Video> reference_video =
+      OpenYuvFile(ResourcePath("foreman_128x96", "yuv"), 128, 96);
+  ASSERT_TRUE(reference_video);
+  // Compares each frame with the next one.
+  std::vector<size_t> indices;
+  for (size_t i = 1; i < reference_video->number_of_frames(); ++i)
+    indices.push_back(i);
+  const rtc::scoped_refptr<Video> test_video =
+      ReorderVideo(reference_video, indices);
+
+  const std::vector<AnalysisResult> results =
+      CalculateFrameMetrics(reference_video, test_video, /*num_threads=*/4);
+  ASSERT_EQ(results.size(), indices.size());
+  for (size_t i = 0; i < results.size(); ++i) {
+    EXPECT_EQ(results[i].frame_number, static_cast<int>(i));
+    EXPECT_EQ(results[i].psnr_value,
+              Psnr(reference_video->GetFrame(i), test_video->GetFrame(i)));
+    EXPECT_EQ(results[i].ssim_value,
+              Ssim(reference_video->GetFrame(i), test_video->GetFrame(i)));
+  }
+}
+
 TEST(VideoQualityAnalysisTest, CalculateFrameClustersOneValue) {
   const std::vector<Cluster> result = CalculateFrameClusters({1});
   EXPECT_EQ(1u, result.size());
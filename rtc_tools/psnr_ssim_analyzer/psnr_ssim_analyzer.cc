@@ -11,7 +11,6 @@
 #include <stdio.h>
 #include <stdlib.h>
 
-#include <algorithm>
 #include <string>
 
 #include "absl/flags/flag.h"
@@ -34,26 +33,24 @@ ABSL_FLAG(std::string,
           test_file,
           "test.yuv",
           "The test YUV file to run the analysis for");
+ABSL_FLAG(int,
+          threads,
+          1,
+          "Number of threads used to compare the frames. The results do not "
+          "depend on the number of threads.");
 
 void CompareFiles(
     const rtc::scoped_refptr<webrtc::test::Video>& reference_video,
     const rtc::scoped_refptr<webrtc::test::Video>& test_video,
-    const char* results_file_name) {
+    const char* results_file_name,
+    int num_threads) {
   FILE* results_file = fopen(results_file_name, "w");
 
-  const size_t num_frames = std::min(reference_video->number_of_frames(),
-                                     test_video->number_of_frames());
-  for (size_t i = 0; i < num_frames; ++i) {
-    const rtc::scoped_refptr<webrtc::I420BufferInterface> ref_buffer =
-        reference_video->GetFrame(i);
-    const rtc::scoped_refptr<webrtc::I420BufferInterface> test_buffer =
-        test_video->GetFrame(i);
-
-    // Calculate the PSNR and SSIM.
-    double result_psnr = webrtc::test::Psnr(ref_buffer, test_buffer);
-    double result_ssim = webrtc::test::Ssim(ref_buffer, test_buffer);
-    fprintf(results_file, "Frame: %zu, PSNR: %f, SSIM: %f\n", i, result_psnr,
-            result_ssim);
+  for (const webrtc::test::AnalysisResult& result :
+       webrtc::test::CalculateFrameMetrics(reference_video, test_video,
+                                           num_threads)) {
+    fprintf(results_file, "Frame: %d, PSNR: %f, SSIM: %f\n",
+            result.frame_number, result.psnr_value, result.ssim_value);
   }
 
   fclose(results_file);
@@ -103,6 +100,7 @@ int main(int argc, char* argv[]) {
   }
 
   CompareFiles(reference_video, test_video,
-               absl::GetFlag(FLAGS_results_file).c_str());
+               absl::GetFlag(FLAGS_results_file).c_str(),
+               absl::GetFlag(FLAGS_threads));
   return 0;
 }
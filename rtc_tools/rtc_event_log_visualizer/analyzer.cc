@@ -446,6 +446,7 @@ EventLogAnalyzer::EventLogAnalyzer(const ParsedRtcEventLog& log,
     RTC_LOG(LS_WARNING) << "No useful events in the log.";
     config_.begin_time_ = config_.end_time_ = Timestamp::Zero();
   }
+  BuildCandidatePairDescriptions();
 
   RTC_LOG(LS_INFO) << "Log is "
                    << (parsed_log_.last_timestamp().ms() -
@@ -457,6 +458,7 @@ EventLogAnalyzer::EventLogAnalyzer(const ParsedRtcEventLog& log,
 EventLogAnalyzer::EventLogAnalyzer(const ParsedRtcEventLog& log,
                                    const AnalyzerConfig& config)
     : parsed_log_(log), config_(config) {
+  BuildCandidatePairDescriptions();
   RTC_LOG(LS_INFO) << "Log is "
                    << (parsed_log_.last_timestamp().ms() -
                        parsed_log_.first_timestamp().ms()) /
@@ -1888,8 +1890,6 @@ void EventLogAnalyzer::CreateIceCandidatePairConfigGraph(Plot* plot) {
           TimeSeries("[" + std::to_string(config.candidate_pair_id) + "]" +
                          candidate_pair_desc,
                      LineStyle::kNone, PointStyle::kHighlight);
-      candidate_pair_desc_by_id_[config.candidate_pair_id] =
-          candidate_pair_desc;
     }
     float x = config_.GetCallTimeSec(config.log_time());
     float y = static_cast<float>(config.type);
@@ -1916,24 +1916,25 @@ void EventLogAnalyzer::CreateIceCandidatePairConfigGraph(Plot* plot) {
         "SELECTED"}});
 }
 
-std::string EventLogAnalyzer::GetCandidatePairLogDescriptionFromId(
-    uint32_t candidate_pair_id) {
-  if (candidate_pair_desc_by_id_.find(candidate_pair_id) !=
-      candidate_pair_desc_by_id_.end()) {
-    return candidate_pair_desc_by_id_[candidate_pair_id];
-  }
+void EventLogAnalyzer::BuildCandidatePairDescriptions() {
   for (const auto& config : parsed_log_.ice_candidate_pair_configs()) {
     // TODO(qingsi): Add the handling of the "Updated" config event after the
     // visualization of property change for candidate pairs is introduced.
     if (candidate_pair_desc_by_id_.find(config.candidate_pair_id) ==
         candidate_pair_desc_by_id_.end()) {
-      const std::string candidate_pair_desc =
-          GetCandidatePairLogDescriptionAsString(config);
       candidate_pair_desc_by_id_[config.candidate_pair_id] =
-          candidate_pair_desc;
+          GetCandidatePairLogDescriptionAsString(config);
     }
   }
-  return candidate_pair_desc_by_id_[candidate_pair_id];
+}
+
+std::string EventLogAnalyzer::GetCandidatePairLogDescriptionFromId(
+    uint32_t candidate_pair_id) const {
+  auto it = candidate_pair_desc_by_id_.find(candidate_pair_id);
+  if (it == candidate_pair_desc_by_id_.end()) {
+    return std::string();
+  }
+  return it->second;
 }
 
 void EventLogAnalyzer::CreateIceConnectivityCheckGraph(Plot* plot) {
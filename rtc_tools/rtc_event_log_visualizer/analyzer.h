@@ -97,7 +97,11 @@ class EventLogAnalyzer {
                                           const IterableType& packets,
                                           const std::string& label);
 
-  std::string GetCandidatePairLogDescriptionFromId(uint32_t candidate_pair_id);
+  // Fills in `candidate_pair_desc_by_id_`, so that it is only read by the
+  // Create*Graph functions, which may then run concurrently.
+  void BuildCandidatePairDescriptions();
+  std::string GetCandidatePairLogDescriptionFromId(
+      uint32_t candidate_pair_id) const;
 
   const ParsedRtcEventLog& parsed_log_;
 
@@ -11,6 +11,7 @@
 #include <stdio.h>
 #include <string.h>
 
+#include <atomic>
 #include <cstdio>
 #include <fstream>
 #include <iostream>
@@ -32,6 +33,7 @@
 #include "modules/rtp_rtcp/source/rtcp_packet/report_block.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/platform_thread.h"
 #include "rtc_tools/rtc_event_log_visualizer/alerts.h"
 #include "rtc_tools/rtc_event_log_visualizer/analyze_audio.h"
 #include "rtc_tools/rtc_event_log_visualizer/analyzer.h"
@@ -109,6 +111,13 @@ ABSL_FLAG(std::string,
           "",
           "A path to output the python plots into");
 
+ABSL_FLAG(int,
+          threads,
+          1,
+          "Number of threads used to create the plots. The plots are "
+          "independent of each other, so slow simulations can run in "
+          "parallel. The output does not depend on the number of threads.");
+
 ABSL_FLAG(bool,
           list_plots,
           false,
@@ -611,10 +620,47 @@ int main(int argc, char* argv[]) {
     return 1;
   }
 
+  // Allocate the plots up front, so that the output order doesn't depend on
+  // which plot finishes first.
+  std::vector<std::pair<const PlotDeclaration*, Plot*>> enabled_plots;
   for (const auto& plot : plots) {
     if (plot.enabled) {
-      Plot* output = collection.AppendNewPlot(plot.label);
-      plot.plot_func(output);
+      enabled_plots.emplace_back(&plot, collection.AppendNewPlot(plot.label));
+    }
+  }
+
+  const int num_threads = absl::GetFlag(FLAGS_threads);
+  if (num_threads > 1) {
+    // The NetEq plots share one simulation, which is otherwise created lazily
+    // by the first plot that needs it.
+    bool needs_neteq_stats =
+        absl::c_find(plot_flags, "simulated_neteq_jitter_buffer_delay") !=
+        plot_flags.end();
+    for (const auto& enabled_plot : enabled_plots) {
+      needs_neteq_stats |=
+          absl::StartsWith(enabled_plot.first->label, "simulated_neteq_");
+    }
+    if (needs_neteq_stats && !neteq_stats) {
+      neteq_stats = webrtc::SimulateNetEq(parsed_log, config, wav_path, 48000);
+    }
+
+    std::atomic<size_t> next_plot(0);
+    std::vector<rtc::PlatformThread> workers;
+    for (int i = 0; i < num_threads; ++i) {
+      workers.push_back(rtc::PlatformThread::SpawnJoinable(
+          [&] {
+            for (size_t j = next_plot++; j < enabled_plots.size();
+                 j = next_plot++) {
+              enabled_plots[j].first->plot_func(enabled_plots[j].second);
+            }
+          },
+          "PlotWorker"));
+    }
+    // Joins the worker threads.
+    workers.clear();
+  } else {
+    for (const auto& enabled_plot : enabled_plots) {
+      enabled_plot.first->plot_func(enabled_plot.second);
     }
   }
 
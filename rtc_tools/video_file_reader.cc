@@ -22,6 +22,8 @@
 #include "rtc_base/logging.h"
 #include "rtc_base/string_encode.h"
 #include "rtc_base/string_to_number.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
 
 namespace webrtc {
 namespace test {
@@ -32,7 +34,8 @@ bool ReadBytes(uint8_t* dst, size_t n, FILE* file) {
   return fread(reinterpret_cast<char*>(dst), /* size= */ 1, n, file) == n;
 }
 
-// Common base class for .yuv and .y4m files.
+// Common base class for .yuv and .y4m files. GetFrame() may be called from
+// several threads at the same time.
 class VideoFile : public Video {
  public:
   VideoFile(int width,
@@ -54,8 +57,9 @@ class VideoFile : public Video {
       size_t frame_index) const override {
     RTC_CHECK_LT(frame_index, frame_positions_.size());
 
-    fsetpos(file_, &frame_positions_[frame_index]);
     rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(width_, height_);
+    MutexLock lock(&file_mutex_);
+    fsetpos(file_, &frame_positions_[frame_index]);
 
     if (!ReadBytes(buffer->MutableDataY(), width_ * height_, file_) ||
         !ReadBytes(buffer->MutableDataU(),
@@ -73,7 +77,8 @@ class VideoFile : public Video {
   const int width_;
   const int height_;
   const std::vector<fpos_t> frame_positions_;
-  FILE* const file_;
+  mutable Mutex file_mutex_;
+  FILE* const file_ RTC_PT_GUARDED_BY(file_mutex_);
 };
 
 }  // namespace
@@ -10,9 +10,15 @@
 
 #include <stdio.h>
 
+#if defined(WEBRTC_POSIX)
+#include <sys/resource.h>
+#endif
+
+#include <algorithm>
 #include <fstream>
 #include <map>
 #include <memory>
+#include <vector>
 
 #include "absl/flags/flag.h"
 #include "absl/flags/parse.h"
@@ -20,6 +26,7 @@
 #include "api/environment/environment_factory.h"
 #include "api/field_trials.h"
 #include "api/media_types.h"
+#include "api/numerics/samples_stats_counter.h"
 #include "api/task_queue/task_queue_base.h"
 #include "api/test/video/function_video_decoder_factory.h"
 #include "api/transport/field_trial_based_config.h"
@@ -35,8 +42,11 @@
 #include "modules/rtp_rtcp/source/rtp_util.h"
 #include "modules/video_coding/utility/ivf_file_writer.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/platform_thread.h"
 #include "rtc_base/string_to_number.h"
 #include "rtc_base/strings/json.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
 #include "system_wrappers/include/clock.h"
 #include "system_wrappers/include/sleep.h"
 #include "test/call_config_utils.h"
@@ -170,6 +180,21 @@ ABSL_FLAG(int,
           "packet has been delivered. Typically useful to let the last few "
           "frames be decoded and rendered. Duration given in seconds.");
 
+ABSL_FLAG(bool,
+          benchmark,
+          false,
+          "Benchmark the receive pipeline: deliver packets as fast as "
+          "possible instead of at their recorded times, decode frames as soon "
+          "as they are complete, don't render, and print decode throughput "
+          "and per-frame latencies when done. Can't be combined with "
+          "--simulated_time.");
+
+ABSL_FLAG(int,
+          parallel_replays,
+          1,
+          "Number of replays of the input to run in parallel, each with its "
+          "own call and receive streams.");
+
 namespace {
 bool ValidatePayloadType(int32_t payload_type) {
   return payload_type > 0 && payload_type <= 127;
@@ -198,6 +223,101 @@ class NullRenderer : public rtc::VideoSinkInterface<VideoFrame> {
   void OnFrame(const VideoFrame& frame) override {}
 };
 
+// Collects the per-frame latencies of all replays in benchmark mode, from the
+// packet receive times and decode times the frames carry.
+class BenchmarkStats {
+ public:
+  BenchmarkStats() : clock_(Clock::GetRealTimeClock()) {}
+
+  void Start() {
+    MutexLock lock(&mutex_);
+    start_ = clock_->CurrentTime();
+  }
+
+  void OnFrame(const VideoFrame& frame) {
+    const Timestamp now = clock_->CurrentTime();
+    MutexLock lock(&mutex_);
+    ++num_frames_;
+    last_frame_ = now;
+    if (frame.packet_infos().empty())
+      return;
+    Timestamp first_packet = Timestamp::PlusInfinity();
+    Timestamp last_packet = Timestamp::MinusInfinity();
+    for (const RtpPacketInfo& packet_info : frame.packet_infos()) {
+      first_packet = std::min(first_packet, packet_info.receive_time());
+      last_packet = std::max(last_packet, packet_info.receive_time());
+    }
+    // Time in the packet buffer, waiting for the rest of the frame.
+    assembly_ms_.AddSample((last_packet - first_packet).ms<double>());
+    if (frame.processing_time()) {
+      // Time in the reference finder and the frame buffer, waiting for
+      // references and for the decoder.
+      queue_ms_.AddSample(
+          (frame.processing_time()->start - last_packet).ms<double>());
+      decode_ms_.AddSample(frame.processing_time()->Elapsed().ms<double>());
+    }
+    total_ms_.AddSample((now - first_packet).ms<double>());
+  }
+
+  void Print() {
+    MutexLock lock(&mutex_);
+    printf("decoded_frames: %d\n", num_frames_);
+    if (num_frames_ > 0 && last_frame_ > start_) {
+      printf("decode_fps: %.1f\n",
+             num_frames_ / (last_frame_ - start_).seconds<double>());
+    }
+    PrintLatency("assembly", assembly_ms_);
+    PrintLatency("queue", queue_ms_);
+    PrintLatency("decode", decode_ms_);
+    PrintLatency("total", total_ms_);
+#if defined(WEBRTC_POSIX)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#if defined(WEBRTC_MAC)
+      // In bytes on Mac, in kilobytes elsewhere.
+      usage.ru_maxrss /= 1024;
+#endif
+      printf("max_rss_kb: %ld\n", static_cast<long>(usage.ru_maxrss));
+    }
+#endif
+  }
+
+ private:
+  static void PrintLatency(const char* name, SamplesStatsCounter& samples) {
+    if (samples.IsEmpty())
+      return;
+    printf("%s_latency_ms: p50=%.2f p90=%.2f p99=%.2f max=%.2f\n", name,
+           samples.GetPercentile(0.5), samples.GetPercentile(0.9),
+           samples.GetPercentile(0.99), samples.GetMax());
+  }
+
+  Clock* const clock_;
+  Mutex mutex_;
+  Timestamp start_ RTC_GUARDED_BY(mutex_) = Timestamp::MinusInfinity();
+  Timestamp last_frame_ RTC_GUARDED_BY(mutex_) = Timestamp::MinusInfinity();
+  int num_frames_ RTC_GUARDED_BY(mutex_) = 0;
+  SamplesStatsCounter assembly_ms_ RTC_GUARDED_BY(mutex_);
+  SamplesStatsCounter queue_ms_ RTC_GUARDED_BY(mutex_);
+  SamplesStatsCounter decode_ms_ RTC_GUARDED_BY(mutex_);
+  SamplesStatsCounter total_ms_ RTC_GUARDED_BY(mutex_);
+};
+
+class BenchmarkPassthrough : public rtc::VideoSinkInterface<VideoFrame> {
+ public:
+  BenchmarkPassthrough(BenchmarkStats* stats,
+                       rtc::VideoSinkInterface<VideoFrame>* renderer)
+      : stats_(stats), renderer_(renderer) {}
+
+  void OnFrame(const VideoFrame& video_frame) override {
+    stats_->OnFrame(video_frame);
+    renderer_->OnFrame(video_frame);
+  }
+
+ private:
+  BenchmarkStats* const stats_;
+  rtc::VideoSinkInterface<VideoFrame>* const renderer_;
+};
+
 class FileRenderPassthrough : public rtc::VideoSinkInterface<VideoFrame> {
  public:
   FileRenderPassthrough(const std::string& basename,
@@ -301,8 +421,10 @@ struct StreamState {
 };
 
 // Loads multiple configurations from the provided configuration file.
-std::unique_ptr<StreamState> ConfigureFromFile(const std::string& config_path,
-                                               Call* call) {
+std::unique_ptr<StreamState> ConfigureFromFile(
+    const std::string& config_path,
+    Call* call,
+    BenchmarkStats* benchmark_stats) {
   auto stream_state = std::make_unique<StreamState>();
   // Parse the configuration file.
   std::ifstream config_file(config_path);
@@ -340,13 +462,17 @@ std::unique_ptr<StreamState> ConfigureFromFile(const std::string& config_path,
     // Create a window for this config.
     std::stringstream window_title;
     window_title << "Playback Video (" << config_count++ << ")";
-    if (absl::GetFlag(FLAGS_disable_preview)) {
+    if (absl::GetFlag(FLAGS_disable_preview) || benchmark_stats) {
       stream_state->sinks.emplace_back(std::make_unique<NullRenderer>());
     } else {
       stream_state->sinks.emplace_back(test::VideoRenderer::Create(
           window_title.str().c_str(), absl::GetFlag(FLAGS_render_width),
           absl::GetFlag(FLAGS_render_height)));
     }
+    if (benchmark_stats) {
+      stream_state->sinks.emplace_back(std::make_unique<BenchmarkPassthrough>(
+          benchmark_stats, stream_state->sinks.back().get()));
+    }
     // Create a receive stream for this config.
     receive_config.renderer = stream_state->sinks.back().get();
     receive_config.decoder_factory = stream_state->decoder_factory.get();
@@ -359,14 +485,15 @@ std::unique_ptr<StreamState> ConfigureFromFile(const std::string& config_path,
 // Loads the base configuration from flags passed in on the commandline.
 std::unique_ptr<StreamState> ConfigureFromFlags(
     const std::string& rtp_dump_path,
-    Call* call) {
+    Call* call,
+    BenchmarkStats* benchmark_stats) {
   auto stream_state = std::make_unique<StreamState>();
   // Create the video renderers. We must add both to the stream state to keep
   // them from deallocating.
   std::stringstream window_title;
   window_title << "Playback Video (" << rtp_dump_path << ")";
   std::unique_ptr<rtc::VideoSinkInterface<VideoFrame>> playback_video;
-  if (absl::GetFlag(FLAGS_disable_preview)) {
+  if (absl::GetFlag(FLAGS_disable_preview) || benchmark_stats) {
     playback_video = std::make_unique<NullRenderer>();
   } else {
     playback_video.reset(test::VideoRenderer::Create(
@@ -377,6 +504,10 @@ std::unique_ptr<StreamState> ConfigureFromFlags(
       absl::GetFlag(FLAGS_out_base), playback_video.get());
   stream_state->sinks.push_back(std::move(playback_video));
   stream_state->sinks.push_back(std::move(file_passthrough));
+  if (benchmark_stats) {
+    stream_state->sinks.push_back(std::make_unique<BenchmarkPassthrough>(
+        benchmark_stats, stream_state->sinks.back().get()));
+  }
   // Setup the configuration from the flags.
   VideoReceiveStreamInterface::Config receive_config(
       &(stream_state->transport));
@@ -446,7 +577,11 @@ std::unique_ptr<StreamState> ConfigureFromFlags(
 std::unique_ptr<test::RtpFileReader> CreateRtpReader(
     const std::string& rtp_dump_path) {
   std::unique_ptr<test::RtpFileReader> rtp_reader(test::RtpFileReader::Create(
-      test::RtpFileReader::kRtpDump, rtp_dump_path));
+      test::RtpFileReader::kIndexedRtpDump, rtp_dump_path));
+  if (!rtp_reader) {
+    rtp_reader.reset(test::RtpFileReader::Create(test::RtpFileReader::kRtpDump,
+                                                 rtp_dump_path));
+  }
   if (!rtp_reader) {
     rtp_reader.reset(
         test::RtpFileReader::Create(test::RtpFileReader::kPcap, rtp_dump_path));
@@ -475,9 +610,11 @@ class RtpReplayer final {
   RtpReplayer(absl::string_view replay_config_path,
               absl::string_view rtp_dump_path,
               std::unique_ptr<FieldTrialsView> field_trials,
-              bool simulated_time)
+              bool simulated_time,
+              BenchmarkStats* benchmark_stats)
       : replay_config_path_(replay_config_path),
         rtp_dump_path_(rtp_dump_path),
+        benchmark_stats_(benchmark_stats),
         time_sim_(simulated_time
                       ? std::make_unique<GlobalSimulatedTimeController>(
                             Timestamp::Millis(1 << 30))
@@ -496,9 +633,11 @@ class RtpReplayer final {
       // Creation of the streams must happen inside a task queue because it is
       // resued as a worker thread.
       if (replay_config_path_.empty()) {
-        stream_state_ = ConfigureFromFlags(rtp_dump_path_, call_.get());
+        stream_state_ =
+            ConfigureFromFlags(rtp_dump_path_, call_.get(), benchmark_stats_);
       } else {
-        stream_state_ = ConfigureFromFile(replay_config_path_, call_.get());
+        stream_state_ = ConfigureFromFile(replay_config_path_, call_.get(),
+                                          benchmark_stats_);
       }
       event.Set();
     });
@@ -589,8 +728,10 @@ class RtpReplayer final {
         continue;
       }
 
-      int64_t deliver_in_ms = replay_start_ms + packet.time_ms - now_ms;
-      SleepOrAdvanceTime(deliver_in_ms);
+      if (!benchmark_stats_) {
+        int64_t deliver_in_ms = replay_start_ms + packet.time_ms - now_ms;
+        SleepOrAdvanceTime(deliver_in_ms);
+      }
 
       ++num_packets;
 
@@ -600,7 +741,7 @@ class RtpReplayer final {
           call_->Receiver()->DeliverRtcpPacket(std::move(packet_buffer));
         }
         RtpPacketReceived received_packet(&extensions,
-                                          Timestamp::Millis(CurrentTimeMs()));
+                                          env_.clock().CurrentTime());
         if (!received_packet.Parse(std::move(packet_buffer))) {
           result = Result::kParsingFailed;
           return;
@@ -661,6 +802,7 @@ class RtpReplayer final {
 
   const std::string replay_config_path_;
   const std::string rtp_dump_path_;
+  BenchmarkStats* const benchmark_stats_;
   std::unique_ptr<GlobalSimulatedTimeController> time_sim_;
   Environment env_;
   std::unique_ptr<TaskQueueBase, TaskQueueDeleter> worker_thread_;
@@ -670,11 +812,40 @@ class RtpReplayer final {
 };
 
 void RtpReplay() {
-  RtpReplayer replayer(
-      absl::GetFlag(FLAGS_config_file), absl::GetFlag(FLAGS_input_file),
-      std::make_unique<FieldTrials>(absl::GetFlag(FLAGS_force_fieldtrials)),
-      absl::GetFlag(FLAGS_simulated_time));
-  replayer.Run();
+  const bool benchmark = absl::GetFlag(FLAGS_benchmark);
+  std::string field_trials = absl::GetFlag(FLAGS_force_fieldtrials);
+  if (benchmark) {
+    // Decode frames as soon as they are complete, rather than at their
+    // render time.
+    field_trials = "WebRTC-ForcePlayoutDelay/min_ms:0,max_ms:0/" + field_trials;
+  }
+  std::unique_ptr<BenchmarkStats> benchmark_stats =
+      benchmark ? std::make_unique<BenchmarkStats>() : nullptr;
+
+  std::vector<std::unique_ptr<RtpReplayer>> replayers;
+  for (int i = 0; i < absl::GetFlag(FLAGS_parallel_replays); ++i) {
+    replayers.push_back(std::make_unique<RtpReplayer>(
+        absl::GetFlag(FLAGS_config_file), absl::GetFlag(FLAGS_input_file),
+        std::make_unique<FieldTrials>(field_trials),
+        absl::GetFlag(FLAGS_simulated_time), benchmark_stats.get()));
+  }
+  if (benchmark_stats) {
+    benchmark_stats->Start();
+  }
+  if (replayers.size() == 1) {
+    replayers[0]->Run();
+  } else {
+    std::vector<rtc::PlatformThread> threads;
+    for (auto& replayer : replayers) {
+      threads.push_back(rtc::PlatformThread::SpawnJoinable(
+          [&replayer] { replayer->Run(); }, "RtpReplayer"));
+    }
+    // Joins the threads.
+    threads.clear();
+  }
+  if (benchmark_stats) {
+    benchmark_stats->Print();
+  }
 }
 
 }  // namespace
@@ -699,6 +870,12 @@ int main(int argc, char* argv[]) {
       absl::GetFlag(FLAGS_transmission_offset_id)));
   RTC_CHECK(ValidateInputFilenameNotEmpty(absl::GetFlag(FLAGS_input_file)));
   RTC_CHECK_GE(absl::GetFlag(FLAGS_extend_run_time_duration), 0);
+  RTC_CHECK_GE(absl::GetFlag(FLAGS_parallel_replays), 1);
+  // The simulated time controller replaces the global clock, so there can
+  // only be one, and it has to advance at the recorded packet times.
+  RTC_CHECK(!absl::GetFlag(FLAGS_simulated_time) ||
+            (!absl::GetFlag(FLAGS_benchmark) &&
+             absl::GetFlag(FLAGS_parallel_replays) == 1));
 
   rtc::ThreadManager::Instance()->WrapCurrentThread();
   webrtc::test::RunTest(webrtc::RtpReplay);
@@ -50,8 +50,24 @@ public class HardwareVideoDecoderFactory extends MediaCodecVideoDecoderFactory {
    */
   public HardwareVideoDecoderFactory(@Nullable EglBase.Context sharedContext,
       @Nullable Predicate<MediaCodecInfo> codecAllowedPredicate) {
+    this(sharedContext, codecAllowedPredicate, /* useAsyncMode= */ false);
+  }
+
+  /**
+   * Creates a HardwareVideoDecoderFactory that supports surface texture rendering.
+   *
+   * @param sharedContext The textures generated will be accessible from this context. May be null,
+   *                      this disables texture support.
+   * @param codecAllowedPredicate predicate to filter codecs. It is combined with the default
+   *                              predicate that only allows hardware codecs.
+   * @param useAsyncMode Whether texture decoders run MediaCodec in asynchronous mode. Requires
+   *                     API 23; older devices keep using synchronous mode.
+   */
+  public HardwareVideoDecoderFactory(@Nullable EglBase.Context sharedContext,
+      @Nullable Predicate<MediaCodecInfo> codecAllowedPredicate, boolean useAsyncMode) {
     super(sharedContext,
         (codecAllowedPredicate == null ? defaultAllowedPredicate
-                                       : codecAllowedPredicate.and(defaultAllowedPredicate)));
+                                       : codecAllowedPredicate.and(defaultAllowedPredicate)),
+        useAsyncMode);
   }
 }
@@ -13,13 +13,16 @@ package org.webrtc;
 import android.media.MediaCodec;
 import android.media.MediaCodecInfo.CodecCapabilities;
 import android.media.MediaFormat;
+import android.os.Build;
 import android.os.SystemClock;
 import android.view.Surface;
 import androidx.annotation.Nullable;
 import java.io.IOException;
 import java.nio.ByteBuffer;
 import java.util.concurrent.BlockingDeque;
+import java.util.concurrent.BlockingQueue;
 import java.util.concurrent.LinkedBlockingDeque;
+import java.util.concurrent.LinkedBlockingQueue;
 import java.util.concurrent.TimeUnit;
 import org.webrtc.ThreadUtils.ThreadChecker;
 
@@ -60,6 +63,15 @@ class AndroidVideoDecoder implements VideoDecoder, VideoSink {
   private final BlockingDeque<FrameInfo> frameInfos;
   private int colorFormat;
 
+  // Whether to run the codec in asynchronous mode when decoding to a texture.  In asynchronous
+  // mode MediaCodec reports buffers through callbacks on the texture thread instead of being
+  // polled by an output thread.
+  private final boolean useAsyncMode;
+  // Set on the decoder thread when the codec is created.  Immutable while the codec is running.
+  private boolean asyncMode;
+  // Input buffers reported by the codec in asynchronous mode, consumed by decode().
+  private final BlockingQueue<Integer> availableInputBuffers = new LinkedBlockingQueue<>();
+
   // Output thread runs a loop which polls MediaCodec for decoded output buffers.  It reformats
   // those buffers into VideoFrames and delivers them to the callback.  Variable is set on decoder
   // thread and is immutable while the codec is running.
@@ -92,6 +104,7 @@ class AndroidVideoDecoder implements VideoDecoder, VideoSink {
   private boolean keyFrameRequired;
 
   private final @Nullable EglBase.Context sharedContext;
+  private final @Nullable SurfaceTextureHelperPool surfaceTextureHelperPool;
   // Valid and immutable while the decoder is running.
   @Nullable private SurfaceTextureHelper surfaceTextureHelper;
   @Nullable private Surface surface;
@@ -119,17 +132,26 @@ class AndroidVideoDecoder implements VideoDecoder, VideoSink {
 
   AndroidVideoDecoder(MediaCodecWrapperFactory mediaCodecWrapperFactory, String codecName,
       VideoCodecMimeType codecType, int colorFormat, @Nullable EglBase.Context sharedContext) {
+    this(mediaCodecWrapperFactory, codecName, codecType, colorFormat, sharedContext,
+        /* surfaceTextureHelperPool= */ null, /* useAsyncMode= */ false);
+  }
+
+  AndroidVideoDecoder(MediaCodecWrapperFactory mediaCodecWrapperFactory, String codecName,
+      VideoCodecMimeType codecType, int colorFormat, @Nullable EglBase.Context sharedContext,
+      @Nullable SurfaceTextureHelperPool surfaceTextureHelperPool, boolean useAsyncMode) {
     if (!isSupportedColorFormat(colorFormat)) {
       throw new IllegalArgumentException("Unsupported color format: " + colorFormat);
     }
     Logging.d(TAG,
         "ctor name: " + codecName + " type: " + codecType + " color format: " + colorFormat
-            + " context: " + sharedContext);
+            + " context: " + sharedContext + " async: " + useAsyncMode);
     this.mediaCodecWrapperFactory = mediaCodecWrapperFactory;
     this.codecName = codecName;
     this.codecType = codecType;
     this.colorFormat = colorFormat;
     this.sharedContext = sharedContext;
+    this.surfaceTextureHelperPool = surfaceTextureHelperPool;
+    this.useAsyncMode = useAsyncMode;
     this.frameInfos = new LinkedBlockingDeque<>();
   }
 
@@ -152,7 +174,7 @@ class AndroidVideoDecoder implements VideoDecoder, VideoSink {
     Logging.d(TAG,
         "initDecodeInternal name: " + codecName + " type: " + codecType + " width: " + width
             + " height: " + height + " color format: " + colorFormat);
-    if (outputThread != null) {
+    if (outputThread != null || (asyncMode && codec != null)) {
       Logging.e(TAG, "initDecodeInternal called while the codec is already running");
       return VideoCodecStatus.FALLBACK_SOFTWARE;
     }
@@ -173,12 +195,27 @@ class AndroidVideoDecoder implements VideoDecoder, VideoSink {
       Logging.e(TAG, "Cannot create media decoder " + codecName);
       return VideoCodecStatus.FALLBACK_SOFTWARE;
     }
+    // Asynchronous mode needs setCallback(Callback, Handler), which was added in API 23.  Byte
+    // buffer output keeps the output thread, since it would otherwise copy frames on the decoder
+    // thread.
+    asyncMode = useAsyncMode && surfaceTextureHelper != null
+        && Build.VERSION.SDK_INT >= Build.VERSION_CODES.M;
     try {
       MediaFormat format = MediaFormat.createVideoFormat(codecType.mimeType(), width, height);
       if (sharedContext == null) {
         format.setInteger(MediaFormat.KEY_COLOR_FORMAT, colorFormat);
       }
+      if (asyncMode) {
+        availableInputBuffers.clear();
+        outputThreadChecker = new ThreadChecker();
+        outputThreadChecker.detachThread();
+        codec.setCallback(new AsyncCallback(codec), surfaceTextureHelper.getHandler());
+      }
       codec.configure(format, surface, null, 0);
+      if (asyncMode) {
+        // Callbacks may arrive on the texture thread as soon as the codec is started.
+        running = true;
+      }
       codec.start();
     } catch (IllegalStateException | IllegalArgumentException e) {
       Logging.e(TAG, "initDecode failed", e);
@@ -186,8 +223,10 @@ class AndroidVideoDecoder implements VideoDecoder, VideoSink {
       return VideoCodecStatus.FALLBACK_SOFTWARE;
     }
     running = true;
-    outputThread = createOutputThread();
-    outputThread.start();
+    if (!asyncMode) {
+      outputThread = createOutputThread();
+      outputThread.start();
+    }
 
     Logging.d(TAG, "initDecodeInternal done");
     return VideoCodecStatus.OK;
@@ -239,7 +278,7 @@ class AndroidVideoDecoder implements VideoDecoder, VideoSink {
 
     int index;
     try {
-      index = codec.dequeueInputBuffer(DEQUEUE_INPUT_TIMEOUT_US);
+      index = dequeueInputBuffer();
     } catch (IllegalStateException e) {
       Logging.e(TAG, "dequeueInputBuffer failed", e);
       return VideoCodecStatus.ERROR;
@@ -296,7 +335,11 @@ class AndroidVideoDecoder implements VideoDecoder, VideoSink {
       releaseSurface();
       surface = null;
       surfaceTextureHelper.stopListening();
-      surfaceTextureHelper.dispose();
+      if (surfaceTextureHelperPool != null) {
+        surfaceTextureHelperPool.release(surfaceTextureHelper);
+      } else {
+        surfaceTextureHelper.dispose();
+      }
       surfaceTextureHelper = null;
     }
     synchronized (renderedTextureMetadataLock) {
@@ -309,6 +352,9 @@ class AndroidVideoDecoder implements VideoDecoder, VideoSink {
 
   // Internal variant is used when restarting the codec due to reconfiguration.
   private VideoCodecStatus releaseInternal() {
+    if (asyncMode) {
+      return releaseAsyncCodec();
+    }
     if (!running) {
       Logging.d(TAG, "release: Decoder is not running.");
       return VideoCodecStatus.OK;
@@ -335,6 +381,45 @@ class AndroidVideoDecoder implements VideoDecoder, VideoSink {
     return VideoCodecStatus.OK;
   }
 
+  // In asynchronous mode there is no output thread, so the codec is stopped and released on the
+  // calling thread.  The callbacks stop touching the codec once running is false.
+  private VideoCodecStatus releaseAsyncCodec() {
+    if (codec == null) {
+      Logging.d(TAG, "release: Decoder is not running.");
+      return VideoCodecStatus.OK;
+    }
+    running = false;
+    try {
+      releaseCodec(codec);
+      if (shutdownException != null) {
+        Logging.e(TAG, "Media decoder release error", new RuntimeException(shutdownException));
+        shutdownException = null;
+        return VideoCodecStatus.ERROR;
+      }
+    } finally {
+      codec = null;
+      availableInputBuffers.clear();
+    }
+    return VideoCodecStatus.OK;
+  }
+
+  private int dequeueInputBuffer() {
+    if (!asyncMode) {
+      return codec.dequeueInputBuffer(DEQUEUE_INPUT_TIMEOUT_US);
+    }
+    if (!running) {
+      // The codec reported an error from a callback.
+      return -1;
+    }
+    try {
+      Integer index = availableInputBuffers.poll(DEQUEUE_INPUT_TIMEOUT_US, TimeUnit.MICROSECONDS);
+      return index != null ? index : -1;
+    } catch (InterruptedException e) {
+      Thread.currentThread().interrupt();
+      return -1;
+    }
+  }
+
   private VideoCodecStatus reinitDecode(int newWidth, int newHeight) {
     decoderThreadChecker.checkIsOnValidThread();
     VideoCodecStatus status = releaseInternal();
@@ -377,29 +462,78 @@ class AndroidVideoDecoder implements VideoDecoder, VideoSink {
         return;
       }
 
-      FrameInfo frameInfo = frameInfos.poll();
-      Integer decodeTimeMs = null;
-      int rotation = 0;
-      if (frameInfo != null) {
-        decodeTimeMs = (int) (SystemClock.elapsedRealtime() - frameInfo.decodeStartTimeMs);
-        rotation = frameInfo.rotation;
+      deliverOutputBuffer(codec, index, info);
+    } catch (IllegalStateException e) {
+      Logging.e(TAG, "deliverDecodedFrame failed", e);
+    }
+  }
+
+  private void deliverOutputBuffer(
+      MediaCodecWrapper codec, int index, MediaCodec.BufferInfo info) {
+    FrameInfo frameInfo = frameInfos.poll();
+    Integer decodeTimeMs = null;
+    int rotation = 0;
+    if (frameInfo != null) {
+      decodeTimeMs = (int) (SystemClock.elapsedRealtime() - frameInfo.decodeStartTimeMs);
+      rotation = frameInfo.rotation;
+    }
+
+    hasDecodedFirstFrame = true;
+
+    if (surfaceTextureHelper != null) {
+      deliverTextureFrame(codec, index, info, rotation, decodeTimeMs);
+    } else {
+      deliverByteFrame(codec, index, info, rotation, decodeTimeMs);
+    }
+  }
+
+  // Receives buffers from a codec in asynchronous mode.  Runs on the texture thread.  Holds on to
+  // the codec it was created for, since the decoder thread clears `codec` when releasing it.
+  private class AsyncCallback implements MediaCodecWrapper.Callback {
+    private final MediaCodecWrapper codec;
+
+    AsyncCallback(MediaCodecWrapper codec) {
+      this.codec = codec;
+    }
+
+    @Override
+    public void onInputBufferAvailable(int index) {
+      if (running) {
+        availableInputBuffers.offer(index);
       }
+    }
 
-      hasDecodedFirstFrame = true;
+    @Override
+    public void onOutputBufferAvailable(int index, MediaCodec.BufferInfo info) {
+      outputThreadChecker.checkIsOnValidThread();
+      if (!running) {
+        return;
+      }
+      try {
+        deliverOutputBuffer(codec, index, info);
+      } catch (IllegalStateException e) {
+        Logging.e(TAG, "deliverOutputBuffer failed", e);
+      }
+    }
 
-      if (surfaceTextureHelper != null) {
-        deliverTextureFrame(index, info, rotation, decodeTimeMs);
-      } else {
-        deliverByteFrame(index, info, rotation, decodeTimeMs);
+    @Override
+    public void onOutputFormatChanged(MediaFormat format) {
+      if (running) {
+        reformat(format);
       }
+    }
 
-    } catch (IllegalStateException e) {
-      Logging.e(TAG, "deliverDecodedFrame failed", e);
+    @Override
+    public void onError(MediaCodec.CodecException e) {
+      Logging.e(TAG, "Media decoder error", e);
+      if (running) {
+        stopOnOutputThread(e);
+      }
     }
   }
 
-  private void deliverTextureFrame(final int index, final MediaCodec.BufferInfo info,
-      final int rotation, final Integer decodeTimeMs) {
+  private void deliverTextureFrame(final MediaCodecWrapper codec, final int index,
+      final MediaCodec.BufferInfo info, final int rotation, final Integer decodeTimeMs) {
     // Load dimensions from shared memory under the dimension lock.
     final int width;
     final int height;
@@ -440,8 +574,8 @@ class AndroidVideoDecoder implements VideoDecoder, VideoSink {
     callback.onDecodedFrame(frameWithModifiedTimeStamp, decodeTimeMs, null /* qp */);
   }
 
-  private void deliverByteFrame(
-      int index, MediaCodec.BufferInfo info, int rotation, Integer decodeTimeMs) {
+  private void deliverByteFrame(MediaCodecWrapper codec, int index, MediaCodec.BufferInfo info,
+      int rotation, Integer decodeTimeMs) {
     // Load dimensions from shared memory under the dimension lock.
     int width;
     int height;
@@ -619,6 +753,11 @@ class AndroidVideoDecoder implements VideoDecoder, VideoSink {
   private void releaseCodecOnOutputThread() {
     outputThreadChecker.checkIsOnValidThread();
     Logging.d(TAG, "Releasing MediaCodec on output thread");
+    releaseCodec(codec);
+    Logging.d(TAG, "Release on output thread done");
+  }
+
+  private void releaseCodec(MediaCodecWrapper codec) {
     try {
       codec.stop();
     } catch (Exception e) {
@@ -631,7 +770,6 @@ class AndroidVideoDecoder implements VideoDecoder, VideoSink {
       // Propagate exceptions caught during release back to the main thread.
       shutdownException = e;
     }
-    Logging.d(TAG, "Release on output thread done");
   }
 
   private void stopOnOutputThread(Exception e) {
@@ -651,6 +789,9 @@ class AndroidVideoDecoder implements VideoDecoder, VideoSink {
 
   // Visible for testing.
   protected SurfaceTextureHelper createSurfaceTextureHelper() {
+    if (surfaceTextureHelperPool != null) {
+      return surfaceTextureHelperPool.acquire();
+    }
     return SurfaceTextureHelper.create("decoder-texture-thread", sharedContext);
   }
 
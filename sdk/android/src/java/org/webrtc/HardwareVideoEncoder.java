@@ -153,6 +153,10 @@ class HardwareVideoEncoder implements VideoEncoder {
   private long nextPresentationTimestampUs;
   // Presentation timestamp of the last requested (or forced) key frame.
   private long lastKeyFrameNs;
+  // Texture frames encoded since initEncode(), and how many of them had to be copied to I420
+  // because the codec is in byte buffer mode.
+  private int textureFrameCount;
+  private int textureFrameCopyCount;
 
   // --- Only accessed on the output thread.
   // Contents of the last observed config frame output by the MediaCodec. Used by H.264.
@@ -213,6 +217,8 @@ class HardwareVideoEncoder implements VideoEncoder {
     this.width = settings.width;
     this.height = settings.height;
     useSurfaceMode = canUseSurface();
+    textureFrameCount = 0;
+    textureFrameCopyCount = 0;
 
     if (settings.startBitrate != 0 && settings.maxFramerate != 0) {
       bitrateAdjuster.setTargets(settings.startBitrate * 1000, settings.maxFramerate);
@@ -328,6 +334,12 @@ class HardwareVideoEncoder implements VideoEncoder {
       }
     }
 
+    if (textureFrameCopyCount > 0) {
+      Logging.w(TAG,
+          "Copied " + textureFrameCopyCount + " of " + textureFrameCount
+              + " texture frames to I420 buffers");
+    }
+
     textureDrawer.release();
     videoFrameDrawer.release();
     if (textureEglBase != null) {
@@ -358,11 +370,14 @@ class HardwareVideoEncoder implements VideoEncoder {
 
     final boolean isTextureBuffer = videoFrame.getBuffer() instanceof VideoFrame.TextureBuffer;
 
-    // If input resolution changed, restart the codec with the new resolution.
+    // If input resolution changed, restart the codec with the new resolution. In surface mode,
+    // texture frames are cropped and scaled to the codec resolution on the GPU instead, which keeps
+    // lower simulcast layers and frames cropped for alignment on the texture path.
     final int frameWidth = videoFrame.getBuffer().getWidth();
     final int frameHeight = videoFrame.getBuffer().getHeight();
     final boolean shouldUseSurfaceMode = canUseSurface() && isTextureBuffer;
-    if (frameWidth != width || frameHeight != height || shouldUseSurfaceMode != useSurfaceMode) {
+    if (((frameWidth != width || frameHeight != height) && !shouldUseSurfaceMode)
+        || shouldUseSurfaceMode != useSurfaceMode) {
       VideoCodecStatus status = resetCodec(frameWidth, frameHeight, shouldUseSurfaceMode);
       if (status != VideoCodecStatus.OK) {
         return status;
@@ -388,8 +403,8 @@ class HardwareVideoEncoder implements VideoEncoder {
 
     EncodedImage.Builder builder = EncodedImage.builder()
                                        .setCaptureTimeNs(videoFrame.getTimestampNs())
-                                       .setEncodedWidth(videoFrame.getBuffer().getWidth())
-                                       .setEncodedHeight(videoFrame.getBuffer().getHeight())
+                                       .setEncodedWidth(width)
+                                       .setEncodedHeight(height)
                                        .setRotation(videoFrame.getRotation());
     outputBuilders.offer(builder);
 
@@ -399,6 +414,10 @@ class HardwareVideoEncoder implements VideoEncoder {
         (long) (TimeUnit.SECONDS.toMicros(1) / bitrateAdjuster.getAdjustedFramerateFps());
     nextPresentationTimestampUs += frameDurationUs;
 
+    if (isTextureBuffer) {
+      textureFrameCount++;
+    }
+
     final VideoCodecStatus returnValue;
     if (useSurfaceMode) {
       returnValue = encodeTextureBuffer(videoFrame, presentationTimestampUs);
@@ -418,22 +437,46 @@ class HardwareVideoEncoder implements VideoEncoder {
   private VideoCodecStatus encodeTextureBuffer(
       VideoFrame videoFrame, long presentationTimestampUs) {
     encodeThreadChecker.checkIsOnValidThread();
+    final VideoFrame.Buffer buffer = videoFrame.getBuffer();
+    final boolean needsScaling = buffer.getWidth() != width || buffer.getHeight() != height;
+    // Cropping and scaling a texture buffer only updates its transformation matrix. The actual
+    // scaling happens when drawing it to the input surface.
+    final VideoFrame.Buffer scaledBuffer = needsScaling ? cropAndScaleToCodecSize(buffer) : buffer;
     try {
       // TODO(perkj): glClear() shouldn't be necessary since every pixel is covered anyway,
       // but it's a workaround for bug webrtc:5147.
       GLES20.glClear(GLES20.GL_COLOR_BUFFER_BIT);
       // It is not necessary to release this frame because it doesn't own the buffer.
       VideoFrame derotatedFrame =
-          new VideoFrame(videoFrame.getBuffer(), 0 /* rotation */, videoFrame.getTimestampNs());
+          new VideoFrame(scaledBuffer, 0 /* rotation */, videoFrame.getTimestampNs());
       videoFrameDrawer.drawFrame(derotatedFrame, textureDrawer, null /* additionalRenderMatrix */);
       textureEglBase.swapBuffers(TimeUnit.MICROSECONDS.toNanos(presentationTimestampUs));
     } catch (RuntimeException e) {
       Logging.e(TAG, "encodeTexture failed", e);
       return VideoCodecStatus.ERROR;
+    } finally {
+      if (needsScaling) {
+        scaledBuffer.release();
+      }
     }
     return VideoCodecStatus.OK;
   }
 
+  /** Crops `buffer` to the aspect ratio of the codec, centered, and scales it to the codec size. */
+  private VideoFrame.Buffer cropAndScaleToCodecSize(VideoFrame.Buffer buffer) {
+    final int bufferWidth = buffer.getWidth();
+    final int bufferHeight = buffer.getHeight();
+    int cropWidth = bufferWidth;
+    int cropHeight = bufferHeight;
+    if ((long) bufferWidth * height > (long) bufferHeight * width) {
+      cropWidth = (int) ((long) bufferHeight * width / height);
+    } else {
+      cropHeight = (int) ((long) bufferWidth * height / width);
+    }
+    return buffer.cropAndScale((bufferWidth - cropWidth) / 2, (bufferHeight - cropHeight) / 2,
+        cropWidth, cropHeight, width, height);
+  }
+
   private VideoCodecStatus encodeByteBuffer(VideoFrame videoFrame, long presentationTimestampUs) {
     encodeThreadChecker.checkIsOnValidThread();
     // No timeout.  Don't block for an input buffer, drop frames if the encoder falls behind.
@@ -466,6 +509,14 @@ class HardwareVideoEncoder implements VideoEncoder {
       return VideoCodecStatus.ERROR;
     }
 
+    if (videoFrame.getBuffer() instanceof VideoFrame.TextureBuffer) {
+      // The texture has to be read back, which is what surface mode avoids.
+      if (textureFrameCopyCount++ == 0) {
+        Logging.w(TAG,
+            "Copying texture frames to I420, surface mode is unavailable: "
+                + (surfaceColorFormat == null ? "no surface color format" : "no EGL context"));
+      }
+    }
     fillInputBuffer(buffer, videoFrame.getBuffer());
 
     try {
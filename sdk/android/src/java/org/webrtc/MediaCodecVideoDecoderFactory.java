@@ -28,6 +28,9 @@ class MediaCodecVideoDecoderFactory implements VideoDecoderFactory {
 
   private final @Nullable EglBase.Context sharedContext;
   private final @Nullable Predicate<MediaCodecInfo> codecAllowedPredicate;
+  private final boolean useAsyncMode;
+  // Output surfaces shared by the texture decoders created by this factory.
+  private final @Nullable SurfaceTextureHelperPool surfaceTextureHelperPool;
 
   /**
    * MediaCodecVideoDecoderFactory with support of codecs filtering.
@@ -39,8 +42,27 @@ class MediaCodecVideoDecoderFactory implements VideoDecoderFactory {
    */
   public MediaCodecVideoDecoderFactory(@Nullable EglBase.Context sharedContext,
       @Nullable Predicate<MediaCodecInfo> codecAllowedPredicate) {
+    this(sharedContext, codecAllowedPredicate, /* useAsyncMode= */ false);
+  }
+
+  /**
+   * MediaCodecVideoDecoderFactory with support of codecs filtering and asynchronous decoding.
+   *
+   * @param sharedContext The textures generated will be accessible from this context. May be null,
+   *                      this disables texture support.
+   * @param codecAllowedPredicate optional predicate to test if codec allowed. All codecs are
+   *                              allowed when predicate is not provided.
+   * @param useAsyncMode Whether texture decoders run MediaCodec in asynchronous mode, which
+   *                     delivers output buffers as soon as they are ready instead of polling for
+   *                     them. Requires API 23; older devices keep using synchronous mode.
+   */
+  public MediaCodecVideoDecoderFactory(@Nullable EglBase.Context sharedContext,
+      @Nullable Predicate<MediaCodecInfo> codecAllowedPredicate, boolean useAsyncMode) {
     this.sharedContext = sharedContext;
     this.codecAllowedPredicate = codecAllowedPredicate;
+    this.useAsyncMode = useAsyncMode;
+    this.surfaceTextureHelperPool =
+        sharedContext == null ? null : new SurfaceTextureHelperPool(sharedContext);
   }
 
   @Nullable
@@ -56,7 +78,7 @@ class MediaCodecVideoDecoderFactory implements VideoDecoderFactory {
     CodecCapabilities capabilities = info.getCapabilitiesForType(type.mimeType());
     return new AndroidVideoDecoder(new MediaCodecWrapperFactoryImpl(), info.getName(), type,
         MediaCodecUtils.selectColorFormat(MediaCodecUtils.DECODER_COLOR_FORMATS, capabilities),
-        sharedContext);
+        sharedContext, surfaceTextureHelperPool, useAsyncMode);
   }
 
   @Override
@@ -15,6 +15,7 @@ import android.media.MediaCodecInfo;
 import android.media.MediaCrypto;
 import android.media.MediaFormat;
 import android.os.Bundle;
+import android.os.Handler;
 import android.view.Surface;
 import java.nio.ByteBuffer;
 
@@ -24,6 +25,17 @@ import java.nio.ByteBuffer;
  * exists to allow mocking and using a fake implementation in tests.
  */
 interface MediaCodecWrapper {
+  /** Receives the events of a codec in asynchronous mode, see {@link MediaCodec.Callback}. */
+  interface Callback {
+    void onInputBufferAvailable(int index);
+
+    void onOutputBufferAvailable(int index, MediaCodec.BufferInfo info);
+
+    void onOutputFormatChanged(MediaFormat format);
+
+    void onError(MediaCodec.CodecException e);
+  }
+
   void configure(MediaFormat format, Surface surface, MediaCrypto crypto, int flags);
 
   void start();
@@ -57,4 +69,11 @@ interface MediaCodecWrapper {
   void setParameters(Bundle params);
 
   MediaCodecInfo getCodecInfo();
+
+  /**
+   * Switches the codec to asynchronous mode, where `callback` is called on `handler` instead of
+   * the codec being polled with dequeueInputBuffer() and dequeueOutputBuffer(). Must be called
+   * before configure().
+   */
+  void setCallback(Callback callback, Handler handler);
 }
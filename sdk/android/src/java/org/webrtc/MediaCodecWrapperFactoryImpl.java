@@ -10,12 +10,15 @@
 
 package org.webrtc;
 
+import android.annotation.TargetApi;
 import android.media.MediaCodec;
 import android.media.MediaCodec.BufferInfo;
 import android.media.MediaCodecInfo;
 import android.media.MediaCrypto;
 import android.media.MediaFormat;
+import android.os.Build;
 import android.os.Bundle;
+import android.os.Handler;
 import android.view.Surface;
 import java.io.IOException;
 import java.nio.ByteBuffer;
@@ -117,6 +120,33 @@ class MediaCodecWrapperFactoryImpl implements MediaCodecWrapperFactory {
     public MediaCodecInfo getCodecInfo() {
       return mediaCodec.getCodecInfo();
     }
+
+    @TargetApi(Build.VERSION_CODES.M)
+    @Override
+    public void setCallback(Callback callback, Handler handler) {
+      mediaCodec.setCallback(new MediaCodec.Callback() {
+        @Override
+        public void onInputBufferAvailable(MediaCodec codec, int index) {
+          callback.onInputBufferAvailable(index);
+        }
+
+        @Override
+        public void onOutputBufferAvailable(
+            MediaCodec codec, int index, MediaCodec.BufferInfo info) {
+          callback.onOutputBufferAvailable(index, info);
+        }
+
+        @Override
+        public void onOutputFormatChanged(MediaCodec codec, MediaFormat format) {
+          callback.onOutputFormatChanged(format);
+        }
+
+        @Override
+        public void onError(MediaCodec codec, MediaCodec.CodecException e) {
+          callback.onError(e);
+        }
+      }, handler);
+    }
   }
 
   @Override
@@ -0,0 +1,59 @@
+/*
+ *  Copyright 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+package org.webrtc;
+
+import androidx.annotation.Nullable;
+import java.util.ArrayDeque;
+
+/**
+ * Pool of SurfaceTextureHelpers used as decoder output surfaces. Creating a helper starts a thread
+ * and an EGL context, which is noticeable when decoders are created and released frequently, e.g.
+ * when remote streams come and go in a conference. Released helpers are kept idle, up to a limit,
+ * and handed out to the next decoder. Idle helpers live as long as the pool. This class is thread
+ * safe.
+ */
+class SurfaceTextureHelperPool {
+  private static final String TAG = "SurfaceTextureHelperPool";
+  private static final int MAX_IDLE_HELPERS = 4;
+
+  private final @Nullable EglBase.Context sharedContext;
+  private final ArrayDeque<SurfaceTextureHelper> idleHelpers = new ArrayDeque<>();
+
+  SurfaceTextureHelperPool(@Nullable EglBase.Context sharedContext) {
+    this.sharedContext = sharedContext;
+  }
+
+  /** Returns an idle helper, or creates a new one. Returns null if creation fails. */
+  @Nullable
+  SurfaceTextureHelper acquire() {
+    synchronized (idleHelpers) {
+      if (!idleHelpers.isEmpty()) {
+        return idleHelpers.pop();
+      }
+    }
+    return SurfaceTextureHelper.create("decoder-texture-thread", sharedContext);
+  }
+
+  /**
+   * Returns a helper to the pool. The caller must have called stopListening() and must not use
+   * the helper afterwards.
+   */
+  void release(SurfaceTextureHelper helper) {
+    synchronized (idleHelpers) {
+      if (idleHelpers.size() < MAX_IDLE_HELPERS) {
+        idleHelpers.push(helper);
+        return;
+      }
+    }
+    Logging.d(TAG, "Pool is full, disposing helper");
+    helper.dispose();
+  }
+}
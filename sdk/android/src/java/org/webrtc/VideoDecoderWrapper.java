@@ -18,10 +18,14 @@ import org.webrtc.VideoDecoder;
 class VideoDecoderWrapper {
   @CalledByNative
   static VideoDecoder.Callback createDecoderCallback(final long nativeDecoder) {
-    return (VideoFrame frame, Integer decodeTimeMs,
-               Integer qp) -> nativeOnDecodedFrame(nativeDecoder, frame, decodeTimeMs, qp);
+    // Frames are passed unpacked, with -1 for missing values, so that the native side doesn't
+    // have to call back into Java for each field.
+    return (VideoFrame frame, Integer decodeTimeMs, Integer qp)
+               -> nativeOnDecodedFrame(nativeDecoder, frame.getBuffer(), frame.getRotation(),
+                   frame.getTimestampNs(), decodeTimeMs == null ? -1 : decodeTimeMs,
+                   qp == null ? -1 : qp);
   }
 
-  private static native void nativeOnDecodedFrame(
-      long nativeVideoDecoderWrapper, VideoFrame frame, Integer decodeTimeMs, Integer qp);
+  private static native void nativeOnDecodedFrame(long nativeVideoDecoderWrapper,
+      VideoFrame.Buffer buffer, int rotation, long timestampNs, int decodeTimeMs, int qp);
 }
@@ -132,10 +132,8 @@ void AndroidVideoTrackSource::OnFrameCaptured(
       JavaToNativeFrameBuffer(env, j_video_frame_buffer);
   const VideoRotation rotation = jintToVideoRotation(j_rotation);
 
-  // AdaptedVideoTrackSource handles applying rotation for I420 frames.
-  if (apply_rotation() && rotation != kVideoRotation_0)
-    buffer = buffer->ToI420();
-
+  // The VideoBroadcaster converts and rotates the frame for the sinks that
+  // want rotation applied, other sinks get the native buffer.
   OnFrame(VideoFrame::Builder()
               .set_video_frame_buffer(buffer)
               .set_rotation(rotation)
@@ -34,12 +34,6 @@ namespace jni {
 namespace {
 // RTP timestamps are 90 kHz.
 const int64_t kNumRtpTicksPerMillisec = 90000 / rtc::kNumMillisecsPerSec;
-
-template <typename Dst, typename Src>
-inline absl::optional<Dst> cast_optional(const absl::optional<Src>& value) {
-  return value ? absl::optional<Dst>(rtc::dchecked_cast<Dst, Src>(*value))
-               : absl::nullopt;
-}
 }  // namespace
 
 VideoDecoderWrapper::VideoDecoderWrapper(JNIEnv* jni,
@@ -160,11 +154,12 @@ VideoDecoder::DecoderInfo VideoDecoderWrapper::GetDecoderInfo() const {
 
 void VideoDecoderWrapper::OnDecodedFrame(
     JNIEnv* env,
-    const JavaRef<jobject>& j_frame,
-    const JavaRef<jobject>& j_decode_time_ms,
-    const JavaRef<jobject>& j_qp) {
+    const JavaRef<jobject>& j_buffer,
+    jint rotation,
+    jlong timestamp_ns,
+    jint decode_time_ms,
+    jint qp) {
   RTC_DCHECK_RUNS_SERIALIZED(&callback_race_checker_);
-  const int64_t timestamp_ns = GetJavaVideoFrameTimestampNs(env, j_frame);
 
   FrameExtraInfo frame_extra_info;
   {
@@ -185,14 +180,23 @@ void VideoDecoderWrapper::OnDecodedFrame(
   }
 
   VideoFrame frame =
-      JavaToNativeFrame(env, j_frame, frame_extra_info.timestamp_rtp);
+      VideoFrame::Builder()
+          .set_video_frame_buffer(JavaToNativeFrameBuffer(env, j_buffer))
+          .set_timestamp_rtp(frame_extra_info.timestamp_rtp)
+          .set_timestamp_ms(timestamp_ns / rtc::kNumNanosecsPerMillisec)
+          .set_rotation(static_cast<VideoRotation>(rotation))
+          .build();
   frame.set_ntp_time_ms(frame_extra_info.timestamp_ntp);
 
-  absl::optional<int32_t> decoding_time_ms =
-      JavaToNativeOptionalInt(env, j_decode_time_ms);
+  absl::optional<int32_t> decoding_time_ms;
+  if (decode_time_ms >= 0) {
+    decoding_time_ms = decode_time_ms;
+  }
 
-  absl::optional<uint8_t> decoder_qp =
-      cast_optional<uint8_t, int32_t>(JavaToNativeOptionalInt(env, j_qp));
+  absl::optional<uint8_t> decoder_qp;
+  if (qp >= 0) {
+    decoder_qp = rtc::dchecked_cast<uint8_t>(qp);
+  }
   // If the decoder provides QP values itself, no need to parse the bitstream.
   // Enable QP parsing if decoder does not provide QP values itself.
   qp_parsing_enabled_ = !decoder_qp.has_value();
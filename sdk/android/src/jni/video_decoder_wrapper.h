@@ -53,11 +53,15 @@ class VideoDecoderWrapper : public VideoDecoder {
 
   DecoderInfo GetDecoderInfo() const override;
 
-  // Wraps the frame to a AndroidVideoBuffer and passes it to the callback.
+  // Wraps the frame buffer to a AndroidVideoBuffer and passes it to the
+  // callback. `decode_time_ms` and `qp` are -1 when the decoder doesn't report
+  // them.
   void OnDecodedFrame(JNIEnv* env,
-                      const JavaRef<jobject>& j_frame,
-                      const JavaRef<jobject>& j_decode_time_ms,
-                      const JavaRef<jobject>& j_qp);
+                      const JavaRef<jobject>& j_buffer,
+                      jint rotation,
+                      jlong timestamp_ns,
+                      jint decode_time_ms,
+                      jint qp);
 
  private:
   struct FrameExtraInfo {
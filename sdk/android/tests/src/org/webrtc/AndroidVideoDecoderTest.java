@@ -18,12 +18,14 @@ import static org.mockito.ArgumentMatchers.eq;
 import static org.mockito.Mockito.doThrow;
 import static org.mockito.Mockito.inOrder;
 import static org.mockito.Mockito.mock;
+import static org.mockito.Mockito.never;
 import static org.mockito.Mockito.spy;
 import static org.mockito.Mockito.verify;
 import static org.mockito.Mockito.when;
 
 import android.graphics.Matrix;
 import android.graphics.SurfaceTexture;
+import android.media.MediaCodec;
 import android.media.MediaCodecInfo.CodecCapabilities;
 import android.media.MediaFormat;
 import android.os.Handler;
@@ -63,8 +65,10 @@ public class AndroidVideoDecoderTest {
     private boolean deliverDecodedFrameDone = true;
 
     public TestDecoder(MediaCodecWrapperFactory mediaCodecFactory, String codecName,
-        VideoCodecMimeType codecType, int colorFormat, EglBase.Context sharedContext) {
-      super(mediaCodecFactory, codecName, codecType, colorFormat, sharedContext);
+        VideoCodecMimeType codecType, int colorFormat, EglBase.Context sharedContext,
+        boolean useAsyncMode) {
+      super(mediaCodecFactory, codecName, codecType, colorFormat, sharedContext,
+          /* surfaceTextureHelperPool= */ null, useAsyncMode);
     }
 
     public void waitDeliverDecodedFrame() throws InterruptedException {
@@ -146,6 +150,7 @@ public class AndroidVideoDecoderTest {
   private class TestDecoderBuilder {
     private VideoCodecMimeType codecType = VideoCodecMimeType.VP8;
     private boolean useSurface = true;
+    private boolean useAsyncMode;
 
     public TestDecoderBuilder setCodecType(VideoCodecMimeType codecType) {
       this.codecType = codecType;
@@ -157,11 +162,16 @@ public class AndroidVideoDecoderTest {
       return this;
     }
 
+    public TestDecoderBuilder setUseAsyncMode(boolean useAsyncMode) {
+      this.useAsyncMode = useAsyncMode;
+      return this;
+    }
+
     public TestDecoder build() {
       return new TestDecoder((String name)
                                  -> fakeMediaCodecWrapper,
           /* codecName= */ "org.webrtc.testdecoder", codecType, COLOR_FORMAT,
-          useSurface ? mockEglBaseContext : null);
+          useSurface ? mockEglBaseContext : null, useAsyncMode);
     }
   }
 
@@ -333,6 +343,32 @@ public class AndroidVideoDecoderTest {
     verify(fakeMediaCodecWrapper).releaseOutputBuffer(bufferIndex, /* render= */ true);
   }
 
+  @Test
+  public void testAsyncModeRendersOutputTexture() {
+    // Set-up.
+    TestDecoder decoder = new TestDecoderBuilder().setUseAsyncMode(true).build();
+    decoder.initDecode(TEST_DECODER_SETTINGS, mockDecoderCallback);
+    MediaCodecWrapper.Callback codecCallback = fakeMediaCodecWrapper.getCallback();
+    assertThat(codecCallback).isNotNull();
+
+    // Test.
+    codecCallback.onInputBufferAvailable(/* index= */ 1);
+    assertThat(decoder.decode(createTestEncodedImage(),
+                   new DecodeInfo(/* isMissingFrames= */ false, /* renderTimeMs= */ 0)))
+        .isEqualTo(VideoCodecStatus.OK);
+    int bufferIndex =
+        fakeMediaCodecWrapper.addOutputTexture(/* presentationTimestampUs= */ 0, /* flags= */ 0);
+    codecCallback.onOutputBufferAvailable(bufferIndex, new MediaCodec.BufferInfo());
+
+    // Verify.
+    verify(fakeMediaCodecWrapper, never()).dequeueInputBuffer(anyLong());
+    verify(fakeMediaCodecWrapper)
+        .queueInputBuffer(eq(1), eq(0), eq(ENCODED_TEST_DATA.length), anyLong(), eq(0));
+    verify(fakeMediaCodecWrapper).releaseOutputBuffer(bufferIndex, /* render= */ true);
+    assertThat(decoder.release()).isEqualTo(VideoCodecStatus.OK);
+    assertThat(fakeMediaCodecWrapper.getState()).isEqualTo(State.RELEASED);
+  }
+
   @Test
   public void testSurfaceTextureStall_FramesDropped() throws InterruptedException {
     final int numFrames = 10;
@@ -17,6 +17,7 @@ import android.media.MediaCodecInfo.CodecCapabilities;
 import android.media.MediaCrypto;
 import android.media.MediaFormat;
 import android.os.Bundle;
+import android.os.Handler;
 import android.view.Surface;
 import androidx.annotation.Nullable;
 import java.nio.ByteBuffer;
@@ -110,6 +111,7 @@ public class FakeMediaCodecWrapper implements MediaCodecWrapper {
   private final boolean[] inputBufferReserved = new boolean[NUM_INPUT_BUFFERS];
   private final boolean[] outputBufferReserved = new boolean[NUM_OUTPUT_BUFFERS];
   private final List<QueuedOutputBufferInfo> queuedOutputBuffers = new ArrayList<>();
+  private @Nullable Callback callback;
 
   public FakeMediaCodecWrapper() {}
 
@@ -123,6 +125,11 @@ public class FakeMediaCodecWrapper implements MediaCodecWrapper {
     return configuredFormat;
   }
 
+  /** Returns the callback passed to setCallback, or null if the codec is in synchronous mode. */
+  public @Nullable Callback getCallback() {
+    return callback;
+  }
+
   /** Returns the last flags passed to configure. */
   public int getConfiguredFlags() {
     return configuredFlags;
@@ -324,4 +331,12 @@ public class FakeMediaCodecWrapper implements MediaCodecWrapper {
   public MediaCodecInfo getCodecInfo() {
     return null;
   }
+
+  @Override
+  public void setCallback(Callback callback, Handler handler) {
+    if (state != State.STOPPED_UNINITIALIZED) {
+      throw new IllegalStateException("Expected state STOPPED_UNINITIALIZED but was " + state);
+    }
+    this.callback = callback;
+  }
 }
@@ -15,6 +15,7 @@
 #include "common_video/libyuv/include/webrtc_libyuv.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/synchronization/mutex.h"
 #include "third_party/libyuv/include/libyuv.h"
 
 #if !defined(NDEBUG) && defined(WEBRTC_IOS)
@@ -22,6 +23,61 @@
 #import <VideoToolbox/VideoToolbox.h>
 #endif
 
+namespace {
+
+// Pool of the intermediate buffers that RGB frames are scaled into by toI420.
+// Capturers deliver frames of a single size and format, so one pool is kept
+// and recreated when those change, instead of allocating a new buffer for
+// every frame.
+class ScaledPixelBufferPool {
+ public:
+  CVPixelBufferRef CreatePixelBuffer(int width, int height, OSType pixelFormat) {
+    webrtc::MutexLock lock(&mutex_);
+    if (!pool_ || width != width_ || height != height_ || pixelFormat != pixelFormat_) {
+      if (pool_) {
+        CVPixelBufferPoolRelease(pool_);
+        pool_ = nullptr;
+      }
+      width_ = width;
+      height_ = height;
+      pixelFormat_ = pixelFormat;
+      NSDictionary* attributes = @{
+        (NSString*)kCVPixelBufferWidthKey : @(width),
+        (NSString*)kCVPixelBufferHeightKey : @(height),
+        (NSString*)kCVPixelBufferPixelFormatTypeKey : @(pixelFormat),
+        (NSString*)kCVPixelBufferIOSurfacePropertiesKey : @{},
+      };
+      CVReturn ret = CVPixelBufferPoolCreate(
+          nullptr, nullptr, (__bridge CFDictionaryRef)attributes, &pool_);
+      if (ret != kCVReturnSuccess) {
+        RTC_LOG(LS_WARNING) << "Failed to create pixel buffer pool: " << ret;
+        pool_ = nullptr;
+      }
+    }
+    CVPixelBufferRef pixelBuffer = nullptr;
+    if (pool_ &&
+        CVPixelBufferPoolCreatePixelBuffer(nullptr, pool_, &pixelBuffer) == kCVReturnSuccess) {
+      return pixelBuffer;
+    }
+    CVPixelBufferCreate(nullptr, width, height, pixelFormat, nullptr, &pixelBuffer);
+    return pixelBuffer;
+  }
+
+ private:
+  webrtc::Mutex mutex_;
+  CVPixelBufferPoolRef pool_ RTC_GUARDED_BY(mutex_) = nullptr;
+  int width_ RTC_GUARDED_BY(mutex_) = 0;
+  int height_ RTC_GUARDED_BY(mutex_) = 0;
+  OSType pixelFormat_ RTC_GUARDED_BY(mutex_) = 0;
+};
+
+ScaledPixelBufferPool* GetScaledPixelBufferPool() {
+  static ScaledPixelBufferPool* const pool = new ScaledPixelBufferPool();
+  return pool;
+}
+
+}  // namespace
+
 @implementation RTC_OBJC_TYPE (RTCCVPixelBuffer) {
   int _width;
   int _height;
@@ -191,8 +247,8 @@
       srcY += srcYStride * _cropY + _cropX;
       srcUV += srcUVStride * (_cropY / 2) + _cropX;
 
-      // TODO(magjed): Use a frame buffer pool.
-      webrtc::NV12ToI420Scaler nv12ToI420Scaler;
+      // Keep the scaler, and with it its temporary chroma planes, per thread.
+      static thread_local webrtc::NV12ToI420Scaler nv12ToI420Scaler;
       nv12ToI420Scaler.NV12ToI420Scale(srcY,
                                        srcYStride,
                                        srcUV,
@@ -212,20 +268,23 @@
     case kCVPixelFormatType_32BGRA:
     case kCVPixelFormatType_32ARGB: {
       CVPixelBufferRef scaledPixelBuffer = NULL;
-      CVPixelBufferRef sourcePixelBuffer = NULL;
-      if ([self requiresCropping] ||
-          [self requiresScalingToWidth:i420Buffer.width height:i420Buffer.height]) {
-        CVPixelBufferCreate(
-            NULL, i420Buffer.width, i420Buffer.height, pixelFormat, NULL, &scaledPixelBuffer);
+      const uint8_t* src = NULL;
+      size_t bytesPerRow = 0;
+      if ([self requiresScalingToWidth:i420Buffer.width height:i420Buffer.height]) {
+        scaledPixelBuffer = GetScaledPixelBufferPool()->CreatePixelBuffer(
+            i420Buffer.width, i420Buffer.height, pixelFormat);
         [self cropAndScaleTo:scaledPixelBuffer withTempBuffer:NULL];
 
         CVPixelBufferLockBaseAddress(scaledPixelBuffer, kCVPixelBufferLock_ReadOnly);
-        sourcePixelBuffer = scaledPixelBuffer;
+        src = static_cast<uint8_t*>(CVPixelBufferGetBaseAddress(scaledPixelBuffer));
+        bytesPerRow = CVPixelBufferGetBytesPerRow(scaledPixelBuffer);
       } else {
-        sourcePixelBuffer = _pixelBuffer;
+        // Crop just by modifying pointers, no intermediate buffer is needed.
+        const int bytesPerPixel = 4;
+        bytesPerRow = CVPixelBufferGetBytesPerRow(_pixelBuffer);
+        src = static_cast<uint8_t*>(CVPixelBufferGetBaseAddress(_pixelBuffer)) +
+            bytesPerRow * _cropY + _cropX * bytesPerPixel;
       }
-      const uint8_t* src = static_cast<uint8_t*>(CVPixelBufferGetBaseAddress(sourcePixelBuffer));
-      const size_t bytesPerRow = CVPixelBufferGetBytesPerRow(sourcePixelBuffer);
 
       if (pixelFormat == kCVPixelFormatType_32BGRA) {
         // Corresponds to libyuv::FOURCC_ARGB
@@ -113,17 +113,10 @@ void ObjCVideoTrackSource::OnCapturedFrame(RTC_OBJC_TYPE(RTCVideoFrame) * frame)
     buffer = i420_buffer;
   }
 
-  // Applying rotation is only supported for legacy reasons and performance is
-  // not critical here.
-  VideoRotation rotation = static_cast<VideoRotation>(frame.rotation);
-  if (apply_rotation() && rotation != kVideoRotation_0) {
-    buffer = I420Buffer::Rotate(*buffer->ToI420(), rotation);
-    rotation = kVideoRotation_0;
-  }
-
+  // The VideoBroadcaster applies the rotation for the sinks that want it.
   OnFrame(VideoFrame::Builder()
               .set_video_frame_buffer(buffer)
-              .set_rotation(rotation)
+              .set_rotation(static_cast<VideoRotation>(frame.rotation))
               .set_timestamp_us(translated_timestamp_us)
               .build());
 }
@@ -0,0 +1,219 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "stats/rtc_stats_binary_encoder.h"
+
+#include <string.h>
+
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "absl/types/variant.h"
+#include "api/stats/attribute.h"
+#include "api/units/timestamp.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+namespace {
+
+void WriteVarInt(uint64_t value, std::string* output) {
+  while (value >= 0x80) {
+    output->push_back(static_cast<char>(0x80 | (value & 0x7f)));
+    value >>= 7;
+  }
+  output->push_back(static_cast<char>(value));
+}
+
+// Maps signed integers to unsigned ones with small magnitudes for small
+// absolute values: 0, -1, 1, -2, ... become 0, 1, 2, 3, ...
+void WriteSignedVarInt(int64_t value, std::string* output) {
+  WriteVarInt((static_cast<uint64_t>(value) << 1) ^
+                  static_cast<uint64_t>(value >> 63),
+              output);
+}
+
+void WriteString(absl::string_view value, std::string* output) {
+  WriteVarInt(value.size(), output);
+  output->append(value.data(), value.size());
+}
+
+void WriteValue(bool value, const bool* /*previous*/, std::string* output) {
+  output->push_back(value ? 1 : 0);
+}
+
+template <typename T,
+          typename std::enable_if_t<std::is_integral_v<T> &&
+                                        !std::is_same_v<T, bool>,
+                                    bool> = true>
+void WriteValue(T value, const T* previous, std::string* output) {
+  // The difference is computed in unsigned arithmetic, which wraps around
+  // instead of overflowing.
+  uint64_t difference = static_cast<uint64_t>(static_cast<int64_t>(value)) -
+                        static_cast<uint64_t>(static_cast<int64_t>(
+                            previous ? *previous : T(0)));
+  WriteSignedVarInt(static_cast<int64_t>(difference), output);
+}
+
+void WriteValue(double value, const double* previous, std::string* output) {
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  if (previous) {
+    uint64_t previous_bits;
+    memcpy(&previous_bits, previous, sizeof(previous_bits));
+    bits ^= previous_bits;
+  }
+  // Reversing the bytes moves the low mantissa bits, which are zero for
+  // doubles without many significant bits, to the top.
+  uint64_t reversed = 0;
+  for (size_t i = 0; i < sizeof(bits); ++i) {
+    reversed = (reversed << 8) | ((bits >> (8 * i)) & 0xff);
+  }
+  WriteVarInt(reversed, output);
+}
+
+void WriteValue(const std::string& value,
+                const std::string* /*previous*/,
+                std::string* output) {
+  WriteString(value, output);
+}
+
+template <typename T>
+void WriteValue(const std::vector<T>& value,
+                const std::vector<T>* /*previous*/,
+                std::string* output) {
+  WriteVarInt(value.size(), output);
+  for (const T& element : value) {
+    WriteValue(element, static_cast<const T*>(nullptr), output);
+  }
+}
+
+template <typename T>
+void WriteValue(const std::map<std::string, T>& value,
+                const std::map<std::string, T>* /*previous*/,
+                std::string* output) {
+  WriteVarInt(value.size(), output);
+  for (const auto& [key, element] : value) {
+    WriteString(key, output);
+    WriteValue(element, static_cast<const T*>(nullptr), output);
+  }
+}
+
+void WriteAttributeValue(const Attribute& attribute,
+                         const Attribute* previous,
+                         std::string* output) {
+  absl::visit(
+      [&](const auto* optional) {
+        using T = typename std::remove_const_t<
+            std::remove_pointer_t<decltype(optional)>>::value_type;
+        const T* previous_value = nullptr;
+        if (previous && previous->holds_alternative<T>() &&
+            previous->has_value()) {
+          previous_value = &previous->get<T>();
+        }
+        WriteValue(optional->value(), previous_value, output);
+      },
+      attribute.as_variant());
+}
+
+}  // namespace
+
+RTCStatsBinaryEncoder::RTCStatsBinaryEncoder() = default;
+
+RTCStatsBinaryEncoder::~RTCStatsBinaryEncoder() = default;
+
+std::string RTCStatsBinaryEncoder::Encode(const RTCStatsReport& report) {
+  std::string output;
+  const Timestamp previous_timestamp =
+      Timestamp::Micros(previous_timestamp_us_);
+  WriteSignedVarInt(report.timestamp().us() - previous_timestamp_us_, &output);
+  previous_timestamp_us_ = report.timestamp().us();
+
+  std::vector<std::string> removed_ids;
+  for (const auto& [id, stats] : previous_stats_) {
+    if (!report.Get(id)) {
+      removed_ids.push_back(id);
+    }
+  }
+  WriteVarInt(removed_ids.size(), &output);
+  for (const std::string& id : removed_ids) {
+    WriteInternedString(id, &output);
+    previous_stats_.erase(id);
+  }
+
+  std::vector<const RTCStats*> changed_stats;
+  for (const RTCStats& stats : report) {
+    auto it = previous_stats_.find(stats.id());
+    if (it == previous_stats_.end() || *it->second != stats ||
+        it->second->timestamp() - previous_timestamp !=
+            stats.timestamp() - report.timestamp()) {
+      changed_stats.push_back(&stats);
+    }
+  }
+  WriteVarInt(changed_stats.size(), &output);
+  for (const RTCStats* stats : changed_stats) {
+    auto it = previous_stats_.find(stats->id());
+    const RTCStats* previous =
+        it != previous_stats_.end() ? it->second.get() : nullptr;
+    WriteInternedString(stats->id(), &output);
+    if (!previous) {
+      WriteInternedString(stats->type(), &output);
+    }
+    WriteSignedVarInt((stats->timestamp() - report.timestamp()).us(), &output);
+
+    std::vector<Attribute> attributes = stats->Attributes();
+    std::vector<Attribute> previous_attributes;
+    if (previous) {
+      previous_attributes = previous->Attributes();
+      RTC_DCHECK_EQ(attributes.size(), previous_attributes.size());
+    }
+    std::vector<size_t> changed_indices;
+    for (size_t i = 0; i < attributes.size(); ++i) {
+      if (previous ? attributes[i] != previous_attributes[i]
+                   : attributes[i].has_value()) {
+        changed_indices.push_back(i);
+      }
+    }
+    WriteVarInt(changed_indices.size(), &output);
+    for (size_t i : changed_indices) {
+      WriteVarInt((i << 1) | (attributes[i].has_value() ? 1 : 0), &output);
+      if (attributes[i].has_value()) {
+        WriteAttributeValue(attributes[i],
+                            previous ? &previous_attributes[i] : nullptr,
+                            &output);
+      }
+    }
+    previous_stats_[stats->id()] = stats->copy();
+  }
+  return output;
+}
+
+void RTCStatsBinaryEncoder::Reset() {
+  previous_timestamp_us_ = 0;
+  previous_stats_.clear();
+  interned_strings_.clear();
+}
+
+void RTCStatsBinaryEncoder::WriteInternedString(absl::string_view string,
+                                                std::string* output) {
+  auto it = interned_strings_.find(string);
+  if (it != interned_strings_.end()) {
+    WriteVarInt(it->second << 1, output);
+    return;
+  }
+  uint64_t index = interned_strings_.size();
+  interned_strings_.emplace(std::string(string), index);
+  WriteVarInt((index << 1) | 1, output);
+  WriteString(string, output);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,86 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef STATS_RTC_STATS_BINARY_ENCODER_H_
+#define STATS_RTC_STATS_BINARY_ENCODER_H_
+
+#include <stdint.h>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "api/stats/rtc_stats.h"
+#include "api/stats/rtc_stats_report.h"
+#include "rtc_base/system/rtc_export.h"
+
+namespace webrtc {
+
+// Encodes a sequence of RTCStatsReports, e.g. those of one PeerConnection, into
+// a compact binary format. Each report is encoded relative to the previous one:
+// only the stats objects that were added, removed or had members changed are
+// written, and of those only the changed members.
+//
+// The attributes are identified by their index in RTCStats::Attributes(), so
+// the decoder needs to know the attributes of each stats type. Stats ids and
+// types are interned: the first time a string is written it is assigned the
+// next index, which is written in its place from then on.
+//
+// All integers are written as varints (7 bits per byte, least significant
+// first). Signed values are zigzag encoded. A report is written as:
+//   timestamp in us, minus that of the previous report (signed)
+//   number of removed stats objects, followed by their interned ids
+//   number of added or changed stats objects, followed by for each:
+//     interned id
+//     interned type, only if the id was not in the previous report
+//     timestamp in us, minus that of the report (signed)
+//     number of changed attributes, followed by for each:
+//       index << 1 | has_value
+//       the value, only if has_value
+// An interned string is written as index << 1 | is_new, followed by the length
+// and the characters if it is new. Integer values are written as the
+// difference to the previous value of the attribute (signed), or to zero if it
+// had none. Doubles are XORed with the previous value and written as a varint
+// with their bytes reversed, so that small changes of doubles without many
+// significant bits take few bytes. Sequences and maps are written as their size
+// followed by the elements, which are not delta encoded. Strings are written
+// as their length followed by the characters.
+//
+// Stats objects that are not written keep their members and their timestamp
+// relative to that of the report.
+class RTC_EXPORT RTCStatsBinaryEncoder {
+ public:
+  RTCStatsBinaryEncoder();
+  ~RTCStatsBinaryEncoder();
+
+  RTCStatsBinaryEncoder(const RTCStatsBinaryEncoder&) = delete;
+  RTCStatsBinaryEncoder& operator=(const RTCStatsBinaryEncoder&) = delete;
+
+  // Encodes `report` relative to the previously encoded report.
+  std::string Encode(const RTCStatsReport& report);
+
+  // Forgets the previously encoded reports and the interned strings, e.g.
+  // when the receiver of the encoded reports changes. The next report is
+  // encoded in full.
+  void Reset();
+
+ private:
+  void WriteInternedString(absl::string_view string, std::string* output);
+
+  int64_t previous_timestamp_us_ = 0;
+  std::map<std::string, std::unique_ptr<const RTCStats>> previous_stats_;
+  std::map<std::string, uint64_t, std::less<>> interned_strings_;
+};
+
+}  // namespace webrtc
+
+#endif  // STATS_RTC_STATS_BINARY_ENCODER_H_
@@ -0,0 +1,96 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "stats/rtc_stats_binary_encoder.h"
+
+#include <memory>
+#include <string>
+
+#include "api/stats/rtc_stats_report.h"
+#include "stats/test/rtc_test_stats.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+rtc::scoped_refptr<RTCStatsReport> CreateReport(Timestamp timestamp,
+                                                int64_t counter) {
+  rtc::scoped_refptr<RTCStatsReport> report = RTCStatsReport::Create(timestamp);
+  auto stats = std::make_unique<RTCTestStats>("RTCTestStatsID", timestamp);
+  stats->m_bool = true;
+  stats->m_int64 = counter;
+  stats->m_double = 1000.0 + counter;
+  stats->m_string = "a string that does not change";
+  stats->m_sequence_uint32 = std::vector<uint32_t>{1, 2, 3};
+  report->AddStats(std::move(stats));
+  return report;
+}
+
+}  // namespace
+
+TEST(RTCStatsBinaryEncoderTest, EncodesFirstReportInFull) {
+  RTCStatsBinaryEncoder encoder;
+  std::string encoded = encoder.Encode(*CreateReport(Timestamp::Micros(0), 1));
+  // No change of timestamp, no removed stats and one changed stats object.
+  ASSERT_GE(encoded.size(), 3u);
+  EXPECT_EQ(encoded[0], 0);
+  EXPECT_EQ(encoded[1], 0);
+  EXPECT_EQ(encoded[2], 1);
+  // The id is interned as string 0 and the type as string 1.
+  std::string id = "RTCTestStatsID";
+  EXPECT_EQ(encoded[3], 1);
+  EXPECT_EQ(encoded.substr(4, 1 + id.size()),
+            std::string(1, static_cast<char>(id.size())) + id);
+  EXPECT_NE(encoded.find("a string that does not change"), std::string::npos);
+}
+
+TEST(RTCStatsBinaryEncoderTest, EncodesUnchangedReportInFewBytes) {
+  RTCStatsBinaryEncoder encoder;
+  encoder.Encode(*CreateReport(Timestamp::Micros(0), 1));
+  // Timestamp, no removed stats and no changed stats objects.
+  EXPECT_EQ(encoder.Encode(*CreateReport(Timestamp::Micros(1), 1)),
+            std::string("\x02\x00\x00", 3));
+}
+
+TEST(RTCStatsBinaryEncoderTest, EncodesOnlyChangedAttributes) {
+  RTCStatsBinaryEncoder encoder;
+  rtc::scoped_refptr<RTCStatsReport> report =
+      CreateReport(Timestamp::Micros(0), 1);
+  std::string full = encoder.Encode(*report);
+  std::string delta = encoder.Encode(*CreateReport(Timestamp::Micros(0), 2));
+  EXPECT_LT(delta.size(), full.size());
+  EXPECT_LT(delta.size(), report->ToJson().size() / 10);
+  EXPECT_EQ(delta.find("a string that does not change"), std::string::npos);
+  // The interned id, the timestamp and the two changed attributes follow the
+  // report header.
+  ASSERT_GE(delta.size(), 6u);
+  EXPECT_EQ(delta[3], 0);
+  EXPECT_EQ(delta[4], 0);
+  EXPECT_EQ(delta[5], 2);
+}
+
+TEST(RTCStatsBinaryEncoderTest, EncodesRemovedStats) {
+  RTCStatsBinaryEncoder encoder;
+  encoder.Encode(*CreateReport(Timestamp::Micros(0), 1));
+  // No change of timestamp, one removed stats object with interned id 0 and no
+  // changed stats objects.
+  EXPECT_EQ(encoder.Encode(*RTCStatsReport::Create(Timestamp::Micros(0))),
+            std::string("\x00\x01\x00\x00", 4));
+}
+
+TEST(RTCStatsBinaryEncoderTest, EncodesInFullAfterReset) {
+  RTCStatsBinaryEncoder encoder;
+  std::string full = encoder.Encode(*CreateReport(Timestamp::Micros(0), 1));
+  encoder.Reset();
+  EXPECT_EQ(encoder.Encode(*CreateReport(Timestamp::Micros(0), 1)), full);
+}
+
+}  // namespace webrtc
@@ -158,7 +158,11 @@ const char* RTCRemoteIceCandidateStats::type() const {
 // clang-format off
 WEBRTC_RTCSTATS_IMPL(RTCPeerConnectionStats, RTCStats, "peer-connection",
     AttributeInit("dataChannelsOpened", &data_channels_opened),
-    AttributeInit("dataChannelsClosed", &data_channels_closed))
+    AttributeInit("dataChannelsClosed", &data_channels_closed),
+    AttributeInit("setupTimeline", &setup_timeline),
+    AttributeInit("memoryUsageBytes", &memory_usage_bytes),
+    AttributeInit("memoryUsageBytesByComponent",
+                  &memory_usage_bytes_by_component))
 // clang-format on
 
 RTCPeerConnectionStats::RTCPeerConnectionStats(std::string id,
@@ -274,7 +278,8 @@ WEBRTC_RTCSTATS_IMPL(
     AttributeInit("relativePacketArrivalDelay", &relative_packet_arrival_delay),
     AttributeInit("interruptionCount", &interruption_count),
     AttributeInit("totalInterruptionDuration", &total_interruption_duration),
-    AttributeInit("minPlayoutDelay", &min_playout_delay))
+    AttributeInit("minPlayoutDelay", &min_playout_delay),
+    AttributeInit("totalDecodeCpuTime", &total_decode_cpu_time))
 // clang-format on
 
 RTCInboundRtpStreamStats::RTCInboundRtpStreamStats(std::string id,
@@ -317,7 +322,8 @@ WEBRTC_RTCSTATS_IMPL(
     AttributeInit("active", &active),
     AttributeInit("powerEfficientEncoder", &power_efficient_encoder),
     AttributeInit("scalabilityMode", &scalability_mode),
-    AttributeInit("rtxSsrc", &rtx_ssrc))
+    AttributeInit("rtxSsrc", &rtx_ssrc),
+    AttributeInit("totalEncodeCpuTime", &total_encode_cpu_time))
 // clang-format on
 
 RTCOutboundRtpStreamStats::RTCOutboundRtpStreamStats(std::string id,
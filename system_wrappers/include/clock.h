@@ -79,6 +79,44 @@ class SimulatedClock : public Clock {
   std::atomic<int64_t> time_us_;
 };
 
+// Clock that reads `clock` at most once per ScopedClockCache on the calling
+// thread and returns that time for all reads within the scope. Outside of a
+// scope it reads `clock` every time. Lets components that read the clock many
+// times for what is logically the same instant, e.g. once per packet while
+// sending a burst, opt into a single read per iteration of their task queue
+// loop.
+class CachingClock : public Clock {
+ public:
+  explicit CachingClock(Clock* clock);
+  ~CachingClock() override;
+
+  Timestamp CurrentTime() override;
+  NtpTime ConvertTimestampToNtpTime(Timestamp timestamp) override;
+
+ private:
+  Clock* const clock_;
+};
+
+// Caches the time read by CachingClocks on the current thread while alive.
+// Meant to be put on the stack for one iteration of a processing loop. Nested
+// scopes share the cache of the outermost one.
+class ScopedClockCache {
+ public:
+  ScopedClockCache();
+  ~ScopedClockCache();
+
+  ScopedClockCache(const ScopedClockCache&) = delete;
+  ScopedClockCache& operator=(const ScopedClockCache&) = delete;
+
+ private:
+  friend class CachingClock;
+
+  const bool is_outermost_;
+  // The clock the time was read from and the time read, if any.
+  Clock* clock_ = nullptr;
+  Timestamp time_ = Timestamp::MinusInfinity();
+};
+
 }  // namespace webrtc
 
 #endif  // SYSTEM_WRAPPERS_INCLUDE_CLOCK_H_
@@ -413,7 +413,8 @@ Histogram* HistogramFactoryGetEnumeration(absl::string_view name, int boundary);
 Histogram* SparseHistogramFactoryGetEnumeration(absl::string_view name,
                                                 int boundary);
 
-// Function for adding a `sample` to a histogram.
+// Function for adding a `sample` to a histogram. Thread-safe, and doesn't
+// lock in the default implementation.
 void HistogramAdd(Histogram* histogram_pointer, int sample);
 
 struct SampleInfo {
@@ -436,9 +437,14 @@ void GetAndReset(
     std::map<std::string, std::unique_ptr<SampleInfo>, rtc::AbslStringViewCmp>*
         histograms);
 
+// Gets histograms without clearing samples.
+void GetSnapshot(
+    std::map<std::string, std::unique_ptr<SampleInfo>, rtc::AbslStringViewCmp>*
+        histograms);
+
 // Functions below are mainly for testing.
 
-// Clears all samples.
+// Clears all samples. Must not be called while samples are being added.
 void Reset();
 
 // Returns the number of times the `sample` has been added to the histogram.
@@ -10,11 +10,15 @@
 
 #include "system_wrappers/include/clock.h"
 
+#include "absl/base/attributes.h"
+#include "rtc_base/checks.h"
 #include "rtc_base/time_utils.h"
 
 namespace webrtc {
 namespace {
 
+ABSL_CONST_INIT thread_local ScopedClockCache* current_clock_cache = nullptr;
+
 int64_t NtpOffsetUsCalledOnce() {
   constexpr int64_t kNtpJan1970Sec = 2208988800;
   int64_t clock_time = rtc::TimeMicros();
@@ -99,4 +103,42 @@ void SimulatedClock::AdvanceTime(TimeDelta delta) {
   time_us_.fetch_add(delta.us(), std::memory_order_relaxed);
 }
 
+CachingClock::CachingClock(Clock* clock) : clock_(clock) {
+  RTC_DCHECK(clock_);
+}
+
+CachingClock::~CachingClock() = default;
+
+Timestamp CachingClock::CurrentTime() {
+  ScopedClockCache* const cache = current_clock_cache;
+  if (cache == nullptr) {
+    return clock_->CurrentTime();
+  }
+  if (cache->clock_ != clock_) {
+    // Either the first read in the scope, or a read of another underlying
+    // clock, which can't share the cached time.
+    cache->clock_ = clock_;
+    cache->time_ = clock_->CurrentTime();
+  }
+  return cache->time_;
+}
+
+NtpTime CachingClock::ConvertTimestampToNtpTime(Timestamp timestamp) {
+  return clock_->ConvertTimestampToNtpTime(timestamp);
+}
+
+ScopedClockCache::ScopedClockCache()
+    : is_outermost_(current_clock_cache == nullptr) {
+  if (is_outermost_) {
+    current_clock_cache = this;
+  }
+}
+
+ScopedClockCache::~ScopedClockCache() {
+  if (is_outermost_) {
+    RTC_DCHECK_EQ(current_clock_cache, this);
+    current_clock_cache = nullptr;
+  }
+}
+
 }  // namespace webrtc
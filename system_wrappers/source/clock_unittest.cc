@@ -31,4 +31,33 @@ TEST(ClockTest, NtpTime) {
   EXPECT_GE(milliseconds_upper_bound + 1, ntp_time.ToMs());
 }
 
+TEST(ClockTest, CachingClockReadsOncePerScope) {
+  SimulatedClock clock(Timestamp::Millis(1000));
+  CachingClock caching_clock(&clock);
+  {
+    ScopedClockCache cache;
+    EXPECT_EQ(caching_clock.CurrentTime(), Timestamp::Millis(1000));
+    clock.AdvanceTimeMilliseconds(5);
+    EXPECT_EQ(caching_clock.CurrentTime(), Timestamp::Millis(1000));
+    {
+      ScopedClockCache nested_cache;
+      EXPECT_EQ(caching_clock.CurrentTime(), Timestamp::Millis(1000));
+    }
+    EXPECT_EQ(caching_clock.CurrentTime(), Timestamp::Millis(1000));
+  }
+  EXPECT_EQ(caching_clock.CurrentTime(), Timestamp::Millis(1005));
+  clock.AdvanceTimeMilliseconds(5);
+  EXPECT_EQ(caching_clock.CurrentTime(), Timestamp::Millis(1010));
+}
+
+TEST(ClockTest, CachingClocksOfDifferentClocksDontShareTime) {
+  SimulatedClock clock1(Timestamp::Millis(1000));
+  SimulatedClock clock2(Timestamp::Millis(2000));
+  CachingClock caching_clock1(&clock1);
+  CachingClock caching_clock2(&clock2);
+  ScopedClockCache cache;
+  EXPECT_EQ(caching_clock1.CurrentTime(), Timestamp::Millis(1000));
+  EXPECT_EQ(caching_clock2.CurrentTime(), Timestamp::Millis(2000));
+}
+
 }  // namespace webrtc
@@ -102,6 +102,14 @@ int GetCPUInfo(CPUFeature feature) {
            (cpu_info7[1] & 0x00000020) != 0 /* AVX2 */ &&
            (cpu_info7[1] & 0x00000100) != 0 /* BMI2 */;
   }
+  if (feature == kAVX512F && GetCPUInfo(kAVX2) != 0) {
+    int cpu_info7[4];
+    __cpuid(cpu_info7, 7);
+    // On top of AVX2, the kernel must save the opmask and the upper halves of
+    // the ZMM registers.
+    return (cpu_info7[1] & 0x00010000) != 0 /* AVX512F */ &&
+           (xgetbv(0) & 0x000000E0) == 0xE0 /* ZMM state enabled by kernel */;
+  }
 #endif  // WEBRTC_ENABLE_AVX2
   if (feature == kFMA3) {
     return 0 != (cpu_info[2] & 0x00001000);
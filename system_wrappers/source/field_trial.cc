@@ -19,9 +19,12 @@
 #include "absl/strings/string_view.h"
 #include "experiments/registered_field_trials.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/containers/flat_map.h"
 #include "rtc_base/containers/flat_set.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/string_encode.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
 
 // Simple field trial implementation, which allows client to
 // specify desired flags in InitFieldTrialsFromString.
@@ -79,6 +82,49 @@ bool FieldTrialsStringIsValidInternal(const absl::string_view trials) {
   return true;
 }
 
+#ifndef WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT
+// The global field trial string, parsed on the first lookup after it is set,
+// so that lookups don't have to scan the string.
+struct ParsedTrials {
+  Mutex mutex;
+  bool is_valid RTC_GUARDED_BY(mutex) = false;
+  flat_map<std::string, std::string> trials RTC_GUARDED_BY(mutex);
+};
+
+ParsedTrials& GetParsedTrials() {
+  static auto* parsed_trials = new ParsedTrials();
+  return *parsed_trials;
+}
+
+// Parses the name/group pairs of `trials_string` up to the first malformed
+// one. The first group wins if a name occurs more than once.
+flat_map<std::string, std::string> ParseTrials(
+    absl::string_view trials_string) {
+  flat_map<std::string, std::string> trials;
+  size_t next_item = 0;
+  while (next_item < trials_string.length()) {
+    // Find next name/value pair in field trial configuration string.
+    size_t field_name_end =
+        trials_string.find(kPersistentStringSeparator, next_item);
+    if (field_name_end == trials_string.npos || field_name_end == next_item)
+      break;
+    size_t field_value_end =
+        trials_string.find(kPersistentStringSeparator, field_name_end + 1);
+    if (field_value_end == trials_string.npos ||
+        field_value_end == field_name_end + 1)
+      break;
+    absl::string_view field_name =
+        trials_string.substr(next_item, field_name_end - next_item);
+    absl::string_view field_value = trials_string.substr(
+        field_name_end + 1, field_value_end - field_name_end - 1);
+    next_item = field_value_end + 1;
+
+    trials.emplace(std::string(field_name), std::string(field_value));
+  }
+  return trials;
+}
+#endif  // WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT
+
 }  // namespace
 
 bool FieldTrialsStringIsValid(absl::string_view trials_string) {
@@ -130,32 +176,16 @@ std::string FindFullName(absl::string_view name) {
   if (trials_init_string == NULL)
     return std::string();
 
-  absl::string_view trials_string(trials_init_string);
-  if (trials_string.empty())
-    return std::string();
-
-  size_t next_item = 0;
-  while (next_item < trials_string.length()) {
-    // Find next name/value pair in field trial configuration string.
-    size_t field_name_end =
-        trials_string.find(kPersistentStringSeparator, next_item);
-    if (field_name_end == trials_string.npos || field_name_end == next_item)
-      break;
-    size_t field_value_end =
-        trials_string.find(kPersistentStringSeparator, field_name_end + 1);
-    if (field_value_end == trials_string.npos ||
-        field_value_end == field_name_end + 1)
-      break;
-    absl::string_view field_name =
-        trials_string.substr(next_item, field_name_end - next_item);
-    absl::string_view field_value = trials_string.substr(
-        field_name_end + 1, field_value_end - field_name_end - 1);
-    next_item = field_value_end + 1;
-
-    if (name == field_name)
-      return std::string(field_value);
+  ParsedTrials& parsed = GetParsedTrials();
+  MutexLock lock(&parsed.mutex);
+  if (!parsed.is_valid) {
+    parsed.trials = ParseTrials(trials_init_string);
+    parsed.is_valid = true;
   }
-  return std::string();
+  auto it = parsed.trials.find(name);
+  if (it == parsed.trials.end())
+    return std::string();
+  return it->second;
 }
 #endif  // WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT
 
@@ -167,6 +197,12 @@ void InitFieldTrialsFromString(const char* trials_string) {
         << "Invalid field trials string:" << trials_string;
   };
   trials_init_string = trials_string;
+#ifndef WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT
+  ParsedTrials& parsed = GetParsedTrials();
+  MutexLock lock(&parsed.mutex);
+  parsed.is_valid = false;
+  parsed.trials.clear();
+#endif  // WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT
 }
 
 const char* GetFieldTrialString() {
@@ -9,12 +9,35 @@
  */
 #include "system_wrappers/include/field_trial.h"
 
+#include <string.h>
+
 #include "rtc_base/checks.h"
 #include "test/gtest.h"
 #include "test/testsupport/rtc_expect_death.h"
 
 namespace webrtc {
 namespace field_trial {
+#ifndef WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT
+TEST(FieldTrialTest, FindsTrialsOfCurrentString) {
+  FieldTrialsAllowedInScopeForTesting allowed_keys({"Audio", "Video", "Other"});
+  const char* const previous_trials = GetFieldTrialString();
+
+  char trials[] = "Audio/Enabled/Video/Disabled/";
+  InitFieldTrialsFromString(trials);
+  EXPECT_EQ(FindFullName("Audio"), "Enabled");
+  EXPECT_EQ(FindFullName("Video"), "Disabled");
+  EXPECT_EQ(FindFullName("Other"), "");
+
+  // Setting the string again is picked up, even with the same buffer.
+  strcpy(trials, "Audio/Disabled/");
+  InitFieldTrialsFromString(trials);
+  EXPECT_EQ(FindFullName("Audio"), "Disabled");
+  EXPECT_EQ(FindFullName("Video"), "");
+
+  InitFieldTrialsFromString(previous_trials);
+}
+#endif  // !defined(WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT)
+
 #if GTEST_HAS_DEATH_TEST && RTC_DCHECK_IS_ON && !defined(WEBRTC_ANDROID) && \
     !defined(WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT)
 TEST(FieldTrialValidationTest, AcceptsValidInputs) {
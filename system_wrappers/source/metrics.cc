@@ -10,7 +10,12 @@
 #include "system_wrappers/include/metrics.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
 
+#include "absl/numeric/bits.h"
 #include "absl/strings/string_view.h"
 #include "rtc_base/string_utils.h"
 #include "rtc_base/synchronization/mutex.h"
@@ -29,11 +34,24 @@ namespace {
 // linearly/exponentially spaced buckets) if samples are logged more frequently.
 const int kMaxSampleMapSize = 300;
 
+// Number of slots in the sample table. A power of two, large enough to keep
+// the probe sequences short with `kMaxSampleMapSize` values.
+constexpr size_t kSampleTableSize = 512;
+static_assert((kSampleTableSize & (kSampleTableSize - 1)) == 0, "");
+static_assert(kSampleTableSize > kMaxSampleMapSize, "");
+
+// Samples are stored in an open addressing hash table of atomic counters, so
+// that Add() doesn't lock. A slot is assigned to a sample value the first
+// time the value is added and keeps it until Reset(); GetAndReset() only
+// clears the counts. Hence `kMaxSampleMapSize` limits the number of distinct
+// values over the lifetime of the histogram, rather than between two calls
+// to GetAndReset().
 class RtcHistogram {
  public:
   RtcHistogram(absl::string_view name, int min, int max, int bucket_count)
-      : min_(min), max_(max), info_(name, min, max, bucket_count) {
+      : name_(name), min_(min), max_(max), bucket_count_(bucket_count) {
     RTC_DCHECK_GT(bucket_count, 0);
+    RTC_DCHECK_GT(min, std::numeric_limits<int>::min() + 1);
   }
 
   RtcHistogram(const RtcHistogram&) = delete;
@@ -43,66 +61,125 @@ class RtcHistogram {
     sample = std::min(sample, max_);
     sample = std::max(sample, min_ - 1);  // Underflow bucket.
 
-    MutexLock lock(&mutex_);
-    if (info_.samples.size() == kMaxSampleMapSize &&
-        info_.samples.find(sample) == info_.samples.end()) {
-      return;
+    size_t index = SlotIndex(sample);
+    for (size_t i = 0; i < kSampleTableSize; ++i) {
+      Slot& slot = slots_[index];
+      int slot_sample = slot.sample.load(std::memory_order_acquire);
+      if (slot_sample == kEmpty) {
+        if (num_values_.fetch_add(1, std::memory_order_relaxed) >=
+            kMaxSampleMapSize) {
+          num_values_.fetch_sub(1, std::memory_order_relaxed);
+          return;
+        }
+        if (!slot.sample.compare_exchange_strong(slot_sample, sample,
+                                                 std::memory_order_acq_rel)) {
+          // Another thread took the slot, possibly for the same value.
+          num_values_.fetch_sub(1, std::memory_order_relaxed);
+        } else {
+          slot_sample = sample;
+        }
+      }
+      if (slot_sample == sample) {
+        slot.count.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+      index = (index + 1) & (kSampleTableSize - 1);
     }
-    ++info_.samples[sample];
   }
 
-  // Returns a copy (or nullptr if there are no samples) and clears samples.
-  std::unique_ptr<SampleInfo> GetAndReset() {
-    MutexLock lock(&mutex_);
-    if (info_.samples.empty())
+  // Returns a copy (or nullptr if there are no samples), and clears samples
+  // if `reset` is true.
+  std::unique_ptr<SampleInfo> GetSamples(bool reset) {
+    auto info =
+        std::make_unique<SampleInfo>(name_, min_, max_, bucket_count_);
+    for (Slot& slot : slots_) {
+      int sample = slot.sample.load(std::memory_order_acquire);
+      if (sample == kEmpty) {
+        continue;
+      }
+      int count = reset ? slot.count.exchange(0, std::memory_order_relaxed)
+                        : slot.count.load(std::memory_order_relaxed);
+      if (count > 0) {
+        info->samples[sample] = count;
+      }
+    }
+    if (info->samples.empty())
       return nullptr;
-
-    SampleInfo* copy =
-        new SampleInfo(info_.name, info_.min, info_.max, info_.bucket_count);
-
-    std::swap(info_.samples, copy->samples);
-
-    return std::unique_ptr<SampleInfo>(copy);
+    return info;
   }
 
-  const std::string& name() const { return info_.name; }
+  const std::string& name() const { return name_; }
 
   // Functions only for testing.
+  // Must not be called concurrently with Add().
   void Reset() {
-    MutexLock lock(&mutex_);
-    info_.samples.clear();
+    for (Slot& slot : slots_) {
+      slot.sample.store(kEmpty, std::memory_order_relaxed);
+      slot.count.store(0, std::memory_order_relaxed);
+    }
+    num_values_.store(0, std::memory_order_relaxed);
   }
 
   int NumEvents(int sample) const {
-    MutexLock lock(&mutex_);
-    const auto it = info_.samples.find(sample);
-    return (it == info_.samples.end()) ? 0 : it->second;
+    size_t index = SlotIndex(sample);
+    for (size_t i = 0; i < kSampleTableSize; ++i) {
+      const Slot& slot = slots_[index];
+      int slot_sample = slot.sample.load(std::memory_order_acquire);
+      if (slot_sample == kEmpty)
+        return 0;
+      if (slot_sample == sample)
+        return slot.count.load(std::memory_order_relaxed);
+      index = (index + 1) & (kSampleTableSize - 1);
+    }
+    return 0;
   }
 
   int NumSamples() const {
     int num_samples = 0;
-    MutexLock lock(&mutex_);
-    for (const auto& sample : info_.samples) {
+    for (const auto& sample : Samples()) {
       num_samples += sample.second;
     }
     return num_samples;
   }
 
   int MinSample() const {
-    MutexLock lock(&mutex_);
-    return (info_.samples.empty()) ? -1 : info_.samples.begin()->first;
+    std::map<int, int> samples = Samples();
+    return samples.empty() ? -1 : samples.begin()->first;
   }
 
   std::map<int, int> Samples() const {
-    MutexLock lock(&mutex_);
-    return info_.samples;
+    std::map<int, int> samples;
+    for (const Slot& slot : slots_) {
+      int sample = slot.sample.load(std::memory_order_acquire);
+      int count = slot.count.load(std::memory_order_relaxed);
+      if (sample != kEmpty && count > 0) {
+        samples[sample] = count;
+      }
+    }
+    return samples;
   }
 
  private:
-  mutable Mutex mutex_;
+  // Marks an unassigned slot. Below the underflow bucket of any histogram.
+  static constexpr int kEmpty = std::numeric_limits<int>::min();
+
+  struct Slot {
+    std::atomic<int> sample{kEmpty};
+    std::atomic<int> count{0};
+  };
+
+  static size_t SlotIndex(int sample) {
+    // Fibonacci hashing, spreads consecutive values over the table.
+    return (static_cast<uint32_t>(sample) * 2654435769u) >>
+           (32 - absl::bit_width(kSampleTableSize - 1));
+  }
+
+  const std::string name_;
   const int min_;
   const int max_;
-  SampleInfo info_ RTC_GUARDED_BY(mutex_);
+  const int bucket_count_;
+  std::atomic<int> num_values_{0};
+  std::array<Slot, kSampleTableSize> slots_;
 };
 
 class RtcHistogramMap {
@@ -143,7 +220,19 @@ class RtcHistogramMap {
                             rtc::AbslStringViewCmp>* histograms) {
     MutexLock lock(&mutex_);
     for (const auto& kv : map_) {
-      std::unique_ptr<SampleInfo> info = kv.second->GetAndReset();
+      std::unique_ptr<SampleInfo> info = kv.second->GetSamples(/*reset=*/true);
+      if (info)
+        histograms->insert(std::make_pair(kv.first, std::move(info)));
+    }
+  }
+
+  void GetSnapshot(std::map<std::string,
+                            std::unique_ptr<SampleInfo>,
+                            rtc::AbslStringViewCmp>* histograms) const {
+    MutexLock lock(&mutex_);
+    for (const auto& kv : map_) {
+      std::unique_ptr<SampleInfo> info =
+          kv.second->GetSamples(/*reset=*/false);
       if (info)
         histograms->insert(std::make_pair(kv.first, std::move(info)));
     }
@@ -301,6 +390,15 @@ void GetAndReset(
     map->GetAndReset(histograms);
 }
 
+void GetSnapshot(
+    std::map<std::string, std::unique_ptr<SampleInfo>, rtc::AbslStringViewCmp>*
+        histograms) {
+  histograms->clear();
+  RtcHistogramMap* map = GetMap();
+  if (map)
+    map->GetSnapshot(histograms);
+}
+
 void Reset() {
   RtcHistogramMap* map = GetMap();
   if (map)
@@ -12,8 +12,10 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "rtc_base/checks.h"
+#include "rtc_base/platform_thread.h"
 #include "rtc_base/string_utils.h"
 #include "system_wrappers/include/metrics.h"
 #include "test/gtest.h"
@@ -154,6 +156,61 @@ TEST_F(MetricsDefaultTest, GetAndReset) {
   EXPECT_EQ(1, metrics::NumEvents("Histogram2", 8));
 }
 
+TEST_F(MetricsDefaultTest, GetSnapshotKeepsSamples) {
+  RTC_HISTOGRAM_PERCENTAGE("Histogram1", 4);
+  RTC_HISTOGRAM_PERCENTAGE("Histogram1", 5);
+  RTC_HISTOGRAM_PERCENTAGE("Histogram2", 10);
+
+  std::map<std::string, std::unique_ptr<metrics::SampleInfo>,
+           rtc::AbslStringViewCmp>
+      histograms;
+  metrics::GetSnapshot(&histograms);
+  EXPECT_EQ(2u, histograms.size());
+  EXPECT_EQ(1, NumEvents("Histogram1", 4, histograms));
+  EXPECT_EQ(1, NumEvents("Histogram1", 5, histograms));
+  EXPECT_EQ(1, NumEvents("Histogram2", 10, histograms));
+  EXPECT_EQ(2, metrics::NumSamples("Histogram1"));
+  EXPECT_EQ(1, metrics::NumSamples("Histogram2"));
+}
+
+TEST_F(MetricsDefaultTest, LimitsNumberOfDistinctSamples) {
+  for (int i = 0; i < 1000; ++i)
+    RTC_HISTOGRAM_COUNTS_10000("DistinctCounts10000", i);
+  std::map<int, int> samples = metrics::Samples("DistinctCounts10000");
+  EXPECT_EQ(300u, samples.size());
+  EXPECT_EQ(0, samples.begin()->first);
+  EXPECT_EQ(299, samples.rbegin()->first);
+
+  // Values that already have been added are still counted after a reset.
+  std::map<std::string, std::unique_ptr<metrics::SampleInfo>,
+           rtc::AbslStringViewCmp>
+      histograms;
+  metrics::GetAndReset(&histograms);
+  RTC_HISTOGRAM_COUNTS_10000("DistinctCounts10000", 7);
+  RTC_HISTOGRAM_COUNTS_10000("DistinctCounts10000", 700);
+  EXPECT_EQ(1, metrics::NumSamples("DistinctCounts10000"));
+  EXPECT_EQ(1, metrics::NumEvents("DistinctCounts10000", 7));
+}
+
+TEST_F(MetricsDefaultTest, AddsSamplesFromMultipleThreads) {
+  constexpr int kNumThreads = 4;
+  constexpr int kSamplesPerThread = 10000;
+  std::vector<rtc::PlatformThread> threads;
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads.push_back(rtc::PlatformThread::SpawnJoinable(
+        [] {
+          for (int j = 0; j < kSamplesPerThread; ++j)
+            RTC_HISTOGRAM_COUNTS_100("ThreadedCounts100", j % 10);
+        },
+        "AddSamples"));
+  }
+  threads.clear();
+  EXPECT_EQ(kNumThreads * kSamplesPerThread,
+            metrics::NumSamples("ThreadedCounts100"));
+  EXPECT_EQ(kNumThreads * kSamplesPerThread / 10,
+            metrics::NumEvents("ThreadedCounts100", 5));
+}
+
 TEST_F(MetricsDefaultTest, TestMinMaxBucket) {
   const std::string kName = "MinMaxCounts100";
   RTC_HISTOGRAM_COUNTS_100(kName, 4);
@@ -0,0 +1,47 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "test/allocation_counter.h"
+
+#include <stdlib.h>
+
+#include <atomic>
+#include <cstddef>
+
+#include "rtc_base/checks.h"
+
+namespace {
+
+std::atomic<int64_t> g_allocation_count{0};
+
+}  // namespace
+
+// The array and sized forms of new and delete forward to these by default.
+void* operator new(size_t size) {
+  g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+  void* ptr = malloc(size == 0 ? 1 : size);
+  // Built without exceptions, so std::bad_alloc can not be thrown.
+  RTC_CHECK(ptr);
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+  free(ptr);
+}
+
+namespace webrtc {
+namespace test {
+
+int64_t GetAllocationCount() {
+  return g_allocation_count.load(std::memory_order_relaxed);
+}
+
+}  // namespace test
+}  // namespace webrtc
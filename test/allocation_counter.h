@@ -0,0 +1,27 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef TEST_ALLOCATION_COUNTER_H_
+#define TEST_ALLOCATION_COUNTER_H_
+
+#include <cstdint>
+
+namespace webrtc {
+namespace test {
+
+// Returns the number of calls made to the global operator new by the process
+// so far, from all threads. Linking this target replaces the global operator
+// new, so it should only be linked into dedicated benchmark and test binaries.
+int64_t GetAllocationCount();
+
+}  // namespace test
+}  // namespace webrtc
+
+#endif  // TEST_ALLOCATION_COUNTER_H_
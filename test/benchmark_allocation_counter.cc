@@ -0,0 +1,28 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "test/benchmark_allocation_counter.h"
+
+#include "test/allocation_counter.h"
+
+namespace webrtc {
+namespace test {
+
+ScopedAllocationCounter::ScopedAllocationCounter(benchmark::State& state)
+    : state_(state), start_count_(GetAllocationCount()) {}
+
+ScopedAllocationCounter::~ScopedAllocationCounter() {
+  state_.counters["allocs"] =
+      benchmark::Counter(GetAllocationCount() - start_count_,
+                         benchmark::Counter::kAvgIterations);
+}
+
+}  // namespace test
+}  // namespace webrtc
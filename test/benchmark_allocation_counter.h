@@ -0,0 +1,41 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef TEST_BENCHMARK_ALLOCATION_COUNTER_H_
+#define TEST_BENCHMARK_ALLOCATION_COUNTER_H_
+
+#include <cstdint>
+
+#include "benchmark/benchmark.h"
+
+namespace webrtc {
+namespace test {
+
+// Reports the number of allocations made during the lifetime of this object,
+// per benchmark iteration, as the "allocs" counter of `state`. Create it just
+// before the benchmark loop. Linking this target replaces the global operator
+// new, see test/allocation_counter.h.
+class ScopedAllocationCounter {
+ public:
+  explicit ScopedAllocationCounter(benchmark::State& state);
+  ~ScopedAllocationCounter();
+
+  ScopedAllocationCounter(const ScopedAllocationCounter&) = delete;
+  ScopedAllocationCounter& operator=(const ScopedAllocationCounter&) = delete;
+
+ private:
+  benchmark::State& state_;
+  const int64_t start_count_;
+};
+
+}  // namespace test
+}  // namespace webrtc
+
+#endif  // TEST_BENCHMARK_ALLOCATION_COUNTER_H_
@@ -57,5 +57,10 @@ bool FrameForwarder::has_sinks() const {
   return sink_ != nullptr;
 }
 
+bool FrameForwarder::SinkWantsFrame(int64_t timestamp_us) {
+  MutexLock lock(&mutex_);
+  return sink_ != nullptr && sink_->WantsFrame(timestamp_us);
+}
+
 }  // namespace test
 }  // namespace webrtc
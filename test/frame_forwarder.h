@@ -30,6 +30,8 @@ class FrameForwarder : public rtc::VideoSourceInterface<VideoFrame> {
       RTC_LOCKS_EXCLUDED(mutex_);
   rtc::VideoSinkWants sink_wants() const RTC_LOCKS_EXCLUDED(mutex_);
   bool has_sinks() const RTC_LOCKS_EXCLUDED(mutex_);
+  // Asks the sink whether it wants a frame captured at `timestamp_us`.
+  bool SinkWantsFrame(int64_t timestamp_us) RTC_LOCKS_EXCLUDED(mutex_);
 
  protected:
   rtc::VideoSinkWants sink_wants_locked() const
@@ -312,6 +312,9 @@ EmulatedNetworkNodeStats EmulatedNetworkNodeStatsBuilder::Build() const {
 }
 
 void LinkEmulation::OnPacketReceived(EmulatedIpPacket packet) {
+  MutexLock lock(&stop_lock_);
+  if (stopped_)
+    return;
   task_queue_->PostTask([this, packet = std::move(packet)]() mutable {
     RTC_DCHECK_RUN_ON(task_queue_);
 
@@ -351,6 +354,11 @@ void LinkEmulation::OnPacketReceived(EmulatedIpPacket packet) {
   });
 }
 
+void LinkEmulation::Stop() {
+  MutexLock lock(&stop_lock_);
+  stopped_ = true;
+}
+
 EmulatedNetworkNodeStats LinkEmulation::stats() const {
   RTC_DCHECK_RUN_ON(task_queue_);
   return stats_builder_.Build();
@@ -464,7 +472,8 @@ EmulatedNetworkNode::EmulatedNetworkNode(
     absl::Nonnull<TaskQueueBase*> task_queue,
     std::unique_ptr<NetworkBehaviorInterface> network_behavior,
     EmulatedNetworkStatsGatheringMode stats_gathering_mode)
-    : router_(task_queue),
+    : task_queue_(task_queue),
+      router_(task_queue),
       link_(clock,
             task_queue,
             std::move(network_behavior),
@@ -659,6 +668,13 @@ rtc::IPAddress EmulatedEndpointImpl::GetPeerLocalAddress() const {
 }
 
 void EmulatedEndpointImpl::OnPacketReceived(EmulatedIpPacket packet) {
+  if (!task_queue_->IsCurrent()) {
+    // The last node of the route runs on a different task queue.
+    task_queue_->PostTask([this, packet = std::move(packet)]() mutable {
+      OnPacketReceived(std::move(packet));
+    });
+    return;
+  }
   RTC_DCHECK_RUN_ON(task_queue_);
   if (!options_.allow_receive_packets_with_different_dest_ip) {
     RTC_CHECK(packet.to.ipaddr() == options_.ip)
@@ -158,6 +158,11 @@ class LinkEmulation : public EmulatedNetworkReceiverInterface {
         stats_builder_(stats_gathering_mode) {}
   void OnPacketReceived(EmulatedIpPacket packet) override;
 
+  // Drops all packets received after this call instead of posting them to
+  // `task_queue`, so that the task queue can be destroyed while other task
+  // queues are still forwarding packets to this link.
+  void Stop();
+
   EmulatedNetworkNodeStats stats() const;
 
  private:
@@ -180,6 +185,9 @@ class LinkEmulation : public EmulatedNetworkReceiverInterface {
   uint64_t next_packet_id_ RTC_GUARDED_BY(task_queue_) = 1;
 
   EmulatedNetworkNodeStatsBuilder stats_builder_ RTC_GUARDED_BY(task_queue_);
+
+  Mutex stop_lock_;
+  bool stopped_ RTC_GUARDED_BY(stop_lock_) = false;
 };
 
 // Represents a component responsible for routing packets based on their IP
@@ -238,6 +246,8 @@ class EmulatedNetworkNode : public EmulatedNetworkReceiverInterface {
 
   LinkEmulation* link() { return &link_; }
   NetworkRouterNode* router() { return &router_; }
+  // The task queue that the link and the router of this node run on.
+  TaskQueueBase* task_queue() const { return task_queue_; }
   EmulatedNetworkNodeStats stats() const;
 
   // Creates a route for the given receiver_ip over all the given nodes to the
@@ -249,6 +259,7 @@ class EmulatedNetworkNode : public EmulatedNetworkReceiverInterface {
                          std::vector<EmulatedNetworkNode*> nodes);
 
  private:
+  const absl::Nonnull<TaskQueueBase*> task_queue_;
   NetworkRouterNode router_;
   LinkEmulation link_;
 };
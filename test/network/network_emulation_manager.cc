@@ -12,6 +12,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <string>
 
 #include "api/field_trials_view.h"
 #include "api/units/time_delta.h"
@@ -33,7 +34,8 @@ constexpr uint32_t kMaxIPv4Address = 0xC0A8FFFF;
 
 std::unique_ptr<TimeController> CreateTimeController(
     TimeMode mode,
-    const FieldTrialsView* field_trials) {
+    const FieldTrialsView* field_trials,
+    int max_parallelism) {
   switch (mode) {
     case TimeMode::kRealTime:
       return std::make_unique<RealTimeController>(field_trials);
@@ -42,7 +44,7 @@ std::unique_ptr<TimeController> CreateTimeController(
       // timestamps in typical test scenarios.
       const Timestamp kSimulatedStartTime = Timestamp::Seconds(100000);
       return std::make_unique<GlobalSimulatedTimeController>(
-          kSimulatedStartTime);
+          kSimulatedStartTime, max_parallelism);
   }
 }
 }  // namespace
@@ -50,16 +52,33 @@ std::unique_ptr<TimeController> CreateTimeController(
 NetworkEmulationManagerImpl::NetworkEmulationManagerImpl(
     TimeMode mode,
     EmulatedNetworkStatsGatheringMode stats_gathering_mode,
-    const FieldTrialsView* field_trials)
+    const FieldTrialsView* field_trials,
+    int num_link_task_queues)
     : time_mode_(mode),
       stats_gathering_mode_(stats_gathering_mode),
-      time_controller_(CreateTimeController(mode, field_trials)),
+      time_controller_(
+          CreateTimeController(mode, field_trials, num_link_task_queues)),
       clock_(time_controller_->GetClock()),
       next_node_id_(1),
       next_ip4_address_(kMinIPv4Address),
       task_queue_(time_controller_->GetTaskQueueFactory()->CreateTaskQueue(
           "NetworkEmulation",
-          TaskQueueFactory::Priority::NORMAL)) {}
+          TaskQueueFactory::Priority::NORMAL)) {
+  RTC_CHECK_GE(num_link_task_queues, 1);
+  if (num_link_task_queues == 1)
+    return;
+  TaskQueueFactory* link_task_queue_factory =
+      mode == TimeMode::kSimulated
+          ? static_cast<GlobalSimulatedTimeController*>(time_controller_.get())
+                ->GetParallelTaskQueueFactory()
+          : time_controller_->GetTaskQueueFactory();
+  for (int i = 0; i < num_link_task_queues; ++i) {
+    link_task_queues_.push_back(std::make_unique<TaskQueueForTest>(
+        link_task_queue_factory->CreateTaskQueue(
+            "NetworkEmulationLink" + std::to_string(i),
+            TaskQueueFactory::Priority::NORMAL)));
+  }
+}
 
 // TODO(srte): Ensure that any pending task that must be run for consistency
 // (such as stats collection tasks) are not cancelled when the task queue is
@@ -68,6 +87,16 @@ NetworkEmulationManagerImpl::~NetworkEmulationManagerImpl() {
   for (auto& turn_server : turn_servers_) {
     turn_server->Stop();
   }
+  if (!link_task_queues_.empty()) {
+    // Packets may still be forwarded between the link task queues, so no link
+    // may post to them once the first one is deleted.
+    task_queue_.SendTask([this] {
+      for (auto& node : network_nodes_) {
+        node->link()->Stop();
+      }
+    });
+    link_task_queues_.clear();
+  }
 }
 
 EmulatedNetworkNode* NetworkEmulationManagerImpl::CreateEmulatedNode(
@@ -79,9 +108,9 @@ EmulatedNetworkNode* NetworkEmulationManagerImpl::CreateEmulatedNode(
 
 EmulatedNetworkNode* NetworkEmulationManagerImpl::CreateEmulatedNode(
     std::unique_ptr<NetworkBehaviorInterface> network_behavior) {
-  auto node = std::make_unique<EmulatedNetworkNode>(clock_, task_queue_.Get(),
-                                                    std::move(network_behavior),
-                                                    stats_gathering_mode_);
+  auto node = std::make_unique<EmulatedNetworkNode>(
+      clock_, NextNodeTaskQueue(), std::move(network_behavior),
+      stats_gathering_mode_);
   EmulatedNetworkNode* out = node.get();
   task_queue_.PostTask([this, node = std::move(node)]() mutable {
     network_nodes_.push_back(std::move(node));
@@ -196,15 +225,17 @@ EmulatedRoute* NetworkEmulationManagerImpl::CreateDefaultRoute(
 
 void NetworkEmulationManagerImpl::ClearRoute(EmulatedRoute* route) {
   RTC_CHECK(route->active) << "Route already cleared";
-  task_queue_.SendTask([route]() {
-    // Remove receiver from intermediate nodes.
-    for (auto* node : route->via_nodes) {
+  // Remove receiver from intermediate nodes.
+  for (auto* node : route->via_nodes) {
+    SendTask(node->task_queue(), [route, node]() {
       if (route->is_default) {
         node->router()->RemoveDefaultReceiver();
       } else {
         node->router()->RemoveReceiver(route->to->GetPeerLocalAddress());
       }
-    }
+    });
+  }
+  task_queue_.SendTask([route]() {
     // Remove destination endpoint from source endpoint's router.
     if (route->is_default) {
       route->from->router()->RemoveDefaultReceiver();
@@ -332,7 +363,12 @@ void NetworkEmulationManagerImpl::GetStats(
       [nodes, stats_callback, stats_gathering_mode = stats_gathering_mode_]() {
         EmulatedNetworkNodeStatsBuilder stats_builder(stats_gathering_mode);
         for (auto* node : nodes) {
-          stats_builder.AddEmulatedNetworkNodeStats(node->stats());
+          // The link task queues never wait for `task_queue_`, so it's safe
+          // to block on them here.
+          EmulatedNetworkNodeStats node_stats;
+          SendTask(node->task_queue(),
+                   [&node_stats, node] { node_stats = node->stats(); });
+          stats_builder.AddEmulatedNetworkNodeStats(node_stats);
         }
         stats_callback(stats_builder.Build());
       });
@@ -355,6 +391,15 @@ NetworkEmulationManagerImpl::GetNextIPv4Address() {
   return absl::nullopt;
 }
 
+TaskQueueBase* NetworkEmulationManagerImpl::NextNodeTaskQueue() {
+  if (link_task_queues_.empty())
+    return task_queue_.Get();
+  TaskQueueBase* task_queue = link_task_queues_[next_link_task_queue_]->Get();
+  next_link_task_queue_ =
+      (next_link_task_queue_ + 1) % link_task_queues_.size();
+  return task_queue;
+}
+
 Timestamp NetworkEmulationManagerImpl::Now() const {
   return clock_->CurrentTime();
 }
@@ -37,10 +37,16 @@ namespace test {
 
 class NetworkEmulationManagerImpl : public NetworkEmulationManager {
  public:
+  // If `num_link_task_queues` is greater than 1, the links of the emulated
+  // network nodes are spread over that many task queues instead of running on
+  // the task queue of the endpoints. In simulated time the link task queues
+  // run on as many threads; the ones with packets ready at the same simulated
+  // time run in parallel, and time only advances once all of them are done.
   NetworkEmulationManagerImpl(
       TimeMode mode,
       EmulatedNetworkStatsGatheringMode stats_gathering_mode,
-      const FieldTrialsView* field_trials = nullptr);
+      const FieldTrialsView* field_trials = nullptr,
+      int num_link_task_queues = 1);
   ~NetworkEmulationManagerImpl();
 
   EmulatedNetworkNode* CreateEmulatedNode(BuiltInNetworkBehaviorConfig config,
@@ -103,12 +109,15 @@ class NetworkEmulationManagerImpl : public NetworkEmulationManager {
       std::pair<std::unique_ptr<CrossTrafficGenerator>, RepeatingTaskHandle>;
 
   absl::optional<rtc::IPAddress> GetNextIPv4Address();
+  // Returns the task queue for the next created network node.
+  TaskQueueBase* NextNodeTaskQueue();
 
   const TimeMode time_mode_;
   const EmulatedNetworkStatsGatheringMode stats_gathering_mode_;
   const std::unique_ptr<TimeController> time_controller_;
   Clock* const clock_;
   int next_node_id_;
+  size_t next_link_task_queue_ = 0;
 
   RepeatingTaskHandle process_task_handle_;
 
@@ -129,9 +138,12 @@ class NetworkEmulationManagerImpl : public NetworkEmulationManager {
   std::map<EmulatedEndpoint*, EmulatedNetworkManager*>
       endpoint_to_network_manager_;
 
-  // Must be the last field, so it will be deleted first, because tasks
-  // in the TaskQueue can access other fields of the instance of this class.
+  // Must be the last fields, so they will be deleted first, because tasks
+  // in the TaskQueues can access other fields of the instance of this class.
   TaskQueueForTest task_queue_;
+  // Empty unless the links run on their own task queues. Deleted before
+  // `task_queue_`, once all links have been stopped.
+  std::vector<std::unique_ptr<TaskQueueForTest>> link_task_queues_;
 };
 
 }  // namespace test
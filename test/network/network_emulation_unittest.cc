@@ -634,6 +634,53 @@ TEST(NetworkEmulationManagerTest,
   network_manager.time_controller()->AdvanceTime(TimeDelta::Seconds(1));
 }
 
+TEST(NetworkEmulationManagerTest, DeliversPacketsOverLinksOnOwnTaskQueues) {
+  NetworkEmulationManagerImpl network_manager(
+      TimeMode::kSimulated, EmulatedNetworkStatsGatheringMode::kDefault,
+      /*field_trials=*/nullptr, /*num_link_task_queues=*/3);
+  EmulatedEndpoint* alice = network_manager.CreateEndpoint({});
+  EmulatedEndpoint* bob = network_manager.CreateEndpoint({});
+  BuiltInNetworkBehaviorConfig config;
+  config.queue_delay_ms = 10;
+  std::vector<EmulatedNetworkNode*> nodes;
+  for (int i = 0; i < 3; ++i) {
+    nodes.push_back(network_manager.CreateEmulatedNode(config));
+  }
+  EmulatedRoute* route = network_manager.CreateRoute(alice, nodes, bob);
+
+  constexpr int kNumPackets = 10;
+  MockReceiver receiver;
+  ASSERT_EQ(bob->BindReceiver(80, &receiver), 80);
+  for (int i = 0; i < kNumPackets; ++i) {
+    alice->SendPacket(rtc::SocketAddress(alice->GetPeerLocalAddress(), 80),
+                      rtc::SocketAddress(bob->GetPeerLocalAddress(), 80),
+                      "Hello");
+  }
+  // Each of the three links adds 10 ms of delay.
+  EXPECT_CALL(receiver, OnPacketReceived(::testing::_)).Times(0);
+  network_manager.time_controller()->AdvanceTime(TimeDelta::Millis(29));
+  ::testing::Mock::VerifyAndClearExpectations(&receiver);
+  EXPECT_CALL(receiver, OnPacketReceived(::testing::_)).Times(kNumPackets);
+  network_manager.time_controller()->AdvanceTime(TimeDelta::Millis(1));
+  ::testing::Mock::VerifyAndClearExpectations(&receiver);
+
+  std::atomic<int> received_stats_count{0};
+  network_manager.GetStats(
+      rtc::ArrayView<EmulatedNetworkNode* const>(nodes),
+      [&](EmulatedNetworkNodeStats stats) {
+        EXPECT_EQ(stats.packet_transport_time.NumSamples(), 0);
+        received_stats_count++;
+      });
+  network_manager.time_controller()->AdvanceTime(TimeDelta::Zero());
+  EXPECT_EQ(received_stats_count.load(), 1);
+
+  network_manager.ClearRoute(route);
+  alice->SendPacket(rtc::SocketAddress(alice->GetPeerLocalAddress(), 80),
+                    rtc::SocketAddress(bob->GetPeerLocalAddress(), 80),
+                    "Hello");
+  network_manager.time_controller()->AdvanceTime(TimeDelta::Seconds(1));
+}
+
 TEST(NetworkEmulationManagerTURNTest, GetIceServerConfig) {
   NetworkEmulationManagerImpl network_manager(
       TimeMode::kRealTime, EmulatedNetworkStatsGatheringMode::kDefault);
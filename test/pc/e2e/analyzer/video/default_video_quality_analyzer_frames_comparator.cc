@@ -321,6 +321,7 @@ void DefaultVideoQualityAnalyzerFramesComparator::AddComparison(
     absl::optional<VideoFrame> rendered,
     FrameComparisonType type,
     FrameStats frame_stats) {
+  WaitForComparisonsQueueCapacity();
   MutexLock lock(&mutex_);
   RTC_CHECK_EQ(state_, State::kActive)
       << "Frames comparator has to be started before it will be used";
@@ -335,6 +336,7 @@ void DefaultVideoQualityAnalyzerFramesComparator::AddComparison(
     absl::optional<VideoFrame> rendered,
     FrameComparisonType type,
     FrameStats frame_stats) {
+  WaitForComparisonsQueueCapacity();
   MutexLock lock(&mutex_);
   RTC_CHECK_EQ(state_, State::kActive)
       << "Frames comparator has to be started before it will be used";
@@ -358,7 +360,8 @@ void DefaultVideoQualityAnalyzerFramesComparator::AddComparisonInternal(
       StatsSample(comparisons_.size(), Now(), /*metadata=*/{}));
   // If there too many computations waiting in the queue, we won't provide
   // frames itself to make future computations lighter.
-  if (comparisons_.size() >= kMaxActiveComparisons) {
+  if (!options_.wait_on_cpu_overload &&
+      comparisons_.size() >= kMaxActiveComparisons) {
     comparisons_.emplace_back(ValidateFrameComparison(
         FrameComparison(std::move(stats_key), /*captured=*/absl::nullopt,
                         /*rendered=*/absl::nullopt, type,
@@ -376,6 +379,22 @@ void DefaultVideoQualityAnalyzerFramesComparator::AddComparisonInternal(
   cpu_measurer_.StopExcludingCpuThreadTime();
 }
 
+void DefaultVideoQualityAnalyzerFramesComparator::
+    WaitForComparisonsQueueCapacity() {
+  if (!options_.wait_on_cpu_overload) {
+    return;
+  }
+  while (true) {
+    {
+      MutexLock lock(&mutex_);
+      if (comparisons_.size() < kMaxActiveComparisons) {
+        return;
+      }
+    }
+    comparison_taken_event_.Wait(rtc::Event::kForever);
+  }
+}
+
 void DefaultVideoQualityAnalyzerFramesComparator::ProcessComparisons() {
   while (true) {
     // Try to pick next comparison to perform from the queue.
@@ -386,6 +405,7 @@ void DefaultVideoQualityAnalyzerFramesComparator::ProcessComparisons() {
       if (!comparisons_.empty()) {
         comparison = comparisons_.front();
         comparisons_.pop_front();
+        comparison_taken_event_.Set();
         if (!comparisons_.empty()) {
           comparison_available_event_.Set();
         }
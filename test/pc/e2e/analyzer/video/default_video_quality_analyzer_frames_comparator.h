@@ -132,6 +132,9 @@ class DefaultVideoQualityAnalyzerFramesComparator {
                              FrameComparisonType type,
                              FrameStats frame_stats)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  // Blocks while the comparisons queue is full if
+  // `options_.wait_on_cpu_overload` is set.
+  void WaitForComparisonsQueueCapacity() RTC_LOCKS_EXCLUDED(mutex_);
   void ProcessComparisons();
   void ProcessComparison(const FrameComparison& comparison);
   Timestamp Now();
@@ -150,6 +153,7 @@ class DefaultVideoQualityAnalyzerFramesComparator {
 
   std::vector<rtc::PlatformThread> thread_pool_;
   rtc::Event comparison_available_event_;
+  rtc::Event comparison_taken_event_;
 };
 
 }  // namespace webrtc
@@ -1650,5 +1650,43 @@ TEST(DefaultVideoQualityAnalyzerFramesComparatorTest,
 }
 // Stats validation tests end.
 
+TEST(DefaultVideoQualityAnalyzerFramesComparatorTest,
+     WaitOnCpuOverloadDoesNotSkipComparisons) {
+  DefaultVideoQualityAnalyzerCpuMeasurer cpu_measurer;
+  DefaultVideoQualityAnalyzerOptions options = AnalyzerOptionsForTest();
+  options.compute_psnr = true;
+  options.wait_on_cpu_overload = true;
+  DefaultVideoQualityAnalyzerFramesComparator comparator(
+      Clock::GetRealTimeClock(), cpu_measurer, options);
+
+  Timestamp stream_start_time = Clock::GetRealTimeClock()->CurrentTime();
+  size_t stream = 0;
+  size_t sender = 0;
+  size_t receiver = 1;
+  size_t peers_count = 2;
+  InternalStatsKey stats_key(stream, sender, receiver);
+
+  comparator.Start(/*max_threads_count=*/1);
+  comparator.EnsureStatsForStream(stream, sender, peers_count,
+                                  stream_start_time, stream_start_time);
+  // Many more comparisons than fit into the queue are added at once.
+  constexpr int kComparisonsCount = 100;
+  for (int i = 0; i < kComparisonsCount; ++i) {
+    Timestamp captured_time = stream_start_time + TimeDelta::Millis(30 * i);
+    VideoFrame frame = CreateFrame(/*frame_id=*/i + 1, /*width=*/320,
+                                   /*height=*/180, captured_time);
+    comparator.AddComparison(
+        stats_key, frame, frame, FrameComparisonType::kRegular,
+        FrameStatsWith10msDeltaBetweenPhasesAnd10x10Frame(
+            /*frame_id=*/i + 1, captured_time));
+  }
+  comparator.Stop(/*last_rendered_frame_times=*/{});
+
+  FramesComparatorStats comparator_stats = comparator.frames_comparator_stats();
+  EXPECT_EQ(comparator_stats.cpu_overloaded_comparisons_done, 0);
+  EXPECT_EQ(comparator.stream_stats().at(stats_key).psnr.NumSamples(),
+            kComparisonsCount);
+}
+
 }  // namespace
 }  // namespace webrtc
@@ -280,6 +280,11 @@ struct DefaultVideoQualityAnalyzerOptions {
   TimeDelta max_frames_storage_duration = kDefaultMaxFramesStorageDuration;
   // If true, the analyzer will expect peers to receive their own video streams.
   bool enable_receive_own_stream = false;
+  // If true, adding a frame comparison while the comparisons queue is full
+  // blocks until a comparison is picked up, instead of skipping PSNR and SSIM
+  // for it. Intended for simulated time, where media is produced faster than
+  // real time and would otherwise overload the comparator.
+  bool wait_on_cpu_overload = false;
 };
 
 }  // namespace webrtc
@@ -12,6 +12,7 @@
 
 #include <stdio.h>
 
+#include <algorithm>
 #include <map>
 #include <string>
 #include <vector>
@@ -48,6 +49,15 @@ bool ReadUint32(uint32_t* out, FILE* file) {
   return true;
 }
 
+bool ReadUint64(uint64_t* out, FILE* file) {
+  uint32_t high;
+  uint32_t low;
+  if (!ReadUint32(&high, file) || !ReadUint32(&low, file))
+    return false;
+  *out = (static_cast<uint64_t>(high) << 32) | low;
+  return true;
+}
+
 bool ReadUint16(uint16_t* out, FILE* file) {
   *out = 0;
   for (size_t i = 0; i < 2; ++i) {
@@ -191,6 +201,130 @@ class RtpDumpReader : public RtpFileReaderImpl {
   FILE* file_;
 };
 
+// Reads RTP packets from a file in the indexed rtpdump format, see
+// RtpFileReader::kIndexedRtpDump.
+class IndexedRtpDumpReader : public RtpFileReaderImpl {
+ public:
+  IndexedRtpDumpReader() = default;
+  ~IndexedRtpDumpReader() override {
+    if (file_ != nullptr) {
+      fclose(file_);
+      file_ = nullptr;
+    }
+  }
+
+  IndexedRtpDumpReader(const IndexedRtpDumpReader&) = delete;
+  IndexedRtpDumpReader& operator=(const IndexedRtpDumpReader&) = delete;
+
+  bool Init(FILE* file, const std::set<uint32_t>& ssrc_filter) override {
+    file_ = file;
+
+    char header[kIndexedHeaderSize];
+    if (fread(header, 1, sizeof(header), file_) != sizeof(header) ||
+        strncmp(header, kIndexedFirstLine, strlen(kIndexedFirstLine)) != 0) {
+      RTC_LOG(LS_INFO) << "Wrong file format of input file";
+      return false;
+    }
+
+    uint64_t index_offset;
+    char magic[4];
+    TRY(fseek(file_, -static_cast<long>(kIndexedFooterSize), SEEK_END) == 0);
+    TRY(ReadUint64(&index_offset, file_));
+    TRY(fread(magic, 1, sizeof(magic), file_) == sizeof(magic));
+    TRY(memcmp(magic, kIndexedFooterMagic, sizeof(magic)) == 0);
+    TRY(SeekTo(index_offset));
+
+    uint32_t num_ssrcs;
+    TRY(ReadUint32(&num_ssrcs, file_));
+    for (uint32_t i = 0; i < num_ssrcs; ++i) {
+      uint32_t ssrc;
+      uint32_t num_packets;
+      TRY(ReadUint32(&ssrc, file_));
+      TRY(ReadUint32(&num_packets, file_));
+      const bool selected =
+          ssrc_filter.empty() || ssrc_filter.count(ssrc) > 0;
+      if (!selected) {
+        TRY(fseek(file_, num_packets * kIndexEntrySize, SEEK_CUR) == 0);
+        continue;
+      }
+      for (uint32_t j = 0; j < num_packets; ++j) {
+        IndexEntry entry;
+        TRY(ReadUint32(&entry.time_ms, file_));
+        TRY(ReadUint64(&entry.offset, file_));
+        packets_.push_back(entry);
+      }
+    }
+    // Read the packets in the order they were written.
+    std::sort(packets_.begin(), packets_.end(),
+              [](const IndexEntry& a, const IndexEntry& b) {
+                return a.offset < b.offset;
+              });
+    return true;
+  }
+
+  bool NextPacket(RtpPacket* packet) override {
+    if (next_packet_ == packets_.size())
+      return false;
+    TRY(SeekTo(packets_[next_packet_++].offset));
+
+    uint16_t len;
+    uint16_t plen;
+    uint32_t offset;
+    TRY(ReadUint16(&len, file_));
+    TRY(ReadUint16(&plen, file_));
+    TRY(ReadUint32(&offset, file_));
+    TRY(len >= kPacketHeaderSize);
+    len -= kPacketHeaderSize;
+    if (len > RtpPacket::kMaxPacketBufferSize) {
+      RTC_LOG(LS_ERROR) << "Packet is too large to fit: " << len << " bytes vs "
+                        << RtpPacket::kMaxPacketBufferSize
+                        << " bytes allocated. Consider increasing the buffer "
+                           "size";
+      return false;
+    }
+    TRY(fread(packet->data, 1, len, file_) == len);
+    packet->length = len;
+    packet->original_length = plen;
+    packet->time_ms = offset;
+    return true;
+  }
+
+  // Assumes that the packets were written in time order.
+  bool SeekToTime(uint32_t time_ms) override {
+    next_packet_ = std::partition_point(packets_.begin(), packets_.end(),
+                                        [time_ms](const IndexEntry& entry) {
+                                          return entry.time_ms < time_ms;
+                                        }) -
+                   packets_.begin();
+    return true;
+  }
+
+ private:
+  struct IndexEntry {
+    uint32_t time_ms;
+    uint64_t offset;
+  };
+
+  static constexpr size_t kIndexedHeaderSize = 16;
+  static constexpr size_t kIndexedFooterSize = 12;
+  static constexpr size_t kIndexEntrySize = 12;
+  static constexpr char kIndexedFirstLine[] = "#!rtpidx1.0\n";
+  static constexpr char kIndexedFooterMagic[] = "RIDX";
+
+  bool SeekTo(uint64_t offset) {
+#if defined(WEBRTC_WIN)
+    return _fseeki64(file_, offset, SEEK_SET) == 0;
+#else
+    return fseeko(file_, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+  }
+
+  FILE* file_ = nullptr;
+  // The selected packets, in file order.
+  std::vector<IndexEntry> packets_;
+  size_t next_packet_ = 0;
+};
+
 enum {
   kResultFail = -1,
   kResultSuccess = 0,
@@ -636,6 +770,9 @@ RtpFileReaderImpl* CreateReaderForFormat(RtpFileReader::FileFormat format) {
     case RtpFileReader::kLengthPacketInterleaved:
       reader = new InterleavedRtpFileReader();
       break;
+    case RtpFileReader::kIndexedRtpDump:
+      reader = new IndexedRtpDumpReader();
+      break;
   }
   return reader;
 }
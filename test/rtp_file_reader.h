@@ -10,6 +10,9 @@
 #ifndef TEST_RTP_FILE_READER_H_
 #define TEST_RTP_FILE_READER_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include <set>
 #include <string>
 
@@ -33,7 +36,25 @@ struct RtpPacket {
 
 class RtpFileReader {
  public:
-  enum FileFormat { kPcap, kRtpDump, kLengthPacketInterleaved };
+  // kIndexedRtpDump is an rtpdump with an index, written by RtpFileWriter,
+  // which allows to read only the packets of some SSRCs, and to seek by time,
+  // without reading the whole file. All integers are big-endian. It consists
+  // of:
+  // - A 16 byte header, starting with "#!rtpidx1.0\n".
+  // - The packet records of an rtpdump: uint16 record length including this
+  //   8 byte record header, uint16 original packet length (0 for RTCP),
+  //   uint32 time offset in ms, and the packet.
+  // - The index: uint32 number of SSRCs, then per SSRC the uint32 SSRC, the
+  //   uint32 number of packets, and per packet the uint32 time offset in ms
+  //   and the uint64 file offset of its record. RTCP packets are indexed by
+  //   their sender SSRC.
+  // - A 12 byte footer: the uint64 file offset of the index, and "RIDX".
+  enum FileFormat {
+    kPcap,
+    kRtpDump,
+    kLengthPacketInterleaved,
+    kIndexedRtpDump
+  };
 
   virtual ~RtpFileReader() {}
   static RtpFileReader* Create(FileFormat format,
@@ -45,6 +66,11 @@ class RtpFileReader {
                                absl::string_view filename,
                                const std::set<uint32_t>& ssrc_filter);
   virtual bool NextPacket(RtpPacket* packet) = 0;
+
+  // Continues reading at the first packet with a time offset of at least
+  // `time_ms`. Returns false if the format doesn't support seeking, which
+  // only kIndexedRtpDump does.
+  virtual bool SeekToTime(uint32_t time_ms) { return false; }
 };
 }  // namespace test
 }  // namespace webrtc
@@ -12,10 +12,16 @@
 
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 
+#include <map>
 #include <string>
+#include <vector>
 
 #include "absl/types/optional.h"
+#include "api/array_view.h"
+#include "modules/rtp_rtcp/source/byte_io.h"
+#include "modules/rtp_rtcp/source/rtp_util.h"
 #include "rtc_base/checks.h"
 
 namespace webrtc {
@@ -23,6 +29,9 @@ namespace test {
 
 static const uint16_t kPacketHeaderSize = 8;
 static const char kFirstLine[] = "#!rtpplay1.0 0.0.0.0/0\n";
+static const char kIndexedFirstLine[] = "#!rtpidx1.0\n";
+static const char kIndexedFooterMagic[] = "RIDX";
+static const size_t kIndexedHeaderSize = 16;
 
 // Write RTP packets to file in rtpdump format, as documented at:
 // http://www.cs.columbia.edu/irt/software/rtptools/
@@ -95,6 +104,98 @@ class RtpDumpWriter : public RtpFileWriter {
   absl::optional<uint32_t> first_packet_time_;
 };
 
+// Write RTP packets to file in the indexed rtpdump format, see
+// RtpFileReader::kIndexedRtpDump.
+class IndexedRtpDumpWriter : public RtpFileWriter {
+ public:
+  explicit IndexedRtpDumpWriter(FILE* file) : file_(file) {
+    RTC_CHECK(file_ != NULL);
+    uint8_t header[kIndexedHeaderSize] = {0};
+    memcpy(header, kIndexedFirstLine, strlen(kIndexedFirstLine));
+    RTC_CHECK(Write(header, sizeof(header)));
+  }
+  ~IndexedRtpDumpWriter() override {
+    RTC_CHECK(WriteIndex());
+    fclose(file_);
+  }
+
+  IndexedRtpDumpWriter(const IndexedRtpDumpWriter&) = delete;
+  IndexedRtpDumpWriter& operator=(const IndexedRtpDumpWriter&) = delete;
+
+  bool WritePacket(const RtpPacket* packet) override {
+    if (!first_packet_time_) {
+      first_packet_time_ = packet->time_ms;
+    }
+    const uint32_t time_ms = packet->time_ms - *first_packet_time_;
+    index_[PacketSsrc(*packet)].push_back({time_ms, offset_});
+
+    uint8_t header[kPacketHeaderSize];
+    ByteWriter<uint16_t>::WriteBigEndian(
+        &header[0], static_cast<uint16_t>(packet->length + kPacketHeaderSize));
+    ByteWriter<uint16_t>::WriteBigEndian(
+        &header[2], static_cast<uint16_t>(packet->original_length));
+    ByteWriter<uint32_t>::WriteBigEndian(&header[4], time_ms);
+    return Write(header, sizeof(header)) &&
+           Write(packet->data, packet->length);
+  }
+
+ private:
+  struct IndexEntry {
+    uint32_t time_ms;
+    uint64_t offset;
+  };
+
+  // Returns the SSRC of an RTP packet, or the sender SSRC of an RTCP packet.
+  static uint32_t PacketSsrc(const RtpPacket& packet) {
+    rtc::ArrayView<const uint8_t> data(packet.data, packet.length);
+    if (packet.length >= kRtcpSenderSsrcEnd &&
+        (packet.original_length == 0 || IsRtcpPacket(data))) {
+      return ByteReader<uint32_t>::ReadBigEndian(&packet.data[4]);
+    }
+    if (IsRtpPacket(data)) {
+      return ParseRtpSsrc(data);
+    }
+    return 0;
+  }
+
+  bool WriteIndex() {
+    const uint64_t index_offset = offset_;
+    uint8_t buffer[12];
+    ByteWriter<uint32_t>::WriteBigEndian(&buffer[0],
+                                         static_cast<uint32_t>(index_.size()));
+    if (!Write(buffer, 4))
+      return false;
+    for (const auto& [ssrc, entries] : index_) {
+      ByteWriter<uint32_t>::WriteBigEndian(&buffer[0], ssrc);
+      ByteWriter<uint32_t>::WriteBigEndian(
+          &buffer[4], static_cast<uint32_t>(entries.size()));
+      if (!Write(buffer, 8))
+        return false;
+      for (const IndexEntry& entry : entries) {
+        ByteWriter<uint32_t>::WriteBigEndian(&buffer[0], entry.time_ms);
+        ByteWriter<uint64_t>::WriteBigEndian(&buffer[4], entry.offset);
+        if (!Write(buffer, 12))
+          return false;
+      }
+    }
+    ByteWriter<uint64_t>::WriteBigEndian(&buffer[0], index_offset);
+    memcpy(&buffer[8], kIndexedFooterMagic, 4);
+    return Write(buffer, 12);
+  }
+
+  bool Write(const uint8_t* data, size_t size) {
+    offset_ += size;
+    return fwrite(data, sizeof(uint8_t), size, file_) == size;
+  }
+
+  static constexpr size_t kRtcpSenderSsrcEnd = 8;
+
+  FILE* const file_;
+  uint64_t offset_ = 0;
+  absl::optional<uint32_t> first_packet_time_;
+  std::map<uint32_t, std::vector<IndexEntry>> index_;
+};
+
 RtpFileWriter* RtpFileWriter::Create(FileFormat format,
                                      const std::string& filename) {
   FILE* file = fopen(filename.c_str(), "wb");
@@ -105,6 +206,8 @@ RtpFileWriter* RtpFileWriter::Create(FileFormat format,
   switch (format) {
     case kRtpDump:
       return new RtpDumpWriter(file);
+    case kIndexedRtpDump:
+      return new IndexedRtpDumpWriter(file);
   }
   fclose(file);
   return NULL;
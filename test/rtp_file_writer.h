@@ -20,6 +20,10 @@ class RtpFileWriter {
  public:
   enum FileFormat {
     kRtpDump,
+    // The packet records of kRtpDump, with an index of the packets of each
+    // SSRC appended when the writer is destroyed. See
+    // RtpFileReader::kIndexedRtpDump.
+    kIndexedRtpDump,
   };
 
   virtual ~RtpFileWriter() {}
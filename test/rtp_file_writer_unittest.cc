@@ -14,7 +14,9 @@
 #include <string.h>
 
 #include <memory>
+#include <set>
 
+#include "modules/rtp_rtcp/source/byte_io.h"
 #include "test/gtest.h"
 #include "test/rtp_file_reader.h"
 #include "test/testsupport/file_utils.h"
@@ -82,4 +84,63 @@ TEST_F(RtpFileWriterTest, WriteToRtpDumpWithOffset) {
   VerifyFileContents(10);
 }
 
+// Writes an RTP packet with the given SSRC and sequence number to `writer`.
+void WriteRtpPacket(test::RtpFileWriter* writer,
+                    uint32_t ssrc,
+                    uint16_t sequence_number,
+                    uint32_t time_ms) {
+  test::RtpPacket packet;
+  memset(packet.data, 0, 20);
+  packet.data[0] = 0x80;
+  packet.data[1] = 96;
+  ByteWriter<uint16_t>::WriteBigEndian(&packet.data[2], sequence_number);
+  ByteWriter<uint32_t>::WriteBigEndian(&packet.data[8], ssrc);
+  packet.length = 20;
+  packet.original_length = 20;
+  packet.time_ms = time_ms;
+  EXPECT_TRUE(writer->WritePacket(&packet));
+}
+
+TEST(IndexedRtpDumpTest, FiltersBySsrcAndSeeksToTime) {
+  const std::string filename = test::OutputPath() + "test_indexed_rtp_dump.rtp";
+  {
+    std::unique_ptr<test::RtpFileWriter> writer(test::RtpFileWriter::Create(
+        test::RtpFileWriter::kIndexedRtpDump, filename));
+    ASSERT_TRUE(writer);
+    for (uint16_t i = 0; i < 10; ++i) {
+      WriteRtpPacket(writer.get(), /*ssrc=*/1111, i, 1000 + 10 * i);
+      WriteRtpPacket(writer.get(), /*ssrc=*/2222, i, 1005 + 10 * i);
+    }
+  }
+
+  // The file is not a plain rtpdump file.
+  EXPECT_FALSE(
+      test::RtpFileReader::Create(test::RtpFileReader::kRtpDump, filename));
+
+  std::unique_ptr<test::RtpFileReader> reader(test::RtpFileReader::Create(
+      test::RtpFileReader::kIndexedRtpDump, filename));
+  ASSERT_TRUE(reader);
+  test::RtpPacket packet;
+  int num_packets = 0;
+  while (reader->NextPacket(&packet)) {
+    EXPECT_EQ(packet.length, 20u);
+    EXPECT_EQ(packet.time_ms, static_cast<uint32_t>(5 * num_packets));
+    ++num_packets;
+  }
+  EXPECT_EQ(num_packets, 20);
+
+  reader.reset(test::RtpFileReader::Create(test::RtpFileReader::kIndexedRtpDump,
+                                           filename, std::set<uint32_t>{2222}));
+  ASSERT_TRUE(reader);
+  ASSERT_TRUE(reader->SeekToTime(50));
+  uint16_t expected_sequence_number = 5;
+  while (reader->NextPacket(&packet)) {
+    EXPECT_EQ(ByteReader<uint32_t>::ReadBigEndian(&packet.data[8]), 2222u);
+    EXPECT_EQ(ByteReader<uint16_t>::ReadBigEndian(&packet.data[2]),
+              expected_sequence_number);
+    ++expected_sequence_number;
+  }
+  EXPECT_EQ(expected_sequence_number, 10);
+}
+
 }  // namespace webrtc
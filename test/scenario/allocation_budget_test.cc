@@ -0,0 +1,99 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Checks that sending and receiving media in steady state stays within a heap
+// allocation budget per received RTP packet. The count covers the whole
+// process, i.e. both the send path (RtpSenderEgress, PacingController) and
+// the receive path (RtpVideoStreamReceiver2, ChannelReceive) as well as the
+// encoders, decoders and the network emulation between them.
+//
+// The budgets have headroom above the current steady state, and are meant to
+// be lowered as allocations are removed from the media paths, so that they
+// don't creep back in.
+
+#include <cstdint>
+#include <functional>
+
+#include "api/units/time_delta.h"
+#include "test/allocation_counter.h"
+#include "test/gtest.h"
+#include "test/scenario/scenario.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+
+constexpr TimeDelta kWarmUpTime = TimeDelta::Seconds(3);
+constexpr TimeDelta kMeasureTime = TimeDelta::Seconds(5);
+
+constexpr int64_t kAudioAllocationsPerPacketBudget = 150;
+constexpr int64_t kVideoAllocationsPerPacketBudget = 150;
+
+// Runs `s` past the warm-up, which covers stream setup, the initial bandwidth
+// ramp-up and the first key frame, and returns the number of allocations per
+// packet counted by `received_packets` during the measurement that follows.
+int64_t MeasureSteadyStateAllocationsPerPacket(
+    Scenario& s,
+    std::function<int64_t()> received_packets) {
+  s.RunFor(kWarmUpTime);
+  const int64_t packets_start = received_packets();
+  const int64_t allocations_start = GetAllocationCount();
+  s.RunFor(kMeasureTime);
+  const int64_t allocations = GetAllocationCount() - allocations_start;
+  const int64_t packets = received_packets() - packets_start;
+  EXPECT_GT(packets, 0);
+  return packets > 0 ? allocations / packets : 0;
+}
+
+CallClientPair* CreateRoute(Scenario& s) {
+  CallClient* caller = s.CreateClient("caller", CallClientConfig());
+  CallClient* callee = s.CreateClient("callee", CallClientConfig());
+  return s.CreateRoutes(
+      caller, {s.CreateSimulationNode(NetworkSimulationConfig())}, callee,
+      {s.CreateSimulationNode(NetworkSimulationConfig())});
+}
+
+TEST(AllocationBudgetTest, AudioSteadyStateStaysWithinBudget) {
+  Scenario s;
+  CallClientPair* route = CreateRoute(s);
+  AudioStreamPair* audio =
+      s.CreateAudioStream(route->forward(), AudioStreamConfig());
+
+  const int64_t allocations_per_packet =
+      MeasureSteadyStateAllocationsPerPacket(s, [&] {
+        int64_t packets = 0;
+        route->second()->SendTask(
+            [&] { packets = audio->receive()->GetStats().packets_received; });
+        return packets;
+      });
+  EXPECT_LE(allocations_per_packet, kAudioAllocationsPerPacketBudget);
+}
+
+TEST(AllocationBudgetTest, VideoSteadyStateStaysWithinBudget) {
+  Scenario s;
+  CallClientPair* route = CreateRoute(s);
+  VideoStreamPair* video =
+      s.CreateVideoStream(route->forward(), VideoStreamConfig());
+
+  const int64_t allocations_per_packet =
+      MeasureSteadyStateAllocationsPerPacket(s, [&] {
+        int64_t packets = 0;
+        route->second()->SendTask([&] {
+          packets =
+              video->receive()->GetStats().rtp_stats.packet_counter.packets;
+        });
+        return packets;
+      });
+  EXPECT_LE(allocations_per_packet, kVideoAllocationsPerPacketBudget);
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace webrtc
@@ -0,0 +1,158 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Runs many audio and video streams through test/scenario for a fixed
+// duration and reports the resources used per packet, frame and stream, so
+// that the numbers can be compared between revisions to catch regressions.
+//
+// Each call is a pair of clients connected over two simulated links. The
+// output is one "<name> <value> <unit>" line per metric.
+
+#include <stdio.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "api/units/data_rate.h"
+#include "api/units/time_delta.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/cpu_time.h"
+#include "rtc_base/memory_usage.h"
+#include "test/allocation_counter.h"
+#include "test/scenario/scenario.h"
+
+ABSL_FLAG(int, calls, 4, "Number of calls, each between two clients.");
+ABSL_FLAG(int, video_streams, 1, "Video streams per call and direction.");
+ABSL_FLAG(int, audio_streams, 1, "Audio streams per call and direction.");
+ABSL_FLAG(bool,
+          bidirectional,
+          false,
+          "Send streams in both directions of each call instead of only from "
+          "the first client to the second.");
+ABSL_FLAG(int, duration_s, 10, "Duration of media to run, in seconds.");
+ABSL_FLAG(bool,
+          real_time,
+          false,
+          "Run in real time instead of simulated time. Thread count and CPU "
+          "usage are more representative in real time.");
+
+namespace webrtc {
+namespace test {
+namespace {
+
+// Returns the number of threads in the process, or -1 if not known on this
+// platform.
+int GetThreadCount() {
+  FILE* file = fopen("/proc/self/status", "r");
+  if (!file)
+    return -1;
+  int threads = -1;
+  char line[256];
+  while (fgets(line, sizeof(line), file)) {
+    if (sscanf(line, "Threads: %d", &threads) == 1)
+      break;
+  }
+  fclose(file);
+  return threads;
+}
+
+void PrintMetric(const char* name, double value, const char* unit) {
+  printf("%s %.2f %s\n", name, value, unit);
+}
+
+void RunLoadBenchmark() {
+  const int num_calls = absl::GetFlag(FLAGS_calls);
+  const int video_streams = absl::GetFlag(FLAGS_video_streams);
+  const int audio_streams = absl::GetFlag(FLAGS_audio_streams);
+  const bool bidirectional = absl::GetFlag(FLAGS_bidirectional);
+  const TimeDelta duration =
+      TimeDelta::Seconds(absl::GetFlag(FLAGS_duration_s));
+  RTC_CHECK_GT(num_calls, 0);
+  RTC_CHECK_GE(video_streams, 0);
+  RTC_CHECK_GE(audio_streams, 0);
+  RTC_CHECK_GT(video_streams + audio_streams, 0);
+  RTC_CHECK_GT(duration, TimeDelta::Zero());
+
+  const int64_t rss_before = rtc::GetProcessResidentSizeBytes();
+  Scenario s("load_benchmark", absl::GetFlag(FLAGS_real_time));
+
+  std::vector<VideoStreamPair*> video_pairs;
+  std::vector<AudioStreamPair*> audio_pairs;
+  auto add_streams = [&](std::pair<CallClient*, CallClient*> route) {
+    for (int i = 0; i < video_streams; ++i)
+      video_pairs.push_back(s.CreateVideoStream(route, VideoStreamConfig()));
+    for (int i = 0; i < audio_streams; ++i)
+      audio_pairs.push_back(s.CreateAudioStream(route, AudioStreamConfig()));
+  };
+  for (int i = 0; i < num_calls; ++i) {
+    CallClient* first =
+        s.CreateClient("a" + std::to_string(i), CallClientConfig());
+    CallClient* second =
+        s.CreateClient("b" + std::to_string(i), CallClientConfig());
+    auto config = [](NetworkSimulationConfig* c) {
+      c->bandwidth = DataRate::KilobitsPerSec(5000);
+      c->delay = TimeDelta::Millis(25);
+    };
+    CallClientPair* route =
+        s.CreateRoutes(first, {s.CreateSimulationNode(config)}, second,
+                       {s.CreateSimulationNode(config)});
+    add_streams(route->forward());
+    if (bidirectional)
+      add_streams(route->reverse());
+  }
+  const int num_streams = video_pairs.size() + audio_pairs.size();
+  const int64_t rss_setup = rtc::GetProcessResidentSizeBytes();
+
+  const int64_t cpu_start = rtc::GetProcessCpuTimeNanos();
+  const int64_t allocations_start = GetAllocationCount();
+  s.RunFor(duration);
+  const int64_t cpu_ns = rtc::GetProcessCpuTimeNanos() - cpu_start;
+  const int64_t allocations = GetAllocationCount() - allocations_start;
+  // Sampled before the streams are torn down, while all of them are running.
+  const int threads = GetThreadCount();
+  const int64_t rss_end = rtc::GetProcessResidentSizeBytes();
+
+  int64_t packets = 0;
+  int64_t frames = 0;
+  for (VideoStreamPair* pair : video_pairs) {
+    VideoReceiveStreamInterface::Stats stats = pair->receive()->GetStats();
+    packets += stats.rtp_stats.packet_counter.packets;
+    frames += stats.frames_decoded;
+  }
+  for (AudioStreamPair* pair : audio_pairs) {
+    packets += pair->receive()->GetStats().packets_received;
+  }
+
+  PrintMetric("streams", num_streams, "count");
+  PrintMetric("received_packets", packets, "count");
+  PrintMetric("decoded_frames", frames, "count");
+  PrintMetric("cpu_per_packet", packets ? cpu_ns / packets : 0, "ns");
+  PrintMetric("cpu_per_frame", frames ? cpu_ns / frames : 0, "ns");
+  PrintMetric("rss_setup_per_stream",
+              (rss_setup - rss_before) / num_streams / 1024.0, "KiB");
+  PrintMetric("rss_end_per_stream",
+              (rss_end - rss_before) / num_streams / 1024.0, "KiB");
+  PrintMetric("allocations_per_second",
+              allocations / duration.seconds<double>(), "count");
+  PrintMetric("threads", threads, "count");
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  absl::ParseCommandLine(argc, argv);
+  webrtc::test::RunLoadBenchmark();
+  return 0;
+}
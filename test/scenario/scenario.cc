@@ -28,6 +28,11 @@ ABSL_FLAG(std::string,
           scenario_logs_root,
           "",
           "Output root path, based on project root if unset.");
+ABSL_FLAG(int,
+          scenario_link_task_queues,
+          1,
+          "Number of task queues, and threads in simulated time, that the "
+          "emulated network links are spread over.");
 
 namespace webrtc {
 namespace test {
@@ -67,7 +72,9 @@ Scenario::Scenario(
     bool real_time)
     : log_writer_factory_(std::move(log_writer_factory)),
       network_manager_(real_time ? TimeMode::kRealTime : TimeMode::kSimulated,
-                       EmulatedNetworkStatsGatheringMode::kDefault),
+                       EmulatedNetworkStatsGatheringMode::kDefault,
+                       /*field_trials=*/nullptr,
+                       absl::GetFlag(FLAGS_scenario_link_task_queues)),
       clock_(network_manager_.time_controller()->GetClock()),
       audio_decoder_factory_(CreateBuiltinAudioDecoderFactory()),
       audio_encoder_factory_(CreateBuiltinAudioEncoderFactory()),
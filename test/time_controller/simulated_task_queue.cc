@@ -16,8 +16,11 @@ namespace webrtc {
 
 SimulatedTaskQueue::SimulatedTaskQueue(
     sim_time_impl::SimulatedTimeControllerImpl* handler,
-    absl::string_view name)
-    : handler_(handler), name_(new char[name.size()]) {
+    absl::string_view name,
+    bool can_run_in_parallel)
+    : handler_(handler),
+      can_run_in_parallel_(can_run_in_parallel),
+      name_(new char[name.size()]) {
   std::copy_n(name.begin(), name.size(), name_);
 }
 
@@ -26,7 +26,8 @@ class SimulatedTaskQueue : public TaskQueueBase,
                            public sim_time_impl::SimulatedSequenceRunner {
  public:
   SimulatedTaskQueue(sim_time_impl::SimulatedTimeControllerImpl* handler,
-                     absl::string_view name);
+                     absl::string_view name,
+                     bool can_run_in_parallel = false);
 
   ~SimulatedTaskQueue();
 
@@ -37,6 +38,7 @@ class SimulatedTaskQueue : public TaskQueueBase,
     return next_run_time_;
   }
   TaskQueueBase* GetAsTaskQueue() override { return this; }
+  bool CanRunInParallel() const override { return can_run_in_parallel_; }
 
   // TaskQueueBase interface
   void Delete() override;
@@ -50,6 +52,7 @@ class SimulatedTaskQueue : public TaskQueueBase,
 
  private:
   sim_time_impl::SimulatedTimeControllerImpl* const handler_;
+  const bool can_run_in_parallel_;
   // Using char* to be debugger friendly.
   char* name_;
 
@@ -36,10 +36,29 @@ bool RemoveByValue(C* vec, typename C::value_type val) {
 
 namespace sim_time_impl {
 
-SimulatedTimeControllerImpl::SimulatedTimeControllerImpl(Timestamp start_time)
-    : thread_id_(rtc::CurrentThreadId()), current_time_(start_time) {}
+SimulatedTimeControllerImpl::SimulatedTimeControllerImpl(Timestamp start_time,
+                                                         int max_parallelism)
+    : thread_id_(rtc::CurrentThreadId()), current_time_(start_time) {
+  RTC_DCHECK_GE(max_parallelism, 1);
+  if (max_parallelism == 1)
+    return;
+  for (int i = 0; i < max_parallelism; ++i) {
+    worker_wakeups_.push_back(std::make_unique<rtc::Event>());
+  }
+  for (int i = 0; i < max_parallelism; ++i) {
+    workers_.push_back(rtc::PlatformThread::SpawnJoinable(
+        [this, i] { RunWorker(i); },
+        "SimulatedTimeWorker" + std::to_string(i)));
+  }
+}
 
-SimulatedTimeControllerImpl::~SimulatedTimeControllerImpl() = default;
+SimulatedTimeControllerImpl::~SimulatedTimeControllerImpl() {
+  stop_workers_ = true;
+  for (auto& wakeup : worker_wakeups_) {
+    wakeup->Set();
+  }
+  workers_.clear();
+}
 
 std::unique_ptr<TaskQueueBase, TaskQueueDeleter>
 SimulatedTimeControllerImpl::CreateTaskQueue(
@@ -53,6 +72,15 @@ SimulatedTimeControllerImpl::CreateTaskQueue(
   return task_queue;
 }
 
+std::unique_ptr<TaskQueueBase, TaskQueueDeleter>
+SimulatedTimeControllerImpl::CreateParallelTaskQueue(absl::string_view name) {
+  auto task_queue = std::unique_ptr<SimulatedTaskQueue, TaskQueueDeleter>(
+      new SimulatedTaskQueue(this, name,
+                             /*can_run_in_parallel=*/!workers_.empty()));
+  Register(task_queue.get());
+  return task_queue;
+}
+
 std::unique_ptr<rtc::Thread> SimulatedTimeControllerImpl::CreateThread(
     const std::string& name,
     std::unique_ptr<rtc::SocketServer> socket_server) {
@@ -94,15 +122,26 @@ void SimulatedTimeControllerImpl::RunReadyRunners() {
 
   // We repeat until we have no ready left to handle tasks posted by ready
   // runners.
+  std::vector<SimulatedSequenceRunner*> parallel_runners;
   while (true) {
     for (auto* runner : runners_) {
       if (yielded_.find(runner->GetAsTaskQueue()) == yielded_.end() &&
           runner->GetNextRunTime() <= current_time) {
-        ready_runners_.push_back(runner);
+        if (runner->CanRunInParallel()) {
+          parallel_runners.push_back(runner);
+        } else {
+          ready_runners_.push_back(runner);
+        }
       }
     }
-    if (ready_runners_.empty())
+    if (ready_runners_.empty() && parallel_runners.empty())
       break;
+    if (!parallel_runners.empty()) {
+      lock_.Unlock();
+      RunParallelRunners(parallel_runners, current_time);
+      lock_.Lock();
+      parallel_runners.clear();
+    }
     while (!ready_runners_.empty()) {
       auto* runner = ready_runners_.front();
       ready_runners_.pop_front();
@@ -116,6 +155,44 @@ void SimulatedTimeControllerImpl::RunReadyRunners() {
   }
 }
 
+void SimulatedTimeControllerImpl::RunParallelRunners(
+    const std::vector<SimulatedSequenceRunner*>& runners,
+    Timestamp at_time) {
+  if (runners.size() == 1) {
+    runners[0]->RunReady(at_time);
+    return;
+  }
+  parallel_runners_ = &runners;
+  parallel_run_time_ = at_time;
+  next_parallel_runner_ = 0;
+  const size_t num_workers = std::min(workers_.size(), runners.size());
+  running_workers_ = num_workers;
+  for (size_t i = 0; i < num_workers; ++i) {
+    worker_wakeups_[i]->Set();
+  }
+  // The tasks are running on the workers, so there's nothing to yield to
+  // while waiting for them.
+  rtc::ScopedYieldPolicy no_yield(nullptr);
+  parallel_runners_done_.Wait(rtc::Event::kForever, rtc::Event::kForever);
+  parallel_runners_ = nullptr;
+}
+
+void SimulatedTimeControllerImpl::RunWorker(size_t index) {
+  SimulatedThread::CurrentThreadSetter set_current(dummy_thread_.get());
+  while (true) {
+    worker_wakeups_[index]->Wait(rtc::Event::kForever, rtc::Event::kForever);
+    if (stop_workers_)
+      return;
+    for (size_t i = next_parallel_runner_++; i < parallel_runners_->size();
+         i = next_parallel_runner_++) {
+      (*parallel_runners_)[i]->RunReady(parallel_run_time_);
+    }
+    if (--running_workers_ == 0) {
+      parallel_runners_done_.Set();
+    }
+  }
+}
+
 Timestamp SimulatedTimeControllerImpl::CurrentTime() const {
   MutexLock lock(&time_lock_);
   return current_time_;
@@ -164,8 +241,12 @@ void SimulatedTimeControllerImpl::StopYield(TaskQueueBase* yielding_from) {
 }  // namespace sim_time_impl
 
 GlobalSimulatedTimeController::GlobalSimulatedTimeController(
-    Timestamp start_time)
-    : sim_clock_(start_time.us()), impl_(start_time), yield_policy_(&impl_) {
+    Timestamp start_time,
+    int max_parallelism)
+    : sim_clock_(start_time.us()),
+      impl_(start_time, max_parallelism),
+      parallel_task_queue_factory_(&impl_),
+      yield_policy_(&impl_) {
   global_clock_.SetTime(start_time);
   auto main_thread = std::make_unique<SimulatedMainThread>(&impl_);
   impl_.Register(main_thread.get());
@@ -182,6 +263,10 @@ TaskQueueFactory* GlobalSimulatedTimeController::GetTaskQueueFactory() {
   return &impl_;
 }
 
+TaskQueueFactory* GlobalSimulatedTimeController::GetParallelTaskQueueFactory() {
+  return &parallel_task_queue_factory_;
+}
+
 std::unique_ptr<rtc::Thread> GlobalSimulatedTimeController::CreateThread(
     const std::string& name,
     std::unique_ptr<rtc::SocketServer> socket_server) {
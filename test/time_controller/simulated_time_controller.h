@@ -10,6 +10,7 @@
 #ifndef TEST_TIME_CONTROLLER_SIMULATED_TIME_CONTROLLER_H_
 #define TEST_TIME_CONTROLLER_SIMULATED_TIME_CONTROLLER_H_
 
+#include <atomic>
 #include <list>
 #include <memory>
 #include <unordered_set>
@@ -20,7 +21,9 @@
 #include "api/sequence_checker.h"
 #include "api/test/time_controller.h"
 #include "api/units/timestamp.h"
+#include "rtc_base/event.h"
 #include "rtc_base/fake_clock.h"
+#include "rtc_base/platform_thread.h"
 #include "rtc_base/platform_thread_types.h"
 #include "rtc_base/synchronization/mutex.h"
 #include "rtc_base/synchronization/yield_policy.h"
@@ -40,18 +43,34 @@ class SimulatedSequenceRunner {
   // inheritance. Therefore we simply allow the implementations to provide a
   // casted pointer to themself.
   virtual TaskQueueBase* GetAsTaskQueue() = 0;
+
+  // Returns true if the runner may run at the same time as other parallel
+  // runners that are ready at the same simulated time.
+  virtual bool CanRunInParallel() const { return false; }
 };
 
 class SimulatedTimeControllerImpl : public TaskQueueFactory,
                                     public rtc::YieldInterface {
  public:
-  explicit SimulatedTimeControllerImpl(Timestamp start_time);
+  // Up to `max_parallelism` parallel runners are run at the same time, see
+  // CreateParallelTaskQueue().
+  explicit SimulatedTimeControllerImpl(Timestamp start_time,
+                                       int max_parallelism = 1);
   ~SimulatedTimeControllerImpl() override;
 
   std::unique_ptr<TaskQueueBase, TaskQueueDeleter> CreateTaskQueue(
       absl::string_view name,
       Priority priority) const RTC_LOCKS_EXCLUDED(time_lock_) override;
 
+  // Creates a task queue that runs on a worker thread, at the same time as the
+  // other parallel task queues that have tasks ready at the same simulated
+  // time. All such task queues finish running their ready tasks before time
+  // advances or any other runner runs, so no task can observe a task
+  // scheduled for a later time. Tasks on these queues must not block or
+  // yield. Returns a regular task queue if `max_parallelism` is 1.
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> CreateParallelTaskQueue(
+      absl::string_view name) RTC_LOCKS_EXCLUDED(lock_);
+
   // Implements the YieldInterface by running ready tasks on all task queues,
   // except that if this method is called from a task, the task queue running
   // that task is skipped.
@@ -83,6 +102,12 @@ class SimulatedTimeControllerImpl : public TaskQueueFactory,
   void StopYield(TaskQueueBase* yielding_from);
 
  private:
+  // Runs `runners` on the worker threads and waits for them to finish.
+  void RunParallelRunners(
+      const std::vector<SimulatedSequenceRunner*>& runners,
+      Timestamp at_time) RTC_LOCKS_EXCLUDED(lock_);
+  void RunWorker(size_t index);
+
   const rtc::PlatformThreadId thread_id_;
   const std::unique_ptr<rtc::Thread> dummy_thread_ = rtc::Thread::Create();
   mutable Mutex time_lock_;
@@ -96,6 +121,34 @@ class SimulatedTimeControllerImpl : public TaskQueueFactory,
 
   // Runners on which YieldExecution has been called.
   std::unordered_set<TaskQueueBase*> yielded_;
+
+  // The batch of parallel runners currently being run by the workers. Only
+  // written by the thread advancing time, while the workers are idle.
+  const std::vector<SimulatedSequenceRunner*>* parallel_runners_ = nullptr;
+  Timestamp parallel_run_time_ = Timestamp::MinusInfinity();
+  std::atomic<size_t> next_parallel_runner_{0};
+  std::atomic<size_t> running_workers_{0};
+  bool stop_workers_ = false;
+  std::vector<std::unique_ptr<rtc::Event>> worker_wakeups_;
+  rtc::Event parallel_runners_done_;
+  std::vector<rtc::PlatformThread> workers_;
+};
+
+// Creates task queues using
+// SimulatedTimeControllerImpl::CreateParallelTaskQueue().
+class ParallelTaskQueueFactory : public TaskQueueFactory {
+ public:
+  explicit ParallelTaskQueueFactory(SimulatedTimeControllerImpl* impl)
+      : impl_(impl) {}
+
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> CreateTaskQueue(
+      absl::string_view name,
+      Priority priority) const override {
+    return impl_->CreateParallelTaskQueue(name);
+  }
+
+ private:
+  SimulatedTimeControllerImpl* const impl_;
 };
 }  // namespace sim_time_impl
 
@@ -126,11 +179,17 @@ class TokenTaskQueue : public TaskQueueBase {
 // since it modifies global state.
 class GlobalSimulatedTimeController : public TimeController {
  public:
-  explicit GlobalSimulatedTimeController(Timestamp start_time);
+  explicit GlobalSimulatedTimeController(Timestamp start_time,
+                                         int max_parallelism = 1);
   ~GlobalSimulatedTimeController() override;
 
   Clock* GetClock() override;
   TaskQueueFactory* GetTaskQueueFactory() override;
+  // Returns a factory for task queues whose tasks may run concurrently, on up
+  // to `max_parallelism` threads, with the tasks of the other task queues
+  // created by it that are ready at the same simulated time. The tasks must
+  // not block or yield.
+  TaskQueueFactory* GetParallelTaskQueueFactory();
   std::unique_ptr<rtc::Thread> CreateThread(
       const std::string& name,
       std::unique_ptr<rtc::SocketServer> socket_server) override;
@@ -158,6 +217,7 @@ class GlobalSimulatedTimeController : public TimeController {
   // Provides simulated CurrentNtpInMilliseconds()
   SimulatedClock sim_clock_;
   sim_time_impl::SimulatedTimeControllerImpl impl_;
+  sim_time_impl::ParallelTaskQueueFactory parallel_task_queue_factory_;
   rtc::ScopedYieldPolicy yield_policy_;
   std::unique_ptr<rtc::Thread> main_thread_;
 };
@@ -12,6 +12,7 @@
 
 #include <atomic>
 #include <memory>
+#include <vector>
 
 #include "api/task_queue/task_queue_base.h"
 #include "api/units/time_delta.h"
@@ -163,4 +164,39 @@ TEST(SimulatedTimeControllerTest, SkipsDelayedTaskForward) {
   sim.AdvanceTime(TimeDelta::Zero());
 }
 
+TEST(SimulatedTimeControllerTest, RunsParallelTaskQueuesConcurrently) {
+  constexpr int kNumTaskQueues = 4;
+  GlobalSimulatedTimeController sim(kStartTime, kNumTaskQueues);
+  std::vector<std::unique_ptr<TaskQueueBase, TaskQueueDeleter>> task_queues;
+  for (int i = 0; i < kNumTaskQueues; ++i) {
+    task_queues.push_back(
+        sim.GetParallelTaskQueueFactory()->CreateTaskQueue(
+            "ParallelQueue", TaskQueueFactory::Priority::NORMAL));
+  }
+  std::atomic<int> started(0);
+  std::atomic<int> finished(0);
+  rtc::Event all_started(/*manual_reset=*/true, /*initially_signaled=*/false);
+  for (auto& task_queue : task_queues) {
+    task_queue->PostDelayedTask(
+        [&] {
+          // Only finishes if all tasks are running at the same time.
+          if (++started == kNumTaskQueues) {
+            all_started.Set();
+          } else {
+            EXPECT_TRUE(all_started.Wait(TimeDelta::Seconds(10)));
+          }
+          ++finished;
+        },
+        TimeDelta::Millis(10));
+  }
+  int finished_before_time_advanced = -1;
+  task_queues[0]->PostDelayedTask(
+      [&] { finished_before_time_advanced = finished.load(); },
+      TimeDelta::Millis(11));
+
+  sim.AdvanceTime(TimeDelta::Millis(11));
+  EXPECT_EQ(finished.load(), kNumTaskQueues);
+  EXPECT_EQ(finished_before_time_advanced, kNumTaskQueues);
+}
+
 }  // namespace webrtc
@@ -35,8 +35,10 @@
 #include "modules/video_coding/include/video_error_codes.h"
 #include "modules/video_coding/svc/scalability_mode_util.h"
 #include "modules/video_coding/utility/ivf_file_writer.h"
+#include "rtc_base/cpu_time.h"
 #include "rtc_base/event.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/platform_thread.h"
 #include "rtc_base/strings/string_builder.h"
 #include "rtc_base/synchronization/mutex.h"
 #include "rtc_base/task_queue_for_test.h"
@@ -779,7 +781,8 @@ class Decoder : public DecodedImageCallback {
       : env_(env),
         decoder_factory_(decoder_factory),
         analyzer_(analyzer),
-        pacer_(decoder_settings.pacing_settings) {
+        pacer_(decoder_settings.pacing_settings),
+        number_of_cores_(decoder_settings.number_of_cores) {
     RTC_CHECK(analyzer_) << "Analyzer must be provided";
 
     if (decoder_settings.decoder_input_base_path) {
@@ -805,7 +808,7 @@ class Decoder : public DecodedImageCallback {
 
       VideoDecoder::Settings ds;
       ds.set_codec_type(*codec_type_);
-      ds.set_number_of_cores(1);
+      ds.set_number_of_cores(number_of_cores_);
       ds.set_max_render_resolution({1280, 720});
       bool result = decoder_->Configure(ds);
       RTC_CHECK(result) << "Failed to configure decoder";
@@ -870,6 +873,7 @@ class Decoder : public DecodedImageCallback {
   std::unique_ptr<VideoDecoder> decoder_;
   VideoCodecAnalyzer* const analyzer_;
   Pacer pacer_;
+  const int number_of_cores_;
   LimitedTaskQueue task_queue_;
   std::unique_ptr<TesterIvfWriter> ivf_writer_;
   std::unique_ptr<TesterY4mWriter> y4m_writer_;
@@ -888,7 +892,9 @@ class Encoder : public EncodedImageCallback {
           VideoCodecAnalyzer* analyzer)
       : encoder_factory_(encoder_factory),
         analyzer_(analyzer),
-        pacer_(encoder_settings.pacing_settings) {
+        pacer_(encoder_settings.pacing_settings),
+        number_of_cores_(encoder_settings.number_of_cores),
+        complexity_(encoder_settings.complexity) {
     RTC_CHECK(analyzer_) << "Analyzer must be provided";
 
     if (encoder_settings.encoder_input_base_path) {
@@ -1040,7 +1046,7 @@ class Encoder : public EncodedImageCallback {
     vc.mode = webrtc::VideoCodecMode::kRealtimeVideo;
     vc.SetFrameDropEnabled(true);
     vc.SetScalabilityMode(es.scalability_mode);
-    vc.SetVideoEncoderComplexity(VideoCodecComplexity::kComplexityNormal);
+    vc.SetVideoEncoderComplexity(complexity_);
 
     vc.codecType = PayloadStringToCodecType(es.sdp_video_format.name);
     switch (vc.codecType) {
@@ -1107,7 +1113,7 @@ class Encoder : public EncodedImageCallback {
 
     VideoEncoder::Settings ves(
         VideoEncoder::Capabilities(/*loss_notification=*/false),
-        /*number_of_cores=*/1,
+        number_of_cores_,
         /*max_payload_size=*/1440);
 
     int result = encoder_->InitEncode(&vc, ves);
@@ -1197,6 +1203,8 @@ class Encoder : public EncodedImageCallback {
   std::unique_ptr<VideoEncoder> encoder_;
   VideoCodecAnalyzer* const analyzer_;
   Pacer pacer_;
+  const int number_of_cores_;
+  const VideoCodecComplexity complexity_;
   absl::optional<EncodingSettings> last_encoding_settings_;
   std::unique_ptr<VideoBitrateAllocator> bitrate_allocator_;
   LimitedTaskQueue task_queue_;
@@ -1413,6 +1421,50 @@ SplitBitrateAndUpdateScalabilityMode(std::string codec_type,
   return std::make_tuple(bitrates, *vc.GetScalabilityMode());
 }
 
+// Encodes frames pulled from `video_source` and decodes the encoded frames.
+// Stats are collected by `analyzer`.
+void EncodeDecode(const Environment& env,
+                  VideoSource& video_source,
+                  VideoEncoderFactory* encoder_factory,
+                  VideoDecoderFactory* decoder_factory,
+                  const EncoderSettings& encoder_settings,
+                  const DecoderSettings& decoder_settings,
+                  const std::map<uint32_t, EncodingSettings>& encoding_settings,
+                  VideoCodecAnalyzer* analyzer) {
+  const EncodingSettings& frame_settings = encoding_settings.begin()->second;
+  Encoder encoder(encoder_factory, encoder_settings, analyzer);
+  encoder.Initialize(frame_settings);
+
+  int num_spatial_layers =
+      ScalabilityModeToNumSpatialLayers(frame_settings.scalability_mode);
+  std::vector<std::unique_ptr<Decoder>> decoders;
+  for (int sidx = 0; sidx < num_spatial_layers; ++sidx) {
+    auto decoder = std::make_unique<Decoder>(env, decoder_factory,
+                                             decoder_settings, analyzer);
+    decoder->Initialize(frame_settings.sdp_video_format);
+    decoders.push_back(std::move(decoder));
+  }
+
+  for (const auto& [timestamp_rtp, frame_settings] : encoding_settings) {
+    const EncodingSettings::LayerSettings& top_layer =
+        frame_settings.layers_settings.rbegin()->second;
+    VideoFrame source_frame = video_source.PullFrame(
+        timestamp_rtp, top_layer.resolution, top_layer.framerate);
+    encoder.Encode(source_frame, frame_settings,
+                   [&decoders](const EncodedImage& encoded_frame) {
+                     int sidx = encoded_frame.SpatialIndex().value_or(
+                         encoded_frame.SimulcastIndex().value_or(0));
+                     decoders.at(sidx)->Decode(encoded_frame);
+                   });
+  }
+
+  encoder.Flush();
+  for (auto& decoder : decoders) {
+    decoder->Flush();
+  }
+  analyzer->Flush();
+}
+
 }  // namespace
 
 void VideoCodecStats::Stream::LogMetrics(
@@ -1474,6 +1526,58 @@ void VideoCodecStats::Stream::LogMetrics(
                     metadata);
 }
 
+double VideoCodecTester::ThroughputStats::fps() const {
+  if (wall_time <= TimeDelta::Zero()) {
+    return 0.0;
+  }
+  return num_decoded_frames / wall_time.seconds<double>();
+}
+
+double VideoCodecTester::ThroughputStats::fps_per_core() const {
+  if (cpu_time <= TimeDelta::Zero()) {
+    return 0.0;
+  }
+  return num_decoded_frames / cpu_time.seconds<double>();
+}
+
+void VideoCodecTester::ThroughputStats::LogMetrics(
+    MetricsLogger* logger,
+    std::string test_case_name,
+    std::string prefix,
+    std::map<std::string, std::string> metadata) const {
+  logger->LogSingleValueMetric(prefix + "num_instances", test_case_name,
+                               num_instances, Unit::kCount,
+                               ImprovementDirection::kNeitherIsBetter,
+                               metadata);
+  logger->LogSingleValueMetric(prefix + "fps", test_case_name, fps(),
+                               Unit::kHertz,
+                               ImprovementDirection::kBiggerIsBetter, metadata);
+  logger->LogSingleValueMetric(prefix + "fps_per_core", test_case_name,
+                               fps_per_core(), Unit::kHertz,
+                               ImprovementDirection::kBiggerIsBetter, metadata);
+  logger->LogMetric(prefix + "encode_time_ms", test_case_name, encode_time_ms,
+                    Unit::kMilliseconds, ImprovementDirection::kSmallerIsBetter,
+                    metadata);
+  logger->LogMetric(prefix + "decode_time_ms", test_case_name, decode_time_ms,
+                    Unit::kMilliseconds, ImprovementDirection::kSmallerIsBetter,
+                    metadata);
+  logger->LogMetric(prefix + "latency_ms", test_case_name, latency_ms,
+                    Unit::kMilliseconds, ImprovementDirection::kSmallerIsBetter,
+                    metadata);
+  if (!latency_ms.IsEmpty()) {
+    // GetPercentile() sorts the samples, so it is not const.
+    SamplesStatsCounter latency = latency_ms;
+    for (const auto& [name, percentile] :
+         {std::pair("p50", 0.50), std::pair("p95", 0.95),
+          std::pair("p99", 0.99)}) {
+      logger->LogSingleValueMetric(
+          prefix + "latency_" + name + "_ms", test_case_name,
+          latency.GetPercentile(percentile), Unit::kMilliseconds,
+          ImprovementDirection::kSmallerIsBetter, metadata);
+    }
+  }
+}
+
 // TODO(ssilkin): use Frequency and DataRate for framerate and bitrate.
 std::map<uint32_t, EncodingSettings> VideoCodecTester::CreateEncodingSettings(
     std::string codec_type,
@@ -1592,39 +1696,73 @@ VideoCodecTester::RunEncodeDecodeTest(
   VideoSource video_source(source_settings);
   std::unique_ptr<VideoCodecAnalyzer> analyzer =
       std::make_unique<VideoCodecAnalyzer>(&video_source);
-  const EncodingSettings& frame_settings = encoding_settings.begin()->second;
-  Encoder encoder(encoder_factory, encoder_settings, analyzer.get());
-  encoder.Initialize(frame_settings);
+  EncodeDecode(env, video_source, encoder_factory, decoder_factory,
+               encoder_settings, decoder_settings, encoding_settings,
+               analyzer.get());
+  return std::move(analyzer);
+}
 
-  int num_spatial_layers =
-      ScalabilityModeToNumSpatialLayers(frame_settings.scalability_mode);
-  std::vector<std::unique_ptr<Decoder>> decoders;
-  for (int sidx = 0; sidx < num_spatial_layers; ++sidx) {
-    auto decoder = std::make_unique<Decoder>(env, decoder_factory,
-                                             decoder_settings, analyzer.get());
-    decoder->Initialize(frame_settings.sdp_video_format);
-    decoders.push_back(std::move(decoder));
+VideoCodecTester::ThroughputStats VideoCodecTester::RunThroughputTest(
+    const Environment& env,
+    const VideoSourceSettings& source_settings,
+    VideoEncoderFactory* encoder_factory,
+    VideoDecoderFactory* decoder_factory,
+    const EncoderSettings& encoder_settings,
+    const DecoderSettings& decoder_settings,
+    const std::map<uint32_t, EncodingSettings>& encoding_settings,
+    int num_instances) {
+  RTC_CHECK_GT(num_instances, 0);
+  EncoderSettings unpaced_encoder_settings = encoder_settings;
+  unpaced_encoder_settings.pacing_settings = PacingSettings();
+  DecoderSettings unpaced_decoder_settings = decoder_settings;
+  unpaced_decoder_settings.pacing_settings = PacingSettings();
+
+  std::vector<std::unique_ptr<VideoSource>> video_sources;
+  std::vector<std::unique_ptr<VideoCodecAnalyzer>> analyzers;
+  for (int i = 0; i < num_instances; ++i) {
+    video_sources.push_back(std::make_unique<VideoSource>(source_settings));
+    // No video source, such that PSNR is not computed.
+    analyzers.push_back(
+        std::make_unique<VideoCodecAnalyzer>(/*video_source=*/nullptr));
   }
 
-  for (const auto& [timestamp_rtp, frame_settings] : encoding_settings) {
-    const EncodingSettings::LayerSettings& top_layer =
-        frame_settings.layers_settings.rbegin()->second;
-    VideoFrame source_frame = video_source.PullFrame(
-        timestamp_rtp, top_layer.resolution, top_layer.framerate);
-    encoder.Encode(source_frame, frame_settings,
-                   [&decoders](const EncodedImage& encoded_frame) {
-                     int sidx = encoded_frame.SpatialIndex().value_or(
-                         encoded_frame.SimulcastIndex().value_or(0));
-                     decoders.at(sidx)->Decode(encoded_frame);
-                   });
+  const int64_t start_time_us = rtc::TimeMicros();
+  const int64_t start_cpu_time_ns = rtc::GetProcessCpuTimeNanos();
+  {
+    std::vector<rtc::PlatformThread> threads;
+    for (int i = 0; i < num_instances; ++i) {
+      threads.push_back(rtc::PlatformThread::SpawnJoinable(
+          [&, i] {
+            EncodeDecode(env, *video_sources[i], encoder_factory,
+                         decoder_factory, unpaced_encoder_settings,
+                         unpaced_decoder_settings, encoding_settings,
+                         analyzers[i].get());
+          },
+          "throughput_" + std::to_string(i)));
+    }
+    // Threads are joined when they go out of scope.
   }
 
-  encoder.Flush();
-  for (auto& decoder : decoders) {
-    decoder->Flush();
+  ThroughputStats stats;
+  stats.num_instances = num_instances;
+  stats.wall_time = TimeDelta::Micros(rtc::TimeMicros() - start_time_us);
+  stats.cpu_time = TimeDelta::Micros(
+      (rtc::GetProcessCpuTimeNanos() - start_cpu_time_ns) / 1000);
+  for (const auto& analyzer : analyzers) {
+    for (const VideoCodecStats::Frame& frame :
+         analyzer->Slice(/*filter=*/{}, /*merge=*/false)) {
+      if (frame.encoded) {
+        stats.encode_time_ms.AddSample(frame.encode_time.ms<double>());
+      }
+      if (frame.decoded) {
+        ++stats.num_decoded_frames;
+        stats.decode_time_ms.AddSample(frame.decode_time.ms<double>());
+        stats.latency_ms.AddSample(
+            (frame.encode_time + frame.decode_time).ms<double>());
+      }
+    }
   }
-  analyzer->Flush();
-  return std::move(analyzer);
+  return stats;
 }
 
 }  // namespace test
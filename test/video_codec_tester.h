@@ -24,8 +24,10 @@
 #include "api/units/data_rate.h"
 #include "api/units/data_size.h"
 #include "api/units/frequency.h"
+#include "api/units/time_delta.h"
 #include "api/video/encoded_image.h"
 #include "api/video/resolution.h"
+#include "api/video_codecs/video_codec.h"
 #include "api/video_codecs/video_decoder_factory.h"
 #include "api/video_codecs/video_encoder_factory.h"
 
@@ -162,16 +164,47 @@ class VideoCodecTester {
 
   struct DecoderSettings {
     PacingSettings pacing_settings;
+    // Number of cores the decoder is allowed to use.
+    int number_of_cores = 1;
     absl::optional<std::string> decoder_input_base_path;
     absl::optional<std::string> decoder_output_base_path;
   };
 
   struct EncoderSettings {
     PacingSettings pacing_settings;
+    // Number of cores the encoder is allowed to use.
+    int number_of_cores = 1;
+    // Software encoders map the complexity to their speed presets.
+    VideoCodecComplexity complexity = VideoCodecComplexity::kComplexityNormal;
     absl::optional<std::string> encoder_input_base_path;
     absl::optional<std::string> encoder_output_base_path;
   };
 
+  // Results of a throughput test, aggregated over all codec instances.
+  struct ThroughputStats {
+    int num_instances = 0;
+    int num_decoded_frames = 0;
+    TimeDelta wall_time = TimeDelta::Zero();
+    // CPU time used by the process while the test was running.
+    TimeDelta cpu_time = TimeDelta::Zero();
+    SamplesStatsCounter encode_time_ms;
+    SamplesStatsCounter decode_time_ms;
+    // Encode time plus decode time of each decoded frame.
+    SamplesStatsCounter latency_ms;
+
+    // Decoded frames per second of wall time, summed over all instances.
+    double fps() const;
+    // Decoded frames per second of CPU time, i.e. the frame rate which one
+    // fully loaded core sustains.
+    double fps_per_core() const;
+
+    // Logs `ThroughputStats` metrics to provided `MetricsLogger`.
+    void LogMetrics(MetricsLogger* logger,
+                    std::string test_case_name,
+                    std::string prefix,
+                    std::map<std::string, std::string> metadata = {}) const;
+  };
+
   virtual ~VideoCodecTester() = default;
 
   // Interface for a coded video frames source.
@@ -221,6 +254,20 @@ class VideoCodecTester {
       const EncoderSettings& encoder_settings,
       const DecoderSettings& decoder_settings,
       const std::map<uint32_t, EncodingSettings>& encoding_settings);
+
+  // Runs `num_instances` encoder and decoder pairs concurrently, each on its
+  // own copy of the video, and returns their aggregated throughput. Frames
+  // are fed to the codecs back-to-back regardless of the pacing settings, and
+  // PSNR is not computed, such that the CPU time is spent in the codecs.
+  static ThroughputStats RunThroughputTest(
+      const Environment& env,
+      const VideoSourceSettings& source_settings,
+      VideoEncoderFactory* encoder_factory,
+      VideoDecoderFactory* decoder_factory,
+      const EncoderSettings& encoder_settings,
+      const DecoderSettings& decoder_settings,
+      const std::map<uint32_t, EncodingSettings>& encoding_settings,
+      int num_instances);
 };
 
 }  // namespace test
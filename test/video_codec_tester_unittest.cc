@@ -676,6 +676,48 @@ INSTANTIATE_TEST_SUITE_P(
                                        .constant_rate = Frequency::Hertz(20)},
                         /*expected_delta_ms=*/50)));
 
+TEST(VideoCodecTesterThroughputTest, AggregatesAllInstances) {
+  constexpr int kNumFrames = 3;
+  constexpr int kNumInstances = 2;
+  std::string yuv_path = CreateYuvFile(kWidth, kHeight, kNumFrames);
+  VideoSourceSettings video_source_settings{
+      .file_path = yuv_path,
+      .resolution = {.width = kWidth, .height = kHeight},
+      .framerate = kTargetFramerate};
+
+  NiceMock<MockVideoEncoderFactory> encoder_factory;
+  ON_CALL(encoder_factory, CreateVideoEncoder)
+      .WillByDefault([](const SdpVideoFormat&) {
+        return std::make_unique<NiceMock<TestVideoEncoder>>(
+            ScalabilityMode::kL1T1,
+            std::vector<std::vector<Frame>>(
+                kNumFrames, {{.frame_size = DataSize::Bytes(1)}}));
+      });
+
+  NiceMock<MockVideoDecoderFactory> decoder_factory;
+  ON_CALL(decoder_factory, Create).WillByDefault(WithoutArgs([] {
+    return std::make_unique<NiceMock<TestVideoDecoder>>();
+  }));
+
+  std::map<uint32_t, EncodingSettings> encoding_settings =
+      VideoCodecTester::CreateEncodingSettings(
+          "VP8", "L1T1", kWidth, kHeight, {/*bitrate_kbps=*/128},
+          kTargetFramerate.hertz(), kNumFrames);
+
+  VideoCodecTester::ThroughputStats stats = VideoCodecTester::RunThroughputTest(
+      CreateEnvironment(), video_source_settings, &encoder_factory,
+      &decoder_factory, EncoderSettings{}, DecoderSettings{}, encoding_settings,
+      kNumInstances);
+  remove(yuv_path.c_str());
+
+  EXPECT_EQ(stats.num_instances, kNumInstances);
+  EXPECT_EQ(stats.num_decoded_frames, kNumInstances * kNumFrames);
+  EXPECT_EQ(stats.encode_time_ms.NumSamples(), kNumInstances * kNumFrames);
+  EXPECT_EQ(stats.latency_ms.NumSamples(), kNumInstances * kNumFrames);
+  EXPECT_GT(stats.wall_time, TimeDelta::Zero());
+  EXPECT_GT(stats.fps(), 0.0);
+}
+
 struct EncodingSettingsTestParameters {
   std::string codec_type;
   std::string scalability_mode;
@@ -85,6 +85,13 @@ void EncodeUsageResource::OnEncodeCompleted(
                                encode_duration_us);
 }
 
+void EncodeUsageResource::OnEncodeCpuTimeMeasured(int64_t capture_time_us,
+                                                  TimeDelta encode_cpu_time) {
+  RTC_DCHECK_RUN_ON(encoder_queue());
+  overuse_detector_->FrameEncodeCpuTimeMeasured(
+      capture_time_us, static_cast<int>(encode_cpu_time.us()));
+}
+
 void EncodeUsageResource::AdaptUp() {
   RTC_DCHECK_RUN_ON(encoder_queue());
   OnResourceUsageStateMeasured(ResourceUsageState::kUnderuse);
@@ -16,6 +16,7 @@
 
 #include "absl/types/optional.h"
 #include "api/scoped_refptr.h"
+#include "api/units/time_delta.h"
 #include "api/video/video_adaptation_reason.h"
 #include "video/adaptation/overuse_frame_detector.h"
 #include "video/adaptation/video_stream_encoder_resource.h"
@@ -49,6 +50,8 @@ class EncodeUsageResource : public VideoStreamEncoderResource,
                          int64_t time_sent_in_us,
                          int64_t capture_time_us,
                          absl::optional<int> encode_duration_us);
+  void OnEncodeCpuTimeMeasured(int64_t capture_time_us,
+                               TimeDelta encode_cpu_time);
 
   // OveruseFrameDetectorObserverInterface implementation.
   void AdaptUp() override;
@@ -569,6 +569,10 @@ void OveruseFrameDetector::FrameSent(uint32_t timestamp,
                                      int64_t capture_time_us,
                                      absl::optional<int> encode_duration_us) {
   RTC_DCHECK_RUN_ON(&task_checker_);
+  if (options_.use_thread_cpu_time) {
+    // The usage is fed by FrameEncodeCpuTimeMeasured() instead.
+    return;
+  }
   encode_duration_us = usage_->FrameSent(timestamp, time_sent_in_us,
                                          capture_time_us, encode_duration_us);
 
@@ -578,6 +582,22 @@ void OveruseFrameDetector::FrameSent(uint32_t timestamp,
   }
 }
 
+void OveruseFrameDetector::FrameEncodeCpuTimeMeasured(
+    int64_t capture_time_us,
+    int encode_cpu_time_us) {
+  RTC_DCHECK_RUN_ON(&task_checker_);
+  if (!options_.use_thread_cpu_time) {
+    return;
+  }
+  absl::optional<int> encode_duration_us =
+      usage_->FrameSent(/*timestamp=*/0, /*time_sent_in_us=*/capture_time_us,
+                        capture_time_us, encode_cpu_time_us);
+  if (encode_duration_us) {
+    EncodedFrameTimeMeasured(*encode_duration_us /
+                             rtc::kNumMicrosecsPerMillisec);
+  }
+}
+
 void OveruseFrameDetector::CheckForOveruse(
     OveruseFrameDetectorObserverInterface* observer) {
   RTC_DCHECK_RUN_ON(&task_checker_);
@@ -636,6 +656,7 @@ void OveruseFrameDetector::CheckForOveruse(
 
 void OveruseFrameDetector::SetOptions(const CpuOveruseOptions& options) {
   RTC_DCHECK_RUN_ON(&task_checker_);
+  RTC_DCHECK(!options.use_thread_cpu_time || options.filter_time_ms > 0);
   options_ = options;
 
   // Time constant config overridable by field trial.
@@ -53,6 +53,10 @@ struct CpuOveruseOptions {
   int high_threshold_consecutive_count = 2;
   // New estimator enabled if this is set non-zero.
   int filter_time_ms = 0;  // Time constant for averaging
+  // Estimate the usage from the thread CPU time spent encoding, reported with
+  // FrameEncodeCpuTimeMeasured(), instead of from wall-clock encode time.
+  // Requires the new estimator.
+  bool use_thread_cpu_time = false;
 };
 
 class OveruseFrameDetectorObserverInterface {
@@ -105,6 +109,11 @@ class OveruseFrameDetector {
                  int64_t capture_time_us,
                  absl::optional<int> encode_duration_us);
 
+  // Called with the thread CPU time spent encoding the frame captured at
+  // `capture_time_us`, if CpuOveruseOptions::use_thread_cpu_time is set.
+  void FrameEncodeCpuTimeMeasured(int64_t capture_time_us,
+                                  int encode_cpu_time_us);
+
   // Interface for cpu load estimation. Intended for internal use only.
   class ProcessingUsage {
    public:
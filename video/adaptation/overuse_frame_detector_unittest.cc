@@ -1016,4 +1016,33 @@ TEST_F(OveruseFrameDetectorTest2, NoOveruseForSimulcast) {
   EXPECT_LE(UsagePercent(), 45);
 }
 
+TEST_F(OveruseFrameDetectorTest2, UsesEncodeCpuTimeWhenEnabled) {
+  options_.use_thread_cpu_time = true;
+  overuse_detector_->SetOptions(options_);
+  constexpr int kNumFrames = 500;
+  constexpr int kIntervalUs = 30 * rtc::kNumMicrosecsPerMillisec;
+  constexpr int kEncodeCpuTimeUs = 12 * rtc::kNumMicrosecsPerMillisec;
+  for (int i = 0; i < kNumFrames; ++i) {
+    int64_t capture_time_us = rtc::TimeMicros();
+    // Wall-clock encode durations are ignored.
+    overuse_detector_->FrameSent(0, 0, capture_time_us, kIntervalUs);
+    overuse_detector_->FrameEncodeCpuTimeMeasured(capture_time_us,
+                                                  kEncodeCpuTimeUs);
+    clock_.AdvanceTime(TimeDelta::Micros(kIntervalUs));
+  }
+  // 12 ms / 30 ms.
+  EXPECT_GE(UsagePercent(), 35);
+  EXPECT_LE(UsagePercent(), 45);
+}
+
+TEST_F(OveruseFrameDetectorTest2, IgnoresEncodeCpuTimeWhenDisabled) {
+  overuse_detector_->SetOptions(options_);
+  InsertAndSendFramesWithInterval(500, kFrameIntervalUs, kWidth, kHeight,
+                                  kProcessTimeUs);
+  const int usage_percent = UsagePercent();
+  overuse_detector_->FrameEncodeCpuTimeMeasured(rtc::TimeMicros(),
+                                                kFrameIntervalUs);
+  EXPECT_EQ(UsagePercent(), usage_percent);
+}
+
 }  // namespace webrtc
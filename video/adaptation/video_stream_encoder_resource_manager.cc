@@ -46,6 +46,11 @@ namespace {
 constexpr const char* kPixelLimitResourceFieldTrialName =
     "WebRTC-PixelLimitResource";
 
+// Measures encode usage in thread CPU time rather than in wall-clock time, so
+// that scheduling delays on a loaded machine aren't taken for encode cost.
+constexpr const char* kThreadCpuTimeFieldTrialName =
+    "WebRTC-CpuOveruse-ThreadCpuTime";
+
 bool IsResolutionScalingEnabled(DegradationPreference degradation_preference) {
   return degradation_preference == DegradationPreference::MAINTAIN_FRAMERATE ||
          degradation_preference == DegradationPreference::BALANCED;
@@ -290,6 +295,8 @@ VideoStreamEncoderResourceManager::VideoStreamEncoderResourceManager(
       balanced_settings_(field_trials),
       clock_(clock),
       experiment_cpu_load_estimator_(experiment_cpu_load_estimator),
+      thread_cpu_time_enabled_(
+          field_trials.IsEnabled(kThreadCpuTimeFieldTrialName)),
       initial_frame_dropper_(
           std::make_unique<InitialFrameDropper>(quality_scaler_resource_,
                                                 field_trials)),
@@ -527,6 +534,19 @@ void VideoStreamEncoderResourceManager::OnFrameDropped(
   quality_scaler_resource_->OnFrameDropped(reason);
 }
 
+void VideoStreamEncoderResourceManager::OnEncodeCpuTimeMeasured(
+    const VideoFrame& frame,
+    TimeDelta encode_cpu_time) {
+  RTC_DCHECK_RUN_ON(encoder_queue_);
+  // Keyed by the same capture time as OnEncodeCompleted().
+  encode_usage_resource_->OnEncodeCpuTimeMeasured(
+      frame.render_time_ms() * rtc::kNumMicrosecsPerMillisec, encode_cpu_time);
+}
+
+bool VideoStreamEncoderResourceManager::UsesThreadCpuTime() const {
+  return thread_cpu_time_enabled_;
+}
+
 bool VideoStreamEncoderResourceManager::DropInitialFrames() const {
   RTC_DCHECK_RUN_ON(encoder_queue_);
   return initial_frame_dropper_->DropInitialFrames();
@@ -683,6 +703,17 @@ CpuOveruseOptions VideoStreamEncoderResourceManager::GetCpuOveruseOptions()
   if (encoder_settings_->encoder_info().is_hardware_accelerated) {
     options.low_encode_usage_threshold_percent = 150;
     options.high_encode_usage_threshold_percent = 200;
+  } else if (thread_cpu_time_enabled_) {
+    // The reported CPU time is already normalized by the number of threads
+    // the encoder encodes on, see VideoStreamEncoder.
+    options.use_thread_cpu_time = true;
+    options.filter_time_ms = 5 * rtc::kNumMillisecsPerSec;
+  } else if (encoder_settings_->encoder_info().num_threads > 1) {
+    // Encode usage is measured in wall-clock time, which a multithreaded
+    // software encoder keeps low while using several cores. Only adapt up
+    // when there is headroom in the CPU time spent on all of its threads.
+    options.low_encode_usage_threshold_percent /=
+        encoder_settings_->encoder_info().num_threads;
   }
   if (experiment_cpu_load_estimator_) {
     options.filter_time_ms = 5 * rtc::kNumMillisecsPerSec;
@@ -124,6 +124,13 @@ class VideoStreamEncoderResourceManager
                          absl::optional<int> encode_duration_us,
                          DataSize frame_size);
   void OnFrameDropped(EncodedImageCallback::DropReason reason);
+  // Reports the thread CPU time spent encoding `frame`, including work the
+  // encoder did on threads of its own.
+  void OnEncodeCpuTimeMeasured(const VideoFrame& frame,
+                               TimeDelta encode_cpu_time);
+  // True if CPU adaptation uses the thread CPU time of the encoder, which then
+  // has to be reported with OnEncodeCpuTimeMeasured().
+  bool UsesThreadCpuTime() const;
 
   // Resources need to be mapped to an AdaptReason (kCpu or kQuality) in order
   // to update legacy getStats().
@@ -214,6 +221,7 @@ class VideoStreamEncoderResourceManager
   const BalancedDegradationSettings balanced_settings_;
   Clock* clock_ RTC_GUARDED_BY(encoder_queue_);
   const bool experiment_cpu_load_estimator_ RTC_GUARDED_BY(encoder_queue_);
+  const bool thread_cpu_time_enabled_;
   const std::unique_ptr<InitialFrameDropper> initial_frame_dropper_
       RTC_GUARDED_BY(encoder_queue_);
   const bool quality_scaling_experiment_enabled_ RTC_GUARDED_BY(encoder_queue_);
@@ -0,0 +1,251 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/decode_thread_pool.h"
+
+#include <algorithm>
+#include <deque>
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/event.h"
+
+namespace webrtc {
+
+constexpr char DecodeThreadPool::Config::kKey[];
+
+std::unique_ptr<StructParametersParser> DecodeThreadPool::Config::Parser() {
+  return StructParametersParser::Create("enabled", &enabled,  //
+                                        "max_threads", &max_threads);
+}
+
+class DecodeThreadPool::PooledTaskQueue : public TaskQueueBase {
+ public:
+  PooledTaskQueue(DecodeThreadPool* pool, uint64_t id) : pool_(pool), id_(id) {}
+  ~PooledTaskQueue() override = default;
+
+  void Delete() override { pool_->Delete(this); }
+
+  uint64_t id() const { return id_; }
+
+  struct Task {
+    absl::AnyInvocable<void() &&> task;
+    Timestamp deadline;
+  };
+
+  void RunTask(absl::AnyInvocable<void() &&> task) {
+    CurrentTaskQueueSetter set_current(this);
+    std::move(task)();
+    // Destroy the task while the queue is still current.
+    task = nullptr;
+  }
+
+  // Pending tasks are destroyed as if they were run on the queue.
+  void DestroyTasks(std::deque<Task> tasks) {
+    CurrentTaskQueueSetter set_current(this);
+    tasks.clear();
+  }
+
+  // State below is guarded by the mutex of the pool.
+  std::deque<Task> tasks;
+  // True while in the ready heap of the pool.
+  bool ready = false;
+  // True while a thread of the pool runs a task of this queue.
+  bool running = false;
+  bool deleted = false;
+  // Signaled when the running task completes after the queue was deleted.
+  rtc::Event* task_done = nullptr;
+
+ protected:
+  void PostTaskImpl(absl::AnyInvocable<void() &&> task,
+                    const PostTaskTraits& traits,
+                    const Location& location) override {
+    pool_->Post(this, std::move(task), Timestamp::MinusInfinity());
+  }
+
+  void PostDelayedTaskImpl(absl::AnyInvocable<void() &&> task,
+                           TimeDelta delay,
+                           const PostDelayedTaskTraits& traits,
+                           const Location& location) override {
+    pool_->PostDelayed(this, std::move(task), delay, traits.high_precision);
+  }
+
+ private:
+  DecodeThreadPool* const pool_;
+  const uint64_t id_;
+};
+
+std::unique_ptr<DecodeThreadPool> DecodeThreadPool::CreateFromFieldTrials(
+    const FieldTrialsView& field_trials,
+    TaskQueueFactory& task_queue_factory,
+    int num_cpu_cores) {
+  Config config;
+  config.Parser()->Parse(field_trials.Lookup(Config::kKey));
+  if (!config.enabled)
+    return nullptr;
+  int num_threads = std::max(1, std::min(config.max_threads, num_cpu_cores));
+  return std::make_unique<DecodeThreadPool>(task_queue_factory, num_threads);
+}
+
+DecodeThreadPool::DecodeThreadPool(TaskQueueFactory& task_queue_factory,
+                                   int num_threads)
+    : timer_queue_(task_queue_factory.CreateTaskQueue(
+          "DecodeThreadPoolTimer",
+          TaskQueueFactory::Priority::HIGH)) {
+  RTC_DCHECK_GT(num_threads, 0);
+  for (int i = 0; i < num_threads; ++i) {
+    threads_.push_back(task_queue_factory.CreateTaskQueue(
+        "DecodingQueue", TaskQueueFactory::Priority::HIGH));
+  }
+  MutexLock lock(&mutex_);
+  for (const auto& thread : threads_)
+    idle_threads_.push_back(thread.get());
+}
+
+DecodeThreadPool::~DecodeThreadPool() {
+  {
+    MutexLock lock(&mutex_);
+    RTC_DCHECK(queues_.empty());
+  }
+  // Drop pending delayed tasks before the threads they would be posted to.
+  timer_queue_ = nullptr;
+  threads_.clear();
+}
+
+std::unique_ptr<TaskQueueBase, TaskQueueDeleter>
+DecodeThreadPool::CreateTaskQueue() {
+  MutexLock lock(&mutex_);
+  uint64_t id = next_queue_id_++;
+  auto* queue = new PooledTaskQueue(this, id);
+  queues_[id] = queue;
+  return std::unique_ptr<TaskQueueBase, TaskQueueDeleter>(queue);
+}
+
+void DecodeThreadPool::PostTaskWithDeadline(TaskQueueBase* task_queue,
+                                            absl::AnyInvocable<void() &&> task,
+                                            Timestamp deadline) {
+  Post(static_cast<PooledTaskQueue*>(task_queue), std::move(task), deadline);
+}
+
+void DecodeThreadPool::Post(PooledTaskQueue* queue,
+                            absl::AnyInvocable<void() &&> task,
+                            Timestamp deadline) {
+  MutexLock lock(&mutex_);
+  RTC_DCHECK(!queue->deleted);
+  PostLocked(queue, std::move(task), deadline);
+}
+
+void DecodeThreadPool::PostLocked(PooledTaskQueue* queue,
+                                  absl::AnyInvocable<void() &&> task,
+                                  Timestamp deadline) {
+  queue->tasks.push_back({std::move(task), deadline});
+  if (queue->ready || queue->running)
+    return;
+  PushReady(queue);
+  if (!idle_threads_.empty()) {
+    TaskQueueBase* thread = idle_threads_.back();
+    idle_threads_.pop_back();
+    thread->PostTask([this, thread] { RunTasks(thread); });
+  }
+}
+
+void DecodeThreadPool::PostDelayed(PooledTaskQueue* queue,
+                                   absl::AnyInvocable<void() &&> task,
+                                   TimeDelta delay,
+                                   bool high_precision) {
+  // The queue may be deleted before the delay expires, so look it up by id.
+  auto post = [this, id = queue->id(), task = std::move(task)]() mutable {
+    MutexLock lock(&mutex_);
+    auto it = queues_.find(id);
+    if (it != queues_.end())
+      PostLocked(it->second, std::move(task), Timestamp::MinusInfinity());
+  };
+  if (high_precision) {
+    timer_queue_->PostDelayedHighPrecisionTask(std::move(post), delay);
+  } else {
+    timer_queue_->PostDelayedTask(std::move(post), delay);
+  }
+}
+
+void DecodeThreadPool::Delete(PooledTaskQueue* queue) {
+  RTC_DCHECK(!queue->IsCurrent());
+  std::deque<PooledTaskQueue::Task> tasks;
+  rtc::Event task_done;
+  bool running;
+  {
+    MutexLock lock(&mutex_);
+    queues_.erase(queue->id());
+    queue->deleted = true;
+    if (queue->ready) {
+      ready_queues_.erase(
+          std::find_if(ready_queues_.begin(), ready_queues_.end(),
+                       [&](const ReadyQueue& r) { return r.queue == queue; }));
+      std::make_heap(ready_queues_.begin(), ready_queues_.end(), &LessUrgent);
+      queue->ready = false;
+    }
+    tasks = std::move(queue->tasks);
+    running = queue->running;
+    if (running)
+      queue->task_done = &task_done;
+  }
+  if (running)
+    task_done.Wait(rtc::Event::kForever);
+
+  queue->DestroyTasks(std::move(tasks));
+  delete queue;
+}
+
+void DecodeThreadPool::PushReady(PooledTaskQueue* queue) {
+  RTC_DCHECK(!queue->tasks.empty());
+  ready_queues_.push_back(
+      {queue->tasks.front().deadline, next_order_++, queue});
+  std::push_heap(ready_queues_.begin(), ready_queues_.end(), &LessUrgent);
+  queue->ready = true;
+}
+
+bool DecodeThreadPool::LessUrgent(const ReadyQueue& a, const ReadyQueue& b) {
+  return b.deadline < a.deadline ||
+         (b.deadline == a.deadline && b.order < a.order);
+}
+
+void DecodeThreadPool::RunTasks(TaskQueueBase* thread) {
+  PooledTaskQueue* queue = nullptr;
+  while (true) {
+    absl::AnyInvocable<void() &&> task;
+    {
+      MutexLock lock(&mutex_);
+      if (queue) {
+        queue->running = false;
+        if (queue->deleted) {
+          // `queue` is deleted as soon as this is signaled.
+          if (queue->task_done)
+            queue->task_done->Set();
+        } else if (!queue->tasks.empty()) {
+          PushReady(queue);
+        }
+      }
+      if (ready_queues_.empty()) {
+        idle_threads_.push_back(thread);
+        return;
+      }
+      std::pop_heap(ready_queues_.begin(), ready_queues_.end(), &LessUrgent);
+      queue = ready_queues_.back().queue;
+      ready_queues_.pop_back();
+      queue->ready = false;
+      queue->running = true;
+      task = std::move(queue->tasks.front().task);
+      queue->tasks.pop_front();
+    }
+
+    queue->RunTask(std::move(task));
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,127 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VIDEO_DECODE_THREAD_POOL_H_
+#define VIDEO_DECODE_THREAD_POOL_H_
+
+#include <stdint.h>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "absl/functional/any_invocable.h"
+#include "api/field_trials_view.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/task_queue/task_queue_factory.h"
+#include "api/units/timestamp.h"
+#include "rtc_base/experiments/struct_parameters_parser.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Runs the decode task queues of several video receive streams on a bounded
+// number of threads, instead of one thread per stream.
+//
+// Every stream gets its own task queue from `CreateTaskQueue()`. Tasks posted
+// to such a queue run in FIFO order and never overlap, as for any other task
+// queue, but the queues share the threads of the pool. When more queues have
+// pending tasks than there are threads, the queue whose next task has the
+// earliest deadline runs first. Decode tasks are posted with the render time of
+// their frame as deadline, see `PostTaskWithDeadline()`, so that the frames
+// closest to being rendered are decoded first. Together with the
+// DecodeSynchronizer, which releases the frames of all streams on the same
+// metronome tick, this orders the decodes of a tick by deadline.
+//
+// All task queues must be deleted before the pool is destroyed.
+class DecodeThreadPool {
+ public:
+  struct Config {
+    static constexpr char kKey[] = "WebRTC-Video-DecodeThreadPool";
+    std::unique_ptr<StructParametersParser> Parser();
+
+    bool enabled = false;
+    // The pool uses at most this many threads, and never more than the number
+    // of cores.
+    int max_threads = 4;
+  };
+
+  // Returns a pool configured from `field_trials`, or nullptr if not enabled.
+  static std::unique_ptr<DecodeThreadPool> CreateFromFieldTrials(
+      const FieldTrialsView& field_trials,
+      TaskQueueFactory& task_queue_factory,
+      int num_cpu_cores);
+
+  DecodeThreadPool(TaskQueueFactory& task_queue_factory, int num_threads);
+  ~DecodeThreadPool();
+
+  DecodeThreadPool(const DecodeThreadPool&) = delete;
+  DecodeThreadPool& operator=(const DecodeThreadPool&) = delete;
+
+  int num_threads() const { return static_cast<int>(threads_.size()); }
+
+  // Creates a task queue that runs its tasks on the threads of this pool.
+  // Tasks posted with TaskQueueBase::PostTask have no deadline and run before
+  // any task that has one.
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> CreateTaskQueue();
+
+  // Posts `task` to `task_queue`, which must have been created by this pool.
+  // `deadline` only affects the order in which queues get a thread, the tasks
+  // of a single queue always run in the order they were posted.
+  void PostTaskWithDeadline(TaskQueueBase* task_queue,
+                            absl::AnyInvocable<void() &&> task,
+                            Timestamp deadline);
+
+ private:
+  class PooledTaskQueue;
+  struct ReadyQueue {
+    Timestamp deadline;
+    uint64_t order;
+    PooledTaskQueue* queue;
+  };
+
+  // Max-heap order of `ready_queues_`: the earliest deadline is at the top,
+  // and among equal deadlines the queue that became ready first.
+  static bool LessUrgent(const ReadyQueue& a, const ReadyQueue& b);
+
+  void Post(PooledTaskQueue* queue,
+            absl::AnyInvocable<void() &&> task,
+            Timestamp deadline);
+  void PostLocked(PooledTaskQueue* queue,
+                  absl::AnyInvocable<void() &&> task,
+                  Timestamp deadline) RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  void PostDelayed(PooledTaskQueue* queue,
+                   absl::AnyInvocable<void() &&> task,
+                   TimeDelta delay,
+                   bool high_precision);
+  void Delete(PooledTaskQueue* queue);
+
+  void PushReady(PooledTaskQueue* queue) RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  // Runs ready queues on `thread` until there are none left.
+  void RunTasks(TaskQueueBase* thread);
+
+  Mutex mutex_;
+  // Queues with pending tasks that are not running, see LessUrgent().
+  std::vector<ReadyQueue> ready_queues_ RTC_GUARDED_BY(mutex_);
+  uint64_t next_order_ RTC_GUARDED_BY(mutex_) = 0;
+  std::vector<TaskQueueBase*> idle_threads_ RTC_GUARDED_BY(mutex_);
+  // Live queues by id, used to drop delayed tasks of deleted queues.
+  std::map<uint64_t, PooledTaskQueue*> queues_ RTC_GUARDED_BY(mutex_);
+  uint64_t next_queue_id_ RTC_GUARDED_BY(mutex_) = 0;
+
+  // Runs timers for delayed tasks, which are then posted to their queue.
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> timer_queue_;
+  std::vector<std::unique_ptr<TaskQueueBase, TaskQueueDeleter>> threads_;
+};
+
+}  // namespace webrtc
+
+#endif  // VIDEO_DECODE_THREAD_POOL_H_
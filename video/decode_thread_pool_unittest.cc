@@ -0,0 +1,148 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/decode_thread_pool.h"
+
+#include <memory>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "api/task_queue/default_task_queue_factory.h"
+#include "api/task_queue/task_queue_test.h"
+#include "rtc_base/event.h"
+#include "system_wrappers/include/sleep.h"
+#include "test/explicit_key_value_config.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+
+constexpr TimeDelta kTimeout = TimeDelta::Seconds(5);
+
+// Hands out task queues of a pool, so that the generic task queue tests run
+// against them.
+class PooledTaskQueueFactory : public TaskQueueFactory {
+ public:
+  PooledTaskQueueFactory()
+      : factory_(CreateDefaultTaskQueueFactory()), pool_(*factory_, 2) {}
+
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> CreateTaskQueue(
+      absl::string_view name,
+      Priority priority) const override {
+    return pool_.CreateTaskQueue();
+  }
+
+ private:
+  const std::unique_ptr<TaskQueueFactory> factory_;
+  mutable DecodeThreadPool pool_;
+};
+
+std::unique_ptr<TaskQueueFactory> CreatePooledTaskQueueFactory(
+    const FieldTrialsView* field_trials) {
+  return std::make_unique<PooledTaskQueueFactory>();
+}
+
+INSTANTIATE_TEST_SUITE_P(DecodeThreadPool,
+                         TaskQueueTest,
+                         ::testing::Values(CreatePooledTaskQueueFactory));
+
+TEST(DecodeThreadPoolTest, DisabledByDefault) {
+  test::ExplicitKeyValueConfig field_trials("");
+  auto factory = CreateDefaultTaskQueueFactory();
+  EXPECT_EQ(DecodeThreadPool::CreateFromFieldTrials(field_trials, *factory,
+                                                    /*num_cpu_cores=*/8),
+            nullptr);
+}
+
+TEST(DecodeThreadPoolTest, NumberOfThreadsIsLimitedByCores) {
+  test::ExplicitKeyValueConfig field_trials(
+      "WebRTC-Video-DecodeThreadPool/enabled:true,max_threads:6/");
+  auto factory = CreateDefaultTaskQueueFactory();
+  auto pool = DecodeThreadPool::CreateFromFieldTrials(field_trials, *factory,
+                                                      /*num_cpu_cores=*/3);
+  ASSERT_NE(pool, nullptr);
+  EXPECT_EQ(pool->num_threads(), 3);
+}
+
+TEST(DecodeThreadPoolTest, RunsEarliestDeadlineFirst) {
+  auto factory = CreateDefaultTaskQueueFactory();
+  DecodeThreadPool pool(*factory, /*num_threads=*/1);
+  auto blocked = pool.CreateTaskQueue();
+  auto late = pool.CreateTaskQueue();
+  auto early = pool.CreateTaskQueue();
+  auto middle = pool.CreateTaskQueue();
+
+  // Occupy the only thread while the other queues get their tasks.
+  rtc::Event unblock;
+  blocked->PostTask([&] { unblock.Wait(kTimeout); });
+
+  std::vector<int> order;
+  rtc::Event done;
+  pool.PostTaskWithDeadline(
+      late.get(), [&] { order.push_back(3); }, Timestamp::Millis(30));
+  pool.PostTaskWithDeadline(
+      early.get(), [&] { order.push_back(1); }, Timestamp::Millis(10));
+  pool.PostTaskWithDeadline(
+      middle.get(), [&] { order.push_back(2); }, Timestamp::Millis(20));
+  pool.PostTaskWithDeadline(
+      late.get(), [&] { done.Set(); }, Timestamp::Millis(30));
+  unblock.Set();
+
+  ASSERT_TRUE(done.Wait(kTimeout));
+  EXPECT_THAT(order, ElementsAre(1, 2, 3));
+}
+
+TEST(DecodeThreadPoolTest, RunsTasksOfOneQueueInPostOrder) {
+  auto factory = CreateDefaultTaskQueueFactory();
+  DecodeThreadPool pool(*factory, /*num_threads=*/4);
+  auto queue = pool.CreateTaskQueue();
+
+  std::vector<int> order;
+  rtc::Event done;
+  // A later task of the same queue never overtakes an earlier one.
+  pool.PostTaskWithDeadline(
+      queue.get(), [&] { order.push_back(1); }, Timestamp::Millis(30));
+  pool.PostTaskWithDeadline(
+      queue.get(), [&] { order.push_back(2); }, Timestamp::Millis(10));
+  queue->PostTask([&] {
+    order.push_back(3);
+    done.Set();
+  });
+
+  ASSERT_TRUE(done.Wait(kTimeout));
+  EXPECT_THAT(order, ElementsAre(1, 2, 3));
+}
+
+TEST(DecodeThreadPoolTest, DeleteWaitsForRunningTaskAndDropsPendingTasks) {
+  auto factory = CreateDefaultTaskQueueFactory();
+  DecodeThreadPool pool(*factory, /*num_threads=*/1);
+  auto queue = pool.CreateTaskQueue();
+
+  rtc::Event started;
+  bool finished = false;
+  bool ran_pending = false;
+  queue->PostTask([&] {
+    started.Set();
+    SleepMs(10);
+    finished = true;
+  });
+  queue->PostTask([&] { ran_pending = true; });
+  ASSERT_TRUE(started.Wait(kTimeout));
+
+  queue = nullptr;
+  EXPECT_TRUE(finished);
+  EXPECT_FALSE(ran_pending);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -20,6 +20,7 @@
 #include "absl/algorithm/container.h"
 #include "absl/base/attributes.h"
 #include "absl/cleanup/cleanup.h"
+#include "absl/functional/any_invocable.h"
 #include "api/sequence_checker.h"
 #include "api/task_queue/pending_task_safety_flag.h"
 #include "api/task_queue/task_queue_base.h"
@@ -97,15 +98,20 @@ class PassthroughAdapterMode : public AdapterMode {
       FrameCadenceAdapterInterface::kFrameRateAveragingWindowSizeMs, 1000};
 };
 
+class VSyncEncodeAdapterMode;
+
 // Implements a frame cadence adapter supporting zero-hertz input.
 class ZeroHertzAdapterMode : public AdapterMode {
  public:
+  // If `vsync_encode_adapter` is non-null, idle repeats are aligned to its
+  // metronome. It must outlive this object.
   ZeroHertzAdapterMode(TaskQueueBase* queue,
                        Clock* clock,
                        FrameCadenceAdapterInterface::Callback* callback,
                        double max_fps,
                        std::atomic<int>& frames_scheduled_for_processing,
-                       bool zero_hertz_queue_overload);
+                       bool zero_hertz_queue_overload,
+                       VSyncEncodeAdapterMode* vsync_encode_adapter);
   ~ZeroHertzAdapterMode() { refresh_frame_requester_.Stop(); }
 
   // Reconfigures according to parameters.
@@ -226,6 +232,9 @@ class ZeroHertzAdapterMode : public AdapterMode {
   // Can be used as kill-switch for the queue overload mechanism.
   const bool zero_hertz_queue_overload_enabled_;
 
+  // Aligns idle repeats to the metronome tick if set.
+  VSyncEncodeAdapterMode* const vsync_encode_adapter_;
+
   // How much the incoming frame sequence is delayed by.
   const TimeDelta frame_delay_ = TimeDelta::Seconds(1) / max_fps_;
 
@@ -293,6 +302,11 @@ class VSyncEncodeAdapterMode : public AdapterMode {
 
   void EncodeAllEnqueuedFrames();
 
+  // Posts `task` to the queue on the next metronome tick. This lets tasks of
+  // several streams that aren't time critical, like idle repeats, wake up
+  // together with the encoding of the other streams.
+  void PostTaskOnNextTick(absl::AnyInvocable<void() &&> task);
+
  private:
   // Holds input frames coming from the client ready to be encoded.
   struct InputFrameRef {
@@ -350,6 +364,7 @@ class FrameCadenceAdapterImpl : public FrameCadenceAdapterInterface {
   // VideoFrameSink overrides.
   void OnFrame(const VideoFrame& frame) override;
   void OnDiscardedFrame() override;
+  bool WantsFrame(int64_t timestamp_us) override;
   void OnConstraintsChanged(
       const VideoTrackSourceConstraints& constraints) override;
 
@@ -431,13 +446,15 @@ ZeroHertzAdapterMode::ZeroHertzAdapterMode(
     FrameCadenceAdapterInterface::Callback* callback,
     double max_fps,
     std::atomic<int>& frames_scheduled_for_processing,
-    bool zero_hertz_queue_overload_enabled)
+    bool zero_hertz_queue_overload_enabled,
+    VSyncEncodeAdapterMode* vsync_encode_adapter)
     : queue_(queue),
       clock_(clock),
       callback_(callback),
       max_fps_(max_fps),
       frames_scheduled_for_processing_(frames_scheduled_for_processing),
-      zero_hertz_queue_overload_enabled_(zero_hertz_queue_overload_enabled) {
+      zero_hertz_queue_overload_enabled_(zero_hertz_queue_overload_enabled),
+      vsync_encode_adapter_(vsync_encode_adapter) {
   sequence_checker_.Detach();
   MaybeStartRefreshFrameRequester();
 }
@@ -643,6 +660,21 @@ void ZeroHertzAdapterMode::ScheduleRepeat(int frame_id, bool idle_repeat) {
   scheduled_repeat_->idle = idle_repeat;
 
   TimeDelta repeat_delay = RepeatDuration(idle_repeat);
+  if (idle_repeat && vsync_encode_adapter_) {
+    // Idle repeats aren't time critical, so they wait for the next metronome
+    // tick to be encoded together with other streams.
+    queue_->PostDelayedTask(
+        SafeTask(safety_.flag(),
+                 [this, frame_id] {
+                   vsync_encode_adapter_->PostTaskOnNextTick(
+                       SafeTask(safety_.flag(), [this, frame_id] {
+                         RTC_DCHECK_RUN_ON(&sequence_checker_);
+                         ProcessRepeatedFrameOnDelayedCadence(frame_id);
+                       }));
+                 }),
+        repeat_delay);
+    return;
+  }
   queue_->PostDelayedHighPrecisionTask(
       SafeTask(safety_.flag(),
                [this, frame_id] {
@@ -825,6 +857,23 @@ void VSyncEncodeAdapterMode::EncodeAllEnqueuedFrames() {
   input_queue_.clear();
 }
 
+void VSyncEncodeAdapterMode::PostTaskOnNextTick(
+    absl::AnyInvocable<void() &&> task) {
+  if (!worker_queue_->IsCurrent()) {
+    worker_queue_->PostTask(SafeTask(
+        worker_safety_.flag(), [this, task = std::move(task)]() mutable {
+          PostTaskOnNextTick(std::move(task));
+        }));
+    return;
+  }
+
+  RTC_DCHECK_RUN_ON(&worker_sequence_checker_);
+  metronome_->RequestCallOnNextTick(SafeTask(
+      worker_safety_.flag(), [this, task = std::move(task)]() mutable {
+        queue_->PostTask(SafeTask(queue_safety_flag_, std::move(task)));
+      }));
+}
+
 FrameCadenceAdapterImpl::FrameCadenceAdapterImpl(
     Clock* clock,
     TaskQueueBase* queue,
@@ -961,6 +1010,10 @@ void FrameCadenceAdapterImpl::OnDiscardedFrame() {
   }));
 }
 
+bool FrameCadenceAdapterImpl::WantsFrame(int64_t timestamp_us) {
+  return callback_->WantsFrame(timestamp_us);
+}
+
 void FrameCadenceAdapterImpl::OnConstraintsChanged(
     const VideoTrackSourceConstraints& constraints) {
   RTC_LOG(LS_INFO) << __func__ << " this " << this << " min_fps "
@@ -1013,7 +1066,8 @@ void FrameCadenceAdapterImpl::MaybeReconfigureAdapters(
       zero_hertz_adapter_.emplace(
           queue_, clock_, callback_, source_constraints_->max_fps.value(),
           frames_scheduled_for_processing_,
-          frame_cadence_adapter_zero_hertz_queue_overload_enabled_);
+          frame_cadence_adapter_zero_hertz_queue_overload_enabled_,
+          vsync_encode_adapter_.get());
       zero_hertz_adapter_->UpdateVideoSourceRestrictions(
           restricted_max_frame_rate_);
       zero_hertz_adapter_created_timestamp_ = clock_->CurrentTime();
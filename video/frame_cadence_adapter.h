@@ -71,6 +71,10 @@ class FrameCadenceAdapterInterface
     // Called when the source has discarded a frame.
     virtual void OnDiscardedFrame() = 0;
 
+    // Called on the frame delivery thread before the source produces a frame
+    // captured at `timestamp_us`. Returns false if the frame will be dropped.
+    virtual bool WantsFrame(int64_t timestamp_us) { return true; }
+
     // Called when the adapter needs the source to send a refresh frame.
     virtual void RequestRefreshFrame() = 0;
   };
@@ -78,7 +82,10 @@ class FrameCadenceAdapterInterface
   // Factory function creating a production instance. Deletion of the returned
   // instance needs to happen on the same sequence that Create() was called on.
   // Frames arriving in FrameCadenceAdapterInterface::OnFrame are posted to
-  // Callback::OnFrame on the |queue|.
+  // Callback::OnFrame on the |queue|. If |metronome| is non-null, frames are
+  // posted on its ticks, as are idle repeats in zero-hertz mode, so that the
+  // encoders of several streams run together. The metronome is used on
+  // |worker_queue|.
   static std::unique_ptr<FrameCadenceAdapterInterface> Create(
       Clock* clock,
       TaskQueueBase* queue,
@@ -691,6 +691,59 @@ TEST(FrameCadenceAdapterTest, EncodeFramesAreAlignedWithMetronomeTick) {
   finalized.Wait(rtc::Event::kForever);
 }
 
+TEST(FrameCadenceAdapterTest, IdleRepeatsAreAlignedWithMetronomeTick) {
+  ZeroHertzFieldTrialEnabler enabler;
+  GlobalSimulatedTimeController time_controller(Timestamp::Zero());
+  static constexpr TimeDelta kFrameDelay = TimeDelta::Millis(100);
+  auto queue = time_controller.GetTaskQueueFactory()->CreateTaskQueue(
+      "queue", TaskQueueFactory::Priority::NORMAL);
+  auto worker_queue = time_controller.GetTaskQueueFactory()->CreateTaskQueue(
+      "work_queue", TaskQueueFactory::Priority::NORMAL);
+  test::ForcedTickMetronome metronome(TimeDelta::Millis(33));
+  auto adapter = FrameCadenceAdapterInterface::Create(
+      time_controller.GetClock(), queue.get(), &metronome, worker_queue.get(),
+      enabler);
+  MockCallback callback;
+  adapter->Initialize(&callback);
+  queue->PostTask([&] {
+    adapter->SetZeroHertzModeEnabled(
+        FrameCadenceAdapterInterface::ZeroHertzModeParams{
+            /*num_simulcast_layers=*/1});
+    adapter->OnConstraintsChanged(VideoTrackSourceConstraints{
+        /*min_fps=*/0, /*max_fps=*/TimeDelta::Seconds(1) / kFrameDelay});
+  });
+  time_controller.AdvanceTime(TimeDelta::Zero());
+
+  // The frame and the short repeat are sent without waiting for a tick.
+  EXPECT_CALL(callback, OnFrame).Times(2);
+  adapter->OnFrame(CreateFrame());
+  time_controller.AdvanceTime(kFrameDelay);
+  queue->PostTask([&] {
+    adapter->UpdateLayerQualityConvergence(/*spatial_index=*/0, true);
+  });
+  time_controller.AdvanceTime(kFrameDelay);
+  Mock::VerifyAndClearExpectations(&callback);
+
+  // The idle repeat waits for the next tick.
+  EXPECT_CALL(callback, OnFrame).Times(0);
+  time_controller.AdvanceTime(
+      FrameCadenceAdapterInterface::kZeroHertzIdleRepeatRatePeriod);
+  Mock::VerifyAndClearExpectations(&callback);
+  EXPECT_EQ(metronome.NumListeners(), 1u);
+
+  EXPECT_CALL(callback, OnFrame).Times(1);
+  worker_queue->PostTask([&] { metronome.Tick(); });
+  time_controller.AdvanceTime(TimeDelta::Zero());
+  Mock::VerifyAndClearExpectations(&callback);
+
+  rtc::Event finalized;
+  queue->PostTask([&] {
+    adapter = nullptr;
+    finalized.Set();
+  });
+  finalized.Wait(rtc::Event::kForever);
+}
+
 class FrameCadenceAdapterSimulcastLayersParamTest
     : public ::testing::TestWithParam<int> {
  public:
@@ -53,6 +53,13 @@ class FrameDumpingEncoder : public VideoEncoder, public EncodedImageCallback {
     codec_settings_ = *codec_settings;
     return wrapped_->InitEncode(codec_settings, settings);
   }
+  bool UpdateActiveStreams(const VideoCodec& codec_settings) override {
+    if (!wrapped_->UpdateActiveStreams(codec_settings)) {
+      return false;
+    }
+    codec_settings_ = codec_settings;
+    return true;
+  }
   int32_t RegisterEncodeCompleteCallback(
       EncodedImageCallback* callback) override {
     callback_ = callback;
@@ -0,0 +1,102 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/keyframe_cache.h"
+
+#include <utility>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+
+// Copy of a frame that keeps the receive information, which EncodedFrame only
+// exposes through virtual methods.
+class CachedFrame : public EncodedFrame {
+ public:
+  explicit CachedFrame(const EncodedFrame& frame)
+      : EncodedFrame(frame),
+        received_time_(frame.ReceivedTime()),
+        delayed_by_retransmission_(frame.delayed_by_retransmission()) {}
+
+  int64_t ReceivedTime() const override { return received_time_; }
+  bool delayed_by_retransmission() const override {
+    return delayed_by_retransmission_;
+  }
+
+ private:
+  const int64_t received_time_;
+  const bool delayed_by_retransmission_;
+};
+
+}  // namespace
+
+constexpr char KeyframeCache::Config::kKey[];
+
+std::unique_ptr<StructParametersParser> KeyframeCache::Config::Parser() {
+  return StructParametersParser::Create("enabled", &enabled,  //
+                                        "max_frames", &max_frames);
+}
+
+std::unique_ptr<KeyframeCache> KeyframeCache::CreateFromFieldTrials(
+    const FieldTrialsView& field_trials) {
+  Config config;
+  config.Parser()->Parse(field_trials.Lookup(Config::kKey));
+  if (!config.enabled || config.max_frames <= 0)
+    return nullptr;
+  return std::make_unique<KeyframeCache>(config.max_frames);
+}
+
+KeyframeCache::KeyframeCache(int max_frames) : max_frames_(max_frames) {
+  RTC_DCHECK_GT(max_frames, 0);
+}
+
+KeyframeCache::~KeyframeCache() = default;
+
+bool KeyframeCache::Insert(const EncodedFrame& frame) {
+  if (frame_ids_.count(frame.Id()) > 0)
+    return false;
+
+  if (frame.is_keyframe()) {
+    // Spatial layers of the same picture may all be keyframes.
+    if (!frames_.empty() &&
+        frames_.front()->RtpTimestamp() != frame.RtpTimestamp()) {
+      Clear();
+    }
+  } else {
+    for (size_t i = 0; i < frame.num_references; ++i) {
+      if (frame_ids_.count(frame.references[i]) == 0)
+        return false;
+    }
+  }
+
+  if (frames_.size() == max_frames_) {
+    Clear();
+    return false;
+  }
+  frame_ids_.insert(frame.Id());
+  frames_.push_back(std::make_unique<CachedFrame>(frame));
+  return true;
+}
+
+std::vector<std::unique_ptr<EncodedFrame>> KeyframeCache::CopyFrames() const {
+  std::vector<std::unique_ptr<EncodedFrame>> frames;
+  frames.reserve(frames_.size());
+  for (const std::unique_ptr<EncodedFrame>& frame : frames_)
+    frames.push_back(std::make_unique<CachedFrame>(*frame));
+  return frames;
+}
+
+void KeyframeCache::Clear() {
+  frames_.clear();
+  frame_ids_.clear();
+}
+
+}  // namespace webrtc
@@ -0,0 +1,76 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VIDEO_KEYFRAME_CACHE_H_
+#define VIDEO_KEYFRAME_CACHE_H_
+
+#include <stdint.h>
+
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "api/field_trials_view.h"
+#include "api/video/encoded_frame.h"
+#include "rtc_base/experiments/struct_parameters_parser.h"
+
+namespace webrtc {
+
+// Keeps the frames needed to start decoding a stream without requesting a new
+// keyframe from the sender: the most recent keyframe, and the delta frames
+// after it whose references are all cached. References are the frame ids set
+// by the RtpFrameReferenceFinder.
+//
+// Used by a video receive stream that keeps receiving while it is stopped, so
+// that it can resume decoding from the cached frames as soon as it is started
+// again, instead of waiting a round trip for a keyframe.
+class KeyframeCache {
+ public:
+  struct Config {
+    static constexpr char kKey[] = "WebRTC-Video-KeyframeCache";
+    std::unique_ptr<StructParametersParser> Parser();
+
+    bool enabled = false;
+    // The cache is emptied, and stays empty until the next keyframe, if the
+    // frames since the last keyframe exceed this number.
+    int max_frames = 300;
+  };
+
+  // Returns a cache configured from `field_trials`, or nullptr if not enabled.
+  static std::unique_ptr<KeyframeCache> CreateFromFieldTrials(
+      const FieldTrialsView& field_trials);
+
+  explicit KeyframeCache(int max_frames);
+  ~KeyframeCache();
+
+  KeyframeCache(const KeyframeCache&) = delete;
+  KeyframeCache& operator=(const KeyframeCache&) = delete;
+
+  // Returns true if a copy of `frame` was cached. The copy shares the encoded
+  // data of `frame`. A keyframe replaces the cached frames of earlier pictures,
+  // a delta frame is only cached if all its references are.
+  bool Insert(const EncodedFrame& frame);
+
+  // Returns copies of the cached frames in the order they were inserted, which
+  // is a valid decode order.
+  std::vector<std::unique_ptr<EncodedFrame>> CopyFrames() const;
+
+  void Clear();
+  size_t size() const { return frames_.size(); }
+
+ private:
+  const size_t max_frames_;
+  std::vector<std::unique_ptr<EncodedFrame>> frames_;
+  std::set<int64_t> frame_ids_;
+};
+
+}  // namespace webrtc
+
+#endif  // VIDEO_KEYFRAME_CACHE_H_
@@ -0,0 +1,100 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/keyframe_cache.h"
+
+#include <memory>
+#include <vector>
+
+#include "test/explicit_key_value_config.h"
+#include "test/fake_encoded_frame.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+std::vector<int64_t> Ids(
+    const std::vector<std::unique_ptr<EncodedFrame>>& frames) {
+  std::vector<int64_t> ids;
+  for (const auto& frame : frames)
+    ids.push_back(frame->Id());
+  return ids;
+}
+
+TEST(KeyframeCacheTest, DisabledByDefault) {
+  test::ExplicitKeyValueConfig field_trials("");
+  EXPECT_EQ(KeyframeCache::CreateFromFieldTrials(field_trials), nullptr);
+}
+
+TEST(KeyframeCacheTest, CachesKeyframeAndDependentDeltaFrames) {
+  KeyframeCache cache(/*max_frames=*/10);
+  EXPECT_TRUE(cache.Insert(*test::FakeFrameBuilder().Time(0).Id(1).Build()));
+  EXPECT_TRUE(
+      cache.Insert(*test::FakeFrameBuilder().Time(10).Id(2).Refs({1}).Build()));
+  EXPECT_TRUE(
+      cache.Insert(*test::FakeFrameBuilder().Time(20).Id(3).Refs({2}).Build()));
+
+  EXPECT_THAT(Ids(cache.CopyFrames()), ElementsAre(1, 2, 3));
+  EXPECT_EQ(cache.size(), 3u);
+}
+
+TEST(KeyframeCacheTest, DropsDeltaFramesWithMissingReferences) {
+  KeyframeCache cache(/*max_frames=*/10);
+  EXPECT_FALSE(
+      cache.Insert(*test::FakeFrameBuilder().Time(0).Id(1).Refs({0}).Build()));
+  EXPECT_TRUE(cache.Insert(*test::FakeFrameBuilder().Time(10).Id(2).Build()));
+  EXPECT_FALSE(
+      cache.Insert(*test::FakeFrameBuilder().Time(30).Id(4).Refs({3}).Build()));
+  EXPECT_TRUE(
+      cache.Insert(*test::FakeFrameBuilder().Time(40).Id(5).Refs({2}).Build()));
+
+  EXPECT_THAT(Ids(cache.CopyFrames()), ElementsAre(2, 5));
+}
+
+TEST(KeyframeCacheTest, NewKeyframeReplacesCachedFrames) {
+  KeyframeCache cache(/*max_frames=*/10);
+  cache.Insert(*test::FakeFrameBuilder().Time(0).Id(1).Build());
+  cache.Insert(*test::FakeFrameBuilder().Time(10).Id(2).Refs({1}).Build());
+  EXPECT_TRUE(cache.Insert(*test::FakeFrameBuilder().Time(20).Id(3).Build()));
+  EXPECT_FALSE(
+      cache.Insert(*test::FakeFrameBuilder().Time(30).Id(4).Refs({2}).Build()));
+
+  EXPECT_THAT(Ids(cache.CopyFrames()), ElementsAre(3));
+}
+
+TEST(KeyframeCacheTest, KeepsKeyframeSpatialLayersOfSamePicture) {
+  KeyframeCache cache(/*max_frames=*/10);
+  cache.Insert(*test::FakeFrameBuilder().Time(0).Id(1).SpatialLayer(0).Build());
+  EXPECT_TRUE(cache.Insert(
+      *test::FakeFrameBuilder().Time(0).Id(2).SpatialLayer(1).Build()));
+
+  EXPECT_THAT(Ids(cache.CopyFrames()), ElementsAre(1, 2));
+}
+
+TEST(KeyframeCacheTest, EmptiesWhenFull) {
+  KeyframeCache cache(/*max_frames=*/2);
+  cache.Insert(*test::FakeFrameBuilder().Time(0).Id(1).Build());
+  cache.Insert(*test::FakeFrameBuilder().Time(10).Id(2).Refs({1}).Build());
+  EXPECT_FALSE(
+      cache.Insert(*test::FakeFrameBuilder().Time(20).Id(3).Refs({2}).Build()));
+  // Delta frames are not cached until the next keyframe.
+  EXPECT_FALSE(
+      cache.Insert(*test::FakeFrameBuilder().Time(30).Id(4).Refs({3}).Build()));
+  EXPECT_THAT(cache.CopyFrames(), IsEmpty());
+
+  EXPECT_TRUE(cache.Insert(*test::FakeFrameBuilder().Time(40).Id(5).Build()));
+}
+
+}  // namespace
+}  // namespace webrtc
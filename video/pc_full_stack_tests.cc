@@ -12,6 +12,7 @@
 #include <utility>
 #include <vector>
 
+#include "absl/flags/flag.h"
 #include "api/media_stream_interface.h"
 #include "api/test/create_network_emulation_manager.h"
 #include "api/test/create_peer_connection_quality_test_frame_generator.h"
@@ -31,9 +32,17 @@
 #include "system_wrappers/include/field_trial.h"
 #include "test/field_trial.h"
 #include "test/gtest.h"
+#include "test/pc/e2e/analyzer/video/default_video_quality_analyzer.h"
+#include "test/pc/e2e/analyzer/video/default_video_quality_analyzer_shared_objects.h"
 #include "test/pc/e2e/network_quality_metrics_reporter.h"
 #include "test/testsupport/file_utils.h"
 
+ABSL_FLAG(webrtc::TimeMode,
+          time_mode,
+          webrtc::TimeMode::kRealTime,
+          "Time mode to run the tests in: realtime or simulated. In simulated "
+          "time the tests run as fast as the CPU allows.");
+
 namespace webrtc {
 
 using ::webrtc::webrtc_pc_e2e::AudioConfig;
@@ -56,9 +65,16 @@ CreateTestFixture(const std::string& test_case_name,
                             EmulatedNetworkManagerInterface*> network_links,
                   rtc::FunctionView<void(PeerConfigurer*)> alice_configurer,
                   rtc::FunctionView<void(PeerConfigurer*)> bob_configurer) {
+  DefaultVideoQualityAnalyzerOptions analyzer_options;
+  // In simulated time frames are produced faster than they can be compared,
+  // so wait for the comparisons instead of skipping PSNR and SSIM.
+  analyzer_options.wait_on_cpu_overload =
+      absl::GetFlag(FLAGS_time_mode) == TimeMode::kSimulated;
   auto fixture = webrtc_pc_e2e::CreatePeerConnectionE2EQualityTestFixture(
       test_case_name, time_controller, /*audio_quality_analyzer=*/nullptr,
-      /*video_quality_analyzer=*/nullptr);
+      std::make_unique<DefaultVideoQualityAnalyzer>(
+          time_controller.GetClock(), test::GetGlobalMetricsLogger(),
+          analyzer_options));
   auto alice = std::make_unique<PeerConfigurer>(
       network_links.first->network_dependencies());
   auto bob = std::make_unique<PeerConfigurer>(
@@ -124,7 +140,7 @@ INSTANTIATE_TEST_SUITE_P(
 #if defined(RTC_ENABLE_VP9)
 TEST(PCFullStackTest, Pc_Foreman_Cif_Net_Delay_0_0_Plr_0_VP9) {
   std::unique_ptr<NetworkEmulationManager> network_emulation_manager =
-      CreateNetworkEmulationManager();
+      CreateNetworkEmulationManager(absl::GetFlag(FLAGS_time_mode));
   auto fixture = CreateTestFixture(
       "pc_foreman_cif_net_delay_0_0_plr_0_VP9",
       *network_emulation_manager->time_controller(),
@@ -153,7 +169,7 @@ TEST(PCFullStackTest, Pc_Foreman_Cif_Net_Delay_0_0_Plr_0_VP9) {
 TEST(PCGenericDescriptorTest,
      Pc_Foreman_Cif_Delay_50_0_Plr_5_VP9_Generic_Descriptor) {
   std::unique_ptr<NetworkEmulationManager> network_emulation_manager =
-      CreateNetworkEmulationManager();
+      CreateNetworkEmulationManager(absl::GetFlag(FLAGS_time_mode));
   BuiltInNetworkBehaviorConfig config;
   config.loss_percent = 5;
   config.queue_delay_ms = 50;
@@ -191,7 +207,7 @@ TEST(PCGenericDescriptorTest,
 #endif
 TEST(PCFullStackTest, MAYBE_Pc_Generator_Net_Delay_0_0_Plr_0_VP9Profile2) {
   std::unique_ptr<NetworkEmulationManager> network_emulation_manager =
-      CreateNetworkEmulationManager();
+      CreateNetworkEmulationManager(absl::GetFlag(FLAGS_time_mode));
   auto fixture = CreateTestFixture(
       "pc_generator_net_delay_0_0_plr_0_VP9Profile2",
       *network_emulation_manager->time_controller(),
@@ -251,7 +267,7 @@ TEST(PCFullStackTest, GeneratorWithoutPacketLossMultiplexI420AFrame) {
 
 TEST(PCFullStackTest, Pc_Net_Delay_0_0_Plr_0) {
   std::unique_ptr<NetworkEmulationManager> network_emulation_manager =
-      CreateNetworkEmulationManager();
+      CreateNetworkEmulationManager(absl::GetFlag(FLAGS_time_mode));
   auto fixture = CreateTestFixture(
       "pc_net_delay_0_0_plr_0", *network_emulation_manager->time_controller(),
       network_emulation_manager->CreateEndpointPairWithTwoWayRoutes(
@@ -270,7 +286,7 @@ TEST(PCFullStackTest, Pc_Net_Delay_0_0_Plr_0) {
 TEST(PCGenericDescriptorTest,
      Pc_Foreman_Cif_Net_Delay_0_0_Plr_0_Generic_Descriptor) {
   std::unique_ptr<NetworkEmulationManager> network_emulation_manager =
-      CreateNetworkEmulationManager();
+      CreateNetworkEmulationManager(absl::GetFlag(FLAGS_time_mode));
   auto fixture = CreateTestFixture(
       "pc_foreman_cif_net_delay_0_0_plr_0_generic_descriptor",
       *network_emulation_manager->time_controller(),
@@ -290,7 +306,7 @@ TEST(PCGenericDescriptorTest,
 TEST(PCGenericDescriptorTest,
      Pc_Foreman_Cif_30kbps_Net_Delay_0_0_Plr_0_Generic_Descriptor) {
   std::unique_ptr<NetworkEmulationManager> network_emulation_manager =
-      CreateNetworkEmulationManager();
+      CreateNetworkEmulationManager(absl::GetFlag(FLAGS_time_mode));
   BuiltInNetworkBehaviorConfig config;
   auto fixture = CreateTestFixture(
       "pc_foreman_cif_30kbps_net_delay_0_0_plr_0_generic_descriptor",
@@ -317,7 +333,7 @@ TEST(PCGenericDescriptorTest,
 // Link capacity below default start rate.
 TEST(PCFullStackTest, Pc_Foreman_Cif_Link_150kbps_Net_Delay_0_0_Plr_0) {
   std::unique_ptr<NetworkEmulationManager> network_emulation_manager =
-      CreateNetworkEmulationManager();
+      CreateNetworkEmulationManager(absl::GetFlag(FLAGS_time_mode));
   BuiltInNetworkBehaviorConfig config;
   config.link_capacity_kbps = 150;
   auto fixture = CreateTestFixture(
@@ -337,7 +353,7 @@ TEST(PCFullStackTest, Pc_Foreman_Cif_Link_150kbps_Net_Delay_0_0_Plr_0) {
 
 TEST(PCFullStackTest, Pc_Foreman_Cif_Link_130kbps_Delay100ms_Loss1_Ulpfec) {
   std::unique_ptr<NetworkEmulationManager> network_emulation_manager =
-      CreateNetworkEmulationManager();
+      CreateNetworkEmulationManager(absl::GetFlag(FLAGS_time_mode));
   BuiltInNetworkBehaviorConfig config;
   config.link_capacity_kbps = 130;
   config.queue_delay_ms = 100;
@@ -360,7 +376,7 @@ TEST(PCFullStackTest, Pc_Foreman_Cif_Link_130kbps_Delay100ms_Loss1_Ulpfec) {
 
 TEST(PCFullStackTest, Pc_Foreman_Cif_Link_50kbps_Delay100ms_Loss1_Ulpfec) {
   std::unique_ptr<NetworkEmulationManager> network_emulation_manager =
-      CreateNetworkEmulationManager();
+      CreateNetworkEmulationManager(absl::GetFlag(FLAGS_time_mode));
   BuiltInNetworkBehaviorConfig config;
   config.link_capacity_kbps = 50;
   config.queue_delay_ms = 100;
@@ -385,7 +401,7 @@ TEST(PCFullStackTest, Pc_Foreman_Cif_Link_50kbps_Delay100ms_Loss1_Ulpfec) {
 TEST(PCFullStackTest,
      Pc_Foreman_Cif_Link_150kbps_Delay100ms_30pkts_Queue_Overshoot30) {
   std::unique_ptr<NetworkEmulationManager> network_emulation_manager =
-      CreateNetworkEmulationManager();
+      CreateNetworkEmulationManager(absl::GetFlag(FLAGS_time_mode));
   BuiltInNetworkBehaviorConfig config;
   config.link_capacity_kbps = 150;
   config.queue_length_packets = 30;
@@ -412,7 +428,7 @@ TEST(PCFullStackTest,
 // Link queue is restrictive enough to trigger loss on probes.
 TEST(PCFullStackTest, Pc_Foreman_Cif_Link_250kbps_Delay100ms_10pkts_Loss1) {
   std::unique_ptr<NetworkEmulationManager> network_emulation_manager =
-      CreateNetworkEmulationManager();
+      CreateNetworkEmulationManager(absl::GetFlag(FLAGS_time_mode));
   BuiltInNetworkBehaviorConfig config;
   config.link_capacity_kbps = 250;
   config.queue_length_packets = 10;
@@ -437,7 +453,7 @@ TEST(PCFullStackTest, Pc_Foreman_Cif_Link_250kbps_Delay100ms_10pkts_Loss1) {
 TEST(PCGenericDescriptorTest,
      Pc_Foreman_Cif_Delay_50_0_Plr_5_Generic_Descriptor) {
   std::unique_ptr<NetworkEmulationManager> network_emulation_manager =
-      CreateNetworkEmulationManager();
+      CreateNetworkEmulationManager(absl::GetFlag(FLAGS_time_mode));
   BuiltInNetworkBehaviorConfig config;
   config.loss_percent = 5;
   config.queue_delay_ms = 50;
@@ -459,7 +475,7 @@ TEST(PCGenericDescriptorTest,
 TEST(PCGenericDescriptorTest,
      Pc_Foreman_Cif_Delay_50_0_Plr_5_Ulpfec_Generic_Descriptor) {
   std::unique_ptr<NetworkEmulationManager> network_emulation_manager =
-      CreateNetworkEmulationManager();
+      CreateNetworkEmulationManager(absl::GetFlag(FLAGS_time_mode));
   BuiltInNetworkBehaviorConfig config;
   config.loss_percent = 5;
   config.queue_delay_ms = 50;
@@ -481,7 +497,7 @@ TEST(PCGenericDescriptorTest,
 
 TEST(PCFullStackTest, Pc_Foreman_Cif_Delay_50_0_Plr_5_Flexfec) {
   std::unique_ptr<NetworkEmulationManager> network_emulation_manager =
-      CreateNetworkEmulationManager();
+      CreateNetworkEmulationManager(absl::GetFlag(FLAGS_time_mode));
   BuiltInNetworkBehaviorConfig config;
   config.loss_percent = 5;
   config.queue_delay_ms = 50;
@@ -505,7 +521,7 @@ TEST(PCFullStackTest, Pc_Foreman_Cif_Delay_50_0_Plr_5_Flexfec) {
 
 TEST(PCFullStackTest, Pc_Foreman_Cif_500kbps_Delay_50_0_Plr_3_Flexfec) {
   std::unique_ptr<NetworkEmulationManager> network_emulation_manager =
-      CreateNetworkEmulationManager();
+      CreateNetworkEmulationManager(absl::GetFlag(FLAGS_time_mode));
   BuiltInNetworkBehaviorConfig config;
   config.loss_percent = 3;
   config.link_capacity_kbps = 500;
@@ -530,7 +546,7 @@ TEST(PCFullStackTest, Pc_Foreman_Cif_500kbps_Delay_50_0_Plr_3_Flexfec) {
 
 TEST(PCFullStackTest, Pc_Foreman_Cif_500kbps_Delay_50_0_Plr_3_Ulpfec) {
   std::unique_ptr<NetworkEmulationManager> network_emulation_manager =
-      CreateNetworkEmulationManager();
+      CreateNetworkEmulationManager(absl::GetFlag(FLAGS_time_mode));
   BuiltInNetworkBehaviorConfig config;
   config.loss_percent = 3;
   config.link_capacity_kbps = 500;
@@ -554,7 +570,7 @@ TEST(PCFullStackTest, Pc_Foreman_Cif_500kbps_Delay_50_0_Plr_3_Ulpfec) {
 #if defined(WEBRTC_USE_H264)
 TEST(PCFullStackTest, Pc_Foreman_Cif_Net_Delay_0_0_Plr_0_H264) {
   std::unique_ptr<NetworkEmulationManager> network_emulation_manager =
-      CreateNetworkEmulationManager();
+      CreateNetworkEmulationManager(absl::GetFlag(FLAGS_time_mode));
   auto fixture = CreateTestFixture(
       "pc_foreman_cif_net_delay_0_0_plr_0_H264",
       *network_emulation_manager->time_controller(),
@@ -576,7 +592,7 @@ TEST(PCFullStackTest, Pc_Foreman_Cif_Net_Delay_0_0_Plr_0_H264) {
 
 TEST(PCFullStackTest, Pc_Foreman_Cif_30kbps_Net_Delay_0_0_Plr_0_H264) {
   std::unique_ptr<NetworkEmulationManager> network_emulation_manager =
-      CreateNetworkEmulationManager();
+      CreateNetworkEmulationManager(absl::GetFlag(FLAGS_time_mode));
   BuiltInNetworkBehaviorConfig config;
   auto fixture = CreateTestFixture(
       "pc_foreman_cif_30kbps_net_delay_0_0_plr_0_H264",
@@ -605,7 +621,7 @@ TEST(PCFullStackTest, Pc_Foreman_Cif_30kbps_Net_Delay_0_0_Plr_0_H264) {
 TEST(PCGenericDescriptorTest,
      Pc_Foreman_Cif_Delay_50_0_Plr_5_H264_Generic_Descriptor) {
   std::unique_ptr<NetworkEmulationManager> network_emulation_manager =
-      CreateNetworkEmulationManager();
+      CreateNetworkEmulationManager(absl::GetFlag(FLAGS_time_mode));
   BuiltInNetworkBehaviorConfig config;
   config.loss_percent = 5;
   config.queue_delay_ms = 50;
@@ -632,7 +648,7 @@ TEST(PCFullStackTest, Pc_Foreman_Cif_Delay_50_0_Plr_5_H264_Sps_Pps_Idr) {
       AppendFieldTrials("WebRTC-SpsPpsIdrIsH264Keyframe/Enabled/"));
 
   std::unique_ptr<NetworkEmulationManager> network_emulation_manager =
-      CreateNetworkEmulationManager();
+      CreateNetworkEmulationManager(absl::GetFlag(FLAGS_time_mode));
   BuiltInNetworkBehaviorConfig config;
   config.loss_percent = 5;
   config.queue_delay_ms = 50;
@@ -656,7 +672,7 @@ TEST(PCFullStackTest, Pc_Foreman_Cif_Delay_50_0_Plr_5_H264_Sps_Pps_Idr) {
 
 TEST(PCFullStackTest, Pc_Foreman_Cif_Delay_50_0_Plr_5_H264_Flexfec) {
   std::unique_ptr<NetworkEmulationManager> network_emulation_manager =
-      CreateNetworkEmulationManager();
+      CreateNetworkEmulationManager(absl::GetFlag(FLAGS_time_mode));
   BuiltInNetworkBehaviorConfig config;
   config.loss_percent = 5;
   config.queue_delay_ms = 50;
@@ -686,7 +702,7 @@ TEST(PCFullStackTest, Pc_Foreman_Cif_Delay_50_0_Plr_5_H264_Flexfec) {
 // for debugging. It is therefore disabled by default.
 TEST(PCFullStackTest, DISABLED_Pc_Foreman_Cif_Delay_50_0_Plr_5_H264_Ulpfec) {
   std::unique_ptr<NetworkEmulationManager> network_emulation_manager =
-      CreateNetworkEmulationManager();
+      CreateNetworkEmulationManager(absl::GetFlag(FLAGS_time_mode));
   BuiltInNetworkBehaviorConfig config;
   config.loss_percent = 5;
   config.queue_delay_ms = 50;
@@ -713,7 +729,7 @@ TEST(PCFullStackTest, DISABLED_Pc_Foreman_Cif_Delay_50_0_Plr_5_H264_Ulpfec) {
 
 TEST(PCFullStackTest, Pc_Foreman_Cif_500kbps) {
   std::unique_ptr<NetworkEmulationManager> network_emulation_manager =
-      CreateNetworkEmulationManager();
+      CreateNetworkEmulationManager(absl::GetFlag(FLAGS_time_mode));
   BuiltInNetworkBehaviorConfig config;
   config.queue_length_packets = 0;
   config.queue_delay_ms = 0;
@@ -734,7 +750,7 @@ TEST(PCFullStackTest, Pc_Foreman_Cif_500kbps) {
 
 TEST_P(ParameterizedPCFullStackTest, Pc_Foreman_Cif_500kbps_32pkts_Queue) {
   std::unique_ptr<NetworkEmulationManager> network_emulation_manager =
-      CreateNetworkEmulationManager();
+      CreateNetworkEmulationManager(absl::GetFlag(FLAGS_time_mode));
   BuiltInNetworkBehaviorConfig config;
   config.queue_length_packets = 32;
   config.queue_delay_ms = 0;
@@ -763,7 +779,7 @@ TEST_P(ParameterizedPCFullStackTest, Pc_Foreman_Cif_500kbps_32pkts_Queue) {
 
 TEST(PCFullStackTest, Pc_Foreman_Cif_500kbps_100ms) {
   std::unique_ptr<NetworkEmulationManager> network_emulation_manager =
-      CreateNetworkEmulationManager();
+      CreateNetworkEmulationManager(absl::GetFlag(FLAGS_time_mode));
   BuiltInNetworkBehaviorConfig config;
   config.queue_length_packets = 0;
   config.queue_delay_ms = 100;
@@ -786,7 +802,7 @@ TEST(PCFullStackTest, Pc_Foreman_Cif_500kbps_100ms) {
 TEST(PCGenericDescriptorTest,
      Pc_Foreman_Cif_500kbps_100ms_32pkts_Queue_Generic_Descriptor) {
   std::unique_ptr<NetworkEmulationManager> network_emulation_manager =
-      CreateNetworkEmulationManager();
+      CreateNetworkEmulationManager(absl::GetFlag(FLAGS_time_mode));
   BuiltInNetworkBehaviorConfig config;
   config.queue_length_packets = 32;
   config.queue_delay_ms = 100;
@@ -829,7 +845,7 @@ TEST(PCFullStackTest, ForemanCif500kbps100msLimitedQueueRecvBwe) {
 
 TEST(PCFullStackTest, Pc_Foreman_Cif_1000kbps_100ms_32pkts_Queue) {
   std::unique_ptr<NetworkEmulationManager> network_emulation_manager =
-      CreateNetworkEmulationManager();
+      CreateNetworkEmulationManager(absl::GetFlag(FLAGS_time_mode));
   BuiltInNetworkBehaviorConfig config;
   config.queue_length_packets = 32;
   config.queue_delay_ms = 100;
@@ -852,7 +868,7 @@ TEST(PCFullStackTest, Pc_Foreman_Cif_1000kbps_100ms_32pkts_Queue) {
 // TODO(sprang): Remove this if we have the similar ModerateLimits below?
 TEST(PCFullStackTest, Pc_Conference_Motion_Hd_2000kbps_100ms_32pkts_Queue) {
   std::unique_ptr<NetworkEmulationManager> network_emulation_manager =
-      CreateNetworkEmulationManager();
+      CreateNetworkEmulationManager(absl::GetFlag(FLAGS_time_mode));
   BuiltInNetworkBehaviorConfig config;
   config.queue_length_packets = 32;
   config.queue_delay_ms = 100;
@@ -1002,7 +1018,7 @@ TEST(PCFullStackTest,
 TEST_P(ParameterizedPCFullStackTest,
        Pc_Conference_Motion_Hd_2000kbps_100ms_32pkts_Queue_Vp9) {
   std::unique_ptr<NetworkEmulationManager> network_emulation_manager =
-      CreateNetworkEmulationManager();
+      CreateNetworkEmulationManager(absl::GetFlag(FLAGS_time_mode));
   BuiltInNetworkBehaviorConfig config;
   config.queue_length_packets = 32;
   config.queue_delay_ms = 100;
@@ -1041,7 +1057,7 @@ TEST_P(ParameterizedPCFullStackTest,
 
 TEST(PCFullStackTest, Pc_Screenshare_Slides_No_Conference_Mode) {
   std::unique_ptr<NetworkEmulationManager> network_emulation_manager =
-      CreateNetworkEmulationManager();
+      CreateNetworkEmulationManager(absl::GetFlag(FLAGS_time_mode));
   auto fixture = CreateTestFixture(
       "pc_screenshare_slides_no_conference_mode",
       *network_emulation_manager->time_controller(),
@@ -1061,7 +1077,7 @@ TEST(PCFullStackTest, Pc_Screenshare_Slides_No_Conference_Mode) {
 
 TEST(PCFullStackTest, Pc_Screenshare_Slides) {
   std::unique_ptr<NetworkEmulationManager> network_emulation_manager =
-      CreateNetworkEmulationManager();
+      CreateNetworkEmulationManager(absl::GetFlag(FLAGS_time_mode));
   auto fixture = CreateTestFixture(
       "pc_screenshare_slides", *network_emulation_manager->time_controller(),
       network_emulation_manager->CreateEndpointPairWithTwoWayRoutes(
@@ -1084,7 +1100,7 @@ TEST(PCFullStackTest, Pc_Screenshare_Slides) {
 #if !defined(WEBRTC_MAC) && !defined(WEBRTC_WIN)
 TEST(PCFullStackTest, Pc_Screenshare_Slides_Simulcast_No_Conference_Mode) {
   std::unique_ptr<NetworkEmulationManager> network_emulation_manager =
-      CreateNetworkEmulationManager();
+      CreateNetworkEmulationManager(absl::GetFlag(FLAGS_time_mode));
   auto fixture = CreateTestFixture(
       "pc_screenshare_slides_simulcast_no_conference_mode",
       *network_emulation_manager->time_controller(),
@@ -1107,7 +1123,7 @@ TEST(PCFullStackTest, Pc_Screenshare_Slides_Simulcast_No_Conference_Mode) {
 
 TEST_P(ParameterizedPCFullStackTest, Pc_Screenshare_Slides_Simulcast) {
   std::unique_ptr<NetworkEmulationManager> network_emulation_manager =
-      CreateNetworkEmulationManager();
+      CreateNetworkEmulationManager(absl::GetFlag(FLAGS_time_mode));
   auto fixture = CreateTestFixture(
       "pc_screenshare_slides_simulcast" + GetParam().test_case_name_postfix,
       *network_emulation_manager->time_controller(),
@@ -1320,7 +1336,7 @@ TEST(PCFullStackTest, Pc_Screenshare_Slides_Vp9_3sl_High_Fps) {
       AppendFieldTrials("WebRTC-Vp9InterLayerPred/"
                         "Enabled,inter_layer_pred_mode:on/"));
   std::unique_ptr<NetworkEmulationManager> network_emulation_manager =
-      CreateNetworkEmulationManager();
+      CreateNetworkEmulationManager(absl::GetFlag(FLAGS_time_mode));
   auto fixture = CreateTestFixture(
       "pc_screenshare_slides_vp9_3sl_high_fps",
       *network_emulation_manager->time_controller(),
@@ -1354,7 +1370,7 @@ TEST(PCFullStackTest, Pc_Vp9svc_3sl_High) {
       AppendFieldTrials("WebRTC-Vp9InterLayerPred/"
                         "Enabled,inter_layer_pred_mode:on/"));
   std::unique_ptr<NetworkEmulationManager> network_emulation_manager =
-      CreateNetworkEmulationManager();
+      CreateNetworkEmulationManager(absl::GetFlag(FLAGS_time_mode));
   auto fixture = CreateTestFixture(
       "pc_vp9svc_3sl_high", *network_emulation_manager->time_controller(),
       network_emulation_manager->CreateEndpointPairWithTwoWayRoutes(
@@ -1387,7 +1403,7 @@ TEST(PCFullStackTest, Pc_Vp9svc_3sl_Low) {
       AppendFieldTrials("WebRTC-Vp9InterLayerPred/"
                         "Enabled,inter_layer_pred_mode:on/"));
   std::unique_ptr<NetworkEmulationManager> network_emulation_manager =
-      CreateNetworkEmulationManager();
+      CreateNetworkEmulationManager(absl::GetFlag(FLAGS_time_mode));
   auto fixture = CreateTestFixture(
       "pc_vp9svc_3sl_low", *network_emulation_manager->time_controller(),
       network_emulation_manager->CreateEndpointPairWithTwoWayRoutes(
@@ -1518,7 +1534,7 @@ TEST(PCFullStackTest, MAYBE_Pc_Simulcast_HD_High) {
   webrtc::test::ScopedFieldTrials override_trials(AppendFieldTrials(
       "WebRTC-ForceSimulatedOveruseIntervalMs/1000-50000-300/"));
   std::unique_ptr<NetworkEmulationManager> network_emulation_manager =
-      CreateNetworkEmulationManager();
+      CreateNetworkEmulationManager(absl::GetFlag(FLAGS_time_mode));
   BuiltInNetworkBehaviorConfig config;
   config.loss_percent = 0;
   config.queue_delay_ms = 100;
@@ -1539,7 +1555,7 @@ TEST(PCFullStackTest, MAYBE_Pc_Simulcast_HD_High) {
 
 TEST_P(ParameterizedPCFullStackTest, Pc_Simulcast_Vp8_3sl_High) {
   std::unique_ptr<NetworkEmulationManager> network_emulation_manager =
-      CreateNetworkEmulationManager();
+      CreateNetworkEmulationManager(absl::GetFlag(FLAGS_time_mode));
   BuiltInNetworkBehaviorConfig config;
   config.loss_percent = 0;
   config.queue_delay_ms = 100;
@@ -1569,7 +1585,7 @@ TEST_P(ParameterizedPCFullStackTest, Pc_Simulcast_Vp8_3sl_High) {
 
 TEST(PCFullStackTest, Pc_Simulcast_Vp8_3sl_Low) {
   std::unique_ptr<NetworkEmulationManager> network_emulation_manager =
-      CreateNetworkEmulationManager();
+      CreateNetworkEmulationManager(absl::GetFlag(FLAGS_time_mode));
   BuiltInNetworkBehaviorConfig config;
   config.loss_percent = 0;
   config.queue_delay_ms = 100;
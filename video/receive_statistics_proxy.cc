@@ -476,6 +476,17 @@ void ReceiveStatisticsProxy::OnIncomingPayloadType(int payload_type) {
   }));
 }
 
+void ReceiveStatisticsProxy::OnDecodeCpuTimeMeasured(TimeDelta cpu_time) {
+  RTC_DCHECK_RUN_ON(&decode_queue_);
+  worker_thread_->PostTask(
+      SafeTask(task_safety_.flag(), [this, cpu_time]() {
+        RTC_DCHECK_RUN_ON(&main_thread_);
+        stats_.total_decode_cpu_time =
+            stats_.total_decode_cpu_time.value_or(TimeDelta::Zero()) +
+            cpu_time;
+      }));
+}
+
 void ReceiveStatisticsProxy::OnDecoderInfo(
     const VideoDecoder::DecoderInfo& decoder_info) {
   RTC_DCHECK_RUN_ON(&decode_queue_);
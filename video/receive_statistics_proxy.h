@@ -81,6 +81,10 @@ class ReceiveStatisticsProxy : public VideoStreamBufferControllerStatsObserver,
 
   void OnPreDecode(VideoCodecType codec_type, int qp);
 
+  // Called on the decode queue with the thread CPU time spent decoding a
+  // frame.
+  void OnDecodeCpuTimeMeasured(TimeDelta cpu_time);
+
   void OnUniqueFramesCounted(int num_unique_frames);
 
   // Indicates video stream has been paused (no incoming packets).
@@ -13,6 +13,7 @@
 #include <algorithm>
 #include <limits>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -39,11 +40,16 @@
 #include "modules/rtp_rtcp/source/video_rtp_depacketizer_raw.h"
 #include "modules/video_coding/h264_sprop_parameter_sets.h"
 #include "modules/video_coding/h264_sps_pps_tracker.h"
+#ifdef RTC_ENABLE_H265
+#include "modules/video_coding/h265_vps_sps_pps_tracker.h"
+#endif
 #include "modules/video_coding/nack_requester.h"
 #include "modules/video_coding/packet_buffer.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/copy_on_write_buffer.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/strings/string_builder.h"
+#include "rtc_base/third_party/base64/base64.h"
 #include "system_wrappers/include/metrics.h"
 #include "system_wrappers/include/ntp_time.h"
 
@@ -694,6 +700,30 @@ bool RtpVideoStreamReceiver2::OnReceivedPayloadData(
         break;
     }
 
+#ifdef RTC_ENABLE_H265
+  } else if (packet->codec() == kVideoCodecH265) {
+    if (packet->payload_type != last_payload_type_) {
+      last_payload_type_ = packet->payload_type;
+      InsertVpsSpsPpsIntoTracker(packet->payload_type);
+    }
+
+    video_coding::H265VpsSpsPpsTracker::FixedBitstream fixed =
+        h265_tracker_.MaybeFixBitstream(std::move(codec_payload),
+                                        &packet->video_header);
+
+    switch (fixed.action) {
+      case video_coding::H265VpsSpsPpsTracker::kRequestKeyframe:
+        rtcp_feedback_buffer_.RequestKeyFrame();
+        rtcp_feedback_buffer_.SendBufferedRtcpFeedback();
+        [[fallthrough]];
+      case video_coding::H265VpsSpsPpsTracker::kDrop:
+        return false;
+      case video_coding::H265VpsSpsPpsTracker::kInsert:
+        packet->video_payload = std::move(fixed.bitstream);
+        break;
+    }
+#endif
+
   } else {
     packet->video_payload = std::move(codec_payload);
   }
@@ -777,30 +807,40 @@ void RtpVideoStreamReceiver2::OnInsertedPacket(
   int max_nack_count;
   int64_t min_recv_time;
   int64_t max_recv_time;
-  std::vector<rtc::ArrayView<const uint8_t>> payloads;
+  std::vector<rtc::CopyOnWriteBuffer> payloads;
   RtpPacketInfos::vector_type packet_infos;
 
   bool frame_boundary = true;
-  for (auto& packet : result.packets) {
+  for (size_t i = 0; i < result.packets.size(); ++i) {
+    std::unique_ptr<video_coding::PacketBuffer::Packet>& packet =
+        result.packets[i];
     // PacketBuffer promisses frame boundaries are correctly set on each
     // packet. Document that assumption with the DCHECKs.
     RTC_DCHECK_EQ(frame_boundary, packet->is_first_packet_in_frame());
     int64_t unwrapped_rtp_seq_num =
         rtp_seq_num_unwrapper_.Unwrap(packet->seq_num);
-    RTC_DCHECK_GT(packet_infos_.count(unwrapped_rtp_seq_num), 0);
-    RtpPacketInfo& packet_info = packet_infos_[unwrapped_rtp_seq_num];
+    auto packet_info_it = packet_infos_.find(unwrapped_rtp_seq_num);
+    RTC_DCHECK(packet_info_it != packet_infos_.end());
+    RtpPacketInfo& packet_info = packet_info_it->second;
     if (packet->is_first_packet_in_frame()) {
       first_packet = packet.get();
       max_nack_count = packet->times_nacked;
       min_recv_time = packet_info.receive_time().ms();
       max_recv_time = packet_info.receive_time().ms();
+      // Usually the remaining packets are all of this frame. Reserve for them
+      // rather than growing the vectors packet by packet.
+      payloads.reserve(result.packets.size() - i);
+      packet_infos.reserve(result.packets.size() - i);
     } else {
       max_nack_count = std::max(max_nack_count, packet->times_nacked);
       min_recv_time = std::min(min_recv_time, packet_info.receive_time().ms());
       max_recv_time = std::max(max_recv_time, packet_info.receive_time().ms());
     }
-    payloads.emplace_back(packet->video_payload);
-    packet_infos.push_back(packet_info);
+    // Neither the packet nor its info is needed once the frame is assembled,
+    // so move them to the frame.
+    payloads.push_back(std::move(packet->video_payload));
+    packet_infos.push_back(std::move(packet_info));
+    packet_infos_.erase(packet_info_it);
 
     frame_boundary = packet->is_last_packet_in_frame();
     if (packet->is_last_packet_in_frame()) {
@@ -808,8 +848,8 @@ void RtpVideoStreamReceiver2::OnInsertedPacket(
       RTC_CHECK(depacketizer_it != payload_type_map_.end());
       RTC_CHECK(depacketizer_it->second);
 
-      rtc::scoped_refptr<EncodedImageBuffer> bitstream =
-          depacketizer_it->second->AssembleFrame(payloads);
+      rtc::scoped_refptr<EncodedImageBufferInterface> bitstream =
+          depacketizer_it->second->AssembleFrameFromPayloads(payloads);
       if (!bitstream) {
         // Failed to assemble a frame. Discard and continue.
         continue;
@@ -1064,6 +1104,11 @@ absl::optional<int64_t> RtpVideoStreamReceiver2::LastReceivedKeyframePacketMs()
   return absl::nullopt;
 }
 
+size_t RtpVideoStreamReceiver2::GetPacketBufferMemoryUsageBytes() const {
+  RTC_DCHECK_RUN_ON(&packet_sequence_checker_);
+  return packet_buffer_.GetMemoryUsageBytes();
+}
+
 void RtpVideoStreamReceiver2::ManageFrame(
     std::unique_ptr<RtpFrameObject> frame) {
   RTC_DCHECK_RUN_ON(&packet_sequence_checker_);
@@ -1300,6 +1345,39 @@ void RtpVideoStreamReceiver2::InsertSpsPpsIntoTracker(uint8_t payload_type) {
                              sprop_decoder.pps_nalu());
 }
 
+#ifdef RTC_ENABLE_H265
+void RtpVideoStreamReceiver2::InsertVpsSpsPpsIntoTracker(
+    uint8_t payload_type) {
+  RTC_DCHECK_RUN_ON(&packet_sequence_checker_);
+  RTC_DCHECK_RUN_ON(&worker_task_checker_);
+
+  auto codec_params_it = pt_codec_params_.find(payload_type);
+  if (codec_params_it == pt_codec_params_.end())
+    return;
+
+  // Each parameter may hold a comma separated list of NALUs, use the first.
+  std::vector<uint8_t> nalus[3];
+  const char* const keys[3] = {cricket::kH265FmtpSpropVps,
+                               cricket::kH265FmtpSpropSps,
+                               cricket::kH265FmtpSpropPps};
+  for (int i = 0; i < 3; ++i) {
+    auto sprop_it = codec_params_it->second.find(keys[i]);
+    if (sprop_it == codec_params_it->second.end())
+      return;
+    const std::string& sprop = sprop_it->second;
+    if (!rtc::Base64::DecodeFromArray(
+            sprop.data(), std::min(sprop.find(','), sprop.size()),
+            rtc::Base64::DO_STRICT, &nalus[i], nullptr)) {
+      RTC_LOG(LS_WARNING) << "Failed to decode " << keys[i] << " *" << sprop
+                          << "*";
+      return;
+    }
+  }
+
+  h265_tracker_.InsertVpsSpsPpsNalus(nalus[0], nalus[1], nalus[2]);
+}
+#endif
+
 void RtpVideoStreamReceiver2::UpdatePacketReceiveTimestamps(
     const RtpPacketReceived& packet,
     bool is_keyframe) {
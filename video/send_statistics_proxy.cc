@@ -709,6 +709,12 @@ void SendStatisticsProxy::OnEncodedFrameTimeMeasured(int encode_time_ms,
   stats_.encode_usage_percent = encode_usage_percent;
 }
 
+void SendStatisticsProxy::OnEncodeCpuTimeMeasured(TimeDelta cpu_time) {
+  MutexLock lock(&mutex_);
+  stats_.total_encode_cpu_time =
+      stats_.total_encode_cpu_time.value_or(TimeDelta::Zero()) + cpu_time;
+}
+
 void SendStatisticsProxy::OnSuspendChange(bool is_suspended) {
   int64_t now_ms = clock_->TimeInMilliseconds();
   MutexLock lock(&mutex_);
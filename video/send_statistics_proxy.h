@@ -85,6 +85,8 @@ class SendStatisticsProxy : public VideoStreamEncoderObserver,
 
   void OnEncoderInternalScalerUpdate(bool is_scaled) override;
 
+  void OnEncodeCpuTimeMeasured(TimeDelta cpu_time) override;
+
   void OnMinPixelLimitReached() override;
   void OnInitialQualityResolutionAdaptDown() override;
 
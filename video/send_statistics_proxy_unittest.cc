@@ -368,6 +368,16 @@ TEST_F(SendStatisticsProxyTest, TotalEncodeTimeIncreasesPerFrameMeasured) {
   EXPECT_EQ(30u, statistics_proxy_->GetStats().total_encode_time_ms);
 }
 
+TEST_F(SendStatisticsProxyTest, TotalEncodeCpuTimeIncreasesPerMeasurement) {
+  EXPECT_FALSE(statistics_proxy_->GetStats().total_encode_cpu_time);
+  statistics_proxy_->OnEncodeCpuTimeMeasured(TimeDelta::Micros(300));
+  EXPECT_EQ(statistics_proxy_->GetStats().total_encode_cpu_time,
+            TimeDelta::Micros(300));
+  statistics_proxy_->OnEncodeCpuTimeMeasured(TimeDelta::Micros(500));
+  EXPECT_EQ(statistics_proxy_->GetStats().total_encode_cpu_time,
+            TimeDelta::Micros(800));
+}
+
 TEST_F(SendStatisticsProxyTest, OnSendEncodedImageIncreasesFramesEncoded) {
   EncodedImage encoded_image;
   CodecSpecificInfo codec_info;
@@ -0,0 +1,526 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/shared_video_encoder_pool.h"
+
+#include <stdint.h>
+
+#include <limits>
+#include <utility>
+
+#include "absl/algorithm/container.h"
+#include "absl/types/optional.h"
+#include "api/video/encoded_image.h"
+#include "api/video/video_frame.h"
+#include "api/video/video_frame_type.h"
+#include "modules/video_coding/include/video_codec_interface.h"
+#include "modules/video_coding/include/video_error_codes.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+namespace {
+
+bool SimulcastStreamsEqual(const SimulcastStream& a, const SimulcastStream& b) {
+  return a.width == b.width && a.height == b.height &&
+         a.maxFramerate == b.maxFramerate &&
+         a.numberOfTemporalLayers == b.numberOfTemporalLayers &&
+         a.maxBitrate == b.maxBitrate && a.targetBitrate == b.targetBitrate &&
+         a.minBitrate == b.minBitrate && a.qpMax == b.qpMax &&
+         a.active == b.active;
+}
+
+// Returns true if an encoder initialized with `a` and `b` behaves the same,
+// apart from the start bitrate, which only matters until the first SetRates().
+bool CompatibleCodecSettings(const VideoCodec& a, const VideoCodec& b) {
+  if (a.codecType != b.codecType || a.width != b.width ||
+      a.height != b.height || a.maxBitrate != b.maxBitrate ||
+      a.minBitrate != b.minBitrate || a.maxFramerate != b.maxFramerate ||
+      a.active != b.active || a.qpMax != b.qpMax ||
+      a.numberOfSimulcastStreams != b.numberOfSimulcastStreams ||
+      a.mode != b.mode ||
+      a.expect_encode_from_texture != b.expect_encode_from_texture ||
+      a.timing_frame_thresholds.delay_ms !=
+          b.timing_frame_thresholds.delay_ms ||
+      a.timing_frame_thresholds.outlier_ratio_percent !=
+          b.timing_frame_thresholds.outlier_ratio_percent ||
+      a.legacy_conference_mode != b.legacy_conference_mode ||
+      a.GetScalabilityMode() != b.GetScalabilityMode() ||
+      a.GetVideoEncoderComplexity() != b.GetVideoEncoderComplexity() ||
+      a.GetFrameDropEnabled() != b.GetFrameDropEnabled()) {
+    return false;
+  }
+  for (int i = 0; i < a.numberOfSimulcastStreams; ++i) {
+    if (!SimulcastStreamsEqual(a.simulcastStream[i], b.simulcastStream[i])) {
+      return false;
+    }
+  }
+  switch (a.codecType) {
+    case kVideoCodecVP8:
+      return a.VP8() == b.VP8();
+    case kVideoCodecVP9:
+      if (a.VP9() != b.VP9()) {
+        return false;
+      }
+      for (int i = 0; i < a.VP9().numberOfSpatialLayers; ++i) {
+        if (!(a.spatialLayers[i] == b.spatialLayers[i])) {
+          return false;
+        }
+      }
+      return true;
+    case kVideoCodecH264:
+      return a.H264() == b.H264();
+    case kVideoCodecAV1:
+      return a.AV1() == b.AV1();
+    default:
+      return true;
+  }
+}
+
+bool CompatibleEncoderSettings(const VideoEncoder::Settings& a,
+                               const VideoEncoder::Settings& b) {
+  return a.capabilities.loss_notification ==
+             b.capabilities.loss_notification &&
+         a.max_payload_size == b.max_payload_size &&
+         a.encoder_thread_limit == b.encoder_thread_limit;
+}
+
+}  // namespace
+
+// A shared encoder and the encoders of the pool using it.
+// Encoder calls are serialized by `encoder_mutex_`, and the members by
+// `members_mutex_`, which is taken with `encoder_mutex_` held when the encoder
+// delivers its output. The pool's mutex is taken before both.
+class SharedVideoEncoderPool::Group : public EncodedImageCallback {
+ public:
+  Group(VideoEncoderFactory* factory,
+        const SdpVideoFormat& format,
+        const void* source,
+        std::unique_ptr<VideoEncoder> encoder,
+        const VideoCodec& codec_settings,
+        const VideoEncoder::Settings& settings)
+      : factory_(factory),
+        format_(format),
+        source_(source),
+        codec_settings_(codec_settings),
+        settings_(settings),
+        encoder_(std::move(encoder)) {
+    encoder_->RegisterEncodeCompleteCallback(this);
+  }
+
+  ~Group() override {
+    MutexLock lock(&encoder_mutex_);
+    encoder_->Release();
+  }
+
+  bool Matches(VideoEncoderFactory* factory,
+               const SdpVideoFormat& format,
+               const void* source,
+               const VideoCodec& codec_settings,
+               const VideoEncoder::Settings& settings) const {
+    return factory == factory_ && source == source_ && format == format_ &&
+           CompatibleCodecSettings(codec_settings, codec_settings_) &&
+           CompatibleEncoderSettings(settings, settings_);
+  }
+
+  void AddMember(SharedEncoder* member) {
+    MutexLock lock(&encoder_mutex_);
+    {
+      MutexLock members_lock(&members_mutex_);
+      members_.push_back(Member{member});
+    }
+    // The new member's receivers need a key frame to start decoding.
+    key_frame_requested_ = true;
+  }
+
+  // Returns true if no members remain.
+  bool RemoveMember(SharedEncoder* member) {
+    MutexLock lock(&encoder_mutex_);
+    {
+      MutexLock members_lock(&members_mutex_);
+      auto it = absl::c_find_if(
+          members_, [&](const Member& m) { return m.encoder == member; });
+      RTC_DCHECK(it != members_.end());
+      members_.erase(it);
+      if (members_.empty()) {
+        return true;
+      }
+    }
+    ApplyRates();
+    return false;
+  }
+
+  void SetCallback(SharedEncoder* member, EncodedImageCallback* callback) {
+    MutexLock lock(&members_mutex_);
+    FindMember(member).callback = callback;
+  }
+
+  int32_t Encode(const VideoFrame& frame,
+                 const std::vector<VideoFrameType>* frame_types) {
+    MutexLock lock(&encoder_mutex_);
+    bool key_frame =
+        key_frame_requested_ ||
+        (frame_types != nullptr &&
+         absl::c_linear_search(*frame_types, VideoFrameType::kVideoFrameKey));
+    if (frame.timestamp_us() <= last_frame_timestamp_us_) {
+      // Already encoded for another member, which delivered the output to all
+      // members. Key frame requests are honored on the next frame.
+      key_frame_requested_ = key_frame;
+      return WEBRTC_VIDEO_CODEC_OK;
+    }
+    last_frame_timestamp_us_ = frame.timestamp_us();
+    key_frame_requested_ = false;
+    std::vector<VideoFrameType> types(
+        frame_types != nullptr ? frame_types->size() : 1,
+        key_frame ? VideoFrameType::kVideoFrameKey
+                  : VideoFrameType::kVideoFrameDelta);
+    int32_t result = encoder_->Encode(frame, &types);
+    if (result != WEBRTC_VIDEO_CODEC_OK && key_frame) {
+      key_frame_requested_ = true;
+    }
+    return result;
+  }
+
+  void SetRates(SharedEncoder* member,
+                const VideoEncoder::RateControlParameters& parameters) {
+    MutexLock lock(&encoder_mutex_);
+    {
+      MutexLock members_lock(&members_mutex_);
+      FindMember(member).rates = parameters;
+    }
+    ApplyRates();
+  }
+
+  void OnPacketLossRateUpdate(float packet_loss_rate) {
+    MutexLock lock(&encoder_mutex_);
+    encoder_->OnPacketLossRateUpdate(packet_loss_rate);
+  }
+
+  void OnRttUpdate(int64_t rtt_ms) {
+    MutexLock lock(&encoder_mutex_);
+    encoder_->OnRttUpdate(rtt_ms);
+  }
+
+  void OnLossNotification(
+      const VideoEncoder::LossNotification& loss_notification) {
+    MutexLock lock(&encoder_mutex_);
+    encoder_->OnLossNotification(loss_notification);
+  }
+
+  VideoEncoder::EncoderInfo GetEncoderInfo() const {
+    MutexLock lock(&encoder_mutex_);
+    return encoder_->GetEncoderInfo();
+  }
+
+  // EncodedImageCallback implementation.
+  Result OnEncodedImage(
+      const EncodedImage& encoded_image,
+      const CodecSpecificInfo* codec_specific_info) override {
+    MutexLock lock(&members_mutex_);
+    Result result(Result::OK);
+    for (const Member& member : members_) {
+      if (member.callback == nullptr) {
+        continue;
+      }
+      Result member_result =
+          member.callback->OnEncodedImage(encoded_image, codec_specific_info);
+      if (member_result.error != Result::OK) {
+        result = member_result;
+      }
+    }
+    return result;
+  }
+
+  void OnDroppedFrame(DropReason reason) override {
+    MutexLock lock(&members_mutex_);
+    for (const Member& member : members_) {
+      if (member.callback != nullptr) {
+        member.callback->OnDroppedFrame(reason);
+      }
+    }
+  }
+
+ private:
+  struct Member {
+    SharedEncoder* encoder;
+    EncodedImageCallback* callback = nullptr;
+    absl::optional<VideoEncoder::RateControlParameters> rates;
+  };
+
+  Member& FindMember(SharedEncoder* member)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(members_mutex_) {
+    auto it = absl::c_find_if(
+        members_, [&](const Member& m) { return m.encoder == member; });
+    RTC_DCHECK(it != members_.end());
+    return *it;
+  }
+
+  // Runs the encoder at the lowest target of the members that are not paused,
+  // so that the stream fits every member's link. The encoder is only paused
+  // if all members are.
+  void ApplyRates() RTC_EXCLUSIVE_LOCKS_REQUIRED(encoder_mutex_) {
+    absl::optional<VideoEncoder::RateControlParameters> rates;
+    {
+      MutexLock lock(&members_mutex_);
+      for (const Member& member : members_) {
+        if (!member.rates) {
+          continue;
+        }
+        uint32_t bitrate_bps = member.rates->bitrate.get_sum_bps();
+        if (!rates || (bitrate_bps > 0 &&
+                       (rates->bitrate.get_sum_bps() == 0 ||
+                        bitrate_bps < rates->bitrate.get_sum_bps()))) {
+          rates = member.rates;
+        }
+      }
+    }
+    if (rates && rates != applied_rates_) {
+      encoder_->SetRates(*rates);
+      applied_rates_ = rates;
+    }
+  }
+
+  VideoEncoderFactory* const factory_;
+  const SdpVideoFormat format_;
+  const void* const source_;
+  const VideoCodec codec_settings_;
+  const VideoEncoder::Settings settings_;
+
+  mutable Mutex encoder_mutex_;
+  const std::unique_ptr<VideoEncoder> encoder_
+      RTC_PT_GUARDED_BY(encoder_mutex_);
+  int64_t last_frame_timestamp_us_ RTC_GUARDED_BY(encoder_mutex_) =
+      std::numeric_limits<int64_t>::min();
+  bool key_frame_requested_ RTC_GUARDED_BY(encoder_mutex_) = false;
+  absl::optional<VideoEncoder::RateControlParameters> applied_rates_
+      RTC_GUARDED_BY(encoder_mutex_);
+
+  Mutex members_mutex_;
+  std::vector<Member> members_ RTC_GUARDED_BY(members_mutex_);
+};
+
+// Encoder handed out by the pool. Until initialized, and when its encoder is
+// not shareable, it uses an encoder of its own; otherwise it forwards to the
+// group it joined.
+class SharedVideoEncoderPool::SharedEncoder : public VideoEncoder {
+ public:
+  SharedEncoder(SharedVideoEncoderPool* pool,
+                VideoEncoderFactory* factory,
+                const SdpVideoFormat& format,
+                const void* source,
+                std::unique_ptr<VideoEncoder> encoder)
+      : pool_(pool),
+        factory_(factory),
+        format_(format),
+        source_(source),
+        encoder_(std::move(encoder)) {}
+
+  ~SharedEncoder() override { LeaveGroup(); }
+
+  VideoEncoderFactory* factory() const { return factory_; }
+  const SdpVideoFormat& format() const { return format_; }
+  const void* source() const { return source_; }
+
+  // VideoEncoder implementation.
+  void SetFecControllerOverride(
+      FecControllerOverride* fec_controller_override) override {
+    // Only applied to an encoder of its own, as the override of one stream
+    // can't control a shared encoder.
+    fec_controller_override_ = fec_controller_override;
+    if (encoder_) {
+      encoder_->SetFecControllerOverride(fec_controller_override);
+    }
+  }
+
+  int InitEncode(const VideoCodec* codec_settings,
+                 const VideoEncoder::Settings& settings) override {
+    LeaveGroup();
+    if (!encoder_) {
+      encoder_ = factory_->CreateVideoEncoder(format_);
+      if (!encoder_) {
+        return WEBRTC_VIDEO_CODEC_ERROR;
+      }
+      encoder_->SetFecControllerOverride(fec_controller_override_);
+    }
+    if (encoder_->GetEncoderInfo().is_hardware_accelerated) {
+      if (callback_) {
+        encoder_->RegisterEncodeCompleteCallback(callback_);
+      }
+      return encoder_->InitEncode(codec_settings, settings);
+    }
+    int error = WEBRTC_VIDEO_CODEC_OK;
+    group_ = pool_->Join(this, encoder_, *codec_settings, settings, error);
+    if (!group_) {
+      return error;
+    }
+    if (callback_) {
+      group_->SetCallback(this, callback_);
+    }
+    return WEBRTC_VIDEO_CODEC_OK;
+  }
+
+  int32_t RegisterEncodeCompleteCallback(
+      EncodedImageCallback* callback) override {
+    callback_ = callback;
+    if (group_) {
+      group_->SetCallback(this, callback);
+    } else if (encoder_) {
+      encoder_->RegisterEncodeCompleteCallback(callback);
+    }
+    return WEBRTC_VIDEO_CODEC_OK;
+  }
+
+  int32_t Release() override {
+    if (group_) {
+      LeaveGroup();
+      return WEBRTC_VIDEO_CODEC_OK;
+    }
+    return encoder_ ? encoder_->Release() : WEBRTC_VIDEO_CODEC_OK;
+  }
+
+  int32_t Encode(const VideoFrame& frame,
+                 const std::vector<VideoFrameType>* frame_types) override {
+    if (group_) {
+      return group_->Encode(frame, frame_types);
+    }
+    return encoder_ ? encoder_->Encode(frame, frame_types)
+                    : WEBRTC_VIDEO_CODEC_UNINITIALIZED;
+  }
+
+  void SetRates(const RateControlParameters& parameters) override {
+    if (group_) {
+      group_->SetRates(this, parameters);
+    } else if (encoder_) {
+      encoder_->SetRates(parameters);
+    }
+  }
+
+  void OnPacketLossRateUpdate(float packet_loss_rate) override {
+    if (group_) {
+      group_->OnPacketLossRateUpdate(packet_loss_rate);
+    } else if (encoder_) {
+      encoder_->OnPacketLossRateUpdate(packet_loss_rate);
+    }
+  }
+
+  void OnRttUpdate(int64_t rtt_ms) override {
+    if (group_) {
+      group_->OnRttUpdate(rtt_ms);
+    } else if (encoder_) {
+      encoder_->OnRttUpdate(rtt_ms);
+    }
+  }
+
+  void OnLossNotification(const LossNotification& loss_notification) override {
+    if (group_) {
+      group_->OnLossNotification(loss_notification);
+    } else if (encoder_) {
+      encoder_->OnLossNotification(loss_notification);
+    }
+  }
+
+  EncoderInfo GetEncoderInfo() const override {
+    if (group_) {
+      return group_->GetEncoderInfo();
+    }
+    return encoder_ ? encoder_->GetEncoderInfo() : EncoderInfo();
+  }
+
+ private:
+  void LeaveGroup() {
+    if (group_) {
+      pool_->Leave(this, group_);
+      group_ = nullptr;
+    }
+  }
+
+  SharedVideoEncoderPool* const pool_;
+  VideoEncoderFactory* const factory_;
+  const SdpVideoFormat format_;
+  const void* const source_;
+  // Null while in a group, and after leaving one until initialized again.
+  std::unique_ptr<VideoEncoder> encoder_;
+  Group* group_ = nullptr;
+  EncodedImageCallback* callback_ = nullptr;
+  FecControllerOverride* fec_controller_override_ = nullptr;
+};
+
+SharedVideoEncoderPool& SharedVideoEncoderPool::Default() {
+  static SharedVideoEncoderPool* const pool = new SharedVideoEncoderPool();
+  return *pool;
+}
+
+SharedVideoEncoderPool::SharedVideoEncoderPool() = default;
+
+SharedVideoEncoderPool::~SharedVideoEncoderPool() {
+  RTC_DCHECK(groups_.empty());
+}
+
+std::unique_ptr<VideoEncoder> SharedVideoEncoderPool::CreateEncoder(
+    VideoEncoderFactory* factory,
+    const SdpVideoFormat& format,
+    const void* source) {
+  std::unique_ptr<VideoEncoder> encoder = factory->CreateVideoEncoder(format);
+  if (!encoder || source == nullptr) {
+    return encoder;
+  }
+  return std::make_unique<SharedEncoder>(this, factory, format, source,
+                                         std::move(encoder));
+}
+
+size_t SharedVideoEncoderPool::NumGroups() const {
+  MutexLock lock(&mutex_);
+  return groups_.size();
+}
+
+SharedVideoEncoderPool::Group* SharedVideoEncoderPool::Join(
+    SharedEncoder* member,
+    std::unique_ptr<VideoEncoder>& encoder,
+    const VideoCodec& codec_settings,
+    const VideoEncoder::Settings& settings,
+    int& error) {
+  MutexLock lock(&mutex_);
+  for (const std::unique_ptr<Group>& group : groups_) {
+    if (group->Matches(member->factory(), member->format(), member->source(),
+                       codec_settings, settings)) {
+      group->AddMember(member);
+      encoder = nullptr;
+      return group.get();
+    }
+  }
+  error = encoder->InitEncode(&codec_settings, settings);
+  if (error != WEBRTC_VIDEO_CODEC_OK) {
+    return nullptr;
+  }
+  groups_.push_back(std::make_unique<Group>(
+      member->factory(), member->format(), member->source(),
+      std::move(encoder), codec_settings, settings));
+  groups_.back()->AddMember(member);
+  RTC_LOG(LS_INFO) << "Created shared encoder for " << member->format().name
+                   << ", " << groups_.size() << " in use.";
+  return groups_.back().get();
+}
+
+void SharedVideoEncoderPool::Leave(SharedEncoder* member, Group* group) {
+  // Released after unlocking.
+  std::unique_ptr<Group> released;
+  MutexLock lock(&mutex_);
+  if (!group->RemoveMember(member)) {
+    return;
+  }
+  auto it = absl::c_find_if(groups_, [&](const std::unique_ptr<Group>& g) {
+    return g.get() == group;
+  });
+  RTC_DCHECK(it != groups_.end());
+  released = std::move(*it);
+  groups_.erase(it);
+}
+
+}  // namespace webrtc
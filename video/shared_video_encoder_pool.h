@@ -0,0 +1,85 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VIDEO_SHARED_VIDEO_ENCODER_POOL_H_
+#define VIDEO_SHARED_VIDEO_ENCODER_POOL_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <vector>
+
+#include "api/video_codecs/sdp_video_format.h"
+#include "api/video_codecs/video_codec.h"
+#include "api/video_codecs/video_encoder.h"
+#include "api/video_codecs/video_encoder_factory.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Lets the send streams of several calls that encode the same video source
+// with identical settings share a single encoder, e.g. when one track is sent
+// to many PeerConnections. Encoders created by the pool join, when
+// initialized, a group of encoders for the same source, factory and format
+// that were initialized with compatible codec settings; the first of them
+// becomes the group's encoder and the others release theirs. A frame is
+// encoded once, by the first member to pass it in, and the encoded images
+// are delivered to the callbacks of all members. Key frame requests of any
+// member are honored for all of them, and the encoder runs at the lowest
+// rate allocation of the members that are not paused.
+// Hardware encoders are not shared, as their output may be delivered
+// asynchronously on encoder-owned threads.
+// This class is thread safe.
+class SharedVideoEncoderPool {
+ public:
+  // Returns the process-wide pool.
+  static SharedVideoEncoderPool& Default();
+
+  SharedVideoEncoderPool();
+  ~SharedVideoEncoderPool();
+
+  SharedVideoEncoderPool(const SharedVideoEncoderPool&) = delete;
+  SharedVideoEncoderPool& operator=(const SharedVideoEncoderPool&) = delete;
+
+  // Returns an encoder for `format` that can share its encoder with the other
+  // encoders of this pool created for the same `source`, which only serves as
+  // a key. Returns null if `factory` fails to create an encoder. `factory`
+  // must outlive the returned encoder and the pool.
+  std::unique_ptr<VideoEncoder> CreateEncoder(VideoEncoderFactory* factory,
+                                              const SdpVideoFormat& format,
+                                              const void* source);
+
+  // Number of shared encoders in use.
+  size_t NumGroups() const;
+
+ private:
+  class Group;
+  class SharedEncoder;
+
+  // Adds `member` to a group of compatible encoders, or initializes `encoder`
+  // and makes it the encoder of a new group. Returns the group, or null and
+  // the error of initializing `encoder` in `error`.
+  Group* Join(SharedEncoder* member,
+              std::unique_ptr<VideoEncoder>& encoder,
+              const VideoCodec& codec_settings,
+              const VideoEncoder::Settings& settings,
+              int& error);
+  // Removes `member` from `group`, releasing the group's encoder if it was
+  // the last member.
+  void Leave(SharedEncoder* member, Group* group);
+
+  mutable Mutex mutex_;
+  std::vector<std::unique_ptr<Group>> groups_ RTC_GUARDED_BY(mutex_);
+};
+
+}  // namespace webrtc
+
+#endif  // VIDEO_SHARED_VIDEO_ENCODER_POOL_H_
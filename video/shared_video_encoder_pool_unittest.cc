@@ -0,0 +1,264 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/shared_video_encoder_pool.h"
+
+#include <memory>
+#include <vector>
+
+#include "api/video/i420_buffer.h"
+#include "api/video/video_frame.h"
+#include "modules/video_coding/include/video_codec_interface.h"
+#include "modules/video_coding/include/video_error_codes.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+
+constexpr int kWidth = 320;
+constexpr int kHeight = 240;
+
+// Encoder producing one image per frame, of the requested type.
+class FakeEncoder : public VideoEncoder {
+ public:
+  explicit FakeEncoder(bool hardware_accelerated)
+      : hardware_accelerated_(hardware_accelerated) {}
+
+  int InitEncode(const VideoCodec* codec_settings,
+                 const VideoEncoder::Settings& settings) override {
+    return WEBRTC_VIDEO_CODEC_OK;
+  }
+  int32_t RegisterEncodeCompleteCallback(
+      EncodedImageCallback* callback) override {
+    callback_ = callback;
+    return WEBRTC_VIDEO_CODEC_OK;
+  }
+  int32_t Release() override { return WEBRTC_VIDEO_CODEC_OK; }
+  int32_t Encode(const VideoFrame& frame,
+                 const std::vector<VideoFrameType>* frame_types) override {
+    encoded_types_.push_back(frame_types ? (*frame_types)[0]
+                                         : VideoFrameType::kVideoFrameDelta);
+    EncodedImage image;
+    image.SetRtpTimestamp(frame.timestamp());
+    image._frameType = encoded_types_.back();
+    CodecSpecificInfo codec_specific;
+    callback_->OnEncodedImage(image, &codec_specific);
+    return WEBRTC_VIDEO_CODEC_OK;
+  }
+  void SetRates(const RateControlParameters& parameters) override {
+    rates_.push_back(parameters.bitrate.get_sum_bps());
+  }
+  EncoderInfo GetEncoderInfo() const override {
+    EncoderInfo info;
+    info.is_hardware_accelerated = hardware_accelerated_;
+    return info;
+  }
+
+  const std::vector<VideoFrameType>& encoded_types() const {
+    return encoded_types_;
+  }
+  const std::vector<uint32_t>& rates() const { return rates_; }
+
+ private:
+  const bool hardware_accelerated_;
+  EncodedImageCallback* callback_ = nullptr;
+  std::vector<VideoFrameType> encoded_types_;
+  std::vector<uint32_t> rates_;
+};
+
+class FakeEncoderFactory : public VideoEncoderFactory {
+ public:
+  std::vector<SdpVideoFormat> GetSupportedFormats() const override {
+    return {SdpVideoFormat("VP8")};
+  }
+  std::unique_ptr<VideoEncoder> CreateVideoEncoder(
+      const SdpVideoFormat& format) override {
+    auto encoder = std::make_unique<FakeEncoder>(hardware_accelerated_);
+    encoders_.push_back(encoder.get());
+    return encoder;
+  }
+
+  void set_hardware_accelerated(bool hardware_accelerated) {
+    hardware_accelerated_ = hardware_accelerated;
+  }
+  // Encoders created, in order. Only valid while not destroyed.
+  const std::vector<FakeEncoder*>& encoders() const { return encoders_; }
+
+ private:
+  bool hardware_accelerated_ = false;
+  std::vector<FakeEncoder*> encoders_;
+};
+
+class CountingCallback : public EncodedImageCallback {
+ public:
+  Result OnEncodedImage(const EncodedImage& encoded_image,
+                        const CodecSpecificInfo* codec_specific_info) override {
+    rtp_timestamps_.push_back(encoded_image.RtpTimestamp());
+    return Result(Result::OK);
+  }
+
+  const std::vector<uint32_t>& rtp_timestamps() const {
+    return rtp_timestamps_;
+  }
+
+ private:
+  std::vector<uint32_t> rtp_timestamps_;
+};
+
+VideoCodec CodecSettings(int width = kWidth) {
+  VideoCodec codec;
+  codec.codecType = kVideoCodecVP8;
+  codec.width = width;
+  codec.height = kHeight;
+  codec.maxFramerate = 30;
+  *codec.VP8() = VideoEncoder::GetDefaultVp8Settings();
+  return codec;
+}
+
+const VideoEncoder::Settings kSettings(VideoEncoder::Capabilities(false),
+                                       /*number_of_cores=*/1,
+                                       /*max_payload_size=*/1200);
+
+VideoFrame Frame(int64_t timestamp_us) {
+  return VideoFrame::Builder()
+      .set_video_frame_buffer(I420Buffer::Create(kWidth, kHeight))
+      .set_timestamp_us(timestamp_us)
+      .set_timestamp_rtp(timestamp_us / 1000 * 90)
+      .build();
+}
+
+VideoEncoder::RateControlParameters Rates(uint32_t bitrate_bps) {
+  VideoBitrateAllocation allocation;
+  allocation.SetBitrate(0, 0, bitrate_bps);
+  return VideoEncoder::RateControlParameters(allocation, 30.0);
+}
+
+class SharedVideoEncoderPoolTest : public ::testing::Test {
+ protected:
+  std::unique_ptr<VideoEncoder> CreateInitializedEncoder(
+      const void* source,
+      EncodedImageCallback* callback,
+      const VideoCodec& codec = CodecSettings()) {
+    std::unique_ptr<VideoEncoder> encoder =
+        pool_.CreateEncoder(&factory_, SdpVideoFormat("VP8"), source);
+    encoder->RegisterEncodeCompleteCallback(callback);
+    EXPECT_EQ(encoder->InitEncode(&codec, kSettings), WEBRTC_VIDEO_CODEC_OK);
+    return encoder;
+  }
+
+  FakeEncoderFactory factory_;
+  SharedVideoEncoderPool pool_;
+  const int source_ = 0;
+  const int other_source_ = 0;
+  CountingCallback callback1_;
+  CountingCallback callback2_;
+};
+
+TEST_F(SharedVideoEncoderPoolTest, EncodesFrameOnceForAllEncodersOfSource) {
+  auto encoder1 = CreateInitializedEncoder(&source_, &callback1_);
+  auto encoder2 = CreateInitializedEncoder(&source_, &callback2_);
+  EXPECT_EQ(pool_.NumGroups(), 1u);
+
+  VideoFrame frame = Frame(/*timestamp_us=*/1000);
+  EXPECT_EQ(encoder1->Encode(frame, nullptr), WEBRTC_VIDEO_CODEC_OK);
+  EXPECT_EQ(encoder2->Encode(frame, nullptr), WEBRTC_VIDEO_CODEC_OK);
+
+  EXPECT_EQ(factory_.encoders()[0]->encoded_types().size(), 1u);
+  EXPECT_THAT(callback1_.rtp_timestamps(), ElementsAre(frame.timestamp()));
+  EXPECT_THAT(callback2_.rtp_timestamps(), ElementsAre(frame.timestamp()));
+}
+
+TEST_F(SharedVideoEncoderPoolTest, KeyFrameRequestsApplyToSharedEncoder) {
+  auto encoder1 = CreateInitializedEncoder(&source_, &callback1_);
+  EXPECT_EQ(encoder1->Encode(Frame(1000), nullptr), WEBRTC_VIDEO_CODEC_OK);
+  EXPECT_EQ(encoder1->Encode(Frame(2000), nullptr), WEBRTC_VIDEO_CODEC_OK);
+
+  // A joining encoder gets a key frame.
+  auto encoder2 = CreateInitializedEncoder(&source_, &callback2_);
+  EXPECT_EQ(encoder2->Encode(Frame(3000), nullptr), WEBRTC_VIDEO_CODEC_OK);
+  EXPECT_EQ(encoder1->Encode(Frame(3000), nullptr), WEBRTC_VIDEO_CODEC_OK);
+
+  // A key frame requested for a frame encoded for another member is produced
+  // on the next frame.
+  std::vector<VideoFrameType> key = {VideoFrameType::kVideoFrameKey};
+  EXPECT_EQ(encoder1->Encode(Frame(4000), nullptr), WEBRTC_VIDEO_CODEC_OK);
+  EXPECT_EQ(encoder2->Encode(Frame(4000), &key), WEBRTC_VIDEO_CODEC_OK);
+  EXPECT_EQ(encoder1->Encode(Frame(5000), nullptr), WEBRTC_VIDEO_CODEC_OK);
+
+  EXPECT_THAT(factory_.encoders()[0]->encoded_types(),
+              ElementsAre(VideoFrameType::kVideoFrameKey,
+                          VideoFrameType::kVideoFrameDelta,
+                          VideoFrameType::kVideoFrameKey,
+                          VideoFrameType::kVideoFrameDelta,
+                          VideoFrameType::kVideoFrameKey));
+}
+
+TEST_F(SharedVideoEncoderPoolTest, UsesLowestRateOfActiveEncoders) {
+  auto encoder1 = CreateInitializedEncoder(&source_, &callback1_);
+  auto encoder2 = CreateInitializedEncoder(&source_, &callback2_);
+  const FakeEncoder* shared = factory_.encoders()[0];
+
+  encoder1->SetRates(Rates(500000));
+  encoder2->SetRates(Rates(300000));
+  EXPECT_EQ(shared->rates().back(), 300000u);
+
+  // A paused encoder doesn't hold back the other one.
+  encoder2->SetRates(Rates(0));
+  EXPECT_EQ(shared->rates().back(), 500000u);
+
+  // Leaving the group no longer limits the rate.
+  encoder2->SetRates(Rates(200000));
+  EXPECT_EQ(shared->rates().back(), 200000u);
+  encoder2.reset();
+  EXPECT_EQ(shared->rates().back(), 500000u);
+}
+
+TEST_F(SharedVideoEncoderPoolTest, DoesNotShareBetweenSourcesOrSettings) {
+  auto encoder1 = CreateInitializedEncoder(&source_, &callback1_);
+  auto encoder2 = CreateInitializedEncoder(&other_source_, &callback2_);
+  EXPECT_EQ(pool_.NumGroups(), 2u);
+
+  CountingCallback callback3;
+  auto encoder3 =
+      CreateInitializedEncoder(&source_, &callback3, CodecSettings(640));
+  EXPECT_EQ(pool_.NumGroups(), 3u);
+
+  // Re-initializing with the settings of the first group joins it.
+  VideoCodec codec = CodecSettings();
+  EXPECT_EQ(encoder3->InitEncode(&codec, kSettings), WEBRTC_VIDEO_CODEC_OK);
+  EXPECT_EQ(pool_.NumGroups(), 2u);
+}
+
+TEST_F(SharedVideoEncoderPoolTest, DoesNotShareHardwareEncoders) {
+  factory_.set_hardware_accelerated(true);
+  auto encoder1 = CreateInitializedEncoder(&source_, &callback1_);
+  auto encoder2 = CreateInitializedEncoder(&source_, &callback2_);
+  EXPECT_EQ(pool_.NumGroups(), 0u);
+
+  EXPECT_EQ(encoder1->Encode(Frame(1000), nullptr), WEBRTC_VIDEO_CODEC_OK);
+  EXPECT_EQ(encoder2->Encode(Frame(1000), nullptr), WEBRTC_VIDEO_CODEC_OK);
+  EXPECT_EQ(factory_.encoders()[0]->encoded_types().size(), 1u);
+  EXPECT_EQ(factory_.encoders()[1]->encoded_types().size(), 1u);
+}
+
+TEST_F(SharedVideoEncoderPoolTest, ReleasesSharedEncoderWithLastMember) {
+  auto encoder1 = CreateInitializedEncoder(&source_, &callback1_);
+  auto encoder2 = CreateInitializedEncoder(&source_, &callback2_);
+  EXPECT_EQ(encoder1->Release(), WEBRTC_VIDEO_CODEC_OK);
+  EXPECT_EQ(pool_.NumGroups(), 1u);
+  encoder2.reset();
+  EXPECT_EQ(pool_.NumGroups(), 0u);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,102 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/video_decoder_pool.h"
+
+#include <utility>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+constexpr char VideoDecoderPool::Config::kKey[];
+
+std::unique_ptr<StructParametersParser> VideoDecoderPool::Config::Parser() {
+  return StructParametersParser::Create(
+      "enabled", &enabled,                          //
+      "idle_release_time", &idle_release_time,      //
+      "max_pooled_decoders", &max_pooled_decoders,  //
+      "max_pooled_time", &max_pooled_time);
+}
+
+std::unique_ptr<VideoDecoderPool> VideoDecoderPool::CreateFromFieldTrials(
+    const FieldTrialsView& field_trials,
+    Clock& clock) {
+  Config config;
+  config.Parser()->Parse(field_trials.Lookup(Config::kKey));
+  if (!config.enabled)
+    return nullptr;
+  return std::make_unique<VideoDecoderPool>(config, clock);
+}
+
+VideoDecoderPool::VideoDecoderPool(const Config& config, Clock& clock)
+    : config_(config), clock_(clock) {}
+
+VideoDecoderPool::~VideoDecoderPool() = default;
+
+std::unique_ptr<VideoDecoder> VideoDecoderPool::Take(
+    const VideoDecoderFactory* factory,
+    const SdpVideoFormat& format,
+    RenderResolution resolution) {
+  MutexLock lock(&mutex_);
+  RemoveExpired(clock_.CurrentTime());
+  // Entries are in the order they were pooled, and the most recently pooled
+  // decoder of those matching best is taken.
+  auto match = entries_.end();
+  for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+    if (it->factory != factory || !it->format.IsSameCodec(format)) {
+      continue;
+    }
+    if (match == entries_.end() || it->resolution == resolution ||
+        match->resolution != resolution) {
+      match = it;
+    }
+  }
+  if (match == entries_.end()) {
+    return nullptr;
+  }
+  std::unique_ptr<VideoDecoder> decoder = std::move(match->decoder);
+  entries_.erase(match);
+  return decoder;
+}
+
+void VideoDecoderPool::Put(const VideoDecoderFactory* factory,
+                           const SdpVideoFormat& format,
+                           RenderResolution resolution,
+                           std::unique_ptr<VideoDecoder> decoder) {
+  RTC_DCHECK(decoder);
+  const Timestamp now = clock_.CurrentTime();
+  MutexLock lock(&mutex_);
+  RemoveExpired(now);
+  if (config_.max_pooled_decoders <= 0) {
+    return;
+  }
+  if (entries_.size() >= static_cast<size_t>(config_.max_pooled_decoders)) {
+    entries_.erase(entries_.begin());
+  }
+  entries_.push_back(
+      Entry{factory, format, resolution, now, std::move(decoder)});
+}
+
+size_t VideoDecoderPool::size() const {
+  MutexLock lock(&mutex_);
+  return entries_.size();
+}
+
+void VideoDecoderPool::RemoveExpired(Timestamp now) {
+  auto it = entries_.begin();
+  while (it != entries_.end() &&
+         now - it->pooled_time >= config_.max_pooled_time) {
+    ++it;
+  }
+  entries_.erase(entries_.begin(), it);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,111 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VIDEO_VIDEO_DECODER_POOL_H_
+#define VIDEO_VIDEO_DECODER_POOL_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <vector>
+
+#include "api/field_trials_view.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "api/video/render_resolution.h"
+#include "api/video_codecs/sdp_video_format.h"
+#include "api/video_codecs/video_decoder.h"
+#include "api/video_codecs/video_decoder_factory.h"
+#include "rtc_base/experiments/struct_parameters_parser.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+
+// Keeps the decoders released by the video receive streams of a call for
+// reuse by other streams of the call, so that streams that start or resume
+// decoding don't have to create a decoder from scratch.
+//
+// With a pool, a receive stream releases its decoders when it hasn't had a
+// frame to decode for `Config::idle_release_time`, and when it is stopped,
+// and puts them into the pool. A stream that needs a decoder again, which
+// happens on its next decodable key frame, first looks for one in the pool.
+// Decoders are pooled by the factory that created them, their codec and the
+// resolution they last decoded, and are destroyed when they have not been
+// reused for `Config::max_pooled_time`.
+// This class is thread safe.
+class VideoDecoderPool {
+ public:
+  struct Config {
+    static constexpr char kKey[] = "WebRTC-Video-DecoderPool";
+    std::unique_ptr<StructParametersParser> Parser();
+
+    bool enabled = false;
+    // Receive streams release their decoders after this long without a frame
+    // to decode.
+    TimeDelta idle_release_time = TimeDelta::Seconds(10);
+    // The pool keeps at most this many decoders, destroying the ones pooled
+    // the longest ago first.
+    int max_pooled_decoders = 8;
+    TimeDelta max_pooled_time = TimeDelta::Seconds(30);
+  };
+
+  // Returns a pool configured from `field_trials`, or nullptr if not enabled.
+  static std::unique_ptr<VideoDecoderPool> CreateFromFieldTrials(
+      const FieldTrialsView& field_trials,
+      Clock& clock);
+
+  VideoDecoderPool(const Config& config, Clock& clock);
+  ~VideoDecoderPool();
+
+  VideoDecoderPool(const VideoDecoderPool&) = delete;
+  VideoDecoderPool& operator=(const VideoDecoderPool&) = delete;
+
+  const Config& config() const { return config_; }
+
+  // Returns a pooled decoder for `format` that was created by `factory`,
+  // preferring one that last decoded `resolution`, or null if there is none.
+  std::unique_ptr<VideoDecoder> Take(const VideoDecoderFactory* factory,
+                                     const SdpVideoFormat& format,
+                                     RenderResolution resolution);
+
+  // Pools `decoder`, which `factory` created for `format` and which has been
+  // released, see VideoDecoder::Release(). `factory` must outlive the pool.
+  void Put(const VideoDecoderFactory* factory,
+           const SdpVideoFormat& format,
+           RenderResolution resolution,
+           std::unique_ptr<VideoDecoder> decoder);
+
+  // Number of pooled decoders.
+  size_t size() const;
+
+ private:
+  struct Entry {
+    const VideoDecoderFactory* factory;
+    SdpVideoFormat format;
+    RenderResolution resolution;
+    Timestamp pooled_time;
+    std::unique_ptr<VideoDecoder> decoder;
+  };
+
+  // Destroys the decoders that have been pooled for `max_pooled_time`.
+  void RemoveExpired(Timestamp now) RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  const Config config_;
+  Clock& clock_;
+  mutable Mutex mutex_;
+  // Ordered by `pooled_time`.
+  std::vector<Entry> entries_ RTC_GUARDED_BY(mutex_);
+};
+
+}  // namespace webrtc
+
+#endif  // VIDEO_VIDEO_DECODER_POOL_H_
@@ -0,0 +1,117 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/video_decoder_pool.h"
+
+#include <memory>
+#include <utility>
+
+#include "api/test/mock_video_decoder.h"
+#include "api/test/mock_video_decoder_factory.h"
+#include "system_wrappers/include/clock.h"
+#include "test/explicit_key_value_config.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::IsNull;
+using ::testing::NotNull;
+
+constexpr RenderResolution kHd(1280, 720);
+constexpr RenderResolution kVga(640, 480);
+
+class VideoDecoderPoolTest : public ::testing::Test {
+ protected:
+  VideoDecoderPoolTest() : clock_(Timestamp::Seconds(1000)) {}
+
+  std::unique_ptr<VideoDecoderPool> CreatePool(int max_pooled_decoders = 8) {
+    VideoDecoderPool::Config config;
+    config.enabled = true;
+    config.max_pooled_decoders = max_pooled_decoders;
+    config.max_pooled_time = TimeDelta::Seconds(30);
+    return std::make_unique<VideoDecoderPool>(config, clock_);
+  }
+
+  SimulatedClock clock_;
+  MockVideoDecoderFactory factory_;
+  MockVideoDecoderFactory other_factory_;
+};
+
+TEST_F(VideoDecoderPoolTest, IsNotCreatedUnlessEnabled) {
+  test::ExplicitKeyValueConfig disabled("");
+  EXPECT_THAT(VideoDecoderPool::CreateFromFieldTrials(disabled, clock_),
+              IsNull());
+
+  test::ExplicitKeyValueConfig enabled(
+      "WebRTC-Video-DecoderPool/enabled:true,idle_release_time:5s/");
+  std::unique_ptr<VideoDecoderPool> pool =
+      VideoDecoderPool::CreateFromFieldTrials(enabled, clock_);
+  ASSERT_THAT(pool, NotNull());
+  EXPECT_EQ(pool->config().idle_release_time, TimeDelta::Seconds(5));
+}
+
+TEST_F(VideoDecoderPoolTest, TakesDecoderOfSameFactoryAndCodec) {
+  std::unique_ptr<VideoDecoderPool> pool = CreatePool();
+  auto decoder = std::make_unique<MockVideoDecoder>();
+  MockVideoDecoder* decoder_ptr = decoder.get();
+  pool->Put(&factory_, SdpVideoFormat("VP8"), kVga, std::move(decoder));
+  EXPECT_EQ(pool->size(), 1u);
+
+  EXPECT_THAT(pool->Take(&other_factory_, SdpVideoFormat("VP8"), kVga),
+              IsNull());
+  EXPECT_THAT(pool->Take(&factory_, SdpVideoFormat("VP9"), kVga), IsNull());
+  EXPECT_EQ(pool->Take(&factory_, SdpVideoFormat("VP8"), kHd).get(),
+            decoder_ptr);
+  EXPECT_EQ(pool->size(), 0u);
+}
+
+TEST_F(VideoDecoderPoolTest, PrefersDecoderOfSameResolution) {
+  std::unique_ptr<VideoDecoderPool> pool = CreatePool();
+  auto vga_decoder = std::make_unique<MockVideoDecoder>();
+  MockVideoDecoder* vga_decoder_ptr = vga_decoder.get();
+  pool->Put(&factory_, SdpVideoFormat("VP8"), kVga, std::move(vga_decoder));
+  pool->Put(&factory_, SdpVideoFormat("VP8"), kHd,
+            std::make_unique<MockVideoDecoder>());
+
+  EXPECT_EQ(pool->Take(&factory_, SdpVideoFormat("VP8"), kVga).get(),
+            vga_decoder_ptr);
+}
+
+TEST_F(VideoDecoderPoolTest, DestroysOldestDecoderWhenFull) {
+  std::unique_ptr<VideoDecoderPool> pool =
+      CreatePool(/*max_pooled_decoders=*/1);
+  auto first = std::make_unique<MockVideoDecoder>();
+  EXPECT_CALL(*first, Destruct);
+  pool->Put(&factory_, SdpVideoFormat("VP8"), kVga, std::move(first));
+
+  auto second = std::make_unique<MockVideoDecoder>();
+  MockVideoDecoder* second_ptr = second.get();
+  pool->Put(&factory_, SdpVideoFormat("VP8"), kVga, std::move(second));
+  EXPECT_EQ(pool->size(), 1u);
+  EXPECT_EQ(pool->Take(&factory_, SdpVideoFormat("VP8"), kVga).get(),
+            second_ptr);
+}
+
+TEST_F(VideoDecoderPoolTest, DestroysDecodersPooledForTooLong) {
+  std::unique_ptr<VideoDecoderPool> pool = CreatePool();
+  pool->Put(&factory_, SdpVideoFormat("VP8"), kVga,
+            std::make_unique<MockVideoDecoder>());
+
+  clock_.AdvanceTime(TimeDelta::Seconds(29));
+  EXPECT_EQ(pool->size(), 1u);
+  clock_.AdvanceTime(TimeDelta::Seconds(1));
+  EXPECT_THAT(pool->Take(&factory_, SdpVideoFormat("VP8"), kVga), IsNull());
+  EXPECT_EQ(pool->size(), 0u);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -42,6 +42,7 @@
 #include "modules/video_coding/timing/timing.h"
 #include "modules/video_coding/utility/vp8_header_parser.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/cpu_time.h"
 #include "rtc_base/event.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/strings/string_builder.h"
@@ -185,7 +186,9 @@ VideoReceiveStream2::VideoReceiveStream2(
     CallStats* call_stats,
     std::unique_ptr<VCMTiming> timing,
     NackPeriodicProcessor* nack_periodic_processor,
-    DecodeSynchronizer* decode_sync)
+    DecodeSynchronizer* decode_sync,
+    DecodeThreadPool* decode_thread_pool,
+    VideoDecoderPool* decoder_pool)
     : env_(env),
       packet_sequence_checker_(SequenceChecker::kDetached),
       decode_sequence_checker_(SequenceChecker::kDetached),
@@ -221,9 +224,17 @@ VideoReceiveStream2::VideoReceiveStream2(
       max_wait_for_frame_(DetermineMaxWaitForFrame(
           TimeDelta::Millis(config_.rtp.nack.rtp_history_ms),
           false)),
-      decode_queue_(env_.task_queue_factory().CreateTaskQueue(
-          "DecodingQueue",
-          TaskQueueFactory::Priority::HIGH)) {
+      keyframe_cache_(
+          KeyframeCache::CreateFromFieldTrials(env_.field_trials())),
+      cpu_time_accounting_enabled_(
+          env_.field_trials().IsEnabled("WebRTC-PerStreamCpuTime")),
+      decode_thread_pool_(decode_thread_pool),
+      decoder_pool_(decoder_pool),
+      decode_queue_(decode_thread_pool_
+                        ? decode_thread_pool_->CreateTaskQueue()
+                        : env_.task_queue_factory().CreateTaskQueue(
+                              "DecodingQueue",
+                              TaskQueueFactory::Priority::HIGH)) {
   RTC_LOG(LS_INFO) << "VideoReceiveStream2: " << config_.ToString();
 
   RTC_DCHECK(call_->worker_thread());
@@ -383,6 +394,16 @@ void VideoReceiveStream2::Start() {
     RTC_DCHECK_RUN_ON(&decode_sequence_checker_);
     decoder_stopped_ = false;
   });
+  if (keyframe_cache_ && keyframe_cache_->size() > 0) {
+    // Frames left from before the stop can't be decoded by the new decoders.
+    buffer_->Clear();
+    absl::optional<int64_t> last_continuous_pid =
+        buffer_->InsertCachedFrames(keyframe_cache_->CopyFrames());
+    if (last_continuous_pid.has_value()) {
+      RTC_DCHECK_RUN_ON(&packet_sequence_checker_);
+      rtp_video_stream_receiver_.FrameContinuous(*last_continuous_pid);
+    }
+  }
   buffer_->StartNextDecode(true);
   decoder_running_ = true;
 
@@ -400,7 +421,9 @@ void VideoReceiveStream2::Stop() {
   // Also call `GetUniqueFramesSeen()` at the same time (since it's a counter
   // that's updated on the network thread).
   RTC_DCHECK_RUN_ON(&packet_sequence_checker_);
-  rtp_video_stream_receiver_.StopReceive();
+  // With a keyframe cache the stream keeps receiving, see OnCompleteFrame().
+  if (!keyframe_cache_)
+    rtp_video_stream_receiver_.StopReceive();
 
   stats_proxy_.OnUniqueFramesCounted(
       rtp_video_stream_receiver_.GetUniqueFramesSeen());
@@ -416,9 +439,7 @@ void VideoReceiveStream2::Stop() {
       // that any pending encoded frame will return early without trying to
       // access the decoder database.
       decoder_stopped_ = true;
-      for (const Decoder& decoder : config_.decoders) {
-        video_receiver_.RegisterExternalDecoder(nullptr, decoder.payload_type);
-      }
+      ReleaseDecoders();
       done.Set();
     });
     done.Wait(rtc::Event::kForever);
@@ -431,7 +452,8 @@ void VideoReceiveStream2::Stop() {
 
   // TODO(bugs.webrtc.org/11993): Make these calls on the network thread.
   RTC_DCHECK_RUN_ON(&packet_sequence_checker_);
-  rtp_video_stream_receiver_.RemoveReceiveCodecs();
+  if (!keyframe_cache_)
+    rtp_video_stream_receiver_.RemoveReceiveCodecs();
   video_receiver_.DeregisterReceiveCodecs();
 
   video_stream_decoder_.reset();
@@ -515,11 +537,21 @@ void VideoReceiveStream2::SetAssociatedPayloadTypes(
 }
 
 void VideoReceiveStream2::CreateAndRegisterExternalDecoder(
-    const Decoder& decoder) {
+    const Decoder& decoder,
+    RenderResolution resolution) {
   TRACE_EVENT0("webrtc",
                "VideoReceiveStream2::CreateAndRegisterExternalDecoder");
-  std::unique_ptr<VideoDecoder> video_decoder =
-      config_.decoder_factory->Create(env_, decoder.video_format);
+  std::unique_ptr<VideoDecoder> video_decoder;
+  if (decoder_pool_) {
+    video_decoder = decoder_pool_->Take(config_.decoder_factory,
+                                        decoder.video_format, resolution);
+  }
+  if (!video_decoder) {
+    video_decoder = config_.decoder_factory->Create(env_, decoder.video_format);
+  }
+  if (video_decoder && decoder_pool_) {
+    pooled_decoder_resolutions_[decoder.payload_type] = resolution;
+  }
   // If we still have no valid decoder, we have to create a "Null" decoder
   // that ignores all calls. The reason we can get into this state is that the
   // old decoder factory interface doesn't have a way to query supported
@@ -542,6 +574,8 @@ void VideoReceiveStream2::CreateAndRegisterExternalDecoder(
     rtc::SimpleStringBuilder ssb(filename_buffer);
     ssb << decoded_output_file << "/webrtc_receive_stream_" << remote_ssrc()
         << "-" << rtc::TimeMicros() << ".ivf";
+    // The wrapper dumps to a file of this stream, so it isn't pooled.
+    pooled_decoder_resolutions_.erase(decoder.payload_type);
     video_decoder = CreateFrameDumpingDecoderWrapper(
         std::move(video_decoder), FileWrapper::OpenWriteOnly(ssb.str()));
   }
@@ -550,6 +584,19 @@ void VideoReceiveStream2::CreateAndRegisterExternalDecoder(
                                           decoder.payload_type);
 }
 
+void VideoReceiveStream2::ReleaseDecoders() {
+  for (const Decoder& decoder : config_.decoders) {
+    std::unique_ptr<VideoDecoder> video_decoder =
+        video_receiver_.TakeExternalDecoder(decoder.payload_type);
+    auto it = pooled_decoder_resolutions_.find(decoder.payload_type);
+    if (video_decoder && it != pooled_decoder_resolutions_.end()) {
+      decoder_pool_->Put(config_.decoder_factory, decoder.video_format,
+                         it->second, std::move(video_decoder));
+    }
+  }
+  pooled_decoder_resolutions_.clear();
+}
+
 VideoReceiveStreamInterface::Stats VideoReceiveStream2::GetStats() const {
   RTC_DCHECK_RUN_ON(&worker_sequence_checker_);
   VideoReceiveStream2::Stats stats = stats_proxy_.GetStats();
@@ -571,6 +618,15 @@ VideoReceiveStreamInterface::Stats VideoReceiveStream2::GetStats() const {
   return stats;
 }
 
+void VideoReceiveStream2::VisitMemoryUsage(
+    rtc::MemoryUsageVisitor& visitor) const {
+  // Packets are delivered on the worker thread, so the packet buffer can be
+  // read from here.
+  RTC_DCHECK_RUN_ON(&packet_sequence_checker_);
+  visitor.Add("videoPacketBuffer",
+              rtp_video_stream_receiver_.GetPacketBufferMemoryUsageBytes());
+}
+
 void VideoReceiveStream2::UpdateHistograms() {
   RTC_DCHECK_RUN_ON(&worker_sequence_checker_);
   absl::optional<int> fraction_lost;
@@ -691,6 +747,18 @@ void VideoReceiveStream2::OnCompleteFrame(std::unique_ptr<EncodedFrame> frame) {
     UpdatePlayoutDelays();
   }
 
+  if (keyframe_cache_) {
+    bool cached = keyframe_cache_->Insert(*frame);
+    if (!decoder_running_) {
+      // Stopped, the frame is only kept for when the stream is started again.
+      if (cached) {
+        RTC_DCHECK_RUN_ON(&packet_sequence_checker_);
+        rtp_video_stream_receiver_.FrameContinuous(frame->Id());
+      }
+      return;
+    }
+  }
+
   auto last_continuous_pid = buffer_->InsertFrame(std::move(frame));
   if (last_continuous_pid.has_value()) {
     {
@@ -748,6 +816,7 @@ bool VideoReceiveStream2::SetMinimumPlayoutDelay(int delay_ms) {
 void VideoReceiveStream2::OnEncodedFrame(std::unique_ptr<EncodedFrame> frame) {
   RTC_DCHECK_RUN_ON(&packet_sequence_checker_);
   Timestamp now = env_.clock().CurrentTime();
+  last_frame_to_decode_time_ = now;
   const bool keyframe_request_is_due =
       !last_keyframe_request_ ||
       now >= (*last_keyframe_request_ + max_wait_for_keyframe_);
@@ -764,9 +833,10 @@ void VideoReceiveStream2::OnEncodedFrame(std::unique_ptr<EncodedFrame> frame) {
   }
   stats_proxy_.OnPreDecode(frame->CodecSpecific()->codecType, qp);
 
-  decode_queue_->PostTask([this, now, keyframe_request_is_due,
-                           received_frame_is_keyframe, frame = std::move(frame),
-                           keyframe_required = keyframe_required_]() mutable {
+  absl::optional<Timestamp> render_time = frame->RenderTimestamp();
+  auto decode_task = [this, now, keyframe_request_is_due,
+                      received_frame_is_keyframe, frame = std::move(frame),
+                      keyframe_required = keyframe_required_]() mutable {
     RTC_DCHECK_RUN_ON(&decode_sequence_checker_);
     if (decoder_stopped_)
       return;
@@ -791,7 +861,15 @@ void VideoReceiveStream2::OnEncodedFrame(std::unique_ptr<EncodedFrame> frame) {
                                             keyframe_request_is_due);
                    buffer_->StartNextDecode(keyframe_required_);
                  }));
-  });
+  };
+  if (decode_thread_pool_) {
+    // Frames without render time are decoded after all frames that have one.
+    decode_thread_pool_->PostTaskWithDeadline(
+        decode_queue_.get(), std::move(decode_task),
+        render_time.value_or(Timestamp::PlusInfinity()));
+  } else {
+    decode_queue_->PostTask(std::move(decode_task));
+  }
 }
 
 void VideoReceiveStream2::OnDecodableFrameTimeout(TimeDelta wait) {
@@ -810,6 +888,22 @@ void VideoReceiveStream2::OnDecodableFrameTimeout(TimeDelta wait) {
   if (!stream_is_active)
     stats_proxy_.OnStreamInactive();
 
+  if (decoder_pool_ && last_frame_to_decode_time_ &&
+      now - *last_frame_to_decode_time_ >=
+          decoder_pool_->config().idle_release_time) {
+    RTC_LOG(LS_INFO) << "Releasing the decoders of stream " << remote_ssrc()
+                     << " after " << now - *last_frame_to_decode_time_
+                     << " without frames to decode.";
+    last_frame_to_decode_time_ = absl::nullopt;
+    // Decoding resumes with new decoders, which need a keyframe.
+    keyframe_required_ = true;
+    decode_queue_->PostTask([this] {
+      RTC_DCHECK_RUN_ON(&decode_sequence_checker_);
+      if (!decoder_stopped_)
+        ReleaseDecoders();
+    });
+  }
+
   if (stream_is_active && !IsReceivingKeyFrame(now) &&
       (!config_.crypto_options.sframe.require_frame_encryption ||
        rtp_video_stream_receiver_.IsDecryptable())) {
@@ -840,7 +934,9 @@ VideoReceiveStream2::HandleEncodedFrameOnDecodeQueue(
     // Look for the decoder with this payload type.
     for (const Decoder& decoder : config_.decoders) {
       if (decoder.payload_type == frame->PayloadType()) {
-        CreateAndRegisterExternalDecoder(decoder);
+        CreateAndRegisterExternalDecoder(
+            decoder, RenderResolution(frame->EncodedImage()._encodedWidth,
+                                      frame->EncodedImage()._encodedHeight));
         break;
       }
     }
@@ -901,7 +997,14 @@ int VideoReceiveStream2::DecodeAndMaybeDispatchEncodedFrame(
       pending_resolution_.emplace();
   }
 
+  const int64_t decode_start_cpu_time_ns =
+      cpu_time_accounting_enabled_ ? rtc::GetThreadCpuTimeNanos() : 0;
   int decode_result = video_receiver_.Decode(frame_ptr);
+  if (cpu_time_accounting_enabled_) {
+    stats_proxy_.OnDecodeCpuTimeMeasured(TimeDelta::Micros(
+        (rtc::GetThreadCpuTimeNanos() - decode_start_cpu_time_ns) /
+        rtc::kNumNanosecsPerMicrosec));
+  }
   if (decode_result < WEBRTC_VIDEO_CODEC_OK) {
     // Asynchronous decoders may delay error reporting, potentially resulting in
     // error reports reflecting issues that occurred several frames back.
@@ -31,12 +31,16 @@
 #include "modules/rtp_rtcp/source/source_tracker.h"
 #include "modules/video_coding/nack_requester.h"
 #include "modules/video_coding/video_receiver2.h"
+#include "rtc_base/memory_usage.h"
 #include "rtc_base/system/no_unique_address.h"
 #include "rtc_base/thread_annotations.h"
+#include "video/decode_thread_pool.h"
+#include "video/keyframe_cache.h"
 #include "video/receive_statistics_proxy.h"
 #include "video/rtp_streams_synchronizer2.h"
 #include "video/rtp_video_stream_receiver2.h"
 #include "video/transport_adapter.h"
+#include "video/video_decoder_pool.h"
 #include "video/video_stream_buffer_controller.h"
 #include "video/video_stream_decoder2.h"
 
@@ -101,7 +105,9 @@ class VideoReceiveStream2
                       CallStats* call_stats,
                       std::unique_ptr<VCMTiming> timing,
                       NackPeriodicProcessor* nack_periodic_processor,
-                      DecodeSynchronizer* decode_sync);
+                      DecodeSynchronizer* decode_sync,
+                      DecodeThreadPool* decode_thread_pool,
+                      VideoDecoderPool* decoder_pool);
   // Destruction happens on the worker thread. Prior to destruction the caller
   // must ensure that a registration with the transport has been cleared. See
   // `RegisterWithTransport` for details.
@@ -156,6 +162,9 @@ class VideoReceiveStream2
 
   webrtc::VideoReceiveStreamInterface::Stats GetStats() const override;
 
+  // Reports the memory held by the packet buffer of the stream.
+  void VisitMemoryUsage(rtc::MemoryUsageVisitor& visitor) const;
+
   // SetBaseMinimumPlayoutDelayMs and GetBaseMinimumPlayoutDelayMs are called
   // from webrtc/api level and requested by user code. For e.g. blink/js layer
   // in Chromium.
@@ -202,7 +211,13 @@ class VideoReceiveStream2
   // Called on packet sequence.
   void OnDecodableFrameTimeout(TimeDelta wait) override;
 
-  void CreateAndRegisterExternalDecoder(const Decoder& decoder);
+  // Registers a decoder for `decoder`, taken from `decoder_pool_` if it has
+  // one for `resolution`.
+  void CreateAndRegisterExternalDecoder(const Decoder& decoder,
+                                        RenderResolution resolution)
+      RTC_RUN_ON(decode_sequence_checker_);
+  // Deregisters all decoders, returning the pooled ones to `decoder_pool_`.
+  void ReleaseDecoders() RTC_RUN_ON(decode_sequence_checker_);
 
   struct DecodeFrameResult {
     // True if the decoder returned code WEBRTC_VIDEO_CODEC_OK_REQUEST_KEYFRAME,
@@ -300,6 +315,11 @@ class VideoReceiveStream2
   // If we have successfully decoded any frame.
   bool frame_decoded_ RTC_GUARDED_BY(decode_sequence_checker_) = false;
 
+  // When the last frame was passed on to be decoded, unset while the decoders
+  // are released for being idle.
+  absl::optional<Timestamp> last_frame_to_decode_time_
+      RTC_GUARDED_BY(packet_sequence_checker_);
+
   absl::optional<Timestamp> last_keyframe_request_
       RTC_GUARDED_BY(packet_sequence_checker_);
 
@@ -345,6 +365,27 @@ class VideoReceiveStream2
   // Used to signal destruction to potentially pending tasks.
   ScopedTaskSafety task_safety_;
 
+  // If set, the stream keeps receiving while it is stopped and resumes
+  // decoding from the cached frames when started again, without requesting a
+  // keyframe.
+  const std::unique_ptr<KeyframeCache> keyframe_cache_
+      RTC_PT_GUARDED_BY(worker_sequence_checker_);
+
+  // Measures the thread CPU time of every decode and reports it to
+  // `stats_proxy_`.
+  const bool cpu_time_accounting_enabled_;
+
+  // If set, `decode_queue_` runs on this pool and decode tasks are posted with
+  // the render time of their frame as deadline.
+  DecodeThreadPool* const decode_thread_pool_;
+
+  // If set, decoders are released when idle and when the stream is stopped,
+  // and taken from and returned to this pool.
+  VideoDecoderPool* const decoder_pool_;
+  // Resolutions the pooled decoders were registered for, by payload type.
+  std::map<uint8_t, RenderResolution> pooled_decoder_resolutions_
+      RTC_GUARDED_BY(decode_sequence_checker_);
+
   // Defined last so they are destroyed before all other members, in particular
   // `decode_queue_` should be stopped before `decode_sequence_checker_` is
   // destructed to avoid races when running tasks on the `decode_queue_` during
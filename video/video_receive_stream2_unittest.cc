@@ -55,6 +55,7 @@
 #include "test/time_controller/simulated_time_controller.h"
 #include "test/video_decoder_proxy_factory.h"
 #include "video/call_stats2.h"
+#include "video/video_decoder_pool.h"
 
 namespace webrtc {
 
@@ -263,7 +264,8 @@ class VideoReceiveStream2Test : public ::testing::TestWithParam<bool> {
             env_, &fake_call_, kDefaultNumCpuCores, &packet_router_,
             config_.Copy(), &call_stats_, absl::WrapUnique(timing_),
             &nack_periodic_processor_,
-            UseMetronome() ? &decode_sync_ : nullptr);
+            UseMetronome() ? &decode_sync_ : nullptr,
+            /*decode_thread_pool=*/nullptr, decoder_pool_.get());
     video_receive_stream_->RegisterWithTransport(
         &rtp_stream_receiver_controller_);
     if (state)
@@ -288,6 +290,7 @@ class VideoReceiveStream2Test : public ::testing::TestWithParam<bool> {
   VCMTiming* timing_;
   test::FakeMetronome fake_metronome_;
   DecodeSynchronizer decode_sync_;
+  std::unique_ptr<VideoDecoderPool> decoder_pool_;
 
  private:
   test::VideoDecoderProxyFactory h264_decoder_factory_;
@@ -480,6 +483,48 @@ TEST_P(VideoReceiveStream2Test, LazyDecoderCreation) {
   time_controller_.AdvanceTime(TimeDelta::Zero());
 }
 
+TEST_P(VideoReceiveStream2Test, ReusesPooledDecoderWhenRestarted) {
+  decoder_pool_ = std::make_unique<VideoDecoderPool>(VideoDecoderPool::Config(),
+                                                     env_.clock());
+  RecreateReceiveStream();
+  constexpr uint8_t idr_nalu[] = {0x05, 0xFF, 0xFF, 0xFF};
+  RtpPacketToSend rtppacket(nullptr);
+  uint8_t* payload = rtppacket.AllocatePayload(sizeof(idr_nalu));
+  memcpy(payload, idr_nalu, sizeof(idr_nalu));
+  rtppacket.SetMarker(true);
+  rtppacket.SetSsrc(1111);
+  rtppacket.SetPayloadType(99);
+  rtppacket.SetSequenceNumber(1);
+  rtppacket.SetTimestamp(0);
+  RtpPacketReceived parsed_packet;
+  ASSERT_TRUE(parsed_packet.Parse(rtppacket.data(), rtppacket.size()));
+
+  EXPECT_CALL(mock_h264_decoder_factory_, Create);
+  video_receive_stream_->Start();
+  rtp_stream_receiver_controller_.OnRtpPacket(parsed_packet);
+  time_controller_.AdvanceTime(TimeDelta::Zero());
+  EXPECT_EQ(decoder_pool_->size(), 0u);
+
+  // Stopping releases the decoder into the pool.
+  EXPECT_CALL(mock_decoder_, Release);
+  video_receive_stream_->Stop();
+  EXPECT_EQ(decoder_pool_->size(), 1u);
+  EXPECT_TRUE(
+      testing::Mock::VerifyAndClearExpectations(&mock_h264_decoder_factory_));
+
+  // The next keyframe is decoded by the pooled decoder.
+  EXPECT_CALL(mock_h264_decoder_factory_, Create).Times(0);
+  EXPECT_CALL(mock_decoder_, Configure);
+  EXPECT_CALL(mock_decoder_, Decode(_, _));
+  video_receive_stream_->Start();
+  rtppacket.SetSequenceNumber(2);
+  rtppacket.SetTimestamp(3000);
+  ASSERT_TRUE(parsed_packet.Parse(rtppacket.data(), rtppacket.size()));
+  rtp_stream_receiver_controller_.OnRtpPacket(parsed_packet);
+  time_controller_.AdvanceTime(TimeDelta::Zero());
+  EXPECT_EQ(decoder_pool_->size(), 0u);
+}
+
 TEST_P(VideoReceiveStream2Test, PassesNtpTime) {
   const Timestamp kNtpTimestamp = Timestamp::Millis(12345);
   std::unique_ptr<test::FakeEncodedFrame> test_frame =
@@ -620,6 +665,24 @@ std::unique_ptr<test::FakeEncodedFrame> MakeFrame(VideoFrameType frame_type,
   return MakeFrameWithResolution(frame_type, picture_id, 320, 240);
 }
 
+TEST_P(VideoReceiveStream2Test, ReleasesIdleDecodersIntoPool) {
+  VideoDecoderPool::Config pool_config;
+  pool_config.idle_release_time = TimeDelta::Seconds(1);
+  decoder_pool_ =
+      std::make_unique<VideoDecoderPool>(pool_config, env_.clock());
+  RecreateReceiveStream();
+  video_receive_stream_->Start();
+  video_receive_stream_->OnCompleteFrame(
+      MakeFrame(VideoFrameType::kVideoFrameKey, 0));
+  EXPECT_THAT(fake_renderer_.WaitForFrame(kDefaultTimeOut), RenderedFrame());
+  EXPECT_EQ(decoder_pool_->size(), 0u);
+
+  // Without frames, the decoder is released once the frame buffer times out.
+  EXPECT_CALL(mock_decoder_, Release);
+  time_controller_.AdvanceTime(kMaxWaitForFrame);
+  EXPECT_EQ(decoder_pool_->size(), 1u);
+}
+
 TEST_P(VideoReceiveStream2Test, PassesFrameWhenEncodedFramesCallbackSet) {
   testing::MockFunction<void(const RecordableEncodedFrame&)> callback;
   video_receive_stream_->Start();
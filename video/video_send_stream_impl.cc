@@ -574,6 +574,13 @@ VideoSendStream::Stats VideoSendStreamImpl::GetStats() {
   return stats_proxy_.GetStats();
 }
 
+void VideoSendStreamImpl::VisitMemoryUsage(
+    rtc::MemoryUsageVisitor& visitor) const {
+  RTC_DCHECK_RUN_ON(&thread_checker_);
+  visitor.Add("rtpPacketHistory",
+              rtp_video_sender_->GetPacketHistoryMemoryUsageBytes());
+}
+
 absl::optional<float> VideoSendStreamImpl::GetPacingFactorOverride() const {
   return configured_pacing_factor_;
 }
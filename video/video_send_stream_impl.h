@@ -35,6 +35,7 @@
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "modules/video_coding/include/video_codec_interface.h"
 #include "rtc_base/experiments/field_trial_parser.h"
+#include "rtc_base/memory_usage.h"
 #include "rtc_base/system/no_unique_address.h"
 #include "rtc_base/task_utils/repeating_task.h"
 #include "rtc_base/thread_annotations.h"
@@ -119,6 +120,9 @@ class VideoSendStreamImpl : public webrtc::VideoSendStream,
 
   std::map<uint32_t, RtpPayloadState> GetRtpPayloadStates() const;
 
+  // Reports the memory held by the packet histories of the stream.
+  void VisitMemoryUsage(rtc::MemoryUsageVisitor& visitor) const;
+
   const absl::optional<float>& configured_pacing_factor() const {
     return configured_pacing_factor_;
   }
@@ -125,6 +125,7 @@ class MockRtpVideoSender : public RtpVideoSenderInterface {
               GetSentRtpPacketInfos,
               (uint32_t ssrc, rtc::ArrayView<const uint16_t> sequence_numbers),
               (const, override));
+  MOCK_METHOD(size_t, GetPacketHistoryMemoryUsageBytes, (), (const, override));
 
   MOCK_METHOD(void, SetFecAllowed, (bool fec_allowed), (override));
 };
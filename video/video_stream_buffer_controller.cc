@@ -13,6 +13,7 @@
 #include <algorithm>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "absl/base/attributes.h"
 #include "absl/functional/bind_front.h"
@@ -30,6 +31,7 @@
 #include "modules/video_coding/timing/jitter_estimator.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/numerics/sequence_number_util.h"
 #include "rtc_base/thread_annotations.h"
 #include "video/frame_decode_scheduler.h"
 #include "video/frame_decode_timing.h"
@@ -116,7 +118,9 @@ VideoStreamBufferController::VideoStreamBufferController(
           absl::bind_front(&VideoStreamBufferController::OnTimeout, this)),
       zero_playout_delay_max_decode_queue_size_(
           "max_decode_queue_size",
-          kZeroPlayoutDelayDefaultMaxDecodeQueueSize) {
+          kZeroPlayoutDelayDefaultMaxDecodeQueueSize),
+      ultra_low_latency_playout_enabled_(
+          field_trials.IsEnabled("WebRTC-Video-UltraLowLatencyPlayout")) {
   RTC_DCHECK(stats_proxy_);
   RTC_DCHECK(receiver_);
   RTC_DCHECK(timing_);
@@ -171,6 +175,18 @@ absl::optional<int64_t> VideoStreamBufferController::InsertFrame(
   return buffer_->LastContinuousFrameId();
 }
 
+absl::optional<int64_t> VideoStreamBufferController::InsertCachedFrames(
+    std::vector<std::unique_ptr<EncodedFrame>> frames) {
+  RTC_DCHECK_RUN_ON(&worker_sequence_checker_);
+  for (std::unique_ptr<EncodedFrame>& frame : frames) {
+    uint32_t rtp_timestamp = frame->RtpTimestamp();
+    if (buffer_->InsertFrame(std::move(frame)))
+      last_cached_rtp_timestamp_ = rtp_timestamp;
+  }
+  MaybeScheduleFrameForRelease();
+  return buffer_->LastContinuousFrameId();
+}
+
 void VideoStreamBufferController::UpdateRtt(int64_t max_rtt_ms) {
   RTC_DCHECK_RUN_ON(&worker_sequence_checker_);
   jitter_estimator_.UpdateRtt(TimeDelta::Millis(max_rtt_ms));
@@ -239,7 +255,11 @@ void VideoStreamBufferController::OnFrameReady(
     superframe_size += DataSize::Bytes(frame->size());
   }
 
-  if (!superframe_delayed_by_retransmission) {
+  if (UseUltraLowLatencyPlayout()) {
+    // Frames are decoded as soon as they are complete, so there is no jitter
+    // to absorb. Skip the estimator and keep the jitter delay at zero.
+    timing_->SetJitterDelay(TimeDelta::Zero());
+  } else if (!superframe_delayed_by_retransmission) {
     absl::optional<TimeDelta> inter_frame_delay_variation =
         ifdv_calculator_.Calculate(first_frame.RtpTimestamp(),
                                    max_receive_time);
@@ -389,6 +409,65 @@ void VideoStreamBufferController::ForceKeyFrameReleaseImmediately()
   }
 }
 
+bool VideoStreamBufferController::UseUltraLowLatencyPlayout() const {
+  return ultra_low_latency_playout_enabled_ && timing_->HasZeroPlayoutDelay();
+}
+
+void VideoStreamBufferController::ReleaseNewestFrameImmediately()
+    RTC_RUN_ON(&worker_sequence_checker_) {
+  // A frame may have been scheduled before the playout delay changed.
+  frame_decode_scheduler_->CancelOutstanding();
+
+  // Stale frames are dropped instead of being queued in front of the decoder.
+  auto decodable_tu_info = buffer_->DecodableTemporalUnitsInfo();
+  while (decodable_tu_info && decodable_tu_info->next_rtp_timestamp !=
+                                  decodable_tu_info->last_rtp_timestamp) {
+    buffer_->DropNextDecodableTemporalUnit();
+    decodable_tu_info = buffer_->DecodableTemporalUnitsInfo();
+  }
+  if (!decodable_tu_info) {
+    return;
+  }
+
+  auto frames = buffer_->ExtractNextDecodableTemporalUnit();
+  if (frames.empty()) {
+    RTC_DCHECK_NOTREACHED()
+        << "Frame buffer should always return at least 1 frame.";
+    return;
+  }
+  // Zero render time means render immediately.
+  OnFrameReady(std::move(frames), Timestamp::Zero());
+}
+
+bool VideoStreamBufferController::ReleaseCachedFrameImmediately()
+    RTC_RUN_ON(&worker_sequence_checker_) {
+  if (!last_cached_rtp_timestamp_) {
+    return false;
+  }
+  auto decodable_tu_info = buffer_->DecodableTemporalUnitsInfo();
+  if (!decodable_tu_info ||
+      AheadOf(decodable_tu_info->next_rtp_timestamp,
+              *last_cached_rtp_timestamp_)) {
+    last_cached_rtp_timestamp_.reset();
+    return false;
+  }
+  // Cached frames are late by the time they are inserted. Decode them back to
+  // back, since dropping one would make the frames that follow undecodable.
+  frame_decode_scheduler_->CancelOutstanding();
+  auto frames = buffer_->ExtractNextDecodableTemporalUnit();
+  if (frames.empty()) {
+    RTC_DCHECK_NOTREACHED()
+        << "Frame buffer should always return at least 1 frame.";
+    return false;
+  }
+  if (decodable_tu_info->next_rtp_timestamp == *last_cached_rtp_timestamp_) {
+    last_cached_rtp_timestamp_.reset();
+  }
+  // Zero render time means render immediately.
+  OnFrameReady(std::move(frames), Timestamp::Zero());
+  return true;
+}
+
 void VideoStreamBufferController::MaybeScheduleFrameForRelease()
     RTC_RUN_ON(&worker_sequence_checker_) {
   auto decodable_tu_info = buffer_->DecodableTemporalUnitsInfo();
@@ -400,6 +479,14 @@ void VideoStreamBufferController::MaybeScheduleFrameForRelease()
     return ForceKeyFrameReleaseImmediately();
   }
 
+  if (ReleaseCachedFrameImmediately()) {
+    return;
+  }
+
+  if (UseUltraLowLatencyPlayout()) {
+    return ReleaseNewestFrameImmediately();
+  }
+
   // If already scheduled then abort.
   if (frame_decode_scheduler_->ScheduledRtpTimestamp() ==
       decodable_tu_info->next_rtp_timestamp) {
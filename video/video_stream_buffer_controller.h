@@ -12,6 +12,7 @@
 #define VIDEO_VIDEO_STREAM_BUFFER_CONTROLLER_H_
 
 #include <memory>
+#include <vector>
 
 #include "api/field_trials_view.h"
 #include "api/task_queue/task_queue_base.h"
@@ -82,6 +83,12 @@ class VideoStreamBufferController {
   void SetProtectionMode(VCMVideoProtection protection_mode);
   void Clear();
   absl::optional<int64_t> InsertFrame(std::unique_ptr<EncodedFrame> frame);
+  // Inserts frames that were received while the stream was not decoding, in
+  // decode order, see KeyframeCache. They are released for decoding and
+  // rendering as soon as possible, without updating the timestamp
+  // extrapolation. Returns the last continuous frame id.
+  absl::optional<int64_t> InsertCachedFrames(
+      std::vector<std::unique_ptr<EncodedFrame>> frames);
   void UpdateRtt(int64_t max_rtt_ms);
   void SetMaxWaits(TimeDelta max_wait_for_keyframe,
                    TimeDelta max_wait_for_frame);
@@ -99,6 +106,9 @@ class VideoStreamBufferController {
   void UpdateTimingFrameInfo();
   bool IsTooManyFramesQueued() const RTC_RUN_ON(&worker_sequence_checker_);
   void ForceKeyFrameReleaseImmediately() RTC_RUN_ON(&worker_sequence_checker_);
+  bool UseUltraLowLatencyPlayout() const;
+  void ReleaseNewestFrameImmediately() RTC_RUN_ON(&worker_sequence_checker_);
+  bool ReleaseCachedFrameImmediately() RTC_RUN_ON(&worker_sequence_checker_);
   void MaybeScheduleFrameForRelease() RTC_RUN_ON(&worker_sequence_checker_);
 
   RTC_NO_UNIQUE_ADDRESS SequenceChecker worker_sequence_checker_;
@@ -125,6 +135,10 @@ class VideoStreamBufferController {
       RTC_GUARDED_BY(&worker_sequence_checker_) = 0;
   VCMVideoProtection protection_mode_
       RTC_GUARDED_BY(&worker_sequence_checker_) = kProtectionNack;
+  // RTP timestamp of the last frame given to InsertCachedFrames(), set until
+  // that frame has been released.
+  absl::optional<uint32_t> last_cached_rtp_timestamp_
+      RTC_GUARDED_BY(&worker_sequence_checker_);
 
   // This flag guards frames from queuing in front of the decoder. Without this
   // guard, encoded frames will not wait for the decoder to finish decoding a
@@ -140,6 +154,12 @@ class VideoStreamBufferController {
   // the frame's render time == 0.
   FieldTrialParameter<unsigned> zero_playout_delay_max_decode_queue_size_;
 
+  // Set by the field trial WebRTC-Video-UltraLowLatencyPlayout. When enabled
+  // and both min and max playout delay are zero, the newest decodable frame is
+  // handed to the decoder as soon as it is complete, without going through
+  // `frame_decode_scheduler_`, and older decodable frames are dropped.
+  const bool ultra_low_latency_playout_enabled_;
+
   ScopedTaskSafety worker_safety_;
 };
 
@@ -454,6 +454,44 @@ TEST_P(VideoStreamBufferControllerTest, FramesFastForwardOnSystemHalt) {
   EXPECT_EQ(dropped_frames(), 1);
 }
 
+TEST_P(VideoStreamBufferControllerTest, CachedFramesAreDecodedBackToBack) {
+  StartNextDecodeForceKeyframe();
+  // F0 <-- F1 <-- F2, received before the stream was started.
+  std::vector<std::unique_ptr<EncodedFrame>> frames;
+  frames.push_back(test::FakeFrameBuilder().Id(0).Time(0).AsLast().Build());
+  frames.push_back(test::FakeFrameBuilder()
+                       .Id(1)
+                       .Time(kFps30Rtp)
+                       .AsLast()
+                       .Refs({0})
+                       .Build());
+  frames.push_back(test::FakeFrameBuilder()
+                       .Id(2)
+                       .Time(2 * kFps30Rtp)
+                       .AsLast()
+                       .Refs({1})
+                       .Build());
+  time_controller_.AdvanceTime(kFps30Delay * 10);
+  EXPECT_EQ(buffer_->InsertCachedFrames(std::move(frames)), 2);
+
+  EXPECT_THAT(WaitForFrameOrTimeout(TimeDelta::Zero()), Frame(test::WithId(0)));
+  StartNextDecode();
+  EXPECT_THAT(WaitForFrameOrTimeout(TimeDelta::Zero()), Frame(test::WithId(1)));
+  StartNextDecode();
+  EXPECT_THAT(WaitForFrameOrTimeout(TimeDelta::Zero()), Frame(test::WithId(2)));
+  EXPECT_EQ(dropped_frames(), 0);
+
+  // Frames inserted afterwards are scheduled as usual.
+  StartNextDecode();
+  buffer_->InsertFrame(test::FakeFrameBuilder()
+                           .Id(3)
+                           .Time(3 * kFps30Rtp)
+                           .AsLast()
+                           .Refs({2})
+                           .Build());
+  EXPECT_THAT(WaitForFrameOrTimeout(kFps30Delay), Frame(test::WithId(3)));
+}
+
 TEST_P(VideoStreamBufferControllerTest, ForceKeyFrame) {
   StartNextDecodeForceKeyframe();
   // Initial keyframe.
@@ -922,6 +960,110 @@ INSTANTIATE_TEST_SUITE_P(
             "WebRTC-ZeroPlayoutDelay/"
             "min_pacing:16ms,max_decode_queue_size:5/")));
 
+class UltraLowLatencyVideoStreamBufferControllerTest
+    : public ::testing::Test,
+      public VideoStreamBufferControllerFixture {
+ protected:
+  void SetZeroPlayoutDelay() {
+    timing_.set_min_playout_delay(TimeDelta::Zero());
+    timing_.set_max_playout_delay(TimeDelta::Zero());
+  }
+};
+
+TEST_P(UltraLowLatencyVideoStreamBufferControllerTest,
+       FramesReleasedAsSoonAsComplete) {
+  SetZeroPlayoutDelay();
+  StartNextDecodeForceKeyframe();
+  buffer_->InsertFrame(test::FakeFrameBuilder()
+                           .Id(0)
+                           .Time(0)
+                           .PlayoutDelay(VideoPlayoutDelay::Minimal())
+                           .AsLast()
+                           .Build());
+  auto result = WaitForFrameOrTimeout(TimeDelta::Zero());
+  EXPECT_THAT(result, Frame(test::WithId(0)));
+
+  StartNextDecode();
+  buffer_->InsertFrame(test::FakeFrameBuilder()
+                           .Id(1)
+                           .Time(kFps30Rtp)
+                           .Refs({0})
+                           .PlayoutDelay(VideoPlayoutDelay::Minimal())
+                           .AsLast()
+                           .Build());
+  result = WaitForFrameOrTimeout(TimeDelta::Zero());
+  ASSERT_THAT(result, Frame(test::WithId(1)));
+  EXPECT_EQ(absl::get<std::unique_ptr<EncodedFrame>>(*result)->RenderTimeMs(),
+            0);
+  EXPECT_EQ(timing_.GetTimings().minimum_delay, TimeDelta::Zero());
+}
+
+TEST_P(UltraLowLatencyVideoStreamBufferControllerTest,
+       StaleFramesDroppedWhileDecoderBusy) {
+  SetZeroPlayoutDelay();
+  StartNextDecodeForceKeyframe();
+  buffer_->InsertFrame(test::FakeFrameBuilder()
+                           .Id(0)
+                           .Time(0)
+                           .PlayoutDelay(VideoPlayoutDelay::Minimal())
+                           .AsLast()
+                           .Build());
+  EXPECT_THAT(WaitForFrameOrTimeout(TimeDelta::Zero()), Frame(test::WithId(0)));
+
+  // The decoder is busy while three more frames complete.
+  for (int id = 1; id <= 3; ++id) {
+    buffer_->InsertFrame(test::FakeFrameBuilder()
+                             .Id(id)
+                             .Time(kFps30Rtp * id)
+                             .Refs({0})
+                             .PlayoutDelay(VideoPlayoutDelay::Minimal())
+                             .AsLast()
+                             .Build());
+  }
+
+  // Only the newest one is decoded.
+  StartNextDecode();
+  EXPECT_THAT(WaitForFrameOrTimeout(TimeDelta::Zero()), Frame(test::WithId(3)));
+  EXPECT_EQ(dropped_frames(), 2);
+}
+
+TEST_P(UltraLowLatencyVideoStreamBufferControllerTest,
+       NonZeroMaxPlayoutDelayKeepsPacing) {
+  const VideoPlayoutDelay kPacedPlayoutDelay(TimeDelta::Zero(),
+                                             TimeDelta::Millis(10));
+  timing_.set_min_playout_delay(TimeDelta::Zero());
+  timing_.set_max_playout_delay(TimeDelta::Millis(10));
+  StartNextDecodeForceKeyframe();
+  buffer_->InsertFrame(test::FakeFrameBuilder()
+                           .Id(0)
+                           .Time(0)
+                           .PlayoutDelay(kPacedPlayoutDelay)
+                           .AsLast()
+                           .Build());
+  EXPECT_THAT(WaitForFrameOrTimeout(TimeDelta::Zero()), Frame(test::WithId(0)));
+
+  StartNextDecode();
+  buffer_->InsertFrame(test::FakeFrameBuilder()
+                           .Id(1)
+                           .Time(kFps30Rtp)
+                           .Refs({0})
+                           .PlayoutDelay(kPacedPlayoutDelay)
+                           .AsLast()
+                           .Build());
+  // Pacing is set to 16ms in the field trial so we should not decode yet.
+  EXPECT_THAT(WaitForFrameOrTimeout(TimeDelta::Zero()), Eq(absl::nullopt));
+  time_controller_.AdvanceTime(TimeDelta::Millis(16));
+  EXPECT_THAT(WaitForFrameOrTimeout(TimeDelta::Zero()), Frame(test::WithId(1)));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    VideoStreamBufferController,
+    UltraLowLatencyVideoStreamBufferControllerTest,
+    ::testing::Combine(::testing::Bool(),
+                       ::testing::Values(
+                           "WebRTC-Video-UltraLowLatencyPlayout/Enabled/"
+                           "WebRTC-ZeroPlayoutDelay/min_pacing:16ms/")));
+
 class IncomingTimestampVideoStreamBufferControllerTest
     : public ::testing::Test,
       public VideoStreamBufferControllerFixture {};
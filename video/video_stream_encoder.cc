@@ -16,6 +16,7 @@
 #include <memory>
 #include <numeric>
 #include <utility>
+#include <vector>
 
 #include "absl/algorithm/container.h"
 #include "absl/cleanup/cleanup.h"
@@ -42,13 +43,17 @@
 #include "modules/video_coding/utility/vp8_constants.h"
 #include "rtc_base/arraysize.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/cpu_time.h"
 #include "rtc_base/event.h"
 #include "rtc_base/experiments/encoder_info_settings.h"
+#include "rtc_base/experiments/field_trial_list.h"
+#include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/experiments/rate_control_settings.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/strings/string_builder.h"
 #include "rtc_base/system/no_unique_address.h"
 #include "rtc_base/thread_annotations.h"
+#include "rtc_base/time_utils.h"
 #include "rtc_base/trace_event.h"
 #include "system_wrappers/include/metrics.h"
 #include "video/adaptation/video_stream_encoder_resource_manager.h"
@@ -56,6 +61,7 @@
 #include "video/config/encoder_stream_factory.h"
 #include "video/frame_cadence_adapter.h"
 #include "video/frame_dumping_encoder.h"
+#include "video/shared_video_encoder_pool.h"
 
 namespace webrtc {
 
@@ -202,6 +208,27 @@ bool RequiresEncoderReset(const VideoCodec& prev_send_codec,
   return false;
 }
 
+// Returns true if `new_send_codec` requires an encoder reset only because
+// simulcast streams were activated or deactivated, which encoders may apply
+// with VideoEncoder::UpdateActiveStreams().
+bool OnlyActiveStreamsChanged(
+    const VideoCodec& prev_send_codec,
+    const VideoCodec& new_send_codec,
+    bool was_encode_called_since_last_initialization) {
+  if (new_send_codec.numberOfSimulcastStreams < 2 ||
+      new_send_codec.numberOfSimulcastStreams !=
+          prev_send_codec.numberOfSimulcastStreams) {
+    return false;
+  }
+  VideoCodec prev_with_new_active_streams = prev_send_codec;
+  for (int i = 0; i < new_send_codec.numberOfSimulcastStreams; ++i) {
+    prev_with_new_active_streams.simulcastStream[i].active =
+        new_send_codec.simulcastStream[i].active;
+  }
+  return !RequiresEncoderReset(prev_with_new_active_streams, new_send_codec,
+                               was_encode_called_since_last_initialization);
+}
+
 // Limit allocation across TLs in bitrate allocation according to number of TLs
 // in EncoderInfo.
 VideoBitrateAllocation UpdateAllocationFromEncoderInfo(
@@ -542,6 +569,40 @@ absl::optional<int> ParseEncoderThreadLimit(const FieldTrialsView& trials) {
   return encoder_thread_limit.GetOptional();
 }
 
+// Parses e.g. "threads:4,row_mt:false,speed_min_pixels:0|230400,speed:8|9".
+VideoEncoder::Settings::ThreadingPolicy ParseEncoderThreadingPolicy(
+    const FieldTrialsView& trials) {
+  FieldTrialOptional<int> threads("threads");
+  FieldTrialOptional<int> log2_tile_columns("log2_tile_columns");
+  FieldTrialOptional<bool> row_mt("row_mt");
+  FieldTrialList<int> speed_min_pixels("speed_min_pixels");
+  FieldTrialList<int> speed("speed");
+  ParseFieldTrial(
+      {&threads, &log2_tile_columns, &row_mt, &speed_min_pixels, &speed},
+      trials.Lookup("WebRTC-VideoEncoderSettings"));
+
+  VideoEncoder::Settings::ThreadingPolicy policy;
+  if (threads && *threads >= 1) {
+    policy.num_threads = threads.GetOptional();
+  }
+  if (log2_tile_columns && *log2_tile_columns >= 0) {
+    policy.log2_tile_columns = log2_tile_columns.GetOptional();
+  }
+  policy.row_mt = row_mt.GetOptional();
+  if (speed_min_pixels.Get().size() != speed.Get().size()) {
+    RTC_LOG(LS_WARNING) << "Ignoring encoder speed settings with "
+                        << speed_min_pixels.Get().size()
+                        << " resolutions and " << speed.Get().size()
+                        << " speeds.";
+    return policy;
+  }
+  for (size_t i = 0; i < speed.Get().size(); ++i) {
+    policy.speed_by_resolution.push_back({speed_min_pixels.Get()[i],
+                                          speed.Get()[i]});
+  }
+  return policy;
+}
+
 absl::optional<VideoSourceRestrictions> MergeRestrictions(
     const std::vector<absl::optional<VideoSourceRestrictions>>& list) {
   absl::optional<VideoSourceRestrictions> return_value;
@@ -558,6 +619,28 @@ absl::optional<VideoSourceRestrictions> MergeRestrictions(
   return return_value;
 }
 
+// Maps a native `buffer` the encoder can't take to one of the pixel formats
+// the encoder prefers, so that cropping and scaling it doesn't convert it to
+// I420 only to have the encoder convert it back. Returns `buffer` if it isn't
+// native or can't be mapped.
+rtc::scoped_refptr<VideoFrameBuffer> MapToPreferredPixelFormat(
+    rtc::scoped_refptr<VideoFrameBuffer> buffer,
+    const VideoEncoder::EncoderInfo& info) {
+  if (buffer->type() != VideoFrameBuffer::Type::kNative ||
+      info.supports_native_handle || info.preferred_pixel_formats.empty()) {
+    return buffer;
+  }
+  absl::InlinedVector<VideoFrameBuffer::Type, kMaxPreferredPixelFormats>
+      preferred_formats = info.preferred_pixel_formats;
+  rtc::scoped_refptr<VideoFrameBuffer> mapped_buffer =
+      buffer->GetMappedFrameBuffer(preferred_formats);
+  if (!mapped_buffer ||
+      !absl::c_linear_search(preferred_formats, mapped_buffer->type())) {
+    return buffer;
+  }
+  return mapped_buffer;
+}
+
 }  //  namespace
 
 VideoStreamEncoder::EncoderRateSettings::EncoderRateSettings()
@@ -706,6 +789,10 @@ VideoStreamEncoder::VideoStreamEncoder(
       vp9_low_tier_core_threshold_(
           ParseVp9LowTierCoreCountThreshold(field_trials)),
       experimental_encoder_thread_limit_(ParseEncoderThreadLimit(field_trials)),
+      experimental_threading_policy_(
+          ParseEncoderThreadingPolicy(field_trials)),
+      cpu_time_accounting_enabled_(
+          field_trials.IsEnabled("WebRTC-PerStreamCpuTime")),
       encoder_queue_(std::move(encoder_queue)) {
   TRACE_EVENT0("webrtc", "VideoStreamEncoder::VideoStreamEncoder");
   RTC_DCHECK_RUN_ON(worker_queue_);
@@ -841,8 +928,17 @@ void VideoStreamEncoder::SetSource(
   input_state_provider_.OnHasInputChanged(source);
 
   // This may trigger reconfiguring the QualityScaler on the encoder queue.
-  encoder_queue_->PostTask([this, degradation_preference] {
+  encoder_queue_->PostTask([this, source, degradation_preference] {
     RTC_DCHECK_RUN_ON(encoder_queue_.get());
+    if (settings_.share_encoder && source != shared_encoder_source_) {
+      // The encoder is shared with the streams of the new source from the next
+      // frame on.
+      shared_encoder_source_ = source;
+      if (encoder_) {
+        pending_encoder_creation_ = true;
+        pending_encoder_reconfiguration_ = true;
+      }
+    }
     degradation_preference_manager_->SetDegradationPreference(
         degradation_preference);
     stream_resource_manager_.SetDegradationPreferences(degradation_preference);
@@ -914,6 +1010,7 @@ void VideoStreamEncoder::ConfigureEncoder(VideoEncoderConfig config,
     encoder_config_ = std::move(config);
     max_data_payload_length_ = max_data_payload_length;
     pending_encoder_reconfiguration_ = true;
+    UpdateFrameDropHints();
 
     // Reconfigure the encoder now if the frame resolution is known.
     // Otherwise, the reconfiguration is deferred until the next frame to
@@ -946,8 +1043,12 @@ void VideoStreamEncoder::ReconfigureEncoder() {
     encoder_.reset();
 
     encoder_ = MaybeCreateFrameDumpingEncoderWrapper(
-        settings_.encoder_factory->CreateVideoEncoder(
-            encoder_config_.video_format),
+        settings_.share_encoder
+            ? SharedVideoEncoderPool::Default().CreateEncoder(
+                  settings_.encoder_factory, encoder_config_.video_format,
+                  shared_encoder_source_)
+            : settings_.encoder_factory->CreateVideoEncoder(
+                  encoder_config_.video_format),
         field_trials_);
     if (!encoder_) {
       RTC_LOG(LS_ERROR) << "CreateVideoEncoder failed, failing encoder format: "
@@ -1261,16 +1362,32 @@ void VideoStreamEncoder::ReconfigureEncoder() {
   rate_allocator_->SetLegacyConferenceMode(
       encoder_config_.legacy_conference_mode);
 
+  if (codec.codecType == VideoCodecType::kVideoCodecVP9 &&
+      number_of_cores_ <= vp9_low_tier_core_threshold_.value_or(0)) {
+    codec.SetVideoEncoderComplexity(VideoCodecComplexity::kComplexityLow);
+  }
+
   // Reset (release existing encoder) if one exists and anything except
   // start bitrate or max framerate has changed.
   if (!encoder_reset_required) {
     encoder_reset_required = RequiresEncoderReset(
         send_codec_, codec, was_encode_called_since_last_initialization_);
-  }
-
-  if (codec.codecType == VideoCodecType::kVideoCodecVP9 &&
-      number_of_cores_ <= vp9_low_tier_core_threshold_.value_or(0)) {
-    codec.SetVideoEncoderComplexity(VideoCodecComplexity::kComplexityLow);
+    // Activating or deactivating simulcast streams doesn't need a reset if the
+    // encoder can apply it on the fly, so that the streams that stay active
+    // don't have to restart with key frames.
+    if (encoder_reset_required && encoder_initialized_ &&
+        OnlyActiveStreamsChanged(
+            send_codec_, codec, was_encode_called_since_last_initialization_) &&
+        encoder_->UpdateActiveStreams(codec)) {
+      encoder_reset_required = false;
+      for (int i = 0; i < codec.numberOfSimulcastStreams; ++i) {
+        if (codec.simulcastStream[i].active &&
+            !send_codec_.simulcastStream[i].active) {
+          next_frame_types_[i] = VideoFrameType::kVideoFrameKey;
+        }
+      }
+      frame_encode_metadata_writer_.OnEncoderInit(codec);
+    }
   }
 
   send_codec_ = codec;
@@ -1287,6 +1404,7 @@ void VideoStreamEncoder::ReconfigureEncoder() {
     VideoEncoder::Settings settings = VideoEncoder::Settings(
         settings_.capabilities, number_of_cores_, max_data_payload_length);
     settings.encoder_thread_limit = experimental_encoder_thread_limit_;
+    settings.threading_policy = experimental_threading_policy_;
     int error = encoder_->InitEncode(&send_codec_, settings);
     if (error != 0) {
       RTC_LOG(LS_ERROR) << "Failed to initialize the encoder associated with "
@@ -1542,6 +1660,15 @@ void VideoStreamEncoder::OnFrame(Timestamp post_time,
 
   last_captured_timestamp_ = incoming_frame.ntp_time_ms();
 
+  if (rejected_frame_timestamp_us_ == video_frame.timestamp_us()) {
+    // WantsFrame() rejected the frame, but it was delivered for other sinks.
+    rejected_frame_timestamp_us_.reset();
+    ProcessDroppedFrame(incoming_frame,
+                        VideoStreamEncoderObserver::DropReason::kEncoderQueue);
+    return;
+  }
+  rejected_frame_timestamp_us_.reset();
+
   encoder_stats_observer_->OnIncomingFrame(incoming_frame.width(),
                                            incoming_frame.height());
   ++captured_frame_count_;
@@ -1549,6 +1676,7 @@ void VideoStreamEncoder::OnFrame(Timestamp post_time,
   bool cwnd_frame_drop =
       cwnd_frame_drop_interval_ &&
       (cwnd_frame_counter_++ % cwnd_frame_drop_interval_.value() == 0);
+  UpdateFrameDropHints();
   if (!queue_overload && !cwnd_frame_drop) {
     MaybeEncodeVideoFrame(incoming_frame, post_time.us());
   } else {
@@ -1586,6 +1714,39 @@ void VideoStreamEncoder::OnDiscardedFrame() {
       VideoStreamEncoderObserver::DropReason::kSource);
 }
 
+bool VideoStreamEncoder::WantsFrame(int64_t timestamp_us) {
+  // Called on the frame delivery thread. The congestion window hint applies
+  // to one frame only.
+  const bool drop_for_cwnd = drop_next_frame_for_cwnd_.exchange(false);
+  if (!drop_for_cwnd && !drop_frames_while_paused_.load()) {
+    return true;
+  }
+  encoder_queue_->PostTask([this, timestamp_us, drop_for_cwnd] {
+    RTC_DCHECK_RUN_ON(encoder_queue_.get());
+    rejected_frame_timestamp_us_ = timestamp_us;
+    if (drop_for_cwnd) {
+      ++cwnd_frame_counter_;
+      ++dropped_frame_cwnd_pushback_count_;
+    } else {
+      TraceFrameDropStart();
+    }
+    UpdateFrameDropHints();
+  });
+  return false;
+}
+
+void VideoStreamEncoder::UpdateFrameDropHints() {
+  // Screen content may not be followed by another frame for a long time, so
+  // it is always delivered and dropped, or kept as the pending frame, here.
+  const bool realtime = encoder_config_.content_type ==
+                        VideoEncoderConfig::ContentType::kRealtimeVideo;
+  drop_frames_while_paused_.store(realtime && last_encoder_rate_settings_ &&
+                                  EncoderPaused());
+  drop_next_frame_for_cwnd_.store(
+      realtime && cwnd_frame_drop_interval_ &&
+      cwnd_frame_counter_ % cwnd_frame_drop_interval_.value() == 0);
+}
+
 bool VideoStreamEncoder::EncoderPaused() const {
   RTC_DCHECK_RUN_ON(encoder_queue_.get());
   // Pause video if paused by caller or as long as the network is down or the
@@ -1940,24 +2101,35 @@ void VideoStreamEncoder::EncodeVideoFrame(const VideoFrame& video_frame,
        !info.supports_native_handle)) {
     int cropped_width = video_frame.width() - crop_width_;
     int cropped_height = video_frame.height() - crop_height_;
+    rtc::scoped_refptr<VideoFrameBuffer> buffer =
+        MapToPreferredPixelFormat(video_frame.video_frame_buffer(), info);
     rtc::scoped_refptr<VideoFrameBuffer> cropped_buffer;
     // TODO(ilnik): Remove scaling if cropping is too big, as it should never
     // happen after SinkWants signaled correctly from ReconfigureEncoder.
     VideoFrame::UpdateRect update_rect = video_frame.update_rect();
+    std::vector<VideoFrame::UpdateRect> update_region;
     if (crop_width_ < 4 && crop_height_ < 4) {
       // The difference is small, crop without scaling.
-      cropped_buffer = video_frame.video_frame_buffer()->CropAndScale(
+      cropped_buffer = buffer->CropAndScale(
           crop_width_ / 2, crop_height_ / 2, cropped_width, cropped_height,
           cropped_width, cropped_height);
       update_rect.offset_x -= crop_width_ / 2;
       update_rect.offset_y -= crop_height_ / 2;
       update_rect.Intersect(
           VideoFrame::UpdateRect{0, 0, cropped_width, cropped_height});
+      for (VideoFrame::UpdateRect rect : video_frame.update_region()) {
+        rect.offset_x -= crop_width_ / 2;
+        rect.offset_y -= crop_height_ / 2;
+        rect.Intersect(
+            VideoFrame::UpdateRect{0, 0, cropped_width, cropped_height});
+        if (!rect.IsEmpty()) {
+          update_region.push_back(rect);
+        }
+      }
 
     } else {
       // The difference is large, scale it.
-      cropped_buffer = video_frame.video_frame_buffer()->Scale(cropped_width,
-                                                               cropped_height);
+      cropped_buffer = buffer->Scale(cropped_width, cropped_height);
       if (!update_rect.IsEmpty()) {
         // Since we can't reason about pixels after scaling, we invalidate whole
         // picture, if anything changed.
@@ -1972,6 +2144,9 @@ void VideoStreamEncoder::EncodeVideoFrame(const VideoFrame& video_frame,
 
     out_frame.set_video_frame_buffer(cropped_buffer);
     out_frame.set_update_rect(update_rect);
+    if (!update_region.empty()) {
+      out_frame.set_update_region(std::move(update_region));
+    }
     out_frame.set_ntp_time_ms(video_frame.ntp_time_ms());
     out_frame.set_capture_time_identifier(
         video_frame.capture_time_identifier());
@@ -2014,8 +2189,34 @@ void VideoStreamEncoder::EncodeVideoFrame(const VideoFrame& video_frame,
 
   frame_encode_metadata_writer_.OnEncodeStarted(out_frame);
 
+  const bool measure_cpu_time = cpu_time_accounting_enabled_ ||
+                                stream_resource_manager_.UsesThreadCpuTime();
+  const int64_t encode_start_cpu_time_ns =
+      measure_cpu_time ? rtc::GetThreadCpuTimeNanos() : 0;
   const int32_t encode_status = encoder_->Encode(out_frame, &next_frame_types_);
   was_encode_called_since_last_initialization_ = true;
+  if (measure_cpu_time) {
+    const TimeDelta encode_cpu_time = TimeDelta::Micros(
+        (rtc::GetThreadCpuTimeNanos() - encode_start_cpu_time_ns) /
+        rtc::kNumNanosecsPerMicrosec);
+    if (cpu_time_accounting_enabled_) {
+      encoder_stats_observer_->OnEncodeCpuTimeMeasured(encode_cpu_time);
+    }
+    if (stream_resource_manager_.UsesThreadCpuTime() && encode_status >= 0) {
+      // Add the time spent on the encoder's own worker threads and spread
+      // the total over all threads, so that the usage stays comparable to
+      // that of a single threaded encoder.
+      TimeDelta total_cpu_time = encode_cpu_time;
+      const VideoEncoder::EncoderInfo info_after = encoder_->GetEncoderInfo();
+      if (info.worker_thread_cpu_time && info_after.worker_thread_cpu_time) {
+        total_cpu_time = (total_cpu_time + *info_after.worker_thread_cpu_time -
+                          *info.worker_thread_cpu_time) /
+                         std::max(1, info_after.num_threads);
+      }
+      stream_resource_manager_.OnEncodeCpuTimeMeasured(out_frame,
+                                                       total_cpu_time);
+    }
+  }
 
   if (encode_status < 0) {
     RTC_LOG(LS_ERROR) << "Encoder failed, failing encoder format: "
@@ -2324,6 +2525,7 @@ void VideoStreamEncoder::OnBitrateUpdated(DataRate target_bitrate,
       RequestRefreshFrame();
     }
   }
+  UpdateFrameDropHints();
 }
 
 bool VideoStreamEncoder::DropDueToSize(uint32_t source_pixel_count) const {
@@ -168,6 +168,9 @@ class VideoStreamEncoder : public VideoStreamEncoderInterface,
     void OnDiscardedFrame() override {
       video_stream_encoder_.OnDiscardedFrame();
     }
+    bool WantsFrame(int64_t timestamp_us) override {
+      return video_stream_encoder_.WantsFrame(timestamp_us);
+    }
     void RequestRefreshFrame() override {
       video_stream_encoder_.RequestRefreshFrame();
     }
@@ -215,7 +218,10 @@ class VideoStreamEncoder : public VideoStreamEncoderInterface,
                bool queue_overload,
                const VideoFrame& video_frame);
   void OnDiscardedFrame();
+  bool WantsFrame(int64_t timestamp_us);
   void RequestRefreshFrame();
+  // Publishes whether the next frames will be dropped, for WantsFrame().
+  void UpdateFrameDropHints() RTC_RUN_ON(encoder_queue_);
 
   void MaybeEncodeVideoFrame(const VideoFrame& frame,
                              int64_t time_when_posted_in_ms);
@@ -311,6 +317,8 @@ class VideoStreamEncoder : public VideoStreamEncoderInterface,
   // Set when configuration must create a new encoder object, e.g.,
   // because of a codec change.
   bool pending_encoder_creation_ RTC_GUARDED_BY(encoder_queue_) = false;
+  // Source the encoder is shared for, when `settings_.share_encoder` is set.
+  const void* shared_encoder_source_ RTC_GUARDED_BY(encoder_queue_) = nullptr;
   absl::InlinedVector<SetParametersCallback, 2> encoder_configuration_callbacks_
       RTC_GUARDED_BY(encoder_queue_);
 
@@ -392,6 +400,17 @@ class VideoStreamEncoder : public VideoStreamEncoderInterface,
   // Frame counter for congestion window frame drop.
   int cwnd_frame_counter_ RTC_GUARDED_BY(encoder_queue_) = 0;
 
+  // Set on the encoder queue and read on the frame delivery thread, letting
+  // the source skip producing frames that would be dropped: all frames while
+  // the encoder is paused, and the next frame if it is to be dropped by the
+  // congestion window pushback.
+  std::atomic<bool> drop_frames_while_paused_{false};
+  std::atomic<bool> drop_next_frame_for_cwnd_{false};
+  // Capture time of the last frame WantsFrame() rejected, to drop it should
+  // it be delivered anyway.
+  absl::optional<int64_t> rejected_frame_timestamp_us_
+      RTC_GUARDED_BY(encoder_queue_);
+
   std::unique_ptr<EncoderBitrateAdjuster> bitrate_adjuster_
       RTC_GUARDED_BY(encoder_queue_);
 
@@ -466,6 +485,11 @@ class VideoStreamEncoder : public VideoStreamEncoderInterface,
 
   const absl::optional<int> vp9_low_tier_core_threshold_;
   const absl::optional<int> experimental_encoder_thread_limit_;
+  const VideoEncoder::Settings::ThreadingPolicy experimental_threading_policy_;
+
+  // Measures the thread CPU time of every Encode() call and reports it to
+  // `encoder_stats_observer_`.
+  const bool cpu_time_accounting_enabled_;
 
   // These are copies of restrictions (glorified max_pixel_count) set by
   // a) OnVideoSourceRestrictionsUpdated
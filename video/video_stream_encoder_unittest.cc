@@ -1057,6 +1057,7 @@ class VideoStreamEncoderTest : public ::testing::Test {
               kQpLow, kQpHigh, kMinPixelsPerFrame);
         }
         info.is_hardware_accelerated = is_hardware_accelerated_;
+        info.num_threads = num_threads_;
         for (int i = 0; i < kMaxSpatialLayers; ++i) {
           if (temporal_layers_supported_[i]) {
             info.fps_allocation[i].clear();
@@ -1115,6 +1116,11 @@ class VideoStreamEncoderTest : public ::testing::Test {
       is_hardware_accelerated_ = is_hardware_accelerated;
     }
 
+    void SetNumThreads(int num_threads) {
+      MutexLock lock(&local_mutex_);
+      num_threads_ = num_threads;
+    }
+
     void SetTemporalLayersSupported(size_t spatial_idx, bool supported) {
       RTC_DCHECK_LT(spatial_idx, kMaxSpatialLayers);
       MutexLock lock(&local_mutex_);
@@ -1224,6 +1230,11 @@ class VideoStreamEncoderTest : public ::testing::Test {
       return last_encoder_complexity_;
     }
 
+    Settings::ThreadingPolicy LastThreadingPolicy() {
+      MutexLock lock(&local_mutex_);
+      return last_threading_policy_;
+    }
+
    private:
     int32_t Encode(const VideoFrame& input_image,
                    const std::vector<VideoFrameType>* frame_types) override {
@@ -1283,6 +1294,7 @@ class VideoStreamEncoderTest : public ::testing::Test {
       }
 
       last_encoder_complexity_ = config->GetVideoEncoderComplexity();
+      last_threading_policy_ = settings.threading_policy;
 
       if (force_init_encode_failed_) {
         initialized_ = EncoderState::kInitializationFailed;
@@ -1338,6 +1350,7 @@ class VideoStreamEncoderTest : public ::testing::Test {
     bool apply_alignment_to_all_simulcast_layers_ RTC_GUARDED_BY(local_mutex_) =
         false;
     bool is_hardware_accelerated_ RTC_GUARDED_BY(local_mutex_) = false;
+    int num_threads_ RTC_GUARDED_BY(local_mutex_) = 1;
     rtc::scoped_refptr<EncodedImageBufferInterface> encoded_image_data_
         RTC_GUARDED_BY(local_mutex_);
     std::unique_ptr<Vp8FrameBufferController> frame_buffer_controller_
@@ -1367,6 +1380,8 @@ class VideoStreamEncoderTest : public ::testing::Test {
     absl::optional<bool> is_qp_trusted_ RTC_GUARDED_BY(local_mutex_);
     VideoCodecComplexity last_encoder_complexity_ RTC_GUARDED_BY(local_mutex_){
         VideoCodecComplexity::kComplexityNormal};
+    Settings::ThreadingPolicy last_threading_policy_
+        RTC_GUARDED_BY(local_mutex_);
   };
 
   class TestSink : public VideoStreamEncoder::EncoderSink {
@@ -1778,6 +1793,33 @@ TEST_F(VideoStreamEncoderTest,
   video_stream_encoder_->Stop();
 }
 
+TEST_F(VideoStreamEncoderTest,
+       NativeFrameIsMappedToPreferredPixelFormatBeforeCropping) {
+  video_encoder_config_.video_stream_factory =
+      rtc::make_ref_counted<CroppingVideoStreamFactory>();
+  video_stream_encoder_->ConfigureEncoder(std::move(video_encoder_config_),
+                                          kMaxPayloadLength);
+  video_stream_encoder_->WaitUntilTaskQueueIsIdle();
+  fake_encoder_.SetPreferredPixelFormats({VideoFrameBuffer::Type::kNV12});
+
+  video_stream_encoder_->OnBitrateUpdatedAndWaitForManagedResources(
+      kTargetBitrate, kTargetBitrate, kTargetBitrate, 0, 0, 0);
+  video_source_.IncomingCapturedFrame(CreateFrame(1, nullptr));
+  WaitForEncodedFrame(1);
+
+  // The frame needs to be cropped, which is done on the mapped NV12 buffer
+  // rather than on an I420 conversion of the native buffer.
+  rtc::Event frame_destroyed_event;
+  video_source_.IncomingCapturedFrame(CreateFakeNV12NativeFrame(
+      2, &frame_destroyed_event, codec_width_ + 1, codec_height_ + 1));
+  WaitForEncodedFrame(2);
+  EXPECT_EQ(VideoFrameBuffer::Type::kNV12,
+            fake_encoder_.GetLastInputPixelFormat());
+  EXPECT_EQ(fake_encoder_.config().width, fake_encoder_.GetLastInputWidth());
+  EXPECT_EQ(fake_encoder_.config().height, fake_encoder_.GetLastInputHeight());
+  video_stream_encoder_->Stop();
+}
+
 TEST_F(VideoStreamEncoderTest, NonI420FramesShouldNotBeConvertedToI420) {
   video_stream_encoder_->OnBitrateUpdatedAndWaitForManagedResources(
       kTargetBitrate, kTargetBitrate, kTargetBitrate, 0, 0, 0);
@@ -1871,6 +1913,50 @@ TEST_F(VideoStreamEncoderTest, DropsFramesWhenCongestionWindowPushbackSet) {
   video_stream_encoder_->Stop();
 }
 
+TEST_F(VideoStreamEncoderTest,
+       RejectsFramesAheadOfCaptureWhenCongestionWindowPushbackSet) {
+  video_stream_encoder_->OnBitrateUpdatedAndWaitForManagedResources(
+      kTargetBitrate, kTargetBitrate, kTargetBitrate, 0, 0, 0);
+  video_source_.IncomingCapturedFrame(CreateFrame(1, nullptr));
+  WaitForEncodedFrame(1);
+
+  // With 1/2 of frames to be dropped, the source is told to skip every
+  // second frame.
+  video_stream_encoder_->OnBitrateUpdatedAndWaitForManagedResources(
+      kTargetBitrate, kTargetBitrate, kTargetBitrate, 0, 0, 0.5);
+  EXPECT_FALSE(video_source_.SinkWantsFrame(/*timestamp_us=*/1000));
+  EXPECT_TRUE(video_source_.SinkWantsFrame(/*timestamp_us=*/2000));
+  video_source_.IncomingCapturedFrame(CreateFrame(3, nullptr));
+  WaitForEncodedFrame(3);
+
+  // A rejected frame delivered anyway is dropped. Frames are created with a
+  // capture time of 99 ms.
+  EXPECT_FALSE(video_source_.SinkWantsFrame(/*timestamp_us=*/99000));
+  video_source_.IncomingCapturedFrame(CreateFrame(4, nullptr));
+  ExpectDroppedFrame();
+  video_source_.IncomingCapturedFrame(CreateFrame(5, nullptr));
+  WaitForEncodedFrame(5);
+  video_stream_encoder_->Stop();
+}
+
+TEST_F(VideoStreamEncoderTest, RejectsFramesAheadOfCaptureWhileSuspended) {
+  video_stream_encoder_->OnBitrateUpdatedAndWaitForManagedResources(
+      kTargetBitrate, kTargetBitrate, kTargetBitrate, 0, 0, 0);
+  video_source_.IncomingCapturedFrame(CreateFrame(1, nullptr));
+  WaitForEncodedFrame(1);
+  EXPECT_TRUE(video_source_.SinkWantsFrame(/*timestamp_us=*/99000));
+
+  video_stream_encoder_->OnBitrateUpdatedAndWaitForManagedResources(
+      DataRate::Zero(), DataRate::Zero(), DataRate::Zero(), 0, 0, 0);
+  EXPECT_FALSE(video_source_.SinkWantsFrame(/*timestamp_us=*/99000));
+  EXPECT_FALSE(video_source_.SinkWantsFrame(/*timestamp_us=*/99000));
+
+  video_stream_encoder_->OnBitrateUpdatedAndWaitForManagedResources(
+      kTargetBitrate, kTargetBitrate, kTargetBitrate, 0, 0, 0);
+  EXPECT_TRUE(video_source_.SinkWantsFrame(/*timestamp_us=*/99000));
+  video_stream_encoder_->Stop();
+}
+
 TEST_F(VideoStreamEncoderTest,
        ConfigureEncoderTriggersOnEncoderConfigurationChanged) {
   video_stream_encoder_->OnBitrateUpdatedAndWaitForManagedResources(
@@ -7138,6 +7224,27 @@ TEST_F(VideoStreamEncoderTest,
   video_stream_encoder_->Stop();
 }
 
+TEST_F(VideoStreamEncoderTest,
+       LowerCpuUnderuseThresholdForMultithreadedSoftwareEncoder) {
+  const int kFrameWidth = 1280;
+  const int kFrameHeight = 720;
+  const CpuOveruseOptions default_options;
+  fake_encoder_.SetNumThreads(4);
+
+  video_stream_encoder_->OnBitrateUpdatedAndWaitForManagedResources(
+      kTargetBitrate, kTargetBitrate, kTargetBitrate, 0, 0, 0);
+  video_source_.IncomingCapturedFrame(
+      CreateFrame(1, kFrameWidth, kFrameHeight));
+  WaitForEncodedFrame(1);
+  EXPECT_EQ(video_stream_encoder_->overuse_detector_proxy_->GetOptions()
+                .low_encode_usage_threshold_percent,
+            default_options.low_encode_usage_threshold_percent / 4);
+  EXPECT_EQ(video_stream_encoder_->overuse_detector_proxy_->GetOptions()
+                .high_encode_usage_threshold_percent,
+            default_options.high_encode_usage_threshold_percent);
+  video_stream_encoder_->Stop();
+}
+
 TEST_F(VideoStreamEncoderTest,
        CpuAdaptationThresholdsUpdatesWhenHardwareAccelerationChange) {
   const int kFrameWidth = 1280;
@@ -8544,6 +8651,33 @@ TEST_F(VideoStreamEncoderTest,
   video_stream_encoder_->Stop();
 }
 
+TEST_F(VideoStreamEncoderTest, ConfiguresEncoderThreadingFromFieldTrial) {
+  webrtc::test::ScopedKeyValueConfig field_trials(
+      field_trials_,
+      "WebRTC-VideoEncoderSettings/threads:4,log2_tile_columns:1,row_mt:false,"
+      "speed_min_pixels:0|230400,speed:8|9/");
+  ResetEncoder("VP9", /*num_stream=*/1, /*num_temporal_layers=*/1,
+               /*num_spatial_layers=*/1,
+               /*screenshare=*/false, /*allocation_callback_type=*/
+               VideoStreamEncoder::BitrateAllocationCallbackType::
+                   kVideoBitrateAllocationWhenScreenSharing,
+               /*num_cores=*/8);
+
+  video_stream_encoder_->OnBitrateUpdatedAndWaitForManagedResources(
+      kTargetBitrate, kTargetBitrate, kTargetBitrate, 0, 0, 0);
+  video_source_.IncomingCapturedFrame(
+      CreateFrame(1, /*width=*/320, /*height=*/180));
+  WaitForEncodedFrame(1);
+  VideoEncoder::Settings::ThreadingPolicy policy =
+      fake_encoder_.LastThreadingPolicy();
+  EXPECT_EQ(policy.num_threads, 4);
+  EXPECT_EQ(policy.log2_tile_columns, 1);
+  EXPECT_EQ(policy.row_mt, false);
+  EXPECT_EQ(policy.GetSpeed(320 * 180), 8);
+  EXPECT_EQ(policy.GetSpeed(640 * 360), 9);
+  video_stream_encoder_->Stop();
+}
+
 TEST_F(VideoStreamEncoderTest, LowComplexityWithTwoCores) {
   ResetEncoder("VP9", /*num_stream=*/1, /*num_temporal_layers=*/1,
                /*num_spatial_layers=*/1,